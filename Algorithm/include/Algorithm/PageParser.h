@@ -17,11 +17,16 @@
 /// @since  2017-09-27
 /// @brief  Parser for a set of data objects in consecutive memory pages.
 
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 #include <stdexcept>
+#include <utility>
 
 namespace o2
 {
@@ -154,6 +159,13 @@ void set<void>(void*, size_t)
  *   for (auto element : parser) {
  *     // do something with element
  *   }
+ *
+ * Usage: batched page descriptors
+ *   std::vector<RawParser::PageDescriptor> pages;
+ *   parser.getPageDescriptors(pages);
+ *   // the pages can now be processed independently, e.g. in parallel
+ *
+ * See ScatteredPageParser for buffers spread over several message parts.
  */
 template <typename PageHeaderT,
           size_t PageSize,
@@ -178,7 +190,16 @@ class PageParser
   using TargetInPageBuffer = std::true_type;
   using SourceInPageBuffer = std::false_type;
 
+  /// Descriptor of one page of a buffer, see getPageDescriptors
+  struct PageDescriptor {
+    const PageHeaderType* header = nullptr; // the page header at the start of the page
+    const BufferType* payload = nullptr;    // the data following the page header
+    size_t payloadSize = 0;                 // size of the data in this page
+  };
+
   PageParser() = delete;
+  PageParser(const PageParser&) = delete;
+  PageParser& operator=(const PageParser&) = delete;
   template <typename T>
   PageParser(T* buffer, size_t size,
              GetNElements getNElementsFct = pageparser::defaultGetNElementsFct)
@@ -453,6 +474,37 @@ class PageParser
     return mGroupHeader;
   }
 
+  /// Append the descriptors of all the pages of a buffer, e.g. one superpage, to @a pages.
+  /// All pages have the fixed size, only the last one can be shorter, so the descriptors
+  /// are computed without reading the buffer and the pages can be handed to decoders
+  /// which process them independently. Returns the number of pages of the buffer.
+  template <typename T>
+  static size_t getPageDescriptors(T* buffer, size_t size, std::vector<PageDescriptor>& pages)
+  {
+    static_assert(sizeof(T) == sizeof(BufferType),
+                  "buffer required to be byte-type");
+    size_t nPages = size > 0 ? ((size - 1) / page_size) + 1 : 0;
+    if (nPages > 0 && size - (nPages - 1) * page_size < sizeof(PageHeaderType)) {
+      throw std::runtime_error("format error: the last page is shorter than the page header");
+    }
+    auto data = reinterpret_cast<const BufferType*>(buffer);
+    size_t offset = pages.size();
+    pages.resize(offset + nPages);
+    for (size_t page = 0; page < nPages; ++page) {
+      auto& descriptor = pages[offset + page];
+      descriptor.header = reinterpret_cast<const PageHeaderType*>(data + page * page_size);
+      descriptor.payload = data + page * page_size + sizeof(PageHeaderType);
+      descriptor.payloadSize = std::min(page_size, size - page * page_size) - sizeof(PageHeaderType);
+    }
+    return nPages;
+  }
+
+  /// Append the descriptors of all the pages of the buffer of the parser to @a pages
+  size_t getPageDescriptors(std::vector<PageDescriptor>& pages) const
+  {
+    return getPageDescriptors(mBuffer, mSize, pages);
+  }
+
   using iterator = Iterator<value_type>;
   using const_iterator = Iterator<const value_type>;
 
@@ -492,6 +544,152 @@ class PageParser
   size_t mNGroupElements = 0;
 };
 
+/**
+ * @class ScatteredPageParser
+ * Parser for data objects in pages spread over a scatter list of buffers,
+ * e.g. the parts of a multipart message, without concatenating them.
+ *
+ * Every buffer is a sequence of pages parsed by ParserT, a PageParser,
+ * the data objects can not be split across the buffer boundary. The
+ * iterator goes transparently over the objects of all the buffers.
+ *
+ * Usage:
+ *   using RawParser = PageParser<PageHeaderType, N, ElementType>;
+ *   ScatteredPageParser<RawParser> parser({{ptr1, size1}, {ptr2, size2}});
+ *   for (auto element : parser) {
+ *     // do something with element
+ *   }
+ *   // or process the pages of every buffer, e.g. superpage, at once
+ *   parser.forEachSuperpage([](size_t part, RawParser::PageDescriptor const* pages, size_t nPages) {
+ *   });
+ */
+template <typename ParserT>
+class ScatteredPageParser
+{
+ public:
+  using ParserType = ParserT;
+  using BufferType = typename ParserType::BufferType;
+  using value_type = typename ParserType::value_type;
+  using PageDescriptor = typename ParserType::PageDescriptor;
+  using GetNElements = typename ParserType::GetNElements;
+  using Part = std::pair<const BufferType*, size_t>;
+
+  ScatteredPageParser() = delete;
+  ScatteredPageParser(std::vector<Part> const& parts,
+                      GetNElements getNElementsFct = pageparser::defaultGetNElementsFct)
+  {
+    mParsers.reserve(parts.size());
+    for (auto const& [buffer, size] : parts) {
+      mParsers.emplace_back(std::make_unique<ParserType>(buffer, size, getNElementsFct));
+    }
+  }
+
+  class const_iterator
+  {
+   public:
+    using ParentType = ScatteredPageParser;
+    using SelfType = const_iterator;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = const typename ParentType::value_type;
+    using reference = value_type&;
+    using pointer = value_type*;
+    using difference_type = std::ptrdiff_t;
+    using PartIterator = typename ParserType::const_iterator;
+
+    const_iterator() = delete;
+    const_iterator(ParentType const* parent, size_t part) : mParent(parent), mPart(part)
+    {
+      seek();
+    }
+
+    // prefix increment
+    SelfType& operator++()
+    {
+      ++(*mIterator);
+      if (*mIterator == mParent->mParsers[mPart]->end()) {
+        ++mPart;
+        seek();
+      }
+      return *this;
+    }
+    // postfix increment
+    SelfType operator++(int /*unused*/)
+    {
+      SelfType copy(*this);
+      operator++();
+      return copy;
+    }
+    reference operator*()
+    {
+      return **mIterator;
+    }
+    bool operator==(const SelfType& rh) const
+    {
+      return mPart == rh.mPart && (mPart == mParent->mParsers.size() || *mIterator == *rh.mIterator);
+    }
+    bool operator!=(const SelfType& rh) const
+    {
+      return !operator==(rh);
+    }
+    /// index of the buffer of the current element
+    size_t getPart() const
+    {
+      return mPart;
+    }
+
+   private:
+    // move to the first element of the current or a following non-empty buffer
+    void seek()
+    {
+      mIterator.reset();
+      for (; mPart < mParent->mParsers.size(); ++mPart) {
+        auto const& parser = *(mParent->mParsers[mPart]);
+        mIterator.emplace(parser.begin());
+        if (*mIterator != parser.end()) {
+          return;
+        }
+      }
+      mIterator.reset();
+    }
+
+    ParentType const* mParent;
+    size_t mPart;
+    std::optional<PartIterator> mIterator;
+  };
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, mParsers.size());
+  }
+
+  /// number of buffers in the scatter list
+  size_t getNParts() const
+  {
+    return mParsers.size();
+  }
+
+  /// Call @a f with the page descriptors of every buffer, i.e. superpage, in turn
+  /// f(size_t part, PageDescriptor const* pages, size_t nPages)
+  template <typename F>
+  void forEachSuperpage(F&& f) const
+  {
+    std::vector<PageDescriptor> pages;
+    for (size_t part = 0; part < mParsers.size(); ++part) {
+      pages.clear();
+      auto nPages = mParsers[part]->getPageDescriptors(pages);
+      f(part, pages.data(), nPages);
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<const ParserType>> mParsers;
+};
+
 } // namespace algorithm
 } // namespace o2
 
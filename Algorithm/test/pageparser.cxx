@@ -244,3 +244,50 @@ BOOST_AUTO_TEST_CASE(test_pageparser_group_perpage)
   runParserTest<DataSetT, PageHeader, int, 100, true>(dataset);
   runParserTest<DataSetT, PageHeader, int, 89, true>(dataset);
 }
+
+BOOST_AUTO_TEST_CASE(test_pageparser_scattered)
+{
+  constexpr unsigned pagesize = 128;
+  using RawParser = o2::algorithm::PageParser<PageHeader, pagesize, ClusterData>;
+  std::vector<ClusterData> dataset;
+  FillData(dataset, 50);
+
+  // the data set is split over three buffers, like the parts of a multipart message,
+  // the one in the middle is empty
+  std::vector<ClusterData> first(dataset.begin(), dataset.begin() + 20);
+  std::vector<ClusterData> second;
+  std::vector<ClusterData> third(dataset.begin() + 20, dataset.end());
+  auto buffer1 = MakeBuffer(pagesize, PageHeader(0), first);
+  auto buffer3 = MakeBuffer(pagesize, PageHeader(1), third);
+  std::vector<o2::algorithm::ScatteredPageParser<RawParser>::Part> parts{{buffer1.first.get(), buffer1.second},
+                                                                         {nullptr, 0},
+                                                                         {buffer3.first.get(), buffer3.second}};
+  const o2::algorithm::ScatteredPageParser<RawParser> parser(parts);
+  BOOST_CHECK(parser.getNParts() == 3);
+
+  unsigned dataidx = 0;
+  for (auto i : parser) {
+    BOOST_REQUIRE(dataidx < dataset.size());
+    BOOST_REQUIRE(i == dataset[dataidx++]);
+  }
+  BOOST_CHECK(dataidx == dataset.size());
+
+  // the page descriptors of every buffer
+  std::vector<size_t> nPagesPerPart;
+  parser.forEachSuperpage([&](size_t part, RawParser::PageDescriptor const* pages, size_t nPages) {
+    BOOST_CHECK(part == nPagesPerPart.size());
+    nPagesPerPart.push_back(nPages);
+    auto size = parts[part].second;
+    for (size_t page = 0; page < nPages; ++page) {
+      BOOST_CHECK(reinterpret_cast<const uint8_t*>(pages[page].header) == parts[part].first + page * pagesize);
+      BOOST_CHECK(pages[page].header->pageid == (part == 0 ? 0 : 1));
+      BOOST_CHECK(pages[page].payload == parts[part].first + page * pagesize + sizeof(PageHeader));
+      auto expectedSize = (page + 1 < nPages ? pagesize : size - page * pagesize) - sizeof(PageHeader);
+      BOOST_CHECK(pages[page].payloadSize == expectedSize);
+    }
+  });
+  BOOST_REQUIRE(nPagesPerPart.size() == 3);
+  BOOST_CHECK(nPagesPerPart[0] == (buffer1.second + pagesize - 1) / pagesize);
+  BOOST_CHECK(nPagesPerPart[1] == 0);
+  BOOST_CHECK(nPagesPerPart[2] == (buffer3.second + pagesize - 1) / pagesize);
+}
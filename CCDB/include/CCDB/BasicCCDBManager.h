@@ -102,6 +102,11 @@ class CCDBManagerInstance
   template <typename T>
   T* getForTimeStamp(std::string const& path, long timestamp);
 
+  /// retrieve the objects of type T from CCDB as stored under paths and timestamp,
+  /// the objects which are not available in the cache are fetched concurrently
+  template <typename T>
+  std::vector<T*> getForTimeStamps(std::vector<std::string> const& paths, long timestamp);
+
   /// retrieve an object of type T from CCDB as stored under path, timestamp and metaData
   template <typename T>
   T* getSpecific(std::string const& path, long timestamp = -1, MD metaData = MD())
@@ -198,6 +203,9 @@ class CCDBManagerInstance
  private:
   // method to print (fatal) error
   void reportFatal(std::string_view s);
+  // book-keeping of the object retrieved for path, updates the cache if enabled, returns the object to be served
+  template <typename T>
+  T* registerRetrieved(std::string const& path, T* ptr, long timestamp);
   // we access the CCDB via the CURL based C++ API
   o2::ccdb::CcdbApi mCCDBAccessor;
   std::unordered_map<std::string, CachedObject> mCache; //! map for {path, CachedObject} associations
@@ -220,21 +228,10 @@ class CCDBManagerInstance
 };
 
 template <typename T>
-T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
+T* CCDBManagerInstance::registerRetrieved(std::string const& path, T* ptr, long timestamp)
 {
-  T* ptr = nullptr;
-  mQueries++;
-  auto start = std::chrono::system_clock::now();
   if (!isCachingEnabled()) {
-    ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, nullptr, "",
-                                                mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
-                                                mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
-    if (!ptr) {
-      if (mFatalWhenNull) {
-        reportFatal(std::string("Got nullptr from CCDB for path ") + path + std::string(" and timestamp ") + std::to_string(timestamp));
-      }
-      mFailures++;
-    } else {
+    if (ptr) {
       mFetches++;
       auto sh = mHeaders.find("fileSize");
       if (sh != mHeaders.end()) {
@@ -242,6 +239,70 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
         mFetchedSize += s;
       }
     }
+    return ptr;
+  }
+  auto& cached = mCache[path];
+  if (ptr) { // new object was shipped, old one (if any) is not valid anymore
+    cached.fetches++;
+    mFetches++;
+    if constexpr (std::is_same<TGeoManager, T>::value || std::is_base_of<o2::conf::ConfigurableParam, T>::value) {
+      // some special objects cannot be cached to shared_ptr since root may delete their raw global pointer
+      cached.noCleanupPtr = ptr;
+    } else {
+      cached.objPtr.reset(ptr);
+    }
+    cached.uuid = mHeaders["ETag"];
+
+    try {
+      if (mHeaders.find("Valid-From") != mHeaders.end()) {
+        cached.startvalidity = std::stol(mHeaders["Valid-From"]);
+      } else {
+        // if meta-information missing assume infinit validity
+        // (should happen only for locally created objects)
+        cached.startvalidity = 0;
+      }
+      if (mHeaders.find("Valid-Until") != mHeaders.end()) {
+        cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
+      } else {
+        cached.endvalidity = std::numeric_limits<long>::max();
+      }
+      cached.cacheValidFrom = timestamp;
+    } catch (std::exception const& e) {
+      reportFatal("Failed to read validity from CCDB response (Valid-From :  " + mHeaders["Valid-From"] + std::string(" Valid-Until: ") + mHeaders["Valid-Until"] + std::string(")"));
+    }
+    auto sh = mHeaders.find("fileSize");
+    if (sh != mHeaders.end()) {
+      size_t s = atol(sh->second.c_str());
+      mFetchedSize += s;
+      cached.minSize = std::min(s, cached.minSize);
+      cached.maxSize = std::max(s, cached.minSize);
+    }
+  } else if (mHeaders.count("Error")) { // in case of errors the pointer is 0 and headers["Error"] should be set
+    cached.failures++;
+    cached.clear(); // in case of any error clear cache for this object
+  }
+  // the old object is valid, fetch cache end of validity
+  ptr = reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
+  if (mHeaders.find("Cache-Valid-Until") != mHeaders.end()) {
+    cached.cacheValidUntil = std::stol(mHeaders["Cache-Valid-Until"]);
+  } else {
+    cached.cacheValidUntil = -1;
+  }
+  mHeaders.clear();
+  mMetaData.clear();
+  return ptr;
+}
+
+template <typename T>
+T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
+{
+  T* ptr = nullptr;
+  mQueries++;
+  auto start = std::chrono::system_clock::now();
+  if (!isCachingEnabled()) {
+    ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, nullptr, "",
+                                                mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                                mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
   } else {
     auto& cached = mCache[path];
     cached.queries++;
@@ -251,64 +312,62 @@ T* CCDBManagerInstance::getForTimeStamp(std::string const& path, long timestamp)
     ptr = mCCDBAccessor.retrieveFromTFileAny<T>(path, mMetaData, timestamp, &mHeaders, cached.uuid,
                                                 mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
                                                 mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
-    if (ptr) { // new object was shipped, old one (if any) is not valid anymore
-      cached.fetches++;
-      mFetches++;
-      if constexpr (std::is_same<TGeoManager, T>::value || std::is_base_of<o2::conf::ConfigurableParam, T>::value) {
-        // some special objects cannot be cached to shared_ptr since root may delete their raw global pointer
-        cached.noCleanupPtr = ptr;
-      } else {
-        cached.objPtr.reset(ptr);
-      }
-      cached.uuid = mHeaders["ETag"];
-
-      try {
-        if (mHeaders.find("Valid-From") != mHeaders.end()) {
-          cached.startvalidity = std::stol(mHeaders["Valid-From"]);
-        } else {
-          // if meta-information missing assume infinit validity
-          // (should happen only for locally created objects)
-          cached.startvalidity = 0;
-        }
-        if (mHeaders.find("Valid-Until") != mHeaders.end()) {
-          cached.endvalidity = std::stol(mHeaders["Valid-Until"]);
-        } else {
-          cached.endvalidity = std::numeric_limits<long>::max();
-        }
-        cached.cacheValidFrom = timestamp;
-      } catch (std::exception const& e) {
-        reportFatal("Failed to read validity from CCDB response (Valid-From :  " + mHeaders["Valid-From"] + std::string(" Valid-Until: ") + mHeaders["Valid-Until"] + std::string(")"));
-      }
-      auto sh = mHeaders.find("fileSize");
-      if (sh != mHeaders.end()) {
-        size_t s = atol(sh->second.c_str());
-        mFetchedSize += s;
-        cached.minSize = std::min(s, cached.minSize);
-        cached.maxSize = std::max(s, cached.minSize);
-      }
-    } else if (mHeaders.count("Error")) { // in case of errors the pointer is 0 and headers["Error"] should be set
-      cached.failures++;
-      cached.clear(); // in case of any error clear cache for this object
+  }
+  ptr = registerRetrieved(path, ptr, timestamp);
+  if (!ptr) {
+    if (mFatalWhenNull) {
+      reportFatal(std::string("Got nullptr from CCDB for path ") + path + std::string(" and timestamp ") + std::to_string(timestamp));
     }
-    // the old object is valid, fetch cache end of validity
-    ptr = reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
-    if (mHeaders.find("Cache-Valid-Until") != mHeaders.end()) {
-      cached.cacheValidUntil = std::stol(mHeaders["Cache-Valid-Until"]);
-    } else {
-      cached.cacheValidUntil = -1;
+    mFailures++;
+  }
+  auto end = std::chrono::system_clock::now();
+  mTimerMS += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+  return ptr;
+}
+
+template <typename T>
+std::vector<T*> CCDBManagerInstance::getForTimeStamps(std::vector<std::string> const& paths, long timestamp)
+{
+  std::vector<T*> ptrs(paths.size(), nullptr);
+  std::vector<std::string> fetchPaths, fetchETags;
+  std::vector<size_t> fetchIDs;
+  auto start = std::chrono::system_clock::now();
+  for (size_t i = 0; i < paths.size(); i++) {
+    mQueries++;
+    if (isCachingEnabled()) {
+      auto& cached = mCache[paths[i]];
+      cached.queries++;
+      if ((!isOnline() && cached.isCacheValid(timestamp)) || (mCheckObjValidityEnabled && cached.isValid(timestamp))) {
+        ptrs[i] = reinterpret_cast<T*>(cached.noCleanupPtr ? cached.noCleanupPtr : cached.objPtr.get());
+        continue;
+      }
+      fetchETags.push_back(cached.uuid);
     }
-    mHeaders.clear();
-    mMetaData.clear();
-    if (!ptr) {
-      if (mFatalWhenNull) {
-        reportFatal(std::string("Got nullptr from CCDB for path ") + path + std::string(" and timestamp ") + std::to_string(timestamp));
+    fetchPaths.push_back(paths[i]);
+    fetchIDs.push_back(i);
+  }
+  if (!fetchPaths.empty()) {
+    std::vector<MD> headers;
+    auto fetched = mCCDBAccessor.retrieveFromTFilesAny<T>(fetchPaths, mMetaData, timestamp, &headers, fetchETags,
+                                                          mCreatedNotAfter ? std::to_string(mCreatedNotAfter) : "",
+                                                          mCreatedNotBefore ? std::to_string(mCreatedNotBefore) : "");
+    for (size_t i = 0; i < fetchPaths.size(); i++) {
+      mHeaders = std::move(headers[i]);
+      auto ptr = registerRetrieved(fetchPaths[i], fetched[i], timestamp);
+      if (!ptr) {
+        if (mFatalWhenNull) {
+          reportFatal(std::string("Got nullptr from CCDB for path ") + fetchPaths[i] + std::string(" and timestamp ") + std::to_string(timestamp));
+        }
+        mFailures++;
       }
-      mFailures++;
+      ptrs[fetchIDs[i]] = ptr;
     }
   }
+  mHeaders.clear();
+  mMetaData.clear();
   auto end = std::chrono::system_clock::now();
   mTimerMS += std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-  return ptr;
+  return ptrs;
 }
 
 class BasicCCDBManager : public CCDBManagerInstance
@@ -27,6 +27,7 @@
 #include <CommonUtils/ConfigurableParam.h>
 #include <type_traits>
 #include <vector>
+#include <algorithm>
 
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__ROOTCLING__) && !defined(__CLING__)
 #include "MemoryResources/MemoryResources.h"
@@ -167,6 +168,19 @@ class CcdbApi //: public DatabaseInterface
     return storeAsTFile(rootobj, path, metadata, startValidityTimestamp, endValidityTimestamp, maxSize);
   }
 
+  /**
+   * Store an object of a flat class (o2::gpu::FlatObject) as raw flat image, which the consumers
+   * use without ROOT streaming. The image can only be used by builds with the same class layout.
+   */
+  template <typename T>
+  int storeAsFlatImage(const T& obj, std::string const& path, std::map<std::string, std::string> const& metadata,
+                       long startValidityTimestamp = -1, long endValidityTimestamp = -1) const
+  {
+    std::vector<char> image(T::getFlatImageSize(obj));
+    T::writeToFlatImage(obj, image.data());
+    return storeAsBinaryFile(image.data(), image.size(), "flat_image.bin", T::Class_Name(), path, metadata, startValidityTimestamp, endValidityTimestamp);
+  }
+
   /**
    * Retrieve object at the given path for the given timestamp.
    *
@@ -191,6 +205,24 @@ class CcdbApi //: public DatabaseInterface
                          long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                          const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * Retrieve the objects at the given paths for the given timestamp. All lookups and downloads are performed
+   * concurrently via the CCDBDownloader, which saves a round trip and a redirect per object.
+   *
+   * @param paths The paths where the objects are to be found.
+   * @param metadata Key-values representing the metadata to filter out objects, common for all paths.
+   * @param timestamp Timestamp of the objects to retrieve. If omitted, current timestamp is used.
+   * @param headers Vector to be populated with the headers we received for every path, if it is not null.
+   * @param etags optional etags from previous calls, either empty or one per path
+   * @param optional createdNotAfter upper time limit for the object creation timestamp (TimeMachine mode)
+   * @param optional createdNotBefore lower time limit for the object creation timestamp (TimeMachine mode)
+   * @return the objects in the order of the paths, nullptr for those which were not found or not modified w.r.t. the etag
+   */
+  template <typename T>
+  std::vector<T*> retrieveFromTFilesAny(std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                                        long timestamp = -1, std::vector<std::map<std::string, std::string>>* headers = nullptr, std::vector<std::string> const& etags = {},
+                                        const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
+
   /**
    * Delete all versions of the object at this path.
    *
@@ -375,6 +407,16 @@ class CcdbApi //: public DatabaseInterface
   void getFromSnapshot(bool createSnapshot, std::string const& path,
                        long timestamp, std::map<std::string, std::string>& headers,
                        std::string& snapshotpath, o2::pmr::vector<char>& dest, int& fromSnapshot, std::string const& etag) const;
+
+  // Serves the request from the node cache if it holds an object valid for the requested timestamp.
+  bool getFromNodeCache(RequestContext& requestContext) const;
+
+  // Publishes the downloaded object atomically to the node cache.
+  void saveToNodeCache(RequestContext const& requestContext) const;
+
+  // Directory of the node cache holding the objects of the given path and metadata.
+  std::string getNodeCacheDir(std::string const& path, std::map<std::string, std::string> const& metadata) const;
+
   void releaseNamedSemaphore(boost::interprocess::named_semaphore* sem, std::string const& path) const;
   boost::interprocess::named_semaphore* createNamedSemaphore(std::string const& path) const;
   static std::string determineSemaphoreName(std::string const& basedir, std::string const& objectpath);
@@ -389,6 +431,26 @@ class CcdbApi //: public DatabaseInterface
                         std::map<std::string, std::string>* headers, std::string const& etag,
                         const std::string& createdNotAfter, const std::string& createdNotBefore, bool considerSnapshot = true) const;
 
+  /**
+   * Retrieve an object of a flat class (o2::gpu::FlatObject) stored with storeAsFlatImage.
+   * The object is relocated from the raw image, no ROOT streaming is involved.
+   */
+  template <typename T>
+  T* retrieveFlatImage(std::string const& path, std::map<std::string, std::string> const& metadata, long timestamp = -1,
+                       std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
+                       const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const
+  {
+    o2::pmr::vector<char> image;
+    std::map<std::string, std::string> localHeaders;
+    loadFileToMemory(image, path, metadata, timestamp, &localHeaders, etag, createdNotAfter, createdNotBefore);
+    if (headers) {
+      for (auto& h : localHeaders) {
+        (*headers)[h.first] = h.second;
+      }
+    }
+    return image.empty() ? nullptr : T::template readFromFlatImage<T>(image.data(), image.size());
+  }
+
   // Loads files from alien and cvmfs into given destination.
   bool loadLocalContentToMemory(o2::pmr::vector<char>& dest, std::string& url) const;
 
@@ -495,6 +557,28 @@ class CcdbApi //: public DatabaseInterface
                         const std::string& path, const std::map<std::string, std::string>& metadata,
                         long startValidityTimestamp, long endValidityTimestamp, std::vector<char>::size_type maxSize = 0 /*in bytes*/) const;
 
+  /**
+   * An object to be stored with storeAsBinaryFiles(). The buffer has to stay valid until the upload is done.
+   */
+  struct UploadRequest {
+    const char* buffer = nullptr;
+    size_t size = 0;
+    std::string fileName;
+    std::string objectType;
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    long startValidityTimestamp = -1;
+    long endValidityTimestamp = -1;
+  };
+
+  /**
+   * Store several binary buffers concurrently using the multi-handle of the CCDBDownloader, with at most
+   * maxParallel transfers at the same time. Failed uploads are retried on the next host with increasing delays,
+   * as configured by setCurlRetriesParameters(). In snapshot mode the buffers are stored one after the other.
+   * @return one code per request, with the same meaning as for storeAsBinaryFile()
+   */
+  std::vector<int> storeAsBinaryFiles(std::vector<UploadRequest> const& requests, int maxParallel = 4) const;
+
   /**
    * A generic helper implementation to store an obj whose type is given by a std::type_info
    * @return 0 -> ok,
@@ -516,6 +600,14 @@ class CcdbApi //: public DatabaseInterface
                           long timestamp = -1, std::map<std::string, std::string>* headers = nullptr, std::string const& etag = "",
                           const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
 
+  /**
+   * A generic helper implementation to query the objects of several paths whose type is given by a std::type_info
+   * @return the objects in the order of the paths, nullptr for those which were not retrieved
+   */
+  std::vector<void*> retrieveFromTFiles(std::type_info const&, std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                                        long timestamp = -1, std::vector<std::map<std::string, std::string>>* headers = nullptr, std::vector<std::string> const& etags = {},
+                                        const std::string& createdNotAfter = "", const std::string& createdNotBefore = "") const;
+
   /**
    * Run the uvLoop belonging to mDownloader once.
    *
@@ -623,6 +715,7 @@ class CcdbApi //: public DatabaseInterface
   std::string mSnapshotTopPath{};    // root of the snaphot in the snapshot backend mode, i.e. with init("file://<dir>) call
   std::string mSnapshotCachePath{};  // root of the local snapshot (to fill or impose, even if not in the snapshot backend mode)
   bool mPreferSnapshotCache = false; // if snapshot is available, don't try to query its validity even in non-snapshot backend mode
+  std::string mNodeCachePath{};      // root of the cache shared by all processes of the node, objects are keyed by path, metadata, validity and ETag
   bool mInSnapshotMode = false;
   mutable TGrid* mAlienInstance = nullptr;                       // a cached connection to TGrid (needed for Alien locations)
   bool mNeedAlienToken = true;                                   // On EPN and FLP we use a local cache and don't need the alien token
@@ -659,6 +752,18 @@ typename std::enable_if<std::is_base_of<o2::conf::ConfigurableParam, T>::value,
   return static_cast<T*>(obj);
 }
 
+template <typename T>
+std::vector<T*> CcdbApi::retrieveFromTFilesAny(std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                                               long timestamp, std::vector<std::map<std::string, std::string>>* headers, std::vector<std::string> const& etags,
+                                               const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  static_assert(!std::is_base_of<o2::conf::ConfigurableParam, T>::value, "ConfigurableParams need to be retrieved with retrieveFromTFileAny");
+  auto objects = retrieveFromTFiles(typeid(T), paths, metadata, timestamp, headers, etags, createdNotAfter, createdNotBefore);
+  std::vector<T*> res(objects.size());
+  std::transform(objects.begin(), objects.end(), res.begin(), [](void* obj) { return static_cast<T*>(obj); });
+  return res;
+}
+
 } // namespace ccdb
 } // namespace o2
 
@@ -210,6 +210,14 @@ void CcdbApi::init(std::string const& host)
     }
     snapshotReport += ", prefer if available";
   }
+  // The environment option ALICEO2_CCDB_NODECACHE defines a cache folder shared by all processes of a node.
+  // Contrary to the ALICEO2_CCDB_LOCALCACHE, every object is stored together with its validity and ETag
+  // and is only served for timestamps within its validity, other requests go to the server.
+  const char* nodecachedir = getenv("ALICEO2_CCDB_NODECACHE");
+  if (nodecachedir && nodecachedir[0] != 0) {
+    mNodeCachePath = fs::weakly_canonical(fs::absolute(nodecachedir));
+    snapshotReport += fmt::format("{}node cache dir={}", snapshotReport.empty() ? "(" : ", ", mNodeCachePath);
+  }
   if (!snapshotReport.empty()) {
     snapshotReport += ')';
   }
@@ -463,6 +471,99 @@ int CcdbApi::storeAsBinaryFile(const char* buffer, size_t size, const std::strin
   return returnValue;
 }
 
+std::vector<int> CcdbApi::storeAsBinaryFiles(std::vector<UploadRequest> const& requests, int maxParallel) const
+{
+  std::vector<int> returnValues(requests.size(), 0);
+  if (mInSnapshotMode) {
+    for (size_t i = 0; i < requests.size(); i++) {
+      const auto& rq = requests[i];
+      returnValues[i] = storeAsBinaryFile(rq.buffer, rq.size, rq.fileName, rq.objectType, rq.path, rq.metadata, rq.startValidityTimestamp, rq.endValidityTimestamp);
+    }
+    return returnValues;
+  }
+
+  // one transfer per request, all of them sharing the multi-handle of the downloader
+  struct Transfer {
+    CURL* curl = nullptr;
+    curl_mime* mime = nullptr;
+    curl_slist* headerList = nullptr;
+    long startValidityTimestamp = 0;
+    long endValidityTimestamp = 0;
+  };
+  std::vector<Transfer> transfers(requests.size());
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < requests.size(); i++) {
+    const auto& rq = requests[i];
+    auto& tr = transfers[i];
+    checkMetadataKeys(rq.metadata);
+    tr.startValidityTimestamp = rq.startValidityTimestamp == -1 ? getCurrentTimestamp() : rq.startValidityTimestamp;
+    tr.endValidityTimestamp = rq.endValidityTimestamp == -1 ? getFutureTimestamp(60 * 60 * 24 * 1) : rq.endValidityTimestamp;
+    tr.curl = curl_easy_init();
+    if (tr.curl == nullptr) {
+      LOGP(alarm, "curl initialization failure");
+      returnValues[i] = -2;
+      continue;
+    }
+    tr.mime = curl_mime_init(tr.curl);
+    auto field = curl_mime_addpart(tr.mime);
+    curl_mime_name(field, "send");
+    curl_mime_filedata(field, rq.fileName.c_str());
+    curl_mime_data(field, rq.buffer, rq.size);
+    tr.headerList = curl_slist_append(tr.headerList, "Expect:");
+    curlSetSSLOptions(tr.curl);
+    curl_easy_setopt(tr.curl, CURLOPT_MIMEPOST, tr.mime);
+    curl_easy_setopt(tr.curl, CURLOPT_HTTPHEADER, tr.headerList);
+    curl_easy_setopt(tr.curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(tr.curl, CURLOPT_USERAGENT, mUniqueAgentID.c_str());
+    pending.push_back(i);
+  }
+
+  // the downloader applies its own limits to all handles, use the ones of the uploads for this batch
+  const auto maxHandlesInUse = mDownloader->mMaxHandlesInUse;
+  const auto requestTimeoutMS = mDownloader->mRequestTimeoutMS;
+  mDownloader->setMaxParallelConnections(std::max(1, maxParallel));
+  mDownloader->setRequestTimeoutTime(mCurlTimeoutUpload * 1000L);
+
+  const int nAttempts = std::max(1, mCurlRetries) * std::max<int>(1, hostsPool.size());
+  for (int attempt = 0; attempt < nAttempts && !pending.empty(); attempt++) {
+    if (attempt > 0) {
+      usleep(mCurlDelayRetries * attempt);
+    }
+    const int hostIndex = attempt % std::max<int>(1, hostsPool.size());
+    std::vector<CURL*> handles;
+    for (auto i : pending) {
+      const auto& rq = requests[i];
+      auto& tr = transfers[i];
+      std::string fullUrl = getFullUrlForStorage(tr.curl, rq.path, rq.objectType, rq.metadata, tr.startValidityTimestamp, tr.endValidityTimestamp, hostIndex);
+      LOG(debug3) << "Full URL Encoded: " << fullUrl;
+      curl_easy_setopt(tr.curl, CURLOPT_URL, fullUrl.c_str());
+      handles.push_back(tr.curl);
+    }
+    auto codes = mDownloader->batchBlockingPerform(handles);
+    std::vector<size_t> failed;
+    for (size_t j = 0; j < pending.size(); j++) {
+      returnValues[pending[j]] = codes[j];
+      if (codes[j] != CURLE_OK) {
+        LOGP(alarm, "Upload of {} to {} failed at attempt {}: {}", requests[pending[j]].path, getHostUrl(hostIndex), attempt + 1, curl_easy_strerror(codes[j]));
+        failed.push_back(pending[j]);
+      }
+    }
+    pending.swap(failed);
+  }
+
+  mDownloader->setMaxParallelConnections(maxHandlesInUse);
+  mDownloader->setRequestTimeoutTime(requestTimeoutMS);
+
+  for (auto& tr : transfers) {
+    if (tr.curl) {
+      curl_easy_cleanup(tr.curl);
+    }
+    curl_slist_free_all(tr.headerList);
+    curl_mime_free(tr.mime);
+  }
+  return returnValues;
+}
+
 int CcdbApi::storeAsTFile(const TObject* rootObject, std::string const& path, std::map<std::string, std::string> const& metadata,
                           long startValidityTimestamp, long endValidityTimestamp, std::vector<char>::size_type maxSize) const
 {
@@ -1132,6 +1233,19 @@ void* CcdbApi::retrieveFromTFile(std::type_info const& tinfo, std::string const&
 
   // normal mode follows
 
+  if (!mNodeCachePath.empty() && !mInSnapshotMode) {
+    // go through the node cache, the downloaded object is published to it
+    o2::pmr::vector<char> buff;
+    std::map<std::string, std::string> localHeaders;
+    loadFileToMemory(buff, path, metadata, timestamp, &localHeaders, etag, createdNotAfter, createdNotBefore, false);
+    if (headers) {
+      for (auto& h : localHeaders) {
+        (*headers)[h.first] = h.second;
+      }
+    }
+    return buff.empty() ? nullptr : interpretAsTMemFileAndExtract(buff.data(), buff.size(), tinfo);
+  }
+
   CURL* curl_handle = curl_easy_init();
   curl_easy_setopt(curl_handle, CURLOPT_USERAGENT, mUniqueAgentID.c_str());
   string fullUrl = getFullUrlForRetrieval(curl_handle, path, metadata, timestamp); // todo check if function still works correctly in case mInSnapshotMode
@@ -1827,6 +1941,154 @@ void CcdbApi::getFromSnapshot(bool createSnapshot, std::string const& path,
   }
 }
 
+std::vector<void*> CcdbApi::retrieveFromTFiles(std::type_info const& tinfo, std::vector<std::string> const& paths, std::map<std::string, std::string> const& metadata,
+                                               long timestamp, std::vector<std::map<std::string, std::string>>* headers, std::vector<std::string> const& etags,
+                                               const std::string& createdNotAfter, const std::string& createdNotBefore) const
+{
+  if (!etags.empty() && etags.size() != paths.size()) {
+    LOGP(fatal, "Number of etags ({}) does not match the number of paths ({})", etags.size(), paths.size());
+  }
+  std::vector<o2::pmr::vector<char>> buffers(paths.size());
+  std::vector<std::map<std::string, std::string>> localHeaders(paths.size());
+  std::vector<RequestContext> contexts;
+  contexts.reserve(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto& requestContext = contexts.emplace_back(buffers[i], metadata, localHeaders[i]);
+    requestContext.path = paths[i];
+    requestContext.timestamp = timestamp;
+    requestContext.etag = etags.empty() ? "" : etags[i];
+    requestContext.createdNotAfter = createdNotAfter;
+    requestContext.createdNotBefore = createdNotBefore;
+    requestContext.considerSnapshot = true;
+  }
+  vectoredLoadFileToMemory(contexts);
+
+  std::vector<void*> objects(paths.size(), nullptr);
+  for (size_t i = 0; i < paths.size(); i++) {
+    if (!buffers[i].empty()) {
+      objects[i] = interpretAsTMemFileAndExtract(buffers[i].data(), buffers[i].size(), tinfo);
+    }
+  }
+  if (headers) {
+    *headers = std::move(localHeaders);
+  }
+  return objects;
+}
+
+std::string CcdbApi::getNodeCacheDir(std::string const& path, std::map<std::string, std::string> const& metadata) const
+{
+  // objects retrieved with different metadata filters are kept apart
+  std::string mdkey;
+  for (const auto& [key, value] : metadata) {
+    mdkey += key + '=' + value + ';';
+  }
+  return fmt::format("{}/{}/{}", mNodeCachePath, path, mdkey.empty() ? std::string("default") : fmt::format("md{:016x}", std::hash<std::string>{}(mdkey)));
+}
+
+bool CcdbApi::getFromNodeCache(RequestContext& requestContext) const
+{
+  // the latest object or objects with creation time constraints are always queried from the server
+  if (mNodeCachePath.empty() || requestContext.timestamp < 0 || !requestContext.createdNotAfter.empty() || !requestContext.createdNotBefore.empty()) {
+    return false;
+  }
+  const auto cachedir = getNodeCacheDir(requestContext.path, requestContext.metadata);
+  std::error_code ec;
+  if (!std::filesystem::is_directory(cachedir, ec)) {
+    return false;
+  }
+  // the files are called <Valid-From>_<Valid-Until>_<ETag>.root, take the most recent validity containing the timestamp
+  std::string cachedfile, cachedetag;
+  long cachedValidFrom = -1;
+  for (const auto& entry : std::filesystem::directory_iterator(cachedir, ec)) {
+    const auto fname = entry.path().filename().string();
+    if (entry.path().extension() != ".root") {
+      continue;
+    }
+    const auto pos0 = fname.find('_'), pos1 = fname.find('_', pos0 + 1);
+    if (pos0 == std::string::npos || pos1 == std::string::npos) {
+      continue;
+    }
+    long validFrom = 0, validUntil = 0;
+    try {
+      validFrom = std::stol(fname.substr(0, pos0));
+      validUntil = std::stol(fname.substr(pos0 + 1, pos1 - pos0 - 1));
+    } catch (std::exception const&) {
+      continue;
+    }
+    if (validFrom <= requestContext.timestamp && requestContext.timestamp < validUntil && validFrom > cachedValidFrom) {
+      cachedValidFrom = validFrom;
+      cachedfile = entry.path().string();
+      cachedetag = fname.substr(pos1 + 1, fname.size() - pos1 - 1 - entry.path().extension().string().size());
+    }
+  }
+  if (cachedfile.empty()) {
+    return false;
+  }
+  std::map<std::string, std::string> cachedHeaders;
+  loadFileToMemory(requestContext.dest, cachedfile, &cachedHeaders);
+  if (requestContext.dest.empty() || cachedHeaders.count("Error")) {
+    requestContext.dest.clear();
+    return false;
+  }
+  // the caching information of the original response does not apply to this request
+  cachedHeaders.erase("Cache-Valid-Until");
+  for (auto& h : cachedHeaders) {
+    requestContext.headers[h.first] = h.second;
+  }
+  // the requester already owns this object: answer like the server with "not modified"
+  auto etag = requestContext.etag;
+  etag.erase(std::remove(etag.begin(), etag.end(), '\"'), etag.end());
+  if (!etag.empty() && etag == cachedetag) {
+    requestContext.dest.clear();
+  }
+  return true;
+}
+
+void CcdbApi::saveToNodeCache(RequestContext const& requestContext) const
+{
+  if (mNodeCachePath.empty() || requestContext.timestamp < 0 || !requestContext.createdNotAfter.empty() || !requestContext.createdNotBefore.empty() ||
+      requestContext.dest.empty() || requestContext.headers.count("Error")) {
+    return;
+  }
+  auto validFrom = requestContext.headers.find("Valid-From"), validUntil = requestContext.headers.find("Valid-Until"), etagEntry = requestContext.headers.find("ETag");
+  if (validFrom == requestContext.headers.end() || validUntil == requestContext.headers.end() || etagEntry == requestContext.headers.end()) {
+    return;
+  }
+  auto etag = etagEntry->second;
+  etag.erase(std::remove(etag.begin(), etag.end(), '\"'), etag.end());
+  std::replace(etag.begin(), etag.end(), '/', '-');
+  const auto cachedir = getNodeCacheDir(requestContext.path, requestContext.metadata);
+  const auto cachedfile = fmt::format("{}/{}_{}_{}.root", cachedir, validFrom->second, validUntil->second, etag);
+  std::error_code ec;
+  if (std::filesystem::exists(cachedfile, ec)) {
+    return;
+  }
+  try {
+    o2::utils::createDirectoriesIfAbsent(cachedir);
+  } catch (std::exception const& e) {
+    LOGP(warning, "Could not create node cache directory {}, reason: {}", cachedir, e.what());
+    return;
+  }
+  // write to a private file and rename it: readers see either no file or the complete one
+  const auto tmpfile = fmt::format("{}.{}.{}.tmp", cachedfile, boost::asio::ip::host_name(), getpid());
+  {
+    std::ofstream objFile(tmpfile, std::ios::out | std::ofstream::binary);
+    std::copy(requestContext.dest.begin(), requestContext.dest.end(), std::ostreambuf_iterator<char>(objFile));
+    if (!objFile.good()) {
+      LOGP(warning, "Unable to write node cache file {}", tmpfile);
+      std::filesystem::remove(tmpfile, ec);
+      return;
+    }
+  }
+  CCDBQuery querysummary(requestContext.path, requestContext.metadata, requestContext.timestamp);
+  updateMetaInformationInLocalFile(tmpfile, &requestContext.headers, &querysummary);
+  std::filesystem::rename(tmpfile, cachedfile, ec);
+  if (ec) {
+    LOGP(warning, "Unable to publish node cache file {}, reason: {}", cachedfile, ec.message());
+    std::filesystem::remove(tmpfile, ec);
+  }
+}
+
 void CcdbApi::saveSnapshot(RequestContext& requestContext) const
 {
   // Consider saving snapshot
@@ -1882,6 +2144,8 @@ void CcdbApi::navigateSourcesAndLoadFile(RequestContext& requestContext, int& fr
     // if we are in snapshot mode we can simply open the file, unless the etag is non-empty:
     // this would mean that the object was is already fetched and in this mode we don't to validity checks!
     getFromSnapshot(createSnapshot, requestContext.path, requestContext.timestamp, requestContext.headers, snapshotpath, requestContext.dest, fromSnapshot, requestContext.etag);
+  } else if (getFromNodeCache(requestContext)) {
+    fromSnapshot = 3;
   } else { // look on the server
     scheduleDownload(requestContext, requestCounter);
   }
@@ -1913,6 +2177,9 @@ void CcdbApi::vectoredLoadFileToMemory(std::vector<RequestContext>& requestConte
       if (requestContext.considerSnapshot && fromSnapshots.at(i) != 2) {
         saveSnapshot(requestContext);
       }
+      if (fromSnapshots.at(i) == 0) {
+        saveToNodeCache(requestContext);
+      }
     }
   }
 }
@@ -0,0 +1,262 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitter2Batch.h
+/// \brief 2-prongs secondary vertex fit of a batch of track pairs in lockstep
+
+#ifndef _ALICEO2_DCA_FITTER2_BATCH_
+#define _ALICEO2_DCA_FITTER2_BATCH_
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "ReconstructionDataFormats/Track.h"
+#include "DCAFitter/HelixHelper.h"
+#include "DCAFitter/DCAFitter2Lanes.h"
+
+namespace o2
+{
+namespace vertexing
+{
+
+///__________________________________________________________________________________
+///< Fitter of up to W 2-prong candidates per process call, giving the same candidates as DCAFitterN<2> configured with
+///< constant field and without propagation of the tracks to the PCA (setPropagateToPCA(false), no Propagator, no material
+///< corrections, no final weighted PCA). The seeding (2D crossings and propagation of the tracks to them) is done per pair,
+///< the minimizations of all seeds are done in lockstep by DCAFitter2Lanes: first for the 1st crossing of every pair, then
+///< for the 2nd ones, which need to know if the fit of the 1st one has moved to the 2nd crossing.
+///< The candidates are addressed by the lane (index of the pair in the batch) and, as in DCAFitterN, by their quality order.
+template <int W = 8>
+class DCAFitter2Batch
+{
+  static constexpr int MAXHYP = 2;
+  static constexpr float XerrFactor = 5.; // factor for conversion of track covYY to dummy covXX
+  using Track = o2::track::TrackParCov;
+  using TrackAuxPar = o2::track::TrackAuxPar;
+  using CrossInfo = o2::track::CrossInfo;
+  using Lanes = DCAFitter2Lanes<W>;
+
+ public:
+  static constexpr int getNProngs() { return 2; }
+  static constexpr int getBatchSize() { return W; }
+
+  DCAFitter2Batch() = default;
+  DCAFitter2Batch(float bz, bool useAbsDCA)
+  {
+    setBz(bz);
+    setUseAbsDCA(useAbsDCA);
+  }
+
+  ///< fit n <= W pairs of tracks {tracks0[l], tracks1[l]}, return the number of pairs with at least 1 vertex candidate
+  int process(const Track* const* tracks0, const Track* const* tracks1, int n);
+
+  ///< number of pairs of the last process call
+  int getNPairs() const { return mNPairs; }
+
+  ///< number of vertex candidates of the pair in the lane
+  int getNCandidates(int lane) const { return mNCand[lane]; }
+
+  ///< return PCA candidate, by default best on is provided (no check for the index validity)
+  std::array<float, 3> getPCACandidatePos(int lane, int cand = 0) const
+  {
+    const auto& lanes = mLanes[mOrder[lane][cand]];
+    return {float(lanes.pca[0][lane]), float(lanes.pca[1][lane]), float(lanes.pca[2][lane])};
+  }
+
+  ///< return Chi2 at PCA candidate (no check for its validity)
+  float getChi2AtPCACandidate(int lane, int cand = 0) const { return mLanes[mOrder[lane][cand]].chi2[lane]; }
+
+  ///< return number of iterations during minimization (no check for its validity)
+  int getNIterations(int lane, int cand = 0) const { return mLanes[mOrder[lane][cand]].nIter[lane]; }
+
+  ///< X of the PCA candidate in the frame of the track i
+  float getTrackX(int i, int lane, int cand = 0) const
+  {
+    const auto& lanes = mLanes[mOrder[lane][cand]];
+    const auto& taux = mTrAux[lane][i];
+    return taux.c * lanes.pca[0][lane] + taux.s * lanes.pca[1][lane];
+  }
+
+  ///< track param propagated to the PCA candidate, check isValid to make sure propagation was successful
+  o2::track::TrackPar getTrackParamAtPCA(int i, int lane, int cand = 0) const
+  {
+    o2::track::TrackPar trc(*mOrigTrPtr[lane][i]);
+    if (!trc.propagateParamTo(getTrackX(i, lane, cand), mBz)) {
+      trc.invalidate();
+    }
+    return trc;
+  }
+
+  ///< track propagated with errors to the PCA candidate, check isValid to make sure propagation was successful
+  Track getTrackAtPCA(int i, int lane, int cand = 0) const
+  {
+    Track trc(*mOrigTrPtr[lane][i]);
+    if (!trc.propagateTo(getTrackX(i, lane, cand), mBz)) {
+      trc.invalidate();
+    }
+    return trc;
+  }
+
+  const Track* getOrigTrackPtr(int i, int lane) const { return mOrigTrPtr[lane][i]; }
+
+  void setMaxIter(int n = 20) { mParams.maxIter = n > 2 ? n : 2; }
+  void setMaxR(float r = 200.) { mMaxR2 = r * r; }
+  void setMaxDZIni(float d = 4.) { mMaxDZIni = d; }
+  void setMaxDXYIni(float d = 4.) { mMaxDXYIni = d > 0 ? d : 1e9; }
+  void setMaxChi2(float chi2 = 999.) { mParams.maxChi2 = chi2; }
+  void setBz(float bz) { mBz = std::abs(bz) > o2::constants::math::Almost0 ? bz : 0.f; }
+  void setMinParamChange(float x = 1e-3) { mParams.minParamChange = x > 1e-4 ? x : 1.e-4; }
+  void setMinRelChi2Change(float r = 0.9) { mParams.minRelChi2Change = r > 0.1 ? r : 999.; }
+  void setUseAbsDCA(bool v) { mParams.useAbsDCA = v; }
+  void setMaxDistance2ToMerge(float v) { mMaxDist2ToMergeSeeds = v; }
+  void setMinXSeed(float x) { mMinXSeed = x; }
+  void setCollinear(bool isCollinear) { mIsCollinear = isCollinear; }
+
+  int getMaxIter() const { return mParams.maxIter; }
+  float getMaxR() const { return std::sqrt(mMaxR2); }
+  float getMaxDZIni() const { return mMaxDZIni; }
+  float getMaxDXYIni() const { return mMaxDXYIni; }
+  float getMaxChi2() const { return mParams.maxChi2; }
+  float getMinParamChange() const { return mParams.minParamChange; }
+  float getBz() const { return mBz; }
+  float getMaxDistance2ToMerge() const { return mMaxDist2ToMergeSeeds; }
+  bool getUseAbsDCA() const { return mParams.useAbsDCA; }
+  float getMinXSeed() const { return mMinXSeed; }
+  const DCAFitter2LanesParams& getLanesParams() const { return mParams; }
+
+ private:
+  void seedLane(int ih, int lane);
+
+  std::array<Lanes, MAXHYP> mLanes{};                  // minimization lanes for each of the crossings
+  std::array<std::array<const Track*, 2>, W> mOrigTrPtr{};
+  std::array<std::array<TrackAuxPar, 2>, W> mTrAux{};  // Aux track info of the pairs
+  std::array<CrossInfo, W> mCrossings{};               // info on tracks crossing
+  std::array<std::array<int, MAXHYP>, W> mOrder{};     // candidates of the pair ordered in quality
+  std::array<int, W> mNCand{};                         // number of candidates of the pair
+  DCAFitter2LanesParams mParams{};
+  int mNPairs = 0;
+  bool mIsCollinear = false;         // use collinear fits when there 2 crossing points
+  float mBz = 0;                     // bz field, to be set by user
+  float mMaxR2 = 200. * 200.;        // reject PCA's above this radius
+  float mMinXSeed = -50.;            // reject seed if it corresponds to X-param < mMinXSeed for one of candidates (e.g. X becomes strongly negative)
+  float mMaxDZIni = 4.;              // reject (if>0) PCA candidate if tracks DZ exceeds threshold
+  float mMaxDXYIni = 4.;             // reject (if>0) PCA candidate if tracks dXY exceeds threshold
+  float mMaxDist2ToMergeSeeds = 1.;  // merge 2 seeds to their average if their distance^2 is below the threshold
+};
+
+///_________________________________________________________________________
+template <int W>
+int DCAFitter2Batch<W>::process(const Track* const* tracks0, const Track* const* tracks1, int n)
+{
+  if (n > W) {
+    throw std::runtime_error("number of track pairs exceeds the batch size");
+  }
+  mNPairs = n;
+  for (auto& lanes : mLanes) {
+    lanes.clear();
+  }
+  for (int l = 0; l < n; l++) {
+    mNCand[l] = 0;
+    mOrigTrPtr[l] = {tracks0[l], tracks1[l]};
+    for (int i = 0; i < 2; i++) {
+      mTrAux[l][i].set(*mOrigTrPtr[l][i], mBz);
+    }
+    auto& cross = mCrossings[l];
+    if (!cross.set(mTrAux[l][0], *tracks0[l], mTrAux[l][1], *tracks1[l], mMaxDXYIni, mIsCollinear)) {
+      continue; // no crossing
+    }
+    if (cross.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
+      auto dst2 = (cross.xDCA[0] - cross.xDCA[1]) * (cross.xDCA[0] - cross.xDCA[1]) +
+                  (cross.yDCA[0] - cross.yDCA[1]) * (cross.yDCA[0] - cross.yDCA[1]);
+      if (dst2 < mMaxDist2ToMergeSeeds) {
+        cross.nDCA = 1;
+        cross.xDCA[0] = 0.5 * (cross.xDCA[0] + cross.xDCA[1]);
+        cross.yDCA[0] = 0.5 * (cross.yDCA[0] + cross.yDCA[1]);
+      }
+    }
+    for (int ic = 0; ic < cross.nDCA; ic++) {
+      if (cross.xDCA[ic] * cross.xDCA[ic] + cross.yDCA[ic] * cross.yDCA[ic] > mMaxR2) { // check if radius is acceptable
+        continue;
+      }
+      seedLane(ic, l);
+    }
+  }
+
+  mLanes[0].minimize(mParams);
+  for (int l = 0; l < n; l++) { // if the 1st crossing fit has converged to the 2nd one, the latter is fitted w/o alternative check
+    if (mLanes[0].status[l] == Lanes::Abandoned) {
+      mLanes[1].checkAlt[l] = false;
+    }
+  }
+  mLanes[1].minimize(mParams);
+
+  int nFound = 0;
+  for (int l = 0; l < n; l++) {
+    auto& order = mOrder[l];
+    int nc = 0;
+    for (int ih = 0; ih < MAXHYP; ih++) {
+      if (mLanes[ih].isLaneOK(l)) {
+        order[nc++] = ih;
+      }
+    }
+    if (nc == MAXHYP && mLanes[order[1]].chi2[l] < mLanes[order[0]].chi2[l]) { // order in quality
+      std::swap(order[0], order[1]);
+    }
+    mNCand[l] = nc;
+    nFound += nc > 0;
+  }
+  return nFound;
+}
+
+//___________________________________________________________________
+template <int W>
+void DCAFitter2Batch<W>::seedLane(int ih, int l)
+{
+  // propagate the tracks of the pair to the crossing ih and activate the corresponding lane
+  auto& lanes = mLanes[ih];
+  const auto& cross = mCrossings[l];
+  float z[2];
+  for (int i = 2; i--;) {
+    const auto& taux = mTrAux[l][i];
+    double x = taux.c * double(cross.xDCA[ih]) + taux.s * double(cross.yDCA[ih]); // X of PCA in the track frame
+    if (x < mMinXSeed) {
+      return;
+    }
+    if (mParams.useAbsDCA) {
+      o2::track::TrackPar trc(*mOrigTrPtr[l][i]);
+      if (!trc.propagateParamTo(x, mBz)) {
+        return;
+      }
+      lanes.setTrack(l, i, trc, taux.s, taux.c, mBz);
+      z[i] = trc.getZ();
+    } else {
+      Track trc(*mOrigTrPtr[l][i]);
+      if (!trc.propagateTo(x, mBz)) {
+        return;
+      }
+      lanes.setTrack(l, i, trc, taux.s, taux.c, mBz);
+      if (!lanes.setTrackCov(l, i, trc, XerrFactor)) {
+        return;
+      }
+      z[i] = trc.getZ();
+    }
+  }
+  if (mMaxDZIni > 0 && std::abs(z[0] - z[1]) > mMaxDZIni) { // apply rough cut on tracks Z difference
+    return;
+  }
+  int ihAlt = 1 - ih;
+  lanes.setSeed(l, cross.xDCA[ih], cross.yDCA[ih], cross.nDCA == MAXHYP, cross.xDCA[ihAlt], cross.yDCA[ihAlt]);
+}
+
+} // namespace vertexing
+} // namespace o2
+#endif // _ALICEO2_DCA_FITTER2_BATCH_
@@ -0,0 +1,458 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitter2Lanes.h
+/// \brief Lockstep minimization of the 2-prongs DCA of several seeded candidates, usable on the host and on the device
+/// For the formulae derivation see /afs/cern.ch/user/s/shahoian/public/O2/DCAFitter/DCAFitterN.pdf
+
+#ifndef _ALICEO2_DCA_FITTER2_LANES_
+#define _ALICEO2_DCA_FITTER2_LANES_
+
+#include "GPUCommonDef.h"
+#include "GPUCommonMath.h"
+#include "ReconstructionDataFormats/Track.h"
+
+namespace o2
+{
+namespace vertexing
+{
+
+///< settings of the minimization, flat copy of the corresponding DCAFitterN settings which can be shipped to the device
+struct DCAFitter2LanesParams {
+  int maxIter = 20;               // max number of iterations
+  float maxChi2 = 100.f;          // abs cut on chi2 or abs distance
+  float minParamChange = 1e-3f;   // stop iterations if largest change of any X is smaller than this
+  float minRelChi2Change = 0.9f;  // stop iterations is chi2/chi2old > this
+  float xerrFactor = 5.f;         // factor for conversion of track covYY to dummy covXX
+  bool useAbsDCA = false;         // use abs. distance minimization rather than chi2
+};
+
+///__________________________________________________________________________________
+///< Newton minimization of the 2-prongs DCA for W candidates (lanes) in structure-of-arrays layout.
+///< This is the DCAFitterN<2> minimizeChi2 / minimizeChi2NoErr with constant field (no Propagator, no material corrections):
+///< every lane is set from the tracks already propagated to its seed (2D crossing) point, after which the iterations need
+///< only the track positions, the inverse position errors and the 1st and 2nd track derivatives at the seed, which stay
+///< constant, therefore all the matrices which do not depend on the residuals are calculated once per lane.
+///< All lanes are iterated in lockstep, a lane which has converged, failed or moved towards the alternative seed is masked,
+///< so that every loop over the lanes is branch-free and can be vectorized by the compiler.
+///< On the device a single candidate per thread is fitted with W = 1.
+template <int W>
+struct DCAFitter2Lanes {
+  static constexpr int NLanes = W;
+  static constexpr double NInv = 0.5;
+  enum LaneStatus : int { Idle = 0,  // lane is not used
+                          Active,    // iterations are ongoing
+                          Converged, // minimization succeded, chi2 is below the cut
+                          Failed,    // invalid input, singular matrices or chi2 above the cut
+                          Abandoned  // the fit converged to alternative seed
+  };
+
+  float c[2][W], s[2][W];                                // cos and sin of tracks alpha
+  float dydx[2][W], dzdx[2][W], d2ydx2[2][W], d2zdx2[2][W]; // track derivatives over X param at the seed, see TrackDeriv
+  float sxx[2][W], syy[2][W], syz[2][W], szz[2][W];       // inverse cov matrix of the track position, see TrackCovI
+  float xCur[W], yCur[W], xAlt[W], yAlt[W];               // seed and alternative seed XY
+  bool checkAlt[W];                                       // abandon the lane if the PCA gets closer to the alternative seed
+
+  double pos[2][3][W];     // track positions
+  double res[2][3][W];     // track residuals
+  double pca[3][W];        // PCA
+  double coef[2][3][3][W]; // TrackCoefVtx of the weighted PCA = sum_i coef_i * pos_i
+  double gv[2][2][3][W];   // dchi2/dx_i = sum_j { res_j * gv_ij }
+  double hv[3][3][W];      // residual-dependent part of d2chi2/dx_i/dx_j for (0,0),(1,0),(1,1), multiplied by res_0,res_0|res_1,res_1
+  double hc[3][W];         // constant part of d2chi2/dx_i/dx_j for (0,0),(1,0),(1,1)
+  float chi2[W];           // chi2 at the PCA, normalized to the number of prongs on completion
+  int nIter[W];            // number of iterations
+  int status[W];           // LaneStatus
+
+  GPUd() void clear()
+  {
+    for (int l = 0; l < W; l++) {
+      status[l] = Idle;
+      nIter[l] = 0;
+      chi2[l] = -1.f;
+    }
+  }
+
+  ///< set the track i of the lane, propagated to its seed point, together with the sin and cos of its alpha
+  template <typename T>
+  GPUd() void setTrack(int l, int i, const T& trc, float sna, float csa, float bz)
+  {
+    c[i][l] = csa;
+    s[i][l] = sna;
+    pos[i][0][l] = trc.getX();
+    pos[i][1][l] = trc.getY();
+    pos[i][2][l] = trc.getZ();
+    float snp = trc.getSnp(), csp = o2::gpu::CAMath::Sqrt((1.f - snp) * (1.f + snp)), cspI = 1.f / csp, crv2c = trc.getCurvature(bz) * cspI;
+    dydx[i][l] = snp * cspI;                    // = snp/csp
+    dzdx[i][l] = trc.getTgl() * cspI;           // = tgl/csp
+    d2ydx2[i][l] = crv2c * cspI * cspI;         // = crv/csp^3
+    d2zdx2[i][l] = crv2c * dzdx[i][l] * dydx[i][l]; // = crv*tgl*snp/csp^3
+  }
+
+  ///< set the inverse cov matrix of the track i of the lane at its seed point (needed for the weighted minimization only),
+  ///< the lane is failed if the covariance is not positive
+  GPUd() bool setTrackCov(int l, int i, const o2::track::TrackParCov& trc, float xerrFactor)
+  {
+    // we assign Y error to X for DCA calculation
+    // (otherwise for quazi-collinear tracks the X will not be constrained)
+    float cyy = trc.getSigmaY2(), czz = trc.getSigmaZ2(), cyz = trc.getSigmaZY(), cxx = cyy * xerrFactor;
+    float detYZ = cyy * czz - cyz * cyz;
+    if (!(detYZ > 0.f)) {
+      status[l] = Failed;
+      return false;
+    }
+    auto detYZI = 1.f / detYZ;
+    sxx[i][l] = 1.f / cxx;
+    syy[i][l] = czz * detYZI;
+    syz[i][l] = -cyz * detYZI;
+    szz[i][l] = cyy * detYZI;
+    return true;
+  }
+
+  ///< activate the lane with its seed and, if checkA is set, the alternative seed
+  GPUd() void setSeed(int l, float x, float y, bool checkA = false, float xA = 0.f, float yA = 0.f)
+  {
+    xCur[l] = x;
+    yCur[l] = y;
+    checkAlt[l] = checkA;
+    xAlt[l] = xA;
+    yAlt[l] = yA;
+    nIter[l] = 0;
+    chi2[l] = -1.f;
+    status[l] = Active;
+  }
+
+  GPUd() bool isLaneOK(int l) const { return status[l] == Converged; }
+
+  ///< minimize all active lanes, return the number of converged ones
+  GPUd() int minimize(const DCAFitter2LanesParams& par)
+  {
+    if (par.useAbsDCA) {
+      prepareNoErr();
+    } else {
+      prepare();
+    }
+    int nActive = 0;
+    for (int l = 0; l < W; l++) {
+      nActive += status[l] == Active;
+    }
+    while (nActive) {
+      nActive = par.useAbsDCA ? iterate<true>(par) : iterate<false>(par);
+    }
+    int nOK = 0;
+    for (int l = 0; l < W; l++) {
+      if (status[l] == Converged) {
+        chi2[l] = chi2[l] * NInv;
+        if (!(chi2[l] < par.maxChi2)) {
+          status[l] = Failed;
+        }
+      }
+      nOK += status[l] == Converged;
+    }
+    return nOK;
+  }
+
+ private:
+  // PCA and residuals helpers are written without inner loops, so that the loops over the lanes can be vectorized
+  template <bool AbsDCA>
+  GPUdi() void calcPCA(int l, const double (&p)[2][3], double (&v)[3]) const
+  {
+    if constexpr (AbsDCA) { // mean of the track points in the lab, see calcPCANoErr
+      double c1 = c[1][l], s1 = s[1][l], c0 = c[0][l], s0 = s[0][l];
+      v[0] = ((p[1][0] * c1 - p[1][1] * s1) + (p[0][0] * c0 - p[0][1] * s0)) * NInv;
+      v[1] = ((p[1][0] * s1 + p[1][1] * c1) + (p[0][0] * s0 + p[0][1] * c0)) * NInv;
+      v[2] = (p[1][2] + p[0][2]) * NInv;
+    } else { // V = sum_i Ti pi, see calcPCA
+      v[0] = (coef[1][0][0][l] * p[1][0] + coef[1][0][1][l] * p[1][1] + coef[1][0][2][l] * p[1][2]) +
+             (coef[0][0][0][l] * p[0][0] + coef[0][0][1][l] * p[0][1] + coef[0][0][2][l] * p[0][2]);
+      v[1] = (coef[1][1][0][l] * p[1][0] + coef[1][1][1][l] * p[1][1] + coef[1][1][2][l] * p[1][2]) +
+             (coef[0][1][0][l] * p[0][0] + coef[0][1][1][l] * p[0][1] + coef[0][1][2][l] * p[0][2]);
+      v[2] = (coef[1][2][0][l] * p[1][0] + coef[1][2][1][l] * p[1][1] + coef[1][2][2][l] * p[1][2]) +
+             (coef[0][2][0][l] * p[0][0] + coef[0][2][1][l] * p[0][1] + coef[0][2][2][l] * p[0][2]);
+    }
+  }
+
+  template <bool AbsDCA>
+  GPUdi() double calcResiduals(int l, int i, const double (&p)[2][3], const double (&v)[3], double (&r)[2][3]) const
+  {
+    double ci = c[i][l], si = s[i][l];
+    r[i][0] = p[i][0] - (v[0] * ci + v[1] * si); // glo->loc
+    r[i][1] = p[i][1] - (v[1] * ci - v[0] * si);
+    r[i][2] = p[i][2] - v[2];
+    if constexpr (AbsDCA) {
+      return r[i][0] * r[i][0] + r[i][1] * r[i][1] + r[i][2] * r[i][2];
+    } else {
+      return r[i][0] * r[i][0] * sxx[i][l] + r[i][1] * r[i][1] * syy[i][l] + r[i][2] * r[i][2] * szz[i][l] + 2. * r[i][1] * r[i][2] * syz[i][l];
+    }
+  }
+
+  template <bool AbsDCA>
+  GPUdi() float calcResiduals(int l, const double (&p)[2][3], const double (&v)[3], double (&r)[2][3]) const
+  {
+    double chi2L = calcResiduals<AbsDCA>(l, 1, p, v, r);
+    return chi2L + calcResiduals<AbsDCA>(l, 0, p, v, r);
+  }
+
+  GPUdi() double dotGV(int l, int i, int j, const double (&r)[2][3]) const
+  {
+    return r[j][0] * gv[i][j][0][l] + r[j][1] * gv[i][j][1][l] + r[j][2] * gv[i][j][2][l];
+  }
+
+  GPUdi() double calcHessian(int l, int ih, const double (&rh)[3]) const
+  {
+    return hc[ih][l] + rh[0] * hv[ih][0][l] + rh[1] * hv[ih][1][l] + rh[2] * hv[ih][2][l];
+  }
+
+  GPUdi() void updateLane(int l, bool upd, const double (&p)[2][3], const double (&r)[2][3], const double (&v)[3])
+  {
+#define _UPD_LANE_(K)                                \
+  pos[0][K][l] = upd ? p[0][K] : pos[0][K][l]; \
+  pos[1][K][l] = upd ? p[1][K] : pos[1][K][l]; \
+  res[0][K][l] = upd ? r[0][K] : res[0][K][l]; \
+  res[1][K][l] = upd ? r[1][K] : res[1][K][l]; \
+  pca[K][l] = upd ? v[K] : pca[K][l];
+    _UPD_LANE_(0);
+    _UPD_LANE_(1);
+    _UPD_LANE_(2);
+#undef _UPD_LANE_
+  }
+
+  GPUdi() void correctTrack(int l, int i, double dx, double (&p)[2][3]) const
+  {
+    double dx2h = 0.5 * dx * dx;
+    p[i][0] = pos[i][0][l] - dx;
+    p[i][1] = pos[i][1][l] - (dydx[i][l] * dx - dx2h * d2ydx2[i][l]);
+    p[i][2] = pos[i][2][l] - (dzdx[i][l] * dx - dx2h * d2zdx2[i][l]);
+  }
+
+  template <bool AbsDCA>
+  GPUdi() void initLane(int l)
+  {
+    double p[2][3], v[3], r[2][3];
+    for (int i = 0; i < 2; i++) {
+      for (int k = 0; k < 3; k++) {
+        p[i][k] = pos[i][k][l];
+      }
+    }
+    calcPCA<AbsDCA>(l, p, v);
+    chi2[l] = calcResiduals<AbsDCA>(l, p, v, r);
+    for (int k = 0; k < 3; k++) {
+      pca[k][l] = v[k];
+      res[0][k][l] = r[0][k];
+      res[1][k][l] = r[1][k];
+    }
+  }
+
+  ///< store the chi2 derivatives coefficients which do not depend on the residuals
+  GPUdi() void setDerivatives(int l, const double (&dr1)[2][2][3], const double (&dr2)[2][2][3], bool absDCA)
+  {
+    // vectors of dres_j/dx_i, multiplied by covI_j in the weighted mode, see calcChi2Derivatives and calcChi2DerivativesNoErr
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 2; j++) {
+        const auto& d = dr1[j][i];
+        if (absDCA) {
+          gv[i][j][0][l] = d[0];
+          gv[i][j][1][l] = d[1];
+          gv[i][j][2][l] = d[2];
+        } else {
+          gv[i][j][0][l] = sxx[j][l] * d[0];
+          gv[i][j][1][l] = syy[j][l] * d[1] + syz[j][l] * d[2];
+          gv[i][j][2][l] = syz[j][l] * d[1] + szz[j][l] * d[2];
+        }
+      }
+    }
+    constexpr int HI[3] = {0, 1, 1}, HJ[3] = {0, 0, 1};
+    for (int h = 0; h < 3; h++) {
+      int i = HI[h], j = HJ[h];
+      double sum = 0.; // sum_k { Dres_k/Dx_j * gv_ik }
+      for (int k = 2; k--;) {
+        const auto& dk = dr1[k][j];
+        sum += dk[0] * gv[i][k][0][l] + dk[1] * gv[i][k][1][l] + dk[2] * gv[i][k][2][l];
+      }
+      hc[h][l] = sum;
+      if (absDCA) { // res_i * D2res_i/Dx_i/Dx_j
+        for (int k = 0; k < 3; k++) {
+          hv[h][k][l] = dr2[i][j][k];
+        }
+      } else { // res_j * covI_j * D2res_j/Dx_j^2
+        const auto& d = dr2[j][j];
+        hv[h][0][l] = sxx[j][l] * d[0];
+        hv[h][1][l] = syy[j][l] * d[1] + syz[j][l] * d[2];
+        hv[h][2][l] = syz[j][l] * d[1] + szz[j][l] * d[2];
+      }
+    }
+  }
+
+  ///< prepare the weighted minimization: Ti matrices of the PCA and derivatives of the residuals, see calcPCACoefs and calcResidDerivatives
+  GPUd() void prepare()
+  {
+    for (int l = 0; l < W; l++) {
+      if (status[l] != Active) {
+        continue;
+      }
+      // [sum_{0<j<N} M_j*E_j*M_j^T]^-1
+      double xx = 0., xy = 0., yy = 0., xz = 0., yz = 0., zz = 0.;
+      for (int i = 2; i--;) {
+        float ci = c[i][l], si = s[i][l], cc = ci * ci, ss = si * si, cs = ci * si;
+        xx += cc * sxx[i][l] + ss * syy[i][l];
+        xy += cs * (sxx[i][l] - syy[i][l]);
+        xz += -si * syz[i][l];
+        yy += cc * syy[i][l] + ss * sxx[i][l];
+        yz += ci * syz[i][l];
+        zz += szz[i][l];
+      }
+      double wi[3][3];
+      wi[0][0] = yy * zz - yz * yz;
+      wi[1][0] = xz * yz - xy * zz;
+      wi[2][0] = xy * yz - xz * yy;
+      double det = xx * wi[0][0] + xy * wi[1][0] + xz * wi[2][0];
+      if (det == 0.) {
+        status[l] = Failed;
+        continue;
+      }
+      double detI = 1. / det;
+      wi[1][1] = xx * zz - xz * xz;
+      wi[2][1] = xy * xz - xx * yz;
+      wi[2][2] = xx * yy - xy * xy;
+      wi[0][0] *= detI;
+      wi[1][0] *= detI;
+      wi[2][0] *= detI;
+      wi[1][1] *= detI;
+      wi[2][1] *= detI;
+      wi[2][2] *= detI;
+      wi[0][1] = wi[1][0];
+      wi[0][2] = wi[2][0];
+      wi[1][2] = wi[2][1];
+      for (int i = 2; i--;) { // Ti = Winv * Mi*Ei
+        float ci = c[i][l], si = s[i][l];
+        double miei[3][3] = {{ci * sxx[i][l], -si * syy[i][l], -si * syz[i][l]},
+                             {si * sxx[i][l], ci * syy[i][l], ci * syz[i][l]},
+                             {0., syz[i][l], szz[i][l]}};
+        for (int r = 0; r < 3; r++) {
+          for (int k = 0; k < 3; k++) {
+            coef[i][r][k][l] = wi[r][0] * miei[0][k] + wi[r][1] * miei[1][k] + wi[r][2] * miei[2][k];
+          }
+        }
+      }
+      double dr1[2][2][3], dr2[2][2][3];
+      for (int i = 2; i--;) { // residual being differentiated
+        double ci = c[i][l], si = s[i][l];
+        for (int j = 2; j--;) { // track over which we differentiate
+          double mt[3][3];      // M_i^tr * T_j
+          for (int k = 0; k < 3; k++) {
+            mt[0][k] = ci * coef[j][0][k][l] + si * coef[j][1][k][l];
+            mt[1][k] = -si * coef[j][0][k][l] + ci * coef[j][1][k][l];
+            mt[2][k] = coef[j][2][k][l];
+          }
+          double dydxj = dydx[j][l], dzdxj = dzdx[j][l], d2ydx2j = d2ydx2[j][l], d2zdx2j = d2zdx2[j][l];
+          for (int k = 0; k < 3; k++) {
+            // DResid_i/Dx_j = (delta_ij - M_i^tr * T_j) * DTrack_k/Dx_k
+            dr1[i][j][k] = -(mt[k][0] + mt[k][1] * dydxj + mt[k][2] * dzdxj);
+            // D2Resid_I/(Dx_J Dx_K) = (delta_ijk - M_i^tr * T_j * delta_jk) * D2Track_k/dx_k^2
+            dr2[i][j][k] = -(mt[k][1] * d2ydx2j + mt[k][2] * d2zdx2j);
+          }
+          if (i == j) {
+            dr1[i][j][0] += 1.;
+            dr1[i][j][1] += dydxj;
+            dr1[i][j][2] += dzdxj;
+            dr2[i][j][1] += d2ydx2j;
+            dr2[i][j][2] += d2zdx2j;
+          }
+        }
+      }
+      setDerivatives(l, dr1, dr2, false);
+      initLane<false>(l);
+    }
+  }
+
+  ///< prepare the abs. distance minimization: derivatives of the residuals, see calcRMatrices and calcResidDerivativesNoErr
+  GPUd() void prepareNoErr()
+  {
+    constexpr double NInv1 = 1. - NInv; // profit from Rii = I/Ninv
+    for (int l = 0; l < W; l++) {
+      if (status[l] != Active) {
+        continue;
+      }
+      double dr1[2][2][3], dr2[2][2][3];
+      for (int i = 2; i--;) {
+        dr1[i][i][0] = NInv1;
+        dr1[i][i][1] = NInv1 * dydx[i][l];
+        dr1[i][i][2] = NInv1 * dzdx[i][l];
+        dr2[i][i][0] = 0.;
+        dr2[i][i][1] = NInv1 * d2ydx2[i][l];
+        dr2[i][i][2] = NInv1 * d2zdx2[i][l];
+      }
+      // M_1^T*M_0 / N matrix non-trivial elements = {c1*c0+s1*s0 , s1*c0-c1*s0 }
+      double cij = (c[1][l] * c[0][l] + s[1][l] * s[0][l]) * NInv, sij = (s[1][l] * c[0][l] - c[1][l] * s[0][l]) * NInv;
+      dr1[1][0][0] = -(cij + sij * dydx[0][l]);
+      dr1[1][0][1] = -(-sij + cij * dydx[0][l]);
+      dr1[1][0][2] = -dzdx[0][l] * NInv;
+      dr1[0][1][0] = -(cij - sij * dydx[1][l]);
+      dr1[0][1][1] = -(sij + cij * dydx[1][l]);
+      dr1[0][1][2] = -dzdx[1][l] * NInv;
+      dr2[1][0][0] = -sij * d2ydx2[0][l];
+      dr2[1][0][1] = -cij * d2ydx2[0][l];
+      dr2[1][0][2] = -d2zdx2[0][l] * NInv;
+      dr2[0][1][0] = sij * d2ydx2[1][l];
+      dr2[0][1][1] = -cij * d2ydx2[1][l];
+      dr2[0][1][2] = -d2zdx2[1][l] * NInv;
+      setDerivatives(l, dr1, dr2, true);
+      initLane<true>(l);
+    }
+  }
+
+  ///< single Newton-Raphson iteration of all active lanes, return the number of lanes still active
+  template <bool AbsDCA>
+  GPUd() int iterate(const DCAFitter2LanesParams& par)
+  {
+    const double minParamChange = par.minParamChange;
+    const float minRelChi2Change = par.minRelChi2Change;
+    const int maxIter = par.maxIter; // local copies, so that the lanes loop does not need alias checks
+    int nActive = 0;
+    for (int l = 0; l < W; l++) {
+      bool act = status[l] == Active;
+      double r[2][3] = {{res[0][0][l], res[0][1][l], res[0][2][l]}, {res[1][0][l], res[1][1][l], res[1][2][l]}}, p[2][3], v[3];
+      double g0 = dotGV(l, 0, 1, r) + dotGV(l, 0, 0, r), g1 = dotGV(l, 1, 1, r) + dotGV(l, 1, 0, r);
+      double h00 = calcHessian(l, 0, r[0]), h10 = calcHessian(l, 1, r[AbsDCA ? 1 : 0]), h11 = calcHessian(l, 2, r[1]);
+      // corrections = - dchi2/d{x0,x1} * [ d^2chi2/d{x0,x1}^2 ]^-1
+      double det = h00 * h11 - h10 * h10;
+      bool inverted = det != 0.;
+      double detI = 1. / (inverted ? det : 1.);
+      double dx0 = detI * (h11 * g0 - h10 * g1), dx1 = detI * (h00 * g1 - h10 * g0);
+      correctTrack(l, 0, dx0, p); // propagate tracks to updated X
+      correctTrack(l, 1, dx1, p);
+      calcPCA<AbsDCA>(l, p, v);
+      double dxCur = v[0] - xCur[l], dyCur = v[1] - yCur[l], dxAlt = v[0] - xAlt[l], dyAlt = v[1] - yAlt[l];
+      bool abandon = checkAlt[l] & (dxCur * dxCur + dyCur * dyCur > dxAlt * dxAlt + dyAlt * dyAlt);
+      float chi2Upd = calcResiduals<AbsDCA>(l, p, v, r);
+      double adx0 = dx0 < 0. ? -dx0 : dx0, adx1 = dx1 < 0. ? -dx1 : dx1;
+      bool converged = ((adx0 > adx1 ? adx0 : adx1) < minParamChange) | (chi2Upd > chi2[l] * minRelChi2Change);
+
+      // masked update, the lanes which are not active keep their state
+      bool upd = act & inverted & !abandon;
+      updateLane(l, upd, p, r, v);
+      chi2[l] = upd ? chi2Upd : chi2[l];
+      int nit = nIter[l] + (upd & !converged);
+      nIter[l] = nit;
+      int st = (converged | (nit >= maxIter)) ? Converged : Active;
+      st = abandon ? Abandoned : st;
+      st = inverted ? st : Failed;
+      st = act ? st : status[l];
+      status[l] = st;
+      nActive += st == Active;
+    }
+    return nActive;
+  }
+};
+
+} // namespace vertexing
+} // namespace o2
+#endif // _ALICEO2_DCA_FITTER2_LANES_
@@ -0,0 +1,108 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchDCAFitter2Batch.cxx
+/// \brief Benchmark of the 2-prong vertex fit: scalar DCAFitterN<2> vs lockstep DCAFitter2Batch
+
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+#include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitter2Batch.h"
+
+namespace
+{
+constexpr float Bz = 5.f;
+constexpr int NPairs = 4096;
+
+// pairs of opposite charge tracks from V0 decays at R = 10 cm, smeared within their errors
+void generatePairs(std::vector<o2::track::TrackParCov>& trk0, std::vector<o2::track::TrackParCov>& trk1)
+{
+  const float errYZ = 1e-2, errSlp = 1e-3, errQPT = 2e-2;
+  std::array<float, 15> covm = {
+    errYZ * errYZ,
+    0., errYZ * errYZ,
+    0, 0., errSlp * errSlp,
+    0., 0., 0., errSlp * errSlp,
+    0., 0., 0., 0., errQPT * errQPT};
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> uni(0.f, 1.f);
+  std::normal_distribution<float> gaus(0.f, 1.f);
+  trk0.clear();
+  trk1.clear();
+  for (int ip = 0; ip < NPairs; ip++) {
+    float phiV0 = uni(gen) * o2::constants::math::TwoPI, zV0 = (uni(gen) - 0.5f) * 20.f;
+    float xV0 = 10.f * std::cos(phiV0), yV0 = 10.f * std::sin(phiV0);
+    for (int i = 0; i < 2; i++) {
+      float phi = phiV0 + (uni(gen) - 0.5f) * 0.6f, s, c, x;
+      std::array<float, 5> params;
+      o2::math_utils::sincos(phi, s, c);
+      o2::math_utils::rotateZInv(xV0, yV0, x, params[0], s, c);
+      params[1] = zV0 + errYZ * gaus(gen);
+      params[0] += errYZ * gaus(gen);
+      params[2] = errSlp * gaus(gen);
+      params[3] = (uni(gen) - 0.5f) * 2.f + errSlp * gaus(gen);
+      params[4] = (i ? -1.f : 1.f) / (0.2f + uni(gen) * 3.f);
+      covm[14] = errQPT * errQPT * params[4] * params[4];
+      params[4] *= 1.f + errQPT * gaus(gen);
+      auto& trc = (i ? trk1 : trk0).emplace_back(x, phi, params, covm);
+      trc.propagateTo(trc.getX() + (uni(gen) - 0.5f) * 2.f, Bz);
+    }
+  }
+}
+} // namespace
+
+static void BM_DCAFitterN2(benchmark::State& state)
+{
+  std::vector<o2::track::TrackParCov> trk0, trk1;
+  generatePairs(trk0, trk1);
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(Bz);
+  ft.setPropagateToPCA(false);
+  ft.setUseAbsDCA(state.range(0));
+  int ncand = 0;
+  for (auto _ : state) {
+    for (int ip = 0; ip < NPairs; ip++) {
+      ncand += ft.process(trk0[ip], trk1[ip]);
+    }
+  }
+  benchmark::DoNotOptimize(ncand);
+  state.SetItemsProcessed(state.iterations() * NPairs);
+}
+
+template <int W>
+static void BM_DCAFitter2Batch(benchmark::State& state)
+{
+  std::vector<o2::track::TrackParCov> trk0, trk1;
+  generatePairs(trk0, trk1);
+  std::vector<const o2::track::TrackParCov*> ptr0, ptr1;
+  for (int ip = 0; ip < NPairs; ip++) {
+    ptr0.push_back(&trk0[ip]);
+    ptr1.push_back(&trk1[ip]);
+  }
+  o2::vertexing::DCAFitter2Batch<W> ft(Bz, state.range(0));
+  int ncand = 0;
+  for (auto _ : state) {
+    for (int ip = 0; ip < NPairs; ip += W) {
+      ncand += ft.process(&ptr0[ip], &ptr1[ip], std::min(W, NPairs - ip));
+    }
+  }
+  benchmark::DoNotOptimize(ncand);
+  state.SetItemsProcessed(state.iterations() * NPairs);
+}
+
+// argument: use absolute DCA minimization (1) or the weighted one (0)
+BENCHMARK(BM_DCAFitterN2)->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, 4)->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, 8)->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, 16)->Arg(1)->Arg(0)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
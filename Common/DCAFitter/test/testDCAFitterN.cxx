@@ -15,6 +15,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitter2Batch.h"
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TRandom.h>
 #include <TGenPhaseSpace.h>
@@ -552,5 +553,82 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+BOOST_AUTO_TEST_CASE(DCAFitter2BatchVsScalar)
+{
+  constexpr int NTest = 10000, W = 8;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<o2::track::TrackParCov> vctracks, trk0(NTest), trk1(NTest);
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (int iev = 0; iev < NTest; iev++) {
+    generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+    trk0[iev] = vctracks[0];
+    trk1[iev] = vctracks[1];
+  }
+
+  for (bool useAbs : {true, false}) {
+    o2::vertexing::DCAFitterN<2> ft; // scalar reference, the batch fitter does not propagate the tracks to the PCA
+    ft.setBz(bz);
+    ft.setPropagateToPCA(false);
+    ft.setUseAbsDCA(useAbs);
+    o2::vertexing::DCAFitter2Batch<W> ftb(bz, useAbs);
+
+    std::vector<int> ncS(NTest), ncB(NTest);
+    std::vector<std::array<float, 3>> pcaS(NTest), pcaB(NTest);
+    std::vector<float> chi2S(NTest), chi2B(NTest);
+    TStopwatch swS, swB;
+    for (int iev = 0; iev < NTest; iev++) {
+      ncS[iev] = ft.process(trk0[iev], trk1[iev]);
+      if (ncS[iev]) {
+        const auto& pca = ft.getPCACandidate();
+        pcaS[iev] = {float(pca[0]), float(pca[1]), float(pca[2])};
+        chi2S[iev] = ft.getChi2AtPCACandidate();
+      }
+    }
+    swS.Stop();
+    swB.Start();
+    std::array<const o2::track::TrackParCov*, W> ptr0, ptr1;
+    for (int iev0 = 0; iev0 < NTest; iev0 += W) {
+      int n = std::min(W, NTest - iev0);
+      for (int l = 0; l < n; l++) {
+        ptr0[l] = &trk0[iev0 + l];
+        ptr1[l] = &trk1[iev0 + l];
+      }
+      ftb.process(ptr0.data(), ptr1.data(), n);
+      for (int l = 0; l < n; l++) {
+        ncB[iev0 + l] = ftb.getNCandidates(l);
+        if (ncB[iev0 + l]) {
+          pcaB[iev0 + l] = ftb.getPCACandidatePos(l);
+          chi2B[iev0 + l] = ftb.getChi2AtPCACandidate(l);
+        }
+      }
+    }
+    swB.Stop();
+
+    int nfound = 0, nMismatch = 0;
+    for (int iev = 0; iev < NTest; iev++) {
+      if (ncS[iev] != ncB[iev]) {
+        nMismatch++;
+        continue;
+      }
+      if (ncS[iev]) {
+        nfound++;
+        for (int j = 0; j < 3; j++) {
+          BOOST_CHECK_SMALL(pcaS[iev][j] - pcaB[iev][j], 1e-4f);
+        }
+        BOOST_CHECK_SMALL((chi2S[iev] - chi2B[iev]) / std::max(chi2S[iev], 1e-3f), 1e-4f);
+      }
+    }
+    LOG(info) << "2-prongs with " << (useAbs ? "abs" : "wgh") << ".dist minimization, scalar vs batch of " << W << ": found " << nfound << " of " << NTest
+              << ", mismatches: " << nMismatch << ", scalar: " << NTest / swS.CpuTime() << " pairs/s, batch: " << NTest / swB.CpuTime() << " pairs/s";
+    BOOST_CHECK(nfound > 0.99 * NTest);
+    BOOST_CHECK(nMismatch == 0);
+  }
+}
+
 } // namespace vertexing
 } // namespace o2
@@ -114,6 +114,10 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Field at np points, point containing their consecutive coordinates and bField receiving
+  /// their consecutive field components, the points of the measured map being evaluated together
+  void Field(int np, const Double_t* __restrict__ point, Double_t* __restrict__ bField);
+
   void field(const math_utils::Point3D<float> xyz, float bxyz[3])
   {
     double xyzd[3] = {xyz.X(), xyz.Y(), xyz.Z()}, bxyzd[3] = {0};
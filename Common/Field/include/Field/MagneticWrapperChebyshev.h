@@ -210,6 +210,11 @@ class MagneticWrapperChebyshev : public TNamed
   /// it gets it at closest valid point
   virtual void Field(const Double_t* xyz, Double_t* b) const;
 
+  /// Computes field in cartesian coordinates for np points, xyz containing their consecutive coordinates
+  /// and b receiving their consecutive field components. The parameterization of the previous point, e.g. along
+  /// a track, is tried first and the consecutive points of the same parameterization are evaluated together
+  void Field(Int_t np, const Double_t* xyz, Double_t* b) const;
+
   /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
   /// it gets it at closest valid point
   Double_t getBz(const Double_t* xyz) const;
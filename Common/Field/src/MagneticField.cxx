@@ -17,6 +17,7 @@
 #include <TFile.h>      // for TFile
 #include <TPRegexp.h>   // for TPRegexp
 #include <TSystem.h>    // for TSystem, gSystem
+#include <vector>       // for vector
 #include <fairlogger/Logger.h> // for FairLogger
 #include "FairParamList.h"
 #include "FairRun.h"
@@ -286,6 +287,43 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(int np, const Double_t* __restrict__ xyz, Double_t* __restrict__ b)
+{
+  /*
+   * query field values at np points, given as consecutive triplets of coordinates;
+   * the points of the measured map are evaluated together
+   */
+
+  thread_local std::vector<Double_t> mapXYZ, mapB;
+  thread_local std::vector<int> mapIndex;
+  mapXYZ.clear();
+  mapIndex.clear();
+  for (int ip = 0; ip < np; ip++) {
+    const Double_t* point = xyz + 3 * ip;
+    if (mFastField && mFastField->Field(point, b + 3 * ip)) {
+      continue;
+    }
+    if (mMeasuredMap && point[2] > mMeasuredMap->getMinZ() && point[2] < mMeasuredMap->getMaxZ()) {
+      mapXYZ.insert(mapXYZ.end(), point, point + 3);
+      mapIndex.push_back(ip);
+    } else {
+      MachineField(point, b + 3 * ip);
+    }
+  }
+  if (mapIndex.empty()) {
+    return;
+  }
+
+  mapB.resize(mapXYZ.size());
+  mMeasuredMap->Field(mapIndex.size(), mapXYZ.data(), mapB.data());
+  for (size_t i = 0; i < mapIndex.size(); i++) {
+    double factor = (mapXYZ[3 * i + 2] > sSolenoidToDipoleZ || mDipoleOnOffFlag) ? mMultipicativeFactorSolenoid : mMultipicativeFactorDipole;
+    for (int k = 3; k--;) {
+      b[3 * mapIndex[i] + k] = mapB[3 * i + k] * factor;
+    }
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
@@ -17,6 +17,7 @@
 #include <TArrayF.h>    // for TArrayF
 #include <TArrayI.h>    // for TArrayI
 #include <TSystem.h>    // for TSystem, gSystem
+#include <algorithm>    // for copy_n
 #include <cstdio>       // for printf, fprintf, fclose, fopen, FILE
 #include <cstring>      // for memcpy
 #include <fairlogger/Logger.h> // for FairLogger
@@ -445,6 +446,78 @@ void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(Int_t np, const Double_t* xyz, Double_t* b) const
+{
+  // The points are accumulated while they belong to the same parameterization, which is tried
+  // first for the next point before searching for its segment, and evaluated together
+  constexpr int batch = o2::math_utils::Chebyshev3DCalc::MaxBatchSize;
+  Double_t par[3 * batch], bpar[3 * batch];
+  Int_t index[batch];
+  int nBatch = 0;
+  Chebyshev3D* batchPar = nullptr;
+  bool batchCylindrical = false;
+  Chebyshev3D* lastSolenoid = nullptr;
+  Chebyshev3D* lastDipole = nullptr;
+
+  auto flush = [&]() {
+    if (nBatch == 0) {
+      return;
+    }
+    batchPar->Eval(nBatch, par, bpar);
+    for (int i = 0; i < nBatch; i++) {
+      if (batchCylindrical) {
+        // convert field to cartesian system
+        cylindricalToCartesianCylB(par + 3 * i, bpar + 3 * i, b + 3 * index[i]);
+      } else {
+        std::copy_n(bpar + 3 * i, 3, b + 3 * index[i]);
+      }
+    }
+    nBatch = 0;
+  };
+
+  for (int ip = 0; ip < np; ip++) {
+    const Double_t* point = xyz + 3 * ip;
+    Double_t coord[3];
+    Chebyshev3D* pointPar = nullptr;
+    bool cylindrical = point[2] > mMinZSolenoid;
+    if (cylindrical) {
+      cartesianToCylindrical(point, coord);
+      if (lastSolenoid && lastSolenoid->isInside(coord)) {
+        pointPar = lastSolenoid;
+      } else {
+        int id = findSolenoidSegment(coord);
+        pointPar = id < 0 ? nullptr : getParameterSolenoid(id);
+      }
+    } else {
+      std::copy_n(point, 3, coord);
+      if (lastDipole && lastDipole->isInside(coord)) {
+        pointPar = lastDipole;
+      } else {
+        int id = findDipoleSegment(coord);
+        pointPar = id < 0 ? nullptr : getParameterDipole(id);
+      }
+    }
+#ifndef _BRING_TO_BOUNDARY_ // exact matching to fitted volume is requested
+    if (pointPar && !pointPar->isInside(coord)) {
+      pointPar = nullptr;
+    }
+#endif
+    if (!pointPar) {
+      b[3 * ip] = b[3 * ip + 1] = b[3 * ip + 2] = 0;
+      continue;
+    }
+    (cylindrical ? lastSolenoid : lastDipole) = pointPar;
+    if (pointPar != batchPar || nBatch == batch) {
+      flush();
+      batchPar = pointPar;
+      batchCylindrical = cylindrical;
+    }
+    std::copy_n(coord, 3, par + 3 * nBatch);
+    index[nBatch++] = ip;
+  }
+  flush();
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t* xyz) const
 {
   Double_t rphiz[3];
@@ -17,6 +17,7 @@
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
 #include <memory>
+#include <vector>
 #include <fairlogger/Logger.h> // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -98,3 +99,64 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticField_batch_test)
+{
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+
+  // points along straight tracks from the vertex, as queried during the propagation
+  const int ntrk = 200, nstep = 100;
+  const int ntst = ntrk * nstep;
+  std::vector<double> xyz(3 * ntst), bxyz(3 * ntst), bbatch(3 * ntst);
+  float rnd[3];
+  for (int itr = 0; itr < ntrk; itr++) {
+    gRandom->RndmArray(3, rnd);
+    double phi = rnd[0] * TMath::Pi() * 2, tgl = (rnd[1] - 0.5) * 2, step = 2. + 2. * rnd[2];
+    for (int is = 0; is < nstep; is++) {
+      double* p = &xyz[3 * (itr * nstep + is)];
+      p[0] = is * step * TMath::Cos(phi);
+      p[1] = is * step * TMath::Sin(phi);
+      p[2] = is * step * tgl;
+    }
+  }
+
+  const int repFactor = 20;
+  TStopwatch swPoint;
+  swPoint.Start();
+  for (int ii = repFactor; ii--;) {
+    for (int it = 0; it < ntst; it++) {
+      fld->Field(&xyz[3 * it], &bxyz[3 * it]);
+    }
+  }
+  swPoint.Stop();
+
+  TStopwatch swBatch;
+  swBatch.Start();
+  for (int ii = repFactor; ii--;) {
+    for (int itr = 0; itr < ntrk; itr++) {
+      fld->Field(nstep, &xyz[3 * itr * nstep], &bbatch[3 * itr * nstep]);
+    }
+  }
+  swBatch.Stop();
+
+  fld->AllowFastField(true);
+  TStopwatch swFast;
+  swFast.Start();
+  double bfast[3];
+  for (int ii = repFactor; ii--;) {
+    for (int it = 0; it < ntst; it++) {
+      fld->Field(&xyz[3 * it], bfast);
+    }
+  }
+  swFast.Stop();
+
+  double sP = swPoint.CpuTime() / (ntst * repFactor);
+  double sB = swBatch.CpuTime() / (ntst * repFactor);
+  double sF = swFast.CpuTime() / (ntst * repFactor);
+  LOG(info) << "Timing: Exact param: " << sP << " Batched exact param: " << sB << " Fast param: " << sF
+            << "s/call -> batch factor " << (sB > 0. ? sP / sB : -1.);
+
+  for (int it = 0; it < 3 * ntst; it++) {
+    BOOST_CHECK_SMALL(bbatch[it] - bxyz[it], 1.e-6);
+  }
+}
@@ -136,6 +136,10 @@ class Chebyshev3D : public TNamed
 
   Double_t Eval(const Double_t* par, int idim);
 
+  /// Evaluates Chebyshev parameterization for np points of 3d->DimOut function, par containing the consecutive
+  /// 3D arguments of the points and res receiving their consecutive DimOut results
+  void Eval(int np, const Double_t* par, Double_t* res) const;
+
   void evaluateDerivative(int dimd, const Float_t* par, Float_t* res);
 
   void evaluateDerivative2(int dimd1, int dimd2, const Float_t* par, Float_t* res);
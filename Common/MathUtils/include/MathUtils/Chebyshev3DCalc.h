@@ -169,6 +169,15 @@ class Chebyshev3DCalc : public TNamed
 
   Double_t Eval(const Double_t* par) const;
 
+  /// Maximum number of points evaluated together by the batched Eval
+  static constexpr int MaxBatchSize = 16;
+
+  /// Evaluates Chebyshev parameterization for np <= MaxBatchSize points of 3D function, giving the same results
+  /// as the single point Eval, with the recursions of all the points done together to allow their vectorization.
+  /// VERY IMPORTANT: par must contain the function arguments ALREADY MAPPED to [-1:1] interval,
+  /// ordered by dimension, i.e. par[dim * np + ip] is the dim-th argument of the ip-th point
+  void Eval(int np, const Float_t* par, Float_t* res) const;
+
  private:
   Int_t mNumberOfCoefficients;    ///< total number of coeeficients
   Int_t mNumberOfRows;            ///< number of significant rows in the 3D coeffs matrix
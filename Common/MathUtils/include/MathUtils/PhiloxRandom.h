@@ -0,0 +1,207 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// @file   PhiloxRandom.h
+///
+
+/// @brief  Counter-based random number generator
+///
+/// Implementation of the Philox4x32-10 generator (Salmon et al., "Parallel
+/// random numbers: as easy as 1, 2, 3", SC11). The n-th number of a stream
+/// is a pure function of the key of the stream and of n, so that streams keyed
+/// by e.g. (event, thread, stream) can be drawn in parallel, and reproducibly,
+/// without any shared state. The numbers are generated by blocks of counters
+/// in loops which are vectorized by the compiler.
+
+#ifndef ALICEO2_MATHUTILS_PHILOXRANDOM_H_
+#define ALICEO2_MATHUTILS_PHILOXRANDOM_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace o2
+{
+namespace math_utils
+{
+
+class PhiloxRandom
+{
+ public:
+  using Counter = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  /// number of counters processed together by the block generation
+  static constexpr size_t BlockSize = 16;
+
+  /// constructor
+  /// @param [in] event first part of the key of the stream, e.g. the event or time frame number
+  /// @param [in] thread second part of the key of the stream, e.g. the thread or sector number
+  /// @param [in] stream third part of the key of the stream, to have several independent streams per thread
+  PhiloxRandom(uint64_t event = 0, uint32_t thread = 0, uint32_t stream = 0) { setKey(event, thread, stream); }
+
+  /// set the key of the stream and restart it from its beginning
+  void setKey(uint64_t event, uint32_t thread, uint32_t stream)
+  {
+    mKey = {static_cast<uint32_t>(event), static_cast<uint32_t>(event >> 32)};
+    mCounterHigh = (static_cast<uint64_t>(stream) << 32) | thread;
+    mPosition = 0;
+  }
+
+  /// position in the stream, i.e. number of 32 bit values drawn since its beginning
+  uint64_t getPosition() const { return mPosition; }
+
+  /// move to any position in the stream, without generating the values in between
+  void setPosition(uint64_t position) { mPosition = position; }
+
+  /// Philox4x32-10 bijection of one counter
+  static Counter generate(Counter counter, Key key)
+  {
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t p0 = static_cast<uint64_t>(M0) * counter[0];
+      const uint64_t p1 = static_cast<uint64_t>(M1) * counter[2];
+      counter = {static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(p1),
+                 static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(p0)};
+      key[0] += W0;
+      key[1] += W1;
+    }
+    return counter;
+  }
+
+  /// fill an array with the next 32 bit random values of the stream
+  void fill(uint32_t* values, size_t n);
+
+  /// fill an array with the next random values of the stream, uniformly distributed in ]0, 1[
+  void fillFlat(float* values, size_t n)
+  {
+    uint32_t bits[4 * BlockSize];
+    while (n > 0) {
+      const size_t chunk = std::min(n, 4 * BlockSize);
+      fill(bits, chunk);
+      for (size_t i = 0; i < chunk; ++i) {
+        values[i] = toFlat(bits[i]);
+      }
+      values += chunk;
+      n -= chunk;
+    }
+  }
+
+  /// fill an array with the next random values of the stream, normally distributed with mean 0 and sigma 1
+  /// (Box-Muller transform of pairs of flat values)
+  void fillGaus(float* values, size_t n)
+  {
+    const size_t nPairs = n / 2;
+    fillFlat(values, 2 * nPairs);
+    for (size_t i = 0; i < 2 * nPairs; i += 2) {
+      const float r = std::sqrt(-2.f * std::log(values[i]));
+      const float phi = TwoPi * values[i + 1];
+      values[i] = r * std::cos(phi);
+      values[i + 1] = r * std::sin(phi);
+    }
+    if (n & 1) {
+      float pair[2];
+      fillFlat(pair, 2);
+      values[n - 1] = std::sqrt(-2.f * std::log(pair[0])) * std::cos(TwoPi * pair[1]);
+    }
+  }
+
+  /// next random value of the stream, uniformly distributed in ]0, 1[
+  float getNextFlat()
+  {
+    float value;
+    fillFlat(&value, 1);
+    return value;
+  }
+
+  /// convert 32 random bits to a float uniformly distributed in ]0, 1[
+  static float toFlat(uint32_t bits) { return (bits >> 8) * 0x1p-24f + 0x1p-25f; }
+
+ private:
+  static constexpr uint32_t M0 = 0xD2511F53;
+  static constexpr uint32_t M1 = 0xCD9E8D57;
+  static constexpr uint32_t W0 = 0x9E3779B9;
+  static constexpr uint32_t W1 = 0xBB67AE85;
+  static constexpr float TwoPi = 6.28318530717958647692f;
+
+  /// generate the 4 * BlockSize values of BlockSize consecutive counters starting at the counter first
+  void generateBlock(uint64_t first, uint32_t* values) const;
+
+  Key mKey{};               ///< key of the stream, from the event
+  uint64_t mCounterHigh{0}; ///< upper half of the counters, from the thread and stream
+  uint64_t mPosition{0};    ///< number of values drawn since the beginning of the stream
+};
+
+//______________________________________________________________________________
+inline void PhiloxRandom::generateBlock(uint64_t first, uint32_t* values) const
+{
+  // structure of arrays over the counters of the block, such that each round is a loop over them
+  uint32_t c0[BlockSize], c1[BlockSize], c2[BlockSize], c3[BlockSize];
+  for (size_t i = 0; i < BlockSize; ++i) {
+    const uint64_t counter = first + i;
+    c0[i] = static_cast<uint32_t>(counter);
+    c1[i] = static_cast<uint32_t>(counter >> 32);
+    c2[i] = static_cast<uint32_t>(mCounterHigh);
+    c3[i] = static_cast<uint32_t>(mCounterHigh >> 32);
+  }
+  Key key = mKey;
+  for (int round = 0; round < 10; ++round) {
+    for (size_t i = 0; i < BlockSize; ++i) {
+      const uint64_t p0 = static_cast<uint64_t>(M0) * c0[i];
+      const uint64_t p1 = static_cast<uint64_t>(M1) * c2[i];
+      const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[i] ^ key[0];
+      const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[i] ^ key[1];
+      c1[i] = static_cast<uint32_t>(p1);
+      c3[i] = static_cast<uint32_t>(p0);
+      c0[i] = n0;
+      c2[i] = n2;
+    }
+    key[0] += W0;
+    key[1] += W1;
+  }
+  for (size_t i = 0; i < BlockSize; ++i) {
+    values[4 * i] = c0[i];
+    values[4 * i + 1] = c1[i];
+    values[4 * i + 2] = c2[i];
+    values[4 * i + 3] = c3[i];
+  }
+}
+
+//______________________________________________________________________________
+inline void PhiloxRandom::fill(uint32_t* values, size_t n)
+{
+  // the value at position p is the (p % 4)-th word of the counter p / 4 of the stream
+  constexpr size_t valuesPerBlock = 4 * BlockSize;
+  while (n > 0) {
+    const uint64_t counter = mPosition / 4;
+    const size_t offset = mPosition % 4;
+    size_t chunk = 0;
+    if (offset == 0 && n >= valuesPerBlock) {
+      generateBlock(counter, values);
+      chunk = valuesPerBlock;
+    } else {
+      const auto words = generate({static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                                   static_cast<uint32_t>(mCounterHigh), static_cast<uint32_t>(mCounterHigh >> 32)},
+                                  mKey);
+      chunk = std::min(n, 4 - offset);
+      std::copy_n(words.begin() + offset, chunk, values);
+    }
+    values += chunk;
+    n -= chunk;
+    mPosition += chunk;
+  }
+}
+
+} // namespace math_utils
+} // namespace o2
+#endif
@@ -24,17 +24,26 @@
 /// The numbers can then be used as a continuous stream in
 /// a ring buffer
 ///
+/// Alternatively the ring can be filled from a counter-based generator
+/// keyed by (event, thread, stream), in which case it is refilled with the
+/// next numbers of the stream instead of repeating, and the numbers only
+/// depend on the key, such that rings of different threads can be used in
+/// parallel reproducibly
+///
 /// @author Jens Wiechula, Jens.Wiechula@cern.ch
 
 #ifndef ALICEO2_MATHUTILS_RANDOMRING_H_
 #define ALICEO2_MATHUTILS_RANDOMRING_H_
 
+#include <algorithm>
 #include <array>
 
 #include "TF1.h"
 #include "TRandom.h"
 #include <functional>
 
+#include "MathUtils/PhiloxRandom.h"
+
 
 namespace o2
 {
@@ -72,6 +81,13 @@ class RandomRing
   /// @param [in] randomType type of the random generator
   void initialize(std::function<float()> function);
 
+  /// initialisation of the random ring with a counter-based generator
+  /// @param [in] randomType type of the random generator, Gaus or Flat
+  /// @param [in] event first part of the key of the stream
+  /// @param [in] thread second part of the key of the stream
+  /// @param [in] stream third part of the key of the stream
+  void initialize(const RandomType randomType, uint64_t event, uint32_t thread, uint32_t stream = 0);
+
   /// next random value from the ring buffer
   /// This function return a value from the ring buffer
   /// and increases the buffer position
@@ -81,11 +97,29 @@ class RandomRing
     const float value = mRandomNumbers[mRingPosition];
     ++mRingPosition;
     if (mRingPosition >= mRandomNumbers.size()) {
-      mRingPosition = 0;
+      wrap();
     }
     return value;
   }
 
+  /// fill an array with the next random values from the ring buffer
+  /// and increase the buffer position accordingly
+  /// @param [out] values array to be filled
+  /// @param [in] n number of random values
+  void getNextValues(float* values, size_t n)
+  {
+    while (n > 0) {
+      const size_t chunk = std::min(n, mRandomNumbers.size() - mRingPosition);
+      std::copy_n(&mRandomNumbers[mRingPosition], chunk, values);
+      values += chunk;
+      n -= chunk;
+      mRingPosition += chunk;
+      if (mRingPosition >= mRandomNumbers.size()) {
+        wrap();
+      }
+    }
+  }
+
   /// next vector with random values
   /// This function retuns a Vc vector with random numbers to be
   /// used for vectorised programming and increases the buffer
@@ -101,7 +135,7 @@ class RandomRing
     const VcType value = VcType(&mRandomNumbers[mRingPosition]);
     mRingPosition += VcType::size();
     if (mRingPosition >= mRandomNumbers.size()) {
-      mRingPosition = 0;
+      wrap();
     }
     return value;
   }
@@ -110,7 +144,26 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// set the position in the ring buffer, e.g. to read copies of a ring from different positions
+  /// @param [in] position new position in the ring buffer, wrapped around the size of the ring
+  void setRingPosition(size_t position) { mRingPosition = position % mRandomNumbers.size(); }
+
+  /// @return true if the ring is filled from a counter-based generator
+  bool isCounterBased() const { return mCounterBased; }
+
  private:
+  /// go back to the beginning of the ring, first refilling it from the counter-based generator if used
+  void wrap()
+  {
+    if (mCounterBased) {
+      fillFromGenerator();
+    }
+    mRingPosition = 0;
+  }
+
+  /// fill the ring with the next values of the counter-based generator
+  void fillFromGenerator();
+
   // =========================================================================
   // ===| members |===========================================================
   //
@@ -118,6 +171,8 @@ class RandomRing
   RandomType mRandomType;              ///< Type of random numbers used
   std::array<float, N> mRandomNumbers; ///< Ring with random gaus numbers
   size_t mRingPosition = 0;            ///< presently accessed position in the ring
+  bool mCounterBased = false;          ///< if the ring is filled from the counter-based generator
+  PhiloxRandom mGenerator;             ///< counter-based generator
 
 }; // end class RandomRing
 
@@ -144,6 +199,7 @@ inline RandomRing<N>::RandomRing(TF1& function)
 template <size_t N>
 inline void RandomRing<N>::initialize(const RandomType randomType)
 {
+  mCounterBased = false;
 
   for (auto& v : mRandomNumbers) {
     // TODO: configurable mean and sigma
@@ -164,10 +220,42 @@ inline void RandomRing<N>::initialize(const RandomType randomType)
   }
 }
 
+//______________________________________________________________________________
+template <size_t N>
+inline void RandomRing<N>::initialize(const RandomType randomType, uint64_t event, uint32_t thread, uint32_t stream)
+{
+  mRandomType = randomType;
+  mCounterBased = true;
+  mGenerator.setKey(event, thread, stream);
+  mRingPosition = 0;
+  fillFromGenerator();
+}
+
+//______________________________________________________________________________
+template <size_t N>
+inline void RandomRing<N>::fillFromGenerator()
+{
+  switch (mRandomType) {
+    case RandomType::Gaus: {
+      mGenerator.fillGaus(mRandomNumbers.data(), N);
+      break;
+    }
+    case RandomType::Flat: {
+      mGenerator.fillFlat(mRandomNumbers.data(), N);
+      break;
+    }
+    default: {
+      mRandomNumbers.fill(0);
+      break;
+    }
+  }
+}
+
 //______________________________________________________________________________
 template <size_t N>
 inline void RandomRing<N>::initialize(TF1& function)
 {
+  mCounterBased = false;
   mRandomType = RandomType::CustomTF1;
   for (auto& v : mRandomNumbers) {
     v = function.GetRandom();
@@ -178,6 +266,7 @@ inline void RandomRing<N>::initialize(TF1& function)
 template <size_t N>
 inline void RandomRing<N>::initialize(std::function<float()> function)
 {
+  mCounterBased = false;
   mRandomType = RandomType::CustomLambda;
   for (auto& v : mRandomNumbers) {
     v = function();
@@ -387,6 +387,11 @@ using detail::StatAccumulator;
 using detail::bit2Mask;
 using detail::numberOfBitsSet;
 using detail::truncateFloatFraction;
+using detail::truncateFloatFractions;
+using detail::packFloatToUInt16;
+using detail::unpackUInt16ToFloat;
+using detail::packFloatsToUInt16;
+using detail::unpackUInt16ToFloats;
 
 } // namespace math_utils
 } // namespace o2
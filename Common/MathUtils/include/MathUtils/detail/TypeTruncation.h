@@ -17,6 +17,7 @@
 #define MATHUTILS_INCLUDE_MATHUTILS_DETAIL_TYPETRUNCATION_H_
 
 #ifndef GPUCA_GPUCODE_DEVICE
+#include <cstddef>
 #include <cstdint>
 #endif
 
@@ -42,6 +43,58 @@ static float truncateFloatFraction(float x, uint32_t mask = 0xFFFFFF00)
   return myu.y;
 }
 
+static void truncateFloatFractions(float* x, std::size_t n, uint32_t mask = 0xFFFFFF00)
+{
+  // Same as truncateFloatFraction applied in place to n consecutive values (e.g. the values of a column),
+  // the loop works on the bit patterns only such that it can be vectorized
+  constexpr uint32_t ProtMask = ((0x1u << 9) - 1u) << 23;
+  const uint32_t fullMask = ProtMask | mask;
+  for (std::size_t i = 0; i < n; ++i) {
+    union {
+      float y;
+      uint32_t iy;
+    } myu;
+    myu.y = x[i];
+    myu.iy &= fullMask;
+    x[i] = myu.y;
+  }
+}
+
+static uint16_t packFloatToUInt16(float x, float xMin, float xMax)
+{
+  // Encode x as a 16 bits fixed-point number in the range [xMin, xMax], with a precision of (xMax - xMin) / 65535,
+  // values outside of the range are stored at its edges
+  float u = (x - xMin) * (65535.f / (xMax - xMin));
+  u = (u < 0.f) ? 0.f : ((u > 65535.f) ? 65535.f : u);
+  return static_cast<uint16_t>(u + 0.5f);
+}
+
+static float unpackUInt16ToFloat(uint16_t v, float xMin, float xMax)
+{
+  // Decode a value encoded with packFloatToUInt16
+  return xMin + v * ((xMax - xMin) / 65535.f);
+}
+
+static void packFloatsToUInt16(const float* x, uint16_t* v, std::size_t n, float xMin, float xMax)
+{
+  // Same as packFloatToUInt16 applied to n consecutive values
+  const float scale = 65535.f / (xMax - xMin);
+  for (std::size_t i = 0; i < n; ++i) {
+    float u = (x[i] - xMin) * scale;
+    u = (u < 0.f) ? 0.f : ((u > 65535.f) ? 65535.f : u);
+    v[i] = static_cast<uint16_t>(u + 0.5f);
+  }
+}
+
+static void unpackUInt16ToFloats(const uint16_t* v, float* x, std::size_t n, float xMin, float xMax)
+{
+  // Same as unpackUInt16ToFloat applied to n consecutive values
+  const float step = (xMax - xMin) / 65535.f;
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = xMin + v[i] * step;
+  }
+}
+
 } // namespace detail
 } // namespace math_utils
 } // namespace o2
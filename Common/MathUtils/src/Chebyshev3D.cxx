@@ -21,6 +21,7 @@
 #include <TRandom.h>                   // for TRandom, gRandom
 #include <TString.h>                   // for TString
 #include <TSystem.h>                   // for TSystem, gSystem
+#include <algorithm>                   // for min
 #include <cstdio>                      // for printf, fprintf, FILE, fclose, fflush, etc
 #include "MathUtils/Chebyshev3DCalc.h" // for Chebyshev3DCalc, etc
 #include "TMathBase.h"                 // for Max, Abs
@@ -307,6 +308,29 @@ void Chebyshev3D::Clear(const Option_t*)
   mChebyshevParameter.Delete();
 }
 
+void Chebyshev3D::Eval(int np, const Double_t* par, Double_t* res) const
+{
+  // evaluate the points by blocks, with the mapped arguments ordered by dimension as in Chebyshev3DCalc::Eval
+  constexpr int batch = Chebyshev3DCalc::MaxBatchSize;
+  Float_t mapped[3 * batch], calc[batch];
+  for (int first = 0; first < np; first += batch) {
+    int n = std::min(batch, np - first);
+    const Double_t* parBlock = par + 3 * first;
+    Double_t* resBlock = res + mOutputArrayDimension * first;
+    for (int ip = 0; ip < n; ip++) {
+      for (int i = 3; i--;) {
+        mapped[i * n + ip] = mapToInternal(parBlock[3 * ip + i], i);
+      }
+    }
+    for (int i = mOutputArrayDimension; i--;) {
+      getChebyshevCalc(i)->Eval(n, mapped, calc);
+      for (int ip = 0; ip < n; ip++) {
+        resBlock[mOutputArrayDimension * ip + i] = calc[ip];
+      }
+    }
+  }
+}
+
 void Chebyshev3D::Print(const Option_t* opt) const
 {
   // print info
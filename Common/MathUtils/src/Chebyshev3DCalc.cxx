@@ -17,6 +17,8 @@
 #include <TSystem.h> // for TSystem, gSystem
 #include "TNamed.h"  // for TNamed
 #include "TString.h" // for TString, TString::EStripType::kBoth
+#include <algorithm>
+#include <vector>
 
 using namespace o2::math_utils;
 
@@ -203,6 +205,86 @@ void Chebyshev3DCalc::Print(const Option_t*) const
   printf("%d coefficients in %dx%dx%d matrix\n", mNumberOfCoefficients, mNumberOfRows, mNumberOfColumns, nmax3d);
 }
 
+namespace
+{
+// The batched evaluation always processes MaxBatchSize points (lanes), the unused ones being padded,
+// such that the loops over the points have a constant trip count and are vectorized by the compiler
+constexpr int NLanes = Chebyshev3DCalc::MaxBatchSize;
+
+/// Evaluates 1D Chebyshev parameterization with the same coefficients for all the lanes
+void batchEvaluation1D(const Float_t* x, const Float_t* array, int ncf, Float_t* res)
+{
+  if (ncf <= 0) {
+    std::fill_n(res, NLanes, 0.f);
+    return;
+  }
+  Float_t b0[NLanes], b1[NLanes], b2[NLanes];
+  --ncf;
+  for (int ip = 0; ip < NLanes; ip++) {
+    b0[ip] = array[ncf];
+    b1[ip] = b2[ip] = 0;
+  }
+  for (int i = ncf; i--;) {
+    for (int ip = 0; ip < NLanes; ip++) {
+      b2[ip] = b1[ip];
+      b1[ip] = b0[ip];
+      b0[ip] = array[i] + (x[ip] + x[ip]) * b1[ip] - b2[ip];
+    }
+  }
+  for (int ip = 0; ip < NLanes; ip++) {
+    res[ip] = b0[ip] - x[ip] * b1[ip];
+  }
+}
+
+/// Evaluates 1D Chebyshev parameterization with its own coefficients for each lane, array[i * NLanes + ip] being the i-th one of lane ip
+void batchEvaluation1DPerLane(const Float_t* x, const Float_t* array, int ncf, Float_t* res)
+{
+  if (ncf <= 0) {
+    std::fill_n(res, NLanes, 0.f);
+    return;
+  }
+  Float_t b0[NLanes], b1[NLanes], b2[NLanes];
+  --ncf;
+  for (int ip = 0; ip < NLanes; ip++) {
+    b0[ip] = array[ncf * NLanes + ip];
+    b1[ip] = b2[ip] = 0;
+  }
+  for (int i = ncf; i--;) {
+    for (int ip = 0; ip < NLanes; ip++) {
+      b2[ip] = b1[ip];
+      b1[ip] = b0[ip];
+      b0[ip] = array[i * NLanes + ip] + (x[ip] + x[ip]) * b1[ip] - b2[ip];
+    }
+  }
+  for (int ip = 0; ip < NLanes; ip++) {
+    res[ip] = b0[ip] - x[ip] * b1[ip];
+  }
+}
+} // namespace
+
+void Chebyshev3DCalc::Eval(int np, const Float_t* par, Float_t* res) const
+{
+  // same recursions as the single point Eval, done for all the lanes at once
+  thread_local std::vector<Float_t> tmp2D, tmp1D;
+  tmp2D.resize(mNumberOfColumns * NLanes);
+  tmp1D.resize(mNumberOfRows * NLanes);
+  Float_t x[3][NLanes] = {}, out[NLanes];
+  for (int i = 3; i--;) {
+    std::copy_n(par + i * np, np, x[i]);
+  }
+  for (int id0 = mNumberOfRows; id0--;) {
+    int nCLoc = mNumberOfColumnsAtRow[id0]; // number of significant coefs on this row
+    int col0 = mColumnAtRowBeginning[id0];  // beginning of local column in the 2D boundary matrix
+    for (int id1 = nCLoc; id1--;) {
+      int id = id1 + col0;
+      batchEvaluation1D(x[2], mCoefficients + mCoefficientBound2D1[id], mCoefficientBound2D0[id], tmp2D.data() + id1 * NLanes);
+    }
+    batchEvaluation1DPerLane(x[1], tmp2D.data(), nCLoc, tmp1D.data() + id0 * NLanes);
+  }
+  batchEvaluation1DPerLane(x[0], tmp1D.data(), mNumberOfRows, out);
+  std::copy_n(out, np, res);
+}
+
 Float_t Chebyshev3DCalc::evaluateDerivative(int dim, const Float_t* par) const
 {
   int ncfRC;
@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PhiloxRandom
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "MathUtils/PhiloxRandom.h"
+#include "MathUtils/RandomRing.h"
+
+using namespace o2::math_utils;
+
+BOOST_AUTO_TEST_CASE(PhiloxRandom_knownAnswers)
+{
+  // known answers of the reference implementation (Random123)
+  auto c = PhiloxRandom::generate({0, 0, 0, 0}, {0, 0});
+  BOOST_CHECK(c == (PhiloxRandom::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  c = PhiloxRandom::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+  BOOST_CHECK(c == (PhiloxRandom::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  c = PhiloxRandom::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+  BOOST_CHECK(c == (PhiloxRandom::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+BOOST_AUTO_TEST_CASE(PhiloxRandom_streams)
+{
+  // the values only depend on the key and on the position, not on how they are drawn
+  const size_t n = 1000;
+  PhiloxRandom all(12345, 3, 7), chunks(12345, 3, 7);
+  std::vector<uint32_t> vAll(n), vChunks(n);
+  all.fill(vAll.data(), n);
+  const size_t sizes[] = {1, 3, 64, 70, 5, 2, 129};
+  for (size_t pos = 0, i = 0; pos < n; ++i) {
+    size_t chunk = std::min(sizes[i % 7], n - pos);
+    chunks.fill(vChunks.data() + pos, chunk);
+    pos += chunk;
+  }
+  BOOST_CHECK(vAll == vChunks);
+
+  uint32_t value = 0;
+  chunks.setPosition(517);
+  chunks.fill(&value, 1);
+  BOOST_CHECK_EQUAL(value, vAll[517]);
+
+  PhiloxRandom other(12345, 4, 7);
+  std::vector<uint32_t> vOther(n);
+  other.fill(vOther.data(), n);
+  BOOST_CHECK(vAll != vOther);
+
+  // moments of the distributions
+  std::vector<float> values(1000000);
+  PhiloxRandom generator(1);
+  generator.fillFlat(values.data(), values.size());
+  double mean = 0;
+  for (auto v : values) {
+    BOOST_REQUIRE(v > 0.f && v < 1.f);
+    mean += v;
+  }
+  BOOST_CHECK_SMALL(mean / values.size() - 0.5, 1e-3);
+  generator.fillGaus(values.data(), values.size());
+  double sum = 0, sum2 = 0;
+  for (auto v : values) {
+    sum += v;
+    sum2 += v * v;
+  }
+  mean = sum / values.size();
+  BOOST_CHECK_SMALL(mean, 3e-3);
+  BOOST_CHECK_CLOSE(std::sqrt(sum2 / values.size() - mean * mean), 1., 0.3);
+}
+
+BOOST_AUTO_TEST_CASE(RandomRing_counterBased)
+{
+  // counter-based rings with the same key give the same values, and do not repeat after the ring size
+  RandomRing<1024> ring1, ring2;
+  ring1.initialize(RandomRing<1024>::RandomType::Gaus, 10, 2);
+  ring2.initialize(RandomRing<1024>::RandomType::Gaus, 10, 2);
+  BOOST_CHECK(ring1.isCounterBased());
+  std::vector<float> values1(3000), values2(3000);
+  ring1.getNextValues(values1.data(), values1.size());
+  for (auto& v : values2) {
+    v = ring2.getNextValue();
+  }
+  BOOST_CHECK(values1 == values2);
+  BOOST_CHECK(!std::equal(values1.begin(), values1.begin() + 1024, values1.begin() + 1024));
+}
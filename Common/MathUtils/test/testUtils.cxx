@@ -18,6 +18,8 @@
 #include <iostream>
 #include <chrono>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include "MathUtils/Utils.h"
 
 using namespace o2;
@@ -121,3 +123,33 @@ BOOST_AUTO_TEST_CASE(Utils_test)
 
   } // test fastATan2()
 }
+
+BOOST_AUTO_TEST_CASE(Truncation_test)
+{
+  // test the batched truncation and the 16 bits packing of MathUtils/detail/TypeTruncation.h
+
+  const int N = 1000;
+  std::vector<float> values(N), truncated(N);
+  for (int i = 0; i < N; ++i) {
+    values[i] = (i % 2 ? -1.f : 1.f) * std::exp(0.02f * (i - N / 2));
+  }
+
+  for (uint32_t mask : {0xFFFFFFFFu, 0xFFFFFF00u, 0xFFFFE000u, 0xFFFF0000u}) {
+    truncated = values;
+    math_utils::truncateFloatFractions(truncated.data(), N, mask);
+    for (int i = 0; i < N; ++i) {
+      BOOST_CHECK_EQUAL(truncated[i], math_utils::truncateFloatFraction(values[i], mask));
+    }
+  }
+
+  const float xMin = -2.f, xMax = 3.f, precision = (xMax - xMin) / 65535.f;
+  std::vector<uint16_t> packed(N);
+  math_utils::packFloatsToUInt16(values.data(), packed.data(), N, xMin, xMax);
+  math_utils::unpackUInt16ToFloats(packed.data(), truncated.data(), N, xMin, xMax);
+  for (int i = 0; i < N; ++i) {
+    BOOST_CHECK_EQUAL(packed[i], math_utils::packFloatToUInt16(values[i], xMin, xMax));
+    BOOST_CHECK_EQUAL(truncated[i], math_utils::unpackUInt16ToFloat(packed[i], xMin, xMax));
+    float expected = std::clamp(values[i], xMin, xMax);
+    BOOST_CHECK_SMALL(truncated[i] - expected, 0.5001f * precision + 1.e-6f);
+  }
+}
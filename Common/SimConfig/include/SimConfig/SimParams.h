@@ -50,6 +50,16 @@ struct SimMaterialParams : public o2::conf::ConfigurableParamHelper<SimMaterialP
   O2ParamDef(SimMaterialParams, "SimMaterialParams");
 };
 
+// parameters influencing the output written by the hit merger
+struct SimIOParams : public o2::conf::ConfigurableParamHelper<SimIOParams> {
+  int kineCompression = -1;  // ROOT compression setting (100 * algorithm + level) of the kinematics and MC header files, -1 keeps the ROOT default
+  int kineBasketSize = 0;    // basket size in bytes of the kinematics branches, 0 keeps the ROOT default
+  long kineAutoFlush = 0;    // TTree::SetAutoFlush value of the kinematics trees (> 0: entries, < 0: bytes), 0 keeps the ROOT default
+  int mergerIOThreads = 0;   // if > 0, ROOT implicit multithreading with this number of threads compresses the baskets of the trees in parallel
+
+  O2ParamDef(SimIOParams, "SimIOParams");
+};
+
 } // namespace conf
 } // namespace o2
 
@@ -21,6 +21,8 @@
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimCutParams> + ;
 #pragma link C++ class o2::conf::SimMaterialParams + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimMaterialParams> + ;
+#pragma link C++ class o2::conf::SimIOParams + ;
+#pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimIOParams> + ;
 
 #pragma link C++ class o2::conf::SimUserDecay + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::conf::SimUserDecay> + ;
@@ -33,3 +33,22 @@ BOOST_AUTO_TEST_CASE(test1)
   BOOST_CHECK_CLOSE(par.ZmaxA, 20., 0.001);
   BOOST_CHECK_CLOSE(ConfigurableParam::getValueAs<double>("SimCutParams.ZmaxA"), 20., 0.001);
 }
+
+BOOST_AUTO_TEST_CASE(snapshot)
+{
+  auto& par = SimCutParams::Instance();
+  ConfigurableParam::updateFromString("SimCutParams.ZmaxC=30;SimCutParams.stepTrackRefHookFile=hook.macro;SimCutParams.trackSeed=true");
+  BOOST_CHECK(ConfigurableParam::writeSnapshot("simcutparams.snapshot"));
+
+  ConfigurableParam::updateFromString("SimCutParams.ZmaxC=40;SimCutParams.stepTrackRefHookFile=other.macro;SimCutParams.trackSeed=false");
+  BOOST_CHECK(ConfigurableParam::updateFromSnapshot("simcutparams.snapshot"));
+  BOOST_CHECK_CLOSE(par.ZmaxC, 30., 0.001);
+  BOOST_CHECK_EQUAL(par.stepTrackRefHookFile, "hook.macro");
+  BOOST_CHECK_EQUAL(par.trackSeed, true);
+  BOOST_CHECK_CLOSE(ConfigurableParam::getValueAs<double>("SimCutParams.ZmaxC"), 30., 0.001);
+  BOOST_CHECK_EQUAL(ConfigurableParam::getProvenance("SimCutParams.ZmaxC"), ConfigurableParam::kRT);
+  // the values which come from the code are not part of the snapshot
+  BOOST_CHECK_EQUAL(ConfigurableParam::getProvenance("SimCutParams.maxRTracking"), ConfigurableParam::kCODE);
+
+  BOOST_CHECK(!ConfigurableParam::updateFromSnapshot("nonexisting.snapshot"));
+}
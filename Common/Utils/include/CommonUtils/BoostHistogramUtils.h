@@ -20,6 +20,8 @@
 #include <algorithm>
 #include <vector>
 #include <array>
+#include <limits>
+#include <type_traits>
 #include <TH1.h>
 #include <TH2.h>
 #include <TFile.h>
@@ -43,6 +45,7 @@
 #include <boost/histogram/axis.hpp>
 #include <boost/histogram/make_histogram.hpp>
 #include <boost/histogram/accumulators/mean.hpp>
+#include <boost/histogram/unsafe_access.hpp>
 
 using boostHisto2d = boost::histogram::histogram<std::tuple<boost::histogram::axis::regular<double, boost::use_default, boost::use_default, boost::use_default>, boost::histogram::axis::regular<double, boost::use_default, boost::use_default, boost::use_default>>, boost::histogram::unlimited_storage<std::allocator<char>>>;
 using boostHisto1d = boost::histogram::histogram<std::tuple<boost::histogram::axis::regular<double, boost::use_default, boost::use_default, boost::use_default>>>;
@@ -737,6 +740,62 @@ double getIntegralBoostHist(boost::histogram::histogram<axes...>& hist, double m
   return boost::histogram::algorithm::sum(slicedHist);
 }
 
+namespace detail
+{
+/// \brief Adds the cells of other to the cells of target if no cell overflows
+/// \return false if the cells can not be added without changing the type of the target cells
+template <typename T, typename U>
+bool addBoostCells(T* target, const U* other, size_t size)
+{
+  if constexpr (!std::is_arithmetic_v<T> || !std::is_arithmetic_v<U> || (std::is_integral_v<T> && (std::is_floating_point_v<U> || sizeof(U) > sizeof(T)))) {
+    return false;
+  } else {
+    if constexpr (std::is_integral_v<T>) {
+      bool overflow = false;
+      for (size_t i = 0; i < size; i++) {
+        overflow |= static_cast<T>(other[i]) > std::numeric_limits<T>::max() - target[i];
+      }
+      if (overflow) {
+        return false;
+      }
+    }
+    for (size_t i = 0; i < size; i++) {
+      target[i] += other[i];
+    }
+    return true;
+  }
+}
+} // namespace detail
+
+/// \brief Add the content of a boost histogram to another one with the same axes
+///
+/// For storages with contiguous arithmetic cells the cells are added as plain arrays, which the compiler vectorizes.
+/// The generic operator+= of boost::histogram, which handles each cell separately, is only used if the axes differ,
+/// for accumulator cells or if cells of an unlimited_storage have to be widened.
+/// \param target histogram to which the content is added
+/// \param other histogram which is added
+template <typename axes, typename Storage>
+void addBoostHistos(boost::histogram::histogram<axes, Storage>& target, const boost::histogram::histogram<axes, Storage>& other)
+{
+  using unsafe = boost::histogram::unsafe_access;
+  if (unsafe::axes(target) == unsafe::axes(other)) {
+    auto& targetStorage = unsafe::storage(target);
+    auto& otherStorage = unsafe::storage(const_cast<boost::histogram::histogram<axes, Storage>&>(other));
+    if constexpr (requires { unsafe::unlimited_storage_buffer(targetStorage); }) {
+      auto& targetBuffer = unsafe::unlimited_storage_buffer(targetStorage);
+      const auto& otherBuffer = unsafe::unlimited_storage_buffer(otherStorage);
+      if (targetBuffer.size == otherBuffer.size && targetBuffer.visit([&otherBuffer](auto* targetCells) { return otherBuffer.visit([targetCells, size = otherBuffer.size](const auto* otherCells) { return detail::addBoostCells(targetCells, otherCells, size); }); })) {
+        return;
+      }
+    } else if constexpr (requires { targetStorage.data(); } && std::is_arithmetic_v<typename Storage::value_type>) {
+      if (targetStorage.size() == otherStorage.size() && detail::addBoostCells(targetStorage.data(), otherStorage.data(), targetStorage.size())) {
+        return;
+      }
+    }
+  }
+  target += other;
+}
+
 } // namespace utils
 } // end namespace o2
 
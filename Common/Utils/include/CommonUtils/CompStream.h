@@ -91,6 +91,10 @@ class icomp_stream : public std::istream
  * Implementation is based on boost::iostreams utilities, the filtered_streambuf
  * and compression filters. Currently supporting gzip, zlib, bzip2, and lzma algorithms.
  * The algorithm is specified either by enum or string to the constructor.
+ *
+ * With gzip, several threads can be used: the data is then split in blocks compressed
+ * in parallel as independent gzip members, which form together a valid gzip stream
+ * readable by icomp_stream and any gzip tool.
  */
 class ocomp_stream : public std::ostream
 {
@@ -100,22 +104,26 @@ class ocomp_stream : public std::ostream
   /// constructor
   /// @param filename name of the file to read from
   /// @param method   compression method specified by enum
-  ocomp_stream(std::string filename, CompressionMethod method = CompressionMethod::None);
+  /// @param nThreads number of threads used for the gzip compression
+  ocomp_stream(std::string filename, CompressionMethod method = CompressionMethod::None, int nThreads = 1);
 
   /// constructor
-  /// @param backend the stream to read data from
-  /// @param method  compression method specified by enum
-  ocomp_stream(std::ostream& backend, CompressionMethod method = CompressionMethod::None);
+  /// @param backend  the stream to read data from
+  /// @param method   compression method specified by enum
+  /// @param nThreads number of threads used for the gzip compression
+  ocomp_stream(std::ostream& backend, CompressionMethod method = CompressionMethod::None, int nThreads = 1);
 
   /// constructor
   /// @param filename name of the file to read from
   /// @param method   compression method specified by string: gzip, zlib, bzip2, lzma
-  ocomp_stream(std::string filename, std::string method);
+  /// @param nThreads number of threads used for the gzip compression
+  ocomp_stream(std::string filename, std::string method, int nThreads = 1);
 
   /// constructor
-  /// @param backend the stream to read data from
-  /// @param method  compression method specified by string: gzip, zlib, bzip2, lzma
-  ocomp_stream(std::ostream& backend, std::string method);
+  /// @param backend  the stream to read data from
+  /// @param method   compression method specified by string: gzip, zlib, bzip2, lzma
+  /// @param nThreads number of threads used for the gzip compression
+  ocomp_stream(std::ostream& backend, std::string method, int nThreads = 1);
 
  private:
   streambuffer_t mStreamBuffer;
@@ -256,6 +256,12 @@ class ConfigurableParam
   // load from (CCDB) snapshot
   static void fromCCDB(std::string filename);
 
+  // write the values not coming from the code to a binary snapshot of the configuration
+  static bool writeSnapshot(std::string const& filename);
+  // load a binary snapshot of the configuration, without ROOT reflection nor string parsing
+  // (only valid with parameters compiled from the same code as the writer)
+  static bool updateFromSnapshot(std::string const& filename);
+
   // allows to provide a string of key-values from which to update
   // (certain) key-values
   // propagates changes down to each registered configuration
@@ -279,6 +285,7 @@ class ConfigurableParam
   friend std::ostream& operator<<(std::ostream& out, const ConfigurableParam& me);
 
   static void initPropertyTree();
+  static void updateIODirectories();
   static EParamUpdateStatus updateThroughStorageMap(std::string, std::string, std::type_info const&, void*);
   static EParamUpdateStatus updateThroughStorageMapWithConversion(std::string const&, std::string const&);
 
@@ -51,6 +51,7 @@ enum SamplingTypes {
   sampleIDGlobal = 3, ///< in case different streamers have access to the same IDs use this gloabl ID
   sampleWeights = 4,  ///< perform sampling on weights, defined where the streamer is called
   sampleTsallis = 5,  ///< perform sampling on tsallis pdf
+  sampleHash = 6,     ///< sample deterministically on the hash of the ID (e.g. TF or track ID): same decision in all threads, streamers and runs
 };
 
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
@@ -68,6 +69,9 @@ struct ParameterDebugStreamer : public o2::conf::ConfigurableParamHelper<Paramet
   SamplingTypes samplingType[StreamFlags::streamFlagsCount]{};                                    ///< sampling type for each streamer (default = SamplingTypes::sampleAll)
   float samplingFrequency[StreamFlags::streamFlagsCount]{0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1}; ///< frequency which is used for the sampling (0.1 -> 10% is written if sampling is used)
   int sampleIDGlobal[StreamFlags::streamFlagsCount]{};                                            ///< storage of reference streamer used for sampleIDFromOtherStreamer
+  int maxEntries[StreamFlags::streamFlagsCount]{};                                                ///< maximum number of entries written per process for each streamer, further entries are rejected (0 = no limit)
+  unsigned int samplingSeed{};                                                                    ///< seed mixed into the hash for sampleHash, change it to select a different subset
+  int compression{-1};                                                                            ///< ROOT compression setting of the output files (e.g. 404 = LZ4 level 4, 0 = uncompressed, -1 = ROOT default)
   O2ParamDef(ParameterDebugStreamer, "DebugStreamerParam");
 };
 
@@ -167,6 +171,12 @@ class DebugStreamer
   /// get random value between min and max
   static float getRandom(float min = 0, float max = 1);
 
+  /// \return returns a value in [0, 1) which is a deterministic function of the given ID and the sampling seed
+  static float getHashUniform(const size_t samplingID);
+
+  /// \return returns the number of entries accepted so far by checkStream for given streamer
+  static size_t getNAcceptedEntries(const StreamFlags streamFlag);
+
  private:
   using StreamersPerFlag = tbb::concurrent_unordered_map<size_t, std::unique_ptr<o2::utils::TreeStreamRedirector>>;
   StreamersPerFlag mTreeStreamer; ///< streamer which is used for the debugging
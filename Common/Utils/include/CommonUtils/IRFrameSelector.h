@@ -17,7 +17,10 @@
 #define O2_UTILS_IRFRAMESELECTOR_H
 
 #include "CommonDataFormat/IRFrame.h"
+#include "CommonConstants/LHCConstants.h"
 #include <gsl/span>
+#include <cstdint>
+#include <vector>
 
 namespace o2::utils
 {
@@ -26,6 +29,8 @@ class IRFrameSelector
  public:
   long check(o2::dataformats::IRFrame fr, size_t bwd = 0, size_t fwd = 0);
   long check(const o2::InteractionRecord& ir, size_t bwd = 0, size_t fwd = 0) { return check(o2::dataformats::IRFrame{ir, ir}, bwd, fwd); }
+  bool isSelected(o2::dataformats::IRFrame fr, size_t bwd = 0, size_t fwd = 0);
+  bool isSelected(const o2::InteractionRecord& ir, size_t bwd = 0, size_t fwd = 0) { return isSelected(o2::dataformats::IRFrame{ir, ir}, bwd, fwd); }
   gsl::span<const o2::dataformats::IRFrame> getMatchingFrames(const o2::dataformats::IRFrame& fr);
 
   template <typename SPAN>
@@ -36,6 +41,7 @@ class IRFrameSelector
     applyMargins(bwd, fwd, shift, removeOverlaps);
     mLastIRFrameChecked.getMin().clear(); // invalidate
     mLastBoundID = -1;
+    buildBCMask();
   }
 
   void clear();
@@ -47,11 +53,18 @@ class IRFrameSelector
   bool isSet() const { return mIsSet; }
 
  private:
+  static constexpr int64_t MaxBCMaskSize = 256 * o2::constants::lhc::LHCMaxBunches; // max number of BCs covered by the mask (~110 kB)
+
+  void buildBCMask();
+
   gsl::span<const o2::dataformats::IRFrame> mFrames{}; // externally provided span of IRFrames, must be sorted in IRFrame.getMin()
   o2::dataformats::IRFrame mLastIRFrameChecked{};      // last frame which was checked
   long mLastBoundID = -1;                              // id of the last checked entry >= mLastIRFrameChecked
   bool mIsSet = false;                                 // flag that something was set (even if empty)
   std::vector<o2::dataformats::IRFrame> mOwnList;      // list loaded from the file
+  std::vector<uint64_t> mBCMask;                       //! bit per BC of [mBCMaskStart, mBCMaskEnd], set if the BC is selected
+  int64_t mBCMaskStart = 0;                            //! first BC covered by the mask
+  int64_t mBCMaskEnd = -1;                             //! last BC covered by the mask
   ClassDefNV(IRFrameSelector, 1);
 };
 
@@ -21,6 +21,7 @@
 
 #include <TRandom.h>
 #include <fcntl.h>
+#include <cstdint>
 
 namespace o2
 {
@@ -41,6 +42,18 @@ class RngHelper
     return s;
   }
 
+  // derives a seed for the random stream with the given index (e.g. of one of several parallel
+  // generator instances) from a base seed; the seeds of different streams are decorrelated by
+  // splitmix64 mixing and are limited to the uint32_t range (0 excluded) supported by TRandom
+  static ULong_t decorrelatedSeed(ULong_t seed, ULong_t index)
+  {
+    uint64_t z = uint64_t(seed) + (uint64_t(index) + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = (z ^ (z >> 31)) & 0xffffffffULL;
+    return z == 0 ? 1 : z;
+  }
+
   // static function to get a true random number from /dev/urandom
   template <typename T>
   static T readURandom()
@@ -66,7 +66,9 @@ class ShmManager
 
   // creates a global shared mem region
   // to be used by "nsubsegments" simulation processes
-  bool createGlobalSegment(int nsubsegments = 1);
+  // if hugepages is set, the region is backed by huge pages (falling back to normal pages if none are available);
+  // if prefault is set, all pages are touched once at creation such that the workers don't fault on first use
+  bool createGlobalSegment(int nsubsegments = 1, bool hugepages = false, bool prefault = false);
 
   // create the local segment
   // this will occupy a subregion of an already created global shared mem segment
@@ -82,6 +84,7 @@ class ShmManager
 
   void release();
   int getShmID() const { return mShmID; }
+  bool usesHugePages() const { return mHugePages; }
   bool hasSegment() const { return mShmID != -1; }
   bool readyToAllocate() const { return mShmID != -1 && mBufferPtr; }
 
@@ -114,6 +117,7 @@ class ShmManager
   ShmMetaInfo* mSegInfoPtr = nullptr; // pointing to the meta information object
   bool mIsMaster = false;             // true if the manager who allocated the region
   bool mIsOperational = false;
+  bool mHugePages = false;            // true if the segment is backed by huge pages
   // helper function
   void* tryAttach(bool& success);
   size_t getPointerOffset(void* ptr) const { return (size_t)((char*)ptr - (char*)mBufferPtr); }
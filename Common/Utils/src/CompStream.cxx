@@ -22,8 +22,14 @@
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 //#include <boost/iostreams/filter/lzma.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <algorithm>
+#include <future>
 #include <map>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace o2
 {
@@ -56,12 +62,99 @@ void pushDecompressor(T& stream, CompressionMethod method)
   }
 }
 
+/// gzip compression filter splitting the data in blocks compressed in parallel
+/// each block is written as an independent gzip member, in the input order
+class parallel_gzip_compressor
+{
+ public:
+  using char_type = char;
+  struct category : boost::iostreams::multichar_output_filter_tag, boost::iostreams::closable_tag {
+  };
+
+  /// size of the blocks compressed independently
+  static constexpr size_t BlockSize = 1 << 20;
+
+  parallel_gzip_compressor(int nThreads) : mState(std::make_shared<State>())
+  {
+    mState->nThreads = nThreads;
+    mState->blocks.emplace_back();
+    mState->blocks.back().reserve(BlockSize);
+  }
+
+  template <typename Sink>
+  std::streamsize write(Sink& sink, const char* s, std::streamsize n)
+  {
+    std::streamsize written = 0;
+    while (written < n) {
+      auto& block = mState->blocks.back();
+      auto nCopy = std::min<std::streamsize>(n - written, BlockSize - block.size());
+      block.insert(block.end(), s + written, s + written + nCopy);
+      written += nCopy;
+      if (block.size() == BlockSize) {
+        if (mState->blocks.size() == mState->nThreads) {
+          compress(sink);
+        }
+        mState->blocks.emplace_back();
+        mState->blocks.back().reserve(BlockSize);
+      }
+    }
+    return n;
+  }
+
+  template <typename Sink>
+  void close(Sink& sink)
+  {
+    if (mState->blocks.back().empty() && (mState->hasOutput || mState->blocks.size() > 1)) {
+      mState->blocks.pop_back(); // an empty member is kept only if there is no data, to have a valid gzip stream
+    }
+    compress(sink);
+    mState->blocks.emplace_back();
+  }
+
+ private:
+  /// compress the pending blocks in parallel and write them to the sink in order
+  template <typename Sink>
+  void compress(Sink& sink)
+  {
+    std::vector<std::future<std::string>> members;
+    for (auto& block : mState->blocks) {
+      members.emplace_back(std::async(std::launch::async, [&block]() {
+        std::string member;
+        boost::iostreams::filtering_ostream stream;
+        stream.push(boost::iostreams::gzip_compressor());
+        stream.push(boost::iostreams::back_inserter(member));
+        stream.write(block.data(), block.size());
+        stream.reset();
+        return member;
+      }));
+    }
+    for (auto& member : members) {
+      auto data = member.get();
+      boost::iostreams::write(sink, data.data(), data.size());
+    }
+    mState->blocks.clear();
+    mState->hasOutput = true;
+  }
+
+  /// the filter is copied when pushed to the stream, the buffered data is shared
+  struct State {
+    size_t nThreads = 1;
+    bool hasOutput = false;
+    std::vector<std::vector<char>> blocks;
+  };
+  std::shared_ptr<State> mState;
+};
+
 template <typename T>
-void pushCompressor(T& stream, CompressionMethod method)
+void pushCompressor(T& stream, CompressionMethod method, int nThreads = 1)
 {
   switch (method) {
     case CompressionMethod::Gzip:
-      stream.push(boost::iostreams::gzip_compressor());
+      if (nThreads > 1) {
+        stream.push(parallel_gzip_compressor(nThreads));
+      } else {
+        stream.push(boost::iostreams::gzip_compressor());
+      }
       break;
     case CompressionMethod::Zlib:
       stream.push(boost::iostreams::zlib_compressor());
@@ -126,31 +219,31 @@ icomp_stream::icomp_stream(std::istream& backend, std::string method)
   mStreamBuffer.push(backend);
 }
 
-ocomp_stream::ocomp_stream(std::string filename, CompressionMethod method)
+ocomp_stream::ocomp_stream(std::string filename, CompressionMethod method, int nThreads)
   : mStreamBuffer(), std::ostream(&mStreamBuffer)
 {
-  comp_stream_helpers::pushCompressor(mStreamBuffer, method);
+  comp_stream_helpers::pushCompressor(mStreamBuffer, method, nThreads);
   mStreamBuffer.push(boost::iostreams::file_sink(filename));
 }
 
-ocomp_stream::ocomp_stream(std::ostream& backend, CompressionMethod method)
+ocomp_stream::ocomp_stream(std::ostream& backend, CompressionMethod method, int nThreads)
   : mStreamBuffer(), std::ostream(&mStreamBuffer)
 {
-  comp_stream_helpers::pushCompressor(mStreamBuffer, method);
+  comp_stream_helpers::pushCompressor(mStreamBuffer, method, nThreads);
   mStreamBuffer.push(backend);
 }
 
-ocomp_stream::ocomp_stream(std::string filename, std::string method)
+ocomp_stream::ocomp_stream(std::string filename, std::string method, int nThreads)
   : mStreamBuffer(), std::ostream(&mStreamBuffer)
 {
-  comp_stream_helpers::pushCompressor(mStreamBuffer, comp_stream_helpers::Method(method));
+  comp_stream_helpers::pushCompressor(mStreamBuffer, comp_stream_helpers::Method(method), nThreads);
   mStreamBuffer.push(boost::iostreams::file_sink(filename));
 }
 
-ocomp_stream::ocomp_stream(std::ostream& backend, std::string method)
+ocomp_stream::ocomp_stream(std::ostream& backend, std::string method, int nThreads)
   : mStreamBuffer(), std::ostream(&mStreamBuffer)
 {
-  comp_stream_helpers::pushCompressor(mStreamBuffer, comp_stream_helpers::Method(method));
+  comp_stream_helpers::pushCompressor(mStreamBuffer, comp_stream_helpers::Method(method), nThreads);
   mStreamBuffer.push(backend);
 }
 } // namespace io
@@ -29,7 +29,10 @@
 #undef NDEBUG
 #endif
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <fairlogger/Logger.h>
 #include <typeinfo>
@@ -310,6 +313,199 @@ void ConfigurableParam::fromCCDB(std::string filename)
 
 // ------------------------------------------------------------------
 
+namespace
+{
+// Layout of a configuration snapshot: a header followed, for each value which
+// does not come from the code, by its key, its offset in the parameter object,
+// its type, its provenance and its bytes (or characters for a std::string).
+constexpr uint32_t SnapshotMagic = 0x4f324350; // "O2CP"
+constexpr uint32_t SnapshotVersion = 1;
+
+struct SnapshotType {
+  std::type_info const& tinfo;
+  size_t size; // 0 for a std::string
+};
+
+// the types which can be stored in the key to storage map (see nameToTypeInfo)
+const std::array<SnapshotType, 14> snapshotTypes{{{typeid(char), sizeof(char)},
+                                                  {typeid(unsigned char), sizeof(unsigned char)},
+                                                  {typeid(short), sizeof(short)},
+                                                  {typeid(unsigned short), sizeof(unsigned short)},
+                                                  {typeid(int), sizeof(int)},
+                                                  {typeid(unsigned int), sizeof(unsigned int)},
+                                                  {typeid(long), sizeof(long)},
+                                                  {typeid(unsigned long), sizeof(unsigned long)},
+                                                  {typeid(float), sizeof(float)},
+                                                  {typeid(double), sizeof(double)},
+                                                  {typeid(bool), sizeof(bool)},
+                                                  {typeid(long long), sizeof(long long)},
+                                                  {typeid(unsigned long long), sizeof(unsigned long long)},
+                                                  {typeid(std::string), 0}}};
+
+template <typename T>
+void writeBinary(std::ostream& out, T value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readBinary(std::istream& in, T& value)
+{
+  return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void writeBinary(std::ostream& out, std::string const& value)
+{
+  writeBinary<uint32_t>(out, value.size());
+  out.write(value.data(), value.size());
+}
+
+bool readBinary(std::istream& in, std::string& value)
+{
+  uint32_t size = 0;
+  if (!readBinary(in, size)) {
+    return false;
+  }
+  value.resize(size);
+  return bool(in.read(value.data(), size));
+}
+} // namespace
+
+// Write the values which were changed with respect to the code (from the command
+// line, configuration files or CCDB) to a binary snapshot, which devices of the same
+// build can load with updateFromSnapshot instead of parsing the configuration again.
+// Returns false, without writing, if one of these values has an unsupported type.
+bool ConfigurableParam::writeSnapshot(std::string const& filename)
+{
+  if (!sIsFullyInitialized) {
+    initialize();
+  }
+  std::map<std::string, char const*> paramAddresses;
+  for (auto p : *sRegisteredParamClasses) {
+    paramAddresses.emplace(p->getName(), reinterpret_cast<char const*>(p));
+  }
+
+  std::ostringstream out;
+  uint32_t nValues = 0;
+  for (auto& [key, provenance] : *sValueProvenanceMap) {
+    if (provenance == kCODE) {
+      continue;
+    }
+    auto storage = sKeyToStorageMap->find(key);
+    auto param = paramAddresses.find(key.substr(0, key.find('.')));
+    auto type = snapshotTypes.end();
+    if (storage != sKeyToStorageMap->end()) {
+      type = std::find_if(snapshotTypes.begin(), snapshotTypes.end(), [&storage](auto const& t) { return t.tinfo == storage->second.first; });
+    }
+    if (param == paramAddresses.end() || type == snapshotTypes.end()) {
+      LOG(error) << "Cannot write the value of " << key << " to the configuration snapshot";
+      return false;
+    }
+    auto address = static_cast<char const*>(storage->second.second);
+    writeBinary(out, key);
+    writeBinary<uint64_t>(out, address - param->second);
+    writeBinary<uint8_t>(out, type - snapshotTypes.begin());
+    writeBinary<uint8_t>(out, provenance);
+    if (type->size == 0) {
+      writeBinary(out, *reinterpret_cast<std::string const*>(address));
+    } else {
+      writeBinary(out, std::string(address, type->size));
+    }
+    ++nValues;
+  }
+
+  std::ofstream file(filename, std::ios::binary);
+  writeBinary(file, SnapshotMagic);
+  writeBinary(file, SnapshotVersion);
+  writeBinary(file, nValues);
+  file << out.str();
+  if (!file) {
+    LOG(error) << "Cannot write the configuration snapshot " << filename;
+    return false;
+  }
+  return true;
+}
+
+// ------------------------------------------------------------------
+
+// Load a snapshot written by writeSnapshot. The values are copied directly into
+// the parameter objects, without ROOT reflection nor string conversion, unless
+// the parameter database is already initialized, in which case it is updated.
+// The values of the parameters which are not linked in this executable are ignored.
+bool ConfigurableParam::updateFromSnapshot(std::string const& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  uint32_t magic = 0, version = 0, nValues = 0;
+  if (!readBinary(file, magic) || !readBinary(file, version) || !readBinary(file, nValues) ||
+      magic != SnapshotMagic || version != SnapshotVersion) {
+    LOG(error) << "Cannot read the configuration snapshot " << filename;
+    return false;
+  }
+  if (sRegisteredParamClasses == nullptr) {
+    return true;
+  }
+  std::map<std::string, char*> paramAddresses;
+  for (auto p : *sRegisteredParamClasses) {
+    paramAddresses.emplace(p->getName(), reinterpret_cast<char*>(p));
+  }
+
+  std::string key, value;
+  uint64_t offset = 0;
+  uint8_t typeIndex = 0, provenance = 0;
+  for (uint32_t i = 0; i < nValues; ++i) {
+    if (!readBinary(file, key) || !readBinary(file, offset) || !readBinary(file, typeIndex) ||
+        !readBinary(file, provenance) || !readBinary(file, value) || typeIndex >= snapshotTypes.size()) {
+      LOG(error) << "Corrupted configuration snapshot " << filename;
+      return false;
+    }
+    auto param = paramAddresses.find(key.substr(0, key.find('.')));
+    if (param == paramAddresses.end()) {
+      continue;
+    }
+    auto& type = snapshotTypes[typeIndex];
+    auto address = param->second + offset;
+    if (type.size == 0) {
+      *reinterpret_cast<std::string*>(address) = value;
+    } else if (value.size() == type.size) {
+      std::memcpy(address, value.data(), type.size);
+    } else {
+      LOG(error) << "Corrupted configuration snapshot " << filename;
+      return false;
+    }
+    // initialize() only adds the provenance of the keys which are not yet known
+    (*sValueProvenanceMap)[key] = static_cast<EParamProvenance>(provenance);
+  }
+  if (sIsFullyInitialized) {
+    initPropertyTree();
+  }
+  updateIODirectories();
+  return true;
+}
+
+// ------------------------------------------------------------------
+
+// propagate the input and output directories changed through the KeyValParam
+void ConfigurableParam::updateIODirectories()
+{
+  auto isChanged = [](std::string const& key) {
+    auto iter = sValueProvenanceMap->find(key);
+    return iter != sValueProvenanceMap->end() && iter->second != kCODE;
+  };
+  const auto& kv = o2::conf::KeyValParam::Instance();
+  if (isChanged("keyval.input_dir")) {
+    ConfigurableParamReaders::setInputDir(o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(kv.input_dir)));
+  }
+  if (isChanged("keyval.output_dir")) {
+    if (kv.output_dir == "/dev/null") {
+      sOutputDir = kv.output_dir;
+    } else {
+      sOutputDir = o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(kv.output_dir));
+    }
+  }
+}
+
+// ------------------------------------------------------------------
+
 ConfigurableParam::ConfigurableParam()
 {
   if (sRegisteredParamClasses == nullptr) {
@@ -487,17 +683,7 @@ void ConfigurableParam::updateFromString(std::string const& configString)
 
   setValues(keyValues);
 
-  const auto& kv = o2::conf::KeyValParam::Instance();
-  if (getProvenance("keyval.input_dir") != kCODE) {
-    ConfigurableParamReaders::setInputDir(o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(kv.input_dir)));
-  }
-  if (getProvenance("keyval.output_dir") != kCODE) {
-    if (kv.output_dir == "/dev/null") {
-      sOutputDir = kv.output_dir;
-    } else {
-      sOutputDir = o2::utils::Str::concat_string(o2::utils::Str::rectifyDirectory(kv.output_dir));
-    }
-  }
+  updateIODirectories();
 }
 
 // setValues takes a vector of pairs where each pair is a key and value
@@ -16,6 +16,9 @@
 #include "TROOT.h"
 #include "TKey.h"
 #include <random>
+#include <array>
+#include <atomic>
+#include "TFile.h"
 #include "Framework/Logger.h"
 #endif
 
@@ -31,7 +34,12 @@ o2::utils::DebugStreamer::DebugStreamer()
 void o2::utils::DebugStreamer::setStreamer(const char* outFile, const char* option, const size_t id)
 {
   if (!isStreamerSet(id)) {
-    mTreeStreamer[id] = std::make_unique<o2::utils::TreeStreamRedirector>(fmt::format("{}_{}.root", outFile, id).data(), option);
+    auto streamer = std::make_unique<o2::utils::TreeStreamRedirector>(fmt::format("{}_{}.root", outFile, id).data(), option);
+    // the compression of full baskets is the dominant cost of writing, use a cheaper setting if requested
+    if (const int compression = ParameterDebugStreamer::Instance().compression; compression >= 0 && streamer->GetFile()) {
+      streamer->GetFile()->SetCompressionSettings(compression);
+    }
+    mTreeStreamer[id] = std::move(streamer);
   }
 }
 
@@ -55,6 +63,12 @@ void o2::utils::DebugStreamer::flush()
   }
 }
 
+namespace
+{
+/// number of entries accepted by checkStream for each streamer, used for the maximum number of entries
+std::array<std::atomic<size_t>, o2::utils::StreamFlags::streamFlagsCount> sNAcceptedEntries{};
+} // namespace
+
 bool o2::utils::DebugStreamer::checkStream(const StreamFlags streamFlag, const size_t samplingID, const float weight)
 {
   const bool isStreamerSet = ((getStreamFlags() & streamFlag) == streamFlag);
@@ -63,8 +77,11 @@ bool o2::utils::DebugStreamer::checkStream(const StreamFlags streamFlag, const s
   }
 
   // check sampling frequency
-  const auto sampling = getSamplingTypeFrequency(streamFlag);
-  if (sampling.first != SamplingTypes::sampleAll) {
+  auto isSampled = [&]() {
+    const auto sampling = getSamplingTypeFrequency(streamFlag);
+    if (sampling.first == SamplingTypes::sampleAll) {
+      return true;
+    }
     auto sampleTrack = [&]() {
       if (samplingID == -1) {
         LOGP(fatal, "Sampling type sampleID not supported for stream flag {}", (int)streamFlag);
@@ -102,11 +119,44 @@ bool o2::utils::DebugStreamer::checkStream(const StreamFlags streamFlag, const s
     } else if (sampling.first == SamplingTypes::sampleWeights) {
       // sample with weight
       return (weight * getRandom() < sampling.second);
+    } else if (sampling.first == SamplingTypes::sampleHash) {
+      if (samplingID == -1) {
+        LOGP(fatal, "Sampling type sampleHash not supported for stream flag {}", (int)streamFlag);
+      }
+      // no state needed: the same ID gives the same decision everywhere
+      return (getHashUniform(samplingID) < sampling.second);
     }
+    return true;
+  };
+
+  if (!isSampled()) {
+    return false;
+  }
+
+  // limit the number of written entries
+  const int index = getIndex(streamFlag);
+  const int maxEntries = ParameterDebugStreamer::Instance().maxEntries[index];
+  if (maxEntries > 0 && sNAcceptedEntries[index].fetch_add(1, std::memory_order_relaxed) >= static_cast<size_t>(maxEntries)) {
+    return false;
   }
   return true;
 }
 
+float o2::utils::DebugStreamer::getHashUniform(const size_t samplingID)
+{
+  // splitmix64 finalizer of the ID mixed with the seed
+  uint64_t h = static_cast<uint64_t>(samplingID) + (static_cast<uint64_t>(ParameterDebugStreamer::Instance().samplingSeed) + 1) * 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return static_cast<float>((h >> 40) * 0x1.0p-24); // 24 bits to stay below 1 in float
+}
+
+size_t o2::utils::DebugStreamer::getNAcceptedEntries(const StreamFlags streamFlag)
+{
+  return sNAcceptedEntries[getIndex(streamFlag)].load(std::memory_order_relaxed);
+}
+
 float o2::utils::DebugStreamer::getRandom(float min, float max)
 {
   // init random number generator for each thread
@@ -18,6 +18,7 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TKey.h>
+#include <algorithm>
 
 using namespace o2::utils;
 
@@ -32,6 +33,74 @@ gsl::span<const o2::dataformats::IRFrame> IRFrameSelector::getMatchingFrames(con
   return {&*lower, size_t(std::distance(lower, upper))};
 }
 
+bool IRFrameSelector::isSelected(o2::dataformats::IRFrame fr, size_t bwd, size_t fwd)
+{
+  // check if fr, expanded by -bwd and fwd BCs, overlaps with at least 1 entry in the frames container
+  // it is equivalent to check(...) >= 0 but is done in O(1) for a single BC when the frames span is short enough
+  // to be covered by the mask of selected BCs, as for the frames selected in a TF
+  if (mBCMask.empty()) {
+    return check(fr, bwd, fwd) >= 0;
+  }
+  int64_t bcMin = fr.getMin().toLong(), bcMax = fr.getMax().toLong();
+  bcMin = bcMin > int64_t(bwd) ? bcMin - int64_t(bwd) : 0;
+  bcMax = o2::InteractionRecord::MaxGlobalBCs - bcMax > int64_t(fwd) ? bcMax + int64_t(fwd) : o2::InteractionRecord::MaxGlobalBCs;
+  bcMin = std::max(bcMin, mBCMaskStart);
+  bcMax = std::min(bcMax, mBCMaskEnd);
+  if (bcMin > bcMax) { // no selected BC outside of the mask
+    return false;
+  }
+  size_t first = bcMin - mBCMaskStart, last = bcMax - mBCMaskStart;
+  size_t firstWord = first / 64, lastWord = last / 64;
+  for (size_t iw = firstWord; iw <= lastWord; iw++) {
+    auto bits = mBCMask[iw];
+    if (iw == firstWord) {
+      bits &= ~0ULL << (first % 64);
+    }
+    if (iw == lastWord) {
+      bits &= ~0ULL >> (63 - last % 64);
+    }
+    if (bits) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void IRFrameSelector::buildBCMask()
+{
+  // fill the mask of selected BCs if the frames cover a short enough interval
+  mBCMask.clear();
+  mBCMaskStart = 0;
+  mBCMaskEnd = -1;
+  if (!mFrames.size()) {
+    return;
+  }
+  int64_t bcMin = mFrames.front().getMin().toLong(), bcMax = bcMin;
+  for (const auto& fr : mFrames) {
+    bcMax = std::max(bcMax, fr.getMax().toLong());
+  }
+  if (bcMax - bcMin >= MaxBCMaskSize) {
+    return; // keep using the search in the frames
+  }
+  mBCMaskStart = bcMin;
+  mBCMaskEnd = bcMax;
+  mBCMask.resize((bcMax - bcMin) / 64 + 1, 0);
+  for (const auto& fr : mFrames) {
+    size_t first = fr.getMin().toLong() - bcMin, last = fr.getMax().toLong() - bcMin;
+    size_t firstWord = first / 64, lastWord = last / 64;
+    for (size_t iw = firstWord; iw <= lastWord; iw++) {
+      auto bits = ~0ULL;
+      if (iw == firstWord) {
+        bits &= ~0ULL << (first % 64);
+      }
+      if (iw == lastWord) {
+        bits &= ~0ULL >> (63 - last % 64);
+      }
+      mBCMask[iw] |= bits;
+    }
+  }
+}
+
 long IRFrameSelector::check(o2::dataformats::IRFrame fr, size_t bwd, size_t fwd)
 {
   // check if fr overlaps with at least 1 entry in the frames container, if needed expand fr by -bwd and fwd BCs from 2 sides
@@ -184,6 +253,7 @@ void IRFrameSelector::clear()
   mIsSet = false;
   mOwnList.clear();
   mFrames = {};
+  buildBCMask();
 }
 
 void IRFrameSelector::applyMargins(size_t bwd, size_t fwd, long shift, bool removeOverlaps)
@@ -40,6 +40,9 @@ namespace utils
 const char* SHMIDNAME = "ALICEO2_SIMSHM_SHMID";
 // a common virtual address under which this should be mapped
 const char* SHMADDRNAME = "ALICEO2_SIMSHM_COMMONADDR";
+// the (default) huge page size and the normal page size
+constexpr size_t HUGEPAGESIZE = 2 * 1024 * 1024;
+constexpr size_t PAGESIZE = 4096;
 
 ShmManager::ShmManager() = default;
 
@@ -98,13 +101,14 @@ void ShmManager::printSegInfo() const
 {
   if (mSegInfoPtr) {
     LOG(info) << "ATTACHED WORKERS " << mSegInfoPtr->counter;
+    LOG(info) << "HUGE PAGES " << mHugePages;
     LOG(info) << "CONNECTION FAILURES " << mSegInfoPtr->failures;
   } else {
     LOG(info) << "no segment info to print";
   }
 }
 
-bool ShmManager::createGlobalSegment(int nsegments)
+bool ShmManager::createGlobalSegment(int nsegments, bool hugepages, bool prefault)
 {
   mIsMaster = true;
   // first of all take a look if we really start from a clean state
@@ -122,8 +126,24 @@ bool ShmManager::createGlobalSegment(int nsegments)
 #ifdef USESHM
   LOG(info) << "CREATING SIM SHARED MEM SEGMENT FOR " << nsegments << " WORKERS";
   // LOG(info) << "SIZEOF ShmMetaInfo " << sizeof(ShmMetaInfo);
-  const auto totalsize = sizeof(ShmMetaInfo) + SHMPOOLSIZE * nsegments;
-  if ((mShmID = shmget(IPC_PRIVATE, totalsize, IPC_CREAT | 0666)) == -1) {
+  auto totalsize = sizeof(ShmMetaInfo) + SHMPOOLSIZE * nsegments;
+#ifdef SHM_HUGETLB
+  if (hugepages) {
+    // the size of a huge page segment must be a multiple of the huge page size
+    const auto hugesize = (totalsize + HUGEPAGESIZE - 1) / HUGEPAGESIZE * HUGEPAGESIZE;
+    if ((mShmID = shmget(IPC_PRIVATE, hugesize, IPC_CREAT | SHM_HUGETLB | 0666)) != -1) {
+      totalsize = hugesize;
+      mHugePages = true;
+    } else {
+      LOG(warn) << "COULD NOT CREATE HUGE PAGE SEGMENT OF " << hugesize << " BYTES ... FALLING BACK TO NORMAL PAGES";
+    }
+  }
+#else
+  if (hugepages) {
+    LOG(warn) << "HUGE PAGE SEGMENTS NOT SUPPORTED ON THIS PLATFORM";
+  }
+#endif
+  if (!mHugePages && (mShmID = shmget(IPC_PRIVATE, totalsize, IPC_CREAT | 0666)) == -1) {
     perror("shmget: shmget failed");
   } else {
     // We are attaching once to determine a common virtual address under which everyone else should attach.
@@ -132,6 +152,14 @@ bool ShmManager::createGlobalSegment(int nsegments)
     mSegPtr = addr;
     LOG(debug) << "COMMON ADDRESS " << addr << " AS NUMBER " << (unsigned long long)addr;
 
+    if (prefault && addr != (void*)-1) {
+      // touch every page once, the physical pages then exist before the workers attach
+      const auto pagesize = mHugePages ? HUGEPAGESIZE : PAGESIZE;
+      for (size_t offset = 0; offset < totalsize; offset += pagesize) {
+        static_cast<volatile char*>(addr)[offset] = 0;
+      }
+    }
+
     // initialize the meta information (counter)
     o2::utils::ShmMetaInfo info;
     std::memcpy(addr, &info, sizeof(info));
@@ -13,11 +13,14 @@
 // from multiple TTree (containing a subset of branches).
 // A typical example is TPC clusterization/digitization: Clusters per TPC
 // sector may sit in different files and we want to produce an aggregate TTree
-// for further processing. The utility offers options to use TFriends or to make
-// a deep copy.
+// for further processing. The utility offers options to use TFriends, to make
+// a deep copy (optionally keeping only the entries passing a selection) or to
+// copy the compressed baskets of each file without decompressing them.
 
 #include <TTree.h>
 #include <TFile.h>
+#include <TROOT.h>
+#include <TTreeFormula.h>
 #include <boost/program_options.hpp>
 #include <set>
 #include <vector>
@@ -27,7 +30,10 @@ struct Options {
   std::vector<std::string> infilenames;
   std::string treename;
   std::string outfilename;
+  std::string selection;
   bool asfriend = false;
+  bool fast = false;
+  int nthreads = 1;
 };
 
 // just to make a protected interface accessible
@@ -53,7 +59,10 @@ bool parseOptions(int argc, char* argv[], Options& optvalues)
     "infiles,i", bpo::value<std::vector<std::string>>(&optvalues.infilenames)->multitoken(), "All input files to be merged")(
     "treename,t", bpo::value<std::string>(&optvalues.treename), "Name of tree (assumed same in all files).")(
     "outfile,o", bpo::value<std::string>(&optvalues.outfilename)->default_value(""), "Outfile to be created with merged tree.")(
-    "asfriend", "If merging is done using the friend mechanism.");
+    "asfriend", "If merging is done using the friend mechanism.")(
+    "fast", "If the compressed baskets of each file are copied without decompressing them. The trees of the other files are attached as friends of the first one within the output file.")(
+    "selection,s", bpo::value<std::string>(&optvalues.selection)->default_value(""), "Only copy the entries passing this selection on the branches of all files (deep copy only).")(
+    "nthreads,n", bpo::value<int>(&optvalues.nthreads)->default_value(1), "Number of threads used by ROOT to (de)compress the baskets in parallel.");
   options.add_options()("help,h", "Produce help message.");
 
   bpo::variables_map vm;
@@ -69,6 +78,17 @@ bool parseOptions(int argc, char* argv[], Options& optvalues)
     if (vm.count("asfriend")) {
       optvalues.asfriend = true;
     }
+    if (vm.count("fast")) {
+      optvalues.fast = true;
+    }
+    if (optvalues.asfriend && optvalues.fast) {
+      std::cerr << "The options asfriend and fast are exclusive\n";
+      return false;
+    }
+    if (!optvalues.selection.empty() && (optvalues.asfriend || optvalues.fast)) {
+      std::cerr << "A selection can only be applied with a deep copy\n";
+      return false;
+    }
 
   } catch (const bpo::error& e) {
     std::cerr << e.what() << "\n\n";
@@ -159,7 +179,32 @@ static char DataTypeToChar(EDataType datatype)
   return 0;
 }
 
-void merge(Options const& options)
+// Fills the list of entries passing the selection, evaluated on the
+// trees of all files joined as friends
+bool selectEntries(Options const& options, std::vector<Long64_t>& entries)
+{
+  entries.clear();
+  TFile mainfile(options.infilenames[0].c_str(), "OPEN");
+  auto tree = (TTree*)mainfile.Get(options.treename.c_str());
+  for (int i = 1; i < options.infilenames.size(); ++i) {
+    tree->AddFriend(options.treename.c_str(), options.infilenames[i].c_str());
+  }
+  TTreeFormula formula("selection", options.selection.c_str(), tree);
+  if (formula.GetNdim() == 0) {
+    std::cerr << "Invalid selection " << options.selection << "\n";
+    return false;
+  }
+  for (Long64_t e = 0; e < tree->GetEntries(); ++e) {
+    tree->LoadTree(e);
+    if (formula.GetNdata() > 0 && formula.EvalInstance(0) != 0) {
+      entries.push_back(e);
+    }
+  }
+  std::cout << entries.size() << " out of " << tree->GetEntries() << " entries pass the selection\n";
+  return true;
+}
+
+bool merge(Options const& options)
 {
   if (options.asfriend) {
     // open the output file
@@ -182,10 +227,40 @@ void merge(Options const& options)
     //auto maintree = mainfile->Get<TTree>(firsttreename);
     //maintree->AddFriend(friendcopy);
     //mainfile->Write();
+  } else if (options.fast) {
+    // a copy of the compressed baskets of each tree into the output file,
+    // the trees of the other files being friends of the first one
+    TFile outfile(options.outfilename.c_str(), "RECREATE");
+    TTree* maintree = nullptr;
+    for (int i = 0; i < options.infilenames.size(); ++i) {
+      TFile _tmp(options.infilenames[i].c_str(), "OPEN");
+      auto t = (TTree*)_tmp.Get(options.treename.c_str());
+      outfile.cd();
+      auto copy = t->CloneTree(-1, "fast");
+      if (copy == nullptr) {
+        std::cerr << "Error copying the tree of " << options.infilenames[i] << "\n";
+        return false;
+      }
+      if (maintree == nullptr) {
+        maintree = copy;
+      } else {
+        copy->SetName(Form("%s_%d", options.treename.c_str(), i));
+        maintree->AddFriend(copy);
+      }
+      copy->Write();
+    }
+    maintree->Write("", TObject::kOverwrite);
+    outfile.Close();
   } else {
     // a deep copy solution
 
-    auto copyBranch = [](TTree* t, TBranch* br) -> bool {
+    std::vector<Long64_t> entries;
+    if (!options.selection.empty() && !selectEntries(options, entries)) {
+      return false;
+    }
+    auto selected = options.selection.empty() ? nullptr : &entries;
+
+    auto copyBranch = [selected](TTree* t, TBranch* br) -> bool {
       // Get data from original branch and copy to new
       // by using generic type/class information of old.
       // We are using some internals of the TTree implementation. (Luckily these
@@ -207,8 +282,9 @@ void merge(Options const& options)
         }
         if (newbr) {
           br->SetAddress(&data);
-          for (int e = 0; e < br->GetEntries(); ++e) {
-            auto size = br->GetEntry(e);
+          Long64_t nEntries = selected ? selected->size() : br->GetEntries();
+          for (Long64_t e = 0; e < nEntries; ++e) {
+            auto size = br->GetEntry(selected ? (*selected)[e] : e);
             newbr->Fill();
           }
           br->ResetAddress();
@@ -233,7 +309,7 @@ void merge(Options const& options)
           std::cerr << "Error copying branch " << br->GetName() << "\n";
         }
       }
-      outtree->SetEntries(t->GetEntries());
+      outtree->SetEntries(selected ? selected->size() : t->GetEntries());
     }
     outfile.Write();
     outfile.Close();
@@ -243,6 +319,7 @@ void merge(Options const& options)
   // https://root-forum.cern.ch/t/make-a-new-ttree-from-a-deep-vertical-union-of-existing-ttrees/44250
   // ... but this solution has problems since ROOT 6-24 since RDataFrame may change the internal type
   // of std::vector<> using a non-default allocator which may cause problem when reading data back.
+  return true;
 }
 
 int main(int argc, char* argv[])
@@ -257,8 +334,14 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (optvalues.nthreads > 1) {
+    ROOT::EnableImplicitMT(optvalues.nthreads);
+  }
+
   // merge files
-  merge(optvalues);
+  if (!merge(optvalues)) {
+    return 1;
+  }
 
   return 0;
 }
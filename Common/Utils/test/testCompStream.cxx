@@ -128,3 +128,43 @@ BOOST_AUTO_TEST_CASE(test_compstream_methods_mapper)
   BOOST_REQUIRE(checker(o2::io::CompressionMethod::Bzip2, "bzip2"));
   //BOOST_REQUIRE(checker(o2::io::CompressionMethod::Lzma, "lzma"));
 }
+
+BOOST_AUTO_TEST_CASE(test_compstream_parallel_gzip)
+{
+  // enough data for several blocks compressed in parallel, with an incomplete last block
+  const int range = 1000000;
+  std::stringstream pipe;
+  {
+    o2::io::ocomp_stream stream(pipe, o2::io::CompressionMethod::Gzip, 4);
+    for (int i = 0; i < range; i++) {
+      stream << i << " ";
+    }
+    stream << std::endl;
+  }
+
+  {
+    o2::io::icomp_stream stream(pipe, o2::io::CompressionMethod::Gzip);
+    int val;
+    int expected = 0;
+    while (stream >> val) {
+      BOOST_CHECK(val == expected);
+      if (val != expected) {
+        break;
+      }
+      ++expected;
+    }
+    BOOST_CHECK(expected == range);
+  }
+
+  // an empty stream is still a valid gzip stream
+  std::stringstream emptyPipe;
+  {
+    o2::io::ocomp_stream stream(emptyPipe, "gzip", 4);
+  }
+  {
+    o2::io::icomp_stream stream(emptyPipe, "gzip");
+    int val;
+    BOOST_CHECK(!(stream >> val));
+    BOOST_CHECK(stream.eof());
+  }
+}
@@ -0,0 +1,47 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test IRFrameSelector
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "CommonUtils/IRFrameSelector.h"
+#include <TRandom.h>
+#include <vector>
+
+using namespace o2;
+
+BOOST_AUTO_TEST_CASE(IRFrameSelector_test)
+{
+  // frames covering few orbits use the mask of selected BCs, frames spread over a long period use the search,
+  // both must give the same answer as the stateful check
+  for (int64_t spacing : {50, 100000}) {
+    std::vector<dataformats::IRFrame> frames;
+    int64_t bc = 1000;
+    for (int i = 0; i < 200; i++) {
+      bc += 1 + gRandom->Integer(spacing);
+      int64_t width = gRandom->Integer(10);
+      frames.emplace_back(InteractionRecord::long2IR(bc), InteractionRecord::long2IR(bc + width));
+      bc += width;
+    }
+    utils::IRFrameSelector selector, reference;
+    selector.setSelectedIRFrames(frames, 3, 5, 0, true);
+    reference.setSelectedIRFrames(frames, 3, 5, 0, true);
+    for (int i = 0; i < 100000; i++) {
+      auto bcMin = int64_t(gRandom->Integer(bc + 2000));
+      auto ir = InteractionRecord::long2IR(bcMin);
+      size_t bwd = gRandom->Integer(3), fwd = gRandom->Integer(3);
+      BOOST_CHECK_EQUAL(selector.isSelected(ir, bwd, fwd), reference.check(ir, bwd, fwd) >= 0);
+      dataformats::IRFrame fr{ir, InteractionRecord::long2IR(bcMin + gRandom->Integer(200))};
+      BOOST_CHECK_EQUAL(selector.isSelected(fr), reference.check(fr) >= 0);
+    }
+  }
+}
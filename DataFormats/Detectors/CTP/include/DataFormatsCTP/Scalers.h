@@ -84,6 +84,22 @@ struct CTPScalerRecordO2 {
   void printFromZero(std::ostream& stream, CTPScalerRecordO2& record0) const;
   ClassDefNV(CTPScalerRecordO2, 4);
 };
+/// Rates of a single class counter or input precomputed from the O2 scaler records.
+/// Interval i spans the records i and i+1, the lookups give the same answer as
+/// CTPRunScalers::getRate/getRateGivenT without touching the full scaler records.
+struct CTPScalerRates {
+  CTPScalerRates() = default;
+  std::vector<uint32_t> orbits; // orbit of each scaler record
+  std::vector<double> times;    // epoch time of each scaler record
+  std::vector<double> rates;    // rate in Hz in each interval between consecutive records, orbits.size()-1 entries
+  double globalRate = -1.;      // mean rate between the first and the last record
+  size_t size() const { return rates.size(); }
+  /// pair of global rate and rate in the interval containing the orbit, -1 if out of bounds
+  std::pair<double, double> getRate(uint32_t orbit) const;
+  /// same with absolute timestamp (not orbit) as argument
+  std::pair<double, double> getRateGivenT(double timestamp) const;
+  ClassDefNV(CTPScalerRates, 1);
+};
 class CTPRunScalers
 {
  public:
@@ -132,6 +148,9 @@ class CTPRunScalers
   /// same with absolute  timestamp (not orbit) as argument
   std::pair<double, double> getRateGivenT(double timestamp, int classindex, int type) const;
 
+  /// precomputes the rates of one counter (same classindex/type convention as getRate) for repeated lookups
+  CTPScalerRates getScalerRates(int classindex, int type) const;
+
   /// retrieves time boundaries of this scaler object from O2 scalers
   std::pair<unsigned long, unsigned long> getTimeLimit() const
   {
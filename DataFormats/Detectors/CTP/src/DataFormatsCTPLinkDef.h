@@ -43,6 +43,7 @@
 #pragma link C++ class vector < o2::ctp::CTPScalerRecordRaw> + ;
 #pragma link C++ class o2::ctp::CTPScalerRecordO2 + ;
 #pragma link C++ class vector < o2::ctp::CTPScalerRecordO2> + ;
+#pragma link C++ class o2::ctp::CTPScalerRates + ;
 #pragma link C++ class o2::ctp::CTPRunScalers + ;
 #pragma link C++ class o2::ctp::LumiInfo + ;
 #pragma link C++ class vector < o2::ctp::LumiInfo> + ;
@@ -15,6 +15,7 @@
 #include "DataFormatsCTP/Scalers.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include "CommonUtils/StringUtils.h"
 #include <fairlogger/Logger.h>
 
@@ -693,8 +694,8 @@ std::pair<double, double> CTPRunScalers::getRate(uint32_t orbit, int classindex,
           return -1; // wrong type
       }
     } else if (type == 7) {
-      auto s0 = &(prev->scalersInps[classindex]); // type CTPScalerO2*
-      auto s1 = &(next->scalersInps[classindex]);
+      auto s0 = prev->scalersInps[classindex];
+      auto s1 = next->scalersInps[classindex];
       return (s1 - s0) / timedelta;
     } else {
       LOG(error) << "Wrong type:" << type;
@@ -777,6 +778,88 @@ std::pair<double, double> CTPRunScalers::getRateGivenT(double timestamp, int cla
   }
   return std::make_pair(-1., -1.);
 }
+// precomputes the rates of one counter for all scaler record intervals
+// type - 7 : inputs
+// type - 1..6 : lmb,lma,l0b,l0a,l1b,l1a
+CTPScalerRates CTPRunScalers::getScalerRates(int classindex, int type) const
+{
+  CTPScalerRates res;
+  size_t nrec = mScalerRecordO2.size();
+  if (nrec <= 1) {
+    LOG(error) << "not enough data";
+    return res;
+  }
+  if (type < 1 || type > 7) {
+    LOG(error) << "Wrong type:" << type;
+    return res;
+  }
+  // gather the counter of interest into contiguous arrays once ...
+  std::vector<uint64_t> counts(nrec);
+  res.orbits.resize(nrec);
+  res.times.resize(nrec);
+  for (size_t i = 0; i < nrec; i++) {
+    const auto& rec = mScalerRecordO2[i];
+    res.orbits[i] = rec.intRecord.orbit;
+    res.times[i] = rec.epochTime;
+    if (type == 7) {
+      counts[i] = rec.scalersInps[classindex];
+      continue;
+    }
+    const auto& scal = rec.scalers[classindex];
+    switch (type) {
+      case 1:
+        counts[i] = scal.lmBefore;
+        break;
+      case 2:
+        counts[i] = scal.lmAfter;
+        break;
+      case 3:
+        counts[i] = scal.l0Before;
+        break;
+      case 4:
+        counts[i] = scal.l0After;
+        break;
+      case 5:
+        counts[i] = scal.l1Before;
+        break;
+      default:
+        counts[i] = scal.l1After;
+    }
+  }
+  // ... so that the rates are a branch-free loop over them
+  res.rates.resize(nrec - 1);
+  const auto* orb = res.orbits.data();
+  const auto* cnt = counts.data();
+  auto* rate = res.rates.data();
+  for (size_t i = 0; i < nrec - 1; i++) {
+    rate[i] = double(cnt[i + 1] - cnt[i]) / (double(orb[i + 1] - orb[i]) * 88.e-6); // converts orbits into time
+  }
+  res.globalRate = double(counts[nrec - 1] - counts[0]) / (double(res.orbits[nrec - 1] - res.orbits[0]) * 88.e-6);
+  return res;
+}
+std::pair<double, double> CTPScalerRates::getRate(uint32_t orbit) const
+{
+  if (orbits.size() <= 1) {
+    return std::make_pair(-1., -1.);
+  }
+  // first record with orbit greater than the given one
+  auto nextindex = std::upper_bound(orbits.begin(), orbits.end(), orbit) - orbits.begin();
+  if (nextindex == 0 || nextindex == orbits.size()) {
+    return std::make_pair(globalRate, -1.);
+  }
+  return std::make_pair(globalRate, rates[nextindex - 1]);
+}
+std::pair<double, double> CTPScalerRates::getRateGivenT(double timestamp) const
+{
+  if (times.size() <= 1) {
+    return std::make_pair(-1., -1.);
+  }
+  auto nextindex = std::upper_bound(times.begin(), times.end(), timestamp) - times.begin();
+  if (nextindex == 0 || nextindex == times.size()) {
+    return std::make_pair(globalRate, -1.);
+  }
+  return std::make_pair(globalRate, rates[nextindex - 1]);
+}
 // Offset orbit of all records
 //
 int CTPRunScalers::addOrbitOffset(uint32_t offset)
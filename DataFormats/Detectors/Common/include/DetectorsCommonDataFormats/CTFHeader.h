@@ -31,11 +31,12 @@ struct CTFHeader {
   uint32_t firstTForbit = 0;              // first orbit of time frame as unique identifier within the run
   uint32_t tfCounter = 0;                 // original TFcounter of the TF
   o2::detectors::DetID::mask_t detectors; // mask of represented detectors
+  uint32_t dictTimeStamp = 0;             // version of the last dictionary created online by the CTF writer, 0 if none
 
   std::string describe() const;
   void print() const;
 
-  ClassDefNV(CTFHeader, 4)
+  ClassDefNV(CTFHeader, 5)
 };
 
 std::ostream& operator<<(std::ostream& stream, const CTFHeader& c);
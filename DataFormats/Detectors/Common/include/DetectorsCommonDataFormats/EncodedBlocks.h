@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <Rtypes.h>
 #include <any>
+#include <algorithm>
 
 #include "TTree.h"
 #include "CommonUtils/StringUtils.h"
@@ -66,17 +67,56 @@ inline constexpr bool is_iterator_v = is_iterator<T>::value;
 
 inline constexpr bool mayEEncode(Metadata::OptStore opt) noexcept
 {
-  return (opt == Metadata::OptStore::EENCODE) || (opt == Metadata::OptStore::EENCODE_OR_PACK);
+  return (opt == Metadata::OptStore::EENCODE) || (opt == Metadata::OptStore::EENCODE_OR_PACK) || (opt == Metadata::OptStore::EENCODE_CTX) ||
+         (opt == Metadata::OptStore::EENCODE_STREAM);
 }
 
 inline constexpr bool mayPack(Metadata::OptStore opt) noexcept
 {
-  return (opt == Metadata::OptStore::PACK) || (opt == Metadata::OptStore::EENCODE_OR_PACK);
+  return (opt == Metadata::OptStore::PACK) || (opt == Metadata::OptStore::EENCODE_OR_PACK) || (opt == Metadata::OptStore::EENCODE_CTX) ||
+         (opt == Metadata::OptStore::EENCODE_STREAM);
+}
+
+/// descriptor of the sub-stream of one context class in a block stored with Metadata::OptStore::EENCODE_CTX
+struct ContextStreamHeader {
+  uint32_t messageLength = 0;
+  uint32_t nLiterals = 0;
+  int32_t min = 0;
+  int32_t max = 0;
+  int32_t literalsPackingOffset = 0;
+  uint8_t nStreams = 0;
+  uint8_t streamingLowerBound = 0;
+  uint8_t probabilityBits = 0;
+  uint8_t literalsPackingWidth = 0;
+  int32_t nDictWords = 0;
+  int32_t nDataWords = 0;
+  int32_t nLiteralWords = 0;
+
+  int32_t getNWords() const { return nDictWords + nDataWords + nLiteralWords; }
+};
+
+/// number of words of the table preceding the context streams: nContexts, ctxMin and the stream headers
+template <typename W>
+inline constexpr size_t getContextTableWords(size_t nContexts) noexcept
+{
+  static_assert(sizeof(ContextStreamHeader) % sizeof(W) == 0);
+  return 2 + nContexts * sizeof(ContextStreamHeader) / sizeof(W);
+}
+
+/// context class of the context value, the values above ctxMin + nContexts - 1 share the last class
+inline size_t getContextClass(int64_t ctx, int64_t ctxMin, size_t nContexts) noexcept
+{
+  return std::clamp<int64_t>(ctx - ctxMin, 0, nContexts - 1);
 }
 
 } // namespace detail
 constexpr size_t PackingThreshold = 512;
 
+constexpr size_t ContextCodingThreshold = 8 * PackingThreshold; // shorter messages do not pay for the per-context dictionaries
+constexpr uint8_t MaxContextBits = 4;                            // at most 16 context classes
+
+constexpr size_t StreamingChunkSize = 1 << 20; // symbols per independently coded chunk with OptStore::EENCODE_STREAM
+
 constexpr size_t Alignment = 16;
 
 constexpr int WrappersSplitLevel = 99;
@@ -453,6 +493,10 @@ class EncodedBlocks
   /// estimate free size needed to add new block
   static size_t estimateBlockSize(int n) { return Block<W>::estimateSize(n); }
 
+  /// create in the vector a scratch container to fill only the provided slot, with the space for nBytes of its payload reserved
+  template <typename VD>
+  static auto createForSlot(VD& v, int slot, size_t nBytes);
+
   /// check if empty and valid
   bool empty() const { return (mRegistry.offsFreeStart == alignSize(sizeof(*this))) && (mRegistry.size >= mRegistry.offsFreeStart); }
 
@@ -503,6 +547,19 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encode(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
 
+  /// encode src to the block at provided slot with one symbol table per class of the context stream (OptStore::EENCODE_CTX),
+  /// the i-th entry of the context stream being the context of the i-th source entry. Falls back to encode(), i.e. order-0 coding,
+  /// if the context coding is not requested, not supported (rANS compat, external encoder) or does not pay off.
+  template <typename input_IT, typename ctx_IT, typename buffer_T>
+  o2::ctf::CTFIOSize encodeWithContext(const input_IT srcBegin, const input_IT srcEnd, const ctx_IT ctxBegin, int slot, uint8_t ctxBits, uint8_t symbolTablePrecision, Metadata::OptStore opt, buffer_T* buffer = nullptr, const std::any& encoderExt = {}, float memfc = 1.f);
+
+  /// declare the slots preceding the provided one as empty, so that it can be filled in an otherwise empty (scratch) container
+  void skipSlots(int slot);
+
+  /// copy the block and metadata of the provided slot from another container (e.g. a scratch container filled by a different thread)
+  template <typename buffer_T>
+  void copySlot(const EncodedBlocks& src, int slot, buffer_T* buffer);
+
   /// decode block at provided slot to destination vector (will be resized as needed)
   template <class container_T, class container_IT = typename container_T::iterator>
   o2::ctf::CTFIOSize decode(container_T& dest, int slot, const std::any& decoderExt = {}) const;
@@ -511,6 +568,11 @@ class EncodedBlocks
   template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
   o2::ctf::CTFIOSize decode(D_IT dest, int slot, const std::any& decoderExt = {}) const;
 
+  /// decode block at provided slot to destination pointer using the already decoded context stream, blocks not stored with
+  /// OptStore::EENCODE_CTX are decoded by decode()
+  template <typename D_IT, typename ctx_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
+  o2::ctf::CTFIOSize decodeWithContext(D_IT dest, const ctx_IT ctxBegin, int slot, const std::any& decoderExt = {}) const;
+
 #ifndef __CLING__
   /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
   static std::vector<char> createDictionaryBlocks(const std::vector<rans::DenseHistogram<int32_t>>& vfreq, const std::vector<Metadata>& prbits);
@@ -600,6 +662,10 @@ class EncodedBlocks
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize encodeRANSV1Inplace(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
 
+  /// encode in chunks of StreamingChunkSize symbols, iterating twice over the source without caching it (OptStore::EENCODE_STREAM)
+  template <typename input_IT, typename buffer_T>
+  o2::ctf::CTFIOSize encodeRANSV1Streaming(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer = nullptr, double_t sizeEstimateSafetyFactor = 1);
+
 #ifndef __CLING__
   template <typename input_IT, typename buffer_T>
   o2::ctf::CTFIOSize pack(const input_IT srcBegin, const input_IT srcEnd, int slot, rans::Metrics<typename std::iterator_traits<input_IT>::value_type> metrics, buffer_T* buffer = nullptr);
@@ -637,9 +703,15 @@ class EncodedBlocks
   template <typename dst_IT>
   CTFIOSize decodeRansV1Impl(dst_IT dest, int slot, const std::any& decoderExt) const;
 
+  template <typename dst_IT>
+  CTFIOSize decodeRansV1StreamImpl(dst_IT dest, int slot) const;
+
   template <typename dst_IT>
   CTFIOSize decodeUnpackImpl(dst_IT dest, int slot) const;
 
+  template <typename dst_T>
+  void decodeContextStream(const detail::ContextStreamHeader& ch, const W* payload, dst_T* dest) const;
+
   template <typename dst_IT>
   CTFIOSize decodeCopyImpl(dst_IT dest, int slot) const;
 
@@ -878,6 +950,19 @@ inline auto EncodedBlocks<H, N, W>::create(VD& v)
   return create(v.data(), v.size() * vsz);
 }
 
+///_____________________________________________________________________________
+/// create scratch container for single slot, pre-sized to avoid its expansions during the encoding
+template <typename H, int N, typename W>
+template <typename VD>
+inline auto EncodedBlocks<H, N, W>::createForSlot(VD& v, int slot, size_t nBytes)
+{
+  size_t vsz = sizeof(typename std::remove_reference<decltype(v)>::type::value_type); // size of the element of the buffer
+  v.resize((getMinAlignedSize() + estimateBlockSize(nBytes / sizeof(W) + 1) + vsz - 1) / vsz);
+  auto b = create(v);
+  b->skipSlots(slot);
+  return b;
+}
+
 ///_____________________________________________________________________________
 /// print itself
 template <typename H, int N, typename W>
@@ -947,6 +1032,10 @@ CTFIOSize EncodedBlocks<H, N, W>::decode(D_IT dest,                        // it
     }
     if (md.opt == Metadata::OptStore::EENCODE) {
       return decodeRansV1Impl(dest, slot, decoderExt);
+    } else if (md.opt == Metadata::OptStore::EENCODE_STREAM) {
+      return decodeRansV1StreamImpl(dest, slot);
+    } else if (md.opt == Metadata::OptStore::EENCODE_CTX) {
+      throw std::runtime_error(fmt::format("slot {} is context coded and must be decoded with its context stream", slot));
     } else {
       return decodeCopyImpl(dest, slot);
     }
@@ -1048,6 +1137,138 @@ CTFIOSize EncodedBlocks<H, N, W>::decodeRansV1Impl(dst_IT dstBegin, int slot, co
   return {0, md.getUncompressedSize(), md.getCompressedSize()};
 };
 
+template <typename H, int N, typename W>
+template <typename dst_IT>
+CTFIOSize EncodedBlocks<H, N, W>::decodeRansV1StreamImpl(dst_IT dstBegin, int slot) const
+{
+  // get references to the right data
+  const auto& block = mBlocks[slot];
+  const auto& md = mMetadata[slot];
+
+  using dst_type = typename std::iterator_traits<dst_IT>::value_type;
+  using decoder_type = typename rans::defaultDecoder_type<dst_type>;
+
+  std::optional<decoder_type> decoder{};
+  std::visit([&](auto&& arg) { decoder = decoder_type{arg}; }, this->getDictionary<dst_type>(slot));
+  if (md.probabilityBits != decoder->getSymbolTablePrecision()) {
+    throw std::runtime_error(fmt::format(
+      "Missmatch in decoder renorming precision vs metadata:{} Bits vs {} Bits.",
+      md.probabilityBits, decoder->getSymbolTablePrecision()));
+  }
+
+  // the literals of all chunks are stored together, those of chunk i end after the literals of chunks 0..i
+  std::vector<dst_type> literals(md.nLiterals);
+  if (block.getNLiterals()) {
+    rans::unpack(block.getLiterals(), md.nLiterals, literals.data(), md.literalsPackingWidth, md.literalsPackingOffset);
+  }
+
+  // data layout: chunk size, then nStreamWords, nLiterals and the encoded stream of each chunk
+  const W* data = block.getData();
+  const W* const dataEnd = data + block.getNData();
+  const size_t chunkSize = *data++;
+  size_t nDecoded = 0;
+  size_t nLiteralsDecoded = 0;
+  while (nDecoded < md.messageLength) {
+    const size_t nAvailable = std::distance(data, dataEnd);
+    if (nAvailable < 2 || nAvailable < 2 + size_t(data[0]) || nLiteralsDecoded + data[1] > md.nLiterals) {
+      throw std::runtime_error(fmt::format("slot {}: corrupted chunk header after {} of {} decoded symbols", slot, nDecoded, md.messageLength));
+    }
+    const size_t nChunkSymbols = std::min(chunkSize, md.messageLength - nDecoded);
+    nLiteralsDecoded += data[1];
+    data += 2 + data[0];
+    if (literals.empty()) {
+      decoder->process(data, std::next(dstBegin, nDecoded), nChunkSymbols, md.nStreams);
+    } else {
+      decoder->process(data, std::next(dstBegin, nDecoded), nChunkSymbols, md.nStreams, literals.begin() + nLiteralsDecoded);
+    }
+    nDecoded += nChunkSymbols;
+  }
+  return {0, md.getUncompressedSize(), md.getCompressedSize()};
+};
+
+template <typename H, int N, typename W>
+template <typename D_IT, typename ctx_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool>>
+CTFIOSize EncodedBlocks<H, N, W>::decodeWithContext(D_IT dest,                        // iterator to destination
+                                                    const ctx_IT ctxBegin,            // iterator to the decoded context stream
+                                                    int slot,                         // slot of the block to decode
+                                                    const std::any& decoderExt) const // optional externally provided decoder
+{
+  const auto& md = mMetadata[slot];
+  if (md.opt != Metadata::OptStore::EENCODE_CTX) {
+    return decode(dest, slot, decoderExt);
+  }
+  using dst_type = typename std::iterator_traits<D_IT>::value_type;
+
+  // data layout: nContexts, ctxMin, nContexts stream headers, the streams (dictionary, data, literals) in context order
+  const W* data = mBlocks[slot].getData();
+  const size_t nContexts = data[0];
+  if (!nContexts || nContexts > rans::utils::pow2(MaxContextBits) || detail::getContextTableWords<W>(nContexts) > size_t(md.nDataWords)) {
+    throw std::runtime_error(fmt::format("slot {}: corrupted context table with {} contexts", slot, nContexts));
+  }
+  const int64_t ctxMin = static_cast<int32_t>(data[1]);
+  const auto* headers = reinterpret_cast<const detail::ContextStreamHeader*>(data + 2);
+  const W* payload = data + detail::getContextTableWords<W>(nContexts);
+  const W* payloadEnd = data + md.nDataWords;
+
+  std::vector<std::vector<dst_type>> streams(nContexts);
+  size_t nDecoded = 0;
+  for (size_t ic = 0; ic < nContexts; ic++) {
+    const auto& ch = headers[ic];
+    if (payload + ch.getNWords() > payloadEnd || (nDecoded += ch.messageLength) > md.messageLength) {
+      throw std::runtime_error(fmt::format("slot {}: corrupted context stream {} of {}", slot, ic, nContexts));
+    }
+    streams[ic].resize(ch.messageLength);
+    decodeContextStream(ch, payload, streams[ic].data());
+    payload += ch.getNWords();
+  }
+  if (nDecoded != md.messageLength) {
+    throw std::runtime_error(fmt::format("slot {}: context streams hold {} entries instead of {}", slot, nDecoded, md.messageLength));
+  }
+
+  // interleave the streams in the order of the context
+  std::vector<size_t> positions(nContexts, 0);
+  auto ctxIt = ctxBegin;
+  for (size_t i = 0; i < md.messageLength; i++) {
+    const auto ic = detail::getContextClass(*ctxIt++, ctxMin, nContexts);
+    if (positions[ic] == streams[ic].size()) {
+      throw std::runtime_error(fmt::format("slot {}: context stream does not match the encoded data at entry {}", slot, i));
+    }
+    *dest++ = streams[ic][positions[ic]++];
+  }
+  return {0, md.getUncompressedSize(), md.getCompressedSize()};
+}
+
+template <typename H, int N, typename W>
+template <typename dst_T>
+void EncodedBlocks<H, N, W>::decodeContextStream(const detail::ContextStreamHeader& ch, const W* payload, dst_T* dest) const
+{
+  using decoder_type = typename rans::defaultDecoder_type<dst_T>;
+  if (!ch.messageLength) {
+    return;
+  }
+  const W* dict = payload;
+  const W* data = dict + ch.nDictWords;
+  const W* literals = data + ch.nDataWords;
+
+  std::optional<decoder_type> decoder{};
+  if constexpr (sizeof(dst_T) > 2) {
+    decoder = decoder_type{rans::readRenormedSetDictionary(dict, data, static_cast<dst_T>(ch.min), static_cast<dst_T>(ch.max), ch.probabilityBits)};
+  } else {
+    decoder = decoder_type{rans::readRenormedDictionary(dict, data, static_cast<dst_T>(ch.min), static_cast<dst_T>(ch.max), ch.probabilityBits)};
+  }
+  if (ch.streamingLowerBound != rans::utils::getStreamingLowerBound_v<typename decoder_type::coder_type>) {
+    throw std::runtime_error("Streaming lower bound of context stream and decoder do not match");
+  }
+
+  if (ch.nLiteralWords) {
+    std::vector<dst_T> literalsBuffer(ch.nLiterals);
+    rans::unpack(literals, ch.nLiterals, literalsBuffer.data(), ch.literalsPackingWidth, ch.literalsPackingOffset);
+    decoder->process(data + ch.nDataWords, dest, ch.messageLength, ch.nStreams, literalsBuffer.end());
+  } else {
+    decoder->process(data + ch.nDataWords, dest, ch.messageLength, ch.nStreams);
+  }
+}
+
 template <typename H, int N, typename W>
 template <typename dst_IT>
 CTFIOSize EncodedBlocks<H, N, W>::decodeUnpackImpl(dst_IT dest, int slot) const
@@ -1145,6 +1366,179 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encode(const input_IT srcBegin,
   }
 };
 
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT, typename ctx_IT, typename buffer_T>
+o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::encodeWithContext(const input_IT srcBegin,      // iterator begin of source message
+                                                             const input_IT srcEnd,        // iterator end of source message
+                                                             const ctx_IT ctxBegin,        // iterator begin of the context stream
+                                                             int slot,                     // slot in encoded data to fill
+                                                             uint8_t ctxBits,              // number of bits of the context class
+                                                             uint8_t symbolTablePrecision, // encoding into
+                                                             Metadata::OptStore opt,       // option for data compression
+                                                             buffer_T* buffer,             // optional buffer (vector) providing memory for encoded blocks
+                                                             const std::any& encoderExt,   // optional external encoder
+                                                             float memfc)                  // memory allocation margin factor
+{
+  using storageBuffer_t = W;
+  using input_t = typename std::iterator_traits<input_IT>::value_type;
+  using ransEncoder_t = typename rans::denseEncoder_type<input_t>;
+  using ransState_t = typename ransEncoder_t::coder_type::state_type;
+  using ransStream_t = typename ransEncoder_t::stream_type;
+  using coder_t = internal::InplaceEntropyCoder<input_t>;
+
+  const size_t messageLength = std::distance(srcBegin, srcEnd);
+  // the per-context dictionaries are stored in the block, which is supported only by rANS V1 without external dictionary
+  if (opt != Metadata::OptStore::EENCODE_CTX || getANSHeader() != ANSVersion1 || encoderExt.has_value() || !ctxBits || messageLength < ContextCodingThreshold) {
+    return encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, buffer, encoderExt, memfc);
+  }
+  const size_t nContexts = rans::utils::pow2(std::min(ctxBits, MaxContextBits));
+
+  // split the source by context class
+  int32_t ctxMin = std::numeric_limits<int32_t>::max();
+  auto ctxIt = ctxBegin;
+  for (size_t i = 0; i < messageLength; i++) {
+    ctxMin = std::min<int64_t>(ctxMin, *ctxIt++);
+  }
+  std::vector<std::vector<input_t>> sources(nContexts);
+  ctxIt = ctxBegin;
+  for (auto it = srcBegin; it != srcEnd; ++it) {
+    sources[detail::getContextClass(*ctxIt++, ctxMin, nContexts)].push_back(*it);
+  }
+
+  // encode with context only if the estimated size of the per-context streams beats the order-0 one
+  auto estimateSize = [](const coder_t& coder) {
+    const auto estimate = coder.getMetrics().getSizeEstimate();
+    return estimate.getCompressedDatasetSize(1.) + estimate.getCompressedDictionarySize(1.) + estimate.getIncompressibleSize(1.);
+  };
+  std::vector<coder_t> coders(nContexts);
+  try {
+    size_t contextSize = detail::getContextTableWords<storageBuffer_t>(nContexts) * sizeof(storageBuffer_t);
+    for (size_t ic = 0; ic < nContexts; ic++) {
+      if (sources[ic].size()) {
+        coders[ic] = coder_t{sources[ic].data(), sources[ic].data() + sources[ic].size()};
+        contextSize += estimateSize(coders[ic]);
+      }
+    }
+    const coder_t order0{srcBegin, srcEnd};
+    if ((detail::mayPack(opt) && order0.getMetrics().getSizeEstimate().preferPacking()) || contextSize >= estimateSize(order0)) {
+      return encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, buffer, encoderExt, memfc);
+    }
+  } catch (const rans::HistogramError& error) {
+    return encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, buffer, encoderExt, memfc);
+  }
+
+  // fill a new block
+  assert(slot == mRegistry.nFilledBlocks);
+  mRegistry.nFilledBlocks++;
+  auto* thisBlock = &mBlocks[slot];
+  auto* thisMetadata = &mMetadata[slot];
+
+  const size_t headerWords = detail::getContextTableWords<storageBuffer_t>(nContexts);
+  size_t bufferSizeWords = headerWords;
+  for (size_t ic = 0; ic < nContexts; ic++) {
+    if (sources[ic].size()) {
+      coders[ic].makeEncoder();
+      const auto estimate = coders[ic].getMetrics().getSizeEstimate();
+      bufferSizeWords += rans::utils::nBytesTo<storageBuffer_t>((estimate.getCompressedDictionarySize() +
+                                                                 estimate.getCompressedDatasetSize() +
+                                                                 estimate.getIncompressibleSize()) *
+                                                                memfc);
+    }
+  }
+  std::tie(thisBlock, thisMetadata) = expandStorage(slot, bufferSizeWords, buffer);
+
+  storageBuffer_t* const dataBegin = thisBlock->getCreateData();
+  storageBuffer_t* const dataEnd = thisBlock->getEndOfBlock();
+  rans::utils::checkBounds(dataBegin + headerWords, dataEnd);
+  dataBegin[0] = nContexts;
+  dataBegin[1] = static_cast<storageBuffer_t>(ctxMin);
+  auto* headers = reinterpret_cast<detail::ContextStreamHeader*>(dataBegin + 2);
+  storageBuffer_t* streamEnd = dataBegin + headerWords;
+  size_t nLiterals = 0;
+  input_t min = std::numeric_limits<input_t>::max(), max = std::numeric_limits<input_t>::min();
+  for (size_t ic = 0; ic < nContexts; ic++) {
+    auto& ch = headers[ic] = detail::ContextStreamHeader{};
+    if (sources[ic].empty()) {
+      continue;
+    }
+    auto& coder = coders[ic];
+    const auto& metrics = coder.getMetrics();
+    auto* dictEnd = coder.writeDictionary(streamEnd, dataEnd);
+    auto* encodedEnd = coder.encode(sources[ic].data(), sources[ic].data() + sources[ic].size(), dictEnd, dataEnd);
+    auto* literalsEnd = coder.getNIncompressibleSamples() ? coder.writeIncompressible(encodedEnd, dataEnd) : encodedEnd;
+    ch.messageLength = sources[ic].size();
+    ch.nLiterals = coder.getNIncompressibleSamples();
+    ch.min = *metrics.getCoderProperties().min;
+    ch.max = *metrics.getCoderProperties().max;
+    ch.literalsPackingOffset = metrics.getDatasetProperties().min;
+    ch.nStreams = coder.getNStreams();
+    ch.streamingLowerBound = rans::utils::getStreamingLowerBound_v<typename ransEncoder_t::coder_type>;
+    ch.probabilityBits = coder.getSymbolTablePrecision();
+    ch.literalsPackingWidth = metrics.getDatasetProperties().alphabetRangeBits;
+    ch.nDictWords = std::distance(streamEnd, dictEnd);
+    ch.nDataWords = std::distance(dictEnd, encodedEnd);
+    ch.nLiteralWords = std::distance(encodedEnd, literalsEnd);
+    streamEnd = literalsEnd;
+    nLiterals += ch.nLiterals;
+    min = std::min(min, metrics.getDatasetProperties().min);
+    max = std::max(max, metrics.getDatasetProperties().max);
+  }
+  const size_t dataSize = std::distance(dataBegin, streamEnd);
+  thisBlock->setNData(dataSize);
+  thisBlock->realignBlock();
+  LOGP(debug, "StoreData {} bytes in {} contexts, offs: {}:{}", dataSize * sizeof(storageBuffer_t), nContexts, thisBlock->getOffsData(), thisBlock->getOffsData() + dataSize * sizeof(storageBuffer_t));
+
+  // the metadata describes the whole message, the dictionaries and literals are stored per context in the data area
+  *thisMetadata = detail::makeMetadataRansV1<input_t, ransState_t, ransStream_t>(0,
+                                                                                 rans::utils::getStreamingLowerBound_v<typename ransEncoder_t::coder_type>,
+                                                                                 messageLength,
+                                                                                 nLiterals,
+                                                                                 0,
+                                                                                 min,
+                                                                                 max,
+                                                                                 0,
+                                                                                 0,
+                                                                                 0,
+                                                                                 dataSize,
+                                                                                 0);
+  thisMetadata->opt = Metadata::OptStore::EENCODE_CTX;
+  return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
+};
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+void EncodedBlocks<H, N, W>::skipSlots(int slot)
+{
+  assert(slot >= mRegistry.nFilledBlocks && slot <= N);
+  for (int i = mRegistry.nFilledBlocks; i < slot; i++) {
+    mMetadata[i] = Metadata{};
+    mMetadata[i].opt = Metadata::OptStore::NODATA;
+  }
+  mRegistry.nFilledBlocks = slot;
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::copySlot(const EncodedBlocks& src, int slot, buffer_T* buffer)
+{
+  // fill a new block
+  assert(slot == mRegistry.nFilledBlocks);
+  mRegistry.nFilledBlocks++;
+
+  const auto& srcBlock = src.mBlocks[slot];
+  const auto& srcMetadata = src.mMetadata[slot];
+  if (srcMetadata.opt == Metadata::OptStore::NODATA) {
+    mMetadata[slot] = srcMetadata;
+    return;
+  }
+  // after the expansion this (hence its data members) are not guaranteed to be valid
+  auto [thisBlock, thisMetadata] = expandStorage(slot, srcBlock.getNStored(), buffer);
+  thisBlock->store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  *thisMetadata = srcMetadata;
+}
+
 template <typename H, int N, typename W>
 template <typename T>
 [[nodiscard]] auto EncodedBlocks<H, N, W>::expandStorage(size_t slot, size_t nElements, T* buffer) -> decltype(auto)
@@ -1284,6 +1678,8 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::entropyCodeRANSV1(const input_IT srcB
 
     if (encoderExt.has_value()) {
       encoderStatistics = encodeRANSV1External(srcBegin, srcEnd, slot, encoderExt, buffer, memfc);
+    } else if (opt == Metadata::OptStore::EENCODE_STREAM) {
+      encoderStatistics = encodeRANSV1Streaming(srcBegin, srcEnd, slot, opt, buffer, memfc);
     } else {
       encoderStatistics = encodeRANSV1Inplace(srcBegin, srcEnd, slot, opt, buffer, memfc);
     }
@@ -1461,6 +1857,105 @@ CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Inplace(const input_IT srcBegin, c
   return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
 }; // namespace ctf
 
+template <typename H, int N, typename W>
+template <typename input_IT, typename buffer_T>
+CTFIOSize EncodedBlocks<H, N, W>::encodeRANSV1Streaming(const input_IT srcBegin, const input_IT srcEnd, int slot, Metadata::OptStore opt, buffer_T* buffer, double_t sizeEstimateSafetyFactor)
+{
+  using storageBuffer_t = W;
+  using input_t = typename std::iterator_traits<input_IT>::value_type;
+  using ransEncoder_t = typename rans::denseEncoder_type<input_t>;
+  using ransState_t = typename ransEncoder_t::coder_type::state_type;
+  using ransStream_t = typename ransEncoder_t::stream_type;
+
+  // assert at compile time that output types align so that padding is not necessary.
+  static_assert(std::is_same_v<storageBuffer_t, ransStream_t>);
+  static_assert(std::is_same_v<storageBuffer_t, typename rans::count_t>);
+
+  auto* thisBlock = &mBlocks[slot];
+  auto* thisMetadata = &mMetadata[slot];
+
+  // the 1st pass over the source builds the histogram, the 2nd one encodes it chunk by chunk. Unlike encodeRANSV1Inplace
+  // the source is never cached, only a single chunk of it is held by the encoder.
+  internal::InplaceEntropyCoder<input_t> encoder{};
+  try {
+    encoder = internal::InplaceEntropyCoder<input_t>{srcBegin, srcEnd};
+  } catch (const rans::HistogramError& error) {
+    LOGP(warning, "Failed to build Dictionary for rANS encoding, using fallback option");
+    return store(srcBegin, srcEnd, slot, this->FallbackStorageType, buffer);
+  }
+
+  const rans::Metrics<input_t>& metrics = encoder.getMetrics();
+  if (detail::mayPack(opt) && metrics.getSizeEstimate().preferPacking()) {
+    return pack(srcBegin, srcEnd, slot, metrics, buffer);
+  }
+
+  encoder.makeEncoder();
+
+  const size_t messageLength = std::distance(srcBegin, srcEnd);
+  const rans::SizeEstimate sizeEstimate = metrics.getSizeEstimate();
+  const size_t dictSizeWords = rans::utils::nBytesTo<storageBuffer_t>(sizeEstimate.getCompressedDictionarySize() * sizeEstimateSafetyFactor);
+  std::tie(thisBlock, thisMetadata) = expandStorage(slot, dictSizeWords, buffer);
+
+  // encode dict
+  auto encodedDictEnd = encoder.writeDictionary(thisBlock->getCreateDict(), thisBlock->getEndOfBlock());
+  const size_t dictSize = std::distance(thisBlock->getCreateDict(), encodedDictEnd);
+  thisBlock->setNDict(dictSize);
+  thisBlock->realignBlock();
+  LOGP(debug, "StoreDict {} bytes, offs: {}:{}", dictSize * sizeof(storageBuffer_t), thisBlock->getOffsDict(), thisBlock->getOffsDict() + dictSize * sizeof(storageBuffer_t));
+
+  // encode payload: the chunk size, then nStreamWords, nLiterals and the encoded stream of each chunk. The storage reserved
+  // for the estimated size grows geometrically if the chunks need more.
+  const size_t nChunks = (messageLength + StreamingChunkSize - 1) / StreamingChunkSize;
+  size_t reservedWords = rans::utils::nBytesTo<storageBuffer_t>(sizeEstimate.getCompressedDatasetSize() * sizeEstimateSafetyFactor) + 1 + 2 * nChunks;
+  std::tie(thisBlock, thisMetadata) = expandStorage(slot, reservedWords, buffer);
+  size_t dataSize = 0;
+  thisBlock->getCreateData()[dataSize++] = StreamingChunkSize;
+
+  encoder.encodeStreaming(srcBegin, srcEnd, StreamingChunkSize, [&](const auto& chunk, const ransStream_t* streamBegin, const ransStream_t* streamEnd) {
+    const size_t requiredWords = dataSize + 2 + chunk.nStreamWords;
+    if (requiredWords > reservedWords) {
+      reservedWords = std::max(requiredWords, reservedWords + reservedWords / 2);
+      std::tie(thisBlock, thisMetadata) = expandStorage(slot, reservedWords, buffer);
+    }
+    auto* chunkData = thisBlock->getCreateData() + dataSize;
+    chunkData[0] = chunk.nStreamWords;
+    chunkData[1] = chunk.nLiterals;
+    std::copy(streamBegin, streamEnd, chunkData + 2);
+    dataSize = requiredWords;
+  });
+  thisBlock->setNData(dataSize);
+  thisBlock->realignBlock();
+  LOGP(debug, "StoreData {} bytes in {} chunks, offs: {}:{}", dataSize * sizeof(storageBuffer_t), nChunks, thisBlock->getOffsData(), thisBlock->getOffsData() + dataSize * sizeof(storageBuffer_t));
+
+  // encode literals of all chunks
+  size_t literalsSize{};
+  if (encoder.getNIncompressibleSamples() > 0) {
+    std::tie(thisBlock, thisMetadata) = expandStorage(slot, encoder.template getPackedIncompressibleSize<storageBuffer_t>(), buffer);
+    auto literalsEnd = encoder.writeIncompressible(thisBlock->getCreateLiterals(), thisBlock->getEndOfBlock());
+    literalsSize = std::distance(thisBlock->getCreateLiterals(), literalsEnd);
+    thisBlock->setNLiterals(literalsSize);
+    thisBlock->realignBlock();
+    LOGP(debug, "StoreLiterals {} bytes, offs: {}:{}", literalsSize * sizeof(storageBuffer_t), thisBlock->getOffsLiterals(), thisBlock->getOffsLiterals() + literalsSize * sizeof(storageBuffer_t));
+  }
+
+  // write metadata
+  *thisMetadata = detail::makeMetadataRansV1<input_t, ransState_t, ransStream_t>(encoder.getNStreams(),
+                                                                                 rans::utils::getStreamingLowerBound_v<typename ransEncoder_t::coder_type>,
+                                                                                 messageLength,
+                                                                                 encoder.getNIncompressibleSamples(),
+                                                                                 encoder.getSymbolTablePrecision(),
+                                                                                 *metrics.getCoderProperties().min,
+                                                                                 *metrics.getCoderProperties().max,
+                                                                                 metrics.getDatasetProperties().min,
+                                                                                 metrics.getDatasetProperties().alphabetRangeBits,
+                                                                                 dictSize,
+                                                                                 dataSize,
+                                                                                 literalsSize);
+  thisMetadata->opt = Metadata::OptStore::EENCODE_STREAM;
+
+  return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
+};
+
 template <typename H, int N, typename W>
 template <typename input_IT, typename buffer_T>
 o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::pack(const input_IT srcBegin, const input_IT srcEnd, int slot, rans::Metrics<typename std::iterator_traits<input_IT>::value_type> metrics, buffer_T* buffer)
@@ -30,7 +30,9 @@ struct Metadata {
     NONE,                         // original data repacked to array with slot-size = streamSize and saved w/o compression
     NODATA,                       // no data was provided
     PACK,                         // use Bitpacking
-    EENCODE_OR_PACK               // decide at runtime if to encode or pack
+    EENCODE_OR_PACK,              // decide at runtime if to encode or pack
+    EENCODE_CTX,                  // entropy encoding with symbol tables selected by a context stream, see EncodedBlocks::encodeWithContext
+    EENCODE_STREAM                // entropy encoding in independent chunks without caching the source, see EncodedBlocks::encodeRANSV1Streaming
   };
   uint8_t nStreams = 0;              // Amount of concurrent Streams used by the encoder. only used by rANS version >=1.
   size_t messageLength = 0;          // Message length (multiply with messageWordSize to get size in Bytes).
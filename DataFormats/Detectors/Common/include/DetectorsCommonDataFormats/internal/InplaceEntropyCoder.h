@@ -79,6 +79,10 @@ class InplaceEntropyCoder
   template <typename src_IT, typename dst_IT>
   [[nodiscard]] dst_IT encode(src_IT srcBegin, src_IT srcEnd, dst_IT dstBegin, dst_IT dstEnd);
 
+  /// encode in independent chunks of chunkSize symbols iterating the source once, see rans::StreamingEncoder for the sink
+  template <typename src_IT, typename sink_F>
+  void encodeStreaming(src_IT srcBegin, src_IT srcEnd, size_t chunkSize, sink_F&& sink);
+
   template <typename dst_IT>
   [[nodiscard]] dst_IT writeDictionary(dst_IT dstBegin, dst_IT dstEnd);
 
@@ -205,6 +209,24 @@ template <typename src_IT, typename dst_IT>
   return messageEnd;
 };
 
+template <typename source_T>
+template <typename src_IT, typename sink_F>
+void InplaceEntropyCoder<source_T>::encodeStreaming(src_IT srcBegin, src_IT srcEnd, size_t chunkSize, sink_F&& sink)
+{
+  static_assert(std::is_same_v<source_T, typename std::iterator_traits<src_IT>::value_type>);
+
+  std::visit([&, this](auto&& encoder) {
+    rans::StreamingEncoder<std::decay_t<decltype(encoder)>> streamingEncoder{encoder, chunkSize};
+    if (encoder.getSymbolTable().hasEscapeSymbol()) {
+      mIncompressibleBuffer.reserve(*mMetrics.getCoderProperties().nIncompressibleSamples);
+      streamingEncoder.process(srcBegin, srcEnd, sink, std::back_inserter(mIncompressibleBuffer));
+    } else {
+      streamingEncoder.process(srcBegin, srcEnd, sink);
+    }
+  },
+             *mEncoder);
+};
+
 template <typename source_T>
 template <typename dst_IT>
 [[nodiscard]] inline dst_IT InplaceEntropyCoder<source_T>::writeDictionary(dst_IT dstBegin, dst_IT dstEnd)
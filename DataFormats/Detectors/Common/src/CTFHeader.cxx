@@ -18,7 +18,11 @@ using DetID = o2::detectors::DetID;
 /// describe itsel as a string
 std::string CTFHeader::describe() const
 {
-  return fmt::format("Run:{:07d} TF:{} Orbit:{:08d} CteationTime:{} Detectors: {}", run, tfCounter, firstTForbit, creationTime, DetID::getNames(detectors));
+  auto s = fmt::format("Run:{:07d} TF:{} Orbit:{:08d} CteationTime:{} Detectors: {}", run, tfCounter, firstTForbit, creationTime, DetID::getNames(detectors));
+  if (dictTimeStamp) {
+    s += fmt::format(" OnlineDict:{}", dictTimeStamp);
+  }
+  return s;
 }
 
 void CTFHeader::print() const
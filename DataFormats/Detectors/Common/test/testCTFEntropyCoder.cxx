@@ -204,6 +204,75 @@ BOOST_AUTO_TEST_CASE(testInplaceEncoderCombinedIterator)
   encodeInplace(begin, end);
 };
 
+template <typename source_IT>
+void encodeInplaceStreaming(source_IT begin, source_IT end, size_t chunkSize)
+{
+  using source_type = typename std::iterator_traits<source_IT>::value_type;
+
+  ctf::internal::InplaceEntropyCoder<source_type> entropyCoder{begin, end};
+  entropyCoder.makeEncoder();
+
+  const rans::Metrics<source_type>& metrics = entropyCoder.getMetrics();
+  const rans::SizeEstimate sizeEstimate = metrics.getSizeEstimate();
+
+  // each chunk is stored as nStreamWords, nLiterals, encoded stream
+  std::vector<buffer_type> encodeBuffer;
+  entropyCoder.encodeStreaming(begin, end, chunkSize, [&](const auto& chunk, const buffer_type* streamBegin, const buffer_type* streamEnd) {
+    BOOST_CHECK(chunk.nSymbols <= chunkSize);
+    encodeBuffer.push_back(chunk.nStreamWords);
+    encodeBuffer.push_back(chunk.nLiterals);
+    encodeBuffer.insert(encodeBuffer.end(), streamBegin, streamEnd);
+  });
+  std::vector<buffer_type> literalSymbolsBuffer(sizeEstimate.getIncompressibleSize<buffer_type>(), 0);
+  std::vector<buffer_type> dictBuffer(sizeEstimate.getCompressedDictionarySize<buffer_type>(), 0);
+  [[maybe_unused]] auto literalsEnd = entropyCoder.writeIncompressible(literalSymbolsBuffer.data(), literalSymbolsBuffer.data() + literalSymbolsBuffer.size());
+  auto dictEnd = entropyCoder.writeDictionary(dictBuffer.data(), dictBuffer.data() + dictBuffer.size());
+
+  // decode chunk by chunk
+  const auto& coderProperties = metrics.getCoderProperties();
+  auto decoder = rans::makeDecoder<>::fromRenormed(rans::readRenormedDictionary(dictBuffer.data(), dictEnd,
+                                                                                *coderProperties.min, *coderProperties.max,
+                                                                                *coderProperties.renormingPrecisionBits));
+  std::vector<source_type> literals(entropyCoder.getNIncompressibleSamples());
+
+  const auto& datasetPropterties = metrics.getDatasetProperties();
+  rans::unpack(literalSymbolsBuffer.data(), literals.size(), literals.data(),
+               datasetPropterties.alphabetRangeBits, datasetPropterties.min);
+
+  size_t messageLength = std::distance(begin, end);
+  std::vector<source_type> sourceBuffer(messageLength, 0);
+
+  const buffer_type* chunkIter = encodeBuffer.data();
+  auto chunkLiteralsEnd = literals.begin();
+  for (size_t nDecoded = 0; nDecoded < messageLength; nDecoded += chunkSize) {
+    const size_t nStreamWords = chunkIter[0];
+    chunkLiteralsEnd += chunkIter[1];
+    chunkIter += 2 + nStreamWords;
+    decoder.process(chunkIter, sourceBuffer.data() + nDecoded, std::min(chunkSize, messageLength - nDecoded), entropyCoder.getNStreams(), chunkLiteralsEnd);
+  }
+
+  BOOST_CHECK(chunkIter == encodeBuffer.data() + encodeBuffer.size());
+  BOOST_CHECK(chunkLiteralsEnd == literals.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(sourceBuffer.begin(), sourceBuffer.end(), begin, end);
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testInplaceEncoderStreaming, source_T, source_types)
+{
+  const auto& testMessage = MessageProxy.getMessage<source_T>();
+  encodeInplaceStreaming(testMessage.begin(), testMessage.end(), 100);
+};
+
+BOOST_AUTO_TEST_CASE(testInplaceEncoderStreamingCombinedIterator)
+{
+
+  const auto& testMessage1 = MessageProxy.getMessage<int8_t>();
+  const auto& testMessage2 = MessageProxy.getMessage<int8_t>();
+
+  auto [begin, end] = makeInputIterators(testMessage1.data(), testMessage2.data(), testMessage1.size(), ShiftFunctor<uint16_t, rans::utils::toBits<uint8_t>()>{});
+
+  encodeInplaceStreaming(begin, end, 100);
+};
+
 class ExternalEncoderDecoderProxy
 {
  public:
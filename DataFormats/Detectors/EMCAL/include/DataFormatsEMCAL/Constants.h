@@ -109,10 +109,11 @@ constexpr uint32_t Inc = 0x1 << 20; ///< trigger bit marking incomplete event
 }
 
 enum FitAlgorithm {
-  Standard = 0,  ///< Standard raw fitter
-  Gamma2 = 1,    ///< Gamma2 raw fitter
-  NeuralNet = 2, ///< Neural net raw fitter
-  NONE = 3
+  Standard = 0,    ///< Standard raw fitter
+  Gamma2 = 1,      ///< Gamma2 raw fitter
+  NeuralNet = 2,   ///< Neural net raw fitter
+  LookupTable = 3, ///< Lookup table raw fitter
+  NONE = 4
 };
 
 enum STUtype_t {
@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef ALICEO2_FOCAL_PIXELCLUSTER_H
+#define ALICEO2_FOCAL_PIXELCLUSTER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include "Rtypes.h"
+
+namespace o2::focal
+{
+/// \class PixelCluster
+/// \brief Cluster of adjacent fired pixels in one chip of a FOCAL pixel layer
+class PixelCluster
+{
+ public:
+  PixelCluster() = default;
+  PixelCluster(int layerID, int feeID, int laneID, int chipID, float column, float row, int nPixels, int columnSpan, int rowSpan) : mLayerID(layerID), mFeeID(feeID), mLaneID(laneID), mChipID(chipID), mNPixels(nPixels), mColumnSpan(columnSpan), mRowSpan(rowSpan), mColumn(column), mRow(row) {}
+  ~PixelCluster() = default;
+
+  int getLayerID() const { return mLayerID; }
+  int getFeeID() const { return mFeeID; }
+  int getLaneID() const { return mLaneID; }
+  int getChipID() const { return mChipID; }
+  /// \brief Centre of gravity of the fired pixels, in pixel units
+  float getColumn() const { return mColumn; }
+  float getRow() const { return mRow; }
+  int getNumberOfPixels() const { return mNPixels; }
+  int getColumnSpan() const { return mColumnSpan; }
+  int getRowSpan() const { return mRowSpan; }
+
+  void printStream(std::ostream& stream) const;
+
+ private:
+  uint8_t mLayerID = 0;     /// Layer index
+  uint8_t mFeeID = 0;       /// FEE ID
+  uint8_t mLaneID = 0;      /// Lane index
+  uint8_t mChipID = 0;      /// Chip index
+  uint16_t mNPixels = 0;    /// Number of fired pixels
+  uint16_t mColumnSpan = 0; /// Number of columns covered by the cluster
+  uint16_t mRowSpan = 0;    /// Number of rows covered by the cluster
+  float mColumn = 0.;       /// Mean column of the fired pixels
+  float mRow = 0.;          /// Mean row of the fired pixels
+
+  ClassDefNV(PixelCluster, 1);
+};
+
+std::ostream& operator<<(std::ostream& stream, const PixelCluster& cluster);
+
+} // namespace o2::focal
+
+#endif // ALICEO2_FOCAL_PIXELCLUSTER_H
@@ -24,6 +24,7 @@
 #pragma link C++ class o2::focal::PixelHit + ;
 #pragma link C++ class o2::focal::PixelChip + ;
 #pragma link C++ class o2::focal::PixelChipRecord + ;
+#pragma link C++ class o2::focal::PixelCluster + ;
 #pragma link C++ class o2::focal::TriggerRecord + ;
 
 #pragma link C++ class std::vector < o2::focal::Event> + ;
@@ -31,5 +32,6 @@
 #pragma link C++ class std::vector < o2::focal::PixelHit> + ;
 #pragma link C++ class std::vector < o2::focal::PixelChip> + ;
 #pragma link C++ class std::vector < o2::focal::PixelChipRecord> + ;
+#pragma link C++ class std::vector < o2::focal::PixelCluster> + ;
 #pragma link C++ class std::vector < o2::focal::TriggerRecord> + ;
 #endif
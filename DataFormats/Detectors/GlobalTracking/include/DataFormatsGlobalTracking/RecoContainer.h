@@ -28,7 +28,10 @@
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include "DataFormatsCTP/LumiInfo.h"
 #include <gsl/span>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 // We forward declare the internal structures, to reduce header dependencies.
 // Please include headers for TPC Hits or TRD tracklets directly (DataFormatsTPC/WorkflowHelper.h / DataFormatsTRD/RecoInputContainer.h)
@@ -191,6 +194,7 @@ namespace globaltracking
 struct DataRequest {
   std::vector<o2::framework::InputSpec> inputs;
   std::unordered_map<std::string, bool> requestMap;
+  mutable std::unordered_map<const char*, int> inputPositions; // positions in the InputRecord of the bindings accessed by RecoContainer, resolved at the 1st TF
   MatchingType matchingInputType = MatchingType::Standard; // use subspec = 0 for inputs
 
   auto getMatchingInputType() const { return matchingInputType; }
@@ -261,6 +265,43 @@ struct DataRequest {
 // Therefore, for the random access better to use direct getter, i.e. auto& tr = getITSTrack(gid)
 // while for looping over the whole span first create a span then iterate over it.
 
+// Holder of an object which is costly to extract from the input (e.g. the MC truth containers which need
+// deserialization): the loader registered by the RecoContainer::addXXX methods is invoked only at the 1st access
+// (thread-safe), so that the consumers which don't need the object don't pay for it.
+// Since the loader accesses the ProcessingContext inputs, the object must be accessed within the processing of the same TF.
+template <typename T>
+class LazyObject
+{
+ public:
+  using Loader = std::function<std::unique_ptr<const T>()>;
+
+  void setLoader(Loader&& loader)
+  {
+    mObj.reset();
+    mLoader = std::move(loader);
+    mLoaded = false;
+  }
+  const T* get() const
+  {
+    if (!mLoaded.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mLoaded.load(std::memory_order_relaxed)) {
+        if (mLoader) {
+          mObj = mLoader();
+        }
+        mLoaded.store(true, std::memory_order_release);
+      }
+    }
+    return mObj.get();
+  }
+
+ private:
+  Loader mLoader;
+  mutable std::mutex mMutex;
+  mutable std::atomic<bool> mLoaded{false};
+  mutable std::unique_ptr<const T> mObj;
+};
+
 struct RecoContainer {
   RecoContainer();
   ~RecoContainer();
@@ -331,15 +372,16 @@ struct RecoContainer {
   STrackAccessor strkPool;  // containers for strangeness tracking related objects
   CosmicsAccessor cosmPool; // containers for cosmics track data
 
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcHMPClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcCPVClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcMCHClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::phos::MCLabel>> mcPHSCells;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::emcal::MCLabel>> mcEMCCells;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDTrackClusters;
-  std::unique_ptr<const o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDClusters;
+  // MC truth containers of clusters are deserialized at the 1st access
+  LazyObject<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcITSClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcTOFClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcHMPClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcCPVClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::MCCompLabel>> mcMCHClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::phos::MCLabel>> mcPHSCells;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::emcal::MCLabel>> mcEMCCells;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDTrackClusters;
+  LazyObject<o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>> mcMIDClusters;
   std::unique_ptr<const std::vector<o2::MCCompLabel>> mcMIDTracks;
   o2::ctp::LumiInfo mCTPLumi;
 
@@ -348,8 +390,11 @@ struct RecoContainer {
 
   std::unique_ptr<o2::tpc::internal::getWorkflowTPCInput_ret> inputsTPCclusters; // special struct for TPC clusters access
   std::unique_ptr<o2::trd::RecoInputContainer> inputsTRD;                        // special struct for TRD tracklets, trigger records
+  const DataRequest* mDataRequest = nullptr;                                     // request being collected, caching the positions of the inputs
 
   void collectData(o2::framework::ProcessingContext& pc, const DataRequest& request);
+  template <typename T>
+  decltype(auto) getInput(o2::framework::ProcessingContext& pc, const char* binding);
   void createTracks(std::function<bool(const o2::track::TrackParCov&, GTrackID)> const& creator) const;
   template <class T>
   void createTracksVariadic(T creator, GTrackID::mask_t srcSel = GTrackID::getSourcesMask("all")) const;
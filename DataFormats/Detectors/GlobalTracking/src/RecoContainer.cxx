@@ -56,6 +56,36 @@ using DetID = o2::detectors::DetID;
 RecoContainer::RecoContainer() = default;
 RecoContainer::~RecoContainer() = default;
 
+namespace
+{
+// loader of the object from the input, to be invoked at the 1st access
+template <typename T>
+typename LazyObject<T>::Loader lazyInput(ProcessingContext& pc, const char* binding)
+{
+  return [&pc, binding]() {
+    std::unique_ptr<const T> obj;
+    obj = pc.inputs().get<const T*>(binding);
+    return obj;
+  };
+}
+} // namespace
+
+template <typename T>
+decltype(auto) RecoContainer::getInput(ProcessingContext& pc, const char* binding)
+{
+  // the bindings are string literals, their address identifies them
+  if (mDataRequest != nullptr) {
+    auto [position, isNew] = mDataRequest->inputPositions.try_emplace(binding, -1);
+    if (isNew) {
+      position->second = pc.inputs().resolve(binding).pos;
+    }
+    if (position->second >= 0) {
+      return pc.inputs().get<T>(o2::framework::InputRecord::Handle{position->second});
+    }
+  }
+  return pc.inputs().get<T>(binding);
+}
+
 void DataRequest::addInput(const InputSpec&& isp)
 {
   if (std::find(inputs.begin(), inputs.end(), isp) == inputs.end()) {
@@ -609,6 +639,7 @@ void DataRequest::requestClusters(GTrackID::mask_t src, bool useMC, DetID::mask_
 void RecoContainer::collectData(ProcessingContext& pc, const DataRequest& requests)
 {
   auto& reqMap = requests.requestMap;
+  mDataRequest = &requests;
 
   startIR = {0, pc.services().get<o2::framework::TimingInfo>().firstTForbit};
 
@@ -813,20 +844,21 @@ void RecoContainer::collectData(ProcessingContext& pc, const DataRequest& reques
   if (req != reqMap.end()) {
     addHMPMatches(pc, req->second);
   }
+  mDataRequest = nullptr;
 }
 
 //____________________________________________________________
 void RecoContainer::addSVertices(ProcessingContext& pc, bool)
 {
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::V0Index>>("v0sIdx"), V0SIDX);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::V0>>("v0s"), V0S);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::RangeReference<int, int>>>("p2v0s"), PVTX_V0REFS);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::CascadeIndex>>("cascsIdx"), CASCSIDX);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::Cascade>>("cascs"), CASCS);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::RangeReference<int, int>>>("p2cascs"), PVTX_CASCREFS);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::Decay3BodyIndex>>("decay3bodyIdx"), DECAY3BODYIDX);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::Decay3Body>>("decay3body"), DECAY3BODY);
-  svtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::RangeReference<int, int>>>("p2decay3body"), PVTX_3BODYREFS);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::V0Index>>(pc, "v0sIdx"), V0SIDX);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::V0>>(pc, "v0s"), V0S);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::RangeReference<int, int>>>(pc, "p2v0s"), PVTX_V0REFS);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::CascadeIndex>>(pc, "cascsIdx"), CASCSIDX);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::Cascade>>(pc, "cascs"), CASCS);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::RangeReference<int, int>>>(pc, "p2cascs"), PVTX_CASCREFS);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::Decay3BodyIndex>>(pc, "decay3bodyIdx"), DECAY3BODYIDX);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::Decay3Body>>(pc, "decay3body"), DECAY3BODY);
+  svtxPool.registerContainer(getInput<gsl::span<o2::dataformats::RangeReference<int, int>>>(pc, "p2decay3body"), PVTX_3BODYREFS);
   // no mc
 }
 
@@ -834,22 +866,22 @@ void RecoContainer::addSVertices(ProcessingContext& pc, bool)
 void RecoContainer::addPVertices(ProcessingContext& pc, bool mc)
 {
   if (!pvtxPool.isLoaded(PVTX)) { // in case was loaded via addPVerticesTMP
-    pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::PrimaryVertex>>("pvtx"), PVTX);
+    pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::PrimaryVertex>>(pc, "pvtx"), PVTX);
   }
-  pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::VtxTrackIndex>>("pvtx_trmtc"), PVTX_TRMTC);
-  pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::VtxTrackRef>>("pvtx_tref"), PVTX_TRMTCREFS);
+  pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::VtxTrackIndex>>(pc, "pvtx_trmtc"), PVTX_TRMTC);
+  pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::VtxTrackRef>>(pc, "pvtx_tref"), PVTX_TRMTCREFS);
 
   if (mc && !pvtxPool.isLoaded(PVTX_MCTR)) { // in case was loaded via addPVerticesTMP
-    pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::MCEventLabel>>("pvtx_mc"), PVTX_MCTR);
+    pvtxPool.registerContainer(getInput<gsl::span<o2::MCEventLabel>>(pc, "pvtx_mc"), PVTX_MCTR);
   }
 }
 
 //____________________________________________________________
 void RecoContainer::addStrangeTracks(ProcessingContext& pc, bool mc)
 {
-  strkPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::StrangeTrack>>("strangetracks"), STRACK);
+  strkPool.registerContainer(getInput<gsl::span<o2::dataformats::StrangeTrack>>(pc, "strangetracks"), STRACK);
   if (mc) {
-    strkPool.registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("strack_mc"), STRACK_MC);
+    strkPool.registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "strack_mc"), STRACK_MC);
   }
 }
 
@@ -857,22 +889,22 @@ void RecoContainer::addStrangeTracks(ProcessingContext& pc, bool mc)
 void RecoContainer::addPVerticesTMP(ProcessingContext& pc, bool mc)
 {
   if (!pvtxPool.isLoaded(PVTX)) { // in case was loaded via addPVertices
-    pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::PrimaryVertex>>("pvtx"), PVTX);
+    pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::PrimaryVertex>>(pc, "pvtx"), PVTX);
   }
-  pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::VtxTrackIndex>>("pvtx_cont"), PVTX_CONTID);
-  pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::VtxTrackRef>>("pvtx_contref"), PVTX_CONTIDREFS);
+  pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::VtxTrackIndex>>(pc, "pvtx_cont"), PVTX_CONTID);
+  pvtxPool.registerContainer(getInput<gsl::span<o2::dataformats::VtxTrackRef>>(pc, "pvtx_contref"), PVTX_CONTIDREFS);
 
   if (mc && !pvtxPool.isLoaded(PVTX_MCTR)) { // in case was loaded via addPVertices
-    pvtxPool.registerContainer(pc.inputs().get<gsl::span<o2::MCEventLabel>>("pvtx_mc"), PVTX_MCTR);
+    pvtxPool.registerContainer(getInput<gsl::span<o2::MCEventLabel>>(pc, "pvtx_mc"), PVTX_MCTR);
   }
 }
 
 //____________________________________________________________
 void RecoContainer::addCosmicTracks(ProcessingContext& pc, bool mc)
 {
-  cosmPool.registerContainer(pc.inputs().get<gsl::span<o2::dataformats::TrackCosmics>>("cosmics"), COSM_TRACKS);
+  cosmPool.registerContainer(getInput<gsl::span<o2::dataformats::TrackCosmics>>(pc, "cosmics"), COSM_TRACKS);
   if (mc) {
-    cosmPool.registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("cosmicsMC"), COSM_TRACKS_MC);
+    cosmPool.registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "cosmicsMC"), COSM_TRACKS_MC);
   }
 }
 
@@ -880,57 +912,57 @@ void RecoContainer::addCosmicTracks(ProcessingContext& pc, bool mc)
 void RecoContainer::addITSTracks(ProcessingContext& pc, bool mc)
 {
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {            // this params need to be queried only once
-    pc.inputs().get<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>("alpparITS"); // note: configurable param does not need finaliseCCDB
+    getInput<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>(pc, "alpparITS"); // note: configurable param does not need finaliseCCDB
   }
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::its::TrackITS>>("trackITS"), TRACKS);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<int>>("trackITSClIdx"), INDICES);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("trackITSROF"), TRACKREFS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::its::TrackITS>>(pc, "trackITS"), TRACKS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<int>>(pc, "trackITSClIdx"), INDICES);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::itsmft::ROFRecord>>(pc, "trackITSROF"), TRACKREFS);
   if (mc) {
-    commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackITSMCTR"), MCLABELS);
+    commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackITSMCTR"), MCLABELS);
   }
 }
 
 //____________________________________________________________
 void RecoContainer::addIRFramesITS(ProcessingContext& pc)
 {
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::dataformats::IRFrame>>("IRFramesITS"), VARIA);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::dataformats::IRFrame>>(pc, "IRFramesITS"), VARIA);
 }
 
 //____________________________________________________________
 void RecoContainer::addMFTTracks(ProcessingContext& pc, bool mc)
 {
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {            // this params need to be queried only once
-    pc.inputs().get<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::MFT>*>("alpparMFT"); // note: configurable param does not need finaliseCCDB
+    getInput<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::MFT>*>(pc, "alpparMFT"); // note: configurable param does not need finaliseCCDB
   }
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::mft::TrackMFT>>("trackMFT"), TRACKS);
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<int>>("trackMFTClIdx"), INDICES);
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("trackMFTROF"), TRACKREFS);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<o2::mft::TrackMFT>>(pc, "trackMFT"), TRACKS);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<int>>(pc, "trackMFTClIdx"), INDICES);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<o2::itsmft::ROFRecord>>(pc, "trackMFTROF"), TRACKREFS);
   if (mc) {
-    commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackMFTMCTR"), MCLABELS);
+    commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackMFTMCTR"), MCLABELS);
   }
 }
 
 //____________________________________________________________
 void RecoContainer::addMCHTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::TrackMCH>>("trackMCH"), TRACKS);
-  commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::ROFRecord>>("trackMCHROF"), TRACKREFS);
-  commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::Cluster>>("trackMCHTRACKCLUSTERS"), INDICES);
+  commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::mch::TrackMCH>>(pc, "trackMCH"), TRACKS);
+  commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::mch::ROFRecord>>(pc, "trackMCHROF"), TRACKREFS);
+  commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::mch::Cluster>>(pc, "trackMCHTRACKCLUSTERS"), INDICES);
   if (mc) {
-    commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackMCHMCTR"), MCLABELS);
+    commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackMCHMCTR"), MCLABELS);
   }
 }
 
 //____________________________________________________________
 void RecoContainer::addMIDTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::Track>>("trackMID"), TRACKS);
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::ROFRecord>>("trackMIDROF"), TRACKREFS);
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::Cluster>>("trackMIDTRACKCLUSTERS"), INDICES);
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::ROFRecord>>("trackClMIDROF"), MATCHES);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::Track>>(pc, "trackMID"), TRACKS);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::ROFRecord>>(pc, "trackMIDROF"), TRACKREFS);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::Cluster>>(pc, "trackMIDTRACKCLUSTERS"), INDICES);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::ROFRecord>>(pc, "trackClMIDROF"), MATCHES);
   if (mc) {
-    commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackMIDMCTR"), MCLABELS);
-    mcMIDTrackClusters = pc.inputs().get<const dataformats::MCTruthContainer<o2::mid::MCClusterLabel>*>("trackMIDMCTRCL");
+    commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackMIDMCTR"), MCLABELS);
+    mcMIDTrackClusters.setLoader(lazyInput<dataformats::MCTruthContainer<o2::mid::MCClusterLabel>>(pc, "trackMIDMCTRCL"));
   }
 }
 
@@ -949,112 +981,112 @@ const o2::dataformats::MCTruthContainer<o2::mid::MCClusterLabel>* RecoContainer:
 //____________________________________________________________
 void RecoContainer::addTPCTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::TPC].registerContainer(pc.inputs().get<gsl::span<o2::tpc::TrackTPC>>("trackTPC"), TRACKS);
-  commonPool[GTrackID::TPC].registerContainer(pc.inputs().get<gsl::span<o2::tpc::TPCClRefElem>>("trackTPCClRefs"), INDICES);
+  commonPool[GTrackID::TPC].registerContainer(getInput<gsl::span<o2::tpc::TrackTPC>>(pc, "trackTPC"), TRACKS);
+  commonPool[GTrackID::TPC].registerContainer(getInput<gsl::span<o2::tpc::TPCClRefElem>>(pc, "trackTPCClRefs"), INDICES);
   if (mc) {
-    commonPool[GTrackID::TPC].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackTPCMCTR"), MCLABELS);
+    commonPool[GTrackID::TPC].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackTPCMCTR"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addITSTPCTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::ITSTPC].registerContainer(pc.inputs().get<gsl::span<o2d::TrackTPCITS>>("trackITSTPC"), TRACKS);
-  commonPool[GTrackID::ITSAB].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::TrkClusRef>>("trackITSTPCABREFS"), TRACKREFS);
-  commonPool[GTrackID::ITSAB].registerContainer(pc.inputs().get<gsl::span<int>>("trackITSTPCABCLID"), INDICES);
+  commonPool[GTrackID::ITSTPC].registerContainer(getInput<gsl::span<o2d::TrackTPCITS>>(pc, "trackITSTPC"), TRACKS);
+  commonPool[GTrackID::ITSAB].registerContainer(getInput<gsl::span<o2::itsmft::TrkClusRef>>(pc, "trackITSTPCABREFS"), TRACKREFS);
+  commonPool[GTrackID::ITSAB].registerContainer(getInput<gsl::span<int>>(pc, "trackITSTPCABCLID"), INDICES);
   if (mc) {
-    commonPool[GTrackID::ITSTPC].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackITSTPCMCTR"), MCLABELS);
-    commonPool[GTrackID::ITSAB].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackITSTPCABMCTR"), MCLABELS);
+    commonPool[GTrackID::ITSTPC].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackITSTPCMCTR"), MCLABELS);
+    commonPool[GTrackID::ITSAB].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackITSTPCABMCTR"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addGlobalFwdTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MFTMCH].registerContainer(pc.inputs().get<gsl::span<o2d::GlobalFwdTrack>>("fwdtracks"), TRACKS);
+  commonPool[GTrackID::MFTMCH].registerContainer(getInput<gsl::span<o2d::GlobalFwdTrack>>(pc, "fwdtracks"), TRACKS);
   if (mc) {
-    commonPool[GTrackID::MFTMCH].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("MCTruth"), MCLABELS);
+    commonPool[GTrackID::MFTMCH].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "MCTruth"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addMFTMCHMatches(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MFTMCH].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoFwd>>("matchMFTMCH"), MATCHES);
+  commonPool[GTrackID::MFTMCH].registerContainer(getInput<gsl::span<o2d::MatchInfoFwd>>(pc, "matchMFTMCH"), MATCHES);
 }
 
 //__________________________________________________________
 void RecoContainer::addMCHMIDMatches(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MCHMID].registerContainer(pc.inputs().get<gsl::span<o2d::TrackMCHMID>>("matchMCHMID"), MATCHES);
+  commonPool[GTrackID::MCHMID].registerContainer(getInput<gsl::span<o2d::TrackMCHMID>>(pc, "matchMCHMID"), MATCHES);
   if (mc) {
-    commonPool[GTrackID::MCHMID].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("matchMCHMID_MCTR"), MCLABELS);
+    commonPool[GTrackID::MCHMID].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "matchMCHMID_MCTR"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addITSTPCTRDTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::ITSTPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::trd::TrackTRD>>("trackITSTPCTRD"), TRACKS);
-  commonPool[GTrackID::ITSTPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::trd::TrackTriggerRecord>>("trigITSTPCTRD"), TRACKREFS);
+  commonPool[GTrackID::ITSTPCTRD].registerContainer(getInput<gsl::span<o2::trd::TrackTRD>>(pc, "trackITSTPCTRD"), TRACKS);
+  commonPool[GTrackID::ITSTPCTRD].registerContainer(getInput<gsl::span<o2::trd::TrackTriggerRecord>>(pc, "trigITSTPCTRD"), TRACKREFS);
   if (mc) {
-    commonPool[GTrackID::ITSTPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackITSTPCTRDMCTR"), MCLABELS);
-    commonPool[GTrackID::ITSTPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackITSTPCTRDSAMCTR"), MCLABELSEXTRA);
+    commonPool[GTrackID::ITSTPCTRD].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackITSTPCTRDMCTR"), MCLABELS);
+    commonPool[GTrackID::ITSTPCTRD].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackITSTPCTRDSAMCTR"), MCLABELSEXTRA);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addTPCTRDTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::TPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::trd::TrackTRD>>("trackTPCTRD"), TRACKS);
-  commonPool[GTrackID::TPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::trd::TrackTriggerRecord>>("trigTPCTRD"), TRACKREFS);
+  commonPool[GTrackID::TPCTRD].registerContainer(getInput<gsl::span<o2::trd::TrackTRD>>(pc, "trackTPCTRD"), TRACKS);
+  commonPool[GTrackID::TPCTRD].registerContainer(getInput<gsl::span<o2::trd::TrackTriggerRecord>>(pc, "trigTPCTRD"), TRACKREFS);
   if (mc) {
-    commonPool[GTrackID::TPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackTPCTRDMCTR"), MCLABELS);
-    commonPool[GTrackID::TPCTRD].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("trackTPCTRDSAMCTR"), MCLABELSEXTRA);
+    commonPool[GTrackID::TPCTRD].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackTPCTRDMCTR"), MCLABELS);
+    commonPool[GTrackID::TPCTRD].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "trackTPCTRDSAMCTR"), MCLABELSEXTRA);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addTPCTOFTracks(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::TPCTOF].registerContainer(pc.inputs().get<gsl::span<o2d::TrackTPCTOF>>("trackTPCTOF"), TRACKS);
-  commonPool[GTrackID::TPCTOF].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoTOF>>("matchTPCTOF"), MATCHES);
+  commonPool[GTrackID::TPCTOF].registerContainer(getInput<gsl::span<o2d::TrackTPCTOF>>(pc, "trackTPCTOF"), TRACKS);
+  commonPool[GTrackID::TPCTOF].registerContainer(getInput<gsl::span<o2d::MatchInfoTOF>>(pc, "matchTPCTOF"), MATCHES);
   if (mc) {
-    commonPool[GTrackID::TPCTOF].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("clsTOF_TPC_MCTR"), MCLABELS);
+    commonPool[GTrackID::TPCTOF].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "clsTOF_TPC_MCTR"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addTOFMatchesITSTPC(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::ITSTPCTOF].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoTOF>>("matchITSTPCTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
+  commonPool[GTrackID::ITSTPCTOF].registerContainer(getInput<gsl::span<o2d::MatchInfoTOF>>(pc, "matchITSTPCTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
   if (mc) {
-    commonPool[GTrackID::ITSTPCTOF].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("clsTOF_GLO_MCTR"), MCLABELS);
+    commonPool[GTrackID::ITSTPCTOF].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "clsTOF_GLO_MCTR"), MCLABELS);
   }
 }
 //__________________________________________________________
 void RecoContainer::addTOFMatchesTPCTRD(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::TPCTRDTOF].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoTOF>>("matchTPCTRDTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
+  commonPool[GTrackID::TPCTRDTOF].registerContainer(getInput<gsl::span<o2d::MatchInfoTOF>>(pc, "matchTPCTRDTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
   if (mc) {
-    commonPool[GTrackID::TPCTRDTOF].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("clsTOF_GLO2_MCTR"), MCLABELS);
+    commonPool[GTrackID::TPCTRDTOF].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "clsTOF_GLO2_MCTR"), MCLABELS);
   }
 }
 //__________________________________________________________
 void RecoContainer::addTOFMatchesITSTPCTRD(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::ITSTPCTRDTOF].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoTOF>>("matchITSTPCTRDTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
+  commonPool[GTrackID::ITSTPCTRDTOF].registerContainer(getInput<gsl::span<o2d::MatchInfoTOF>>(pc, "matchITSTPCTRDTOF"), MATCHES); // only ITS/TPC : TOF match info, no real tracks
   if (mc) {
-    commonPool[GTrackID::ITSTPCTRDTOF].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("clsTOF_GLO3_MCTR"), MCLABELS);
+    commonPool[GTrackID::ITSTPCTRDTOF].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "clsTOF_GLO3_MCTR"), MCLABELS);
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addHMPMatches(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2d::MatchInfoHMP>>("matchHMP"), MATCHES); //  HMPID match info, no real tracks
+  commonPool[GTrackID::HMP].registerContainer(getInput<gsl::span<o2d::MatchInfoHMP>>(pc, "matchHMP"), MATCHES); //  HMPID match info, no real tracks
   if (mc) {
-    commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2::MCCompLabel>>("clsHMP_GLO_MCTR"), MCLABELS);
+    commonPool[GTrackID::HMP].registerContainer(getInput<gsl::span<o2::MCCompLabel>>(pc, "clsHMP_GLO_MCTR"), MCLABELS);
   }
 }
 
@@ -1062,14 +1094,14 @@ void RecoContainer::addHMPMatches(ProcessingContext& pc, bool mc)
 void RecoContainer::addITSClusters(ProcessingContext& pc, bool mc)
 {
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {            // this params need to be queried only once
-    pc.inputs().get<o2::itsmft::TopologyDictionary*>("cldictITS");                        // just to trigger the finaliseCCDB
-    pc.inputs().get<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>("alpparITS"); // note: configurable param does not need finaliseCCDB
+    getInput<o2::itsmft::TopologyDictionary*>(pc, "cldictITS");                        // just to trigger the finaliseCCDB
+    getInput<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>(pc, "alpparITS"); // note: configurable param does not need finaliseCCDB
   }
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clusITSROF"), CLUSREFS);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusITS"), CLUSTERS);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusITSPatt"), PATTERNS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::itsmft::ROFRecord>>(pc, "clusITSROF"), CLUSREFS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::itsmft::CompClusterExt>>(pc, "clusITS"), CLUSTERS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<unsigned char>>(pc, "clusITSPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
+    mcITSClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusITSMC"));
   }
 }
 
@@ -1077,14 +1109,14 @@ void RecoContainer::addITSClusters(ProcessingContext& pc, bool mc)
 void RecoContainer::addIT3Clusters(ProcessingContext& pc, bool mc)
 {
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {            // this params need to be queried only once
-    pc.inputs().get<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>("alpparITS"); // note: configurable param does not need finaliseCCDB
-    pc.inputs().get<o2::its3::TopologyDictionary*>("cldictIT3");                          // just to trigger the finaliseCCDB
+    getInput<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::ITS>*>(pc, "alpparITS"); // note: configurable param does not need finaliseCCDB
+    getInput<o2::its3::TopologyDictionary*>(pc, "cldictIT3");                          // just to trigger the finaliseCCDB
   }
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clusITSROF"), CLUSREFS);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusITS"), CLUSTERS);
-  commonPool[GTrackID::ITS].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusITSPatt"), PATTERNS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::itsmft::ROFRecord>>(pc, "clusITSROF"), CLUSREFS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<o2::itsmft::CompClusterExt>>(pc, "clusITS"), CLUSTERS);
+  commonPool[GTrackID::ITS].registerContainer(getInput<gsl::span<unsigned char>>(pc, "clusITSPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusITSMC");
+    mcITSClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusITSMC"));
   }
 }
 #endif
@@ -1093,14 +1125,14 @@ void RecoContainer::addIT3Clusters(ProcessingContext& pc, bool mc)
 void RecoContainer::addMFTClusters(ProcessingContext& pc, bool mc)
 {
   if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) {            // this params need to be queried only once
-    pc.inputs().get<o2::itsmft::TopologyDictionary*>("cldictMFT");                        // just to trigger the finaliseCCDB
-    pc.inputs().get<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::MFT>*>("alpparMFT"); // note: configurable param does not need finaliseCCDB
+    getInput<o2::itsmft::TopologyDictionary*>(pc, "cldictMFT");                        // just to trigger the finaliseCCDB
+    getInput<o2::itsmft::DPLAlpideParam<o2::detectors::DetID::MFT>*>(pc, "alpparMFT"); // note: configurable param does not need finaliseCCDB
   }
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clusMFTROF"), CLUSREFS);
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("clusMFT"), CLUSTERS);
-  commonPool[GTrackID::MFT].registerContainer(pc.inputs().get<gsl::span<unsigned char>>("clusMFTPatt"), PATTERNS);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<o2::itsmft::ROFRecord>>(pc, "clusMFTROF"), CLUSREFS);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<o2::itsmft::CompClusterExt>>(pc, "clusMFT"), CLUSTERS);
+  commonPool[GTrackID::MFT].registerContainer(getInput<gsl::span<unsigned char>>(pc, "clusMFTPatt"), PATTERNS);
   if (mc) {
-    mcITSClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusMFTMC");
+    mcITSClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusMFTMC"));
   }
 }
 
@@ -1109,17 +1141,17 @@ void RecoContainer::addTPCClusters(ProcessingContext& pc, bool mc, bool shmap, b
 {
   inputsTPCclusters = o2::tpc::getWorkflowTPCInput(pc, 0, mc);
   if (shmap) {
-    clusterShMapTPC = pc.inputs().get<gsl::span<unsigned char>>("clusTPCshmap");
+    clusterShMapTPC = getInput<gsl::span<unsigned char>>(pc, "clusTPCshmap");
   }
   if (occmap) {
-    occupancyMapTPC = pc.inputs().get<gsl::span<unsigned int>>("clusTPCoccmap");
+    occupancyMapTPC = getInput<gsl::span<unsigned int>>(pc, "clusTPCoccmap");
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addTPCTriggers(ProcessingContext& pc)
 {
-  commonPool[GTrackID::TPC].registerContainer(pc.inputs().get<gsl::span<o2::tpc::TriggerInfoDLBZS>>("trigTPC"), MATCHES);
+  commonPool[GTrackID::TPC].registerContainer(getInput<gsl::span<o2::tpc::TriggerInfoDLBZS>>(pc, "trigTPC"), MATCHES);
 }
 
 //__________________________________________________________
@@ -1131,88 +1163,88 @@ void RecoContainer::addTRDTracklets(ProcessingContext& pc, bool mc)
 //__________________________________________________________
 void RecoContainer::addTOFClusters(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::TOF].registerContainer(pc.inputs().get<gsl::span<o2::tof::Cluster>>("tofcluster"), CLUSTERS);
+  commonPool[GTrackID::TOF].registerContainer(getInput<gsl::span<o2::tof::Cluster>>(pc, "tofcluster"), CLUSTERS);
   if (mc) {
-    mcTOFClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("tofclusterlabel");
+    mcTOFClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "tofclusterlabel"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addHMPClusters(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2::hmpid::Cluster>>("hmpidcluster"), CLUSTERS);
-  commonPool[GTrackID::HMP].registerContainer(pc.inputs().get<gsl::span<o2::hmpid::Trigger>>("hmpidtriggers"), CLUSREFS);
+  commonPool[GTrackID::HMP].registerContainer(getInput<gsl::span<o2::hmpid::Cluster>>(pc, "hmpidcluster"), CLUSTERS);
+  commonPool[GTrackID::HMP].registerContainer(getInput<gsl::span<o2::hmpid::Trigger>>(pc, "hmpidtriggers"), CLUSREFS);
   if (mc) {
-    mcHMPClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("hmpidclusterlabel");
+    mcHMPClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "hmpidclusterlabel"));
   }
 }
 //__________________________________________________________
 void RecoContainer::addMCHClusters(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::ROFRecord>>("clusMCHROF"), CLUSREFS);
-  commonPool[GTrackID::MCH].registerContainer(pc.inputs().get<gsl::span<o2::mch::Cluster>>("clusMCH"), CLUSTERS);
+  commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::mch::ROFRecord>>(pc, "clusMCHROF"), CLUSREFS);
+  commonPool[GTrackID::MCH].registerContainer(getInput<gsl::span<o2::mch::Cluster>>(pc, "clusMCH"), CLUSTERS);
   if (mc) {
-    mcMCHClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("clusMCHMC");
+    mcMCHClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "clusMCHMC"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addMIDClusters(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::ROFRecord>>("clusMIDROF"), CLUSREFS);
-  commonPool[GTrackID::MID].registerContainer(pc.inputs().get<gsl::span<o2::mid::Cluster>>("clusMID"), CLUSTERS);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::ROFRecord>>(pc, "clusMIDROF"), CLUSREFS);
+  commonPool[GTrackID::MID].registerContainer(getInput<gsl::span<o2::mid::Cluster>>(pc, "clusMID"), CLUSTERS);
   if (mc) {
-    mcMIDClusters = pc.inputs().get<const dataformats::MCTruthContainer<o2::mid::MCClusterLabel>*>("clusMIDMC");
+    mcMIDClusters.setLoader(lazyInput<dataformats::MCTruthContainer<o2::mid::MCClusterLabel>>(pc, "clusMIDMC"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addCTPDigits(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::CTP].registerContainer(pc.inputs().get<gsl::span<o2::ctp::CTPDigit>>("CTPDigits"), CLUSTERS);
-  if (pc.inputs().get<gsl::span<char>>("CTPLumi").size() == sizeof(o2::ctp::LumiInfo)) {
-    mCTPLumi = pc.inputs().get<o2::ctp::LumiInfo>("CTPLumi");
+  commonPool[GTrackID::CTP].registerContainer(getInput<gsl::span<o2::ctp::CTPDigit>>(pc, "CTPDigits"), CLUSTERS);
+  if (getInput<gsl::span<char>>(pc, "CTPLumi").size() == sizeof(o2::ctp::LumiInfo)) {
+    mCTPLumi = getInput<o2::ctp::LumiInfo>(pc, "CTPLumi");
   }
   if (mc) {
-    //  pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("CTPDigitsMC");
+    //  getInput<const dataformats::MCTruthContainer<MCCompLabel>*>(pc, "CTPDigitsMC");
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addCPVClusters(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::CPV].registerContainer(pc.inputs().get<gsl::span<o2::cpv::Cluster>>("CPVClusters"), CLUSTERS);
-  commonPool[GTrackID::CPV].registerContainer(pc.inputs().get<gsl::span<o2::cpv::TriggerRecord>>("CPVTriggers"), CLUSREFS);
+  commonPool[GTrackID::CPV].registerContainer(getInput<gsl::span<o2::cpv::Cluster>>(pc, "CPVClusters"), CLUSTERS);
+  commonPool[GTrackID::CPV].registerContainer(getInput<gsl::span<o2::cpv::TriggerRecord>>(pc, "CPVTriggers"), CLUSREFS);
   if (mc) {
-    mcCPVClusters = pc.inputs().get<const dataformats::MCTruthContainer<MCCompLabel>*>("CPVClustersMC");
+    mcCPVClusters.setLoader(lazyInput<dataformats::MCTruthContainer<MCCompLabel>>(pc, "CPVClustersMC"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addPHOSCells(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::PHS].registerContainer(pc.inputs().get<gsl::span<o2::phos::Cell>>("PHSCells"), CLUSTERS);
-  commonPool[GTrackID::PHS].registerContainer(pc.inputs().get<gsl::span<o2::phos::TriggerRecord>>("PHSTriggers"), CLUSREFS);
+  commonPool[GTrackID::PHS].registerContainer(getInput<gsl::span<o2::phos::Cell>>(pc, "PHSCells"), CLUSTERS);
+  commonPool[GTrackID::PHS].registerContainer(getInput<gsl::span<o2::phos::TriggerRecord>>(pc, "PHSTriggers"), CLUSREFS);
   if (mc) {
-    mcPHSCells = pc.inputs().get<const dataformats::MCTruthContainer<o2::phos::MCLabel>*>("PHSCellsMC");
+    mcPHSCells.setLoader(lazyInput<dataformats::MCTruthContainer<o2::phos::MCLabel>>(pc, "PHSCellsMC"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addEMCALCells(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::EMC].registerContainer(pc.inputs().get<gsl::span<o2::emcal::Cell>>("EMCCells"), CLUSTERS);
-  commonPool[GTrackID::EMC].registerContainer(pc.inputs().get<gsl::span<o2::emcal::TriggerRecord>>("EMCTriggers"), CLUSREFS);
+  commonPool[GTrackID::EMC].registerContainer(getInput<gsl::span<o2::emcal::Cell>>(pc, "EMCCells"), CLUSTERS);
+  commonPool[GTrackID::EMC].registerContainer(getInput<gsl::span<o2::emcal::TriggerRecord>>(pc, "EMCTriggers"), CLUSREFS);
   if (mc) {
-    mcEMCCells = pc.inputs().get<const dataformats::MCTruthContainer<o2::emcal::MCLabel>*>("EMCCellsMC");
+    mcEMCCells.setLoader(lazyInput<dataformats::MCTruthContainer<o2::emcal::MCLabel>>(pc, "EMCCellsMC"));
   }
 }
 
 //__________________________________________________________
 void RecoContainer::addFT0RecPoints(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::FT0].registerContainer(pc.inputs().get<gsl::span<o2::ft0::RecPoints>>("ft0recpoints"), TRACKS);
-  commonPool[GTrackID::FT0].registerContainer(pc.inputs().get<gsl::span<o2::ft0::ChannelDataFloat>>("ft0channels"), CLUSTERS);
+  commonPool[GTrackID::FT0].registerContainer(getInput<gsl::span<o2::ft0::RecPoints>>(pc, "ft0recpoints"), TRACKS);
+  commonPool[GTrackID::FT0].registerContainer(getInput<gsl::span<o2::ft0::ChannelDataFloat>>(pc, "ft0channels"), CLUSTERS);
 
   if (mc) {
     LOG(error) << "FT0 RecPoint does not support MC truth";
@@ -1222,8 +1254,8 @@ void RecoContainer::addFT0RecPoints(ProcessingContext& pc, bool mc)
 //__________________________________________________________
 void RecoContainer::addFV0RecPoints(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::FV0].registerContainer(pc.inputs().get<gsl::span<o2::fv0::RecPoints>>("fv0recpoints"), TRACKS);
-  commonPool[GTrackID::FV0].registerContainer(pc.inputs().get<gsl::span<o2::fv0::ChannelDataFloat>>("fv0channels"), CLUSTERS);
+  commonPool[GTrackID::FV0].registerContainer(getInput<gsl::span<o2::fv0::RecPoints>>(pc, "fv0recpoints"), TRACKS);
+  commonPool[GTrackID::FV0].registerContainer(getInput<gsl::span<o2::fv0::ChannelDataFloat>>(pc, "fv0channels"), CLUSTERS);
 
   if (mc) {
     LOG(error) << "FV0 RecPoint does not support MC truth";
@@ -1233,8 +1265,8 @@ void RecoContainer::addFV0RecPoints(ProcessingContext& pc, bool mc)
 //__________________________________________________________
 void RecoContainer::addFDDRecPoints(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::FDD].registerContainer(pc.inputs().get<gsl::span<o2::fdd::RecPoint>>("fddrecpoints"), TRACKS);
-  commonPool[GTrackID::FDD].registerContainer(pc.inputs().get<gsl::span<o2::fdd::ChannelDataFloat>>("fddchannels"), CLUSTERS);
+  commonPool[GTrackID::FDD].registerContainer(getInput<gsl::span<o2::fdd::RecPoint>>(pc, "fddrecpoints"), TRACKS);
+  commonPool[GTrackID::FDD].registerContainer(getInput<gsl::span<o2::fdd::ChannelDataFloat>>(pc, "fddchannels"), CLUSTERS);
 
   if (mc) {
     LOG(error) << "FDD RecPoint does not support MC truth";
@@ -1244,10 +1276,10 @@ void RecoContainer::addFDDRecPoints(ProcessingContext& pc, bool mc)
 //__________________________________________________________
 void RecoContainer::addZDCRecEvents(ProcessingContext& pc, bool mc)
 {
-  commonPool[GTrackID::ZDC].registerContainer(pc.inputs().get<gsl::span<o2::zdc::BCRecData>>("zdcbcrec"), MATCHES);
-  commonPool[GTrackID::ZDC].registerContainer(pc.inputs().get<gsl::span<o2::zdc::ZDCEnergy>>("zdcenergy"), TRACKS);
-  commonPool[GTrackID::ZDC].registerContainer(pc.inputs().get<gsl::span<o2::zdc::ZDCTDCData>>("zdctdcdata"), CLUSTERS);
-  commonPool[GTrackID::ZDC].registerContainer(pc.inputs().get<gsl::span<uint16_t>>("zdcinfo"), PATTERNS);
+  commonPool[GTrackID::ZDC].registerContainer(getInput<gsl::span<o2::zdc::BCRecData>>(pc, "zdcbcrec"), MATCHES);
+  commonPool[GTrackID::ZDC].registerContainer(getInput<gsl::span<o2::zdc::ZDCEnergy>>(pc, "zdcenergy"), TRACKS);
+  commonPool[GTrackID::ZDC].registerContainer(getInput<gsl::span<o2::zdc::ZDCTDCData>>(pc, "zdctdcdata"), CLUSTERS);
+  commonPool[GTrackID::ZDC].registerContainer(getInput<gsl::span<uint16_t>>(pc, "zdcinfo"), PATTERNS);
 
   if (mc) {
     LOG(error) << "ZDC RecEvent does not support MC truth";
@@ -137,6 +137,15 @@ struct Data {
     return float(getADCValue(pos)) * FloatConversion;
   }
 
+  /// unpack all ADC values of the 128 bit word in float
+  /// the fixed number of iterations allows the compiler to unroll and vectorize the unpacking
+  void getADCValuesFloat(float* values) const
+  {
+    for (uint32_t pos = 0; pos < ChannelsPerWord; ++pos) {
+      values[pos] = float((adcValues[pos / ChannelsPerHalfWord] >> ((pos % ChannelsPerHalfWord) * DataBitSize)) & BitMask) * FloatConversion;
+    }
+  }
+
   /// reset all ADC values
   void reset()
   {
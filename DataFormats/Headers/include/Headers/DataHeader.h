@@ -466,8 +466,9 @@ auto get(const std::byte* buffer, size_t /*len*/ = 0)
     // is part of the header definition. The check function 'sanityCheck' will throw
     // otherwise, we keep the code related to the exception outside the header file.
     // Note: Can not check on size because the O2 data model requires variable size headers
-    // to be supported.
-    if (current->sanityCheck(HeaderValueType::sVersion)) {
+    // to be supported. The version is compared inline so that the out-of-line check is
+    // only called, to throw, on a mismatch.
+    if (current->headerVersion == HeaderValueType::sVersion || current->sanityCheck(HeaderValueType::sVersion)) {
       return reinterpret_cast<HeaderConstPtrType>(current);
     }
   }
@@ -475,7 +476,7 @@ auto get(const std::byte* buffer, size_t /*len*/ = 0)
   while ((current = current->next())) {
     prev = current;
     if (current->description == HeaderValueType::sHeaderType) {
-      if (current->sanityCheck(HeaderValueType::sVersion)) {
+      if (current->headerVersion == HeaderValueType::sVersion || current->sanityCheck(HeaderValueType::sVersion)) {
         return reinterpret_cast<HeaderConstPtrType>(current);
       }
     }
@@ -31,12 +31,17 @@
 #include <boost/container/pmr/memory_resource.hpp>
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/polymorphic_allocator.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <execinfo.h>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 #include <fairmq/Message.h>
 #include <fairmq/TransportFactory.h>
 #include <fairmq/MemoryResources.h>
@@ -111,6 +116,299 @@ class MessageResource : public FairMQMemoryResource
   }
 };
 
+//__________________________________________________________________________________________________
+/// A memory resource which rounds allocations up to a limited set of size classes and, rather than
+/// giving released messages back to the transport, keeps them in per class free lists to serve the
+/// next allocations. This avoids the continuous allocation / deallocation of arbitrary sizes in the
+/// (shared memory) segment, e.g. when pmr containers grow, which fragments it over long runs.
+/// Messages extracted via getMessage (i.e. the ones which are sent) leave the resource.
+class SlabMessageResource : public FairMQMemoryResource
+{
+ public:
+  struct Stats {
+    size_t allocations = 0;    /// number of allocations served
+    size_t reused = 0;         /// allocations served from the free lists
+    size_t allocatedBytes = 0; /// bytes requested to the transport
+    size_t cachedMessages = 0; /// messages currently in the free lists
+    size_t cachedBytes = 0;    /// bytes currently in the free lists
+  };
+
+  /// Sizes up to MIN_SLAB_SIZE share the same class, then each power of two
+  /// is divided in 2^SUBCLASSES_LOG2 classes, up to MAX_SLAB_SIZE. Bigger
+  /// allocations are not rounded and never cached.
+  static constexpr size_t MIN_SLAB_SIZE = 256;
+  static constexpr size_t MAX_SLAB_SIZE = 64 * 1024 * 1024;
+  static constexpr size_t SUBCLASSES_LOG2 = 2;
+
+  SlabMessageResource() noexcept = delete;
+  SlabMessageResource(const SlabMessageResource&) = delete;
+  SlabMessageResource& operator=(const SlabMessageResource&) = delete;
+  /// @a maxCachedBytes is the maximum amount of memory kept in the free lists
+  SlabMessageResource(fair::mq::TransportFactory* factory, size_t maxCachedBytes)
+    : mFactory{factory},
+      mUpstream{factory ? factory->GetMemoryResource() : throw std::runtime_error("SlabMessageResource::SlabMessageResource factory is nullptr")},
+      mMaxCachedBytes{maxCachedBytes}
+  {
+  }
+
+  /// @return the size actually allocated for a request of @a bytes
+  static size_t sizeClass(size_t bytes)
+  {
+    if (bytes <= MIN_SLAB_SIZE) {
+      return MIN_SLAB_SIZE;
+    }
+    if (bytes > MAX_SLAB_SIZE) {
+      return bytes;
+    }
+    size_t step = (size_t{1} << (63 - __builtin_clzll(bytes - 1))) >> SUBCLASSES_LOG2;
+    return (bytes + step - 1) / step * step;
+  }
+
+  fair::mq::MessagePtr getMessage(void* p) override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mMessages.find(p);
+    if (it == mMessages.end()) {
+      return nullptr;
+    }
+    auto message = std::move(it->second);
+    mMessages.erase(it);
+    return message;
+  }
+
+  void* setMessage(fair::mq::MessagePtr message) override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    void* data = message->GetData();
+    mMessages[data] = std::move(message);
+    return data;
+  }
+
+  fair::mq::TransportFactory* getTransportFactory() noexcept override { return mFactory; }
+
+  size_t getNumberOfMessages() const noexcept override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMessages.size();
+  }
+
+  Stats getStats() const
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mStats;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    size_t size = sizeClass(bytes);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.allocations++;
+    fair::mq::MessagePtr message;
+    auto& freeList = mFreeLists[size];
+    for (auto it = freeList.rbegin(); it != freeList.rend(); ++it) {
+      if (reinterpret_cast<uintptr_t>((*it)->GetData()) % alignment == 0) {
+        message = std::move(*it);
+        freeList.erase(std::next(it).base());
+        mStats.reused++;
+        mStats.cachedMessages--;
+        mStats.cachedBytes -= size;
+        break;
+      }
+    }
+    if (!message) {
+      message = mFactory->CreateMessage(size, fair::mq::Alignment{alignment});
+      mStats.allocatedBytes += size;
+    }
+    void* data = message->GetData();
+    mMessages[data] = std::move(message);
+    return data;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t /*alignment*/) override
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mMessages.find(p);
+    if (it == mMessages.end()) {
+      return;
+    }
+    auto message = std::move(it->second);
+    mMessages.erase(it);
+    size_t size = message->GetSize();
+    // Only keep what still has the size of its class, so that it can be
+    // handed out again as is.
+    if (size > MAX_SLAB_SIZE || size != sizeClass(size) || mStats.cachedBytes + size > mMaxCachedBytes) {
+      return;
+    }
+    mFreeLists[size].emplace_back(std::move(message));
+    mStats.cachedMessages++;
+    mStats.cachedBytes += size;
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    // Messages come from the same transport, so whatever the transport
+    // resource would accept can be extracted from here as well.
+    return this == &other || mUpstream == &other;
+  }
+
+ private:
+  fair::mq::TransportFactory* mFactory{nullptr};
+  FairMQMemoryResource* mUpstream{nullptr};
+  size_t mMaxCachedBytes{0};
+  mutable std::mutex mMutex;
+  Stats mStats;
+  std::unordered_map<void*, fair::mq::MessagePtr> mMessages;
+  std::unordered_map<size_t, std::vector<fair::mq::MessagePtr>> mFreeLists;
+};
+
+//__________________________________________________________________________________________________
+/// A memory resource which forwards everything to an upstream one and keeps track of the memory
+/// the containers hold, e.g. to publish it as metrics. Messages extracted via getMessage (i.e. the
+/// ones which are sent) are not held anymore. When @a samplingInterval is not 0, one allocation out
+/// of @a samplingInterval is attributed to the call stack which requested it, so that the sites
+/// allocating the most can be reported.
+class AccountingMessageResource : public FairMQMemoryResource
+{
+ public:
+  struct Stats {
+    size_t allocations = 0;    /// number of allocations since the last reset
+    size_t allocatedBytes = 0; /// bytes allocated since the last reset
+    size_t heldBytes = 0;      /// bytes currently held by the containers
+    size_t peakHeldBytes = 0;  /// maximum of heldBytes since the last reset
+  };
+
+  static constexpr size_t MAX_SITE_FRAMES = 8;
+  static constexpr size_t MAX_SITES = 1024;
+
+  /// An allocation site, identified by the return addresses of its call stack
+  struct Site {
+    std::array<void*, MAX_SITE_FRAMES> frames = {};
+    int nFrames = 0;
+    size_t allocations = 0; /// sampled allocations from this site
+    size_t bytes = 0;       /// bytes of the sampled allocations
+  };
+
+  AccountingMessageResource() noexcept = delete;
+  AccountingMessageResource(const AccountingMessageResource&) = delete;
+  AccountingMessageResource& operator=(const AccountingMessageResource&) = delete;
+  AccountingMessageResource(FairMQMemoryResource* upstream, size_t samplingInterval = 0)
+    : mUpstream{upstream ? upstream : throw std::runtime_error("AccountingMessageResource::AccountingMessageResource upstream is nullptr")},
+      mSamplingInterval{samplingInterval}
+  {
+  }
+
+  fair::mq::MessagePtr getMessage(void* p) override
+  {
+    auto message = mUpstream->getMessage(p);
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto it = mSizes.find(p);
+    if (message && it != mSizes.end()) {
+      mStats.heldBytes -= it->second;
+      mSizes.erase(it);
+    }
+    return message;
+  }
+
+  void* setMessage(fair::mq::MessagePtr message) override { return mUpstream->setMessage(std::move(message)); }
+  fair::mq::TransportFactory* getTransportFactory() noexcept override { return mUpstream->getTransportFactory(); }
+  size_t getNumberOfMessages() const noexcept override { return mUpstream->getNumberOfMessages(); }
+
+  /// @return the statistics, starting a new interval if @a reset is true
+  Stats getStats(bool reset = false)
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto result = mStats;
+    if (reset) {
+      mStats.allocations = 0;
+      mStats.allocatedBytes = 0;
+      mStats.peakHeldBytes = mStats.heldBytes;
+    }
+    return result;
+  }
+
+  /// @return the @a n sites with the most sampled bytes, in decreasing order
+  std::vector<Site> getTopSites(size_t n) const
+  {
+    std::vector<Site> result;
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      result.reserve(mSites.size());
+      for (auto& [_, site] : mSites) {
+        result.push_back(site);
+      }
+    }
+    auto last = result.begin() + std::min(n, result.size());
+    std::partial_sort(result.begin(), last, result.end(), [](Site const& a, Site const& b) { return a.bytes > b.bytes; });
+    result.erase(last, result.end());
+    return result;
+  }
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    void* p = mUpstream->allocate(bytes, alignment);
+    Site sample;
+    bool sampled = mSamplingInterval && (mSampleCounter.fetch_add(1, std::memory_order_relaxed) % mSamplingInterval) == 0;
+    if (sampled) {
+      // Outside of the lock, unwinding is the expensive part.
+      void* frames[MAX_SITE_FRAMES + 2];
+      int nFrames = backtrace(frames, MAX_SITE_FRAMES + 2);
+      // Skip this function and the allocate() of the memory_resource.
+      sample.nFrames = std::max(nFrames - 2, 0);
+      std::copy_n(frames + 2, sample.nFrames, sample.frames.begin());
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mSizes[p] = bytes;
+    mStats.allocations++;
+    mStats.allocatedBytes += bytes;
+    mStats.heldBytes += bytes;
+    mStats.peakHeldBytes = std::max(mStats.peakHeldBytes, mStats.heldBytes);
+    if (sampled) {
+      size_t hash = 0;
+      for (int i = 0; i < sample.nFrames; ++i) {
+        hash = hash * 31 + std::hash<void*>{}(sample.frames[i]);
+      }
+      auto it = mSites.find(hash);
+      if (it == mSites.end() && mSites.size() < MAX_SITES) {
+        it = mSites.emplace(hash, sample).first;
+      }
+      if (it != mSites.end()) {
+        it->second.allocations++;
+        it->second.bytes += bytes;
+      }
+    }
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      auto it = mSizes.find(p);
+      if (it != mSizes.end()) {
+        mStats.heldBytes -= it->second;
+        mSizes.erase(it);
+      }
+    }
+    mUpstream->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override
+  {
+    return this == &other || mUpstream->is_equal(other);
+  }
+
+ private:
+  FairMQMemoryResource* mUpstream{nullptr};
+  size_t mSamplingInterval{0};
+  std::atomic<size_t> mSampleCounter{0};
+  mutable std::mutex mMutex;
+  Stats mStats;
+  std::unordered_map<void*, size_t> mSizes;
+  std::unordered_map<size_t, Site> mSites;
+};
+
 //__________________________________________________________________________________________________
 // A spectator pmr memory resource which only watches the memory of the underlying buffer, does not
 // carry out real allocation. It owns the underlying buffer which is destroyed on deallocation.
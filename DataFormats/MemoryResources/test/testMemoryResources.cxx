@@ -216,4 +216,88 @@ BOOST_AUTO_TEST_CASE(test_SpectatorMemoryResource)
   BOOST_CHECK(vecmove.size() == size);
 }
 
+BOOST_AUTO_TEST_CASE(test_SlabMessageResource)
+{
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(1), 256);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(256), 256);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(300), 320);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(512), 512);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(513), 640);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(1000000), 1048576);
+  BOOST_CHECK_EQUAL(SlabMessageResource::sizeClass(SlabMessageResource::MAX_SLAB_SIZE + 1), SlabMessageResource::MAX_SLAB_SIZE + 1);
+
+  auto factoryZMQ = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  SlabMessageResource resource(factoryZMQ.get(), 1024 * 1024);
+  void const* firstData = nullptr;
+  {
+    std::vector<char, polymorphic_allocator<char>> v(300, polymorphic_allocator<char>{&resource});
+    firstData = v.data();
+  }
+  auto stats = resource.getStats();
+  BOOST_CHECK_EQUAL(stats.allocations, 1);
+  BOOST_CHECK_EQUAL(stats.reused, 0);
+  BOOST_CHECK_EQUAL(stats.cachedMessages, 1);
+  BOOST_CHECK_EQUAL(stats.cachedBytes, 320);
+
+  // Same class, we get the same buffer back.
+  std::vector<char, polymorphic_allocator<char>> v(310, polymorphic_allocator<char>{&resource});
+  BOOST_CHECK(v.data() == firstData);
+  stats = resource.getStats();
+  BOOST_CHECK_EQUAL(stats.reused, 1);
+  BOOST_CHECK_EQUAL(stats.cachedMessages, 0);
+
+  // Extracting the message makes it leave the resource.
+  auto message = o2::pmr::getMessage(std::move(v));
+  BOOST_CHECK(message->GetData() == firstData);
+  BOOST_CHECK_EQUAL(message->GetSize(), 310);
+  BOOST_CHECK_EQUAL(resource.getNumberOfMessages(), 0);
+  BOOST_CHECK_EQUAL(resource.getStats().cachedMessages, 0);
+
+  // Nothing above the limit is cached.
+  {
+    std::vector<char, polymorphic_allocator<char>> big(2 * 1024 * 1024, polymorphic_allocator<char>{&resource});
+  }
+  BOOST_CHECK_EQUAL(resource.getStats().cachedMessages, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_AccountingMessageResource)
+{
+  auto factoryZMQ = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  AccountingMessageResource resource(factoryZMQ->GetMemoryResource(), 1);
+  {
+    std::vector<char, polymorphic_allocator<char>> v(300, polymorphic_allocator<char>{&resource});
+    BOOST_CHECK_EQUAL(resource.getStats().heldBytes, 300);
+  }
+  auto stats = resource.getStats(true);
+  BOOST_CHECK_EQUAL(stats.allocations, 1);
+  BOOST_CHECK_EQUAL(stats.allocatedBytes, 300);
+  BOOST_CHECK_EQUAL(stats.heldBytes, 0);
+  BOOST_CHECK_EQUAL(stats.peakHeldBytes, 300);
+
+  // A new interval starts from what is currently held.
+  stats = resource.getStats();
+  BOOST_CHECK_EQUAL(stats.allocations, 0);
+  BOOST_CHECK_EQUAL(stats.peakHeldBytes, 0);
+
+  // Extracting the message makes it leave the resource.
+  std::vector<char, polymorphic_allocator<char>> v(1000, polymorphic_allocator<char>{&resource});
+  BOOST_CHECK_EQUAL(resource.getStats().heldBytes, 1000);
+  auto message = o2::pmr::getMessage(std::move(v));
+  BOOST_CHECK_EQUAL(message->GetSize(), 1000);
+  stats = resource.getStats();
+  BOOST_CHECK_EQUAL(stats.heldBytes, 0);
+  BOOST_CHECK_EQUAL(stats.peakHeldBytes, 1000);
+
+  // Every allocation is sampled, both of them come from this test.
+  auto sites = resource.getTopSites(10);
+  BOOST_REQUIRE(!sites.empty());
+  size_t sampledBytes = 0;
+  for (auto& site : sites) {
+    BOOST_CHECK(site.nFrames > 0);
+    sampledBytes += site.bytes;
+  }
+  BOOST_CHECK_EQUAL(sampledBytes, 1300);
+  BOOST_CHECK(resource.getTopSites(1).size() == 1);
+}
+
 }; // namespace o2::pmr
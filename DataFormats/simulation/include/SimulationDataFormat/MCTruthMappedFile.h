@@ -0,0 +1,143 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MCTruthMappedFile.h
+/// \brief Flat on-disk storage of MC labels which is accessed via a memory mapping
+///
+/// The file holds one flat label buffer, as created by MCTruthContainer::flatten_to, per entry (e.g. per timeframe):
+/// <pre>
+/// FileHeader | buffer of entry 0 | buffer of entry 1 | ... | index with offset and size of the buffers
+/// </pre>
+/// The reader maps the file and returns ConstMCTruthContainerView objects pointing into the mapping. Only the pages
+/// of the labels which are accessed are read from disk, instead of reading the labels of a full entry into memory.
+
+#ifndef O2_MCTRUTHMAPPEDFILE_H
+#define O2_MCTRUTHMAPPEDFILE_H
+
+#include <SimulationDataFormat/ConstMCTruthContainer.h>
+#include <SimulationDataFormat/MCTruthContainer.h>
+#include <gsl/span>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TTree;
+
+namespace o2
+{
+namespace dataformats
+{
+
+namespace mctruthmappedfile
+{
+constexpr uint64_t Magic = 0x4f324d434c424c31; ///< identifier of the file format
+constexpr uint64_t Alignment = 64;             ///< alignment of the label buffers in the file
+
+struct FileHeader {
+  uint64_t magic = Magic;
+  uint64_t nEntries = 0;    ///< number of entries
+  uint64_t indexOffset = 0; ///< offset of the index, 0 as long as the file is not closed
+};
+
+struct IndexEntry {
+  uint64_t offset = 0; ///< offset of the flat label buffer of the entry
+  uint64_t size = 0;   ///< size of the flat label buffer of the entry
+};
+} // namespace mctruthmappedfile
+
+/// @class MCTruthMappedFileWriter
+/// @brief Writes the labels of consecutive entries to a file which can be read by MCTruthMappedFile
+class MCTruthMappedFileWriter
+{
+ public:
+  /// create the file, an existing file is overwritten
+  explicit MCTruthMappedFileWriter(std::string_view filename);
+  ~MCTruthMappedFileWriter() { close(); }
+  MCTruthMappedFileWriter(const MCTruthMappedFileWriter&) = delete;
+  MCTruthMappedFileWriter& operator=(const MCTruthMappedFileWriter&) = delete;
+
+  /// add the labels of the next entry from a flat buffer, as created by MCTruthContainer::flatten_to
+  void add(gsl::span<const char> flatBuffer);
+
+  /// add the labels of the next entry
+  template <typename TruthElement>
+  void add(MCTruthContainer<TruthElement> const& labels)
+  {
+    std::vector<char> buffer;
+    labels.flatten_to(buffer);
+    add(gsl::span<const char>(buffer.data(), buffer.size()));
+  }
+
+  /// add the labels of all entries of a branch, stored as IOMCTruthContainerView or MCTruthContainer<MCCompLabel>
+  /// \return number of entries added
+  size_t addFromTree(TTree* tree, std::string const& brname);
+
+  /// write the index and close the file
+  void close();
+
+  /// \return number of entries written so far
+  size_t getNEntries() const { return mIndex.size(); }
+
+ private:
+  std::ofstream mFile;
+  std::string mFileName;
+  std::vector<mctruthmappedfile::IndexEntry> mIndex;
+  uint64_t mPosition = 0; ///< current write position
+};
+
+/// @class MCTruthMappedFile
+/// @brief Read-only access to the labels of a file written by MCTruthMappedFileWriter via a memory mapping
+class MCTruthMappedFile
+{
+ public:
+  MCTruthMappedFile() = default;
+  explicit MCTruthMappedFile(std::string_view filename) { open(filename); }
+  ~MCTruthMappedFile() { close(); }
+  MCTruthMappedFile(const MCTruthMappedFile&) = delete;
+  MCTruthMappedFile& operator=(const MCTruthMappedFile&) = delete;
+
+  /// map the file, a previously opened file is closed
+  void open(std::string_view filename);
+
+  /// release the mapping
+  void close();
+
+  bool isOpen() const { return mMapping != nullptr; }
+
+  /// \return number of entries in the file
+  size_t getNEntries() const { return mNEntries; }
+
+  /// \return flat label buffer of the entry, empty for entries out of range
+  gsl::span<const char> getBuffer(size_t entry) const;
+
+  /// \return view of the labels of the entry, which is valid as long as the file is open
+  template <typename TruthElement>
+  ConstMCTruthContainerView<TruthElement> getView(size_t entry) const
+  {
+    return ConstMCTruthContainerView<TruthElement>(getBuffer(entry));
+  }
+
+  /// advise the kernel that the labels of the entry will be accessed soon
+  void prefetch(size_t entry) const;
+
+ private:
+  const char* mMapping = nullptr;
+  size_t mMappingSize = 0;
+  size_t mNEntries = 0;
+  const mctruthmappedfile::IndexEntry* mIndex = nullptr;
+};
+
+} // namespace dataformats
+} // namespace o2
+
+#endif
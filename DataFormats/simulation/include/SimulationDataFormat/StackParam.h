@@ -28,6 +28,8 @@ struct StackParam : public o2::conf::ConfigurableParamHelper<StackParam> {
   std::string transportPrimaryFileName = "";
   std::string transportPrimaryFuncName = "";
   bool transportPrimaryInvert = false;
+  bool compactKine = false;         // remove particles not selected for the output during the transport of a primary
+  int compactKineThreshold = 10000; // min. number of removable particles to compact the particle buffer
 
   // boilerplate stuff + make principal key "Stack"
   O2ParamDef(StackParam, "Stack");
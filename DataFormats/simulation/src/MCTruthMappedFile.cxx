@@ -0,0 +1,156 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MCTruthMappedFile.cxx
+/// \brief Implementation of the memory mapped MC label storage
+
+#include "SimulationDataFormat/MCTruthMappedFile.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include <TTree.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <memory>
+#include <stdexcept>
+
+using namespace o2::dataformats;
+using namespace o2::dataformats::mctruthmappedfile;
+
+MCTruthMappedFileWriter::MCTruthMappedFileWriter(std::string_view filename) : mFileName(filename)
+{
+  mFile.open(mFileName, std::ios::binary | std::ios::trunc);
+  if (!mFile) {
+    throw std::runtime_error("MCTruthMappedFileWriter: cannot create " + mFileName);
+  }
+  // the header is rewritten with the final numbers on close
+  FileHeader header;
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mPosition = sizeof(header);
+}
+
+void MCTruthMappedFileWriter::add(gsl::span<const char> flatBuffer)
+{
+  if (!mFile.is_open()) {
+    throw std::runtime_error("MCTruthMappedFileWriter: " + mFileName + " is already closed");
+  }
+  // align each buffer such that the header and the labels can be accessed in place
+  const uint64_t padding = (Alignment - mPosition % Alignment) % Alignment;
+  const char zeros[Alignment] = {0};
+  mFile.write(zeros, padding);
+  mPosition += padding;
+  mIndex.push_back({mPosition, flatBuffer.size()});
+  mFile.write(flatBuffer.data(), flatBuffer.size());
+  mPosition += flatBuffer.size();
+  if (!mFile) {
+    throw std::runtime_error("MCTruthMappedFileWriter: failed to write to " + mFileName);
+  }
+}
+
+size_t MCTruthMappedFileWriter::addFromTree(TTree* tree, std::string const& brname)
+{
+  const auto nEntries = tree->GetEntries();
+  for (Long64_t entry = 0; entry < nEntries; ++entry) {
+    std::unique_ptr<ConstMCTruthContainer<o2::MCCompLabel>> labels(MCLabelIOHelper::loadFromTTree(tree, brname, entry));
+    if (!labels) {
+      throw std::runtime_error("MCTruthMappedFileWriter: cannot read labels from branch " + brname);
+    }
+    add(gsl::span<const char>(labels->data(), labels->size()));
+  }
+  return nEntries;
+}
+
+void MCTruthMappedFileWriter::close()
+{
+  if (!mFile.is_open()) {
+    return;
+  }
+  const uint64_t padding = (Alignment - mPosition % Alignment) % Alignment;
+  const char zeros[Alignment] = {0};
+  mFile.write(zeros, padding);
+  FileHeader header;
+  header.nEntries = mIndex.size();
+  header.indexOffset = mPosition + padding;
+  mFile.write(reinterpret_cast<const char*>(mIndex.data()), mIndex.size() * sizeof(IndexEntry));
+  mFile.seekp(0);
+  mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mFile.close();
+}
+
+void MCTruthMappedFile::open(std::string_view filename)
+{
+  close();
+  const std::string name(filename);
+  int fd = ::open(name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("MCTruthMappedFile: cannot open " + name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("MCTruthMappedFile: " + name + " is too short");
+  }
+  void* mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("MCTruthMappedFile: cannot map " + name);
+  }
+  // the labels are accessed in random order by the consumers
+  madvise(mapping, st.st_size, MADV_RANDOM);
+  mMapping = static_cast<const char*>(mapping);
+  mMappingSize = st.st_size;
+
+  const auto* header = reinterpret_cast<const FileHeader*>(mMapping);
+  if (header->magic != Magic || header->indexOffset == 0 || header->indexOffset % Alignment ||
+      header->indexOffset + header->nEntries * sizeof(IndexEntry) > mMappingSize) {
+    close();
+    throw std::runtime_error("MCTruthMappedFile: " + name + " is not a valid or complete label file");
+  }
+  mNEntries = header->nEntries;
+  mIndex = reinterpret_cast<const IndexEntry*>(mMapping + header->indexOffset);
+  for (size_t i = 0; i < mNEntries; ++i) {
+    if (mIndex[i].offset + mIndex[i].size > header->indexOffset) {
+      close();
+      throw std::runtime_error("MCTruthMappedFile: corrupted index in " + name);
+    }
+  }
+}
+
+void MCTruthMappedFile::close()
+{
+  if (mMapping) {
+    munmap(const_cast<char*>(mMapping), mMappingSize);
+  }
+  mMapping = nullptr;
+  mMappingSize = 0;
+  mNEntries = 0;
+  mIndex = nullptr;
+}
+
+gsl::span<const char> MCTruthMappedFile::getBuffer(size_t entry) const
+{
+  if (entry >= mNEntries) {
+    return {};
+  }
+  return gsl::span<const char>(mMapping + mIndex[entry].offset, mIndex[entry].size);
+}
+
+void MCTruthMappedFile::prefetch(size_t entry) const
+{
+  if (entry >= mNEntries || mIndex[entry].size == 0) {
+    return;
+  }
+  // madvise needs a page aligned address
+  const auto pageSize = size_t(sysconf(_SC_PAGESIZE));
+  const size_t begin = mIndex[entry].offset / pageSize * pageSize;
+  const size_t end = mIndex[entry].offset + mIndex[entry].size;
+  madvise(const_cast<char*>(mMapping + begin), end - begin, MADV_WILLNEED);
+}
@@ -17,6 +17,7 @@
 #include "SimulationDataFormat/ConstMCTruthContainer.h"
 #include "SimulationDataFormat/LabelContainer.h"
 #include "SimulationDataFormat/IOMCTruthContainerView.h"
+#include "SimulationDataFormat/MCTruthMappedFile.h"
 #include <algorithm>
 #include <iostream>
 #include <TFile.h>
@@ -401,4 +402,76 @@ BOOST_AUTO_TEST_CASE(MCTruthContainer_ROOTIO)
   BOOST_CHECK(cont2->getLabels(BIGSIZE - 1)[1] == TruthElement(BIGSIZE, BIGSIZE - 1, BIGSIZE - 1));
 }
 
+
+BOOST_AUTO_TEST_CASE(MCTruthMappedFile)
+{
+  using TruthElement = o2::MCCompLabel;
+  const int NENTRIES = 5;
+  std::vector<dataformats::MCTruthContainer<TruthElement>> containers(NENTRIES);
+  for (int entry = 0; entry < NENTRIES; ++entry) {
+    // entries of different sizes, such that the buffers need padding, one of them empty
+    for (int i = 0; i < entry * 7; ++i) {
+      containers[entry].addElement(i, TruthElement(i, entry, 0));
+      if (i % 3 == 0) {
+        containers[entry].addElement(i, TruthElement(i + 1, entry, 1));
+      }
+    }
+  }
+  {
+    dataformats::MCTruthMappedFileWriter writer("tmpLabels.bin");
+    for (auto const& c : containers) {
+      writer.add(c);
+    }
+    BOOST_CHECK(writer.getNEntries() == NENTRIES);
+  }
+
+  dataformats::MCTruthMappedFile file("tmpLabels.bin");
+  BOOST_CHECK(file.getNEntries() == NENTRIES);
+  for (int entry = NENTRIES - 1; entry >= 0; --entry) {
+    file.prefetch(entry);
+    auto view = file.getView<TruthElement>(entry);
+    BOOST_CHECK(reinterpret_cast<uintptr_t>(view.getBuffer().data()) % dataformats::mctruthmappedfile::Alignment == 0);
+    BOOST_CHECK(view.getIndexedSize() == containers[entry].getIndexedSize());
+    BOOST_CHECK(view.getNElements() == containers[entry].getNElements());
+    for (int i = 0; i < containers[entry].getIndexedSize(); ++i) {
+      auto labels = view.getLabels(i);
+      auto ref = containers[entry].getLabels(i);
+      BOOST_CHECK(std::equal(labels.begin(), labels.end(), ref.begin(), ref.end()));
+    }
+  }
+  BOOST_CHECK(file.getBuffer(NENTRIES).empty());
+
+  // conversion of labels stored in a tree
+  {
+    TFile f("tmpLabels.root", "RECREATE");
+    TTree tree("o2sim", "o2sim");
+    dataformats::IOMCTruthContainerView* io = nullptr;
+    std::vector<char> buffer;
+    tree.Branch("Labels", &io, 32000, 2);
+    for (auto const& c : containers) {
+      c.flatten_to(buffer);
+      dataformats::IOMCTruthContainerView entryIO(buffer);
+      io = &entryIO;
+      tree.Fill();
+    }
+    dataformats::MCTruthMappedFileWriter writer("tmpLabels2.bin");
+    BOOST_CHECK(writer.addFromTree(&tree, "Labels") == NENTRIES);
+    BOOST_CHECK_THROW(writer.addFromTree(&tree, "NoLabels"), std::runtime_error);
+  }
+  dataformats::MCTruthMappedFile file2("tmpLabels2.bin");
+  BOOST_CHECK(file2.getNEntries() == NENTRIES);
+  for (int entry = 0; entry < NENTRIES; ++entry) {
+    auto buffer = file.getBuffer(entry), buffer2 = file2.getBuffer(entry);
+    BOOST_CHECK(std::equal(buffer.begin(), buffer.end(), buffer2.begin(), buffer2.end()));
+  }
+
+  // files which were not closed by the writer are rejected
+  {
+    std::ofstream truncated("tmpLabels3.bin", std::ios::binary);
+    dataformats::mctruthmappedfile::FileHeader header;
+    truncated.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+  BOOST_CHECK_THROW(dataformats::MCTruthMappedFile("tmpLabels3.bin"), std::runtime_error);
+}
+
 } // namespace o2
@@ -472,6 +472,15 @@ class AODProducerWorkflowDPL : public Task
   };
   std::vector<TPCCounters> mTPCCounters;
 
+  // barrel track quantities computed in parallel before the sequential filling of the track tables
+  struct BarrelTrackCache {
+    TrackExtraInfo extraInfo{};
+    o2::track::TrackParCov trackPar{}; // track propagated to the PV, if isProp
+    bool isProp = false;
+    bool isSet = false; // if not set, the track is processed while filling the tables
+  };
+  std::vector<BarrelTrackCache> mBarrelTrackCache; // one entry per vertex-track association
+
   void updateTimeDependentParams(ProcessingContext& pc);
 
   void addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
@@ -627,6 +636,15 @@ class AODProducerWorkflowDPL : public Task
   // helper for tpc clusters
   void countTPCClusters(const o2::globaltracking::RecoContainer& data);
 
+  // helpers for barrel tracks
+  bool isThinnedCandidate(GIndex trackIndex) const
+  {
+    return mThinTracks && trackIndex.getSource() == GIndex::Source::TPC && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() && mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end();
+  }
+  void fillBarrelTrackCache(BarrelTrackCache& trackCache, int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
+                            const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
+  void cacheBarrelTracks(const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
+
   // helper for trd pattern
   uint8_t getTRDPattern(const o2::trd::TrackTRD& track);
 
@@ -88,6 +88,8 @@
 #include <map>
 #include <numeric>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <set>
 #include <string>
 #include <vector>
@@ -301,11 +303,13 @@ void AODProducerWorkflowDPL::addToTracksTable(TracksCursorType& tracksCursor, Tr
   // trackscov
   float sY = TMath::Sqrt(track.getSigmaY2()), sZ = TMath::Sqrt(track.getSigmaZ2()), sSnp = TMath::Sqrt(track.getSigmaSnp2()),
         sTgl = TMath::Sqrt(track.getSigmaTgl2()), sQ2Pt = TMath::Sqrt(track.getSigma1Pt2());
-  tracksCovCursor(truncateFloatFraction(sY, mTrackCovDiag),
-                  truncateFloatFraction(sZ, mTrackCovDiag),
-                  truncateFloatFraction(sSnp, mTrackCovDiag),
-                  truncateFloatFraction(sTgl, mTrackCovDiag),
-                  truncateFloatFraction(sQ2Pt, mTrackCovDiag),
+  float sigmas[5] = {sY, sZ, sSnp, sTgl, sQ2Pt};
+  truncateFloatFractions(sigmas, 5, mTrackCovDiag);
+  tracksCovCursor(sigmas[0],
+                  sigmas[1],
+                  sigmas[2],
+                  sigmas[3],
+                  sigmas[4],
                   (Char_t)(128. * track.getSigmaZY() / (sZ * sY)),
                   (Char_t)(128. * track.getSigmaSnpY() / (sSnp * sY)),
                   (Char_t)(128. * track.getSigmaSnpZ() / (sSnp * sZ)),
@@ -481,7 +485,16 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           float weight = 0;
           static std::uniform_real_distribution<> distr(0., 1.);
           bool writeQAData = o2::math_utils::Tsallis::downsampleTsallisCharged(data.getTrackParam(trackIndex).getPt(), mTrackQCFraction, mSqrtS, weight, distr(mGenerator));
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+          bool isThinned = isThinnedCandidate(trackIndex);
+          if (isThinned && !writeQAData) {
+            mGIDToTableID.emplace(trackIndex, -1); // skipped track, see below
+            continue;
+          }
+          auto& trackCache = mBarrelTrackCache[ti];
+          if (!trackCache.isSet) { // not processed in advance
+            fillBarrelTrackCache(trackCache, collisionID, collisionBC, trackIndex, data, bcsMap);
+          }
+          auto& extraInfoHolder = trackCache.extraInfo;
 
           if (writeQAData) {
             auto trackQAInfoHolder = processBarrelTrackQA(collisionID, collisionBC, trackIndex, data, bcsMap);
@@ -496,7 +509,7 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
             }
           }
 
-          if (mThinTracks && src == GIndex::Source::TPC && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() && mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end() && !writeQAData) {
+          if (isThinned && !writeQAData) {
             mGIDToTableID.emplace(trackIndex, -1); // pretend skipped tracks are stored; this is safe since they are are not written to disk and -1 indicates to all users to not use this track
             continue;
           }
@@ -506,19 +519,10 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                          << " timeErr=" << extraInfoHolder.trackTimeRes << " BCSlice: " << extraInfoHolder.bcSlice[0] << ":" << extraInfoHolder.bcSlice[1];
             continue;
           }
-          const auto& trOrig = data.getTrackParam(trackIndex);
-          bool isProp = false;
-          if (mPropTracks && trOrig.getX() < mMinPropR &&
-              mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
-              mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) { // Do not propagate track assoc. to V0s and str. tracking
-            auto trackPar(trOrig);
-            isProp = propagateTrackToPV(trackPar, data, collisionID);
-            if (isProp) {
-              addToTracksTable(tracksCursor, tracksCovCursor, trackPar, collisionID, aod::track::Track);
-            }
-          }
-          if (!isProp) {
-            addToTracksTable(tracksCursor, tracksCovCursor, trOrig, collisionID, aod::track::TrackIU);
+          if (trackCache.isProp) {
+            addToTracksTable(tracksCursor, tracksCovCursor, trackCache.trackPar, collisionID, aod::track::Track);
+          } else {
+            addToTracksTable(tracksCursor, tracksCovCursor, data.getTrackParam(trackIndex), collisionID, aod::track::TrackIU);
           }
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
 
@@ -553,6 +557,75 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
   }
 }
 
+void AODProducerWorkflowDPL::fillBarrelTrackCache(BarrelTrackCache& trackCache, int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
+                                                  const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+{
+  trackCache.extraInfo = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+  trackCache.isProp = false;
+  const auto& trOrig = data.getTrackParam(trackIndex);
+  if (mPropTracks && trOrig.getX() < mMinPropR &&
+      mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
+      mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) { // Do not propagate track assoc. to V0s and str. tracking
+    trackCache.trackPar = trOrig;
+    trackCache.isProp = propagateTrackToPV(trackCache.trackPar, data, collisionID);
+  }
+  trackCache.isSet = true;
+}
+
+void AODProducerWorkflowDPL::cacheBarrelTracks(const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+{
+  // process in parallel the barrel tracks that fillTrackTablesPerCollision will store, i.e. the first association
+  // of each track, except those which may be thinned, so that the tables are then filled in the usual order from the cache
+  auto primVertices = data.getPrimaryVertices();
+  auto primVer2TRefs = data.getPrimaryVertexMatchedTrackRefs();
+  auto primVerGIs = data.getPrimaryVertexMatchedTracks();
+  mBarrelTrackCache.clear();
+  mBarrelTrackCache.resize(primVerGIs.size());
+  if (primVer2TRefs.empty()) {
+    return;
+  }
+
+  // list the associations to process following the filling order: unassigned tracks first, then collision by collision
+  std::vector<std::pair<int, int>> associations{}; // (index in primVerGIs, collisionID)
+  std::unordered_set<GIndex> ambiguousTracks{};
+  int nVertices = primVertices.size();
+  for (int collisionID = -1; collisionID < nVertices; collisionID++) {
+    const auto& trackRef = (collisionID < 0) ? primVer2TRefs.back() : primVer2TRefs[collisionID];
+    for (int src = GIndex::NSources; src--;) {
+      if (!GIndex::isTrackSource(src) || !GIndex::includesSource(src, mInputSources) ||
+          src == GIndex::Source::MFT || src == GIndex::Source::MCH || src == GIndex::Source::MFTMCH || src == GIndex::Source::MCHMID) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        const auto& trackIndex = primVerGIs[ti];
+        if ((trackIndex.isAmbiguous() && !ambiguousTracks.insert(trackIndex).second) || isThinnedCandidate(trackIndex)) {
+          continue;
+        }
+        associations.emplace_back(ti, collisionID);
+      }
+    }
+  }
+
+  std::vector<std::uint64_t> collisionBCs(nVertices);
+  for (int collisionID = 0; collisionID < nVertices; collisionID++) {
+    const double interactionTime = primVertices[collisionID].getTimeStamp().getTimeStamp() * 1E3; // mus to ns
+    collisionBCs[collisionID] = relativeTime_to_GlobalBC(interactionTime);
+  }
+
+  int nAssociations = associations.size();
+#ifdef WITH_OPENMP
+  int ngroup = std::min(50, std::max(1, nAssociations / mNThreads));
+#pragma omp parallel for schedule(dynamic, ngroup) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nAssociations; i++) {
+    int ti = associations[i].first, collisionID = associations[i].second;
+    std::uint64_t collisionBC = (collisionID < 0) ? std::uint64_t(-1) : collisionBCs[collisionID];
+    fillBarrelTrackCache(mBarrelTrackCache[ti], collisionID, collisionBC, primVerGIs[ti], data, bcsMap);
+  }
+}
+
 void AODProducerWorkflowDPL::fillIndexTablesPerCollision(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices, const o2::globaltracking::RecoContainer& data)
 {
   const auto& mchmidMatches = data.getMCHMIDMatches();
@@ -2140,6 +2213,9 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
   }
 
+  // process the barrel tracks in advance, possibly in parallel
+  cacheBarrelTracks(recoData, bcsMap);
+
   // filling unassigned tracks first
   // so that all unassigned tracks are stored in the beginning of the table together
   auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
@@ -2294,6 +2370,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   clearMCKeepStore(mToStore);
   mGIDToTableID.clear();
   mTableTrID = 0;
+  mBarrelTrackCache.clear();
   mGIDToTableFwdID.clear();
   mTableTrFwdID = 0;
   mGIDToTableMFTID.clear();
@@ -43,6 +43,7 @@ struct AlignConfig : public o2::conf::ConfigurableParamHelper<AlignConfig> {
   float minScatteringAngleToAccount = 0.0003;
 
   int verbose = 0;
+  int nThreads = 1; // number of threads for the calculation of the residuals derivatives of each track
 
   int vtxMinCont = 2;     // require min number of contributors in Vtx
   int vtxMaxCont = 99999; // require max number of contributors in Vtx
@@ -28,6 +28,10 @@
 #include "MathUtils/SymMatrixSolver.h"
 #include "MathUtils/Utils.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 #define DEBUG 4
 using namespace o2::align::utils;
 using namespace o2::base;
@@ -168,8 +172,6 @@ bool AlignmentTrack::calcResidDeriv(double* extendedParams, bool invert, int pFr
   // (like http://root.cern.ch/root/html/ROOT__Math__RichardsonDerivator.html)
   //
   const auto& algConf = AlignConfig::Instance();
-  trackParam_t probD[kNRDClones]; // use this to vary supplied param for derivative calculation
-  double varDelta[kRichardsonN];
   const int kInvElem[kNKinParBON] = {-1, 1, 1, -1, -1};
   //
   const double kDelta[kNKinParBON] = {0.02, 0.02, 0.001, 0.001, 0.01}; // variations for ExtTrackParam and material effects
@@ -195,7 +197,11 @@ bool AlignmentTrack::calcResidDeriv(double* extendedParams, bool invert, int pFr
   }
 
   // 1) derivative wrt trackParam_t parameters
-  for (int ipar = mNLocExtPar; ipar--;) {
+  // 2) derivatives wrt material effect related parameters: MS and eventually ELoss
+  // the derivatives over each parameter are independent of each other and can be computed concurrently
+  auto calcDerivExtPar = [&](int ipar) -> bool {
+    trackParam_t probD[kNRDClones]; // use this to vary supplied param for derivative calculation
+    double varDelta[kRichardsonN];
     setParams(probD, kNRDClones, getX(), getAlpha(), extendedParams, true);
     if (invert) {
       for (int ic = kNRDClones; ic--;) {
@@ -229,103 +235,127 @@ bool AlignmentTrack::calcResidDeriv(double* extendedParams, bool invert, int pFr
         }
       }
     } // loop over points
-  }   // loop over ExtTrackParam parameters
-  // 2) now vary material effect related parameters: MS and eventually ELoss
-  for (int ip = pFrom; ip != pTo; ip += pinc) { // points are ordered against track direction
+    return true;
+  };
+
+  // params is a private copy of extendedParams, the varied parameter is restored on exit
+  auto calcDerivMatPar = [&](int ip, int ipar, double* params) -> bool {
     AlignmentPoint* pnt = getPoint(ip);
-    // global derivatives at this point
-    if (pnt->containsMeasurement() && !calcResidDerivGlo(pnt)) {
-      if (algConf.verbose > 2) {
-        LOGF(warn, "Failed on global derivatives calculation at point %d", ip);
-        pnt->print(AlignmentPoint::kMeasurementBit);
-      }
-      return false;
-    }
-    //
-    if (!pnt->containsMaterial()) {
-      continue;
-    }
-    //
+    trackParam_t probD[kNRDClones];
+    double varDelta[kRichardsonN];
     int nParFreeI = pnt->getNMatPar();
     //
     // array delta gives desired variation of parameters in trackParam_t definition,
     // while the variation should be done for parameters in the frame where the vector
     // of material corrections has diagonal cov. matrix -> rotate the delta to this frame
-    double deltaMatD[kNKinParBON];
-    //    pnt->diagMatCorr(delta, deltaMatD);
-    for (int ipar = 0; ipar < nParFreeI; ipar++) {
-      double d = pnt->getMatCorrCov()[ipar];
-      deltaMatD[ipar] = d > 0. ? Sqrt(d) * 5 : delta[ipar];
-    }
+    double d = pnt->getMatCorrCov()[ipar];
+    double del = d > 0. ? Sqrt(d) * 5 : delta[ipar];
     //
-    //    printf("Vary %d [%+.3e %+.3e %+.3e %+.3e] ",ip,deltaMatD[0],deltaMatD[1],deltaMatD[2],deltaMatD[3]); pnt->print();
-
     int offsI = pnt->getMaxLocVarID() - nParFreeI; // the parameters for this point start with this offset
                                                    // they are irrelevant for the points upstream
-    for (int ipar = 0; ipar < nParFreeI; ipar++) { // loop over DOFs related to MS and ELoss are point ip
-      double del = deltaMatD[ipar];
+    //
+    // We will vary the tracks starting from the original parameters propagated to given point
+    // and stored there (before applying material corrections for this point)
+    //
+    setParams(probD, kNRDClones, pnt->getXTracking(), pnt->getAlphaSens(), pnt->getTrParamWSB(), false);
+    // no need for eventual track inversion here: if needed, this is already done in ParamWSB
+    //
+    int offsIP = offsI + ipar; // parameter entry in the extendedParams array
+    double parOrig = params[offsIP];
+    for (int icl = 0; icl < kRichardsonN; icl++) { // calculate kRichardsonN variations with del, del/2, del/4...
+      varDelta[icl] = del;
+      params[offsIP] = parOrig + del;
       //
-      // We will vary the tracks starting from the original parameters propagated to given point
-      // and stored there (before applying material corrections for this point)
+      // apply varied material effects : incremented by delta
+      if (!applyMatCorr(probD[(icl << 1) + 0], params, pnt)) {
+        params[offsIP] = parOrig;
+        return false;
+      }
       //
-      setParams(probD, kNRDClones, pnt->getXTracking(), pnt->getAlphaSens(), pnt->getTrParamWSB(), false);
-      // no need for eventual track inversion here: if needed, this is already done in ParamWSB
+      // apply varied material effects : decremented by delta
+      params[offsIP] = parOrig - del;
+      if (!applyMatCorr(probD[(icl << 1) + 1], params, pnt)) {
+        params[offsIP] = parOrig;
+        return false;
+      }
       //
-      int offsIP = offsI + ipar; // parameter entry in the extendedParams array
-      //      printf("  Var:%d (%d)  %e\n",ipar,offsIP, del);
-
-      for (int icl = 0; icl < kRichardsonN; icl++) { // calculate kRichardsonN variations with del, del/2, del/4...
-        varDelta[icl] = del;
-        double parOrig = extendedParams[offsIP];
-        extendedParams[offsIP] += del;
-        //
-        // apply varied material effects : incremented by delta
-        if (!applyMatCorr(probD[(icl << 1) + 0], extendedParams, pnt)) {
-          return false;
-        }
-        //
-        // apply varied material effects : decremented by delta
-        extendedParams[offsIP] = parOrig - del;
-        if (!applyMatCorr(probD[(icl << 1) + 1], extendedParams, pnt)) {
+      params[offsIP] = parOrig;
+      del *= 0.5;
+    }
+    if (pnt->containsMeasurement()) { // calculate derivatives at the scattering point itself
+      int offsDerIP = ip * mNLocPar + offsIP;
+      richardsonDeriv(probD, varDelta, pnt, mDResDLoc[0][offsDerIP], mDResDLoc[1][offsDerIP]); // calculate derivatives for ip
+    }
+    //
+    // loop over points whose residuals can be affected by the material effects on point ip
+    for (int jp = ip + pinc; jp != pTo; jp += pinc) {
+      AlignmentPoint* pntJ = getPoint(jp);
+      if (!propagateParamToPoint(probD, kNRDClones, pntJ, algConf.maxStep, algConf.maxSnp, MatCorrType::USEMatCorrNONE, signELoss)) {
+        return false;
+      }
+      //
+      if (pntJ->containsMaterial()) { // apply material corrections
+        if (!applyMatCorr(probD, kNRDClones, params, pntJ)) {
           return false;
         }
-        //
-        extendedParams[offsIP] = parOrig;
-        del *= 0.5;
       }
-      if (pnt->containsMeasurement()) { // calculate derivatives at the scattering point itself
-        int offsDerIP = ip * mNLocPar + offsIP;
-        richardsonDeriv(probD, varDelta, pnt, mDResDLoc[0][offsDerIP], mDResDLoc[1][offsDerIP]); // calculate derivatives for ip
-                                                                                                 // printf("DR SELF: %e %e at %d (%d)\n",mDResDLoc[0][offsDerIP], mDResDLoc[1][offsDerIP],offsI, offsDerIP);
+      //
+      if (pntJ->containsMeasurement()) {
+        int offsDerJ = jp * mNLocPar + offsIP;
+        // calculate derivatives
+        richardsonDeriv(probD, varDelta, pntJ, mDResDLoc[0][offsDerJ], mDResDLoc[1][offsDerJ]);
       }
       //
-      // loop over points whose residuals can be affected by the material effects on point ip
-      for (int jp = ip + pinc; jp != pTo; jp += pinc) {
-        AlignmentPoint* pntJ = getPoint(jp);
+    } // << loop over points whose residuals can be affected by the material effects on point ip
+    return true;
+  };
 
-        // printf("  DerFor:%d ",jp); pntJ->print();
+  // global derivatives of the points and list of the material parameters to vary
+  std::vector<std::pair<int, int>> matPars; // (point, material parameter of this point)
+  for (int ip = pFrom; ip != pTo; ip += pinc) { // points are ordered against track direction
+    AlignmentPoint* pnt = getPoint(ip);
+    // global derivatives at this point
+    if (pnt->containsMeasurement() && !calcResidDerivGlo(pnt)) {
+      if (algConf.verbose > 2) {
+        LOGF(warn, "Failed on global derivatives calculation at point %d", ip);
+        pnt->print(AlignmentPoint::kMeasurementBit);
+      }
+      return false;
+    }
+    if (pnt->containsMaterial()) {
+      for (int ipar = 0; ipar < pnt->getNMatPar(); ipar++) { // loop over DOFs related to MS and ELoss are point ip
+        matPars.emplace_back(ip, ipar);
+      }
+    }
+  }
 
-        if (!propagateParamToPoint(probD, kNRDClones, pntJ, algConf.maxStep, algConf.maxSnp, MatCorrType::USEMatCorrNONE, signELoss)) {
-          return false;
-        }
-        //
-        if (pntJ->containsMaterial()) { // apply material corrections
-          if (!applyMatCorr(probD, kNRDClones, extendedParams, pntJ)) {
-            return false;
-          }
-        }
-        //
-        if (pntJ->containsMeasurement()) {
-          int offsDerJ = jp * mNLocPar + offsIP;
-          // calculate derivatives
-          richardsonDeriv(probD, varDelta, pntJ, mDResDLoc[0][offsDerJ], mDResDLoc[1][offsDerJ]);
-        }
-        //
-      } // << loop over points whose residuals can be affected by the material effects on point ip
-    }   // << loop over DOFs related to MS and ELoss are point ip
-  }     // << loop over all points of the track
+  int nExtPar = mNLocExtPar, nMatPars = matPars.size();
+  int nThreads = algConf.nThreads;
+  bool ok = true;
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(nThreads) if (nThreads > 1) reduction(&& : ok)
+#endif
+  {
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int ipar = 0; ipar < nExtPar; ipar++) {
+      if (ok) {
+        ok = calcDerivExtPar(ipar);
+      }
+    }
+    std::vector<double> params(extendedParams, extendedParams + mNLocPar);
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int i = 0; i < nMatPars; i++) {
+      if (ok) {
+        ok = calcDerivMatPar(matPars[i].first, matPars[i].second, params.data());
+      }
+    }
+  }
   //
-  return true;
+  return ok;
 }
 
 //______________________________________________________
@@ -736,7 +766,7 @@ void AlignmentTrack::richardsonDeriv(const trackParam_t* trSet, const double* de
 {
   // Calculate Richardson derivatives for diagonalized Y and Z from a set of kRichardsonN pairs
   // of tracks with same parameter of i-th pair varied by +-delta[i]
-  static double derRichY[kRichardsonN], derRichZ[kRichardsonN];
+  double derRichY[kRichardsonN], derRichZ[kRichardsonN];
   //
   for (int icl = 0; icl < kRichardsonN; icl++) { // calculate kRichardsonN variations with del, del/2, del/4...
     double resYVP = 0, resYVN = 0, resZVP = 0, resZVN = 0;
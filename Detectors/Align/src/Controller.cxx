@@ -203,13 +203,13 @@ void Controller::process()
         int npnt = 0;
         auto contributorsGID = mRecoData->getSingleDetectorRefs(trackIndex);
 
-        std::string trComb;
-        for (int ig = 0; ig < GIndex::NSources; ig++) {
-          if (contributorsGID[ig].isIndexSet()) {
-            trComb += " " + contributorsGID[ig].asString();
-          }
-        }
         if (algConf.verbose > 1) {
+          std::string trComb;
+          for (int ig = 0; ig < GIndex::NSources; ig++) {
+            if (contributorsGID[ig].isIndexSet()) {
+              trComb += " " + contributorsGID[ig].asString();
+            }
+          }
           LOG(info) << "processing track " << trackIndex.asString() << " contributors: " << trComb;
         }
         resetForNextTrack();
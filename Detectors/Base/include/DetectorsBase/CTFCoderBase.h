@@ -17,6 +17,12 @@
 #define _ALICEO2_CTFCODER_BASE_H_
 
 #include <memory>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
 #include <TFile.h>
 #include <TTree.h>
 #include "DetectorsCommonDataFormats/DetID.h"
@@ -27,6 +33,7 @@
 #include "DetectorsCommonDataFormats/CTFIOSize.h"
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DetectorsCommonDataFormats/ANSHeader.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "rANS/factory.h"
 #include "rANS/compat.h"
 #include "rANS/histogram.h"
@@ -80,6 +87,10 @@ class CTFCoderBase
   template <typename CTF>
   void createCodersFromFile(const std::string& dictPath, o2::ctf::CTFCoderBase::OpType op, bool mayFail = false);
 
+  /// recreate the coders if the dictionary file (or the target of the link) was replaced since the last call, the current coders are kept on failure
+  template <typename CTF>
+  bool updateCodersFromFile(const std::string& dictPath);
+
   template <typename S>
   void createCoder(OpType op, const o2::rans::RenormedDenseHistogram<S>& renormedHistogram, int slot)
   {
@@ -118,9 +129,22 @@ class CTFCoderBase
   void setMemMarginFactor(float v) { mMemMarginFactor = v > 1.f ? v : 1.f; }
   float getMemMarginFactor() const { return mMemMarginFactor; }
 
+  /// number of threads used to entropy-encode the independent slots concurrently
+  void setNThreads(int n) { mNThreads = n > 1 ? n : 1; }
+  int getNThreads() const { return mNThreads; }
+
   void setVerbosity(int v) { mVerbosity = v; }
   int getVerbosity() const { return mVerbosity; }
 
+  /// if > 0, check for an updated external dictionary (CCDB object or local file) every n TFs
+  void setDictUpdateInterval(int n) { mDictUpdateInterval = n > 0 ? n : 0; }
+  int getDictUpdateInterval() const { return mDictUpdateInterval; }
+
+  /// if > 0, encode every n-th TF with per-TF dictionaries despite the external one, to feed the online dictionary creation
+  void setDictSampling(int n) { mDictSampling = n > 0 ? n : 0; }
+  int getDictSampling() const { return mDictSampling; }
+  bool isDictSampledTF() const { return mDictSampledTF; }
+
   const CTFDictHeader& getExtDictHeader() const { return mExtHeader; }
 
   template <typename T>
@@ -161,6 +185,52 @@ class CTFCoderBase
 
   const DetID getDet() const { return mDet; }
 
+  /// Entropy-encoder of the slots of the CTF container held in the buffer. With a single thread every slot is encoded
+  /// immediately to the buffer, otherwise the encoding is deferred to finalise(), which encodes the slots concurrently,
+  /// each into its own scratch container pre-sized according to the memory margin factor, and copies them in slot order
+  /// to the buffer. The encoded payload does not depend on the number of threads. The input data must stay valid until finalise().
+  template <typename CTF, typename BUF>
+  class SlotEncoder
+  {
+   public:
+    SlotEncoder(CTFCoderBase& coder, BUF& buffer) : mCoder(coder), mBuffer(buffer) {}
+
+    /// encode the data to the slot, skipping the entries flagged in the optional reject mask
+    template <typename IT>
+    void encode(IT begin, IT end, int slot, uint8_t probabilityBits, Metadata::OptStore opt, const std::vector<bool>* reject = nullptr);
+
+    /// encode the data to the slot with the symbol tables selected by the context stream of the same length, see EncodedBlocks::encodeWithContext
+    template <typename IT, typename CIT>
+    void encodeWithContext(IT begin, IT end, CIT ctxBegin, int slot, uint8_t ctxBits, uint8_t probabilityBits, Metadata::OptStore opt, const std::vector<bool>* reject = nullptr);
+
+    /// run deferred encoding and copy the slots to the buffer, returns the accumulated IO sizes
+    CTFIOSize finalise();
+
+   private:
+    // run the job immediately or defer it to finalise() when encoding with several threads
+    template <typename source_T, typename F>
+    void schedule(int slot, size_t nSamples, F&& job);
+
+    // margin covering the internal margins of the encoder and the dictionary stored with the data
+    static constexpr size_t ScratchMarginBytes = 64 * 1024;
+    using scratch_t = std::vector<o2::ctf::BufferType>;
+    struct Job {
+      int slot = 0;
+      size_t nBytes = 0; // estimated payload size
+      std::function<CTFIOSize(scratch_t&)> run;
+    };
+    CTFCoderBase& mCoder;
+    BUF& mBuffer;
+    std::vector<Job> mJobs;
+    CTFIOSize mIOSize;
+  };
+
+  template <typename CTF, typename BUF>
+  SlotEncoder<CTF, BUF> makeSlotEncoder(BUF& buffer)
+  {
+    return SlotEncoder<CTF, BUF>(*this, buffer);
+  }
+
  protected:
   void reportIRFrames();
   std::string getPrefix() const { return o2::utils::Str::concat_string(mDet.getName(), "_CTF: "); }
@@ -172,6 +242,12 @@ class CTFCoderBase
     return diff < 0 ? true : diff >= shift;
   }
   bool canApplyBCShift(const o2::InteractionRecord& ir) const { return canApplyBCShift(ir, mBCShift); }
+  // external coder of the slot, none for the TFs sampled with per-TF dictionaries
+  const std::any& getTFCoder(int slot) const
+  {
+    static const std::any noCoder{};
+    return mDictSampledTF ? noCoder : mCoders[slot];
+  }
 
   template <typename source_IT>
   [[nodiscard]] size_t estimateBufferSize(size_t slot, source_IT samplesBegin, source_IT samplesEnd);
@@ -195,6 +271,13 @@ class CTFCoderBase
   o2::utils::IRFrameSelector mIRFrameSelector; // optional IR frames selector
   float mMemMarginFactor = 1.0f;               // factor for memory allocation in EncodedBlocks
   bool mLoadDictFromCCDB{true};
+  bool mDictSampledTF{false};                      // current TF is encoded with per-TF dictionaries
+  int mDictUpdateInterval = 0;                     // if > 0, check for the dictionary update every so many TFs
+  int mDictSampling = 0;                           // if > 0, encode every so many TFs with per-TF dictionaries
+  size_t mNTFProcessed = 0;                        // TFs seen by updateTimeDependentParams
+  std::function<void()> mDictUpdater;              // reloads the external dictionary from the local file if it was updated
+  std::filesystem::path mDictFileTarget{};         // resolved dictionary file of the current coders
+  std::filesystem::file_time_type mDictFileTime{}; // its modification time
   bool mSupportBCShifts{false};
   OpType mOpType;                                    // Encoder or Decoder
   ctf::ANSHeader mANSVersion{ctf::ANSVersionCompat}; // Version of the ANSEncoder/Decoder
@@ -204,8 +287,129 @@ class CTFCoderBase
   size_t mIRFrameSelMarginFwd = 0; // margin in BC to add to the IRFrame upper boundary when selection is requested
   long mIRFrameSelShift = 0;       // Global shift of the IRFrames, to account for e.g. detector latency
   int mVerbosity = 0;
+  int mNThreads = 1; // threads for the entropy encoding of the slots
 };
 
+///________________________________
+template <typename CTF, typename BUF>
+template <typename IT>
+void CTFCoderBase::SlotEncoder<CTF, BUF>::encode(IT begin, IT end, int slot, uint8_t probabilityBits, Metadata::OptStore opt, const std::vector<bool>* reject)
+{
+  using source_T = typename std::iterator_traits<IT>::value_type;
+  auto job = [&coder = mCoder, begin, end, slot, probabilityBits, opt, reject](auto& dest) {
+    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer to the container
+    if (reject && begin != end) {
+      std::vector<source_T> tmp;
+      tmp.reserve(std::distance(begin, end));
+      for (auto i = begin; i != end; i++) {
+        if (!(*reject)[std::distance(begin, i)]) {
+          tmp.emplace_back(*i);
+        }
+      }
+      return CTF::get(dest.data())->encode(tmp.begin(), tmp.end(), slot, probabilityBits, opt, &dest, coder.getTFCoder(slot), coder.getMemMarginFactor());
+    }
+    return CTF::get(dest.data())->encode(begin, end, slot, probabilityBits, opt, &dest, coder.getTFCoder(slot), coder.getMemMarginFactor());
+  };
+  schedule<source_T>(slot, std::distance(begin, end), std::move(job));
+}
+
+///________________________________
+template <typename CTF, typename BUF>
+template <typename IT, typename CIT>
+void CTFCoderBase::SlotEncoder<CTF, BUF>::encodeWithContext(IT begin, IT end, CIT ctxBegin, int slot, uint8_t ctxBits, uint8_t probabilityBits, Metadata::OptStore opt, const std::vector<bool>* reject)
+{
+  using source_T = typename std::iterator_traits<IT>::value_type;
+  using context_T = typename std::iterator_traits<CIT>::value_type;
+  auto job = [&coder = mCoder, begin, end, ctxBegin, slot, ctxBits, probabilityBits, opt, reject](auto& dest) {
+    // the rejected entries are dropped from both the data and the context
+    if (reject && begin != end) {
+      std::vector<source_T> tmp;
+      std::vector<context_T> tmpCtx;
+      tmp.reserve(std::distance(begin, end));
+      tmpCtx.reserve(std::distance(begin, end));
+      auto ctx = ctxBegin;
+      for (auto i = begin; i != end; i++, ctx++) {
+        if (!(*reject)[std::distance(begin, i)]) {
+          tmp.emplace_back(*i);
+          tmpCtx.emplace_back(*ctx);
+        }
+      }
+      return CTF::get(dest.data())->encodeWithContext(tmp.begin(), tmp.end(), tmpCtx.begin(), slot, ctxBits, probabilityBits, opt, &dest, coder.getTFCoder(slot), coder.getMemMarginFactor());
+    }
+    return CTF::get(dest.data())->encodeWithContext(begin, end, ctxBegin, slot, ctxBits, probabilityBits, opt, &dest, coder.getTFCoder(slot), coder.getMemMarginFactor());
+  };
+  schedule<source_T>(slot, std::distance(begin, end), std::move(job));
+}
+
+///________________________________
+template <typename CTF, typename BUF>
+template <typename source_T, typename F>
+void CTFCoderBase::SlotEncoder<CTF, BUF>::schedule(int slot, size_t nSamples, F&& job)
+{
+  if (mCoder.getNThreads() > 1) {
+    size_t nBytes = 0;
+    if (nSamples) {
+      nBytes = ScratchMarginBytes + size_t(1.5 * mCoder.getMemMarginFactor() * mCoder.template estimateBufferSize<source_T>(slot, nSamples));
+    }
+    mJobs.push_back(Job{slot, nBytes, [job, slot, nBytes, ansVersion = mCoder.getANSVersion()](scratch_t& dest) {
+                          CTF::createForSlot(dest, slot, nBytes)->setANSHeader(ansVersion);
+                          return job(dest);
+                        }});
+  } else {
+    mIOSize += job(mBuffer);
+  }
+}
+
+///________________________________
+template <typename CTF, typename BUF>
+CTFIOSize CTFCoderBase::SlotEncoder<CTF, BUF>::finalise()
+{
+  if (mJobs.size()) {
+    std::vector<scratch_t> scratch(mJobs.size());
+    std::vector<CTFIOSize> ioSizes(mJobs.size());
+    // plain threads rather than OpenMP: this header is compiled in the detector workflows, which are not built with it
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(mJobs.size());
+    auto worker = [&]() {
+      for (size_t i; (i = next++) < mJobs.size();) {
+        try {
+          ioSizes[i] = mJobs[i].run(scratch[i]);
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int it = 1; it < std::min<int>(mCoder.getNThreads(), mJobs.size()); it++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : threads) {
+      th.join();
+    }
+    for (auto& err : errors) {
+      if (err) {
+        std::rethrow_exception(err);
+      }
+    }
+    // expand the output once for all slots rather than at every copy
+    auto* ec = CTF::get(mBuffer.data());
+    size_t needed = 0;
+    for (size_t i = 0; i < mJobs.size(); i++) {
+      needed += CTF::estimateBlockSize(CTF::get(scratch[i].data())->getBlock(mJobs[i].slot).getNStored());
+    }
+    if (needed >= ec->getFreeSize()) {
+      CTF::expand(mBuffer, ec->size() + needed - ec->getFreeSize() + sizeof(uint64_t));
+    }
+    for (size_t i = 0; i < mJobs.size(); i++) {
+      CTF::get(mBuffer.data())->copySlot(*CTF::get(scratch[i].data()), mJobs[i].slot, &mBuffer);
+      mIOSize += ioSizes[i];
+    }
+    mJobs.clear();
+  }
+  return mIOSize;
+}
+
 ///________________________________
 template <typename T>
 bool CTFCoderBase::readFromTree(TTree& tree, const std::string brname, T& dest, int ev)
@@ -235,6 +439,41 @@ void CTFCoderBase::createCodersFromFile(const std::string& dictPath, o2::ctf::CT
   createCoders(buff, op);
 }
 
+///________________________________
+template <typename CTF>
+bool CTFCoderBase::updateCodersFromFile(const std::string& dictPath)
+{
+  // the writer of the online dictionaries replaces the link to the latest version, a missing link is not an error
+  std::error_code ec;
+  auto target = std::filesystem::canonical(dictPath, ec);
+  if (ec) {
+    return false;
+  }
+  auto mtime = std::filesystem::last_write_time(target, ec);
+  if (ec || (target == mDictFileTarget && mtime == mDictFileTime)) {
+    return false;
+  }
+  auto prevHeader = mExtHeader;
+  auto prevCoders = mCoders;
+  try {
+    auto buff = readDictionaryFromFile<CTF>(target.native(), true);
+    if (buff.empty()) {
+      mExtHeader = prevHeader;
+      return false;
+    }
+    createCoders(buff, mOpType);
+  } catch (const std::exception& e) {
+    LOGP(alarm, "Failed to update {} CTF dictionary from {}: {}, keeping {}", mDet.getName(), target.native(), e.what(), prevHeader.asString());
+    mCoders.swap(prevCoders);
+    mExtHeader = prevHeader;
+    return false;
+  }
+  mDictFileTarget = target;
+  mDictFileTime = mtime;
+  LOGP(info, "Loaded {} from {}", mExtHeader.asString(), target.native());
+  return true;
+}
+
 ///________________________________
 template <typename CTF>
 std::vector<char> CTFCoderBase::loadDictionaryFromTree(TTree* tree)
@@ -304,6 +543,15 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (ic.options().hasOption("mem-factor")) {
     setMemMarginFactor(ic.options().get<float>("mem-factor"));
   }
+  if (ic.options().hasOption("ctf-encoder-threads")) {
+    setNThreads(ic.options().get<int>("ctf-encoder-threads"));
+  }
+  if (ic.options().hasOption("ctf-dict-update")) {
+    setDictUpdateInterval(ic.options().get<int>("ctf-dict-update"));
+  }
+  if (ic.options().hasOption("ctf-dict-sampling")) {
+    setDictSampling(ic.options().get<int>("ctf-dict-sampling"));
+  }
   if (ic.options().hasOption("irframe-margin-bwd")) {
     mIRFrameSelMarginBwd = ic.options().get<uint32_t>("irframe-margin-bwd");
   }
@@ -329,7 +577,12 @@ void CTFCoderBase::init(o2::framework::InitContext& ic)
   if (dict.empty() || dict == "ccdb") { // load from CCDB
     mLoadDictFromCCDB = true;
   } else {
-    if (dict != "none") { // none means per-CTF dictionary will created on the fly
+    if (dict != "none" && mDictUpdateInterval > 0) { // the file may appear or be replaced during the run
+      mDictUpdater = [this, dict]() { updateCodersFromFile<CTF>(dict); };
+      if (!updateCodersFromFile<CTF>(dict)) {
+        LOGP(info, "CTF dictionary {} is not available yet, internal per-TF CTF Dict will be created until it appears", dict);
+      }
+    } else if (dict != "none") { // none means per-CTF dictionary will created on the fly
       createCodersFromFile<CTF>(dict, mOpType);
       LOGP(info, "Loaded {} from {}", mExtHeader.asString(), dict);
     } else {
@@ -370,7 +623,7 @@ bool CTFCoderBase::finaliseCCDB(o2::framework::ConcreteDataMatcher& matcher, voi
       mExtHeader = static_cast<const CTFDictHeader&>(CTF::get(dict->data())->getHeader());
       LOGP(info, "Loaded {} from CCDB", mExtHeader.asString());
     }
-    mLoadDictFromCCDB = false; // we read the dictionary at most once!
+    mLoadDictFromCCDB = mDictUpdateInterval > 0; // unless the updates are requested, we read the dictionary at most once!
   } else if ((match = (matcher == o2::framework::ConcreteDataMatcher("CTP", "Trig_Offset", 0)))) {
     const auto& trigOffsParam = o2::ctp::TriggerOffsetsParam::Instance();
     auto bcshift = trigOffsParam.customOffset[mDet.getID()];
@@ -35,6 +35,7 @@
 #include <type_traits>
 #include <unistd.h>
 #include <cassert>
+#include <cstring>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -272,6 +273,32 @@ T decodeTMessage(fair::mq::Parts& dataparts, int index)
   return static_cast<T>(decodeTMessageCore(dataparts, index));
 }
 
+// a trait to determine if hits can be sent as a flat array of bytes instead of serializing them with TMessage:
+// this is the case for vectors of trivially copyable hits
+template <typename Container>
+struct UseFlatTransport {
+  static constexpr bool value = std::is_trivially_copyable<typename Container::value_type>::value;
+};
+
+void attachFlatMessageCore(void const* data, size_t size, fair::mq::Channel& channel, fair::mq::Parts& parts);
+void const* getFlatMessageCore(fair::mq::Parts& dataparts, int index, size_t& size);
+
+template <typename Container>
+void attachFlatMessage(Container const& hits, fair::mq::Channel& channel, fair::mq::Parts& parts)
+{
+  attachFlatMessageCore(hits.data(), hits.size() * sizeof(typename Container::value_type), channel, parts);
+}
+
+template <typename T>
+T decodeFlatMessage(fair::mq::Parts& dataparts, int index)
+{
+  using Container = typename std::remove_pointer<T>::type;
+  using Hit_t = typename Container::value_type;
+  size_t size = 0;
+  auto data = static_cast<Hit_t const*>(getFlatMessageCore(dataparts, index, size));
+  return new Container(data, data + size / sizeof(Hit_t));
+}
+
 void attachDetIDHeaderMessage(int id, fair::mq::Channel& channel, fair::mq::Parts& parts);
 
 template <typename T>
@@ -339,7 +366,11 @@ class DetImpl : public o2::base::Detector
 
     while (auto hits = static_cast<Det*>(this)->Det::getHits(probe++)) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-        attachTMessage(*hits, channel, parts);
+        if constexpr (UseFlatTransport<std::remove_pointer_t<decltype(hits)>>::value) {
+          attachFlatMessage(*hits, channel, parts);
+        } else {
+          attachTMessage(*hits, channel, parts);
+        }
       } else {
         // this is the shared mem variant
         // we will just send the sharedmem ID and the offset inside
@@ -537,7 +568,7 @@ class DetImpl : public o2::base::Detector
     using HitPtr_t = decltype(static_cast<Det*>(this)->Det::getHits(probe));
     std::string name = static_cast<Det*>(this)->getHitBranchNames(probe);
 
-    auto copyToBuffer = [this, eventID](HitPtr_t hitdata, Collector_t& collectbuffer, int probe) {
+    auto copyToBuffer = [this, eventID](HitPtr_t hitdata, Collector_t& collectbuffer, int probe, bool owned = false) {
       std::vector<std::vector<std::unique_ptr<Hit_t>>>* hitvector = nullptr;
       {
         auto eventIter = collectbuffer.find(eventID);
@@ -551,6 +582,11 @@ class DetImpl : public o2::base::Detector
       if (probe >= hitvector->size()) {
         hitvector->resize(probe + 1);
       }
+      if (owned) {
+        // the decoded hits become the bucket
+        (*hitvector)[probe].emplace_back(hitdata);
+        return;
+      }
       // add empty hit bucket to list for this event and probe
       (*hitvector)[probe].emplace_back(new Hit_t());
       // copy the data into this bucket
@@ -559,12 +595,17 @@ class DetImpl : public o2::base::Detector
 
     while (name.size() > 0) {
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
-        // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<HitPtr_t>(parts, index++);
-        if (hitsptr) {
-          // ... and copy them to the buffer
-          copyToBuffer(hitsptr, hitcollector, probe);
-          delete hitsptr;
+        if constexpr (UseFlatTransport<Hit_t>::value) {
+          // flat hits are decoded with a single copy, directly into the buffer
+          copyToBuffer(decodeFlatMessage<HitPtr_t>(parts, index++), hitcollector, probe, true);
+        } else {
+          // for each branch name we extract/decode hits from the message parts ...
+          auto hitsptr = decodeTMessage<HitPtr_t>(parts, index++);
+          if (hitsptr) {
+            // ... and copy them to the buffer
+            copyToBuffer(hitsptr, hitcollector, probe);
+            delete hitsptr;
+          }
         }
       } else {
         // for each branch name we extract/decode hits from the message parts ...
@@ -593,7 +634,12 @@ class DetImpl : public o2::base::Detector
       if (!UseShm<Det>::value || !o2::utils::ShmManager::Instance().isOperational()) {
 
         // for each branch name we extract/decode hits from the message parts ...
-        auto hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        Hit_t hitsptr = nullptr;
+        if constexpr (UseFlatTransport<std::remove_pointer_t<Hit_t>>::value) {
+          hitsptr = decodeFlatMessage<Hit_t>(parts, index++);
+        } else {
+          hitsptr = decodeTMessage<Hit_t>(parts, index++);
+        }
         if (hitsptr) {
           // ... and fill the tree branch
           auto br = getOrMakeBranch(tr, name.c_str(), hitsptr);
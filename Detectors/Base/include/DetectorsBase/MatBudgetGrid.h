@@ -0,0 +1,204 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatBudgetGrid.h
+/// \brief Declarations for the regular r-phi-z grid of radially integrated material budget
+
+#ifndef ALICEO2_MATBUDGETGRID_H
+#define ALICEO2_MATBUDGETGRID_H
+
+#include "GPUCommonDef.h"
+#include "GPUCommonRtypes.h"
+#include "GPUCommonMath.h"
+#include "FlatObject.h"
+#include "DetectorsBase/MatCell.h"
+
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+#include <cmath>
+#include <string>
+#endif // !GPUCA_ALIGPUCODE
+
+/**********************************************************************
+ *                                                                    *
+ * Alternative representation of the MatLayerCylSet material LUT:     *
+ * regular grid of mNRBins x mNPhiBins x mNZBins cells, storing for   *
+ * every (phi,z) column the material integrated along the radial      *
+ * straight segment from mRMin to every r bin boundary.               *
+ * The budget of the segment monotonic in r is the difference of two  *
+ * interpolated radial integrals, rescaled to the segment length.     *
+ * The lookup cost does not depend on the number of crossed layers,   *
+ * the radial integrals of the column are contiguous in memory (4     *
+ * float texels, can be bound to a 3D texture with r as the fastest   *
+ * coordinate on the GPU).                                            *
+ *                                                                    *
+ **********************************************************************/
+namespace o2
+{
+namespace base
+{
+
+class MatLayerCylSet;
+
+class MatBudgetGrid : public o2::gpu::FlatObject
+{
+
+ public:
+  ///< material integrated along the radial segment from mRMin
+  struct Integral {
+    float xRho = 0.f;        ///< integral of density, g/cm^2
+    float x2X0 = 0.f;        ///< integral of the inverse radiation length
+    float lengthInMat = 0.f; ///< length inside the material layers of the source LUT, to define the mean density as in MatLayerCylSet
+    float reserved = 0.f;    ///< padding to 16 bytes texel
+
+    ClassDefNV(Integral, 1);
+  };
+
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+  ///< summary of the comparison with the source MatLayerCylSet on random segments
+  struct Comparison {
+    int nTests = 0;
+    double sumRefX2X0 = 0., sumDiffX2X0 = 0., sumDiff2X2X0 = 0., maxAbsDiffX2X0 = 0.;
+    double sumRefXRho = 0., sumDiffXRho = 0., sumDiff2XRho = 0., maxAbsDiffXRho = 0.;
+    float getBiasX2X0() const { return sumRefX2X0 > 0. ? sumDiffX2X0 / sumRefX2X0 : 0.; }
+    float getRMSX2X0() const { return sumRefX2X0 > 0. ? std::sqrt(sumDiff2X2X0 * nTests) / sumRefX2X0 : 0.; }
+    float getBiasXRho() const { return sumRefXRho > 0. ? sumDiffXRho / sumRefXRho : 0.; }
+    float getRMSXRho() const { return sumRefXRho > 0. ? std::sqrt(sumDiff2XRho * nTests) / sumRefXRho : 0.; }
+    void print() const;
+  };
+#endif // !GPUCA_ALIGPUCODE
+
+  MatBudgetGrid() CON_DEFAULT;
+  ~MatBudgetGrid() CON_DEFAULT;
+  MatBudgetGrid(const MatBudgetGrid& src) CON_DELETE;
+
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+  void build(const MatLayerCylSet& lut, float dr, int nphi, float dz, int nSamplesPhiZ = 3);
+  Comparison compare(const MatLayerCylSet& lut, int nTests = 100000, float maxLength = 2.f, int seed = 1) const;
+  void print(bool data = false) const;
+
+  void writeToFile(const std::string& outFName = "matbudGrid.root");
+  static MatBudgetGrid* loadFromFile(const std::string& inpFName = "matbudGrid.root");
+  static MatBudgetGrid* rectifyPtrFromFile(MatBudgetGrid* ptr);
+#endif // !GPUCA_ALIGPUCODE
+
+  GPUd() MatBudget getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const;
+
+  GPUd() float getRMin() const { return mRMin; }
+  GPUd() float getRMax() const { return mRMin + mNRBins * mDR; }
+  GPUd() float getZMax() const { return mZMax; }
+  GPUd() float getDR() const { return mDR; }
+  GPUd() float getDZ() const { return mDZ; }
+  GPUd() int getNRBins() const { return mNRBins; }
+  GPUd() int getNPhiBins() const { return mNPhiBins; }
+  GPUd() int getNZBins() const { return mNZBins; }
+
+  // radial integrals column of given phi and z bins, with getNRBins()+1 entries
+  GPUd() const Integral* getColumn(int iphi, int iz) const { return reinterpret_cast<const Integral*>(mFlatBufferPtr) + (iphi * mNZBins + iz) * (mNRBins + 1); }
+
+#ifndef GPUCA_GPUCODE
+  std::size_t estimateFlatBufferSize() const { return estimateFlatBufferSize(mNRBins, mNPhiBins, mNZBins); }
+  static std::size_t estimateFlatBufferSize(int nr, int nphi, int nz) { return std::size_t(nr + 1) * nphi * nz * sizeof(Integral); }
+  void fixPointers(char* newPtr = nullptr);
+  void cloneFromObject(const MatBudgetGrid& obj, char* newFlatBufferPtr);
+  using o2::gpu::FlatObject::adoptInternalBuffer;
+  using o2::gpu::FlatObject::moveBufferTo;
+  using o2::gpu::FlatObject::releaseInternalBuffer;
+  using o2::gpu::FlatObject::setActualBufferAddress;
+  using o2::gpu::FlatObject::setFutureBufferAddress;
+
+  /// Gives minimal alignment in bytes required for the class object
+  static constexpr size_t getClassAlignmentBytes() { return 8; }
+  /// Gives minimal alignment in bytes required for the flat buffer
+  static constexpr size_t getBufferAlignmentBytes() { return 16; }
+#endif // !GPUCA_GPUCODE
+
+  static constexpr int MaxSubSteps = 64; ///< max number of sub-steps in which a segment is split to follow the phi and z bins
+
+ protected:
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+  Integral* getColumnToFill(int iphi, int iz) { return reinterpret_cast<Integral*>(mFlatBufferPtr) + (iphi * mNZBins + iz) * (mNRBins + 1); }
+#endif // !GPUCA_ALIGPUCODE
+
+  GPUd() void getIntegral(const Integral* column, float r, float& xRho, float& x2X0, float& lengthInMat) const;
+  GPUd() void accountStep(float r0, float r1, float phi, float z, float length, MatBudget& rval, float& lengthInMat) const;
+
+  float mRMin = 0.f;    ///< min radius
+  float mDR = 1.f;      ///< radial bin size
+  float mDRInv = 1.f;   ///< inverse radial bin size
+  float mDPhiInv = 1.f; ///< inverse phi bin size, phi in 0:2pi convention
+  float mZMax = 0.f;    ///< max |z|
+  float mDZ = 1.f;      ///< z bin size
+  float mDZInv = 1.f;   ///< inverse z bin size
+  int mNRBins = 0;      ///< number of radial bins
+  int mNPhiBins = 0;    ///< number of phi bins
+  int mNZBins = 0;      ///< number of z bins
+
+  ClassDefNV(MatBudgetGrid, 1);
+};
+
+//_________________________________________________________________________________________________
+GPUdi() void MatBudgetGrid::getIntegral(const Integral* column, float r, float& xRho, float& x2X0, float& lengthInMat) const
+{
+  // linear interpolation of the radial integrals of the column at radius r
+  float u = (r - mRMin) * mDRInv;
+  if (u <= 0.f) {
+    xRho = x2X0 = lengthInMat = 0.f;
+    return;
+  }
+  if (u >= mNRBins) {
+    const auto& c = column[mNRBins];
+    xRho = c.xRho;
+    x2X0 = c.x2X0;
+    lengthInMat = c.lengthInMat;
+    return;
+  }
+  int ir = int(u);
+  float f = u - ir;
+  const auto &c0 = column[ir], &c1 = column[ir + 1];
+  xRho = c0.xRho + f * (c1.xRho - c0.xRho);
+  x2X0 = c0.x2X0 + f * (c1.x2X0 - c0.x2X0);
+  lengthInMat = c0.lengthInMat + f * (c1.lengthInMat - c0.lengthInMat);
+}
+
+//_________________________________________________________________________________________________
+GPUdi() void MatBudgetGrid::accountStep(float r0, float r1, float phi, float z, float length, MatBudget& rval, float& lengthInMat) const
+{
+  // account material of the step of given length monotonic in r, assuming that it stays in the (phi,z) column
+  if (z <= -mZMax || z >= mZMax) {
+    return;
+  }
+  int iz = int((z + mZMax) * mDZInv), iphi = int(phi * mDPhiInv);
+  const auto* column = getColumn(iphi < mNPhiBins ? iphi : mNPhiBins - 1, iz < mNZBins ? iz : mNZBins - 1);
+  float dr = r1 - r0;
+  if (o2::gpu::CAMath::Abs(dr) < 1e-3f * mDR) { // tangent to the cylinder, use local density
+    int ir = int((0.5f * (r0 + r1) - mRMin) * mDRInv);
+    if (ir < 0 || ir >= mNRBins) {
+      return;
+    }
+    float scale = length * mDRInv;
+    rval.meanRho += (column[ir + 1].xRho - column[ir].xRho) * scale;
+    rval.meanX2X0 += (column[ir + 1].x2X0 - column[ir].x2X0) * scale;
+    lengthInMat += (column[ir + 1].lengthInMat - column[ir].lengthInMat) * scale;
+    return;
+  }
+  float xRho0, x2X00, len0, xRho1, x2X01, len1;
+  getIntegral(column, r0, xRho0, x2X00, len0);
+  getIntegral(column, r1, xRho1, x2X01, len1);
+  float scale = length / dr; // radial to real path length
+  rval.meanRho += (xRho1 - xRho0) * scale;
+  rval.meanX2X0 += (x2X01 - x2X00) * scale;
+  lengthInMat += (len1 - len0) * scale;
+}
+
+} // namespace base
+} // namespace o2
+
+#endif
@@ -0,0 +1,355 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PropagatorBatch.h
+/// \brief Propagation of a block of tracks in lockstep, with track parameters and covariances in SoA layout
+
+#ifndef ALICEO2_BASE_PROPAGATORBATCH_H
+#define ALICEO2_BASE_PROPAGATORBATCH_H
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include "CommonConstants/MathConstants.h"
+#include "MathUtils/Utils.h"
+#include "MathUtils/Cartesian.h"
+#include "DetectorsBase/Propagator.h"
+
+namespace o2
+{
+namespace base
+{
+
+///__________________________________________________________________________________
+///< Propagator of up to W tracks per call, giving the same result as PropagatorImpl::propagateToX (constant field bZ) for
+///< every track. The tracks are copied to SoA lanes and stepped in lockstep: at every step the helix transport of the
+///< parameters and of the covariance matrix is done for all lanes in branch-free loops (lanes which are already at their
+///< destination or have failed make a null step, only the Z of the lanes moving along a large arc is treated separately),
+///< then the material correction is applied per lane.
+///< The field is evaluated once per call instead of once per step and track. The TOF integration is not supported.
+template <int W = 8, typename value_T = float>
+class PropagatorBatch
+{
+ public:
+  using value_type = value_T;
+  using Propagator_t = PropagatorImpl<value_type>;
+  using TrackParCov_t = typename Propagator_t::TrackParCov_t;
+  using MatCorrType = typename Propagator_t::MatCorrType;
+
+  enum LaneStatus : int { Idle,      // lane not used in the last call
+                          Active,    // propagation is in progress
+                          Done,      // track was propagated to the requested X
+                          Failed };  // propagation or material correction failed, track is left at the last valid step
+
+  static constexpr int getBatchSize() { return W; }
+
+  PropagatorBatch(const Propagator_t* prop = nullptr) : mPropagator(prop) {}
+
+  ///< propagate n <= W tracks to the planes X = xToGo[l] in the field bZ, return the number of successfully propagated tracks
+  int propagateToX(TrackParCov_t* const* tracks, const value_type* xToGo, int n, value_type bZ, value_type maxSnp = Propagator_t::MAX_SIN_PHI,
+                   value_type maxStep = Propagator_t::MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT, int signCorr = 0);
+
+  ///< propagate n <= W tracks to the common plane X = xToGo
+  int propagateToX(TrackParCov_t* const* tracks, value_type xToGo, int n, value_type bZ, value_type maxSnp = Propagator_t::MAX_SIN_PHI,
+                   value_type maxStep = Propagator_t::MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT, int signCorr = 0)
+  {
+    std::array<value_type, W> xArr;
+    xArr.fill(xToGo);
+    return propagateToX(tracks, xArr.data(), n, bZ, maxSnp, maxStep, matCorr, signCorr);
+  }
+
+  ///< propagate nTracks contiguous tracks to the plane X = xToGo in blocks of W, the status of every track is stored in ok (if provided)
+  int propagateAllToX(TrackParCov_t* tracks, int nTracks, value_type xToGo, value_type bZ, value_type maxSnp = Propagator_t::MAX_SIN_PHI,
+                      value_type maxStep = Propagator_t::MAX_STEP, MatCorrType matCorr = MatCorrType::USEMatCorrLUT, int signCorr = 0, bool* ok = nullptr);
+
+  ///< status of the lane in the last call
+  int getStatus(int lane) const { return mStatus[lane]; }
+  bool isOK(int lane) const { return mStatus[lane] == Done; }
+
+  void setPropagator(const Propagator_t* prop) { mPropagator = prop; }
+  const Propagator_t* getPropagator() const { return mPropagator; }
+
+ private:
+  static constexpr value_type Epsilon = 0.00001; // precision of propagation to X, as in the PropagatorImpl
+
+  void load(TrackParCov_t* const* tracks, const value_type* xToGo, int n, value_type bZ, int signCorr);
+  void storeLane(int lane, TrackParCov_t& trc) const;
+  void loadLane(int lane, const TrackParCov_t& trc);
+  void transport();
+  bool correctForMaterial(int lane, MatCorrType matCorr);
+
+  const Propagator_t* mPropagator = nullptr;             // provider of the material budget
+  TrackParCov_t* const* mTracks = nullptr;               // tracks of the current call
+  std::array<int, W> mStatus{};                          // lanes status
+  std::array<int, W> mSignCorr{};                        // sign of the e.loss correction
+  std::array<value_type, W> mX{};                        // current X
+  std::array<value_type, W> mXToGo{};                    // destination X
+  std::array<value_type, W> mStep{};                     // step of the current iteration, 0 for the lanes not moving
+  std::array<value_type, W> mBz{};                       // field
+  std::array<value_type, W> mCharged{};                  // 1 for charged tracks, 0 for neutral ones
+  std::array<value_type, W> mCosAlp{}, mSinAlp{};        // rotation of the tracking frame
+  std::array<std::array<value_type, W>, 3> mXYZ0{};      // global position at the beginning of the step
+  std::array<std::array<value_type, W>, 5> mPar{};       // track parameters
+  std::array<std::array<value_type, W>, 15> mCov{};      // covariance matrix, as in the TrackParametrizationWithError
+};
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+int PropagatorBatch<W, value_T>::propagateToX(TrackParCov_t* const* tracks, const value_type* xToGo, int n, value_type bZ, value_type maxSnp,
+                                              value_type maxStep, MatCorrType matCorr, int signCorr)
+{
+  if (n > W) {
+    throw std::runtime_error("number of tracks exceeds the batch size");
+  }
+  if (matCorr != MatCorrType::USEMatCorrNONE && !mPropagator) {
+    throw std::runtime_error("material correction is requested but the propagator is not set");
+  }
+  load(tracks, xToGo, n, bZ, signCorr);
+  while (true) {
+    int nMoving = 0;
+    for (int l = 0; l < W; l++) {
+      value_type dx = mXToGo[l] - mX[l], step = 0;
+      if (mStatus[l] == Active) {
+        if (std::abs(dx) > Epsilon) {
+          step = std::abs(dx) < maxStep ? dx : (dx > 0 ? maxStep : -maxStep);
+          nMoving++;
+        } else {
+          mX[l] = mXToGo[l];
+          mStatus[l] = Done;
+        }
+      }
+      mStep[l] = step;
+    }
+    if (!nMoving) {
+      break;
+    }
+    if (matCorr != MatCorrType::USEMatCorrNONE) {
+      for (int l = 0; l < W; l++) {
+        mXYZ0[0][l] = mCosAlp[l] * mX[l] - mSinAlp[l] * mPar[o2::track::kY][l];
+        mXYZ0[1][l] = mSinAlp[l] * mX[l] + mCosAlp[l] * mPar[o2::track::kY][l];
+        mXYZ0[2][l] = mPar[o2::track::kZ][l];
+      }
+    }
+    transport();
+    for (int l = 0; l < W; l++) {
+      if (mStatus[l] != Active || mStep[l] == 0) {
+        continue;
+      }
+      if (maxSnp > 0 && std::abs(mPar[o2::track::kSnp][l]) >= maxSnp) {
+        if (matCorr != MatCorrType::USEMatCorrNONE) {
+          correctForMaterial(l, matCorr);
+        }
+        mStatus[l] = Failed;
+        continue;
+      }
+      if (matCorr != MatCorrType::USEMatCorrNONE && !correctForMaterial(l, matCorr)) {
+        mStatus[l] = Failed;
+      }
+    }
+  }
+  int nOK = 0;
+  for (int l = 0; l < n; l++) {
+    storeLane(l, *tracks[l]);
+    nOK += mStatus[l] == Done;
+  }
+  return nOK;
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+int PropagatorBatch<W, value_T>::propagateAllToX(TrackParCov_t* tracks, int nTracks, value_type xToGo, value_type bZ, value_type maxSnp,
+                                                 value_type maxStep, MatCorrType matCorr, int signCorr, bool* ok)
+{
+  std::array<TrackParCov_t*, W> ptr;
+  int nOK = 0;
+  for (int i0 = 0; i0 < nTracks; i0 += W) {
+    int n = nTracks - i0 < W ? nTracks - i0 : W;
+    for (int l = 0; l < n; l++) {
+      ptr[l] = &tracks[i0 + l];
+    }
+    nOK += propagateToX(ptr.data(), xToGo, n, bZ, maxSnp, maxStep, matCorr, signCorr);
+    if (ok) {
+      for (int l = 0; l < n; l++) {
+        ok[i0 + l] = isOK(l);
+      }
+    }
+  }
+  return nOK;
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+void PropagatorBatch<W, value_T>::load(TrackParCov_t* const* tracks, const value_type* xToGo, int n, value_type bZ, int signCorr)
+{
+  mTracks = tracks;
+  for (int l = 0; l < W; l++) {
+    if (l < n) {
+      const auto& trc = *tracks[l];
+      loadLane(l, trc);
+      mXToGo[l] = xToGo[l];
+      mBz[l] = bZ;
+      mCharged[l] = trc.getAbsCharge() ? 1 : 0;
+      float sn, cs;
+      o2::math_utils::sincos(float(trc.getAlpha()), sn, cs);
+      mSinAlp[l] = sn;
+      mCosAlp[l] = cs;
+      mSignCorr[l] = signCorr ? signCorr : (xToGo[l] > trc.getX() ? -1 : 1); // sign of eloss correction is not imposed
+      mStatus[l] = Active;
+    } else { // unused lanes make null steps with valid parameters
+      mX[l] = mXToGo[l] = mBz[l] = mCharged[l] = mSinAlp[l] = mCosAlp[l] = 0;
+      for (int i = 0; i < o2::track::kNParams; i++) {
+        mPar[i][l] = 0;
+      }
+      for (int i = 0; i < o2::track::kCovMatSize; i++) {
+        mCov[i][l] = 0;
+      }
+      mStatus[l] = Idle;
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+void PropagatorBatch<W, value_T>::loadLane(int lane, const TrackParCov_t& trc)
+{
+  mX[lane] = trc.getX();
+  for (int i = 0; i < o2::track::kNParams; i++) {
+    mPar[i][lane] = trc.getParam(i);
+  }
+  const auto& cov = trc.getCov();
+  for (int i = 0; i < o2::track::kCovMatSize; i++) {
+    mCov[i][lane] = cov[i];
+  }
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+void PropagatorBatch<W, value_T>::storeLane(int lane, TrackParCov_t& trc) const
+{
+  trc.setX(mX[lane]);
+  for (int i = 0; i < o2::track::kNParams; i++) {
+    trc.setParam(mPar[i][lane], i);
+  }
+  for (int i = 0; i < o2::track::kCovMatSize; i++) {
+    trc.setCov(mCov[i][lane], i);
+  }
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+bool PropagatorBatch<W, value_T>::correctForMaterial(int lane, MatCorrType matCorr)
+{
+  // material correction of the last step of the lane, done with the track of the lane, since it needs its PID
+  math_utils::Point3D<value_type> xyz0(mXYZ0[0][lane], mXYZ0[1][lane], mXYZ0[2][lane]);
+  math_utils::Point3D<value_type> xyz1(mCosAlp[lane] * mX[lane] - mSinAlp[lane] * mPar[o2::track::kY][lane],
+                                       mSinAlp[lane] * mX[lane] + mCosAlp[lane] * mPar[o2::track::kY][lane], mPar[o2::track::kZ][lane]);
+  auto mb = mPropagator->getMatBudget(matCorr, xyz0, xyz1);
+  auto& trc = *mTracks[lane];
+  storeLane(lane, trc);
+  bool res = trc.correctForMaterial(mb.meanX2X0, mb.getXRho(mSignCorr[lane]));
+  loadLane(lane, trc);
+  return res;
+}
+
+///_________________________________________________________________________
+template <int W, typename value_T>
+void PropagatorBatch<W, value_T>::transport()
+{
+  // helix transport of all lanes by their steps in the constant field, equivalent to TrackParametrizationWithError::propagateTo.
+  // The lanes for which the transport is not possible do not move and are flagged as failed.
+  using namespace o2::track;
+  constexpr value_type B2C = o2::constants::math::B2C, Almost1 = o2::constants::math::Almost1;
+  std::array<value_type, W> dxA, dZArc;
+  std::array<int, W> arc;
+  // feasibility of the steps, the lanes which cannot move make a null step
+  for (int l = 0; l < W; l++) {
+    value_type dx = mStep[l], x2r = mPar[kQ2Pt][l] * mBz[l] * B2C * mCharged[l] * dx, f1 = mPar[kSnp][l], f2 = f1 + x2r;
+    bool inRange = std::abs(f1) <= Almost1 && std::abs(f2) <= Almost1, isArc = std::abs(x2r) > 0.05f;
+    value_type r1 = std::sqrt(inRange ? (1.f - f1) * (1.f + f1) : 1.f), r2 = std::sqrt(inRange ? (1.f - f2) * (1.f + f2) : 1.f);
+    bool ok = inRange && (!isArc || std::abs(r1 * f2 - r2 * f1) <= Almost1);
+    dxA[l] = ok ? dx : 0;
+    arc[l] = ok && isArc;
+    mStatus[l] = (ok || mStatus[l] != Active) ? mStatus[l] : Failed;
+  }
+  // for large dx/R the linear approximation of the arc by the segment is not precise enough for the Z propagation
+  for (int l = 0; l < W; l++) {
+    if (arc[l]) {
+      value_type crv = mPar[kQ2Pt][l] * mBz[l] * B2C * mCharged[l], f1 = mPar[kSnp][l], f2 = f1 + crv * dxA[l];
+      value_type r1 = std::sqrt((1.f - f1) * (1.f + f1)), r2 = std::sqrt((1.f - f2) * (1.f + f2));
+      value_type rot = std::asin(r1 * f2 - r2 * f1);
+      if (f1 * f1 + f2 * f2 > 1.f && f1 * f2 < 0.f) { // special cases of large rotations or large abs angles
+        rot = f2 > 0.f ? value_type(o2::constants::math::PI) - rot : -value_type(o2::constants::math::PI) - rot;
+      }
+      dZArc[l] = mPar[kTgl][l] / crv * rot;
+    }
+  }
+  for (int l = 0; l < W; l++) {
+    value_type dx = dxA[l], x2r = mPar[kQ2Pt][l] * mBz[l] * B2C * mCharged[l] * dx;
+    value_type f1 = mPar[kSnp][l], f2 = f1 + x2r, tgl = mPar[kTgl][l];
+    value_type r1 = std::sqrt((1.f - f1) * (1.f + f1)), r2 = std::sqrt((1.f - f2) * (1.f + f2));
+    double dy2dx = (f1 + f2) / (r1 + r2);
+    value_type dZ = arc[l] ? dZArc[l] : value_type(dx * (r2 + f2 * dy2dx) * tgl);
+    mX[l] += dx;
+    mPar[kY][l] += value_type(dx * dy2dx);
+    mPar[kZ][l] += dZ;
+    mPar[kSnp][l] = f2 > Almost1 ? Almost1 : (f2 < -Almost1 ? -Almost1 : f2);
+
+    auto &c00 = mCov[kSigY2][l], &c10 = mCov[kSigZY][l], &c11 = mCov[kSigZ2][l], &c20 = mCov[kSigSnpY][l], &c21 = mCov[kSigSnpZ][l],
+         &c22 = mCov[kSigSnp2][l], &c30 = mCov[kSigTglY][l], &c31 = mCov[kSigTglZ][l], &c32 = mCov[kSigTglSnp][l], &c33 = mCov[kSigTgl2][l],
+         &c40 = mCov[kSigQ2PtY][l], &c41 = mCov[kSigQ2PtZ][l], &c42 = mCov[kSigQ2PtSnp][l], &c43 = mCov[kSigQ2PtTgl][l], &c44 = mCov[kSigQ2Pt2][l];
+
+    // evaluate matrix in double prec.
+    double rinv = 1. / r1;
+    double r3inv = rinv * rinv * rinv;
+    double f24 = dx * mBz[l] * B2C; // x2r/mP[kQ2Pt];
+    double f02 = dx * r3inv;
+    double f04 = 0.5 * f24 * f02;
+    double f12 = f02 * tgl * f1;
+    double f14 = 0.5 * f24 * f12;
+    double f13 = dx * rinv;
+
+    // b = C*ft
+    double b00 = f02 * c20 + f04 * c40, b01 = f12 * c20 + f14 * c40 + f13 * c30;
+    double b02 = f24 * c40;
+    double b10 = f02 * c21 + f04 * c41, b11 = f12 * c21 + f14 * c41 + f13 * c31;
+    double b12 = f24 * c41;
+    double b20 = f02 * c22 + f04 * c42, b21 = f12 * c22 + f14 * c42 + f13 * c32;
+    double b22 = f24 * c42;
+    double b40 = f02 * c42 + f04 * c44, b41 = f12 * c42 + f14 * c44 + f13 * c43;
+    double b42 = f24 * c44;
+    double b30 = f02 * c32 + f04 * c43, b31 = f12 * c32 + f14 * c43 + f13 * c33;
+    double b32 = f24 * c43;
+
+    // a = f*b = f*C*ft
+    double a00 = f02 * b20 + f04 * b40, a01 = f02 * b21 + f04 * b41, a02 = f02 * b22 + f04 * b42;
+    double a11 = f12 * b21 + f14 * b41 + f13 * b31, a12 = f12 * b22 + f14 * b42 + f13 * b32;
+    double a22 = f24 * b42;
+
+    // F*C*Ft = C + (b + bt + a)
+    c00 += b00 + b00 + a00;
+    c10 += b10 + b01 + a01;
+    c20 += b20 + b02 + a02;
+    c30 += b30;
+    c40 += b40;
+    c11 += b11 + b11 + a11;
+    c21 += b21 + b12 + a12;
+    c31 += b31;
+    c41 += b41;
+    c22 += b22 + b22 + a22;
+    c32 += b32;
+    c42 += b42;
+  }
+}
+
+} // namespace base
+} // namespace o2
+
+#endif
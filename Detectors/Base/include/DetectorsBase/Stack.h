@@ -166,6 +166,13 @@ class Stack : public FairGenericStack
   /// Modifiers
   void StoreSecondaries(Bool_t choice = kTRUE) { mStoreSecondaries = choice; }
   void pruneKinematics(bool choice = true) { mPruneKinematics = choice; }
+  /// Remove the particles which cannot be selected for the output anymore already during the transport of a primary.
+  /// The particle buffer is compacted when at least threshold (and half of the) particles are removable.
+  void compactKinematics(bool choice = true, int threshold = 10000)
+  {
+    mCompactKinematics = choice;
+    mCompactThreshold = threshold;
+  }
   void setMinHits(Int_t min) { mMinHits = min; }
   void SetEnergyCut(Double_t eMin) { mEnergyCut = eMin; }
   void StoreMothers(Bool_t choice = kTRUE) { mStoreMothers = choice; }
@@ -304,6 +311,32 @@ class Stack : public FairGenericStack
   /// a pointer to the current MCEventStats object
   o2::dataformats::MCEventStats* mMCEventStats = nullptr; //!
 
+  /// transport status of the particles in mParticles, used for the compaction during transport
+  struct TransportStatus {
+    int trackID = -1;   // track number of the particle
+    int nDaughters = 0; // number of daughters which were not removed
+    bool done = false;  // transport of the particle is finished
+    bool removed = false;
+  };
+  std::vector<TransportStatus> mTransportStatus; //! entries parallel to mParticles
+  bool mCompactKinematics = false;               // whether or not particles are removed during transport
+  Int_t mCompactThreshold = 10000;               // min. number of removable particles to compact mParticles
+  Int_t mLastTrackID = -1;                       //! track transported before the current one
+  Int_t mNRemovable = 0;                         //! removed particles still in mParticles
+  Int_t mNRemovedInPrimary = 0;                  //! particles removed for the current primary
+  // metrics of the compaction, per event
+  Int_t mNRemovedInEvent = 0;    //! particles removed during transport
+  Int_t mNCompactions = 0;       //! number of compactions of mParticles
+  size_t mMaxParticles = 0;      //! highest number of entries in mParticles
+  double mCompactionTimeMS = 0.; //! time spent in the compaction
+
+  /// mark the previously transported track as done when a new track is started
+  void trackStarted(int trackID);
+  /// remove the particle if it can not be stored anymore, and recursively its mothers
+  void removeIfUnselectable(int trackID);
+  /// remove the entries of the removed particles from mParticles
+  void compactParticles();
+
   /// Mark tracks for output using selection criteria
   /// returns true if all available tracks are selected
   /// returns false if some tracks are discarded
@@ -326,7 +359,7 @@ class Stack : public FairGenericStack
 
   void handleTransportPrimary(TParticle& p);
 
-  ClassDefOverride(Stack, 1);
+  ClassDefOverride(Stack, 2);
 };
 
 inline void Stack::addTrackReference(const o2::TrackReference& ref)
@@ -36,7 +36,7 @@ void CTFCoderBase::checkDictVersion(const CTFDictHeader& h) const
 // it needs ONLY when the external dictionary is not provided
 void CTFCoderBase::assignDictVersion(CTFDictHeader& h) const
 {
-  if (mExtHeader.isValidDictTimeStamp()) {
+  if (mExtHeader.isValidDictTimeStamp() && !mDictSampledTF) { // the sampled TFs are self-contained
     h = mExtHeader;
   }
   // detector code may exten it by
@@ -48,19 +48,25 @@ void CTFCoderBase::assignDictVersion(CTFDictHeader& h) const
 
 void CTFCoderBase::updateTimeDependentParams(ProcessingContext& pc, bool askTree)
 {
-  setFirstTFOrbit(pc.services().get<o2::framework::TimingInfo>().firstTForbit);
-  if (pc.services().get<o2::framework::TimingInfo>().globalRunNumberChanged) { // this params need to be queried only once
-    if (mOpType == OpType::Decoder) {
-      pc.inputs().get<o2::ctp::TriggerOffsetsParam*>(mTrigOffsBinding); // this is a configurable param
-    }
+  const auto& tinfo = pc.services().get<o2::framework::TimingInfo>();
+  setFirstTFOrbit(tinfo.firstTForbit);
+  if (tinfo.globalRunNumberChanged && mOpType == OpType::Decoder) {   // this params need to be queried only once
+    pc.inputs().get<o2::ctp::TriggerOffsetsParam*>(mTrigOffsBinding); // this is a configurable param
+  }
+  // the dictionary is queried once per run, unless its periodic updates are requested
+  if (tinfo.globalRunNumberChanged || (mDictUpdateInterval > 0 && (mNTFProcessed % mDictUpdateInterval) == 0)) {
     if (mLoadDictFromCCDB) {
       if (askTree) {
         pc.inputs().get<TTree*>(mDictBinding); // just to trigger the finaliseCCDB
       } else {
         pc.inputs().get<std::vector<char>*>(mDictBinding); // just to trigger the finaliseCCDB
       }
+    } else if (mDictUpdater) {
+      mDictUpdater();
     }
   }
+  mDictSampledTF = mOpType == OpType::Encoder && mDictSampling > 0 && mExtHeader.isValidDictTimeStamp() && (mNTFProcessed % mDictSampling) == 0;
+  mNTFProcessed++;
 }
 
 bool CTFCoderBase::isTreeDictionary(const void* buff) const
@@ -211,6 +211,21 @@ void attachMessageBufferToParts(fair::mq::Parts& parts, fair::mq::Channel& chann
   o2::framework::TMessageSerializer::serialize(buffer, data, cl);
   parts.AddPart(std::move(msg));
 }
+void attachFlatMessageCore(void const* data, size_t size, fair::mq::Channel& channel, fair::mq::Parts& parts)
+{
+  auto msg = channel.Transport()->CreateMessage(size, fair::mq::Alignment{64});
+  if (size) {
+    std::memcpy(msg->GetData(), data, size);
+  }
+  parts.AddPart(std::move(msg));
+}
+void const* getFlatMessageCore(fair::mq::Parts& dataparts, int index, size_t& size)
+{
+  // the message stays owned by the parts, the data has to be copied before they go away
+  auto& rawmessage = dataparts.At(index);
+  size = rawmessage->GetSize();
+  return rawmessage->GetData();
+}
 void attachDetIDHeaderMessage(int id, fair::mq::Channel& channel, fair::mq::Parts& parts)
 {
   std::unique_ptr<fair::mq::Message> message(channel.NewSimpleMessage(id));
@@ -33,6 +33,8 @@
 #pragma link C++ class o2::base::MatBudget + ;
 #pragma link C++ class o2::base::MatLayerCyl + ;
 #pragma link C++ class o2::base::MatLayerCylSet + ;
+#pragma link C++ class o2::base::MatBudgetGrid + ;
+#pragma link C++ class o2::base::MatBudgetGrid::Integral + ;
 #pragma link C++ class o2::base::Aligner + ;
 #pragma link C++ class o2::conf::ConfigurableParamHelper < o2::base::Aligner> + ;
 
@@ -0,0 +1,266 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatBudgetGrid.cxx
+/// \brief Implementation of the regular r-phi-z grid of radially integrated material budget
+
+#include "DetectorsBase/MatBudgetGrid.h"
+#include "CommonConstants/MathConstants.h"
+#include "MathUtils/Utils.h"
+
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "GPUCommonLogger.h"
+#include <TFile.h>
+#include <random>
+#include <vector>
+#endif // !GPUCA_ALIGPUCODE
+
+using namespace o2::base;
+
+#ifndef GPUCA_ALIGPUCODE // this part is unvisible on GPU version
+
+//________________________________________________________________________________
+void MatBudgetGrid::build(const MatLayerCylSet& lut, float dr, int nphi, float dz, int nSamplesPhiZ)
+{
+  ///< build the grid covering the lut, with radial bin dr, nphi phi bins and z bin ~dz.
+  ///< The radial integrals of every (phi,z) column are averaged over nSamplesPhiZ x nSamplesPhiZ radial rays
+  assert(lut.getNLayers() > 0 && dr > 0.f && nphi > 0 && dz > 0.f);
+  mRMin = lut.getRMin();
+  mDR = dr;
+  mDRInv = 1.f / dr;
+  mNRBins = std::ceil((lut.getRMax() - mRMin) * mDRInv);
+  mNPhiBins = nphi;
+  mDPhiInv = nphi / o2::constants::math::TwoPI;
+  mZMax = lut.getZMax();
+  mNZBins = std::max(1, int(std::ceil(2.f * mZMax / dz)));
+  mDZ = 2.f * mZMax / mNZBins;
+  mDZInv = 1.f / mDZ;
+  startConstruction();
+  finishConstruction(estimateFlatBufferSize());
+
+  int nSamples = std::max(1, nSamplesPhiZ);
+  double sampleWgh = 1. / (nSamples * nSamples);
+  std::vector<double> xRho(mNRBins), x2X0(mNRBins), lengthInMat(mNRBins);
+  for (int iphi = 0; iphi < mNPhiBins; iphi++) {
+    for (int iz = 0; iz < mNZBins; iz++) {
+      std::fill(xRho.begin(), xRho.end(), 0.);
+      std::fill(x2X0.begin(), x2X0.end(), 0.);
+      std::fill(lengthInMat.begin(), lengthInMat.end(), 0.);
+      for (int isPhi = 0; isPhi < nSamples; isPhi++) {
+        float phi = (iphi + (isPhi + 0.5f) / nSamples) / mDPhiInv;
+        for (int isZ = 0; isZ < nSamples; isZ++) {
+          float z = -mZMax + (iz + (isZ + 0.5f) / nSamples) * mDZ;
+          // along the radial ray the LUT material is constant within every layer
+          for (int il = 0; il < lut.getNLayers(); il++) {
+            const auto& lr = lut.getLayer(il);
+            float rLrMin = lr.getRMin(), rLrMax = lr.getRMax();
+            const auto& cell = lr.getCell(lr.getPhiSliceID(phi), z < lr.getZMin() ? 0 : lr.getZBinID(z));
+            int irMin = std::max(0, int((rLrMin - mRMin) * mDRInv)), irMax = std::min(mNRBins - 1, int((rLrMax - mRMin) * mDRInv));
+            for (int ir = irMin; ir <= irMax; ir++) {
+              float rBinMin = mRMin + ir * mDR, overlap = std::min(rLrMax, rBinMin + mDR) - std::max(rLrMin, rBinMin);
+              if (overlap > 0.f) {
+                xRho[ir] += cell.meanRho * overlap * sampleWgh;
+                x2X0[ir] += cell.meanX2X0 * overlap * sampleWgh;
+                lengthInMat[ir] += overlap * sampleWgh;
+              }
+            }
+          }
+        }
+      }
+      auto* column = getColumnToFill(iphi, iz);
+      double cumXRho = 0., cumX2X0 = 0., cumLength = 0.;
+      for (int ir = 0; ir < mNRBins; ir++) {
+        column[ir + 1].xRho = cumXRho += xRho[ir];
+        column[ir + 1].x2X0 = cumX2X0 += x2X0[ir];
+        column[ir + 1].lengthInMat = cumLength += lengthInMat[ir];
+      }
+    }
+  }
+}
+
+//________________________________________________________________________________
+MatBudgetGrid::Comparison MatBudgetGrid::compare(const MatLayerCylSet& lut, int nTests, float maxLength, int seed) const
+{
+  ///< compare with the lut the budget on nTests random segments of length < maxLength within the grid volume
+  Comparison cmp;
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> uni(0.f, 1.f);
+  float rMin = getRMin(), rMax = std::min(getRMax(), lut.getRMax());
+  while (cmp.nTests < nTests) {
+    float r = rMin + (rMax - rMin) * uni(gen), phi = o2::constants::math::TwoPI * uni(gen), z = mZMax * (2.f * uni(gen) - 1.f);
+    float phiD = o2::constants::math::TwoPI * uni(gen), cosTD = 2.f * uni(gen) - 1.f, sinTD = std::sqrt(1.f - cosTD * cosTD), len = maxLength * uni(gen);
+    float x0 = r * std::cos(phi), y0 = r * std::sin(phi);
+    float x1 = x0 + len * sinTD * std::cos(phiD), y1 = y0 + len * sinTD * std::sin(phiD), z1 = z + len * cosTD;
+    if (std::abs(z1) > mZMax) { // the LUT layers have no Z limits, test only the segments within the grid
+      continue;
+    }
+    auto ref = lut.getMatBudget(x0, y0, z, x1, y1, z1);
+    auto mb = getMatBudget(x0, y0, z, x1, y1, z1);
+    double dX2X0 = mb.meanX2X0 - ref.meanX2X0, dXRho = mb.getXRho() - ref.getXRho();
+    cmp.nTests++;
+    cmp.sumRefX2X0 += ref.meanX2X0;
+    cmp.sumDiffX2X0 += dX2X0;
+    cmp.sumDiff2X2X0 += dX2X0 * dX2X0;
+    cmp.maxAbsDiffX2X0 = std::max(cmp.maxAbsDiffX2X0, std::abs(dX2X0));
+    cmp.sumRefXRho += ref.getXRho();
+    cmp.sumDiffXRho += dXRho;
+    cmp.sumDiff2XRho += dXRho * dXRho;
+    cmp.maxAbsDiffXRho = std::max(cmp.maxAbsDiffXRho, std::abs(dXRho));
+  }
+  return cmp;
+}
+
+//________________________________________________________________________________
+void MatBudgetGrid::Comparison::print() const
+{
+  printf("%d tests: <x/X0>ref = %.3e, rel.bias: %+.3e rel.RMS: %.3e max|diff|: %.3e | <x*rho>ref = %.3e, rel.bias: %+.3e rel.RMS: %.3e max|diff|: %.3e\n",
+         nTests, nTests ? sumRefX2X0 / nTests : 0., getBiasX2X0(), getRMSX2X0(), maxAbsDiffX2X0,
+         nTests ? sumRefXRho / nTests : 0., getBiasXRho(), getRMSXRho(), maxAbsDiffXRho);
+}
+
+//________________________________________________________________________________
+void MatBudgetGrid::print(bool data) const
+{
+  ///< print grid parameters and optionally the integrals over the full radial span
+  if (!isConstructed()) {
+    printf("Not initialized yet\n");
+    return;
+  }
+  printf("%.2f < R < %.2f (%d bins of %.3f), %d phi bins, |Z| < %.2f (%d bins of %.3f), total size %.2f MB\n",
+         getRMin(), getRMax(), mNRBins, mDR, mNPhiBins, mZMax, mNZBins, mDZ, float(getFlatBufferSize()) / 1024 / 1024);
+  if (data) {
+    for (int iphi = 0; iphi < mNPhiBins; iphi++) {
+      for (int iz = 0; iz < mNZBins; iz++) {
+        const auto& c = getColumn(iphi, iz)[mNRBins];
+        printf("phi%3d z%3d : xRho = %.4e x2X0 = %.4e lengthInMat = %.3f\n", iphi, iz, c.xRho, c.x2X0, c.lengthInMat);
+      }
+    }
+  }
+}
+
+//________________________________________________________________________________
+void MatBudgetGrid::writeToFile(const std::string& outFName)
+{
+  /// store to file
+  TFile outf(outFName.data(), "recreate");
+  if (outf.IsZombie()) {
+    return;
+  }
+  outf.WriteObjectAny(this, Class(), "ccdb_object");
+  outf.Close();
+}
+
+//________________________________________________________________________________
+MatBudgetGrid* MatBudgetGrid::loadFromFile(const std::string& inpFName)
+{
+  TFile inpf(inpFName.data());
+  if (inpf.IsZombie()) {
+    LOG(error) << "Failed to open input file " << inpFName;
+    return nullptr;
+  }
+  MatBudgetGrid* mb = reinterpret_cast<MatBudgetGrid*>(inpf.GetObjectChecked("ccdb_object", Class()));
+  if (!mb) {
+    LOG(error) << "Failed to load mat.budget grid from " << inpFName;
+    return nullptr;
+  }
+  return rectifyPtrFromFile(mb);
+}
+
+//________________________________________________________________________________
+MatBudgetGrid* MatBudgetGrid::rectifyPtrFromFile(MatBudgetGrid* ptr)
+{
+  // rectify object loaded from file
+  if (ptr && !ptr->getFlatBufferPtr()) {
+    ptr->fixPointers();
+  }
+  return ptr;
+}
+
+#endif // !GPUCA_ALIGPUCODE
+
+#ifndef GPUCA_GPUCODE
+//________________________________________________________________________________
+void MatBudgetGrid::fixPointers(char* newPtr)
+{
+  // the flat buffer holds only the integrals array, impose external pointer or the one of the container read from the file
+  mFlatBufferPtr = newPtr ? newPtr : mFlatBufferContainer;
+}
+
+//________________________________________________________________________________
+void MatBudgetGrid::cloneFromObject(const MatBudgetGrid& obj, char* newFlatBufferPtr)
+{
+  /// Initializes from another object, copies data to newBufferPtr
+  o2::gpu::FlatObject::cloneFromObject(obj, newFlatBufferPtr);
+  mRMin = obj.mRMin;
+  mDR = obj.mDR;
+  mDRInv = obj.mDRInv;
+  mDPhiInv = obj.mDPhiInv;
+  mZMax = obj.mZMax;
+  mDZ = obj.mDZ;
+  mDZInv = obj.mDZInv;
+  mNRBins = obj.mNRBins;
+  mNPhiBins = obj.mNPhiBins;
+  mNZBins = obj.mNZBins;
+}
+#endif // !GPUCA_GPUCODE
+
+//_________________________________________________________________________________________________
+GPUd() MatBudget MatBudgetGrid::getMatBudget(float x0, float y0, float z0, float x1, float y1, float z1) const
+{
+  // get material budget traversed on the line between point0 and point1, with the same conventions as MatLayerCylSet
+  MatBudget rval;
+  float dx = x1 - x0, dy = y1 - y0, dz = z1 - z0, dxy2 = dx * dx + dy * dy;
+  rval.length = o2::gpu::CAMath::Sqrt(dxy2 + dz * dz);
+  if (rval.length < 1e-6f) {
+    return rval;
+  }
+  // split the segment at the closest approach to the beam axis to have the pieces monotonic in r
+  float tSplit[3] = {0.f, 1.f, 1.f};
+  int nPieces = 1;
+  if (dxy2 > 0.f) {
+    float tDCA = -(x0 * dx + y0 * dy) / dxy2;
+    if (tDCA > 0.f && tDCA < 1.f) {
+      tSplit[1] = tDCA;
+      nPieces = 2;
+    }
+  }
+  float lengthInMat = 0.f;
+  for (int ip = 0; ip < nPieces; ip++) {
+    float tA = tSplit[ip], tB = tSplit[ip + 1];
+    float xA = x0 + tA * dx, yA = y0 + tA * dy, xB = x0 + tB * dx, yB = y0 + tB * dy;
+    float dPhi = o2::math_utils::fastATan2(yB, xB) - o2::math_utils::fastATan2(yA, xA);
+    if (dPhi > o2::constants::math::PI) {
+      dPhi -= o2::constants::math::TwoPI;
+    } else if (dPhi < -o2::constants::math::PI) {
+      dPhi += o2::constants::math::TwoPI;
+    }
+    // sub-steps to follow the phi and z bins crossed
+    float nBinsCrossed = o2::gpu::CAMath::Max(o2::gpu::CAMath::Abs(dPhi) * mDPhiInv, o2::gpu::CAMath::Abs((tB - tA) * dz) * mDZInv);
+    int nSub = nBinsCrossed < MaxSubSteps - 1 ? 1 + int(nBinsCrossed) : MaxSubSteps;
+    float dt = (tB - tA) / nSub, stepLength = dt * rval.length;
+    float tCur = tA, rCur = o2::gpu::CAMath::Sqrt(xA * xA + yA * yA);
+    for (int is = 0; is < nSub; is++) {
+      float tNext = is + 1 < nSub ? tCur + dt : tB, tMid = 0.5f * (tCur + tNext);
+      float xNext = x0 + tNext * dx, yNext = y0 + tNext * dy, rNext = o2::gpu::CAMath::Sqrt(xNext * xNext + yNext * yNext);
+      float phiMid = o2::math_utils::fastATan2(y0 + tMid * dy, x0 + tMid * dx);
+      if (phiMid < 0.f) {
+        phiMid += o2::constants::math::TwoPI;
+      }
+      accountStep(rCur, rNext, phiMid, z0 + tMid * dz, stepLength, rval, lengthInMat);
+      tCur = tNext;
+      rCur = rNext;
+    }
+  }
+  // at this stage meanRho holds the integral of the density, normalize it to the length in the material as MatLayerCylSet does
+  rval.meanRho = lengthInMat > 0.f ? rval.meanRho / lengthInMat : 0.f;
+  return rval;
+}
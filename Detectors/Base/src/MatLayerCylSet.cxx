@@ -101,7 +101,7 @@ void MatLayerCylSet::finalizeStructures()
   o2::gpu::resizeArray(get()->mR2Intervals, 0, nR2Int);
   o2::gpu::resizeArray(get()->mInterval2LrID, 0, nR2Int);
   get()->mR2Intervals[0] = get()->mRMin2;
-  get()->mR2Intervals[1] = get()->mRMax2;
+  get()->mR2Intervals[1] = getLayer(0).getRMax2();
   get()->mInterval2LrID[0] = 0;
   auto& nRIntervals = get()->mNRIntervals;
   nRIntervals = 1;
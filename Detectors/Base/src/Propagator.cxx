@@ -55,11 +55,12 @@ void PropagatorImpl<value_T>::updateField()
     if (!mField) {
       LOG(fatal) << "Magnetic field is not initialized!";
     }
-    if (!mField->getFastField() && mField->fastFieldExists()) {
-      mField->AllowFastField(true);
-      mFieldFast = mField->getFastField();
-    }
   }
+  // use the polynomial parametrization whenever it is valid for the current field, also if it was already created by another client
+  if (!mField->getFastField() && mField->fastFieldExists()) {
+    mField->AllowFastField(true);
+  }
+  mFieldFast = mField->getFastField();
   const value_type xyz[3] = {0.};
   if (mFieldFast) {
     mFieldFast->GetBz(xyz, mNominalBz);
@@ -759,13 +760,11 @@ GPUd() void PropagatorImpl<value_T>::getFieldXYZImpl(const math_utils::Point3D<T
     }
   } else {
 #ifndef GPUCA_GPUCODE
-    if (mFieldFast) {
-      mFieldFast->Field(xyz, bxyz); // Must not call the host-only function in GPU compilation
-    } else {
+    if (!mFieldFast || !mFieldFast->Field(xyz, bxyz)) { // Must not call the host-only function in GPU compilation
 #ifdef GPUCA_STANDALONE
       LOG(fatal) << "Normal field cannot be used in standalone benchmark";
 #else
-      mField->field(xyz, bxyz);
+      mField->field(xyz, bxyz); // outside of the fast parametrization validity
 #endif
     }
 #endif
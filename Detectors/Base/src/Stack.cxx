@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef> // for NULL
 #include <cmath>
 
@@ -133,7 +134,9 @@ Stack::Stack(const Stack& rhs)
     mMinHits(rhs.mMinHits),
     mEnergyCut(rhs.mEnergyCut),
     mTrackRefs(new std::vector<o2::TrackReference>),
-    mIsG4Like(rhs.mIsG4Like)
+    mIsG4Like(rhs.mIsG4Like),
+    mCompactKinematics(rhs.mCompactKinematics),
+    mCompactThreshold(rhs.mCompactThreshold)
 {
   LOG(debug) << "copy constructor called";
   mTracks = new std::vector<MCTrack>();
@@ -250,6 +253,18 @@ void Stack::PushTrack(Int_t toBeDone, Int_t parentId, Int_t pdgCode, Double_t px
   } else {
     mParticles.emplace_back(p);
     mCurrentParticle0 = p;
+    if (mCompactKinematics) {
+      TransportStatus status;
+      status.trackID = trackId;
+      mTransportStatus.push_back(status);
+      if (parentId >= mNumberOfPrimaryParticles) {
+        const auto motherEntry = mTrackIDtoParticlesEntry[parentId];
+        if (motherEntry >= 0) {
+          mTransportStatus[motherEntry].nDaughters++;
+        }
+      }
+      mMaxParticles = std::max(mMaxParticles, mParticles.size());
+    }
   }
   mStack.push(p);
 }
@@ -295,6 +310,7 @@ void Stack::PushTrack(int toBeDone, TParticle& p)
 /// \param iTrack track number
 void Stack::SetCurrentTrack(Int_t iTrack)
 {
+  trackStarted(iTrack);
   mIndexOfCurrentTrack = iTrack;
   if (iTrack < mPrimaryParticles.size()) {
     auto& p = mPrimaryParticles[iTrack];
@@ -357,6 +373,7 @@ TParticle* Stack::PopNextTrack(Int_t& iTrack)
         mIndexOfCurrentTrack = mCurrentParticle.GetStatusCode();
       }
       iTrack = mIndexOfCurrentTrack;
+      trackStarted(iTrack);
       if (mDoTrackSeeding) {
         auto hash = getHash(mCurrentParticle);
         // LOG(info) << "SEEDING NEW TRACK USING HASH" << hash;
@@ -412,6 +429,96 @@ void Stack::FillTrackArray()
   /// This interface is not implemented since we are filtering/filling the output array
   /// after each primary ... just give a summary message
   LOG(info) << "Stack: " << mTracks->size() << " out of " << mNumberOfEntriesInParticles << " stored \n";
+  if (mCompactKinematics) {
+    LOG(info) << "Stack: " << mNRemovedInEvent << " particles removed during transport in " << mNCompactions
+              << " compactions taking " << mCompactionTimeMS << " ms, max. " << mMaxParticles << " particles buffered ("
+              << mMaxParticles * sizeof(MCTrack) / 1024 << " kB)";
+  }
+}
+
+void Stack::trackStarted(int trackID)
+{
+  if (!mCompactKinematics) {
+    return;
+  }
+  // the engines transport a track until it is finished before starting the next one
+  if (mLastTrackID != trackID && mLastTrackID >= mNumberOfPrimaryParticles && mLastTrackID < (int)mTrackIDtoParticlesEntry.size()) {
+    const auto entry = mTrackIDtoParticlesEntry[mLastTrackID];
+    if (entry >= 0 && !mTransportStatus[entry].done) {
+      mTransportStatus[entry].done = true;
+      removeIfUnselectable(mLastTrackID);
+    }
+  }
+  if (trackID >= mNumberOfPrimaryParticles && trackID < (int)mTrackIDtoParticlesEntry.size()) {
+    const auto entry = mTrackIDtoParticlesEntry[trackID];
+    if (entry < 0) {
+      LOG(fatal) << "Stack: transport of track " << trackID << " resumed after it was removed, Stack.compactKine is not supported by this engine";
+    }
+    mTransportStatus[entry].done = false;
+  }
+  mLastTrackID = trackID;
+
+  // compact only if it frees a significant part of the buffer
+  if (mNRemovable >= mCompactThreshold && 2 * mNRemovable >= (int)mParticles.size()) {
+    compactParticles();
+  }
+}
+
+void Stack::removeIfUnselectable(int trackID)
+{
+  if (!mPruneKinematics) {
+    return;
+  }
+  while (trackID >= mNumberOfPrimaryParticles) {
+    const auto entry = mTrackIDtoParticlesEntry[trackID];
+    auto& status = mTransportStatus[entry];
+    const auto& particle = mParticles[entry];
+    // the particle (and hence its mothers) must be kept if it still has daughters or if selectTracks might select it;
+    // decay and pair production products are never removed since they might be kept for physics reasons
+    if (!status.done || status.nDaughters > 0 || particle.getStore() || (mStoreSecondaries && (int)particle.hasHits() >= mMinHits) ||
+        particle.getProcess() == kPDecay || particle.getProcess() == kPPair) {
+      return;
+    }
+    status.removed = true;
+    mTrackIDtoParticlesEntry[trackID] = -1;
+    mNRemovable++;
+    mNRemovedInPrimary++;
+    mNRemovedInEvent++;
+
+    trackID = particle.getMotherTrackId();
+    if (trackID < mNumberOfPrimaryParticles) {
+      return;
+    }
+    mTransportStatus[mTrackIDtoParticlesEntry[trackID]].nDaughters--;
+  }
+}
+
+void Stack::compactParticles()
+{
+  if (mNRemovable == 0) {
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  int nKept = 0;
+  for (int entry = 0; entry < (int)mParticles.size(); ++entry) {
+    if (mTransportStatus[entry].removed) {
+      continue;
+    }
+    if (nKept != entry) {
+      mParticles[nKept] = mParticles[entry];
+      mTransportStatus[nKept] = mTransportStatus[entry];
+    }
+    mTrackIDtoParticlesEntry[mTransportStatus[nKept].trackID] = nKept;
+    nKept++;
+  }
+  // release the memory of the removed particles
+  mParticles.resize(nKept);
+  mParticles.shrink_to_fit();
+  mTransportStatus.resize(nKept);
+  mTransportStatus.shrink_to_fit();
+  mNRemovable = 0;
+  mNCompactions++;
+  mCompactionTimeMS += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 void Stack::FinishPrimary()
@@ -420,6 +527,9 @@ void Stack::FinishPrimary()
   // we can do some cleanup of the memory structures
   mPrimariesDone++;
   LOG(debug) << "Finish primary hook " << mPrimariesDone;
+  if (mCompactKinematics) {
+    compactParticles();
+  }
   // preserve particles and theire ancestors that produced hits
 
   auto selected = selectTracks();
@@ -504,9 +614,12 @@ void Stack::FinishPrimary()
   // Update index map
   //
   Int_t imax = mNumberOfEntriesInParticles;
-  Int_t imin = imax - mParticles.size();
+  Int_t imin = imax - mParticles.size() - mNRemovedInPrimary;
   for (Int_t idTrack = imin; idTrack < imax; idTrack++) {
     Int_t index1 = mTrackIDtoParticlesEntry[idTrack];
+    if (index1 < 0) {
+      continue; // removed during transport
+    }
     Int_t index2 = indicesKept[index1];
     if (index2 == -1) {
       continue;
@@ -523,6 +636,9 @@ void Stack::FinishPrimary()
   mTransportedIDs.clear();
   mTrackIDtoParticlesEntry.clear();
   mIndexOfPrimaries.clear();
+  mTransportStatus.clear();
+  mLastTrackID = -1;
+  mNRemovedInPrimary = 0;
 }
 
 void Stack::UpdateTrackIndex(TRefArray* detList)
@@ -606,6 +722,11 @@ void Stack::Reset()
   mTrackRefs->clear();
   mTrackIDtoParticlesEntry.clear();
   mHitCounter = 0;
+  mTransportStatus.clear();
+  mLastTrackID = -1;
+  mNRemovable = mNRemovedInPrimary = mNRemovedInEvent = mNCompactions = 0;
+  mMaxParticles = 0;
+  mCompactionTimeMS = 0.;
 }
 
 void Stack::Register()
@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test MatBudgetGrid class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsBase/MatBudgetGrid.h"
+
+namespace o2
+{
+namespace base
+{
+
+// synthetic LUT covering 0<r<40 without gaps, as the production one: uniform beam pipe, 3 inner layers with the material
+// modulated in phi (staves), 2 outer uniform layers, empty layers in between
+void buildTestLUT(MatLayerCylSet& lut)
+{
+  struct Lr {
+    float rMin, rMax, rho, x0I;
+    int nStaves;
+  };
+  const Lr lrs[] = {{0.f, 1.8, 0.f, 0.f, 0}, {1.8, 1.92, 1.85, 1. / 35.28, 0}, {1.92, 2.2, 0.f, 0.f, 0}, {2.2, 2.6, 0.5, 1. / 60., 12}, {2.6, 3.0, 0.f, 0.f, 0}, {3.0, 3.4, 0.5, 1. / 60., 16}, {3.4, 3.8, 0.f, 0.f, 0}, {3.8, 4.2, 0.5, 1. / 60., 20}, {4.2, 19.f, 0.f, 0.f, 0}, {19.f, 21.f, 0.2, 1. / 150., 0}, {21.f, 35.f, 0.f, 0.f, 0}, {35.f, 40.f, 0.1, 1. / 300., 0}};
+  const float zHalf = 30.f, dz = 2.f, drphi = 0.5f;
+  for (const auto& l : lrs) {
+    lut.addLayer(l.rMin, l.rMax, zHalf, dz, drphi);
+  }
+  for (int il = 0; il < lut.getNLayers(); il++) {
+    auto& lr = lut.getLayer(il);
+    for (int ip = 0; ip < lr.getNPhiBins(); ip++) {
+      float phi = 0.5 * (lr.getPhiBinMin(ip) + lr.getPhiBinMax(ip));
+      float scale = lrs[il].nStaves ? 1.f + 0.8f * std::cos(phi * lrs[il].nStaves) : 1.f;
+      for (int iz = 0; iz < lr.getNZBins(); iz++) {
+        auto& cell = lr.getCellPhiBin(ip, iz);
+        cell.meanRho = lrs[il].rho * scale;
+        cell.meanX2X0 = lrs[il].x0I * scale;
+      }
+    }
+  }
+  lut.finalizeStructures();
+  lut.optimizePhiSlices();
+  lut.flatten();
+}
+
+BOOST_AUTO_TEST_CASE(MatBudGrid)
+{
+  MatLayerCylSet lut;
+  buildTestLUT(lut);
+  MatBudgetGrid grid;
+  grid.build(lut, 0.05, 480, 10.f);
+  grid.print();
+
+  // radial ray through the uniform layers only
+  {
+    float x0 = 0.f, y0 = 0.f, z0 = 5.f, x1 = 45.f * std::cos(0.3f), y1 = 45.f * std::sin(0.3f), z1 = 5.f;
+    auto ref = lut.getMatBudget(x0, y0, z0, x1, y1, z1);
+    auto mb = grid.getMatBudget(x0, y0, z0, x1, y1, z1);
+    BOOST_CHECK_CLOSE(mb.length, ref.length, 1e-4);
+    BOOST_CHECK_CLOSE(mb.meanX2X0, ref.meanX2X0, 1.);
+    BOOST_CHECK_CLOSE(mb.meanRho, ref.meanRho, 1.);
+  }
+
+  // random propagation-like steps and long segments
+  for (float maxLength : {2.f, 20.f}) {
+    auto cmp = grid.compare(lut, 200000, maxLength);
+    cmp.print();
+    BOOST_CHECK(std::abs(cmp.getBiasX2X0()) < 0.01);
+    BOOST_CHECK(std::abs(cmp.getBiasXRho()) < 0.01);
+    BOOST_CHECK(cmp.getRMSX2X0() < 0.15);
+    BOOST_CHECK(cmp.getRMSXRho() < 0.2);
+  }
+
+  // relocation of the flat buffer
+  MatBudgetGrid gridC;
+  gridC.cloneFromObject(grid, nullptr);
+  std::unique_ptr<char[]> buff(new char[grid.getFlatBufferSize()]);
+  std::memcpy(buff.get(), grid.getFlatBufferPtr(), grid.getFlatBufferSize());
+  auto gridA = reinterpret_cast<MatBudgetGrid*>(new char[sizeof(MatBudgetGrid)]);
+  std::memcpy((void*)gridA, (const void*)&gridC, sizeof(MatBudgetGrid));
+  gridA->clearInternalBufferPtr();
+  gridA->setActualBufferAddress(buff.get());
+  for (const auto* g : {(const MatBudgetGrid*)&gridC, (const MatBudgetGrid*)gridA}) {
+    auto mb0 = grid.getMatBudget(-3.f, 1.f, -2.f, 25.f, 30.f, 10.f), mb = g->getMatBudget(-3.f, 1.f, -2.f, 25.f, 30.f, 10.f);
+    BOOST_CHECK(mb.meanX2X0 == mb0.meanX2X0 && mb.meanRho == mb0.meanRho && mb.length == mb0.length);
+  }
+  delete[] reinterpret_cast<char*>(gridA);
+}
+
+} // namespace base
+} // namespace o2
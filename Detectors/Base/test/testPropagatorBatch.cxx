@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test PropagatorBatch class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include "DetectorsBase/MatLayerCylSet.h"
+#include "DetectorsBase/PropagatorBatch.h"
+
+namespace o2
+{
+namespace base
+{
+
+using Track = o2::track::TrackParCov;
+
+// uniform layers covering 0<r<60 without gaps
+void buildTestLUT(MatLayerCylSet& lut)
+{
+  const float rb[] = {0.f, 1.8, 2.0, 5.f, 6.f, 20.f, 22.f, 40.f, 41.f, 60.f}, rho[] = {0.f, 1.85, 0.f, 0.5, 0.f, 0.2, 0.f, 1.f, 0.f};
+  for (int il = 0; il < 9; il++) {
+    lut.addLayer(rb[il], rb[il + 1], 100.f, 5.f, 2.f);
+  }
+  for (int il = 0; il < lut.getNLayers(); il++) {
+    auto& lr = lut.getLayer(il);
+    for (int ip = 0; ip < lr.getNPhiBins(); ip++) {
+      for (int iz = 0; iz < lr.getNZBins(); iz++) {
+        auto& cell = lr.getCellPhiBin(ip, iz);
+        cell.meanRho = rho[il];
+        cell.meanX2X0 = rho[il] / 30.f;
+      }
+    }
+  }
+  lut.finalizeStructures();
+  lut.optimizePhiSlices();
+  lut.flatten();
+}
+
+// tracks from the origin with random momenta, including neutral ones and low pT loopers which cannot reach the destination
+std::vector<Track> generateTracks(int n)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> uni(0.f, 1.f);
+  std::vector<Track> tracks;
+  for (int i = 0; i < n; i++) {
+    float alpha = (uni(gen) - 0.5f) * o2::constants::math::TwoPI, pt = 0.1f + 3.f * uni(gen);
+    int charge = (i % 10) ? (uni(gen) > 0.5f ? 1 : -1) : 0;
+    std::array<float, 5> par = {(uni(gen) - 0.5f) * 0.1f, (uni(gen) - 0.5f) * 10.f, (uni(gen) - 0.5f) * 0.6f, (uni(gen) - 0.5f) * 2.f, (charge < 0 ? -1.f : 1.f) / pt};
+    std::array<float, 15> cov = {1e-4, 0., 1e-4, 0., 0., 1e-5, 0., 0., 0., 1e-5, 0., 0., 0., 0., 1e-3};
+    tracks.emplace_back(0.f, alpha, par, cov, charge);
+  }
+  return tracks;
+}
+
+BOOST_AUTO_TEST_CASE(PropagatorBatch_vs_scalar)
+{
+  MatLayerCylSet lut;
+  buildTestLUT(lut);
+  auto prop = Propagator::Instance(true);
+  prop->setMatLUT(&lut);
+  const float bz = -5.f, xToGo = 45.f;
+  const int nTracks = 1000;
+  for (auto matCorr : {Propagator::MatCorrType::USEMatCorrNONE, Propagator::MatCorrType::USEMatCorrLUT}) {
+    auto tracksS = generateTracks(nTracks), tracksB = tracksS;
+    std::vector<char> okS(nTracks);
+    int nOKS = 0;
+    for (int i = 0; i < nTracks; i++) {
+      okS[i] = prop->propagateToX(tracksS[i], xToGo, bz, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr);
+      nOKS += okS[i];
+    }
+    PropagatorBatch<8> propB(prop);
+    std::unique_ptr<bool[]> okB(new bool[nTracks]);
+    int nOKB = propB.propagateAllToX(tracksB.data(), nTracks, xToGo, bz, Propagator::MAX_SIN_PHI, Propagator::MAX_STEP, matCorr, 0, okB.get());
+    BOOST_CHECK(nOKS > nTracks / 2);
+    BOOST_CHECK_EQUAL(nOKS, nOKB);
+    int nDiff = 0;
+    for (int i = 0; i < nTracks; i++) {
+      bool same = bool(okS[i]) == okB[i] && std::abs(tracksS[i].getX() - tracksB[i].getX()) < 1e-5;
+      for (int ip = 0; ip < o2::track::kNParams; ip++) {
+        same &= std::abs(tracksS[i].getParam(ip) - tracksB[i].getParam(ip)) < 1e-5 * (1.f + std::abs(tracksS[i].getParam(ip)));
+      }
+      for (int ic = 0; ic < o2::track::kCovMatSize; ic++) {
+        same &= std::abs(tracksS[i].getCov()[ic] - tracksB[i].getCov()[ic]) < 1e-5 * (1e-6 + std::abs(tracksS[i].getCov()[ic]));
+      }
+      nDiff += !same;
+    }
+    BOOST_CHECK_EQUAL(nDiff, 0);
+  }
+}
+
+} // namespace base
+} // namespace o2
@@ -66,7 +66,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const TriggerReco
     mTrgDataFilt.clear();
     mClusDataFilt.clear();
     for (const auto& trig : trigData) {
-      if (mIRFrameSelector.check(trig.getBCData()) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.getBCData())) {
         mTrgDataFilt.push_back(trig);
         auto clusIt = cluData.begin() + trig.getFirstEntry();
         auto& trigC = mTrgDataFilt.back();
@@ -58,8 +58,16 @@ class Clusterer
   std::vector<FullCluster> mClusters; ///< internal vector of clusters
   std::vector<Digit> mDigits;         ///< vector of transient digits for cell processing
 
-  std::vector<std::vector<float>> meInClusters = std::vector<std::vector<float>>(10, std::vector<float>(NLMMax));
-  std::vector<std::vector<float>> mfij = std::vector<std::vector<float>>(10, std::vector<float>(NLMMax));
+  std::vector<int> mPadToDigit;     //! digit in the pad (-1 if none) of the event being clustered
+  std::vector<int> mNextDigitInPad; //! next digit in the same pad (-1 if none)
+  std::vector<int> mNeighbours;     //! neighbour digits of the cluster element being expanded
+
+  std::vector<FullCluster::CluElement> mUnfoldElements; //! elements of the cluster being unfolded
+  std::vector<float> mUnfoldX;                          //! local x of the elements of the cluster being unfolded
+  std::vector<float> mUnfoldZ;                          //! local z of the elements of the cluster being unfolded
+  std::vector<float> mUnfoldE;                          //! energies of the elements of the cluster being unfolded
+  std::vector<float> meInClusters;                      //! energy of [digit * NLMMax + maximum] in new cluster
+  std::vector<float> mfij;                              //! shower shape of [digit * NLMMax + maximum]
 };
 } // namespace cpv
 } // namespace o2
@@ -21,6 +21,7 @@
 #include "CCDB/CcdbApi.h"
 #include "CPVBase/CPVSimParams.h"
 #include "CPVBase/CPVCalibParams.h"
+#include <algorithm>
 #include <bitset>
 #include <fairlogger/Logger.h> // for LOG
 
@@ -82,16 +83,34 @@ void Clusterer::process(gsl::span<const Digit> digits, gsl::span<const TriggerRe
 //____________________________________________________________________________
 void Clusterer::makeClusters(gsl::span<const Digit> digits)
 {
-  // A cluster is defined as a list of neighbour digits
+  // A cluster is defined as a list of neighbour digits, i.e. pads with a common side
+  // (see Geometry::areNeighbours). The neighbours are looked up in a grid of the pads
+  // holding the digits of the event which can still join a cluster, instead of scanning
+  // all the remaining digits for every digit added to a cluster.
+  // The digits are added in the same order as by the scan over the digits.
 
   // Mark all digits as unused yet
   const int maxNDigits = 23040;       // There is no digits more than in CPV modules ;)
   std::bitset<maxNDigits> digitsUsed; ///< Container for bad cells, 1 means bad sell
   digitsUsed.reset();
 
-  int iFirst = mFirstDigitInEvent; // first index of digit which potentially can be a part of cluster
+  if (mPadToDigit.empty()) {
+    mPadToDigit.resize(Geometry::kNCHANNELS, -1);
+  }
+  mNextDigitInPad.resize(mLastDigitInEvent - mFirstDigitInEvent);
+  // fill the grid with the digits which can be part of a cluster, the digits of the
+  // same pad (if any) are chained in the order of the digits
+  for (int i = mLastDigitInEvent; i-- > mFirstDigitInEvent;) {
+    const Digit& digit = digits[i];
+    if (digit.getAmplitude() < o2::cpv::CPVSimParams::Instance().mDigitMinEnergy || digit.getAbsId() >= Geometry::kNCHANNELS) {
+      continue;
+    }
+    mNextDigitInPad[i - mFirstDigitInEvent] = mPadToDigit[digit.getAbsId()];
+    mPadToDigit[digit.getAbsId()] = i;
+  }
 
-  for (int i = iFirst; i < mLastDigitInEvent; i++) {
+  std::array<int, 5> neighbourPads;
+  for (int i = mFirstDigitInEvent; i < mLastDigitInEvent; i++) {
     if (digitsUsed.test(i - mFirstDigitInEvent)) {
       continue;
     }
@@ -112,43 +131,52 @@ void Clusterer::makeClusters(gsl::span<const Digit> digits)
     digitsUsed.set(i - mFirstDigitInEvent, true);
     int iDigitInCluster = 1;
 
-    // Now scan remaining digits in list to find neigbours of our seed
+    // Now look in the grid for the neighbours of the digits already in cluster
     int index = 0;
     while (index < iDigitInCluster) { // scan over digits already in cluster
-      short digitSeedAbsId = clu.getDigitAbsId(index);
+      unsigned short digitSeedAbsId = clu.getDigitAbsId(index);
       index++;
-      bool runLoop = true;
-      for (Int_t j = iFirst; runLoop && (j < mLastDigitInEvent); j++) {
-        if (digitsUsed.test(j - mFirstDigitInEvent)) {
-          continue; // look through remaining digits
+      int nNeighbourPads = 0;
+      short z = digitSeedAbsId % Geometry::kNumberOfCPVPadsZ;
+      short phi = (digitSeedAbsId / Geometry::kNumberOfCPVPadsZ) % Geometry::kNumberOfCPVPadsPhi;
+      neighbourPads[nNeighbourPads++] = digitSeedAbsId;
+      if (z > 0) {
+        neighbourPads[nNeighbourPads++] = digitSeedAbsId - 1;
+      }
+      if (z < Geometry::kNumberOfCPVPadsZ - 1) {
+        neighbourPads[nNeighbourPads++] = digitSeedAbsId + 1;
+      }
+      if (phi > 0) {
+        neighbourPads[nNeighbourPads++] = digitSeedAbsId - Geometry::kNumberOfCPVPadsZ;
+      }
+      if (phi < Geometry::kNumberOfCPVPadsPhi - 1) {
+        neighbourPads[nNeighbourPads++] = digitSeedAbsId + Geometry::kNumberOfCPVPadsZ;
+      }
+      mNeighbours.clear();
+      for (int iPad = 0; iPad < nNeighbourPads; iPad++) {
+        for (int j = mPadToDigit[neighbourPads[iPad]]; j >= 0; j = mNextDigitInPad[j - mFirstDigitInEvent]) {
+          if (!digitsUsed.test(j - mFirstDigitInEvent)) {
+            mNeighbours.push_back(j);
+          }
         }
+      }
+      // add the neighbours in the order of the digits
+      std::sort(mNeighbours.begin(), mNeighbours.end());
+      for (int j : mNeighbours) {
         const Digit& digitN = digits[j];
-        float digitNEnergy = digitN.getAmplitude(); // Already calibrated digits!
-        if (digitNEnergy < o2::cpv::CPVSimParams::Instance().mDigitMinEnergy) {
-          continue;
-        }
-
-        // call (digit,digitN) in THAT oder !!!!!
-        Int_t ineb = Geometry::areNeighbours(digitSeedAbsId, digitN.getAbsId());
-        switch (ineb) {
-          case -1: // too early (e.g. previous module), do not look before j at subsequent passes
-            iFirst = j;
-            break;
-          case 0: // not a neighbour
-            break;
-          case 1: // are neighbours
-            clu.addDigit(digitN.getAbsId(), digitNEnergy, digitN.getLabel());
-            iDigitInCluster++;
-            digitsUsed.set(j - mFirstDigitInEvent, true);
-            break;
-          case 2: // too far from each other
-          default:
-            runLoop = false;
-            break;
-        } // switch
+        clu.addDigit(digitN.getAbsId(), digitN.getAmplitude(), digitN.getLabel());
+        iDigitInCluster++;
+        digitsUsed.set(j - mFirstDigitInEvent, true);
       }
     } // loop over cluster
   }   // energy theshold
+
+  // clean the grid for the next event
+  for (int i = mFirstDigitInEvent; i < mLastDigitInEvent; i++) {
+    if (digits[i].getAbsId() < Geometry::kNCHANNELS) {
+      mPadToDigit[digits[i].getAbsId()] = -1;
+    }
+  }
 }
 //__________________________________________________________________________
 void Clusterer::makeCalibDigits(std::vector<Digit>* calibDigits)
@@ -183,7 +211,7 @@ void Clusterer::makeUnfoldingsAndCalibDigits(gsl::span<const Digit> digits, std:
     char nMax = clu.getNumberOfLocalMax(maxAt);
     if (nMax > 1) {
       unfoldOneCluster(clu, nMax, maxAt, digits);
-      clu.setEnergy(0); // will be skipped later
+      mClusters[i].setEnergy(0); // will be skipped later, clu may be invalidated by the new clusters
     } else {
       clu.setNExMax(nMax); // Only one local maximum
       // make calib digits from cluster with only one local maximum and appropriate size
@@ -205,14 +233,21 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
   //             maxAtEnergy: energies of digits, corresponding to local maxima
 
   // Take initial cluster and calculate local coordinates of digits
-  // To avoid multiple re-calculation of same parameters
-  char mult = iniClu.getMultiplicity();
-  if (meInClusters.capacity() < static_cast<unsigned int>(mult)) {
-    meInClusters.reserve(mult);
-    mfij.reserve(mult);
+  // To avoid multiple re-calculation of same parameters.
+  // The elements are copied as iniClu belongs to mClusters, which is expanded by the new clusters
+  mUnfoldElements.assign(iniClu.getElementList()->begin(), iniClu.getElementList()->end());
+  const int mult = mUnfoldElements.size();
+  mUnfoldX.resize(mult);
+  mUnfoldZ.resize(mult);
+  mUnfoldE.resize(mult);
+  for (int idig = 0; idig < mult; idig++) {
+    mUnfoldX[idig] = mUnfoldElements[idig].localX;
+    mUnfoldZ[idig] = mUnfoldElements[idig].localZ;
+    mUnfoldE[idig] = mUnfoldElements[idig].energy;
   }
-
-  const std::vector<FullCluster::CluElement>* cluElist = iniClu.getElementList();
+  // contiguous [digit][local maximum] arrays, sized for the multiplicity of this cluster
+  mfij.resize(mult * NLMMax);
+  meInClusters.assign(mult * NLMMax, 0.);
 
   // Coordinates of centers of clusters
   std::array<float, NLMMax> xMax;
@@ -225,9 +260,9 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
   std::array<float, NLMMax> c;
 
   for (int iclu = 0; iclu < nMax; iclu++) {
-    xMax[iclu] = (*cluElist)[digitId[iclu]].localX;
-    zMax[iclu] = (*cluElist)[digitId[iclu]].localZ;
-    eMax[iclu] = 2. * (*cluElist)[digitId[iclu]].energy;
+    xMax[iclu] = mUnfoldX[digitId[iclu]];
+    zMax[iclu] = mUnfoldZ[digitId[iclu]];
+    eMax[iclu] = 2. * mUnfoldE[digitId[iclu]];
   }
 
   std::array<float, NLMMax> prop; // proportion of clusters in the current digit
@@ -242,24 +277,24 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
     std::memset(&c, 0, sizeof c);
     // First calculate shower shapes
     for (int idig = 0; idig < mult; idig++) {
-      auto it = (*cluElist)[idig];
+      float* fi = &mfij[idig * NLMMax];
       for (int iclu = 0; iclu < nMax; iclu++) {
-        mfij[idig][iclu] = responseShape(it.localX - xMax[iclu], it.localZ - zMax[iclu]);
+        fi[iclu] = responseShape(mUnfoldX[idig] - xMax[iclu], mUnfoldZ[idig] - zMax[iclu]);
       }
     }
 
     // Fit energies
     for (int idig = 0; idig < mult; idig++) {
-      auto it = (*cluElist)[idig];
+      const float* fi = &mfij[idig * NLMMax];
+      // sum over all maxima, the diagonal term is subtracted below
+      float fe = 0.;
+      for (int kclu = 0; kclu < nMax; kclu++) {
+        fe += eMax[kclu] * fi[kclu];
+      }
       for (int iclu = 0; iclu < nMax; iclu++) {
-        a[iclu] += mfij[idig][iclu] * mfij[idig][iclu];
-        b[iclu] += it.energy * mfij[idig][iclu];
-        for (int kclu = 0; kclu < nMax; kclu++) {
-          if (iclu == kclu) {
-            continue;
-          }
-          c[iclu] += eMax[kclu] * mfij[idig][iclu] * mfij[idig][kclu];
-        }
+        a[iclu] += fi[iclu] * fi[iclu];
+        b[iclu] += mUnfoldE[idig] * fi[iclu];
+        c[iclu] += (fe - eMax[iclu] * fi[iclu]) * fi[iclu];
       }
     }
     // Evaluate new maximal energies
@@ -275,17 +310,20 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
     // according to shower shape
     // then re-evaluate local position of clusters
     for (int idig = 0; idig < mult; idig++) {
+      const float* fi = &mfij[idig * NLMMax];
       float eEstimated = 0;
       for (int iclu = 0; iclu < nMax; iclu++) {
-        prop[iclu] = eMax[iclu] * mfij[idig][iclu];
+        prop[iclu] = eMax[iclu] * fi[iclu];
         eEstimated += prop[iclu];
       }
       if (eEstimated == 0.) { // numerical accuracy
         continue;
       }
       // Split energy of digit according to contributions
+      float* ei = &meInClusters[idig * NLMMax];
+      float scale = mUnfoldE[idig] / eEstimated;
       for (int iclu = 0; iclu < nMax; iclu++) {
-        meInClusters[idig][iclu] = (*cluElist)[idig].energy * prop[iclu] / eEstimated;
+        ei[iclu] = prop[iclu] * scale;
       }
     }
 
@@ -296,18 +334,19 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
       // full energy, need for weight
       float eTotNew = 0;
       for (int idig = 0; idig < mult; idig++) {
-        eTotNew += meInClusters[idig][iclu];
+        eTotNew += meInClusters[idig * NLMMax + iclu];
       }
       xMax[iclu] = 0;
       zMax[iclu] = 0.;
       float wtot = 0.;
       for (int idig = 0; idig < mult; idig++) {
-        if (meInClusters[idig][iclu] > 0) {
+        float eInClu = meInClusters[idig * NLMMax + iclu];
+        if (eInClu > 0) {
           // In unfolding it is better to use linear weight to reduce contribution of unfolded tails
-          float w = meInClusters[idig][iclu] / eTotNew;
+          float w = eInClu / eTotNew;
           // float w = std::max(std::log(eInClusters[idig][iclu] / eTotNew) + o2::cpv::CPVSimParams::Instance().mLogWeight, float(0.));
-          xMax[iclu] += (*cluElist)[idig].localX * w;
-          zMax[iclu] += (*cluElist)[idig].localZ * w;
+          xMax[iclu] += mUnfoldX[idig] * w;
+          zMax[iclu] += mUnfoldZ[idig] * w;
           wtot += w;
         }
       }
@@ -328,12 +367,11 @@ void Clusterer::unfoldOneCluster(FullCluster& iniClu, char nMax, gsl::span<int>
     FullCluster& clu = mClusters.back();
     clu.setNExMax(nMax);
     for (int idig = 0; idig < mult; idig++) {
-      float eDigit = meInClusters[idig][iclu];
-      idig++;
+      float eDigit = meInClusters[idig * NLMMax + iclu];
       if (eDigit < o2::cpv::CPVSimParams::Instance().mDigitMinEnergy) {
         continue;
       }
-      clu.addDigit((*cluElist)[idig].absId, eDigit, (*cluElist)[idig].label);
+      clu.addDigit(mUnfoldElements[idig].absId, eDigit, mUnfoldElements[idig].label);
     }
   }
 }
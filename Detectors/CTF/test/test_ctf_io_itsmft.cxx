@@ -88,6 +88,24 @@ BOOST_DATA_TEST_CASE(CompressedClustersTest, boost_data::make(ANSVersions), ansV
   sw.Stop();
   LOG(info) << "Compressed in " << sw.CpuTime() << " s";
 
+  // encoding the blocks concurrently in scratch containers must give the same payload
+  {
+    std::vector<o2::ctf::BufferType> vecMT;
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder, o2::detectors::DetID::ITS);
+    coder.setANSVersion(ansVersion);
+    coder.setNThreads(3);
+    coder.encode(vecMT, rofRecVec, cclusVec, pattVec, pattIdConverter, 0);
+    const auto ctfST = o2::itsmft::CTF::getImage(vec.data());
+    const auto ctfMT = o2::itsmft::CTF::getImage(vecMT.data());
+    for (int ib = 0; ib < o2::itsmft::CTF::getNBlocks(); ib++) {
+      const auto& blockST = ctfST.getBlock(ib);
+      const auto& blockMT = ctfMT.getBlock(ib);
+      BOOST_CHECK(ctfST.getMetadata(ib).opt == ctfMT.getMetadata(ib).opt);
+      BOOST_CHECK(blockST.getNStored() == blockMT.getNStored());
+      BOOST_CHECK(blockST.getNStored() == 0 || memcmp(blockST.payload, blockMT.payload, blockST.getNStored() * sizeof(*blockST.payload)) == 0);
+    }
+  }
+
   // writing
   {
     sw.Start();
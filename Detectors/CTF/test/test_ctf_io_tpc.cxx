@@ -143,6 +143,20 @@ BOOST_DATA_TEST_CASE(CTFTest, boost_data::make(ANSVersions) ^ boost_data::make(C
       }
     }
     coder.encode(vecIO, c, c, trigComp); // compress
+
+    // encoding the blocks concurrently in scratch containers must give the same payload
+    std::vector<o2::ctf::BufferType> vecIOMT;
+    coder.setNThreads(2);
+    coder.encode(vecIOMT, c, c, trigComp);
+    const auto ctfST = o2::tpc::CTF::getImage(vecIO.data());
+    const auto ctfMT = o2::tpc::CTF::getImage(vecIOMT.data());
+    for (int ib = 0; ib < o2::tpc::CTF::getNBlocks(); ib++) {
+      const auto& blockST = ctfST.getBlock(ib);
+      const auto& blockMT = ctfMT.getBlock(ib);
+      BOOST_CHECK(ctfST.getMetadata(ib).opt == ctfMT.getMetadata(ib).opt);
+      BOOST_CHECK(blockST.getNStored() == blockMT.getNStored());
+      BOOST_CHECK(blockST.getNStored() == 0 || memcmp(blockST.payload, blockMT.payload, blockST.getNStored() * sizeof(*blockST.payload)) == 0);
+    }
   }
   sw.Stop();
   LOG(info) << "Compressed in " << sw.CpuTime() << " s";
@@ -199,3 +213,82 @@ BOOST_DATA_TEST_CASE(CTFTest, boost_data::make(ANSVersions) ^ boost_data::make(C
   BOOST_CHECK(triggers.size() == triggersR.size());
   BOOST_CHECK(memcmp(triggers.data(), triggersR.data(), triggers.size() * sizeof(o2::tpc::TriggerInfoDLBZS)) == 0);
 }
+
+BOOST_AUTO_TEST_CASE(CTFContextCodingTest)
+{
+  // residuals whose spread grows with the row increment, to be coded in the context of the latter
+  CompressedClusters c;
+  c.nAttachedClustersReduced = 20000;
+  c.nAttachedClusters = c.nAttachedClustersReduced + 100;
+  c.nTracks = 100;
+
+  std::vector<char> bVec;
+  CompressedClustersFlat* ccFlat = nullptr;
+  size_t sizeCFlatBody = CTFCoder::alignSize(ccFlat);
+  size_t sz = sizeCFlatBody + CTFCoder::estimateSize(c);
+  bVec.resize(sz);
+  ccFlat = reinterpret_cast<CompressedClustersFlat*>(bVec.data());
+  auto buff = reinterpret_cast<void*>(reinterpret_cast<char*>(bVec.data()) + sizeCFlatBody);
+  CTFCoder::setCompClusAddresses(c, buff);
+  ccFlat->set(sz, c);
+
+  gRandom->SetSeed(1234);
+  for (int i = 0; i < c.nAttachedClustersReduced; i++) {
+    c.rowDiffA[i] = gRandom->Integer(4);
+    c.padResA[i] = static_cast<int>(gRandom->Gaus(0, 1 + 20 * c.rowDiffA[i]));
+    c.timeResA[i] = static_cast<int>(gRandom->Gaus(0, 1 + 20 * c.rowDiffA[i])) & 0xffffff; // 24 bits residuals
+  }
+  std::vector<bool> reject(c.nAttachedClustersReduced);
+  for (int i = 0; i < c.nAttachedClustersReduced; i += 7) {
+    reject[i] = true;
+  }
+
+  std::vector<o2::ctf::BufferType> vecIO, vecIOCtx;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.setANSVersion(o2::ctf::ANSVersion1);
+    coder.encode(vecIO, c, c, {});
+    coder.setContextCoding(true);
+    coder.encode(vecIOCtx, c, c, {});
+  }
+  const auto ctfImage = o2::tpc::CTF::getImage(vecIO.data());
+  const auto ctfImageCtx = o2::tpc::CTF::getImage(vecIOCtx.data());
+  for (auto slot : {CTF::BLCpadResA, CTF::BLCtimeResA}) {
+    BOOST_CHECK(ctfImageCtx.getMetadata(slot).opt == o2::ctf::Metadata::OptStore::EENCODE_CTX);
+    BOOST_CHECK(ctfImageCtx.getBlock(slot).getNStored() < ctfImage.getBlock(slot).getNStored());
+  }
+
+  std::vector<char> vecIn;
+  std::vector<o2::tpc::TriggerInfoDLBZS> triggersR;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Decoder);
+    coder.decode(ctfImageCtx, vecIn, triggersR);
+  }
+  BOOST_CHECK(vecIn.size() == bVec.size());
+  BOOST_CHECK(memcmp(vecIn.data() + sizeof(o2::tpc::CompressedClustersCounters), bVec.data() + sizeof(o2::tpc::CompressedClustersCounters), bVec.size() - sizeof(o2::tpc::CompressedClustersCounters)) == 0);
+
+  // the rejected entries are dropped from both the residuals and their context
+  std::vector<o2::ctf::BufferType> vecIORej;
+  {
+    CTFCoder coder(o2::ctf::CTFCoderBase::OpType::Encoder);
+    coder.setANSVersion(o2::ctf::ANSVersion1);
+    coder.setContextCoding(true);
+    coder.setNThreads(2);
+    CompressedClusters cFiltered = c;
+    cFiltered.nAttachedClustersReduced -= (c.nAttachedClustersReduced + 6) / 7;
+    coder.encode(vecIORej, c, cFiltered, {}, nullptr, nullptr, nullptr, &reject);
+  }
+  const auto ctfImageRej = o2::tpc::CTF::getImage(vecIORej.data());
+  std::vector<std::remove_pointer_t<decltype(c.rowDiffA)>> rowDiffR;
+  std::vector<std::remove_pointer_t<decltype(c.padResA)>> padResR;
+  ctfImageRej.decode(rowDiffR, CTF::BLCrowDiffA);
+  padResR.resize(rowDiffR.size());
+  ctfImageRej.decodeWithContext(padResR.begin(), rowDiffR.begin(), CTF::BLCpadResA);
+  BOOST_CHECK(ctfImageRej.getMetadata(CTF::BLCpadResA).opt == o2::ctf::Metadata::OptStore::EENCODE_CTX);
+  for (int i = 0, j = 0; i < c.nAttachedClustersReduced; i++) {
+    if (!reject[i]) {
+      BOOST_CHECK(rowDiffR[j] == c.rowDiffA[i] && padResR[j] == c.padResA[i]);
+      j++;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.h
+/// @brief  Memory-mappable binary container of CTFs, alternative to the CTF tree
+
+#ifndef O2_CTF_FLATFILE_H
+#define O2_CTF_FLATFILE_H
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "DetectorsCommonDataFormats/CTFHeader.h"
+#include "DetectorsCommonDataFormats/DetID.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+/// The file is a sequence of entries, one per CTF. Each entry is a CTFFlatEntryHeader followed by the
+/// flat EncodedBlocks images of the detectors, exactly as produced by the entropy encoders, so that
+/// EncodedBlocks::getImage can be used directly on the mapped file. All offsets are relative to the
+/// start of the entry and aligned to CTFFlatEntryHeader::Alignment.
+struct CTFFlatEntryHeader {
+  static constexpr uint64_t Magic = 0x314c4654433e324fULL; // "O2>CTFL1" little-endian
+  static constexpr size_t Alignment = 64;
+
+  uint64_t magic = Magic;
+  uint64_t size = 0; // total size of the entry, header included
+  CTFHeader ctfHeader{};
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> offsets{};
+  std::array<uint64_t, o2::detectors::DetID::nDetectors> sizes{};
+};
+
+class CTFFlatFileWriter
+{
+ public:
+  explicit CTFFlatFileWriter(const std::string& name);
+  ~CTFFlatFileWriter() { close(); }
+  CTFFlatFileWriter(const CTFFlatFileWriter&) = delete;
+  CTFFlatFileWriter& operator=(const CTFFlatFileWriter&) = delete;
+
+  /// register the image of a detector for the current entry, the data must stay valid until writeEntry
+  void addDetector(o2::detectors::DetID det, const void* data, size_t size);
+  /// write the current entry, detectors mask of the header is set from the registered ones, returns the entry size
+  size_t writeEntry(CTFHeader header);
+  void close();
+
+  const std::string& getName() const { return mName; }
+  size_t getNEntries() const { return mNEntries; }
+  size_t getSize() const { return mSize; }
+
+ private:
+  std::string mName{};
+  std::FILE* mFile = nullptr;
+  std::array<gsl::span<const BufferType>, o2::detectors::DetID::nDetectors> mImages{};
+  size_t mNEntries = 0;
+  size_t mSize = 0;
+};
+
+class CTFFlatFileReader
+{
+ public:
+  CTFFlatFileReader() = default;
+  ~CTFFlatFileReader() { close(); }
+  CTFFlatFileReader(const CTFFlatFileReader&) = delete;
+  CTFFlatFileReader& operator=(const CTFFlatFileReader&) = delete;
+
+  /// map the file and index its entries, throws on I/O error or corrupted content
+  void open(const std::string& name);
+  void close();
+
+  const std::string& getName() const { return mName; }
+  long getNEntries() const { return mEntries.size(); }
+  const CTFHeader& getHeader(long entry) const { return getEntry(entry).ctfHeader; }
+  /// image of detector in the mapped file, empty if absent
+  gsl::span<const BufferType> getDetector(long entry, o2::detectors::DetID det) const;
+
+  /// check the magic word at the file start
+  static bool isFlatFile(const std::string& name);
+
+ private:
+  const CTFFlatEntryHeader& getEntry(long entry) const { return *reinterpret_cast<const CTFFlatEntryHeader*>(mData + mEntries[entry]); }
+
+  std::string mName{};
+  const BufferType* mData = nullptr;
+  size_t mSize = 0;
+  std::vector<size_t> mEntries{}; // offsets of the entries
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
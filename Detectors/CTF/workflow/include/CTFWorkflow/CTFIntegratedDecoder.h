@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFIntegratedDecoder.h
+/// @brief  Entropy decoding of detector CTFs inside the CTF reader device
+
+#ifndef O2_CTF_INTEGRATED_DECODER_H
+#define O2_CTF_INTEGRATED_DECODER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gsl/span>
+#include "Framework/OutputSpec.h"
+#include "DetectorsCommonDataFormats/DetID.h"
+
+class TTree;
+
+namespace o2
+{
+namespace framework
+{
+class ProcessingContext;
+}
+namespace ctf
+{
+struct CTFHeader;
+
+/// Decoder of one detector running in the CTF reader instead of a separate entropy decoder device.
+/// The CTF payload is read into a buffer owned by the decoder and decoded directly into the
+/// output messages, which saves the CTFDATA message and its copy in the downstream device.
+/// read() and prepareOutputs() / finalise() talk to ROOT and DPL and must be called from the
+/// processing thread, decode() of different detectors may run concurrently.
+class CTFIntegratedDecoder
+{
+ public:
+  explicit CTFIntegratedDecoder(o2::detectors::DetID det) : mDet(det) {}
+  virtual ~CTFIntegratedDecoder() = default;
+
+  o2::detectors::DetID getDet() const { return mDet; }
+
+  /// load the entropy coding dictionary: "ccdb" (fetched for the CTF creation time), "none" (per-TF dictionary) or a local file
+  virtual void loadDictionary(const std::string& dict, long timestamp) = 0;
+  /// read the CTF of the tree entry into an owned buffer, an empty image is kept if the detector is absent
+  virtual void read(TTree& tree, long entry, bool present) = 0;
+  /// use an external flat image, e.g. from a mapped flat CTF file, which must stay valid until decode() is done
+  void setImage(gsl::span<const uint8_t> image) { mImage = image; }
+  /// create the output messages
+  virtual void prepareOutputs(o2::framework::ProcessingContext& pc) = 0;
+  /// decode the buffer into the outputs
+  virtual void decode() = 0;
+  /// send the decoding report and release the buffer
+  virtual void finalise(o2::framework::ProcessingContext& pc) = 0;
+
+  /// detectors which can be decoded in the reader
+  static o2::detectors::DetID::mask_t getSupportedMask();
+  static std::vector<o2::framework::OutputSpec> getOutputs(o2::detectors::DetID det);
+  static std::unique_ptr<CTFIntegratedDecoder> create(o2::detectors::DetID det, int verbosity);
+
+ protected:
+  o2::detectors::DetID mDet;
+  gsl::span<const uint8_t> mImage{}; // flat EncodedBlocks image to decode
+};
+
+} // namespace ctf
+} // namespace o2
+
+#endif
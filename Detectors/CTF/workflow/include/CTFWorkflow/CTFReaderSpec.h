@@ -26,11 +26,13 @@ namespace ctf
 struct CTFReaderInp {
   std::string inpdata{};
   o2::detectors::DetID::mask_t detMask = o2::detectors::DetID::FullMask;
+  o2::detectors::DetID::mask_t decodeDetMask{}; // detectors entropy-decoded in the reader itself
   std::string copyCmd{};
   std::string tffileRegex{};
   std::string remoteRegex{};
   std::string metricChannel{};
   std::string fileIRFrames{};
+  std::string decoderDict{"ccdb"}; // CTF dictionary for the detectors decoded in the reader
   std::vector<int> ctfIDs{};
   bool skipSkimmedOutTF = false;
   bool allowMissingDetectors = false;
@@ -43,6 +45,8 @@ struct CTFReaderInp {
   unsigned int subspec = 0;
   unsigned int decSSpecEMC = 0;
   int tfRateLimit = -999;
+  int nDecoderThreads = 1;
+  int decoderVerbosity = 0;
   size_t minSHM = 0;
 };
 
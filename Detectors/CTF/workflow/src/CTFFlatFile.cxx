@@ -0,0 +1,177 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFFlatFile.cxx
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fmt/format.h>
+
+#include "CTFWorkflow/CTFFlatFile.h"
+
+namespace o2
+{
+namespace ctf
+{
+
+using DetID = o2::detectors::DetID;
+
+namespace
+{
+constexpr size_t alignUp(size_t size) { return (size + CTFFlatEntryHeader::Alignment - 1) & ~(CTFFlatEntryHeader::Alignment - 1); }
+} // namespace
+
+///_______________________________________
+CTFFlatFileWriter::CTFFlatFileWriter(const std::string& name) : mName(name)
+{
+  mFile = std::fopen(name.c_str(), "wb");
+  if (!mFile) {
+    throw std::runtime_error(fmt::format("failed to open {} for writing: {}", name, std::strerror(errno)));
+  }
+}
+
+///_______________________________________
+void CTFFlatFileWriter::addDetector(DetID det, const void* data, size_t size)
+{
+  mImages[det] = {reinterpret_cast<const BufferType*>(data), size};
+}
+
+///_______________________________________
+size_t CTFFlatFileWriter::writeEntry(CTFHeader header)
+{
+  static const std::array<char, CTFFlatEntryHeader::Alignment> padding{};
+  CTFFlatEntryHeader entry;
+  size_t offset = alignUp(sizeof(CTFFlatEntryHeader));
+  header.detectors.reset();
+  for (int id = DetID::First; id <= DetID::Last; id++) {
+    if (!mImages[id].empty()) {
+      header.detectors.set(id);
+      entry.offsets[id] = offset;
+      entry.sizes[id] = mImages[id].size();
+      offset = alignUp(offset + mImages[id].size());
+    }
+  }
+  entry.ctfHeader = header;
+  entry.size = offset;
+
+  auto write = [this](const void* data, size_t size) {
+    if (size && std::fwrite(data, 1, size, mFile) != size) {
+      throw std::runtime_error(fmt::format("failed to write {} bytes to {}: {}", size, mName, std::strerror(errno)));
+    }
+  };
+  write(&entry, sizeof(CTFFlatEntryHeader));
+  size_t written = sizeof(CTFFlatEntryHeader);
+  for (int id = DetID::First; id <= DetID::Last; id++) {
+    if (entry.sizes[id]) {
+      write(padding.data(), entry.offsets[id] - written);
+      write(mImages[id].data(), mImages[id].size());
+      written = entry.offsets[id] + mImages[id].size();
+    }
+    mImages[id] = {};
+  }
+  write(padding.data(), entry.size - written);
+  mNEntries++;
+  mSize += entry.size;
+  return entry.size;
+}
+
+///_______________________________________
+void CTFFlatFileWriter::close()
+{
+  if (mFile) {
+    std::fclose(mFile);
+    mFile = nullptr;
+  }
+}
+
+///_______________________________________
+void CTFFlatFileReader::open(const std::string& name)
+{
+  close();
+  int fd = ::open(name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(fmt::format("failed to open {}: {}", name, std::strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error(fmt::format("failed to stat {} or it is empty", name));
+  }
+  void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error(fmt::format("failed to map {}: {}", name, std::strerror(errno)));
+  }
+  madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+  mName = name;
+  mData = reinterpret_cast<const BufferType*>(ptr);
+  mSize = st.st_size;
+  // index the entries, only the headers are touched
+  size_t offset = 0;
+  while (offset + sizeof(CTFFlatEntryHeader) <= mSize) {
+    const auto& entry = *reinterpret_cast<const CTFFlatEntryHeader*>(mData + offset);
+    if (entry.magic != CTFFlatEntryHeader::Magic || entry.size < sizeof(CTFFlatEntryHeader) || offset + entry.size > mSize) {
+      break;
+    }
+    mEntries.push_back(offset);
+    offset += entry.size;
+  }
+  if (offset != mSize) {
+    auto nGood = mEntries.size();
+    close();
+    throw std::runtime_error(fmt::format("{} is truncated or corrupted after {} entries", name, nGood));
+  }
+}
+
+///_______________________________________
+void CTFFlatFileReader::close()
+{
+  if (mData) {
+    munmap(const_cast<BufferType*>(mData), mSize);
+  }
+  mData = nullptr;
+  mSize = 0;
+  mEntries.clear();
+}
+
+///_______________________________________
+gsl::span<const BufferType> CTFFlatFileReader::getDetector(long entry, DetID det) const
+{
+  const auto& header = getEntry(entry);
+  if (!header.sizes[det]) {
+    return {};
+  }
+  if (header.offsets[det] + header.sizes[det] > header.size) {
+    throw std::runtime_error(fmt::format("corrupted {} image in entry {} of {}", det.getName(), entry, mName));
+  }
+  return {mData + mEntries[entry] + header.offsets[det], header.sizes[det]};
+}
+
+///_______________________________________
+bool CTFFlatFileReader::isFlatFile(const std::string& name)
+{
+  uint64_t magic = 0;
+  auto* fl = std::fopen(name.c_str(), "rb");
+  if (!fl) {
+    return false;
+  }
+  bool ok = std::fread(&magic, sizeof(magic), 1, fl) == 1 && magic == CTFFlatEntryHeader::Magic;
+  std::fclose(fl);
+  return ok;
+}
+
+} // namespace ctf
+} // namespace o2
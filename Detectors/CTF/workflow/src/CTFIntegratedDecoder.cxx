@@ -0,0 +1,155 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   CTFIntegratedDecoder.cxx
+
+#include <TTree.h>
+#include <TStopwatch.h>
+
+#include "CTFWorkflow/CTFIntegratedDecoder.h"
+#include "CCDB/BasicCCDBManager.h"
+#include "Framework/ProcessingContext.h"
+#include "Framework/DataAllocator.h"
+#include "Framework/DataRefUtils.h"
+#include "Framework/Logger.h"
+#include "DetectorsCommonDataFormats/CTFIOSize.h"
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DataFormatsITSMFT/CTF.h"
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "ITSMFTReconstruction/CTFCoder.h"
+#include "ITSMFTReconstruction/LookUp.h"
+
+using namespace o2::framework;
+
+namespace o2
+{
+namespace ctf
+{
+
+namespace
+{
+/// ITS or MFT compact clusters, as produced by the ITSMFT entropy decoder without noise masking
+class ITSMFTIntegratedDecoder final : public CTFIntegratedDecoder
+{
+ public:
+  ITSMFTIntegratedDecoder(DetID det, int verbosity) : CTFIntegratedDecoder(det), mCoder(o2::ctf::CTFCoderBase::OpType::Decoder, det)
+  {
+    mCoder.setVerbosity(verbosity);
+    mTimer.Stop();
+    mTimer.Reset();
+  }
+
+  ~ITSMFTIntegratedDecoder() final
+  {
+    LOGP(info, "{} integrated entropy decoding total timing: Cpu: {:.3e} Real: {:.3e} s", mDet.getName(), mTimer.CpuTime(), mTimer.RealTime());
+  }
+
+  void loadDictionary(const std::string& dict, long timestamp) final
+  {
+    if (dict.empty() || dict == "ccdb") {
+      const auto path = fmt::format("{}/Calib/CTFDictionaryTree", mDet.getName());
+      auto* tree = o2::ccdb::BasicCCDBManager::instance().getForTimeStamp<TTree>(path, timestamp);
+      if (!tree) {
+        throw std::runtime_error(fmt::format("failed to fetch {} for timestamp {}", path, timestamp));
+      }
+      ConcreteDataMatcher matcher(mDet.getDataOrigin(), "CTFDICT", 0);
+      mCoder.finaliseCCDB<o2::itsmft::CTF>(matcher, tree);
+    } else if (dict != "none") {
+      mCoder.createCodersFromFile<o2::itsmft::CTF>(dict, o2::ctf::CTFCoderBase::OpType::Decoder);
+      LOGP(info, "Loaded {} from {}", mCoder.getExtDictHeader().asString(), dict);
+    } else {
+      LOGP(info, "{}: internal per-TF CTF Dict will be used", mDet.getName());
+    }
+  }
+
+  void read(TTree& tree, long entry, bool present) final
+  {
+    mBuffer.clear();
+    if (present) {
+      o2::itsmft::CTF::readFromTree(mBuffer, tree, mDet.getName(), entry);
+    }
+    mImage = {mBuffer.data(), mBuffer.size()};
+  }
+
+  void prepareOutputs(ProcessingContext& pc) final
+  {
+    const auto orig = mDet.getDataOrigin();
+    mROFs = &pc.outputs().make<std::vector<o2::itsmft::ROFRecord>>(Output{orig, "CLUSTERSROF", 0});
+    mClusters = &pc.outputs().make<std::vector<o2::itsmft::CompClusterExt>>(Output{orig, "COMPCLUSTERS", 0});
+    mPatterns = &pc.outputs().make<std::vector<unsigned char>>(Output{orig, "PATTERNS", 0});
+  }
+
+  void decode() final
+  {
+    mIOSize = {};
+    if (mImage.empty()) {
+      return;
+    }
+    auto cput = mTimer.CpuTime();
+    mTimer.Start(false);
+    mIOSize = mCoder.decode(o2::itsmft::CTF::getImage(mImage.data()), *mROFs, *mClusters, *mPatterns, nullptr, mPattIdConverter);
+    mTimer.Stop();
+    LOGP(info, "Decoded {} {} clusters in {} RO frames, ({}) in {} s", mClusters->size(), mDet.getName(), mROFs->size(), mIOSize.asString(), mTimer.CpuTime() - cput);
+  }
+
+  void finalise(ProcessingContext& pc) final
+  {
+    pc.outputs().snapshot(Output{mDet.getDataOrigin(), "CTFDECREP", 0}, mIOSize);
+    mROFs = nullptr;
+    mClusters = nullptr;
+    mPatterns = nullptr;
+    mImage = {};
+  }
+
+ private:
+  o2::itsmft::CTFCoder mCoder;
+  o2::itsmft::LookUp mPattIdConverter; // no cluster dictionary: patterns are not needed to be converted, only decoded
+  std::vector<o2::ctf::BufferType> mBuffer;
+  std::vector<o2::itsmft::ROFRecord>* mROFs = nullptr;
+  std::vector<o2::itsmft::CompClusterExt>* mClusters = nullptr;
+  std::vector<unsigned char>* mPatterns = nullptr;
+  o2::ctf::CTFIOSize mIOSize{};
+  TStopwatch mTimer;
+};
+} // namespace
+
+///_______________________________________
+DetID::mask_t CTFIntegratedDecoder::getSupportedMask()
+{
+  return DetID::getMask(DetID::ITS) | DetID::getMask(DetID::MFT);
+}
+
+///_______________________________________
+std::vector<OutputSpec> CTFIntegratedDecoder::getOutputs(DetID det)
+{
+  std::vector<OutputSpec> outputs;
+  const auto orig = det.getDataOrigin();
+  if (det == DetID::ITS || det == DetID::MFT) {
+    outputs.emplace_back(OutputSpec{orig, "COMPCLUSTERS", 0, Lifetime::Timeframe});
+    outputs.emplace_back(OutputSpec{orig, "CLUSTERSROF", 0, Lifetime::Timeframe});
+    outputs.emplace_back(OutputSpec{orig, "PATTERNS", 0, Lifetime::Timeframe});
+  }
+  outputs.emplace_back(OutputSpec{orig, "CTFDECREP", 0, Lifetime::Timeframe});
+  return outputs;
+}
+
+///_______________________________________
+std::unique_ptr<CTFIntegratedDecoder> CTFIntegratedDecoder::create(DetID det, int verbosity)
+{
+  if (det == DetID::ITS || det == DetID::MFT) {
+    return std::make_unique<ITSMFTIntegratedDecoder>(det, verbosity);
+  }
+  throw std::runtime_error(fmt::format("Decoding of {} in the CTF reader is not supported", det.getName()));
+}
+
+} // namespace ctf
+} // namespace o2
@@ -11,6 +11,10 @@
 
 /// @file   CTFReaderSpec.cxx
 
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <thread>
 #include <vector>
 #include <TFile.h>
 #include <TTree.h>
@@ -26,6 +30,8 @@
 #include "CommonUtils/IRFrameSelector.h"
 #include "DetectorsRaw/HBFUtils.h"
 #include "CTFWorkflow/CTFReaderSpec.h"
+#include "CTFWorkflow/CTFIntegratedDecoder.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/EncodedBlocks.h"
 #include "CommonUtils/NameConf.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
@@ -87,13 +93,20 @@ class CTFReaderSpec : public o2::framework::Task
   void stopReader();
   template <typename C>
   void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
+  void decodeIntegrated(const CTFHeader& ctfHeader, ProcessingContext& pc);
   void setMessageHeader(ProcessingContext& pc, const CTFHeader& ctfHeader, const std::string& lbl, unsigned subspec) const; // keep just for the reference
   void tryToFixCTFHeader(CTFHeader& ctfHeader) const;
+  void closeInput();
+  long getNInputEntries() const { return mCTFFlat ? mCTFFlat->getNEntries() : mCTFTree->GetEntries(); }
+  std::string getInputName() const { return mCTFFlat ? mCTFFlat->getName() : mCTFFile->GetName(); }
   CTFReaderInp mInput{};
   o2::utils::IRFrameSelector mIRFrameSelector; // optional IR frames selector
+  std::vector<std::unique_ptr<CTFIntegratedDecoder>> mDecoders; // decoders of the detectors requested in mInput.decodeDetMask
+  bool mDecoderDictsLoaded = false;
   std::unique_ptr<o2::utils::FileFetcher> mFileFetcher;
   std::unique_ptr<TFile> mCTFFile;
   std::unique_ptr<TTree> mCTFTree;
+  std::unique_ptr<CTFFlatFileReader> mCTFFlat; // set instead of mCTFFile/mCTFTree for the flat format
   bool mRunning = false;
   bool mUseLocalTFCounter = false;
   int mCTFCounter = 0;
@@ -134,11 +147,18 @@ void CTFReaderSpec::stopReader()
   mRunning = false;
   mFileFetcher->stop();
   mFileFetcher.reset();
+  closeInput();
+}
+
+///_______________________________________
+void CTFReaderSpec::closeInput()
+{
   mCTFTree.reset();
   if (mCTFFile) {
     mCTFFile->Close();
   }
   mCTFFile.reset();
+  mCTFFlat.reset();
 }
 
 ///_______________________________________
@@ -160,6 +180,14 @@ void CTFReaderSpec::init(InitContext& ic)
     mTFLength = hbfu.nHBFPerTF;
     LOGP(info, "IRFrames will be selected from {}, assumed TF length: {} HBF", mInput.fileIRFrames, mTFLength);
   }
+  for (auto id = DetID::First; id <= DetID::Last; id++) {
+    if (mInput.decodeDetMask[id]) {
+      mDecoders.emplace_back(CTFIntegratedDecoder::create(DetID(id), mInput.decoderVerbosity));
+    }
+  }
+  if (!mDecoders.empty()) {
+    LOGP(info, "{} will be entropy-decoded by the reader using {} threads", DetID::getNames(mInput.decodeDetMask), std::min(size_t(std::max(1, mInput.nDecoderThreads)), mDecoders.size()));
+  }
 }
 
 ///_______________________________________
@@ -167,6 +195,15 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
 {
   try {
     mFilesRead++;
+    if (CTFFlatFileReader::isFlatFile(flname)) {
+      mCTFFlat = std::make_unique<CTFFlatFileReader>();
+      mCTFFlat->open(flname);
+      if (mCTFFlat->getNEntries() < 1) {
+        throw std::runtime_error(fmt::format("flat CTF file {} has 0 entries, skipping", flname));
+      }
+      mCurrTreeEntry = 0;
+      return;
+    }
     mCTFFile.reset(TFile::Open(flname.c_str()));
     if (!mCTFFile || !mCTFFile->IsOpen() || mCTFFile->IsZombie()) {
       throw std::runtime_error(fmt::format("failed to open CTF file {}, skipping", flname));
@@ -180,8 +217,7 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     }
   } catch (const std::exception& e) {
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
-    mCTFTree.reset();
-    mCTFFile.reset();
+    closeInput();
     mNFailedFiles++;
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
@@ -201,7 +237,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   long startWait = 0;
 
   while (mRunning) {
-    if (mCTFTree) { // there is a tree open with multiple CTF
+    if (mCTFTree || mCTFFlat) { // there is a tree open with multiple CTF
       if (mInput.ctfIDs.empty() || mInput.ctfIDs[mSelIDEntry] == mCTFCounter) { // no selection requested or matching CTF ID is found
         LOG(debug) << "TF " << mCTFCounter << " of " << mInput.maxTFs << " loop " << mFileFetcher->getNLoops();
         mSelIDEntry++;
@@ -210,7 +246,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
         }
       }
       // explict CTF ID selection list or IRFrame was provided and current entry is not selected
-      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, getNInputEntries(), getInputName());
       checkTreeEntries();
       mCTFCounter++;
       continue;
@@ -244,7 +280,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
   if (mCTFCounter >= mInput.maxTFs || (!mInput.ctfIDs.empty() && mSelIDEntry >= mInput.ctfIDs.size())) { // done
     LOGP(info, "All CTFs from selected range were injected, stopping");
     mRunning = false;
-  } else if (mRunning && !mCTFTree && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
+  } else if (mRunning && !mCTFTree && !mCTFFlat && mFileFetcher->getNextFileInQueue().empty() && !mFileFetcher->isRunning()) { // previous tree was done, can we read more?
     mRunning = false;
   }
 
@@ -263,7 +299,9 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 
   static RateLimiter limiter;
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
+  if (mCTFFlat) {
+    ctfHeader = mCTFFlat->getHeader(mCurrTreeEntry);
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   if (mImposeRunStartMS > 0) {
@@ -325,6 +363,7 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
   processDetector<o2::cpv::CTF>(DetID::CPV, ctfHeader, pc);
   processDetector<o2::zdc::CTF>(DetID::ZDC, ctfHeader, pc);
   processDetector<o2::ctp::CTF>(DetID::CTP, ctfHeader, pc);
+  decodeIntegrated(ctfHeader, pc);
 
   // send sTF acknowledge message
   if (!mInput.sup0xccdb) {
@@ -334,7 +373,7 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
     stfDist.runNumber = uint32_t(ctfHeader.run);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, getNInputEntries(), getInputName());
   checkTreeEntries();
   mTimer.Stop();
 
@@ -360,10 +399,8 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 void CTFReaderSpec::checkTreeEntries()
 {
   // check if the tree has entries left, if needed, close current tree/file
-  if (++mCurrTreeEntry >= mCTFTree->GetEntries()) { // this file is done, check if there are other files
-    mCTFTree.reset();
-    mCTFFile->Close();
-    mCTFFile.reset();
+  if (++mCurrTreeEntry >= getNInputEntries()) { // this file is done, check if there are other files
+    closeInput();
     if (mFileFetcher) {
       mFileFetcher->popFromQueue(mInput.maxLoops < 1);
     }
@@ -389,8 +426,17 @@ void CTFReaderSpec::setMessageHeader(ProcessingContext& pc, const CTFHeader& ctf
 template <typename C>
 void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const
 {
-  if (mInput.detMask[det]) {
+  if (mInput.detMask[det] && !mInput.decodeDetMask[det]) {
     const auto lbl = det.getName();
+    if (mCTFFlat) { // the flat image is already in the final format, just copy it from the mapping
+      auto image = mCTFFlat->getDetector(mCurrTreeEntry, det);
+      if (image.empty() && !mInput.allowMissingDetectors) {
+        throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", lbl));
+      }
+      auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, image.size());
+      std::memcpy(bufVec.data(), image.data(), image.size());
+      return;
+    }
     auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
     if (ctfHeader.detectors[det]) {
       C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
@@ -401,6 +447,67 @@ void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, Proce
   }
 }
 
+///_______________________________________
+void CTFReaderSpec::decodeIntegrated(const CTFHeader& ctfHeader, ProcessingContext& pc)
+{
+  if (mDecoders.empty()) {
+    return;
+  }
+  if (!mDecoderDictsLoaded) {
+    for (auto& dec : mDecoders) {
+      dec->loadDictionary(mInput.decoderDict, ctfHeader.creationTime);
+    }
+    mDecoderDictsLoaded = true;
+  }
+  // ROOT IO and the DPL allocator are used from this thread only
+  for (auto& dec : mDecoders) {
+    const auto det = dec->getDet();
+    if (!ctfHeader.detectors[det] && !mInput.allowMissingDetectors) {
+      throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", det.getName()));
+    }
+    if (mCTFFlat) {
+      dec->setImage(mCTFFlat->getDetector(mCurrTreeEntry, det)); // decoded directly from the mapping
+    } else {
+      dec->read(*(mCTFTree.get()), mCurrTreeEntry, ctfHeader.detectors[det]);
+    }
+    dec->prepareOutputs(pc);
+  }
+  const size_t nThreads = std::min(size_t(std::max(1, mInput.nDecoderThreads)), mDecoders.size());
+  if (nThreads < 2) {
+    for (auto& dec : mDecoders) {
+      dec->decode();
+    }
+  } else {
+    std::atomic<size_t> next{0};
+    std::vector<std::exception_ptr> errors(mDecoders.size());
+    auto worker = [this, &next, &errors]() {
+      for (size_t i = next++; i < mDecoders.size(); i = next++) {
+        try {
+          mDecoders[i]->decode();
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < nThreads; i++) {
+      pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+      thread.join();
+    }
+    for (auto& err : errors) {
+      if (err) {
+        std::rethrow_exception(err);
+      }
+    }
+  }
+  for (auto& dec : mDecoders) {
+    dec->finalise(pc);
+  }
+}
+
 ///_______________________________________
 void CTFReaderSpec::tryToFixCTFHeader(CTFHeader& ctfHeader) const
 {
@@ -459,7 +566,12 @@ DataProcessorSpec getCTFReaderSpec(const CTFReaderInp& inp)
   for (auto id = DetID::First; id <= DetID::Last; id++) {
     if (inp.detMask[id]) {
       DetID det(id);
-      outputs.emplace_back(OutputLabel{det.getName()}, det.getDataOrigin(), "CTFDATA", inp.subspec, Lifetime::Timeframe);
+      if (inp.decodeDetMask[id]) {
+        auto decOutputs = CTFIntegratedDecoder::getOutputs(det);
+        outputs.insert(outputs.end(), decOutputs.begin(), decOutputs.end());
+      } else {
+        outputs.emplace_back(OutputLabel{det.getName()}, det.getDataOrigin(), "CTFDATA", inp.subspec, Lifetime::Timeframe);
+      }
     }
   }
   if (!inp.fileIRFrames.empty()) {
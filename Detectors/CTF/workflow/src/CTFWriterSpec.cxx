@@ -23,6 +23,7 @@
 
 #include "DataFormatsParameters/GRPECSObject.h"
 #include "CTFWorkflow/CTFWriterSpec.h"
+#include "CTFWorkflow/CTFFlatFile.h"
 #include "DetectorsCommonDataFormats/CTFHeader.h"
 #include "CommonUtils/NameConf.h"
 #include "CommonUtils/FileSystemUtils.h"
@@ -113,6 +114,7 @@ class CTFWriterSpec : public o2::framework::Task
   template <typename C>
   void storeDictionary(DetID det, CTFHeader& header);
   void storeDictionaries();
+  void resetDictionaryStatistics();
   void closeTFTreeAndFile();
   void prepareTFTreeAndFile();
   size_t estimateCTFSize(ProcessingContext& pc);
@@ -125,6 +127,7 @@ class CTFWriterSpec : public o2::framework::Task
   bool mFinalized = false;
   bool mWriteCTF = true;
   bool mCreateDict = false;
+  bool mResetDictAfterSave = false; // restart the statistics after every stored dictionary version to follow the data drift
   bool mCreateRunEnvDir = true;
   bool mStoreMetaFile = false;
   bool mRejectCurrentTF = false;
@@ -152,6 +155,7 @@ class CTFWriterSpec : public o2::framework::Task
   int mRejRate = 0;                // CTF rejection rule (>0: percentage to reject randomly, <0: reject if timeslice%|value|!=0)
   int mCTFFileCompression = 0;     // CTF file compression level (if >= 0)
   bool mFillMD5 = false;
+  bool mFlatFormat = false;        // write the memory-mappable flat container instead of the CTF tree
   std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
   o2::framework::DataTakingContext mDataTakingContext{};
   o2::framework::TimingInfo mTimingInfo{};
@@ -170,6 +174,7 @@ class CTFWriterSpec : public o2::framework::Task
   int mLockFD = -1;
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
+  std::unique_ptr<o2::ctf::CTFFlatFileWriter> mCTFFlatOut;
 
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
@@ -220,8 +225,16 @@ void CTFWriterSpec::init(InitContext& ic)
   }
 
   mSaveDictAfter = ic.options().get<int>("save-dict-after");
+  mResetDictAfterSave = ic.options().get<bool>("reset-dict-after-save");
   mCTFAutoSave = ic.options().get<long>("save-ctf-after");
   mCTFFileCompression = ic.options().get<int>("ctf-file-compression");
+  auto fileFormat = ic.options().get<std::string>("ctf-file-format");
+  if (fileFormat == "flat") {
+    mFlatFormat = true;
+    LOG(info) << "CTFs will be written in the flat format";
+  } else if (fileFormat != "root") {
+    throw std::invalid_argument("Invalid ctf-file-format, must be root or flat");
+  }
   mCTFMetaFileDir = ic.options().get<std::string>("meta-output-dir");
   if (mCTFMetaFileDir != "/dev/null") {
     mCTFMetaFileDir = o2::utils::Str::rectifyDirectory(mCTFMetaFileDir);
@@ -314,7 +327,12 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     const auto ctfImage = C::getImage(bdata);
     ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
     if (mWriteCTF && !mRejectCurrentTF) {
-      sz = ctfImage.appendToTree(*tree, det.getName());
+      if (mFlatFormat) { // the input is already the final flat image
+        mCTFFlatOut->addDetector(det, bdata, ctfBuffer.size());
+        sz = ctfBuffer.size();
+      } else {
+        sz = ctfImage.appendToTree(*tree, det.getName());
+      }
       header.detectors.set(det);
     } else {
       sz = ctfBuffer.size();
@@ -400,7 +418,7 @@ void CTFWriterSpec::storeDictionary(DetID det, CTFHeader& header)
   flout.WriteObject(&hb, fmt::format("ctf_dict_header_{}", det.getName()).c_str());
   flout.Close();
   LOGP(info, "Saved {} with {} TFs to {}", hb.asString(), mNCTF, outName);
-  if (mPrevDictTimeStamp) {
+  if (mPrevDictTimeStamp && !mResetDictAfterSave) { // the versions built from distinct TFs may be needed for decoding
     auto outNamePrev = getFileName(false);
     if (std::filesystem::exists(outNamePrev)) {
       std::filesystem::remove(outNamePrev);
@@ -445,7 +463,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
       constexpr size_t MB = 1024 * 1024;
       constexpr int showFirstN = 10, prsecaleWarnings = 50;
       try {
-        const auto si = std::filesystem::space(mCTFFileOut->GetName());
+        const auto si = std::filesystem::space(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding));
         std::string wmsg{};
         if (mCheckDiskFull > 0.f && si.available < mCheckDiskFull) {
           nwaitCycles++;
@@ -476,6 +494,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   }
   // create header
   CTFHeader header{mTimingInfo.runNumber, mTimingInfo.creation, mTimingInfo.firstTForbit, mTimingInfo.tfCounter};
+  header.dictTimeStamp = mDictTimeStamp;
   size_t szCTF = 0;
   mSizeReport = "";
   std::array<size_t, DetID::CTP + 1> szCTFperDet{0}; // DetID::TST is between FDD and CTP and remains empty
@@ -503,10 +522,17 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF && !mRejectCurrentTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    if (mFlatFormat) {
+      szCTF = mCTFFlatOut->writeEntry(header);
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+    }
     size_t prevSizeMB = mAccCTFSize / (1 << 20);
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
+    ++mNAccCTF;
+    if (mCTFTreeOut) {
+      mCTFTreeOut->SetEntries(mNAccCTF);
+    }
     mTFOrbits.push_back(mTimingInfo.firstTForbit);
     LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
@@ -522,7 +548,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
 
     if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
       closeTFTreeAndFile();
-    } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
+    } else if (mCTFTreeOut && ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave)))) {
       mCTFTreeOut->AutoSave("override");
     }
   } else {
@@ -532,6 +558,9 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mNCTF++;
   if (mCreateDict && mSaveDictAfter > 0 && (mNCTF % mSaveDictAfter) == 0) {
     storeDictionaries();
+    if (mResetDictAfterSave) {
+      resetDictionaryStatistics();
+    }
   }
   int dummy = 0;
   pc.outputs().snapshot({"ctfdone", 0}, dummy);
@@ -544,7 +573,7 @@ void CTFWriterSpec::finalize()
   if (mFinalized) {
     return;
   }
-  if (mCreateDict) {
+  if (mCreateDict && mNCTF != mNCTFPrevDict) { // don't overwrite the last version if no new data was collected
     storeDictionaries();
   }
   if (mWriteCTF) {
@@ -564,7 +593,7 @@ void CTFWriterSpec::prepareTFTreeAndFile()
     return;
   }
   bool needToOpen = false;
-  if (!mCTFTreeOut) {
+  if (!mCTFTreeOut && !mCTFFlatOut) {
     needToOpen = true;
   } else {
     if ((mAccCTFSize >= mMinSize) ||                                                         // min size exceeded, may close the file.
@@ -596,12 +625,19 @@ void CTFWriterSpec::prepareTFTreeAndFile()
       }
     }
     mCurrentCTFFileName = o2::base::NameConf::getCTFFileName(mTimingInfo.runNumber, mTimingInfo.firstTForbit, mTimingInfo.tfCounter, mHostName);
+    if (mFlatFormat) {
+      mCurrentCTFFileName = o2::utils::Str::concat_string(mCurrentCTFFileName.substr(0, mCurrentCTFFileName.rfind(".root")), ".ctf");
+    }
     mCurrentCTFFileNameFull = fmt::format("{}{}", ctfDir, mCurrentCTFFileName);
-    mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
-    if (mCTFFileCompression >= 0) {
-      mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+    if (mFlatFormat) {
+      mCTFFlatOut = std::make_unique<o2::ctf::CTFFlatFileWriter>(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding));
+    } else {
+      mCTFFileOut.reset(TFile::Open(fmt::format("{}{}", mCurrentCTFFileNameFull, TMPFileEnding).c_str(), "recreate")); // to prevent premature external usage, use temporary name
+      if (mCTFFileCompression >= 0) {
+        mCTFFileOut->SetCompressionLevel(mCTFFileCompression);
+      }
+      mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
     }
-    mCTFTreeOut = std::make_unique<TTree>(std::string(o2::base::NameConf::CTFTREENAME).c_str(), "O2 CTF tree");
 
     mNCTFFiles++;
   }
@@ -610,13 +646,18 @@ void CTFWriterSpec::prepareTFTreeAndFile()
 //___________________________________________________________________
 void CTFWriterSpec::closeTFTreeAndFile()
 {
-  if (mCTFTreeOut) {
+  if (mCTFTreeOut || mCTFFlatOut) {
     try {
-      mCTFFileOut->cd();
-      mCTFTreeOut->Write();
-      mCTFTreeOut.reset();
-      mCTFFileOut->Close();
-      mCTFFileOut.reset();
+      if (mCTFFlatOut) {
+        mCTFFlatOut->close();
+        mCTFFlatOut.reset();
+      } else {
+        mCTFFileOut->cd();
+        mCTFTreeOut->Write();
+        mCTFTreeOut.reset();
+        mCTFFileOut->Close();
+        mCTFFileOut.reset();
+      }
       // write CTF file metaFile data
       auto actualFileName = TMPFileEnding.empty() ? mCurrentCTFFileNameFull : o2::utils::Str::concat_string(mCurrentCTFFileNameFull, TMPFileEnding);
       if (mStoreMetaFile) {
@@ -695,7 +736,7 @@ void CTFWriterSpec::storeDictionaries()
   }
   std::filesystem::create_symlink(dictFileName, dictFileNameLnk);
   LOGP(info, "Saved CTF dictionaries tree with {} TFs to {} and linked to {}", mNCTF, dictFileName, dictFileNameLnk);
-  if (mPrevDictTimeStamp) {
+  if (mPrevDictTimeStamp && !mResetDictAfterSave) {
     auto dictFileNamePrev = getFileName(false);
     if (std::filesystem::exists(dictFileNamePrev)) {
       std::filesystem::remove(dictFileNamePrev);
@@ -706,6 +747,20 @@ void CTFWriterSpec::storeDictionaries()
   mPrevDictTimeStamp = mDictTimeStamp;
 }
 
+//___________________________________________________________________
+void CTFWriterSpec::resetDictionaryStatistics()
+{
+  // the 1st headers are kept, the next version will be built from the TFs to come
+  for (auto& freqs : mFreqsAccumulation) {
+    freqs.clear();
+  }
+  for (auto& md : mFreqsMetaData) {
+    md.clear();
+  }
+  std::for_each(mIsSaturatedFrequencyTable.begin(), mIsSaturatedFrequencyTable.end(), [](auto& bitset) { bitset.reset(); });
+  LOGP(info, "Reset CTF dictionaries statistics after {} TFs", mNCTF);
+}
+
 //___________________________________________________________________
 void CTFWriterSpec::createLockFile(int level)
 {
@@ -807,6 +862,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
     Options{                                                                               //{"output-type", VariantType::String, "ctf", {"output types: ctf (per TF) or dict (create dictionaries) or both or none"}},
             {"save-ctf-after", VariantType::Int64, 0ll, {"autosave CTF tree with multiple CTFs after every N CTFs if >0 or every -N MBytes if < 0"}},
             {"save-dict-after", VariantType::Int, 0, {"if > 0, in dictionary generation mode save it dictionary after certain number of TFs processed"}},
+            {"reset-dict-after-save", VariantType::Bool, false, {"with save-dict-after, build every dictionary version only from the TFs since the previous one"}},
             {"ctf-dict-dir", VariantType::String, "none", {"CTF dictionary directory, must exist"}},
             {"output-dir", VariantType::String, "none", {"CTF output directory, must exist"}},
             {"output-dir-alt", VariantType::String, "/dev/null", {"Alternative CTF output directory, must exist (if not /dev/null)"}},
@@ -817,6 +873,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
             {"ctf-rejection", VariantType::Int, 0, {">0: percentage to reject randomly, <0: reject if timeslice%|value|!=0"}},
             {"ctf-file-compression", VariantType::Int, 0, {"if >= 0: impose CTF file compression level"}},
+            {"ctf-file-format", VariantType::String, "root", {"CTF file format: root (CTF tree) or flat (memory-mappable container)"}},
             {"require-free-disk", VariantType::Float, 0.f, {"pause writing op. if available disk space is below this margin, in bytes if >0, as a fraction of total if <0"}},
             {"wait-for-free-disk", VariantType::Float, 10.f, {"if paused due to the low disk space, recheck after this time (in s)"}},
             {"max-wait-for-free-disk", VariantType::Float, 60.f, {"produce fatal if paused due to the low disk space for more than this amount in s."}},
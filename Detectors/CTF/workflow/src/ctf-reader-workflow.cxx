@@ -18,6 +18,7 @@
 #include "Framework/InputSpec.h"
 #include "CommonUtils/NameConf.h"
 #include "CTFWorkflow/CTFReaderSpec.h"
+#include "CTFWorkflow/CTFIntegratedDecoder.h"
 #include "DetectorsCommonDataFormats/DetID.h"
 #include "CommonUtils/ConfigurableParam.h"
 #include "Algorithm/RangeTokenizer.h"
@@ -58,7 +59,7 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"loop", VariantType::Int, 0, {"loop N times (infinite for N<0)"}});
   options.push_back(ConfigParamSpec{"delay", VariantType::Float, 0.f, {"delay in seconds between consecutive TFs sending"}});
   options.push_back(ConfigParamSpec{"copy-cmd", VariantType::String, "alien_cp ?src file://?dst", {"copy command for remote files or no-copy to avoid copying"}}); // Use "XrdSecPROTOCOL=sss,unix xrdcp -N root://eosaliceo2.cern.ch/?src ?dst" for direct EOS access
-  options.push_back(ConfigParamSpec{"ctf-file-regex", VariantType::String, ".*o2_ctf_run.+\\.root$", {"regex string to identify CTF files"}});
+  options.push_back(ConfigParamSpec{"ctf-file-regex", VariantType::String, ".*o2_ctf_run.+\\.(root|ctf)$", {"regex string to identify CTF files"}});
   options.push_back(ConfigParamSpec{"remote-regex", VariantType::String, "^(alien://|)/alice/data/.+", {"regex string to identify remote files"}}); // Use "^/eos/aliceo2/.+" for direct EOS access
   options.push_back(ConfigParamSpec{"max-cached-files", VariantType::Int, 3, {"max CTF files queued (copied for remote source)"}});
   options.push_back(ConfigParamSpec{"allow-missing-detectors", VariantType::Bool, false, {"send empty message if detector is missing in the CTF (otherwise throw)"}});
@@ -74,6 +75,10 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   //
   options.push_back(ConfigParamSpec{"emcal-decoded-subspec", VariantType::Int, 0, {"subspec to use for decoded EMCAL data"}});
   //
+  options.push_back(ConfigParamSpec{"decode-in-reader", VariantType::String, std::string{DetID::NONE}, {"comma-separated list of detectors to entropy-decode in the reader device (supported: ITS,MFT clusters)"}});
+  options.push_back(ConfigParamSpec{"reader-decoder-threads", VariantType::Int, 1, {"number of threads for the detectors decoded in the reader"}});
+  options.push_back(ConfigParamSpec{"reader-ctf-dict", VariantType::String, "ccdb", {"CTF dictionary for the detectors decoded in the reader: ccdb, none or local filename"}});
+  //
   options.push_back(ConfigParamSpec{"timeframes-shm-limit", VariantType::String, "0", {"Minimum amount of SHM required in order to publish data"}});
   options.push_back(ConfigParamSpec{"metric-feedback-channel-format", VariantType::String, "name=metric-feedback,type=pull,method=connect,address=ipc://{}metric-feedback-{},transport=shmem,rateLogging=0", {"format for the metric-feedback channel for TF rate limiting"}});
   options.push_back(ConfigParamSpec{"combine-devices", VariantType::Bool, false, {"combine multiple DPL devices (entropy decoders)"}});
@@ -130,6 +135,19 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   ctfInput.fileIRFrames = configcontext.options().get<std::string>("ir-frames-files");
   ctfInput.skipSkimmedOutTF = configcontext.options().get<bool>("skip-skimmed-out-tf");
   int verbosity = configcontext.options().get<int>("ctf-reader-verbosity");
+  ctfInput.decodeDetMask = DetID::getMask(configcontext.options().get<std::string>("decode-in-reader")) & ctfInput.detMask;
+  if ((ctfInput.decodeDetMask & ~o2::ctf::CTFIntegratedDecoder::getSupportedMask()).any()) {
+    throw std::runtime_error(fmt::format("decoding in the reader is supported only for {}", DetID::getNames(o2::ctf::CTFIntegratedDecoder::getSupportedMask())));
+  }
+  if (ctfInput.decodeDetMask[DetID::ITS] && configcontext.options().get<bool>("its-digits")) {
+    throw std::runtime_error("ITS digits cannot be produced by decoding in the reader");
+  }
+  if (ctfInput.decodeDetMask[DetID::MFT] && configcontext.options().get<bool>("mft-digits")) {
+    throw std::runtime_error("MFT digits cannot be produced by decoding in the reader");
+  }
+  ctfInput.nDecoderThreads = configcontext.options().get<int>("reader-decoder-threads");
+  ctfInput.decoderDict = configcontext.options().get<std::string>("reader-ctf-dict");
+  ctfInput.decoderVerbosity = verbosity;
 
   int rateLimitingIPCID = std::stoi(configcontext.options().get<std::string>("timeframes-rate-limit-ipcid"));
   std::string chanFmt = configcontext.options().get<std::string>("metric-feedback-channel-format");
@@ -171,10 +189,10 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   };
 
   // add decoders for all allowed detectors.
-  if (ctfInput.detMask[DetID::ITS]) {
+  if (ctfInput.detMask[DetID::ITS] && !ctfInput.decodeDetMask[DetID::ITS]) {
     addSpecs(o2::itsmft::getEntropyDecoderSpec(DetID::getDataOrigin(DetID::ITS), verbosity, configcontext.options().get<bool>("its-digits"), ctfInput.subspec));
   }
-  if (ctfInput.detMask[DetID::MFT]) {
+  if (ctfInput.detMask[DetID::MFT] && !ctfInput.decodeDetMask[DetID::MFT]) {
     addSpecs(o2::itsmft::getEntropyDecoderSpec(DetID::getDataOrigin(DetID::MFT), verbosity, configcontext.options().get<bool>("mft-digits"), ctfInput.subspec));
   }
   if (ctfInput.detMask[DetID::TPC]) {
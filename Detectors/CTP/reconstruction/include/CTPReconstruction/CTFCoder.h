@@ -73,7 +73,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const CTPDigit>&
   if (mIRFrameSelector.isSet()) { // preselect data
     mDataFilt.clear();
     for (const auto& trig : data) {
-      if (mIRFrameSelector.check(trig.intRecord) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.intRecord)) {
         mDataFilt.push_back(trig);
       }
     }
@@ -22,6 +22,7 @@
 #include <TFile.h>
 #include <filesystem>
 #include <deque>
+#include <future>
 #include <gsl/gsl>
 #include <limits>
 #include <type_traits>
@@ -97,6 +98,19 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  /// Finalize the closed slots on a worker thread while the following TFs keep filling the open slots.
+  /// The slots are finalized one after the other in the order they were closed, so the outputs keep their order.
+  /// The outputs of the calibrator must only be accessed (and reset with initOutput()) when isFinalizationDone() returns true,
+  /// the finalizeSlot() of the derived class must not access data modified by the filling of the open slots.
+  void setAsyncFinalization(bool v = true) { mAsyncFinalization = v; }
+  bool isAsyncFinalization() const { return mAsyncFinalization; }
+
+  /// return true if no slot is being finalized in the background: the outputs can be accessed
+  bool isFinalizationDone();
+
+  /// wait until all closed slots are finalized, e.g. at the end of the run
+  void waitForFinalization();
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -111,6 +125,7 @@ class TimeSlotCalibration
 
   virtual void reset()
   { // reset to virgin state (need for start - stop - start)
+    waitForFinalization();
     mSlots.clear();
     mLastClosedTF = 0;
     mFirstTF = 0;
@@ -220,7 +235,16 @@ class TimeSlotCalibration
 
   TFType tf2SlotMin(TFType tf) const;
 
+  // finalize the slot directly or move it to the queue of the asynchronous finalization, the slot has to be removed afterwards
+  void finalizeOrQueueSlot(Slot& slot);
+  // start the asynchronous finalization of the queued slots if the previous one is done
+  void launchFinalization();
+
   std::deque<Slot> mSlots;
+  std::deque<Slot> mSlotsToFinalize;     //! closed slots waiting for the asynchronous finalization
+  std::deque<Slot> mSlotsInFinalization; //! slots being finalized asynchronously
+  std::future<void> mFinalization;       //! asynchronous finalization of mSlotsInFinalization
+  bool mAsyncFinalization = false;       // finalize closed slots on a worker thread
 
   o2::dataformats::TFIDInfo mCurrentTFInfo{};
   int mSlotLengthInSeconds = -1; // optionally provided slot length in seconds
@@ -299,6 +323,9 @@ template <typename Container>
 void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDelay)
 {
   // Check which slots can be finalized, provided the newly arrived TF is tf
+  if (mAsyncFinalization) {
+    launchFinalization(); // start the slots queued while the previous finalization was running
+  }
 
   // if slot finalization is asked as soon as the slot is ready, we need to check if we got enough statistics, and if so, redefine the slot
   if (mSlots.size() == 1 && mFinalizeWhenReady) {
@@ -320,7 +347,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        finalizeOrQueueSlot(mSlots[0]);           // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() < INFINITE_TF ? (mSlots[0].getTFEnd() + 1) : mSlots[0].getTFEnd() < INFINITE_TF; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
@@ -344,7 +371,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       if (tfLim < tf) {
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          finalizeOrQueueSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -372,11 +399,73 @@ void TimeSlotCalibration<Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  finalizeOrQueueSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
 }
 
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::finalizeOrQueueSlot(Slot& slot)
+{
+  if (!mAsyncFinalization) {
+    finalizeSlot(slot);
+    return;
+  }
+  // the moved-from slot keeps its boundaries until it is removed by the caller
+  mSlotsToFinalize.push_back(std::move(slot));
+  launchFinalization();
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::launchFinalization()
+{
+  if (mFinalization.valid()) {
+    if (mFinalization.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return;
+    }
+    mFinalization.get(); // rethrows exceptions of the finalization
+    mSlotsInFinalization.clear();
+  }
+  if (mSlotsToFinalize.empty()) {
+    return;
+  }
+  mSlotsInFinalization.swap(mSlotsToFinalize);
+  mFinalization = std::async(std::launch::async, [this]() {
+    for (auto& slot : mSlotsInFinalization) {
+      LOG(debug) << "Finalizing asynchronously slot for " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
+      finalizeSlot(slot);
+    }
+  });
+}
+
+//_________________________________________________
+template <typename Container>
+bool TimeSlotCalibration<Container>::isFinalizationDone()
+{
+  if (mFinalization.valid()) {
+    if (mFinalization.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return false;
+    }
+    mFinalization.get();
+    mSlotsInFinalization.clear();
+  }
+  return true;
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::waitForFinalization()
+{
+  while (mFinalization.valid() || !mSlotsToFinalize.empty()) {
+    if (mFinalization.valid()) {
+      mFinalization.wait();
+    }
+    launchFinalization();
+  }
+}
+
 //________________________________________
 template <typename Container>
 inline TFType TimeSlotCalibration<Container>::tf2SlotMin(TFType tf) const
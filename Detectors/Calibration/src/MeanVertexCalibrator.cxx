@@ -16,6 +16,7 @@
 #include "CCDB/CcdbApi.h"
 #include "DetectorsCalibration/Utils.h"
 #include "DetectorsCalibration/MeanVertexParams.h"
+#include <algorithm>
 
 namespace o2
 {
@@ -100,9 +101,10 @@ bool MeanVertexCalibrator::fitMeanVertex(o2::calibration::MeanVertexData* c, Mea
   // we fit as soon as we have enough entries in z
   const auto& params = MeanVertexParams::Instance();
   double fitres;
-  // first we order the vector
-  std::sort(c->histoVtx.begin(), c->histoVtx.end(), [](std::array<float, 3> a, std::array<float, 3> b) { return b[2] > a[2]; });
+  auto zLess = [](const std::array<float, 3>& a, const std::array<float, 3>& b) { return a[2] < b[2]; };
+  // the Z slices only need the vertices partitioned in Z, the full ordering is done only for printing
   if (mVerbose) {
+    std::sort(c->histoVtx.begin(), c->histoVtx.end(), zLess);
     LOG(info) << "Printing ordered vertices";
     for (int i = 0; i < c->histoVtx.size(); ++i) {
       LOG(info) << "x = " << c->histoVtx[i][0] << ", y = " << c->histoVtx[i][1] << ", z = " << c->histoVtx[i][2];
@@ -134,101 +136,110 @@ bool MeanVertexCalibrator::fitMeanVertex(o2::calibration::MeanVertexData* c, Mea
     }
   };
 
+  const size_t nVtx = c->histoVtx.size();
+  const size_t sliceEntries = minEntriesPerPoint - 1; // a slice is fitted once one more vertex beyond it is available
+  htmpX.reserve(sliceEntries);
+  htmpY.reserve(sliceEntries);
   for (int counter = 0; counter < params.nPointsForSlope; counter++) {
     if (mVerbose) {
-      LOG(info) << "Beginning of while: startZ = " << startZ << " c->histoVtx.size() = " << c->histoVtx.size();
+      LOG(info) << "Beginning of slice: startZ = " << startZ << " c->histoVtx.size() = " << nVtx;
     }
+    if (startZ + sliceEntries >= nVtx) {
+      break; // not enough vertices left for another slice
+    }
+    // move the sliceEntries vertices with smallest Z among the remaining ones to the front of the
+    // remaining range, followed by the next one in Z: O(N) instead of sorting all vertices
+    auto sliceBegin = c->histoVtx.begin() + startZ, sliceEnd = sliceBegin + sliceEntries;
+    std::nth_element(sliceBegin, sliceEnd, c->histoVtx.end(), zLess);
     double meanZ = 0;
-    int counts = 0;
-    for (int ii = startZ; ii < c->histoVtx.size(); ++ii) {
-      bool failed = false;
-      if (++counts < minEntriesPerPoint) {
-        htmpX.push_back(c->histoVtx[ii][0]);
-        htmpY.push_back(c->histoVtx[ii][1]);
-        meanZ += c->histoVtx[ii][2];
-      } else {
-        counts--;
-        if (mVerbose) {
-          LOGP(info, "fitting after collecting {} entries for Z slice {} of {}", htmpX.size(), counter, params.nPointsForSlope);
-        }
-        // we can fit and restart filling
-        // X:
-        fitResSlicesX.push_back({});
-        covMatrixX.push_back({});
-        auto hparX = binVector(binnedVect, htmpX, c, 0);
-        if (mVerbose) {
-          LOG(info) << "Fitting X for counter " << counter << ", will use " << hparX.nBins << " bins, from " << hparX.minRange << " to " << hparX.maxRange;
-          for (int i = 0; i < htmpX.size(); ++i) {
-            LOG(info) << "vect[" << i << "] = " << htmpX[i] << ";";
-          }
-        }
-        if (mVerbose) {
-          LOG(info) << " Printing output binned vector for X:";
-          printVector(binnedVect, hparX);
-        } else if (params.dumpNonEmptyBins) {
-          dumpNonEmpty(fmt::format("X{} nonEmpty bins", counter));
-        }
-        fitres = fitGaus(hparX.nBins, binnedVect.data(), hparX.minRange, hparX.maxRange, fitResSlicesX.back(), &covMatrixX.back());
-        if (fitres != -10) {
-          LOG(info) << "X, counter " << counter << ": Fit result (z slice [" << c->histoVtx[startZ][2] << ", " << c->histoVtx[ii][2] << "]) => " << fitres << ". Mean = " << fitResSlicesX[counter][1] << " Sigma = " << fitResSlicesX[counter][2] << ", covMatrix = " << covMatrixX[counter](2, 2) << " entries = " << counts;
-        } else {
-          LOG(error) << "X, counter " << counter << ": Fit failed with result = " << fitres << " entries = " << counts;
-          failed = true;
-        }
-        htmpX.clear();
-
-        // Y:
-        fitResSlicesY.push_back({});
-        covMatrixY.push_back({});
-        binnedVect.clear();
-        auto hparY = binVector(binnedVect, htmpY, c, 1);
-        if (mVerbose) {
-          LOG(info) << "Fitting Y for counter " << counter << ", will use " << hparY.nBins << " bins, from " << hparY.minRange << " to " << hparY.maxRange;
-          for (int i = 0; i < htmpY.size(); ++i) {
-            LOG(info) << i << " : " << htmpY[i];
-          }
-        }
-        if (mVerbose) {
-          LOG(info) << " Printing output binned vector for Y:";
-          printVector(binnedVect, hparY);
-        } else if (params.dumpNonEmptyBins) {
-          dumpNonEmpty(fmt::format("Y{} nonEmpty bins", counter));
-        }
-        fitres = fitGaus(hparY.nBins, binnedVect.data(), hparY.minRange, hparY.maxRange, fitResSlicesY.back(), &covMatrixY.back());
-        if (fitres != -10) {
-          LOG(info) << "Y, counter " << counter << ": Fit result (z slice [" << c->histoVtx[startZ][2] << ", " << c->histoVtx[ii][2] << "]) => " << fitres << ". Mean = " << fitResSlicesY[counter][1] << " Sigma = " << fitResSlicesY[counter][2] << ", covMatrix = " << covMatrixY[counter](2, 2) << " entries = " << counts;
-        } else {
-          LOG(error) << "Y, counter " << counter << ": Fit failed with result = " << fitres << " entries = " << counts;
-          failed = true;
-        }
-        htmpY.clear();
-
-        // Z: let's calculate the mean position
-        if (mVerbose) {
-          LOGP(info, "Z, counter {} {} ({}/{})", counter, meanZ / counts, meanZ, counts);
-        }
-
-        if (failed) {
-          fitResSlicesX.pop_back();
-          covMatrixX.pop_back();
-          fitResSlicesY.pop_back();
-          covMatrixY.pop_back();
-        } else {
-          meanZvect.push_back(meanZ / counts);
-          nBinsOK++;
-        }
-        startZ += counts;
-        break;
+    float minZ = sliceBegin->at(2);
+    for (auto it = sliceBegin; it != sliceEnd; ++it) {
+      htmpX.push_back((*it)[0]);
+      htmpY.push_back((*it)[1]);
+      meanZ += (*it)[2];
+      minZ = std::min(minZ, (*it)[2]);
+    }
+    const float maxZ = (*sliceEnd)[2];
+    const int counts = sliceEntries;
+    bool failed = false;
+    if (mVerbose) {
+      LOGP(info, "fitting after collecting {} entries for Z slice {} of {}", htmpX.size(), counter, params.nPointsForSlope);
+    }
+    // X:
+    fitResSlicesX.push_back({});
+    covMatrixX.push_back({});
+    auto hparX = binVector(binnedVect, htmpX, c, 0);
+    if (mVerbose) {
+      LOG(info) << "Fitting X for counter " << counter << ", will use " << hparX.nBins << " bins, from " << hparX.minRange << " to " << hparX.maxRange;
+      for (int i = 0; i < htmpX.size(); ++i) {
+        LOG(info) << "vect[" << i << "] = " << htmpX[i] << ";";
+      }
+    }
+    if (mVerbose) {
+      LOG(info) << " Printing output binned vector for X:";
+      printVector(binnedVect, hparX);
+    } else if (params.dumpNonEmptyBins) {
+      dumpNonEmpty(fmt::format("X{} nonEmpty bins", counter));
+    }
+    fitres = fitGaus(hparX.nBins, binnedVect.data(), hparX.minRange, hparX.maxRange, fitResSlicesX.back(), &covMatrixX.back());
+    if (fitres != -10) {
+      LOG(info) << "X, counter " << counter << ": Fit result (z slice [" << minZ << ", " << maxZ << "]) => " << fitres << ". Mean = " << fitResSlicesX.back()[1] << " Sigma = " << fitResSlicesX.back()[2] << ", covMatrix = " << covMatrixX.back()(2, 2) << " entries = " << counts;
+    } else {
+      LOG(error) << "X, counter " << counter << ": Fit failed with result = " << fitres << " entries = " << counts;
+      failed = true;
+    }
+    htmpX.clear();
+
+    // Y:
+    fitResSlicesY.push_back({});
+    covMatrixY.push_back({});
+    binnedVect.clear();
+    auto hparY = binVector(binnedVect, htmpY, c, 1);
+    if (mVerbose) {
+      LOG(info) << "Fitting Y for counter " << counter << ", will use " << hparY.nBins << " bins, from " << hparY.minRange << " to " << hparY.maxRange;
+      for (int i = 0; i < htmpY.size(); ++i) {
+        LOG(info) << i << " : " << htmpY[i];
       }
     }
     if (mVerbose) {
-      LOG(info) << "End of while: startZ = " << startZ << " c->histoVtx.size() = " << c->histoVtx.size();
+      LOG(info) << " Printing output binned vector for Y:";
+      printVector(binnedVect, hparY);
+    } else if (params.dumpNonEmptyBins) {
+      dumpNonEmpty(fmt::format("Y{} nonEmpty bins", counter));
+    }
+    fitres = fitGaus(hparY.nBins, binnedVect.data(), hparY.minRange, hparY.maxRange, fitResSlicesY.back(), &covMatrixY.back());
+    if (fitres != -10) {
+      LOG(info) << "Y, counter " << counter << ": Fit result (z slice [" << minZ << ", " << maxZ << "]) => " << fitres << ". Mean = " << fitResSlicesY.back()[1] << " Sigma = " << fitResSlicesY.back()[2] << ", covMatrix = " << covMatrixY.back()(2, 2) << " entries = " << counts;
+    } else {
+      LOG(error) << "Y, counter " << counter << ": Fit failed with result = " << fitres << " entries = " << counts;
+      failed = true;
+    }
+    htmpY.clear();
+
+    // Z: let's calculate the mean position
+    if (mVerbose) {
+      LOGP(info, "Z, counter {} {} ({}/{})", counter, meanZ / counts, meanZ, counts);
+    }
+
+    if (failed) {
+      fitResSlicesX.pop_back();
+      covMatrixX.pop_back();
+      fitResSlicesY.pop_back();
+      covMatrixY.pop_back();
+    } else {
+      meanZvect.push_back(meanZ / counts);
+      nBinsOK++;
+    }
+    startZ += counts;
+    if (mVerbose) {
+      LOG(info) << "End of slice: startZ = " << startZ << " c->histoVtx.size() = " << nVtx;
     }
   }
 
   // fitting main mean vtx Z
-  for (int ii = 0; ii < c->histoVtx.size(); ++ii) {
-    htmpZ.push_back(c->histoVtx[ii][2]);
+  htmpZ.reserve(nVtx);
+  for (const auto& vtx : c->histoVtx) {
+    htmpZ.push_back(vtx[2]);
   }
   auto hparZ = binVector(binnedVect, htmpZ, c, 2);
   fitMeanVertexCoord(2, binnedVect.data(), hparZ, mvo);
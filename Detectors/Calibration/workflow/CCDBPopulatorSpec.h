@@ -31,6 +31,11 @@
 #include "CommonUtils/NameConf.h"
 #include <unordered_map>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
 
 namespace o2
 {
@@ -42,7 +47,18 @@ class CCDBPopulator : public o2::framework::Task
   using CcdbObjectInfo = o2::ccdb::CcdbObjectInfo;
   using CcdbApi = o2::ccdb::CcdbApi;
 
+  /// object waiting for the upload, the payload is owned only if the upload is done asynchronously
+  struct Upload {
+    CcdbObjectInfo info;
+    std::map<std::string, std::string> metadata;
+    const char* data = nullptr;
+    size_t size = 0;
+    std::vector<char> ownedPayload;
+  };
+
  public:
+  ~CCDBPopulator() override { stopUploader(); }
+
   void init(o2::framework::InitContext& ic) final
   {
     mCCDBpath = ic.options().get<std::string>("ccdb-path");
@@ -51,7 +67,12 @@ class CCDBPopulator : public o2::framework::Task
     mFatalOnFailure = ic.options().get<bool>("fatal-on-failure");
     mValidateUpload = ic.options().get<bool>("validate-upload");
     mThrottlingDelayMS = ic.options().get<std::int64_t>("throttling-delay");
+    mMaxParallelUploads = std::max(1, ic.options().get<int>("max-parallel-uploads"));
+    mAsyncUpload = ic.options().get<bool>("async-upload");
     mAPI.init(mCCDBpath);
+    if (mAsyncUpload) {
+      mUploader = std::thread([this]() { uploaderLoop(); });
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
@@ -70,7 +91,7 @@ class CCDBPopulator : public o2::framework::Task
       runNoStr = std::to_string(runNoFromDH);
     }
     auto nowMS = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-    std::map<std::string, std::string> metadata;
+    std::vector<Upload> uploads;
     for (int isl = 0; isl < nSlots; isl++) {
       auto refWrp = pc.inputs().get("clbWrapper", isl);
       auto refPld = pc.inputs().get("clbPayload", isl);
@@ -95,13 +116,19 @@ class CCDBPopulator : public o2::framework::Task
              o2::framework::DataRefUtils::getHeader<o2::header::DataHeader*>(refWrp)->dataDescription.as<std::string>(), isl);
         continue;
       }
-      const auto* md = &wrp->getMetaData();
-      if (runNoFromDH > 0 && md->find(o2::base::NameConf::CCDBRunTag.data()) == md->end()) { // if valid run number is provided and it is not filled in the metadata, add it to the clone
-        metadata = *md;                                                                      // clone since the md from the message is const
-        metadata[o2::base::NameConf::CCDBRunTag.data()] = runNoStr;
-        md = &metadata;
+      auto& upload = uploads.emplace_back(Upload{*wrp.get(), wrp->getMetaData()});
+      if (runNoFromDH > 0 && upload.metadata.find(o2::base::NameConf::CCDBRunTag.data()) == upload.metadata.end()) { // if valid run number is provided and it is not filled in the metadata, add it
+        upload.metadata[o2::base::NameConf::CCDBRunTag.data()] = runNoStr;
       }
-      std::string msg = fmt::format("Storing in ccdb {}/{} of size {} valid for {} : {}", wrp->getPath(), wrp->getFileName(), pld.size(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+      if (mAsyncUpload) { // the input messages are gone when the upload is done
+        upload.ownedPayload.assign(pld.begin(), pld.end());
+        upload.data = upload.ownedPayload.data();
+      } else {
+        upload.data = pld.data();
+      }
+      upload.size = pld.size();
+
+      std::string msg = fmt::format("{} in ccdb {}/{} of size {} valid for {} : {}", mAsyncUpload ? "Queueing for storage" : "Storing", wrp->getPath(), wrp->getFileName(), pld.size(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
       auto& lastLog = mThrottling[wrp->getPath()];
       if (lastLog.first + mThrottlingDelayMS < nowMS) {
         if (lastLog.second) {
@@ -114,56 +141,149 @@ class CCDBPopulator : public o2::framework::Task
         lastLog.second++;
         LOG(info) << msg;
       }
+    }
+    if (uploads.empty()) {
+      return;
+    }
+    if (mAsyncUpload) {
+      {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        std::move(uploads.begin(), uploads.end(), std::back_inserter(mQueue));
+      }
+      mQueueCondition.notify_one();
+    } else {
+      uploadBatch(uploads);
+    }
+  }
+
+  void endOfStream(o2::framework::EndOfStreamContext& ec) final
+  {
+    LOG(info) << "EndOfStream received";
+    stopUploader();
+  }
+
+  void stop() final
+  {
+    stopUploader();
+  }
 
-      auto uploadTS = o2::ccdb::getCurrentTimestamp();
+ private:
+  /// upload the objects of the batch in parallel, adjust the end of validity of the overridden objects and validate the uploads
+  void uploadBatch(std::vector<Upload>& batch)
+  {
+    coalesce(batch);
+    std::vector<CcdbApi::UploadRequest> requests;
+    requests.reserve(batch.size());
+    for (const auto& upload : batch) {
+      const auto& info = upload.info;
+      requests.push_back({upload.data, upload.size, info.getFileName(), info.getObjectType(), info.getPath(), upload.metadata, info.getStartValidityTimestamp(), info.getEndValidityTimestamp()});
+    }
+    auto uploadTS = o2::ccdb::getCurrentTimestamp();
+    auto results = mAPI.storeAsBinaryFiles(requests, mMaxParallelUploads);
 
-      int res = mAPI.storeAsBinaryFile(&pld[0], pld.size(), wrp->getFileName(), wrp->getObjectType(), wrp->getPath(),
-                                       *md, wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
-      if (res) {
+    for (size_t i = 0; i < batch.size(); i++) {
+      const auto& info = batch[i].info;
+      if (results[i]) {
         if (mFatalOnFailure) {
-          LOGP(fatal, "failed on uploading to {} / {} for [{}:{}]", mAPI.getURL(), wrp->getPath(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+          LOGP(fatal, "failed on uploading to {} / {} for [{}:{}]", mAPI.getURL(), info.getPath(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
         } else {
-          LOGP(error, "failed on uploading to {} / {} for [{}:{}]", mAPI.getURL(), wrp->getPath(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+          LOGP(error, "failed on uploading to {} / {} for [{}:{}]", mAPI.getURL(), info.getPath(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
         }
       }
       // do we need to override previous object?
-      if (wrp->isAdjustableEOV() && !mAPI.isSnapshotMode()) {
-        o2::ccdb::adjustOverriddenEOV(mAPI, *wrp.get());
+      if (info.isAdjustableEOV() && !mAPI.isSnapshotMode()) {
+        o2::ccdb::adjustOverriddenEOV(mAPI, info);
       }
       // if requested, make sure that the new object can be queried
-      if (mValidateUpload || wrp->getValidateUpload()) {
+      if (mValidateUpload || info.getValidateUpload()) {
         constexpr long MAXDESYNC = 3;
-        auto headers = mAPI.retrieveHeaders(wrp->getPath(), {}, wrp->getStartValidityTimestamp() + (wrp->getEndValidityTimestamp() - wrp->getStartValidityTimestamp()) / 2);
+        auto headers = mAPI.retrieveHeaders(info.getPath(), {}, info.getStartValidityTimestamp() + (info.getEndValidityTimestamp() - info.getStartValidityTimestamp()) / 2);
         if (headers.empty() ||
             std::atol(headers["Created"].c_str()) < uploadTS - MAXDESYNC ||
-            std::atol(headers["Valid-From"].c_str()) != wrp->getStartValidityTimestamp() ||
-            std::atol(headers["Valid-Until"].c_str()) != wrp->getEndValidityTimestamp()) {
+            std::atol(headers["Valid-From"].c_str()) != info.getStartValidityTimestamp() ||
+            std::atol(headers["Valid-Until"].c_str()) != info.getEndValidityTimestamp()) {
           if (mFatalOnFailure) {
-            LOGP(fatal, "Failed to validate upload to {} / {} for [{}:{}]", mAPI.getURL(), wrp->getPath(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+            LOGP(fatal, "Failed to validate upload to {} / {} for [{}:{}]", mAPI.getURL(), info.getPath(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
           } else {
-            LOGP(error, "Failed to validate upload to {} / {} for [{}:{}]", mAPI.getURL(), wrp->getPath(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+            LOGP(error, "Failed to validate upload to {} / {} for [{}:{}]", mAPI.getURL(), info.getPath(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
           }
         } else {
-          LOGP(important, "Validated upload to {} / {} for [{}:{}]", mAPI.getURL(), wrp->getPath(), wrp->getStartValidityTimestamp(), wrp->getEndValidityTimestamp());
+          LOGP(important, "Validated upload to {} / {} for [{}:{}]", mAPI.getURL(), info.getPath(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
         }
       }
     }
   }
 
-  void endOfStream(o2::framework::EndOfStreamContext& ec) final
+  /// drop the objects which are superseded by a later object of the batch with the same path, validity and metadata
+  static void coalesce(std::vector<Upload>& batch)
   {
-    LOG(info) << "EndOfStream received";
+    std::vector<Upload> kept;
+    kept.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+      const auto& info = batch[i].info;
+      bool superseded = false;
+      for (size_t j = i + 1; j < batch.size() && !superseded; j++) {
+        const auto& later = batch[j].info;
+        superseded = later.getPath() == info.getPath() && later.getStartValidityTimestamp() == info.getStartValidityTimestamp() &&
+                     later.getEndValidityTimestamp() == info.getEndValidityTimestamp() && batch[j].metadata == batch[i].metadata;
+      }
+      if (superseded) {
+        LOGP(info, "Skipping upload of {}/{} for [{}:{}], superseded by a later object", info.getPath(), info.getFileName(), info.getStartValidityTimestamp(), info.getEndValidityTimestamp());
+        continue;
+      }
+      kept.push_back(std::move(batch[i]));
+    }
+    batch.swap(kept);
+  }
+
+  /// upload the queued objects until the uploader is stopped, every wakeup uploads everything which was queued in the meantime
+  void uploaderLoop()
+  {
+    while (true) {
+      std::vector<Upload> batch;
+      {
+        std::unique_lock<std::mutex> lock(mQueueMutex);
+        mQueueCondition.wait(lock, [this]() { return mStopUploader || !mQueue.empty(); });
+        if (mQueue.empty()) {
+          return; // stopped and nothing left to upload
+        }
+        std::move(mQueue.begin(), mQueue.end(), std::back_inserter(batch));
+        mQueue.clear();
+      }
+      uploadBatch(batch);
+    }
+  }
+
+  /// upload what is still queued and join the uploader thread
+  void stopUploader()
+  {
+    if (!mUploader.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mQueueMutex);
+      mStopUploader = true;
+    }
+    mQueueCondition.notify_one();
+    mUploader.join();
+    LOG(info) << "All queued CCDB uploads are done";
   }
 
- private:
   CcdbApi mAPI;
   long mThrottlingDelayMS = 0;                             // LOG(important) at most once per this period for given path
   bool mFatalOnFailure = true;                             // produce fatal on failed upload
   bool mValidateUpload = false;                            // validate upload by querying its headers
+  bool mAsyncUpload = false;                               // upload from a separate thread, not blocking the processing
+  int mMaxParallelUploads = 4;                             // max number of concurrent uploads
   std::unordered_map<std::string, std::pair<long, int>> mThrottling;
   std::int64_t mSSpecMin = -1;                             // min subspec to accept
   std::int64_t mSSpecMax = -1;                             // max subspec to accept
   std::string mCCDBpath = "http://ccdb-test.cern.ch:8080"; // CCDB path
+  std::thread mUploader;                                   // thread doing the asynchronous uploads
+  std::mutex mQueueMutex;                                  // protects mQueue and mStopUploader
+  std::condition_variable mQueueCondition;                 // signals new uploads or the stop to the uploader
+  std::deque<Upload> mQueue;                               // objects waiting for the asynchronous upload
+  bool mStopUploader = false;                              // uploader thread should exit once the queue is empty
 };
 
 } // namespace calibration
@@ -188,7 +308,9 @@ DataProcessorSpec getCCDBPopulatorDeviceSpec(const std::string& defCCDB, const s
       {"sspec-max", VariantType::Int64, -1L, {"max subspec to accept"}},
       {"throttling-delay", VariantType::Int64, 300000L, {"produce important type log at most once per this period in ms for each CCDB path"}},
       {"validate-upload", VariantType::Bool, false, {"valider upload by querying its headers"}},
-      {"fatal-on-failure", VariantType::Bool, false, {"do not produce fatal on failed upload"}}}};
+      {"fatal-on-failure", VariantType::Bool, false, {"do not produce fatal on failed upload"}},
+      {"async-upload", VariantType::Bool, false, {"upload from a separate thread without blocking the processing"}},
+      {"max-parallel-uploads", VariantType::Int, 4, {"max number of concurrent uploads"}}}};
 }
 
 } // namespace framework
@@ -38,6 +38,7 @@ void MeanVertexCalibDevice::init(InitContext& ic)
   if (useVerboseMode) {
     mCalibrator->useVerboseMode(true);
   }
+  mCalibrator->setAsyncFinalization(ic.options().get<bool>("async-finalization"));
 }
 
 //_____________________________________________________________
@@ -56,8 +57,10 @@ void MeanVertexCalibDevice::run(o2::framework::ProcessingContext& pc)
   LOG(debug) << "Processing TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices";
   mCalibrator->process(data);
   sendOutput(pc.outputs());
-  const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
-  LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, for which we created " << infoVec.size() << " objects for TF " << mCalibrator->getCurrentTFInfo().tfCounter;
+  if (mCalibrator->isFinalizationDone()) {
+    const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
+    LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, for which we created " << infoVec.size() << " objects for TF " << mCalibrator->getCurrentTFInfo().tfCounter;
+  }
 }
 
 //_________________________________________________________________
@@ -73,6 +76,7 @@ void MeanVertexCalibDevice::endOfStream(o2::framework::EndOfStreamContext& ec)
 
   LOG(info) << "Finalizing calibration";
   mCalibrator->checkSlotsToFinalize(o2::calibration::INFINITE_TF);
+  mCalibrator->waitForFinalization();
   sendOutput(ec.outputs());
 }
 
@@ -84,6 +88,9 @@ void MeanVertexCalibDevice::sendOutput(DataAllocator& output)
   // extract CCDB infos and calibration objects, convert it to TMemFile and send them to the output
   // TODO in principle, this routine is generic, can be moved to Utils.h
   using clbUtils = o2::calibration::Utils;
+  if (!mCalibrator->isFinalizationDone()) {
+    return; // the outputs are still being filled, send them with one of the following TFs
+  }
   const auto& payloadVec = mCalibrator->getMeanVertexObjectVector();
   auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector(); // use non-const version as we update it
   assert(payloadVec.size() == infoVec.size());
@@ -153,7 +160,8 @@ DataProcessorSpec getMeanVertexCalibDeviceSpec(uint32_t dcsMVsubspec)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<device>(ccdbRequest, dcsMVsubspec)},
-    Options{{"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}}}};
+    Options{{"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}},
+            {"async-finalization", VariantType::Bool, false, {"Finalize the closed slots on a worker thread while the following TFs are processed"}}}};
 }
 
 } // namespace framework
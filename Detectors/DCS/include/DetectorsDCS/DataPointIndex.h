@@ -0,0 +1,105 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DATAPOINT_INDEX_H
+#define O2_DCS_DATAPOINT_INDEX_H
+
+#include "DetectorsDCS/DataPointIdentifier.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace o2::dcs
+{
+/**
+  * DataPointIndex maps the DataPointIdentifiers of a fixed configuration to
+  * the integers 0..size()-1, e.g. to address arrays instead of maps keyed by
+  * DataPointIdentifier.
+  *
+  * The index is a perfect hash built once from the configured identifiers
+  * (hash and displace: the identifiers are distributed in small buckets, and
+  * every bucket gets the seed of a second hash for which its identifiers do
+  * not collide with the ones already placed). A lookup hashes the 64 bytes of
+  * the identifier twice and does a single comparison, without creating any
+  * string.
+  */
+class DataPointIndex
+{
+ public:
+  static constexpr int NotFound = -1;
+
+  DataPointIndex() = default;
+  explicit DataPointIndex(const std::vector<DataPointIdentifier>& ids) { build(ids); }
+
+  /**
+    * Builds the index for the given identifiers, replacing the previous one.
+    * The index of an identifier is its position in the list, duplicates are
+    * ignored.
+    */
+  void build(const std::vector<DataPointIdentifier>& ids);
+
+  /**
+    * @returns the index of the identifier, or NotFound if it is not part of
+    * the configuration
+    */
+  int find(const DataPointIdentifier& id) const noexcept
+  {
+    if (mIDs.empty()) {
+      return NotFound;
+    }
+    const auto words = load(id);
+    const auto displacement = mDisplacements[hash(words, 0) & mBucketMask];
+    const auto slot = mSlots[hash(words, displacement) & mSlotMask];
+    return (slot != NotFound && mIDs[slot] == id) ? slot : NotFound;
+  }
+
+  bool contains(const DataPointIdentifier& id) const noexcept { return find(id) != NotFound; }
+
+  size_t size() const noexcept { return mIDs.size(); }
+  bool empty() const noexcept { return mIDs.empty(); }
+
+  const DataPointIdentifier& getID(int index) const { return mIDs[index]; }
+  const std::vector<DataPointIdentifier>& getIDs() const noexcept { return mIDs; }
+
+ private:
+  using Words = std::array<uint64_t, 8>;
+
+  /// copy the identifier into words, without the bit which is ignored by the comparison of identifiers
+  static Words load(const DataPointIdentifier& id) noexcept
+  {
+    static_assert(sizeof(DataPointIdentifier) == sizeof(Words));
+    Words words;
+    std::memcpy(words.data(), &id, sizeof(Words));
+    words[7] &= ~(uint64_t(0x80) << 56);
+    return words;
+  }
+
+  static uint64_t hash(const Words& words, uint64_t seed) noexcept
+  {
+    uint64_t h = seed * 0x9e3779b97f4a7c15ULL;
+    for (auto w : words) {
+      h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+      h ^= h >> 31;
+    }
+    h *= 0x94d049bb133111ebULL;
+    return h ^ (h >> 29);
+  }
+
+  std::vector<DataPointIdentifier> mIDs;  ///< configured identifiers, by index
+  std::vector<uint32_t> mDisplacements;    ///< seed of the second hash for every bucket
+  std::vector<int> mSlots;                 ///< index of the identifier in every slot, NotFound if empty
+  uint64_t mBucketMask = 0;
+  uint64_t mSlotMask = 0;
+};
+} // namespace o2::dcs
+
+#endif
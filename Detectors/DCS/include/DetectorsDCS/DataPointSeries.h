@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_DCS_DATAPOINT_SERIES_H
+#define O2_DCS_DATAPOINT_SERIES_H
+
+#include "DetectorsDCS/DataPointValue.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <gsl/span>
+
+namespace o2::dcs
+{
+/**
+  * DataPointSeries keeps the time series of a fixed number of numeric data
+  * points, addressed by their DataPointIndex. The epoch times and the values
+  * of every data point are stored in separate columns; only the first payload
+  * word is kept, which holds the value of all numeric types and of bool and
+  * char. clear() keeps the capacity, so that no allocation happens once the
+  * columns have grown to the typical number of values per period.
+  */
+class DataPointSeries
+{
+ public:
+  DataPointSeries() = default;
+  explicit DataPointSeries(size_t nDataPoints, size_t reserve = 0) { init(nDataPoints, reserve); }
+
+  /// set the number of data points, reserving space for the given number of values for each of them
+  void init(size_t nDataPoints, size_t reserve = 0)
+  {
+    mTimes.assign(nDataPoints, {});
+    mValues.assign(nDataPoints, {});
+    for (size_t i = 0; i < nDataPoints; i++) {
+      mTimes[i].reserve(reserve);
+      mValues[i].reserve(reserve);
+    }
+  }
+
+  /// drop the values of all data points
+  void clear()
+  {
+    for (size_t i = 0; i < mTimes.size(); i++) {
+      mTimes[i].clear();
+      mValues[i].clear();
+    }
+  }
+
+  /**
+    * Appends the value of the data point
+    *
+    * @param skipSameTime do not append the value if the last one has the same epoch time
+    * @returns true if the value was appended
+    */
+  bool add(int index, const DataPointValue& value, bool skipSameTime = true)
+  {
+    auto& times = mTimes[index];
+    const auto time = value.get_epoch_time();
+    if (skipSameTime && !times.empty() && times.back() == time) {
+      return false;
+    }
+    times.push_back(time);
+    mValues[index].push_back(value.payload_pt1);
+    return true;
+  }
+
+  size_t getNDataPoints() const noexcept { return mTimes.size(); }
+  size_t size(int index) const noexcept { return mTimes[index].size(); }
+  bool empty(int index) const noexcept { return mTimes[index].empty(); }
+
+  /// epoch times in ms of the values of the data point
+  gsl::span<const uint64_t> getTimes(int index) const { return mTimes[index]; }
+  /// first payload words of the values of the data point
+  gsl::span<const uint64_t> getRawValues(int index) const { return mValues[index]; }
+
+  /// @returns the i-th value of the data point, interpreted as T
+  template <typename T>
+  T getValue(int index, size_t i) const noexcept
+  {
+    static_assert(sizeof(T) <= sizeof(uint64_t) && std::is_trivially_copyable_v<T>, "only values fitting in the first payload word are kept");
+    T value;
+    std::memcpy(&value, &mValues[index][i], sizeof(T));
+    return value;
+  }
+
+ private:
+  std::vector<std::vector<uint64_t>> mTimes;  ///< epoch times of the values, per data point
+  std::vector<std::vector<uint64_t>> mValues; ///< first payload words of the values, per data point
+};
+} // namespace o2::dcs
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "DetectorsDCS/DataPointIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace o2::dcs;
+
+namespace
+{
+uint64_t nextPowerOfTwo(uint64_t n)
+{
+  uint64_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+} // namespace
+
+void DataPointIndex::build(const std::vector<DataPointIdentifier>& ids)
+{
+  mIDs.clear();
+  mIDs.reserve(ids.size());
+  {
+    std::unordered_set<DataPointIdentifier> unique;
+    for (const auto& id : ids) {
+      if (unique.insert(id).second) {
+        mIDs.push_back(id);
+      }
+    }
+  }
+  const size_t n = mIDs.size();
+  // ~4 identifiers per bucket and a load of the slots of at most 80%
+  const uint64_t nBuckets = nextPowerOfTwo(std::max<size_t>(1, n / 4));
+  const uint64_t nSlots = nextPowerOfTwo(std::max<size_t>(1, n + n / 4));
+  mBucketMask = nBuckets - 1;
+  mSlotMask = nSlots - 1;
+  mDisplacements.assign(nBuckets, 0);
+  mSlots.assign(nSlots, NotFound);
+
+  std::vector<std::vector<int>> buckets(nBuckets);
+  std::vector<Words> words(n);
+  for (size_t i = 0; i < n; i++) {
+    words[i] = load(mIDs[i]);
+    buckets[hash(words[i], 0) & mBucketMask].push_back(i);
+  }
+
+  // place the largest buckets first, while most of the slots are still free
+  std::vector<size_t> order(nBuckets);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+  constexpr uint32_t MaxDisplacement = 1u << 24;
+  std::vector<uint64_t> slots;
+  for (auto b : order) {
+    const auto& bucket = buckets[b];
+    if (bucket.empty()) {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t d = 1; d < MaxDisplacement && !placed; d++) {
+      slots.clear();
+      placed = true;
+      for (auto i : bucket) {
+        const auto slot = hash(words[i], d) & mSlotMask;
+        if (mSlots[slot] != NotFound || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+          placed = false;
+          break;
+        }
+        slots.push_back(slot);
+      }
+      if (placed) {
+        mDisplacements[b] = d;
+        for (size_t j = 0; j < bucket.size(); j++) {
+          mSlots[slots[j]] = bucket[j];
+        }
+      }
+    }
+    if (!placed) {
+      throw std::runtime_error("could not build the index of " + std::to_string(n) + " DCS data points");
+    }
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DetectorsDCS DataPointIndex
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include "DetectorsDCS/DataPointIndex.h"
+#include "DetectorsDCS/DataPointSeries.h"
+#include "DetectorsDCS/AliasExpander.h"
+
+using namespace o2::dcs;
+
+BOOST_AUTO_TEST_CASE(DataPointIndexFindsAllConfiguredIDs)
+{
+  std::vector<DataPointIdentifier> ids;
+  for (const auto& alias : expandAliases({"TOF_HVSTATUS_SM[00..17]MOD[0..4]", "tof_hv_vp_[00..89]", "tof_hv_vn_[00..89]", "tof_hv_ip_[00..89]", "tof_hv_in_[00..89]"})) {
+    ids.emplace_back(alias, DPVAL_DOUBLE);
+  }
+  ids.emplace_back("TOF_FEACSTATUS_00", DPVAL_INT);
+  ids.push_back(ids.front()); // duplicates are ignored
+
+  DataPointIndex index(ids);
+  BOOST_REQUIRE_EQUAL(index.size(), ids.size() - 1);
+  for (size_t i = 0; i < index.size(); i++) {
+    BOOST_CHECK_EQUAL(index.find(ids[i]), i);
+    BOOST_CHECK(index.getID(i) == ids[i]);
+  }
+  BOOST_CHECK_EQUAL(index.find(DataPointIdentifier("tof_hv_vp_90", DPVAL_DOUBLE)), DataPointIndex::NotFound);
+  BOOST_CHECK_EQUAL(index.find(DataPointIdentifier("TOF_FEACSTATUS_00", DPVAL_DOUBLE)), DataPointIndex::NotFound);
+  BOOST_CHECK_EQUAL(DataPointIndex().find(ids[0]), DataPointIndex::NotFound);
+}
+
+BOOST_AUTO_TEST_CASE(DataPointSeriesKeepsValuesPerIndex)
+{
+  DataPointSeries series(2, 4);
+  auto makeValue = [](uint32_t sec, double value) {
+    DataPointValue dpval;
+    dpval.sec = sec;
+    std::memcpy(&dpval.payload_pt1, &value, sizeof(double));
+    return dpval;
+  };
+  BOOST_CHECK(series.add(1, makeValue(10, 1.5)));
+  BOOST_CHECK(!series.add(1, makeValue(10, 2.5))); // same time
+  BOOST_CHECK(series.add(1, makeValue(11, 3.5)));
+  BOOST_CHECK(series.empty(0));
+  BOOST_REQUIRE_EQUAL(series.size(1), 2);
+  BOOST_CHECK_EQUAL(series.getTimes(1)[1], 11000);
+  BOOST_CHECK_EQUAL(series.getValue<double>(1, 0), 1.5);
+  BOOST_CHECK_EQUAL(series.getValue<double>(1, 1), 3.5);
+  series.clear();
+  BOOST_CHECK(series.empty(1));
+}
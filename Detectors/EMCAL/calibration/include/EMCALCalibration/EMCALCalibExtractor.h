@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <optional>
+#include <vector>
 #include "CCDB/BasicCCDBManager.h"
 #include "EMCALCalib/BadChannelMap.h"
 #include "EMCALCalib/EMCALChannelScaleFactors.h"
@@ -132,15 +134,22 @@ class EMCALCalibExtractor
       calibrationTimeInfo = buildTimeMeanAndSigma(histTime);
     }
 
-    o2::emcal::BadChannelMap mOutputBCM;
+    // the cut on the time distribution is skipped if the good cell window could not be determined
+    const bool doTimeCut = doIncludeTime && std::abs(calibrationTimeInfo.goodCellWindow) >= 0.001;
+    if (doIncludeTime && !doTimeCut) {
+      LOG(warning) << "Good cell window for time distribution is 0. Will skip the cut on time distribution";
+    }
+
     // now loop through the cells and determine the mask for a given cell
+    // the cells are independent, the masks are filled into the bad channel map in cell order afterwards
+    std::vector<o2::emcal::BadChannelMap::MaskType_t> cellMasks(mNcells, o2::emcal::BadChannelMap::MaskType_t::GOOD_CELL);
 
 #if (defined(WITH_OPENMP) && !defined(__CLING__))
     if (mNThreads < 1) {
       mNThreads = std::min(omp_get_max_threads(), mNcells);
     }
     LOG(info) << "Number of threads that will be used = " << mNThreads;
-#pragma omp parallel for num_threads(mNThreads)
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads)
 #else
     LOG(info) << "OPEN MP will not be used for the bad channel calibration";
     mNThreads = 1;
@@ -148,18 +157,16 @@ class EMCALCalibExtractor
 
     for (int cellID = 0; cellID < mNcells; cellID++) {
       LOG(debug) << "analysing cell " << cellID;
-      if (calibrationInformation.energyPerHitMap[0][cellID] == 0) {
+      if (calibrationInformation.energyPerHitMap.at(0)[cellID] == 0) {
         LOG(debug) << "Cell " << cellID << " is dead.";
-        mOutputBCM.addBadChannel(cellID, o2::emcal::BadChannelMap::MaskType_t::DEAD_CELL);
-        mBadCellFracSM[mGeometry->GetSuperModuleNumber(cellID)] += 1;
-        mBadCellFracFEC[mGeometry->GetSuperModuleNumber(cellID)][getFECNumberInSM(cellID)] += 1;
+        cellMasks[cellID] = o2::emcal::BadChannelMap::MaskType_t::DEAD_CELL;
       } else {
         bool failed = false;
-        for (auto& [sliceIndex, slice] : slices) {
-          auto ranges = calibrationInformation.goodCellWindowMap[sliceIndex];
-          auto rangesNHits = calibrationInformation.goodCellWindowNHitsMap[sliceIndex];
-          auto meanPerCell = calibrationInformation.energyPerHitMap[sliceIndex][cellID];
-          auto meanPerCellNHits = calibrationInformation.nHitsMap[sliceIndex][cellID];
+        for (const auto& [sliceIndex, slice] : slices) {
+          const auto& ranges = calibrationInformation.goodCellWindowMap.at(sliceIndex);
+          const auto& rangesNHits = calibrationInformation.goodCellWindowNHitsMap.at(sliceIndex);
+          auto meanPerCell = calibrationInformation.energyPerHitMap.at(sliceIndex)[cellID];
+          auto meanPerCellNHits = calibrationInformation.nHitsMap.at(sliceIndex)[cellID];
           LOG(debug) << "Energy Per Hit: Mean per cell is " << meanPerCell << " Good Cell Window: [ " << ranges.first << " , " << ranges.second << " ]";
           LOG(debug) << "NHits: Mean per cell is " << meanPerCellNHits << " Good Cell Window: [ " << rangesNHits.first << " , " << rangesNHits.second << " ]";
 
@@ -188,36 +195,38 @@ class EMCALCalibExtractor
         }
 
         // check if the cell is bad due to timing signal.
-        if (!failed && doIncludeTime) {
-          if (std::abs(calibrationTimeInfo.goodCellWindow) < 0.001) {
-            LOG(warning) << "Good cell window for time distribution is 0. Will skip the cut on time distribution";
-          } else {
-            LOG(debug) << " calibrationTimeInfo.goodCellWindow " << calibrationTimeInfo.goodCellWindow << " calibrationTimeInfo.sigmaCell[cellID] " << calibrationTimeInfo.sigmaCell[cellID];
-            if (calibrationTimeInfo.sigmaCell[cellID] > calibrationTimeInfo.goodCellWindow) {
-              LOG(debug) << "Cell " << cellID << " is flagged due to time distribution";
-              failed = true;
-            } else if (calibrationTimeInfo.fracHitsPreTrigg[cellID] > calibrationTimeInfo.goodCellWindowFracHitsPreTrigg) {
-              LOG(debug) << "Cell " << cellID << " is flagged due to time distribution (pre-trigger)";
-              failed = true;
-            } else if (calibrationTimeInfo.fracHitsPostTrigg[cellID] > calibrationTimeInfo.goodCellWindowFracHitsPostTrigg) {
-              LOG(debug) << "Cell " << cellID << " is flagged due to time distribution (post-trigger)";
-              failed = true;
-            }
+        if (!failed && doTimeCut) {
+          LOG(debug) << " calibrationTimeInfo.goodCellWindow " << calibrationTimeInfo.goodCellWindow << " calibrationTimeInfo.sigmaCell[cellID] " << calibrationTimeInfo.sigmaCell[cellID];
+          if (calibrationTimeInfo.sigmaCell[cellID] > calibrationTimeInfo.goodCellWindow) {
+            LOG(debug) << "Cell " << cellID << " is flagged due to time distribution";
+            failed = true;
+          } else if (calibrationTimeInfo.fracHitsPreTrigg[cellID] > calibrationTimeInfo.goodCellWindowFracHitsPreTrigg) {
+            LOG(debug) << "Cell " << cellID << " is flagged due to time distribution (pre-trigger)";
+            failed = true;
+          } else if (calibrationTimeInfo.fracHitsPostTrigg[cellID] > calibrationTimeInfo.goodCellWindowFracHitsPostTrigg) {
+            LOG(debug) << "Cell " << cellID << " is flagged due to time distribution (post-trigger)";
+            failed = true;
           }
         }
 
         if (failed) {
           LOG(debug) << "Cell " << cellID << " is bad.";
-          mOutputBCM.addBadChannel(cellID, o2::emcal::BadChannelMap::MaskType_t::BAD_CELL);
-          mBadCellFracSM[mGeometry->GetSuperModuleNumber(cellID)] += 1;
-          mBadCellFracFEC[mGeometry->GetSuperModuleNumber(cellID)][getFECNumberInSM(cellID)] += 1;
+          cellMasks[cellID] = o2::emcal::BadChannelMap::MaskType_t::BAD_CELL;
         } else {
           LOG(debug) << "Cell " << cellID << " is good.";
-          mOutputBCM.addBadChannel(cellID, o2::emcal::BadChannelMap::MaskType_t::GOOD_CELL);
         }
       }
     }
 
+    o2::emcal::BadChannelMap mOutputBCM;
+    for (int cellID = 0; cellID < mNcells; cellID++) {
+      mOutputBCM.addBadChannel(cellID, cellMasks[cellID]);
+      if (cellMasks[cellID] != o2::emcal::BadChannelMap::MaskType_t::GOOD_CELL) {
+        mBadCellFracSM[mGeometry->GetSuperModuleNumber(cellID)] += 1;
+        mBadCellFracFEC[mGeometry->GetSuperModuleNumber(cellID)][getFECNumberInSM(cellID)] += 1;
+      }
+    }
+
     // Check if the fraction of bad+dead cells in a SM is above a certain threshold
     // If yes, mask the whole SM
     if (EMCALCalibParams::Instance().fracMaskSMFully_bc < 1) {
@@ -283,8 +292,8 @@ class EMCALCalibExtractor
         double sumVal = boost::histogram::algorithm::sum(slicedHist);
         if (sumVal > 0.) {
           // fill the output map with the desired slicing etc.
-          outputMapEnergyPerHit[sliceIndex][cellID] = meanVal;
-          outputMapNHits[sliceIndex][cellID] = sumVal;
+          outputMapEnergyPerHit.at(sliceIndex)[cellID] = meanVal;
+          outputMapNHits.at(sliceIndex)[cellID] = sumVal;
         }
       } // end loop over the slices
     }   // end loop over the cells
@@ -333,6 +342,12 @@ class EMCALCalibExtractor
   BadChannelCalibTimeInfo buildTimeMeanAndSigma(const boost::histogram::histogram<axes...>& histCellTime)
   {
     BadChannelCalibTimeInfo timeInfo;
+#if (defined(WITH_OPENMP) && !defined(__CLING__))
+    if (mNThreads < 1) {
+      mNThreads = std::min(omp_get_max_threads(), mNcells);
+    }
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads)
+#endif
     for (int i = 0; i < mNcells; ++i) {
       // calculate sigma per cell
       const int indexLow = histCellTime.axis(1).index(i);
@@ -401,20 +416,23 @@ class EMCALCalibExtractor
 
     o2::emcal::TimeCalibrationParams TCP;
 
-    double mean = 0;
+    // the fits of the cells are independent and done in parallel, a failed fit is replaced
+    // by the value of the previous cell when filling the calibration params in cell order
+    std::vector<double> cellMeans(mNcells, 0.);
+    std::vector<std::optional<o2::utils::FitGausError_t>> fitErrors(mNcells);
 
-    // #if (defined(WITH_OPENMP) && !defined(__CLING__))
-    //     if (mNThreads < 1) {
-    //       mNThreads = std::min(omp_get_max_threads(), mNcells);
-    //     }
-    //     LOG(info) << "Number of threads that will be used = " << mNThreads;
-    // #pragma omp parallel for num_threads(mNThreads)
-    // #else
-    //     LOG(info) << "OPEN MP will not be used for the time calibration";
-    //     mNThreads = 1;
-    // #endif
-
-    for (unsigned int i = 0; i < mNcells; ++i) {
+#if (defined(WITH_OPENMP) && !defined(__CLING__))
+    if (mNThreads < 1) {
+      mNThreads = std::min(omp_get_max_threads(), mNcells);
+    }
+    LOG(info) << "Number of threads that will be used = " << mNThreads;
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads)
+#else
+    LOG(info) << "OPEN MP will not be used for the time calibration";
+    mNThreads = 1;
+#endif
+
+    for (int i = 0; i < mNcells; ++i) {
       // project boost histogram to 1d just for 1 cell
       const int indexLow = histReduced.axis(1).index(i);
       const int indexHigh = histReduced.axis(1).index(i + 1);
@@ -434,18 +452,25 @@ class EMCALCalibExtractor
       try {
         auto fitValues = o2::utils::fitBoostHistoWithGaus<double>(boostHist1d);
         if (maxElementCenter + EMCALCalibParams::Instance().maxAllowedDeviationFromMax < fitValues.at(1) || maxElementCenter - EMCALCalibParams::Instance().maxAllowedDeviationFromMax > fitValues.at(1)) {
-          mean = maxElementCenter;
+          cellMeans[i] = maxElementCenter;
         } else {
-          mean = fitValues.at(1);
+          cellMeans[i] = fitValues.at(1);
         }
-        // add mean to time calib params
-        TCP.addTimeCalibParam(i, mean, false);                                                // highGain calib factor
-        TCP.addTimeCalibParam(i, mean + EMCALCalibParams::Instance().lowGainOffset_tc, true); // lowGain calib factor
       } catch (o2::utils::FitGausError_t err) {
-        LOG(warning) << createErrorMessageFitGaus(err) << "; for cell " << i << " (Will take the parameter of the previous cell: " << mean << "ns)";
-        TCP.addTimeCalibParam(i, mean, false);                                                // take calib value of last cell; or 400 ns shift default value
-        TCP.addTimeCalibParam(i, mean + EMCALCalibParams::Instance().lowGainOffset_tc, true); // take calib value of last cell; or 400 ns shift default value
+        fitErrors[i] = err;
+      }
+    }
+
+    double mean = 0;
+    for (int i = 0; i < mNcells; ++i) {
+      if (fitErrors[i]) {
+        LOG(warning) << createErrorMessageFitGaus(*fitErrors[i]) << "; for cell " << i << " (Will take the parameter of the previous cell: " << mean << "ns)";
+      } else {
+        mean = cellMeans[i];
       }
+      // add mean to time calib params, in case of a failed fit the value of the last cell; or 400 ns shift default value
+      TCP.addTimeCalibParam(i, mean, false);                                                // highGain calib factor
+      TCP.addTimeCalibParam(i, mean + EMCALCalibParams::Instance().lowGainOffset_tc, true); // lowGain calib factor
     }
     return TCP;
   }
@@ -98,13 +98,11 @@ class EMCALChannelData
   /// \brief Get current calibration histogram
   const boostHisto& getHisto()
   {
-    // set the summed histogram to one of the existing histograms
+    // set the summed histogram to the histogram of the first thread
     mHistoSummed = mHisto[0];
-    // reset the histogram
-    mHistoSummed.reset();
-    // Sum up all entries
-    for (const auto& h : mHisto) {
-      mHistoSummed += h;
+    // Sum up the entries of the other threads
+    for (size_t i = 1; i < mHisto.size(); i++) {
+      o2::utils::addBoostHistos(mHistoSummed, mHisto[i]);
     }
     return mHistoSummed;
   }
@@ -116,9 +114,8 @@ class EMCALChannelData
   const boostHisto& getHistoTime()
   {
     mHistoTimeSummed = mHistoTime[0];
-    mHistoTimeSummed.reset();
-    for (const auto& h : mHistoTime) {
-      mHistoTimeSummed += h;
+    for (size_t i = 1; i < mHistoTime.size(); i++) {
+      o2::utils::addBoostHistos(mHistoTimeSummed, mHistoTime[i]);
     }
     return mHistoTimeSummed;
   }
@@ -29,6 +29,7 @@
 
 #include "Framework/Logger.h"
 #include "CommonUtils/MemFileHelper.h"
+#include "CommonUtils/BoostHistogramUtils.h"
 #include "CCDB/CcdbApi.h"
 #include "DetectorsCalibration/Utils.h"
 #include <boost/histogram.hpp>
@@ -95,13 +96,11 @@ class EMCALTimeCalibData
   /// \brief Get current histogram
   const boostHisto& getHisto()
   {
-    // set the summed histogram to one of the existing histograms
+    // set the summed histogram to the histogram of the first thread
     mHistoSummed = mTimeHisto[0];
-    // reset the histogram
-    mHistoSummed.reset();
-    // Sum up all entries
-    for (const auto& h : mTimeHisto) {
-      mHistoSummed += h;
+    // Sum up the entries of the other threads
+    for (size_t i = 1; i < mTimeHisto.size(); i++) {
+      o2::utils::addBoostHistos(mHistoSummed, mTimeHisto[i]);
     }
     return mHistoSummed;
   }
@@ -93,7 +93,7 @@ void EMCALChannelData::fill(const gsl::span<const o2::emcal::Cell> data)
   auto size_per_thread = static_cast<unsigned int>(std::ceil((static_cast<float>(data.size()) / mNThreads)));
   unsigned int currentfirst = 0;
   for (int ithread = 0; ithread < mNThreads; ithread++) {
-    unsigned int nelements = std::min(size_per_thread, static_cast<unsigned int>(data.size() - 1 - currentfirst));
+    unsigned int nelements = std::min(size_per_thread, static_cast<unsigned int>(data.size() - currentfirst)); // the last thread(s) may get fewer or no cells
     ranges[ithread] = data.subspan(currentfirst, nelements);
     currentfirst += nelements;
   }
@@ -129,8 +129,8 @@ void EMCALChannelData::merge(EMCALChannelData* prev)
 {
   mEvents += prev->getNEvents();
   mNEntriesInHisto += prev->getNEntriesInHisto();
-  mHisto[0] += prev->getHisto();
-  mHistoTime[0] += prev->getHisto();
+  o2::utils::addBoostHistos(mHisto[0], prev->getHisto());
+  o2::utils::addBoostHistos(mHistoTime[0], prev->getHistoTime());
 }
 
 //_____________________________________________
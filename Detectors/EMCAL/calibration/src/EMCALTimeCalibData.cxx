@@ -54,7 +54,7 @@ void EMCALTimeCalibData::merge(EMCALTimeCalibData* prev)
 {
   mEvents += prev->getNEvents();
   mNEntriesInHisto += prev->getNEntriesInHisto();
-  mTimeHisto[0] += prev->getHisto();
+  o2::utils::addBoostHistos(mTimeHisto[0], prev->getHisto());
 }
 //_____________________________________________
 bool EMCALTimeCalibData::hasEnoughData() const
@@ -108,7 +108,7 @@ void EMCALTimeCalibData::fill(const gsl::span<const o2::emcal::Cell> data)
   auto size_per_thread = static_cast<unsigned int>(std::ceil((static_cast<float>(data.size()) / mNThreads)));
   unsigned int currentfirst = 0;
   for (int ithread = 0; ithread < mNThreads; ithread++) {
-    unsigned int nelements = std::min(size_per_thread, static_cast<unsigned int>(data.size() - 1 - currentfirst));
+    unsigned int nelements = std::min(size_per_thread, static_cast<unsigned int>(data.size() - currentfirst)); // the last thread(s) may get fewer or no cells
     ranges[ithread] = data.subspan(currentfirst, nelements);
     currentfirst += nelements;
     LOG(debug) << "currentfirst " << currentfirst << "  nelements " << nelements;
@@ -362,6 +362,7 @@ class AltroDecoder
   RCUTrailer mRCUTrailer;                                    ///< RCU trailer
   std::vector<Channel> mChannels;                            ///< vector of channels in the raw stream
   std::vector<MinorAltroDecodingError> mMinorDecodingErrors; ///< Container for minor (non-crashing) errors
+  std::vector<uint16_t> mUnpackedWords;                      //! 10-bit ALTRO words of the full payload, reused between events
   bool mChannelsInitialized = false;                         ///< check whether the channels are initialized
   unsigned int mMaxBunchLength = UINT_MAX;                   ///< Max bunch length
 
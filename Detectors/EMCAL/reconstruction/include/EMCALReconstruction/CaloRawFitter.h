@@ -15,6 +15,8 @@
 #include <array>
 #include <optional>
 #include <string_view>
+#include <variant>
+#include <vector>
 #include <Rtypes.h>
 #include <gsl/span>
 #include "EMCALReconstruction/CaloFitResults.h"
@@ -53,6 +55,9 @@ class CaloRawFitter
     LOW_SIGNAL            ///< No ADC value above threshold found
   };
 
+  /// \brief Outcome of the raw fit of a single channel: fit results or the error raised in the fit
+  using FitOutcome = std::variant<CaloFitResults, RawFitterError_t>;
+
   /// \brief Create error message for a given error type
   /// \param fiterror Fit error type
   /// \return Error message connected to the error type
@@ -146,6 +151,14 @@ class CaloRawFitter
 
   virtual CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) = 0;
 
+  /// \brief Evaluate amplitude and time of several channels in one go
+  /// \param channels ALTRO bunches of each channel
+  /// \param[out] outcomes Fit results or fit error of each channel, in the order of the input channels
+  ///
+  /// The default implementation evaluates the channels one by one. Fitters
+  /// which can process several channels in parallel override this method.
+  virtual void evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<FitOutcome>& outcomes);
+
   /// \brief Method to do the selection of what should possibly be fitted.
   /// \param bunchvector ALTRO bunches for the current channel
   /// \param adcThreshold ADC threshold applied in peak finding
@@ -15,6 +15,7 @@
 #include <iosfwd>
 #include <array>
 #include <optional>
+#include <vector>
 #include <Rtypes.h>
 #include "EMCALReconstruction/CaloFitResults.h"
 #include "DataFormatsEMCAL/Constants.h"
@@ -60,7 +61,53 @@ class CaloRawFitterGamma2 final : public CaloRawFitter
   /// \return Container with the fit results (amp, time, chi2, ...)
   CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) final;
 
+  /// \brief Evaluation of amplitude and TOF of several channels
+  /// \param channels ALTRO bunches of each channel
+  /// \param[out] outcomes Fit results or fit error of each channel, in the order of the input channels
+  ///
+  /// The peak fits of all channels are performed in parallel lanes on a fixed
+  /// window of EMCAL_MAXTIMEBINS samples, samples outside the fit range of a channel
+  /// being masked. The results are the same as the ones of evaluate.
+  void evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<FitOutcome>& outcomes) final;
+
  private:
+  /// \struct FitState
+  /// \brief Intermediate state of the evaluation of a channel
+  struct FitState {
+    float amp = 0;           ///< Amplitude (initial guess before, result after the peak fit)
+    float time = 0;          ///< Time (initial guess before, result after the peak fit)
+    float chi2 = 0;          ///< Chi2 of the peak fit
+    int ndf = 0;             ///< Number of degrees of freedom of the peak fit
+    bool needsFit = false;   ///< Samples are suited for a peak fit
+    bool fitDone = false;    ///< Peak fit was successful
+    float ampEstimate = 0;   ///< Max. amplitude estimated from the samples
+    short timeEstimate = 0;  ///< Time bin of the max. amplitude
+    short maxADC = 0;        ///< Max. ADC value
+    float pedEstimate = 0;   ///< Pedestal
+    int timebinOffset = 0;   ///< Offset of the first time bin of the selected bunch
+    int first = 0;           ///< First time bin used in the peak fit
+    int nsamples = 0;        ///< Number of time bins used in the peak fit
+  };
+
+  /// \brief Select the samples of the channel and obtain the initial guess of the peak fit
+  /// \param bunchvector ALTRO bunches for the current channel
+  /// \return Fit state before the peak fit
+  /// \throw RawFitterError_t in case the samples cannot be selected
+  FitState prepareFit(const gsl::span<const Bunch> bunchvector);
+
+  /// \brief Validate the peak fit against the estimates and build the fit results
+  /// \param state Fit state after the peak fit
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t::FIT_ERROR in case the amplitude is below the amplitude cut
+  CaloFitResults finalizeFit(FitState& state) const;
+
+  /// \brief Perform the peak fits of several channels in parallel lanes
+  /// \param states Fit states of the channels to be fitted
+  /// \param samples Pedestal-subtracted samples of the channels, EMCAL_MAXTIMEBINS per channel
+  ///
+  /// Same iterations as doFit_1peak. Channels for which the fit fails are set back to the estimates.
+  void doFit_1peakBatch(gsl::span<FitState*> states, gsl::span<const double> samples);
+
   int mNiter = 0;           ///< number of iteraions
   int mNiterationsMax = 15; ///< max number of iteraions
 
@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef EMCALRAWFITTERLUT_H_
+#define EMCALRAWFITTERLUT_H_
+
+#include <iosfwd>
+#include <array>
+#include <Rtypes.h>
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitter.h"
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \class CaloRawFitterLUT
+/// \brief  Raw data fitting: lookup table of the peak position
+/// \ingroup EMCALreconstruction
+///
+/// Extraction of amplitude and peak position from the
+/// ratio of the samples around the maximum. The asymmetry
+/// of the two neighbouring samples of the max. sample depends
+/// only on the distance between the max. sample and the peak
+/// for the response function used in CaloRawFitterStandard.
+/// The inverse relation, together with the amplitude correction
+/// at the max. sample, is tabulated once at construction.
+/// The evaluation requires no iteration and no minimizer.
+class CaloRawFitterLUT final : public CaloRawFitter
+{
+
+ public:
+  /// \brief Constructor
+  CaloRawFitterLUT();
+
+  /// \brief Destructor
+  ~CaloRawFitterLUT() final = default;
+
+  /// \brief Evaluation Amplitude and TOF
+  /// \param bunchvector Calo bunches for the tower and event
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t in case the fit failed (including all possible errors from upstream)
+  CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) final;
+
+  /// \brief Extract amplitude and peak position from the three samples around the maximum
+  /// \param maxTimeBin Time bin of the max. sample
+  /// \return amplitude, time of the peak
+  /// \throw RawFitterError_t::FIT_ERROR in case the sample asymmetry is outside the range of the lookup table
+  std::tuple<float, float> lookupPeak(int maxTimeBin) const;
+
+  /// \brief Response function of the EMCal electronics normalized to a peak amplitude 1
+  /// \param dt Distance to the peak (in timebin units)
+  /// \return Response at the distance dt of the peak
+  static double responseFunction(double dt);
+
+  /// \brief Get the number of entries of the lookup table
+  /// \return Number of entries
+  static constexpr int getNumberOfEntries() { return NENTRIES; }
+
+ private:
+  static constexpr int NENTRIES = 1000;    ///< Number of entries in the lookup table
+  static constexpr double MAXOFFSET = 1.; ///< Max. distance (in timebin units) between max. sample and peak covered by the table
+
+  /// \brief Asymmetry of the two neighbouring samples of the max. sample
+  /// \param offset Distance between the max. sample and the peak
+  /// \return Asymmetry (next - previous) / (next + previous)
+  static double sampleAsymmetry(double offset);
+
+  void buildTable();
+
+  double mAsymmetryMin = 0.;                    ///< Asymmetry of the first entry of the table
+  double mAsymmetryStep = 0.;                   ///< Asymmetry step between two entries of the table
+  std::array<double, NENTRIES> mOffset;         ///< Distance between max. sample and peak for each asymmetry
+  std::array<double, NENTRIES> mAmplitudeScale; ///< Ratio between peak amplitude and max. sample for each asymmetry
+
+  ClassDefNV(CaloRawFitterLUT, 1);
+}; // End of CaloRawFitterLUT
+
+} // namespace emcal
+
+} // namespace o2
+#endif
@@ -139,6 +139,19 @@ CaloRawFitter::CaloRawFitter(const char* name, const char* nameshort) : mMinTime
 {
 }
 
+void CaloRawFitter::evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<FitOutcome>& outcomes)
+{
+  outcomes.clear();
+  outcomes.reserve(channels.size());
+  for (const auto& bunches : channels) {
+    try {
+      outcomes.emplace_back(evaluate(bunches));
+    } catch (RawFitterError_t& e) {
+      outcomes.emplace_back(e);
+    }
+  }
+}
+
 void CaloRawFitter::setTimeConstraint(int min, int max)
 {
 
@@ -13,6 +13,7 @@
 /// \author Martin Poghosyan (Martin.Poghosyan@cern.ch)
 
 #include <fairlogger/Logger.h>
+#include <algorithm>
 #include <cfloat>
 #include <random>
 
@@ -34,60 +35,115 @@ CaloRawFitterGamma2::CaloRawFitterGamma2() : CaloRawFitter("Chi Square ( Gamma2
 
 CaloFitResults CaloRawFitterGamma2::evaluate(const gsl::span<const Bunch> bunchlist)
 {
-  float time = 0;
-  float amp = 0;
-  float chi2 = 0;
-  int ndf = 0;
-  bool fitDone = false;
+  auto state = prepareFit(bunchlist);
+  if (state.needsFit) {
+    mNiter = 0;
+    try {
+      state.chi2 = doFit_1peak(state.first, state.nsamples, state.amp, state.time);
+      state.fitDone = true;
+    } catch (RawFitterError_t& e) {
+      // Fit has failed, set values to estimates
+      // TODO: Check whether we want to include cases in which the peak fit failed
+      state.amp = state.ampEstimate;
+      state.time = state.timeEstimate;
+      state.chi2 = 1.e9;
+    }
+  }
+  return finalizeFit(state);
+}
+
+void CaloRawFitterGamma2::evaluateBatch(const gsl::span<const gsl::span<const Bunch>> channels, std::vector<FitOutcome>& outcomes)
+{
+  outcomes.clear();
+  outcomes.resize(channels.size());
+  std::vector<FitState> states(channels.size());
+  std::vector<bool> prepared(channels.size(), false);
+  std::vector<FitState*> fitStates;
+  std::vector<double> samples;
+  for (std::size_t ichannel = 0; ichannel < channels.size(); ichannel++) {
+    try {
+      states[ichannel] = prepareFit(channels[ichannel]);
+      prepared[ichannel] = true;
+    } catch (RawFitterError_t& e) {
+      outcomes[ichannel] = e;
+      continue;
+    }
+    if (states[ichannel].needsFit) {
+      // the reversed samples are overwritten by the next channel, keep a copy for the fit
+      fitStates.push_back(&states[ichannel]);
+      samples.insert(samples.end(), mReversed.begin(), mReversed.end());
+    }
+  }
+
+  doFit_1peakBatch(fitStates, samples);
+
+  for (std::size_t ichannel = 0; ichannel < channels.size(); ichannel++) {
+    if (!prepared[ichannel]) {
+      continue;
+    }
+    try {
+      outcomes[ichannel] = finalizeFit(states[ichannel]);
+    } catch (RawFitterError_t& e) {
+      outcomes[ichannel] = e;
+    }
+  }
+}
+
+CaloRawFitterGamma2::FitState CaloRawFitterGamma2::prepareFit(const gsl::span<const Bunch> bunchlist)
+{
+  FitState state;
 
   auto [nsamples, bunchIndex, ampEstimate,
         maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, mAmpCut);
+  state.ampEstimate = ampEstimate;
+  state.timeEstimate = timeEstimate;
+  state.maxADC = maxADC;
+  state.pedEstimate = pedEstimate;
+  state.first = first;
+  state.nsamples = nsamples;
 
   if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
-    time = timeEstimate;
-    int timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
-    amp = ampEstimate;
+    state.time = timeEstimate;
+    state.timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+    state.amp = ampEstimate;
 
     if (nsamples > 2 && maxADC < constants::OVERFLOWCUT) {
-      std::tie(amp, time) = doParabolaFit(timeEstimate - 1);
-      mNiter = 0;
-      try {
-        chi2 = doFit_1peak(first, nsamples, amp, time);
-        fitDone = true;
-      } catch (RawFitterError_t& e) {
-        // Fit has failed, set values to estimates
-        // TODO: Check whether we want to include cases in which the peak fit failed
-        amp = ampEstimate;
-        time = timeEstimate;
-        chi2 = 1.e9;
-      }
-
-      time += timebinOffset;
-      timeEstimate += timebinOffset;
-      ndf = nsamples - 2;
+      // initial guess from the parabola fit, must be done while the reversed samples belong to this channel
+      std::tie(state.amp, state.time) = doParabolaFit(timeEstimate - 1);
+      state.needsFit = true;
     }
   }
+  return state;
+}
 
-  if (fitDone) {
-    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
-    float timeDiff = time - timeEstimate;
+CaloFitResults CaloRawFitterGamma2::finalizeFit(FitState& state) const
+{
+  if (state.needsFit) {
+    state.time += state.timebinOffset;
+    state.timeEstimate += state.timebinOffset;
+    state.ndf = state.nsamples - 2;
+  }
+
+  if (state.fitDone) {
+    float ampAsymm = (state.amp - state.ampEstimate) / (state.amp + state.ampEstimate);
+    float timeDiff = state.time - state.timeEstimate;
 
     if ((TMath::Abs(ampAsymm) > 0.1) || (TMath::Abs(timeDiff) > 2)) {
-      amp = ampEstimate;
-      time = timeEstimate;
-      fitDone = false;
+      state.amp = state.ampEstimate;
+      state.time = state.timeEstimate;
+      state.fitDone = false;
     }
   }
-  if (amp >= mAmpCut) {
-    if (!fitDone) {
+  if (state.amp >= mAmpCut) {
+    if (!state.fitDone) {
       std::default_random_engine generator;
       std::uniform_real_distribution<float> distribution(0.0, 1.0);
-      amp += (0.5 - distribution(generator));
+      state.amp += (0.5 - distribution(generator));
     }
-    time = time * constants::EMCAL_TIMESAMPLE;
-    time -= mL1Phase;
+    state.time = state.time * constants::EMCAL_TIMESAMPLE;
+    state.time -= mL1Phase;
 
-    return CaloFitResults(maxADC, pedEstimate, 0, amp, time, (int)time, chi2, ndf);
+    return CaloFitResults(state.maxADC, state.pedEstimate, 0, state.amp, state.time, (int)state.time, state.chi2, state.ndf);
   }
   // Fit failed, rethrow error
   throw RawFitterError_t::FIT_ERROR;
@@ -157,6 +213,102 @@ float CaloRawFitterGamma2::doFit_1peak(int firstTimeBin, int nSamples, float& am
   return chi2;
 }
 
+void CaloRawFitterGamma2::doFit_1peakBatch(gsl::span<FitState*> states, gsl::span<const double> samples)
+{
+  constexpr int nTimeBins = constants::EMCAL_MAXTIMEBINS;
+  const int nLanes = states.size();
+  mNiter = 0;
+  if (nLanes == 0) {
+    return;
+  }
+
+  // Lanes stored as structure of arrays, the samples of a time bin being contiguous for all lanes
+  std::vector<double> reversed(nTimeBins * nLanes);
+  std::vector<float> ampl(nLanes), time(nLanes), chi2(nLanes);
+  std::vector<int> nsamples(nLanes);
+  std::vector<char> active(nLanes);
+  std::vector<double> c11(nLanes), c12(nLanes), c21(nLanes), c22(nLanes), d1(nLanes), d2(nLanes);
+  int nActive = 0;
+  for (int lane = 0; lane < nLanes; lane++) {
+    for (int itbin = 0; itbin < nTimeBins; itbin++) {
+      reversed[itbin * nLanes + lane] = samples[lane * nTimeBins + itbin];
+    }
+    ampl[lane] = states[lane]->amp;
+    time[lane] = states[lane]->time;
+    nsamples[lane] = std::min(states[lane]->nsamples, nTimeBins);
+    // fit using gamma-2 function (ORDER =2 assumed) needs at least 3 samples
+    active[lane] = states[lane]->nsamples >= 3;
+    nActive += active[lane];
+  }
+
+  for (int iteration = 0; iteration <= mNiterationsMax && nActive > 0; iteration++) {
+    mNiter++;
+    std::fill(c11.begin(), c11.end(), 0.);
+    std::fill(c12.begin(), c12.end(), 0.);
+    std::fill(c21.begin(), c21.end(), 0.);
+    std::fill(c22.begin(), c22.end(), 0.);
+    std::fill(d1.begin(), d1.end(), 0.);
+    std::fill(d2.begin(), d2.end(), 0.);
+    std::fill(chi2.begin(), chi2.end(), 0.f);
+
+    for (int itbin = 0; itbin < nTimeBins; itbin++) {
+      const double* sample = &reversed[itbin * nLanes];
+      // Branch-free loop over the lanes, samples not contributing to the fit get a weight 0
+      for (int lane = 0; lane < nLanes; lane++) {
+        double ti = (itbin - time[lane]) / constants::TAU;
+        double w = (active[lane] && itbin < nsamples[lane] && !((ti + 1) < 0)) ? 1. : 0.;
+        ti = (w != 0.) ? ti : 0.;
+        double g_1i = (ti + 1) * TMath::Exp(-2 * ti);
+        double g_i = (ti + 1) * g_1i;
+        double gp_i = 2 * (g_i - g_1i);
+        double q1_i = (2 * ti + 1) * TMath::Exp(-2 * ti);
+        double q2_i = g_1i * g_1i * (4 * ti + 1);
+        c11[lane] += w * ((sample[lane] - ampl[lane] * 2 * g_i) * gp_i);
+        c12[lane] += w * (g_i * g_i);
+        c21[lane] += w * (sample[lane] * q1_i - ampl[lane] * q2_i);
+        c22[lane] += w * (g_i * g_1i);
+        double delta = ampl[lane] * g_i - sample[lane];
+        d1[lane] += w * (delta * g_i);
+        d2[lane] += w * (delta * g_1i);
+        chi2[lane] += w * (delta * delta);
+      }
+    }
+
+    for (int lane = 0; lane < nLanes; lane++) {
+      if (!active[lane]) {
+        continue;
+      }
+      double D = c11[lane] * c22[lane] - c12[lane] * c21[lane];
+      if (TMath::Abs(D) < DBL_EPSILON) {
+        active[lane] = false;
+        nActive--;
+        continue;
+      }
+      double dt = (d1[lane] * c22[lane] - d2[lane] * c12[lane]) / D * constants::TAU;
+      double dA = (d1[lane] * c21[lane] - d2[lane] * c11[lane]) / D;
+      time[lane] += dt;
+      ampl[lane] += dA;
+      if (!(TMath::Abs(dA) > 1 || TMath::Abs(dt) > 0.01)) {
+        states[lane]->amp = ampl[lane];
+        states[lane]->time = time[lane];
+        states[lane]->chi2 = chi2[lane];
+        states[lane]->fitDone = true;
+        active[lane] = false;
+        nActive--;
+      }
+    }
+  }
+
+  // Fit has failed (no convergence within the max. number of iterations or matrix not invertible), set values to estimates
+  for (auto state : states) {
+    if (!state->fitDone) {
+      state->amp = state->ampEstimate;
+      state->time = state->timeEstimate;
+      state->chi2 = 1.e9;
+    }
+  }
+}
+
 std::tuple<float, float> CaloRawFitterGamma2::doParabolaFit(int maxTimeBin) const
 {
   float amp(0.), time(0.);
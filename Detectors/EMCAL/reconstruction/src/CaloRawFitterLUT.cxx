@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CaloRawFitterLUT.cxx
+
+#include <algorithm>
+#include <random>
+
+// ROOT sytem
+#include "TMath.h"
+
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "DataFormatsEMCAL/Constants.h"
+
+#include "EMCALReconstruction/CaloRawFitterLUT.h"
+
+using namespace o2::emcal;
+
+CaloRawFitterLUT::CaloRawFitterLUT() : CaloRawFitter("Lookup table", "LUT")
+{
+  mAlgo = FitAlgorithm::LookupTable;
+  buildTable();
+}
+
+double CaloRawFitterLUT::responseFunction(double dt)
+{
+  // same response function as in CaloRawFitterStandard, with the peak at dt = 0
+  double xx = dt / constants::TAU + 1;
+  if (xx <= 0) {
+    return 0.;
+  }
+  return TMath::Power(xx, constants::ORDER) * TMath::Exp(constants::ORDER * (1 - xx));
+}
+
+double CaloRawFitterLUT::sampleAsymmetry(double offset)
+{
+  double previous = responseFunction(offset - 1), next = responseFunction(offset + 1);
+  return (next - previous) / (next + previous);
+}
+
+void CaloRawFitterLUT::buildTable()
+{
+  // The asymmetry is decreasing with the distance between the max. sample and the peak,
+  // the table is filled in equidistant steps of the asymmetry by bisection
+  mAsymmetryMin = sampleAsymmetry(MAXOFFSET);
+  mAsymmetryStep = (sampleAsymmetry(-MAXOFFSET) - mAsymmetryMin) / (NENTRIES - 1);
+  for (int ientry = 0; ientry < NENTRIES; ientry++) {
+    double asymmetry = mAsymmetryMin + ientry * mAsymmetryStep;
+    double low = -MAXOFFSET, high = MAXOFFSET;
+    for (int istep = 0; istep < 60; istep++) {
+      double mid = 0.5 * (low + high);
+      if (sampleAsymmetry(mid) > asymmetry) {
+        low = mid;
+      } else {
+        high = mid;
+      }
+    }
+    mOffset[ientry] = 0.5 * (low + high);
+    mAmplitudeScale[ientry] = 1. / responseFunction(mOffset[ientry]);
+  }
+}
+
+std::tuple<float, float> CaloRawFitterLUT::lookupPeak(int maxTimeBin) const
+{
+  double previous = getReversed(maxTimeBin - 1), next = getReversed(maxTimeBin + 1);
+  if (previous + next <= 0) {
+    throw RawFitterError_t::FIT_ERROR;
+  }
+  double position = ((next - previous) / (next + previous) - mAsymmetryMin) / mAsymmetryStep;
+  if (!(position >= 0 && position <= NENTRIES - 1)) {
+    throw RawFitterError_t::FIT_ERROR;
+  }
+  int ientry = std::min(static_cast<int>(position), NENTRIES - 2);
+  double weight = position - ientry;
+  double offset = (1 - weight) * mOffset[ientry] + weight * mOffset[ientry + 1];
+  double scale = (1 - weight) * mAmplitudeScale[ientry] + weight * mAmplitudeScale[ientry + 1];
+  return std::make_tuple(getReversed(maxTimeBin) * scale, maxTimeBin - offset);
+}
+
+CaloFitResults CaloRawFitterLUT::evaluate(const gsl::span<const Bunch> bunchlist)
+{
+  float time = 0;
+  float amp = 0;
+  float chi2 = 0;
+  int ndf = 0;
+  bool fitDone = false;
+
+  auto [nsamples, bunchIndex, ampEstimate,
+        maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, mAmpCut);
+
+  if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
+    time = timeEstimate;
+    int timebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+    amp = ampEstimate;
+
+    // the two neighbouring samples of the max. sample must be part of the peak region
+    if (nsamples > 2 && maxADC < constants::OVERFLOWCUT && timeEstimate > first && timeEstimate < last) {
+      try {
+        std::tie(amp, time) = lookupPeak(timeEstimate);
+        chi2 = calculateChi2(amp, time, first, last);
+        time += timebinOffset;
+        timeEstimate += timebinOffset;
+        ndf = nsamples - 2;
+        fitDone = true;
+      } catch (RawFitterError_t& error) {
+        amp = ampEstimate;
+        time = timeEstimate;
+      }
+    }
+  }
+  if (fitDone) {
+    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
+    float timeDiff = time - timeEstimate;
+
+    if ((TMath::Abs(ampAsymm) > 0.1) || (TMath::Abs(timeDiff) > 2)) {
+      amp = ampEstimate;
+      time = timeEstimate;
+      fitDone = false;
+    }
+  }
+  if (amp >= mAmpCut) {
+    if (!fitDone) {
+      std::default_random_engine generator;
+      std::uniform_real_distribution<float> distribution(0.0, 1.0);
+      amp += (0.5 - distribution(generator));
+    }
+    time = time * constants::EMCAL_TIMESAMPLE;
+    time -= mL1Phase;
+
+    return CaloFitResults(maxADC, pedEstimate, 0, amp, time, (int)time, chi2, ndf);
+  }
+  throw RawFitterError_t::FIT_ERROR;
+}
@@ -0,0 +1,95 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include <variant>
+#include <vector>
+#include <gsl/span>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
+
+namespace o2
+{
+namespace emcal
+{
+
+/// \brief Simulate a channel with a single bunch containing a gamma-2 pulse
+std::vector<Bunch> makeChannel(double amplitude, double peaktime, std::default_random_engine& generator)
+{
+  std::normal_distribution<double> noise(0., 1.);
+  constexpr int nsamples = constants::EMCAL_MAXTIMEBINS;
+  std::vector<Bunch> bunches;
+  auto& bunch = bunches.emplace_back(nsamples, nsamples - 1);
+  // samples are stored in reversed time order
+  for (int itbin = nsamples - 1; itbin >= 0; itbin--) {
+    double ti = (itbin - peaktime) / constants::TAU;
+    double signal = ti + 1 > 0 ? amplitude * (ti + 1) * (ti + 1) * std::exp(-2 * ti) : 0.;
+    signal = std::max(signal + noise(generator), 0.);
+    bunch.addADC(static_cast<uint16_t>(std::min(std::lround(signal), 1023l)));
+  }
+  return bunches;
+}
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterGamma2Batch_test)
+{
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<double> amplitudes(1., 1200.), peaktimes(2., 10.);
+  std::vector<std::vector<Bunch>> channels;
+  for (int ichannel = 0; ichannel < 1000; ichannel++) {
+    channels.push_back(makeChannel(amplitudes(generator), peaktimes(generator), generator));
+  }
+  // channels with signals close to the noise, mostly rejected by the fitter
+  std::uniform_real_distribution<double> lowamplitudes(0., 5.);
+  for (int ichannel = 0; ichannel < 100; ichannel++) {
+    channels.push_back(makeChannel(lowamplitudes(generator), peaktimes(generator), generator));
+  }
+  std::vector<gsl::span<const Bunch>> channelspans(channels.begin(), channels.end());
+
+  CaloRawFitterGamma2 scalarfitter, batchfitter;
+  std::vector<CaloRawFitter::FitOutcome> outcomes;
+  batchfitter.evaluateBatch(channelspans, outcomes);
+  BOOST_REQUIRE_EQUAL(outcomes.size(), channels.size());
+
+  int nfits = 0, nerrors = 0;
+  for (std::size_t ichannel = 0; ichannel < channels.size(); ichannel++) {
+    CaloRawFitter::FitOutcome expected;
+    try {
+      expected = scalarfitter.evaluate(channelspans[ichannel]);
+    } catch (CaloRawFitter::RawFitterError_t& e) {
+      expected = e;
+    }
+    BOOST_REQUIRE_EQUAL(expected.index(), outcomes[ichannel].index());
+    if (std::holds_alternative<CaloRawFitter::RawFitterError_t>(expected)) {
+      BOOST_CHECK(std::get<CaloRawFitter::RawFitterError_t>(expected) == std::get<CaloRawFitter::RawFitterError_t>(outcomes[ichannel]));
+      nerrors++;
+      continue;
+    }
+    const auto& scalarresult = std::get<CaloFitResults>(expected);
+    const auto& batchresult = std::get<CaloFitResults>(outcomes[ichannel]);
+    BOOST_CHECK_EQUAL(scalarresult.getMaxSig(), batchresult.getMaxSig());
+    BOOST_CHECK_EQUAL(scalarresult.getNdf(), batchresult.getNdf());
+    BOOST_CHECK_CLOSE(scalarresult.getAmp(), batchresult.getAmp(), 1e-4);
+    BOOST_CHECK_CLOSE(scalarresult.getTime(), batchresult.getTime(), 1e-4);
+    BOOST_CHECK_CLOSE(scalarresult.getChi2(), batchresult.getChi2(), 1e-3);
+    nfits++;
+  }
+  BOOST_CHECK_GT(nfits, 0);
+  BOOST_CHECK_GT(nerrors, 0);
+}
+
+} // namespace emcal
+} // namespace o2
@@ -0,0 +1,60 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterLUT.h"
+
+namespace o2
+{
+namespace emcal
+{
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterLUT_test)
+{
+  CaloRawFitterLUT fitter;
+  BOOST_CHECK_EQUAL(fitter.getAlgo(), FitAlgorithm::LookupTable);
+  BOOST_CHECK_CLOSE(CaloRawFitterLUT::responseFunction(0.), 1., 1e-9);
+
+  constexpr int nsamples = constants::EMCAL_MAXTIMEBINS;
+  for (double amplitude : {50., 200., 800.}) {
+    for (double peaktime = 4.; peaktime < 8.; peaktime += 0.1) {
+      // noise-free pulse in a single bunch, samples stored in reversed time order
+      std::vector<Bunch> bunches;
+      auto& bunch = bunches.emplace_back(nsamples, nsamples - 1);
+      for (int itbin = nsamples - 1; itbin >= 0; itbin--) {
+        bunch.addADC(static_cast<uint16_t>(std::lround(amplitude * CaloRawFitterLUT::responseFunction(itbin - peaktime))));
+      }
+      auto result = fitter.evaluate(bunches);
+      // rounding of the samples to integer ADC values limits the precision
+      BOOST_CHECK_CLOSE(result.getAmp(), amplitude, 1.);
+      BOOST_CHECK_SMALL(result.getTime() / constants::EMCAL_TIMESAMPLE - peaktime, 0.05);
+      BOOST_CHECK_GT(result.getNdf(), 0);
+    }
+  }
+
+  // no signal above the amplitude cut
+  std::vector<Bunch> bunches;
+  auto& bunch = bunches.emplace_back(nsamples, nsamples - 1);
+  for (int itbin = 0; itbin < nsamples; itbin++) {
+    bunch.addADC(1);
+  }
+  BOOST_CHECK_THROW(fitter.evaluate(bunches), CaloRawFitter::RawFitterError_t);
+}
+
+} // namespace emcal
+} // namespace o2
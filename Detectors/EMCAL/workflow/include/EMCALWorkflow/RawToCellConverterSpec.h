@@ -100,14 +100,14 @@ namespace reco_workflow
 /// | EMC/FASTORSTRGR      | 1                 | yes       | Trigger reconrds related to L0 timesums            |
 ///
 /// Workflow options (via --EMCALRawToCellConverterSpec ...):
-/// | Option              | Default | Possible values | Purpose                                        |
-/// |---------------------|---------|-----------------|------------------------------------------------|
-/// | fitmethod           | gamma2  | gamma2,standard | Raw fit method                                 |
-/// | maxmessage          | 100     | any int         | Max. amount of error messages on infoLogger    |
-/// | printtrailer        | false   | set (bool)      | Print RCU trailer (for debugging)              |
-/// | no-mergeHGLG        | false   | set (bool)      | Do not merge HG and LG channels for same tower |
-/// | no-checkactivelinks | false   | set (bool)      | Do not check for active links per BC           |
-/// | no-evalpedestal     | false   | set (bool)      | Disable pedestal evaluation                    |
+/// | Option              | Default | Possible values     | Purpose                                        |
+/// |---------------------|---------|---------------------|------------------------------------------------|
+/// | fitmethod           | gamma2  | gamma2,standard,lut | Raw fit method                                 |
+/// | maxmessage          | 100     | any int             | Max. amount of error messages on infoLogger    |
+/// | printtrailer        | false   | set (bool)          | Print RCU trailer (for debugging)              |
+/// | no-mergeHGLG        | false   | set (bool)          | Do not merge HG and LG channels for same tower |
+/// | no-checkactivelinks | false   | set (bool)          | Do not check for active links per BC           |
+/// | no-evalpedestal     | false   | set (bool)          | Disable pedestal evaluation                    |
 ///
 /// Global switches of the EMCAL reco workflow related to the RawToCellConverter:
 /// | Option                         | Default | Purpose                                       |
@@ -265,6 +265,14 @@ class RawToCellConverterSpec : public framework::Task
     uint8_t mRow;            ///< Row in supermodule
   };
 
+  /// \struct FEEChannel
+  /// \brief FEE channel of the current DDL waiting for the raw fit
+  struct FEEChannel {
+    const o2::emcal::Channel* mChannel; ///< Decoded channel
+    LocalPosition mPosition;            ///< Channel coordinates
+    ChannelType_t mChannelType;         ///< Channel type (High Gain, Low Gain, LEDMON)
+  };
+
   using TRUContainer = std::vector<o2::emcal::CompressedTRU>;
   using PatchContainer = std::vector<o2::emcal::CompressedTriggerPatch>;
 
@@ -313,16 +321,25 @@ class RawToCellConverterSpec : public framework::Task
   /// \throw ModuleIndexException in case of invalid module indices
   int geLEDMONAbsID(int supermoduleID, int module);
 
+  /// \brief Add the FEE channels of the current DDL to the current event
+  /// \param currentEvent Event to add the channels to
+  /// \param timeCorrector Handler for correction of the time
+  ///
+  /// Performing the raw fit of the bunches of all FEE channels of the DDL in one
+  /// batch, and adding the channels to the event in the order of the decoding.
+  void addFEEChannelsToEvent(o2::emcal::EventContainer& currentEvent, const CellTimeCorrection& timeCorrector);
+
   /// \brief Add FEE channel to the current evnet
   /// \param currentEvent Event to add the channel to
   /// \param currentchannel Current FEE channel
+  /// \param fitOutcome Result of the raw fit of the bunches in the channel, or raw fit error
   /// \param timeCorrector Handler for correction of the time
   /// \param position Channel coordinates
   /// \param chantype Channel type (High Gain, Low Gain, LEDMON)
   ///
-  /// Performing a raw fit of the bunches in the channel to extract energy and time, and
+  /// Extracting energy and time from the raw fit of the bunches in the channel, and
   /// adding them to the container for FEE data of the given event.
-  void addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype);
+  void addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CaloRawFitter::FitOutcome& fitOutcome, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype);
 
   /// \brief Add TRU channel to the event
   /// \param currentEvent Event to add the channel to
@@ -506,6 +523,9 @@ class RawToCellConverterSpec : public framework::Task
   std::unique_ptr<MappingHandler> mMapper = nullptr;                 ///!<! Mapper
   std::unique_ptr<TriggerMappingV2> mTriggerMapping;                 ///!<! Trigger mapping
   std::unique_ptr<CaloRawFitter> mRawFitter;                         ///!<! Raw fitter
+  std::vector<FEEChannel> mFEEChannels;                              ///!<! FEE channels of the current DDL waiting for the raw fit
+  std::vector<gsl::span<const Bunch>> mFEEBunches;                   ///!<! Bunches of the FEE channels of the current DDL
+  std::vector<CaloRawFitter::FitOutcome> mFitOutcomes;               ///!<! Raw fit outcomes of the FEE channels of the current DDL
   std::vector<Cell> mOutputCells;                                    ///< Container with output cells
   std::vector<TriggerRecord> mOutputTriggerRecords;                  ///< Container with output trigger records for cells
   std::vector<ErrorTypeFEE> mOutputDecoderErrors;                    ///< Container with decoder errors
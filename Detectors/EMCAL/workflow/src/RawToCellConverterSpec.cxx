@@ -13,6 +13,7 @@
 #include <iostream>
 #include <bitset>
 #include <set>
+#include <variant>
 
 #include <InfoLogger/InfoLogger.hxx>
 
@@ -38,6 +39,7 @@
 #include "EMCALReconstruction/Bunch.h"
 #include "EMCALReconstruction/CaloRawFitterStandard.h"
 #include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterLUT.h"
 #include "EMCALReconstruction/AltroDecoder.h"
 #include "EMCALReconstruction/RawDecodingError.h"
 #include "EMCALReconstruction/RecoParam.h"
@@ -88,6 +90,9 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
   } else if (fitmethod == "gamma2") {
     LOG(info) << "Using gamma2 raw fitter";
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+  } else if (fitmethod == "lut") {
+    LOG(info) << "Using lookup table raw fitter";
+    mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterLUT);
   } else {
     LOG(fatal) << "Unknown fit method" << fitmethod;
   }
@@ -280,6 +285,7 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
 
         // Loop over all the channels
         int nBunchesNotOK = 0;
+        mFEEChannels.clear();
         for (auto& chan : decoder.getChannels()) {
           try {
             auto iRow = map.getRow(chan.getHardwareAddress());
@@ -289,12 +295,13 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             switch (chantype) {
               case o2::emcal::ChannelType_t::HIGH_GAIN:
               case o2::emcal::ChannelType_t::LOW_GAIN:
-                addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype);
+                // raw fit done for all FEE channels of the DDL at once
+                mFEEChannels.push_back({&chan, channelPosition, chantype});
                 break;
               case o2::emcal::ChannelType_t::LEDMON:
                 // Drop LEDMON reconstruction in case of physics triggers
                 if (triggerbits & o2::trigger::Cal) {
-                  addFEEChannelToEvent(currentEvent, chan, timeCorrector, channelPosition, chantype);
+                  mFEEChannels.push_back({&chan, channelPosition, chantype});
                 }
                 break;
               case o2::emcal::ChannelType_t::TRU:
@@ -309,6 +316,7 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             continue;
           }
         }
+        addFEEChannelsToEvent(currentEvent, timeCorrector);
       } catch (o2::emcal::MappingHandler::DDLInvalid& ddlerror) {
         // Unable to catch mapping
         handleDDLError(ddlerror, feeID);
@@ -448,7 +456,21 @@ bool RawToCellConverterSpec::isLostTimeframe(framework::ProcessingContext& ctx)
   return false;
 }
 
-void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype)
+void RawToCellConverterSpec::addFEEChannelsToEvent(o2::emcal::EventContainer& currentEvent, const CellTimeCorrection& timeCorrector)
+{
+  mFEEBunches.clear();
+  for (const auto& feechannel : mFEEChannels) {
+    mFEEBunches.emplace_back(feechannel.mChannel->getBunches());
+  }
+  mRawFitter->evaluateBatch(mFEEBunches, mFitOutcomes);
+  for (std::size_t ichannel = 0; ichannel < mFEEChannels.size(); ichannel++) {
+    const auto& feechannel = mFEEChannels[ichannel];
+    addFEEChannelToEvent(currentEvent, *feechannel.mChannel, mFitOutcomes[ichannel], timeCorrector, feechannel.mPosition, feechannel.mChannelType);
+  }
+  mFEEChannels.clear();
+}
+
+void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CaloRawFitter::FitOutcome& fitOutcome, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype)
 {
   int CellID = -1;
   bool isLowGain = false;
@@ -466,10 +488,13 @@ void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& cur
     return;
   }
 
-  // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
+  // the raw fit of the bunches was performed for all channels of the DDL, rethrow the fit error if any
   CaloFitResults fitResults;
   try {
-    fitResults = mRawFitter->evaluate(currentchannel.getBunches());
+    if (auto fiterror = std::get_if<CaloRawFitter::RawFitterError_t>(&fitOutcome)) {
+      throw *fiterror;
+    }
+    fitResults = std::get<CaloFitResults>(fitOutcome);
     // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
     if (fitResults.getAmp() < 0) {
       fitResults.setAmp(0.);
@@ -1036,7 +1061,7 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getRawToCellConverter
     outputs,
     o2::framework::adaptFromTask<o2::emcal::reco_workflow::RawToCellConverterSpec>(subspecification, !disableDecodingErrors, !disableTriggerReconstruction, calibhandler),
     o2::framework::Options{
-      {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard or gamma2)"}},
+      {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard, gamma2 or lut)"}},
       {"maxmessage", o2::framework::VariantType::Int, 100, {"Max. amout of error messages to be displayed"}},
       {"printtrailer", o2::framework::VariantType::Bool, false, {"Print RCU trailer (for debugging)"}},
       {"no-mergeHGLG", o2::framework::VariantType::Bool, false, {"Do not merge HG and LG channels for same tower"}},
@@ -238,7 +238,7 @@ void CTFCoder::compress(CompressedDigits& cd, const gsl::span<const Digit>& digi
   std::vector<bool> reject(digitVec.size());
   if (mIRFrameSelector.isSet()) {
     for (size_t id = 0; id < digitVec.size(); id++) {
-      if (mIRFrameSelector.check(digitVec[id].mIntRecord) < 0) {
+      if (!mIRFrameSelector.isSelected(digitVec[id].mIntRecord)) {
         reject[id] = true;
         nDigSel--;
         nChanSel -= digitVec[id].ref.getEntries();
@@ -1,7 +1,7 @@
 command=$*
 echo $command
-# launch the command in the background
-$command &
+# launch the command in the background, through a shell such that DPL workflows can be piped
+bash -c "${command}" &
 # get the PID
 PID=$!
 
@@ -42,6 +42,7 @@ title = re.findall('#command line: (\\w.+)', title)[0]
 simulation = 'o2-sim '
 serial = 'o2-sim-serial'
 digitization = 'o2-sim-digitizer-workflow'
+decoding = 'o2-raw-tf-reader-workflow'
 
 # print the command for the user
 print("\nYour command was: ", title)
@@ -62,6 +63,11 @@ elif title.find(digitization) == 0:
     print("You have monitored o2 digitization.\n")
     logfilename = 'o2digi.log'
 
+elif title.find(decoding) == 0:
+    command=decoding
+    print("You have monitored o2 raw data decoding.\n")
+    logfilename = 'o2decode.log'
+
 else :
     print("I do not know this type of simulation.\n")
     exit(1)
@@ -117,10 +123,10 @@ if command==simulation: # True if you typed o2-sim
         print("No details of devices will be provided.")
         no_log = True
 
-elif command==digitization: # True if you typed o2-sim-digitizer-workflow
+elif command==digitization or command==decoding: # True if you typed o2-sim-digitizer-workflow or a raw data reader workflow
 
     try:
-        # open o2digi.log file name
+        # open o2digi.log (o2decode.log) file name
         with open(logfilename) as logfile:
 
             # save the first 100 lines in o2digi.log
@@ -154,7 +160,7 @@ elif command==digitization: # True if you typed o2-sim-digitizer-workflow
         no_log = False
         
     except IOError:
-        print("There exists no o2digi.log..")
+        print("There exists no " + logfilename + "..")
         print("No details of devices will be provided.")
         no_log = True
     
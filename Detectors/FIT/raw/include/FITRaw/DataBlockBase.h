@@ -190,6 +190,30 @@ struct DataBlockWrapper {
     srcPos += nBytesToRead;
   }
 
+  // Direct access to the raw data, w/o deserialization into mData
+  // Only for structs which are not split between GBT words, i.e. element position inside block is trivial
+  constexpr static bool sIsWordAligned = Data_t::PayloadPerGBTword % Data_t::PayloadSize == 0;
+  constexpr static std::size_t sNelementsPerWord = Data_t::PayloadPerGBTword / Data_t::PayloadSize;
+  // Checks block size in the same way as deserialize(), returns number of elements in nWords
+  static unsigned int checkNwords(const gsl::span<const uint8_t> inputBytes, size_t nWords, size_t srcPos, typename RawDataMetric::Status_t& statusBits)
+  {
+    const auto nBytesToRead = nWords * sSizeWord;
+    if ((inputBytes.size() - srcPos) < nBytesToRead || nWords < MinNwords || nWords > MaxNwords) {
+      LOG(error) << "Incomplete payload! |N GBT words " << nWords << " |bytes to read " << nBytesToRead << " |src pos " << srcPos << " |payload size " << inputBytes.size() << " |";
+      RawDataMetric::setStatusBit(statusBits, RawDataMetric::EStatusBits::kIncompletePayload);
+      return 0;
+    }
+    return std::get<kNELEMENTS>(sReadingLookupTable[nWords]);
+  }
+  // Element iElement of the block which starts at srcPos
+  static Data_t getElement(const gsl::span<const uint8_t> inputBytes, size_t srcPos, unsigned int iElement)
+  {
+    static_assert(sIsWordAligned, "Error! Direct access is possible only for elements which are not split between GBT words!");
+    Data_t data{};
+    memcpy(&data, inputBytes.data() + srcPos + (iElement / sNelementsPerWord) * sSizeWord + (iElement % sNelementsPerWord) * Data_t::PayloadSize, Data_t::PayloadSize);
+    return data;
+  }
+
   static constexpr int MaxNwords = Data_t::PayloadSize * Data_t::MaxNelements / Data_t::PayloadPerGBTword + (Data_t::PayloadSize * Data_t::MaxNelements % Data_t::PayloadPerGBTword > 0); // calculating max GBT words per block
   static constexpr int MaxNbytes = SIZE_WORD * MaxNwords;
 
@@ -399,6 +423,7 @@ class DataBlockBase : public boost::mpl::inherit<DataBlockWrapper<ConfigType, He
   // typedef DataBlock<typename Padded::Inverted,Header,DataStructures...> DataBlockInverted_t;
   typedef DataBlock<typename Config_t::InvertedPadding_t, Header, DataStructures...> DataBlockInvertedPadding_t;
   constexpr static std::size_t sHeaderSize = sizeof(Header);
+  constexpr static bool sIsDirectDecoding = false; // should be overridden by DataBlocks with decodeDirect() method
   bool isOnlyHeader() const
   {
     return sHeaderSize == mSize;
@@ -49,6 +49,36 @@ class DataBlockPM : public DataBlockBase<DataBlockPM, ConfigType, RawHeaderPMtyp
     DataPM::deserialize(srcBytes, HeaderPM::mData[0].nGBTWords, srcByteShift);
   }
   const std::size_t getNgbtWords() const { return HeaderPM::mData[0].nGBTWords; }
+  // Decoding w/o intermediate data block, with the same checks as decodeBlock() and sanityCheck()
+  // Returns the block size, the PM words are accessed afterwards with getDataDirect()
+  constexpr static bool sIsDirectDecoding = HeaderPM::sIsWordAligned && DataPM::sIsWordAligned;
+  static size_t decodeDirect(gsl::span<const uint8_t> srcBytes, size_t srcPos, RawHeaderPM& header, unsigned int& nElements, typename RawDataMetric::Status_t& statusBits)
+  {
+    nElements = 0;
+    HeaderPM::checkNwords(srcBytes, HeaderPM::MaxNwords, srcPos, statusBits);
+    if (RawDataMetric::isBitActive(statusBits, RawDataMetric::EStatusBits::kIncompletePayload)) {
+      return srcBytes.size() - srcPos;
+    }
+    header = HeaderPM::getElement(srcBytes, srcPos, 0);
+    const std::size_t dataPos = srcPos + HeaderPM::MaxNwords * HeaderPM::sSizeWord;
+    nElements = DataPM::checkNwords(srcBytes, header.nGBTWords, dataPos, statusBits);
+    if (RawDataMetric::isBitActive(statusBits, RawDataMetric::EStatusBits::kIncompletePayload)) {
+      return srcBytes.size() - srcPos;
+    }
+    if (header.isBadDescriptor()) {
+      RawDataMetric::setStatusBit(statusBits, RawDataMetric::EStatusBits::kWrongDescriptor);
+    }
+    if (nElements == 0) {
+      RawDataMetric::setStatusBit(statusBits, RawDataMetric::EStatusBits::kEmptyDataBlock);
+    } else if (nElements % 2 == 0 && getDataDirect(srcBytes, srcPos, nElements - 1).channelID == 0) {
+      nElements--; // in case of half GBT-word filling
+    }
+    return dataPos + header.nGBTWords * DataPM::sSizeWord - srcPos;
+  }
+  static RawDataPM getDataDirect(gsl::span<const uint8_t> srcBytes, size_t srcPos, unsigned int iElement)
+  {
+    return DataPM::getElement(srcBytes, srcPos + HeaderPM::MaxNwords * HeaderPM::sSizeWord, iElement);
+  }
   std::vector<char> serialize() const
   {
     std::size_t nBytes = HeaderPM::MaxNwords * HeaderPM::sSizeWord;
@@ -105,6 +135,34 @@ class DataBlockTCM : public DataBlockBase<DataBlockTCM, ConfigType, RawHeaderTCM
     HeaderTCM::deserialize(srcBytes, HeaderTCM::MaxNwords, srcByteShift);
     DataTCM::deserialize(srcBytes, HeaderTCM::mData[0].nGBTWords, srcByteShift);
   }
+  // Decoding w/o intermediate data block, with the same checks as decodeBlock() and sanityCheck()
+  // Returns the block size, the TCM word is accessed afterwards with getDataDirect()
+  constexpr static bool sIsDirectDecoding = HeaderTCM::sIsWordAligned && DataTCM::sIsWordAligned;
+  static size_t decodeDirect(gsl::span<const uint8_t> srcBytes, size_t srcPos, RawHeaderTCM& header, unsigned int& nElements, typename RawDataMetric::Status_t& statusBits)
+  {
+    nElements = 0;
+    HeaderTCM::checkNwords(srcBytes, HeaderTCM::MaxNwords, srcPos, statusBits);
+    if (RawDataMetric::isBitActive(statusBits, RawDataMetric::EStatusBits::kIncompletePayload)) {
+      return srcBytes.size() - srcPos;
+    }
+    header = HeaderTCM::getElement(srcBytes, srcPos, 0);
+    const std::size_t dataPos = srcPos + HeaderTCM::MaxNwords * HeaderTCM::sSizeWord;
+    nElements = DataTCM::checkNwords(srcBytes, header.nGBTWords, dataPos, statusBits);
+    if (RawDataMetric::isBitActive(statusBits, RawDataMetric::EStatusBits::kIncompletePayload)) {
+      return srcBytes.size() - srcPos;
+    }
+    if (header.isBadDescriptor()) {
+      RawDataMetric::setStatusBit(statusBits, RawDataMetric::EStatusBits::kWrongDescriptor);
+    }
+    if (nElements == 0) {
+      RawDataMetric::setStatusBit(statusBits, RawDataMetric::EStatusBits::kEmptyDataBlock);
+    }
+    return dataPos + header.nGBTWords * DataTCM::sSizeWord - srcPos;
+  }
+  static RawDataTCM getDataDirect(gsl::span<const uint8_t> srcBytes, size_t srcPos, unsigned int iElement)
+  {
+    return DataTCM::getElement(srcBytes, srcPos + HeaderTCM::MaxNwords * HeaderTCM::sSizeWord, iElement);
+  }
   std::vector<char> serialize() const
   {
     std::size_t nBytes = HeaderTCM::MaxNwords * HeaderTCM::sSizeWord;
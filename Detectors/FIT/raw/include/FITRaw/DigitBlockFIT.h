@@ -175,6 +175,22 @@ class DigitBlockFIT : public DigitBlockBase<DigitType, ChannelDataType>
     auto& tcmData = dataBlock.DataTCM::mData[0];
     DigitBlockFIThelper::ConvertTCMData2Digit(DigitBlockBase_t::mDigit, tcmData);
   }
+  // Filling data from PM, directly from the raw payload (see DataBlockPM::decodeDirect)
+  template <class DataBlockType, typename RawDataMetricType>
+  auto processDigitsDirect(gsl::span<const uint8_t> payload, size_t srcPos, unsigned int nElements, RawDataMetricType& metric, int linkID, int ep) -> std::enable_if_t<DigitBlockHelper::IsSpecOfType<DataBlockPM, DataBlockType>::value>
+  {
+    for (unsigned int iEventData = 0; iEventData < nElements; iEventData++) {
+      const auto pmData = DataBlockType::getDataDirect(payload, srcPos, iEventData);
+      DigitBlockFIThelper::ConvertEventData2ChData<LookupTable_t>(DigitBlockBase_t::mSubDigit, pmData, metric, linkID, ep);
+    }
+  }
+  // Filling data from TCM (normal mode), directly from the raw payload (see DataBlockTCM::decodeDirect)
+  template <class DataBlockType, typename RawDataMetricType>
+  auto processDigitsDirect(gsl::span<const uint8_t> payload, size_t srcPos, unsigned int nElements, RawDataMetricType& metric, int linkID, int ep) -> std::enable_if_t<DigitBlockHelper::IsSpecOfType<DataBlockTCM, DataBlockType>::value>
+  {
+    const auto tcmData = DataBlockType::getDataDirect(payload, srcPos, 0);
+    DigitBlockFIThelper::ConvertTCMData2Digit(DigitBlockBase_t::mDigit, tcmData);
+  }
   // Decompose digits into DataBlocks
   // DataBlockPM
   template <class DataBlockType>
@@ -331,6 +347,16 @@ class DigitBlockFIText : public DigitBlockBase<DigitType, ChannelDataType, Trigg
       DigitBlockFIThelper::ConvertEventData2ChData<LookupTable_t>(DigitBlockBase_t::mSubDigit, pmData, metric, linkID, ep);
     }
   }
+  // Filling data from PM, directly from the raw payload (see DataBlockPM::decodeDirect)
+  // Extended TCM mode has no direct decoding, TCM words are split between GBT words
+  template <class DataBlockType, typename RawDataMetricType>
+  auto processDigitsDirect(gsl::span<const uint8_t> payload, size_t srcPos, unsigned int nElements, RawDataMetricType& metric, int linkID, int ep) -> std::enable_if_t<DigitBlockHelper::IsSpecOfType<DataBlockPM, DataBlockType>::value>
+  {
+    for (unsigned int iEventData = 0; iEventData < nElements; iEventData++) {
+      const auto pmData = DataBlockType::getDataDirect(payload, srcPos, iEventData);
+      DigitBlockFIThelper::ConvertEventData2ChData<LookupTable_t>(DigitBlockBase_t::mSubDigit, pmData, metric, linkID, ep);
+    }
+  }
   // Filling data from TCM (extended mode)
   template <class DataBlockType, typename RawDataMetricType>
   auto processDigits(const DataBlockType& dataBlock, RawDataMetricType& metric, int linkID, int ep) -> std::enable_if_t<DigitBlockHelper::IsSpecOfType<DataBlockTCMext, DataBlockType>::value>
@@ -24,6 +24,7 @@
 #include <map>
 #include <unordered_map>
 #include <tuple>
+#include <iterator>
 
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/set.hpp>
@@ -89,6 +90,12 @@ class RawReaderBase
   template <class DataBlockType, typename... T>
   void processBinaryData(gsl::span<const uint8_t> payload, uint16_t feeID, uint8_t linkID, uint8_t epID)
   {
+    if constexpr (DataBlockType::sIsDirectDecoding) {
+      if (mUseDirectDecoding) {
+        processBinaryDataDirect<DataBlockType>(payload, feeID, linkID, epID);
+        return;
+      }
+    }
     auto& vecDataBlocks = getVecDataBlocks<DataBlockType>();
     auto& metric = addMetric(feeID, linkID, epID);
     auto srcPos = decodeBlocks(payload, metric, vecDataBlocks);
@@ -100,6 +107,39 @@ class RawReaderBase
     }
     vecDataBlocks.clear();
   }
+  // processing payload words directly into digits, w/o intermediate data blocks
+  // data block layout is resolved at compile time, from DataBlockType(payload structs and padding)
+  template <class DataBlockType>
+  void processBinaryDataDirect(gsl::span<const uint8_t> payload, uint16_t feeID, uint8_t linkID, uint8_t epID)
+  {
+    auto& metric = addMetric(feeID, linkID, epID);
+    size_t srcPos = 0;
+    const int nWords = payload.size() / DataBlockType::DataBlockWrapperHeader_t::sSizeWord;
+    const int pageSizeThreshold = DataBlockType::DataBlockWrapperHeader_t::sSizeWord * (nWords - int(nWords > 1)); // no need in reading last GBT word, this will be 0xff... or empty header
+    auto digitIter = mMapDigits.end();
+    while (srcPos < pageSizeThreshold) {
+      typename DataBlockType::DataBlockWrapperHeader_t::Data_t header{};
+      typename RawDataMetric::Status_t statusBits{};
+      unsigned int nElements{0};
+      const auto blockSize = DataBlockType::decodeDirect(payload, srcPos, header, nElements, statusBits);
+      if (!metric.checkBadDataBlock(statusBits)) {
+        // data blocks in page are ordered in time, i.e. digit is usually next to previous one
+        const auto intRec = header.getIntRec();
+        const auto nextIter = digitIter == mMapDigits.end() ? digitIter : std::next(digitIter);
+        if (nextIter != mMapDigits.end() && nextIter->first == intRec) {
+          digitIter = nextIter;
+        } else {
+          digitIter = mMapDigits.try_emplace(nextIter, intRec, intRec);
+        }
+        digitIter->second.template processDigitsDirect<DataBlockType>(payload, srcPos, nElements, metric, static_cast<int>(linkID), static_cast<int>(epID));
+        metric.addStatusBit(RawDataMetric::EStatusBits::kDecodedDataBlock);
+      }
+      srcPos += blockSize;
+    }
+  }
+  // decoding w/o intermediate data blocks, for data blocks which support it
+  void setDirectDecoding(bool useDirectDecoding) { mUseDirectDecoding = useDirectDecoding; }
+  bool isDirectDecoding() const { return mUseDirectDecoding; }
   RawDataMetric& addMetric(uint16_t feeID, uint8_t linkID, uint8_t epID, bool isRegisteredFEE = true)
   {
     auto metricPair = mHashTableMetrics.try_emplace(EntryCRU_t{static_cast<int>(linkID), static_cast<int>(epID)}, linkID, epID, feeID, isRegisteredFEE);
@@ -126,6 +166,7 @@ class RawReaderBase
   }
 
  private:
+  bool mUseDirectDecoding{true};
   // Check for unique DataBlock classes
   // Line below will not be compiled in case of duplicates among DataBlockTypes
   typedef std::void_t<std::enable_if_t<boost::mpl::count<boost::mpl::set<DataBlockTypes...>, DataBlockTypes>::value == 1>...> CheckUniqueTypes;
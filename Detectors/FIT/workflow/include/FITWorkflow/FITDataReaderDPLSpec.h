@@ -57,6 +57,7 @@ class FITDataReaderDPLSpec : public Task
     auto ccdbUrl = ic.options().get<std::string>("ccdb-path");
     auto lutPath = ic.options().get<std::string>("lut-path");
     mDumpMetrics = ic.options().get<bool>("dump-raw-data-metric");
+    mRawReader.setDirectDecoding(!ic.options().get<bool>("disable-direct-decoding"));
     if (!ic.options().get<bool>("disable-empty-tf-protection")) {
       mRawReader.enableEmptyTFprotection();
     }
@@ -200,6 +201,7 @@ framework::DataProcessorSpec getFITDataReaderDPLSpec(const RawReaderType& rawRea
      o2::framework::ConfigParamSpec{"reserve-vec-buffer", VariantType::Int, 0, {"Reserve memory for DataBlock vector, buffer for each page"}},
      o2::framework::ConfigParamSpec{"reserve-map-dig", VariantType::Int, 0, {"Reserve memory for Digit map, mapping in RawReader"}},
      o2::framework::ConfigParamSpec{"dump-raw-data-metric", VariantType::Bool, false, {"Dump raw data metrics, for debugging"}},
+     o2::framework::ConfigParamSpec{"disable-direct-decoding", VariantType::Bool, false, {"Decode pages through intermediate DataBlock vectors, instead of directly into digits"}},
      o2::framework::ConfigParamSpec{"disable-empty-tf-protection", VariantType::Bool, false, {"Disable empty TF protection. In case of empty payload within TF, only dummy ChannelData object will be sent."}}}};
 }
 
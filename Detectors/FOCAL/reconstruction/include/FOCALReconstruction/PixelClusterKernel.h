@@ -0,0 +1,123 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef ALICEO2_FOCAL_PIXELCLUSTERKERNEL_H
+#define ALICEO2_FOCAL_PIXELCLUSTERKERNEL_H
+
+#include "GPUCommonDef.h"
+
+namespace o2::focal::pixelclustering
+{
+
+/// \brief Sums over the pixels of one cluster, from which the cluster parameters are computed
+struct ClusterSums {
+  int mNPixels;
+  int mSumColumn;
+  int mSumRow;
+  int mMinColumn;
+  int mMaxColumn;
+  int mMinRow;
+  int mMaxRow;
+};
+
+/// \brief Root of the tree of pixel i, compressing the path on the way
+GPUdi() int findRoot(int* parent, int i)
+{
+  int root = i;
+  while (parent[root] != root) {
+    root = parent[root];
+  }
+  while (parent[i] != root) {
+    int next = parent[i];
+    parent[i] = root;
+    i = next;
+  }
+  return root;
+}
+
+/// \brief Merges the trees of pixels i and j, the lower index becomes the root
+GPUdi() void merge(int* parent, int i, int j)
+{
+  int ri = findRoot(parent, i), rj = findRoot(parent, j);
+  if (ri < rj) {
+    parent[rj] = ri;
+  } else if (rj < ri) {
+    parent[ri] = rj;
+  }
+}
+
+/// \brief Finds the clusters of adjacent (common side or corner) fired pixels of one chip
+///
+/// As the ITS clusterer, the pixels are scanned column by column, each pixel being only
+/// compared to the pixels of the previous column and to the previous pixel of its column.
+/// Only plain arrays provided by the caller are used, such that one chip can be processed
+/// by one GPU thread.
+/// \param hits Fired pixels of the chip (mColumn, mRow), sorted by column and then row
+/// \param nHits Number of fired pixels
+/// \param parent Work array of nHits elements
+/// \param label Output: index of the cluster of each pixel, clusters numbered in the order of their first pixel
+/// \return Number of clusters
+template <typename Hit>
+GPUd() int findClusters(const Hit* hits, int nHits, int* parent, int* label)
+{
+  int prevColumnStart = 0, prevColumnEnd = 0; // range of the pixels in the column before the current one
+  int columnStart = 0;                        // first pixel of the current column
+  int prevColumnPixel = 0;                    // first pixel of the previous column which can be adjacent to the current pixel
+  for (int i = 0; i < nHits; i++) {
+    parent[i] = i;
+    int column = hits[i].mColumn, row = hits[i].mRow;
+    if (i > 0 && column != hits[i - 1].mColumn) {
+      bool adjacentColumn = column == hits[i - 1].mColumn + 1;
+      prevColumnStart = adjacentColumn ? columnStart : i;
+      prevColumnEnd = i;
+      prevColumnPixel = prevColumnStart;
+      columnStart = i;
+    }
+    if (i > columnStart && hits[i - 1].mRow + 1 >= row) {
+      merge(parent, i, i - 1);
+    }
+    while (prevColumnPixel < prevColumnEnd && hits[prevColumnPixel].mRow + 1 < row) {
+      prevColumnPixel++;
+    }
+    for (int j = prevColumnPixel; j < prevColumnEnd && hits[j].mRow <= row + 1; j++) {
+      merge(parent, i, j);
+    }
+  }
+  int nClusters = 0;
+  for (int i = 0; i < nHits; i++) {
+    int root = findRoot(parent, i);
+    label[i] = root == i ? nClusters++ : label[root];
+  }
+  return nClusters;
+}
+
+/// \brief Computes the sums of the pixels of each cluster from the labels of findClusters
+template <typename Hit>
+GPUd() void sumClusters(const Hit* hits, int nHits, const int* label, int nClusters, ClusterSums* sums)
+{
+  for (int icl = 0; icl < nClusters; icl++) {
+    sums[icl] = {0, 0, 0, 0xffff, 0, 0xffff, 0};
+  }
+  for (int i = 0; i < nHits; i++) {
+    ClusterSums& sum = sums[label[i]];
+    int column = hits[i].mColumn, row = hits[i].mRow;
+    sum.mNPixels++;
+    sum.mSumColumn += column;
+    sum.mSumRow += row;
+    sum.mMinColumn = column < sum.mMinColumn ? column : sum.mMinColumn;
+    sum.mMaxColumn = column > sum.mMaxColumn ? column : sum.mMaxColumn;
+    sum.mMinRow = row < sum.mMinRow ? row : sum.mMinRow;
+    sum.mMaxRow = row > sum.mMaxRow ? row : sum.mMaxRow;
+  }
+}
+
+} // namespace o2::focal::pixelclustering
+
+#endif // ALICEO2_FOCAL_PIXELCLUSTERKERNEL_H
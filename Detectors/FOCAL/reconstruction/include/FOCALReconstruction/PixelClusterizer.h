@@ -0,0 +1,67 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef ALICEO2_FOCAL_PIXELCLUSTERIZER_H
+#define ALICEO2_FOCAL_PIXELCLUSTERIZER_H
+
+#include <vector>
+#include <gsl/span>
+#include <DataFormatsFOCAL/PixelChipRecord.h>
+#include <DataFormatsFOCAL/PixelCluster.h>
+#include <DataFormatsFOCAL/PixelHit.h>
+#include <FOCALReconstruction/PixelClusterKernel.h>
+
+namespace o2::focal
+{
+
+/// \class PixelClusterizer
+/// \brief Clusterizer of the fired pixels of the FOCAL pixel layers
+///
+/// The chips are independent and processed in parallel (OpenMP, if available), the
+/// clusters of a chip are found with the kernel of PixelClusterKernel.h which can as
+/// well run on GPU. The clusters are provided in the order of the chips and, within
+/// a chip, in the order of their first pixel, independent of the number of threads.
+class PixelClusterizer
+{
+ public:
+  PixelClusterizer() = default;
+  ~PixelClusterizer() = default;
+
+  void setNThreads(int nThreads) { mNThreads = nThreads > 0 ? nThreads : 1; }
+  int getNThreads() const { return mNThreads; }
+
+  /// \brief Find the clusters in the chips of one event
+  /// \param chips Chips of the pixel layers in the event
+  /// \param hits Fired pixels referred to by the chips
+  /// \param clusters Output container, the clusters of the event are appended
+  void process(gsl::span<const PixelChipRecord> chips, gsl::span<const PixelHit> hits, std::vector<PixelCluster>& clusters);
+
+ private:
+  /// \brief Work buffers and output of one thread
+  struct ThreadData {
+    std::vector<PixelHit> mSortedHits;
+    std::vector<int> mParent;
+    std::vector<int> mLabel;
+    std::vector<pixelclustering::ClusterSums> mSums;
+    std::vector<PixelCluster> mClusters;
+  };
+
+  void processChip(const PixelChipRecord& chip, gsl::span<const PixelHit> hits, ThreadData& data);
+
+  int mNThreads = 1;
+  std::vector<ThreadData> mThreadData; ///< Per thread buffers
+  std::vector<int> mChipFirstCluster;  ///< First cluster of each chip in the output of its thread
+  std::vector<int> mChipNClusters;     ///< Number of clusters of each chip
+  std::vector<int> mChipThread;        ///< Thread which processed each chip
+};
+
+} // namespace o2::focal
+
+#endif // ALICEO2_FOCAL_PIXELCLUSTERIZER_H
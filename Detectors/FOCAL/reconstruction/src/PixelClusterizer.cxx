@@ -0,0 +1,85 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <algorithm>
+#include <FOCALReconstruction/PixelClusterizer.h>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+using namespace o2::focal;
+
+void PixelClusterizer::process(gsl::span<const PixelChipRecord> chips, gsl::span<const PixelHit> hits, std::vector<PixelCluster>& clusters)
+{
+  int nChips = chips.size();
+  int nThreads = std::max(1, std::min(mNThreads, nChips));
+  if (mThreadData.size() < static_cast<size_t>(nThreads)) {
+    mThreadData.resize(nThreads);
+  }
+  for (auto& data : mThreadData) {
+    data.mClusters.clear();
+  }
+  mChipFirstCluster.resize(nChips);
+  mChipNClusters.resize(nChips);
+  mChipThread.resize(nChips);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int ichip = 0; ichip < nChips; ichip++) {
+#ifdef WITH_OPENMP
+    int ith = omp_get_thread_num();
+#else
+    int ith = 0;
+#endif
+    auto& data = mThreadData[ith];
+    mChipThread[ichip] = ith;
+    mChipFirstCluster[ichip] = data.mClusters.size();
+    processChip(chips[ichip], hits, data);
+    mChipNClusters[ichip] = data.mClusters.size() - mChipFirstCluster[ichip];
+  }
+
+  // collect the clusters in the order of the chips
+  size_t nClusters = clusters.size();
+  for (const auto& data : mThreadData) {
+    nClusters += data.mClusters.size();
+  }
+  clusters.reserve(nClusters);
+  for (int ichip = 0; ichip < nChips; ichip++) {
+    auto first = mThreadData[mChipThread[ichip]].mClusters.begin() + mChipFirstCluster[ichip];
+    clusters.insert(clusters.end(), first, first + mChipNClusters[ichip]);
+  }
+}
+
+void PixelClusterizer::processChip(const PixelChipRecord& chip, gsl::span<const PixelHit> hits, ThreadData& data)
+{
+  int nHits = chip.getNumberOfHits();
+  if (!nHits) {
+    return;
+  }
+  auto chipHits = hits.subspan(chip.getFirstHit(), nHits);
+  const PixelHit* sortedHits = chipHits.data();
+  if (!std::is_sorted(chipHits.begin(), chipHits.end())) {
+    data.mSortedHits.assign(chipHits.begin(), chipHits.end());
+    std::sort(data.mSortedHits.begin(), data.mSortedHits.end());
+    sortedHits = data.mSortedHits.data();
+  }
+  data.mParent.resize(nHits);
+  data.mLabel.resize(nHits);
+  int nClusters = pixelclustering::findClusters(sortedHits, nHits, data.mParent.data(), data.mLabel.data());
+  data.mSums.resize(nClusters);
+  pixelclustering::sumClusters(sortedHits, nHits, data.mLabel.data(), nClusters, data.mSums.data());
+  for (const auto& sum : data.mSums) {
+    float norm = 1.f / sum.mNPixels;
+    data.mClusters.emplace_back(chip.getLayerID(), chip.getFeeID(), chip.getLaneID(), chip.getChipID(), sum.mSumColumn * norm, sum.mSumRow * norm, sum.mNPixels,
+                                sum.mMaxColumn - sum.mMinColumn + 1, sum.mMaxRow - sum.mMinRow + 1);
+  }
+}
@@ -198,6 +198,8 @@ class MillePede2
   static void SetMinResMaxIter(const int val = 2000) { fgMinResMaxIter = val; }
   static void SetIterSolverType(const int val = MinResSolve::kSolMinRes) { fgIterSol = val; }
   static void SetNKrylovV(const int val = 60) { fgNKrylovV = val; }
+  /// \brief set the number of threads used to solve the global system with the dense matrix
+  static void SetNThreads(const int n) { o2::fwdalign::SymMatrix::SetNThreads(n); }
 
   static bool GetInvChol() { return fgInvChol; }
   static int GetMinResPrecondType() { return fgMinResCondType; }
@@ -205,6 +207,13 @@ class MillePede2
   static int GetMinResMaxIter() { return fgMinResMaxIter; }
   static int GetIterSolverType() { return fgIterSol; }
   static int GetNKrylovV() { return fgNKrylovV; }
+  static int GetNThreads() { return o2::fwdalign::SymMatrix::GetNThreads(); }
+
+  /// \brief export the global system (matrix and RHS) to files in the MatrixMarket coordinate format, e.g. for external solvers
+  bool ExportGlobalSystem(const char* matrixFileName, const char* rhsFileName) const;
+
+  /// \brief export the global system before its solution at every iteration, to files prefix_iter<N>[_rhs].mtx (no export if empty)
+  void SetExportSystemPrefix(const char* prefix) { fExportSystemPrefix = prefix; }
 
   /// \brief return error for parameter iPar
   double GetParError(int iPar) const;
@@ -360,20 +369,21 @@ class MillePede2
 
   o2::fwdalign::MillePedeRecord* fRecord; ///< Buffer of measurements records
 
-  long fCurrRecDataID;        ///< ID of the current data record
-  long fCurrRecConstrID;      ///< ID of the current constraint record
-  bool fLocFitAdd;            ///< Add contribution of carrent track (and not eliminate it)
-  bool fUseRecordWeight;      ///< force or ignore the record weight
-  bool fDisableRecordWriter;  ///< disable record writer for DPL process
-  int fMinRecordLength;       ///< ignore shorter records
-  int fSelFirst;              ///< event selection start
-  int fSelLast;               ///< event selection end
-  TArrayL* fRejRunList;       ///< list of runs to reject (if any)
-  TArrayL* fAccRunList;       ///< list of runs to select (if any)
-  TArrayF* fAccRunListWgh;    ///< optional weights for data of accepted runs (if any)
-  double fRunWgh;             ///< run weight
-  double fWghScl[2];          ///< optional rescaling for odd/even residual weights (see its usage in LocalFit)
-  std::vector<int> fkReGroup; ///< optional regrouping of parameters wrt ID's from the records
+  long fCurrRecDataID;         ///< ID of the current data record
+  long fCurrRecConstrID;       ///< ID of the current constraint record
+  bool fLocFitAdd;             ///< Add contribution of carrent track (and not eliminate it)
+  bool fUseRecordWeight;       ///< force or ignore the record weight
+  bool fDisableRecordWriter;   ///< disable record writer for DPL process
+  int fMinRecordLength;        ///< ignore shorter records
+  int fSelFirst;               ///< event selection start
+  int fSelLast;                ///< event selection end
+  TArrayL* fRejRunList;        ///< list of runs to reject (if any)
+  TArrayL* fAccRunList;        ///< list of runs to select (if any)
+  TArrayF* fAccRunListWgh;     ///< optional weights for data of accepted runs (if any)
+  double fRunWgh;              ///< run weight
+  double fWghScl[2];           ///< optional rescaling for odd/even residual weights (see its usage in LocalFit)
+  std::vector<int> fkReGroup;  ///< optional regrouping of parameters wrt ID's from the records
+  TString fExportSystemPrefix; ///< prefix of the files where to export the global system before its solution
 
   static bool fgInvChol;        ///< Invert global matrix in Cholesky solver
   static bool fgWeightSigma;    ///< weight parameter constraint by statistics
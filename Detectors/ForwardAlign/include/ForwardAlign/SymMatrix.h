@@ -88,6 +88,10 @@ class SymMatrix : public MatrixSq
 
   void SetSizeUsed(Int_t sz) { fRowLwb = sz; }
 
+  /// \brief set the number of threads of the Cholesky decomposition/inversion and of the multiplication by vector (if OpenMP is available)
+  static void SetNThreads(Int_t n) { fgNThreads = n > 0 ? n : 1; }
+  static Int_t GetNThreads() { return fgNThreads; }
+
   void Scale(Double_t coeff);
 
   /// \brief multiply from the right
@@ -214,6 +218,7 @@ class SymMatrix : public MatrixSq
 
   static SymMatrix* fgBuffer; ///< buffer for fast solution
   static Int_t fgCopyCnt;     ///< matrix copy counter
+  static Int_t fgNThreads;    ///< number of threads for the parallelized operations
 
   ClassDefOverride(SymMatrix, 0);
 };
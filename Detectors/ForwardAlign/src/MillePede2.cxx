@@ -26,6 +26,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <fstream>
+#include <iomanip>
 
 // #define _DUMP_EQ_BEFORE_
 // #define _DUMP_EQ_AFTER_
@@ -1284,6 +1285,11 @@ int MillePede2::GlobalFitIteration()
   close(defoutB);
 #endif
   //
+  if (!fExportSystemPrefix.IsNull()) {
+    TString matrixFileName = TString::Format("%s_iter%d.mtx", fExportSystemPrefix.Data(), fIter);
+    TString rhsFileName = TString::Format("%s_iter%d_rhs.mtx", fExportSystemPrefix.Data(), fIter);
+    ExportGlobalSystem(matrixFileName.Data(), rhsFileName.Data());
+  }
   fGloSolveStatus = SolveGlobalMatEq(); // obtain solution for this step
 #ifdef _DUMPEQ_AFTER_
   const char* faildumpA = Form("mp2eq_after%d.dat", fIter);
@@ -1425,6 +1431,71 @@ int MillePede2::SolveGlobalMatEq()
   return kNoInversion;
 }
 
+//_____________________________________________________________________________
+bool MillePede2::ExportGlobalSystem(const char* matrixFileName, const char* rhsFileName) const
+{
+  // write the non-zero elements of the lower triangle of the global matrix (symmetric coordinate format)
+  // and the RHS vector (array format) to MatrixMarket files
+  if (!fMatCGlo) {
+    LOG(error) << "MillePede2 - No global system to export";
+    return false;
+  }
+  std::ofstream matrixFile(matrixFileName);
+  std::ofstream rhsFile(rhsFileName);
+  if (!matrixFile || !rhsFile) {
+    LOGF(error, "MillePede2 - Failed to open %s or %s to export the global system", matrixFileName, rhsFileName);
+    return false;
+  }
+
+  auto forEachElement = [this](auto&& process) {
+    if (fgIsMatGloSparse) {
+      const auto& matrix = *(const MatrixSparse*)fMatCGlo;
+      for (int i = 0; i < fNGloSize; i++) {
+        const VectorSparse* row = matrix.GetRow(i);
+        if (!row) {
+          continue;
+        }
+        for (int iel = 0; iel < row->GetNElems(); iel++) {
+          if (row->GetElems()[iel] != 0.) {
+            process(i, int(row->GetIndices()[iel]), row->GetElems()[iel]);
+          }
+        }
+      }
+    } else {
+      const auto& matrix = *(const SymMatrix*)fMatCGlo;
+      for (int i = 0; i < fNGloSize; i++) {
+        for (int j = 0; j <= i; j++) {
+          double val = matrix(i, j);
+          if (val != 0.) {
+            process(i, j, val);
+          }
+        }
+      }
+    }
+  };
+
+  long nElements = 0;
+  forEachElement([&nElements](int, int, double) { nElements++; });
+  matrixFile << "%%MatrixMarket matrix coordinate real symmetric\n";
+  matrixFile << fNGloSize << " " << fNGloSize << " " << nElements << "\n";
+  matrixFile << std::setprecision(17);
+  forEachElement([&matrixFile](int i, int j, double val) { matrixFile << i + 1 << " " << j + 1 << " " << val << "\n"; });
+
+  rhsFile << "%%MatrixMarket matrix array real general\n";
+  rhsFile << fNGloSize << " 1\n";
+  rhsFile << std::setprecision(17);
+  for (int i = 0; i < fNGloSize; i++) {
+    rhsFile << fVecBGlo[i] << "\n";
+  }
+
+  if (!matrixFile || !rhsFile) {
+    LOGF(error, "MillePede2 - Failed to write the global system to %s and %s", matrixFileName, rhsFileName);
+    return false;
+  }
+  LOGF(info, "MillePede2 - Global system of size %d with %ld non-zero elements exported to %s and %s", fNGloSize, nElements, matrixFileName, rhsFileName);
+  return true;
+}
+
 //_____________________________________________________________________________
 Float_t MillePede2::Chi2DoFLim(int nSig, int nDoF) const
 {
@@ -18,12 +18,22 @@
 #include "ForwardAlign/SymMatrix.h"
 #include "Framework/Logger.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::fwdalign;
 
 ClassImp(SymMatrix);
 
 SymMatrix* SymMatrix::fgBuffer = nullptr;
 Int_t SymMatrix::fgCopyCnt = 0;
+Int_t SymMatrix::fgNThreads = 1;
+
+namespace
+{
+constexpr int MinRowsForThreads = 100; // minimum number of rows to process for the parallelization to pay off
+}
 
 //___________________________________________________________
 SymMatrix::SymMatrix()
@@ -218,7 +228,11 @@ void SymMatrix::Print(Option_t* option) const
 //___________________________________________________________
 void SymMatrix::MultiplyByVec(const Double_t* vecIn, Double_t* vecOut) const
 {
-  for (int i = GetSizeUsed(); i--;) {
+  // the rows are independent, so the result does not depend on the number of threads
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(fgNThreads) if (fgNThreads > 1 && GetSizeUsed() > MinRowsForThreads)
+#endif
+  for (int i = GetSizeUsed() - 1; i >= 0; i--) {
     vecOut[i] = 0.0;
     for (int j = GetSizeUsed(); j--;) {
       vecOut[i] += vecIn[j] * GetEl(i, j);
@@ -265,28 +279,36 @@ SymMatrix* SymMatrix::DecomposeChol()
   }
 
   SymMatrix& mchol = *fgBuffer;
+  int sz = GetSizeUsed();
 
-  for (int i = 0; i < GetSizeUsed(); i++) {
+  for (int i = 0; i < sz; i++) {
     Double_t* rowi = mchol.GetRow(i);
-    for (int j = i; j < GetSizeUsed(); j++) {
+    // the diagonal element first, then the rest of the column, whose elements are independent of each other
+    double sum = rowi[i];
+    for (int k = i - 1; k >= 0; k--) {
+      if (rowi[k]) {
+        sum -= rowi[k] * rowi[k];
+      }
+    }
+    if (sum <= 0.0) { // not positive-definite
+      LOG(debug) << "The matrix is not positive definite [" << sum
+                 << "]: Choleski decomposition is not possible";
+      // Print("l");
+      return nullptr;
+    }
+    rowi[i] = TMath::Sqrt(sum);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(fgNThreads) if (fgNThreads > 1 && sz - i > MinRowsForThreads)
+#endif
+    for (int j = i + 1; j < sz; j++) {
       Double_t* rowj = mchol.GetRow(j);
-      double sum = rowj[i];
+      double sumj = rowj[i];
       for (int k = i - 1; k >= 0; k--) {
         if (rowi[k] && rowj[k]) {
-          sum -= rowi[k] * rowj[k];
-        }
-      }
-      if (i == j) {
-        if (sum <= 0.0) { // not positive-definite
-          LOG(debug) << "The matrix is not positive definite [" << sum
-                     << "]: Choleski decomposition is not possible";
-          // Print("l");
-          return nullptr;
+          sumj -= rowi[k] * rowj[k];
         }
-        rowi[i] = TMath::Sqrt(sum);
-      } else {
-        rowj[i] = sum / rowi[i];
       }
+      rowj[i] = sumj / rowi[i];
     }
   }
   return fgBuffer;
@@ -329,20 +351,24 @@ void SymMatrix::InvertChol(SymMatrix* pmchol)
     }
   }
 
-  // take product of the inverted Choleski L matrix with its transposed
-  for (int i = GetSizeUsed(); i--;) {
+  // take product of the inverted Choleski L matrix with its transposed, the elements are independent of each other
+  int sz = GetSizeUsed();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(fgNThreads) if (fgNThreads > 1 && sz > MinRowsForThreads)
+#endif
+  for (int i = sz - 1; i >= 0; i--) {
     for (int j = i + 1; j--;) {
-      sum = 0;
-      for (int k = i; k < GetSizeUsed(); k++) {
+      double sumij = 0;
+      for (int k = i; k < sz; k++) {
         double& mik = mchol(i, k);
         if (mik) {
           double& mjk = mchol(j, k);
           if (mjk) {
-            sum += mik * mjk;
+            sumij += mik * mjk;
           }
         }
       }
-      (*this)(j, i) = sum;
+      (*this)(j, i) = sumij;
     }
   }
 }
@@ -39,6 +39,7 @@ struct ITSTPCMatchingQCParams : public o2::conf::ConfigurableParamHelper<ITSTPCM
   float etaCut = 1.e10f;
   float cutK0Mass = 0.05f;
   float maxEtaK0 = 0.8f;
+  int nThreads = 1; // number of threads used to evaluate the track selection
 
   O2ParamDef(ITSTPCMatchingQCParams, "ITSTPCMatchingQC");
 };
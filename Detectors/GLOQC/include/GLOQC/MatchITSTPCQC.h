@@ -240,6 +240,7 @@ class MatchITSTPCQC
   void deleteHistograms();
   void setBz(float bz) { mBz = bz; }
   void setDoK0QC(bool v) { mDoK0QC = v; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
   bool getDoK0QC() const { return mDoK0QC; }
 
   // ITS track
@@ -303,6 +304,7 @@ class MatchITSTPCQC
   bool mUseMC = false;                                                                     // Usage of the MC information
   bool mUseTrkPID = false;                                                                 // Usage of the PID hypothesis in tracking
   float mBz = 0;                                                                           ///< nominal Bz
+  int mNThreads = 1;                                                                       ///< number of threads used for the track selection
   std::array<std::unordered_map<o2::MCCompLabel, LblInfo>, matchType::SIZE> mMapLabels;    // map with labels that have been found for the matched ITSTPC tracks; key is the label,
                                                                                            // value is the LbLinfo with the id of the track with the highest pT found with that label so far,
                                                                                            // and the flag to say if it is a physical primary or not
@@ -415,7 +417,7 @@ class MatchITSTPCQC
   float mMaxEtaK0 = 0.8;    // cut on the K0 eta
   long int mTimestamp = -1; // timestamp used to load the SVertexParam object: if differnt from -1, we don't load (it means we already did it)
 
-  ClassDefNV(MatchITSTPCQC, 3);
+  ClassDefNV(MatchITSTPCQC, 4);
 };
 } // namespace gloqc
 } // namespace o2
@@ -432,9 +432,11 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
   LOG(debug) << "****** Number of found TPC    tracks = " << mTPCTracks.size();
   LOG(debug) << "****** Number of found ITS    tracks = " << mITSTracks.size();
 
-  // cache selection for TPC and ITS tracks
-  std::vector<bool> isTPCTrackSelectedEntry(mTPCTracks.size(), false);
-  std::vector<bool> isITSTrackSelectedEntry(mITSTracks.size(), false);
+  // cache selection for TPC and ITS tracks; the selection can be evaluated in parallel, hence we do not use std::vector<bool>
+  std::vector<uint8_t> isTPCTrackSelectedEntry(mTPCTracks.size(), false);
+  std::vector<uint8_t> isITSTrackSelectedEntry(mITSTracks.size(), false);
+  // DCA (r-phi) to the beam pipe of the selected TPC tracks, as computed by the track selection, reused for the DCA histograms
+  std::vector<float> dcaTPCSelected(mTPCTracks.size(), 0.f);
   TrackCuts cuts;
   // ITS track
   cuts.setMinPtITSCut(mPtITSCut);
@@ -455,18 +457,24 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
   cuts.setMaxPtCut(mPtMaxCut);
   cuts.setEtaCut(-mEtaCut, mEtaCut);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads)
+#endif
   for (size_t itrk = 0; itrk < mTPCTracks.size(); ++itrk) {
-    auto const& trkTpc = mTPCTracks[itrk];
     o2::dataformats::GlobalTrackID id(itrk, GID::TPC);
-    if (cuts.isSelected(id, mRecoCont)) {
+    std::array<float, 2> dca{};
+    if (cuts.isSelected(id, mRecoCont, &dca)) {
       // NB: same cuts for numerator and denominator tracks of ITS-TPC matching
       // To change cuts only for numerator, something like o2::dataformats::GlobalTrackID id(itrk, GID::ITSTPC) is necessary
       isTPCTrackSelectedEntry[itrk] = true;
+      dcaTPCSelected[itrk] = dca[0];
     }
   }
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 256) num_threads(mNThreads)
+#endif
   for (size_t itrk = 0; itrk < mITSTracks.size(); ++itrk) {
-    auto const& trkIts = mITSTracks[itrk];
     o2::dataformats::GlobalTrackID id(itrk, GID::ITS);
     if (cuts.isSelected(id, mRecoCont)) {
       // NB: same cuts for numerator and denominator tracks of ITS-TPC matching
@@ -584,12 +592,10 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           mChi2VsPtNum[i]->Fill(tpcTrk.getPt(), tpcTrk.getChi2());
           mClsVsPtDen[i]->Fill(tpcTrk.getPt(), tpcTrk.getNClusters());
           mChi2VsPtDen[i]->Fill(tpcTrk.getPt(), tpcTrk.getChi2());
-          math_utils::Point3D<float> v{};
-          std::array<float, 2> dca{};
-          if (tpcTrk.propagateParamToDCA(v, mBz, &dca)) {
-            mDCArVsPtNum->Fill(tpcTrk.getPt(), dca[0]);
-            mDCArVsPtDen->Fill(tpcTrk.getPt(), dca[0]);
-          }
+          // the track passed the selection, hence its DCA was already computed there
+          auto dcaR = dcaTPCSelected[trk.getRefTPC().getIndex()];
+          mDCArVsPtNum->Fill(tpcTrk.getPt(), dcaR);
+          mDCArVsPtDen->Fill(tpcTrk.getPt(), dcaR);
         } else {
           const auto& itsTrk = mITSTracks[trk.getRefITS()];
           mClsVsPtNum[i]->Fill(itsTrk.getPt(), itsTrk.getNClusters());
@@ -701,13 +707,10 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
           mChi2Matching->Fill(trk.getChi2Match());
           mChi2Refit->Fill(trk.getChi2Refit());
           mTimeResVsPt->Fill(trkRef.getPt(), trk.getTimeMUS().getTimeStampError());
-          math_utils::Point3D<float> v{};
-          std::array<float, 2> dca;
-          if (trkRef.propagateParamToDCA(v, mBz, &dca)) {
-            mDCAr->Fill(dca[0]);
-            if (!mUseMC) {
-              mDCArVsPtNum->Fill(trkRef.getPt(), dca[0]);
-            }
+          auto dcaR = dcaTPCSelected[idxTrkRef];
+          mDCAr->Fill(dcaR);
+          if (!mUseMC) {
+            mDCArVsPtNum->Fill(trkRef.getPt(), dcaR);
           }
           LOG(debug) << "*** chi2Matching = " << trk.getChi2Match() << ", chi2refit = " << trk.getChi2Refit() << ", timeResolution = " << trk.getTimeMUS().getTimeStampError();
         }
@@ -803,11 +806,7 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
       m1OverPtDen[matchType::TPC]->Fill(trk.getSign() * trk.getPtInv());
       mClsVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getNClusters());
       mChi2VsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getChi2());
-      math_utils::Point3D<float> v{};
-      std::array<float, 2> dca{};
-      if (auto trc = trk; trc.propagateParamToDCA(v, mBz, &dca)) {
-        mDCArVsPtDen->Fill(trc.getPt(), dca[0]);
-      }
+      mDCArVsPtDen->Fill(trk.getPt(), dcaTPCSelected[el.second.mIdx]);
       if (el.second.mIsPhysicalPrimary) {
         mPtPhysPrimDen[matchType::TPC]->Fill(trk.getPt());
         mPhiPhysPrimDen[matchType::TPC]->Fill(trk.getPhi());
@@ -860,11 +859,7 @@ void MatchITSTPCQC::run(o2::framework::ProcessingContext& ctx)
         m1OverPtDen[matchType::TPC]->Fill(trk.getSign() * trk.getPtInv());
         mClsVsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getNClusters());
         mChi2VsPtDen[matchType::TPC]->Fill(trk.getPt(), trk.getChi2());
-        math_utils::Point3D<float> v{};
-        std::array<float, 2> dca{};
-        if (auto trc = trk; trc.propagateParamToDCA(v, mBz, &dca)) {
-          mDCArVsPtDen->Fill(trc.getPt(), dca[0]);
-        }
+        mDCArVsPtDen->Fill(trk.getPt(), dcaTPCSelected[itrk]);
         ++mNTPCSelectedTracks;
       }
     }
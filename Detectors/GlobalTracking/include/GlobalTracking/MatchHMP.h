@@ -96,6 +96,11 @@ class MatchHMP
   ///< get extra tolerance
   float getExtraTimeToleranceTOF() const { return mExtraTimeToleranceTOF; }
 
+  ///< set number of threads for the ring reconstruction
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  ///< get number of threads for the ring reconstruction
+  int getNThreads() const { return mNThreads; }
+
   /*  enum DebugFlagTypes : UInt_t {
       MatchTreeAll = 0x1 << 1, //  ///< produce matching candidates tree for all candidates
     };
@@ -127,6 +132,21 @@ class MatchHMP
   void doFastMatching();
   void doMatching();
 
+  ///< input of the ring reconstruction of a matched track
+  struct RingRecoInput {
+    int matchIndex;   ///< index of the match info in mMatchedTracks
+    int firstCluster; ///< first cluster of the HMP trigger
+    int lastCluster;  ///< last cluster of the HMP trigger
+    int chamber;      ///< intersected chamber
+    int mipIndex;     ///< index of the MIP among the clusters of the chamber
+    double nmean;     ///< mean refractive index of the radiator
+    double xRa;       ///< x of the track position on the radiator
+    double yRa;       ///< y of the track position on the radiator
+    double xPc;       ///< x of the track impact on the PC
+    double yPc;       ///< y of the track impact on the PC
+  };
+  void reconstructRings(const std::vector<RingRecoInput>& inputs, trackType type);
+
   static int intTrkCha(o2::track::TrackParCov* pTrk, double& xPc, double& yPc, double& xRa, double& yRa, double& theta, double& phi, double bz);               // find track-PC intersection, retuns chamber ID
   static int intTrkCha(int ch, o2::dataformats::TrackHMP* pHmpTrk, double& xPc, double& yPc, double& xRa, double& yRa, double& theta, double& phi, double bz); // find track-PC intersection, retuns chamber ID
 
@@ -205,6 +225,8 @@ class MatchHMP
 
   int mNumOfTriggers; // number of HMP triggers
 
+  int mNThreads = 1; ///< number of threads used for the ring reconstruction
+
   ///----------- aux stuff --------------///
   static constexpr float MAXSNP = 0.85; // max snp of ITS or TPC track at xRef to be matched
 
@@ -215,6 +215,7 @@ class MatchTOF
 
   void doMatching(int sec);
   void doMatchingForTPC(int sec);
+  void selectStripClusters(int sec, const std::array<int, 2>& strips, int nStrips, int itofMin, int itofMax, double maxTime, std::vector<int>& selected) const;
   void selectBestMatches(int sec);
   void BestMatches(std::vector<o2::dataformats::MatchInfoTOFReco>& matchedTracksPairs, std::vector<o2::dataformats::MatchInfoTOF>* matchedTracks, std::vector<int>* matchedTracksIndex, int* matchedClustersIndex, const gsl::span<const o2::ft0::RecPoints>& FITRecPoints, const std::vector<Cluster>& TOFClusWork, const std::vector<matchTrack>* TracksWork, std::vector<o2::dataformats::CalibInfoTOF>& CalibInfoTOF, unsigned long Timestamp, bool MCTruthON, const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* TOFClusLabels, const std::vector<o2::MCCompLabel>* TracksLblWork, std::vector<o2::MCCompLabel>* OutTOFLabels, float calibMaxChi2);
   void BestMatchesHP(std::vector<o2::dataformats::MatchInfoTOFReco>& matchedTracksPairs, std::vector<o2::dataformats::MatchInfoTOF>* matchedTracks, std::vector<int>* matchedTracksIndex, int* matchedClustersIndex, const gsl::span<const o2::ft0::RecPoints>& FITRecPoints, const std::vector<Cluster>& TOFClusWork, std::vector<o2::dataformats::CalibInfoTOF>& CalibInfoTOF, unsigned long Timestamp, bool MCTruthON, const o2::dataformats::MCTruthContainer<o2::MCCompLabel>* TOFClusLabels, const std::vector<o2::MCCompLabel>* TracksLblWork, std::vector<o2::MCCompLabel>* OutTOFLabels);
@@ -318,6 +319,11 @@ class MatchTOF
   ///< per sector indices of TOF cluster entry in mTOFClusWork
   std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusSectIndexCache;
 
+  ///< per sector strip index of TOF clusters: positions in mTOFClusSectIndexCache (hence time ordered) of the clusters of the strip
+  ///< istr (0:90 in the sector) are mTOFClusStripIndex[sec][mTOFClusStripFirst[sec][istr] : mTOFClusStripFirst[sec][istr + 1]]
+  std::array<std::vector<int>, o2::constants::math::NSectors> mTOFClusStripIndex;
+  std::array<std::array<int, Geo::NSTRIPXSECTOR + 1>, o2::constants::math::NSectors> mTOFClusStripFirst{};
+
   ///< array of track-TOFCluster pairs from the matching
   std::vector<o2::dataformats::MatchInfoTOFReco> mMatchedTracksPairsSec[o2::constants::math::NSectors];
 
@@ -51,6 +51,7 @@
 #include "TPCFastTransform.h"
 #include "GPUO2InterfaceRefit.h"
 #include "GlobalTracking/MatchTPCITSParams.h"
+#include "GlobalTracking/MatchTPCITSKernels.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "DataFormatsITSMFT/TrkClusRef.h"
 #include "ITSMFTReconstruction/ChipMappingITS.h"
@@ -107,19 +108,6 @@ constexpr int MinusOne = -1;
 constexpr int MinusTen = -10;
 constexpr int Validated = -2;
 
-///< flags to tell the status of TPC-ITS tracks comparison
-enum TrackRejFlag : int {
-  Accept = 0,
-  RejectOnY, // rejected comparing DY difference of tracks
-  RejectOnZ,
-  RejectOnSnp,
-  RejectOnTgl,
-  RejectOnQ2Pt,
-  RejectOnChi2,
-  NSigmaShift = 10,
-  RejectoOnPIDCorr = 20
-};
-
 ///< TPC track parameters propagated to reference X, with time bracket and index of
 ///< original track in the currently loaded TPC reco output
 struct TrackLocTPC : public o2::track::TrackParCov {
@@ -567,12 +555,6 @@ class MatchTPCITS
   ///< convert TPC time-bins to Z interval
   float tpcBin2Z(float t) const { return t * mTPCBin2Z; }
 
-  ///< rought check of 2 track params difference, return -1,0,1 if it is <,within or > than tolerance
-  int roughCheckDif(float delta, float toler, int rejFlag) const
-  {
-    return delta > toler ? rejFlag : (delta < -toler ? -rejFlag : Accept);
-  }
-
   // ========================= AFTERBURNER =========================
   int prepareABSeeds();
   void processABSeed(int sid, const ITSChipClustersRefs& itsChipClRefs, uint8_t tID);
@@ -637,6 +619,7 @@ class MatchTPCITS
   float mMinTPCTrackPtInv = 999.; ///< cutoff on TPC track inverse pT
   float mMinITSTrackPtInv = 999.; ///< cutoff on ITS track inverse pT
   bool mVDriftCalibOn = false;    ///< flag to produce VDrift calibration data
+  MatchTPCITSCuts mMatchCuts{};   ///< cuts of the TPC-ITS tracks comparison, refreshed once per TF
   o2::tpc::VDriftCorrFact mTPCDrift{};
   o2::gpu::CorrectionMapsHelper* mTPCCorrMapsHelper = nullptr;
 
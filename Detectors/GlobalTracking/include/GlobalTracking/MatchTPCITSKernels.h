@@ -0,0 +1,162 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file MatchTPCITSKernels.h
+/// \brief Comparison of TPC and ITS track pairs at the matching reference X, usable on the host and on the device
+
+#ifndef ALICEO2_GLOBTRACKING_MATCHTPCITSKERNELS_H
+#define ALICEO2_GLOBTRACKING_MATCHTPCITSKERNELS_H
+
+#include "GPUCommonDef.h"
+#include "ReconstructionDataFormats/Track.h"
+
+namespace o2
+{
+namespace globaltracking
+{
+
+///< flags to tell the status of TPC-ITS tracks comparison
+enum TrackRejFlag : int {
+  Accept = 0,
+  RejectOnY, // rejected comparing DY difference of tracks
+  RejectOnZ,
+  RejectOnSnp,
+  RejectOnTgl,
+  RejectOnQ2Pt,
+  RejectOnChi2,
+  NSigmaShift = 10,
+  RejectoOnPIDCorr = 20
+};
+
+///< cuts of the TPC-ITS tracks comparison, flat copy of the MatchTPCITSParams settings which can be shipped to the device
+struct MatchTPCITSCuts {
+  float crudeAbsDiffCut[o2::track::kNParams] = {};
+  float crudeNSigma2Cut[o2::track::kNParams] = {};
+  float cutMatchingChi2 = 0.f;
+  float addErrTglRel = 0.f; ///< Tgl error added relative to the ITS track Tgl (VDrift uncertainty in VDrift calibration mode), 0 otherwise
+};
+
+///< rought check of 2 track params difference, return -1,0,1 if it is <,within or > than tolerance
+GPUdi() int roughCheckDif(float delta, float toler, int rejFlag)
+{
+  return delta > toler ? rejFlag : (delta < -toler ? -rejFlag : Accept);
+}
+
+///< check of the Tgl difference of the ITS and TPC tracks, done before the other checks since the rejection on it allows to profit from sorting
+GPUdi() int checkTPCITSTgl(const o2::track::TrackParCov& tITS, const o2::track::TrackParCov& tTPC, const MatchTPCITSCuts& cuts)
+{
+  float diff = tITS.getParam(o2::track::kTgl) - tTPC.getParam(o2::track::kTgl);
+  int rejFlag = roughCheckDif(diff, cuts.crudeAbsDiffCut[o2::track::kTgl], RejectOnTgl);
+  if (rejFlag) {
+    return rejFlag;
+  }
+  auto err2Tgl = tITS.getDiagError2(o2::track::kTgl) + tTPC.getDiagError2(o2::track::kTgl);
+  auto addErr = tITS.getParam(o2::track::kTgl) * cuts.addErrTglRel;
+  err2Tgl += addErr * addErr; // account for VDrift uncertainty
+  diff *= diff / err2Tgl;
+  return roughCheckDif(diff, cuts.crudeNSigma2Cut[o2::track::kTgl], RejectOnTgl + NSigmaShift);
+}
+
+///< chi2 between 2 tracks defined at the same X and alpha, neglecting the Z parameter.
+///< The 4x4 covariance of the Y, Snp, Tgl, Q2Pt differences is LDL^T decomposed, chi2 = sum_i y_i^2/D_i with L*y = diff,
+///< a covariance which is not positive definite gives 2*HugeF.
+GPUdi() float getPredictedChi2NoZ(const o2::track::TrackParCov& trITS, const o2::track::TrackParCov& trTPC, float addErrTglRel)
+{
+  constexpr int NPar = o2::track::kNParams - 1;
+  constexpr int Par[NPar] = {o2::track::kY, o2::track::kSnp, o2::track::kTgl, o2::track::kQ2Pt};
+  double cov[NPar][NPar], diff[NPar];
+  for (int i = 0; i < NPar; i++) {
+    diff[i] = trITS.getParam(Par[i]) - trTPC.getParam(Par[i]);
+    for (int j = 0; j <= i; j++) {
+      cov[i][j] = static_cast<double>(trITS.getCovarElem(Par[i], Par[j])) + static_cast<double>(trTPC.getCovarElem(Par[i], Par[j]));
+    }
+  }
+  auto addErr = trITS.getParam(o2::track::kTgl) * addErrTglRel;
+  cov[2][2] += addErr * addErr;
+
+  // the strict lower triangle of cov is overwritten by L, its diagonal by D
+  double chi2 = 0.;
+  for (int i = 0; i < NPar; i++) {
+    for (int j = 0; j < i; j++) {
+      for (int k = 0; k < j; k++) {
+        cov[i][j] -= cov[i][k] * cov[j][k] * cov[k][k];
+      }
+      cov[i][j] /= cov[j][j];
+    }
+    for (int k = 0; k < i; k++) {
+      cov[i][i] -= cov[i][k] * cov[i][k] * cov[k][k];
+      diff[i] -= cov[i][k] * diff[k];
+    }
+    if (!(cov[i][i] > 0.)) {
+      return 2. * o2::track::HugeF;
+    }
+    chi2 += diff[i] * diff[i] / cov[i][i];
+  }
+  return chi2;
+}
+
+///< checks of the Y, Z (if requested), Snp and Q2Pt differences of the ITS and TPC tracks and their chi2 neglecting Z,
+///< the Tgl should be checked beforehand by checkTPCITSTgl
+GPUdi() int compareTPCITSParams(const o2::track::TrackParCov& tITS, const o2::track::TrackParCov& tTPC, bool compareZ, const MatchTPCITSCuts& cuts, float& chi2)
+{
+  chi2 = -1.f;
+  int rejFlag = Accept;
+  float diff; // make rough check differences and their nsigmas
+
+  diff = tITS.getParam(o2::track::kY) - tTPC.getParam(o2::track::kY);
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeAbsDiffCut[o2::track::kY], RejectOnY))) {
+    return rejFlag;
+  }
+  diff *= diff / (tITS.getDiagError2(o2::track::kY) + tTPC.getDiagError2(o2::track::kY));
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeNSigma2Cut[o2::track::kY], RejectOnY + NSigmaShift))) {
+    return rejFlag;
+  }
+
+  if (compareZ) {
+    diff = tITS.getParam(o2::track::kZ) - tTPC.getParam(o2::track::kZ);
+    if ((rejFlag = roughCheckDif(diff, cuts.crudeAbsDiffCut[o2::track::kZ], RejectOnZ))) {
+      return rejFlag;
+    }
+    diff *= diff / (tITS.getDiagError2(o2::track::kZ) + tTPC.getDiagError2(o2::track::kZ));
+    if ((rejFlag = roughCheckDif(diff, cuts.crudeNSigma2Cut[o2::track::kZ], RejectOnZ + NSigmaShift))) {
+      return rejFlag;
+    }
+  }
+
+  diff = tITS.getParam(o2::track::kSnp) - tTPC.getParam(o2::track::kSnp);
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeAbsDiffCut[o2::track::kSnp], RejectOnSnp))) {
+    return rejFlag;
+  }
+  diff *= diff / (tITS.getDiagError2(o2::track::kSnp) + tTPC.getDiagError2(o2::track::kSnp));
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeNSigma2Cut[o2::track::kSnp], RejectOnSnp + NSigmaShift))) {
+    return rejFlag;
+  }
+
+  diff = tITS.getParam(o2::track::kQ2Pt) - tTPC.getParam(o2::track::kQ2Pt);
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeAbsDiffCut[o2::track::kQ2Pt], RejectOnQ2Pt))) {
+    return rejFlag;
+  }
+  diff *= diff / (tITS.getDiagError2(o2::track::kQ2Pt) + tTPC.getDiagError2(o2::track::kQ2Pt));
+  if ((rejFlag = roughCheckDif(diff, cuts.crudeNSigma2Cut[o2::track::kQ2Pt], RejectOnQ2Pt + NSigmaShift))) {
+    return rejFlag;
+  }
+
+  chi2 = getPredictedChi2NoZ(tITS, tTPC, cuts.addErrTglRel);
+  if (chi2 > cuts.cutMatchingChi2 || chi2 < 0.) { // sometimes due to the numerical stability the chi2 is negative, reject it.
+    return RejectOnChi2;
+  }
+  return Accept;
+}
+
+} // namespace globaltracking
+} // namespace o2
+
+#endif
@@ -79,7 +79,8 @@ class TrackCuts
   }
 
   //////////////////////////////// O2 ////////////////////////////////
-  bool isSelected(GID trackIndex, o2::globaltracking::RecoContainer& data)
+  // if dcaTPC is provided, it is filled with the DCA of the TPC track to the beam pipe for the selected tracks with a TPC contribution
+  bool isSelected(GID trackIndex, o2::globaltracking::RecoContainer& data, std::array<float, 2>* dcaTPC = nullptr)
   {
     o2::track::TrackParCov trk;
     auto contributorsGID = data.getSingleDetectorRefs(trackIndex);
@@ -111,6 +112,9 @@ class TrackCuts
       if (!trTmp.propagateParamToDCA(v, mBz, &dca, mDCATPCCut) || std::abs(dca[0]) > mDCATPCCutY || std::hypot(dca[0], dca[1]) > mDCATPCCut) {
         return false;
       }
+      if (dcaTPC) {
+        *dcaTPC = dca;
+      }
     }
     // ITS-TPC matched cuts
     // --> currently inactive in MatchITSTPCQC, since either GID::TPC or GID::ITS
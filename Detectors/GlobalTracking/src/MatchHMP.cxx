@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include <TTree.h>
+#include <algorithm>
 #include <cassert>
 
 #include "FairLogger.h"
@@ -49,6 +50,10 @@
 
 #include "CommonDataFormat/InteractionRecord.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::globaltracking;
 using evGIdx = o2::dataformats::EvIndex<int, o2::dataformats::GlobalTrackID>;
 using Cluster = o2::hmpid::Cluster;
@@ -356,7 +361,6 @@ void MatchHMP::doMatching()
 {
   o2::globaltracking::MatchHMP::trackType type = o2::globaltracking::MatchHMP::trackType::CONSTR;
   o2::base::Propagator::MatCorrType matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT; // material correction method
-  Recon* recon = new o2::hmpid::Recon();
   o2::hmpid::Param* pParam = o2::hmpid::Param::instance();
 
   const float kdRadiator = 10.; // distance between radiator and the plane
@@ -381,6 +385,8 @@ void MatchHMP::doMatching()
 
   float timeFromTF = o2::InteractionRecord::bc2ns(mStartIR.bc, mStartIR.orbit);
 
+  std::vector<RingRecoInput> ringRecoInputs; // matched tracks for which the Cherenkov angle has to be reconstructed
+
   for (int ievt = 0; ievt < cacheTriggerHMP.size(); ievt++) { // events loop
 
     auto& event = mHMPTriggersWork[cacheTriggerHMP[ievt]];
@@ -558,10 +564,9 @@ void MatchHMP::doMatching()
 
         double nmean = pParam->meanIdxRad();
 
-        // 7. Calculate the Cherenkov angle
+        // 7. Store what is needed to calculate the Cherenkov angle, done for all matched tracks at once
 
-        recon->setImpPC(xPc, yPc);                                             // store track impact to PC
-        recon->ckovAngle(&matching, oneEventClusters, index, nmean, xRa, yRa); // search for Cerenkov angle of this track
+        ringRecoInputs.push_back({static_cast<int>(mMatchedTracks[type].size()), event.getFirstEntry(), event.getLastEntry(), iCh, index, nmean, xRa, yRa, xPc, yPc});
 
         mMatchedTracks[type].push_back(matching);
 
@@ -571,8 +576,43 @@ void MatchHMP::doMatching()
     }   // tracks loop
   }     // events loop
 
-  delete recon;
-  recon = nullptr;
+  reconstructRings(ringRecoInputs, type);
+}
+//==================================================================================================================================================
+void MatchHMP::reconstructRings(const std::vector<RingRecoInput>& inputs, trackType type)
+{
+  // Search for the Cherenkov angle of the matched tracks, in parallel if several threads are requested.
+  // Each track updates its own match info such that the output does not depend on the number of threads.
+
+  if (inputs.empty()) {
+    return;
+  }
+
+  int nThreads = std::max(1, std::min(mNThreads, static_cast<int>(inputs.size())));
+  std::vector<Recon> recons(nThreads);
+
+  // the refractive index of the radiator is set once in the shared parameters before the parallel section
+  o2::hmpid::Param::instance()->setRefIdx(inputs.front().nmean);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (size_t i = 0; i < inputs.size(); ++i) {
+#ifdef WITH_OPENMP
+    auto& recon = recons[omp_get_thread_num()];
+#else
+    auto& recon = recons[0];
+#endif
+    const auto& input = inputs[i];
+    std::vector<Cluster> oneEventClusters;
+    for (int j = input.firstCluster; j <= input.lastCluster; j++) { // clusters of the chamber in this event, as used for the matching
+      if (mHMPClustersArray[j].ch() == input.chamber) {
+        oneEventClusters.push_back(mHMPClustersArray[j]);
+      }
+    }
+    recon.setImpPC(input.xPc, input.yPc);                                                                                          // store track impact to PC
+    recon.ckovAngle(&mMatchedTracks[type][input.matchIndex], oneEventClusters, input.mipIndex, input.nmean, input.xRa, input.yRa); // search for Cerenkov angle of this track
+  }
 }
 //==================================================================================================================================================
 int MatchHMP::intTrkCha(o2::track::TrackParCov* pTrk, double& xPc, double& yPc, double& xRa, double& yRa, double& theta, double& phi, double bz)
@@ -799,6 +799,26 @@ bool MatchTOF::prepareTOFClusters()
     });
   } // loop over TOF clusters of single sector
 
+  // build the strip index of each sector: the time ordered positions of the clusters are grouped per strip (counting sort, keeps the time order)
+  for (int sec = o2::constants::math::NSectors - 1; sec > -1; sec--) {
+    const auto& indexCache = mTOFClusSectIndexCache[sec];
+    auto& stripFirst = mTOFClusStripFirst[sec];
+    auto& stripIndex = mTOFClusStripIndex[sec];
+    stripFirst.fill(0);
+    stripIndex.resize(indexCache.size());
+    for (auto icl : indexCache) {
+      stripFirst[mTOFClusWork[icl].getPadInSector() / Geo::NPADS + 1]++;
+    }
+    for (int istr = 0; istr < Geo::NSTRIPXSECTOR; istr++) {
+      stripFirst[istr + 1] += stripFirst[istr];
+    }
+    std::array<int, Geo::NSTRIPXSECTOR> fill;
+    std::copy(stripFirst.begin(), stripFirst.end() - 1, fill.begin());
+    for (int itof = 0; itof < (int)indexCache.size(); itof++) {
+      stripIndex[fill[mTOFClusWork[indexCache[itof]].getPadInSector() / Geo::NPADS]++] = itof;
+    }
+  }
+
   if (mMatchedClustersIndex) {
     delete[] mMatchedClustersIndex;
   }
@@ -808,6 +828,32 @@ bool MatchTOF::prepareTOFClusters()
   return true;
 }
 //______________________________________________
+void MatchTOF::selectStripClusters(int sec, const std::array<int, 2>& strips, int nStrips, int itofMin, int itofMax, double maxTime, std::vector<int>& selected) const
+{
+  ///< fill the time ordered positions in mTOFClusSectIndexCache[sec] of the clusters of the given strips, in the [itofMin, itofMax) range and not later than maxTime
+  selected.clear();
+  const auto& cacheTOF = mTOFClusSectIndexCache[sec];
+  const auto& stripIndex = mTOFClusStripIndex[sec];
+  const auto& stripFirst = mTOFClusStripFirst[sec];
+  for (int is = 0; is < nStrips; is++) {
+    int istr = strips[is];
+    if (istr < 0 || (is && istr == strips[0])) { // same strip number crossed in the neighbouring sector, already selected
+      continue;
+    }
+    size_t nPrev = selected.size();
+    auto itEnd = stripIndex.begin() + stripFirst[istr + 1];
+    for (auto it = std::lower_bound(stripIndex.begin() + stripFirst[istr], itEnd, itofMin); it != itEnd && *it < itofMax; ++it) {
+      if (mTOFClusWork[cacheTOF[*it]].getTime() > maxTime) {
+        break;
+      }
+      selected.push_back(*it);
+    }
+    if (nPrev) {
+      std::inplace_merge(selected.begin(), selected.begin() + nPrev, selected.end());
+    }
+  }
+}
+//______________________________________________
 void MatchTOF::doMatching(int sec)
 {
   trkType type = trkType::CONSTR;
@@ -821,6 +867,8 @@ void MatchTOF::doMatching(int sec)
     return;
   }
   int itof0 = 0;                          // starting index in TOF clusters for matching of the track
+  std::array<int, 2> strips;              // strips (numbering in the sector) crossed by the track
+  std::vector<int> stripClusters;         // positions in cacheTOF of the TOF clusters to check for the track
   int detId[2][5];                        // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the TOF det index
   float deltaPos[2][3];                   // at maximum one track can fall in 2 strips during the propagation; the second dimention of the array is the residuals
   o2::track::TrackLTIntegral trkLTInt[2]; // Here we store the integrated track length and time for the (max 2) matched strips
@@ -962,20 +1010,17 @@ void MatchTOF::doMatching(int sec)
       continue; // the track never hit a TOF strip during the propagation
     }
     bool foundCluster = false;
-    for (auto itof = itof0; itof < nTOFCls; itof++) {
+    // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
+    // the clusters with a time too small for the current track are ignored also for the next tracks
+    itof0 = std::lower_bound(cacheTOF.begin() + itof0, cacheTOF.end(), minTrkTime, [this](int icl, float t) { return mTOFClusWork[icl].getTime() < t; }) - cacheTOF.begin();
+    // only the clusters of the crossed strips, within the track time window, are checked
+    for (int ip = 0; ip < nStripsCrossedInPropagation; ip++) {
+      strips[ip] = Geo::getStripNumberPerSM(detId[ip][1], detId[ip][2]);
+    }
+    selectStripClusters(sec, strips, nStripsCrossedInPropagation, itof0, nTOFCls, maxTrkTime, stripClusters);
+    for (auto itof : stripClusters) {
       //      printf("itof = %d\n", itof);
       auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
-      // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
-      //Printf("trefTOF.getTime() = %f, maxTrkTime = %f, minTrkTime = %f", trefTOF.getTime(), maxTrkTime, minTrkTime);
-
-      if (trefTOF.getTime() < minTrkTime) { // this cluster has a time that is too small for the current track, we will get to the next one
-        //Printf("In trefTOF.getTime() < minTrkTime");
-        itof0 = itof + 1; // but for the next track that we will check, we will ignore this cluster (the time is anyway too small)
-        continue;
-      }
-      if (trefTOF.getTime() > maxTrkTime) { // no more TOF clusters can be matched to this track
-        break;
-      }
 
       int mainChannel = trefTOF.getMainContributingChannel();
       int indices[5];
@@ -1115,7 +1160,9 @@ void MatchTOF::doMatchingForTPC(int sec)
   if (!nTracks || !nTOFCls) {
     return;
   }
-  int itof0 = 0; // starting index in TOF clusters for matching of the track
+  int itof0 = 0;                  // starting index in TOF clusters for matching of the track
+  std::array<int, 2> strips;      // strips (numbering in the sector) crossed by the track
+  std::vector<int> stripClusters; // positions in cacheTOF of the TOF clusters to check for the track
   float deltaPosTemp[3];
   std::array<float, 3> pos;
   std::array<float, 3> posBeforeProp;
@@ -1326,7 +1373,12 @@ void MatchTOF::doMatchingForTPC(int sec)
       }
 
       bool foundCluster = false;
-      for (auto itof = itof0; itof < itofMax; itof++) {
+      // only the clusters of the crossed strips are checked
+      for (int ip = 0; ip < nStripsCrossedInPropagation[ibc]; ip++) {
+        strips[ip] = Geo::getStripNumberPerSM(detId[ibc][ip][1], detId[ibc][ip][2]);
+      }
+      selectStripClusters(sec, strips, nStripsCrossedInPropagation[ibc], itof0, itofMax, maxTime, stripClusters);
+      for (auto itof : stripClusters) {
         //      printf("itof = %d\n", itof);
         auto& trefTOF = mTOFClusWork[cacheTOF[itof]];
         // compare the times of the track and the TOF clusters - remember that they both are ordered in time!
@@ -59,7 +59,6 @@
 
 using namespace o2::globaltracking;
 
-using MatrixDSym4 = ROOT::Math::SMatrix<double, 4, 4, ROOT::Math::MatRepSym<double, 4>>;
 using MatrixD4 = ROOT::Math::SMatrix<double, 4, 4, ROOT::Math::MatRepStd<double, 4>>;
 using NAMES = o2::base::NameConf;
 using GTrackID = o2::dataformats::GlobalTrackID;
@@ -290,6 +289,13 @@ void MatchTPCITS::updateTimeDependentParams()
   }
   mCovDiagInner = trackTune.getCovInnerTotal(scale);
   mCovDiagOuter = trackTune.getCovOuterTotal(scale);
+
+  for (int i = 0; i < o2::track::kNParams; i++) {
+    mMatchCuts.crudeAbsDiffCut[i] = mParams->crudeAbsDiffCut[i];
+    mMatchCuts.crudeNSigma2Cut[i] = mParams->crudeNSigma2Cut[i];
+  }
+  mMatchCuts.cutMatchingChi2 = mParams->cutMatchingChi2;
+  mMatchCuts.addErrTglRel = mVDriftCalibOn ? mParams->maxVDriftUncertainty : 0.f;
 }
 
 //______________________________________________
@@ -1121,95 +1127,32 @@ int MatchTPCITS::compareTPCITSTracks(const TrackLocITS& tITS, const TrackLocTPC&
 {
   ///< compare pair of ITS and TPC tracks
   chi2 = -1.f;
-  int rejFlag = Accept;
-  float diff; // make rough check differences and their nsigmas
-
   // start with check on Tgl, since rjection on it will allow to profit from sorting
-  diff = tITS.getParam(o2::track::kTgl) - tTPC.getParam(o2::track::kTgl);
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeAbsDiffCut[o2::track::kTgl], RejectOnTgl))) {
-    return rejFlag;
-  }
-  auto err2Tgl = tITS.getDiagError2(o2::track::kTgl) + tTPC.getDiagError2(o2::track::kTgl);
-  if (mVDriftCalibOn) {
-    auto addErr = tITS.getParam(o2::track::kTgl) * mParams->maxVDriftUncertainty;
-    err2Tgl += addErr * addErr; // account for VDrift uncertainty
-  }
-  diff *= diff / err2Tgl;
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeNSigma2Cut[o2::track::kTgl], RejectOnTgl + NSigmaShift))) {
+  int rejFlag = checkTPCITSTgl(tITS, tTPC, mMatchCuts);
+  if (rejFlag) {
     return rejFlag;
   }
+  const bool compareZ = tTPC.constraint == TrackLocTPC::Constrained; // in continuous only constrained tracks can be compared in Z
   // do we need to account for different PID hypotheses used for ITS and TPC tracks propagation to ref. X?
-  bool testOtherPID = false;
-  float itsParam[5] = {tITS.getY(), tITS.getZ(), tITS.getSnp(), tITS.getTgl(), tITS.getQ2Pt()};
   if (tTPC.getPID() > tITS.getPID() && tITS.dL > 0.f && tTPC.getP2() / tTPC.getPID().getMass2() < mParams->minBetaGammaForPIDDiff) {
     o2::track::TrackPar tPID(mITSTracksArray[tITS.sourceID].getParamOut()); // clone original ITS track at highest update point
     tPID.setPID(tTPC.getPID(), true);
     if (!tPID.correctForELoss(tITS.xrho)) {
       return RejectoOnPIDCorr;
     }
+    // compare with the ITS params substituted by the alternative ones
+    o2::track::TrackParCov tITSAlt(tITS);
     float dCurv = (tPID.getQ2Pt() - tITS.getQ2Pt()) * mBz * o2::constants::math::B2C, dLEff = tITS.dL * mParams->ITSStepEffFraction, dCurvL = dCurv * dLEff;
-    itsParam[o2::track::kQ2Pt] = tPID.getQ2Pt();
-    itsParam[o2::track::kSnp] += dCurvL;
-    if (std::abs(itsParam[o2::track::kSnp]) >= 1.) {
-      itsParam[o2::track::kSnp] = std::copysign(0.99, itsParam[o2::track::kSnp]);
-    }
-    itsParam[o2::track::kY] += dCurvL * dLEff * 0.5;
-    testOtherPID = true;
-  }
-
-  diff = itsParam[o2::track::kY] - tTPC.getParam(o2::track::kY);
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeAbsDiffCut[o2::track::kY], RejectOnY))) {
-    return rejFlag;
-  }
-  diff *= diff / (tITS.getDiagError2(o2::track::kY) + tTPC.getDiagError2(o2::track::kY));
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeNSigma2Cut[o2::track::kY], RejectOnY + NSigmaShift))) {
-    return rejFlag;
-  }
-
-  if (tTPC.constraint == TrackLocTPC::Constrained) { // in continuous only constrained tracks can be compared in Z
-    diff = itsParam[o2::track::kZ] - tTPC.getParam(o2::track::kZ);
-    if ((rejFlag = roughCheckDif(diff, mParams->crudeAbsDiffCut[o2::track::kZ], RejectOnZ))) {
-      return rejFlag;
+    float snp = tITS.getSnp() + dCurvL;
+    if (std::abs(snp) >= 1.) {
+      snp = std::copysign(0.99, snp);
     }
-    diff *= diff / (tITS.getDiagError2(o2::track::kZ) + tTPC.getDiagError2(o2::track::kZ));
-    if ((rejFlag = roughCheckDif(diff, mParams->crudeNSigma2Cut[o2::track::kZ], RejectOnZ + NSigmaShift))) {
-      return rejFlag;
-    }
-  }
-
-  diff = itsParam[o2::track::kSnp] - tTPC.getParam(o2::track::kSnp);
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeAbsDiffCut[o2::track::kSnp], RejectOnSnp))) {
-    return rejFlag;
-  }
-  diff *= diff / (tITS.getDiagError2(o2::track::kSnp) + tTPC.getDiagError2(o2::track::kSnp));
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeNSigma2Cut[o2::track::kSnp], RejectOnSnp + NSigmaShift))) {
-    return rejFlag;
-  }
-
-  diff = itsParam[o2::track::kQ2Pt] - tTPC.getParam(o2::track::kQ2Pt);
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeAbsDiffCut[o2::track::kQ2Pt], RejectOnQ2Pt))) {
-    return rejFlag;
-  }
-  diff *= diff / (tITS.getDiagError2(o2::track::kQ2Pt) + tTPC.getDiagError2(o2::track::kQ2Pt));
-  if ((rejFlag = roughCheckDif(diff, mParams->crudeNSigma2Cut[o2::track::kQ2Pt], RejectOnQ2Pt + NSigmaShift))) {
-    return rejFlag;
-  }
-  // calculate mutual chi2 excluding Z in continuous mode
-  if (testOtherPID) { // temporarily substitute pion params by alternative ones
-    auto tITSAlt = tITS;
-    tITSAlt.setPID(tTPC.getPID());
-    tITSAlt.setParam(itsParam[o2::track::kY], o2::track::kY);
-    tITSAlt.setParam(itsParam[o2::track::kSnp], o2::track::kSnp);
-    tITSAlt.setParam(itsParam[o2::track::kQ2Pt], o2::track::kQ2Pt);
-    chi2 = getPredictedChi2NoZ(tITSAlt, tTPC);
-  } else {
-    chi2 = getPredictedChi2NoZ(tITS, tTPC);
-  }
-  if (chi2 > mParams->cutMatchingChi2 || chi2 < 0.) { // sometimes due to the numerical stability the chi2 is negative, reject it.
-    return RejectOnChi2;
+    tITSAlt.setParam(tITS.getY() + dCurvL * dLEff * 0.5, o2::track::kY);
+    tITSAlt.setParam(snp, o2::track::kSnp);
+    tITSAlt.setParam(tPID.getQ2Pt(), o2::track::kQ2Pt);
+    return compareTPCITSParams(tITSAlt, tTPC, compareZ, mMatchCuts, chi2);
   }
-
-  return Accept;
+  return compareTPCITSParams(tITS, tTPC, compareZ, mMatchCuts, chi2);
 }
 
 //______________________________________________
@@ -1258,49 +1201,8 @@ void MatchTPCITS::printCandidatesITS() const
 float MatchTPCITS::getPredictedChi2NoZ(const o2::track::TrackParCov& trITS, const o2::track::TrackParCov& trTPC) const
 {
   /// get chi2 between 2 tracks, neglecting Z parameter.
-  /// 2 tracks must be defined at the same parameters X,alpha (check is currently commented)
-
-  //  if (std::abs(trITS.getAlpha() - trTPC.getAlpha()) > FLT_EPSILON) {
-  //    LOG(error) << "The reference Alpha of the tracks differ: "
-  //        << trITS.getAlpha() << " : " << trTPC.getAlpha();
-  //    return 2. * o2::track::HugeF;
-  //  }
-  //  if (std::abs(trITS.getX() - trTPC.getX()) > FLT_EPSILON) {
-  //    LOG(error) << "The reference X of the tracks differ: "
-  //        << trITS.getX() << " : " << trTPC.getX();
-  //    return 2. * o2::track::HugeF;
-  //  }
-  MatrixDSym4 covMat;
-  covMat(0, 0) = static_cast<double>(trITS.getSigmaY2()) + static_cast<double>(trTPC.getSigmaY2());
-  covMat(1, 0) = static_cast<double>(trITS.getSigmaSnpY()) + static_cast<double>(trTPC.getSigmaSnpY());
-  covMat(1, 1) = static_cast<double>(trITS.getSigmaSnp2()) + static_cast<double>(trTPC.getSigmaSnp2());
-  covMat(2, 0) = static_cast<double>(trITS.getSigmaTglY()) + static_cast<double>(trTPC.getSigmaTglY());
-  covMat(2, 1) = static_cast<double>(trITS.getSigmaTglSnp()) + static_cast<double>(trTPC.getSigmaTglSnp());
-  covMat(2, 2) = static_cast<double>(trITS.getSigmaTgl2()) + static_cast<double>(trTPC.getSigmaTgl2());
-  if (mVDriftCalibOn) {
-    auto addErr = trITS.getParam(o2::track::kTgl) * mParams->maxVDriftUncertainty;
-    covMat(2, 2) += addErr * addErr;
-  }
-  covMat(3, 0) = static_cast<double>(trITS.getSigma1PtY()) + static_cast<double>(trTPC.getSigma1PtY());
-  covMat(3, 1) = static_cast<double>(trITS.getSigma1PtSnp()) + static_cast<double>(trTPC.getSigma1PtSnp());
-  covMat(3, 2) = static_cast<double>(trITS.getSigma1PtTgl()) + static_cast<double>(trTPC.getSigma1PtTgl());
-  covMat(3, 3) = static_cast<double>(trITS.getSigma1Pt2()) + static_cast<double>(trTPC.getSigma1Pt2());
-  if (!covMat.Invert()) {
-    LOG(error) << "Cov.matrix inversion failed: " << covMat;
-    return 2. * o2::track::HugeF;
-  }
-  double chi2diag = 0., chi2ndiag = 0.,
-         diff[o2::track::kNParams - 1] = {trITS.getParam(o2::track::kY) - trTPC.getParam(o2::track::kY),
-                                          trITS.getParam(o2::track::kSnp) - trTPC.getParam(o2::track::kSnp),
-                                          trITS.getParam(o2::track::kTgl) - trTPC.getParam(o2::track::kTgl),
-                                          trITS.getParam(o2::track::kQ2Pt) - trTPC.getParam(o2::track::kQ2Pt)};
-  for (int i = o2::track::kNParams - 1; i--;) {
-    chi2diag += diff[i] * diff[i] * covMat(i, i);
-    for (int j = i; j--;) {
-      chi2ndiag += diff[i] * diff[j] * covMat(i, j);
-    }
-  }
-  return chi2diag + 2. * chi2ndiag;
+  /// 2 tracks must be defined at the same parameters X,alpha
+  return o2::globaltracking::getPredictedChi2NoZ(trITS, trTPC, mMatchCuts.addErrTglRel);
 }
 
 //______________________________________________
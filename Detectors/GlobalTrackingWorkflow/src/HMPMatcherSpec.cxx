@@ -81,6 +81,7 @@ void HMPMatcherSpec::init(InitContext& ic)
   mTimer.Reset();
   //-------- init geometry and field --------//
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
+  mMatcher.setNThreads(ic.options().get<int>("nthreads"));
 }
 
 void HMPMatcherSpec::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
@@ -174,7 +175,7 @@ DataProcessorSpec getHMPMatcherSpec(GID::mask_t src, bool useMC, float extratole
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<HMPMatcherSpec>(dataRequest, ggRequest, useMC)},
-    Options{}};
+    Options{{"nthreads", VariantType::Int, 1, {"Number of threads for the ring reconstruction"}}}};
 }
 
 } // namespace globaltracking
@@ -65,7 +65,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const Trigger>& t
     mTrgRecFilt.clear();
     mDigDataFilt.clear();
     for (const auto& trig : trigData) {
-      if (mIRFrameSelector.check(trig.getIr()) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.getIr())) {
         mTrgRecFilt.push_back(trig);
         auto digIt = digData.begin() + trig.getFirstEntry();
         auto& trigC = mTrgRecFilt.back();
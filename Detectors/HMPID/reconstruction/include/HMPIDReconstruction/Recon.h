@@ -85,7 +85,7 @@ class Recon : public TNamed
   // void deleteVars() const; // delete variables
 
   // void     CkovAngle    (AliESDtrack *pTrk,TClonesArray *pCluLst,int index,double nmean,float xRa,float yRa );
-  void ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster> clusters, int index, double nmean, float xRa, float yRa); // reconstructed Theta Cerenkov
+  void ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster>& clusters, int index, double nmean, float xRa, float yRa); // reconstructed Theta Cerenkov
 
   bool findPhotCkov(double cluX, double cluY, double& thetaCer, double& phiCer); // find ckov angle for single photon candidate
   bool findPhotCkov2(double cluX, double cluY, double& thetaCer, double& phiCer);
@@ -95,8 +95,8 @@ class Recon : public TNamed
   // template <typename T = double>
   const TVector2 intWithEdge(TVector2 p1, TVector2 p2); // find intercection between plane and lines of 2 thetaC
 
-  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters, float* photChargeVec); // is photon ckov near most probable track ckov
-                                                                                                   //  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters); // is photon ckov near most probable track ckov
+  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters, float* photChargeVec); // is photon ckov near most probable track ckov
+                                                                                                    //  int flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters); // is photon ckov near most probable track ckov
 
   double houghResponse(); // most probable track ckov angle
   // template <typename T = double>
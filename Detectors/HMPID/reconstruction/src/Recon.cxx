@@ -46,7 +46,7 @@ void Recon::initVars(int n)
   //
 }
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster> clusters, int index, double nmean, float xRa, float yRa)
+void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2::hmpid::Cluster>& clusters, int index, double nmean, float xRa, float yRa)
 {
   // Pattern recognition method based on Hough transform
   // Arguments:   pTrk     - track for which Ckov angle is to be found
@@ -65,7 +65,9 @@ void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2
 
   setTrack(xRa, yRa, th, ph);
 
-  fParam->setRefIdx(nmean);
+  if (fParam->getRefIdx() != nmean) { // the parameters are shared, do not write them when the index is already set
+    fParam->setRefIdx(nmean);
+  }
 
   float mipQ = -1, mipX = -1, mipY = -1;
   int chId = -1, sizeClu = -1;
@@ -76,7 +78,7 @@ void Recon::ckovAngle(o2::dataformats::MatchInfoHMP* match, const std::vector<o2
 
   for (int iClu = 0; iClu < clusters.size(); iClu++) { // clusters loop
 
-    o2::hmpid::Cluster cluster = clusters.at(iClu);
+    const auto& cluster = clusters[iClu];
     nPads += cluster.size();
     if (iClu == index) { // this is the MIP! not a photon candidate: just store mip info
       mipX = cluster.x();
@@ -439,8 +441,8 @@ double Recon::findRingCkov(int)
 
 } // FindCkovRing()
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters, float* photChargeVec)
-// int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters)
+int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters, float* photChargeVec)
+// int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster>& clusters)
 {
   // Flag photon candidates if their individual ckov angle is inside the window around ckov angle returned by  HoughResponse()
   // Arguments: ckov- value of most probable ckov angle for track as returned by HoughResponse()
@@ -464,7 +466,7 @@ int Recon::flagPhot(double ckov, const std::vector<o2::hmpid::Cluster> clusters,
     fPhotFlag[i] = 0;
     if (fPhotCkov[i] >= tmin && fPhotCkov[i] <= tmax) {
       fPhotFlag[i] = 2;
-      o2::hmpid::Cluster cluster = clusters.at(fPhotClusIndex[i]);
+      const auto& cluster = clusters[fPhotClusIndex[i]];
       float charge = cluster.q();
       if (iInsideCnt < 10) {
         photChargeVec[iInsideCnt] = charge;
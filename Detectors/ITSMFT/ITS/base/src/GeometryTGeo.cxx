@@ -533,7 +533,9 @@ void GeometryTGeo::fillMatrixCache(int mask)
   }
 
   // build matrices
+  bool updateTransforms = false;
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G)) && !getCacheL2G().isFilled()) {
+    updateTransforms = true;
     // Matrices for Local (Sensor!!! rather than the full chip) to Global frame transformation
     LOGP(info, "Loading {} L2G matrices from TGeo; there are {} matrices", getName(), mSize);
     auto& cacheL2G = getCacheL2G();
@@ -547,6 +549,7 @@ void GeometryTGeo::fillMatrixCache(int mask)
 
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L)) && !getCacheT2L().isFilled()) {
     // matrices for Tracking to Local (Sensor!!! rather than the full chip) frame transformation
+    updateTransforms = true;
     LOGP(info, "Loading {} T2L matrices from TGeo", getName());
     auto& cacheT2L = getCacheT2L();
     cacheT2L.setSize(mSize);
@@ -584,6 +587,15 @@ void GeometryTGeo::fillMatrixCache(int mask)
       cacheT2G.setMatrix(mat, i);
     }
   }
+
+  if (updateTransforms) {
+    updateChipTransforms();
+    if (mChipTransforms.isInitialised() && isTrackingFrameCached()) {
+      for (int i = 0; i < mSize; i++) {
+        mChipTransforms.setTrackingFrame(i, getSensorRefAlpha(i), getSensorRefX(i));
+      }
+    }
+  }
 }
 
 //__________________________________________________________________________
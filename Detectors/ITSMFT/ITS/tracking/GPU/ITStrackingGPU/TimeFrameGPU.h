@@ -191,14 +191,18 @@ class TimeFrameGPU : public TimeFrame
   void loadUnsortedClustersDevice();
   void loadClustersDevice();
   void loadTrackletsDevice();
-  void loadCellsDevice();
+  void loadCellsDevice(); // Cells and cells LUTs from the host, into buffers kept across the iterations
   void loadTrackSeedsDevice();
   void loadTrackSeedsChi2Device();
   void loadRoadsDevice();
   void loadTrackSeedsDevice(std::vector<CellSeed>&);
-  void createCellNeighboursDevice(const unsigned int& layer, std::vector<std::pair<int, int>>& neighbours);
-  void createTrackITSExtDevice(std::vector<CellSeed>&);
-  void downloadTrackITSExtDevice(std::vector<CellSeed>&);
+  void loadUsedClustersDevice();
+  void createNeighboursLUTDevice(const int layer, const unsigned int nCells);
+  void createNeighboursDevice(const int layer, const unsigned int nNeighbours);
+  void createRoadSeedsTableDevice(const unsigned int nCurrentSeeds);
+  void createRoadSeedsDevice(const int slot, const unsigned int nSeeds);
+  void createTrackITSExtDevice(const unsigned int nSeeds);
+  void downloadTrackITSExtDevice(const unsigned int nSeeds); // Appended to getTrackITSExt()
   void initDeviceChunks(const int, const int);
   template <Task task>
   size_t loadChunkData(const size_t, const size_t, const size_t);
@@ -225,13 +229,23 @@ class TimeFrameGPU : public TimeFrame
   // Hybrid
   Road<nLayers - 2>* getDeviceRoads() { return mRoadsDevice; }
   TrackITSExt* getDeviceTrackITSExt() { return mTrackITSExtDevice; }
-  gpuPair<int, int>* getDeviceNeighbours(const int layer) { return mNeighboursDevice[layer]; }
+  int* getDeviceNeighbours(const int layer) { return mNeighboursDevice[layer]; }
+  int* getDeviceNeighboursLUT(const int layer) { return mNeighboursLUTDevice[layer]; }
+  int* getDeviceNeighboursPositions(const int layer) { return mNeighboursPositionsDevice[layer]; }
+  int** getDeviceArrayNeighbours() const { return mNeighboursDeviceArray; }
+  int** getDeviceArrayNeighboursLUT() const { return mNeighboursLUTDeviceArray; }
+  int** getDeviceArrayCellsLUT() const { return mCellsLUTDeviceArray; }
+  unsigned char** getDeviceArrayUsedClusters() const { return mRoadsUsedClustersDeviceArray; }
+  CellSeed* getDeviceRoadSeeds(const int slot) { return mRoadSeedsDevice[slot]; }
+  int* getDeviceRoadSeedsIds(const int slot) { return mRoadSeedsIdsDevice[slot]; }
+  int* getDeviceRoadSeedsTable() { return mRoadSeedsTableDevice; }
   TrackingFrameInfo* getDeviceTrackingFrameInfo(const int);
   TrackingFrameInfo** getDeviceArrayTrackingFrameInfo() { return mTrackingFrameInfoDeviceArray; }
   Cluster** getDeviceArrayClusters() const { return mClustersDeviceArray; }
   Cluster** getDeviceArrayUnsortedClusters() const { return mUnsortedClustersDeviceArray; }
   Tracklet** getDeviceArrayTracklets() const { return mTrackletsDeviceArray; }
   CellSeed** getDeviceArrayCells() const { return mCellsDeviceArray; }
+  CellSeed* getDeviceCells(const int layer) { return mCellsDevice[layer]; }
   CellSeed* getDeviceTrackSeeds() { return mTrackSeedsDevice; }
   o2::track::TrackParCovF** getDeviceArrayTrackSeeds() { return mCellSeedsDeviceArray; }
   float** getDeviceArrayTrackSeedsChi2() { return mCellSeedsChi2DeviceArray; }
@@ -243,6 +257,9 @@ class TimeFrameGPU : public TimeFrame
 
  private:
   void allocMemAsync(void**, size_t, Stream*, bool); // Abstract owned and unowned memory allocations
+  template <typename T>
+  void reserveDeviceBuffer(T*& ptr, size_t& capacity, const size_t size); // Grows the buffer only if too small
+  void resetDeviceBuffers();                                               // Forget the buffers released by the external allocator
   bool mHostRegistered = false;
   std::vector<GpuTimeFrameChunk<nLayers>> mMemChunks;
   TimeFrameGPUParameters mGpuParams;
@@ -263,7 +280,7 @@ class TimeFrameGPU : public TimeFrame
   Cluster** mUnsortedClustersDeviceArray;
   std::array<Tracklet*, nLayers - 1> mTrackletsDevice;
   Tracklet** mTrackletsDeviceArray;
-  std::array<CellSeed*, nLayers - 2> mCellsDevice;
+  std::array<CellSeed*, nLayers - 2> mCellsDevice{};
   CellSeed* mTrackSeedsDevice;
   CellSeed** mCellsDeviceArray;
   std::array<o2::track::TrackParCovF*, nLayers - 2> mCellSeedsDevice;
@@ -272,8 +289,32 @@ class TimeFrameGPU : public TimeFrame
   float** mCellSeedsChi2DeviceArray;
 
   Road<nLayers - 2>* mRoadsDevice;
-  TrackITSExt* mTrackITSExtDevice;
-  std::array<gpuPair<int, int>*, nLayers - 2> mNeighboursDevice;
+  TrackITSExt* mTrackITSExtDevice = nullptr;
+
+  // Device-resident neighbour and road finding, buffers are kept across the iterations with their capacity
+  std::array<size_t, nLayers - 2> mCellsDeviceCapacity{};
+  std::array<int*, nLayers - 3> mCellsLUTDevice{};
+  std::array<size_t, nLayers - 3> mCellsLUTDeviceCapacity{};
+  int** mCellsLUTDeviceArray = nullptr;
+  std::array<int*, nLayers - 3> mNeighboursDevice{};
+  std::array<size_t, nLayers - 3> mNeighboursDeviceCapacity{};
+  int** mNeighboursDeviceArray = nullptr;
+  std::array<int*, nLayers - 3> mNeighboursLUTDevice{};
+  std::array<size_t, nLayers - 3> mNeighboursLUTDeviceCapacity{};
+  int** mNeighboursLUTDeviceArray = nullptr;
+  std::array<int*, nLayers - 3> mNeighboursPositionsDevice{};
+  std::array<size_t, nLayers - 3> mNeighboursPositionsDeviceCapacity{};
+  std::array<unsigned char*, nLayers> mRoadsUsedClustersDevice{};
+  std::array<size_t, nLayers> mRoadsUsedClustersDeviceCapacity{};
+  unsigned char** mRoadsUsedClustersDeviceArray = nullptr;
+  std::array<CellSeed*, 2> mRoadSeedsDevice{}; // Input and output of a road finding step, swapped at every step
+  std::array<int*, 2> mRoadSeedsIdsDevice{};
+  std::array<size_t, 2> mRoadSeedsDeviceCapacity{};
+  std::array<size_t, 2> mRoadSeedsIdsDeviceCapacity{};
+  int* mRoadSeedsTableDevice = nullptr;
+  size_t mRoadSeedsTableDeviceCapacity = 0;
+  size_t mTrackITSExtDeviceCapacity = 0;
+  bool mRoadsDeviceArraysAllocated = false;
   std::array<TrackingFrameInfo*, nLayers> mTrackingFrameInfoDevice;
   TrackingFrameInfo** mTrackingFrameInfoDeviceArray;
 
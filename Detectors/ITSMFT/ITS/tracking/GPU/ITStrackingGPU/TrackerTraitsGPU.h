@@ -53,6 +53,9 @@ class TrackerTraitsGPU : public TrackerTraits
   int getTFNumberOfCells() const override;
 
  private:
+  // One road finding step on the device, the found seeds are stored in the slot outputSlot, returns their number
+  int processNeighboursDevice(const int iLayer, const int iLevel, CellSeed* currentCellSeeds, const int* currentCellIds, const unsigned int nCurrentCells, const int outputSlot);
+
   IndexTableUtils* mDeviceIndexTableUtils;
   gpu::TimeFrameGPU<7>* mTimeFrameGPU;
   gpu::StaticTrackingParameters<nLayers>* mStaticTrkPars;
@@ -52,6 +52,68 @@ GPUg() void fitTrackSeedsKernel(
 #endif
 } // namespace gpu
 
+// Neighbour finding: counts the neighbours in layer layerIndex of the cells of layerIndex + 1 and scans the counts
+// to the offsets neighboursLUT (nCellsNext + 1 entries, zeroed), returns the number of neighbours
+int countCellNeighboursHandler(CellSeed** cellsLayersDevice,
+                               int* neighboursLUT,
+                               int** cellsLUTs,
+                               const float maxChi2ClusterAttachment,
+                               const float bz,
+                               const int layerIndex,
+                               const int nCells,
+                               const int nCellsNext);
+
+// Neighbour finding: stores the neighbours at the offsets computed by countCellNeighboursHandler, and updates the
+// levels of the cells of layerIndex + 1. neighboursPositions holds nCellsNext zeroed counters
+void computeCellNeighboursHandler(CellSeed** cellsLayersDevice,
+                                  int* neighboursLUT,
+                                  int* neighboursPositions,
+                                  int* cellNeighbours,
+                                  int** cellsLUTs,
+                                  const float maxChi2ClusterAttachment,
+                                  const float bz,
+                                  const int layerIndex,
+                                  const int nCells);
+
+// Road finding: counts the seeds obtained by extending the current seeds, of layer layerIndex, with their neighbours of
+// layerIndex - 1, and scans the counts to the offsets foundSeedsTable (nCurrentSeeds + 1 entries), returns the number of seeds
+int countNeighbourSeedsHandler(const int layerIndex,
+                               const int level,
+                               CellSeed** allCellSeeds,
+                               CellSeed* currentCellSeeds,
+                               const int* currentCellIds,
+                               const unsigned int nCurrentCells,
+                               int* foundSeedsTable,
+                               unsigned char** usedClusters,
+                               int** neighbours,
+                               int** neighboursLUT,
+                               TrackingFrameInfo** foundTrackingFrameInfo,
+                               const float bz,
+                               const float maxChi2ClusterAttachment,
+                               const float layerxX0,
+                               const o2::base::Propagator* propagator,
+                               const o2::base::PropagatorF::MatCorrType matCorrType);
+
+// Road finding: stores the seeds at the offsets computed by countNeighbourSeedsHandler
+void computeNeighbourSeedsHandler(const int layerIndex,
+                                  const int level,
+                                  CellSeed** allCellSeeds,
+                                  CellSeed* currentCellSeeds,
+                                  const int* currentCellIds,
+                                  const unsigned int nCurrentCells,
+                                  CellSeed* updatedCellSeeds,
+                                  int* updatedCellsIds,
+                                  int* foundSeedsTable,
+                                  unsigned char** usedClusters,
+                                  int** neighbours,
+                                  int** neighboursLUT,
+                                  TrackingFrameInfo** foundTrackingFrameInfo,
+                                  const float bz,
+                                  const float maxChi2ClusterAttachment,
+                                  const float layerxX0,
+                                  const o2::base::Propagator* propagator,
+                                  const o2::base::PropagatorF::MatCorrType matCorrType);
+
 void trackSeedHandler(CellSeed* trackSeeds,
                       TrackingFrameInfo** foundTrackingFrameInfo,
                       o2::its::TrackITSExt* tracks,
@@ -330,6 +330,40 @@ void TimeFrameGPU<nLayers>::allocMemAsync(void** ptr, size_t size, Stream* strPt
   }
 }
 
+template <int nLayers>
+template <typename T>
+void TimeFrameGPU<nLayers>::reserveDeviceBuffer(T*& ptr, size_t& capacity, const size_t size)
+{
+  if (size <= capacity && capacity) {
+    return;
+  }
+  if (capacity && !getExtAllocator()) {
+    checkGPUError(cudaFreeAsync(ptr, mGpuStreams[0].get()));
+  }
+  capacity = size + size / 4 + 1; // Some margin, such that the next iterations do not grow it again
+  allocMemAsync(reinterpret_cast<void**>(&ptr), capacity * sizeof(T), &(mGpuStreams[0]), getExtAllocator());
+}
+
+template <int nLayers>
+void TimeFrameGPU<nLayers>::resetDeviceBuffers()
+{
+  if (!getExtAllocator()) {
+    return; // Owned buffers are kept for the next timeframes
+  }
+  // The memory of the external allocator is released at the end of the timeframe
+  mCellsDeviceCapacity.fill(0);
+  mCellsLUTDeviceCapacity.fill(0);
+  mNeighboursDeviceCapacity.fill(0);
+  mNeighboursLUTDeviceCapacity.fill(0);
+  mNeighboursPositionsDeviceCapacity.fill(0);
+  mRoadsUsedClustersDeviceCapacity.fill(0);
+  mRoadSeedsDeviceCapacity.fill(0);
+  mRoadSeedsIdsDeviceCapacity.fill(0);
+  mRoadSeedsTableDeviceCapacity = 0;
+  mTrackITSExtDeviceCapacity = 0;
+  mRoadsDeviceArraysAllocated = false;
+}
+
 template <int nLayers>
 void TimeFrameGPU<nLayers>::setDevicePropagator(const o2::base::PropagatorImpl<float>* propagator)
 {
@@ -391,6 +425,9 @@ void TimeFrameGPU<nLayers>::initialiseHybrid(const int iteration,
                                              const TimeFrameGPUParameters* gpuParam)
 {
   mGpuStreams.resize(mGpuParams.nTimeFrameChunks);
+  if (!iteration) {
+    resetDeviceBuffers();
+  }
   o2::its::TimeFrame::initialise(iteration, trkParam, maxLayers);
 }
 
@@ -532,16 +569,42 @@ void TimeFrameGPU<nLayers>::loadTrackletsDevice()
 template <int nLayers>
 void TimeFrameGPU<nLayers>::loadCellsDevice()
 {
+  if (!mRoadsDeviceArraysAllocated) {
+    allocMemAsync(reinterpret_cast<void**>(&mCellsDeviceArray), (nLayers - 2) * sizeof(CellSeed*), &(mGpuStreams[0]), getExtAllocator());
+    allocMemAsync(reinterpret_cast<void**>(&mCellsLUTDeviceArray), (nLayers - 3) * sizeof(int*), &(mGpuStreams[0]), getExtAllocator());
+    allocMemAsync(reinterpret_cast<void**>(&mNeighboursDeviceArray), (nLayers - 3) * sizeof(int*), &(mGpuStreams[0]), getExtAllocator());
+    allocMemAsync(reinterpret_cast<void**>(&mNeighboursLUTDeviceArray), (nLayers - 3) * sizeof(int*), &(mGpuStreams[0]), getExtAllocator());
+    allocMemAsync(reinterpret_cast<void**>(&mRoadsUsedClustersDeviceArray), nLayers * sizeof(unsigned char*), &(mGpuStreams[0]), getExtAllocator());
+    mRoadsDeviceArraysAllocated = true;
+  }
   for (auto iLayer{0}; iLayer < nLayers - 2; ++iLayer) {
     LOGP(debug, "gpu-transfer: loading {} cell seeds on layer {}, for {} MB.", mCells[iLayer].size(), iLayer, mCells[iLayer].size() * sizeof(CellSeed) / MB);
-    allocMemAsync(reinterpret_cast<void**>(&mCellsDevice[iLayer]), mCells[iLayer].size() * sizeof(CellSeed), nullptr, getExtAllocator());
-    // Register and move data
-    checkGPUError(cudaHostRegister(mCells[iLayer].data(), mCells[iLayer].size() * sizeof(CellSeed), cudaHostRegisterPortable));
-    checkGPUError(cudaMemcpyAsync(mCellsDevice[iLayer], mCells[iLayer].data(), mCells[iLayer].size() * sizeof(CellSeed), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+    reserveDeviceBuffer(mCellsDevice[iLayer], mCellsDeviceCapacity[iLayer], mCells[iLayer].size());
+    if (!mCells[iLayer].empty()) {
+      checkGPUError(cudaMemcpyAsync(mCellsDevice[iLayer], mCells[iLayer].data(), mCells[iLayer].size() * sizeof(CellSeed), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+    }
+  }
+  for (auto iLayer{0}; iLayer < nLayers - 3; ++iLayer) {
+    reserveDeviceBuffer(mCellsLUTDevice[iLayer], mCellsLUTDeviceCapacity[iLayer], mCellsLookupTable[iLayer].size());
+    if (!mCellsLookupTable[iLayer].empty()) {
+      checkGPUError(cudaMemcpyAsync(mCellsLUTDevice[iLayer], mCellsLookupTable[iLayer].data(), mCellsLookupTable[iLayer].size() * sizeof(int), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+    }
   }
-  allocMemAsync(reinterpret_cast<void**>(&mCellsDeviceArray), (nLayers - 2) * sizeof(CellSeed*), nullptr, getExtAllocator());
-  checkGPUError(cudaHostRegister(mCellsDevice.data(), (nLayers - 2) * sizeof(CellSeed*), cudaHostRegisterPortable));
+  // The pointer arrays are small and pageable, their content is staged when the copy is issued
   checkGPUError(cudaMemcpyAsync(mCellsDeviceArray, mCellsDevice.data(), (nLayers - 2) * sizeof(CellSeed*), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+  checkGPUError(cudaMemcpyAsync(mCellsLUTDeviceArray, mCellsLUTDevice.data(), (nLayers - 3) * sizeof(int*), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+}
+
+template <int nLayers>
+void TimeFrameGPU<nLayers>::loadUsedClustersDevice()
+{
+  for (auto iLayer{0}; iLayer < nLayers; ++iLayer) {
+    reserveDeviceBuffer(mRoadsUsedClustersDevice[iLayer], mRoadsUsedClustersDeviceCapacity[iLayer], mUsedClusters[iLayer].size());
+    if (!mUsedClusters[iLayer].empty()) {
+      checkGPUError(cudaMemcpyAsync(mRoadsUsedClustersDevice[iLayer], mUsedClusters[iLayer].data(), mUsedClusters[iLayer].size() * sizeof(unsigned char), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+    }
+  }
+  checkGPUError(cudaMemcpyAsync(mRoadsUsedClustersDeviceArray, mRoadsUsedClustersDevice.data(), nLayers * sizeof(unsigned char*), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
 }
 
 template <int nLayers>
@@ -563,35 +626,55 @@ void TimeFrameGPU<nLayers>::loadTrackSeedsDevice(std::vector<CellSeed>& seeds)
 }
 
 template <int nLayers>
-void TimeFrameGPU<nLayers>::createCellNeighboursDevice(const unsigned int& layer, std::vector<std::pair<int, int>>& neighbours)
+void TimeFrameGPU<nLayers>::createNeighboursLUTDevice(const int layer, const unsigned int nCells)
+{
+  LOGP(debug, "gpu-allocation: reserving neighbours LUT for {} cells on layer {}.", nCells, layer + 1);
+  reserveDeviceBuffer(mNeighboursLUTDevice[layer], mNeighboursLUTDeviceCapacity[layer], nCells + 1);
+  checkGPUError(cudaMemsetAsync(mNeighboursLUTDevice[layer], 0, (nCells + 1) * sizeof(int), mGpuStreams[0].get()));
+  reserveDeviceBuffer(mNeighboursPositionsDevice[layer], mNeighboursPositionsDeviceCapacity[layer], nCells);
+  checkGPUError(cudaMemsetAsync(mNeighboursPositionsDevice[layer], 0, nCells * sizeof(int), mGpuStreams[0].get()));
+  checkGPUError(cudaMemcpyAsync(mNeighboursLUTDeviceArray, mNeighboursLUTDevice.data(), (nLayers - 3) * sizeof(int*), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+}
+
+template <int nLayers>
+void TimeFrameGPU<nLayers>::createNeighboursDevice(const int layer, const unsigned int nNeighbours)
+{
+  LOGP(debug, "gpu-allocation: reserving {} neighbours on layer {}, for {} MB.", nNeighbours, layer, nNeighbours * sizeof(int) / MB);
+  reserveDeviceBuffer(mNeighboursDevice[layer], mNeighboursDeviceCapacity[layer], nNeighbours);
+  checkGPUError(cudaMemcpyAsync(mNeighboursDeviceArray, mNeighboursDevice.data(), (nLayers - 3) * sizeof(int*), cudaMemcpyHostToDevice, mGpuStreams[0].get()));
+}
+
+template <int nLayers>
+void TimeFrameGPU<nLayers>::createRoadSeedsTableDevice(const unsigned int nCurrentSeeds)
+{
+  reserveDeviceBuffer(mRoadSeedsTableDevice, mRoadSeedsTableDeviceCapacity, nCurrentSeeds + 1);
+  checkGPUError(cudaMemsetAsync(mRoadSeedsTableDevice, 0, (nCurrentSeeds + 1) * sizeof(int), mGpuStreams[0].get()));
+}
+
+template <int nLayers>
+void TimeFrameGPU<nLayers>::createRoadSeedsDevice(const int slot, const unsigned int nSeeds)
 {
-  mCellsNeighbours[layer].clear();
-  mCellsNeighbours[layer].resize(neighbours.size());
-  LOGP(debug, "gpu-allocation: reserving {} neighbours, for {} MB.", neighbours.size(), neighbours.size() * sizeof(gpuPair<int, int>) / MB);
-  allocMemAsync(reinterpret_cast<void**>(&mNeighboursDevice[layer]), neighbours.size() * sizeof(gpuPair<int, int>), &(mGpuStreams[0]), getExtAllocator());
-  checkGPUError(cudaMemsetAsync(mNeighboursDevice[layer], 0, neighbours.size() * sizeof(gpuPair<int, int>), mGpuStreams[0].get()));
-  checkGPUError(cudaHostRegister(neighbours.data(), neighbours.size() * sizeof(std::pair<int, int>), cudaHostRegisterPortable));
+  LOGP(debug, "gpu-allocation: reserving {} road seeds, for {} MB.", nSeeds, nSeeds * sizeof(CellSeed) / MB);
+  reserveDeviceBuffer(mRoadSeedsDevice[slot], mRoadSeedsDeviceCapacity[slot], nSeeds);
+  reserveDeviceBuffer(mRoadSeedsIdsDevice[slot], mRoadSeedsIdsDeviceCapacity[slot], nSeeds);
 }
 
 template <int nLayers>
-void TimeFrameGPU<nLayers>::createTrackITSExtDevice(std::vector<CellSeed>& seeds)
+void TimeFrameGPU<nLayers>::createTrackITSExtDevice(const unsigned int nSeeds)
 {
-  mTrackITSExt.clear();
-  mTrackITSExt.resize(seeds.size());
-  LOGP(debug, "gpu-allocation: reserving {} tracks, for {} MB.", seeds.size(), seeds.size() * sizeof(o2::its::TrackITSExt) / MB);
-  allocMemAsync(reinterpret_cast<void**>(&mTrackITSExtDevice), seeds.size() * sizeof(o2::its::TrackITSExt), &(mGpuStreams[0]), getExtAllocator());
-  checkGPUError(cudaMemsetAsync(mTrackITSExtDevice, 0, seeds.size() * sizeof(o2::its::TrackITSExt), mGpuStreams[0].get()));
-  checkGPUError(cudaHostRegister(mTrackITSExt.data(), seeds.size() * sizeof(o2::its::TrackITSExt), cudaHostRegisterPortable));
+  LOGP(debug, "gpu-allocation: reserving {} tracks, for {} MB.", nSeeds, nSeeds * sizeof(o2::its::TrackITSExt) / MB);
+  reserveDeviceBuffer(mTrackITSExtDevice, mTrackITSExtDeviceCapacity, nSeeds);
+  checkGPUError(cudaMemsetAsync(mTrackITSExtDevice, 0, nSeeds * sizeof(o2::its::TrackITSExt), mGpuStreams[0].get()));
 }
 
 template <int nLayers>
-void TimeFrameGPU<nLayers>::downloadTrackITSExtDevice(std::vector<CellSeed>& seeds)
+void TimeFrameGPU<nLayers>::downloadTrackITSExtDevice(const unsigned int nSeeds)
 {
-  LOGP(debug, "gpu-transfer: downloading {} tracks, for {} MB.", mTrackITSExt.size(), mTrackITSExt.size() * sizeof(o2::its::TrackITSExt) / MB);
-  checkGPUError(cudaMemcpyAsync(mTrackITSExt.data(), mTrackITSExtDevice, mTrackITSExt.size() * sizeof(o2::its::TrackITSExt), cudaMemcpyDeviceToHost, mGpuStreams[0].get()));
-  checkGPUError(cudaHostUnregister(mTrackITSExt.data()));
-  checkGPUError(cudaHostUnregister(seeds.data()));
-  discardResult(cudaDeviceSynchronize());
+  LOGP(debug, "gpu-transfer: downloading {} tracks, for {} MB.", nSeeds, nSeeds * sizeof(o2::its::TrackITSExt) / MB);
+  const size_t offset{mTrackITSExt.size()};
+  mTrackITSExt.resize(offset + nSeeds);
+  checkGPUError(cudaMemcpyAsync(mTrackITSExt.data() + offset, mTrackITSExtDevice, nSeeds * sizeof(o2::its::TrackITSExt), cudaMemcpyDeviceToHost, mGpuStreams[0].get()));
+  checkGPUError(cudaStreamSynchronize(mGpuStreams[0].get()));
 }
 
 template <int nLayers>
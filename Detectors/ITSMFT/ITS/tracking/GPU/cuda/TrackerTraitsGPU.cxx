@@ -325,94 +325,122 @@ void TrackerTraitsGPU<nLayers>::computeCellsHybrid(const int iteration)
 template <int nLayers>
 void TrackerTraitsGPU<nLayers>::findCellsNeighboursHybrid(const int iteration)
 {
-  TrackerTraits::findCellsNeighbours(iteration);
-  // for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad() - 1; ++iLayer) {
-  //   const int nextLayerCellsNum{static_cast<int>(mTimeFrameGPU->getCells()[iLayer + 1].size())};
-  //   mTimeFrameGPU->getCellsNeighboursLUT()[iLayer].clear();
-  //   mTimeFrameGPU->getCellsNeighboursLUT()[iLayer].resize(nextLayerCellsNum, 0);
-  //   if (mTimeFrameGPU->getCells()[iLayer + 1].empty() ||
-  //       mTimeFrameGPU->getCellsLookupTable()[iLayer].empty()) {
-  //     mTimeFrameGPU->getCellsNeighbours()[iLayer].clear();
-  //     continue;
-  //   }
-
-  //   int layerCellsNum{static_cast<int>(mTimeFrameGPU->getCells()[iLayer].size())};
-  //   std::vector<std::pair<int, int>> cellsNeighbours;
-  //   cellsNeighbours.reserve(nextLayerCellsNum);
-  //   mTimeFrameGPU->createCellNeighboursDevice(iLayer, cellsNeighbours);
-
-  //   // // [...]
-  //   // cellNeighboursHandler<true>(mTimeFrameGPU->getDeviceNeighbours(iLayer));
-  //   // //         // Compute Cell Neighbours LUT
-  //   // //         checkGPUError(cub::DeviceScan::ExclusiveSum(mTimeFrameGPU->getChunk(chunkId).getDeviceCUBTmpBuffer(),                       // d_temp_storage
-  //   // //                                                     mTimeFrameGPU->getChunk(chunkId).getTimeFrameGPUParameters()->tmpCUBBufferSize, // temp_storage_bytes
-  //   // //                                                     mTimeFrameGPU->getChunk(chunkId).getDeviceCellNeigboursLookupTables(iLayer),    // d_in
-  //   // //                                                     mTimeFrameGPU->getChunk(chunkId).getDeviceCellNeigboursLookupTables(iLayer),    // d_out
-  //   // //                                                     mTimeFrameGPU->getHostNCells(chunkId)[iLayer + 1],                              // num_items
-  //   // //                                                     mTimeFrameGPU->getStream(chunkId).get()));
-
-  //   // cellsNeighboursHandler<false>(mTimeFrameGPU->getDeviceNeighbours(iLayer));
-  //   // // [...]
-
-  //   std::sort(cellsNeighbours.begin(), cellsNeighbours.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
-  //     return a.second < b.second;
-  //   });
-  //   mTimeFrameGPU->getCellsNeighbours()[iLayer].clear();
-  //   mTimeFrameGPU->getCellsNeighbours()[iLayer].reserve(cellsNeighbours.size());
-  //   for (auto& cellNeighboursIndex : cellsNeighbours) {
-  //     mTimeFrameGPU->getCellsNeighbours()[iLayer].push_back(cellNeighboursIndex.first);
-  //   }
-  //   std::inclusive_scan(mTimeFrameGPU->getCellsNeighboursLUT()[iLayer].begin(), mTimeFrameGPU->getCellsNeighboursLUT()[iLayer].end(), mTimeFrameGPU->getCellsNeighboursLUT()[iLayer].begin());
-  // }
+  mTimeFrameGPU->loadCellsDevice();
+  for (int iLayer{0}; iLayer < mTrkParams[iteration].CellsPerRoad() - 1; ++iLayer) {
+    const int nextLayerCellsNum{static_cast<int>(mTimeFrameGPU->getCells()[iLayer + 1].size())};
+    mTimeFrameGPU->createNeighboursLUTDevice(iLayer, nextLayerCellsNum);
+    if (mTimeFrameGPU->getCells()[iLayer + 1].empty() ||
+        mTimeFrameGPU->getCellsLookupTable()[iLayer].empty()) {
+      continue;
+    }
+    const int nNeighbours = countCellNeighboursHandler(mTimeFrameGPU->getDeviceArrayCells(),
+                                                       mTimeFrameGPU->getDeviceNeighboursLUT(iLayer),
+                                                       mTimeFrameGPU->getDeviceArrayCellsLUT(),
+                                                       mTrkParams[0].MaxChi2ClusterAttachment,
+                                                       mBz,
+                                                       iLayer,
+                                                       mTimeFrameGPU->getCells()[iLayer].size(),
+                                                       nextLayerCellsNum);
+    mTimeFrameGPU->createNeighboursDevice(iLayer, nNeighbours);
+    if (!nNeighbours) {
+      continue;
+    }
+    computeCellNeighboursHandler(mTimeFrameGPU->getDeviceArrayCells(),
+                                 mTimeFrameGPU->getDeviceNeighboursLUT(iLayer),
+                                 mTimeFrameGPU->getDeviceNeighboursPositions(iLayer),
+                                 mTimeFrameGPU->getDeviceNeighbours(iLayer),
+                                 mTimeFrameGPU->getDeviceArrayCellsLUT(),
+                                 mTrkParams[0].MaxChi2ClusterAttachment,
+                                 mBz,
+                                 iLayer,
+                                 mTimeFrameGPU->getCells()[iLayer].size());
+  }
 };
 
+template <int nLayers>
+int TrackerTraitsGPU<nLayers>::processNeighboursDevice(const int iLayer, const int iLevel, CellSeed* currentCellSeeds, const int* currentCellIds, const unsigned int nCurrentCells, const int outputSlot)
+{
+  mTimeFrameGPU->createRoadSeedsTableDevice(nCurrentCells);
+  const int nSeeds = countNeighbourSeedsHandler(iLayer,
+                                                iLevel,
+                                                mTimeFrameGPU->getDeviceArrayCells(),
+                                                currentCellSeeds,
+                                                currentCellIds,
+                                                nCurrentCells,
+                                                mTimeFrameGPU->getDeviceRoadSeedsTable(),
+                                                mTimeFrameGPU->getDeviceArrayUsedClusters(),
+                                                mTimeFrameGPU->getDeviceArrayNeighbours(),
+                                                mTimeFrameGPU->getDeviceArrayNeighboursLUT(),
+                                                mTimeFrameGPU->getDeviceArrayTrackingFrameInfo(),
+                                                mBz,
+                                                mTrkParams[0].MaxChi2ClusterAttachment,
+                                                mTrkParams[0].LayerxX0[iLayer - 1],
+                                                mTimeFrameGPU->getDevicePropagator(),
+                                                mCorrType);
+  if (!nSeeds) {
+    return 0;
+  }
+  mTimeFrameGPU->createRoadSeedsDevice(outputSlot, nSeeds);
+  computeNeighbourSeedsHandler(iLayer,
+                               iLevel,
+                               mTimeFrameGPU->getDeviceArrayCells(),
+                               currentCellSeeds,
+                               currentCellIds,
+                               nCurrentCells,
+                               mTimeFrameGPU->getDeviceRoadSeeds(outputSlot),
+                               mTimeFrameGPU->getDeviceRoadSeedsIds(outputSlot),
+                               mTimeFrameGPU->getDeviceRoadSeedsTable(),
+                               mTimeFrameGPU->getDeviceArrayUsedClusters(),
+                               mTimeFrameGPU->getDeviceArrayNeighbours(),
+                               mTimeFrameGPU->getDeviceArrayNeighboursLUT(),
+                               mTimeFrameGPU->getDeviceArrayTrackingFrameInfo(),
+                               mBz,
+                               mTrkParams[0].MaxChi2ClusterAttachment,
+                               mTrkParams[0].LayerxX0[iLayer - 1],
+                               mTimeFrameGPU->getDevicePropagator(),
+                               mCorrType);
+  return nSeeds;
+}
+
 template <int nLayers>
 void TrackerTraitsGPU<nLayers>::findRoads(const int iteration)
 {
   for (int startLevel{mTrkParams[iteration].CellsPerRoad()}; startLevel >= mTrkParams[iteration].CellMinimumLevel(); --startLevel) {
     const int minimumLayer{startLevel - 1};
-    std::vector<CellSeed> trackSeeds;
+    // The clusters used by the tracks of the previous levels are excluded from the seeds
+    mTimeFrameGPU->loadUsedClustersDevice();
+    mTimeFrameGPU->getTrackITSExt().clear();
     for (int startLayer{mTrkParams[iteration].CellsPerRoad() - 1}; startLayer >= minimumLayer; --startLayer) {
-      std::vector<int> lastCellId, updatedCellId;
-      std::vector<CellSeed> lastCellSeed, updatedCellSeed;
-
-      processNeighbours(startLayer, startLevel, mTimeFrame->getCells()[startLayer], lastCellId, updatedCellSeed, updatedCellId);
+      // The seeds of each step are the input of the next one, in the other slot
+      int slot{0};
+      int nSeeds = mTimeFrameGPU->getCells()[startLayer].empty() ? 0 : processNeighboursDevice(startLayer, startLevel, mTimeFrameGPU->getDeviceCells(startLayer), nullptr, mTimeFrameGPU->getCells()[startLayer].size(), slot);
 
       int level = startLevel;
-      for (int iLayer{startLayer - 1}; iLayer > 0 && level > 2; --iLayer) {
-        lastCellSeed.swap(updatedCellSeed);
-        lastCellId.swap(updatedCellId);
-        updatedCellSeed.clear();
-        updatedCellId.clear();
-        processNeighbours(iLayer, --level, lastCellSeed, lastCellId, updatedCellSeed, updatedCellId);
+      for (int iLayer{startLayer - 1}; iLayer > 0 && level > 2 && nSeeds; --iLayer) {
+        nSeeds = processNeighboursDevice(iLayer, --level, mTimeFrameGPU->getDeviceRoadSeeds(slot), mTimeFrameGPU->getDeviceRoadSeedsIds(slot), nSeeds, 1 - slot);
+        slot = 1 - slot;
       }
-      for (auto& seed : updatedCellSeed) {
-        if (seed.getQ2Pt() > 1.e3 || seed.getChi2() > mTrkParams[0].MaxChi2NDF * ((startLevel + 2) * 2 - 5)) {
-          continue;
-        }
-        trackSeeds.push_back(seed);
+      if (!nSeeds) {
+        continue;
       }
+      mTimeFrameGPU->createTrackITSExtDevice(nSeeds);
+      trackSeedHandler(
+        mTimeFrameGPU->getDeviceRoadSeeds(slot),          // CellSeed* trackSeeds,
+        mTimeFrameGPU->getDeviceArrayTrackingFrameInfo(), // TrackingFrameInfo** foundTrackingFrameInfo,
+        mTimeFrameGPU->getDeviceTrackITSExt(),            // o2::its::TrackITSExt* tracks,
+        nSeeds,                                           // const size_t nSeeds,
+        mBz,                                              // const float Bz,
+        startLevel,                                       // const int startLevel,
+        mTrkParams[0].MaxChi2ClusterAttachment,           // float maxChi2ClusterAttachment,
+        mTrkParams[0].MaxChi2NDF,                         // float maxChi2NDF,
+        mTimeFrameGPU->getDevicePropagator(),             // const o2::base::Propagator* propagator
+        mCorrType);                                       // o2::base::PropagatorImpl<float>::MatCorrType
+      mTimeFrameGPU->downloadTrackITSExtDevice(nSeeds);
     }
-    if (!trackSeeds.size()) {
-      LOGP(info, "No track seeds found, skipping track finding");
+    if (mTimeFrameGPU->getTrackITSExt().empty()) {
+      LOGP(debug, "No track seeds found, skipping track finding");
       continue;
     }
-    mTimeFrameGPU->createTrackITSExtDevice(trackSeeds);
-    mTimeFrameGPU->loadTrackSeedsDevice(trackSeeds);
-
-    trackSeedHandler(
-      mTimeFrameGPU->getDeviceTrackSeeds(),             // CellSeed* trackSeeds,
-      mTimeFrameGPU->getDeviceArrayTrackingFrameInfo(), // TrackingFrameInfo** foundTrackingFrameInfo,
-      mTimeFrameGPU->getDeviceTrackITSExt(),            // o2::its::TrackITSExt* tracks,
-      trackSeeds.size(),                                // const size_t nSeeds,
-      mBz,                                              // const float Bz,
-      startLevel,                                       // const int startLevel,
-      mTrkParams[0].MaxChi2ClusterAttachment,           // float maxChi2ClusterAttachment,
-      mTrkParams[0].MaxChi2NDF,                         // float maxChi2NDF,
-      mTimeFrameGPU->getDevicePropagator(),             // const o2::base::Propagator* propagator
-      mCorrType);                                       // o2::base::PropagatorImpl<float>::MatCorrType
-
-    mTimeFrameGPU->downloadTrackITSExtDevice(trackSeeds);
 
     auto& tracks = mTimeFrameGPU->getTrackITSExt();
     std::sort(tracks.begin(), tracks.end(), [](const TrackITSExt& a, const TrackITSExt& b) {
@@ -462,7 +490,7 @@ void TrackerTraitsGPU<nLayers>::findRoads(const int iteration)
       mTimeFrame->getTracks(std::min(rofs[0], rofs[1])).emplace_back(track);
     }
   }
-  if (iteration == 2) {
+  if (iteration == static_cast<int>(mTrkParams.size()) - 1) {
     mTimeFrameGPU->unregisterHostMemory(0); // FIXME this needs to work also with sync
   }
 };
@@ -24,6 +24,7 @@
 #include <thrust/functional.h>
 #include <thrust/unique.h>
 #include <thrust/remove.h>
+#include <thrust/scan.h>
 
 #include "ITStracking/Constants.h"
 #include "ITStracking/Configuration.h"
@@ -140,6 +141,9 @@ GPUg() void fitTrackSeedsKernel(
 {
   for (int iCurrentTrackSeedIndex = blockIdx.x * blockDim.x + threadIdx.x; iCurrentTrackSeedIndex < nSeeds; iCurrentTrackSeedIndex += blockDim.x * gridDim.x) {
     auto& seed = trackSeeds[iCurrentTrackSeedIndex];
+    if (seed.getQ2Pt() > 1.e3 || seed.getChi2() > maxChi2NDF * ((startLevel + 2) * 2 - 5)) {
+      continue; // the track stays empty, with a null chi2
+    }
 
     TrackITSExt temporaryTrack{seed};
 
@@ -190,25 +194,23 @@ GPUg() void fitTrackSeedsKernel(
 
 template <bool initRun, int nLayers = 7> // Version for new tracker to supersede the old one
 GPUg() void computeLayerCellNeighboursKernel(
-  CellSeed* cellsCurrentLayer,
-  CellSeed* cellsNextLayer,
+  CellSeed** cellSeedArray,
   int* neighboursLUT,
-  const int* cellsNextLayerLUT,
-  gpuPair<int, int>* cellNeighbours,
+  int* neighboursPositions,
+  int* cellNeighbours,
+  int** cellsLUTs,
   const float maxChi2ClusterAttachment,
   const float bz,
   const int layerIndex,
-  const int* nCells,
-  const int maxCellNeighbours = 1e2)
+  const int nCells)
 {
-  for (int iCurrentCellIndex = blockIdx.x * blockDim.x + threadIdx.x; iCurrentCellIndex < nCells[layerIndex]; iCurrentCellIndex += blockDim.x * gridDim.x) {
-    const auto& currentCellSeed{cellsCurrentLayer[iCurrentCellIndex]};
+  for (int iCurrentCellIndex = blockIdx.x * blockDim.x + threadIdx.x; iCurrentCellIndex < nCells; iCurrentCellIndex += blockDim.x * gridDim.x) {
+    const auto& currentCellSeed{cellSeedArray[layerIndex][iCurrentCellIndex]};
     const int nextLayerTrackletIndex{currentCellSeed.getSecondTrackletIndex()};
-    const int nextLayerFirstCellIndex{cellsNextLayerLUT[nextLayerTrackletIndex]};
-    const int nextLayerLastCellIndex{cellsNextLayerLUT[nextLayerTrackletIndex + 1]};
-    int foundNeighbours{0};
+    const int nextLayerFirstCellIndex{cellsLUTs[layerIndex][nextLayerTrackletIndex]};
+    const int nextLayerLastCellIndex{cellsLUTs[layerIndex][nextLayerTrackletIndex + 1]};
     for (int iNextCell{nextLayerFirstCellIndex}; iNextCell < nextLayerLastCellIndex; ++iNextCell) {
-      CellSeed nextCellSeed{cellsNextLayer[iNextCell]};                     // Copy
+      CellSeed nextCellSeed{cellSeedArray[layerIndex + 1][iNextCell]};     // Copy
       if (nextCellSeed.getFirstTrackletIndex() != nextLayerTrackletIndex) { // Check if cells share the same tracklet
         break;
       }
@@ -224,18 +226,101 @@ GPUg() void computeLayerCellNeighboursKernel(
       if constexpr (initRun) {
         atomicAdd(neighboursLUT + iNextCell, 1);
       } else {
-        if (foundNeighbours >= maxCellNeighbours) {
-          printf("its-gpu-neighbours-finder: data loss on layer: %d: number of neightbours exceeded the threshold!\n");
+        // The levels of the current layer are final, they were updated by the previous layer
+        cellNeighbours[neighboursLUT[iNextCell] + atomicAdd(neighboursPositions + iNextCell, 1)] = iCurrentCellIndex;
+        atomicMax(cellSeedArray[layerIndex + 1][iNextCell].getLevelPtr(), currentCellSeed.getLevel() + 1);
+      }
+    }
+  }
+}
+
+template <bool dryRun, int nLayers = 7>
+GPUg() void processNeighboursKernel(const int layerIndex,
+                                    const int level,
+                                    CellSeed** allCellSeeds,
+                                    CellSeed* currentCellSeeds,
+                                    const int* currentCellIds,
+                                    const unsigned int nCurrentCells,
+                                    CellSeed* updatedCellSeeds,
+                                    int* updatedCellsIds,
+                                    int* foundSeedsTable,
+                                    unsigned char** usedClusters,
+                                    int** neighbours,
+                                    int** neighboursLUT,
+                                    TrackingFrameInfo** foundTrackingFrameInfo,
+                                    const float bz,
+                                    const float maxChi2ClusterAttachment,
+                                    const float layerxX0,
+                                    const o2::base::Propagator* propagator,
+                                    const o2::base::PropagatorF::MatCorrType matCorrType)
+{
+  constexpr float radl = 9.36f; // Radiation length of Si [cm]
+  constexpr float rho = 2.33f;  // Density of Si [g/cm^3]
+  for (unsigned int iCurrentCell = blockIdx.x * blockDim.x + threadIdx.x; iCurrentCell < nCurrentCells; iCurrentCell += blockDim.x * gridDim.x) {
+    int foundSeeds{0};
+    const auto& currentCell{currentCellSeeds[iCurrentCell]};
+    if (currentCell.getLevel() != level) {
+      continue;
+    }
+    if (currentCellIds == nullptr && (usedClusters[layerIndex][currentCell.getFirstClusterIndex()] ||
+                                      usedClusters[layerIndex + 1][currentCell.getSecondClusterIndex()] ||
+                                      usedClusters[layerIndex + 2][currentCell.getThirdClusterIndex()])) {
+      continue; // this we do only on the first step, the cells are then the input seeds
+    }
+    const int cellId = currentCellIds == nullptr ? iCurrentCell : currentCellIds[iCurrentCell];
+    const int startNeighbourId{neighboursLUT[layerIndex - 1][cellId]};
+    const int endNeighbourId{neighboursLUT[layerIndex - 1][cellId + 1]};
+
+    for (int iNeighbourCell{startNeighbourId}; iNeighbourCell < endNeighbourId; ++iNeighbourCell) {
+      const int neighbourCellId = neighbours[layerIndex - 1][iNeighbourCell];
+      const CellSeed& neighbourCell = allCellSeeds[layerIndex - 1][neighbourCellId];
+      if (neighbourCell.getSecondTrackletIndex() != currentCell.getFirstTrackletIndex()) {
+        continue;
+      }
+      if (usedClusters[layerIndex - 1][neighbourCell.getFirstClusterIndex()]) {
+        continue;
+      }
+      if (currentCell.getLevel() - 1 != neighbourCell.getLevel()) {
+        continue;
+      }
+      CellSeed seed{currentCell};
+      const auto& trHit = foundTrackingFrameInfo[layerIndex - 1][neighbourCell.getFirstClusterIndex()];
+
+      if (!seed.rotate(trHit.alphaTrackingFrame)) {
+        continue;
+      }
+
+      if (!propagator->propagateToX(seed, trHit.xTrackingFrame, bz, o2::base::PropagatorImpl<float>::MAX_SIN_PHI, o2::base::PropagatorImpl<float>::MAX_STEP, matCorrType)) {
+        continue;
+      }
+
+      if (matCorrType == o2::base::PropagatorF::MatCorrType::USEMatCorrNONE) {
+        if (!seed.correctForMaterial(layerxX0, layerxX0 * radl * rho, true)) {
           continue;
         }
-        cellNeighbours[neighboursLUT[iNextCell] + foundNeighbours++] = {iCurrentCellIndex, iNextCell};
+      }
 
-        // FIXME: this is prone to race conditions: check on level is not atomic
-        const int currentCellLevel{currentCellSeed.getLevel()};
-        if (currentCellLevel >= nextCellSeed.getLevel()) {
-          atomicExch(cellsNextLayer[iNextCell].getLevelPtr(), currentCellLevel + 1); // Update level on corresponding cell
-        }
+      auto predChi2{seed.getPredictedChi2(trHit.positionTrackingFrame, trHit.covarianceTrackingFrame)};
+      if ((predChi2 > maxChi2ClusterAttachment) || predChi2 < 0.f) {
+        continue;
+      }
+      seed.setChi2(seed.getChi2() + predChi2);
+      if (!seed.o2::track::TrackParCov::update(trHit.positionTrackingFrame, trHit.covarianceTrackingFrame)) {
+        continue;
       }
+
+      if constexpr (!dryRun) {
+        seed.getClusters()[layerIndex - 1] = neighbourCell.getFirstClusterIndex();
+        seed.setLevel(neighbourCell.getLevel());
+        seed.setFirstTrackletIndex(neighbourCell.getFirstTrackletIndex());
+        seed.setSecondTrackletIndex(neighbourCell.getSecondTrackletIndex());
+        updatedCellSeeds[foundSeedsTable[iCurrentCell] + foundSeeds] = seed;
+        updatedCellsIds[foundSeedsTable[iCurrentCell] + foundSeeds] = neighbourCellId;
+      }
+      foundSeeds++;
+    }
+    if constexpr (dryRun) {
+      foundSeedsTable[iCurrentCell] = foundSeeds;
     }
   }
 }
@@ -689,29 +774,137 @@ GPUg() void computeLayerRoadsKernel(
 }
 } // namespace gpu
 
-template <bool isInit>
-void cellNeighboursHandler(CellSeed* cellsCurrentLayer,
-                           CellSeed* cellsNextLayer,
-                           int* neighboursLUT,
-                           const int* cellsNextLayerLUT,
-                           gpuPair<int, int>* cellNeighbours,
-                           const float maxChi2ClusterAttachment,
-                           const float bz,
-                           const int layerIndex,
-                           const int* nCells,
-                           const int maxCellNeighbours = 1e2)
+int countCellNeighboursHandler(CellSeed** cellsLayersDevice,
+                               int* neighboursLUT,
+                               int** cellsLUTs,
+                               const float maxChi2ClusterAttachment,
+                               const float bz,
+                               const int layerIndex,
+                               const int nCells,
+                               const int nCellsNext)
+{
+  gpu::computeLayerCellNeighboursKernel<true><<<20, 512>>>(
+    cellsLayersDevice,        // CellSeed** cellSeedArray,
+    neighboursLUT,            // int* neighboursLUT,
+    nullptr,                  // int* neighboursPositions,
+    nullptr,                  // int* cellNeighbours,
+    cellsLUTs,                // int** cellsLUTs,
+    maxChi2ClusterAttachment, // const float maxChi2ClusterAttachment,
+    bz,                       // const float bz,
+    layerIndex,               // const int layerIndex,
+    nCells);                  // const int nCells
+  gpuCheckError(cudaPeekAtLastError());
+  thrust::exclusive_scan(THRUST_NAMESPACE::par, neighboursLUT, neighboursLUT + nCellsNext + 1, neighboursLUT);
+  int nNeighbours{0};
+  gpuCheckError(cudaMemcpy(&nNeighbours, neighboursLUT + nCellsNext, sizeof(int), cudaMemcpyDeviceToHost));
+  return nNeighbours;
+}
+
+void computeCellNeighboursHandler(CellSeed** cellsLayersDevice,
+                                  int* neighboursLUT,
+                                  int* neighboursPositions,
+                                  int* cellNeighbours,
+                                  int** cellsLUTs,
+                                  const float maxChi2ClusterAttachment,
+                                  const float bz,
+                                  const int layerIndex,
+                                  const int nCells)
 {
-  gpu::computeLayerCellNeighboursKernel<isInit><<<20, 512>>>(
-    cellsCurrentLayer,        // CellSeed* cellsCurrentLayer,
-    cellsNextLayer,           // CellSeed* cellsNextLayer,
+  gpu::computeLayerCellNeighboursKernel<false><<<20, 512>>>(
+    cellsLayersDevice,        // CellSeed** cellSeedArray,
     neighboursLUT,            // int* neighboursLUT,
-    cellsNextLayerLUT,        // const int* cellsNextLayerLUT,
-    cellNeighbours,           // gpuPair<int, int>* cellNeighbours,
+    neighboursPositions,      // int* neighboursPositions,
+    cellNeighbours,           // int* cellNeighbours,
+    cellsLUTs,                // int** cellsLUTs,
     maxChi2ClusterAttachment, // const float maxChi2ClusterAttachment,
     bz,                       // const float bz,
     layerIndex,               // const int layerIndex,
-    nCells,                   // const int* nCells,
-    maxCellNeighbours);       // const int maxCellNeighbours = 1e2
+    nCells);                  // const int nCells
+  gpuCheckError(cudaPeekAtLastError());
+}
+
+int countNeighbourSeedsHandler(const int layerIndex,
+                               const int level,
+                               CellSeed** allCellSeeds,
+                               CellSeed* currentCellSeeds,
+                               const int* currentCellIds,
+                               const unsigned int nCurrentCells,
+                               int* foundSeedsTable,
+                               unsigned char** usedClusters,
+                               int** neighbours,
+                               int** neighboursLUT,
+                               TrackingFrameInfo** foundTrackingFrameInfo,
+                               const float bz,
+                               const float maxChi2ClusterAttachment,
+                               const float layerxX0,
+                               const o2::base::Propagator* propagator,
+                               const o2::base::PropagatorF::MatCorrType matCorrType)
+{
+  gpu::processNeighboursKernel<true><<<20, 512>>>(
+    layerIndex,               // const int layerIndex,
+    level,                    // const int level,
+    allCellSeeds,             // CellSeed** allCellSeeds,
+    currentCellSeeds,         // CellSeed* currentCellSeeds,
+    currentCellIds,           // const int* currentCellIds,
+    nCurrentCells,            // const unsigned int nCurrentCells,
+    nullptr,                  // CellSeed* updatedCellSeeds,
+    nullptr,                  // int* updatedCellsIds,
+    foundSeedsTable,          // int* foundSeedsTable,
+    usedClusters,             // unsigned char** usedClusters,
+    neighbours,               // int** neighbours,
+    neighboursLUT,            // int** neighboursLUT,
+    foundTrackingFrameInfo,   // TrackingFrameInfo** foundTrackingFrameInfo,
+    bz,                       // const float bz,
+    maxChi2ClusterAttachment, // const float maxChi2ClusterAttachment,
+    layerxX0,                 // const float layerxX0,
+    propagator,               // const o2::base::Propagator* propagator,
+    matCorrType);             // o2::base::PropagatorF::MatCorrType matCorrType
+  gpuCheckError(cudaPeekAtLastError());
+  thrust::exclusive_scan(THRUST_NAMESPACE::par, foundSeedsTable, foundSeedsTable + nCurrentCells + 1, foundSeedsTable);
+  int nSeeds{0};
+  gpuCheckError(cudaMemcpy(&nSeeds, foundSeedsTable + nCurrentCells, sizeof(int), cudaMemcpyDeviceToHost));
+  return nSeeds;
+}
+
+void computeNeighbourSeedsHandler(const int layerIndex,
+                                  const int level,
+                                  CellSeed** allCellSeeds,
+                                  CellSeed* currentCellSeeds,
+                                  const int* currentCellIds,
+                                  const unsigned int nCurrentCells,
+                                  CellSeed* updatedCellSeeds,
+                                  int* updatedCellsIds,
+                                  int* foundSeedsTable,
+                                  unsigned char** usedClusters,
+                                  int** neighbours,
+                                  int** neighboursLUT,
+                                  TrackingFrameInfo** foundTrackingFrameInfo,
+                                  const float bz,
+                                  const float maxChi2ClusterAttachment,
+                                  const float layerxX0,
+                                  const o2::base::Propagator* propagator,
+                                  const o2::base::PropagatorF::MatCorrType matCorrType)
+{
+  gpu::processNeighboursKernel<false><<<20, 512>>>(
+    layerIndex,               // const int layerIndex,
+    level,                    // const int level,
+    allCellSeeds,             // CellSeed** allCellSeeds,
+    currentCellSeeds,         // CellSeed* currentCellSeeds,
+    currentCellIds,           // const int* currentCellIds,
+    nCurrentCells,            // const unsigned int nCurrentCells,
+    updatedCellSeeds,         // CellSeed* updatedCellSeeds,
+    updatedCellsIds,          // int* updatedCellsIds,
+    foundSeedsTable,          // int* foundSeedsTable,
+    usedClusters,             // unsigned char** usedClusters,
+    neighbours,               // int** neighbours,
+    neighboursLUT,            // int** neighboursLUT,
+    foundTrackingFrameInfo,   // TrackingFrameInfo** foundTrackingFrameInfo,
+    bz,                       // const float bz,
+    maxChi2ClusterAttachment, // const float maxChi2ClusterAttachment,
+    layerxX0,                 // const float layerxX0,
+    propagator,               // const o2::base::Propagator* propagator,
+    matCorrType);             // o2::base::PropagatorF::MatCorrType matCorrType
+  gpuCheckError(cudaPeekAtLastError());
 }
 
 void trackSeedHandler(CellSeed* trackSeeds,
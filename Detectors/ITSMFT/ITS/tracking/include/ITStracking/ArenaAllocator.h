@@ -0,0 +1,125 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ArenaAllocator.h
+/// \brief Bump allocator for the per-TF scratch buffers of the CPU tracking
+///
+
+#ifndef TRACKINGITSU_INCLUDE_ARENAALLOCATOR_H_
+#define TRACKINGITSU_INCLUDE_ARENAALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ITStracking/ExternalAllocator.h"
+
+namespace o2::its
+{
+
+/// Memory is handed out by bumping an offset in a single block, nothing is released
+/// before rewind()/reset(). Allocations which do not fit the block go to overflow
+/// buffers; reset() at the start of a TF frees those and regrows the block to the
+/// peak of the previous TF, so in steady state no heap allocation is done.
+/// allocate() is thread safe, rewind() and reset() must be called outside parallel regions.
+class ArenaAllocator final : public ExternalAllocator
+{
+ public:
+  static constexpr size_t Alignment = 64;
+
+  explicit ArenaAllocator(size_t capacity = 0);
+  ~ArenaAllocator();
+  ArenaAllocator(const ArenaAllocator&) = delete;
+  ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+  void* allocate(size_t size) override;
+
+  size_t mark() const { return mUsed.load(std::memory_order_relaxed); }
+  void rewind(size_t mark);
+  void reset();
+  void reserve(size_t capacity);
+
+  size_t getCapacity() const { return mCapacity; }
+  size_t getUsedBytes() const { return mark(); }
+  size_t getPeakBytes() const { return mPeak; }
+  size_t getOverflowBytes() const { return mOverflowBytes; }
+
+ private:
+  struct AlignedDelete {
+    void operator()(std::byte* ptr) const { ::operator delete(ptr, std::align_val_t{Alignment}); }
+  };
+  using Buffer = std::unique_ptr<std::byte, AlignedDelete>;
+  static Buffer makeBuffer(size_t size);
+
+  Buffer mBlock;
+  size_t mCapacity = 0;
+  std::atomic<size_t> mUsed{0};
+  size_t mPeak = 0;
+  std::mutex mOverflowMutex;
+  std::vector<Buffer> mOverflow;
+  size_t mOverflowBytes = 0;
+};
+
+/// Rewinds the arena to its state at construction, for the scratch buffers of one step
+class ArenaScope
+{
+ public:
+  explicit ArenaScope(ArenaAllocator& arena) : mArena{arena}, mMark{arena.mark()} {}
+  ~ArenaScope() { mArena.rewind(mMark); }
+  ArenaScope(const ArenaScope&) = delete;
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+ private:
+  ArenaAllocator& mArena;
+  size_t mMark;
+};
+
+/// STL adaptor, deallocation is a no-op: memory comes back with the enclosing ArenaScope
+template <typename T>
+class ArenaStlAllocator
+{
+ public:
+  using value_type = T;
+
+  explicit ArenaStlAllocator(ArenaAllocator& arena) noexcept : mArena{&arena} {}
+  template <typename U>
+  ArenaStlAllocator(const ArenaStlAllocator<U>& other) noexcept : mArena{other.getArena()}
+  {
+  }
+
+  T* allocate(size_t n) { return static_cast<T*>(mArena->allocate(n * sizeof(T))); }
+  void deallocate(T*, size_t) noexcept {}
+
+  ArenaAllocator* getArena() const noexcept { return mArena; }
+
+  template <typename U>
+  bool operator==(const ArenaStlAllocator<U>& other) const noexcept
+  {
+    return mArena == other.getArena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaStlAllocator<U>& other) const noexcept
+  {
+    return mArena != other.getArena();
+  }
+
+ private:
+  ArenaAllocator* mArena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaStlAllocator<T>>;
+
+} // namespace o2::its
+
+#endif
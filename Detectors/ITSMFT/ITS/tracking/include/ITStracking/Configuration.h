@@ -130,6 +130,7 @@ struct VertexingParameters {
   int maxTrackletsPerCluster = 2e3;
   int phiSpan = -1;
   int zSpan = -1;
+  int nROFsPerWindow = 0; // >0: vertex the timeframe in windows of this many ROFs
 
   int nThreads = 1;
 };
@@ -35,6 +35,7 @@
 #include "ITStracking/Tracklet.h"
 #include "ITStracking/IndexTableUtils.h"
 #include "ITStracking/ExternalAllocator.h"
+#include "ITStracking/ArenaAllocator.h"
 
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
@@ -128,6 +129,10 @@ class TimeFrame
   gsl::span<const Cluster> getClustersOnLayer(int rofId, int layerId) const;
   gsl::span<const Cluster> getClustersPerROFrange(int rofMin, int range, int layerId) const;
   gsl::span<const Cluster> getUnsortedClustersOnLayer(int rofId, int layerId) const;
+  gsl::span<const float> getClustersPhiOnLayer(int rofId, int layerId) const { return getClustersSoAOnLayer(mClustersPhi, rofId, layerId); }
+  gsl::span<const float> getClustersZOnLayer(int rofId, int layerId) const { return getClustersSoAOnLayer(mClustersZ, rofId, layerId); }
+  gsl::span<const float> getClustersROnLayer(int rofId, int layerId) const { return getClustersSoAOnLayer(mClustersR, rofId, layerId); }
+  gsl::span<const int> getClustersIdOnLayer(int rofId, int layerId) const { return getClustersSoAOnLayer(mClustersId, rofId, layerId); }
   gsl::span<const int> getROframesClustersPerROFrange(int rofMin, int range, int layerId) const;
   gsl::span<const int> getROframeClusters(int layerId) const;
   gsl::span<const int> getNClustersROFrange(int rofMin, int range, int layerId) const;
@@ -242,6 +247,8 @@ class TimeFrame
   void resizeVectors(int nLayers);
 
   void setExtAllocator(bool ext) { mExtAllocator = ext; }
+  /// scratch memory of the CPU tracker and vertexer, rewound by ArenaScope and reset at every TF
+  ArenaAllocator& getArena() { return mArena; }
   bool getExtAllocator() const { return mExtAllocator; }
 
   /// Debug and printing
@@ -259,6 +266,11 @@ class TimeFrame
   bool mIsGPU = false;
 
   std::vector<std::vector<Cluster>> mClusters;
+  // Structure-of-arrays copy of the sorted clusters, with the quantities read by the tracklet search
+  std::vector<std::vector<float>> mClustersPhi;
+  std::vector<std::vector<float>> mClustersZ;
+  std::vector<std::vector<float>> mClustersR;
+  std::vector<std::vector<int>> mClustersId;
   std::vector<std::vector<TrackingFrameInfo>> mTrackingFrameInfo;
   std::vector<std::vector<int>> mClusterExternalIndices;
   std::vector<std::vector<int>> mROframesClusters;
@@ -275,6 +287,7 @@ class TimeFrame
   // State if memory will be externally managed.
   bool mExtAllocator = false;
   ExternalAllocator* mAllocator = nullptr;
+  ArenaAllocator mArena;
   std::vector<std::vector<Cluster>> mUnsortedClusters;
   std::vector<std::vector<Tracklet>> mTracklets;
   std::vector<std::vector<CellSeed>> mCells;
@@ -294,6 +307,8 @@ class TimeFrame
 
  private:
   void prepareClusters(const TrackingParameters& trkParam, const int maxLayers);
+  template <typename T>
+  gsl::span<const T> getClustersSoAOnLayer(const std::vector<std::vector<T>>& v, int rofId, int layerId) const;
   float mBz = 5.;
   unsigned int mNTotalLowPtVertices = 0;
   int mBeamPosWeight = 0;
@@ -410,6 +425,16 @@ inline gsl::span<const Cluster> TimeFrame::getClustersOnLayer(int rofId, int lay
   return {&mClusters[layerId][startIdx], static_cast<gsl::span<Cluster>::size_type>(mROframesClusters[layerId][rofId + 1] - startIdx)};
 }
 
+template <typename T>
+inline gsl::span<const T> TimeFrame::getClustersSoAOnLayer(const std::vector<std::vector<T>>& v, int rofId, int layerId) const
+{
+  if (rofId < 0 || rofId >= mNrof) {
+    return gsl::span<const T>();
+  }
+  int startIdx{mROframesClusters[layerId][rofId]};
+  return {v[layerId].data() + startIdx, static_cast<typename gsl::span<const T>::size_type>(mROframesClusters[layerId][rofId + 1] - startIdx)};
+}
+
 inline gsl::span<const Cluster> TimeFrame::getClustersPerROFrange(int rofMin, int range, int layerId) const
 {
   if (rofMin < 0 || rofMin >= mNrof) {
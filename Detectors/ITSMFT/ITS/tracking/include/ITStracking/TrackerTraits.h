@@ -105,6 +105,9 @@ class TrackerTraits
   bool mApplySmoothing = false;
 
  protected:
+  /// sort and deduplicate the tracklets of all layers, build the lookup tables and the labels
+  void finaliseLayerTracklets(const int iteration);
+
   o2::base::PropagatorImpl<float>::MatCorrType mCorrType = o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrNONE;
   o2::gpu::GPUChainITS* mChain = nullptr;
   TimeFrame* mTimeFrame;
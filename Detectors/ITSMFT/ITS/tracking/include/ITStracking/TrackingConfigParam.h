@@ -46,6 +46,7 @@ struct VertexerParamConfig : public o2::conf::ConfigurableParamHelper<VertexerPa
   int zSpan = -1;
   int ZBins = 1;
   int PhiBins = 128;
+  int nROFsPerWindow = 0; // >0: vertex the timeframe in windows of this many ROFs, releasing their buffers after each window
 
   int nThreads = 1;
 
@@ -75,6 +75,8 @@ class Vertexer
   void validateTrackletsHybrid();
   template <typename... T>
   void findVertices(T&&... args);
+  template <typename... T>
+  void findVerticesInWindows(T&&... args);
   void findVerticesHybrid();
   void findHistVertices();
 
@@ -141,6 +143,12 @@ inline void Vertexer::findVertices(T&&... args)
   mTraits->computeVertices(std::forward<T>(args)...);
 }
 
+template <typename... T>
+inline void Vertexer::findVerticesInWindows(T&&... args)
+{
+  mTraits->computeVerticesInWindows(std::forward<T>(args)...);
+}
+
 template <typename... T>
 void Vertexer::initialiseVertexerHybrid(T&&... args)
 {
@@ -66,6 +66,7 @@ class VertexerTraits
   virtual void computeTracklets(const int iteration = 0);
   virtual void computeTrackletMatching(const int iteration = 0);
   virtual void computeVertices(const int iteration = 0);
+  void computeVerticesInWindows(const int iteration = 0);
   virtual void adoptTimeFrame(TimeFrame* tf);
   virtual void updateVertexingParameters(const std::vector<VertexingParameters>& vrtPar, const TimeFrameGPUParameters& gpuTfPar);
   // Hybrid
@@ -99,6 +100,9 @@ class VertexerTraits
   void dumpVertexerTraits();
   void setNThreads(int n);
   int getNThreads() const { return mNThreads; }
+  /// restrict the computation to the ROFs [first, last), last < 0 stands for the end of the timeframe
+  void setROFWindow(int first, int last) { mROFWindow = {first, last}; }
+  int getROFWindowEnd() const { return mROFWindow[1] < 0 ? mTimeFrame->getNrof() : mROFWindow[1]; }
 
   template <typename T = o2::MCCompLabel>
   static std::pair<T, float> computeMain(const std::vector<T>& elements)
@@ -118,6 +122,7 @@ class VertexerTraits
  protected:
   unsigned char mIsGPU;
   int mNThreads = 1;
+  std::array<int, 2> mROFWindow = {0, -1};
 
   std::vector<VertexingParameters> mVrtParams;
   IndexTableUtils mIndexTableUtils;
@@ -0,0 +1,83 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file ArenaAllocator.cxx
+/// \brief
+///
+
+#include "ITStracking/ArenaAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace o2::its
+{
+
+namespace
+{
+constexpr size_t alignUp(size_t size, size_t alignment) { return (size + alignment - 1) & ~(alignment - 1); }
+} // namespace
+
+ArenaAllocator::ArenaAllocator(size_t capacity)
+{
+  reserve(capacity);
+}
+
+ArenaAllocator::~ArenaAllocator() = default;
+
+ArenaAllocator::Buffer ArenaAllocator::makeBuffer(size_t size)
+{
+  return Buffer{static_cast<std::byte*>(::operator new(size, std::align_val_t{Alignment}))};
+}
+
+void* ArenaAllocator::allocate(size_t size)
+{
+  const size_t alignedSize{alignUp(std::max(size, size_t{1}), Alignment)};
+  const size_t offset{mUsed.fetch_add(alignedSize, std::memory_order_relaxed)};
+  if (offset + alignedSize <= mCapacity) {
+    return mBlock.get() + offset;
+  }
+  // does not fit: served from the heap until the next reset, which accounts for it in the block size
+  std::lock_guard<std::mutex> guard(mOverflowMutex);
+  mOverflowBytes += alignedSize;
+  return mOverflow.emplace_back(makeBuffer(alignedSize)).get();
+}
+
+void ArenaAllocator::rewind(size_t mark)
+{
+  mPeak = std::max(mPeak, mUsed.load(std::memory_order_relaxed));
+  mUsed.store(std::min(mark, mUsed.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+void ArenaAllocator::reset()
+{
+  mPeak = std::max(mPeak, mUsed.load(std::memory_order_relaxed));
+  mOverflow.clear();
+  mOverflowBytes = 0;
+  if (mPeak > mCapacity) {
+    reserve(mPeak + mPeak / 8); // some headroom for the TF to TF fluctuations
+  }
+  mUsed.store(0, std::memory_order_relaxed);
+  mPeak = 0;
+}
+
+void ArenaAllocator::reserve(size_t capacity)
+{
+  // only valid when nothing is allocated from the block
+  capacity = alignUp(capacity, Alignment);
+  if (capacity <= mCapacity) {
+    return;
+  }
+  mBlock = makeBuffer(capacity);
+  mCapacity = capacity;
+}
+
+} // namespace o2::its
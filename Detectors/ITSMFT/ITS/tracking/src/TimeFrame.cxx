@@ -69,6 +69,10 @@ TimeFrame::TimeFrame(int nLayers)
   mMinR.resize(nLayers, 10000.);
   mMaxR.resize(nLayers, -1.);
   mClusters.resize(nLayers);
+  mClustersPhi.resize(nLayers);
+  mClustersZ.resize(nLayers);
+  mClustersR.resize(nLayers);
+  mClustersId.resize(nLayers);
   mUnsortedClusters.resize(nLayers);
   mTrackingFrameInfo.resize(nLayers);
   mClusterExternalIndices.resize(nLayers);
@@ -195,50 +199,85 @@ int TimeFrame::loadROFrameData(gsl::span<o2::itsmft::ROFRecord> rofs,
   mNrof = 0;
   deepVectorClear(mClusterSize);
   mClusterSize.reserve(clusters.size());
+  // decode the local coordinates of each run of clusters of the same chip, then move
+  // them to the tracking and global frames in one pass with the flattened matrices
+  const auto& chipTransforms = geom->getChipTransforms();
+  const bool batchTransform{chipTransforms.isInitialised() && chipTransforms.hasTrackingFrame()};
+  std::array<std::vector<float>, 3> loc, trk, glo;
+  std::array<std::vector<float>, 2> sigma2;
   for (auto& rof : rofs) {
-    for (int clusterId{rof.getFirstEntry()}; clusterId < rof.getFirstEntry() + rof.getNEntries(); ++clusterId) {
-      auto& c = clusters[clusterId];
-
-      int layer = geom->getLayer(c.getSensorID());
-
-      auto pattID = c.getPatternID();
-      o2::math_utils::Point3D<float> locXYZ;
-      float sigmaY2 = DefClusError2Row, sigmaZ2 = DefClusError2Col, sigmaYZ = 0; // Dummy COG errors (about half pixel size)
-      unsigned int clusterSize{0};
-      if (pattID != itsmft::CompCluster::InvalidPatternID) {
-        sigmaY2 = dict->getErr2X(pattID);
-        sigmaZ2 = dict->getErr2Z(pattID);
-        if (!dict->isGroup(pattID)) {
-          locXYZ = dict->getClusterCoordinates(c);
-          clusterSize = dict->getNpixels(pattID);
+    const int lastClusterId{rof.getFirstEntry() + rof.getNEntries()};
+    for (int clusterId{rof.getFirstEntry()}; clusterId < lastClusterId;) {
+      const auto sensorID = clusters[clusterId].getSensorID();
+      const int layer = geom->getLayer(sensorID);
+      const int firstChipCluster{clusterId};
+      for (auto& v : loc) {
+        v.clear();
+      }
+      for (auto& v : sigma2) {
+        v.clear();
+      }
+      for (; clusterId < lastClusterId && clusters[clusterId].getSensorID() == sensorID; ++clusterId) {
+        auto& c = clusters[clusterId];
+        auto pattID = c.getPatternID();
+        o2::math_utils::Point3D<float> locXYZ;
+        float sigmaY2 = DefClusError2Row, sigmaZ2 = DefClusError2Col; // Dummy COG errors (about half pixel size)
+        unsigned int clusterSize{0};
+        if (pattID != itsmft::CompCluster::InvalidPatternID) {
+          sigmaY2 = dict->getErr2X(pattID);
+          sigmaZ2 = dict->getErr2Z(pattID);
+          if (!dict->isGroup(pattID)) {
+            locXYZ = dict->getClusterCoordinates(c);
+            clusterSize = dict->getNpixels(pattID);
+          } else {
+            o2::itsmft::ClusterPattern patt(pattIt);
+            locXYZ = dict->getClusterCoordinates(c, patt);
+            clusterSize = patt.getNPixels();
+          }
         } else {
           o2::itsmft::ClusterPattern patt(pattIt);
-          locXYZ = dict->getClusterCoordinates(c, patt);
+          locXYZ = dict->getClusterCoordinates(c, patt, false);
           clusterSize = patt.getNPixels();
         }
-      } else {
-        o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict->getClusterCoordinates(c, patt, false);
-        clusterSize = patt.getNPixels();
+        mClusterSize.push_back(std::min(clusterSize, 255u));
+        loc[0].push_back(locXYZ.x());
+        loc[1].push_back(locXYZ.y());
+        loc[2].push_back(locXYZ.z());
+        sigma2[0].push_back(sigmaY2);
+        sigma2[1].push_back(sigmaZ2);
+      }
+      const int nChipClusters{clusterId - firstChipCluster};
+      for (int i{0}; i < 3; ++i) {
+        trk[i].resize(nChipClusters);
+        glo[i].resize(nChipClusters);
       }
-      if (clusterSize < 255) {
-        mClusterSize.push_back(clusterSize);
+      if (batchTransform) {
+        // Inverse transformation to the local --> tracking, and local --> global
+        chipTransforms.localToTracking(sensorID, nChipClusters, loc[0].data(), loc[1].data(), loc[2].data(), trk[0].data(), trk[1].data(), trk[2].data());
+        chipTransforms.localToGlobal(sensorID, nChipClusters, loc[0].data(), loc[1].data(), loc[2].data(), glo[0].data(), glo[1].data(), glo[2].data());
       } else {
-        mClusterSize.push_back(255);
+        for (int i{0}; i < nChipClusters; ++i) {
+          o2::math_utils::Point3D<float> locXYZ{loc[0][i], loc[1][i], loc[2][i]};
+          auto trkXYZ = geom->getMatrixT2L(sensorID) ^ locXYZ;
+          auto gloXYZ = geom->getMatrixL2G(sensorID) * locXYZ;
+          trk[0][i] = trkXYZ.x();
+          trk[1][i] = trkXYZ.y();
+          trk[2][i] = trkXYZ.z();
+          glo[0][i] = gloXYZ.x();
+          glo[1][i] = gloXYZ.y();
+          glo[2][i] = gloXYZ.z();
+        }
+      }
+      const float alpha{geom->getSensorRefAlpha(sensorID)};
+      for (int i{0}; i < nChipClusters; ++i) {
+        addTrackingFrameInfoToLayer(layer, glo[0][i], glo[1][i], glo[2][i], trk[0][i], alpha,
+                                    std::array<float, 2>{trk[1][i], trk[2][i]},
+                                    std::array<float, 3>{sigma2[0][i], 0.f, sigma2[1][i]});
+
+        /// Rotate to the global frame
+        addClusterToLayer(layer, glo[0][i], glo[1][i], glo[2][i], mUnsortedClusters[layer].size());
+        addClusterExternalIndexToLayer(layer, firstChipCluster + i);
       }
-      auto sensorID = c.getSensorID();
-      // Inverse transformation to the local --> tracking
-      auto trkXYZ = geom->getMatrixT2L(sensorID) ^ locXYZ;
-      // Transformation to the local --> global
-      auto gloXYZ = geom->getMatrixL2G(sensorID) * locXYZ;
-
-      addTrackingFrameInfoToLayer(layer, gloXYZ.x(), gloXYZ.y(), gloXYZ.z(), trkXYZ.x(), geom->getSensorRefAlpha(sensorID),
-                                  std::array<float, 2>{trkXYZ.y(), trkXYZ.z()},
-                                  std::array<float, 3>{sigmaY2, sigmaYZ, sigmaZ2});
-
-      /// Rotate to the global frame
-      addClusterToLayer(layer, gloXYZ.x(), gloXYZ.y(), gloXYZ.z(), mUnsortedClusters[layer].size());
-      addClusterExternalIndexToLayer(layer, clusterId);
     }
     for (unsigned int iL{0}; iL < mUnsortedClusters.size(); ++iL) {
       // mNClustersPerROF[iL].push_back(mUnsortedClusters[iL].size() - mROframesClusters[iL].back());
@@ -322,6 +361,14 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
         c.radius = h.r;
         c.indexTableBinIndex = h.bin;
       }
+      const int offset{mROframesClusters[iLayer][rof]};
+      for (int iCluster{0}; iCluster < clustersNum; ++iCluster) {
+        const Cluster& c = clusters2beSorted[iCluster];
+        mClustersPhi[iLayer][offset + iCluster] = c.phi;
+        mClustersZ[iLayer][offset + iCluster] = c.zCoordinate;
+        mClustersR[iLayer][offset + iCluster] = c.radius;
+        mClustersId[iLayer][offset + iCluster] = c.clusterId;
+      }
 
       for (unsigned int iB{0}; iB < clsPerBin.size(); ++iB) {
         mIndexTables[iLayer][rof * (trkParam.ZBins * trkParam.PhiBins + 1) + iB] = lutPerBin[iB];
@@ -336,6 +383,7 @@ void TimeFrame::prepareClusters(const TrackingParameters& trkParam, const int ma
 void TimeFrame::initialise(const int iteration, const TrackingParameters& trkParam, const int maxLayers, bool resetVertices)
 {
   if (iteration == 0) {
+    mArena.reset();
     if (maxLayers < trkParam.NLayers && resetVertices) {
       resetRofPV();
       deepVectorClear(mTotVertPerIteration);
@@ -365,6 +413,14 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     for (unsigned int iLayer{0}; iLayer < std::min((int)mClusters.size(), maxLayers); ++iLayer) {
       deepVectorClear(mClusters[iLayer]);
       mClusters[iLayer].resize(mUnsortedClusters[iLayer].size());
+      deepVectorClear(mClustersPhi[iLayer]);
+      mClustersPhi[iLayer].resize(mUnsortedClusters[iLayer].size());
+      deepVectorClear(mClustersZ[iLayer]);
+      mClustersZ[iLayer].resize(mUnsortedClusters[iLayer].size());
+      deepVectorClear(mClustersR[iLayer]);
+      mClustersR[iLayer].resize(mUnsortedClusters[iLayer].size());
+      deepVectorClear(mClustersId[iLayer]);
+      mClustersId[iLayer].resize(mUnsortedClusters[iLayer].size());
       deepVectorClear(mUsedClusters[iLayer]);
       mUsedClusters[iLayer].resize(mUnsortedClusters[iLayer].size(), false);
       mPositionResolution[iLayer] = o2::gpu::CAMath::Sqrt(0.5 * (trkParam.SystErrorZ2[iLayer] + trkParam.SystErrorY2[iLayer]) + trkParam.LayerResolution[iLayer] * trkParam.LayerResolution[iLayer]);
@@ -498,6 +554,10 @@ void TimeFrame::resizeVectors(int nLayers)
   mMinR.resize(nLayers, 10000.);
   mMaxR.resize(nLayers, -1.);
   mClusters.resize(nLayers);
+  mClustersPhi.resize(nLayers);
+  mClustersZ.resize(nLayers);
+  mClustersR.resize(nLayers);
+  mClustersId.resize(nLayers);
   mUnsortedClusters.resize(nLayers);
   mTrackingFrameInfo.resize(nLayers);
   mClusterExternalIndices.resize(nLayers);
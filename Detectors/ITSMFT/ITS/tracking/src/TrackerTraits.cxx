@@ -42,6 +42,15 @@ float Sq(float q)
 {
   return q * q;
 }
+
+int getThreadIndex()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
 } // namespace
 
 namespace o2
@@ -72,125 +81,139 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
   int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? iROFslice * mTrkParams[iteration].nROFsPerIterations : 0};
   int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? (iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF : tf->getNrof()};
-  for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+  // All (ROF, layer) pairs are independent: process them as one dynamically scheduled task list, without a barrier per ROF.
+  // The tracklets are collected per thread, their order does not matter since they are sorted below.
+  const int nLayers{mTrkParams[iteration].TrackletsPerRoad()};
+  const int nTasks{std::max(0, endROF - startROF) * nLayers};
+  ArenaScope scratch{tf->getArena()};
+  ArenaStlAllocator<Tracklet> trackletAllocator{tf->getArena()};
+  ArenaVector<ArenaVector<Tracklet>> threadTracklets(mNThreads * nLayers, ArenaVector<Tracklet>{trackletAllocator}, ArenaStlAllocator<ArenaVector<Tracklet>>{tf->getArena()});
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+  for (int iTask = 0; iTask < nTasks; ++iTask) {
+    const int rof0{startROF + iTask / nLayers};
+    const int iLayer{iTask % nLayers};
+    auto& tracklets{threadTracklets[getThreadIndex() * nLayers + iLayer]};
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     const int startVtx{iVertex >= 0 ? iVertex : 0};
     const int endVtx{iVertex >= 0 ? std::min(iVertex + 1, static_cast<int>(primaryVertices.size())) : static_cast<int>(primaryVertices.size())};
     int minRof = std::max(startROF, rof0 - mTrkParams[iteration].DeltaROF);
     int maxRof = std::min(endROF - 1, rof0 + mTrkParams[iteration].DeltaROF);
-#pragma omp parallel for num_threads(mNThreads)
-    for (int iLayer = 0; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
-      gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
-      if (layer0.empty()) {
+    gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
+    if (layer0.empty()) {
+      continue;
+    }
+    float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+
+    const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+      const Cluster& currentCluster{layer0[iCluster]};
+      const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+
+      if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
         continue;
       }
-      float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+      const float inverseR0{1.f / currentCluster.radius};
 
-      const int currentLayerClustersNum{static_cast<int>(layer0.size())};
-      for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-        const Cluster& currentCluster{layer0[iCluster]};
-        const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
-
-        if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
+      for (int iV{startVtx}; iV < endVtx; ++iV) {
+        auto& primaryVertex{primaryVertices[iV]};
+        if (primaryVertex.isFlagSet(1) && iteration != 3) {
           continue;
         }
-        const float inverseR0{1.f / currentCluster.radius};
+        const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
 
-        for (int iV{startVtx}; iV < endVtx; ++iV) {
-          auto& primaryVertex{primaryVertices[iV]};
-          if (primaryVertex.isFlagSet(1) && iteration != 3) {
-            continue;
-          }
-          const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
+        const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
 
-          const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
+        const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
 
-          const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
-          const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
+        const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
 
-          const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
-          const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
+        const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
+                                                sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
+        if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+          continue;
+        }
 
-          const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                                  sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
-          if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-            continue;
-          }
+        int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-          int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+        if (phiBinsNum < 0) {
+          phiBinsNum += mTrkParams[iteration].PhiBins;
+        }
 
-          if (phiBinsNum < 0) {
-            phiBinsNum += mTrkParams[iteration].PhiBins;
+        for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
+          gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
+          if (layer1.empty()) {
+            continue;
           }
-
-          for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
-            gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
-            if (layer1.empty()) {
-              continue;
-            }
-
-            for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
-              int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
-              const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-              const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-              if constexpr (debugLevel) {
-                if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
-                    maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
-                  std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
-                  std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
-                  std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
-                  std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
-                  exit(1);
-                }
+          // The candidate selection only reads the structure-of-arrays copy, the full cluster is only accessed for accepted pairs
+          const float* phi1{tf->getClustersPhiOnLayer(rof1, iLayer + 1).data()};
+          const float* z1{tf->getClustersZOnLayer(rof1, iLayer + 1).data()};
+          const float* r1{tf->getClustersROnLayer(rof1, iLayer + 1).data()};
+          const int* id1{tf->getClustersIdOnLayer(rof1, iLayer + 1).data()};
+
+          for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
+            int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
+            const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+            const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+            if constexpr (debugLevel) {
+              if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
+                  maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
+                std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
+                std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
+                std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
+                std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
+                exit(1);
               }
-              const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
+            }
+            const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
+            const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
 
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+            for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
 
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
-                }
+              if (iNextCluster >= (int)layer1.size()) {
+                break;
+              }
 
-                const Cluster& nextCluster{layer1[iNextCluster]};
-                if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-                  continue;
-                }
+              if (tf->isClusterUsed(iLayer + 1, id1[iNextCluster])) {
+                continue;
+              }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
+              const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - phi1[iNextCluster])};
+              const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (r1[iNextCluster] - currentCluster.radius) +
+                                                         currentCluster.zCoordinate - z1[iNextCluster])};
 
 #ifdef OPTIMISATION_OUTPUT
-                MCCompLabel label;
-                int currentId{currentCluster.clusterId};
-                int nextId{nextCluster.clusterId};
-                for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
-                  for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
-                    if (lab1 == lab2 && lab1.isValid()) {
-                      label = lab1;
-                      break;
-                    }
-                  }
-                  if (label.isValid()) {
+              const Cluster& nextCluster{layer1[iNextCluster]};
+              MCCompLabel label;
+              int currentId{currentCluster.clusterId};
+              int nextId{nextCluster.clusterId};
+              for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
+                for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
+                  if (lab1 == lab2 && lab1.isValid()) {
+                    label = lab1;
                     break;
                   }
                 }
-                off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
+                if (label.isValid()) {
+                  break;
+                }
+              }
+              off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
-                  if (iLayer > 0) {
-                    tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
-                  }
-                  const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
-                                                                currentCluster.xCoordinate - nextCluster.xCoordinate)};
-                  const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
-                                   (currentCluster.radius - nextCluster.radius)};
-                  tf->getTracklets()[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+              if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
+                  (deltaPhi < tf->getPhiCut(iLayer) ||
+                   gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
                 }
+                const Cluster& nextCluster{layer1[iNextCluster]};
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                tracklets.emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
               }
             }
           }
@@ -198,10 +221,21 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
       }
     }
   }
+  for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+    for (int iThread = 0; iThread < mNThreads; ++iThread) {
+      const auto& tracklets{threadTracklets[iThread * nLayers + iLayer]};
+      tf->getTracklets()[iLayer].insert(tf->getTracklets()[iLayer].end(), tracklets.begin(), tracklets.end());
+    }
+  }
   if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
     return;
   }
+  finaliseLayerTracklets(iteration);
+}
 
+void TrackerTraits::finaliseLayerTracklets(const int iteration)
+{
+  TimeFrame* tf = mTimeFrame;
 #pragma omp parallel for num_threads(mNThreads)
   for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
     /// Sort tracklets
@@ -209,21 +243,20 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
     std::sort(trkl.begin(), trkl.end(), [](const Tracklet& a, const Tracklet& b) {
       return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
     });
-    /// Remove duplicates
+    /// Remove duplicates, in place
     auto& lut{tf->getTrackletsLookupTable()[iLayer]};
     int id0{-1}, id1{-1};
-    std::vector<Tracklet> newTrk;
-    newTrk.reserve(trkl.size());
-    for (auto& trk : trkl) {
-      if (trk.firstClusterIndex == id0 && trk.secondClusterIndex == id1) {
+    size_t nUnique{0};
+    for (size_t iTrk{0}; iTrk < trkl.size(); ++iTrk) {
+      if (trkl[iTrk].firstClusterIndex == id0 && trkl[iTrk].secondClusterIndex == id1) {
         lut[id0]--;
       } else {
-        id0 = trk.firstClusterIndex;
-        id1 = trk.secondClusterIndex;
-        newTrk.push_back(trk);
+        id0 = trkl[iTrk].firstClusterIndex;
+        id1 = trkl[iTrk].secondClusterIndex;
+        trkl[nUnique++] = trkl[iTrk];
       }
     }
-    trkl.swap(newTrk);
+    trkl.resize(nUnique);
 
     /// Compute LUT
     std::exclusive_scan(lut.begin(), lut.end(), lut.begin(), 0);
@@ -233,17 +266,11 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
   std::sort(tf->getTracklets()[0].begin(), tf->getTracklets()[0].end(), [](const Tracklet& a, const Tracklet& b) {
     return a.firstClusterIndex < b.firstClusterIndex || (a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex < b.secondClusterIndex);
   });
-  int id0{-1}, id1{-1};
-  std::vector<Tracklet> newTrk;
-  newTrk.reserve(tf->getTracklets()[0].size());
-  for (auto& trk : tf->getTracklets()[0]) {
-    if (trk.firstClusterIndex != id0 || trk.secondClusterIndex != id1) {
-      id0 = trk.firstClusterIndex;
-      id1 = trk.secondClusterIndex;
-      newTrk.push_back(trk);
-    }
-  }
-  tf->getTracklets()[0].swap(newTrk);
+  auto& trkl0{tf->getTracklets()[0]};
+  trkl0.erase(std::unique(trkl0.begin(), trkl0.end(), [](const Tracklet& a, const Tracklet& b) {
+                return a.firstClusterIndex == b.firstClusterIndex && a.secondClusterIndex == b.secondClusterIndex;
+              }),
+              trkl0.end());
 
   /// Create tracklets labels
   if (tf->hasMCinformation()) {
@@ -285,20 +312,32 @@ void TrackerTraits::computeLayerCells(const int iteration)
   }
 
   TimeFrame* tf = mTimeFrame;
-#pragma omp parallel for num_threads(mNThreads)
-  for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-
-    if (tf->getTracklets()[iLayer + 1].empty() ||
-        tf->getTracklets()[iLayer].empty()) {
-      continue;
-    }
+  // The tracklets of all layers are split into chunks processed as independent tasks, so that the threads do not depend on the number of layers.
+  // The cells of the chunks are concatenated in chunk order afterwards, which gives the same cell order as a sequential loop.
+  constexpr int trackletsPerChunk{256};
+  const int nLayers{mTrkParams[iteration].CellsPerRoad()};
+  ArenaScope scratch{tf->getArena()};
+  ArenaVector<int> firstChunk(nLayers + 1, 0, ArenaStlAllocator<int>{tf->getArena()});
+  ArenaVector<ArenaVector<int>> nCellsPerTracklet(nLayers, ArenaVector<int>{ArenaStlAllocator<int>{tf->getArena()}}, ArenaStlAllocator<ArenaVector<int>>{tf->getArena()});
+  for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+    const bool skip{tf->getTracklets()[iLayer + 1].empty() || tf->getTracklets()[iLayer].empty()};
+    const int nTracklets{skip ? 0 : static_cast<int>(tf->getTracklets()[iLayer].size())};
+    firstChunk[iLayer + 1] = firstChunk[iLayer] + (nTracklets + trackletsPerChunk - 1) / trackletsPerChunk;
+    nCellsPerTracklet[iLayer].resize(nTracklets, 0);
+  }
+  ArenaVector<ArenaVector<CellSeed>> chunkCells(firstChunk[nLayers], ArenaVector<CellSeed>{ArenaStlAllocator<CellSeed>{tf->getArena()}}, ArenaStlAllocator<ArenaVector<CellSeed>>{tf->getArena()});
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
+  for (int iChunk = 0; iChunk < firstChunk[nLayers]; ++iChunk) {
+    const int iLayer{static_cast<int>(std::upper_bound(firstChunk.begin(), firstChunk.end(), iChunk) - firstChunk.begin()) - 1};
+    auto& cells{chunkCells[iChunk]};
 
 #ifdef OPTIMISATION_OUTPUT
     float resolution{o2::gpu::CAMath::Sqrt(0.5f * (mTrkParams[iteration].SystErrorZ2[iLayer] + mTrkParams[iteration].SystErrorZ2[iLayer + 1] + mTrkParams[iteration].SystErrorZ2[iLayer + 2] + mTrkParams[iteration].SystErrorY2[iLayer] + mTrkParams[iteration].SystErrorY2[iLayer + 1] + mTrkParams[iteration].SystErrorY2[iLayer + 2])) / mTrkParams[iteration].LayerResolution[iLayer]};
     resolution = resolution > 1.e-12 ? resolution : 1.f;
 #endif
-    const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+    const int firstTracklet{(iChunk - firstChunk[iLayer]) * trackletsPerChunk};
+    const int lastTracklet{std::min(firstTracklet + trackletsPerChunk, static_cast<int>(tf->getTracklets()[iLayer].size()))};
+    for (int iTracklet{firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
 
       const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
       const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
@@ -368,16 +407,22 @@ void TrackerTraits::computeLayerCells(const int iteration)
           if (!good) {
             continue;
           }
-          if (iLayer > 0 && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
-            tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, tf->getCells()[iLayer].size());
-          }
-          tf->getCells()[iLayer].emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
-                                              iTracklet, iNextTracklet, track, chi2);
+          nCellsPerTracklet[iLayer][iTracklet]++;
+          cells.emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
+                             iTracklet, iNextTracklet, track, chi2);
         }
       }
     }
-    if (iLayer > 0) {
-      tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, tf->getCells()[iLayer].size());
+  }
+  for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+    for (int iChunk{firstChunk[iLayer]}; iChunk < firstChunk[iLayer + 1]; ++iChunk) {
+      tf->getCells()[iLayer].insert(tf->getCells()[iLayer].end(), chunkCells[iChunk].begin(), chunkCells[iChunk].end());
+    }
+    if (iLayer > 0 && firstChunk[iLayer + 1] > firstChunk[iLayer]) {
+      auto& lut{tf->getCellsLookupTable()[iLayer - 1]};
+      lut.resize(nCellsPerTracklet[iLayer].size() + 1);
+      std::exclusive_scan(nCellsPerTracklet[iLayer].begin(), nCellsPerTracklet[iLayer].end(), lut.begin(), 0);
+      lut.back() = tf->getCells()[iLayer].size();
     }
   }
   if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
@@ -418,7 +463,8 @@ void TrackerTraits::findCellsNeighbours(const int iteration)
     }
 
     int layerCellsNum{static_cast<int>(mTimeFrame->getCells()[iLayer].size())};
-    std::vector<std::pair<int, int>> cellsNeighbours;
+    ArenaScope scratch{mTimeFrame->getArena()};
+    ArenaVector<std::pair<int, int>> cellsNeighbours{ArenaStlAllocator<std::pair<int, int>>{mTimeFrame->getArena()}};
     cellsNeighbours.reserve(nextLayerCellsNum);
 
     for (int iCell{0}; iCell < layerCellsNum; ++iCell) {
@@ -48,6 +48,10 @@ float Vertexer::clustersToVertices(std::function<void(std::string s)> logger)
     trkPars.PhiBins = mTraits->getVertexingParameters()[0].PhiBins;
     trkPars.ZBins = mTraits->getVertexingParameters()[0].ZBins;
     total += evaluateTask(&Vertexer::initialiseVertexer, "Vertexer initialisation", logger, trkPars, iteration);
+    if (mVertParams[0].nROFsPerWindow > 0 && !mTraits->getIsGPU()) {
+      total += evaluateTask(&Vertexer::findVerticesInWindows, "Vertexer windowed vertex finding", logger, iteration);
+      continue;
+    }
     total += evaluateTask(&Vertexer::findTracklets, "Vertexer tracklet finding", logger, iteration);
     total += evaluateTask(&Vertexer::validateTracklets, "Vertexer adjacent tracklets validation", logger, iteration);
     total += evaluateTask(&Vertexer::findVertices, "Vertexer vertex finding", logger, iteration);
@@ -94,6 +98,7 @@ void Vertexer::getGlobalConfiguration()
   mVertParams[0].clusterContributorsCut = vc.clusterContributorsCut;
   mVertParams[0].maxTrackletsPerCluster = vc.maxTrackletsPerCluster;
   mVertParams[0].phiSpan = vc.phiSpan;
+  mVertParams[0].nROFsPerWindow = vc.nROFsPerWindow;
   mVertParams[0].nThreads = vc.nThreads;
   mVertParams[0].ZBins = vc.ZBins;
   mVertParams[0].PhiBins = vc.PhiBins;
@@ -111,12 +111,13 @@ void trackletSelectionKernelHost(
   std::vector<Line>& destTracklets,
   const gsl::span<const MCCompLabel>& trackletLabels,
   std::vector<MCCompLabel>& linesLabels,
+  ArenaAllocator& arena,
   const float tanLambdaCut = 0.025f,
   const float phiCut = 0.005f,
   const int maxTracklets = static_cast<int>(1e2))
 {
   int offset01{0}, offset12{0};
-  std::vector<bool> usedTracklets(tracklets01.size(), false);
+  ArenaVector<bool> usedTracklets(tracklets01.size(), false, ArenaStlAllocator<bool>{arena});
   for (unsigned int iCurrentLayerClusterIndex{0}; iCurrentLayerClusterIndex < clusters1.size(); ++iCurrentLayerClusterIndex) {
     int validTracklets{0};
     for (int iTracklet12{offset12}; iTracklet12 < offset12 + foundTracklets12[iCurrentLayerClusterIndex]; ++iTracklet12) {
@@ -172,10 +173,15 @@ void VertexerTraits::updateVertexingParameters(const std::vector<VertexingParame
 // Main functions
 void VertexerTraits::computeTracklets(const int iteration)
 {
+  const int rofEnd{getROFWindowEnd()};
+  // the ROFs outside of the window must not contribute to the tracklets offsets
+  for (int rofId{0}; rofId <= mTimeFrame->getNrof(); ++rofId) {
+    mTimeFrame->getNTrackletsROf(rofId, 0) = mTimeFrame->getNTrackletsROf(rofId, 1) = 0;
+  }
 #pragma omp parallel num_threads(mNThreads)
   {
 #pragma omp for schedule(dynamic)
-    for (int rofId = 0; rofId < mTimeFrame->getNrof(); ++rofId) {
+    for (int rofId = mROFWindow[0]; rofId < rofEnd; ++rofId) {
       bool skipROF = iteration && (int)mTimeFrame->getPrimaryVertices(rofId).size() > mVrtParams[iteration].vertPerRofThreshold;
       trackleterKernelHost<TrackletMode::Layer0Layer1, true>(
         !skipROF ? mTimeFrame->getClustersOnLayer(rofId, 0) : gsl::span<Cluster>(),
@@ -210,7 +216,7 @@ void VertexerTraits::computeTracklets(const int iteration)
     mTimeFrame->getTracklets()[1].resize(mTimeFrame->getTotalTrackletsTF(1));
 
 #pragma omp for schedule(dynamic)
-    for (int rofId = 0; rofId < mTimeFrame->getNrof(); ++rofId) {
+    for (int rofId = mROFWindow[0]; rofId < rofEnd; ++rofId) {
       bool skipROF = iteration && (int)mTimeFrame->getPrimaryVertices(rofId).size() > mVrtParams[iteration].vertPerRofThreshold;
       trackleterKernelHost<TrackletMode::Layer0Layer1, false>(
         !skipROF ? mTimeFrame->getClustersOnLayer(rofId, 0) : gsl::span<Cluster>(),
@@ -239,6 +245,7 @@ void VertexerTraits::computeTracklets(const int iteration)
 
   /// Create tracklets labels for L0-L1, information is as flat as in tracklets vector (no rofId)
   if (mTimeFrame->hasMCinformation()) {
+    mTimeFrame->getTrackletsLabel(0).clear();
     for (auto& trk : mTimeFrame->getTracklets()[0]) {
       MCCompLabel label;
       int sortedId0{mTimeFrame->getSortedIndex(trk.rof[0], 0, trk.firstClusterIndex)};
@@ -298,8 +305,10 @@ void VertexerTraits::computeTracklets(const int iteration)
 
 void VertexerTraits::computeTrackletMatching(const int iteration)
 {
+  const int rofEnd{getROFWindowEnd()};
+  ArenaScope scratch{mTimeFrame->getArena()};
 #pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
-  for (int rofId = 0; rofId < mTimeFrame->getNrof(); ++rofId) {
+  for (int rofId = mROFWindow[0]; rofId < rofEnd; ++rofId) {
     if (iteration && (int)mTimeFrame->getPrimaryVertices(rofId).size() > mVrtParams[iteration].vertPerRofThreshold) {
       continue;
     }
@@ -314,6 +323,7 @@ void VertexerTraits::computeTrackletMatching(const int iteration)
       mTimeFrame->getLines(rofId),
       mTimeFrame->getLabelsFoundTracklets(rofId, 0),
       mTimeFrame->getLinesLabel(rofId),
+      mTimeFrame->getArena(),
       mVrtParams[iteration].tanLambdaCut,
       mVrtParams[iteration].phiCut);
   }
@@ -357,14 +367,17 @@ void VertexerTraits::computeVertices(const int iteration)
 #ifdef VTX_DEBUG
   std::vector<std::vector<ClusterLines>> dbg_clusLines(mTimeFrame->getNrof());
 #endif
-  std::vector<int> noClustersVec(mTimeFrame->getNrof(), 0);
-  for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
+  ArenaScope scratch{mTimeFrame->getArena()};
+  ArenaVector<int> noClustersVec(mTimeFrame->getNrof(), 0, ArenaStlAllocator<int>{mTimeFrame->getArena()});
+  const int rofEnd{getROFWindowEnd()};
+  for (int rofId{mROFWindow[0]}; rofId < rofEnd; ++rofId) {
     if (iteration && (int)mTimeFrame->getPrimaryVertices(rofId).size() > mVrtParams[iteration].vertPerRofThreshold) {
       continue;
     }
     const int numTracklets{static_cast<int>(mTimeFrame->getLines(rofId).size())};
 
-    std::vector<bool> usedTracklets(numTracklets, false);
+    ArenaScope rofScratch{mTimeFrame->getArena()};
+    ArenaVector<bool> usedTracklets(numTracklets, false, ArenaStlAllocator<bool>{mTimeFrame->getArena()});
     for (int line1{0}; line1 < numTracklets; ++line1) {
       if (usedTracklets[line1]) {
         continue;
@@ -435,8 +448,9 @@ void VertexerTraits::computeVertices(const int iteration)
       }
     }
   }
-  for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
+  for (int rofId{mROFWindow[0]}; rofId < rofEnd; ++rofId) {
     vertices.clear();
+    polls.clear();
     std::sort(mTimeFrame->getTrackletClusters(rofId).begin(), mTimeFrame->getTrackletClusters(rofId).end(),
               [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); }); // ensure clusters are ordered by contributors, so that we can cat after the first.
 #ifdef VTX_DEBUG
@@ -519,6 +533,28 @@ void VertexerTraits::computeVertices(const int iteration)
 #endif
 }
 
+void VertexerTraits::computeVerticesInWindows(const int iteration)
+{
+  // process the timeframe in consecutive windows of ROFs, the per-ROF buffers of a window are released as soon as
+  // its vertices are found, so that the memory needed by the tracklets and lines is bound by the window size
+  const int nRofs{mTimeFrame->getNrof()}, step{std::max(1, mVrtParams[0].nROFsPerWindow)};
+  for (int firstRof{0}; firstRof < nRofs; firstRof += step) {
+    setROFWindow(firstRof, std::min(firstRof + step, nRofs));
+    computeTracklets(iteration);
+    computeTrackletMatching(iteration);
+    computeVertices(iteration);
+    for (int rofId{firstRof}; rofId < mROFWindow[1]; ++rofId) {
+      std::vector<Line>().swap(mTimeFrame->getLines(rofId));
+      std::vector<ClusterLines>().swap(mTimeFrame->getTrackletClusters(rofId));
+      std::vector<MCCompLabel>().swap(mTimeFrame->getLinesLabel(rofId));
+    }
+  }
+  for (int iLayer{0}; iLayer < 2; ++iLayer) {
+    std::vector<Tracklet>().swap(mTimeFrame->getTracklets()[iLayer]);
+  }
+  setROFWindow(0, -1);
+}
+
 void VertexerTraits::setNThreads(int n)
 {
 #ifdef WITH_OPENMP
@@ -145,8 +145,36 @@ class ITSThresholdCalibrator : public Task
   // The x-axis of the correct data fit chosen above
   float* mX = nullptr;
 
+  // Hit counters of the pixels of one row, N_COL x N_RANGE2 x N_RANGE in a single array.
+  // Indexed as [col][iloop2][iloop1] like nested vectors, without their allocations.
+  struct RowHits {
+    // the counters of one pixel, indexed as [iloop2][iloop1]
+    struct Pixel {
+      unsigned short int* counts = nullptr;
+      short int n1 = 0;
+      unsigned short int* operator[](int i2) const { return counts + i2 * n1; }
+    };
+
+    RowHits() = default;
+    RowHits(short int ncol, short int n2, short int n1) : mCounts(ncol * n2 * n1, 0), mN2(n2), mN1(n1) {}
+    Pixel operator[](int col) { return {mCounts.data() + col * mN2 * mN1, mN1}; }
+
+   private:
+    std::vector<unsigned short int> mCounts;
+    short int mN2 = 0;
+    short int mN1 = 0;
+  };
+
+  // Result of the threshold extraction of one pixel
+  struct PixelFit {
+    float thresh = 0.;
+    float noise = 0.;
+    int spoints = 0;
+    bool success = false;
+  };
+
   // Hash tables to store the hit and threshold information per pixel
-  std::map<short int, std::map<int, std::vector<std::vector<std::vector<unsigned short int>>>>> mPixelHits;
+  std::map<short int, std::map<int, RowHits>> mPixelHits;
   std::map<short int, std::deque<short int>> mForbiddenRows;
   // Unordered map for saving sum of values (thr/ithr/vcasn) for avg calculation
   std::map<short int, std::array<long int, 6>> mThresholds;
@@ -180,23 +208,32 @@ class ITSThresholdCalibrator : public Task
   TH1F* mFitHist = nullptr;
   TF1* mFitFunction = nullptr;
 
+  // Use the closed-form erf fit rather than TF1, which is not thread safe
+  bool mFitLUT = false;
+  // Inverse of the erf model (probit) and weight of the points with k = 0...nInjScaled hits
+  std::vector<float> mProbitLUT;
+  std::vector<float> mProbitWeightLUT;
+
   // Some private helper functions
   // Helper functions related to the running over data
-  void extractAndUpdate(const short int&, const short int&);
+  void extractAndUpdate(const short int&, const short int&, const PixelFit* fits = nullptr);
   std::vector<float> calculatePulseParams(const short int&);
   std::vector<float> calculatePulseParams2D(const short int&);
-  void extractThresholdRow(const short int&, const short int&);
+  void extractThresholdRow(const short int&, const short int&, const PixelFit* fits = nullptr);
+  void fitRow(const short int&, const short int&, int, PixelFit*);
+  void fitRows(const std::vector<std::pair<short int, short int>>&, std::vector<std::vector<PixelFit>>&);
   void finalizeOutput();
 
   void setRunType(const short int&);
 
   // Helper functions related to threshold extraction
   void initThresholdTree(bool recreate = true);
-  bool findUpperLower(std::vector<std::vector<unsigned short int>>, const short int&, short int&, short int&, bool, int);
-  bool findThreshold(const short int&, std::vector<std::vector<unsigned short int>>, const float*, short int&, float&, float&, int&, int);
-  bool findThresholdFit(const short int&, std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdDerivative(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdHitcounting(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, int);
+  bool findUpperLower(RowHits::Pixel, const short int&, short int&, short int&, bool, int);
+  bool findThreshold(const short int&, RowHits::Pixel, const float*, short int&, float&, float&, int&, int);
+  bool findThresholdFit(const short int&, RowHits::Pixel, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdFitLUT(RowHits::Pixel, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdDerivative(RowHits::Pixel, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdHitcounting(RowHits::Pixel, const float*, const short int&, float&, int);
   void findAverage(const std::array<long int, 6>&, float&, float&, float&, float&);
   void saveThreshold();
 
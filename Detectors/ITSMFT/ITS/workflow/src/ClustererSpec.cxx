@@ -128,6 +128,7 @@ void ClustererDPL::updateTimeDependentParams(ProcessingContext& pc)
     nbc += mClusterer->isContinuousReadOut() ? alpParams.roFrameLengthInBC : (alpParams.roFrameLengthTrig / o2::constants::lhc::LHCBunchSpacingNS);
     mClusterer->setMaxBCSeparationToMask(nbc);
     mClusterer->setMaxRowColDiffToMask(clParams.maxRowColDiffToMask);
+    mClusterer->setBitMapLabeling(clParams.useBitMapLabeling);
     // Squasher
     int rofBC = mClusterer->isContinuousReadOut() ? alpParams.roFrameLengthInBC : (alpParams.roFrameLengthTrig / o2::constants::lhc::LHCBunchSpacingNS); // ROF length in BC
     mClusterer->setMaxBCSeparationToSquash(rofBC + clParams.maxBCDiffToSquashBias);
@@ -121,9 +121,11 @@ void ITSThresholdCalibrator::init(InitContext& ic)
   // Get number of threads
   this->mNThreads = ic.options().get<int>("nthreads");
 
-  // Check fit type vs nthreads (fit option is not thread safe!)
-  if (mFitType == FIT && mNThreads > 1) {
-    throw std::runtime_error("Multiple threads are requested with fit method which is not thread safe");
+  // The TF1 fit is not thread safe, with multiple threads the closed-form fit is used
+  this->mFitLUT = ic.options().get<bool>("fit-lut");
+  if (mFitType == FIT && mNThreads > 1 && !mFitLUT) {
+    LOG(info) << "Multiple threads are requested with fit method: using the closed-form erf fit";
+    this->mFitLUT = true;
   }
 
   // Machine hostname
@@ -215,6 +217,9 @@ void ITSThresholdCalibrator::init(InitContext& ic)
   if (isDumpS && mFitType != FIT) {
     LOG(error) << "S-curve dump enabled but `fittype` is not fit. Please check";
   }
+  if (isDumpS && (mNThreads > 1 || mFitLUT)) {
+    throw std::runtime_error("S-curve dump requires the TF1 fit method, which is not thread safe: use nthreads 1 and no fit-lut");
+  }
   if (isDumpS) {
     fileDumpS = TFile::Open(Form("s-curves_%d.root", mChipModSel), "RECREATE"); // in case of multiple processes, every process will have it's own file
     if (maxDumpS < 0) {
@@ -412,7 +417,7 @@ void ITSThresholdCalibrator::initThresholdTree(bool recreate /*=true*/)
 // x is the array of charge injected values;
 // NPoints is the length of both arrays.
 bool ITSThresholdCalibrator::findUpperLower(
-  std::vector<std::vector<unsigned short int>> data, const short int& NPoints,
+  RowHits::Pixel data, const short int& NPoints,
   short int& lower, short int& upper, bool flip, int iloop2)
 {
   // Initialize (or re-initialize) upper and lower
@@ -472,7 +477,7 @@ bool ITSThresholdCalibrator::findUpperLower(
 //////////////////////////////////////////////////////////////////////////////
 // Main findThreshold function which calls one of the three methods
 bool ITSThresholdCalibrator::findThreshold(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, short int& NPoints,
+  const short int& chipID, RowHits::Pixel data, const float* x, short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   bool success = false;
@@ -483,7 +488,8 @@ bool ITSThresholdCalibrator::findThreshold(
       break;
 
     case FIT: // Fit method
-      success = this->findThresholdFit(chipID, data, x, NPoints, thresh, noise, spoints, iloop2);
+      success = mFitLUT ? this->findThresholdFitLUT(data, x, NPoints, thresh, noise, spoints, iloop2)
+                        : this->findThresholdFit(chipID, data, x, NPoints, thresh, noise, spoints, iloop2);
       break;
 
     case HITCOUNTING: // Hit-counting method
@@ -504,7 +510,7 @@ bool ITSThresholdCalibrator::findThreshold(
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdFit(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+  const short int& chipID, RowHits::Pixel data, const float* x, const short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -568,6 +574,68 @@ bool ITSThresholdCalibrator::findThresholdFit(
   return (chi2 < 5);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Closed-form alternative to the erf fit, thread safe.
+// Through the inverse of the erf model (probit) the hit fraction k / nInj of the
+// points in the S region becomes linear in x: z(k) = (x - thresh) / noise, with
+// opposite sign for ITHR. The line is fitted by weighted least squares, with z and
+// the binomial weights of each k from a LUT.
+// Parameters and return value as in findThresholdFit, the chi2 uses binomial errors.
+bool ITSThresholdCalibrator::findThresholdFitLUT(
+  RowHits::Pixel data, const float* x, const short int& NPoints,
+  float& thresh, float& noise, int& spoints, int iloop2)
+{
+  short int lower, upper;
+  bool flip = (this->mScanType == 'I');
+  if (!this->findUpperLower(data, NPoints, lower, upper, flip, iloop2) || lower == upper) {
+    if (this->mVerboseOutput) {
+      LOG(warning) << "Start-finding unsuccessful: (lower, upper) = (" << lower << ", " << upper << ")";
+    }
+    return false;
+  }
+  auto hits = [&](int i) -> int { return mScanType != 'r' ? data[iloop2][i] : data[i][iloop2]; };
+
+  double sw = 0., swx = 0., swz = 0., swxx = 0., swxz = 0.;
+  int npoints = 0;
+  for (int i = std::min(lower, upper) + 1; i < std::max(lower, upper); i++) {
+    int k = hits(i);
+    if (k <= 0 || k >= nInjScaled) {
+      continue;
+    }
+    double w = mProbitWeightLUT[k], z = mProbitLUT[k];
+    sw += w;
+    swx += w * x[i];
+    swz += w * z;
+    swxx += w * x[i] * x[i];
+    swxz += w * x[i] * z;
+    npoints++;
+  }
+  if (npoints < 2) { // too steep for a fit, the derivative method gives the step position
+    return this->findThresholdDerivative(data, x, NPoints, thresh, noise, spoints, iloop2);
+  }
+  double det = sw * swxx - swx * swx;
+  double slope = det != 0. ? (sw * swxz - swx * swz) / det : 0.;
+  if ((flip ? -slope : slope) <= 0.) {
+    return false;
+  }
+  thresh = -(swz - slope * swx) / sw / slope;
+  noise = 1. / std::abs(slope);
+  spoints = std::abs(upper - lower) - 1;
+
+  // goodness of the fit over the S region including the two end points
+  double chi2 = 0.;
+  int ndf = -2;
+  for (int i = std::min(lower, upper); i <= std::max(lower, upper); i++) {
+    double t = (x[i] - thresh) / (std::sqrt(2.) * noise);
+    double p = 0.5 * (1. + std::erf(flip ? -t : t));
+    double expected = nInjScaled * p;
+    double var = std::max(expected * (1. - p), 1.);
+    chi2 += (hits(i) - expected) * (hits(i) - expected) / var;
+    ndf++;
+  }
+  return ndf <= 0 || chi2 / ndf < 5;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Use ROOT to find the threshold and noise via derivative method
 // data is the number of trigger counts per charge injected;
@@ -575,7 +643,7 @@ bool ITSThresholdCalibrator::findThresholdFit(
 // NPoints is the length of both arrays.
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
-bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+bool ITSThresholdCalibrator::findThresholdDerivative(RowHits::Pixel data, const float* x, const short int& NPoints,
                                                      float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -621,7 +689,7 @@ bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<uns
 // NPoints is the length of both arrays.
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdHitcounting(
-  std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints, float& thresh, int iloop2)
+  RowHits::Pixel data, const float* x, const short int& NPoints, float& thresh, int iloop2)
 {
   unsigned short int numberOfHits = 0;
   bool is50 = false;
@@ -655,9 +723,62 @@ bool ITSThresholdCalibrator::findThresholdHitcounting(
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Extract the thresholds of all the pixels of a row for the scan point scan_i
+void ITSThresholdCalibrator::fitRow(const short int& chipID, const short int& row, int scan_i, PixelFit* fits)
+{
+  auto& rowHits = mPixelHits[chipID][row];
+  // the TF1 fit and the s-curve dump are not thread safe
+  bool parallel = mNThreads > 1 && !isDumpS && (mFitType != FIT || mFitLUT);
+#ifdef WITH_OPENMP
+  omp_set_num_threads(mNThreads);
+#pragma omp parallel for schedule(dynamic) if (parallel)
+#endif
+  // Loop over all columns (pixels) in the row
+  for (short int col_i = 0; col_i < this->N_COL; col_i++) {
+    auto& fit = fits[col_i];
+    if (isDumpS) {
+      mFitHist->SetName(Form("scurve_chip%d_row%d_col%d_scani%d", chipID, row, col_i, scan_i));
+    }
+    fit.success = this->findThreshold(chipID, rowHits[col_i], this->mX, mScanType == 'r' ? N_RANGE2 : N_RANGE,
+                                      fit.thresh, fit.noise, fit.spoints, scan_i);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Extract the thresholds of the pixels of several completed rows at the first
+// scan point, in parallel over the rows (i.e. chips) and their pixels
+void ITSThresholdCalibrator::fitRows(const std::vector<std::pair<short int, short int>>& rows, std::vector<std::vector<PixelFit>>& fits)
+{
+  fits.resize(rows.size());
+  std::vector<RowHits*> rowHits;
+  for (size_t i = 0; i < rows.size(); i++) {
+    fits[i].assign(N_COL, PixelFit{});
+    rowHits.push_back(&mPixelHits[rows[i].first][rows[i].second]); // no map insertion in the parallel loop
+  }
+  bool parallel = mNThreads > 1 && !isDumpS && (mFitType != FIT || mFitLUT);
+  int nPixels = rows.size() * N_COL;
+#ifdef WITH_OPENMP
+  omp_set_num_threads(mNThreads);
+#pragma omp parallel for schedule(dynamic, 64) if (parallel)
+#endif
+  for (int ipix = 0; ipix < nPixels; ipix++) {
+    int irow = ipix / N_COL;
+    short int col_i = ipix % N_COL;
+    short int chipID = rows[irow].first;
+    auto& fit = fits[irow][col_i];
+    if (isDumpS) {
+      mFitHist->SetName(Form("scurve_chip%d_row%d_col%d_scani%d", chipID, rows[irow].second, col_i, 0));
+    }
+    fit.success = this->findThreshold(chipID, (*rowHits[irow])[col_i], this->mX, mScanType == 'r' ? N_RANGE2 : N_RANGE,
+                                      fit.thresh, fit.noise, fit.spoints, 0);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Run threshold extraction on completed row and update memory
-void ITSThresholdCalibrator::extractThresholdRow(const short int& chipID, const short int& row)
+// fits: thresholds of the row at the first scan point if already extracted
+void ITSThresholdCalibrator::extractThresholdRow(const short int& chipID, const short int& row, const PixelFit* fits)
 {
   if (this->mScanType == 'D' || this->mScanType == 'A') {
     // Loop over all columns (pixels) in the row
@@ -742,32 +863,24 @@ void ITSThresholdCalibrator::extractThresholdRow(const short int& chipID, const
 
   } else { // threshold, vcasn, ithr
 
+    std::vector<PixelFit> rowFits;
     for (int scan_i = 0; scan_i < ((mScanType == 'r') ? N_RANGE : N_RANGE2); scan_i++) {
 
-#ifdef WITH_OPENMP
-      omp_set_num_threads(mNThreads);
-#pragma omp parallel for schedule(dynamic)
-#endif
+      const PixelFit* scanFits = fits;
+      if (!fits || scan_i > 0) {
+        rowFits.assign(N_COL, PixelFit{});
+        this->fitRow(chipID, row, scan_i, rowFits.data());
+        scanFits = rowFits.data();
+      }
       // Loop over all columns (pixels) in the row
       for (short int col_i = 0; col_i < this->N_COL; col_i++) {
-
-        // Do the threshold fit
-        float thresh = 0., noise = 0.;
-        bool success = false;
-        int spoints = 0;
-        if (isDumpS) { // already protected for multi-thread in the init
-          mFitHist->SetName(Form("scurve_chip%d_row%d_col%d_scani%d", chipID, row, col_i, scan_i));
-        }
-
-        success = this->findThreshold(chipID, mPixelHits[chipID][row][col_i],
-                                      this->mX, mScanType == 'r' ? N_RANGE2 : N_RANGE, thresh, noise, spoints, scan_i);
-
+        auto const& fit = scanFits[col_i];
         vChipid[col_i] = chipID;
         vRow[col_i] = row;
-        vThreshold[col_i] = (mScanType == 'T' || mScanType == 'r') ? (short int)(thresh * 10.) : (short int)(thresh);
-        vNoise[col_i] = (float)(noise * 10.); // always factor 10 also for ITHR/VCASN to not have all zeros
-        vSuccess[col_i] = success;
-        vPoints[col_i] = spoints > 0 ? (unsigned char)(spoints) : 0;
+        vThreshold[col_i] = (mScanType == 'T' || mScanType == 'r') ? (short int)(fit.thresh * 10.) : (short int)(fit.thresh);
+        vNoise[col_i] = (float)(fit.noise * 10.); // always factor 10 also for ITHR/VCASN to not have all zeros
+        vSuccess[col_i] = fit.success;
+        vPoints[col_i] = fit.spoints > 0 ? (unsigned char)(fit.spoints) : 0;
 
         if (mScanType == 'r') {
           vMixData[col_i] = (scan_i * this->mStep) + mMin;
@@ -1088,6 +1201,17 @@ void ITSThresholdCalibrator::setRunType(const short int& runtype)
                            : new TF1("mFitFunction", erf, (mScanType == 'T' || mScanType == 'r') ? 3 : mMin, mScanType == 'r' ? mMax2 : mMax, 2);
     this->mFitFunction->SetParName(0, "Threshold");
     this->mFitFunction->SetParName(1, "Noise");
+
+    // Probit and binomial weight of k hits out of nInjScaled for the closed-form fit
+    this->mProbitLUT.assign(nInjScaled + 1, 0.);
+    this->mProbitWeightLUT.assign(nInjScaled + 1, 0.);
+    for (int k = 1; k < nInjScaled; k++) {
+      double p = (double)k / nInjScaled;
+      double z = std::sqrt(2.) * TMath::ErfInverse(2. * p - 1.);
+      double density = std::exp(-0.5 * z * z) / std::sqrt(2. * TMath::Pi());
+      this->mProbitLUT[k] = z;
+      this->mProbitWeightLUT[k] = nInjScaled * density * density / (p * (1. - p));
+    }
   }
 
   return;
@@ -1261,7 +1385,7 @@ std::vector<float> ITSThresholdCalibrator::calculatePulseParams2D(const short in
 }
 //////////////////////////////////////////////////////////////////////////////
 // Extract thresholds and update memory
-void ITSThresholdCalibrator::extractAndUpdate(const short int& chipID, const short int& row)
+void ITSThresholdCalibrator::extractAndUpdate(const short int& chipID, const short int& row, const PixelFit* fits)
 {
   // In threshold scan case, reset mThresholdTree before writing to a new file
   if ((this->mScanType == 'T' || this->mScanType == 'D' || this->mScanType == 'A' || this->mScanType == 'P' || this->mScanType == 'p' || mScanType == 'R' || mScanType == 'r') && ((this->mRowCounter)++ == N_ROWS_PER_FILE)) {
@@ -1273,7 +1397,7 @@ void ITSThresholdCalibrator::extractAndUpdate(const short int& chipID, const sho
   }
 
   // Extract threshold values and save to memory
-  this->extractThresholdRow(chipID, row);
+  this->extractThresholdRow(chipID, row, fits);
 
   return;
 }
@@ -1436,13 +1560,13 @@ void ITSThresholdCalibrator::run(ProcessingContext& pc)
         if (!this->mPixelHits.count(chipID)) {
           if (mScanType == 'D' || mScanType == 'A') { // for digital and analog scan initialize the full matrix for each chipID
             for (int irow = 0; irow < 512; irow++) {
-              this->mPixelHits[chipID][irow] = std::vector<std::vector<std::vector<unsigned short int>>>(this->N_COL, std::vector<std::vector<unsigned short int>>(N_RANGE2, std::vector<unsigned short int>(N_RANGE, 0)));
+              this->mPixelHits[chipID][irow] = RowHits(this->N_COL, N_RANGE2, N_RANGE);
             }
           } else {
-            this->mPixelHits[chipID][row] = std::vector<std::vector<std::vector<unsigned short int>>>(this->N_COL, std::vector<std::vector<unsigned short int>>(N_RANGE2, std::vector<unsigned short int>(N_RANGE, 0)));
+            this->mPixelHits[chipID][row] = RowHits(this->N_COL, N_RANGE2, N_RANGE);
           }
         } else if (!this->mPixelHits[chipID].count(row)) { // allocate memory for chip = chipID or for a row of this chipID
-          this->mPixelHits[chipID][row] = std::vector<std::vector<std::vector<unsigned short int>>>(this->N_COL, std::vector<std::vector<unsigned short int>>(N_RANGE2, std::vector<unsigned short int>(N_RANGE, 0)));
+          this->mPixelHits[chipID][row] = RowHits(this->N_COL, N_RANGE2, N_RANGE);
         }
       }
 
@@ -1487,7 +1611,8 @@ void ITSThresholdCalibrator::run(ProcessingContext& pc)
     // Check if scan of a row is finished: only for specific scans!
     bool passCondition = (mCdwCntRU[iRU] == nInjScaled * nL);
     if (mScanType != 'D' && mScanType != 'A' && mScanType != 'P' && mScanType != 'p' && mScanType != 'R' && mScanType != 'r' && passCondition) {
-      // extract data from the row
+      // extract data from the row, the thresholds of all the chips are extracted together
+      std::vector<std::pair<short int, short int>> rows;
       for (short int iChip = 0; iChip < chipEnabled.size(); iChip++) {
         short int chipID = chipEnabled[iChip];
         if ((chipID % mChipModBase) != mChipModSel) {
@@ -1496,13 +1621,19 @@ void ITSThresholdCalibrator::run(ProcessingContext& pc)
         if (!isDumpS || (std::find(chipDumpList.begin(), chipDumpList.end(), chipID) != chipDumpList.end() || !chipDumpList.size())) { // to dump s-curves as histograms
           if (mPixelHits.count(chipID)) {
             if (mPixelHits[chipID].count(mRowRU[iRU])) { // make sure the row exists
-              extractAndUpdate(chipID, mRowRU[iRU]);
-              mPixelHits[chipID].erase(mRowRU[iRU]);
-              mForbiddenRows[chipID].push_back(mRowRU[iRU]);
+              rows.emplace_back(chipID, mRowRU[iRU]);
             }
           }
         }
       }
+      std::vector<std::vector<PixelFit>> fits;
+      fitRows(rows, fits);
+      for (size_t irow = 0; irow < rows.size(); irow++) {
+        auto [chipID, row] = rows[irow];
+        extractAndUpdate(chipID, row, fits[irow].data());
+        mPixelHits[chipID].erase(row);
+        mForbiddenRows[chipID].push_back(row);
+      }
       mCdwCntRU[iRU] = 0; // reset
     }
   } // end loop on RuSet
@@ -1944,6 +2075,7 @@ DataProcessorSpec getITSThresholdCalibratorSpec(const ITSCalibInpConf& inpConf)
             {"meta-output-dir", VariantType::String, "/dev/null", {"Metadata output directory"}},
             {"meta-type", VariantType::String, "", {"metadata type"}},
             {"nthreads", VariantType::Int, 1, {"Number of threads, default is 1"}},
+            {"fit-lut", VariantType::Bool, false, {"With fittype fit, use the closed-form erf fit instead of TF1. Thread safe, enabled with nthreads > 1"}},
             {"enable-cw-cnt-check", VariantType::Bool, false, {"Use to enable the check of the calib word counter row by row in addition to the hits"}},
             {"enable-single-pix-tag", VariantType::Bool, false, {"Use to enable tagging of single noisy pix in digital and analogue scan"}},
             {"ccdb-mgr-url", VariantType::String, "", {"CCDB url to download confDBmap"}},
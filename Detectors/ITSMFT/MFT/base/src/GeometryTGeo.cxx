@@ -436,7 +436,9 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
   // LOG(info) << "mask " << mask << " o2::math_utils::bit2Mask " << o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G) <<
   // FairLogger::endl;
   // build matrices
+  bool updateTransforms = false;
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G)) && !getCacheL2G().isFilled()) {
+    updateTransforms = true;
     LOG(info) << "Loading MFT L2G matrices from TGeo";
     auto& cacheL2G = getCacheL2G();
     cacheL2G.setSize(mSize);
@@ -448,6 +450,7 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
 
   if ((mask & o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L)) && !getCacheT2L().isFilled()) {
     // matrices for Tracking to Local frame transformation
+    updateTransforms = true;
     LOG(info) << "Loading MFT T2L matrices from TGeo";
     auto& cacheT2L = getCacheT2L();
     cacheT2L.setSize(mSize);
@@ -468,6 +471,10 @@ void GeometryTGeo::fillMatrixCache(Int_t mask)
       cacheT2G.setMatrix(Mat3D(mat), i);
     }
   }
+
+  if (updateTransforms) {
+    updateChipTransforms();
+  }
 }
 
 //__________________________________________________________________________
@@ -497,6 +504,7 @@ void GeometryTGeo::updateL2GMatrixCache(std::vector<int> chipIDs)
       setMatrix(i, cacheL2G);
     }
   }
+  updateChipTransforms();
 }
 //__________________________________________________________________________
 TGeoHMatrix& GeometryTGeo::createT2LMatrix(Int_t index)
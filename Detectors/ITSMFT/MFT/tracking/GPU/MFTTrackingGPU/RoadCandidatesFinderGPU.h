@@ -0,0 +1,37 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RoadCandidatesFinderGPU.h
+/// \brief GPU backend of the MFT LTF and CA road search
+///
+
+#ifndef MFTTRACKINGGPU_ROADCANDIDATESFINDERGPU_H_
+#define MFTTRACKINGGPU_ROADCANDIDATESFINDERGPU_H_
+
+#include <memory>
+
+#include "MFTTracking/RoadCandidates.h"
+
+namespace o2
+{
+namespace mft
+{
+namespace gpu
+{
+
+/// one finder per tracker instance, each owns its stream and device buffers
+std::unique_ptr<RoadCandidatesFinder> createRoadCandidatesFinderGPU();
+
+} // namespace gpu
+} // namespace mft
+} // namespace o2
+
+#endif /* MFTTRACKINGGPU_ROADCANDIDATESFINDERGPU_H_ */
@@ -0,0 +1,361 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RoadCandidatesFinderGPU.cu
+/// \brief GPU backend of the MFT LTF and CA road search
+///
+
+#include <cuda_runtime.h>
+
+#include <thrust/execution_policy.h>
+#include <thrust/device_ptr.h>
+#include <thrust/scan.h>
+
+#include "ITStrackingGPU/Stream.h"
+#include "ITStrackingGPU/Utils.h"
+#include "ITStrackingGPU/Vector.h"
+#include "MFTTrackingGPU/RoadCandidatesFinderGPU.h"
+
+namespace o2
+{
+namespace mft
+{
+namespace gpu
+{
+using o2::its::gpu::Stream;
+using o2::its::gpu::Vector;
+using o2::its::gpu::utils::checkGPUError;
+
+namespace
+{
+constexpr int NLayers = constants::mft::LayersNumber;
+constexpr int NBlocks = 40;
+constexpr int NThreads = 256;
+
+/// clusters of all layers, concatenated and sorted by bin within each layer
+struct ClustersView {
+  const float* x;
+  const float* y;
+  const float* z;
+  const int* bin;
+  const int* used;
+  const int* layerOffsets;
+};
+
+struct SetupView {
+  int nBins;
+  const float* layerZ;
+  const float* inverseLayerZ;
+  const int* binsOffsets;
+  const int* bins;
+  const int* binsSOffsets;
+  const int* binsS;
+
+  GPUd() int getKey(int layer1, int layer2, int bin1) const { return (layer1 * (NLayers - 1) + layer2 - 1) * nBins + bin1; }
+};
+
+/// clusters of "layer" in "bin", as [first, last) index in layer
+GPUd() void getBinClusterRange(const ClustersView& cls, const int layer, const int bin, int& first, int& last)
+{
+  const int* bins = cls.bin + cls.layerOffsets[layer];
+  const int n = cls.layerOffsets[layer + 1] - cls.layerOffsets[layer];
+  int lo = 0, hi = n;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (bins[mid] < bin) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  first = lo;
+  hi = n;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (bins[mid] <= bin) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  last = lo;
+}
+
+GPUd() int findPair(const int* entriesOffsets, const int nPairs, const int entry)
+{
+  int pair = 0;
+  while (pair < nPairs - 1 && entriesOffsets[pair + 1] <= entry) {
+    ++pair;
+  }
+  return pair;
+}
+
+GPUd() float getDistanceToSeed(const ClustersView& cls, const int c1, const int c2, const int c)
+{
+  // same arithmetic as Tracker::getDistanceToSeed
+  float dxSeed = cls.x[c2] - cls.x[c1];
+  float dySeed = cls.y[c2] - cls.y[c1];
+  float dzSeed = cls.z[c2] - cls.z[c1];
+  float dz = cls.z[c] - cls.z[c1];
+  float invdzSeed = dz / dzSeed;
+  float xSeed = cls.x[c1] + dxSeed * invdzSeed;
+  float ySeed = cls.y[c1] + dySeed * invdzSeed;
+  return (cls.x[c] - xSeed) * (cls.x[c] - xSeed) + (cls.y[c] - ySeed) * (cls.y[c] - ySeed);
+}
+
+/// unused clusters of layer2 in the seed window of cluster1, written to "seeds" if not null
+GPUd() int processSeeds(const ClustersView& cls, const SetupView& setup, const int layer1, const int layer2, const int clsInLayer1, int* seeds)
+{
+  const int c1 = cls.layerOffsets[layer1] + clsInLayer1;
+  if (cls.used[c1]) {
+    return 0;
+  }
+  int nSeeds = 0, first, last;
+  const int key = setup.getKey(layer1, layer2, cls.bin[c1]);
+  for (int iBin = setup.binsSOffsets[key]; iBin < setup.binsSOffsets[key + 1]; ++iBin) {
+    getBinClusterRange(cls, layer2, setup.binsS[iBin], first, last);
+    for (int clsInLayer2 = first; clsInLayer2 < last; ++clsInLayer2) {
+      if (cls.used[cls.layerOffsets[layer2] + clsInLayer2]) {
+        continue;
+      }
+      if (seeds) {
+        seeds[nSeeds] = clsInLayer2;
+      }
+      ++nSeeds;
+    }
+  }
+  return nSeeds;
+}
+
+/// unused clusters inside the road of the seed in the intermediate layers, written to "points" if not null
+GPUd() int processPoints(const ClustersView& cls, const SetupView& setup, const int layer1, const int layer2, const int clsInLayer1, const int clsInLayer2,
+                         const float dR2cut, const bool coneRadius, const bool firstOnly, int* points)
+{
+  const int c1 = cls.layerOffsets[layer1] + clsInLayer1;
+  const int c2 = cls.layerOffsets[layer2] + clsInLayer2;
+  const float dz = setup.layerZ[layer2] - setup.layerZ[layer1];
+  const float dRCone = 1 + dz * setup.inverseLayerZ[layer1];
+  const float dR2min = coneRadius ? dR2cut * dRCone * dRCone : dR2cut;
+  int nPoints = 0, first, last;
+  for (int layer = layer1 + 1; layer < layer2; ++layer) {
+    const int key = setup.getKey(layer1, layer, cls.bin[c1]);
+    bool found = false;
+    for (int iBin = setup.binsOffsets[key]; iBin < setup.binsOffsets[key + 1] && !found; ++iBin) {
+      getBinClusterRange(cls, layer, setup.bins[iBin], first, last);
+      for (int clsInLayer = first; clsInLayer < last; ++clsInLayer) {
+        const int c = cls.layerOffsets[layer] + clsInLayer;
+        if (cls.used[c] || getDistanceToSeed(cls, c1, c2, c) >= dR2min) {
+          continue;
+        }
+        if (points) {
+          points[nPoints] = (clsInLayer << 4) | layer;
+        }
+        ++nPoints;
+        if (firstOnly) {
+          found = true;
+          break;
+        }
+      }
+    }
+  }
+  return nPoints;
+}
+
+GPUg() void countSeedsKernel(const ClustersView cls, const SetupView setup, const int* pairs, const int* entriesOffsets, const int nPairs, const int nEntries, int* seedsOffsets)
+{
+  for (int entry = blockIdx.x * blockDim.x + threadIdx.x; entry < nEntries; entry += blockDim.x * gridDim.x) {
+    const int pair = findPair(entriesOffsets, nPairs, entry);
+    seedsOffsets[entry] = processSeeds(cls, setup, pairs[2 * pair], pairs[2 * pair + 1], entry - entriesOffsets[pair], nullptr);
+  }
+}
+
+GPUg() void fillSeedsKernel(const ClustersView cls, const SetupView setup, const int* pairs, const int* entriesOffsets, const int nPairs, const int nEntries,
+                            const int* seedsOffsets, int* seedsEntry, int* seedsCluster2)
+{
+  for (int entry = blockIdx.x * blockDim.x + threadIdx.x; entry < nEntries; entry += blockDim.x * gridDim.x) {
+    const int pair = findPair(entriesOffsets, nPairs, entry);
+    const int nSeeds = processSeeds(cls, setup, pairs[2 * pair], pairs[2 * pair + 1], entry - entriesOffsets[pair], seedsCluster2 + seedsOffsets[entry]);
+    for (int iSeed = 0; iSeed < nSeeds; ++iSeed) {
+      seedsEntry[seedsOffsets[entry] + iSeed] = entry;
+    }
+  }
+}
+
+GPUg() void processPointsKernel(const ClustersView cls, const SetupView setup, const int* pairs, const int* entriesOffsets, const int nPairs, const int nSeeds,
+                                const int* seedsEntry, const int* seedsCluster2, const float dR2cut, const bool coneRadius, const bool firstOnly,
+                                int* pointsOffsets, int* points)
+{
+  for (int seed = blockIdx.x * blockDim.x + threadIdx.x; seed < nSeeds; seed += blockDim.x * gridDim.x) {
+    const int entry = seedsEntry[seed];
+    const int pair = findPair(entriesOffsets, nPairs, entry);
+    int n = processPoints(cls, setup, pairs[2 * pair], pairs[2 * pair + 1], entry - entriesOffsets[pair], seedsCluster2[seed],
+                          dR2cut, coneRadius, firstOnly, points ? points + pointsOffsets[seed] : nullptr);
+    if (!points) {
+      pointsOffsets[seed] = n;
+    }
+  }
+}
+
+} // namespace
+
+class RoadCandidatesFinderGPU final : public RoadCandidatesFinder
+{
+ public:
+  void configure(const RoadSearchSetup& setup) override;
+  void findCandidates(const std::array<std::vector<Cluster>, constants::mft::LayersNumber>& clusters,
+                      const std::vector<std::pair<Int_t, Int_t>>& layerPairs,
+                      Float_t dR2cut, Bool_t coneRadius, Bool_t firstOnly, RoadCandidates& candidates) override;
+
+ private:
+  /// in-place exclusive scan of the n counts in "offsets" (n + 1 elements), returns the total
+  int scanCounts(Vector<int>& offsets, const int n);
+  ClustersView getClustersView() const { return {mX.get(), mY.get(), mZ.get(), mBin.get(), mUsed.get(), mLayerOffsets.get()}; }
+  SetupView getSetupView() const { return {mNBins, mLayerZ.get(), mInverseLayerZ.get(), mBinsOffsets.get(), mBins.get(), mBinsSOffsets.get(), mBinsS.get()}; }
+
+  Stream mStream;
+  int mNBins = 0;
+  Vector<float> mLayerZ, mInverseLayerZ;
+  Vector<int> mBinsOffsets, mBins, mBinsSOffsets, mBinsS;
+
+  // per call buffers, grown on demand
+  Vector<float> mX, mY, mZ;
+  Vector<int> mBin, mUsed, mLayerOffsets, mPairs, mEntriesOffsets;
+  Vector<int> mSeedsOffsets, mSeedsEntry, mSeedsCluster2, mPointsOffsets, mPoints;
+
+  std::vector<float> mHostX, mHostY, mHostZ;
+  std::vector<int> mHostBin, mHostUsed, mHostLayerOffsets, mHostPairs;
+};
+
+void RoadCandidatesFinderGPU::configure(const RoadSearchSetup& setup)
+{
+  mNBins = setup.nBins;
+  mLayerZ.reset(setup.layerZ.data(), NLayers);
+  mInverseLayerZ.reset(setup.inverseLayerZ.data(), NLayers);
+  mBinsOffsets.reset(setup.binsOffsets.data(), setup.binsOffsets.size());
+  mBins.reset(setup.bins.data(), setup.bins.size());
+  mBinsSOffsets.reset(setup.binsSOffsets.data(), setup.binsSOffsets.size());
+  mBinsS.reset(setup.binsS.data(), setup.binsS.size());
+}
+
+int RoadCandidatesFinderGPU::scanCounts(Vector<int>& offsets, const int n)
+{
+  thrust::device_ptr<int> ptr(offsets.get());
+  checkGPUError(cudaMemsetAsync(offsets.get() + n, 0, sizeof(int), mStream.get()));
+  thrust::exclusive_scan(thrust::cuda::par.on(mStream.get()), ptr, ptr + n + 1, ptr);
+  checkGPUError(cudaStreamSynchronize(mStream.get()));
+  return offsets.getElementFromDevice(n);
+}
+
+void RoadCandidatesFinderGPU::findCandidates(const std::array<std::vector<Cluster>, constants::mft::LayersNumber>& clusters,
+                                             const std::vector<std::pair<Int_t, Int_t>>& layerPairs,
+                                             Float_t dR2cut, Bool_t coneRadius, Bool_t firstOnly, RoadCandidates& candidates)
+{
+  const int nPairs = layerPairs.size();
+  candidates.entriesOffsets.resize(nPairs + 1);
+  candidates.entriesOffsets[0] = 0;
+  for (int pair = 0; pair < nPairs; ++pair) {
+    candidates.entriesOffsets[pair + 1] = candidates.entriesOffsets[pair] + clusters[layerPairs[pair].first].size();
+  }
+  const int nEntries = candidates.entriesOffsets[nPairs];
+  candidates.seedsOffsets.assign(nEntries + 1, 0);
+  candidates.seedsCluster2.clear();
+  candidates.pointsOffsets.assign(1, 0);
+  candidates.points.clear();
+  if (nEntries == 0) {
+    return;
+  }
+
+  // structure-of-arrays copy of the clusters with the current usage flags
+  mHostLayerOffsets.resize(NLayers + 1);
+  mHostLayerOffsets[0] = 0;
+  for (int layer = 0; layer < NLayers; ++layer) {
+    mHostLayerOffsets[layer + 1] = mHostLayerOffsets[layer] + clusters[layer].size();
+  }
+  const int nClusters = mHostLayerOffsets[NLayers];
+  mHostX.resize(nClusters);
+  mHostY.resize(nClusters);
+  mHostZ.resize(nClusters);
+  mHostBin.resize(nClusters);
+  mHostUsed.resize(nClusters);
+  for (int layer = 0, ic = 0; layer < NLayers; ++layer) {
+    for (const auto& cluster : clusters[layer]) {
+      mHostX[ic] = cluster.getX();
+      mHostY[ic] = cluster.getY();
+      mHostZ[ic] = cluster.getZ();
+      mHostBin[ic] = cluster.indexTableBin;
+      mHostUsed[ic] = cluster.isUsed;
+      ++ic;
+    }
+  }
+  mHostPairs.resize(2 * nPairs);
+  for (int pair = 0; pair < nPairs; ++pair) {
+    mHostPairs[2 * pair] = layerPairs[pair].first;
+    mHostPairs[2 * pair + 1] = layerPairs[pair].second;
+  }
+  mX.reset(mHostX.data(), nClusters);
+  mY.reset(mHostY.data(), nClusters);
+  mZ.reset(mHostZ.data(), nClusters);
+  mBin.reset(mHostBin.data(), nClusters);
+  mUsed.reset(mHostUsed.data(), nClusters);
+  mLayerOffsets.reset(mHostLayerOffsets.data(), NLayers + 1);
+  mPairs.reset(mHostPairs.data(), 2 * nPairs);
+  mEntriesOffsets.reset(candidates.entriesOffsets.data(), nPairs + 1);
+
+  const auto cls = getClustersView();
+  const auto setup = getSetupView();
+
+  // seeds: count, scan, fill
+  mSeedsOffsets.reset(nEntries + 1);
+  countSeedsKernel<<<NBlocks, NThreads, 0, mStream.get()>>>(cls, setup, mPairs.get(), mEntriesOffsets.get(), nPairs, nEntries, mSeedsOffsets.get());
+  checkGPUError(cudaPeekAtLastError());
+  const int nSeeds = scanCounts(mSeedsOffsets, nEntries);
+  mSeedsOffsets.copyIntoSizedVector(candidates.seedsOffsets);
+  if (nSeeds == 0) {
+    return;
+  }
+  mSeedsEntry.reset(nSeeds);
+  mSeedsCluster2.reset(nSeeds);
+  fillSeedsKernel<<<NBlocks, NThreads, 0, mStream.get()>>>(cls, setup, mPairs.get(), mEntriesOffsets.get(), nPairs, nEntries,
+                                                           mSeedsOffsets.get(), mSeedsEntry.get(), mSeedsCluster2.get());
+  checkGPUError(cudaPeekAtLastError());
+
+  // road points: count, scan, fill
+  mPointsOffsets.reset(nSeeds + 1);
+  processPointsKernel<<<NBlocks, NThreads, 0, mStream.get()>>>(cls, setup, mPairs.get(), mEntriesOffsets.get(), nPairs, nSeeds, mSeedsEntry.get(), mSeedsCluster2.get(),
+                                                               dR2cut, coneRadius, firstOnly, mPointsOffsets.get(), nullptr);
+  checkGPUError(cudaPeekAtLastError());
+  const int nPoints = scanCounts(mPointsOffsets, nSeeds);
+  if (nPoints > 0) {
+    mPoints.reset(nPoints);
+    processPointsKernel<<<NBlocks, NThreads, 0, mStream.get()>>>(cls, setup, mPairs.get(), mEntriesOffsets.get(), nPairs, nSeeds, mSeedsEntry.get(), mSeedsCluster2.get(),
+                                                                 dR2cut, coneRadius, firstOnly, mPointsOffsets.get(), mPoints.get());
+    checkGPUError(cudaPeekAtLastError());
+    checkGPUError(cudaStreamSynchronize(mStream.get()));
+  }
+
+  candidates.seedsCluster2.resize(nSeeds);
+  candidates.pointsOffsets.resize(nSeeds + 1);
+  candidates.points.resize(nPoints);
+  mSeedsCluster2.copyIntoSizedVector(candidates.seedsCluster2);
+  mPointsOffsets.copyIntoSizedVector(candidates.pointsOffsets);
+  if (nPoints > 0) {
+    mPoints.copyIntoSizedVector(candidates.points);
+  }
+}
+
+std::unique_ptr<RoadCandidatesFinder> createRoadCandidatesFinderGPU()
+{
+  return std::make_unique<RoadCandidatesFinderGPU>();
+}
+
+} // namespace gpu
+} // namespace mft
+} // namespace o2
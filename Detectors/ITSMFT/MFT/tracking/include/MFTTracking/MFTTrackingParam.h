@@ -64,6 +64,8 @@ struct MFTTrackingParam : public o2::conf::ConfigurableParamHelper<MFTTrackingPa
   Float_t rCutAtZmin = 0.1; // cm
   /// Special version for TED shots and cosmics, with full scan of the clusters
   bool FullClusterScan = false;
+  /// Run the LTF and CA road search on the GPU (needs the MFT CUDA tracking library, ignored with FullClusterScan)
+  bool useGPU = false;
   /// road for LTF algo : cylinder or cone (default)
   Bool_t LTFConeRadius = kFALSE;
   /// road for CA algo : cylinder or cone (default)
@@ -54,6 +54,7 @@ class ROframe
   Int_t getTotalClusters() const;
 
   std::vector<Cluster>& getClustersInLayer(Int_t layerId) { return mClusters[layerId]; }
+  const std::array<std::vector<Cluster>, constants::mft::LayersNumber>& getClusters() const { return mClusters; }
 
   const MCCompLabel& getClusterLabels(Int_t layerId, const Int_t clusterId) const { return mClusterLabels[layerId][clusterId]; }
 
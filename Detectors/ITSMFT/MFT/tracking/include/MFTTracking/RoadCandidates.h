@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RoadCandidates.h
+/// \brief Interface for offloading the LTF and CA road search of the MFT tracker
+///
+
+#ifndef O2_MFT_ROADCANDIDATES_H_
+#define O2_MFT_ROADCANDIDATES_H_
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "MFTTracking/Cluster.h"
+#include "MFTTracking/Constants.h"
+
+namespace o2
+{
+namespace mft
+{
+
+/// Static search configuration: the R-Phi bin projection tables of the tracker
+/// flattened to CSR, indexed by ((layer1 * (LayersNumber - 1)) + layer2 - 1) * nBins + bin1
+struct RoadSearchSetup {
+  Int_t nBins = 0;
+  std::array<Float_t, constants::mft::LayersNumber> layerZ{};
+  std::array<Float_t, constants::mft::LayersNumber> inverseLayerZ{};
+  std::vector<Int_t> binsOffsets;  ///< search window in the intermediate layers
+  std::vector<Int_t> bins;
+  std::vector<Int_t> binsSOffsets; ///< search window in the last layer of the seed
+  std::vector<Int_t> binsS;
+
+  Int_t getKey(Int_t layer1, Int_t layer2, Int_t bin1) const { return (layer1 * (constants::mft::LayersNumber - 1) + layer2 - 1) * nBins + bin1; }
+};
+
+/// Seeds and road points found for a list of (layer1, layer2) pairs, computed
+/// with the cluster usage flags at the time of the search.
+/// Entries are ordered by pair, then by cluster index in layer1; seeds and
+/// points follow the scan order of the CPU track finder.
+struct RoadCandidates {
+  std::vector<Int_t> entriesOffsets; ///< first entry of each layer pair
+  std::vector<Int_t> seedsOffsets;   ///< first seed of each entry
+  std::vector<Int_t> seedsCluster2;  ///< cluster index in layer2 of each seed
+  std::vector<Int_t> pointsOffsets;  ///< first point of each seed
+  std::vector<Int_t> points;         ///< (clusterIndexInLayer << 4) | layer
+
+  static Int_t getPointLayer(Int_t point) { return point & 0xf; }
+  static Int_t getPointIndex(Int_t point) { return point >> 4; }
+};
+
+/// Device backend for the road search, the CPU track finder replays the
+/// candidates against the current cluster usage flags
+class RoadCandidatesFinder
+{
+ public:
+  virtual ~RoadCandidatesFinder() = default;
+
+  virtual void configure(const RoadSearchSetup& setup) = 0;
+
+  /// firstOnly: keep only the first point per intermediate layer (LTF), otherwise all (CA road)
+  virtual void findCandidates(const std::array<std::vector<Cluster>, constants::mft::LayersNumber>& clusters,
+                              const std::vector<std::pair<Int_t, Int_t>>& layerPairs,
+                              Float_t dR2cut, Bool_t coneRadius, Bool_t firstOnly, RoadCandidates& candidates) = 0;
+};
+
+} // namespace mft
+} // namespace o2
+
+#endif /* O2_MFT_ROADCANDIDATES_H_ */
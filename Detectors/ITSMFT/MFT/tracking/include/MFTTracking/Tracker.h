@@ -20,6 +20,7 @@
 #include "MFTTracking/TrackFitter.h"
 #include "MFTTracking/Cluster.h"
 #include "MFTTracking/TrackerConfig.h"
+#include "MFTTracking/RoadCandidates.h"
 
 #include "MathUtils/Utils.h"
 #include "MathUtils/Cartesian.h"
@@ -81,9 +82,17 @@ class Tracker : public TrackerConfig
   void initializeFinder();
   int getTrackerID() const { return mTrackerID; }
 
+  /// offload the road search to an external (GPU) finder, to be called after configure
+  void setRoadCandidatesFinder(std::unique_ptr<RoadCandidatesFinder> finder);
+  bool hasRoadCandidatesFinder() const { return mRoadFinder != nullptr; }
+
  private:
   void findTracksLTF(ROframe<T>&);
   void findTracksCA(ROframe<T>&);
+  void findTracksLTFCandidates(ROframe<T>&);
+  void findTracksCACandidates(ROframe<T>&);
+  void fillRoadSearchSetup(RoadSearchSetup&) const;
+  Int_t findClosestPointLTF(ROframe<T>&, const Cluster&, const Cluster&, const Int_t, const Int_t, const Int_t) const;
   void findTracksLTFfcs(ROframe<T>&);
   void findTracksCAfcs(ROframe<T>&);
   void computeCellsInRoad(ROframe<T>&);
@@ -167,6 +176,12 @@ class Tracker : public TrackerConfig
 
   /// current road for CA algorithm
   Road mRoad;
+
+  /// optional device backend for the road search
+  std::unique_ptr<RoadCandidatesFinder> mRoadFinder;
+  RoadCandidates mRoadCandidates;
+  std::vector<std::pair<Int_t, Int_t>> mLTFLayerPairs;
+  std::vector<std::pair<Int_t, Int_t>> mCALayerPairs;
 };
 
 //_________________________________________________________________________________________________
@@ -21,6 +21,8 @@
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <array>
+#include <vector>
 
 #include "MFTBase/GeometryTGeo.h"
 #include "DataFormatsITSMFT/CompCluster.h"
@@ -59,49 +61,89 @@ int ioutils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe<T>& event
     nClusters = 0;
   }
 
-  for (auto& c : clusters_in_frame) {
-    auto sensorID = c.getSensorID();
-    int layer = geom->getLayer(sensorID);
-    auto pattID = c.getPatternID();
-    o2::math_utils::Point3D<float> locXYZ;
-    float sigmaX2 = ioutils::DefClusError2Row, sigmaY2 = ioutils::DefClusError2Col; // Dummy COG errors (about half pixel size)
-    if (pattID != itsmft::CompCluster::InvalidPatternID) {
-      sigmaX2 = dict->getErr2X(pattID); // ALPIDE local X coordinate => MFT global X coordinate (ALPIDE rows)
-      sigmaY2 = dict->getErr2Z(pattID); // ALPIDE local Z coordinate => MFT global Y coordinate (ALPIDE columns)
-      if (!dict->isGroup(pattID)) {
-        locXYZ = dict->getClusterCoordinates(c);
-        clusterSize = dict->getNpixels(pattID);
+  // decode the local coordinates of each run of clusters of the same chip, then move
+  // them to the global frame in one pass with the flattened matrices
+  const auto& chipTransforms = geom->getChipTransforms();
+  std::array<std::vector<float>, 3> loc, glo;
+  std::array<std::vector<float>, 2> sigma2;
+  std::vector<int> clsSizes;
+  const int nInFrame = clusters_in_frame.size();
+  while (clusterId < nInFrame) {
+    const auto sensorID = clusters_in_frame[clusterId].getSensorID();
+    const int layer = geom->getLayer(sensorID);
+    const int firstChipCluster = clusterId;
+    for (auto& v : loc) {
+      v.clear();
+    }
+    for (auto& v : sigma2) {
+      v.clear();
+    }
+    clsSizes.clear();
+    for (; clusterId < nInFrame && clusters_in_frame[clusterId].getSensorID() == sensorID; clusterId++) {
+      auto& c = clusters_in_frame[clusterId];
+      auto pattID = c.getPatternID();
+      o2::math_utils::Point3D<float> locXYZ;
+      float sigmaX2 = ioutils::DefClusError2Row, sigmaY2 = ioutils::DefClusError2Col; // Dummy COG errors (about half pixel size)
+      if (pattID != itsmft::CompCluster::InvalidPatternID) {
+        sigmaX2 = dict->getErr2X(pattID); // ALPIDE local X coordinate => MFT global X coordinate (ALPIDE rows)
+        sigmaY2 = dict->getErr2Z(pattID); // ALPIDE local Z coordinate => MFT global Y coordinate (ALPIDE columns)
+        if (!dict->isGroup(pattID)) {
+          locXYZ = dict->getClusterCoordinates(c);
+          clusterSize = dict->getNpixels(pattID);
+        } else {
+          o2::itsmft::ClusterPattern patt(pattIt);
+          locXYZ = dict->getClusterCoordinates(c, patt);
+          clusterSize = patt.getNPixels();
+        }
       } else {
         o2::itsmft::ClusterPattern patt(pattIt);
-        locXYZ = dict->getClusterCoordinates(c, patt);
+        locXYZ = dict->getClusterCoordinates(c, patt, false);
         clusterSize = patt.getNPixels();
       }
-    } else {
-      o2::itsmft::ClusterPattern patt(pattIt);
-      locXYZ = dict->getClusterCoordinates(c, patt, false);
-      clusterSize = patt.getNPixels();
+      if (skip_ROF) { // Skip filtered-out ROFs after processing pattIt
+        continue;
+      }
+      loc[0].push_back(locXYZ.x());
+      loc[1].push_back(locXYZ.y());
+      loc[2].push_back(locXYZ.z());
+      sigma2[0].push_back(sigmaX2);
+      sigma2[1].push_back(sigmaY2);
+      clsSizes.push_back(clusterSize);
     }
-    if (skip_ROF) { // Skip filtered-out ROFs after processing pattIt
-      clusterId++;
+    if (skip_ROF) {
       continue;
     }
     // Transformation to the local --> global
-    auto gloXYZ = geom->getMatrixL2G(sensorID) * locXYZ;
-
-    auto clsPoint2D = math_utils::Point2D<Float_t>(gloXYZ.x(), gloXYZ.y());
-    Float_t rCoord = clsPoint2D.R();
-    Float_t phiCoord = clsPoint2D.Phi();
-    o2::math_utils::bringTo02PiGen(phiCoord);
-    int rBinIndex = tracker->getRBinIndex(rCoord, layer);
-    int phiBinIndex = tracker->getPhiBinIndex(phiCoord);
-    int binIndex = tracker->getBinIndex(rBinIndex, phiBinIndex);
-    event.addClusterToLayer(layer, gloXYZ.x(), gloXYZ.y(), gloXYZ.z(), phiCoord, rCoord, event.getClustersInLayer(layer).size(), binIndex, sigmaX2, sigmaY2, sensorID);
-    if (mcLabels) {
-      event.addClusterLabelToLayer(layer, *(mcLabels->getLabels(first + clusterId).begin()));
+    const int nChipClusters = clusterId - firstChipCluster;
+    for (auto& v : glo) {
+      v.resize(nChipClusters);
+    }
+    if (chipTransforms.isInitialised()) {
+      chipTransforms.localToGlobal(sensorID, nChipClusters, loc[0].data(), loc[1].data(), loc[2].data(), glo[0].data(), glo[1].data(), glo[2].data());
+    } else {
+      for (int i = 0; i < nChipClusters; i++) {
+        auto gloXYZ = geom->getMatrixL2G(sensorID) * o2::math_utils::Point3D<float>{loc[0][i], loc[1][i], loc[2][i]};
+        glo[0][i] = gloXYZ.x();
+        glo[1][i] = gloXYZ.y();
+        glo[2][i] = gloXYZ.z();
+      }
+    }
+
+    for (int i = 0; i < nChipClusters; i++) {
+      auto clsPoint2D = math_utils::Point2D<Float_t>(glo[0][i], glo[1][i]);
+      Float_t rCoord = clsPoint2D.R();
+      Float_t phiCoord = clsPoint2D.Phi();
+      o2::math_utils::bringTo02PiGen(phiCoord);
+      int rBinIndex = tracker->getRBinIndex(rCoord, layer);
+      int phiBinIndex = tracker->getPhiBinIndex(phiCoord);
+      int binIndex = tracker->getBinIndex(rBinIndex, phiBinIndex);
+      event.addClusterToLayer(layer, glo[0][i], glo[1][i], glo[2][i], phiCoord, rCoord, event.getClustersInLayer(layer).size(), binIndex, sigma2[0][i], sigma2[1][i], sensorID);
+      if (mcLabels) {
+        event.addClusterLabelToLayer(layer, *(mcLabels->getLabels(first + firstChipCluster + i).begin()));
+      }
+      event.addClusterExternalIndexToLayer(layer, first + firstChipCluster + i);
+      event.addClusterSizeToLayer(layer, clsSizes[i]);
     }
-    event.addClusterExternalIndexToLayer(layer, first + clusterId);
-    event.addClusterSizeToLayer(layer, clusterSize);
-    clusterId++;
   }
   return nClusters;
 }
@@ -95,6 +95,7 @@ void Tracker<T>::configure(const MFTTrackingParam& trkParam, int trackerID)
       LOG(info) << "TrueTrackMCThreshold          = " << mTrueTrackMCThreshold;
     }
     LOG(info) << "FullClusterScan     = " << (trkParam.FullClusterScan ? "true" : "false");
+    LOG(info) << "useGPU              = " << (trkParam.useGPU ? "true" : "false");
     LOG(info) << "forceZeroField      = " << (trkParam.forceZeroField ? "true" : "false");
     LOG(info) << "MFTRadLength        = " << trkParam.MFTRadLength;
     LOG(info) << "irFramesOnly        = " << (trkParam.irFramesOnly ? "true" : "false");
@@ -235,12 +236,87 @@ void Tracker<T>::initializeFinder()
   }       // end loop layer1
 }
 
+//_________________________________________________________________________________________________
+template <typename T>
+void Tracker<T>::setRoadCandidatesFinder(std::unique_ptr<RoadCandidatesFinder> finder)
+{
+  /// the bin projection tables are filled by initializeFinder of the first tracker
+  mRoadFinder = std::move(finder);
+  if (!mRoadFinder) {
+    return;
+  }
+  if (mFullClusterScan) {
+    LOG(warning) << "Road search offload is not available with FullClusterScan, using the CPU finder";
+    mRoadFinder.reset();
+    return;
+  }
+  RoadSearchSetup setup;
+  fillRoadSearchSetup(setup);
+  mRoadFinder->configure(setup);
+
+  // layer pairs in the order of the CPU seeding loops
+  mLTFLayerPairs.clear();
+  for (Int_t layer1 = 0; layer1 <= (constants::mft::LayersNumber - (mMinTrackPointsLTF - 1)); ++layer1) {
+    for (Int_t layer2 = constants::mft::LayersNumber - 1; layer2 >= layer1 + (mMinTrackPointsLTF - 1); --layer2) {
+      mLTFLayerPairs.emplace_back(layer1, layer2);
+    }
+  }
+  mCALayerPairs.clear();
+  const Int_t layer2Min[4] = {6, 6, 8, 8};
+  for (Int_t layer1 = 0; layer1 <= 3; ++layer1) {
+    for (Int_t layer2 = constants::mft::LayersNumber - 1; layer2 >= layer2Min[layer1]; --layer2) {
+      mCALayerPairs.emplace_back(layer1, layer2);
+    }
+  }
+}
+
+//_________________________________________________________________________________________________
+template <typename T>
+void Tracker<T>::fillRoadSearchSetup(RoadSearchSetup& setup) const
+{
+  constexpr Int_t NPairs = (constants::mft::LayersNumber - 1) * (constants::mft::LayersNumber - 1);
+  setup.nBins = mRPhiBins + 1; // including the overflow bin
+  setup.layerZ = constants::mft::LayerZCoordinate();
+  setup.inverseLayerZ = constants::mft::InverseLayerZCoordinate();
+
+  auto flatten = [&setup](const BinContainer& container, std::vector<Int_t>& offsets, std::vector<Int_t>& bins) {
+    offsets.assign(NPairs * setup.nBins + 1, 0);
+    bins.clear();
+    for (Int_t layer1 = 0; layer1 < (constants::mft::LayersNumber - 1); ++layer1) {
+      for (Int_t layer2 = layer1 + 1; layer2 < constants::mft::LayersNumber; ++layer2) {
+        for (Int_t bin1 = 0; bin1 < setup.nBins; ++bin1) {
+          const auto& src = container[layer1][layer2 - 1][bin1];
+          offsets[setup.getKey(layer1, layer2, bin1) + 1] = src.size();
+        }
+      }
+    }
+    for (Int_t key = 0; key < NPairs * setup.nBins; ++key) {
+      offsets[key + 1] += offsets[key];
+    }
+    bins.resize(offsets.back());
+    for (Int_t layer1 = 0; layer1 < (constants::mft::LayersNumber - 1); ++layer1) {
+      for (Int_t layer2 = layer1 + 1; layer2 < constants::mft::LayersNumber; ++layer2) {
+        for (Int_t bin1 = 0; bin1 < setup.nBins; ++bin1) {
+          const auto& src = container[layer1][layer2 - 1][bin1];
+          std::copy(src.begin(), src.end(), bins.begin() + offsets[setup.getKey(layer1, layer2, bin1)]);
+        }
+      }
+    }
+  };
+  flatten(*mBins.get(), setup.binsOffsets, setup.bins);
+  flatten(*mBinsS.get(), setup.binsSOffsets, setup.binsS);
+}
+
 //_________________________________________________________________________________________________
 template <typename T>
 void Tracker<T>::findLTFTracks(ROframe<T>& event)
 {
   if (!mFullClusterScan) {
-    findTracksLTF(event);
+    if (mRoadFinder) {
+      findTracksLTFCandidates(event);
+    } else {
+      findTracksLTF(event);
+    }
   } else {
     findTracksLTFfcs(event);
   }
@@ -251,7 +327,11 @@ template <typename T>
 void Tracker<T>::findCATracks(ROframe<T>& event)
 {
   if (!mFullClusterScan) {
-    findTracksCA(event);
+    if (mRoadFinder) {
+      findTracksCACandidates(event);
+    } else {
+      findTracksCA(event);
+    }
   } else {
     findTracksCAfcs(event);
   }
@@ -408,6 +488,129 @@ void Tracker<T>::findTracksLTF(ROframe<T>& event)
   } // end seeding
 }
 
+//_________________________________________________________________________________________________
+template <typename T>
+Int_t Tracker<T>::findClosestPointLTF(ROframe<T>& event, const Cluster& cluster1, const Cluster& cluster2, const Int_t layer1, const Int_t layer2, const Int_t layer) const
+{
+  // same selection as in findTracksLTF: the first unused cluster inside the road
+  Int_t clsMinIndex, clsMaxIndex;
+  Float_t dz = constants::mft::LayerZCoordinate()[layer2] - constants::mft::LayerZCoordinate()[layer1];
+  Float_t dRCone = 1 + dz * constants::mft::InverseLayerZCoordinate()[layer1];
+  Float_t dR2min = mLTFConeRadius ? mLTFclsR2Cut * dRCone * dRCone : mLTFclsR2Cut;
+  auto& clusters = event.getClustersInLayer(layer);
+  for (const auto& bin : (*mBins.get())[layer1][layer - 1][cluster1.indexTableBin]) {
+    getBinClusterRange(event, layer, bin, clsMinIndex, clsMaxIndex);
+    for (Int_t clsInLayer = clsMinIndex; clsInLayer <= clsMaxIndex; ++clsInLayer) {
+      if (clusters[clsInLayer].getUsed()) {
+        continue;
+      }
+      if (getDistanceToSeed(cluster1, cluster2, clusters[clsInLayer]) < dR2min) {
+        return clsInLayer;
+      }
+    }
+  }
+  return constants::mft::UnusedIndex;
+}
+
+//_________________________________________________________________________________________________
+template <typename T>
+void Tracker<T>::findTracksLTFCandidates(ROframe<T>& event)
+{
+  // LTF with seeds and road points from the external finder, replayed in the
+  // order of findTracksLTF: the candidates were computed with the usage flags
+  // at the start of the search, so discarding clusters used in the meantime
+  // gives the same tracks as the CPU scan
+
+  MCCompLabel mcCompLabel;
+  Int_t nPointDisks, extClsIndex, clsSize, nPoints;
+  Bool_t hasDisk[constants::mft::DisksNumber];
+  TrackElement trackPoints[constants::mft::LayersNumber];
+
+  mRoadFinder->findCandidates(event.getClusters(), mLTFLayerPairs, mLTFclsR2Cut, mLTFConeRadius, true, mRoadCandidates);
+  const auto& cand = mRoadCandidates;
+
+  for (size_t iPair = 0; iPair < mLTFLayerPairs.size(); ++iPair) {
+    const auto [layer1, layer2] = mLTFLayerPairs[iPair];
+    auto& clusters1 = event.getClustersInLayer(layer1);
+    auto& clusters2 = event.getClustersInLayer(layer2);
+
+    for (Int_t clsInLayer1 = 0; clsInLayer1 < (Int_t)clusters1.size(); ++clsInLayer1) {
+      Cluster& cluster1 = clusters1[clsInLayer1];
+      if (cluster1.getUsed()) {
+        continue;
+      }
+      const Int_t entry = cand.entriesOffsets[iPair] + clsInLayer1;
+
+      for (Int_t seed = cand.seedsOffsets[entry]; seed < cand.seedsOffsets[entry + 1]; ++seed) {
+        const Int_t clsInLayer2 = cand.seedsCluster2[seed];
+        Cluster& cluster2 = clusters2[clsInLayer2];
+        if (cluster2.getUsed()) {
+          continue;
+        }
+
+        nPoints = 0;
+        trackPoints[nPoints].layer = layer1;
+        trackPoints[nPoints].idInLayer = clsInLayer1;
+        nPoints++;
+
+        // at most one point per intermediate layer, in increasing layer order
+        for (Int_t ip = cand.pointsOffsets[seed]; ip < cand.pointsOffsets[seed + 1]; ++ip) {
+          const Int_t layer = RoadCandidates::getPointLayer(cand.points[ip]);
+          Int_t clsInLayer = RoadCandidates::getPointIndex(cand.points[ip]);
+          if (event.getClustersInLayer(layer)[clsInLayer].getUsed()) {
+            // the candidate was taken by a previous track, look for the next one
+            clsInLayer = findClosestPointLTF(event, cluster1, cluster2, layer1, layer2, layer);
+            if (clsInLayer == constants::mft::UnusedIndex) {
+              continue;
+            }
+          }
+          trackPoints[nPoints].layer = layer;
+          trackPoints[nPoints].idInLayer = clsInLayer;
+          nPoints++;
+        }
+
+        trackPoints[nPoints].layer = layer2;
+        trackPoints[nPoints].idInLayer = clsInLayer2;
+        nPoints++;
+
+        // keep only tracks fulfilling the minimum length condition
+        if (nPoints < mMinTrackPointsLTF) {
+          continue;
+        }
+        for (Int_t i = 0; i < (constants::mft::DisksNumber); i++) {
+          hasDisk[i] = kFALSE;
+        }
+        for (Int_t point = 0; point < nPoints; ++point) {
+          hasDisk[trackPoints[point].layer / 2] = kTRUE;
+        }
+        nPointDisks = 0;
+        for (Int_t disk = 0; disk < (constants::mft::DisksNumber); ++disk) {
+          if (hasDisk[disk]) {
+            ++nPointDisks;
+          }
+        }
+        if (nPointDisks < mMinTrackStationsLTF) {
+          continue;
+        }
+
+        // add a new Track
+        event.addTrack();
+        for (Int_t point = 0; point < nPoints; ++point) {
+          auto layer = trackPoints[point].layer;
+          auto clsInLayer = trackPoints[point].idInLayer;
+          Cluster& cluster = event.getClustersInLayer(layer)[clsInLayer];
+          mcCompLabel = mUseMC ? event.getClusterLabels(layer, cluster.clusterId) : MCCompLabel();
+          extClsIndex = event.getClusterExternalIndex(layer, cluster.clusterId);
+          clsSize = event.getClusterSize(layer, cluster.clusterId);
+          event.getCurrentTrack().setPoint(cluster, layer, clsInLayer, mcCompLabel, extClsIndex, clsSize);
+          // mark the used clusters
+          cluster.setUsed(true);
+        }
+      }
+    }
+  }
+}
+
 //_________________________________________________________________________________________________
 template <typename T>
 void Tracker<T>::findTracksLTFfcs(ROframe<T>& event)
@@ -679,6 +882,85 @@ void Tracker<T>::findTracksCA(ROframe<T>& event)
   }         // end layer1
 }
 
+//_________________________________________________________________________________________________
+template <typename T>
+void Tracker<T>::findTracksCACandidates(ROframe<T>& event)
+{
+  // CA roads from the external finder, replayed in the order of findTracksCA;
+  // road points which were used by a previous road are dropped
+
+  Int_t roadId = 0, nPointDisks, nPoints;
+  Bool_t hasDisk[constants::mft::DisksNumber];
+  std::vector<TrackElement> roadPoints;
+
+  mRoadFinder->findCandidates(event.getClusters(), mCALayerPairs, mROADclsR2Cut, mLTFConeRadius, false, mRoadCandidates);
+  const auto& cand = mRoadCandidates;
+
+  for (size_t iPair = 0; iPair < mCALayerPairs.size(); ++iPair) {
+    const auto [layer1, layer2] = mCALayerPairs[iPair];
+    auto& clusters1 = event.getClustersInLayer(layer1);
+    auto& clusters2 = event.getClustersInLayer(layer2);
+
+    for (Int_t clsInLayer1 = 0; clsInLayer1 < (Int_t)clusters1.size(); ++clsInLayer1) {
+      if (clusters1[clsInLayer1].getUsed()) {
+        continue;
+      }
+      const Int_t entry = cand.entriesOffsets[iPair] + clsInLayer1;
+
+      for (Int_t seed = cand.seedsOffsets[entry]; seed < cand.seedsOffsets[entry + 1]; ++seed) {
+        const Int_t clsInLayer2 = cand.seedsCluster2[seed];
+        if (clusters2[clsInLayer2].getUsed()) {
+          continue;
+        }
+
+        // start a road
+        roadPoints.clear();
+        roadPoints.emplace_back(layer1, clsInLayer1);
+        for (Int_t ip = cand.pointsOffsets[seed]; ip < cand.pointsOffsets[seed + 1]; ++ip) {
+          const Int_t layer = RoadCandidates::getPointLayer(cand.points[ip]);
+          const Int_t clsInLayer = RoadCandidates::getPointIndex(cand.points[ip]);
+          if (!event.getClustersInLayer(layer)[clsInLayer].getUsed()) {
+            roadPoints.emplace_back(layer, clsInLayer);
+          }
+        }
+        roadPoints.emplace_back(layer2, clsInLayer2);
+        nPoints = roadPoints.size();
+
+        // keep only roads fulfilling the minimum length condition
+        if (nPoints < mMinTrackPointsCA) {
+          continue;
+        }
+        for (Int_t i = 0; i < (constants::mft::DisksNumber); i++) {
+          hasDisk[i] = kFALSE;
+        }
+        for (Int_t point = 0; point < nPoints; ++point) {
+          hasDisk[roadPoints[point].layer / 2] = kTRUE;
+        }
+        nPointDisks = 0;
+        for (Int_t disk = 0; disk < (constants::mft::DisksNumber); ++disk) {
+          if (hasDisk[disk]) {
+            ++nPointDisks;
+          }
+        }
+        if (nPointDisks < mMinTrackStationsCA) {
+          continue;
+        }
+
+        mRoad.reset();
+        for (Int_t point = 0; point < nPoints; ++point) {
+          mRoad.setPoint(roadPoints[point].layer, roadPoints[point].idInLayer);
+        }
+        mRoad.setRoadId(roadId);
+        ++roadId;
+
+        computeCellsInRoad(event);
+        runForwardInRoad();
+        runBackwardInRoad(event);
+      }
+    }
+  }
+}
+
 //_________________________________________________________________________________________________
 template <typename T>
 void Tracker<T>::findTracksCAfcs(ROframe<T>& event)
@@ -17,6 +17,9 @@
 #include "MFTTracking/IOUtils.h"
 #include "MFTTracking/Tracker.h"
 #include "MFTTracking/TrackCA.h"
+#ifdef MFT_GPU_TRACKING
+#include "MFTTrackingGPU/RoadCandidatesFinderGPU.h"
+#endif
 #include "MFTBase/GeometryTGeo.h"
 
 #include <vector>
@@ -46,6 +49,16 @@ namespace mft
 {
 //#define _TIMING_
 
+template <typename T>
+void setupGPURoadFinder(Tracker<T>& tracker)
+{
+#ifdef MFT_GPU_TRACKING
+  tracker.setRoadCandidatesFinder(gpu::createRoadCandidatesFinderGPU());
+#else
+  LOG(fatal) << "MFT GPU road search requested (MFTTracking.useGPU), but O2 was built without CUDA";
+#endif
+}
+
 void TrackerDPL::init(InitContext& ic)
 {
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
@@ -377,6 +390,9 @@ void TrackerDPL::updateTimeDependentParams(ProcessingContext& pc)
         auto& tracker = mTrackerLVec.emplace_back(std::make_unique<o2::mft::Tracker<TrackLTFL>>(mUseMC));
         tracker->setBz(0);
         tracker->configure(trackingParam, i);
+        if (trackingParam.useGPU) {
+          setupGPURoadFinder(*tracker);
+        }
       }
     } else {
       LOG(info) << "Starting MFT tracker: Field is on! Bz = " << Bz;
@@ -386,6 +402,9 @@ void TrackerDPL::updateTimeDependentParams(ProcessingContext& pc)
         auto& tracker = mTrackerVec.emplace_back(std::make_unique<o2::mft::Tracker<TrackLTF>>(mUseMC));
         tracker->setBz(Bz);
         tracker->configure(trackingParam, i);
+        if (trackingParam.useGPU) {
+          setupGPURoadFinder(*tracker);
+        }
       }
     }
   }
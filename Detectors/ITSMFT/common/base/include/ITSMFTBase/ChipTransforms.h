@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ChipTransforms.h
+/// \brief Flattened per-chip local to global / tracking transforms for the cluster loading
+
+#ifndef ALICEO2_ITSMFT_CHIPTRANSFORMS_H_
+#define ALICEO2_ITSMFT_CHIPTRANSFORMS_H_
+
+#include <array>
+#include <vector>
+
+namespace o2
+{
+namespace detectors
+{
+class DetMatrixCache;
+}
+namespace itsmft
+{
+
+/// Float copy of the L2G and inverse T2L matrices of every chip in one contiguous table,
+/// so that the clusters of a chip can be transformed in a single loop without going
+/// through the double precision Transform3D of the matrix cache
+class ChipTransforms
+{
+ public:
+  /// 3x4 row-major: rotation | translation
+  using Matrix = std::array<float, 12>;
+
+  struct Chip {
+    Matrix l2g{};   ///< local -> global
+    Matrix l2t{};   ///< local -> tracking (inverse of T2L)
+    float alpha = 0.f; ///< tracking frame alpha (barrel only)
+    float x = 0.f;     ///< tracking frame X (barrel only)
+  };
+
+  /// needs the L2G cache filled, the local -> tracking part is filled only if T2L is cached
+  void init(const o2::detectors::DetMatrixCache& geom);
+  void setTrackingFrame(int chip, float alpha, float x)
+  {
+    mChips[chip].alpha = alpha;
+    mChips[chip].x = x;
+  }
+  void clear() { mChips.clear(); }
+
+  bool isInitialised() const { return !mChips.empty(); }
+  bool hasTrackingFrame() const { return mHasT2L; }
+  int getSize() const { return mChips.size(); }
+  const Chip& getChip(int chip) const { return mChips[chip]; }
+
+  /// transform the n local points of a chip, outputs are SoA arrays of size n
+  void localToGlobal(int chip, int n, const float* lx, const float* ly, const float* lz, float* gx, float* gy, float* gz) const
+  {
+    apply(mChips[chip].l2g, n, lx, ly, lz, gx, gy, gz);
+  }
+  void localToTracking(int chip, int n, const float* lx, const float* ly, const float* lz, float* tx, float* ty, float* tz) const
+  {
+    apply(mChips[chip].l2t, n, lx, ly, lz, tx, ty, tz);
+  }
+
+  static void apply(const Matrix& m, int n, const float* __restrict__ x, const float* __restrict__ y, const float* __restrict__ z,
+                    float* __restrict__ ox, float* __restrict__ oy, float* __restrict__ oz)
+  {
+    for (int i = 0; i < n; i++) {
+      ox[i] = m[0] * x[i] + m[1] * y[i] + m[2] * z[i] + m[3];
+      oy[i] = m[4] * x[i] + m[5] * y[i] + m[6] * z[i] + m[7];
+      oz[i] = m[8] * x[i] + m[9] * y[i] + m[10] * z[i] + m[11];
+    }
+  }
+
+ private:
+  std::vector<Chip> mChips;
+  bool mHasT2L = false;
+};
+
+} // namespace itsmft
+} // namespace o2
+
+#endif
@@ -20,6 +20,7 @@
 #include <TObjArray.h> // for TObjArray
 #include <string>
 #include "DetectorsCommonDataFormats/DetMatrixCache.h"
+#include "ITSMFTBase/ChipTransforms.h"
 
 namespace o2
 {
@@ -43,8 +44,14 @@ class GeometryTGeo : public o2::detectors::DetMatrixCache
   bool isOwner() const { return mOwner; }
   void setOwner(bool v) { mOwner = v; }
 
+  /// flattened L2G/T2L matrices for the batched cluster transforms, refreshed by fillMatrixCache
+  const ChipTransforms& getChipTransforms() const { return mChipTransforms; }
+
  protected:
-  bool mOwner = true; //! is it owned by the singleton?
+  void updateChipTransforms() { mChipTransforms.init(*this); }
+
+  bool mOwner = true;              //! is it owned by the singleton?
+  ChipTransforms mChipTransforms;  //! float copy of the matrix cache
 
   ClassDefOverride(GeometryTGeo, 1); // ITSMFR geometry based on TGeo
 };
@@ -0,0 +1,46 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ChipTransforms.cxx
+/// \brief Implementation of the ChipTransforms class
+
+#include "ITSMFTBase/ChipTransforms.h"
+#include "DetectorsCommonDataFormats/DetMatrixCache.h"
+
+using namespace o2::itsmft;
+
+//__________________________________________________________________________
+void ChipTransforms::init(const o2::detectors::DetMatrixCache& geom)
+{
+  const auto& cacheL2G = geom.getCacheL2G();
+  const auto& cacheT2L = geom.getCacheT2L();
+  mChips.clear();
+  mHasT2L = false;
+  if (!cacheL2G.isFilled()) {
+    return;
+  }
+  mHasT2L = cacheT2L.isFilled();
+  mChips.resize(geom.getSize());
+  std::array<double, 12> comp;
+  for (int i = 0; i < geom.getSize(); i++) {
+    auto& chip = mChips[i];
+    geom.getMatrixL2G(i).GetComponents(comp.begin());
+    for (int j = 0; j < 12; j++) {
+      chip.l2g[j] = comp[j];
+    }
+    if (mHasT2L) {
+      geom.getMatrixT2L(i).Inverse().GetComponents(comp.begin());
+      for (int j = 0; j < 12; j++) {
+        chip.l2t[j] = comp[j];
+      }
+    }
+  }
+}
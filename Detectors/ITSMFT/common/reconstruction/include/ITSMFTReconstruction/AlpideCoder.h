@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 #include "PayLoadCont.h"
 #include <map>
+#include <algorithm>
 #include <fmt/format.h>
 #include <iomanip>
 
@@ -341,23 +342,22 @@ class AlpideCoder
 #endif
               return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
             }
-            for (int ip = 0; ip < HitMapSize; ip++) {
-              if (hitsPattern & (0x1 << ip)) {
-                uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
-                if (addr & ~MaskPixID) {
+            // the bits of the pattern refer to increasing addresses, so the hits beyond the double column end can only follow the valid ones
+            const uint32_t validPattern = hitsPattern & ((0x1u << std::min<int>(HitMapSize, MaskPixID - pixID)) - 1);
+            for (uint32_t pattern = validPattern; pattern; pattern &= pattern - 1) { // loop over the set bits only
+              uint16_t addr = pixID + __builtin_ctz(pattern) + 1, rowE = addr >> 1;
+              // the real columnt is int colE = colD + rightC, with rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1))
+              if ((rowE ^ addr) & 0x1) { // same as above
+                rightColHits[nRightCHits++] = rowE;
+              } else {
+                addHit(chipData, rowE, colD); // left column hits are added directly to the container
+              }
+            }
+            if (validPattern != hitsPattern) {
 #ifdef ALPIDE_DECODING_STAT
-                  chipData.setError(ChipStat::WrongRow);
+              chipData.setError(ChipStat::WrongRow);
 #endif
-                  return unexpectedEOF(fmt::format("Non-existing encoder {} decoded, DataLong was {:x}", pixID, dataS)); // abandon cable data
-                }
-                rightC = ((rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1)); // true for right column / lalse for left
-                // the real columnt is int colE = colD + rightC;
-                if (rightC) { // same as above
-                  rightColHits[nRightCHits++] = rowE;
-                } else {
-                  addHit(chipData, rowE, colD + rightC); // left column hits are added directly to the container
-                }
-              }
+              return unexpectedEOF(fmt::format("Non-existing encoder {} decoded, DataLong was {:x}", pixID, dataS)); // abandon cable data
             }
           }
         } else if (ChipStat::getAPENonCritical(dataC) >= 0) { // check for recoverable APE, if on: continue with ExpectChipTrailer | ExpectData | ExpectRegion expectation
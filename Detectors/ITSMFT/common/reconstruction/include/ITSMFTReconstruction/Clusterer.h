@@ -120,6 +120,13 @@ class Clusterer
     uint32_t nPatt = 0;
   };
 
+  struct MergeBlock {
+    const ThreadStat* stat = nullptr; ///< block of the thread output
+    int thread = 0;                   ///< thread which produced the block
+    size_t clusOffs = 0;              ///< position of the block clusters in the final output
+    size_t pattOffs = 0;              ///< position of the block patterns in the final output
+  };
+
   struct ClustererThread {
     int id = -1;
     Clusterer* parent = nullptr; // parent clusterer
@@ -139,6 +146,21 @@ class Clusterer
     std::array<Label, MaxLabels> labelsBuff; //! temporary buffer for building cluster labels
     std::vector<PixelData> pixArrBuff;       //! temporary buffer for pattern calc.
     //
+    /// buffers for the bit-mask based labeling: the fired rows of a column are packed into NColWords words,
+    /// runs of consecutive fired rows are extracted from them and connected to the overlapping runs of the previous column
+    static constexpr int NColWords = (SegmentationAlpide::NRows + 63) / 64;
+    struct PixelRun {
+      uint16_t rowMin = 0;   ///< 1st row of the run
+      uint16_t rowMax = 0;   ///< last row of the run
+      uint32_t firstPix = 0; ///< entry of the 1st pixel of the run in the bmPixels
+      uint32_t nPix = 0;     ///< number of pixels in the run
+    };
+    std::array<uint64_t, NColWords> colBits{}; //! fired rows of the current column
+    std::vector<uint32_t> bmPixels;             //! entries of the unmasked pixels in the ChipPixelData, in column-major order
+    std::vector<PixelRun> runs;                 //! runs of the chip in column-major order
+    std::vector<int> runParent;                 //! union-find forest over the runs, the root is the run with smallest index
+    std::vector<int> runNext;                   //! next run of the same cluster
+    //
     /// temporary storage for the thread output
     CompClusCont compClusters;
     PatternCont patterns;
@@ -171,11 +193,35 @@ class Clusterer
       curr[row] = lastIndex; // store index of the new precluster in the current column buffer
     }
 
+    ///< find the root of the run with path halving
+    int findRunRoot(int ir)
+    {
+      while (runParent[ir] != ir) {
+        ir = runParent[ir] = runParent[runParent[ir]];
+      }
+      return ir;
+    }
+
+    ///< merge the clusters of 2 runs, the run with smaller index becomes the root
+    void uniteRuns(int ir0, int ir1)
+    {
+      ir0 = findRunRoot(ir0);
+      ir1 = findRunRoot(ir1);
+      if (ir0 < ir1) {
+        runParent[ir1] = ir0;
+      } else if (ir1 < ir0) {
+        runParent[ir0] = ir1;
+      }
+    }
+
     void fetchMCLabels(int digID, const ConstMCTruth* labelsDig, int& nfilled);
     void initChip(const ChipPixelData* curChipData, uint32_t first);
     void updateChip(const ChipPixelData* curChipData, uint32_t ip);
     void finishChip(ChipPixelData* curChipData, CompClusCont* compClus, PatternCont* patterns,
                     const ConstMCTruth* labelsDig, MCTruth* labelsClus);
+    void processChipBitMap(ChipPixelData* curChipData, CompClusCont* compClus, PatternCont* patterns,
+                           const ConstMCTruth* labelsDig, MCTruth* labelsClus);
+    void finishCluster(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr);
     void finishChipSingleHitFast(uint32_t hit, ChipPixelData* curChipData, CompClusCont* compClusPtr,
                                  PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPTr);
     void process(uint16_t chip, uint16_t nChips, CompClusCont* compClusPtr, PatternCont* patternsPtr,
@@ -216,6 +262,9 @@ class Clusterer
   int getMaxBCSeparationToSquash() const { return mMaxBCSeparationToSquash; }
   void setMaxBCSeparationToSquash(int n) { mMaxBCSeparationToSquash = n; }
 
+  bool isBitMapLabeling() const { return mBitMapLabeling; }
+  void setBitMapLabeling(bool v) { mBitMapLabeling = v; }
+
   void print() const;
   void clear();
   void reset();
@@ -243,6 +292,7 @@ class Clusterer
   int mMaxBCSeparationToMask = 6000. / o2::constants::lhc::LHCBunchSpacingNS + 10;
   int mMaxRowColDiffToMask = 0; ///< provide their difference in col/row is <= than this
   int mNHugeClus = 0;           ///< number of encountered huge clusters
+  bool mBitMapLabeling = false; ///< use the column bit-mask based connected-component labeling
 
   ///< Squashing options
   int mSquashingDepth = 0; ///< squashing is applied to next N rofs
@@ -252,6 +302,7 @@ class Clusterer
   std::vector<ChipPixelData> mChips;                      // currently processed ROF's chips data
   std::vector<ChipPixelData> mChipsOld;                   // previously processed ROF's chips data (for masking)
   std::vector<ChipPixelData*> mFiredChipsPtr;             // pointers on the fired chips data in the decoder cache
+  std::vector<MergeBlock> mMergeBlocks;                   //! thread output blocks ordered by chip, used at merging
 
   LookUp mPattIdConverter; //! Convert the cluster topology to the corresponding entry in the dictionary.
 
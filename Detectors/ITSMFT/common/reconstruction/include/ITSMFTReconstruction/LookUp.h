@@ -23,6 +23,8 @@
 #ifndef ALICEO2_ITSMFT_LOOKUP_H
 #define ALICEO2_ITSMFT_LOOKUP_H
 #include <array>
+#include <vector>
+#include <cstdint>
 #include "DataFormatsITSMFT/ClusterTopology.h"
 #include "DataFormatsITSMFT/TopologyDictionary.h"
 
@@ -46,8 +48,18 @@ class LookUp
   auto getDictionaty() const { return mDictionary; }
 
  private:
+  /// topologies with up to MaxPackedBits pixels in the bounding box are identified by their spans and pattern
+  /// packed into a 64-bit key, which is looked up in an open-addressing table instead of hashing the pattern
+  static constexpr int MaxPackedBits = 48;
+  static uint64_t packTopology(int nRow, int nCol, const unsigned char* patt);
+  void buildPackedTable();
+  int findPacked(uint64_t key) const;
+
   TopologyDictionary mDictionary;
   int mTopologiesOverThreshold;
+  std::vector<uint64_t> mPackedKeys; //! open-addressing table of packed topologies, 0 for empty slot
+  std::vector<int> mPackedIDs;       //! dictionary IDs of the packed topologies
+  int mPackedShift = 64;             //! shift of the multiplicative hash selecting the slot
 
   ClassDefNV(LookUp, 3);
 };
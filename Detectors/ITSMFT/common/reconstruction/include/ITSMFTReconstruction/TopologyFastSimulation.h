@@ -33,9 +33,13 @@ class TopologyFastSimulation
 {
  public:
   TopologyFastSimulation(std::string fileName, unsigned seed = 0xdeadbeef);
+  TopologyFastSimulation(const TopologyDictionary& dictionary, unsigned seed = 0xdeadbeef);
   int getRandom();
+  const TopologyDictionary& getDictionary() const { return mDictionary; }
 
  private:
+  void init(unsigned seed);
+
   TopologyDictionary mDictionary;
   std::vector<double> mFreqArray;
   std::mt19937 mGenerator;
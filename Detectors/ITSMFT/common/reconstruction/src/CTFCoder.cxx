@@ -55,7 +55,7 @@ void CTFCoder::compress(CompressedClusters& cc,
   if (mIRFrameSelector.isSet()) {
     for (size_t ir = 0; ir < rofRecVec.size(); ir++) {
       auto irStart = rofRecVec[ir].getBCData();
-      if (mIRFrameSelector.check({irStart, irStart + strobeLength - 1}) < 0) {
+      if (!mIRFrameSelector.isSelected({irStart, irStart + strobeLength - 1})) {
         reject[ir] = true;
         nrofSel--;
         nClusSel -= rofRecVec[ir].getNEntries();
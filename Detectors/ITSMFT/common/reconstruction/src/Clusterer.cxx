@@ -112,38 +112,43 @@ void Clusterer::process(int nThreads, PixelReader& reader, CompClusCont* compClu
 #ifdef _PERFORM_TIMING_
       mTimerMerge.Start(false);
 #endif
-      size_t nClTot = 0, nPattTot = 0;
-      int chid = 0, thrStatIdx[nThreads];
+      // order the blocks of all threads by chip, assign them their place in the preallocated output and let
+      // every block be copied independently, only the MC labels are merged sequentially
+      mMergeBlocks.clear();
       for (int ith = 0; ith < nThreads; ith++) {
-        std::sort(mThreads[ith]->stats.begin(), mThreads[ith]->stats.end(), [](const ThreadStat& a, const ThreadStat& b) { return a.firstChip < b.firstChip; });
-        thrStatIdx[ith] = 0;
-        nClTot += mThreads[ith]->compClusters.size();
-        nPattTot += mThreads[ith]->patterns.size();
+        for (const auto& stat : mThreads[ith]->stats) {
+          mMergeBlocks.emplace_back(MergeBlock{&stat, ith, 0, 0});
+        }
+      }
+      std::sort(mMergeBlocks.begin(), mMergeBlocks.end(), [](const MergeBlock& a, const MergeBlock& b) { return a.stat->firstChip < b.stat->firstChip; });
+      size_t nClTot = compClus->size(), nPattTot = patterns ? patterns->size() : 0;
+      for (auto& blk : mMergeBlocks) {
+        blk.clusOffs = nClTot;
+        blk.pattOffs = nPattTot;
+        nClTot += blk.stat->nClus;
+        nPattTot += blk.stat->nPatt;
       }
-      compClus->reserve(nClTot);
+      compClus->resize(nClTot);
       if (patterns) {
-        patterns->reserve(nPattTot);
+        patterns->resize(nPattTot);
       }
-      while (chid < nFired) {
-        for (int ith = 0; ith < nThreads; ith++) {
-          if (thrStatIdx[ith] >= mThreads[ith]->stats.size()) {
-            continue;
-          }
-          const auto& stat = mThreads[ith]->stats[thrStatIdx[ith]];
-          if (stat.firstChip == chid) {
-            thrStatIdx[ith]++;
-            chid += stat.nChips; // next chip to look
-            const auto clbeg = mThreads[ith]->compClusters.begin() + stat.firstClus;
-            auto szold = compClus->size();
-            compClus->insert(compClus->end(), clbeg, clbeg + stat.nClus);
-            if (patterns) {
-              const auto ptbeg = mThreads[ith]->patterns.begin() + stat.firstPatt;
-              patterns->insert(patterns->end(), ptbeg, ptbeg + stat.nPatt);
-            }
-            if (labelsCl) {
-              labelsCl->mergeAtBack(mThreads[ith]->labels, stat.firstClus, stat.nClus);
-            }
-          }
+      int nBlocks = mMergeBlocks.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+      for (int ib = 0; ib < nBlocks; ib++) {
+        const auto& blk = mMergeBlocks[ib];
+        const auto& thr = *mThreads[blk.thread];
+        const auto clbeg = thr.compClusters.begin() + blk.stat->firstClus;
+        std::copy(clbeg, clbeg + blk.stat->nClus, compClus->begin() + blk.clusOffs);
+        if (patterns) {
+          const auto ptbeg = thr.patterns.begin() + blk.stat->firstPatt;
+          std::copy(ptbeg, ptbeg + blk.stat->nPatt, patterns->begin() + blk.pattOffs);
+        }
+      }
+      if (labelsCl) {
+        for (const auto& blk : mMergeBlocks) {
+          labelsCl->mergeAtBack(mThreads[blk.thread]->labels, blk.stat->firstClus, blk.stat->nClus);
         }
       }
       for (int ith = 0; ith < nThreads; ith++) {
@@ -189,6 +194,8 @@ void Clusterer::ClustererThread::process(uint16_t chip, uint16_t nChips, CompClu
       auto valp = validPixID++;
       if (validPixID == npix) { // special case of a single pixel fired on the chip
         finishChipSingleHitFast(valp, curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
+      } else if (parent->mBitMapLabeling) {
+        processChipBitMap(curChipData, compClusPtr, patternsPtr, labelsDigPtr, labelsClPtr);
       } else {
         initChip(curChipData, valp);
         for (; validPixID < npix; validPixID++) {
@@ -259,41 +266,152 @@ void Clusterer::ClustererThread::finishChip(ChipPixelData* curChipData, CompClus
       }
       preClusterIndices[i2] = -1;
     }
-    if (bbox.isAcceptableSize()) {
-      parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
-    } else {
-      auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
-      if (warnLeft > 0) {
-        LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
-             warnLeft == 1 ? " (Further warnings will be muted)" : "");
+    finishCluster(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::finishCluster(const BBox& bbox, int nlab, CompClusCont* compClusPtr, PatternCont* patternsPtr, MCTruth* labelsClusPtr)
+{
+  // stream the cluster made of the pixels in the pixArrBuff, splitting it if it does not fit to the pattern
+  if (bbox.isAcceptableSize()) {
+    parent->streamCluster(pixArrBuff, &labelsBuff, bbox, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab);
+  } else {
+    auto warnLeft = MaxHugeClusWarn - parent->mNHugeClus;
+    if (warnLeft > 0) {
+      LOGP(warn, "Splitting a huge cluster: chipID {}, rows {}:{} cols {}:{}{}", bbox.chipID, bbox.rowMin, bbox.rowMax, bbox.colMin, bbox.colMax,
+           warnLeft == 1 ? " (Further warnings will be muted)" : "");
 #ifdef WITH_OPENMP
 #pragma omp critical
 #endif
-        {
-          parent->mNHugeClus++;
-        }
+      {
+        parent->mNHugeClus++;
       }
-      BBox bboxT(bbox); // truncated box
-      std::vector<PixelData> pixbuf;
-      do {
-        bboxT.rowMin = bbox.rowMin;
-        bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
-        do { // Select a subset of pixels fitting the reduced bounding box
-          bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
-          for (const auto& pix : pixArrBuff) {
-            if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
-              pixbuf.push_back(pix);
-            }
+    }
+    BBox bboxT(bbox); // truncated box
+    std::vector<PixelData> pixbuf;
+    do {
+      bboxT.rowMin = bbox.rowMin;
+      bboxT.colMax = std::min(bbox.colMax, uint16_t(bboxT.colMin + o2::itsmft::ClusterPattern::MaxColSpan - 1));
+      do { // Select a subset of pixels fitting the reduced bounding box
+        bboxT.rowMax = std::min(bbox.rowMax, uint16_t(bboxT.rowMin + o2::itsmft::ClusterPattern::MaxRowSpan - 1));
+        for (const auto& pix : pixArrBuff) {
+          if (bboxT.isInside(pix.getRowDirect(), pix.getCol())) {
+            pixbuf.push_back(pix);
           }
-          if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
-            parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
-            pixbuf.clear();
+        }
+        if (!pixbuf.empty()) { // Stream a piece of cluster only if the reduced bounding box is not empty
+          parent->streamCluster(pixbuf, &labelsBuff, bboxT, parent->mPattIdConverter, compClusPtr, patternsPtr, labelsClusPtr, nlab, true);
+          pixbuf.clear();
+        }
+        bboxT.rowMin = bboxT.rowMax + 1;
+      } while (bboxT.rowMin < bbox.rowMax);
+      bboxT.colMin = bboxT.colMax + 1;
+    } while (bboxT.colMin < bbox.colMax);
+  }
+}
+
+//__________________________________________________
+void Clusterer::ClustererThread::processChipBitMap(ChipPixelData* curChipData, CompClusCont* compClusPtr,
+                                                   PatternCont* patternsPtr, const ConstMCTruth* labelsDigPtr, MCTruth* labelsClusPtr)
+{
+  // connected-component labeling on the bit-mask of fired rows of every column: the runs of consecutive rows are extracted
+  // word-wise and merged with the overlapping runs of the previous column, the clusters are streamed in the order of their 1st pixel
+#ifdef _ALLOW_DIAGONAL_ALPIDE_CLUSTERS_
+  constexpr int RowDist = 1;
+#else
+  constexpr int RowDist = 0;
+#endif
+  constexpr int NBits = NColWords * 64;
+  // position of the 1st bit at or after "from" which is set (or unset if inverted)
+  auto nextBit = [this](int from, bool inverted) {
+    for (int iw = from >> 6; iw < NColWords; iw++) {
+      uint64_t w = inverted ? ~colBits[iw] : colBits[iw];
+      if (iw == (from >> 6)) {
+        w &= ~uint64_t(0) << (from & 63);
+      }
+      if (w) {
+        return iw * 64 + __builtin_ctzll(w);
+      }
+    }
+    return NBits;
+  };
+  const auto& pixData = curChipData->getData();
+  bmPixels.clear();
+  runs.clear();
+  runParent.clear();
+  uint32_t ip = curChipData->getFirstUnmasked(), npix = pixData.size();
+  int prevFirstRun = 0, prevLastRun = 0; // range of the runs of the previous column
+  int prevCol = -2;
+  while (ip < npix) {
+    int col = pixData[ip].getCol();
+    uint32_t pixEntry = bmPixels.size();
+    colBits.fill(0);
+    for (; ip < npix && pixData[ip].getCol() == col; ip++) {
+      if (!pixData[ip].isMasked()) {
+        auto row = pixData[ip].getRowDirect(); // can use getRowDirect since the pixel is not masked
+        colBits[row >> 6] |= uint64_t(1) << (row & 63);
+        bmPixels.push_back(ip);
+      }
+    }
+    int colFirstRun = runs.size(), jr = prevFirstRun;
+    bool leftCol = prevCol + 1 == col;
+    for (int rowMin = nextBit(0, false); rowMin < NBits;) {
+      int rowEnd = nextBit(rowMin, true);
+      auto& run = runs.emplace_back(PixelRun{uint16_t(rowMin), uint16_t(rowEnd - 1), pixEntry, 0});
+      while (pixEntry < bmPixels.size() && pixData[bmPixels[pixEntry]].getRowDirect() < rowEnd) {
+        pixEntry++;
+      }
+      run.nPix = pixEntry - run.firstPix;
+      int ir = runs.size() - 1;
+      runParent.push_back(ir);
+      if (leftCol) { // connect to the overlapping runs of the previous column, both sets are ordered in rows
+        while (jr < prevLastRun && runs[jr].rowMax + RowDist < rowMin) {
+          jr++;
+        }
+        for (int kr = jr; kr < prevLastRun && runs[kr].rowMin <= run.rowMax + RowDist; kr++) {
+          uniteRuns(kr, ir);
+        }
+      }
+      rowMin = nextBit(rowEnd, false);
+    }
+    prevFirstRun = colFirstRun;
+    prevLastRun = runs.size();
+    prevCol = col;
+  }
+  // chain the runs of every cluster to its root, which precedes all of them
+  int nRuns = runs.size();
+  runNext.assign(nRuns, -1);
+  for (int ir = nRuns; ir--;) {
+    int root = findRunRoot(ir);
+    if (root != ir) {
+      runNext[ir] = runNext[root];
+      runNext[root] = ir;
+    }
+  }
+  for (int ir = 0; ir < nRuns; ir++) {
+    if (runParent[ir] != ir) {
+      continue;
+    }
+    BBox bbox(curChipData->getChipID());
+    int nlab = 0;
+    pixArrBuff.clear();
+    for (int next = ir; next >= 0; next = runNext[next]) {
+      const auto& run = runs[next];
+      for (uint32_t i = run.firstPix; i < run.firstPix + run.nPix; i++) {
+        const auto pix = pixData[bmPixels[i]];
+        pixArrBuff.push_back(pix); // needed for cluster topology
+        bbox.adjust(pix.getRowDirect(), pix.getCol());
+        if (labelsClusPtr) {
+          if (parent->mSquashingDepth) { // the MCtruth for this pixel is stored in chip data: due to squashing we lose contiguity
+            fetchMCLabels(curChipData->getOrderedPixId(bmPixels[i]), labelsDigPtr, nlab);
+          } else { // the MCtruth for this pixel is at curChipData->startID+bmPixels[i]
+            fetchMCLabels(bmPixels[i] + curChipData->getStartID(), labelsDigPtr, nlab);
           }
-          bboxT.rowMin = bboxT.rowMax + 1;
-        } while (bboxT.rowMin < bbox.rowMax);
-        bboxT.colMin = bboxT.colMax + 1;
-      } while (bboxT.colMin < bbox.colMax);
+        }
+      }
     }
+    finishCluster(bbox, nlab, compClusPtr, patternsPtr, labelsClusPtr);
   }
 }
 
@@ -453,6 +571,9 @@ void Clusterer::print() const
   LOGP(info, "Clusterizer squashes overflow pixels separated by {} BC and <= {} in row/col seeking down to {} neighbour ROFs", mMaxBCSeparationToSquash, mMaxRowColDiffToMask, mSquashingDepth);
   LOG(info) << "Clusterizer masks overflow pixels separated by < " << mMaxBCSeparationToMask << " BC and <= "
             << mMaxRowColDiffToMask << " in row/col";
+  if (mBitMapLabeling) {
+    LOG(info) << "Clusterizer uses bit-mask based connected-component labeling";
+  }
 
 #ifdef _PERFORM_TIMING_
   auto& tmr = const_cast<TStopwatch&>(mTimer); // ugly but this is what root does internally
@@ -37,6 +37,7 @@ void LookUp::loadDictionary(std::string fileName)
 {
   mDictionary.readFromFile(fileName);
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildPackedTable();
 }
 
 void LookUp::setDictionary(const TopologyDictionary* dict)
@@ -45,6 +46,69 @@ void LookUp::setDictionary(const TopologyDictionary* dict)
     mDictionary = *dict;
   }
   mTopologiesOverThreshold = mDictionary.mCommonMap.size();
+  buildPackedTable();
+}
+
+uint64_t LookUp::packTopology(int nRow, int nCol, const unsigned char* patt)
+{
+  // spans in the lowest 2 bytes, followed by the used pattern bytes, the unused bits of the pattern are 0
+  int nBytes = (nRow * nCol + 7) / 8;
+  uint64_t key = uint64_t(nRow) | (uint64_t(nCol) << 8);
+  for (int i = 0; i < nBytes; i++) {
+    key |= uint64_t(patt[i]) << (16 + 8 * i);
+  }
+  return key;
+}
+
+void LookUp::buildPackedTable()
+{
+  // fill the table with the common topologies not covered by the small topologies LUT, keeping it at most half full
+  mPackedKeys.clear();
+  mPackedIDs.clear();
+  int nPacked = 0;
+  for (const auto& entry : mDictionary.mCommonMap) {
+    const auto& patt = mDictionary.getPattern(entry.second);
+    int nBits = patt.getRowSpan() * patt.getColumnSpan();
+    nPacked += nBits >= 9 && nBits <= MaxPackedBits;
+  }
+  if (!nPacked) {
+    return;
+  }
+  int nBitsTable = 1;
+  while ((1 << nBitsTable) < 2 * nPacked) {
+    nBitsTable++;
+  }
+  mPackedShift = 64 - nBitsTable;
+  mPackedKeys.resize(1 << nBitsTable, 0);
+  mPackedIDs.resize(1 << nBitsTable, CompCluster::InvalidPatternID);
+  uint32_t mask = (1 << nBitsTable) - 1;
+  for (const auto& entry : mDictionary.mCommonMap) {
+    const auto& patt = mDictionary.getPattern(entry.second);
+    int nBits = patt.getRowSpan() * patt.getColumnSpan();
+    if (nBits < 9 || nBits > MaxPackedBits) {
+      continue;
+    }
+    auto key = packTopology(patt.getRowSpan(), patt.getColumnSpan(), patt.getPattern().data() + 2);
+    uint32_t slot = (key * 0x9E3779B97F4A7C15ULL) >> mPackedShift;
+    while (mPackedKeys[slot] && mPackedKeys[slot] != key) {
+      slot = (slot + 1) & mask;
+    }
+    mPackedKeys[slot] = key;
+    mPackedIDs[slot] = entry.second;
+  }
+}
+
+int LookUp::findPacked(uint64_t key) const
+{
+  uint32_t mask = mPackedKeys.size() - 1;
+  uint32_t slot = (key * 0x9E3779B97F4A7C15ULL) >> mPackedShift;
+  while (mPackedKeys[slot]) {
+    if (mPackedKeys[slot] == key) {
+      return mPackedIDs[slot];
+    }
+    slot = (slot + 1) & mask;
+  }
+  return -1;
 }
 
 int LookUp::groupFinder(int nRow, int nCol)
@@ -74,6 +138,11 @@ int LookUp::findGroupID(int nRow, int nCol, const unsigned char patt[ClusterPatt
     if (ID >= 0) {
       return ID;
     }
+  } else if (nBits <= MaxPackedBits && !mPackedKeys.empty()) { // unique topology fitting to the packed key
+    int ID = findPacked(packTopology(nRow, nCol, patt));
+    if (ID >= 0) {
+      return ID;
+    }
   } else { // Big unique topology
     unsigned long hash = ClusterTopology::getCompleteHash(nRow, nCol, patt);
     auto ret = mDictionary.mCommonMap.find(hash);
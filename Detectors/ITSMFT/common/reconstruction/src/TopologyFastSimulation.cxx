@@ -26,15 +26,25 @@ namespace itsmft
 TopologyFastSimulation::TopologyFastSimulation(std::string fileName, unsigned seed)
 {
   mDictionary.readFromFile(fileName);
+  init(seed);
+}
+
+TopologyFastSimulation::TopologyFastSimulation(const TopologyDictionary& dictionary, unsigned seed) : mDictionary(dictionary)
+{
+  init(seed);
+}
+
+void TopologyFastSimulation::init(unsigned seed)
+{
   double tot_freq = 0.;
   int dictSize = mDictionary.getSize();
-  mFreqArray.reserve(dictSize);
+  mFreqArray.resize(dictSize);
   for (int iKey = 0; iKey < dictSize; iKey++) {
     tot_freq += mDictionary.getFrequency(iKey);
     mFreqArray[iKey] = tot_freq;
   }
   mGenerator = std::mt19937(seed);
-  mDistribution = std::uniform_real_distribution<double>(0.0, 1.0);
+  mDistribution = std::uniform_real_distribution<double>(0.0, tot_freq);
 }
 
 int TopologyFastSimulation::getRandom()
@@ -42,7 +52,7 @@ int TopologyFastSimulation::getRandom()
   double rnd = mDistribution(mGenerator);
   auto ind = std::upper_bound(mFreqArray.begin(), mFreqArray.end(), rnd,
                               [](const double& comp1, const double& comp2) { return comp1 < comp2; });
-  return std::distance(mFreqArray.begin(), ind);
+  return std::min<int>(std::distance(mFreqArray.begin(), ind), mFreqArray.size() - 1);
 }
 } // namespace itsmft
 } // namespace o2
@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterFastSimulation.h
+/// \brief Fast simulation of ITS/MFT compact clusters from hits, bypassing the digitization and the clusterization
+
+#ifndef ALICEO2_ITSMFT_CLUSTERFASTSIMULATION_H
+#define ALICEO2_ITSMFT_CLUSTERFASTSIMULATION_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ITSMFTSimulation/DigiParams.h"
+#include "ITSMFTSimulation/Hit.h"
+#include "ITSMFTBase/GeometryTGeo.h"
+#include "ITSMFTReconstruction/TopologyFastSimulation.h"
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/ROFRecord.h"
+#include "CommonDataFormat/InteractionRecord.h"
+#include "SimulationDataFormat/MCCompLabel.h"
+#include "SimulationDataFormat/MCTruthContainer.h"
+
+namespace o2
+{
+namespace itsmft
+{
+
+/// Every hit above the charge threshold produces one compact cluster centred at the middle of the hit segment,
+/// with a topology sampled according to the frequencies of the topologies in the dictionary.
+/// The readout frames are assigned from the collision and hit times as in the Digitizer,
+/// the outputs have the same layout as the ones of the Clusterer.
+class ClusterFastSimulation
+{
+ public:
+  ClusterFastSimulation() = default;
+  ClusterFastSimulation(const ClusterFastSimulation&) = delete;
+  ClusterFastSimulation& operator=(const ClusterFastSimulation&) = delete;
+
+  void setClusters(std::vector<CompClusterExt>* clus) { mClusters = clus; }
+  void setPatterns(std::vector<unsigned char>* patt) { mPatterns = patt; }
+  void setROFRecords(std::vector<ROFRecord>* rec) { mROFRecords = rec; }
+  void setMCLabels(o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mclb) { mMCLabels = mclb; }
+  void setGeometry(const o2::itsmft::GeometryTGeo* gm) { mGeometry = gm; }
+  o2::itsmft::DigiParams& getParams() { return mParams; }
+  const o2::itsmft::DigiParams& getParams() const { return mParams; }
+
+  /// set the dictionary the topologies are sampled from
+  void setDictionary(const TopologyDictionary& dict, unsigned seed);
+
+  void init();
+
+  /// Steer conversion of hits to clusters
+  void process(const std::vector<Hit>* hits, int evID, int srcID);
+  void setEventTime(const o2::InteractionTimeRecord& irt);
+
+  void setContinuous(bool v) { mParams.setContinuous(v); }
+  bool isContinuous() const { return mParams.isContinuous(); }
+  /// move the clusters of the RO frames up to maxFrame to the output containers, sorted in chips
+  void fillOutputContainer(uint32_t maxFrame = 0xffffffff);
+
+  uint32_t getEventROFrameMin() const { return mEventROFrameMin; }
+  uint32_t getEventROFrameMax() const { return mEventROFrameMax; }
+  void resetEventROFrames()
+  {
+    mEventROFrameMin = 0xffffffff;
+    mEventROFrameMax = 0;
+  }
+
+  size_t getNSampledGroups() const { return mNSampledGroups; }
+
+ private:
+  struct PendingCluster {
+    CompClusterExt cluster;
+    std::vector<unsigned char> pattern; ///< explicit pattern for groups of rare topologies
+    o2::MCCompLabel label;
+  };
+
+  void processHit(const o2::itsmft::Hit& hit, int evID, int srcID);
+
+  o2::itsmft::DigiParams mParams;
+  o2::InteractionRecord mIRFirstSampledTF; ///< IR of the 1st sampled IR of the TF
+  o2::InteractionTimeRecord mEventTime;    ///< global event time and interaction record
+  double mCollisionTimeWrtROF = 0;
+  uint32_t mROFrameMin = 0;               ///< lowest RO frame of current clusters
+  uint32_t mROFrameMax = 0;               ///< highest RO frame of current clusters
+  uint32_t mNewROFrame = 0;               ///< ROFrame corresponding to provided time
+  uint32_t mEventROFrameMin = 0xffffffff; ///< lowest RO frame for processed events
+  uint32_t mEventROFrameMax = 0;          ///< highest RO frame for processed events
+  size_t mNSampledGroups = 0;             ///< number of clusters with the topology of a group of rare topologies
+
+  std::unique_ptr<TopologyFastSimulation> mTopologySampler;
+  std::map<uint32_t, std::vector<PendingCluster>> mPending; ///< clusters not yet sent to the output, per RO frame
+
+  const o2::itsmft::GeometryTGeo* mGeometry = nullptr;                     ///< ITS OR MFT upgrade geometry
+  std::vector<CompClusterExt>* mClusters = nullptr;                        //! output clusters
+  std::vector<unsigned char>* mPatterns = nullptr;                         //! output patterns
+  std::vector<o2::itsmft::ROFRecord>* mROFRecords = nullptr;               //! output ROF records
+  o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mMCLabels = nullptr; //! output labels
+};
+
+} // namespace itsmft
+} // namespace o2
+
+#endif
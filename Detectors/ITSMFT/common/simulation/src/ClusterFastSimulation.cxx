@@ -0,0 +1,216 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterFastSimulation.cxx
+/// \brief Implementation of the fast simulation of ITS/MFT compact clusters from hits
+
+#include "ITSMFTSimulation/ClusterFastSimulation.h"
+#include "ITSMFTBase/SegmentationAlpide.h"
+#include "DetectorsRaw/HBFUtils.h"
+#include "MathUtils/Cartesian.h"
+#include "CommonConstants/LHCConstants.h"
+#include <fairlogger/Logger.h>
+#include <algorithm>
+#include <cmath>
+
+using o2::itsmft::ClusterFastSimulation;
+using o2::itsmft::Hit;
+using Segmentation = o2::itsmft::SegmentationAlpide;
+
+using namespace o2::itsmft;
+
+namespace
+{
+constexpr float sec2ns = 1e9;
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::setDictionary(const TopologyDictionary& dict, unsigned seed)
+{
+  mTopologySampler = std::make_unique<TopologyFastSimulation>(dict, seed);
+  LOG(info) << "Sampling cluster topologies from a dictionary of " << dict.getSize() << " entries with seed " << seed;
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::init()
+{
+  if (!mTopologySampler) {
+    LOG(fatal) << "No cluster dictionary was provided for the fast simulation of clusters";
+  }
+  mIRFirstSampledTF = o2::raw::HBFUtils::Instance().getFirstSampledTFIR();
+  mROFrameMin = 0;
+  mROFrameMax = 0;
+  mNewROFrame = 0;
+  mPending.clear();
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::process(const std::vector<Hit>* hits, int evID, int srcID)
+{
+  // convert the hits of single event to clusters, the time must have been set beforehand
+  LOG(debug) << "Fast cluster simulation of " << mGeometry->getName() << " hits of entry " << evID << " from source "
+             << srcID << " at time " << mEventTime << " ROFrame= " << mNewROFrame;
+
+  // is there something to flush ?
+  if (mNewROFrame > mROFrameMin) {
+    fillOutputContainer(mNewROFrame - 1); // flush out all frame preceding the new one
+  }
+  for (const auto& hit : *hits) {
+    processHit(hit, evID, srcID);
+  }
+  // in the triggered mode store clusters after every MC event
+  if (!mParams.isContinuous()) {
+    fillOutputContainer(mROFrameMax);
+  }
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::setEventTime(const o2::InteractionTimeRecord& irt)
+{
+  // same RO frame assignment as in the Digitizer
+  mEventTime = irt;
+  if (!mParams.isContinuous()) {
+    mROFrameMin = 0; // in triggered mode reset the frame counters
+    mROFrameMax = 0;
+  }
+  mCollisionTimeWrtROF = mEventTime.timeInBCNS;
+  if (mParams.isContinuous()) {
+    auto nbc = mEventTime.differenceInBC(mIRFirstSampledTF);
+    if (mCollisionTimeWrtROF < 0 && nbc > 0) {
+      nbc--;
+    }
+    mNewROFrame = nbc / mParams.getROFrameLengthInBC();
+    mCollisionTimeWrtROF += (nbc % mParams.getROFrameLengthInBC()) * o2::constants::lhc::LHCBunchSpacingNS;
+  } else {
+    mNewROFrame = 0;
+  }
+  if (mNewROFrame < mROFrameMin) {
+    LOG(error) << "New ROFrame " << mNewROFrame << " (" << irt << ") precedes currently cashed " << mROFrameMin;
+    throw std::runtime_error("deduced ROFrame precedes already processed one");
+  }
+  if (mParams.isContinuous() && mROFrameMax < mNewROFrame) {
+    mROFrameMax = mNewROFrame - 1; // all frames up to this are finished
+  }
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::processHit(const o2::itsmft::Hit& hit, int evID, int srcID)
+{
+  // the deposited charge must at least pass the threshold of a single pixel
+  if (hit.GetEnergyLoss() * mParams.getEnergyToNElectrons() < mParams.getChargeThreshold()) {
+    return;
+  }
+  float timeInROF = hit.GetTime() * sec2ns;
+  if (timeInROF > 20e3) {
+    return; // same as in the Digitizer
+  }
+  if (mParams.isContinuous()) {
+    timeInROF += mCollisionTimeWrtROF;
+  }
+  if (timeInROF < 0) {
+    timeInROF = 0.;
+  }
+  // in the triggered mode we read just 1 frame
+  uint32_t roFrame = mNewROFrame + (mParams.isContinuous() ? uint32_t(timeInROF * mParams.getROFrameLengthInv()) : 0);
+
+  // the cluster is centred at the middle of the hit segment in the sensor frame
+  int chipID = hit.GetDetectorID();
+  const auto& matrix = mGeometry->getMatrixL2G(chipID);
+  math_utils::Vector3D<float> xyzLocS(matrix ^ (hit.GetPosStart()));
+  math_utils::Vector3D<float> xyzLocE(matrix ^ (hit.GetPos()));
+  auto xyzLoc = (xyzLocS + xyzLocE) * 0.5f;
+
+  const auto& dict = mTopologySampler->getDictionary();
+  int pattID = mTopologySampler->getRandom();
+  const auto& patt = dict.getPattern(pattID);
+  PendingCluster cl;
+  int row = 0, col = 0, rowMin = 0, colMin = 0;
+  if (dict.isGroup(pattID)) {
+    // the reconstruction takes the position of the rare topologies from the explicit pattern,
+    // relative to the anchor pixel shifted by the centre of gravity of the pattern
+    if (!Segmentation::localToDetector(xyzLoc.X(), xyzLoc.Z(), row, col)) {
+      return;
+    }
+    float xCOG = 0, zCOG = 0;
+    patt.getCOG(xCOG, zCOG);
+    rowMin = row - std::round(xCOG);
+    colMin = col - std::round(zCOG);
+    const auto& bitmap = patt.getPattern();
+    cl.pattern.assign(bitmap.begin(), bitmap.begin() + 2 + patt.getUsedBytes());
+    mNSampledGroups++;
+  } else {
+    // the position of the dictionary topologies is the one of the anchor pixel shifted by the centre of gravity
+    if (!Segmentation::localToDetector(xyzLoc.X() - dict.getXCOG(pattID), xyzLoc.Z() - dict.getZCOG(pattID), row, col)) {
+      return;
+    }
+    rowMin = row;
+    colMin = col;
+  }
+  if (rowMin < 0 || colMin < 0 || rowMin + patt.getRowSpan() > Segmentation::NRows || colMin + patt.getColumnSpan() > Segmentation::NCols) {
+    return; // the cluster would not fit into the sensitive matrix
+  }
+  cl.cluster.set(row, col, pattID, chipID);
+  cl.label = o2::MCCompLabel(hit.GetTrackID(), evID, srcID, false);
+  mPending[roFrame].push_back(std::move(cl));
+
+  if (roFrame > mROFrameMax) {
+    mROFrameMax = roFrame;
+  }
+  if (roFrame > mEventROFrameMax) {
+    mEventROFrameMax = roFrame;
+  }
+  if (roFrame < mEventROFrameMin) {
+    mEventROFrameMin = roFrame;
+  }
+}
+
+//_______________________________________________________________________
+void ClusterFastSimulation::fillOutputContainer(uint32_t frameLast)
+{
+  // fill output with clusters from min.cached up to requested frame
+  if (frameLast > mROFrameMax) {
+    frameLast = mROFrameMax;
+  }
+  LOG(debug) << "Filling " << mGeometry->getName() << " clusters output for RO frames " << mROFrameMin << ":" << frameLast;
+
+  o2::itsmft::ROFRecord rcROF;
+  for (; mROFrameMin <= frameLast; mROFrameMin++) {
+    rcROF.setROFrame(mROFrameMin);
+    rcROF.setFirstEntry(mClusters->size()); // start of current ROF in clusters
+    auto frame = mPending.find(mROFrameMin);
+    if (frame != mPending.end()) {
+      // write clusters in the same order as the Clusterer
+      auto& clusters = frame->second;
+      std::stable_sort(clusters.begin(), clusters.end(), [](const PendingCluster& a, const PendingCluster& b) {
+        return a.cluster.getChipID() < b.cluster.getChipID();
+      });
+      for (const auto& cl : clusters) {
+        if (mMCLabels) {
+          mMCLabels->addElement(mClusters->size(), cl.label);
+        }
+        mClusters->push_back(cl.cluster);
+        if (mPatterns) {
+          mPatterns->insert(mPatterns->end(), cl.pattern.begin(), cl.pattern.end());
+        }
+      }
+      mPending.erase(frame);
+    }
+    rcROF.setNEntries(mClusters->size() - rcROF.getFirstEntry()); // number of clusters
+    if (isContinuous()) {
+      rcROF.getBCData().setFromLong(mIRFirstSampledTF.toLong() + mROFrameMin * mParams.getROFrameLengthInBC());
+    } else {
+      rcROF.getBCData() = mEventTime;
+    }
+    if (mROFRecords) {
+      mROFRecords->push_back(rcROF);
+    }
+  }
+}
@@ -131,9 +131,12 @@ DataProcessorSpec getEntropyEncoderSpec(o2::header::DataOrigin orig, bool selIR)
             {{"ctfrep"}, orig, "CTFENCREP", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyEncoderSpec>(orig, selIR)},
     Options{{"ctf-dict", VariantType::String, "ccdb", {"CTF dictionary: empty or ccdb=CCDB, none=no external dictionary otherwise: local filename"}},
+            {"ctf-dict-update", VariantType::Int, 0, {"if > 0, check for an updated CTF dictionary (CCDB or local file) every N TFs"}},
+            {"ctf-dict-sampling", VariantType::Int, 0, {"if > 0, encode every N-th TF with per-TF dictionaries to feed the online dictionary creation"}},
             {"irframe-margin-bwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame lower boundary when selection is requested"}},
             {"irframe-margin-fwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame upper boundary when selection is requested"}},
             {"mem-factor", VariantType::Float, 1.f, {"Memory allocation margin factor"}},
+            {"ctf-encoder-threads", VariantType::Int, 1, {"number of threads to entropy-encode the CTF blocks concurrently"}},
             {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
 
@@ -303,6 +303,7 @@ void STFDecoder<Mapping>::updateTimeDependentParams(ProcessingContext& pc)
       nbc += mClusterer->isContinuousReadOut() ? alpParams.roFrameLengthInBC : (alpParams.roFrameLengthTrig / o2::constants::lhc::LHCBunchSpacingNS);
       mClusterer->setMaxBCSeparationToMask(nbc);
       mClusterer->setMaxRowColDiffToMask(clParams.maxRowColDiffToMask);
+      mClusterer->setBitMapLabeling(clParams.useBitMapLabeling);
       // Squasher
       int rofBC = mClusterer->isContinuousReadOut() ? alpParams.roFrameLengthInBC : (alpParams.roFrameLengthTrig / o2::constants::lhc::LHCBunchSpacingNS); // ROF length in BC
       mClusterer->setMaxBCSeparationToSquash(rofBC + clParams.maxBCDiffToSquashBias);
@@ -42,6 +42,10 @@ class MathiesonOriginal
 
   float integrate(float xMin, float yMin, float xMax, float yMax) const;
 
+  /// integrate the Mathieson over n areas given by the arrays of their limits
+  /// the results are the same as with the integration of the areas one by one, but the loops can be vectorized
+  void integrate(const float* xMin, const float* yMin, const float* xMax, const float* yMax, int n, float* integrals) const;
+
  private:
   float mSqrtKx3 = 0.;      ///< Mathieson Sqrt(Kx3)
   float mKx2 = 0.;          ///< Mathieson Kx2
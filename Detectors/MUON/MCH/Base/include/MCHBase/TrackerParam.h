@@ -45,6 +45,9 @@ struct TrackerParam : public o2::conf::ConfigurableParamHelper<TrackerParam> {
   std::size_t maxCandidates = 50000; ///< maximum number of track candidates above which the tracking abort
   double maxTrackingDuration = 300.; ///< maximum tracking duration in second above which the tracking abort
 
+  bool useFieldLUT = false;    ///< interpolate the magnetic field from a lookup table during the track extrapolation
+  int fieldLUTCheckTracks = 0; ///< number of random tracks used to check the accuracy of the lookup table when built
+
   O2ParamDef(TrackerParam, "MCHTracking");
 };
 
@@ -18,6 +18,9 @@
 
 #include <TMath.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace o2
 {
 namespace mch
@@ -66,5 +69,40 @@ float MathiesonOriginal::integrate(float xMin, float yMin, float xMax, float yMa
                             mKy4 * (TMath::ATan(uyMax) - TMath::ATan(uyMin)));
 }
 
+//_________________________________________________________________________________________________
+void MathiesonOriginal::integrate(const float* xMin, const float* yMin, const float* xMax, const float* yMax, int n,
+                                  float* integrals) const
+{
+  /// integrate the Mathieson over x and y in the n given areas
+  /// the areas are processed in chunks, with one loop per limit such that they can be vectorized
+
+  constexpr int SChunkSize = 64;
+  double uxMin[SChunkSize], uxMax[SChunkSize], uyMin[SChunkSize], uyMax[SChunkSize];
+
+  for (int first = 0; first < n; first += SChunkSize) {
+    const int size = std::min(SChunkSize, n - first);
+    const float* xMinChunk = xMin + first;
+    const float* xMaxChunk = xMax + first;
+    const float* yMinChunk = yMin + first;
+    const float* yMaxChunk = yMax + first;
+    for (int i = 0; i < size; ++i) {
+      uxMin[i] = std::atan(mSqrtKx3 * std::tanh(static_cast<double>(mKx2 * (xMinChunk[i] * mInversePitch))));
+    }
+    for (int i = 0; i < size; ++i) {
+      uxMax[i] = std::atan(mSqrtKx3 * std::tanh(static_cast<double>(mKx2 * (xMaxChunk[i] * mInversePitch))));
+    }
+    for (int i = 0; i < size; ++i) {
+      uyMin[i] = std::atan(mSqrtKy3 * std::tanh(static_cast<double>(mKy2 * (yMinChunk[i] * mInversePitch))));
+    }
+    for (int i = 0; i < size; ++i) {
+      uyMax[i] = std::atan(mSqrtKy3 * std::tanh(static_cast<double>(mKy2 * (yMaxChunk[i] * mInversePitch))));
+    }
+    float* integralsChunk = integrals + first;
+    for (int i = 0; i < size; ++i) {
+      integralsChunk[i] = static_cast<float>(4. * mKx4 * (uxMax[i] - uxMin[i]) * mKy4 * (uyMax[i] - uyMin[i]));
+    }
+  }
+}
+
 } // namespace mch
 } // namespace o2
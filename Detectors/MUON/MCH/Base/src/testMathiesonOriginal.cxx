@@ -0,0 +1,54 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE mathiesonoriginal test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "MCHBase/MathiesonOriginal.h"
+#include <vector>
+
+using o2::mch::MathiesonOriginal;
+
+BOOST_AUTO_TEST_CASE(BatchedIntegrationShouldMatchSingleIntegration)
+{
+  MathiesonOriginal mathieson;
+  mathieson.setPitch(0.25);
+  mathieson.setSqrtKx3AndDeriveKx2Kx4(0.7131);
+  mathieson.setSqrtKy3AndDeriveKy2Ky4(0.7642);
+
+  // more areas than the size of the chunks used internally
+  const int n = 150;
+  std::vector<float> xMin(n), yMin(n), xMax(n), yMax(n), integrals(n);
+  for (int i = 0; i < n; ++i) {
+    xMin[i] = -1.5f + 0.02f * i;
+    xMax[i] = xMin[i] + 0.63f;
+    yMin[i] = 0.8f - 0.013f * i;
+    yMax[i] = yMin[i] + 0.42f;
+  }
+  mathieson.integrate(xMin.data(), yMin.data(), xMax.data(), yMax.data(), n, integrals.data());
+
+  for (int i = 0; i < n; ++i) {
+    BOOST_CHECK_EQUAL(integrals[i], mathieson.integrate(xMin[i], yMin[i], xMax[i], yMax[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IntegralOverLargeAreaShouldBeOne)
+{
+  MathiesonOriginal mathieson;
+  mathieson.setPitch(0.21);
+  mathieson.setSqrtKx3AndDeriveKx2Kx4(0.7000);
+  mathieson.setSqrtKy3AndDeriveKy2Ky4(0.7550);
+
+  float xMin = -10.f, yMin = -10.f, xMax = 10.f, yMax = 10.f, integral = 0.f;
+  mathieson.integrate(&xMin, &yMin, &xMax, &yMax, 1, &integral);
+  BOOST_CHECK_CLOSE(integral, 1.f, 1.e-3);
+}
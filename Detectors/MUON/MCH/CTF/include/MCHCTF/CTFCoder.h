@@ -68,7 +68,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const ROFRecord>&
     mROFRecFilt.clear();
     mDigDataFilt.clear();
     for (const auto& rof : rofData) {
-      if (mIRFrameSelector.check(rof.getBCData()) >= 0) {
+      if (mIRFrameSelector.isSelected(rof.getBCData())) {
         mROFRecFilt.push_back(rof);
         auto digIt = digData.begin() + rof.getFirstIdx();
         auto& rofC = mROFRecFilt.back();
@@ -20,6 +20,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -72,6 +73,7 @@ class ClusterFinderOriginal
   static constexpr int SNFitClustersMax = 3;                     ///< maximum number of clusters fitted at the same time
   static constexpr int SNFitParamMax = 3 * SNFitClustersMax - 1; ///< maximum number of fit parameters
   static constexpr double SLowestCoupling = 1.e-2;               ///< minimum coupling between clusters of pixels and pads
+  static constexpr unsigned int SRandomSeed = 12345;             ///< seed of the random generator, reset for every precluster
 
   void resetPreCluster(gsl::span<const Digit>& digits);
   void simplifyPreCluster(std::vector<int>& removedDigits);
@@ -99,6 +101,7 @@ class ClusterFinderOriginal
   double computeChi2(const double param[SNFitParamMax + 2], int nParamUsed) const;
   void param2ChargeFraction(const double param[SNFitParamMax], int nParamUsed, double fraction[SNFitClustersMax]) const;
   float chargeIntegration(double x, double y, const PadOriginal& pad) const;
+  void resizeIntegrationBuffers(size_t size) const;
 
   void split(const TH2D& histMLEM, const std::vector<double>& coef);
   void addPixel(const TH2D& histMLEM, int i0, int j0, std::vector<int>& pixels, std::vector<std::vector<bool>>& isUsed);
@@ -127,6 +130,18 @@ class ClusterFinderOriginal
   std::unique_ptr<ClusterOriginal> mPreCluster; ///< precluster currently processed
   std::vector<PadOriginal> mPixels;             ///< list of pixels for the current precluster
 
+  /// random generator used in the fit, reset for every precluster such that the results
+  /// do not depend on the order in which the preclusters are processed
+  mutable std::minstd_rand mRandom{SRandomSeed};
+
+  // buffers for the integration of the Mathieson over several pads at once
+  mutable std::vector<float> mXMin{};
+  mutable std::vector<float> mXMax{};
+  mutable std::vector<float> mYMin{};
+  mutable std::vector<float> mYMax{};
+  mutable std::vector<float> mIntegrals{};
+  mutable std::vector<double> mPadChargeFit{};
+
   const mapping::Segmentation* mSegmentation = nullptr; ///< pointer to the DE segmentation for the current precluster
 
   std::vector<Cluster> mClusters{}; ///< list of reconstructed clusters
@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ParallelClusterFinder.h
+/// \brief Definition of a class to reconstruct the clusters of independent preclusters in parallel threads
+///
+/// Every thread owns a ClusterFinderOriginal. The preclusters are distributed dynamically over the threads
+/// and the results are stored per precluster, such that the output does not depend on the number of threads.
+
+#ifndef O2_MCH_PARALLELCLUSTERFINDER_H_
+#define O2_MCH_PARALLELCLUSTERFINDER_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <gsl/span>
+
+#include "DataFormatsMCH/Cluster.h"
+#include "DataFormatsMCH/Digit.h"
+#include "MCHBase/ErrorMap.h"
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ClusterFinderOriginal.h"
+
+namespace o2
+{
+namespace mch
+{
+
+class ParallelClusterFinder
+{
+ public:
+  ParallelClusterFinder() = default;
+  ~ParallelClusterFinder() = default;
+
+  ParallelClusterFinder(const ParallelClusterFinder&) = delete;
+  ParallelClusterFinder& operator=(const ParallelClusterFinder&) = delete;
+  ParallelClusterFinder(ParallelClusterFinder&&) = delete;
+  ParallelClusterFinder& operator=(ParallelClusterFinder&&) = delete;
+
+  void init(int nThreads, bool run2Config);
+  void deinit();
+
+  void findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits);
+
+  /// return the number of threads
+  int getNThreads() const { return mWorkers.size(); }
+  /// return the number of preclusters processed in the last call to findClusters
+  size_t getNPreClusters() const { return mResults.size(); }
+
+  gsl::span<const Cluster> getClusters(size_t iPreCluster) const;
+  gsl::span<const Digit> getUsedDigits(size_t iPreCluster) const;
+
+  /// return the counting of encountered errors
+  ErrorMap& getErrorMap() { return mErrorMap; }
+
+ private:
+  /// clusterizer of one thread and the clusters and digits of the preclusters it processed
+  struct Worker {
+    ClusterFinderOriginal clusterFinder{};
+    std::vector<Cluster> clusters{};
+    std::vector<Digit> usedDigits{};
+  };
+
+  /// location of the results of one precluster
+  struct Result {
+    int worker = 0;
+    size_t firstCluster = 0;
+    size_t nClusters = 0;
+    size_t firstDigit = 0;
+    size_t nDigits = 0;
+  };
+
+  void process(int iWorker, gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits);
+
+  std::vector<std::unique_ptr<Worker>> mWorkers{}; ///< one clusterizer per thread
+  std::vector<Result> mResults{};                  ///< results of every precluster
+  std::atomic<size_t> mNextPreCluster{0};          ///< next precluster to be processed
+
+  ErrorMap mErrorMap{}; ///< counting of encountered errors
+};
+
+} // namespace mch
+} // namespace o2
+
+#endif // O2_MCH_PARALLELCLUSTERFINDER_H_
@@ -31,7 +31,6 @@
 #include <TH2I.h>
 #include <TAxis.h>
 #include <TMath.h>
-#include <TRandom.h>
 
 #include <fairlogger/Logger.h>
 
@@ -198,6 +197,7 @@ void ClusterFinderOriginal::resetPreCluster(gsl::span<const Digit>& digits)
   /// reset the precluster with the pads converted from the input digits
 
   mPreCluster->clear();
+  mRandom.seed(SRandomSeed);
 
   mSegmentation = &mapping::segmentation(digits[0].getDetID());
 
@@ -963,19 +963,32 @@ void ClusterFinderOriginal::computeCoefficients(std::vector<double>& coef, std::
   coef.assign(mPreCluster->multiplicity() * mPixels.size(), 0.);
   prob.assign(mPixels.size(), 0.);
 
+  int nPixels = mPixels.size();
+  resizeIntegrationBuffers(nPixels);
+
   int iCoef(0);
   for (const auto& pad : *mPreCluster) {
 
     // ignore the pads that must not be considered
     if (pad.status() != PadOriginal::kZero) {
-      iCoef += mPixels.size();
+      iCoef += nPixels;
       continue;
     }
 
-    for (int i = 0; i < mPixels.size(); ++i) {
+    // charge (given by Mathieson integral) on pad, assuming the Mathieson is center at each pixel.
+    for (int i = 0; i < nPixels; ++i) {
+      double xPad = pad.x() - mPixels[i].x();
+      double yPad = pad.y() - mPixels[i].y();
+      mXMin[i] = xPad - pad.dx();
+      mXMax[i] = xPad + pad.dx();
+      mYMin[i] = yPad - pad.dy();
+      mYMax[i] = yPad + pad.dy();
+    }
+    mMathieson->integrate(mXMin.data(), mYMin.data(), mXMax.data(), mYMax.data(), nPixels, mIntegrals.data());
 
-      // charge (given by Mathieson integral) on pad, assuming the Mathieson is center at pixel.
-      coef[iCoef] = chargeIntegration(mPixels[i].x(), mPixels[i].y(), pad);
+    for (int i = 0; i < nPixels; ++i) {
+
+      coef[iCoef] = mIntegrals[i];
 
       // update the pixel visibility
       prob[i] += coef[iCoef];
@@ -1621,7 +1634,7 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
       }
       if (nFail > 10) {
         currentParam[iDerivMax] -= shift[iDerivMax];
-        shift[iDerivMax] = 4. * shiftSave * (gRandom->Rndm(0) - 0.5);
+        shift[iDerivMax] = 4. * shiftSave * (std::uniform_real_distribution<double>(0., 1.)(mRandom) - 0.5);
         currentParam[iDerivMax] += shift[iDerivMax];
       }
     }
@@ -1647,7 +1660,31 @@ double ClusterFinderOriginal::computeChi2(const double param[SNFitParamMax + 2],
   double chargeFraction[SNFitClustersMax] = {0.};
   param2ChargeFraction(param, nParamUsed, chargeFraction);
 
+  resizeIntegrationBuffers(mPreCluster->multiplicity());
+  mPadChargeFit.assign(mPreCluster->multiplicity(), 0.);
+
+  // compute the expected charge of the pads used for this fit with these cluster parameters
+  for (int iParam = 0; iParam < nParamUsed; iParam += 3) {
+    int nPads(0);
+    for (const auto& pad : *mPreCluster) {
+      if (pad.status() == PadOriginal::kUseForFit) {
+        double xPad = pad.x() - param[iParam];
+        double yPad = pad.y() - param[iParam + 1];
+        mXMin[nPads] = xPad - pad.dx();
+        mXMax[nPads] = xPad + pad.dx();
+        mYMin[nPads] = yPad - pad.dy();
+        mYMax[nPads] = yPad + pad.dy();
+        ++nPads;
+      }
+    }
+    mMathieson->integrate(mXMin.data(), mYMin.data(), mXMax.data(), mYMax.data(), nPads, mIntegrals.data());
+    for (int iPad = 0; iPad < nPads; ++iPad) {
+      mPadChargeFit[iPad] += mIntegrals[iPad] * chargeFraction[iParam / 3];
+    }
+  }
+
   double chi2(0.);
+  int iPad(0);
   for (const auto& pad : *mPreCluster) {
 
     // skip pads not to be used for this fit
@@ -1655,14 +1692,8 @@ double ClusterFinderOriginal::computeChi2(const double param[SNFitParamMax + 2],
       continue;
     }
 
-    // compute the expected pad charge with these cluster parameters
-    double padChargeFit(0.);
-    for (int iParam = 0; iParam < nParamUsed; iParam += 3) {
-      padChargeFit += chargeIntegration(param[iParam], param[iParam + 1], pad) * chargeFraction[iParam / 3];
-    }
-    padChargeFit *= param[SNFitParamMax];
-
     // compute the chi2
+    double padChargeFit = mPadChargeFit[iPad++] * param[SNFitParamMax];
     double delta = padChargeFit - pad.charge();
     chi2 += delta * delta / pad.charge();
   }
@@ -1696,6 +1727,19 @@ float ClusterFinderOriginal::chargeIntegration(double x, double y, const PadOrig
   return mMathieson->integrate(xPad - pad.dx(), yPad - pad.dy(), xPad + pad.dx(), yPad + pad.dy());
 }
 
+//_________________________________________________________________________________________________
+void ClusterFinderOriginal::resizeIntegrationBuffers(size_t size) const
+{
+  /// make sure the buffers used to integrate the Mathieson over several pads at once are large enough
+  if (mIntegrals.size() < size) {
+    mXMin.resize(size);
+    mXMax.resize(size);
+    mYMin.resize(size);
+    mYMax.resize(size);
+    mIntegrals.resize(size);
+  }
+}
+
 //_________________________________________________________________________________________________
 void ClusterFinderOriginal::split(const TH2D& histMLEM, const std::vector<double>& coef)
 {
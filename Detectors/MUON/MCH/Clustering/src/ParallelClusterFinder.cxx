@@ -0,0 +1,139 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ParallelClusterFinder.cxx
+/// \brief Implementation of a class to reconstruct the clusters of independent preclusters in parallel threads
+
+#include "MCHClustering/ParallelClusterFinder.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include <TDirectory.h>
+#include <TROOT.h>
+
+namespace o2::mch
+{
+
+//_________________________________________________________________________________________________
+void ParallelClusterFinder::init(int nThreads, bool run2Config)
+{
+  /// create and initialize one clusterizer per thread
+  nThreads = std::max(nThreads, 1);
+  if (nThreads > 1) {
+    // the clusterizers use ROOT histograms
+    ROOT::EnableThreadSafety();
+  }
+  mWorkers.clear();
+  for (int i = 0; i < nThreads; ++i) {
+    mWorkers.emplace_back(std::make_unique<Worker>());
+    mWorkers.back()->clusterFinder.init(run2Config);
+  }
+}
+
+//_________________________________________________________________________________________________
+void ParallelClusterFinder::deinit()
+{
+  /// deinitialize the clusterizers
+  for (auto& worker : mWorkers) {
+    worker->clusterFinder.deinit();
+  }
+  mWorkers.clear();
+}
+
+//_________________________________________________________________________________________________
+void ParallelClusterFinder::findClusters(gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits)
+{
+  /// reconstruct the clusters of every precluster independently, distributing the preclusters over the threads
+  /// the results of the previous call are discarded, the errors are accumulated
+
+  mResults.assign(preClusters.size(), Result{});
+  for (auto& worker : mWorkers) {
+    worker->clusters.clear();
+    worker->usedDigits.clear();
+  }
+  mNextPreCluster = 0;
+
+  int nThreads = std::min(mWorkers.size(), preClusters.size());
+  if (nThreads <= 1) {
+    process(0, preClusters, digits);
+  } else {
+    std::vector<std::thread> threads{};
+    std::vector<std::exception_ptr> exceptions(nThreads);
+    for (int i = 0; i < nThreads; ++i) {
+      threads.emplace_back([this, i, preClusters, digits, &exceptions]() {
+        try {
+          process(i, preClusters, digits);
+        } catch (...) {
+          exceptions[i] = std::current_exception();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto& exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+  }
+
+  for (auto& worker : mWorkers) {
+    mErrorMap.add(worker->clusterFinder.getErrorMap());
+    worker->clusterFinder.getErrorMap().clear();
+  }
+}
+
+//_________________________________________________________________________________________________
+gsl::span<const Cluster> ParallelClusterFinder::getClusters(size_t iPreCluster) const
+{
+  /// return the clusters reconstructed from the given precluster
+  /// the cluster index in the unique ID and the reference to the digits are relative to this precluster
+  const auto& result = mResults[iPreCluster];
+  return {mWorkers[result.worker]->clusters.data() + result.firstCluster, result.nClusters};
+}
+
+//_________________________________________________________________________________________________
+gsl::span<const Digit> ParallelClusterFinder::getUsedDigits(size_t iPreCluster) const
+{
+  /// return the digits used in the clusters reconstructed from the given precluster
+  const auto& result = mResults[iPreCluster];
+  return {mWorkers[result.worker]->usedDigits.data() + result.firstDigit, result.nDigits};
+}
+
+//_________________________________________________________________________________________________
+void ParallelClusterFinder::process(int iWorker, gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits)
+{
+  /// clusterize the preclusters not yet taken by another thread
+
+  // do not attach the histograms created by the clusterizer to the current directory
+  TDirectory::TContext context(nullptr);
+
+  auto& worker = *mWorkers[iWorker];
+  for (auto iPreCluster = mNextPreCluster++; iPreCluster < preClusters.size(); iPreCluster = mNextPreCluster++) {
+    const auto& preCluster = preClusters[iPreCluster];
+    worker.clusterFinder.reset();
+    worker.clusterFinder.findClusters(digits.subspan(preCluster.firstDigit, preCluster.nDigits));
+
+    auto& result = mResults[iPreCluster];
+    result.worker = iWorker;
+    result.firstCluster = worker.clusters.size();
+    result.nClusters = worker.clusterFinder.getClusters().size();
+    result.firstDigit = worker.usedDigits.size();
+    result.nDigits = worker.clusterFinder.getUsedDigits().size();
+    worker.clusters.insert(worker.clusters.end(), worker.clusterFinder.getClusters().begin(), worker.clusterFinder.getClusters().end());
+    worker.usedDigits.insert(worker.usedDigits.end(), worker.clusterFinder.getUsedDigits().begin(), worker.clusterFinder.getUsedDigits().end());
+  }
+}
+
+} // namespace o2::mch
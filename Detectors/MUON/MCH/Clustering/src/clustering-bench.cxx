@@ -0,0 +1,197 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file clustering-bench.cxx
+/// \brief Benchmark of the parallel clustering on the preclusters recorded with ClusterFinderGEM::dumpPreCluster
+///
+/// The preclusters are clusterized with one thread and with the requested number of threads,
+/// and the outputs of the two configurations are checked to be identical.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "DataFormatsMCH/Cluster.h"
+#include "DataFormatsMCH/Digit.h"
+#include "Framework/Logger.h"
+#include "MCHBase/PreCluster.h"
+#include "MCHClustering/ParallelClusterFinder.h"
+#include "MCHMappingInterface/Segmentation.h"
+
+namespace po = boost::program_options;
+using namespace o2::mch;
+
+//____________________________________________________________________________________
+template <typename T>
+bool readArray(std::ifstream& in, std::vector<T>& data)
+{
+  /// read an array written by ClusterDump, i.e. its size followed by its content
+  long size = 0;
+  if (!in.read(reinterpret_cast<char*>(&size), sizeof(long)) || size < 0) {
+    return false;
+  }
+  data.resize(size);
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(data.data()), sizeof(T) * size));
+}
+
+//____________________________________________________________________________________
+bool readPreClusters(const std::string& inFile, std::vector<PreCluster>& preClusters, std::vector<Digit>& digits)
+{
+  /// read the preclusters from the dump file and convert the pads back into digits
+
+  std::ifstream in(inFile, std::ios::binary);
+  if (!in) {
+    LOG(error) << "opening file " << inFile << " failed";
+    return false;
+  }
+
+  std::vector<uint32_t> header{};
+  std::vector<double> x{}, y{}, dx{}, dy{}, charge{};
+  std::vector<int16_t> saturated{}, cathode{};
+  std::vector<uint32_t> adc{};
+  while (readArray(in, header)) {
+    if (header.size() != 6 || !readArray(in, x) || !readArray(in, y) || !readArray(in, dx) || !readArray(in, dy) ||
+        !readArray(in, charge) || !readArray(in, saturated) || !readArray(in, cathode) || !readArray(in, adc)) {
+      LOG(error) << "the file " << inFile << " is not a valid precluster dump";
+      return false;
+    }
+    uint32_t nPads = header[4];
+    int deId = header[5];
+    if (x.size() != nPads || cathode.size() != nPads || adc.size() != nPads) {
+      LOG(error) << "inconsistent number of pads in precluster " << header[2];
+      return false;
+    }
+    const auto& segmentation = o2::mch::mapping::segmentation(deId);
+    auto firstDigit = digits.size();
+    for (uint32_t iPad = 0; iPad < nPads; ++iPad) {
+      int bPad(-1), nbPad(-1);
+      segmentation.findPadPairByPosition(x[iPad], y[iPad], bPad, nbPad);
+      int padId = (cathode[iPad] == 0) ? bPad : nbPad;
+      if (padId < 0) {
+        LOG(error) << "pad not found at (" << x[iPad] << ", " << y[iPad] << ") in DE " << deId;
+        return false;
+      }
+      digits.emplace_back(deId, padId, adc[iPad], 0, 1, saturated[iPad] != 0);
+    }
+    preClusters.push_back({static_cast<uint32_t>(firstDigit), nPads});
+  }
+
+  return true;
+}
+
+//____________________________________________________________________________________
+double runClustering(int nThreads, int nLoops, gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits,
+                     std::vector<Cluster>& clusters, std::vector<Digit>& usedDigits)
+{
+  /// clusterize the preclusters nLoops times with nThreads threads and return the average time in ms
+  /// the clusters and the digits used in the clustering are stored in the order of the preclusters
+
+  ParallelClusterFinder clusterFinder{};
+  clusterFinder.init(nThreads, false);
+
+  std::chrono::duration<double, std::milli> time{};
+  for (int iLoop = 0; iLoop < nLoops; ++iLoop) {
+    auto tStart = std::chrono::high_resolution_clock::now();
+    clusterFinder.findClusters(preClusters, digits);
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    time += tEnd - tStart;
+  }
+
+  clusters.clear();
+  usedDigits.clear();
+  for (size_t iPreCluster = 0; iPreCluster < preClusters.size(); ++iPreCluster) {
+    auto newClusters = clusterFinder.getClusters(iPreCluster);
+    clusters.insert(clusters.end(), newClusters.begin(), newClusters.end());
+    auto newDigits = clusterFinder.getUsedDigits(iPreCluster);
+    usedDigits.insert(usedDigits.end(), newDigits.begin(), newDigits.end());
+  }
+
+  clusterFinder.deinit();
+
+  return time.count() / nLoops;
+}
+
+//____________________________________________________________________________________
+bool isIdentical(const std::vector<Cluster>& clusters1, const std::vector<Cluster>& clusters2,
+                 const std::vector<Digit>& digits1, const std::vector<Digit>& digits2)
+{
+  /// check that the two sets of clusters are bitwise identical and refer to the same digits
+  return clusters1.size() == clusters2.size() && digits1 == digits2 &&
+         std::memcmp(clusters1.data(), clusters2.data(), clusters1.size() * sizeof(Cluster)) == 0;
+}
+
+//____________________________________________________________________________________
+int main(int argc, char** argv)
+{
+  po::variables_map vm;
+  po::options_description usage("Usage");
+
+  std::string inFile;
+  int nThreads;
+  int nLoops;
+
+  // clang-format off
+  usage.add_options()
+      ("help,h", "produce help message")
+      ("infile,f", po::value<std::string>(&inFile)->required(), "input file of preclusters dumped by the GEM clustering")
+      ("n-threads,n", po::value<int>(&nThreads)->default_value(4), "number of threads to compare with the sequential clustering")
+      ("loops,l", po::value<int>(&nLoops)->default_value(1), "number of times the preclusters are clusterized")
+        ;
+  // clang-format on
+
+  po::options_description cmdline;
+  cmdline.add(usage);
+
+  po::store(po::command_line_parser(argc, argv).options(cmdline).run(), vm);
+
+  if (vm.count("help")) {
+    LOG(info) << "This program benchmarks the parallel clustering on recorded preclusters";
+    LOG(info) << usage;
+    return 2;
+  }
+
+  try {
+    po::notify(vm);
+  } catch (boost::program_options::error& e) {
+    LOG(error) << e.what();
+    exit(1);
+  }
+
+  std::vector<PreCluster> preClusters{};
+  std::vector<Digit> digits{};
+  if (!readPreClusters(inFile, preClusters, digits)) {
+    exit(2);
+  }
+  LOG(info) << "read " << preClusters.size() << " preclusters with " << digits.size() << " digits";
+
+  nLoops = std::max(nLoops, 1);
+  std::vector<Cluster> clusters1{}, clustersN{};
+  std::vector<Digit> usedDigits1{}, usedDigitsN{};
+  auto time1 = runClustering(1, nLoops, preClusters, digits, clusters1, usedDigits1);
+  LOG(info) << "1 thread: " << clusters1.size() << " clusters in " << time1 << " ms";
+  auto timeN = runClustering(nThreads, nLoops, preClusters, digits, clustersN, usedDigitsN);
+  LOG(info) << nThreads << " threads: " << clustersN.size() << " clusters in " << timeN << " ms (speedup "
+            << ((timeN > 0.) ? time1 / timeN : 0.) << ")";
+
+  if (!isIdentical(clusters1, clustersN, usedDigits1, usedDigitsN)) {
+    LOG(error) << "the clusters found with " << nThreads << " threads differ from the sequential ones";
+    return 3;
+  }
+  LOG(info) << "the outputs are identical";
+
+  return 0;
+}
@@ -30,6 +30,7 @@ struct DigitFilterParam : public o2::conf::ConfigurableParamHelper<DigitFilterPa
   bool rejectBackground = true; ///< attempts to reject background (loose background selection, don't kill signal)
   bool selectSignal = false;    ///< attempts to select only signal (strict background selection, might loose signal)
   int timeOffset = 120;         ///< digit time calibration offset
+  int nThreads = 1;             ///< number of threads used to apply the selection to the digits
   /// mask to reject digits based on the statusmap (0 = no rejection)
   uint32_t statusMask = StatusMap::kBadPedestal | StatusMap::kRejectList | StatusMap::kBadHV;
 
@@ -15,6 +15,7 @@
 #include "Framework/Logger.h"
 #include "MCHDigitFiltering/DigitFilterParam.h"
 #include "MCHStatus/StatusMap.h"
+#include <algorithm>
 #include <functional>
 #include <gsl/span>
 #include <vector>
@@ -114,13 +115,17 @@ DigitFilter createBadChannelFilter(const StatusMap& statusMap,
   auto rejectList = applyMask(statusMap, statusMask);
   report(rejectList, statusMask);
 
+  // sort the pads of each detection element once, to look them up by bisection
+  for (auto& [deID, pads] : rejectList) {
+    std::sort(pads.begin(), pads.end());
+  }
+
   return [rejectList](const o2::mch::Digit& digit) -> bool {
     bool goodChannel{true};
-    auto deID = digit.getDetID();
     auto it = rejectList.find(digit.getDetID());
     if (it != rejectList.end()) {
       // channel is good if it's not found in the rejectlist
-      goodChannel = std::find(it->second.begin(), it->second.end(), digit.getPadID()) == it->second.end();
+      goodChannel = !std::binary_search(it->second.begin(), it->second.end(), digit.getPadID());
     }
     return goodChannel;
   };
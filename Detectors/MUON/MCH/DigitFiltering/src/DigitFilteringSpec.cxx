@@ -26,6 +26,7 @@
 #include "SimulationDataFormat/MCCompLabel.h"
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include <fmt/format.h>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <string>
@@ -48,6 +49,7 @@ class DigitFilteringTask
     mRejectBackground = DigitFilterParam::Instance().rejectBackground;
     mStatusMask = DigitFilterParam::Instance().statusMask;
     mTimeCalib = DigitFilterParam::Instance().timeOffset;
+    mNThreads = std::max(1, DigitFilterParam::Instance().nThreads);
     auto stop = [this]() {
       LOG(info) << "digit filtering duration = "
                 << std::chrono::duration<double, std::milli>(mElapsedTime).count() << " ms";
@@ -114,6 +116,17 @@ class DigitFilteringTask
       // the clustering resolution will suffer.
       // That's why we only apply the "reject background" filter, which
       // is a loose background cut that does not penalize the signal
+
+      // the selection is evaluated for all the digits first, possibly in parallel,
+      // and the selected digits are then copied in their original order
+      mIsSelected.resize(iDigits.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNThreads)
+#endif
+      for (size_t i = 0; i < iDigits.size(); i++) {
+        mIsSelected[i] = mIsGoodDigit(iDigits[i]);
+      }
+
       int cursor{0};
       for (const auto& irof : iRofs) {
         const auto digits = iDigits.subspan(irof.getFirstIdx(), irof.getNEntries());
@@ -121,7 +134,7 @@ class DigitFilteringTask
         // filter the digits from the current ROF
         for (auto i = 0; i < digits.size(); i++) {
           const auto& d = digits[i];
-          if (mIsGoodDigit(d)) {
+          if (mIsSelected[i + irof.getFirstIdx()]) {
             oDigits.emplace_back(d);
             if (iLabels) {
               oLabels->addElements(oLabels->getIndexedSize(), iLabels->getLabels(i + irof.getFirstIdx()));
@@ -167,7 +180,9 @@ class DigitFilteringTask
   int mMinADC{1};
   int32_t mTimeCalib{0};
   uint32_t mStatusMask{0};
+  int mNThreads{1};
   DigitFilter mIsGoodDigit;
+  std::vector<uint8_t> mIsSelected; ///< selection flag of each input digit
   std::chrono::duration<double> mElapsedTime{};
 };
 
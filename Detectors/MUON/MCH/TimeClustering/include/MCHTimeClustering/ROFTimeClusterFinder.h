@@ -39,7 +39,14 @@ class ROFTimeClusterFinder
   ROFTimeClusterFinder(gsl::span<const o2::mch::ROFRecord> rofs, gsl::span<const o2::mch::Digit> digits, uint32_t timeClusterSize, uint32_t nBins, bool improvePeakSearch, bool debug);
   ~ROFTimeClusterFinder() = default;
 
+  /// set the number of threads used to select the signal-like digits for the peak search
+  void setNThreads(int n) { mNThreads = n < 1 ? 1 : n; }
+
   /// process the digit ROFs and create the time clusters
+  ///
+  /// The time histogram is filled ROF by ROF and the time clusters are emitted as soon as
+  /// the bins in the peak search window around them are complete, instead of waiting for the
+  /// whole histogram to be filled
   void process();
 
   /// return the vector of time-cluster ROFs
@@ -76,16 +83,25 @@ class ROFTimeClusterFinder
   uint32_t mNbinsInOneTF;     ///< maximum number of peak search bins in one time frame
   DigitFilter mIsGoodDigit;   ///< function to select only digits that are likely signal
   bool mImprovePeakSearch;    ///< whether to only use signal-like digits in the peak search
+  int mNThreads{1};           ///< number of threads for the selection of the signal-like digits
 
-  /// fill the time histogram for the peak search algorithm
+  /// initialize the time histogram for the peak search algorithm
   void initTimeBins();
-  /// search for the next peak in the time histogram
-  int32_t getNextPeak();
+  /// count the signal-like digits of each input ROF
+  void countDigitsPS();
+  /// add the digit ROF to the time histogram, return the bin index or -1 if the ROF cannot be added
+  int32_t fillTimeBin(size_t iRof);
+  /// search for the peaks that can be found with the bins up to lastCompleteBin, and store the corresponding ROFs
+  void findPeaks(int32_t lastCompleteBin);
+  /// search for the next peak in the time histogram, among the candidates up to lastCandidate
+  int32_t getNextPeak(int32_t lastCandidate);
   /// create an output ROF containing all the digits in the [firstBin,lastBin] range of the time histogram
   void storeROF(int32_t firstBin, int32_t lastBin);
 
-  std::vector<TimeBin> mTimeBins; ///< time histogram for the peak search algorithm
-  int32_t mLastSavedTimeBin;      ///< index of the last bin that has been stored in the output ROFs
+  std::vector<TimeBin> mTimeBins;      ///< time histogram for the peak search algorithm
+  std::vector<uint32_t> mNDigitsPS;    ///< number of digits for the peak search in each input ROF
+  int32_t mLastSavedTimeBin;           ///< index of the last bin that has been stored in the output ROFs
+  int32_t mNextPeakCandidate{0};       ///< index of the first bin not yet checked as peak candidate
 
   gsl::span<const o2::mch::ROFRecord> mInputROFs; ///< input digit ROFs
   gsl::span<const o2::mch::Digit> mDigits;        ///< input digits
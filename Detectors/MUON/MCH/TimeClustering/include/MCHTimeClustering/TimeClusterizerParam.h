@@ -30,6 +30,7 @@ struct TimeClusterizerParam : public o2::conf::ConfigurableParamHelper<TimeClust
   int peakSearchNbins = 5;          ///< number of time bins for the peak search algorithm (must be an odd number >= 3)
   int minDigitsPerROF = 0;          ///< minimum number of digits per ROF (below that threshold ROF is discarded)
   bool peakSearchSignalOnly = true; ///< only use signal-like hits in peak search
+  int nThreads = 1;                 ///< number of threads for the selection of the signal-like hits in the peak search
   bool irFramesOnly = false;        ///< only output ROFs that overlap one of the IRFrames (provided externally, e.g. by ITS) @see MCHROFFiltering/IRFrameFilter
 
   float rofRejectionFraction = 0; ///< fraction of output (i.e. time-clusterized) ROFs to discard. If 0 (default) keep them all. WARNING: use a non zero value only at Pt2 for sync reco, if needed.
@@ -11,10 +11,15 @@
 
 #include "MCHTimeClustering/ROFTimeClusterFinder.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fmt/format.h>
 #include "Framework/Logger.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mch
@@ -64,76 +69,93 @@ void ROFTimeClusterFinder::initTimeBins()
     mNbinsInOneTF = maxNTimeBins;
   }
   mTimeBins.resize(mNbinsInOneTF);
+}
 
-  // store the number of digits in each bin
-  int64_t previousROFbc = -1;
-  for (size_t iRof = 0; iRof < mInputROFs.size(); iRof++) {
-    const auto& rof = mInputROFs[iRof];
-    const auto& ir = rof.getBCData();
-    auto rofBc = ir.differenceInBC(mFirstIR);
-    auto binIdx = rofBc / mBinWidth;
-
-    // sanity checks: ROFs must be ordered in time and not be empty
-    if (rofBc <= previousROFbc || rofBc > tfSize) {
-      LOGP(alarm, "Wrong ROF ordering");
-      break;
-    }
-    previousROFbc = rofBc;
-    if (rof.getNEntries() < 1) {
-      LOGP(alarm, "Empty ROF");
-      break;
-    }
-
-    // stop here if the number of bins exceeds the limit
-    if (binIdx >= mNbinsInOneTF) {
-      break;
-    }
+//_________________________________________________________________________________________________
 
-    auto& timeBin = mTimeBins[binIdx];
+void ROFTimeClusterFinder::countDigitsPS()
+{
+  mNDigitsPS.resize(mInputROFs.size());
 
-    if (timeBin.mFirstIdx < 0) {
-      timeBin.mFirstIdx = iRof;
+  if (!mImprovePeakSearch) {
+    for (size_t iRof = 0; iRof < mInputROFs.size(); iRof++) {
+      mNDigitsPS[iRof] = mInputROFs[iRof].getNEntries();
     }
-    timeBin.mLastIdx = iRof;
+    return;
+  }
 
-    int nDigitsPS = 0;
-    if (mImprovePeakSearch) {
+  // the digit selection is independent for each ROF, and is the most expensive part of the peak search
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, 16) num_threads(mNThreads)
+#endif
+  for (size_t iRof = 0; iRof < mInputROFs.size(); iRof++) {
+    const auto& rof = mInputROFs[iRof];
+    uint32_t nDigitsPS = 0;
+    if (rof.getNEntries() > 0) {
       auto rofDigits = mDigits.subspan(rof.getFirstIdx(), rof.getNEntries());
       for (auto& digit : rofDigits) {
         if (mIsGoodDigit(digit)) {
           nDigitsPS += 1;
         }
       }
-    } else {
-      nDigitsPS = rof.getNEntries();
     }
-    timeBin.mNDigitsPS += nDigitsPS;
+    mNDigitsPS[iRof] = nDigitsPS;
   }
+}
 
-  if (mDebug) {
-    std::cout << "Peak search histogram:" << std::endl;
-    for (int32_t i = 0; i < mNbinsInOneTF; i++) {
-      if (mTimeBins[i].mFirstIdx >= 0) {
-        auto nDigits = mInputROFs[mTimeBins[i].mLastIdx].getLastIdx() - mInputROFs[mTimeBins[i].mFirstIdx].getFirstIdx() + 1;
-        std::cout << fmt::format("bin {}: {}/{}", i, mTimeBins[i].mNDigitsPS, nDigits) << std::endl;
-      }
-    }
+//_________________________________________________________________________________________________
+
+int32_t ROFTimeClusterFinder::fillTimeBin(size_t iRof)
+{
+  const auto& rof = mInputROFs[iRof];
+  const auto& ir = rof.getBCData();
+  auto tfSize = mInputROFs.back().getBCData().differenceInBC(mInputROFs.front().getBCData());
+  auto rofBc = ir.differenceInBC(mInputROFs.front().getBCData());
+  auto binIdx = rofBc / mBinWidth;
+
+  // sanity checks: ROFs must be ordered in time and not be empty
+  auto previousROFbc = iRof > 0 ? mInputROFs[iRof - 1].getBCData().differenceInBC(mInputROFs.front().getBCData()) : -1;
+  if (rofBc <= previousROFbc || rofBc > tfSize) {
+    LOGP(alarm, "Wrong ROF ordering");
+    return -1;
+  }
+  if (rof.getNEntries() < 1) {
+    LOGP(alarm, "Empty ROF");
+    return -1;
+  }
+
+  // stop here if the number of bins exceeds the limit
+  if (binIdx >= mNbinsInOneTF) {
+    return -1;
   }
+
+  auto& timeBin = mTimeBins[binIdx];
+
+  if (timeBin.mFirstIdx < 0) {
+    timeBin.mFirstIdx = iRof;
+  }
+  timeBin.mLastIdx = iRof;
+  timeBin.mNDigitsPS += mNDigitsPS[iRof];
+
+  return binIdx;
 }
 
 //_________________________________________________________________________________________________
 
-int32_t ROFTimeClusterFinder::getNextPeak()
+int32_t ROFTimeClusterFinder::getNextPeak(int32_t lastCandidate)
 {
   int32_t sPadding = mNbinsInOneWindow / 2;
 
+  // the bins before mNextPeakCandidate have already been rejected, with complete neighbours
+  int32_t firstCandidate = std::max(mLastSavedTimeBin + sPadding + 1, mNextPeakCandidate);
+
   if (mDebug) {
-    std::cout << "Searching peak from " << mLastSavedTimeBin + 1 << std::endl;
+    std::cout << "Searching peak from " << firstCandidate << " to " << lastCandidate << std::endl;
   }
 
   // loop over the bins and search for local maxima
   // a local maxima is defined as a bin tht is higher than all the surrounding 4 bins (2 below and 2 above)
-  for (int32_t i = mLastSavedTimeBin + sPadding + 1; i < mNbinsInOneTF; i++) {
+  for (int32_t i = firstCandidate; i <= lastCandidate; i++) {
     auto& peak = mTimeBins[i];
     if (peak.empty()) {
       continue;
@@ -164,13 +186,47 @@ int32_t ROFTimeClusterFinder::getNextPeak()
       std::cout << fmt::format("new peak found at bin {}, entries = {}/{}", i, peak.mNDigitsPS, nDigits) << std::endl;
     }
 
+    mNextPeakCandidate = i + 1;
     return i;
   }
+  mNextPeakCandidate = std::max(firstCandidate, lastCandidate + 1);
   return -1;
 }
 
 //_________________________________________________________________________________________________
 
+void ROFTimeClusterFinder::findPeaks(int32_t lastCompleteBin)
+{
+  // a peak candidate can only be checked once all the bins in its search window are complete
+  int32_t sPadding = mNbinsInOneWindow / 2;
+  int32_t nBins = mNbinsInOneTF;
+  int32_t lastCandidate = (lastCompleteBin >= nBins - 1) ? nBins - 1 : lastCompleteBin - sPadding;
+
+  int32_t peak{-1};
+  while ((peak = getNextPeak(lastCandidate)) >= 0) {
+    int32_t peakStart = peak - mNbinsInOneWindow / 2;
+    int32_t peakEnd = peakStart + mNbinsInOneWindow - 1;
+
+    // peak found, we add the corresponding rof(s)
+    // first we fill the gap between the last peak and the current one, if needed
+    if (mDebug) {
+      std::cout << fmt::format("peakStart={}  mLastSavedTimeBin={}", peakStart, mLastSavedTimeBin) << std::endl;
+    }
+    while ((peakStart - mLastSavedTimeBin) > 1) {
+      int32_t firstBin = mLastSavedTimeBin + 1;
+      int32_t lastBin = firstBin + mNbinsInOneWindow - 1;
+      if (lastBin >= peakStart) {
+        lastBin = peakStart - 1;
+      }
+
+      storeROF(firstBin, lastBin);
+    }
+    storeROF(peakStart, peakEnd);
+  }
+}
+
+//_________________________________________________________________________________________________
+
 void ROFTimeClusterFinder::storeROF(int32_t firstBin, int32_t lastBin)
 {
   if (mDebug) {
@@ -241,29 +297,34 @@ void ROFTimeClusterFinder::process()
   }
 
   initTimeBins();
+  countDigitsPS();
   mOutputROFs.clear();
 
   mLastSavedTimeBin = -1;
-  int32_t peak{-1};
-  while ((peak = getNextPeak()) >= 0) {
-    int32_t peakStart = peak - mNbinsInOneWindow / 2;
-    int32_t peakEnd = peakStart + mNbinsInOneWindow - 1;
-
-    // peak found, we add the corresponding rof(s)
-    // first we fill the gap between the last peak and the current one, if needed
-    if (mDebug) {
-      std::cout << fmt::format("peakStart={}  mLastSavedTimeBin={}", peakStart, mLastSavedTimeBin) << std::endl;
+  mNextPeakCandidate = 0;
+  int32_t currentBin{-1};
+  for (size_t iRof = 0; iRof < mInputROFs.size(); iRof++) {
+    auto binIdx = fillTimeBin(iRof);
+    if (binIdx < 0) {
+      break;
     }
-    while ((peakStart - mLastSavedTimeBin) > 1) {
-      int32_t firstBin = mLastSavedTimeBin + 1;
-      int32_t lastBin = firstBin + mNbinsInOneWindow - 1;
-      if (lastBin >= peakStart) {
-        lastBin = peakStart - 1;
-      }
+    // the bins before the one of the current ROF will not change anymore
+    if (binIdx > currentBin) {
+      findPeaks(binIdx - 1);
+      currentBin = binIdx;
+    }
+  }
+  // all the bins are now complete
+  findPeaks(int32_t(mNbinsInOneTF) - 1);
 
-      storeROF(firstBin, lastBin);
+  if (mDebug) {
+    std::cout << "Peak search histogram:" << std::endl;
+    for (int32_t i = 0; i < mNbinsInOneTF; i++) {
+      if (mTimeBins[i].mFirstIdx >= 0) {
+        auto nDigits = mInputROFs[mTimeBins[i].mLastIdx].getLastIdx() - mInputROFs[mTimeBins[i].mFirstIdx].getFirstIdx() + 1;
+        std::cout << fmt::format("bin {}: {}/{}", i, mTimeBins[i].mNDigitsPS, nDigits) << std::endl;
+      }
     }
-    storeROF(peakStart, peakEnd);
   }
 }
 
@@ -68,6 +68,7 @@ class TimeClusterFinderTask
     mIRFramesOnly = param.irFramesOnly;
     mDebug = ic.options().get<bool>("mch-debug");
     mROFRejectionFraction = param.rofRejectionFraction;
+    mNThreads = param.nThreads;
 
     if (mDebug) {
       fair::Logger::SetConsoleColor(true);
@@ -92,6 +93,7 @@ class TimeClusterFinderTask
     LOGP(info, "PeakSearchSignalOnly  : {}", mPeakSearchSignalOnly);
     LOGP(info, "IRFramesOnly          : {}", mIRFramesOnly);
     LOGP(info, "ROFRejectionFraction  : {}", mROFRejectionFraction);
+    LOGP(info, "NThreads              : {}", mNThreads);
 
     auto stop = [this]() {
       if (mTFcount) {
@@ -116,6 +118,7 @@ class TimeClusterFinderTask
     auto digits = pc.inputs().get<gsl::span<o2::mch::Digit>>("digits");
 
     o2::mch::ROFTimeClusterFinder rofProcessor(rofs, digits, mTimeClusterWidth, mNbinsInOneWindow, mPeakSearchSignalOnly, mDebug);
+    rofProcessor.setNThreads(mNThreads);
 
     if (mDebug) {
       LOGP(warning, "{:=>60} ", fmt::format("{:6d} Input ROFS", rofs.size()));
@@ -196,6 +199,7 @@ class TimeClusterFinderTask
   int mTFcount{0};             ///< number of processed time frames
   int mDebug{0};               ///< verbosity flag
   int mMinDigitPerROF;         ///< minimum digit per ROF threshold
+  int mNThreads{1};            ///< number of threads for the peak search
   bool mPeakSearchSignalOnly;  ///< only use signal-like hits in peak search
   bool mOnlyTrackable;         ///< only keep ROFs that are trackable
   bool mIRFramesOnly;          ///< only keep ROFs that overlap some IRFrame
@@ -0,0 +1,82 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FieldLUT.h
+/// \brief Definition of a lookup table of the magnetic field in the muon arm
+///
+/// \author Philippe Pillot, Subatech
+
+#ifndef O2_MCH_FIELDLUT_H_
+#define O2_MCH_FIELDLUT_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace o2
+{
+namespace mch
+{
+
+/// Magnetic field sampled on a regular 3D grid covering the muon arm, from the vertex region to MID,
+/// and interpolated trilinearly between the nodes. It is meant to replace the calls to the field map
+/// during the track extrapolation when the accuracy of the interpolation is sufficient
+class FieldLUT
+{
+ public:
+  /// deviations of the interpolated field with respect to the field map
+  struct Accuracy {
+    double maxDeviation = 0.; ///< maximum deviation of the field (kG)
+    double rmsDeviation = 0.; ///< RMS of the deviation of the field (kG)
+    double maxField = 0.;     ///< maximum field encountered in the test points (kG)
+  };
+
+  FieldLUT() = default;
+  ~FieldLUT() = default;
+
+  FieldLUT(const FieldLUT&) = delete;
+  FieldLUT& operator=(const FieldLUT&) = delete;
+  FieldLUT(FieldLUT&&) = default;
+  FieldLUT& operator=(FieldLUT&&) = default;
+
+  void fill();
+  /// release the table
+  void clear()
+  {
+    mField.clear();
+    mField.shrink_to_fit();
+  }
+
+  /// return true if the table has been filled
+  bool isFilled() const { return !mField.empty(); }
+
+  bool field(const double* x, double* b) const;
+
+  Accuracy checkAccuracy(int nPoints, unsigned int seed = 0) const;
+
+  static constexpr double SXYMax = 400.; ///< half size of the table in x and y (cm)
+  static constexpr double SZMin = -1720.; ///< lower edge of the table in z (cm)
+  static constexpr double SZMax = 10.;    ///< upper edge of the table in z (cm)
+  static constexpr double SStep = 10.;    ///< distance between the nodes in each direction (cm)
+
+ private:
+  static constexpr int SNXY = static_cast<int>(2. * SXYMax / SStep) + 1;     ///< number of nodes in x and y
+  static constexpr int SNZ = static_cast<int>((SZMax - SZMin) / SStep) + 1; ///< number of nodes in z
+
+  /// return the index of the first field component at the given node
+  static std::size_t index(int ix, int iy, int iz) { return 3 * ((static_cast<std::size_t>(iz) * SNXY + iy) * SNXY + ix); }
+
+  std::vector<float> mField{}; ///< field components at the nodes
+};
+
+} // namespace mch
+} // namespace o2
+
+#endif // O2_MCH_FIELDLUT_H_
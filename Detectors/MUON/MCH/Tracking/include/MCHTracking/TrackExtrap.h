@@ -21,6 +21,8 @@
 
 #include <TMatrixD.h>
 
+#include "MCHTracking/FieldLUT.h"
+
 namespace o2
 {
 namespace mch
@@ -49,6 +51,10 @@ class TrackExtrap
   /// Switch to Runge-Kutta extrapolation v2
   static void useExtrapV2(bool extrapV2 = true) { sExtrapV2 = extrapV2; }
 
+  /// Return true if the field is interpolated from the lookup table during the extrapolation
+  static bool isFieldLUTUsed() { return sFieldLUT.isFilled(); }
+  static void checkFieldLUT(int nTracks);
+
   static double getImpactParamFromBendingMomentum(double bendingMomentum);
   static double getBendingMomentumFromImpactParam(double impactParam);
 
@@ -116,6 +122,7 @@ class TrackExtrap
   static bool extrapToZRungekutta(TrackParam& trackParam, double zEnd);
   static bool extrapToZRungekuttaV2(TrackParam& trackParam, double zEnd);
   static bool extrapOneStepRungekutta(double charge, double step, const double* vect, double* vout);
+  static void getField(const double* x, double* b);
 
   static constexpr double SMuMass = 0.105658;                         ///< Muon mass (GeV/c2)
   static constexpr double SAbsZBeg = -90.;                            ///< Position of the begining of the absorber (cm)
@@ -139,9 +146,11 @@ class TrackExtrap
 
   static double sSimpleBValue; ///< Magnetic field value at the centre
   static bool sFieldON;        ///< true if the field is switched ON
+  static FieldLUT sFieldLUT;   ///< lookup table of the field, used if filled
 
   static std::size_t sNCallExtrapToZCov; ///< number of times the method extrapToZCov(...) is called
   static std::size_t sNCallField;        ///< number of times the method Field(...) is called
+  static std::size_t sNCallFieldLUT;     ///< number of times the field is taken from the lookup table
 };
 
 } // namespace mch
@@ -22,6 +22,7 @@
 #include <unordered_set>
 #include <list>
 #include <array>
+#include <memory>
 #include <vector>
 #include <utility>
 
@@ -37,12 +38,14 @@ namespace o2
 namespace mch
 {
 
+class ClusterGrid;
+
 /// Class to reconstruct tracks
 class TrackFinder
 {
  public:
-  TrackFinder() = default;
-  ~TrackFinder() = default;
+  TrackFinder();
+  ~TrackFinder();
 
   TrackFinder(const TrackFinder&) = delete;
   TrackFinder& operator=(const TrackFinder&) = delete;
@@ -107,6 +110,7 @@ class TrackFinder
                                           std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
   void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
 
+  void findClusterCandidates(const TrackParam& param, int deId, std::vector<const Cluster*>& clusters) const;
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
   bool tryOneClusterFast(const TrackParam& param, const Cluster& cluster);
   double tryOneCluster(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
@@ -127,6 +131,8 @@ class TrackFinder
   static constexpr double SMaxNonBendingDistanceToTrack = 1.;
   ///< maximum distance to the track to search for compatible cluster(s) in bending direction
   static constexpr double SMaxBendingDistanceToTrack = 1.;
+  ///< margin added to the search window of cluster candidates in the grids to absorb rounding errors
+  static constexpr double SGridMargin = 1.e-3;
   static constexpr double SMinBendingMomentum = 0.8; ///< minimum value (GeV/c) of momentum in bending plane
   /// z position of the chambers
   static constexpr double SDefaultChamberZ[10] = {-526.16, -545.24, -676.4, -695.4, -967.5,
@@ -140,6 +146,8 @@ class TrackFinder
 
   /// array of pointers to the lists of clusters per DE
   std::array<std::vector<std::pair<const int, const std::list<const Cluster*>*>>, 32> mClusters{};
+  /// 2D grids of clusters per DE to select the cluster candidates around the tracks
+  std::unordered_map<int, std::unique_ptr<ClusterGrid>> mClusterGrids{};
 
   std::list<Track> mTracks{}; ///< list of reconstructed tracks
 
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterGrid.cxx
+/// \brief Implementation of a 2D grid of the clusters of one DE
+///
+/// \author Philippe Pillot, Subatech
+
+#include "ClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace o2
+{
+namespace mch
+{
+
+//_________________________________________________________________________________________________
+void ClusterGrid::fill(const std::list<const Cluster*>* clusters)
+{
+  /// fill the grid with the given clusters, or empty it if the pointer is null
+
+  mClusters.clear();
+  mCellStart.clear();
+  mCellClusters.clear();
+  mNX = mNY = 1;
+
+  if (clusters == nullptr || clusters->empty()) {
+    return;
+  }
+
+  mClusters.assign(clusters->begin(), clusters->end());
+
+  // compute the area covered by the clusters
+  mXMin = mClusters.front()->getX();
+  mYMin = mClusters.front()->getY();
+  mZMin = mClusters.front()->getZ();
+  double xMax(mXMin), yMax(mYMin);
+  mZMax = mZMin;
+  for (const auto cluster : mClusters) {
+    mXMin = std::min(mXMin, cluster->getX());
+    xMax = std::max(xMax, cluster->getX());
+    mYMin = std::min(mYMin, cluster->getY());
+    yMax = std::max(yMax, cluster->getY());
+    mZMin = std::min(mZMin, cluster->getZ());
+    mZMax = std::max(mZMax, cluster->getZ());
+  }
+
+  // subdivide the area in cells of about the same size in x and y if there are enough clusters
+  double width = std::max(xMax - mXMin, 1.e-3);
+  double height = std::max(yMax - mYMin, 1.e-3);
+  if (mClusters.size() >= SMinClustersForGrid) {
+    int nCells = mClusters.size() / SClustersPerCell;
+    mNX = std::clamp(static_cast<int>(std::lround(std::sqrt(nCells * width / height))), 1, nCells);
+    mNY = std::max(nCells / mNX, 1);
+  }
+  mInvCellSizeX = mNX / width;
+  mInvCellSizeY = mNY / height;
+
+  // sort the cluster indices per cell, keeping the input order within each cell
+  mCellStart.assign(mNX * mNY + 1, 0);
+  std::vector<int> cells(mClusters.size());
+  for (size_t i = 0; i < mClusters.size(); ++i) {
+    cells[i] = getCell(getIX(mClusters[i]->getX()), getIY(mClusters[i]->getY()));
+    ++mCellStart[cells[i] + 1];
+  }
+  for (size_t iCell = 1; iCell < mCellStart.size(); ++iCell) {
+    mCellStart[iCell] += mCellStart[iCell - 1];
+  }
+  mCellClusters.resize(mClusters.size());
+  std::vector<uint32_t> nFilled(mNX * mNY, 0);
+  for (size_t i = 0; i < mClusters.size(); ++i) {
+    mCellClusters[mCellStart[cells[i]] + nFilled[cells[i]]++] = i;
+  }
+}
+
+//_________________________________________________________________________________________________
+void ClusterGrid::findClusters(double xMin, double xMax, double yMin, double yMax, std::vector<const Cluster*>& clusters) const
+{
+  /// fill the vector with the clusters in the cells overlapping the search window, in the order of the input list
+  /// it contains at least all the clusters in the window
+
+  clusters.clear();
+
+  if (mClusters.empty() || xMax < mXMin || yMax < mYMin ||
+      xMin > mXMin + mNX / mInvCellSizeX || yMin > mYMin + mNY / mInvCellSizeY) {
+    return;
+  }
+
+  if (mNX * mNY == 1) {
+    clusters = mClusters;
+    return;
+  }
+
+  int ixMin = getIX(xMin), ixMax = getIX(xMax);
+  int iyMin = getIY(yMin), iyMax = getIY(yMax);
+  std::vector<uint32_t> indices{};
+  for (int iy = iyMin; iy <= iyMax; ++iy) {
+    auto first = mCellClusters.begin() + mCellStart[getCell(ixMin, iy)];
+    auto last = mCellClusters.begin() + mCellStart[getCell(ixMax, iy) + 1];
+    indices.insert(indices.end(), first, last);
+  }
+  if (ixMin != ixMax || iyMin != iyMax) {
+    std::sort(indices.begin(), indices.end());
+  }
+
+  clusters.reserve(indices.size());
+  for (auto i : indices) {
+    clusters.push_back(mClusters[i]);
+  }
+}
+
+//_________________________________________________________________________________________________
+int ClusterGrid::getIX(double x) const
+{
+  /// return the index of the column of cells containing x, or the closest one
+  return static_cast<int>(std::clamp(std::floor((x - mXMin) * mInvCellSizeX), 0., mNX - 1.));
+}
+
+//_________________________________________________________________________________________________
+int ClusterGrid::getIY(double y) const
+{
+  /// return the index of the row of cells containing y, or the closest one
+  return static_cast<int>(std::clamp(std::floor((y - mYMin) * mInvCellSizeY), 0., mNY - 1.));
+}
+
+} // namespace mch
+} // namespace o2
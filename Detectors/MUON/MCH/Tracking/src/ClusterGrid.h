@@ -0,0 +1,82 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ClusterGrid.h
+/// \brief Definition of a 2D grid of the clusters of one DE to quickly select the ones within a search window
+///
+/// \author Philippe Pillot, Subatech
+
+#ifndef O2_MCH_CLUSTERGRID_H_
+#define O2_MCH_CLUSTERGRID_H_
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#include "DataFormatsMCH/Cluster.h"
+
+namespace o2
+{
+namespace mch
+{
+
+/// 2D grid of the clusters of one DE
+/// The clusters found in a search window are returned in the order of the input list,
+/// such that the tracking algorithm is not affected by the use of the grid
+class ClusterGrid
+{
+ public:
+  ClusterGrid() = default;
+  ~ClusterGrid() = default;
+
+  ClusterGrid(const ClusterGrid&) = delete;
+  ClusterGrid& operator=(const ClusterGrid&) = delete;
+  ClusterGrid(ClusterGrid&&) = default;
+  ClusterGrid& operator=(ClusterGrid&&) = default;
+
+  void fill(const std::list<const Cluster*>* clusters);
+
+  /// return true if the DE has no cluster
+  bool empty() const { return mClusters.empty(); }
+  /// return the minimum z position of the clusters
+  double getZMin() const { return mZMin; }
+  /// return the maximum z position of the clusters
+  double getZMax() const { return mZMax; }
+
+  void findClusters(double xMin, double xMax, double yMin, double yMax, std::vector<const Cluster*>& clusters) const;
+
+ private:
+  /// minimum number of clusters for which the grid is subdivided
+  static constexpr int SMinClustersForGrid = 16;
+  /// average number of clusters per cell
+  static constexpr double SClustersPerCell = 2.;
+
+  int getCell(int ix, int iy) const { return iy * mNX + ix; }
+  int getIX(double x) const;
+  int getIY(double y) const;
+
+  std::vector<const Cluster*> mClusters{}; ///< clusters in the order of the input list
+  std::vector<uint32_t> mCellStart{};      ///< index of the first cluster of each cell in mCellClusters
+  std::vector<uint32_t> mCellClusters{};   ///< indices of the clusters in mClusters, sorted per cell
+  int mNX = 1;                             ///< number of cells in x
+  int mNY = 1;                             ///< number of cells in y
+  double mXMin = 0.;                       ///< lower x edge of the grid
+  double mYMin = 0.;                       ///< lower y edge of the grid
+  double mInvCellSizeX = 0.;               ///< inverse of the cell size in x
+  double mInvCellSizeY = 0.;               ///< inverse of the cell size in y
+  double mZMin = 0.;                       ///< minimum z position of the clusters
+  double mZMax = 0.;                       ///< maximum z position of the clusters
+};
+
+} // namespace mch
+} // namespace o2
+
+#endif // O2_MCH_CLUSTERGRID_H_
@@ -0,0 +1,141 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FieldLUT.cxx
+/// \brief Implementation of a lookup table of the magnetic field in the muon arm
+///
+/// \author Philippe Pillot, Subatech
+
+#include "MCHTracking/FieldLUT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <TGeoGlobalMagField.h>
+
+#include "Framework/Logger.h"
+
+namespace o2
+{
+namespace mch
+{
+
+constexpr double FieldLUT::SXYMax;
+constexpr double FieldLUT::SZMin;
+constexpr double FieldLUT::SZMax;
+constexpr double FieldLUT::SStep;
+
+//_________________________________________________________________________________________________
+void FieldLUT::fill()
+{
+  /// sample the current field map at the nodes of the table
+
+  mField.clear();
+
+  auto fieldMap = TGeoGlobalMagField::Instance();
+  if (fieldMap == nullptr || fieldMap->GetField() == nullptr) {
+    LOG(error) << "cannot fill the field lookup table: no magnetic field map";
+    return;
+  }
+
+  mField.resize(3 * static_cast<std::size_t>(SNXY) * SNXY * SNZ);
+  double x[3] = {0., 0., 0.};
+  double b[3] = {0., 0., 0.};
+  for (int iz = 0; iz < SNZ; ++iz) {
+    x[2] = SZMin + iz * SStep;
+    for (int iy = 0; iy < SNXY; ++iy) {
+      x[1] = -SXYMax + iy * SStep;
+      for (int ix = 0; ix < SNXY; ++ix) {
+        x[0] = -SXYMax + ix * SStep;
+        fieldMap->Field(x, b);
+        auto i = index(ix, iy, iz);
+        mField[i] = b[0];
+        mField[i + 1] = b[1];
+        mField[i + 2] = b[2];
+      }
+    }
+  }
+
+  LOG(info) << "field lookup table filled with " << SNXY << "x" << SNXY << "x" << SNZ << " nodes";
+}
+
+//_________________________________________________________________________________________________
+bool FieldLUT::field(const double* x, double* b) const
+{
+  /// interpolate the field at the position x
+  /// return false, without modifying b, if the table is not filled or the position is outside
+
+  if (mField.empty() || std::abs(x[0]) > SXYMax || std::abs(x[1]) > SXYMax || x[2] < SZMin || x[2] > SZMax) {
+    return false;
+  }
+
+  // locate the cell and the position inside, taking care of the upper edges
+  double u[3] = {(x[0] + SXYMax) / SStep, (x[1] + SXYMax) / SStep, (x[2] - SZMin) / SStep};
+  int nNodes[3] = {SNXY, SNXY, SNZ};
+  int i[3] = {0, 0, 0};
+  double t[3] = {0., 0., 0.};
+  for (int k = 0; k < 3; ++k) {
+    i[k] = std::min(static_cast<int>(u[k]), nNodes[k] - 2);
+    t[k] = u[k] - i[k];
+  }
+
+  for (int k = 0; k < 3; ++k) {
+    double b00 = mField[index(i[0], i[1], i[2]) + k] * (1. - t[0]) + mField[index(i[0] + 1, i[1], i[2]) + k] * t[0];
+    double b10 = mField[index(i[0], i[1] + 1, i[2]) + k] * (1. - t[0]) + mField[index(i[0] + 1, i[1] + 1, i[2]) + k] * t[0];
+    double b01 = mField[index(i[0], i[1], i[2] + 1) + k] * (1. - t[0]) + mField[index(i[0] + 1, i[1], i[2] + 1) + k] * t[0];
+    double b11 = mField[index(i[0], i[1] + 1, i[2] + 1) + k] * (1. - t[0]) + mField[index(i[0] + 1, i[1] + 1, i[2] + 1) + k] * t[0];
+    b[k] = (b00 * (1. - t[1]) + b10 * t[1]) * (1. - t[2]) + (b01 * (1. - t[1]) + b11 * t[1]) * t[2];
+  }
+
+  return true;
+}
+
+//_________________________________________________________________________________________________
+FieldLUT::Accuracy FieldLUT::checkAccuracy(int nPoints, unsigned int seed) const
+{
+  /// compare the interpolated field with the field map at nPoints random positions inside the table
+
+  Accuracy accuracy{};
+
+  auto fieldMap = TGeoGlobalMagField::Instance();
+  if (mField.empty() || nPoints <= 0 || fieldMap == nullptr || fieldMap->GetField() == nullptr) {
+    return accuracy;
+  }
+
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> xyDistribution(-SXYMax, SXYMax);
+  std::uniform_real_distribution<double> zDistribution(SZMin, SZMax);
+  double x[3] = {0., 0., 0.};
+  double bMap[3] = {0., 0., 0.};
+  double bLUT[3] = {0., 0., 0.};
+  double sumDeviation2 = 0.;
+  for (int i = 0; i < nPoints; ++i) {
+    x[0] = xyDistribution(generator);
+    x[1] = xyDistribution(generator);
+    x[2] = zDistribution(generator);
+    fieldMap->Field(x, bMap);
+    field(x, bLUT);
+    double deviation2 = 0.;
+    for (int k = 0; k < 3; ++k) {
+      deviation2 += (bLUT[k] - bMap[k]) * (bLUT[k] - bMap[k]);
+    }
+    sumDeviation2 += deviation2;
+    accuracy.maxDeviation = std::max(accuracy.maxDeviation, std::sqrt(deviation2));
+    accuracy.maxField = std::max(accuracy.maxField, std::sqrt(bMap[0] * bMap[0] + bMap[1] * bMap[1] + bMap[2] * bMap[2]));
+  }
+  accuracy.rmsDeviation = std::sqrt(sumDeviation2 / nPoints);
+
+  return accuracy;
+}
+
+} // namespace mch
+} // namespace o2
@@ -16,6 +16,11 @@
 
 #include "MCHTracking/TrackExtrap.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
 #include <TGeoGlobalMagField.h>
 #include <TGeoManager.h>
 #include <TGeoMaterial.h>
@@ -24,6 +29,7 @@
 #include <TMath.h>
 
 #include "Framework/Logger.h"
+#include "MCHBase/TrackerParam.h"
 
 #include "MCHTracking/TrackParam.h"
 
@@ -35,8 +41,10 @@ namespace mch
 bool TrackExtrap::sExtrapV2 = false;
 double TrackExtrap::sSimpleBValue = 0.;
 bool TrackExtrap::sFieldON = false;
+FieldLUT TrackExtrap::sFieldLUT{};
 std::size_t TrackExtrap::sNCallExtrapToZCov = 0;
 std::size_t TrackExtrap::sNCallField = 0;
+std::size_t TrackExtrap::sNCallFieldLUT = 0;
 
 //__________________________________________________________________________
 void TrackExtrap::setField()
@@ -49,6 +57,16 @@ void TrackExtrap::setField()
   sSimpleBValue = b[0];
   sFieldON = (TMath::Abs(sSimpleBValue) > 1.e-10) ? true : false;
   LOG(info) << "Track extrapolation with magnetic field " << (sFieldON ? "ON" : "OFF");
+
+  // (re)build the field lookup table if requested, for the current field map
+  sFieldLUT.clear();
+  const auto& trackerParam = TrackerParam::Instance();
+  if (sFieldON && trackerParam.useFieldLUT) {
+    sFieldLUT.fill();
+    if (trackerParam.fieldLUTCheckTracks > 0) {
+      checkFieldLUT(trackerParam.fieldLUTCheckTracks);
+    }
+  }
 }
 
 //__________________________________________________________________________
@@ -1066,8 +1084,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
       h = rest;
     }
     // cmodif: call gufld(vout,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(vout, f);
-    ++sNCallField;
+    getField(vout, f);
 
     // *
     // *             start of integration
@@ -1115,8 +1132,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     at = a + secxs[0];
     bt = b + secys[0];
@@ -1155,8 +1171,7 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
     xyzt[2] = zt;
 
     // cmodif: call gufld(xyzt,f) changed into:
-    TGeoGlobalMagField::Instance()->Field(xyzt, f);
-    ++sNCallField;
+    getField(xyzt, f);
 
     z = z + (c + (seczs[0] + seczs[1] + seczs[2]) * kthird) * h;
     y = y + (b + (secys[0] + secys[1] + secys[2]) * kthird) * h;
@@ -1255,12 +1270,90 @@ bool TrackExtrap::extrapOneStepRungekutta(double charge, double step, const doub
   return true;
 }
 
+//__________________________________________________________________________
+void TrackExtrap::getField(const double* x, double* b)
+{
+  /// Get the magnetic field at the position x, from the lookup table if filled and covering this position
+  if (sFieldLUT.field(x, b)) {
+    ++sNCallFieldLUT;
+  } else {
+    TGeoGlobalMagField::Instance()->Field(x, b);
+    ++sNCallField;
+  }
+}
+
+//__________________________________________________________________________
+void TrackExtrap::checkFieldLUT(int nTracks)
+{
+  /// Check the accuracy of the field lookup table with respect to the field map,
+  /// at random positions and by extrapolating nTracks random tracks from the end of the absorber to MID
+
+  if (!sFieldLUT.isFilled() || nTracks <= 0) {
+    return;
+  }
+
+  auto accuracy = sFieldLUT.checkAccuracy(100 * nTracks);
+  LOG(info) << "field lookup table: max deviation = " << accuracy.maxDeviation << " kG, RMS = " << accuracy.rmsDeviation
+            << " kG (max field = " << accuracy.maxField << " kG)";
+
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> thetaDistribution(2. * TMath::DegToRad(), 9. * TMath::DegToRad());
+  std::uniform_real_distribution<double> phiDistribution(0., TMath::TwoPi());
+  std::uniform_real_distribution<double> inversePDistribution(1. / 50., 1. / 2.);
+  std::bernoulli_distribution chargeDistribution(0.5);
+
+  FieldLUT lut{};
+  std::swap(lut, sFieldLUT);
+  int nExtrap(0);
+  double maxDPos(0.), sumDPos2(0.), maxDSlope(0.), maxDInvP(0.);
+  for (int i = 0; i < nTracks; ++i) {
+    double tanTheta = std::tan(thetaDistribution(generator));
+    double phi = phiDistribution(generator);
+    TrackParam param{};
+    param.setZ(SAbsZEnd);
+    param.setNonBendingSlope(tanTheta * std::cos(phi));
+    param.setBendingSlope(tanTheta * std::sin(phi));
+    param.setNonBendingCoor(param.getNonBendingSlope() * SAbsZEnd);
+    param.setBendingCoor(param.getBendingSlope() * SAbsZEnd);
+    param.setInverseBendingMomentum((chargeDistribution(generator) ? 1. : -1.) * inversePDistribution(generator));
+
+    // extrapolate with the field map then with the lookup table
+    TrackParam paramMap(param);
+    bool mapOK = extrapToZ(paramMap, SMIDZ);
+    std::swap(lut, sFieldLUT);
+    TrackParam paramLUT(param);
+    bool lutOK = extrapToZ(paramLUT, SMIDZ);
+    std::swap(lut, sFieldLUT);
+    if (!mapOK || !lutOK) {
+      continue;
+    }
+
+    ++nExtrap;
+    double dX = paramLUT.getNonBendingCoor() - paramMap.getNonBendingCoor();
+    double dY = paramLUT.getBendingCoor() - paramMap.getBendingCoor();
+    double dPos2 = dX * dX + dY * dY;
+    sumDPos2 += dPos2;
+    maxDPos = std::max(maxDPos, std::sqrt(dPos2));
+    maxDSlope = std::max({maxDSlope, std::abs(paramLUT.getNonBendingSlope() - paramMap.getNonBendingSlope()),
+                          std::abs(paramLUT.getBendingSlope() - paramMap.getBendingSlope())});
+    maxDInvP = std::max(maxDInvP, std::abs(paramLUT.getInverseBendingMomentum() / paramMap.getInverseBendingMomentum() - 1.));
+  }
+  std::swap(lut, sFieldLUT);
+
+  LOG(info) << "field lookup table: " << nExtrap << " tracks extrapolated to MID, position deviation max = " << maxDPos
+            << " cm, RMS = " << ((nExtrap > 0) ? std::sqrt(sumDPos2 / nExtrap) : 0.) << " cm, max slope deviation = " << maxDSlope
+            << ", max relative bending momentum deviation = " << maxDInvP;
+}
+
 //__________________________________________________________________________
 void TrackExtrap::printNCalls()
 {
   /// Print the number of times some methods are called
   LOG(info) << "number of times extrapToZCov() is called = " << sNCallExtrapToZCov;
   LOG(info) << "number of times Field() is called = " << sNCallField;
+  if (sNCallFieldLUT > 0) {
+    LOG(info) << "number of times the field lookup table is used = " << sNCallFieldLUT;
+  }
 }
 
 } // namespace mch
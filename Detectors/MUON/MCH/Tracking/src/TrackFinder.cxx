@@ -17,8 +17,10 @@
 #include "MCHTracking/TrackFinder.h"
 
 #include <cassert>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 #include <TGeoGlobalMagField.h>
@@ -29,6 +31,7 @@
 #include "MCHBase/Error.h"
 #include "MCHBase/TrackerParam.h"
 #include "MCHTracking/TrackExtrap.h"
+#include "ClusterGrid.h"
 
 namespace o2
 {
@@ -41,6 +44,12 @@ constexpr double TrackFinder::SDefaultChamberZ[10];
 constexpr double TrackFinder::SChamberThicknessInX0[10];
 constexpr int TrackFinder::SNDE[10];
 
+//_________________________________________________________________________________________________
+TrackFinder::TrackFinder() = default;
+
+//_________________________________________________________________________________________________
+TrackFinder::~TrackFinder() = default;
+
 //_________________________________________________________________________________________________
 void TrackFinder::init()
 {
@@ -136,6 +145,13 @@ void TrackFinder::init()
     mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, nullptr);
     mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, nullptr);
   }
+
+  // create the grids of clusters of every DE
+  for (const auto& plane : mClusters) {
+    for (const auto& de : plane) {
+      mClusterGrids.emplace(de.first, std::make_unique<ClusterGrid>());
+    }
+  }
 }
 
 //_________________________________________________________________________________________________
@@ -164,7 +180,7 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
   mTracks.clear();
   mStartTime = std::chrono::steady_clock::now();
 
-  // fill the internal array of pointers to the list of clusters per DE
+  // fill the internal array of pointers to the list of clusters per DE and the grids of clusters
   for (auto& plane : mClusters) {
     for (auto& de : plane) {
       auto itDE = clusters.find(de.first);
@@ -173,6 +189,7 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
       } else {
         de.second = &(itDE->second);
       }
+      mClusterGrids[de.first]->fill(de.second);
     }
   }
 
@@ -767,6 +784,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
 
   // loop over all DEs of plane
   TrackParam paramAtCluster{};
+  std::vector<const Cluster*> clusterCandidates{};
   for (auto& de : mClusters[plane]) {
 
     // skip DE without cluster
@@ -780,7 +798,8 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
     }
 
     // look for cluster candidate in this DE
-    for (const auto cluster : *de.second) {
+    findClusterCandidates(currentParam, de.first, clusterCandidates);
+    for (const auto cluster : clusterCandidates) {
 
       // try to add the current cluster
       if (!isCompatible(currentParam, *cluster, paramAtCluster)) {
@@ -959,6 +978,8 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   TrackParam currentParamAtCluster1{};
   TrackParam paramAtCluster2{};
   std::unordered_map<int, std::unordered_set<uint32_t>> newExcludedClusters{};
+  std::vector<const Cluster*> cluster1Candidates{};
+  std::vector<const Cluster*> cluster2Candidates{};
   for (auto& de1 : mClusters[plane1]) {
 
     // skip DE without cluster
@@ -971,7 +992,8 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
     // look for cluster candidate in this DE
-    for (const auto cluster1 : *de1.second) {
+    findClusterCandidates(paramAtChamber, de1.first, cluster1Candidates);
+    for (const auto cluster1 : cluster1Candidates) {
 
       // skip excluded clusters
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster1->uid) > 0) {
@@ -1009,7 +1031,8 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
         }
 
         // look for cluster candidate in this DE
-        for (const auto cluster2 : *de2.second) {
+        findClusterCandidates(currentParamAtCluster1, de2.first, cluster2Candidates);
+        for (const auto cluster2 : cluster2Candidates) {
 
           // try to add the current cluster
           if (!isCompatible(currentParamAtCluster1, *cluster2, paramAtCluster2)) {
@@ -1064,7 +1087,8 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
     bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
 
     // look for cluster candidate in this DE
-    for (const auto cluster2 : *de2.second) {
+    findClusterCandidates(paramAtChamber, de2.first, cluster2Candidates);
+    for (const auto cluster2 : cluster2Candidates) {
 
       // skip excluded clusters (in particular the ones already attached together with a cluster on plane1)
       if (hasExcludedClusters && itExcludedClusters->second.count(cluster2->uid) > 0) {
@@ -1564,6 +1588,45 @@ void TrackFinder::moveClusters(std::unordered_map<int, std::unordered_set<uint32
   source.clear();
 }
 
+//_________________________________________________________________________________________________
+void TrackFinder::findClusterCandidates(const TrackParam& param, int deId, std::vector<const Cluster*>& clusters) const
+{
+  /// Fill the vector with the clusters of the DE which might pass the tryOneClusterFast test, in their original order
+  /// The search window is the union of the tryOneClusterFast windows at the minimum and maximum z of the clusters.
+  /// It contains the windows at any z in between since the track position is linear in dZ and its variance convex
+
+  const auto& grid = *mClusterGrids.at(deId);
+  if (grid.empty()) {
+    clusters.clear();
+    return;
+  }
+
+  const TMatrixD& paramCov = param.getCovariances();
+  double sigmaCut = TrackerParam::Instance().sigmaCutForTracking;
+  double xMin(0.), xMax(0.), yMin(0.), yMax(0.);
+  for (int i = 0; i < 2; ++i) {
+    double dZ = ((i == 0) ? grid.getZMin() : grid.getZMax()) - param.getZ();
+    double x = param.getNonBendingCoor() + param.getNonBendingSlope() * dZ;
+    double y = param.getBendingCoor() + param.getBendingSlope() * dZ;
+    double errX2 = paramCov(0, 0) + dZ * dZ * paramCov(1, 1) + 2. * dZ * paramCov(0, 1) + mChamberResolutionX2;
+    double errY2 = paramCov(2, 2) + dZ * dZ * paramCov(3, 3) + 2. * dZ * paramCov(2, 3) + mChamberResolutionY2;
+    double dXmax = sigmaCut * TMath::Sqrt(2. * errX2) + SMaxNonBendingDistanceToTrack + SGridMargin;
+    double dYmax = sigmaCut * TMath::Sqrt(2. * errY2) + SMaxBendingDistanceToTrack + SGridMargin;
+    xMin = (i == 0) ? x - dXmax : std::min(xMin, x - dXmax);
+    xMax = (i == 0) ? x + dXmax : std::max(xMax, x + dXmax);
+    yMin = (i == 0) ? y - dYmax : std::min(yMin, y - dYmax);
+    yMax = (i == 0) ? y + dYmax : std::max(yMax, y + dYmax);
+  }
+
+  // tryOneClusterFast accepts every cluster if the window cannot be computed
+  if (!(xMin <= xMax) || !(yMin <= yMax)) {
+    xMin = yMin = -std::numeric_limits<double>::infinity();
+    xMax = yMax = std::numeric_limits<double>::infinity();
+  }
+
+  grid.findClusters(xMin, xMax, yMin, yMax, clusters);
+}
+
 //_________________________________________________________________________________________________
 bool TrackFinder::isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster)
 {
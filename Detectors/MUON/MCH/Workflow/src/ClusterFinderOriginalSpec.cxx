@@ -16,6 +16,7 @@
 
 #include "MCHWorkflow/ClusterFinderOriginalSpec.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
@@ -41,7 +42,7 @@
 #include "MCHBase/ErrorMap.h"
 #include "MCHBase/PreCluster.h"
 #include "DataFormatsMCH/Cluster.h"
-#include "MCHClustering/ClusterFinderOriginal.h"
+#include "MCHClustering/ParallelClusterFinder.h"
 
 namespace o2
 {
@@ -65,7 +66,9 @@ class ClusterFinderOriginalTask
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHClustering", true);
     }
     bool run2Config = ic.options().get<bool>("run2-config");
-    mClusterFinder.init(run2Config);
+    int nThreads = std::max(ic.options().get<int>("n-threads"), 1);
+    mClusterFinder.init(nThreads, run2Config);
+    LOG(info) << "clusterizing the preclusters in " << nThreads << " thread(s)";
 
     mAttachInitalPrecluster = ic.options().get<bool>("attach-initial-precluster");
 
@@ -97,32 +100,20 @@ class ClusterFinderOriginalTask
     clusterROFs.reserve(preClusterROFs.size());
     auto& errorMap = mClusterFinder.getErrorMap();
     errorMap.clear();
-    for (const auto& preClusterROF : preClusterROFs) {
-
-      // prepare to clusterize the current ROF
-      auto clusterOffset = clusters.size();
-      mClusterFinder.reset();
-
-      for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
-
-        auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
-        auto firstClusterIdx = mClusterFinder.getClusters().size();
 
-        // clusterize the current precluster
-        auto tStart = std::chrono::high_resolution_clock::now();
-        mClusterFinder.findClusters(preclusterDigits);
-        auto tEnd = std::chrono::high_resolution_clock::now();
-        mTimeClusterFinder += tEnd - tStart;
+    // clusterize all the preclusters of the TF, which are independent of each other
+    auto tStart = std::chrono::high_resolution_clock::now();
+    mClusterFinder.findClusters(preClusters, digits);
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    mTimeClusterFinder += tEnd - tStart;
 
-        if (mAttachInitalPrecluster) {
-          // store the new clusters and associate them to all the digits of the precluster
-          writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
-        }
-      }
+    for (const auto& preClusterROF : preClusterROFs) {
 
-      if (!mAttachInitalPrecluster) {
-        // store all the clusters of the current ROF and the associated digits actually used in the clustering
-        writeClusters(clusters, usedDigits);
+      // store the clusters of the current ROF in the order of the preclusters
+      auto clusterOffset = clusters.size();
+      for (auto iPreCluster = preClusterROF.getFirstIdx(); iPreCluster <= preClusterROF.getLastIdx(); ++iPreCluster) {
+        const auto& preCluster = preClusters[iPreCluster];
+        writeClusters(iPreCluster, digits.subspan(preCluster.firstDigit, preCluster.nDigits), clusterOffset, clusters, usedDigits);
       }
 
       // create the cluster ROF
@@ -143,49 +134,42 @@ class ClusterFinderOriginalTask
 
  private:
   //_________________________________________________________________________________________________
-  void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx,
+  void writeClusters(size_t iPreCluster, const gsl::span<const Digit>& preclusterDigits, size_t clusterOffset,
                      std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
                      std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
   {
-    /// fill the output messages with the new clusters and all the digits from the corresponding precluster
+    /// fill the output messages with the clusters of the precluster and either all the digits of the precluster
+    /// or the digits actually used in the clustering
     /// modify the references to the attached digits according to their position in the global vector
+    /// and number the clusters according to their position in the current ROF (starting at clusterOffset)
 
-    if (firstClusterIdx == mClusterFinder.getClusters().size()) {
+    auto newClusters = mClusterFinder.getClusters(iPreCluster);
+    if (newClusters.empty()) {
       return;
     }
 
-    auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin() + firstClusterIdx, mClusterFinder.getClusters().end());
-
     auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
-
-    for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
-      itCluster->firstDigit = digitOffset;
-      itCluster->nDigits = preclusterDigits.size();
+    if (mAttachInitalPrecluster) {
+      usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
+    } else {
+      auto newDigits = mClusterFinder.getUsedDigits(iPreCluster);
+      usedDigits.insert(usedDigits.end(), newDigits.begin(), newDigits.end());
     }
-  }
-
-  //_________________________________________________________________________________________________
-  void writeClusters(std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
-                     std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
-  {
-    /// fill the output messages with clusters and attached digits of the current event
-    /// modify the references to the attached digits according to their position in the global vector
-
-    auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin(), mClusterFinder.getClusters().end());
 
-    auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), mClusterFinder.getUsedDigits().begin(), mClusterFinder.getUsedDigits().end());
-
-    for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
-      itCluster->firstDigit += digitOffset;
+    for (const auto& cluster : newClusters) {
+      auto& newCluster = clusters.emplace_back(cluster);
+      newCluster.uid = Cluster::buildUniqueId(cluster.getChamberId(), cluster.getDEId(), clusters.size() - 1 - clusterOffset);
+      if (mAttachInitalPrecluster) {
+        newCluster.firstDigit = digitOffset;
+        newCluster.nDigits = preclusterDigits.size();
+      } else {
+        newCluster.firstDigit += digitOffset;
+      }
     }
   }
 
   bool mAttachInitalPrecluster = false;               ///< attach all digits of initial precluster to cluster
-  ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
+  ParallelClusterFinder mClusterFinder{};             ///< clusterizer
   ErrorMap mErrorMap{};                               ///< counting of encountered errors
   std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
 };
@@ -205,7 +189,8 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* specNa
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
             {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
-            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}}}};
+            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}},
+            {"n-threads", VariantType::Int, 1, {"number of threads used to clusterize the preclusters of a TF"}}}};
 }
 
 } // end namespace mch
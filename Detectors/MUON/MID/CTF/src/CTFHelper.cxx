@@ -39,7 +39,7 @@ void CTFHelper::TFData::buildReferences(o2::utils::IRFrameSelector& irSelector)
   }
   while (nDone < NEvTypes) { // find next ROFRecord with smallest BC, untill all 3 spans are traversed
     int selT = rofBC[0] <= rofBC[1] ? (rofBC[0] <= rofBC[2] ? 0 : 2) : (rofBC[1] <= rofBC[2] ? 1 : 2);
-    if (!irSelector.isSet() || irSelector.check(rofData[selT][idx[selT]].interactionRecord) >= 0) {
+    if (!irSelector.isSet() || irSelector.isSelected(rofData[selT][idx[selT]].interactionRecord)) {
       rofDataRefs.emplace_back(idx[selT], selT);
       for (uint32_t ic = rofData[selT][idx[selT]].firstEntry; ic < rofData[selT][idx[selT]].getEndIndex(); ic++) {
         colDataRefs.emplace_back(ic, selT); // register indices of corresponding column data
@@ -17,12 +17,14 @@
 #ifndef O2_MID_TRACKER_H
 #define O2_MID_TRACKER_H
 
+#include <array>
 #include <vector>
 #include <unordered_set>
 #include <gsl/gsl>
 #include "DataFormatsMID/Cluster.h"
 #include "DataFormatsMID/ROFRecord.h"
 #include "DataFormatsMID/Track.h"
+#include "MIDBase/DetectorParameters.h"
 #include "MIDBase/GeometryTransformer.h"
 
 namespace o2
@@ -57,6 +59,17 @@ class Tracker
   const std::vector<ROFRecord>& getClusterROFRecords() { return mClusterROFRecords; }
 
  private:
+  /// Extent and largest uncertainties of the clusters of one detection element
+  struct ClusterBounds {
+    float xMin, xMax, yMin, yMax, zMin, zMax; ///< extent of the clusters
+    double maxEX2, maxEY2;                    ///< largest squared uncertainties of the clusters
+  };
+
+  /// Region of a detection element containing all the clusters that can be attached to a track
+  struct SearchWindow {
+    double xMin, xMax, yMin, yMax; ///< limits of the region
+  };
+
   void processSide(bool isRight, bool isInward);
   void tryAddTrack(const Track& track);
   void followTrackKeepAll(Track& track, bool isRight, bool isInward);
@@ -67,13 +80,21 @@ class Tracker
   int getFirstNeighbourRPC(int rpc) const;
   int getLastNeighbourRPC(int rpc) const;
   bool loadClusters(gsl::span<const Cluster>& clusters);
+  bool getSearchWindow(const Track& track, int deId, SearchWindow& window) const;
+  /// Checks if the cluster is inside the search window
+  bool isInWindow(const Cluster& cl, const SearchWindow& window) const
+  {
+    return cl.xCoor >= window.xMin && cl.xCoor <= window.xMax && cl.yCoor >= window.yMin && cl.yCoor <= window.yMax;
+  }
   bool makeTrackSeed(Track& track, const Cluster& cl1, const Cluster& cl2) const;
   void runKalmanFilter(Track& track, const Cluster& cluster) const;
   bool tryOneCluster(const Track& track, int chamber, int clIdx, Track& newTrack) const;
   void excludeUsedClusters(const Track& track, int ch1, int ch2, std::unordered_set<int>& excludedClusters) const;
   bool skipOneChamber(Track& track) const;
 
-  static constexpr float SMT11Z = -1603.5; ///< Position of the first MID chamber (cm)
+  static constexpr float SMT11Z = -1603.5;         ///< Position of the first MID chamber (cm)
+  static constexpr double SWindowRelMargin = 1.01; ///< Relative margin on the half size of the search window
+  static constexpr double SWindowAbsMargin = 0.1;  ///< Absolute margin on the half size of the search window (cm)
 
   float mImpactParamCut = 210.; ///< Cut on impact parameter
   float mSigmaCut = 5.;         ///< Number of sigmas cut
@@ -82,6 +103,8 @@ class Tracker
   std::vector<int> mClusterIndexes[72]; ///< Ordered arrays of clusters indexes
   std::vector<Cluster> mClusters{};     ///< 3D clusters
 
+  std::array<ClusterBounds, detparams::NDetectionElements> mClusterBounds{}; ///! Bounds of the clusters per detection element
+
   std::vector<Track> mTracks{};                ///< Vector of tracks
   std::vector<ROFRecord> mTrackROFRecords{};   ///< List of track RO frame records
   std::vector<ROFRecord> mClusterROFRecords{}; ///< List of cluster RO frame records
@@ -15,8 +15,10 @@
 /// \date   09 May 2017
 #include "MIDTracking/Tracker.h"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <stdexcept>
 
 #include "Framework/Logger.h"
@@ -71,20 +73,76 @@ bool Tracker::loadClusters(gsl::span<const Cluster>& clusters)
 {
   /// Fills the array of clusters per detection element
 
+  constexpr float inf = std::numeric_limits<float>::max();
+  mClusterBounds.fill({inf, -inf, inf, -inf, inf, -inf, 0., 0.});
+
   for (auto& cl : clusters) {
     int deId = cl.deId;
     // This needs to be done before adding the element to mClusters
     mClusterIndexes[deId].emplace_back(mClusters.size());
     const auto& position = mTransformer.localToGlobal(deId, cl.xCoor, cl.yCoor);
     mClusters.emplace_back(cl);
-    mClusters.back().xCoor = position.x();
-    mClusters.back().yCoor = position.y();
-    mClusters.back().zCoor = position.z();
+    auto& cl3D = mClusters.back();
+    cl3D.xCoor = position.x();
+    cl3D.yCoor = position.y();
+    cl3D.zCoor = position.z();
+
+    auto& bounds = mClusterBounds[deId];
+    bounds.xMin = std::min(bounds.xMin, cl3D.xCoor);
+    bounds.xMax = std::max(bounds.xMax, cl3D.xCoor);
+    bounds.yMin = std::min(bounds.yMin, cl3D.yCoor);
+    bounds.yMax = std::max(bounds.yMax, cl3D.yCoor);
+    bounds.zMin = std::min(bounds.zMin, cl3D.zCoor);
+    bounds.zMax = std::max(bounds.zMax, cl3D.zCoor);
+    bounds.maxEX2 = std::max(bounds.maxEX2, cl3D.getEX2());
+    bounds.maxEY2 = std::max(bounds.maxEY2, cl3D.getEY2());
   }
 
   return (clusters.size() > 0);
 }
 
+//______________________________________________________________________________
+bool Tracker::getSearchWindow(const Track& track, int deId, SearchWindow& window) const
+{
+  /// Computes the region of the detection element outside of which no cluster can pass the chi2 cut of tryOneCluster
+  /// Returns false if the region does not contain any cluster of this detection element
+  ///
+  /// Each coordinate alone must satisfy diff^2 / (track variance + cluster variance) <= mMaxChi2.
+  /// The track position is linear in z and its variance is convex in z, so their bounds over the z extent
+  /// of the clusters are reached at the edges. A margin protects against the float rounding of the propagation
+
+  if (mClusterIndexes[deId].empty()) {
+    return false;
+  }
+
+  const auto& bounds = mClusterBounds[deId];
+  const auto& covParams = track.getCovarianceParameters();
+  double pos[2] = {track.getPositionX(), track.getPositionY()};
+  double dir[2] = {track.getDirectionX(), track.getDirectionY()};
+  double maxClusterVar[2] = {bounds.maxEX2, bounds.maxEY2};
+  double dZ[2] = {bounds.zMin - track.getPositionZ(), bounds.zMax - track.getPositionZ()};
+  double limits[2][2];
+  for (int idx = 0; idx < 2; ++idx) {
+    int slopeIdx = idx + 2;
+    int covIdx = idx + 4;
+    double maxTrackVar = 0.;
+    limits[idx][0] = std::numeric_limits<double>::max();
+    limits[idx][1] = -std::numeric_limits<double>::max();
+    for (auto dz : dZ) {
+      double trackPos = pos[idx] + dir[idx] * dz;
+      limits[idx][0] = std::min(limits[idx][0], trackPos);
+      limits[idx][1] = std::max(limits[idx][1], trackPos);
+      maxTrackVar = std::max(maxTrackVar, covParams[idx] + 2. * covParams[covIdx] * dz + covParams[slopeIdx] * dz * dz);
+    }
+    double halfWidth = std::sqrt(mMaxChi2 * (maxTrackVar + maxClusterVar[idx])) * SWindowRelMargin + SWindowAbsMargin;
+    limits[idx][0] -= halfWidth;
+    limits[idx][1] += halfWidth;
+  }
+  window = {limits[0][0], limits[0][1], limits[1][0], limits[1][1]};
+
+  return window.xMax >= bounds.xMin && window.xMin <= bounds.xMax && window.yMax >= bounds.yMin && window.yMin <= bounds.yMax;
+}
+
 //______________________________________________________________________________
 void Tracker::process(gsl::span<const Cluster> clusters, gsl::span<const ROFRecord> rofRecords)
 {
@@ -282,12 +340,16 @@ bool Tracker::findAllClusters(const Track& track, bool isRight, int chamber, int
   bool clusterFound = false;
   Track newTrack;
 
+  SearchWindow window;
   for (int irpc = firstRPC; irpc <= lastRPC; ++irpc) {
     int deId = rpcOffset + irpc;
+    if (!getSearchWindow(track, deId, window)) {
+      continue;
+    }
     for (auto clIdx : mClusterIndexes[deId]) {
 
-      // skip excluded clusters
-      if (excludeClusters && excludedClusters.count(clIdx) > 0) {
+      // skip excluded clusters and clusters too far from the track
+      if ((excludeClusters && excludedClusters.count(clIdx) > 0) || !isInWindow(mClusters[clIdx], window)) {
         continue;
       }
 
@@ -366,10 +428,14 @@ void Tracker::findNextCluster(const Track& track, bool isRight, bool isInward, i
   int nextChamber = (isInward) ? chamber - 1 : chamber + 1;
   int rpcOffset = detparams::getDEId(isRight, chamber, 0);
   Track newTrack;
+  SearchWindow window;
   for (int irpc = firstRPC; irpc <= lastRPC; ++irpc) {
     int deId = rpcOffset + irpc;
+    if (!getSearchWindow(track, deId, window)) {
+      continue;
+    }
     for (auto clIdx : mClusterIndexes[deId]) {
-      if (!tryOneCluster(track, chamber, clIdx, newTrack)) {
+      if (!isInWindow(mClusters[clIdx], window) || !tryOneCluster(track, chamber, clIdx, newTrack)) {
         continue;
       }
       if (nextChamber >= 0 && nextChamber <= 3) {
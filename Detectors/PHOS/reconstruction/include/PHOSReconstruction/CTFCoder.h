@@ -65,7 +65,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const TriggerReco
     mTrgDataFilt.clear();
     mCellDataFilt.clear();
     for (const auto& trig : trigData) {
-      if (mIRFrameSelector.check(trig.getBCData()) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.getBCData())) {
         mTrgDataFilt.push_back(trig);
         auto cellIt = cellData.begin() + trig.getFirstEntry();
         auto& trigC = mTrgDataFilt.back();
@@ -116,6 +116,9 @@ class Clusterer
   std::vector<Digit> mTrigger;    ///< internal vector of clusters
   int mFirstElememtInEvent;       ///< Range of digits from one event
   int mLastElementInEvent;        ///< Range of digits from one event
+  std::vector<int> mCellToCluEl;     //! element in the cell (-1 if none) of the event being clustered
+  std::vector<int> mNextCluElInCell; //! next element in the same cell (-1 if none)
+  std::vector<int> mNeighbours;      //! neighbour elements of the cluster element being expanded
 
   std::vector<float> mProp;             ///< proportion of clusters in the current digit
   std::array<float, NLOCMAX> mxMax;     ///< current maximum coordinate
@@ -11,6 +11,7 @@
 
 /// \file Clusterer.cxx
 /// \brief Implementation of the PHOS cluster finder
+#include <algorithm>
 #include <memory>
 #include "TDecompBK.h"
 
@@ -154,10 +155,30 @@ void Clusterer::makeClusters(std::vector<Cluster>& clusters, std::vector<CluElem
   // A cluster is defined as a list of neighbour digits (as defined in Geometry::areNeighbours)
   // Cluster contains first and (next-to) last index of the combined list of clusterelements, so
   // add elements to final list and mark element in internal list as used (zero energy)
-
-  int iFirst = 0; // first index of digit which potentially can be a part of cluster
+  // The neighbours are looked up in a grid of the cells holding the elements of the event
+  // instead of scanning all the elements for every element added to a cluster, the elements
+  // are added in the same order as with the scan.
+
+  const short nZ = 56;   // cells in a row of a module
+  const short nPhi = 64; // rows in a module
+  const int nCells = Geometry::getTotalNCells();
+  if (mCellToCluEl.empty()) {
+    mCellToCluEl.resize(nCells, -1);
+  }
   int n = mCluEl.size();
-  for (int i = iFirst; i < n; i++) {
+  mNextCluElInCell.resize(n);
+  // elements of the same cell (if any) are chained in the order of the elements
+  for (int i = n; i--;) {
+    int cell = mCluEl[i].absId - 1;
+    if (cell < 0 || cell >= nCells) {
+      continue;
+    }
+    mNextCluElInCell[i] = mCellToCluEl[cell];
+    mCellToCluEl[cell] = i;
+  }
+
+  std::array<int, 5> neighbourCells;
+  for (int i = 0; i < n; i++) {
     if (mCluEl[i].energy == 0) { // already used
       continue;
     }
@@ -178,34 +199,45 @@ void Clusterer::makeClusters(std::vector<Cluster>& clusters, std::vector<CluElem
     } else {
       continue;
     }
-    // Now scan remaining digits in list to find neigbours of our seed
+    // Now look in the grid for the neighbours of the digits already in cluster
     int index = 0;
     while (index < iDigitInCluster) { // scan over digits already in cluster
-      short digitSeedAbsId = cluelements.at(clu->getFirstCluEl() + index).absId;
+      int cell = cluelements.at(clu->getFirstCluEl() + index).absId - 1;
       index++;
-      for (int j = iFirst; j < n; j++) {
-        if (mCluEl[j].energy == 0) {
-          continue; // look through remaining digits
+      if (cell < 0 || cell >= nCells) {
+        continue;
+      }
+      int nNeighbourCells = 0;
+      short col = cell % nZ;
+      short row = (cell / nZ) % nPhi;
+      neighbourCells[nNeighbourCells++] = cell;
+      if (col > 0) {
+        neighbourCells[nNeighbourCells++] = cell - 1;
+      }
+      if (col < nZ - 1) {
+        neighbourCells[nNeighbourCells++] = cell + 1;
+      }
+      if (row > 0) {
+        neighbourCells[nNeighbourCells++] = cell - nZ;
+      }
+      if (row < nPhi - 1) {
+        neighbourCells[nNeighbourCells++] = cell + nZ;
+      }
+      mNeighbours.clear();
+      for (int iCell = 0; iCell < nNeighbourCells; iCell++) {
+        for (int j = mCellToCluEl[neighbourCells[iCell]]; j >= 0; j = mNextCluElInCell[j]) {
+          if (mCluEl[j].energy != 0) {
+            mNeighbours.push_back(j);
+          }
         }
+      }
+      // add the neighbours in the order of the elements
+      std::sort(mNeighbours.begin(), mNeighbours.end());
+      for (int j : mNeighbours) {
         CluElement& digitN = mCluEl[j];
-
-        // call (digit,digitN) in THAT oder !!!!!
-        Int_t ineb = Geometry::areNeighbours(digitSeedAbsId, digitN.absId);
-        switch (ineb) {
-          case -1: // too early (e.g. previous module), do not look before j at subsequent passes
-            iFirst = j;
-            break;
-          case 0: // not a neighbour
-            break;
-          case 1: // are neighbours
-            cluelements.emplace_back(digitN);
-            digitN.energy = 0;
-            iDigitInCluster++;
-            break;
-          case 2: // too far from each other
-          default:
-            break;
-        } // switch
+        cluelements.emplace_back(digitN);
+        digitN.energy = 0;
+        iDigitInCluster++;
       }
     } // loop over cluster
     clu->setLastCluEl(cluelements.size());
@@ -226,6 +258,14 @@ void Clusterer::makeClusters(std::vector<Cluster>& clusters, std::vector<CluElem
     }
 
   } // energy theshold
+
+  // clean the grid for the next event
+  for (const auto& el : mCluEl) {
+    int cell = el.absId - 1;
+    if (cell >= 0 && cell < nCells) {
+      mCellToCluEl[cell] = -1;
+    }
+  }
 }
 //__________________________________________________________________________
 void Clusterer::makeUnfolding(Cluster& clu, std::vector<Cluster>& clusters, std::vector<CluElement>& cluelements)
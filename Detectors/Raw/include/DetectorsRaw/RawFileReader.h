@@ -43,17 +43,21 @@ struct ReaderInp {
   std::string dropTF{};
   std::string metricChannel{};
   std::string onlyDet{};
+  std::string indexFile{};
   size_t spSize = 1024L * 1024L;
   size_t bufferSize = 1024L * 1024L;
   size_t minSHM = 0;
   int loop = 1;
   int runNumber = 0;
+  int nThreadsPrescan = 1;
   uint32_t delay_us = 0;
   uint32_t errMap = 0xffffffff;
   uint32_t minTF = 0;
   uint32_t maxTF = 0xffffffff;
+  uint32_t readAheadTF = 0;
   bool partPerSP = true;
   bool cache = false;
+  bool mapFiles = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -209,6 +213,7 @@ class RawFileReader
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
+    const char* mapNextSuperPage(size_t& sz, const PartStat* pstat = nullptr);
     size_t skipNextHBF();
     size_t skipNextTF();
 
@@ -217,6 +222,8 @@ class RawFileReader
     std::string describe() const;
 
    private:
+    int getSuperPageEnd(size_t& sz, const PartStat* pstat) const;
+
     RawFileReader* reader = nullptr; //!
   };
 
@@ -272,6 +279,16 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  bool getMapFiles() const { return mMapFiles; }
+  void setMapFiles(bool v) { mMapFiles = v; }
+  const char* getMappedData(const LinkBlock& blc) const { return blc.fileID < mFileMaps.size() && mFileMaps[blc.fileID].first ? mFileMaps[blc.fileID].first + blc.offset : nullptr; }
+  void prefetchTFs(uint32_t tf, uint32_t nTF) const;
+
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n > 0 ? n : 1; }
+  const std::string& getIndexFile() const { return mIndexFile; }
+  void setIndexFile(const std::string& f) { mIndexFile = f; }
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -290,19 +307,30 @@ class RawFileReader
   static std::string nochk_expl(ErrTypes e);
 
  private:
+  using RDHScan = std::vector<std::pair<long int, RDHAny>>; // RDHs of the file with their offsets
+
   int getLinkLocalID(const RDHAny& rdh, int fileID);
-  bool preprocessFile(int ifl);
+  bool scanFile(int ifl, RDHScan& rdhs) const;
+  bool preprocessFile(int ifl, const RDHScan& rdhs);
+  void preprocessFiles();
+  std::string getIndexFileName() const;
+  std::string getIndexFingerprint() const;
+  bool loadIndex();
+  bool saveIndex() const;
+  bool mapFile(int ifl);
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
   static constexpr o2::header::DataDescription DEFDataDescription = o2::header::gDataDescriptionRawData;
   static constexpr ReadoutCardType DEFCardType = CRU;
+  static constexpr char IndexMagic[8] = {'O', '2', 'R', 'A', 'W', 'I', 'D', 'X'}; // signature of the pre-scan index file
   o2::header::DataOrigin mDefDataOrigin = DEFDataOrigin;                //!
   o2::header::DataDescription mDefDataDescription = DEFDataDescription; //!
   ReadoutCardType mDefCardType = CRU;                                   //!
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::pair<const char*, size_t>> mFileMaps;                //! optional read-only mappings of input files
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -320,6 +348,9 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mMapFiles = false;                                           //! map input files to memory instead of reading them
+  int mNThreads = 1;                                                //! number of threads for the files pre-scan
+  std::string mIndexFile{};                                         //! file to load the pre-scan index from or to store it to ("auto": next to the 1st input file)
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
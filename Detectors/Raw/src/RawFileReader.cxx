@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <iomanip>
 #include <memory>
@@ -26,10 +27,14 @@
 #include "DetectorsRaw/RDHUtils.h"
 #include "DetectorsRaw/HBFUtils.h"
 #include "Framework/Logger.h"
+#include <fmt/format.h>
 
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -133,6 +138,8 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     ibl++;
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
+    } else if (auto mapped = reader->getMappedData(blc)) {
+      memcpy(buff + sz, mapped, blc.size);
     } else {
       auto fl = reader->mFiles[blc.fileID];
       if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
@@ -258,22 +265,17 @@ int RawFileReader::LinkData::getNHBFinTF() const
 }
 
 //____________________________________________
-size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReader::PartStat* pstat)
+int RawFileReader::LinkData::getSuperPageEnd(size_t& sz, const RawFileReader::PartStat* pstat) const
 {
-  // read data of the next complete HB, buffer of getNextHBFSize() must be allocated in advance
-  size_t sz = 0;
-  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
-    return sz;
-  }
+  // find the block following the next superpage, its blocks are contiguous in the file
+  sz = 0;
   int ibl = nextBlock2Read, nbl = blocks.size();
-  auto tfID = blocks[nextBlock2Read].tfID;
-  bool error = false;
   if (pstat) { // info is provided, use it derictly
     sz = pstat->size;
     ibl += pstat->nBlocks;
   } else { // need to calculate blocks to read
     while (ibl < nbl) {
-      auto& blc = blocks[ibl];
+      const auto& blc = blocks[ibl];
       if (ibl > nextBlock2Read && (blc.tfID != blocks[nextBlock2Read].tfID ||
                                    blc.testFlag(LinkBlock::StartSP) ||
                                    (sz + blc.size) > reader->mNominalSPageSize ||
@@ -284,9 +286,24 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
       sz += blc.size;
     }
   }
+  return ibl;
+}
+
+//____________________________________________
+size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReader::PartStat* pstat)
+{
+  // read data of the next complete HB, buffer of getNextHBFSize() must be allocated in advance
+  size_t sz = 0;
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return sz;
+  }
+  int ibl = getSuperPageEnd(sz, pstat);
+  bool error = false;
   if (sz) {
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
+    } else if (auto mapped = reader->getMappedData(blocks[nextBlock2Read])) {
+      memcpy(buff, mapped, sz);
     } else {
       auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
       if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
@@ -303,6 +320,23 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
   return error ? 0 : sz; // in case of the error we ignore the data
 }
 
+//____________________________________________
+const char* RawFileReader::LinkData::mapNextSuperPage(size_t& sz, const RawFileReader::PartStat* pstat)
+{
+  // return the pointer on the data of the next superpage in the mapped file, w/o copying it.
+  // If the files are not mapped, nullptr is returned and the position is not changed
+  sz = 0;
+  if (nextBlock2Read < 0 || nextBlock2Read >= int(blocks.size())) { // negative nextBlock2Read signals absence of data
+    return nullptr;
+  }
+  auto mapped = reader->getMappedData(blocks[nextBlock2Read]);
+  if (!mapped) {
+    return nullptr;
+  }
+  nextBlock2Read = getSuperPageEnd(sz, pstat);
+  return mapped;
+}
+
 //____________________________________________
 size_t RawFileReader::LinkData::getLargestSuperPage() const
 {
@@ -570,80 +604,294 @@ int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
 }
 
 //_____________________________________________________________________
-bool RawFileReader::preprocessFile(int ifl)
+bool RawFileReader::scanFile(int ifl, RDHScan& rdhs) const
 {
-  // preprocess file, check RDH data, build statistics
+  // read the file and collect its RDHs with their offsets, can be called concurrently for different files
   std::unique_ptr<char[]> buffer = std::make_unique<char[]>(mBufferSize);
   FILE* fl = mFiles[ifl];
-  mCurrentFileID = ifl;
-  LinkSpec_t specPrev = 0xffffffffffffffff;
-  int lIDPrev = -1;
-  mMultiLinkFile = false;
   fseek(fl, 0L, SEEK_END);
   const auto fileSize = ftell(fl);
   rewind(fl);
-  long int nr = 0;
-  mPosInFile = 0;
-  size_t nRDHread = 0, boffs;
+  long int nr = 0, posInFile = 0;
+  size_t boffs;
   bool readMore = true;
+  rdhs.clear();
   while (readMore && (nr = fread(buffer.get(), 1, mBufferSize, fl))) {
     boffs = 0;
     while (1) {
-      auto& rdh = *reinterpret_cast<RDHUtils::RDHAny*>(&buffer[boffs]);
-      if ((mPosInFile + RDHUtils::getOffsetToNext(rdh)) > fileSize) {
-        LOGP(warning, "File {} truncated current file pos {} + offsetToNext {} > fileSize {}", ifl, mPosInFile, RDHUtils::getOffsetToNext(rdh), fileSize);
+      const auto& rdh = *reinterpret_cast<const RDHAny*>(&buffer[boffs]);
+      if ((posInFile + RDHUtils::getOffsetToNext(rdh)) > fileSize) {
+        LOGP(warning, "File {} truncated current file pos {} + offsetToNext {} > fileSize {}", ifl, posInFile, RDHUtils::getOffsetToNext(rdh), fileSize);
         readMore = false;
         break;
       }
-      nRDHread++;
-      LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
-      int lID = lIDPrev;
-      if (spec != specPrev) { // link has changed
-        specPrev = spec;
-        if (lIDPrev != -1) {
-          mMultiLinkFile = true;
+      rdhs.emplace_back(posInFile, rdh);
+      boffs += RDHUtils::getOffsetToNext(rdh);
+      posInFile += RDHUtils::getOffsetToNext(rdh);
+      if (boffs + sizeof(RDHAny) >= nr) {
+        if (fseek(fl, posInFile, SEEK_SET)) {
+          readMore = false;
         }
-        lID = getLinkLocalID(rdh, mCurrentFileID);
-      }
-      bool newSPage = lID != lIDPrev;
-      try {
-        mLinksData[lID].preprocessCRUPage(rdh, newSPage);
-      } catch (...) {
-        LOG(error) << "Corrupted data, abandoning processing";
-        mStopProcessing = true;
         break;
       }
+    }
+  }
+  return !rdhs.empty();
+}
 
-      if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
-        mLinksData[lID].nTimeFrames--;
-        mLinksData[lID].blocks.pop_back();
-        if (mLinksData[lID].nHBFrames > 0) {
-          mLinksData[lID].nHBFrames--;
-        }
-        if (mLinksData[lID].nCRUPages > 0) {
-          mLinksData[lID].nCRUPages--;
-        }
-        lIDPrev = -1; // last block is closed
-        readMore = false;
-        break;
+//_____________________________________________________________________
+bool RawFileReader::preprocessFile(int ifl, const RDHScan& rdhs)
+{
+  // preprocess RDHs of the file, check RDH data, build statistics
+  mCurrentFileID = ifl;
+  LinkSpec_t specPrev = 0xffffffffffffffff;
+  int lIDPrev = -1;
+  mMultiLinkFile = false;
+  mPosInFile = 0;
+  size_t nRDHread = 0;
+  for (const auto& [pos, rdh] : rdhs) {
+    mPosInFile = pos;
+    nRDHread++;
+    LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
+    int lID = lIDPrev;
+    if (spec != specPrev) { // link has changed
+      specPrev = spec;
+      if (lIDPrev != -1) {
+        mMultiLinkFile = true;
       }
-      boffs += RDHUtils::getOffsetToNext(rdh);
-      mPosInFile += RDHUtils::getOffsetToNext(rdh);
-      lIDPrev = lID;
-      if (boffs + sizeof(RDHUtils::RDHAny) >= nr) {
-        if (fseek(fl, mPosInFile, SEEK_SET)) {
-          readMore = false;
-          break;
-        }
-        break;
+      lID = getLinkLocalID(rdh, mCurrentFileID);
+    }
+    bool newSPage = lID != lIDPrev;
+    try {
+      mLinksData[lID].preprocessCRUPage(rdh, newSPage);
+    } catch (...) {
+      LOG(error) << "Corrupted data, abandoning processing";
+      mStopProcessing = true;
+      break;
+    }
+
+    if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
+      mLinksData[lID].nTimeFrames--;
+      mLinksData[lID].blocks.pop_back();
+      if (mLinksData[lID].nHBFrames > 0) {
+        mLinksData[lID].nHBFrames--;
       }
+      if (mLinksData[lID].nCRUPages > 0) {
+        mLinksData[lID].nCRUPages--;
+      }
+      lIDPrev = -1; // last block is closed
+      break;
     }
+    mPosInFile += RDHUtils::getOffsetToNext(rdh);
+    lIDPrev = lID;
   }
   LOGF(info, "File %3d : %9li bytes scanned, %6d RDH read for %4d links from %s",
        mCurrentFileID, mPosInFile, nRDHread, int(mLinkEntries.size()), mFileNames[mCurrentFileID]);
   return nRDHread > 0;
 }
 
+//_____________________________________________________________________
+void RawFileReader::preprocessFiles()
+{
+  // Scan the files in up to mNThreads threads ahead of the file being preprocessed.
+  // The RDHs must be preprocessed in the order of files since the links may span over several files.
+  int nf = mFiles.size();
+  std::vector<RDHScan> scans(nf);
+  std::vector<std::future<bool>> scanned(nf);
+  auto launchScan = [this, &scans, &scanned](int ifl) {
+    scanned[ifl] = std::async(mNThreads > 1 ? std::launch::async : std::launch::deferred, [this, &scans, ifl]() { return scanFile(ifl, scans[ifl]); });
+  };
+  for (int i = 0; i < std::min(mNThreads, nf); i++) {
+    launchScan(i);
+  }
+  for (int i = 0; i < nf; i++) {
+    scanned[i].get();
+    if (i + mNThreads < nf) {
+      launchScan(i + mNThreads);
+    }
+    if (!mStopProcessing && preprocessFile(i, scans[i])) {
+      mEmpty = false;
+    }
+    RDHScan().swap(scans[i]); // release the memory
+  }
+}
+
+//_____________________________________________________________________
+std::string RawFileReader::getIndexFileName() const
+{
+  if (mIndexFile == "auto") {
+    return mFileNames.empty() ? std::string{} : mFileNames.front() + ".rawidx";
+  }
+  return mIndexFile;
+}
+
+//_____________________________________________________________________
+std::string RawFileReader::getIndexFingerprint() const
+{
+  // the index is valid only for the same files and settings affecting the preprocessing
+  const auto& hbfu = HBFUtils::Instance();
+  std::string fp = fmt::format("chk:{:#x} maxTF:{} calcTF:{} autoTF:{} HBFPerTF:{}", mCheckErrors, mMaxTFToRead, mPreferCalculatedTFStart,
+                               int(mFirstTFAutodetect), hbfu.getNOrbitsPerTF());
+  if (mFirstTFAutodetect != FirstTFDetection::Pending) {
+    fp += fmt::format(" orbitFirst:{}", hbfu.orbitFirst);
+  }
+  for (size_t i = 0; i < mFileNames.size(); i++) {
+    struct stat st;
+    if (stat(mFileNames[i].c_str(), &st)) {
+      return {};
+    }
+    fp += fmt::format("\n{} {} {} {}/{}/{}", mFileNames[i], st.st_size, st.st_mtime, std::get<0>(mDataSpecs[i]).as<std::string>(),
+                      std::get<1>(mDataSpecs[i]).as<std::string>(), int(std::get<2>(mDataSpecs[i])));
+  }
+  return fp;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::saveIndex() const
+{
+  // store the links data produced by the preprocessing
+  auto fname = getIndexFileName();
+  auto fp = getIndexFingerprint();
+  if (fname.empty() || fp.empty()) {
+    return false;
+  }
+  auto ftmp = fname + ".tmp";
+  FILE* fl = fopen(ftmp.c_str(), "wb");
+  if (!fl) {
+    LOG(warning) << "Failed to create pre-scan index file " << fname;
+    return false;
+  }
+  bool ok = true;
+  auto wr = [fl, &ok](const auto& v) { ok &= fwrite(&v, sizeof(v), 1, fl) == 1; };
+  ok &= fwrite(IndexMagic, sizeof(IndexMagic), 1, fl) == 1;
+  wr(uint32_t(fp.size()));
+  ok &= fwrite(fp.data(), 1, fp.size(), fl) == fp.size();
+  wr(uint8_t(mFirstTFAutodetect == FirstTFDetection::Done));
+  wr(HBFUtils::Instance().orbitFirst);
+  wr(uint8_t(mEmpty));
+  wr(uint32_t(mLinksData.size()));
+  for (const auto& link : mLinksData) {
+    wr(link.rdhl);
+    wr(link.irOfSOX);
+    wr(link.spec);
+    wr(link.subspec);
+    wr(link.nTimeFrames);
+    wr(link.nHBFrames);
+    wr(link.nSPages);
+    wr(link.nCRUPages);
+    wr(link.cruDetector);
+    wr(link.continuousRO);
+    wr(link.origin);
+    wr(link.description);
+    wr(link.nErrors);
+    wr(uint32_t(link.blocks.size()));
+    for (const auto& blc : link.blocks) {
+      wr(blc.offset);
+      wr(blc.size);
+      wr(blc.tfID);
+      wr(blc.ir);
+      wr(blc.fileID);
+      wr(blc.flags);
+    }
+    wr(uint32_t(link.tfStartBlock.size()));
+    for (const auto& tfs : link.tfStartBlock) {
+      wr(tfs);
+    }
+  }
+  ok &= fclose(fl) == 0;
+  if (!ok || std::rename(ftmp.c_str(), fname.c_str())) {
+    LOG(warning) << "Failed to write pre-scan index file " << fname;
+    std::remove(ftmp.c_str());
+    return false;
+  }
+  LOGF(info, "Stored pre-scan index of %d links to %s", int(mLinksData.size()), fname);
+  return true;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::loadIndex()
+{
+  // load the links data from the index of the previous preprocessing, if it matches the inputs
+  auto fname = getIndexFileName();
+  if (fname.empty()) {
+    return false;
+  }
+  FILE* fl = fopen(fname.c_str(), "rb");
+  if (!fl) {
+    LOG(info) << "No pre-scan index " << fname << " is found, the files will be scanned";
+    return false;
+  }
+  bool ok = true;
+  auto rd = [fl, &ok](auto& v) { ok &= fread(&v, sizeof(v), 1, fl) == 1; };
+  char magic[sizeof(IndexMagic)];
+  uint32_t n = 0;
+  ok &= fread(magic, sizeof(magic), 1, fl) == 1 && memcmp(magic, IndexMagic, sizeof(magic)) == 0;
+  rd(n);
+  std::string fp(ok ? n : 0, '\0');
+  ok &= fread(fp.data(), 1, fp.size(), fl) == fp.size() && fp == getIndexFingerprint();
+  if (!ok) {
+    LOG(warning) << "Pre-scan index " << fname << " does not match the inputs, the files will be scanned";
+    fclose(fl);
+    return false;
+  }
+  uint8_t firstTFDone = 0, empty = 1;
+  uint32_t orbitFirst = 0;
+  rd(firstTFDone);
+  rd(orbitFirst);
+  rd(empty);
+  rd(n);
+  std::vector<LinkData> links;
+  std::unordered_map<LinkSpec_t, int> entries;
+  for (uint32_t il = 0; ok && il < n; il++) {
+    RDHAny rdhl;
+    rd(rdhl);
+    auto& link = links.emplace_back(rdhl, this);
+    rd(link.irOfSOX);
+    rd(link.spec);
+    rd(link.subspec);
+    rd(link.nTimeFrames);
+    rd(link.nHBFrames);
+    rd(link.nSPages);
+    rd(link.nCRUPages);
+    rd(link.cruDetector);
+    rd(link.continuousRO);
+    rd(link.origin);
+    rd(link.description);
+    rd(link.nErrors);
+    uint32_t nb = 0;
+    rd(nb);
+    link.blocks.resize(ok ? nb : 0);
+    for (auto& blc : link.blocks) {
+      rd(blc.offset);
+      rd(blc.size);
+      rd(blc.tfID);
+      rd(blc.ir);
+      rd(blc.fileID);
+      rd(blc.flags);
+      ok &= blc.fileID < mFiles.size();
+    }
+    rd(nb);
+    link.tfStartBlock.resize(ok ? nb : 0);
+    for (auto& tfs : link.tfStartBlock) {
+      rd(tfs);
+    }
+    entries[link.spec] = il;
+  }
+  fclose(fl);
+  if (!ok) {
+    LOG(warning) << "Failed to read pre-scan index " << fname << ", the files will be scanned";
+    return false;
+  }
+  if (firstTFDone && mFirstTFAutodetect == FirstTFDetection::Pending) {
+    imposeFirstTF(orbitFirst);
+  }
+  mLinksData.swap(links);
+  mLinkEntries.swap(entries);
+  mEmpty = empty;
+  LOGF(info, "Loaded pre-scan index of %d links from %s", int(mLinksData.size()), fname);
+  return true;
+}
+
 //_____________________________________________________________________
 void RawFileReader::printStat(bool verbose) const
 {
@@ -666,6 +914,12 @@ void RawFileReader::clear()
     fclose(fl);
   }
   mFiles.clear();
+  for (auto& fmap : mFileMaps) {
+    if (fmap.first) {
+      munmap(const_cast<char*>(fmap.first), fmap.second);
+    }
+  }
+  mFileMaps.clear();
   mFileNames.clear();
 
   mCurrentFileID = 0;
@@ -724,9 +978,16 @@ bool RawFileReader::init()
 
   int nf = mFiles.size();
   mEmpty = true;
-  for (int i = 0; i < nf; i++) {
-    if (preprocessFile(i)) {
-      mEmpty = false;
+  if (!loadIndex()) {
+    preprocessFiles();
+    if (!mStopProcessing && !mIndexFile.empty()) {
+      saveIndex();
+    }
+  }
+  if (mMapFiles) {
+    mFileMaps.resize(nf, {nullptr, 0});
+    for (int i = 0; i < nf; i++) {
+      mapFile(i);
     }
   }
   if (mStopProcessing) {
@@ -788,6 +1049,72 @@ bool RawFileReader::init()
   return !mEmpty;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::mapFile(int ifl)
+{
+  // map the input file read-only, in case of failure the file will be read via its FILE handler
+  int fd = fileno(mFiles[ifl]);
+  struct stat st;
+  if (fstat(fd, &st) || st.st_size <= 0) {
+    LOG(warning) << "Failed to stat input file " << mFileNames[ifl] << ", it will not be mapped";
+    return false;
+  }
+  size_t sz = st.st_size;
+  void* ptr = mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (ptr == MAP_FAILED) {
+    LOG(warning) << "Failed to map input file " << mFileNames[ifl] << ", it will be read";
+    return false;
+  }
+  madvise(ptr, sz, MADV_SEQUENTIAL);
+  mFileMaps[ifl] = {reinterpret_cast<const char*>(ptr), sz};
+  LOGF(info, "Mapped %zu bytes of input file %s", sz, mFileNames[ifl]);
+  return true;
+}
+
+//_____________________________________________________________________
+void RawFileReader::prefetchTFs(uint32_t tf, uint32_t nTF) const
+{
+  // ask the kernel to read ahead the data of nTF TFs starting from tf, the hint is given per contiguous range of blocks
+  if (!nTF) {
+    return;
+  }
+  static const size_t pageSize = sysconf(_SC_PAGESIZE);
+  auto advise = [this](int fileID, size_t offs, size_t sz) {
+    if (fileID < int(mFileMaps.size()) && mFileMaps[fileID].first) {
+      size_t start = offs & ~(pageSize - 1); // madvise needs page-aligned address
+      madvise(const_cast<char*>(mFileMaps[fileID].first) + start, sz + offs - start, MADV_WILLNEED);
+    } else {
+      posix_fadvise(fileno(mFiles[fileID]), offs, sz, POSIX_FADV_WILLNEED);
+    }
+  };
+  for (const auto& link : mLinksData) {
+    if (tf >= link.tfStartBlock.size()) {
+      continue;
+    }
+    int ibl = link.tfStartBlock[tf].first, nbl = tf + nTF < link.tfStartBlock.size() ? link.tfStartBlock[tf + nTF].first : link.blocks.size();
+    int fileID = -1;
+    size_t offs = 0, sz = 0;
+    for (; ibl < nbl; ibl++) {
+      const auto& blc = link.blocks[ibl];
+      if (blc.dataCache) {
+        continue;
+      }
+      if (blc.fileID != fileID || offs + sz != blc.offset) { // new contiguous range
+        if (sz) {
+          advise(fileID, offs, sz);
+        }
+        fileID = blc.fileID;
+        offs = blc.offset;
+        sz = 0;
+      }
+      sz += blc.size;
+    }
+    if (sz) {
+      advise(fileID, offs, sz);
+    }
+  }
+}
+
 //_____________________________________________________________________
 o2h::DataOrigin RawFileReader::getDataOrigin(const std::string& ors)
 {
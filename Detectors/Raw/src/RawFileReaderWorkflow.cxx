@@ -87,6 +87,9 @@ class RawReaderSpecs : public o2f::Task
   size_t mSentSize = 0;
   size_t mSentMessages = 0;
   bool mPartPerSP = true;                                          // fill part per superpage
+  bool mMapFiles = false;                                          // read from mapped files, sending superpages w/o copy when possible
+  uint32_t mReadAheadTF = 0;                                       // number of TFs to prefetch ahead of the one being read
+  uint32_t mNextTFToPrefetch = 0;                                  // 1st TF not yet prefetched
   bool mSup0xccdb = false;                                         // suppress explicit FLP/DISTSUBTIMEFRAME/0xccdb output
   std::string mRawChannelName = "";                                // name of optional non-DPL channel
   std::unique_ptr<o2::raw::RawFileReader> mReader;                 // matching engine
@@ -96,12 +99,15 @@ class RawReaderSpecs : public o2f::Task
 
 //___________________________________________________________
 RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
-  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mRunNumber(rinp.runNumber), mPartPerSP(rinp.partPerSP), mSup0xccdb(rinp.sup0xccdb), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize, rinp.onlyDet)), mRawChannelName(rinp.rawChannelConfig), mPreferCalcTF(rinp.preferCalcTF), mMinSHM(rinp.minSHM)
+  : mLoop(rinp.loop < 0 ? INT_MAX : (rinp.loop < 1 ? 1 : rinp.loop)), mDelayUSec(rinp.delay_us), mMinTFID(rinp.minTF), mMaxTFID(rinp.maxTF), mRunNumber(rinp.runNumber), mPartPerSP(rinp.partPerSP), mMapFiles(rinp.mapFiles), mReadAheadTF(rinp.readAheadTF), mSup0xccdb(rinp.sup0xccdb), mReader(std::make_unique<o2::raw::RawFileReader>(rinp.inifile, 0, rinp.bufferSize, rinp.onlyDet)), mRawChannelName(rinp.rawChannelConfig), mPreferCalcTF(rinp.preferCalcTF), mMinSHM(rinp.minSHM)
 {
   mReader->setCheckErrors(rinp.errMap);
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setMapFiles(rinp.mapFiles);
+  mReader->setNThreads(rinp.nThreadsPrescan);
+  mReader->setIndexFile(rinp.indexFile);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -220,6 +226,16 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     tfID = mMinTFID;
   }
   mReader->setNextTFToRead(tfID);
+  if (mReadAheadTF) { // hint the kernel on the data of the following TFs which were not yet prefetched
+    if (mNextTFToPrefetch <= tfID || mNextTFToPrefetch > tfID + mReadAheadTF + 1) { // 1st call or new loop started
+      mNextTFToPrefetch = tfID + 1;
+    }
+    auto lastTF = std::min(tfID + mReadAheadTF, mMaxTFID);
+    if (lastTF >= mNextTFToPrefetch) {
+      mReader->prefetchTFs(mNextTFToPrefetch, lastTF - mNextTFToPrefetch + 1);
+      mNextTFToPrefetch = lastTF + 1;
+    }
+  }
   std::vector<RawFileReader::PartStat> partsSP;
 
   static o2f::RateLimiter limiter;
@@ -266,8 +282,19 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
       hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
       auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      fair::mq::MessagePtr plMessage;
+      size_t bread = 0;
+      const char* mapped = (mPartPerSP && mMapFiles) ? link.mapNextSuperPage(bread, &partsSP[hdrTmpl.splitPayloadIndex]) : nullptr;
+      if (mapped && (reinterpret_cast<uintptr_t>(mapped) & 63) == 0) { // message pointing to the mapped superpage, which stays valid as long as the reader
+        plMessage = fmqFactory->CreateMessage(const_cast<char*>(mapped), bread, [](void*, void*) {}, nullptr);
+      } else {
+        plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        if (mapped) { // misaligned superpage must be copied
+          memcpy(plMessage->GetData(), mapped, bread);
+        } else {
+          bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+        }
+      }
       if (bread != hdrTmpl.payloadSize) {
         LOG(error) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
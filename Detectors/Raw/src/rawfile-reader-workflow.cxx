@@ -17,6 +17,7 @@
 #include "Framework/Logger.h"
 #include <string>
 #include <bitset>
+#include <algorithm>
 
 using namespace o2::framework;
 using namespace o2::raw;
@@ -38,6 +39,10 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
   options.push_back(ConfigParamSpec{"part-per-sp", VariantType::Bool, false, {"FMQ parts per superpage instead of per HBF"}});
   options.push_back(ConfigParamSpec{"raw-channel-config", VariantType::String, "", {"optional raw FMQ channel for non-DPL output"}});
   options.push_back(ConfigParamSpec{"cache-data", VariantType::Bool, false, {"cache data at 1st reading, may require excessive memory!!!"}});
+  options.push_back(ConfigParamSpec{"map-files", VariantType::Bool, false, {"map input files to memory, superpage parts are sent w/o copy if possible"}});
+  options.push_back(ConfigParamSpec{"prescan-threads", VariantType::Int, 1, {"number of threads to pre-scan the input files"}});
+  options.push_back(ConfigParamSpec{"index-file", VariantType::String, "", {"file to load the pre-scan index from or store it to if absent/outdated, \"auto\" for <1st input file>.rawidx"}});
+  options.push_back(ConfigParamSpec{"readahead-tf", VariantType::Int, 0, {"number of TFs to prefetch from the files ahead of the one being read"}});
   options.push_back(ConfigParamSpec{"detect-tf0", VariantType::Bool, false, {"autodetect HBFUtils start Orbit/BC from 1st TF seen"}});
   options.push_back(ConfigParamSpec{"calculate-tf-start", VariantType::Bool, false, {"calculate TF start instead of using TType"}});
   options.push_back(ConfigParamSpec{"drop-tf", VariantType::String, "none", {"Drop each TFid%(1)==(2) of detector, e.g. ITS,2,4;TPC,4[,0];..."}});
@@ -72,6 +77,10 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   rinp.spSize = uint64_t(configcontext.options().get<int64_t>("super-page-size"));
   rinp.partPerSP = configcontext.options().get<bool>("part-per-sp");
   rinp.cache = configcontext.options().get<bool>("cache-data");
+  rinp.mapFiles = configcontext.options().get<bool>("map-files");
+  rinp.nThreadsPrescan = configcontext.options().get<int>("prescan-threads");
+  rinp.indexFile = configcontext.options().get<std::string>("index-file");
+  rinp.readAheadTF = uint32_t(std::max(0, configcontext.options().get<int>("readahead-tf")));
   rinp.autodetectTF0 = configcontext.options().get<bool>("detect-tf0");
   rinp.preferCalcTF = configcontext.options().get<bool>("calculate-tf-start");
   rinp.rawChannelConfig = configcontext.options().get<std::string>("raw-channel-config");
@@ -14,6 +14,7 @@
 #define BOOST_TEST_DYN_LINK
 #include <algorithm>
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <TRandom.h>
@@ -189,9 +190,12 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
 
   std::unique_ptr<RawFileReader> reader;
   std::string confName;
+  bool mapFiles = false;
+  int nThreads = 1;
+  std::string indexFile{};
 
   //_________________________________________________________________
-  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg") : confName(cfg) {}
+  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg", bool mapf = false) : confName(cfg), mapFiles(mapf) {}
 
   //_________________________________________________________________
   void init()
@@ -200,7 +204,11 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
     uint32_t errCheck = 0xffffffff;
     errCheck ^= 0x1 << RawFileReader::ErrNoSuperPageForTF; // makes no sense for superpages not interleaved by others
     reader->setCheckErrors(errCheck);
+    reader->setMapFiles(mapFiles);
+    reader->setNThreads(nThreads);
+    reader->setIndexFile(indexFile);
     reader->init();
+    reader->prefetchTFs(0, 2);
   }
 
   //_________________________________________________________________
@@ -329,4 +337,67 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
   dr.run(); // read back and check
 }
 
+BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU_Index)
+{
+  const std::string indexFile = "test_raw_index.rawidx";
+  std::remove(indexFile.c_str());
+  TestRawWriter dw{"TST", true, "test_raw_conf_GBT_idx.cfg"};
+  dw.init();
+  dw.run(); // write output
+  //
+  TestRawReader dr{"TST", "test_raw_conf_GBT_idx.cfg"}; // parallel pre-scan, storing the index
+  dr.nThreads = 3;
+  dr.indexFile = indexFile;
+  dr.init();
+  BOOST_CHECK(std::ifstream(indexFile).good());
+  dr.run();
+  //
+  TestRawReader drIdx{"TST", "test_raw_conf_GBT_idx.cfg"}; // pre-scan replaced by the index
+  drIdx.indexFile = indexFile;
+  drIdx.init();
+  BOOST_REQUIRE(drIdx.reader->getNLinks() == dr.reader->getNLinks());
+  for (int il = 0; il < dr.reader->getNLinks(); il++) {
+    const auto &lnk = dr.reader->getLink(il), &lnkIdx = drIdx.reader->getLink(il);
+    BOOST_CHECK(lnk.spec == lnkIdx.spec);
+    BOOST_CHECK(lnk.nTimeFrames == lnkIdx.nTimeFrames);
+    BOOST_REQUIRE(lnk.blocks.size() == lnkIdx.blocks.size());
+    for (size_t ib = 0; ib < lnk.blocks.size(); ib++) {
+      BOOST_CHECK(lnk.blocks[ib].offset == lnkIdx.blocks[ib].offset && lnk.blocks[ib].size == lnkIdx.blocks[ib].size && lnk.blocks[ib].flags == lnkIdx.blocks[ib].flags);
+    }
+  }
+  drIdx.run();
+  std::remove(indexFile.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(RawReaderWriter_CRU_Mapped)
+{
+  TestRawWriter dw{"TST", true, "test_raw_conf_GBT_map.cfg"};
+  dw.init();
+  dw.run(); // write output
+  //
+  TestRawReader dr{"TST", "test_raw_conf_GBT_map.cfg", true}; // read back from mapped files
+  dr.init();
+  dr.run(); // read back and check
+
+  // superpages provided from the mapped files must be identical to those read
+  auto& reader = *dr.reader;
+  std::vector<RawFileReader::PartStat> parts;
+  std::vector<char> buff;
+  for (int il = 0; il < reader.getNLinks(); il++) {
+    auto& lnk = reader.getLink(il);
+    BOOST_REQUIRE(lnk.rewindToTF(0));
+    int nParts = lnk.getNextTFSuperPagesStat(parts);
+    for (int ip = 0; ip < nParts; ip++) {
+      size_t sz = 0;
+      auto mapped = lnk.mapNextSuperPage(sz, &parts[ip]);
+      BOOST_REQUIRE(mapped != nullptr);
+      BOOST_CHECK(sz == size_t(parts[ip].size));
+      buff.resize(sz);
+      lnk.nextBlock2Read -= parts[ip].nBlocks; // step back to read the same superpage
+      BOOST_CHECK(lnk.readNextSuperPage(buff.data(), &parts[ip]) == sz);
+      BOOST_CHECK(memcmp(buff.data(), mapped, sz) == 0);
+    }
+  }
+}
+
 } // namespace o2
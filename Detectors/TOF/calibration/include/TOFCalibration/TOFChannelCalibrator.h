@@ -22,6 +22,7 @@
 #include "TOFBase/CalibTOFapi.h"
 
 #include <array>
+#include <vector>
 #include <boost/histogram.hpp>
 
 #include "TGraphErrors.h"
@@ -261,6 +262,10 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<o
   void setNThreads(int n) { mNThreads = std::min(n, NMAXTHREADS); }
   int getNThreads() const { return mNThreads; }
 
+  /// use the median of the peak (with sub-bin interpolation) and the sigma from its MAD instead of the gaussian fit
+  void setUseRobustEstimator(bool val = true) { mUseRobustEstimator = val; }
+  bool useRobustEstimator() const { return mUseRobustEstimator; }
+
   void setStripFunction()
   {
     mStripOffsetFunction.clear();
@@ -302,6 +307,20 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<o
   }
 
  private:
+  /// offset extracted for one channel, stored in the TimeSlewing object once all channels are processed
+  struct ChannelResult {
+    enum Status { kNoStat,      // not enough entries, the channel is not calibrated
+                  kFailed,      // the fit (or estimate) failed
+                  kProblematic, // small fraction under the peak, large sigma or offset out of range
+                  kGood };
+    Status status = kNoStat;
+    float offset = 0.;    // offset in ps, BC included
+    float sigma = 99999.; // sigma of the peak in ps
+    float fraction = -1.; // fraction of the entries under the peak
+  };
+
+  ChannelResult extractChannel(const TOFChannelData* c, int ich, std::vector<float>& histoValues) const;
+
   int mMinEntries = 0; // min number of entries to calibrate the TimeSlot
   int mNBins = 0;      // bins of the histogram with the t-text per channel
   float mRange = 0.;   // range of the histogram with the t-text per channel
@@ -324,6 +343,8 @@ class TOFChannelCalibrator final : public o2::calibration::TimeSlotCalibration<o
 
   int mNThreads = 1; // number of threads from OpenMP
 
+  bool mUseRobustEstimator = false; // median/MAD of the peak instead of the gaussian fit for the channel offsets
+
   std::string mStripOffsetFunction; // TLinear functon for fitting channel offset within the strip in cosmic data
 
   TLinearFitter mLinFitters[NMAXTHREADS]; // fitters for OpenMP for fitGaus
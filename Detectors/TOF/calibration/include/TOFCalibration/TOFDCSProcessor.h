@@ -12,6 +12,7 @@
 #ifndef DETECTOR_TOFDCSPROCESSOR_H_
 #define DETECTOR_TOFDCSPROCESSOR_H_
 
+#include <algorithm>
 #include <memory>
 #include <Rtypes.h>
 #include <unordered_map>
@@ -20,6 +21,8 @@
 #include "Framework/Logger.h"
 #include "DetectorsDCS/DataPointCompositeObject.h"
 #include "DetectorsDCS/DataPointIdentifier.h"
+#include "DetectorsDCS/DataPointIndex.h"
+#include "DetectorsDCS/DataPointSeries.h"
 #include "DetectorsDCS/DataPointValue.h"
 #include "DetectorsDCS/DeliveryType.h"
 #include "CCDB/CcdbObjectInfo.h"
@@ -92,7 +95,7 @@ class TOFDCSProcessor
 
   //int process(const std::vector<DPCOM>& dps);
   int process(const gsl::span<const DPCOM> dps);
-  int processDP(const DPCOM& dpcom);
+  int processDP(const DPCOM& dpcom, int index);
   uint64_t processFlags(uint64_t flag, const char* pid);
 
   void updateDPsCCDB();
@@ -128,26 +131,20 @@ class TOFDCSProcessor
 
   void clearDPsinfo()
   {
-    mDpsdoublesmap.clear();
+    mDpsdoubles.clear();
     //    mTOFDCS.clear();
   }
 
   bool areAllDPsFilled()
   {
-    for (auto& it : mPids) {
-      if (!it.second) {
-        return false;
-      }
-    }
-    return true;
+    return std::all_of(mPidProcessed.begin(), mPidProcessed.end(), [](bool processed) { return processed; });
   }
 
  private:
   std::unordered_map<DPID, TOFDCSinfo> mTOFDCS;                // this is the object that will go to the CCDB
-  std::unordered_map<DPID, bool> mPids;                        // contains all PIDs for the processor, the bool
-                                                               // will be true if the DP was processed at least once
-  std::unordered_map<DPID, std::vector<DPVAL>> mDpsdoublesmap; // this is the map that will hold the DPs for the
-                                                               // double type (voltages and currents)
+  o2::dcs::DataPointIndex mPidIndex;                           //! index of all PIDs for the processor
+  std::vector<bool> mPidProcessed;                             //! true if the DP of the index was processed at least once
+  o2::dcs::DataPointSeries mDpsdoubles;                        //! values of the DPs of double type (voltages and currents), by index
 
   std::array<std::array<TOFFEACinfo, NFEACS>, NDDLS> mFeacInfo;                       // contains the strip/pad info per FEAC
   std::array<std::bitset<8>, NDDLS> mPrevFEACstatus;                                  // previous FEAC status
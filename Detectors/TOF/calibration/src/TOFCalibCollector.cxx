@@ -99,19 +99,20 @@ void TOFCalibInfoSlot::merge(const TOFCalibInfoSlot* prev)
 
   LOG(debug) << "Merging two slots with entries: current slot -> " << mTOFCollectedCalibInfoSlot.size() << " , previous slot -> " << prev->mTOFCollectedCalibInfoSlot.size();
 
+  // both vectors are grouped by channel: we interleave the blocks of the channels
+  // which have entries, copying each block at once
   int offset = 0, offsetPrev = 0;
   std::vector<o2::dataformats::CalibInfoTOF> tmpVector;
+  tmpVector.reserve(mTOFCollectedCalibInfoSlot.size() + prev->mTOFCollectedCalibInfoSlot.size());
+  auto cur = mTOFCollectedCalibInfoSlot.begin();
+  auto old = prev->mTOFCollectedCalibInfoSlot.begin();
   for (int ch = 0; ch < Geo::NCHANNELS; ch++) {
     if (mEntriesSlot[ch] != 0) {
-      for (int i = offset; i < offset + mEntriesSlot[ch]; i++) {
-        tmpVector.emplace_back(mTOFCollectedCalibInfoSlot[i]);
-      }
+      tmpVector.insert(tmpVector.end(), cur + offset, cur + offset + mEntriesSlot[ch]);
       offset += mEntriesSlot[ch];
     }
     if (prev->mEntriesSlot[ch] != 0) {
-      for (int i = offsetPrev; i < offsetPrev + prev->mEntriesSlot[ch]; i++) {
-        tmpVector.emplace_back(prev->mTOFCollectedCalibInfoSlot[i]);
-      }
+      tmpVector.insert(tmpVector.end(), old + offsetPrev, old + offsetPrev + prev->mEntriesSlot[ch]);
       offsetPrev += prev->mEntriesSlot[ch];
       mEntriesSlot[ch] += prev->mEntriesSlot[ch];
     }
@@ -653,160 +653,180 @@ void TOFChannelCalibrator<T>::finalizeSlotWithCosmics(Slot& slot)
 //_____________________________________________
 
 template <typename T>
-void TOFChannelCalibrator<T>::finalizeSlotWithTracks(Slot& slot)
+typename TOFChannelCalibrator<T>::ChannelResult TOFChannelCalibrator<T>::extractChannel(const TOFChannelData* c, int ich, std::vector<float>& histoValues) const
 {
-  // Extract results for the single slot
-  o2::tof::TOFChannelData* c = slot.getContainer();
-  LOG(info) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
+  // Extract the offset of one channel from its t-texp distribution;
+  // this only reads the container, so that it can be called concurrently for different channels
+
+  ChannelResult res;
+  auto entriesInChannel = c->integral(ich);
+  if (entriesInChannel == 0) {
+    return res; // a channel with 0 entries is normal, it will be flagged as problematic
+  }
+  if (entriesInChannel < mMinEntries) {
+    LOG(debug) << "channel " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << mMinEntries << ")";
+    return res;
+  }
+
+  int sector = ich / Geo::NPADSXSECTOR;
+  int chinsector = ich % Geo::NPADSXSECTOR;
+  const auto& histo = c->getHisto(sector);
   int nbins = c->getNbins();
   float range = c->getRange();
-  std::vector<int> entriesPerChannel = c->getEntriesPerChannel();
 
-  // for the CCDB entry
-  std::map<std::string, std::string> md;
-  TimeSlewing ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
-  ts.bind();
-
-#ifdef WITH_OPENMP
-  if (mNThreads < 1) {
-    mNThreads = std::min(omp_get_max_threads(), NMAXTHREADS);
+  std::array<double, 3> fitValues;
+  fitValues.fill(-99999999);
+  histoValues.clear();
+  // more efficient way
+  int imax = nbins / 2;
+  double maxval = 0;
+  double binwidth = 2 * range / nbins;
+  int binrange = int(1500 / binwidth) + 1;
+  int nbinsUsed = 0;
+  for (int i = 0; i < nbins; ++i) { // find peak
+    const auto& v = histo.at(i, chinsector);
+    if (v > maxval) {
+      maxval = v;
+      imax = i;
+    }
   }
-  LOG(debug) << "Number of threads that will be used = " << mNThreads;
-#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
-#else
-  mNThreads = 1;
-#endif
-  for (int sector = 0; sector < Geo::NSECTORS; sector++) {
-    TMatrixD mat(3, 3);
-    int ithread = 0;
-#ifdef WITH_OPENMP
-    ithread = omp_get_thread_num();
-#endif
-    LOG(info) << "Processing sector " << sector << " with thread " << ithread;
-    auto& histo = c->getHisto(sector);
 
-    std::array<double, 3> fitValues;
-    std::vector<float> histoValues;
-    for (int chinsector = 0; chinsector < Geo::NPADSXSECTOR; chinsector++) {
-      // make the slice of the 2D histogram so that we have the 1D of the current channel
-      int ich = chinsector + sector * Geo::NPADSXSECTOR;
-      auto entriesInChannel = entriesPerChannel.at(ich);
-      if (entriesInChannel == 0) {
-        ts.setChannelOffset(ich, 0.0);
-        continue; // skip always since a channel with 0 entries is normal, it will be flagged as problematic
-      }
+  float renorm = 1.; // to avoid fit problem when stats is too large (bad chi2)
+  if (maxval > 10) {
+    renorm = 10. / maxval;
+  }
 
-      if (entriesInChannel < mMinEntries) {
-        LOG(debug) << "channel " << ich << " will not be calibrated since it has only " << entriesInChannel << " entries (min = " << mMinEntries << ")";
-        ts.setChannelOffset(ich, 0.0);
-        continue;
-      }
+  for (int i = std::max(0, imax - binrange); i < std::min(nbins, imax + binrange); ++i) { // not count for entries far from the peak (fit optimization)
+    const auto& v = histo.at(i, chinsector);
+    histoValues.push_back(v * renorm);
+    nbinsUsed++;
+  }
 
-      LOG(debug) << "channel " << ich << " will be calibrated since it has " << entriesInChannel << " entries (min = " << mMinEntries << ")";
-      fitValues.fill(-99999999);
-      histoValues.clear();
-      // more efficient way
-      int imax = nbins / 2;
-      double maxval = 0;
-      double binwidth = 2 * range / nbins;
-      int binrange = int(1500 / binwidth) + 1;
-      float minRange = -range;
-      float maxRange = range;
-      int nbinsUsed = 0;
-      for (unsigned j = chinsector; j <= chinsector; ++j) {
-        for (unsigned i = 0; i < nbins; ++i) { // find peak
-          const auto& v = histo.at(i, j);
-          if (v > maxval) {
-            maxval = v;
-            imax = i;
-          }
-        }
+  float minRange = (std::max(0, imax - binrange) - nbins / 2) * binwidth;
+  float maxRange = minRange + nbinsUsed * binwidth;
 
-        float renorm = 1.; // to avoid fit problem when stats is too large (bad chi2)
-        if (maxval > 10) {
-          renorm = 10. / maxval;
-        }
+  double fitres = -10;
+  if (mUseRobustEstimator) {
+    // median of the truncated distribution (with sub-bin interpolation) and sigma from its MAD
+    fitres = o2::math_utils::medmadGaus(nbinsUsed, histoValues.data(), minRange, maxRange, fitValues) ? 0 : -10;
+  } else {
+    fitres = fitGaus(nbinsUsed, histoValues.data(), minRange, maxRange, fitValues, nullptr, 2., false);
+  }
+  if (fitres > -10) {
+    LOG(debug) << "Channel " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
+  } else {
+#ifdef DEBUGGING
+    FILE* f = fopen(Form("%d.cal", ich), "w");
+    for (int i = 0; i < histoValues.size(); i++) {
+      fprintf(f, "%d %f %f\n", i, minRange + binwidth * i, histoValues[i]);
+    }
+    fclose(f);
+#endif
+    LOG(debug) << "Channel " << ich << " :: Fit failed with result = " << fitres;
+    res.status = ChannelResult::kFailed;
+    return res;
+  }
 
-        for (unsigned i = 0; i < nbins; ++i) {
-          const auto& v = histo.at(i, j);
-          LOG(debug) << "channel = " << ich << ", in sector = " << sector << " (where it is channel = " << chinsector << ") bin = " << i << " value = " << v;
-          if (i >= imax - binrange && i < imax + binrange) {
-            histoValues.push_back(v * renorm);
-            nbinsUsed++;
-          } // not count for entries far from the peak (fit optimization)
-        }
-      }
+  if (fitValues[2] < 0) {
+    fitValues[2] = -fitValues[2];
+  }
 
-      minRange = (imax - nbins / 2 - binrange) * binwidth;
-      maxRange = (imax - nbins / 2 + binrange) * binwidth;
+  float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
+  float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
 
-      double fitres = fitGaus(nbinsUsed, histoValues.data(), minRange, maxRange, fitValues, nullptr, 2., false);
-      LOG(info) << "channel = " << ich << " fitted by thread = " << ithread;
-      if (fitres > -10) {
-        LOG(info) << "Channel " << ich << " :: Fit result " << fitres << " Mean = " << fitValues[1] << " Sigma = " << fitValues[2];
-      } else {
-#ifdef DEBUGGING
-        FILE* f = fopen(Form("%d.cal", ich), "w");
-        for (int i = 0; i < histoValues.size(); i++) {
-          fprintf(f, "%d %f %f\n", i, minRange + binwidth * i, histoValues[i]);
-        }
-        fclose(f);
-#endif
-        LOG(info) << "Channel " << ich << " :: Fit failed with result = " << fitres;
-        ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, -1);
-        ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, 99999);
-        ts.setChannelOffset(ich, 0.0);
-        continue;
-      }
+  if (intmin < -mRange) {
+    intmin = -mRange;
+  }
+  if (intmax < -mRange) {
+    intmax = -mRange;
+  }
+  if (intmin > mRange) {
+    intmin = mRange;
+  }
+  if (intmax > mRange) {
+    intmax = mRange;
+  }
 
-      if (fitValues[2] < 0) {
-        fitValues[2] = -fitValues[2];
-      }
+  res.fraction = entriesInChannel > 0 ? c->integral(ich, intmin, intmax) / entriesInChannel : 0;
+  res.sigma = fitValues[2];
 
-      float fractionUnderPeak;
-      float intmin = fitValues[1] - 5 * fitValues[2]; // mean - 5*sigma
-      float intmax = fitValues[1] + 5 * fitValues[2]; // mean + 5*sigma
+  int tobeused = o2::tof::Utils::getMaxUsedChannel(ich);
+  res.offset = fitValues[1] + tobeused * o2::tof::Geo::BC_TIME_INPS; // adjust by adding the right BC
 
-      if (intmin < -mRange) {
-        intmin = -mRange;
-      }
-      if (intmax < -mRange) {
-        intmax = -mRange;
-      }
-      if (intmin > mRange) {
-        intmin = mRange;
-      }
-      if (intmax > mRange) {
-        intmax = mRange;
-      }
+  if (abs(res.offset) > mRange) {
+    res.fraction = -1;
+    res.sigma = 99999;
+  }
 
-      fractionUnderPeak = entriesInChannel > 0 ? c->integral(ich, intmin, intmax) / entriesInChannel : 0;
-      // now we need to store the results in the TimeSlewingObject
-      ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, fractionUnderPeak);
-      ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, abs(fitValues[2]));
+  bool isProb = res.fraction < 0.5 || res.sigma > 1000;
+  res.status = isProb ? ChannelResult::kProblematic : ChannelResult::kGood;
+  return res;
+}
 
-      int tobeused = o2::tof::Utils::getMaxUsedChannel(ich);
-      fitValues[1] += tobeused * o2::tof::Geo::BC_TIME_INPS; // adjust by adding the right BC
+//_____________________________________________
 
-      if (abs(fitValues[1]) > mRange) {
-        ts.setFractionUnderPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, -1);
-        ts.setSigmaPeak(ich / Geo::NPADSXSECTOR, ich % Geo::NPADSXSECTOR, 99999);
-      }
+template <typename T>
+void TOFChannelCalibrator<T>::finalizeSlotWithTracks(Slot& slot)
+{
+  // Extract results for the single slot
+  o2::tof::TOFChannelData* c = slot.getContainer();
+  LOG(info) << "Finalize slot " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
 
-      bool isProb = ts.getFractionUnderPeak(ich) < 0.5 || ts.getSigmaPeak(ich) > 1000;
+  // for the CCDB entry
+  std::map<std::string, std::string> md;
+  TimeSlewing ts = mCalibTOFapi->getSlewParamObj(); // we take the current CCDB object, since we want to simply update the offset
+  ts.bind();
 
-      if (!isProb) {
-        ts.updateOffsetInfo(ich, fitValues[1]);
-      } else {
-        ts.setChannelOffset(ich, 0.0);
-      }
+  // the channels are extracted independently of each other (possibly in parallel) and the results
+  // are then stored in the TimeSlewing object in channel order, so that the output does not depend
+  // on the number of threads
+  std::vector<ChannelResult> results(Geo::NCHANNELS);
+#ifdef WITH_OPENMP
+  if (mNThreads < 1) {
+    mNThreads = std::min(omp_get_max_threads(), NMAXTHREADS);
+  }
+  LOG(info) << "Number of threads that will be used = " << mNThreads;
+#pragma omp parallel num_threads(mNThreads)
+#else
+  mNThreads = 1;
+#endif
+  {
+    std::vector<float> histoValues;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
+      results[ich] = extractChannel(c, ich, histoValues);
+    }
+  }
 
+  int nGood = 0, nProb = 0, nFailed = 0;
+  for (int ich = 0; ich < Geo::NCHANNELS; ich++) {
+    const auto& res = results[ich];
+    int sector = ich / Geo::NPADSXSECTOR, chinsector = ich % Geo::NPADSXSECTOR;
+    if (res.status == ChannelResult::kNoStat) {
+      ts.setChannelOffset(ich, 0.0);
+      continue;
+    }
+    ts.setFractionUnderPeak(sector, chinsector, res.fraction);
+    ts.setSigmaPeak(sector, chinsector, res.sigma);
+    if (res.status == ChannelResult::kGood) {
+      ts.updateOffsetInfo(ich, res.offset);
+      LOG(debug) << "udpdate channel " << ich << " with " << res.offset << " offset in ps";
+      nGood++;
+    } else if (res.status == ChannelResult::kProblematic) {
+      ts.setChannelOffset(ich, 0.0);
+      nProb++;
+    } else {
+      ts.setChannelOffset(ich, 0.0);
+      nFailed++;
+      continue;
+    }
 #ifdef DEBUGGING
-      mFitCal->Fill(ich, fitValues[1]);
+    mFitCal->Fill(ich, res.offset);
 #endif
-      LOG(debug) << "udpdate channel " << ich << " with " << fitValues[1] << " offset in ps";
-    } // end loop channels in sector
-  }   // end loop over sectors
+  }
+  LOG(info) << "Channels calibrated: " << nGood << ", problematic: " << nProb << ", failed " << (mUseRobustEstimator ? "estimates" : "fits") << ": " << nFailed;
   auto clName = o2::utils::MemFileHelper::getClassName(ts);
   auto flName = o2::ccdb::CcdbApi::generateFileName(clName);
   auto startValidity = slot.getStaticStartTimeMS() - o2::ccdb::CcdbObjectInfo::SECOND * 10; // adding a marging, in case some TFs were not processed
@@ -47,8 +47,10 @@ void TOFDCSProcessor::init(const std::vector<DPID>& pids)
   // fill the array of the DPIDs that will be used by TOF
   // pids should be provided by CCDB
 
-  for (const auto& it : pids) {
-    mPids[it] = false;
+  mPidIndex.build(pids);
+  mPidProcessed.assign(mPidIndex.size(), false);
+  mDpsdoubles.init(mPidIndex.size());
+  for (const auto& it : mPidIndex.getIDs()) {
     mTOFDCS[it].makeEmpty();
   }
 
@@ -74,12 +76,12 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
     for (auto& it : dps) {
       mapin[it.id] = it.data;
     }
-    for (auto& it : mPids) {
-      const auto& el = mapin.find(it.first);
+    for (const auto& it : mPidIndex.getIDs()) {
+      const auto& el = mapin.find(it);
       if (el == mapin.end()) {
-        LOG(debug) << "DP " << it.first << " not found in map";
+        LOG(debug) << "DP " << it << " not found in map";
       } else {
-        LOG(debug) << "DP " << it.first << " found in map";
+        LOG(debug) << "DP " << it << " found in map";
       }
     }
   }
@@ -90,13 +92,13 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
   // now we process all DPs, one by one
   for (const auto& it : dps) {
     // we process only the DPs defined in the configuration
-    const auto& el = mPids.find(it.id);
-    if (el == mPids.end()) {
+    const int index = mPidIndex.find(it.id);
+    if (index == o2::dcs::DataPointIndex::NotFound) {
       LOG(info) << "DP " << it.id << " not found in TOFDCSProcessor, we will not process it";
       continue;
     }
-    processDP(it);
-    mPids[it.id] = true;
+    processDP(it, index);
+    mPidProcessed[index] = true;
   }
 
   if (mUpdateFeacStatus) {
@@ -112,7 +114,7 @@ int TOFDCSProcessor::process(const gsl::span<const DPCOM> dps)
 
 //__________________________________________________________________
 
-int TOFDCSProcessor::processDP(const DPCOM& dpcom)
+int TOFDCSProcessor::processDP(const DPCOM& dpcom, int index)
 {
 
   // processing single DP
@@ -134,18 +136,10 @@ int TOFDCSProcessor::processDP(const DPCOM& dpcom)
     // now I need to access the correct element
     if (type == DPVAL_DOUBLE) {
       // for these DPs, we will store the first, last, mid value, plus the value where the maximum variation occurred
-      auto& dvect = mDpsdoublesmap[dpid];
       if (mVerboseDP) {
-        LOG(debug) << "mDpsdoublesmap[dpid].size() = " << dvect.size();
-      }
-      auto etime = val.get_epoch_time();
-      if (dvect.size() == 0 ||
-          etime != dvect.back().get_epoch_time()) { // we check
-                                                    // that we did not get the
-                                                    // same timestamp as the
-                                                    // latest one
-        dvect.push_back(val);
+        LOG(debug) << "mDpsdoubles.size(index) = " << mDpsdoubles.size(index);
       }
+      mDpsdoubles.add(index, val); // we check that we did not get the same timestamp as the latest one
     }
 
     if (type == DPVAL_INT) {
@@ -337,58 +331,60 @@ void TOFDCSProcessor::updateDPsCCDB()
     double double_value;
   } converter0, converter1;
 
-  for (auto& it : mPids) {
-    const auto& type = it.first.get_type();
+  for (size_t index = 0; index < mPidIndex.size(); ++index) {
+    const auto& pid = mPidIndex.getID(index);
+    const auto& type = pid.get_type();
     if (type == o2::dcs::DPVAL_DOUBLE) {
-      auto& tofdcs = mTOFDCS[it.first];
-      if (it.second) {     // we processed the DP at least 1x
+      auto& tofdcs = mTOFDCS[pid];
+      if (mPidProcessed[index]) { // we processed the DP at least 1x
         if (mVerboseDP) {
-          LOG(info) << "Processing DP " << it.first.get_alias();
+          LOG(info) << "Processing DP " << pid.get_alias();
         }
-        it.second = false; // reset for the next period
+        mPidProcessed[index] = false; // reset for the next period
         tofdcs.updated = true;
-        auto& dpvect = mDpsdoublesmap[it.first];
-        tofdcs.firstValue.first = dpvect[0].get_epoch_time();
-        converter0.raw_data = dpvect[0].payload_pt1;
+        const auto times = mDpsdoubles.getTimes(index);
+        const auto values = mDpsdoubles.getRawValues(index);
+        tofdcs.firstValue.first = times[0];
+        converter0.raw_data = values[0];
         tofdcs.firstValue.second = converter0.double_value;
-        tofdcs.lastValue.first = dpvect.back().get_epoch_time();
-        converter0.raw_data = dpvect.back().payload_pt1;
+        tofdcs.lastValue.first = times.back();
+        converter0.raw_data = values.back();
         tofdcs.lastValue.second = converter0.double_value;
         // find min and max
-        for (const auto& el : dpvect) {
-          converter0.raw_data = el.payload_pt1;
+        for (size_t i = 0; i < times.size(); ++i) {
+          converter0.raw_data = values[i];
           if (converter0.double_value < tofdcs.minValue.second) {
-            tofdcs.minValue.first = el.get_epoch_time();
+            tofdcs.minValue.first = times[i];
             tofdcs.minValue.second = converter0.double_value;
           }
           if (converter0.double_value > tofdcs.maxValue.second) {
-            tofdcs.maxValue.first = el.get_epoch_time();
+            tofdcs.maxValue.first = times[i];
             tofdcs.maxValue.second = converter0.double_value;
           }
         }
         // now I will look for the max change
-        if (dpvect.size() > 1) {
-          auto deltatime = dpvect.back().get_epoch_time() - dpvect[0].get_epoch_time();
+        if (times.size() > 1) {
+          auto deltatime = times.back() - times[0];
           if (deltatime < 60000) {
             // if we did not cover at least 1 minute,
             // max variation is defined as the difference between first and last value
-            converter0.raw_data = dpvect[0].payload_pt1;
-            converter1.raw_data = dpvect.back().payload_pt1;
+            converter0.raw_data = values[0];
+            converter1.raw_data = values.back();
             double delta = converter0.double_value - converter1.double_value;
-            tofdcs.maxChange.first[0] = dpvect[0].get_epoch_time();
-            tofdcs.maxChange.first[1] = dpvect.back().get_epoch_time();
+            tofdcs.maxChange.first[0] = times[0];
+            tofdcs.maxChange.first[1] = times.back();
             tofdcs.maxChange.second = delta;
           } else {
-            for (auto i = 0; i < dpvect.size() - 1; ++i) {
-              for (auto j = i + 1; j < dpvect.size(); ++j) {
-                auto deltatime = dpvect[j].get_epoch_time() - dpvect[i].get_epoch_time();
+            for (auto i = 0; i < times.size() - 1; ++i) {
+              for (auto j = i + 1; j < times.size(); ++j) {
+                auto deltatime = times[j] - times[i];
                 if (deltatime >= 60000) { // we compare to values coming from at least 1 minute later; epoch_time in ms
-                  converter0.raw_data = dpvect[i].payload_pt1;
-                  converter1.raw_data = dpvect[j].payload_pt1;
+                  converter0.raw_data = values[i];
+                  converter1.raw_data = values[j];
                   double delta = converter0.double_value - converter1.double_value;
                   if (std::abs(delta) > std::abs(tofdcs.maxChange.second)) {
-                    tofdcs.maxChange.first[0] = dpvect[i].get_epoch_time();
-                    tofdcs.maxChange.first[1] = dpvect[j].get_epoch_time();
+                    tofdcs.maxChange.first[0] = times[i];
+                    tofdcs.maxChange.first[1] = times[j];
                     tofdcs.maxChange.second = delta;
                   }
                 }
@@ -396,35 +392,35 @@ void TOFDCSProcessor::updateDPsCCDB()
             }
           }
           // mid point
-          auto midIdx = dpvect.size() / 2 - 1;
-          tofdcs.midValue.first = dpvect[midIdx].get_epoch_time();
-          converter0.raw_data = dpvect[midIdx].payload_pt1;
+          auto midIdx = times.size() / 2 - 1;
+          tofdcs.midValue.first = times[midIdx];
+          converter0.raw_data = values[midIdx];
           tofdcs.midValue.second = converter0.double_value;
         } else {
-          tofdcs.maxChange.first[0] = dpvect[0].get_epoch_time();
-          tofdcs.maxChange.first[1] = dpvect[0].get_epoch_time();
-          converter0.raw_data = dpvect[0].payload_pt1;
+          tofdcs.maxChange.first[0] = times[0];
+          tofdcs.maxChange.first[1] = times[0];
+          converter0.raw_data = values[0];
           tofdcs.maxChange.second = converter0.double_value;
-          tofdcs.midValue.first = dpvect[0].get_epoch_time();
-          converter0.raw_data = dpvect[0].payload_pt1;
+          tofdcs.midValue.first = times[0];
+          converter0.raw_data = values[0];
           tofdcs.midValue.second = converter0.double_value;
         }
       } else {
         tofdcs.updated = false;
       }
       if (mVerboseDP) {
-        LOG(info) << "PID " << it.first.get_alias() << " was updated to:";
+        LOG(info) << "PID " << pid.get_alias() << " was updated to:";
         tofdcs.print();
       }
     }
   }
   if (mVerboseDP) {
     LOG(info) << "Printing object to be sent to CCDB";
-    for (auto& it : mPids) {
-      const auto& type = it.first.get_type();
+    for (const auto& pid : mPidIndex.getIDs()) {
+      const auto& type = pid.get_type();
       if (type == o2::dcs::DPVAL_DOUBLE) {
-        LOG(info) << "PID = " << it.first.get_alias();
-        auto& tofdcs = mTOFDCS[it.first];
+        LOG(info) << "PID = " << pid.get_alias();
+        auto& tofdcs = mTOFDCS[pid];
         tofdcs.print();
       }
     }
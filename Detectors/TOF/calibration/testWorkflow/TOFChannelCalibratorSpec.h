@@ -63,6 +63,8 @@ class TOFChannelCalibDevice : public o2::framework::Task
     auto delay = ic.options().get<uint32_t>("max-delay");
     auto updateInterval = ic.options().get<uint32_t>("update-interval");
     auto deltaUpdateInterval = ic.options().get<uint32_t>("delta-update-interval");
+    auto nThreads = ic.options().get<int>("nthreads");
+    bool robust = ic.options().get<bool>("robust-estimator");
     mCalibrator = std::make_unique<o2::tof::TOFChannelCalibrator<T>>(minEnt, nb, mRange);
 
     mCalibrator->doPerStrip(mDoPerStrip);
@@ -85,6 +87,8 @@ class TOFChannelCalibDevice : public o2::framework::Task
 
     mCalibrator->setIsTest(isTest);
     mCalibrator->setDoCalibWithCosmics(mCosmics);
+    mCalibrator->setNThreads(nThreads);
+    mCalibrator->setUseRobustEstimator(robust);
 
     // calibration objects set to zero
     mPhase.addLHCphase(0, 0);
@@ -263,7 +267,9 @@ DataProcessorSpec getTOFChannelCalibDeviceSpec(bool useCCDB, bool attachChannelO
       {"tf-per-slot", VariantType::UInt32, 0u, {"number of TFs per calibration time slot, if 0: close once statistics reached"}},
       {"max-delay", VariantType::UInt32, 0u, {"number of slots in past to consider"}},
       {"update-interval", VariantType::UInt32, 10u, {"number of TF after which to try to finalize calibration"}},
-      {"delta-update-interval", VariantType::UInt32, 10u, {"number of TF after which to try to finalize calibration, if previous attempt failed"}}}};
+      {"delta-update-interval", VariantType::UInt32, 10u, {"number of TF after which to try to finalize calibration, if previous attempt failed"}},
+      {"nthreads", VariantType::Int, 1, {"number of threads for the channel fits (0: as many as allowed by OpenMP)"}},
+      {"robust-estimator", VariantType::Bool, false, {"use median and MAD of the peak instead of the gaussian fit for the channel offsets"}}}};
 }
 
 } // namespace framework
@@ -79,19 +79,39 @@ class Clusterer
   bool areCalibStored() const { return mAreCalibStored; }
   void setCalibStored(bool val = true) { mAreCalibStored = val; }
 
+  // set the number of threads clusterizing groups of sectors in parallel (< 0 for all available)
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
  private:
-  void calibrateStrip();
-  void processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
+  // digits of the cluster being built and destination of the outputs, one per thread
+  struct ThreadContext {
+    Digit* contributingDigit[6];                                          // array of digits contributing to the cluster
+    int numberOfContributingDigits = 0;                                   // number of digits contributing to the cluster
+    std::vector<Cluster>* clusters = nullptr;                             // where the clusters are stored
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel>* labels = nullptr; // where the cluster MC labels are stored
+    std::vector<o2::tof::CalibInfoCluster>* calibInfos = nullptr;         // where the calib infos from clusters are stored
+    std::vector<Cluster> threadClusters;                                  // clusters of this thread in the parallel mode
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> threadLabels;      // cluster MC labels of this thread in the parallel mode
+    std::vector<o2::tof::CalibInfoCluster> threadCalibInfos;              // calib infos of this thread in the parallel mode
+  };
+
+  static constexpr int SMinDigitsPerThread = 1000; // below this number of digits per thread the clusterization stays sequential
+
+  void calibrateStrip(StripData& stripData);
+  void processStrip(StripData& stripData, ThreadContext& context, MCLabelContainer const* digitMCTruth);
+  void processParallel(DataReader& r, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth);
   //void fetchMCLabels(const Digit* dig, std::array<Label, Cluster::maxLabels>& labels, int& nfilled) const;
 
-  StripData mStripData; ///< single strip data provided by the reader
+  StripData mStripData;                       ///< single strip data provided by the reader
+  std::vector<StripData> mStrips;             //! all the strips of the readout window, in the parallel mode
+  std::vector<ThreadContext> mThreadContexts; //! per-thread buffers, in the parallel mode
+  int mNThreads = 1;                          //! number of threads used for the clusterization
 
   o2::dataformats::MCTruthContainer<o2::MCCompLabel>* mClsLabels = nullptr; // Cluster MC labels
 
-  Digit* mContributingDigit[6];    //! array of digits contributing to the cluster; this will not be stored, it is temporary to build the final cluster
-  int mNumberOfContributingDigits; //! number of digits contributing to the cluster; this will not be stored, it is temporary to build the final cluster
-  void addContributingDigit(Digit* dig);
-  void buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth);
+  void addContributingDigit(Digit* dig, ThreadContext& context);
+  void buildCluster(Cluster& c, ThreadContext& context, MCLabelContainer const* digitMCTruth);
   CalibApi* mCalibApi = nullptr; //! calib api to handle the TOF calibration
   uint64_t mFirstOrbit = 0;      //! 1st orbit of the TF
   uint64_t mBCOffset = 0;        //! 1st orbit of the TF converted to BCs
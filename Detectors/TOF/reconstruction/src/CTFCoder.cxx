@@ -70,7 +70,7 @@ void CTFCoder::compress(CompressedInfos& cc,
   for (int rof0 = 0; rof0 < nrofIni; rof0++) {
     const auto& rofRec = rofRecVec[rof0];
     const auto ir = rofRec.getBCData();
-    if (mIRFrameSelector.isSet() && mIRFrameSelector.check(o2::dataformats::IRFrame{ir, ir + (o2::constants::lhc::LHCMaxBunches / 3 - 1)}) < 0) {
+    if (mIRFrameSelector.isSet() && !mIRFrameSelector.isSelected(o2::dataformats::IRFrame{ir, ir + (o2::constants::lhc::LHCMaxBunches / 3 - 1)})) {
       continue;
     }
     int64_t rofInBC = ir.toLong();
@@ -85,7 +85,7 @@ void CTFCoder::compress(CompressedInfos& cc,
     int timeframe = 0, tdc = 0, ndigAcc = 0;
     for (int idig = idigMin; idig < idigMax; idig++) {
       const auto& dig = digCopy[idig - idigMin];
-      if (mIRFrameSelector.isSet() && mIRFrameSelector.check(dig.getIR()) < 0) {
+      if (mIRFrameSelector.isSet() && !mIRFrameSelector.isSelected(dig.getIR())) {
         continue;
       }
       ndigAcc++;
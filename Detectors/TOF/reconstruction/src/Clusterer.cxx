@@ -19,6 +19,10 @@
 #include "SimulationDataFormat/MCTruthContainer.h"
 #include <TStopwatch.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::tof;
 
 //__________________________________________________
@@ -28,15 +32,26 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
   timerProcess.Start();
 
   reader.init();
+
+  if (mNThreads > 1) {
+    processParallel(reader, clusters, digitMCTruth);
+    timerProcess.Stop();
+    return;
+  }
+
   int totNumDigits = 0;
+  ThreadContext context;
+  context.clusters = &clusters;
+  context.labels = mClsLabels;
+  context.calibInfos = &mCalibInfosFromCluster;
 
   while (reader.getNextStripData(mStripData)) {
     LOG(debug) << "TOFClusterer got Strip " << mStripData.stripID << " with Ndigits "
                << mStripData.digits.size();
     totNumDigits += mStripData.digits.size();
 
-    calibrateStrip();
-    processStrip(clusters, digitMCTruth);
+    calibrateStrip(mStripData);
+    processStrip(mStripData, context, digitMCTruth);
   }
 
   LOG(debug) << "We had " << totNumDigits << " digits in this event";
@@ -44,13 +59,93 @@ void Clusterer::process(DataReader& reader, std::vector<Cluster>& clusters, MCLa
 }
 
 //__________________________________________________
-void Clusterer::calibrateStrip()
+void Clusterer::processParallel(DataReader& reader, std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+{
+  // read all the strips first, then clusterize groups of consecutive sectors in parallel.
+  // The outputs of the groups are appended in the order of the strips such that they are
+  // identical to the ones of the sequential clusterization
+
+  int totNumDigits = 0;
+  size_t nStrips = 0;
+  while (true) {
+    if (nStrips == mStrips.size()) {
+      mStrips.emplace_back();
+    }
+    if (!reader.getNextStripData(mStrips[nStrips])) {
+      break;
+    }
+    totNumDigits += mStrips[nStrips].digits.size();
+    ++nStrips;
+  }
+  LOG(debug) << "We had " << totNumDigits << " digits in " << nStrips << " strips in this event";
+
+  // split the strips in groups of about the same number of digits, changing group only with the sector
+  int nGroups = std::max(1, std::min(mNThreads, totNumDigits / SMinDigitsPerThread));
+  std::vector<size_t> groupStart{0};
+  int nDigits = 0;
+  for (size_t iStrip = 1; iStrip < nStrips && static_cast<int>(groupStart.size()) < nGroups; ++iStrip) {
+    nDigits += mStrips[iStrip - 1].digits.size();
+    if (nDigits >= totNumDigits * static_cast<double>(groupStart.size()) / nGroups &&
+        mStrips[iStrip].stripID / Geo::NSTRIPXSECTOR != mStrips[iStrip - 1].stripID / Geo::NSTRIPXSECTOR) {
+      groupStart.push_back(iStrip);
+    }
+  }
+  groupStart.push_back(nStrips);
+  nGroups = groupStart.size() - 1;
+
+  if (static_cast<int>(mThreadContexts.size()) < nGroups) {
+    mThreadContexts.resize(nGroups);
+  }
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    auto& context = mThreadContexts[iGroup];
+    context.threadClusters.clear();
+    context.threadLabels.clear();
+    context.threadCalibInfos.clear();
+    context.clusters = &context.threadClusters;
+    context.labels = (mClsLabels != nullptr) ? &context.threadLabels : nullptr;
+    context.calibInfos = &context.threadCalibInfos;
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nGroups)
+#endif
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    for (size_t iStrip = groupStart[iGroup]; iStrip < groupStart[iGroup + 1]; ++iStrip) {
+      calibrateStrip(mStrips[iStrip]);
+      processStrip(mStrips[iStrip], mThreadContexts[iGroup], digitMCTruth);
+    }
+  }
+
+  for (int iGroup = 0; iGroup < nGroups; ++iGroup) {
+    const auto& context = mThreadContexts[iGroup];
+    clusters.insert(clusters.end(), context.threadClusters.begin(), context.threadClusters.end());
+    if (mClsLabels != nullptr) {
+      mClsLabels->mergeAtBack(context.threadLabels);
+    }
+    mCalibInfosFromCluster.insert(mCalibInfosFromCluster.end(), context.threadCalibInfos.begin(), context.threadCalibInfos.end());
+  }
+}
+
+//__________________________________________________
+void Clusterer::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  int maxThreads = omp_get_max_threads();
+  mNThreads = (n < 0) ? maxThreads : std::max(1, std::min(maxThreads, n));
+#else
+  mNThreads = 1;
+#endif
+  LOG(info) << "TOF clusterization running with " << mNThreads << " threads";
+}
+
+//__________________________________________________
+void Clusterer::calibrateStrip(StripData& stripData)
 {
   // method to calibrate the times from the current strip
 
-  for (int idig = 0; idig < mStripData.digits.size(); idig++) {
+  for (int idig = 0; idig < stripData.digits.size(); idig++) {
     //    LOG(debug) << "Checking digit " << idig;
-    Digit* dig = &mStripData.digits[idig];
+    Digit* dig = &stripData.digits[idig];
     //    LOG(info) << "channel = " << dig->getChannel();
     dig->setBC(dig->getBC() - mBCOffset); // RS Don't use raw BC, always start from the beginning of the TF
     double calib = mCalibApi->getTimeCalibration(dig->getChannel(), dig->getTOT() * Geo::TOTBIN_NS);
@@ -63,7 +158,7 @@ void Clusterer::calibrateStrip()
 }
 
 //__________________________________________________
-void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer const* digitMCTruth)
+void Clusterer::processStrip(StripData& stripData, ThreadContext& context, MCLabelContainer const* digitMCTruth)
 {
   // method to clusterize the current strip
 
@@ -73,30 +168,30 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
   Int_t iphi, iphi2, iphi3;
   Int_t ieta, ieta2, ieta3; // it is the number of padz-row increasing along the various strips
 
-  for (int idig = 0; idig < mStripData.digits.size(); idig++) {
+  for (int idig = 0; idig < stripData.digits.size(); idig++) {
     //    LOG(debug) << "Checking digit " << idig;
-    Digit* dig = &mStripData.digits[idig];
+    Digit* dig = &stripData.digits[idig];
     //printf("checking digit %d - alreadyUsed=%d   -  problematic=%d\n",idig,dig->isUsedInCluster(),dig->isProblematic()); // toberem
     if (dig->isUsedInCluster() || dig->isProblematic()) {
       continue; // the digit was already used to build a cluster, or it was declared problematic
     }
 
-    mNumberOfContributingDigits = 0;
+    context.numberOfContributingDigits = 0;
     dig->getPhiAndEtaIndex(iphi, ieta);
-    if (mStripData.digits.size() > 1) {
+    if (stripData.digits.size() > 1) {
       LOG(debug) << "idig = " << idig;
     }
 
     // first we make a cluster out of the digit
-    int noc = clusters.size();
+    int noc = context.clusters->size();
     //    LOG(debug) << "noc = " << noc << "\n";
-    clusters.emplace_back();
-    Cluster& c = clusters[noc];
-    addContributingDigit(dig);
+    context.clusters->emplace_back();
+    Cluster& c = (*context.clusters)[noc];
+    addContributingDigit(dig, context);
     double timeDig = dig->getCalibratedTime();
 
-    for (int idigNext = idig + 1; idigNext < mStripData.digits.size(); idigNext++) {
-      Digit* digNext = &mStripData.digits[idigNext];
+    for (int idigNext = idig + 1; idigNext < stripData.digits.size(); idigNext++) {
+      Digit* digNext = &stripData.digits[idigNext];
       if (digNext->isUsedInCluster() || dig->isProblematic()) {
         continue; // the digit was already used to build a cluster, or was problematic
       }
@@ -116,28 +211,28 @@ void Clusterer::processStrip(std::vector<Cluster>& clusters, MCLabelContainer co
       }
 
       // if we are here, the digit contributes to the cluster
-      addContributingDigit(digNext);
+      addContributingDigit(digNext, context);
 
     } // loop on the second digit
 
     //printf("build cluster\n");
-    buildCluster(c, digitMCTruth); // toberem
+    buildCluster(c, context, digitMCTruth); // toberem
 
   } // loop on the first digit
 }
 //______________________________________________________________________
-void Clusterer::addContributingDigit(Digit* dig)
+void Clusterer::addContributingDigit(Digit* dig, ThreadContext& context)
 {
 
   // adding a digit to the array that stores the contributing ones
 
-  if (mNumberOfContributingDigits == 6) {
+  if (context.numberOfContributingDigits == 6) {
     LOG(debug) << "The cluster has already 6 digits associated to it, we cannot add more; returning without doing anything";
 
     int phi, eta;
-    for (int i = 0; i < mNumberOfContributingDigits; i++) {
-      mContributingDigit[i]->getPhiAndEtaIndex(phi, eta);
-      LOG(debug) << "digit already in " << i << ", channel = " << mContributingDigit[i]->getChannel() << ",phi,eta = (" << phi << "," << eta << "), TDC = " << mContributingDigit[i]->getTDC() << ", calibrated time = " << mContributingDigit[i]->getCalibratedTime();
+    for (int i = 0; i < context.numberOfContributingDigits; i++) {
+      context.contributingDigit[i]->getPhiAndEtaIndex(phi, eta);
+      LOG(debug) << "digit already in " << i << ", channel = " << context.contributingDigit[i]->getChannel() << ",phi,eta = (" << phi << "," << eta << "), TDC = " << context.contributingDigit[i]->getTDC() << ", calibrated time = " << context.contributingDigit[i]->getCalibratedTime();
     }
 
     dig->getPhiAndEtaIndex(phi, eta);
@@ -148,44 +243,44 @@ void Clusterer::addContributingDigit(Digit* dig)
 
     return;
   }
-  mContributingDigit[mNumberOfContributingDigits] = dig;
-  mNumberOfContributingDigits++;
+  context.contributingDigit[context.numberOfContributingDigits] = dig;
+  context.numberOfContributingDigits++;
   dig->setIsUsedInCluster();
 
   return;
 }
 
 //_____________________________________________________________________
-void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
+void Clusterer::buildCluster(Cluster& c, ThreadContext& context, MCLabelContainer const* digitMCTruth)
 {
   static const float inv12 = 1. / 12.;
 
   // here we finally build the cluster from all the digits contributing to it
 
   Digit* temp;
-  for (int idig = 1; idig < mNumberOfContributingDigits; idig++) {
+  for (int idig = 1; idig < context.numberOfContributingDigits; idig++) {
     // the digit[0] will be the main one
-    if (mContributingDigit[idig]->getTOT() > mContributingDigit[0]->getTOT()) {
-      temp = mContributingDigit[0];
-      mContributingDigit[0] = mContributingDigit[idig];
-      mContributingDigit[idig] = temp;
+    if (context.contributingDigit[idig]->getTOT() > context.contributingDigit[0]->getTOT()) {
+      temp = context.contributingDigit[0];
+      context.contributingDigit[0] = context.contributingDigit[idig];
+      context.contributingDigit[idig] = temp;
     }
   }
 
-  c.setMainContributingChannel(mContributingDigit[0]->getChannel());
-  c.setTime(mContributingDigit[0]->getCalibratedTime());                                                                                      // time in ps (for now we assume it calibrated)
-  c.setTimeRaw(mContributingDigit[0]->getTDC() * Geo::TDCBIN + mContributingDigit[0]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3); // time in ps (for now we assume it calibrated)
+  c.setMainContributingChannel(context.contributingDigit[0]->getChannel());
+  c.setTime(context.contributingDigit[0]->getCalibratedTime());                                                                                             // time in ps (for now we assume it calibrated)
+  c.setTimeRaw(context.contributingDigit[0]->getTDC() * Geo::TDCBIN + context.contributingDigit[0]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3); // time in ps (for now we assume it calibrated)
 
-  //printf("timeraw= %lf - time real = %lf (%d, %lu) \n",c.getTimeRaw(),mContributingDigit[0]->getTDC() * Geo::TDCBIN + mContributingDigit[0]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3,mContributingDigit[0]->getTDC(),mContributingDigit[0]->getBC());
+  //printf("timeraw= %lf - time real = %lf (%d, %lu) \n",c.getTimeRaw(),context.contributingDigit[0]->getTDC() * Geo::TDCBIN + context.contributingDigit[0]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3,context.contributingDigit[0]->getTDC(),context.contributingDigit[0]->getBC());
 
-  c.setTot(mContributingDigit[0]->getTOT() * Geo::TOTBIN_NS); // TOT in ns (for now we assume it calibrated)
+  c.setTot(context.contributingDigit[0]->getTOT() * Geo::TOTBIN_NS); // TOT in ns (for now we assume it calibrated)
   //setL0L1Latency(); // to be filled (maybe)
   //setDeltaBC(); // to be filled (maybe)
 
-  c.setDigitInfo(0, mContributingDigit[0]->getChannel(), mContributingDigit[0]->getCalibratedTime(), mContributingDigit[0]->getTOT() * Geo::TOTBIN_NS);
+  c.setDigitInfo(0, context.contributingDigit[0]->getChannel(), context.contributingDigit[0]->getCalibratedTime(), context.contributingDigit[0]->getTOT() * Geo::TOTBIN_NS);
 
-  int ch1 = mContributingDigit[0]->getChannel();
-  short tot1 = mContributingDigit[0]->getTOT() < 20000 ? mContributingDigit[0]->getTOT() : 20000;
+  int ch1 = context.contributingDigit[0]->getChannel();
+  short tot1 = context.contributingDigit[0]->getTOT() < 20000 ? context.contributingDigit[0]->getTOT() : 20000;
   double dtime = c.getTimeRaw();
 
   int chan1, chan2;
@@ -194,10 +289,10 @@ void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
   int deltaPhi, deltaEta;
   int mask;
 
-  mContributingDigit[0]->getPhiAndEtaIndex(phi1, eta1);
+  context.contributingDigit[0]->getPhiAndEtaIndex(phi1, eta1);
   // now set the mask with the secondary digits
-  for (int idig = 1; idig < mNumberOfContributingDigits; idig++) {
-    mContributingDigit[idig]->getPhiAndEtaIndex(phi2, eta2);
+  for (int idig = 1; idig < context.numberOfContributingDigits; idig++) {
+    context.contributingDigit[idig]->getPhiAndEtaIndex(phi2, eta2);
     deltaPhi = phi1 - phi2;
     deltaEta = eta1 - eta2;
 
@@ -229,39 +324,39 @@ void Clusterer::buildCluster(Cluster& c, MCLabelContainer const* digitMCTruth)
       }
     } else { // |delataphi| > 1
       isOk = false;
-      mContributingDigit[idig]->setIsUsedInCluster(false);
+      context.contributingDigit[idig]->setIsUsedInCluster(false);
     }
 
     if (isOk) {
-      c.setDigitInfo(c.getNumOfContributingChannels(), mContributingDigit[idig]->getChannel(), mContributingDigit[idig]->getCalibratedTime(), mContributingDigit[idig]->getTOT() * Geo::TOTBIN_NS);
+      c.setDigitInfo(c.getNumOfContributingChannels(), context.contributingDigit[idig]->getChannel(), context.contributingDigit[idig]->getCalibratedTime(), context.contributingDigit[idig]->getTOT() * Geo::TOTBIN_NS);
       c.addBitInContributingChannels(mask);
 
-      if (mCalibFromCluster && c.getNumOfContributingChannels() == 2 && !mIsNoisy[mContributingDigit[idig]->getChannel()] && !mIsNoisy[ch1]) { // fill info for calibration excluding noisy channels
-        int8_t dch = int8_t(mContributingDigit[idig]->getChannel() - ch1);
-        short tot2 = mContributingDigit[idig]->getTOT() < 20000 ? mContributingDigit[idig]->getTOT() : 20000;
-        dtime -= mContributingDigit[idig]->getTDC() * Geo::TDCBIN + mContributingDigit[idig]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3;
-        addCalibFromCluster(ch1, dch, float(dtime), tot1, tot2);
+      if (mCalibFromCluster && c.getNumOfContributingChannels() == 2 && !mIsNoisy[context.contributingDigit[idig]->getChannel()] && !mIsNoisy[ch1]) { // fill info for calibration excluding noisy channels
+        int8_t dch = int8_t(context.contributingDigit[idig]->getChannel() - ch1);
+        short tot2 = context.contributingDigit[idig]->getTOT() < 20000 ? context.contributingDigit[idig]->getTOT() : 20000;
+        dtime -= context.contributingDigit[idig]->getTDC() * Geo::TDCBIN + context.contributingDigit[idig]->getBC() * o2::constants::lhc::LHCBunchSpacingNS * 1E3;
+        context.calibInfos->emplace_back(ch1, dch, float(dtime), tot1, tot2);
       }
     }
   }
 
   // filling the MC labels of this cluster; the first will be those of the main digit; then the others
   if (digitMCTruth != nullptr) {
-    int lbl = mClsLabels->getIndexedSize(); // this should correspond to the number of digits also;
+    int lbl = context.labels->getIndexedSize(); // this should correspond to the number of digits also;
     //printf("lbl = %d\n", lbl);
-    for (int i = 0; i < mNumberOfContributingDigits; i++) {
-      if (!mContributingDigit[i]->isUsedInCluster()) {
+    for (int i = 0; i < context.numberOfContributingDigits; i++) {
+      if (!context.contributingDigit[i]->isUsedInCluster()) {
         continue;
       }
       //printf("contributing digit = %d\n", i);
-      int digitLabel = mContributingDigit[i]->getLabel();
+      int digitLabel = context.contributingDigit[i]->getLabel();
       //printf("digitLabel = %d\n", digitLabel);
       gsl::span<const o2::MCCompLabel> mcArray = digitMCTruth->getLabels(digitLabel);
       for (int j = 0; j < static_cast<int>(mcArray.size()); j++) {
         //printf("checking element %d in the array of labels\n", j);
         auto label = digitMCTruth->getElement(digitMCTruth->getMCTruthHeader(digitLabel).index + j);
         //printf("EventID = %d\n", label.getEventID());
-        mClsLabels->addElement(lbl, label);
+        context.labels->addElement(lbl, label);
       }
     }
   }
@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file cluster-bench.cxx
+/// \brief Benchmark of the parallel TOF clusterization on the digits of recorded TFs
+///
+/// The digits are read from a file produced by the TOF digit writer (e.g. after the raw data decoding),
+/// clusterized with one thread and with the requested number of threads, and the outputs of the two
+/// configurations are checked to be identical.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "DataFormatsTOF/CalibLHCphaseTOF.h"
+#include "DataFormatsTOF/CalibTimeSlewingParamTOF.h"
+#include "DataFormatsTOF/Cluster.h"
+#include "Framework/Logger.h"
+#include "TOFBase/CalibTOFapi.h"
+#include "TOFBase/Digit.h"
+#include "TOFReconstruction/Clusterer.h"
+#include "TOFReconstruction/DataReader.h"
+
+namespace po = boost::program_options;
+using namespace o2::tof;
+
+//____________________________________________________________________________________
+double runClustering(int nThreads, int nLoops, CalibTOFapi& calibApi, const std::vector<Digit>& digits,
+                     const std::vector<ReadoutWindowData>& readoutWindows, std::vector<Cluster>& clusters)
+{
+  /// clusterize the readout windows of one TF nLoops times with nThreads threads and return the average time in ms
+
+  Clusterer clusterer{};
+  clusterer.setCalibApi(&calibApi);
+  clusterer.setCalibStored(true); // do not reject the channels that are problematic for a default calibration
+  clusterer.setNThreads(nThreads);
+  DigitDataReader reader{};
+  gsl::span<const Digit> digitSpan(digits);
+
+  std::chrono::duration<double, std::milli> time{};
+  for (int iLoop = 0; iLoop < nLoops; ++iLoop) {
+    clusters.clear();
+    auto tStart = std::chrono::high_resolution_clock::now();
+    for (const auto& readoutWindow : readoutWindows) {
+      auto digitsRO = readoutWindow.getBunchChannelData(digitSpan);
+      reader.setDigitArray(&digitsRO);
+      clusterer.process(reader, clusters, nullptr);
+    }
+    auto tEnd = std::chrono::high_resolution_clock::now();
+    time += tEnd - tStart;
+  }
+
+  return time.count() / nLoops;
+}
+
+//____________________________________________________________________________________
+bool isIdentical(const std::vector<Cluster>& clusters1, const std::vector<Cluster>& clusters2)
+{
+  /// check that the two sets of clusters are identical
+  return std::equal(clusters1.begin(), clusters1.end(), clusters2.begin(), clusters2.end(), [](const Cluster& c1, const Cluster& c2) {
+    return c1.getMainContributingChannel() == c2.getMainContributingChannel() && c1.getTime() == c2.getTime() &&
+           c1.getTimeRaw() == c2.getTimeRaw() && c1.getTot() == c2.getTot() &&
+           c1.getAdditionalContributingChannels() == c2.getAdditionalContributingChannels() &&
+           c1.getX() == c2.getX() && c1.getY() == c2.getY() && c1.getZ() == c2.getZ();
+  });
+}
+
+//____________________________________________________________________________________
+int main(int argc, char** argv)
+{
+  po::variables_map vm;
+  po::options_description usage("Usage");
+
+  std::string inFile;
+  int nThreads;
+  int nLoops;
+
+  // clang-format off
+  usage.add_options()
+      ("help,h", "produce help message")
+      ("infile,f", po::value<std::string>(&inFile)->default_value("tofdigits.root"), "input file of TOF digits")
+      ("n-threads,n", po::value<int>(&nThreads)->default_value(4), "number of threads to compare with the sequential clusterization")
+      ("loops,l", po::value<int>(&nLoops)->default_value(1), "number of times each TF is clusterized")
+        ;
+  // clang-format on
+
+  po::options_description cmdline;
+  cmdline.add(usage);
+
+  po::store(po::command_line_parser(argc, argv).options(cmdline).run(), vm);
+
+  if (vm.count("help")) {
+    LOG(info) << "This program benchmarks the parallel TOF clusterization on recorded digits";
+    LOG(info) << usage;
+    return 2;
+  }
+
+  try {
+    po::notify(vm);
+  } catch (boost::program_options::error& e) {
+    LOG(error) << e.what();
+    exit(1);
+  }
+
+  std::unique_ptr<TFile> file(TFile::Open(inFile.c_str()));
+  if (!file || file->IsZombie()) {
+    LOG(error) << "opening file " << inFile << " failed";
+    exit(2);
+  }
+  auto tree = file->Get<TTree>("o2sim");
+  if (tree == nullptr) {
+    LOG(error) << "the file " << inFile << " does not contain TOF digits";
+    exit(2);
+  }
+  std::vector<Digit> digits{}, *digitsPtr = &digits;
+  std::vector<ReadoutWindowData> readoutWindows{}, *readoutWindowsPtr = &readoutWindows;
+  tree->SetBranchAddress("TOFDigit", &digitsPtr);
+  tree->SetBranchAddress("TOFReadoutWindow", &readoutWindowsPtr);
+
+  // the times are calibrated with a null LHC phase and a default time slewing
+  auto lhcPhase = std::make_unique<o2::dataformats::CalibLHCphaseTOF>();
+  auto timeSlewing = std::make_unique<o2::dataformats::CalibTimeSlewingParamTOF>();
+  CalibTOFapi calibApi(0, lhcPhase.get(), timeSlewing.get());
+
+  nLoops = std::max(nLoops, 1);
+  double time1(0.), timeN(0.);
+  std::vector<Cluster> clusters1{}, clustersN{};
+  size_t nDigits(0), nClusters(0);
+  for (Long64_t iTF = 0; iTF < tree->GetEntries(); ++iTF) {
+    tree->GetEntry(iTF);
+    nDigits += digits.size();
+    time1 += runClustering(1, nLoops, calibApi, digits, readoutWindows, clusters1);
+    timeN += runClustering(nThreads, nLoops, calibApi, digits, readoutWindows, clustersN);
+    nClusters += clusters1.size();
+    if (!isIdentical(clusters1, clustersN)) {
+      LOG(error) << "the clusters found with " << nThreads << " threads in TF " << iTF << " differ from the sequential ones";
+      return 3;
+    }
+  }
+
+  LOG(info) << "read " << tree->GetEntries() << " TFs with " << nDigits << " digits";
+  LOG(info) << "1 thread: " << nClusters << " clusters in " << time1 << " ms";
+  LOG(info) << nThreads << " threads: " << nClusters << " clusters in " << timeN << " ms (speedup "
+            << ((timeN > 0.) ? time1 / timeN : 0.) << ")";
+  LOG(info) << "the outputs are identical";
+
+  return 0;
+}
@@ -81,6 +81,7 @@ class TOFDPLClustererTask
     mClusterer.setCalibFromCluster(mIsCalib);
     mClusterer.setDeltaTforClustering(mTimeWin);
     mClusterer.setCalibStored(mForCalib);
+    mClusterer.setNThreads(ic.options().get<int>("nthreads"));
 
     mMultPerLongBC.resize(o2::base::GRPGeomHelper::instance().getNHBFPerTF() * o2::constants::lhc::LHCMaxBunches);
     std::fill(mMultPerLongBC.begin(), mMultPerLongBC.end(), 0);
@@ -357,7 +358,8 @@ o2::framework::DataProcessorSpec getTOFClusterizerSpec(bool useMC, bool useCCDB,
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<TOFDPLClustererTask>(ggRequest, useMC, useCCDB, doCalib, isCosmic, ccdb_url, isForCalib)},
-    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}}}};
+    Options{{"cluster-time-window", VariantType::Int, 5000, {"time window for clusterization in ps"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads clusterizing groups of sectors in parallel, <0 for all available"}}}};
 }
 
 } // end namespace tof
@@ -17,6 +17,7 @@
 #define AliceO2_TPC_CDBInterface_H_
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string_view>
 
@@ -244,6 +245,10 @@ class CDBInterface
     mGainMap.reset();
   }
 
+  /// Mutex to serialize the access from several threads, e.g. the threads of the digitization
+  /// The calibration objects are loaded on demand and the accessors are not thread safe
+  std::mutex& getMutex() { return mMutex; }
+
  private:
   CDBInterface();
 
@@ -268,6 +273,7 @@ class CDBInterface
   std::string mGainMapFileName;                 ///< optional file name for the gain map
   std::string mFEEParamFileName;                ///< optional file name for the FEE parameters (ion tail, common mode, threshold, pedestals)
   DeadChannelMapCreator mDeadChannelMapCreator; ///< creation of dead channel map
+  std::mutex mMutex;                            ///< mutex to serialize the access from several threads
 
   // ===========================================================================
   // ===| functions |===========================================================
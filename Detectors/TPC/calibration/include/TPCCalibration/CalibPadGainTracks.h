@@ -178,6 +178,12 @@ class CalibPadGainTracks : public CalibPadGainTracksBase
   /// \return returns magnetic field which is used for propagation of track parameters
   float getFieldNominalGPUBz() const { return mFieldNominalGPUBz; };
 
+  /// \param nThreads number of threads used for the processing of the tracks
+  void setNThreads(const int nThreads);
+
+  /// \return returns number of threads used for the processing of the tracks
+  int getNThreads() const { return mNThreads; }
+
   /// dump object to disc
   /// \param outFileName name of the output file
   /// \param outName name of the object in the output file
@@ -240,15 +246,27 @@ class CalibPadGainTracks : public CalibPadGainTracksBase
   bool mDoNotNormCharge{false};                                                       ///< do not normalize the cluster charge to the dE/dx
   ChargeType mChargeType{ChargeType::Max};                                            ///< charge type which is used for calculating the dE/dx and filling the pad-by-pad histograms
   o2::gpu::CorrectionMapsHelper* mTPCCorrMapsHelper = nullptr;                        ///< cluster corrections map helper
-  std::vector<std::vector<float>> mDEdxBuffer{};                                      ///<! memory for dE/dx
-  std::vector<std::tuple<unsigned char, unsigned char, unsigned char, float>> mClTrk; ///<! memory for cluster informations
-  std::vector<float> mDedxTmp{};                                                      ///<! memory for dE/dx calculation
+  int mNThreads{1};                                                                   ///< number of threads used for the processing of the tracks
+
+  /// memory used during the processing of the tracks, one object for each thread
+  struct ThreadBuffer {
+    std::vector<std::vector<float>> dEdxBuffer{};                                      ///< memory for dE/dx
+    std::vector<std::tuple<unsigned char, unsigned char, unsigned char, float>> clTrk; ///< memory for cluster informations
+    std::vector<float> dedxTmp{};                                                      ///< memory for dE/dx calculation
+    std::vector<std::tuple<unsigned char, unsigned short, float>> fills;               ///< roc, pad in roc and value of the pad-by-pad histogram fills in case of multiple threads
+  };
+  std::vector<ThreadBuffer> mThreadBuffers{1}; ///<! per thread memory for the processing of the tracks
   std::unique_ptr<CalPad> mGainMapRef;                                                ///<! static Gain map object used for correcting the cluster charge
   std::unique_ptr<CalibdEdxTrackTopologyPol> mCalibTrackTopologyPol;                  ///<! calibration container for the cluster charge
 
   /// calculate truncated mean for track
   /// \param track input track which will be processed
-  void processTrack(TrackTPC track, o2::gpu::GPUO2InterfaceRefit* refit);
+  /// \param refit refitter used in case the track is not propagated
+  /// \param buffer memory of the thread which processes the track
+  void processTrack(TrackTPC track, o2::gpu::GPUO2InterfaceRefit* refit, ThreadBuffer& buffer);
+
+  /// fill the pad-by-pad histogram directly or, in case of multiple threads, buffer the value until all tracks are processed
+  void fillHistogram(ThreadBuffer& buffer, const size_t roc, const size_t padInROC, const float val);
 
   /// get the index (padnumber in ROC) for given pad which is needed for the filling of the CalDet object
   /// \param padSub pad subset type
@@ -266,7 +284,7 @@ class CalibPadGainTracks : public CalibPadGainTracksBase
   /// get the truncated mean for input vector and the truncation range low*nCl<nCl<high*nCl
   /// \param low lower cluster cut of  0.05*nCluster
   /// \param high higher cluster cut of  0.6*nCluster
-  void getTruncMean(float low = 0.05f, float high = 0.6f);
+  void getTruncMean(ThreadBuffer& buffer, float low = 0.05f, float high = 0.6f);
 
   /// Helper function for drawing the reference gain map
   void drawRefGainMapHelper(const bool type, const Sector sector, const std::string filename, const float minZ, const float maxZ) const;
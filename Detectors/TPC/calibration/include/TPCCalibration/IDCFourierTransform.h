@@ -131,6 +131,7 @@ class IDCFourierTransform : public IDCFourierTransformBase<Type>
   inline static int sFftw{1};                ///< using fftw or naive approach for calculation of fourier coefficients
   inline static int sNThreads{1};            ///< number of threads which are used during the calculation of the fourier coefficients
   fftwf_plan mFFTWPlan{nullptr};             ///<! FFTW plan which is used during the ft
+  fftwf_plan mFFTWPlanInverse{nullptr};      ///<! FFTW plan which is used during the inverse ft
   std::vector<float*> mVal1DIDCs;            ///<! buffer for the 1D-IDC values for SIMD usage (each thread will get his one obejct)
   std::vector<fftwf_complex*> mCoefficients; ///<! buffer for coefficients (each thread will get his one obejct)
 
@@ -26,6 +26,7 @@
 #include "TPCFastSpaceChargeCorrectionMap.h"
 #include "TPCFastSpaceChargeCorrection.h"
 #include "TPCFastTransformGeo.h"
+#include "Spline2DHelper.h"
 #include "SpacePoints/TrackResiduals.h"
 
 class TTree;
@@ -84,6 +85,12 @@ class TPCFastSpaceChargeCorrectionHelper
       correctionGlobal,
     const int nKnotsY = 10, const int nKnotsZ = 20);
 
+  /// creates TPCFastSpaceChargeCorrection object as a linear combination of corrections created with the same spline layout (e.g. reference and derivative maps).
+  /// The spline parameters of the direct and inverse corrections are combined linearly, the inverse correction is refitted only for the rows where
+  /// the combined inverse deviates from the inversion of the combined correction by more than maxInverseResidual (cm)
+  std::unique_ptr<TPCFastSpaceChargeCorrection> createFromLinearCombination(const std::vector<const TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling,
+                                                                            float maxInverseResidual = 0.01f, bool prn = false);
+
   /// Create SpaceCharge correction out of the voxel tree
   std::unique_ptr<o2::gpu::TPCFastSpaceChargeCorrection> createFromTrackResiduals(
     const o2::tpc::TrackResiduals& trackResiduals, TTree* voxResTree, bool useSmoothed = false, bool invertSigns = false);
@@ -110,6 +117,10 @@ class TPCFastSpaceChargeCorrectionHelper
   /// get space charge correction in internal TPCFastTransform coordinates u,v->dx,du,dv
   void getSpaceChargeCorrection(const TPCFastSpaceChargeCorrection& correction, int slice, int row, o2::gpu::TPCFastSpaceChargeCorrectionMap::CorrectionPoint p, double& su, double& sv, double& dx, double& du, double& dv);
 
+  /// initialise inverse transformation of one TPC row from linear combination of several input corrections, the output is stored in the first correction
+  void initInverseRow(std::vector<o2::gpu::TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling, int slice, int row,
+                      Spline2DHelper<float>& helper, std::vector<float>& splineParameters, bool prn);
+
   /// initialise max drift length
   void initMaxDriftLength(o2::gpu::TPCFastSpaceChargeCorrection& correction, bool prn);
 
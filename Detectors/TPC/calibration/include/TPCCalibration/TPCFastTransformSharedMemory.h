@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TPCFastTransformSharedMemory.h
+/// \brief Distribution of TPCFastTransform objects between the processes of a node via POSIX shared memory
+///
+/// The publisher copies the class part and the flat buffer of the transformation into a shared memory segment
+/// "<name>_v<version>" and afterwards stores the version in the small segment "<name>", which is used by the readers
+/// to find the current map and to check if a newer version was published.
+/// The readers map the segment copy-on-write and only relocate the pointers of the object to the mapping.
+/// Relocating touches only the pages with the class parts of the objects, the pages holding the spline parameters
+/// remain shared between all processes of the node.
+
+#ifndef ALICEO2_TPC_TPCFASTTRANSFORMSHAREDMEMORY_H_
+#define ALICEO2_TPC_TPCFASTTRANSFORMSHAREDMEMORY_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace o2::gpu
+{
+class TPCFastTransform;
+}
+
+namespace o2::tpc
+{
+
+class TPCFastTransformSharedMemory
+{
+ public:
+  TPCFastTransformSharedMemory() = default;
+  ~TPCFastTransformSharedMemory() { detach(); }
+  TPCFastTransformSharedMemory(const TPCFastTransformSharedMemory&) = delete;
+  TPCFastTransformSharedMemory& operator=(const TPCFastTransformSharedMemory&) = delete;
+
+  /// publish the transformation in the shared memory
+  /// \param name name of the shared memory segment, e.g. "/tpc-corrmap"
+  /// \param transform transformation which will be published
+  /// \param version version of the transformation, has to be larger than the version which is currently published
+  /// \return returns true if the transformation was published
+  static bool publish(std::string_view name, const o2::gpu::TPCFastTransform& transform, uint64_t version);
+
+  /// remove the published transformation from the shared memory. Processes which are attached keep their mapping
+  /// \param name name of the shared memory segment
+  static void unlink(std::string_view name);
+
+  /// \return returns version of the currently published transformation, 0 if nothing was published
+  /// \param name name of the shared memory segment
+  static uint64_t getPublishedVersion(std::string_view name);
+
+  /// attach to the currently published transformation. A previously attached transformation is detached
+  /// \param name name of the shared memory segment
+  /// \return returns true if the transformation was attached
+  bool attach(std::string_view name);
+
+  /// release the mapping of the attached transformation
+  void detach();
+
+  /// \return returns true if a newer version than the attached one was published
+  bool isOutdated() const { return getPublishedVersion(mName) > mVersion; }
+
+  /// \return returns the attached transformation, nullptr if nothing is attached
+  o2::gpu::TPCFastTransform* get() const { return mTransform; }
+
+  /// \return returns version of the attached transformation
+  uint64_t getVersion() const { return mVersion; }
+
+ private:
+  /// layout of the shared memory segment holding the transformation
+  struct Header {
+    uint64_t magic{};        ///< identifier of the segment
+    uint64_t version{};      ///< version of the transformation
+    uint64_t classOffset{};  ///< offset of the class part of the transformation
+    uint64_t classSize{};    ///< size of the class part of the transformation
+    uint64_t bufferOffset{}; ///< offset of the flat buffer of the transformation
+    uint64_t bufferSize{};   ///< size of the flat buffer of the transformation
+  };
+
+  static constexpr uint64_t Magic = 0x544643464d534832; ///< identifier of the segments
+
+  /// \return returns name of the segment holding the given version
+  static std::string getSegmentName(std::string_view name, uint64_t version);
+
+  std::string mName{};                            ///< name of the attached shared memory segment
+  o2::gpu::TPCFastTransform* mTransform{nullptr}; ///< attached transformation, located in the mapping
+  void* mMapping{nullptr};                        ///< mapping of the shared memory segment
+  size_t mMappingSize{0};                         ///< size of the mapping
+  uint64_t mVersion{0};                           ///< version of the attached transformation
+};
+
+} // namespace o2::tpc
+
+#endif
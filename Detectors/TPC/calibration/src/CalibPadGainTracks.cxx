@@ -30,35 +30,84 @@
 // root includes
 #include "TFile.h"
 #include <random>
+#include <thread>
 
 using namespace o2::tpc;
 
 void CalibPadGainTracks::processTracks(const int nMaxTracks)
 {
-  std::unique_ptr<o2::gpu::GPUO2InterfaceRefit> refit;
-  if (!mPropagateTrack) {
-    refit = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(mClusterIndex, mTPCCorrMapsHelper, mFieldNominalGPUBz, mTPCTrackClIdxVecInput->data(), 0, mTPCRefitterShMap.data(), mTPCRefitterOccMap.data(), mTPCRefitterOccMap.size());
-  }
-
   const size_t loopEnd = (nMaxTracks < 0) ? mTracks->size() : ((nMaxTracks > mTracks->size()) ? mTracks->size() : size_t(nMaxTracks));
 
+  // draw random tracks
+  std::vector<size_t> ind;
   if (loopEnd < mTracks->size()) {
-    // draw random tracks
-    std::vector<size_t> ind(mTracks->size());
+    ind.resize(mTracks->size());
     std::iota(ind.begin(), ind.end(), 0);
     std::minstd_rand rng(std::time(nullptr));
     std::shuffle(ind.begin(), ind.end(), rng);
-    for (size_t i = 0; i < loopEnd; ++i) {
-      processTrack((*mTracks)[ind[i]], refit.get());
+  }
+
+  auto myThread = [&](int iThread) {
+    // the refit object is not thread safe: one object per thread
+    std::unique_ptr<o2::gpu::GPUO2InterfaceRefit> refit;
+    if (!mPropagateTrack) {
+      refit = std::make_unique<o2::gpu::GPUO2InterfaceRefit>(mClusterIndex, mTPCCorrMapsHelper, mFieldNominalGPUBz, mTPCTrackClIdxVecInput->data(), 0, mTPCRefitterShMap.data(), mTPCRefitterOccMap.data(), mTPCRefitterOccMap.size());
     }
-  } else {
-    for (const auto& trk : *mTracks) {
-      processTrack(trk, refit.get());
+    auto& buffer = mThreadBuffers[iThread];
+    buffer.fills.clear();
+    for (size_t i = iThread; i < loopEnd; i += mNThreads) {
+      processTrack((*mTracks)[ind.empty() ? i : ind[i]], refit.get(), buffer);
+    }
+  };
+
+  if (mNThreads == 1) {
+    myThread(0);
+    return;
+  }
+
+  std::vector<std::thread> threads(mNThreads);
+  for (int i = 0; i < mNThreads; i++) {
+    threads[i] = std::thread(myThread, i);
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  // fill the buffered values to the histograms: each thread fills the histograms of its own ROCs
+  auto fillThread = [&](int iThread) {
+    for (const auto& buffer : mThreadBuffers) {
+      for (const auto& [roc, padInROC, val] : buffer.fills) {
+        if ((roc % mNThreads) == iThread) {
+          fillPadByPadHistogram(roc, padInROC, val);
+        }
+      }
     }
+  };
+  for (int i = 0; i < mNThreads; i++) {
+    threads[i] = std::thread(fillThread, i);
   }
+  for (auto& th : threads) {
+    th.join();
+  }
+}
+
+void CalibPadGainTracks::fillHistogram(ThreadBuffer& buffer, const size_t roc, const size_t padInROC, const float val)
+{
+  if (mNThreads == 1) {
+    fillPadByPadHistogram(roc, padInROC, val);
+  } else {
+    buffer.fills.emplace_back(roc, padInROC, val);
+  }
+}
+
+void CalibPadGainTracks::setNThreads(const int nThreads)
+{
+  mNThreads = std::max(nThreads, 1);
+  mThreadBuffers.resize(mNThreads);
+  reserveMemory();
 }
 
-void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2InterfaceRefit* refit)
+void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2InterfaceRefit* refit, ThreadBuffer& buffer)
 {
   // make momentum cut
   const float mom = track.getP();
@@ -68,10 +117,10 @@ void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2Int
   }
 
   // clearing memory
-  for (auto& buffer : mDEdxBuffer) {
-    buffer.clear();
+  for (auto& dEdxBuffer : buffer.dEdxBuffer) {
+    dEdxBuffer.clear();
   }
-  mClTrk.clear();
+  buffer.clTrk.clear();
 
   for (int iCl = 0; iCl < nClusters; iCl++) { // loop over cluster
     const o2::tpc::ClusterNative& cl = track.getCluster(*mTPCTrackClIdxVecInput, iCl, *mClusterIndex);
@@ -162,7 +211,7 @@ void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2Int
         index -= Mapper::getPadsInIROC();
       }
 
-      fillPadByPadHistogram(cru.roc().getRoc(), index, fillVal);
+      fillHistogram(buffer, cru.roc().getRoc(), index, fillVal);
     }
 
     if (mMode == dedxTrack) {
@@ -173,23 +222,23 @@ void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2Int
       const int nPadsSector = 1;
 
       if (!isEdge && (isSectorCentre > nPadsSector)) {
-        mDEdxBuffer[indexBuffer].emplace_back(chargeNorm);
+        buffer.dEdxBuffer[indexBuffer].emplace_back(chargeNorm);
       }
 
-      mClTrk.emplace_back(std::make_tuple(sectorIndex, rowIndex, pad, chargeNorm)); // fill with dummy dedx value
+      buffer.clTrk.emplace_back(std::make_tuple(sectorIndex, rowIndex, pad, chargeNorm)); // fill with dummy dedx value
     }
   }
 
   if (mMode == dedxTrack) {
-    getTruncMean();
+    getTruncMean(buffer);
 
     // set the dEdx
-    for (auto& x : mClTrk) {
+    for (auto& x : buffer.clTrk) {
       const unsigned char globRow = std::get<1>(x);
       const int region = Mapper::REGION[globRow];
       const int indexBuffer = getdEdxBufferIndex(region);
 
-      const float dedxTmp = mDedxTmp[indexBuffer];
+      const float dedxTmp = buffer.dedxTmp[indexBuffer];
       if (dedxTmp <= 0 || dedxTmp < mDedxMin || (mDedxMax > 0 && dedxTmp > mDedxMax)) {
         continue;
       }
@@ -206,21 +255,22 @@ void CalibPadGainTracks::processTrack(o2::tpc::TrackTPC track, o2::gpu::GPUO2Int
       if (getLogTransformQ()) {
         fillVal = std::log(1 + fillVal);
       }
-      fillPadByPadHistogram(roc.getRoc(), index, fillVal);
+      fillHistogram(buffer, roc.getRoc(), index, fillVal);
     }
   } else {
   }
 }
 
-void CalibPadGainTracks::getTruncMean(float low, float high)
+void CalibPadGainTracks::getTruncMean(ThreadBuffer& buffer, float low, float high)
 {
-  mDedxTmp.clear();
-  mDedxTmp.reserve(mDEdxBuffer.size());
+  auto& dedxTmp = buffer.dedxTmp;
+  dedxTmp.clear();
+  dedxTmp.reserve(buffer.dEdxBuffer.size());
   // returns the truncated mean for input vector
-  for (auto& charge : mDEdxBuffer) {
+  for (auto& charge : buffer.dEdxBuffer) {
     const int nClustersUsed = static_cast<int>(charge.size());
     if (nClustersUsed < mMinClusters) {
-      mDedxTmp.emplace_back(-1);
+      dedxTmp.emplace_back(-1);
       continue;
     }
 
@@ -230,13 +280,13 @@ void CalibPadGainTracks::getTruncMean(float low, float high)
     const int endInd = static_cast<int>(high * nClustersUsed);
 
     if (endInd <= startInd) {
-      mDedxTmp.emplace_back(-1);
+      dedxTmp.emplace_back(-1);
       continue;
     }
 
     const float dEdx = std::accumulate(charge.begin() + startInd, charge.begin() + endInd, 0.f);
     const int nClustersTrunc = endInd - startInd; // count number of clusters
-    mDedxTmp.emplace_back(dEdx / nClustersTrunc);
+    dedxTmp.emplace_back(dEdx / nClustersTrunc);
   }
 }
 
@@ -270,27 +320,32 @@ float CalibPadGainTracks::getTrackTopologyCorrectionPol(const o2::tpc::TrackTPC&
 
 void CalibPadGainTracks::reserveMemory()
 {
-  mClTrk.reserve(Mapper::PADROWS);
+  for (auto& buffer : mThreadBuffers) {
+    buffer.clTrk.reserve(Mapper::PADROWS);
+  }
   resizedEdxBuffer();
 }
 
 void CalibPadGainTracks::resizedEdxBuffer()
 {
-  if (mDedxRegion == stack) {
-    mDEdxBuffer.resize(4);
-    mDEdxBuffer[0].reserve(Mapper::getNumberOfRowsInIROC());
-    mDEdxBuffer[1].reserve(Mapper::getNumberOfRowsInOROC());
-    mDEdxBuffer[2].reserve(Mapper::getNumberOfRowsInOROC());
-    mDEdxBuffer[3].reserve(Mapper::getNumberOfRowsInOROC());
-  } else if (mDedxRegion == chamber) {
-    mDEdxBuffer.resize(2);
-    mDEdxBuffer[0].reserve(Mapper::getNumberOfRowsInIROC());
-    mDEdxBuffer[1].reserve(Mapper::getNumberOfRowsInOROC());
-  } else if (mDedxRegion == sector) {
-    mDEdxBuffer.resize(1);
-    mDEdxBuffer[0].reserve(Mapper::instance().getNumberOfRows());
-  } else {
-    LOGP(warning, "wrong dE/dx type");
+  for (auto& buffer : mThreadBuffers) {
+    auto& dEdxBuffer = buffer.dEdxBuffer;
+    if (mDedxRegion == stack) {
+      dEdxBuffer.resize(4);
+      dEdxBuffer[0].reserve(Mapper::getNumberOfRowsInIROC());
+      dEdxBuffer[1].reserve(Mapper::getNumberOfRowsInOROC());
+      dEdxBuffer[2].reserve(Mapper::getNumberOfRowsInOROC());
+      dEdxBuffer[3].reserve(Mapper::getNumberOfRowsInOROC());
+    } else if (mDedxRegion == chamber) {
+      dEdxBuffer.resize(2);
+      dEdxBuffer[0].reserve(Mapper::getNumberOfRowsInIROC());
+      dEdxBuffer[1].reserve(Mapper::getNumberOfRowsInOROC());
+    } else if (mDedxRegion == sector) {
+      dEdxBuffer.resize(1);
+      dEdxBuffer[0].reserve(Mapper::instance().getNumberOfRows());
+    } else {
+      LOGP(warning, "wrong dE/dx type");
+    }
   }
 }
 
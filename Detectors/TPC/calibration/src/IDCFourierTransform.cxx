@@ -30,6 +30,7 @@ o2::tpc::IDCFourierTransform<Type>::~IDCFourierTransform()
     fftwf_free(mCoefficients[thread]);
   }
   fftwf_destroy_plan(mFFTWPlan);
+  fftwf_destroy_plan(mFFTWPlanInverse);
 }
 
 template <class Type>
@@ -39,7 +40,9 @@ void o2::tpc::IDCFourierTransform<Type>::initFFTW3Members()
     mVal1DIDCs[thread] = fftwf_alloc_real(this->mRangeIDC);
     mCoefficients[thread] = fftwf_alloc_complex(getNMaxCoefficients());
   }
+  // plans are created once for the given interval length and executed with the per thread buffers
   mFFTWPlan = fftwf_plan_dft_r2c_1d(this->mRangeIDC, mVal1DIDCs.front(), mCoefficients.front(), FFTW_ESTIMATE);
+  mFFTWPlanInverse = fftwf_plan_dft_c2r_1d(this->mRangeIDC, mCoefficients.front(), mVal1DIDCs.front(), FFTW_ESTIMATE);
 }
 
 template <class Type>
@@ -60,9 +63,10 @@ void o2::tpc::IDCFourierTransform<Type>::calcFourierCoefficientsNaive()
   const bool add = mFourierCoefficients.getNCoefficientsPerTF() % 2;
   const unsigned int lastCoeff = mFourierCoefficients.getNCoefficientsPerTF() / 2;
 
+  const std::vector<float> idcOneExpanded{this->getExpandedIDCOne()}; // 1D-IDC values which will be used for the FFT
+
 #pragma omp parallel for num_threads(sNThreads)
   for (unsigned int interval = 0; interval < this->getNIntervals(); ++interval) {
-    const std::vector<float>& idcOneExpanded{this->getExpandedIDCOne()}; // 1D-IDC values which will be used for the FFT
     for (unsigned int coeff = 0; coeff < lastCoeff; ++coeff) {
       const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * coeff); // index for storing real fourier coefficient
       const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
@@ -167,19 +171,17 @@ std::vector<std::vector<float>> o2::tpc::IDCFourierTransform<Type>::inverseFouri
   std::vector<std::vector<float>> inverse(this->getNIntervals());
 
   // loop over all the intervals. For each interval the coefficients are calculated
-  // this loop and execution of FFTW is not optimized as it is used only for debugging
+#pragma omp parallel for num_threads(sNThreads)
   for (unsigned int interval = 0; interval < this->getNIntervals(); ++interval) {
-    inverse[interval].resize(this->mRangeIDC);
-    std::vector<std::array<float, 2>> val1DIDCs;
-    val1DIDCs.reserve(this->mRangeIDC);
+    const int thread = omp_get_thread_num();
     for (unsigned int index = 0; index < getNMaxCoefficients(); ++index) {
       const unsigned int indexDataReal = mFourierCoefficients.getIndex(interval, 2 * index); // index for storing real fourier coefficient
       const unsigned int indexDataImag = indexDataReal + 1;                                  // index for storing complex fourier coefficient
-      val1DIDCs.emplace_back(std::array<float, 2>{mFourierCoefficients(indexDataReal), mFourierCoefficients(indexDataImag)});
+      mCoefficients[thread][index][0] = mFourierCoefficients(indexDataReal);
+      mCoefficients[thread][index][1] = mFourierCoefficients(indexDataImag);
     }
-    const fftwf_plan fftwPlan = fftwf_plan_dft_c2r_1d(this->mRangeIDC, reinterpret_cast<fftwf_complex*>(val1DIDCs.data()), inverse[interval].data(), FFTW_ESTIMATE);
-    fftwf_execute(fftwPlan);
-    fftwf_destroy_plan(fftwPlan);
+    fftwf_execute_dft_c2r(mFFTWPlanInverse, mCoefficients[thread], mVal1DIDCs[thread]); // the input buffer is overwritten by the c2r transform
+    inverse[interval].assign(mVal1DIDCs[thread], mVal1DIDCs[thread] + this->mRangeIDC);
   }
   return inverse;
 }
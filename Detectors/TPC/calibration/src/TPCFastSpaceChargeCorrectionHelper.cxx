@@ -28,6 +28,8 @@
 #include "Riostream.h"
 #include <fairlogger/Logger.h>
 #include <thread>
+#include <atomic>
+#include <algorithm>
 #include "TStopwatch.h"
 
 using namespace o2::gpu;
@@ -672,89 +674,242 @@ void TPCFastSpaceChargeCorrectionHelper::initInverse(std::vector<o2::gpu::TPCFas
   auto& correction = *(corrections.front());
   initMaxDriftLength(correction, prn);
 
-  double tpcR2min = mGeo.getRowInfo(0).x - 1.;
-  tpcR2min = tpcR2min * tpcR2min;
-  double tpcR2max = mGeo.getRowInfo(mGeo.getNumberOfRows() - 1).x;
-  tpcR2max = tpcR2max / cos(2 * M_PI / mGeo.getNumberOfSlicesA() / 2) + 1.;
-  tpcR2max = tpcR2max * tpcR2max;
-
   for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
     // LOG(info) << "inverse transform for slice " << slice ;
-    double vLength = (slice < mGeo.getNumberOfSlicesA()) ? mGeo.getTPCzLengthA() : mGeo.getTPCzLengthC();
+    auto myThread = [&](int iThread) {
+      Spline2DHelper<float> helper;
+      std::vector<float> splineParameters;
+
+      for (int row = iThread; row < mGeo.getNumberOfRows(); row += mNthreads) {
+        initInverseRow(corrections, scaling, slice, row, helper, splineParameters, prn);
+      } // row
+    };  // thread
+
+    std::vector<std::thread> threads(mNthreads);
+
+    // run n threads
+    for (int i = 0; i < mNthreads; i++) {
+      threads[i] = std::thread(myThread, i);
+    }
+
+    // wait for the threads to finish
+    for (auto& th : threads) {
+      th.join();
+    }
+
+  } // slice
+  float duration = watch.RealTime();
+  LOGP(info, "Inverse took: {}s", duration);
+}
+
+void TPCFastSpaceChargeCorrectionHelper::initInverseRow(std::vector<o2::gpu::TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling, int slice, int row,
+                                                        Spline2DHelper<float>& helper, std::vector<float>& splineParameters, bool prn)
+{
+  /// initialise inverse transformation for one TPC row
+  auto& correction = *(corrections.front());
+  TPCFastSpaceChargeCorrection::SplineType spline = correction.getSpline(slice, row);
+  helper.setSpline(spline, 10, 10);
+  std::vector<double> dataPointCU, dataPointCV, dataPointF;
+
+  float u0, u1, v0, v1;
+  mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
+  mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
+
+  double x = mGeo.getRowInfo(row).x;
+  int nPointsU = (spline.getGridX1().getNumberOfKnots() - 1) * 10;
+  int nPointsV = (spline.getGridX2().getNumberOfKnots() - 1) * 10;
+
+  double stepU = (u1 - u0) / (nPointsU - 1);
+  double stepV = (v1 - v0) / (nPointsV - 1);
+
+  if (prn) {
+    LOG(info) << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1;
+  }
+  TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
+  area.cuMin = 1.e10;
+  area.cuMax = -1.e10;
+
+  /*
+  v1 = area.vMax;
+  stepV = (v1 - v0) / (nPointsU - 1);
+  if (stepV < 1.f) {
+    stepV = 1.f;
+  }
+  */
+
+  for (double u = u0; u < u1 + stepU; u += stepU) {
+    for (double v = v0; v < v1 + stepV; v += stepV) {
+      float dx, du, dv;
+      correction.getCorrection(slice, row, u, v, dx, du, dv);
+      dx *= scaling[0];
+      du *= scaling[0];
+      dv *= scaling[0];
+      // add remaining corrections
+      for (int i = 1; i < corrections.size(); ++i) {
+        float dxTmp, duTmp, dvTmp;
+        corrections[i]->getCorrection(slice, row, u, v, dxTmp, duTmp, dvTmp);
+        dx += dxTmp * scaling[i];
+        du += duTmp * scaling[i];
+        dv += dvTmp * scaling[i];
+      }
+      double cx = x + dx;
+      double cu = u + du;
+      double cv = v + dv;
+      if (cu < area.cuMin) {
+        area.cuMin = cu;
+      }
+      if (cu > area.cuMax) {
+        area.cuMax = cu;
+      }
+
+      dataPointCU.push_back(cu);
+      dataPointCV.push_back(cv);
+      dataPointF.push_back(dx);
+      dataPointF.push_back(du);
+      dataPointF.push_back(dv);
+
+      if (prn) {
+        LOG(info) << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv;
+      }
+    } // v
+  }   // u
+
+  if (area.cuMax - area.cuMin < 0.2) {
+    area.cuMax = .1;
+    area.cuMin = -.1;
+  }
+  if (area.cvMax < 0.1) {
+    area.cvMax = .1;
+  }
+  if (prn) {
+    LOG(info) << "slice " << slice << " row " << row << " max drift L = " << correction.getMaxDriftLength(slice, row)
+              << " active area: cuMin " << area.cuMin << " cuMax " << area.cuMax << " vMax " << area.vMax << " cvMax " << area.cvMax;
+  }
+
+  TPCFastSpaceChargeCorrection::SliceRowInfo& info = correction.getSliceRowInfo(slice, row);
+  info.gridCorrU0 = area.cuMin;
+  info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (area.cuMax - area.cuMin);
+  info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / area.cvMax;
+
+  info.gridCorrU0 = u0;
+  info.gridCorrV0 = info.gridV0;
+  info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (u1 - info.gridCorrU0);
+  info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / (v1 - info.gridCorrV0);
+
+  int nDataPoints = dataPointCU.size();
+  for (int i = 0; i < nDataPoints; i++) {
+    dataPointCU[i] = (dataPointCU[i] - info.gridCorrU0) * info.scaleCorrUtoGrid;
+    dataPointCV[i] = (dataPointCV[i] - info.gridCorrV0) * info.scaleCorrVtoGrid;
+  }
+
+  splineParameters.resize(spline.getNumberOfParameters());
+
+  helper.approximateDataPoints(spline, splineParameters.data(), 0., spline.getGridX1().getUmax(),
+                               0., spline.getGridX2().getUmax(),
+                               dataPointCU.data(), dataPointCV.data(),
+                               dataPointF.data(), dataPointCU.size());
+
+  float* splineX = correction.getSplineData(slice, row, 1);
+  float* splineUV = correction.getSplineData(slice, row, 2);
+  for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
+    splineX[i] = splineParameters[3 * i + 0];
+    splineUV[2 * i + 0] = splineParameters[3 * i + 1];
+    splineUV[2 * i + 1] = splineParameters[3 * i + 2];
+  }
+}
+
+std::unique_ptr<TPCFastSpaceChargeCorrection> TPCFastSpaceChargeCorrectionHelper::createFromLinearCombination(const std::vector<const TPCFastSpaceChargeCorrection*>& corrections, const std::vector<float>& scaling,
+                                                                                                          float maxInverseResidual, bool prn)
+{
+  /// creates TPCFastSpaceChargeCorrection object as a linear combination of corrections with identical spline layout
+
+  TStopwatch watch;
+  if (corrections.empty() || corrections.size() != scaling.size()) {
+    LOGP(error, "Input corrections and scaling values have different size");
+    return nullptr;
+  }
+
+  if (!mIsInitialized) {
+    initGeometry();
+  }
+
+  const auto& corr0 = *(corrections.front());
+  for (const auto* corr : corrections) {
+    bool sameLayout = (corr->getFlatBufferSize() == corr0.getFlatBufferSize());
+    for (int slice = 0; sameLayout && slice < mGeo.getNumberOfSlices(); slice++) {
+      for (int row = 0; sameLayout && row < mGeo.getNumberOfRows(); row++) {
+        const auto &info = corr->getSliceRowInfo(slice, row), &info0 = corr0.getSliceRowInfo(slice, row);
+        sameLayout = corr->getRowInfo(row).splineScenarioID == corr0.getRowInfo(row).splineScenarioID &&
+                     corr->getSpline(slice, row).getNumberOfParameters() == corr0.getSpline(slice, row).getNumberOfParameters() &&
+                     info.gridV0 == info0.gridV0 && info.gridCorrU0 == info0.gridCorrU0 && info.gridCorrV0 == info0.gridCorrV0 &&
+                     info.scaleCorrUtoGrid == info0.scaleCorrUtoGrid && info.scaleCorrVtoGrid == info0.scaleCorrVtoGrid;
+      }
+    }
+    if (!sameLayout) {
+      LOGP(error, "Input corrections have different spline layouts and can not be combined linearly");
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<TPCFastSpaceChargeCorrection> correctionPtr(new TPCFastSpaceChargeCorrection);
+  TPCFastSpaceChargeCorrection& correction = *correctionPtr;
+  correction.cloneFromObject(corr0, nullptr);
+
+  // the spline approximation is linear in the input data: combine the parameters of the direct and of the inverse splines
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < mGeo.getNumberOfRows(); row++) {
+      const int nPar = correction.getSpline(slice, row).getNumberOfParameters();
+      const int nParSpline[3] = {nPar, nPar / 3, 2 * nPar / 3};
+      for (int iSpline = 0; iSpline < 3; iSpline++) {
+        float* data = correction.getSplineData(slice, row, iSpline);
+        for (int i = 0; i < nParSpline[iSpline]; i++) {
+          data[i] = 0.f;
+          for (int ic = 0; ic < corrections.size(); ic++) {
+            data[i] += scaling[ic] * corrections[ic]->getSplineData(slice, row, iSpline)[i];
+          }
+        }
+      }
+    }
+  }
+
+  // the inverse of the combined correction is not linear in the inputs: check the combined inverse splines and refit them where needed
+  initMaxDriftLength(correction, prn);
+
+  std::vector<o2::gpu::TPCFastSpaceChargeCorrection*> corrCombined{&correction};
+  const std::vector<float> scalingCombined{1.f};
+  std::atomic<int> nRefitted{0};
+
+  for (int slice = 0; slice < mGeo.getNumberOfSlices(); slice++) {
 
     auto myThread = [&](int iThread) {
       Spline2DHelper<float> helper;
       std::vector<float> splineParameters;
-      ChebyshevFit1D chebFitterX, chebFitterU, chebFitterV;
 
       for (int row = iThread; row < mGeo.getNumberOfRows(); row += mNthreads) {
-        TPCFastSpaceChargeCorrection::SplineType spline = correction.getSpline(slice, row);
-        helper.setSpline(spline, 10, 10);
-        std::vector<double> dataPointCU, dataPointCV, dataPointF;
+        const TPCFastSpaceChargeCorrection::SplineType& spline = correction.getSpline(slice, row);
 
         float u0, u1, v0, v1;
         mGeo.convScaledUVtoUV(slice, row, 0., 0., u0, v0);
         mGeo.convScaledUVtoUV(slice, row, 1., 1., u1, v1);
 
-        double x = mGeo.getRowInfo(row).x;
-        int nPointsU = (spline.getGridX1().getNumberOfKnots() - 1) * 10;
-        int nPointsV = (spline.getGridX2().getNumberOfKnots() - 1) * 10;
+        const double x = mGeo.getRowInfo(row).x;
+        const int nPointsU = (spline.getGridX1().getNumberOfKnots() - 1) * 10;
+        const int nPointsV = (spline.getGridX2().getNumberOfKnots() - 1) * 10;
+        const double stepU = (u1 - u0) / (nPointsU - 1);
+        const double stepV = (v1 - v0) / (nPointsV - 1);
 
-        double stepU = (u1 - u0) / (nPointsU - 1);
-        double stepV = (v1 - v0) / (nPointsV - 1);
-
-        if (prn) {
-          LOG(info) << "u0 " << u0 << " u1 " << u1 << " v0 " << v0 << " v1 " << v1;
-        }
+        // active area of the corrected coordinates, as in initInverseRow()
         TPCFastSpaceChargeCorrection::RowActiveArea& area = correction.getSliceRowInfo(slice, row).activeArea;
         area.cuMin = 1.e10;
         area.cuMax = -1.e10;
-
-        /*
-        v1 = area.vMax;
-        stepV = (v1 - v0) / (nPointsU - 1);
-        if (stepV < 1.f) {
-          stepV = 1.f;
-        }
-        */
-
         for (double u = u0; u < u1 + stepU; u += stepU) {
           for (double v = v0; v < v1 + stepV; v += stepV) {
             float dx, du, dv;
             correction.getCorrection(slice, row, u, v, dx, du, dv);
-            dx *= scaling[0];
-            du *= scaling[0];
-            dv *= scaling[0];
-            // add remaining corrections
-            for (int i = 1; i < corrections.size(); ++i) {
-              float dxTmp, duTmp, dvTmp;
-              corrections[i]->getCorrection(slice, row, u, v, dxTmp, duTmp, dvTmp);
-              dx += dxTmp * scaling[i];
-              du += duTmp * scaling[i];
-              dv += dvTmp * scaling[i];
-            }
-            double cx = x + dx;
-            double cu = u + du;
-            double cv = v + dv;
-            if (cu < area.cuMin) {
-              area.cuMin = cu;
-            }
-            if (cu > area.cuMax) {
-              area.cuMax = cu;
-            }
-
-            dataPointCU.push_back(cu);
-            dataPointCV.push_back(cv);
-            dataPointF.push_back(dx);
-            dataPointF.push_back(du);
-            dataPointF.push_back(dv);
-
-            if (prn) {
-              LOG(info) << "measurement cu " << cu << " cv " << cv << " dx " << dx << " du " << du << " dv " << dv;
-            }
-          } // v
-        }   // u
-
+            area.cuMin = std::min(area.cuMin, float(u + du));
+            area.cuMax = std::max(area.cuMax, float(u + du));
+          }
+        }
         if (area.cuMax - area.cuMin < 0.2) {
           area.cuMax = .1;
           area.cuMin = -.1;
@@ -762,40 +917,27 @@ void TPCFastSpaceChargeCorrectionHelper::initInverse(std::vector<o2::gpu::TPCFas
         if (area.cvMax < 0.1) {
           area.cvMax = .1;
         }
-        if (prn) {
-          LOG(info) << "slice " << slice << " row " << row << " max drift L = " << correction.getMaxDriftLength(slice, row)
-                    << " active area: cuMin " << area.cuMin << " cuMax " << area.cuMax << " vMax " << area.vMax << " cvMax " << area.cvMax;
-        }
-
-        TPCFastSpaceChargeCorrection::SliceRowInfo& info = correction.getSliceRowInfo(slice, row);
-        info.gridCorrU0 = area.cuMin;
-        info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (area.cuMax - area.cuMin);
-        info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / area.cvMax;
-
-        info.gridCorrU0 = u0;
-        info.gridCorrV0 = info.gridV0;
-        info.scaleCorrUtoGrid = spline.getGridX1().getUmax() / (u1 - info.gridCorrU0);
-        info.scaleCorrVtoGrid = spline.getGridX2().getUmax() / (v1 - info.gridCorrV0);
 
-        int nDataPoints = dataPointCU.size();
-        for (int i = 0; i < nDataPoints; i++) {
-          dataPointCU[i] = (dataPointCU[i] - info.gridCorrU0) * info.scaleCorrUtoGrid;
-          dataPointCV[i] = (dataPointCV[i] - info.gridCorrV0) * info.scaleCorrVtoGrid;
+        // residual of the combined inverse w.r.t. the inversion of the combined correction
+        float maxResidual = 0.f;
+        for (double u = u0; u < u1 + stepU && maxResidual <= maxInverseResidual; u += stepU) {
+          for (double v = v0; v < v1 + stepV; v += stepV) {
+            float dx, du, dv;
+            correction.getCorrection(slice, row, u, v, dx, du, dv);
+            const float cu = u + du, cv = v + dv;
+            float nomX, nomU, nomV;
+            correction.getCorrectionInvCorrectedX(slice, row, cu, cv, nomX);
+            correction.getCorrectionInvUV(slice, row, cu, cv, nomU, nomV);
+            maxResidual = std::max({maxResidual, std::abs(nomX - float(x + dx)), std::abs(nomU - float(u)), std::abs(nomV - float(v))});
+          }
         }
 
-        splineParameters.resize(spline.getNumberOfParameters());
-
-        helper.approximateDataPoints(spline, splineParameters.data(), 0., spline.getGridX1().getUmax(),
-                                     0., spline.getGridX2().getUmax(),
-                                     dataPointCU.data(), dataPointCV.data(),
-                                     dataPointF.data(), dataPointCU.size());
-
-        float* splineX = correction.getSplineData(slice, row, 1);
-        float* splineUV = correction.getSplineData(slice, row, 2);
-        for (int i = 0; i < spline.getNumberOfParameters() / 3; i++) {
-          splineX[i] = splineParameters[3 * i + 0];
-          splineUV[2 * i + 0] = splineParameters[3 * i + 1];
-          splineUV[2 * i + 1] = splineParameters[3 * i + 2];
+        if (maxResidual > maxInverseResidual) {
+          if (prn) {
+            LOG(info) << "slice " << slice << " row " << row << " inverse residual " << maxResidual << " > " << maxInverseResidual << ": refit the inverse correction";
+          }
+          initInverseRow(corrCombined, scalingCombined, slice, row, helper, splineParameters, prn);
+          ++nRefitted;
         }
       } // row
     };  // thread
@@ -813,8 +955,10 @@ void TPCFastSpaceChargeCorrectionHelper::initInverse(std::vector<o2::gpu::TPCFas
     }
 
   } // slice
+
   float duration = watch.RealTime();
-  LOGP(info, "Inverse took: {}s", duration);
+  LOGP(info, "Linear combination of {} corrections took: {}s, inverse correction refitted for {} out of {} rows", corrections.size(), duration, nRefitted.load(), mGeo.getNumberOfSlices() * mGeo.getNumberOfRows());
+  return std::move(correctionPtr);
 }
 
 } // namespace tpc
@@ -0,0 +1,218 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TPCFastTransformSharedMemory.cxx
+/// \brief Distribution of TPCFastTransform objects between the processes of a node via POSIX shared memory
+
+#include "TPCCalibration/TPCFastTransformSharedMemory.h"
+#include "TPCFastTransform.h"
+#include "Framework/Logger.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace o2::tpc;
+
+namespace
+{
+size_t alignSize(const size_t size, const size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+} // namespace
+
+std::string TPCFastTransformSharedMemory::getSegmentName(std::string_view name, uint64_t version)
+{
+  return fmt::format("{}_v{}", name, version);
+}
+
+uint64_t TPCFastTransformSharedMemory::getPublishedVersion(std::string_view name)
+{
+  const std::string segment(name);
+  const int fd = shm_open(segment.data(), O_RDONLY, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(std::atomic<uint64_t>))) {
+    close(fd);
+    return 0;
+  }
+  void* ptr = mmap(nullptr, sizeof(std::atomic<uint64_t>), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return 0;
+  }
+  const uint64_t version = reinterpret_cast<const std::atomic<uint64_t>*>(ptr)->load(std::memory_order_acquire);
+  munmap(ptr, sizeof(std::atomic<uint64_t>));
+  return version;
+}
+
+bool TPCFastTransformSharedMemory::publish(std::string_view name, const o2::gpu::TPCFastTransform& transform, uint64_t version)
+{
+  if (!transform.isConstructed()) {
+    LOGP(error, "Can not publish TPCFastTransform which is not constructed");
+    return false;
+  }
+
+  const uint64_t publishedVersion = getPublishedVersion(name);
+  if (version <= publishedVersion) {
+    LOGP(error, "Version {} of {} is not larger than the published version {}", version, name, publishedVersion);
+    return false;
+  }
+
+  // the flat buffer starts at a new page: only the pages of the class parts are modified when relocating the pointers
+  Header header;
+  header.magic = Magic;
+  header.version = version;
+  header.classOffset = alignSize(sizeof(Header), o2::gpu::TPCFastTransform::getClassAlignmentBytes());
+  header.classSize = sizeof(o2::gpu::TPCFastTransform);
+  header.bufferOffset = alignSize(header.classOffset + header.classSize, sysconf(_SC_PAGESIZE));
+  header.bufferSize = transform.getFlatBufferSize();
+  const size_t segmentSize = header.bufferOffset + header.bufferSize;
+
+  const std::string segment = getSegmentName(name, version);
+  const int fd = shm_open(segment.data(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    LOGP(error, "Could not create shared memory segment {}: {}", segment, std::strerror(errno));
+    return false;
+  }
+  if (ftruncate(fd, segmentSize) != 0) {
+    LOGP(error, "Could not resize shared memory segment {} to {} bytes: {}", segment, segmentSize, std::strerror(errno));
+    close(fd);
+    shm_unlink(segment.data());
+    return false;
+  }
+  void* ptr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    LOGP(error, "Could not map shared memory segment {}: {}", segment, std::strerror(errno));
+    shm_unlink(segment.data());
+    return false;
+  }
+
+  char* base = static_cast<char*>(ptr);
+  {
+    // clone with the flat buffer in the segment and copy the class part, the pointers are relocated by the readers
+    o2::gpu::TPCFastTransform tmp;
+    tmp.cloneFromObject(transform, base + header.bufferOffset);
+    std::memcpy(base + header.classOffset, static_cast<const void*>(&tmp), header.classSize);
+  }
+  std::memcpy(base, &header, sizeof(Header));
+  munmap(ptr, segmentSize);
+
+  // make the new version visible to the readers
+  const std::string versionSegment(name);
+  const int fdVersion = shm_open(versionSegment.data(), O_CREAT | O_RDWR, 0644);
+  if (fdVersion < 0 || ftruncate(fdVersion, sizeof(std::atomic<uint64_t>)) != 0) {
+    LOGP(error, "Could not create shared memory segment {}: {}", versionSegment, std::strerror(errno));
+    if (fdVersion >= 0) {
+      close(fdVersion);
+    }
+    shm_unlink(segment.data());
+    return false;
+  }
+  void* ptrVersion = mmap(nullptr, sizeof(std::atomic<uint64_t>), PROT_READ | PROT_WRITE, MAP_SHARED, fdVersion, 0);
+  close(fdVersion);
+  if (ptrVersion == MAP_FAILED) {
+    LOGP(error, "Could not map shared memory segment {}: {}", versionSegment, std::strerror(errno));
+    shm_unlink(segment.data());
+    return false;
+  }
+  reinterpret_cast<std::atomic<uint64_t>*>(ptrVersion)->store(version, std::memory_order_release);
+  munmap(ptrVersion, sizeof(std::atomic<uint64_t>));
+
+  // processes which are still attached to the previous version keep their mapping
+  if (publishedVersion > 0) {
+    shm_unlink(getSegmentName(name, publishedVersion).data());
+  }
+
+  LOGP(info, "Published TPCFastTransform version {} with {} bytes in shared memory segment {}", version, segmentSize, segment);
+  return true;
+}
+
+void TPCFastTransformSharedMemory::unlink(std::string_view name)
+{
+  const uint64_t publishedVersion = getPublishedVersion(name);
+  if (publishedVersion > 0) {
+    shm_unlink(getSegmentName(name, publishedVersion).data());
+  }
+  shm_unlink(std::string(name).data());
+}
+
+bool TPCFastTransformSharedMemory::attach(std::string_view name)
+{
+  detach();
+
+  // the segment of the published version might be removed by a concurrent publication: retry with the new version
+  const int maxTrials = 3;
+  for (int trial = 0; trial < maxTrials; ++trial) {
+    const uint64_t version = getPublishedVersion(name);
+    if (version == 0) {
+      LOGP(warning, "No TPCFastTransform published in shared memory segment {}", name);
+      return false;
+    }
+
+    const std::string segment = getSegmentName(name, version);
+    const int fd = shm_open(segment.data(), O_RDONLY, 0);
+    if (fd < 0) {
+      continue;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+      close(fd);
+      continue;
+    }
+    const size_t segmentSize = st.st_size;
+
+    // private mapping: relocating the pointers creates private copies of the touched pages only
+    void* ptr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+      LOGP(error, "Could not map shared memory segment {}: {}", segment, std::strerror(errno));
+      return false;
+    }
+
+    char* base = static_cast<char*>(ptr);
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+    if (header.magic != Magic || header.version != version || header.classSize != sizeof(o2::gpu::TPCFastTransform) || header.bufferOffset + header.bufferSize > segmentSize) {
+      LOGP(error, "Shared memory segment {} does not contain a valid TPCFastTransform", segment);
+      munmap(ptr, segmentSize);
+      return false;
+    }
+
+    mTransform = reinterpret_cast<o2::gpu::TPCFastTransform*>(base + header.classOffset);
+    mTransform->setActualBufferAddress(base + header.bufferOffset);
+    mMapping = ptr;
+    mMappingSize = segmentSize;
+    mVersion = version;
+    mName = name;
+    LOGP(info, "Attached to TPCFastTransform version {} in shared memory segment {}", version, segment);
+    return true;
+  }
+
+  LOGP(error, "Could not attach to TPCFastTransform published in shared memory segment {}", name);
+  return false;
+}
+
+void TPCFastTransformSharedMemory::detach()
+{
+  if (mMapping) {
+    munmap(mMapping, mMappingSize);
+  }
+  mTransform = nullptr;
+  mMapping = nullptr;
+  mMappingSize = 0;
+  mVersion = 0;
+}
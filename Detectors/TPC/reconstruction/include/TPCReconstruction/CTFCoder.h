@@ -160,6 +160,8 @@ class CTFCoder : public o2::ctf::CTFCoderBase
 
   bool getCombineColumns() const { return mCombineColumns; }
   void setCombineColumns(bool v) { mCombineColumns = v; }
+  bool getContextCoding() const { return mContextCoding; }
+  void setContextCoding(bool v) { mContextCoding = v; }
 
  private:
   void checkDataDictionaryConsistency(const CTFHeader& h);
@@ -170,7 +172,10 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   template <typename source_T>
   void buildCoder(ctf::CTFCoderBase::OpType coderType, const CTF::container_t& ctf, CTF::Slots slot);
 
+  static constexpr uint8_t NBitsRowDiffContext = 2; // the residuals are coded in the contexts of row increments 0, 1, 2 and >2
+
   bool mCombineColumns = false; // combine correlated columns
+  bool mContextCoding = false;  // code the track cluster residuals in the context of the row increment
 };
 
 template <typename source_T>
@@ -230,20 +235,19 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   ec->setANSHeader(mANSVersion);
 
   o2::ctf::CTFIOSize iosize;
-  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
-    // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
+  // with several threads the blocks are encoded concurrently, see CTFCoderBase::SlotEncoder
+  auto slotEncoder = makeSlotEncoder<CTF>(buff);
+  auto encodeTPC = [&slotEncoder, &optField](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
+    const auto slotVal = static_cast<int>(slot);
+    slotEncoder.encode(begin, end, slotVal, probabilityBits, optField[slotVal], reject);
+  };
+  // the entries of the context stream correspond one by one to those of the encoded stream
+  auto encodeTPCWithContext = [&slotEncoder, &optField, ctxCoding = mContextCoding](auto begin, auto end, auto ctxBegin, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
     const auto slotVal = static_cast<int>(slot);
-    if (reject && begin != end) {
-      std::vector<std::decay_t<decltype(*begin)>> tmp;
-      tmp.reserve(std::distance(begin, end));
-      for (auto i = begin; i != end; i++) {
-        if (!(*reject)[std::distance(begin, i)]) {
-          tmp.emplace_back(*i);
-        }
-      }
-      iosize += CTF::get(buff.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+    if (ctxCoding) {
+      slotEncoder.encodeWithContext(begin, end, ctxBegin, slotVal, NBitsRowDiffContext, probabilityBits, o2::ctf::Metadata::OptStore::EENCODE_CTX, reject);
     } else {
-      iosize += CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      slotEncoder.encode(begin, end, slotVal, probabilityBits, optField[slotVal], reject);
     }
   };
 
@@ -267,8 +271,8 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   }
   encodeTPC(ccl.sliceLegDiffA, ccl.sliceLegDiffA + (mCombineColumns ? 0 : ccl.nAttachedClustersReduced), CTF::BLCsliceLegDiffA, 0, rejectTrackHitsReduced);
 
-  encodeTPC(ccl.padResA, ccl.padResA + ccl.nAttachedClustersReduced, CTF::BLCpadResA, 0, rejectTrackHitsReduced);
-  encodeTPC(ccl.timeResA, ccl.timeResA + ccl.nAttachedClustersReduced, CTF::BLCtimeResA, 0, rejectTrackHitsReduced);
+  encodeTPCWithContext(ccl.padResA, ccl.padResA + ccl.nAttachedClustersReduced, ccl.rowDiffA, CTF::BLCpadResA, 0, rejectTrackHitsReduced);
+  encodeTPCWithContext(ccl.timeResA, ccl.timeResA + ccl.nAttachedClustersReduced, ccl.rowDiffA, CTF::BLCtimeResA, 0, rejectTrackHitsReduced);
 
   if (mCombineColumns) {
     const auto [begin, end] = makeInputIterators(ccl.sigmaPadA, ccl.sigmaTimeA, ccl.nAttachedClusters,
@@ -314,6 +318,8 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   encodeTPC(trigComp.deltaBC.begin(), trigComp.deltaBC.end(), CTF::BLCTrigBCInc, 0);
   encodeTPC(trigComp.triggerType.begin(), trigComp.triggerType.end(), CTF::BLCTrigType, 0);
 
+  iosize += slotEncoder.finalise();
+
   CTF::get(buff.data())->print(getPrefix(), mVerbosity);
   finaliseCTFOutput<CTF>(buff);
   iosize.rawIn = iosize.ctfIn;
@@ -349,6 +355,11 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec, TRIGVEC&
     const auto slotVal = static_cast<int>(slot);
     iosize += ec.decode(begin, slotVal, coders[slotVal]);
   };
+  // blocks encoded w/o context are decoded as usual
+  auto decodeTPCWithContext = [&ec, &coders = mCoders, &iosize](auto begin, auto ctxBegin, CTF::Slots slot) {
+    const auto slotVal = static_cast<int>(slot);
+    iosize += ec.decodeWithContext(begin, ctxBegin, slotVal, coders[slotVal]);
+  };
 
   if (mCombineColumns) {
     detail::MergedColumnsDecoder<CTF::NBitsQTot, CTF::NBitsQMax>::decode(cc.qTotA, cc.qMaxA, CTF::BLCqTotA, decodeTPC);
@@ -366,8 +377,8 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec, TRIGVEC&
     decodeTPC(cc.sliceLegDiffA, CTF::BLCsliceLegDiffA);
   }
 
-  decodeTPC(cc.padResA, CTF::BLCpadResA);
-  decodeTPC(cc.timeResA, CTF::BLCtimeResA);
+  decodeTPCWithContext(cc.padResA, cc.rowDiffA, CTF::BLCpadResA);
+  decodeTPCWithContext(cc.timeResA, cc.rowDiffA, CTF::BLCtimeResA);
 
   if (mCombineColumns) {
     detail::MergedColumnsDecoder<CTF::NBitsSigmaPad, CTF::NBitsSigmaTime>::decode(cc.sigmaPadA, cc.sigmaTimeA, CTF::BLCsigmaPadA, decodeTPC);
@@ -46,6 +46,17 @@ class IonTailCorrection
   /// within each time bin row by row, pad by pad
   static void sortDigitsOneSectorPerTimeBin(std::vector<Digit>& digits);
 
+  /// Indices of the digits of a single sector sorted per pad in increasing time bin order
+  /// \param digits input digits
+  /// \param order indices of the digits in the processing order
+  static void getOrderPerPad(const std::vector<Digit>& digits, std::vector<size_t>& order);
+
+  /// comparison of digits per pad in increasing time bin order
+  static bool lessPerPad(const Digit& a, const Digit& b);
+
+  /// comparison of digits per time bin, within each time bin row by row, pad by pad
+  static bool lessPerTimeBin(const Digit& a, const Digit& b);
+
   void setITMultFactor(float multFactor) { mITMultFactor = multFactor; }
   float getITMultFactor() const { return mITMultFactor; }
 
@@ -86,7 +86,6 @@
 #include <tuple>
 #include <vector>
 #include <array>
-#include <deque>
 #include <gsl/span>
 
 namespace o2
@@ -239,6 +238,22 @@ class KrBoxClusterFinder
   /// Used to keep track of the digit that has to be processed
   size_t mFirstDigit = 0;
 
+  /// pre-store if complete time bins and rows within time bins have charges above mQThresholdMax
+  struct ThresholdInfo {
+    bool digitAboveThreshold{};
+    std::array<bool, MaxRows> rowAboveThreshold{};
+  };
+
+  /// charges of one time bin of the sector
+  struct TimeSlice {
+    TimeSliceSector charges{};                                   ///< charge map of the time bin
+    ThresholdInfo thresholdInfo{};                               ///< threshold information of the time bin
+    std::vector<std::pair<unsigned char, unsigned char>> filled; ///< row and corrected pad of the filled charges, used to reset the map
+  };
+
+  /// Storage of the 2*mMaxClusterSizeTime + 1 timeslices, which are reused for consecutive time bins instead of being reallocated
+  std::vector<TimeSlice> mTimeSliceStorage{}; //!
+
   /// The set of timeslices.
   /// It consists of 2*mMaxClusterSizeTime + 1 timeslices.
   /// You can imagine it like this:
@@ -257,24 +272,16 @@ class KrBoxClusterFinder
   /// x-axis: Timeslice number
   /// y-axis: Pad number
   /// Time slice four is the interesting one. In there, local maxima are found and clusters are built from it. After it is processed, timeslice number 1 will be dropped and another timeslice will be put at the end of the set.
-  std::deque<TimeSliceSector> mSetOfTimeSlices{};
+  std::vector<TimeSlice*> mSetOfTimeSlices{}; //!
 
-  /// pre-store if complete time bins and rows within time bins have charges above mQThresholdMax
-  struct ThresholdInfo {
-    bool digitAboveThreshold{};
-    std::array<bool, MaxRows> rowAboveThreshold{};
-  };
-
-  std::deque<ThresholdInfo> mThresholdInfo{};
+  /// \return charge map of time slice i of the set of timeslices
+  const TimeSliceSector& getTimeSlice(int i) const { return mSetOfTimeSlices[i]->charges; }
 
   void createInitialMap(const gsl::span<const Digit> eventSector);
-  void popFirstTimeSliceFromMap()
-  {
-    mSetOfTimeSlices.pop_front();
-    mThresholdInfo.pop_front();
-  }
-  void fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue);
-  void addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice);
+  void popFirstTimeSliceFromMap();
+  void resetTimeSlice(TimeSlice& timeSlice);
+  void fillADCValue(TimeSlice& timeSlice, int cru, int rowInSector, int padInRow, float adcValue);
+  void addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice, TimeSlice& target);
 
   /// For each ROC, the maximum cluster size has to be chosen
   void setMaxClusterSize(int row);
@@ -298,11 +298,6 @@ class GBTFrame
   uint32_t mFrameNum{0};            ///< current GBT frame number
   uint32_t mPacketNum{0};           ///< number of present 8k packet
 
-  /// Bit-shift operations helper function operating on the 4 32-bit words of them
-  /// GBT frame. Source bit "s" is shifted to target position "t"
-  template <typename T>
-  T bit(T s, T t) const;
-
   // /// get value of specific bit
   // static constexpr uint32_t getBit(uint32_t value, uint32_t bit)
   //{
@@ -836,13 +831,6 @@ class RawReaderCRU
 }; // class RawReaderCRU
 
 // ===| inline definitions |====================================================
-template <typename T>
-inline T GBTFrame::bit(T s, T t) const
-{
-  const T dataWord = s >> 5;
-  return shiftBit(mData[dataWord], s, t);
-};
-
 inline void GBTFrame::updateSyncCheck(SyncArray& syncArray)
 {
   const auto offset = mPrevHWpos ^ 4;
@@ -905,19 +893,38 @@ inline void GBTFrame::updateSyncCheck(bool verbose)
 /// extract the 4 5b halfwords for the 5 data streams from one GBT frame
 /// the 4 5b halfwords of the previous frame are stored in the same structure
 /// the position of the previous frame is indicated by mPrevHWpos
+///
+/// The 20 bits of a stream are interleaved: bit k of half word j is bit (3 - j) of the
+/// k-th nibble of the stream. Instead of moving the bits one by one, each nibble is spread
+/// to the 4 bytes of a word with a lookup table, so that the 4 half words of a stream are
+/// assembled at once, one per byte.
 inline void GBTFrame::getFrameHalfWords()
 {
-  constexpr adc_t P[5][4] = {{19, 18, 17, 16}, {39, 38, 37, 36}, {63, 62, 61, 60}, {83, 82, 81, 80}, {107, 106, 105, 104}};
+  // bit b of the nibble goes to byte (3 - b)
+  static constexpr auto NibbleSpread = [] {
+    std::array<uint32_t, 16> lut{};
+    for (uint32_t n = 0; n < 16; ++n) {
+      for (uint32_t b = 0; b < 4; ++b) {
+        lut[n] |= ((n >> b) & 1) << (8 * (3 - b));
+      }
+    }
+    return lut;
+  }();
+
+  // the streams start at bit 0, 20, 44, 64 and 88 of the frame, none of them crosses the 64 bit boundary
+  const uint64_t low = uint64_t(mData[0]) | (uint64_t(mData[1]) << 32);
+  const uint64_t high = uint64_t(mData[2]) | (uint64_t(mData[3]) << 32);
+  const uint32_t streamBits[5] = {uint32_t(low), uint32_t(low >> 20), uint32_t(low >> 44), uint32_t(high), uint32_t(high >> 24)};
+
   // i = Stream, j = Halfword
   for (int i = 0; i < 5; i++) {
+    uint32_t halfWords = 0;
+    for (int k = 0; k < 5; k++) {
+      halfWords |= NibbleSpread[(streamBits[i] >> (4 * k)) & 0xf] << k;
+    }
     for (int j = 0; j < 4; j++) {
-      mFrameHalfWords[i][j + mPrevHWpos] = bit(P[i][j], adc_t(4)) |
-                                           bit(adc_t(P[i][j] - 4), adc_t(3)) |
-                                           bit(adc_t(P[i][j] - 8), adc_t(2)) |
-                                           bit(adc_t(P[i][j] - 12), adc_t(1)) |
-                                           bit(adc_t(P[i][j] - 16), adc_t(0));
-      // std::cout << " S : " << i << " H : " << j << " : " << std::hex << res << std::endl;
-    };
+      mFrameHalfWords[i][j + mPrevHWpos] = (halfWords >> (8 * j)) & 0x1f;
+    }
   }
   mPrevHWpos ^= 4; // toggle position of previous HW position
 }
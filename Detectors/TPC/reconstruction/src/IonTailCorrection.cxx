@@ -17,6 +17,7 @@
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include <numeric>
 #include <filesystem>
 
 #include "TPCBase/Utils.h"
@@ -47,12 +48,15 @@ void IonTailCorrection::filterDigitsDirect(std::vector<Digit>& digits)
     return;
   }
 
-  // make sure we process the digits pad-by-pad in increasing time order
-  sortDigitsOneSectorPerPad(digits);
+  // make sure we process the digits pad-by-pad in increasing time order,
+  // the digits themselves stay in place and are accessed via the sorted indices
+  std::vector<size_t> order;
+  getOrderPerPad(digits, order);
 
+  int lastSector = -1;
   int lastRow = -1;
   int lastPad = -1;
-  int lastTime = digits.front().getTimeStamp();
+  int lastTime = digits[order.front()].getTimeStamp();
   float cumul = 0;
 
   // default IT parameters are replaced below,
@@ -64,26 +68,32 @@ void IonTailCorrection::filterDigitsDirect(std::vector<Digit>& digits)
 
   float kTime = mKTime;
   float tailSlopeUnit = std::exp(-kTime);
+  const bool stream = Streamer::checkStream(o2::utils::StreamFlags::streamITCorr);
 
-  for (auto& digit : digits) {
-    const auto sector = CRU(digit.getCRU()).sector();
+  for (const auto idx : order) {
+    auto& digit = digits[idx];
+    const int sector = CRU(digit.getCRU()).sector();
     const auto row = digit.getRow();
     const auto pad = digit.getPad();
     const auto time = digit.getTimeStamp();
-
-    if (mFraction) {
-      kAmp = mFraction->getValue(sector, row, pad) * std::abs(mITMultFactor);
-      if (mITMultFactor < 0) {
-        kAmp = kAmp / (1 + kAmp);
+    const bool newPad = (row != lastRow || pad != lastPad);
+
+    // pad-by-pad parameters only need to be updated for a new pad
+    if (newPad || sector != lastSector) {
+      if (mFraction) {
+        kAmp = mFraction->getValue(sector, row, pad) * std::abs(mITMultFactor);
+        if (mITMultFactor < 0) {
+          kAmp = kAmp / (1 + kAmp);
+        }
+      }
+      if (mExpLambda) {
+        tailSlopeUnit = mExpLambda->getValue(sector, row, pad);
+        kTime = -std::log(tailSlopeUnit);
       }
-    }
-    if (mExpLambda) {
-      tailSlopeUnit = mExpLambda->getValue(sector, row, pad);
-      kTime = -std::log(tailSlopeUnit);
     }
 
     // reset charge cumulation if pad has changed
-    if (row != lastRow || pad != lastPad) {
+    if (newPad) {
       cumul = 0;
       lastTime = time;
     }
@@ -93,7 +103,7 @@ void IonTailCorrection::filterDigitsDirect(std::vector<Digit>& digits)
       auto origCuml = cumul;
       cumul *= tailSlopeUnit;
 
-      if (Streamer::checkStream(o2::utils::StreamFlags::streamITCorr)) {
+      if (stream) {
         streamData(digit.getCRU(), row, pad, time, lastTime, kAmp, kTime, tailSlopeUnit, origCuml, cumul, 0, 0);
       }
 
@@ -113,53 +123,97 @@ void IonTailCorrection::filterDigitsDirect(std::vector<Digit>& digits)
     cumul += origCharge;
     cumul *= tailSlopeUnit;
 
-    if (Streamer::checkStream(o2::utils::StreamFlags::streamITCorr)) {
+    if (stream) {
       streamData(digit.getCRU(), row, pad, time, lastTime, kAmp, kTime, tailSlopeUnit, origCuml, cumul, origCharge, charge);
     }
 
+    lastSector = sector;
     lastRow = row;
     lastPad = pad;
     lastTime = time;
   }
 
-  // sort back
-  sortDigitsOneSectorPerTimeBin(digits);
+  // the output is sorted by time bin, in most cases the input is already in this order
+  if (!std::is_sorted(digits.begin(), digits.end(), lessPerTimeBin)) {
+    sortDigitsOneSectorPerTimeBin(digits);
+  }
 }
 
-void IonTailCorrection::sortDigitsOneSectorPerPad(std::vector<Digit>& digits)
+void IonTailCorrection::getOrderPerPad(const std::vector<Digit>& digits, std::vector<size_t>& order)
 {
-  // sort digits
-  std::sort(digits.begin(), digits.end(), [](const auto& a, const auto& b) {
-    if (a.getRow() < b.getRow()) {
-      return true;
-    }
-    if (a.getRow() == b.getRow()) {
-      if (a.getPad() < b.getPad()) {
-        return true;
-      } else if (a.getPad() == b.getPad()) {
-        return a.getTimeStamp() < b.getTimeStamp();
+  const size_t nDigits = digits.size();
+  order.resize(nDigits);
+
+  // pack row, pad, time and digit index in one 64 bit key, sorting plain integers is much faster than sorting the digits
+  constexpr int NBitsIndex = 24;
+  constexpr int NBitsTime = 24;
+  constexpr uint64_t MaskIndex = (uint64_t(1) << NBitsIndex) - 1;
+  bool packed = (nDigits <= MaskIndex + 1);
+  std::vector<uint64_t> keys;
+  if (packed) {
+    keys.reserve(nDigits);
+    for (size_t i = 0; i < nDigits; ++i) {
+      const auto& digit = digits[i];
+      const auto time = digit.getTimeStamp();
+      if (time < 0 || time >= (1 << NBitsTime) || digit.getRow() > 0xff || digit.getPad() > 0xff) {
+        packed = false;
+        break;
       }
+      keys.emplace_back((uint64_t(digit.getRow()) << (NBitsIndex + NBitsTime + 8)) | (uint64_t(digit.getPad()) << (NBitsIndex + NBitsTime)) | (uint64_t(time) << NBitsIndex) | i);
+    }
+  }
+
+  if (packed) {
+    std::sort(keys.begin(), keys.end());
+    for (size_t i = 0; i < nDigits; ++i) {
+      order[i] = keys[i] & MaskIndex;
     }
-    return false;
-  });
+  } else {
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&digits](const size_t a, const size_t b) { return lessPerPad(digits[a], digits[b]); });
+  }
+}
+
+void IonTailCorrection::sortDigitsOneSectorPerPad(std::vector<Digit>& digits)
+{
+  // sort digits
+  std::sort(digits.begin(), digits.end(), lessPerPad);
 }
 
 void IonTailCorrection::sortDigitsOneSectorPerTimeBin(std::vector<Digit>& digits)
 {
   // sort digits
-  std::sort(digits.begin(), digits.end(), [](const auto& a, const auto& b) {
-    if (a.getTimeStamp() < b.getTimeStamp()) {
+  std::sort(digits.begin(), digits.end(), lessPerTimeBin);
+}
+
+bool IonTailCorrection::lessPerPad(const Digit& a, const Digit& b)
+{
+  if (a.getRow() < b.getRow()) {
+    return true;
+  }
+  if (a.getRow() == b.getRow()) {
+    if (a.getPad() < b.getPad()) {
       return true;
+    } else if (a.getPad() == b.getPad()) {
+      return a.getTimeStamp() < b.getTimeStamp();
     }
-    if (a.getTimeStamp() == b.getTimeStamp()) {
-      if (a.getRow() < b.getRow()) {
-        return true;
-      } else if (a.getRow() == b.getRow()) {
-        return a.getPad() < b.getPad();
-      }
+  }
+  return false;
+}
+
+bool IonTailCorrection::lessPerTimeBin(const Digit& a, const Digit& b)
+{
+  if (a.getTimeStamp() < b.getTimeStamp()) {
+    return true;
+  }
+  if (a.getTimeStamp() == b.getTimeStamp()) {
+    if (a.getRow() < b.getRow()) {
+      return true;
+    } else if (a.getRow() == b.getRow()) {
+      return a.getPad() < b.getPad();
     }
-    return false;
-  });
+  }
+  return false;
 }
 
 void IonTailCorrection::loadITPadValuesFromFile(std::string_view itParamFile)
@@ -20,6 +20,7 @@
 #include "Framework/Logger.h"
 
 #include <TFile.h>
+#include <algorithm>
 #include <vector>
 
 using namespace o2::tpc;
@@ -40,18 +41,42 @@ void KrBoxClusterFinder::loadGainMapFromFile(const std::string_view calDetFileNa
 
 void KrBoxClusterFinder::createInitialMap(const gsl::span<const Digit> eventSector)
 {
+  const size_t nTimeSlices = 2 * mMaxClusterSizeTime + 1;
+  if (mTimeSliceStorage.size() != nTimeSlices) {
+    mTimeSliceStorage.resize(nTimeSlices);
+  }
+
   mSetOfTimeSlices.clear();
-  mThresholdInfo.clear();
+  for (auto& timeSlice : mTimeSliceStorage) {
+    resetTimeSlice(timeSlice);
+    mSetOfTimeSlices.emplace_back(&timeSlice);
+  }
 
   for (int iTimeSlice = 0; iTimeSlice <= 2 * mMaxClusterSizeTime; ++iTimeSlice) {
-    addTimeSlice(eventSector, iTimeSlice);
+    addTimeSlice(eventSector, iTimeSlice, *mSetOfTimeSlices[iTimeSlice]);
   }
 }
 
-void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int padInRow, float adcValue)
+void KrBoxClusterFinder::popFirstTimeSliceFromMap()
 {
-  auto& timeSlice = mSetOfTimeSlices.back();
-  auto& thresholdInfo = mThresholdInfo.back();
+  // the first time slice is cleared and reused as the last one
+  resetTimeSlice(*mSetOfTimeSlices.front());
+  std::rotate(mSetOfTimeSlices.begin(), mSetOfTimeSlices.begin() + 1, mSetOfTimeSlices.end());
+}
+
+void KrBoxClusterFinder::resetTimeSlice(TimeSlice& timeSlice)
+{
+  // only the filled charges need to be reset
+  for (const auto& [row, pad] : timeSlice.filled) {
+    timeSlice.charges[row][pad] = 0;
+  }
+  timeSlice.filled.clear();
+  timeSlice.thresholdInfo = ThresholdInfo{};
+}
+
+void KrBoxClusterFinder::fillADCValue(TimeSlice& timeSlice, int cru, int rowInSector, int padInRow, float adcValue)
+{
+  auto& thresholdInfo = timeSlice.thresholdInfo;
 
   // Correct for pad offset:
   const int padsInRow = mMapperInstance.getNumberOfPadsInRowSector(rowInSector);
@@ -61,11 +86,12 @@ void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int p
     thresholdInfo.digitAboveThreshold = true;
     thresholdInfo.rowAboveThreshold[rowInSector] = true;
   }
+  timeSlice.filled.emplace_back(rowInSector, corPad);
 
   // Get correction factor from gain map:
   const auto correctionFactorCalDet = mGainMap.get();
   if (!correctionFactorCalDet) {
-    timeSlice[rowInSector][corPad] = adcValue;
+    timeSlice.charges[rowInSector][corPad] = adcValue;
     return;
   }
 
@@ -80,14 +106,11 @@ void KrBoxClusterFinder::fillADCValueInLastSlice(int cru, int rowInSector, int p
     adcValue /= correctionFactor;
   }
 
-  timeSlice[rowInSector][corPad] = adcValue;
+  timeSlice.charges[rowInSector][corPad] = adcValue;
 }
 
-void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice)
+void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector, const int timeSlice, TimeSlice& target)
 {
-  mSetOfTimeSlices.emplace_back();
-  mThresholdInfo.emplace_back();
-
   for (; mFirstDigit < eventSector.size(); ++mFirstDigit) {
     const auto& digit = eventSector[mFirstDigit];
     const int time = digit.getTimeStamp();
@@ -102,7 +125,7 @@ void KrBoxClusterFinder::addTimeSlice(const gsl::span<const Digit> eventSector,
     const int padInRow = digit.getPad();
     const float adcValue = digit.getChargeFloat();
 
-    fillADCValueInLastSlice(cru, rowInSector, padInRow, adcValue);
+    fillADCValue(target, cru, rowInSector, padInRow, adcValue);
   }
 }
 
@@ -114,11 +137,11 @@ void KrBoxClusterFinder::loopOverSector(const gsl::span<const Digit> eventSector
   createInitialMap(eventSector);
   for (int iTimeSlice = mMaxClusterSizeTime; iTimeSlice < mMaxTimes - mMaxClusterSizeTime; ++iTimeSlice) {
     // only search for a local maximum if the central time slice has at least one ADC above the charge threshold
-    if (mThresholdInfo[mMaxClusterSizeTime].digitAboveThreshold) {
+    if (mSetOfTimeSlices[mMaxClusterSizeTime]->thresholdInfo.digitAboveThreshold) {
       findLocalMaxima(true, iTimeSlice);
     }
     popFirstTimeSliceFromMap();
-    addTimeSlice(eventSector, iTimeSlice + mMaxClusterSizeTime + 1);
+    addTimeSlice(eventSector, iTimeSlice + mMaxClusterSizeTime + 1, *mSetOfTimeSlices.back());
 
     // don't spend unnecessary time looping till mMaxTimes if there is no more data
     if (mFirstDigit >= eventSector.size()) {
@@ -235,8 +258,8 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
   std::vector<std::tuple<int, int, int>> localMaximaCoords;
 
   const int iTime = mMaxClusterSizeTime;
-  const auto& mapRow = mSetOfTimeSlices[iTime];
-  const auto& thresholdInfo = mThresholdInfo[iTime];
+  const auto& mapRow = getTimeSlice(iTime);
+  const auto& thresholdInfo = mSetOfTimeSlices[iTime]->thresholdInfo;
 
   for (int iRow = 0; iRow < MaxRows; iRow++) { // mapRow.size()
     // Since pad size is different for each ROC, we take this into account while looking for maxima:
@@ -289,29 +312,29 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
         noNeighbours++;
       }
 
-      if ((iRow + 1 < MaxRows) && (mSetOfTimeSlices[iTime][iRow + 1][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime][iRow + 1][iPad] > qMax) {
+      if ((iRow + 1 < MaxRows) && (getTimeSlice(iTime)[iRow + 1][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime)[iRow + 1][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iRow - 1 >= 0) && (mSetOfTimeSlices[iTime][iRow - 1][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime][iRow - 1][iPad] > qMax) {
+      if ((iRow - 1 >= 0) && (getTimeSlice(iTime)[iRow - 1][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime)[iRow - 1][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iTime + 1 < mMaxTimes) && (mSetOfTimeSlices[iTime + 1][iRow][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime + 1][iRow][iPad] > qMax) {
+      if ((iTime + 1 < mMaxTimes) && (getTimeSlice(iTime + 1)[iRow][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime + 1)[iRow][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
       }
 
-      if ((iTime - 1 >= 0) && (mSetOfTimeSlices[iTime - 1][iRow][iPad] > mQThreshold)) {
-        if (mSetOfTimeSlices[iTime - 1][iRow][iPad] > qMax) {
+      if ((iTime - 1 >= 0) && (getTimeSlice(iTime - 1)[iRow][iPad] > mQThreshold)) {
+        if (getTimeSlice(iTime - 1)[iRow][iPad] > qMax) {
           continue;
         }
         noNeighbours++;
@@ -339,7 +362,7 @@ std::vector<std::tuple<int, int, int>> KrBoxClusterFinder::findLocalMaxima(bool
             if ((iPad + i >= MaxPads) || (iPad + i < 0)) {
               continue;
             }
-            if (mSetOfTimeSlices[iTime + j][iRow + k][iPad + i] > qMax) {
+            if (getTimeSlice(iTime + j)[iRow + k][iPad + i] > qMax) {
               thisIsMax = false;
             }
           }
@@ -428,42 +451,42 @@ KrCluster KrBoxClusterFinder::buildCluster(int clusterCenterPad, int clusterCent
 
         // Second: Check if charge is above threshold
         // Might be not necessary since we deal with pedestal subtracted data
-        if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad] <= mQThreshold) {
+        if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad] <= mQThreshold) {
           continue;
         }
         // If not, there are several cases which were explained (for 2D) in the header of the code.
         // The first one is for the diagonal. So, the digit we are investigating here is on the diagonal:
         if (std::abs(iTime) == std::abs(iPad) && std::abs(iTime) == std::abs(iRow)) {
           // Now we check, if the next inner digit has a signal above threshold:
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
             // If yes, the cluster gets updated with the digit on the diagonal.
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
         // Basically, we go through every possible case in the next few if-else conditions:
         else if (std::abs(iTime) == std::abs(iPad)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) == std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iPad) == std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) > std::abs(iPad) && std::abs(iTime) > std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime - signnum(iTime)][clusterCenterRow + iRow][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime - signnum(iTime))[clusterCenterRow + iRow][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iPad) && std::abs(iPad) > std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad - signnum(iPad)] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         } else if (std::abs(iTime) < std::abs(iRow) && std::abs(iPad) < std::abs(iRow)) {
-          if (mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
-            updateTempCluster(mSetOfTimeSlices[clusterCenterTime + iTime][clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
+          if (getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow - signnum(iRow)][clusterCenterPad + iPad] > mQThreshold) {
+            updateTempCluster(getTimeSlice(clusterCenterTime + iTime)[clusterCenterRow + iRow][clusterCenterPad + iPad], clusterCenterPad + iPad, clusterCenterRow + iRow, clusterCenterTime + iTime);
           }
         }
       }
@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include <array>
+#include <bit>
 #include <chrono>
 #include <fmt/format.h>
 #include <fmt/chrono.h>
@@ -151,26 +152,34 @@ bool raw_processing_helpers::processZSdata(const char* data, size_t size, rdh_ut
       fecInPartition = header.fecInPartition;
     }
 
+    // unpack all ADC values of the time bin at once
+    std::array<float, zerosupp_link_based::ContainerZS::ChannelsPerWord * 8> adcValues;
+    for (uint32_t iword = 0; iword < std::min(numberOfWords, 8u); ++iword) {
+      zsdata->cont.data[iword].getADCValuesFloat(adcValues.data() + iword * zerosupp_link_based::ContainerZS::ChannelsPerWord);
+    }
+
+    // loop only over the channels with data
     std::size_t processedChannels = 0;
-    for (std::size_t ichannel = 0; ichannel < channelBits.size(); ++ichannel) {
-      if (!channelBits[ichannel]) {
-        continue;
-      }
+    const uint64_t channelMasks[2] = {header.bitMaskLow, header.bitMaskHigh};
+    for (int imask = 0; imask < 2; ++imask) {
+      for (auto mask = channelMasks[imask]; mask; mask &= mask - 1) {
+        const std::size_t ichannel = imask * 64 + std::countr_zero(mask);
 
-      // adc value
-      const auto adcValue = zsdata->getADCValueFloat(processedChannels);
+        // adc value
+        const auto adcValue = adcValues[processedChannels];
 
-      // mapping to row, pad sector
-      int sampaOnFEC{}, channelOnSAMPA{};
-      Mapper::getSampaAndChannelOnFEC(cruID, ichannel, sampaOnFEC, channelOnSAMPA);
-      const auto padSecPos = mapper.padSecPos(cru, fecInPartition, sampaOnFEC, channelOnSAMPA);
-      const auto& padPos = padSecPos.getPadPos();
+        // mapping to row, pad sector
+        int sampaOnFEC{}, channelOnSAMPA{};
+        Mapper::getSampaAndChannelOnFEC(cruID, ichannel, sampaOnFEC, channelOnSAMPA);
+        const auto padSecPos = mapper.padSecPos(cru, fecInPartition, sampaOnFEC, channelOnSAMPA);
+        const auto& padPos = padSecPos.getPadPos();
 
-      // add digit using callback
-      fillADC(int(cruID), int(padPos.getRow()), int(padPos.getPad()), timebin, adcValue);
+        // add digit using callback
+        fillADC(int(cruID), int(padPos.getRow()), int(padPos.getPad()), timebin, adcValue);
 
-      ++processedChannels;
-      hasData = true;
+        ++processedChannels;
+        hasData = true;
+      }
     }
 
     // go to next time bin
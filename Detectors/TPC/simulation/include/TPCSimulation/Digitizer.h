@@ -21,6 +21,7 @@
 #include "TPCBase/Mapper.h"
 
 #include <cmath>
+#include <memory>
 
 class TTree;
 class TH3;
@@ -141,10 +142,15 @@ class Digitizer
   /// in case of scaled distortions, the distortions can be recalculated to ensure consistent distortions and corrections
   void recalculateDistortions();
 
+  /// Take over the settings of another digitizer, e.g. for digitizing several sectors in parallel threads
+  /// The distortion objects are shared with the other digitizer and only read during the digitization
+  /// \param other digitizer from which the settings are taken
+  void copySettings(const Digitizer& other);
+
  private:
   DigitContainer mDigitContainer;      ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;    ///< Handler of full distortions (static + IR dependant)
-  std::unique_ptr<SC> mSpaceChargeDer; ///< Handler of reference static distortions
+  std::shared_ptr<SC> mSpaceCharge;    ///<! Handler of full distortions (static + IR dependant), shared with the digitizers of other sectors
+  std::shared_ptr<SC> mSpaceChargeDer; ///<! Handler of reference static distortions, shared with the digitizers of other sectors
   Sector mSector = -1;                 ///< ID of the currently processed sector
   double mEventTime = 0.f;             ///< Time of the currently processed event
   double mOutputDigitTimeOffset = 0;   ///< Time of the first IR sampled in the digitizer
@@ -155,7 +161,7 @@ class Digitizer
   int mDistortionScaleType = 0;        ///< type=0: no scaling of distortions, type=1 distortions without any scaling, type=2 distortions scaling with lumi
   float mLumiScaleFactor = 0;          ///< value used to scale the derivative map
   bool mUseScaledDistortions = false;  ///< whether the distortions are already scaled
-  ClassDefNV(Digitizer, 3);
+  ClassDefNV(Digitizer, 4);
 };
 } // namespace tpc
 } // namespace o2
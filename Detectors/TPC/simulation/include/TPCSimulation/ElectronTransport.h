@@ -22,6 +22,8 @@
 #include "TPCBase/Mapper.h"
 #include "MathUtils/RandomRing.h"
 
+#include <memory>
+
 namespace o2
 {
 namespace tpc
@@ -37,10 +39,23 @@ class ElectronTransport
  public:
   static ElectronTransport& instance()
   {
+    if (sThreadInstance) {
+      return *sThreadInstance;
+    }
     static ElectronTransport electronTransport;
     return electronTransport;
   }
 
+  /// Create a copy of the instance, e.g. for the worker threads of the digitization
+  /// The copy reads the random rings from a different position, which is defined by the ID of the copy
+  /// \param copyID ID of the copy
+  /// \return copy of the instance
+  static std::unique_ptr<ElectronTransport> createCopy(int copyID);
+
+  /// Set the instance which is returned by instance() in the calling thread
+  /// \param threadInstance instance to be used in the calling thread, the default instance is used for nullptr
+  static void setThreadInstance(ElectronTransport* threadInstance) { sThreadInstance = threadInstance; }
+
   /// Destructor
   ~ElectronTransport() = default;
 
@@ -53,6 +68,14 @@ class ElectronTransport
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion
   GlobalPosition3D getElectronDrift(GlobalPosition3D posEle, float& driftTime);
 
+  /// Drift of a batch of electrons starting at the same position in electric field taking into account diffusion
+  /// The random numbers are taken in blocks and the loops over the electrons can be vectorized by the compiler
+  /// \param posEle GlobalPosition3D with start position of the electrons
+  /// \param nElectrons Number of electrons
+  /// \param x, y, z Arrays of size nElectrons which are filled with the positions of the electrons after the drift
+  /// \param driftTime Array of size nElectrons which is filled with the drift times of the electrons
+  void getElectronDrift(GlobalPosition3D posEle, int nElectrons, float* x, float* y, float* z, float* driftTime);
+
   /// Drift of electrons in electric field taking into account diffusion with 3 sigma of the width
   /// \param posEle GlobalPosition3D with start position of the electrons
   /// \return GlobalPosition3D with position of the electrons after the drift taking into account diffusion with
@@ -64,6 +87,12 @@ class ElectronTransport
   /// \return Boolean whether the electron is attached (and lost) or not
   bool isElectronAttachment(float driftTime);
 
+  /// Attachment of a batch of electrons
+  /// \param nElectrons Number of electrons
+  /// \param driftTime Array with the drift times of the electrons
+  /// \param attached Array of size nElectrons which is filled with the attachment of the electrons (and lost)
+  void getElectronAttachment(int nElectrons, const float* driftTime, bool* attached);
+
   /// Compute electron drift time from z position
   /// \param zPos z position of the charge
   /// \param signChange If the zPosition of the charge is shifted to the other TPC side, the drift length needs to be
@@ -82,6 +111,8 @@ class ElectronTransport
   const ParameterDetector* mDetParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam;      ///< Caching of the parameter class to avoid multiple CDB calls
   float mVDrift = 0;                  ///< VDrift for current timestamp
+
+  inline static thread_local ElectronTransport* sThreadInstance = nullptr; ///< Instance used in the calling thread
 };
 
 inline bool ElectronTransport::isElectronAttachment(float driftTime)
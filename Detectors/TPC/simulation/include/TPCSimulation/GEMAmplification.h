@@ -23,6 +23,8 @@
 #include "TPCBase/PadPos.h"
 #include "TPCBase/CalDet.h"
 
+#include <memory>
+
 namespace o2
 {
 namespace tpc
@@ -39,10 +41,23 @@ class GEMAmplification
   /// Default constructor
   static GEMAmplification& instance()
   {
+    if (sThreadInstance) {
+      return *sThreadInstance;
+    }
     static GEMAmplification gemAmplification;
     return gemAmplification;
   }
 
+  /// Create a copy of the instance, e.g. for the worker threads of the digitization
+  /// The copy reads the random rings from a different position, which is defined by the ID of the copy
+  /// \param copyID ID of the copy
+  /// \return copy of the instance
+  static std::unique_ptr<GEMAmplification> createCopy(int copyID);
+
+  /// Set the instance which is returned by instance() in the calling thread
+  /// \param threadInstance instance to be used in the calling thread, the default instance is used for nullptr
+  static void setThreadInstance(GEMAmplification* threadInstance) { sThreadInstance = threadInstance; }
+
   /// Destructor
   ~GEMAmplification() = default;
 
@@ -105,6 +120,8 @@ class GEMAmplification
   const ParameterGEM* mGEMParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const ParameterGas* mGasParam; ///< Caching of the parameter class to avoid multiple CDB calls
   const CalPad* mGainMap;        ///< Caching of the parameter class to avoid multiple CDB calls
+
+  inline static thread_local GEMAmplification* sThreadInstance = nullptr; ///< Instance used in the calling thread
 };
 
 inline int GEMAmplification::getStackAmplification(const CRU& cru, const PadPos& pos, const AmplificationMode mode, int nElectrons)
@@ -28,6 +28,8 @@
 
 #include "TSpline.h"
 
+#include <memory>
+
 namespace o2
 {
 namespace tpc
@@ -42,9 +44,22 @@ class SAMPAProcessing
  public:
   static SAMPAProcessing& instance()
   {
+    if (sThreadInstance) {
+      return *sThreadInstance;
+    }
     static SAMPAProcessing sampaProcessing;
     return sampaProcessing;
   }
+
+  /// Create a copy of the instance, e.g. for the worker threads of the digitization
+  /// The copy reads the random rings from a different position, which is defined by the ID of the copy
+  /// \param copyID ID of the copy
+  /// \return copy of the instance
+  static std::unique_ptr<SAMPAProcessing> createCopy(int copyID);
+
+  /// Set the instance which is returned by instance() in the calling thread
+  /// \param threadInstance instance to be used in the calling thread, the default instance is used for nullptr
+  static void setThreadInstance(SAMPAProcessing* threadInstance) { sThreadInstance = threadInstance; }
   /// Destructor
   ~SAMPAProcessing() = default;
 
@@ -144,6 +159,8 @@ class SAMPAProcessing
   const CalPad* mZeroSuppression;            ///< Caching of the parameter class to avoid multiple CDB calls
   math_utils::RandomRing<> mRandomNoiseRing; ///< Ring with random number for noise
   float mVDrift = 0;                         ///< VDrift for current timestamp
+
+  inline static thread_local SAMPAProcessing* sThreadInstance = nullptr; ///< Instance used in the calling thread
 };
 
 template <typename T>
@@ -44,6 +44,8 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   static const int maxTimeBinForTimeFrame = o2::conf::DigiParams::Instance().maxOrbitsToDigitize != -1 ? ((o2::conf::DigiParams::Instance().maxOrbitsToDigitize * 3564 + 2 * 8 - 2) / 8) : -1;
 
   auto& cdb = CDBInterface::instance();
+  // containers of different sectors might be filled in parallel threads
+  std::unique_lock<std::mutex> cdbLock(cdb.getMutex());
 
   // ion tail per pad parameters
   const CalPad* padParams[3] = {nullptr, nullptr, nullptr};
@@ -71,7 +73,10 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   // dead channel map
   const CalDet<bool>* deadMap = {nullptr};
   if (eleParam.applyDeadMap) {
-    deadMap = &cdb.getDeadChannelMap();
+    // the map is recreated by each call, a copy is used outside of the lock
+    static thread_local CalDet<bool> deadMapCopy;
+    deadMapCopy = cdb.getDeadChannelMap();
+    deadMap = &deadMapCopy;
   }
 
   static bool reportedSettings = false;
@@ -82,6 +87,7 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     }
     reportedSettings = true;
   }
+  cdbLock.unlock();
 
   for (auto& time : mTimeBins) {
     /// the time bins between the last event and the timing of this event are uncorrelated and can be written out
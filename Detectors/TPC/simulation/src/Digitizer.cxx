@@ -30,6 +30,9 @@
 #include "TPCCalibration/CorrMapParam.h"
 
 #include <fairlogger/Logger.h>
+#include <algorithm>
+#include <array>
+#include <mutex>
 
 ClassImp(o2::tpc::Digitizer);
 
@@ -41,6 +44,8 @@ Digitizer::Digitizer() = default;
 
 void Digitizer::init()
 {
+  // digitizers of different sectors might be initialized in parallel threads
+  std::lock_guard<std::mutex> lock(CDBInterface::instance().getMutex());
   auto& gemAmplification = GEMAmplification::instance();
   gemAmplification.updateParameters();
   auto& electronTransport = ElectronTransport::instance();
@@ -63,7 +68,7 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray;
   signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
@@ -72,8 +77,14 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
   /// obtain max drift_time + hitTime which can be processed
   float maxEleTime = (int(mDigitContainer.size()) - nShapedPoints) * eleParam.ZbinWidth;
 
+  /// buffers for the batched processing of the electrons of a hit
+  constexpr int ElectronBatchSize = 256;
+  std::array<float, ElectronBatchSize> eleX, eleY, eleZ, eleDriftTime;
+  std::array<bool, ElectronBatchSize> eleAttached;
+
   for (auto& hitGroup : hits) {
     const int MCTrackID = hitGroup.GetTrackID();
+    const MCCompLabel label(MCTrackID, eventID, sourceID, false);
     for (size_t hitindex = 0; hitindex < hitGroup.getSize(); ++hitindex) {
       const auto& eh = hitGroup.getHit(hitindex);
 
@@ -95,64 +106,68 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
       /// The energy loss stored corresponds to nElectrons
       const int nPrimaryElectrons = static_cast<int>(eh.GetEnergyLoss());
       const float hitTime = eh.GetTime() * 0.001; /// in us
-      float driftTime = 0.f;
 
       /// TODO: add primary ions to space-charge density
 
-      /// Loop over electrons
-      for (int iEle = 0; iEle < nPrimaryElectrons; ++iEle) {
-
-        /// Drift and Diffusion
-        const GlobalPosition3D posEleDiff = electronTransport.getElectronDrift(posEle, driftTime);
-        const float eleTime = driftTime + hitTime; /// in us
-        if (eleTime >= maxEleTime) {
-          // LOG(warning) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
-          continue;
-        }
-        const float absoluteTime = eleTime + mTDriftOffset + (mEventTime - mOutputDigitTimeOffset); /// in us
-
-        /// Attachment
-        if (electronTransport.isElectronAttachment(driftTime)) {
-          continue;
-        }
-
-        /// Remove electrons that end up outside the active volume
-        if (std::abs(posEleDiff.Z()) > detParam.TPClength) {
-          continue;
-        }
-
-        /// When the electron is not in the sector we're processing, abandon
-        if (mapper.isOutOfSector(posEleDiff, mSector)) {
-          continue;
-        }
-
-        /// Compute digit position and check for validity
-        const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
-        if (!digiPadPos.isValid()) {
-          continue;
+      /// Loop over electrons, drift, diffusion and attachment are computed for batches of electrons
+      for (int firstEle = 0; firstEle < nPrimaryElectrons; firstEle += ElectronBatchSize) {
+        const int nEle = std::min(ElectronBatchSize, nPrimaryElectrons - firstEle);
+        electronTransport.getElectronDrift(posEle, nEle, eleX.data(), eleY.data(), eleZ.data(), eleDriftTime.data());
+        electronTransport.getElectronAttachment(nEle, eleDriftTime.data(), eleAttached.data());
+
+        for (int iEle = 0; iEle < nEle; ++iEle) {
+          const float driftTime = eleDriftTime[iEle];
+          const float eleTime = driftTime + hitTime; /// in us
+          if (eleTime >= maxEleTime) {
+            // LOG(warning) << "Skipping electron with driftTime " << driftTime << " from hit at time " << hitTime;
+            continue;
+          }
+          const float absoluteTime = eleTime + mTDriftOffset + (mEventTime - mOutputDigitTimeOffset); /// in us
+
+          /// Attachment
+          if (eleAttached[iEle]) {
+            continue;
+          }
+
+          /// Remove electrons that end up outside the active volume
+          if (std::abs(eleZ[iEle]) > detParam.TPClength) {
+            continue;
+          }
+
+          const GlobalPosition3D posEleDiff(eleX[iEle], eleY[iEle], eleZ[iEle]);
+
+          /// When the electron is not in the sector we're processing, abandon
+          if (mapper.isOutOfSector(posEleDiff, mSector)) {
+            continue;
+          }
+
+          /// Compute digit position and check for validity
+          const DigitPos digiPadPos = mapper.findDigitPosFromGlobalPosition(posEleDiff, mSector);
+          if (!digiPadPos.isValid()) {
+            continue;
+          }
+
+          /// Remove digits the end up outside the currently produced sector
+          if (digiPadPos.getCRU().sector() != mSector) {
+            continue;
+          }
+
+          /// Electron amplification
+          const int nElectronsGEM = gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
+          if (nElectronsGEM == 0) {
+            continue;
+          }
+
+          const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
+          const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
+          sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
+          for (float i = 0; i < nShapedPoints; ++i) {
+            const float time = absoluteTime + i * eleParam.ZbinWidth;
+            mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
+                                     signalArray[i]);
+          }
+          /// TODO: add ion backflow to space-charge density
         }
-
-        /// Remove digits the end up outside the currently produced sector
-        if (digiPadPos.getCRU().sector() != mSector) {
-          continue;
-        }
-
-        /// Electron amplification
-        const int nElectronsGEM = gemAmplification.getStackAmplification(digiPadPos.getCRU(), digiPadPos.getPadPos(), amplificationMode);
-        if (nElectronsGEM == 0) {
-          continue;
-        }
-
-        const GlobalPadNumber globalPad = mapper.globalPadNumber(digiPadPos.getGlobalPadPos());
-        const float ADCsignal = sampaProcessing.getADCvalue(static_cast<float>(nElectronsGEM));
-        const MCCompLabel label(MCTrackID, eventID, sourceID, false);
-        sampaProcessing.getShapedSignal(ADCsignal, absoluteTime, signalArray);
-        for (float i = 0; i < nShapedPoints; ++i) {
-          const float time = absoluteTime + i * eleParam.ZbinWidth;
-          mDigitContainer.addDigit(label, digiPadPos.getCRU(), sampaProcessing.getTimeBinFromTime(time), globalPad,
-                                   signalArray[i]);
-        }
-        /// TODO: add ion backflow to space-charge density
       }
       /// end of loop over electrons
     }
@@ -238,6 +253,19 @@ void Digitizer::setMeanLumiDistortionsDerivative(float meanLumi)
   mSpaceChargeDer->setMeanLumi(meanLumi);
 }
 
+void Digitizer::copySettings(const Digitizer& other)
+{
+  mSpaceCharge = other.mSpaceCharge;
+  mSpaceChargeDer = other.mSpaceChargeDer;
+  mVDrift = other.mVDrift;
+  mTDriftOffset = other.mTDriftOffset;
+  mIsContinuous = other.mIsContinuous;
+  mUseSCDistortions = other.mUseSCDistortions;
+  mDistortionScaleType = other.mDistortionScaleType;
+  mLumiScaleFactor = other.mLumiScaleFactor;
+  mUseScaledDistortions = other.mUseScaledDistortions;
+}
+
 void Digitizer::recalculateDistortions()
 {
   if (!mSpaceCharge || !mSpaceChargeDer) {
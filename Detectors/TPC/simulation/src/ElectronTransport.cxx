@@ -16,6 +16,7 @@
 #include "TPCSimulation/ElectronTransport.h"
 #include "TPCBase/CDBInterface.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace o2::tpc;
@@ -26,6 +27,16 @@ ElectronTransport::ElectronTransport() : mRandomGaus(), mRandomFlat(RandomRing<>
   updateParameters();
 }
 
+std::unique_ptr<ElectronTransport> ElectronTransport::createCopy(int copyID)
+{
+  std::unique_ptr<ElectronTransport> copy(new ElectronTransport(instance()));
+  // the copies start at positions shifted by a prime number of values w.r.t. the default instance
+  const size_t position = 104729 * size_t(copyID + 1);
+  copy->mRandomGaus.setRingPosition(copy->mRandomGaus.getRingPosition() + position);
+  copy->mRandomFlat.setRingPosition(copy->mRandomFlat.getRingPosition() + position);
+  return copy;
+}
+
 void ElectronTransport::updateParameters(float vdrift)
 {
   mGasParam = &(ParameterGas::Instance());
@@ -65,6 +76,52 @@ GlobalPosition3D ElectronTransport::getElectronDrift(GlobalPosition3D posEle, fl
   return posEleDiffusion;
 }
 
+void ElectronTransport::getElectronDrift(GlobalPosition3D posEle, int nElectrons, float* x, float* y, float* z, float* driftTime)
+{
+  /// For drift lengths shorter than 1 mm, the drift length is set to that value
+  float driftl = mDetParam->TPClength - std::abs(posEle.Z());
+  if (driftl < 0.01) {
+    driftl = 0.01;
+  }
+  driftl = std::sqrt(driftl);
+  const float sigT = driftl * mGasParam->DiffT;
+  const float sigL = driftl * mGasParam->DiffL;
+
+  mRandomGaus.getNextValues(x, nElectrons);
+  mRandomGaus.getNextValues(y, nElectrons);
+  mRandomGaus.getNextValues(z, nElectrons);
+
+  const float x0 = posEle.X(), y0 = posEle.Y(), z0 = posEle.Z();
+  const float length = mDetParam->TPClength;
+  const float vDrift = mVDrift;
+  for (int i = 0; i < nElectrons; ++i) {
+    x[i] = x[i] * sigT + x0;
+    y[i] = y[i] * sigT + y0;
+  }
+  for (int i = 0; i < nElectrons; ++i) {
+    const float zDiff = z[i] * sigL + z0;
+    /// If there is a sign change in the z position, the old z position of the hit is used and the drift time is
+    /// elongated accordingly, see getElectronDrift(GlobalPosition3D, float&)
+    const bool signChange = z0 * zDiff < 0.f;
+    driftTime[i] = (length - (signChange ? -1.f : 1.f) * std::abs(zDiff)) / vDrift;
+    z[i] = signChange ? z0 : zDiff;
+  }
+}
+
+void ElectronTransport::getElectronAttachment(int nElectrons, const float* driftTime, bool* attached)
+{
+  constexpr int BlockSize = 256;
+  float random[BlockSize];
+  const float attProb = mGasParam->AttCoeff * mGasParam->OxygenCont;
+  for (int first = 0; first < nElectrons; first += BlockSize) {
+    const int n = std::min(BlockSize, nElectrons - first);
+    mRandomFlat.getNextValues(random, n);
+    for (int i = 0; i < n; ++i) {
+      attached[first + i] = random[i] < attProb * driftTime[first + i];
+    }
+  }
+}
+
 bool ElectronTransport::isCompletelyOutOfSectorCoarseElectronDrift(GlobalPosition3D posEle, const Sector& sector) const
 {
   /// For drift lengths shorter than 1 mm, the drift length is set to that value
@@ -102,6 +102,16 @@ GEMAmplification::GEMAmplification()
   LOG(info) << "TPC: GEM setup (polya) took " << watch.CpuTime();
 }
 
+std::unique_ptr<GEMAmplification> GEMAmplification::createCopy(int copyID)
+{
+  std::unique_ptr<GEMAmplification> copy(new GEMAmplification(instance()));
+  const size_t position = 104729 * size_t(copyID + 1);
+  for (auto* ring : {&copy->mRandomGaus, &copy->mRandomFlat, &copy->mGain[0], &copy->mGain[1], &copy->mGain[2], &copy->mGain[3], &copy->mGainFullStack}) {
+    ring->setRingPosition(ring->getRingPosition() + position);
+  }
+  return copy;
+}
+
 void GEMAmplification::updateParameters()
 {
   auto& cdb = CDBInterface::instance();
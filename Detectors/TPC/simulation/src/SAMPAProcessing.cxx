@@ -29,6 +29,13 @@ SAMPAProcessing::SAMPAProcessing() : mRandomNoiseRing()
   updateParameters();
 }
 
+std::unique_ptr<SAMPAProcessing> SAMPAProcessing::createCopy(int copyID)
+{
+  std::unique_ptr<SAMPAProcessing> copy(new SAMPAProcessing(instance()));
+  copy->mRandomNoiseRing.setRingPosition(copy->mRandomNoiseRing.getRingPosition() + 104729 * size_t(copyID + 1));
+  return copy;
+}
+
 void SAMPAProcessing::updateParameters(float vdrift)
 {
   mGasParam = &(ParameterGas::Instance());
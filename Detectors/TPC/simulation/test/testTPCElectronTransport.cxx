@@ -22,6 +22,9 @@
 #include "TPCBase/ParameterDetector.h"
 #include "TPCBase/CDBInterface.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "TH1D.h"
 #include "TF1.h"
 
@@ -121,6 +124,55 @@ BOOST_AUTO_TEST_CASE(ElectronDiffusion_test2)
   BOOST_CHECK_CLOSE(gausZ.GetParameter(2), gasParam.DiffL, 0.5);
 }
 
+/// \brief Test of the batched getElectronDrift function
+/// The same as test 1, but the electrons are drifted in batches.
+/// In addition the drift times have to agree with the ones of the
+/// drifted z positions
+///
+/// Precision: 0.5 %.
+BOOST_AUTO_TEST_CASE(ElectronDiffusion_batch)
+{
+  auto& gasParam = ParameterGas::Instance();
+  auto& detParam = ParameterDetector::Instance();
+  const GlobalPosition3D posEle(10.f, 10.f, 10.f);
+  TH1D hTestDiffX("hTestDiffX", "", 500, posEle.X() - 10., posEle.X() + 10.);
+  TH1D hTestDiffY("hTestDiffY", "", 500, posEle.Y() - 10., posEle.Y() + 10.);
+  TH1D hTestDiffZ("hTestDiffZ", "", 500, posEle.Z() - 10., posEle.Z() + 10.);
+
+  TF1 gausX("gausX", "gaus");
+  TF1 gausY("gausY", "gaus");
+  TF1 gausZ("gausZ", "gaus");
+
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+  constexpr int nElectrons = 100;
+  float x[nElectrons], y[nElectrons], z[nElectrons], driftTime[nElectrons];
+
+  for (int i = 0; i < 5000; ++i) {
+    electronTransport.getElectronDrift(posEle, nElectrons, x, y, z, driftTime);
+    for (int iEle = 0; iEle < nElectrons; ++iEle) {
+      hTestDiffX.Fill(x[iEle]);
+      hTestDiffY.Fill(y[iEle]);
+      hTestDiffZ.Fill(z[iEle]);
+      BOOST_REQUIRE_CLOSE(driftTime[iEle], electronTransport.getDriftTime(z[iEle]), 1e-3);
+    }
+  }
+
+  hTestDiffX.Fit("gausX", "Q0");
+  hTestDiffY.Fit("gausY", "Q0");
+  hTestDiffZ.Fit("gausZ", "Q0");
+
+  BOOST_CHECK_CLOSE(gausX.GetParameter(1), posEle.X(), 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(1), posEle.Y(), 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(1), posEle.Z(), 0.5);
+
+  const float sigT = std::sqrt(detParam.TPClength - posEle.Z()) * gasParam.DiffT;
+  const float sigL = std::sqrt(detParam.TPClength - posEle.Z()) * gasParam.DiffL;
+
+  BOOST_CHECK_CLOSE(gausX.GetParameter(2), sigT, 0.5);
+  BOOST_CHECK_CLOSE(gausY.GetParameter(2), sigT, 0.5);
+  BOOST_CHECK_CLOSE(gausZ.GetParameter(2), sigL, 0.5);
+}
+
 /// \brief Test of the isElectronAttachment function
 /// We let the electrons drift for 100 us and compare the fraction
 /// of lost electrons to the expected value
@@ -143,5 +195,48 @@ BOOST_AUTO_TEST_CASE(ElectronAttatchment_test_1)
   BOOST_CHECK_CLOSE(lostElectrons / nEvents,
                     gasParam.AttCoeff * gasParam.OxygenCont * driftTime, 0.5);
 }
+
+/// \brief Test of the batched getElectronAttachment function
+///
+/// Precision: 0.5 %.
+BOOST_AUTO_TEST_CASE(ElectronAttatchment_batch)
+{
+  auto& gasParam = ParameterGas::Instance();
+  static ElectronTransport& electronTransport = ElectronTransport::instance();
+
+  constexpr int nElectrons = 1000;
+  std::vector<float> driftTime(nElectrons, 100.f);
+  bool attached[nElectrons];
+  float lostElectrons = 0;
+  const int nEvents = 1000;
+  for (int i = 0; i < nEvents; ++i) {
+    electronTransport.getElectronAttachment(nElectrons, driftTime.data(), attached);
+    lostElectrons += std::count(attached, attached + nElectrons, true);
+  }
+
+  BOOST_CHECK_CLOSE(lostElectrons / (nEvents * nElectrons),
+                    gasParam.AttCoeff * gasParam.OxygenCont * driftTime[0], 0.5);
+}
+
+/// \brief Test of the copies of ElectronTransport used in the worker threads of the digitization
+/// A copy set as thread instance is returned by instance() and draws other random numbers than the default instance
+BOOST_AUTO_TEST_CASE(ElectronTransport_threadInstance)
+{
+  auto& electronTransport = ElectronTransport::instance();
+  auto copy = ElectronTransport::createCopy(0);
+
+  ElectronTransport::setThreadInstance(copy.get());
+  BOOST_CHECK_EQUAL(&ElectronTransport::instance(), copy.get());
+  ElectronTransport::setThreadInstance(nullptr);
+  BOOST_CHECK_EQUAL(&ElectronTransport::instance(), &electronTransport);
+
+  constexpr int nElectrons = 100;
+  const GlobalPosition3D posEle(100.f, 10.f, 100.f);
+  float x[nElectrons], y[nElectrons], z[nElectrons], driftTime[nElectrons];
+  float xCopy[nElectrons], yCopy[nElectrons], zCopy[nElectrons], driftTimeCopy[nElectrons];
+  electronTransport.getElectronDrift(posEle, nElectrons, x, y, z, driftTime);
+  copy->getElectronDrift(posEle, nElectrons, xCopy, yCopy, zCopy, driftTimeCopy);
+  BOOST_CHECK(!std::equal(x, x + nElectrons, xCopy));
+}
 } // namespace tpc
 } // namespace o2
@@ -1330,9 +1330,8 @@ class SpaceCharge
   /// calculate distortions/corrections by interpolation of local distortions/corrections
   void processGlobalDistCorr(const DataT radius, const DataT phi, const DataT z0Tmp, [[maybe_unused]] const DataT z1Tmp, DataT& ddR, DataT& ddPhi, DataT& ddZ, const DistCorrInterpolator<DataT>& localDistCorr) const
   {
-    ddR = localDistCorr.evaldR(z0Tmp, radius, phi);
-    ddZ = localDistCorr.evaldZ(z0Tmp, radius, phi);
-    ddPhi = localDistCorr.evaldRPhi(z0Tmp, radius, phi) / radius;
+    localDistCorr.eval(z0Tmp, radius, phi, ddR, ddZ, ddPhi);
+    ddPhi /= radius;
   }
 
   /// dump the created electron tracks with calculateElectronDriftPath function to a tree
@@ -408,6 +408,22 @@ class DistCorrInterpolator
   /// \return returns the function value for the local distortion or correction dRPhi for given coordinate
   DataT evaldRPhi(const DataT z, const DataT r, const DataT phi) const { return interpolatorDistCorrdRPhi(z, r, phi); }
 
+  /// evaluate the local distortions or corrections dR, dZ, dRPhi for given coordinate at once: the position in the grid and the interpolation weights are shared
+  /// \param r r coordinate
+  /// \param phi phi coordinate
+  /// \param z z coordinate
+  /// \param dR returns the local distortion or correction dR
+  /// \param dZ returns the local distortion or correction dZ
+  /// \param dRPhi returns the local distortion or correction dRPhi
+  void eval(const DataT z, const DataT r, const DataT phi, DataT& dR, DataT& dZ, DataT& dRPhi) const
+  {
+    std::array<DataT, 3> values;
+    interpolatorDistCorrdR(z, r, phi, std::array<const DataContainer*, 3>{interpolatorDistCorrdR.getGridData(), interpolatorDistCorrdZ.getGridData(), interpolatorDistCorrdRPhi.getGridData()}, values);
+    dR = values[0];
+    dZ = values[1];
+    dRPhi = values[2];
+  }
+
   o2::tpc::Side getSide() const { return mSide; }
 
   static constexpr unsigned int getID() { return ID; }
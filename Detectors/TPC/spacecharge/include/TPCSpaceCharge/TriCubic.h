@@ -18,6 +18,7 @@
 #define ALICEO2_TPC_TRICUBIC_H_
 
 #include "TPCSpaceCharge/RegularGrid3D.h"
+#include <array>
 
 // forward declare VC Memory
 template <typename DataT, size_t, size_t, bool>
@@ -78,6 +79,23 @@ class TriCubicInterpolator
   /// \return returns the interpolated value at given coordinate
   DataT operator()(const DataT z, const DataT r, const DataT phi) const { return interpolateSparse(z, r, phi); }
 
+  /// interpolate the values of several data containers defined on the same grid as the data of this interpolator at given coordinate.
+  /// The position in the grid and the interpolation weights are computed only once for all containers.
+  /// \param z z coordinate
+  /// \param r r coordinate
+  /// \param phi phi coordinate
+  /// \param data data containers which will be interpolated
+  /// \param values returns the interpolated values for each data container
+  /// \tparam N number of data containers
+  template <size_t N>
+  void operator()(const DataT z, const DataT r, const DataT phi, const std::array<const DataContainer*, N>& data, std::array<DataT, N>& values) const
+  {
+    interpolateSparse(z, r, phi, data.data(), values.data(), N);
+  }
+
+  /// \return returns the data container of the grid which is interpolated
+  const DataContainer* getGridData() const { return mGridData; }
+
   /// set which type of extrapolation is used at the grid boundaries (linear or parabol can be used with periodic phi axis and non periodic z and r axis).
   /// \param extrapolationType sets type of extrapolation. See enum ExtrapolationType for different types
   void setExtrapolationType(const ExtrapolationType extrapolationType) { mExtrapolationType = extrapolationType; }
@@ -153,7 +171,7 @@ class TriCubicInterpolator
     SideZLeft = 25
   };
 
-  void setValues(const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const;
+  void setValues(const DataContainer& data, const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const;
 
   // interpolate value at given coordinate - this method doesnt compute and stores the coefficients and is faster when quering only a few values per cube
   /// \param z z coordinate
@@ -162,6 +180,15 @@ class TriCubicInterpolator
   /// \return returns the interpolated value at given coordinate
   DataT interpolateSparse(const DataT z, const DataT r, const DataT phi) const;
 
+  // interpolate the values of nData data containers defined on the same grid at given coordinate
+  /// \param z z coordinate
+  /// \param r r coordinate
+  /// \param phi phi coordinate
+  /// \param data data containers which will be interpolated
+  /// \param values returns the interpolated values
+  /// \param nData number of data containers
+  void interpolateSparse(const DataT z, const DataT r, const DataT phi, const DataContainer* const* data, DataT* values, const size_t nData) const;
+
   // for periodic boundary conditions
   void getDataIndexCircularArray(const int index0, const int dim, int arr[]) const;
 
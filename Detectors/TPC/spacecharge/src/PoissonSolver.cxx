@@ -1222,9 +1222,14 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
+    // within one pass only the points of one colour (parity of i+j+m) are updated and all their neighbours have the other colour,
+    // so the phi slices are independent and can be processed in parallel. Without phi symmetry and with an odd number of slices
+    // the periodic neighbours of the first and last slice have the same colour: keep the sequential order in this case
+    const bool parallelSlices = (symmetry != 0) || (iPhi % 2 == 0);
     // for each slice
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
+#pragma omp parallel for num_threads(sNThreads) if (parallelSlices)
       for (int m = 0; m < iPhi; ++m) {
         const int jsw = ((msw + m) % 2) ? 1 : 2;
         int mp1 = m + 1;
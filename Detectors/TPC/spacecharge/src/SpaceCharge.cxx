@@ -1676,9 +1676,7 @@ void SpaceCharge<DataT>::getElectricFieldsCyl(const DataT z, const DataT r, cons
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalCorrectionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& lcorrZ, DataT& lcorrR, DataT& lcorrRPhi) const
 {
-  lcorrZ = mInterpolatorLocalCorr[side].evaldZ(z, r, phi);
-  lcorrR = mInterpolatorLocalCorr[side].evaldR(z, r, phi);
-  lcorrRPhi = mInterpolatorLocalCorr[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalCorr[side].eval(z, r, phi, lcorrR, lcorrZ, lcorrRPhi);
 }
 
 template <typename DataT>
@@ -1697,9 +1695,7 @@ void SpaceCharge<DataT>::getLocalCorrectionsCyl(const std::vector<DataT>& z, con
 template <typename DataT>
 void SpaceCharge<DataT>::getCorrectionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& corrZ, DataT& corrR, DataT& corrRPhi) const
 {
-  corrZ = mInterpolatorGlobalCorr[side].evaldZ(z, r, phi);
-  corrR = mInterpolatorGlobalCorr[side].evaldR(z, r, phi);
-  corrRPhi = mInterpolatorGlobalCorr[side].evaldRPhi(z, r, phi);
+  mInterpolatorGlobalCorr[side].eval(z, r, phi, corrR, corrZ, corrRPhi);
 }
 
 template <typename DataT>
@@ -1741,9 +1737,7 @@ void SpaceCharge<DataT>::getCorrections(const DataT x, const DataT y, const Data
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalDistortionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& ldistZ, DataT& ldistR, DataT& ldistRPhi) const
 {
-  ldistZ = mInterpolatorLocalDist[side].evaldZ(z, r, phi);
-  ldistR = mInterpolatorLocalDist[side].evaldR(z, r, phi);
-  ldistRPhi = mInterpolatorLocalDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalDist[side].eval(z, r, phi, ldistR, ldistZ, ldistRPhi);
 }
 
 template <typename DataT>
@@ -1762,9 +1756,7 @@ void SpaceCharge<DataT>::getLocalDistortionsCyl(const std::vector<DataT>& z, con
 template <typename DataT>
 void SpaceCharge<DataT>::getLocalDistortionVectorCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& lvecdistZ, DataT& lvecdistR, DataT& lvecdistRPhi) const
 {
-  lvecdistZ = mInterpolatorLocalVecDist[side].evaldZ(z, r, phi);
-  lvecdistR = mInterpolatorLocalVecDist[side].evaldR(z, r, phi);
-  lvecdistRPhi = mInterpolatorLocalVecDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorLocalVecDist[side].eval(z, r, phi, lvecdistR, lvecdistZ, lvecdistRPhi);
 }
 
 template <typename DataT>
@@ -1804,9 +1796,7 @@ void SpaceCharge<DataT>::getLocalCorrectionVectorCyl(const std::vector<DataT>& z
 template <typename DataT>
 void SpaceCharge<DataT>::getDistortionsCyl(const DataT z, const DataT r, const DataT phi, const Side side, DataT& distZ, DataT& distR, DataT& distRPhi) const
 {
-  distZ = mInterpolatorGlobalDist[side].evaldZ(z, r, phi);
-  distR = mInterpolatorGlobalDist[side].evaldR(z, r, phi);
-  distRPhi = mInterpolatorGlobalDist[side].evaldRPhi(z, r, phi);
+  mInterpolatorGlobalDist[side].eval(z, r, phi, distR, distZ, distRPhi);
 }
 
 template <typename DataT>
@@ -75,10 +75,14 @@ DataT TriCubicInterpolator<DataT>::parabolExtrapolation(const DataT valk, const
 template <typename DataT>
 DataT TriCubicInterpolator<DataT>::interpolateSparse(const DataT z, const DataT r, const DataT phi) const
 {
-  // check if data is empty
-  if (!mGridData->getNDataPoints()) {
-    return 0;
-  }
+  DataT result{};
+  interpolateSparse(z, r, phi, &mGridData, &result, 1);
+  return result;
+}
+
+template <typename DataT>
+void TriCubicInterpolator<DataT>::interpolateSparse(const DataT z, const DataT r, const DataT phi, const DataContainer* const* data, DataT* values, const size_t nData) const
+{
   const Vector<DataT, FDim> coordinates{{z, r, phi}};                                                           // vector holding the coordinates
   Vector<DataT, FDim> posRel{(coordinates - mGridProperties->getGridMin()) * mGridProperties->getInvSpacing()}; // needed for the grid index
   posRel[FPHI] = mGridProperties->clampToGridCircularRel(posRel[FPHI], FPHI);
@@ -91,9 +95,7 @@ DataT TriCubicInterpolator<DataT>::interpolateSparse(const DataT z, const DataT
   }
 
   const int nPoints = 4;
-  std::array<Vector<DataT, nPoints>, 16> cVals;
   const Vector<DataT, FDim> index{floor_vec(posRel)};
-  setValues(index[FZ], index[FR], index[FPHI], cVals);
 
   const Vector<DataT, FDim> vals0{posRelN - index};
   const Vector<DataT, FDim> vals1{vals0 * vals0};
@@ -112,15 +114,27 @@ DataT TriCubicInterpolator<DataT>::interpolateSparse(const DataT z, const DataT
   const Vector<DataT, nPoints> vecValYMult{matrixA * vecValY};
   const Vector<DataT, nPoints> vecValZMult{matrixA * vecValZ};
 
-  DataT result{};
-  int ind = 0;
+  // the weights of the 4x4 rows of the stencil are the same for all data containers
+  std::array<DataT, 16> rowWeights;
   for (int slice = 0; slice < nPoints; ++slice) {
     const Vector<DataT, nPoints> vecA{vecValZMult[slice] * vecValYMult};
     for (int row = 0; row < nPoints; ++row) {
-      result += sum(vecA[row] * vecValXMult * cVals[ind++]);
+      rowWeights[slice * nPoints + row] = vecA[row];
     }
   }
-  return result;
+
+  std::array<Vector<DataT, nPoints>, 16> cVals;
+  for (size_t iData = 0; iData < nData; ++iData) {
+    DataT result{};
+    // check if data is empty
+    if (data[iData]->getNDataPoints()) {
+      setValues(*data[iData], index[FZ], index[FR], index[FPHI], cVals);
+      for (int ind = 0; ind < 16; ++ind) {
+        result += sum(rowWeights[ind] * vecValXMult * cVals[ind]);
+      }
+    }
+    values[iData] = result;
+  }
 }
 
 // for perdiodic boundary condition
@@ -309,11 +323,11 @@ bool TriCubicInterpolator<DataT>::isSideLeft(const int ind) const
 }
 
 template <typename DataT>
-void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const
+void TriCubicInterpolator<DataT>::setValues(const DataContainer& data, const int iz, const int ir, const int iphi, std::array<Vector<DataT, 4>, 16>& cVals) const
 {
   const GridPos location = findPos(iz, ir, iphi);
-  const int ii_x_y_z = mGridData->getDataIndex(iz, ir, iphi);
-  cVals[5][1] = (*mGridData)[ii_x_y_z];
+  const int ii_x_y_z = data.getDataIndex(iz, ir, iphi);
+  cVals[5][1] = data[ii_x_y_z];
 
   int deltaZ[3]{mGridProperties->getDeltaDataIndex(-1, 0), mGridProperties->getDeltaDataIndex(1, 0), mGridProperties->getDeltaDataIndex(2, 0)};
   int deltaR[3]{mGridProperties->getDeltaDataIndex(-1, 1), mGridProperties->getDeltaDataIndex(1, 1), mGridProperties->getDeltaDataIndex(2, 1)};
@@ -347,69 +361,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0], ind[3][2][2] - deltaZ[i0]},
          {ind[3][2][0] - deltaR[i0], ind[3][3][0] - deltaZ[i0], ind[3][3][1] - deltaZ[i0], ind[3][3][2] - deltaZ[i0]}}};
 
-      cVals[0][0] = (*mGridData)[ind[0][0][0]];
-      cVals[0][1] = (*mGridData)[ind[0][0][1]];
-      cVals[0][2] = (*mGridData)[ind[0][0][2]];
-      cVals[0][3] = (*mGridData)[ind[0][0][3]];
-      cVals[1][0] = (*mGridData)[ind[0][1][0]];
-      cVals[1][1] = (*mGridData)[ind[0][1][1]];
-      cVals[1][2] = (*mGridData)[ind[0][1][2]];
-      cVals[1][3] = (*mGridData)[ind[0][1][3]];
-      cVals[2][0] = (*mGridData)[ind[0][2][0]];
-      cVals[2][1] = (*mGridData)[ind[0][2][1]];
-      cVals[2][2] = (*mGridData)[ind[0][2][2]];
-      cVals[2][3] = (*mGridData)[ind[0][2][3]];
-      cVals[3][0] = (*mGridData)[ind[0][3][0]];
-      cVals[3][1] = (*mGridData)[ind[0][3][1]];
-      cVals[3][2] = (*mGridData)[ind[0][3][2]];
-      cVals[3][3] = (*mGridData)[ind[0][3][3]];
-      cVals[4][0] = (*mGridData)[ind[1][0][0]];
-      cVals[4][1] = (*mGridData)[ind[1][0][1]];
-      cVals[4][2] = (*mGridData)[ind[1][0][2]];
-      cVals[4][3] = (*mGridData)[ind[1][0][3]];
-      cVals[5][2] = (*mGridData)[ind[1][1][2]];
-      cVals[5][0] = (*mGridData)[ind[1][1][0]];
-      cVals[5][3] = (*mGridData)[ind[1][1][3]];
-      cVals[6][0] = (*mGridData)[ind[1][2][0]];
-      cVals[6][1] = (*mGridData)[ind[1][2][1]];
-      cVals[6][2] = (*mGridData)[ind[1][2][2]];
-      cVals[6][3] = (*mGridData)[ind[1][2][3]];
-      cVals[7][0] = (*mGridData)[ind[1][3][0]];
-      cVals[7][1] = (*mGridData)[ind[1][3][1]];
-      cVals[7][2] = (*mGridData)[ind[1][3][2]];
-      cVals[7][3] = (*mGridData)[ind[1][3][3]];
-      cVals[8][0] = (*mGridData)[ind[2][0][0]];
-      cVals[8][1] = (*mGridData)[ind[2][0][1]];
-      cVals[8][2] = (*mGridData)[ind[2][0][2]];
-      cVals[8][3] = (*mGridData)[ind[2][0][3]];
-      cVals[9][0] = (*mGridData)[ind[2][1][0]];
-      cVals[9][1] = (*mGridData)[ind[2][1][1]];
-      cVals[9][2] = (*mGridData)[ind[2][1][2]];
-      cVals[9][3] = (*mGridData)[ind[2][1][3]];
-      cVals[10][0] = (*mGridData)[ind[2][2][0]];
-      cVals[10][1] = (*mGridData)[ind[2][2][1]];
-      cVals[10][2] = (*mGridData)[ind[2][2][2]];
-      cVals[10][3] = (*mGridData)[ind[2][2][3]];
-      cVals[11][0] = (*mGridData)[ind[2][3][0]];
-      cVals[11][1] = (*mGridData)[ind[2][3][1]];
-      cVals[11][2] = (*mGridData)[ind[2][3][2]];
-      cVals[11][3] = (*mGridData)[ind[2][3][3]];
-      cVals[12][0] = (*mGridData)[ind[3][0][0]];
-      cVals[12][1] = (*mGridData)[ind[3][0][1]];
-      cVals[12][2] = (*mGridData)[ind[3][0][2]];
-      cVals[12][3] = (*mGridData)[ind[3][0][3]];
-      cVals[13][0] = (*mGridData)[ind[3][1][0]];
-      cVals[13][1] = (*mGridData)[ind[3][1][1]];
-      cVals[13][2] = (*mGridData)[ind[3][1][2]];
-      cVals[13][3] = (*mGridData)[ind[3][1][3]];
-      cVals[14][0] = (*mGridData)[ind[3][2][0]];
-      cVals[14][1] = (*mGridData)[ind[3][2][1]];
-      cVals[14][2] = (*mGridData)[ind[3][2][2]];
-      cVals[14][3] = (*mGridData)[ind[3][2][3]];
-      cVals[15][0] = (*mGridData)[ind[3][3][0]];
-      cVals[15][1] = (*mGridData)[ind[3][3][1]];
-      cVals[15][2] = (*mGridData)[ind[3][3][2]];
-      cVals[15][3] = (*mGridData)[ind[3][3][3]];
+      cVals[0][0] = data[ind[0][0][0]];
+      cVals[0][1] = data[ind[0][0][1]];
+      cVals[0][2] = data[ind[0][0][2]];
+      cVals[0][3] = data[ind[0][0][3]];
+      cVals[1][0] = data[ind[0][1][0]];
+      cVals[1][1] = data[ind[0][1][1]];
+      cVals[1][2] = data[ind[0][1][2]];
+      cVals[1][3] = data[ind[0][1][3]];
+      cVals[2][0] = data[ind[0][2][0]];
+      cVals[2][1] = data[ind[0][2][1]];
+      cVals[2][2] = data[ind[0][2][2]];
+      cVals[2][3] = data[ind[0][2][3]];
+      cVals[3][0] = data[ind[0][3][0]];
+      cVals[3][1] = data[ind[0][3][1]];
+      cVals[3][2] = data[ind[0][3][2]];
+      cVals[3][3] = data[ind[0][3][3]];
+      cVals[4][0] = data[ind[1][0][0]];
+      cVals[4][1] = data[ind[1][0][1]];
+      cVals[4][2] = data[ind[1][0][2]];
+      cVals[4][3] = data[ind[1][0][3]];
+      cVals[5][2] = data[ind[1][1][2]];
+      cVals[5][0] = data[ind[1][1][0]];
+      cVals[5][3] = data[ind[1][1][3]];
+      cVals[6][0] = data[ind[1][2][0]];
+      cVals[6][1] = data[ind[1][2][1]];
+      cVals[6][2] = data[ind[1][2][2]];
+      cVals[6][3] = data[ind[1][2][3]];
+      cVals[7][0] = data[ind[1][3][0]];
+      cVals[7][1] = data[ind[1][3][1]];
+      cVals[7][2] = data[ind[1][3][2]];
+      cVals[7][3] = data[ind[1][3][3]];
+      cVals[8][0] = data[ind[2][0][0]];
+      cVals[8][1] = data[ind[2][0][1]];
+      cVals[8][2] = data[ind[2][0][2]];
+      cVals[8][3] = data[ind[2][0][3]];
+      cVals[9][0] = data[ind[2][1][0]];
+      cVals[9][1] = data[ind[2][1][1]];
+      cVals[9][2] = data[ind[2][1][2]];
+      cVals[9][3] = data[ind[2][1][3]];
+      cVals[10][0] = data[ind[2][2][0]];
+      cVals[10][1] = data[ind[2][2][1]];
+      cVals[10][2] = data[ind[2][2][2]];
+      cVals[10][3] = data[ind[2][2][3]];
+      cVals[11][0] = data[ind[2][3][0]];
+      cVals[11][1] = data[ind[2][3][1]];
+      cVals[11][2] = data[ind[2][3][2]];
+      cVals[11][3] = data[ind[2][3][3]];
+      cVals[12][0] = data[ind[3][0][0]];
+      cVals[12][1] = data[ind[3][0][1]];
+      cVals[12][2] = data[ind[3][0][2]];
+      cVals[12][3] = data[ind[3][0][3]];
+      cVals[13][0] = data[ind[3][1][0]];
+      cVals[13][1] = data[ind[3][1][1]];
+      cVals[13][2] = data[ind[3][1][2]];
+      cVals[13][3] = data[ind[3][1][3]];
+      cVals[14][0] = data[ind[3][2][0]];
+      cVals[14][1] = data[ind[3][2][1]];
+      cVals[14][2] = data[ind[3][2][2]];
+      cVals[14][3] = data[ind[3][2][3]];
+      cVals[15][0] = data[ind[3][3][0]];
+      cVals[15][1] = data[ind[3][3][1]];
+      cVals[15][2] = data[ind[3][3][2]];
+      cVals[15][3] = data[ind[3][3][3]];
     } break;
 
     case GridPos::SideXRight:
@@ -433,69 +447,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]},
          {ind[3][2][0] - deltaR[i0], ind[3][3][0] - deltaZ[i0], ind[3][3][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = (*mGridData)[ind[0][0][0]];
-      cVals[0][1] = (*mGridData)[ind[0][0][1]];
-      cVals[0][2] = (*mGridData)[ind[0][0][2]];
-      cVals[0][3] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][0]]);
-      cVals[1][0] = (*mGridData)[ind[0][1][0]];
-      cVals[1][1] = (*mGridData)[ind[0][1][1]];
-      cVals[1][2] = (*mGridData)[ind[0][1][2]];
-      cVals[1][3] = extrapolation((*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][0]]);
-      cVals[2][0] = (*mGridData)[ind[0][2][0]];
-      cVals[2][1] = (*mGridData)[ind[0][2][1]];
-      cVals[2][2] = (*mGridData)[ind[0][2][2]];
-      cVals[2][3] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][2][0]]);
-      cVals[3][0] = (*mGridData)[ind[0][3][0]];
-      cVals[3][1] = (*mGridData)[ind[0][3][1]];
-      cVals[3][2] = (*mGridData)[ind[0][3][2]];
-      cVals[3][3] = extrapolation((*mGridData)[ind[0][3][2]], (*mGridData)[ind[0][3][1]], (*mGridData)[ind[0][3][0]]);
-      cVals[4][0] = (*mGridData)[ind[1][0][0]];
-      cVals[4][1] = (*mGridData)[ind[1][0][1]];
-      cVals[4][2] = (*mGridData)[ind[1][0][2]];
-      cVals[4][3] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][0]]);
-      cVals[5][0] = (*mGridData)[ind[1][1][0]];
-      cVals[5][2] = (*mGridData)[ind[1][1][2]];
-      cVals[5][3] = extrapolation((*mGridData)[ind[1][1][2]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][0]]);
-      cVals[6][0] = (*mGridData)[ind[1][2][0]];
-      cVals[6][1] = (*mGridData)[ind[1][2][1]];
-      cVals[6][2] = (*mGridData)[ind[1][2][2]];
-      cVals[6][3] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][2][0]]);
-      cVals[7][0] = (*mGridData)[ind[1][3][0]];
-      cVals[7][1] = (*mGridData)[ind[1][3][1]];
-      cVals[7][2] = (*mGridData)[ind[1][3][2]];
-      cVals[7][3] = extrapolation((*mGridData)[ind[1][3][2]], (*mGridData)[ind[1][3][1]], (*mGridData)[ind[1][3][0]]);
-      cVals[8][0] = (*mGridData)[ind[2][0][0]];
-      cVals[8][1] = (*mGridData)[ind[2][0][1]];
-      cVals[8][2] = (*mGridData)[ind[2][0][2]];
-      cVals[8][3] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][0]]);
-      cVals[9][0] = (*mGridData)[ind[2][1][0]];
-      cVals[9][1] = (*mGridData)[ind[2][1][1]];
-      cVals[9][2] = (*mGridData)[ind[2][1][2]];
-      cVals[9][3] = extrapolation((*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][0]]);
-      cVals[10][0] = (*mGridData)[ind[2][2][0]];
-      cVals[10][1] = (*mGridData)[ind[2][2][1]];
-      cVals[10][2] = (*mGridData)[ind[2][2][2]];
-      cVals[10][3] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][2][0]]);
-      cVals[11][0] = (*mGridData)[ind[2][3][0]];
-      cVals[11][1] = (*mGridData)[ind[2][3][1]];
-      cVals[11][2] = (*mGridData)[ind[2][3][2]];
-      cVals[11][3] = extrapolation((*mGridData)[ind[2][3][2]], (*mGridData)[ind[2][3][1]], (*mGridData)[ind[2][3][0]]);
-      cVals[12][0] = (*mGridData)[ind[3][0][0]];
-      cVals[12][1] = (*mGridData)[ind[3][0][1]];
-      cVals[12][2] = (*mGridData)[ind[3][0][2]];
-      cVals[13][0] = (*mGridData)[ind[3][1][0]];
-      cVals[12][3] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][0]]);
-      cVals[13][1] = (*mGridData)[ind[3][1][1]];
-      cVals[13][2] = (*mGridData)[ind[3][1][2]];
-      cVals[13][3] = extrapolation((*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][0]]);
-      cVals[14][0] = (*mGridData)[ind[3][2][0]];
-      cVals[14][1] = (*mGridData)[ind[3][2][1]];
-      cVals[14][2] = (*mGridData)[ind[3][2][2]];
-      cVals[14][3] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][2][0]]);
-      cVals[15][0] = (*mGridData)[ind[3][3][0]];
-      cVals[15][1] = (*mGridData)[ind[3][3][1]];
-      cVals[15][2] = (*mGridData)[ind[3][3][2]];
-      cVals[15][3] = extrapolation((*mGridData)[ind[3][3][2]], (*mGridData)[ind[3][3][1]], (*mGridData)[ind[3][3][0]]);
+      cVals[0][0] = data[ind[0][0][0]];
+      cVals[0][1] = data[ind[0][0][1]];
+      cVals[0][2] = data[ind[0][0][2]];
+      cVals[0][3] = extrapolation(data[ind[0][0][2]], data[ind[0][0][1]], data[ind[0][0][0]]);
+      cVals[1][0] = data[ind[0][1][0]];
+      cVals[1][1] = data[ind[0][1][1]];
+      cVals[1][2] = data[ind[0][1][2]];
+      cVals[1][3] = extrapolation(data[ind[0][1][2]], data[ind[0][1][1]], data[ind[0][1][0]]);
+      cVals[2][0] = data[ind[0][2][0]];
+      cVals[2][1] = data[ind[0][2][1]];
+      cVals[2][2] = data[ind[0][2][2]];
+      cVals[2][3] = extrapolation(data[ind[0][2][2]], data[ind[0][2][1]], data[ind[0][2][0]]);
+      cVals[3][0] = data[ind[0][3][0]];
+      cVals[3][1] = data[ind[0][3][1]];
+      cVals[3][2] = data[ind[0][3][2]];
+      cVals[3][3] = extrapolation(data[ind[0][3][2]], data[ind[0][3][1]], data[ind[0][3][0]]);
+      cVals[4][0] = data[ind[1][0][0]];
+      cVals[4][1] = data[ind[1][0][1]];
+      cVals[4][2] = data[ind[1][0][2]];
+      cVals[4][3] = extrapolation(data[ind[1][0][2]], data[ind[1][0][1]], data[ind[1][0][0]]);
+      cVals[5][0] = data[ind[1][1][0]];
+      cVals[5][2] = data[ind[1][1][2]];
+      cVals[5][3] = extrapolation(data[ind[1][1][2]], data[ii_x_y_z], data[ind[1][1][0]]);
+      cVals[6][0] = data[ind[1][2][0]];
+      cVals[6][1] = data[ind[1][2][1]];
+      cVals[6][2] = data[ind[1][2][2]];
+      cVals[6][3] = extrapolation(data[ind[1][2][2]], data[ind[1][2][1]], data[ind[1][2][0]]);
+      cVals[7][0] = data[ind[1][3][0]];
+      cVals[7][1] = data[ind[1][3][1]];
+      cVals[7][2] = data[ind[1][3][2]];
+      cVals[7][3] = extrapolation(data[ind[1][3][2]], data[ind[1][3][1]], data[ind[1][3][0]]);
+      cVals[8][0] = data[ind[2][0][0]];
+      cVals[8][1] = data[ind[2][0][1]];
+      cVals[8][2] = data[ind[2][0][2]];
+      cVals[8][3] = extrapolation(data[ind[2][0][2]], data[ind[2][0][1]], data[ind[2][0][0]]);
+      cVals[9][0] = data[ind[2][1][0]];
+      cVals[9][1] = data[ind[2][1][1]];
+      cVals[9][2] = data[ind[2][1][2]];
+      cVals[9][3] = extrapolation(data[ind[2][1][2]], data[ind[2][1][1]], data[ind[2][1][0]]);
+      cVals[10][0] = data[ind[2][2][0]];
+      cVals[10][1] = data[ind[2][2][1]];
+      cVals[10][2] = data[ind[2][2][2]];
+      cVals[10][3] = extrapolation(data[ind[2][2][2]], data[ind[2][2][1]], data[ind[2][2][0]]);
+      cVals[11][0] = data[ind[2][3][0]];
+      cVals[11][1] = data[ind[2][3][1]];
+      cVals[11][2] = data[ind[2][3][2]];
+      cVals[11][3] = extrapolation(data[ind[2][3][2]], data[ind[2][3][1]], data[ind[2][3][0]]);
+      cVals[12][0] = data[ind[3][0][0]];
+      cVals[12][1] = data[ind[3][0][1]];
+      cVals[12][2] = data[ind[3][0][2]];
+      cVals[13][0] = data[ind[3][1][0]];
+      cVals[12][3] = extrapolation(data[ind[3][0][2]], data[ind[3][0][1]], data[ind[3][0][0]]);
+      cVals[13][1] = data[ind[3][1][1]];
+      cVals[13][2] = data[ind[3][1][2]];
+      cVals[13][3] = extrapolation(data[ind[3][1][2]], data[ind[3][1][1]], data[ind[3][1][0]]);
+      cVals[14][0] = data[ind[3][2][0]];
+      cVals[14][1] = data[ind[3][2][1]];
+      cVals[14][2] = data[ind[3][2][2]];
+      cVals[14][3] = extrapolation(data[ind[3][2][2]], data[ind[3][2][1]], data[ind[3][2][0]]);
+      cVals[15][0] = data[ind[3][3][0]];
+      cVals[15][1] = data[ind[3][3][1]];
+      cVals[15][2] = data[ind[3][3][2]];
+      cVals[15][3] = extrapolation(data[ind[3][3][2]], data[ind[3][3][1]], data[ind[3][3][0]]);
     } break;
 
     case GridPos::SideYRight:
@@ -515,69 +529,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0], ind[3][1][2] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0], ind[3][2][2] - deltaZ[i0]}}};
 
-      cVals[0][0] = (*mGridData)[ind[0][0][0]];
-      cVals[0][1] = (*mGridData)[ind[0][0][1]];
-      cVals[0][2] = (*mGridData)[ind[0][0][2]];
-      cVals[0][3] = (*mGridData)[ind[0][0][3]];
-      cVals[1][0] = (*mGridData)[ind[0][1][0]];
-      cVals[1][1] = (*mGridData)[ind[0][1][1]];
-      cVals[1][2] = (*mGridData)[ind[0][1][2]];
-      cVals[1][3] = (*mGridData)[ind[0][1][3]];
-      cVals[2][0] = (*mGridData)[ind[0][2][0]];
-      cVals[2][1] = (*mGridData)[ind[0][2][1]];
-      cVals[2][2] = (*mGridData)[ind[0][2][2]];
-      cVals[2][3] = (*mGridData)[ind[0][2][3]];
-      cVals[3][0] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][0][0]]);
-      cVals[3][1] = extrapolation((*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][0][1]]);
-      cVals[3][2] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][0][2]]);
-      cVals[3][3] = extrapolation((*mGridData)[ind[0][2][3]], (*mGridData)[ind[0][1][3]], (*mGridData)[ind[0][0][3]]);
-      cVals[4][0] = (*mGridData)[ind[1][0][0]];
-      cVals[4][1] = (*mGridData)[ind[1][0][1]];
-      cVals[4][2] = (*mGridData)[ind[1][0][2]];
-      cVals[4][3] = (*mGridData)[ind[1][0][3]];
-      cVals[5][0] = (*mGridData)[ind[1][1][0]];
-      cVals[5][2] = (*mGridData)[ind[1][1][2]];
-      cVals[5][3] = (*mGridData)[ind[1][1][3]];
-      cVals[6][0] = (*mGridData)[ind[1][2][0]];
-      cVals[6][1] = (*mGridData)[ind[1][2][1]];
-      cVals[6][2] = (*mGridData)[ind[1][2][2]];
-      cVals[6][3] = (*mGridData)[ind[1][2][3]];
-      cVals[7][0] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][0][0]]);
-      cVals[7][1] = extrapolation((*mGridData)[ind[1][2][1]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][1]]);
-      cVals[7][2] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][0][2]]);
-      cVals[7][3] = extrapolation((*mGridData)[ind[1][2][3]], (*mGridData)[ind[1][1][3]], (*mGridData)[ind[1][0][3]]);
-      cVals[8][0] = (*mGridData)[ind[2][0][0]];
-      cVals[8][1] = (*mGridData)[ind[2][0][1]];
-      cVals[8][2] = (*mGridData)[ind[2][0][2]];
-      cVals[8][3] = (*mGridData)[ind[2][0][3]];
-      cVals[9][0] = (*mGridData)[ind[2][1][0]];
-      cVals[9][1] = (*mGridData)[ind[2][1][1]];
-      cVals[9][2] = (*mGridData)[ind[2][1][2]];
-      cVals[9][3] = (*mGridData)[ind[2][1][3]];
-      cVals[10][0] = (*mGridData)[ind[2][2][0]];
-      cVals[10][1] = (*mGridData)[ind[2][2][1]];
-      cVals[10][2] = (*mGridData)[ind[2][2][2]];
-      cVals[10][3] = (*mGridData)[ind[2][2][3]];
-      cVals[11][0] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][0][0]]);
-      cVals[11][1] = extrapolation((*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][0][1]]);
-      cVals[11][2] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][0][2]]);
-      cVals[11][3] = extrapolation((*mGridData)[ind[2][2][3]], (*mGridData)[ind[2][1][3]], (*mGridData)[ind[2][0][3]]);
-      cVals[12][0] = (*mGridData)[ind[3][0][0]];
-      cVals[12][1] = (*mGridData)[ind[3][0][1]];
-      cVals[12][2] = (*mGridData)[ind[3][0][2]];
-      cVals[12][3] = (*mGridData)[ind[3][0][3]];
-      cVals[13][0] = (*mGridData)[ind[3][1][0]];
-      cVals[13][1] = (*mGridData)[ind[3][1][1]];
-      cVals[13][2] = (*mGridData)[ind[3][1][2]];
-      cVals[13][3] = (*mGridData)[ind[3][1][3]];
-      cVals[14][0] = (*mGridData)[ind[3][2][0]];
-      cVals[14][1] = (*mGridData)[ind[3][2][1]];
-      cVals[14][2] = (*mGridData)[ind[3][2][2]];
-      cVals[14][3] = (*mGridData)[ind[3][2][3]];
-      cVals[15][0] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][0][0]]);
-      cVals[15][1] = extrapolation((*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][0][1]]);
-      cVals[15][2] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][0][2]]);
-      cVals[15][3] = extrapolation((*mGridData)[ind[3][2][3]], (*mGridData)[ind[3][1][3]], (*mGridData)[ind[3][0][3]]);
+      cVals[0][0] = data[ind[0][0][0]];
+      cVals[0][1] = data[ind[0][0][1]];
+      cVals[0][2] = data[ind[0][0][2]];
+      cVals[0][3] = data[ind[0][0][3]];
+      cVals[1][0] = data[ind[0][1][0]];
+      cVals[1][1] = data[ind[0][1][1]];
+      cVals[1][2] = data[ind[0][1][2]];
+      cVals[1][3] = data[ind[0][1][3]];
+      cVals[2][0] = data[ind[0][2][0]];
+      cVals[2][1] = data[ind[0][2][1]];
+      cVals[2][2] = data[ind[0][2][2]];
+      cVals[2][3] = data[ind[0][2][3]];
+      cVals[3][0] = extrapolation(data[ind[0][2][0]], data[ind[0][1][0]], data[ind[0][0][0]]);
+      cVals[3][1] = extrapolation(data[ind[0][2][1]], data[ind[0][1][1]], data[ind[0][0][1]]);
+      cVals[3][2] = extrapolation(data[ind[0][2][2]], data[ind[0][1][2]], data[ind[0][0][2]]);
+      cVals[3][3] = extrapolation(data[ind[0][2][3]], data[ind[0][1][3]], data[ind[0][0][3]]);
+      cVals[4][0] = data[ind[1][0][0]];
+      cVals[4][1] = data[ind[1][0][1]];
+      cVals[4][2] = data[ind[1][0][2]];
+      cVals[4][3] = data[ind[1][0][3]];
+      cVals[5][0] = data[ind[1][1][0]];
+      cVals[5][2] = data[ind[1][1][2]];
+      cVals[5][3] = data[ind[1][1][3]];
+      cVals[6][0] = data[ind[1][2][0]];
+      cVals[6][1] = data[ind[1][2][1]];
+      cVals[6][2] = data[ind[1][2][2]];
+      cVals[6][3] = data[ind[1][2][3]];
+      cVals[7][0] = extrapolation(data[ind[1][2][0]], data[ind[1][1][0]], data[ind[1][0][0]]);
+      cVals[7][1] = extrapolation(data[ind[1][2][1]], data[ii_x_y_z], data[ind[1][0][1]]);
+      cVals[7][2] = extrapolation(data[ind[1][2][2]], data[ind[1][1][2]], data[ind[1][0][2]]);
+      cVals[7][3] = extrapolation(data[ind[1][2][3]], data[ind[1][1][3]], data[ind[1][0][3]]);
+      cVals[8][0] = data[ind[2][0][0]];
+      cVals[8][1] = data[ind[2][0][1]];
+      cVals[8][2] = data[ind[2][0][2]];
+      cVals[8][3] = data[ind[2][0][3]];
+      cVals[9][0] = data[ind[2][1][0]];
+      cVals[9][1] = data[ind[2][1][1]];
+      cVals[9][2] = data[ind[2][1][2]];
+      cVals[9][3] = data[ind[2][1][3]];
+      cVals[10][0] = data[ind[2][2][0]];
+      cVals[10][1] = data[ind[2][2][1]];
+      cVals[10][2] = data[ind[2][2][2]];
+      cVals[10][3] = data[ind[2][2][3]];
+      cVals[11][0] = extrapolation(data[ind[2][2][0]], data[ind[2][1][0]], data[ind[2][0][0]]);
+      cVals[11][1] = extrapolation(data[ind[2][2][1]], data[ind[2][1][1]], data[ind[2][0][1]]);
+      cVals[11][2] = extrapolation(data[ind[2][2][2]], data[ind[2][1][2]], data[ind[2][0][2]]);
+      cVals[11][3] = extrapolation(data[ind[2][2][3]], data[ind[2][1][3]], data[ind[2][0][3]]);
+      cVals[12][0] = data[ind[3][0][0]];
+      cVals[12][1] = data[ind[3][0][1]];
+      cVals[12][2] = data[ind[3][0][2]];
+      cVals[12][3] = data[ind[3][0][3]];
+      cVals[13][0] = data[ind[3][1][0]];
+      cVals[13][1] = data[ind[3][1][1]];
+      cVals[13][2] = data[ind[3][1][2]];
+      cVals[13][3] = data[ind[3][1][3]];
+      cVals[14][0] = data[ind[3][2][0]];
+      cVals[14][1] = data[ind[3][2][1]];
+      cVals[14][2] = data[ind[3][2][2]];
+      cVals[14][3] = data[ind[3][2][3]];
+      cVals[15][0] = extrapolation(data[ind[3][2][0]], data[ind[3][1][0]], data[ind[3][0][0]]);
+      cVals[15][1] = extrapolation(data[ind[3][2][1]], data[ind[3][1][1]], data[ind[3][0][1]]);
+      cVals[15][2] = extrapolation(data[ind[3][2][2]], data[ind[3][1][2]], data[ind[3][0][2]]);
+      cVals[15][3] = extrapolation(data[ind[3][2][3]], data[ind[3][1][3]], data[ind[3][0][3]]);
     } break;
 
     case GridPos::SideYLeft:
@@ -597,69 +611,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0], ind[3][1][2] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0], ind[3][2][2] - deltaZ[i0]}}};
 
-      cVals[0][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][2][0]]);
-      cVals[0][1] = extrapolation((*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][2][1]]);
-      cVals[0][2] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][2][2]]);
-      cVals[0][3] = extrapolation((*mGridData)[ind[0][0][3]], (*mGridData)[ind[0][1][3]], (*mGridData)[ind[0][2][3]]);
-      cVals[1][0] = (*mGridData)[ind[0][0][0]];
-      cVals[1][1] = (*mGridData)[ind[0][0][1]];
-      cVals[1][2] = (*mGridData)[ind[0][0][2]];
-      cVals[1][3] = (*mGridData)[ind[0][0][3]];
-      cVals[2][0] = (*mGridData)[ind[0][1][0]];
-      cVals[2][1] = (*mGridData)[ind[0][1][1]];
-      cVals[2][2] = (*mGridData)[ind[0][1][2]];
-      cVals[2][3] = (*mGridData)[ind[0][1][3]];
-      cVals[3][0] = (*mGridData)[ind[0][2][0]];
-      cVals[3][1] = (*mGridData)[ind[0][2][1]];
-      cVals[3][2] = (*mGridData)[ind[0][2][2]];
-      cVals[3][3] = (*mGridData)[ind[0][2][3]];
-      cVals[4][0] = extrapolation((*mGridData)[ind[1][0][0]], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][2][0]]);
-      cVals[4][1] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][2][1]]);
-      cVals[4][2] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][2][2]]);
-      cVals[4][3] = extrapolation((*mGridData)[ind[1][0][3]], (*mGridData)[ind[1][1][3]], (*mGridData)[ind[1][2][3]]);
-      cVals[5][0] = (*mGridData)[ind[1][0][0]];
-      cVals[5][2] = (*mGridData)[ind[1][0][2]];
-      cVals[5][3] = (*mGridData)[ind[1][0][3]];
-      cVals[6][0] = (*mGridData)[ind[1][1][0]];
-      cVals[6][1] = (*mGridData)[ind[1][1][1]];
-      cVals[6][2] = (*mGridData)[ind[1][1][2]];
-      cVals[6][3] = (*mGridData)[ind[1][1][3]];
-      cVals[7][0] = (*mGridData)[ind[1][2][0]];
-      cVals[7][1] = (*mGridData)[ind[1][2][1]];
-      cVals[7][2] = (*mGridData)[ind[1][2][2]];
-      cVals[7][3] = (*mGridData)[ind[1][2][3]];
-      cVals[8][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][2][0]]);
-      cVals[8][1] = extrapolation((*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][2][1]]);
-      cVals[8][2] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][2][2]]);
-      cVals[8][3] = extrapolation((*mGridData)[ind[2][0][3]], (*mGridData)[ind[2][1][3]], (*mGridData)[ind[2][2][3]]);
-      cVals[9][0] = (*mGridData)[ind[2][0][0]];
-      cVals[9][1] = (*mGridData)[ind[2][0][1]];
-      cVals[9][2] = (*mGridData)[ind[2][0][2]];
-      cVals[9][3] = (*mGridData)[ind[2][0][3]];
-      cVals[10][0] = (*mGridData)[ind[2][1][0]];
-      cVals[10][1] = (*mGridData)[ind[2][1][1]];
-      cVals[10][2] = (*mGridData)[ind[2][1][2]];
-      cVals[10][3] = (*mGridData)[ind[2][1][3]];
-      cVals[11][0] = (*mGridData)[ind[2][2][0]];
-      cVals[11][1] = (*mGridData)[ind[2][2][1]];
-      cVals[11][2] = (*mGridData)[ind[2][2][2]];
-      cVals[11][3] = (*mGridData)[ind[2][2][3]];
-      cVals[12][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][2][0]]);
-      cVals[12][1] = extrapolation((*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][2][1]]);
-      cVals[12][2] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][2][2]]);
-      cVals[12][3] = extrapolation((*mGridData)[ind[3][0][3]], (*mGridData)[ind[3][1][3]], (*mGridData)[ind[3][2][3]]);
-      cVals[13][0] = (*mGridData)[ind[3][0][0]];
-      cVals[13][1] = (*mGridData)[ind[3][0][1]];
-      cVals[13][2] = (*mGridData)[ind[3][0][2]];
-      cVals[13][3] = (*mGridData)[ind[3][0][3]];
-      cVals[14][0] = (*mGridData)[ind[3][1][0]];
-      cVals[14][1] = (*mGridData)[ind[3][1][1]];
-      cVals[14][2] = (*mGridData)[ind[3][1][2]];
-      cVals[14][3] = (*mGridData)[ind[3][1][3]];
-      cVals[15][0] = (*mGridData)[ind[3][2][0]];
-      cVals[15][1] = (*mGridData)[ind[3][2][1]];
-      cVals[15][2] = (*mGridData)[ind[3][2][2]];
-      cVals[15][3] = (*mGridData)[ind[3][2][3]];
+      cVals[0][0] = extrapolation(data[ind[0][0][0]], data[ind[0][1][0]], data[ind[0][2][0]]);
+      cVals[0][1] = extrapolation(data[ind[0][0][1]], data[ind[0][1][1]], data[ind[0][2][1]]);
+      cVals[0][2] = extrapolation(data[ind[0][0][2]], data[ind[0][1][2]], data[ind[0][2][2]]);
+      cVals[0][3] = extrapolation(data[ind[0][0][3]], data[ind[0][1][3]], data[ind[0][2][3]]);
+      cVals[1][0] = data[ind[0][0][0]];
+      cVals[1][1] = data[ind[0][0][1]];
+      cVals[1][2] = data[ind[0][0][2]];
+      cVals[1][3] = data[ind[0][0][3]];
+      cVals[2][0] = data[ind[0][1][0]];
+      cVals[2][1] = data[ind[0][1][1]];
+      cVals[2][2] = data[ind[0][1][2]];
+      cVals[2][3] = data[ind[0][1][3]];
+      cVals[3][0] = data[ind[0][2][0]];
+      cVals[3][1] = data[ind[0][2][1]];
+      cVals[3][2] = data[ind[0][2][2]];
+      cVals[3][3] = data[ind[0][2][3]];
+      cVals[4][0] = extrapolation(data[ind[1][0][0]], data[ind[1][1][0]], data[ind[1][2][0]]);
+      cVals[4][1] = extrapolation(data[ii_x_y_z], data[ind[1][1][1]], data[ind[1][2][1]]);
+      cVals[4][2] = extrapolation(data[ind[1][0][2]], data[ind[1][1][2]], data[ind[1][2][2]]);
+      cVals[4][3] = extrapolation(data[ind[1][0][3]], data[ind[1][1][3]], data[ind[1][2][3]]);
+      cVals[5][0] = data[ind[1][0][0]];
+      cVals[5][2] = data[ind[1][0][2]];
+      cVals[5][3] = data[ind[1][0][3]];
+      cVals[6][0] = data[ind[1][1][0]];
+      cVals[6][1] = data[ind[1][1][1]];
+      cVals[6][2] = data[ind[1][1][2]];
+      cVals[6][3] = data[ind[1][1][3]];
+      cVals[7][0] = data[ind[1][2][0]];
+      cVals[7][1] = data[ind[1][2][1]];
+      cVals[7][2] = data[ind[1][2][2]];
+      cVals[7][3] = data[ind[1][2][3]];
+      cVals[8][0] = extrapolation(data[ind[2][0][0]], data[ind[2][1][0]], data[ind[2][2][0]]);
+      cVals[8][1] = extrapolation(data[ind[2][0][1]], data[ind[2][1][1]], data[ind[2][2][1]]);
+      cVals[8][2] = extrapolation(data[ind[2][0][2]], data[ind[2][1][2]], data[ind[2][2][2]]);
+      cVals[8][3] = extrapolation(data[ind[2][0][3]], data[ind[2][1][3]], data[ind[2][2][3]]);
+      cVals[9][0] = data[ind[2][0][0]];
+      cVals[9][1] = data[ind[2][0][1]];
+      cVals[9][2] = data[ind[2][0][2]];
+      cVals[9][3] = data[ind[2][0][3]];
+      cVals[10][0] = data[ind[2][1][0]];
+      cVals[10][1] = data[ind[2][1][1]];
+      cVals[10][2] = data[ind[2][1][2]];
+      cVals[10][3] = data[ind[2][1][3]];
+      cVals[11][0] = data[ind[2][2][0]];
+      cVals[11][1] = data[ind[2][2][1]];
+      cVals[11][2] = data[ind[2][2][2]];
+      cVals[11][3] = data[ind[2][2][3]];
+      cVals[12][0] = extrapolation(data[ind[3][0][0]], data[ind[3][1][0]], data[ind[3][2][0]]);
+      cVals[12][1] = extrapolation(data[ind[3][0][1]], data[ind[3][1][1]], data[ind[3][2][1]]);
+      cVals[12][2] = extrapolation(data[ind[3][0][2]], data[ind[3][1][2]], data[ind[3][2][2]]);
+      cVals[12][3] = extrapolation(data[ind[3][0][3]], data[ind[3][1][3]], data[ind[3][2][3]]);
+      cVals[13][0] = data[ind[3][0][0]];
+      cVals[13][1] = data[ind[3][0][1]];
+      cVals[13][2] = data[ind[3][0][2]];
+      cVals[13][3] = data[ind[3][0][3]];
+      cVals[14][0] = data[ind[3][1][0]];
+      cVals[14][1] = data[ind[3][1][1]];
+      cVals[14][2] = data[ind[3][1][2]];
+      cVals[14][3] = data[ind[3][1][3]];
+      cVals[15][0] = data[ind[3][2][0]];
+      cVals[15][1] = data[ind[3][2][1]];
+      cVals[15][2] = data[ind[3][2][2]];
+      cVals[15][3] = data[ind[3][2][3]];
     } break;
 
     case GridPos::SideXLeft:
@@ -683,69 +697,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]},
          {ind[3][2][0] - deltaR[i0], ind[3][3][0] - deltaZ[i0], ind[3][3][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][2]]);
-      cVals[0][1] = (*mGridData)[ind[0][0][0]];
-      cVals[0][2] = (*mGridData)[ind[0][0][1]];
-      cVals[0][3] = (*mGridData)[ind[0][0][2]];
-      cVals[1][0] = extrapolation((*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][2]]);
-      cVals[1][1] = (*mGridData)[ind[0][1][0]];
-      cVals[1][2] = (*mGridData)[ind[0][1][1]];
-      cVals[1][3] = (*mGridData)[ind[0][1][2]];
-      cVals[2][0] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][2][2]]);
-      cVals[2][1] = (*mGridData)[ind[0][2][0]];
-      cVals[2][2] = (*mGridData)[ind[0][2][1]];
-      cVals[2][3] = (*mGridData)[ind[0][2][2]];
-      cVals[3][0] = extrapolation((*mGridData)[ind[0][3][0]], (*mGridData)[ind[0][3][1]], (*mGridData)[ind[0][3][2]]);
-      cVals[3][1] = (*mGridData)[ind[0][3][0]];
-      cVals[3][2] = (*mGridData)[ind[0][3][1]];
-      cVals[3][3] = (*mGridData)[ind[0][3][2]];
-      cVals[4][0] = extrapolation((*mGridData)[ind[1][0][0]], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][2]]);
-      cVals[4][1] = (*mGridData)[ind[1][0][0]];
-      cVals[4][2] = (*mGridData)[ind[1][0][1]];
-      cVals[4][3] = (*mGridData)[ind[1][0][2]];
-      cVals[5][0] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][1][2]]);
-      cVals[5][2] = (*mGridData)[ind[1][1][1]];
-      cVals[5][3] = (*mGridData)[ind[1][1][2]];
-      cVals[6][0] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][2][2]]);
-      cVals[6][1] = (*mGridData)[ind[1][2][0]];
-      cVals[6][2] = (*mGridData)[ind[1][2][1]];
-      cVals[6][3] = (*mGridData)[ind[1][2][2]];
-      cVals[7][0] = extrapolation((*mGridData)[ind[1][3][0]], (*mGridData)[ind[1][3][1]], (*mGridData)[ind[1][3][2]]);
-      cVals[7][1] = (*mGridData)[ind[1][3][0]];
-      cVals[7][2] = (*mGridData)[ind[1][3][1]];
-      cVals[7][3] = (*mGridData)[ind[1][3][2]];
-      cVals[8][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][2]]);
-      cVals[8][1] = (*mGridData)[ind[2][0][0]];
-      cVals[8][2] = (*mGridData)[ind[2][0][1]];
-      cVals[8][3] = (*mGridData)[ind[2][0][2]];
-      cVals[9][0] = extrapolation((*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][2]]);
-      cVals[9][1] = (*mGridData)[ind[2][1][0]];
-      cVals[9][2] = (*mGridData)[ind[2][1][1]];
-      cVals[9][3] = (*mGridData)[ind[2][1][2]];
-      cVals[10][0] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][2][2]]);
-      cVals[10][1] = (*mGridData)[ind[2][2][0]];
-      cVals[10][2] = (*mGridData)[ind[2][2][1]];
-      cVals[10][3] = (*mGridData)[ind[2][2][2]];
-      cVals[11][0] = extrapolation((*mGridData)[ind[2][3][0]], (*mGridData)[ind[2][3][1]], (*mGridData)[ind[2][3][2]]);
-      cVals[11][1] = (*mGridData)[ind[2][3][0]];
-      cVals[11][2] = (*mGridData)[ind[2][3][1]];
-      cVals[11][3] = (*mGridData)[ind[2][3][2]];
-      cVals[12][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][2]]);
-      cVals[12][1] = (*mGridData)[ind[3][0][0]];
-      cVals[12][2] = (*mGridData)[ind[3][0][1]];
-      cVals[12][3] = (*mGridData)[ind[3][0][2]];
-      cVals[13][0] = extrapolation((*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][2]]);
-      cVals[13][1] = (*mGridData)[ind[3][1][0]];
-      cVals[13][2] = (*mGridData)[ind[3][1][1]];
-      cVals[13][3] = (*mGridData)[ind[3][1][2]];
-      cVals[14][0] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][2][2]]);
-      cVals[14][1] = (*mGridData)[ind[3][2][0]];
-      cVals[14][2] = (*mGridData)[ind[3][2][1]];
-      cVals[14][3] = (*mGridData)[ind[3][2][2]];
-      cVals[15][0] = extrapolation((*mGridData)[ind[3][3][0]], (*mGridData)[ind[3][3][1]], (*mGridData)[ind[3][3][2]]);
-      cVals[15][1] = (*mGridData)[ind[3][3][0]];
-      cVals[15][2] = (*mGridData)[ind[3][3][1]];
-      cVals[15][3] = (*mGridData)[ind[3][3][2]];
+      cVals[0][0] = extrapolation(data[ind[0][0][0]], data[ind[0][0][1]], data[ind[0][0][2]]);
+      cVals[0][1] = data[ind[0][0][0]];
+      cVals[0][2] = data[ind[0][0][1]];
+      cVals[0][3] = data[ind[0][0][2]];
+      cVals[1][0] = extrapolation(data[ind[0][1][0]], data[ind[0][1][1]], data[ind[0][1][2]]);
+      cVals[1][1] = data[ind[0][1][0]];
+      cVals[1][2] = data[ind[0][1][1]];
+      cVals[1][3] = data[ind[0][1][2]];
+      cVals[2][0] = extrapolation(data[ind[0][2][0]], data[ind[0][2][1]], data[ind[0][2][2]]);
+      cVals[2][1] = data[ind[0][2][0]];
+      cVals[2][2] = data[ind[0][2][1]];
+      cVals[2][3] = data[ind[0][2][2]];
+      cVals[3][0] = extrapolation(data[ind[0][3][0]], data[ind[0][3][1]], data[ind[0][3][2]]);
+      cVals[3][1] = data[ind[0][3][0]];
+      cVals[3][2] = data[ind[0][3][1]];
+      cVals[3][3] = data[ind[0][3][2]];
+      cVals[4][0] = extrapolation(data[ind[1][0][0]], data[ind[1][0][1]], data[ind[1][0][2]]);
+      cVals[4][1] = data[ind[1][0][0]];
+      cVals[4][2] = data[ind[1][0][1]];
+      cVals[4][3] = data[ind[1][0][2]];
+      cVals[5][0] = extrapolation(data[ii_x_y_z], data[ind[1][1][1]], data[ind[1][1][2]]);
+      cVals[5][2] = data[ind[1][1][1]];
+      cVals[5][3] = data[ind[1][1][2]];
+      cVals[6][0] = extrapolation(data[ind[1][2][0]], data[ind[1][2][1]], data[ind[1][2][2]]);
+      cVals[6][1] = data[ind[1][2][0]];
+      cVals[6][2] = data[ind[1][2][1]];
+      cVals[6][3] = data[ind[1][2][2]];
+      cVals[7][0] = extrapolation(data[ind[1][3][0]], data[ind[1][3][1]], data[ind[1][3][2]]);
+      cVals[7][1] = data[ind[1][3][0]];
+      cVals[7][2] = data[ind[1][3][1]];
+      cVals[7][3] = data[ind[1][3][2]];
+      cVals[8][0] = extrapolation(data[ind[2][0][0]], data[ind[2][0][1]], data[ind[2][0][2]]);
+      cVals[8][1] = data[ind[2][0][0]];
+      cVals[8][2] = data[ind[2][0][1]];
+      cVals[8][3] = data[ind[2][0][2]];
+      cVals[9][0] = extrapolation(data[ind[2][1][0]], data[ind[2][1][1]], data[ind[2][1][2]]);
+      cVals[9][1] = data[ind[2][1][0]];
+      cVals[9][2] = data[ind[2][1][1]];
+      cVals[9][3] = data[ind[2][1][2]];
+      cVals[10][0] = extrapolation(data[ind[2][2][0]], data[ind[2][2][1]], data[ind[2][2][2]]);
+      cVals[10][1] = data[ind[2][2][0]];
+      cVals[10][2] = data[ind[2][2][1]];
+      cVals[10][3] = data[ind[2][2][2]];
+      cVals[11][0] = extrapolation(data[ind[2][3][0]], data[ind[2][3][1]], data[ind[2][3][2]]);
+      cVals[11][1] = data[ind[2][3][0]];
+      cVals[11][2] = data[ind[2][3][1]];
+      cVals[11][3] = data[ind[2][3][2]];
+      cVals[12][0] = extrapolation(data[ind[3][0][0]], data[ind[3][0][1]], data[ind[3][0][2]]);
+      cVals[12][1] = data[ind[3][0][0]];
+      cVals[12][2] = data[ind[3][0][1]];
+      cVals[12][3] = data[ind[3][0][2]];
+      cVals[13][0] = extrapolation(data[ind[3][1][0]], data[ind[3][1][1]], data[ind[3][1][2]]);
+      cVals[13][1] = data[ind[3][1][0]];
+      cVals[13][2] = data[ind[3][1][1]];
+      cVals[13][3] = data[ind[3][1][2]];
+      cVals[14][0] = extrapolation(data[ind[3][2][0]], data[ind[3][2][1]], data[ind[3][2][2]]);
+      cVals[14][1] = data[ind[3][2][0]];
+      cVals[14][2] = data[ind[3][2][1]];
+      cVals[14][3] = data[ind[3][2][2]];
+      cVals[15][0] = extrapolation(data[ind[3][3][0]], data[ind[3][3][1]], data[ind[3][3][2]]);
+      cVals[15][1] = data[ind[3][3][0]];
+      cVals[15][2] = data[ind[3][3][1]];
+      cVals[15][3] = data[ind[3][3][2]];
     } break;
 
     case GridPos::Edge0:
@@ -765,69 +779,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][2][2]]);
-      cVals[0][1] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][2][0]]);
-      cVals[0][2] = extrapolation((*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][2][1]]);
-      cVals[0][3] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][2][2]]);
-      cVals[1][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][2]]);
-      cVals[1][1] = (*mGridData)[ind[0][0][0]];
-      cVals[1][2] = (*mGridData)[ind[0][0][1]];
-      cVals[1][3] = (*mGridData)[ind[0][0][2]];
-      cVals[2][0] = extrapolation((*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][2]]);
-      cVals[2][1] = (*mGridData)[ind[0][1][0]];
-      cVals[2][2] = (*mGridData)[ind[0][1][1]];
-      cVals[2][3] = (*mGridData)[ind[0][1][2]];
-      cVals[3][0] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][2][2]]);
-      cVals[3][1] = (*mGridData)[ind[0][2][0]];
-      cVals[3][2] = (*mGridData)[ind[0][2][1]];
-      cVals[3][3] = (*mGridData)[ind[0][2][2]];
-      cVals[4][0] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][2][2]]);
-      cVals[4][1] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][2][0]]);
-      cVals[4][2] = extrapolation((*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][2][1]]);
-      cVals[4][3] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][2][2]]);
-      cVals[5][0] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][2]]);
-      cVals[5][2] = (*mGridData)[ind[1][0][1]];
-      cVals[5][3] = (*mGridData)[ind[1][0][2]];
-      cVals[6][0] = extrapolation((*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][1][2]]);
-      cVals[6][1] = (*mGridData)[ind[1][1][0]];
-      cVals[6][2] = (*mGridData)[ind[1][1][1]];
-      cVals[6][3] = (*mGridData)[ind[1][1][2]];
-      cVals[7][0] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][2][2]]);
-      cVals[7][1] = (*mGridData)[ind[1][2][0]];
-      cVals[7][2] = (*mGridData)[ind[1][2][1]];
-      cVals[7][3] = (*mGridData)[ind[1][2][2]];
-      cVals[8][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][2][2]]);
-      cVals[8][1] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][2][0]]);
-      cVals[8][2] = extrapolation((*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][2][1]]);
-      cVals[8][3] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][2][2]]);
-      cVals[9][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][2]]);
-      cVals[9][1] = (*mGridData)[ind[2][0][0]];
-      cVals[9][2] = (*mGridData)[ind[2][0][1]];
-      cVals[9][3] = (*mGridData)[ind[2][0][2]];
-      cVals[10][0] = extrapolation((*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][2]]);
-      cVals[10][1] = (*mGridData)[ind[2][1][0]];
-      cVals[10][2] = (*mGridData)[ind[2][1][1]];
-      cVals[10][3] = (*mGridData)[ind[2][1][2]];
-      cVals[11][0] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][2][2]]);
-      cVals[11][1] = (*mGridData)[ind[2][2][0]];
-      cVals[11][2] = (*mGridData)[ind[2][2][1]];
-      cVals[11][3] = (*mGridData)[ind[2][2][2]];
-      cVals[12][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][2][2]]);
-      cVals[12][1] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][2][0]]);
-      cVals[12][2] = extrapolation((*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][2][1]]);
-      cVals[12][3] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][2][2]]);
-      cVals[13][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][2]]);
-      cVals[13][1] = (*mGridData)[ind[3][0][0]];
-      cVals[13][2] = (*mGridData)[ind[3][0][1]];
-      cVals[13][3] = (*mGridData)[ind[3][0][2]];
-      cVals[14][0] = extrapolation((*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][2]]);
-      cVals[14][1] = (*mGridData)[ind[3][1][0]];
-      cVals[14][2] = (*mGridData)[ind[3][1][1]];
-      cVals[14][3] = (*mGridData)[ind[3][1][2]];
-      cVals[15][0] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][2][2]]);
-      cVals[15][1] = (*mGridData)[ind[3][2][0]];
-      cVals[15][2] = (*mGridData)[ind[3][2][1]];
-      cVals[15][3] = (*mGridData)[ind[3][2][2]];
+      cVals[0][0] = extrapolation(data[ind[0][0][0]], data[ind[0][1][1]], data[ind[0][2][2]]);
+      cVals[0][1] = extrapolation(data[ind[0][0][0]], data[ind[0][1][0]], data[ind[0][2][0]]);
+      cVals[0][2] = extrapolation(data[ind[0][0][1]], data[ind[0][1][1]], data[ind[0][2][1]]);
+      cVals[0][3] = extrapolation(data[ind[0][0][2]], data[ind[0][1][2]], data[ind[0][2][2]]);
+      cVals[1][0] = extrapolation(data[ind[0][0][0]], data[ind[0][0][1]], data[ind[0][0][2]]);
+      cVals[1][1] = data[ind[0][0][0]];
+      cVals[1][2] = data[ind[0][0][1]];
+      cVals[1][3] = data[ind[0][0][2]];
+      cVals[2][0] = extrapolation(data[ind[0][1][0]], data[ind[0][1][1]], data[ind[0][1][2]]);
+      cVals[2][1] = data[ind[0][1][0]];
+      cVals[2][2] = data[ind[0][1][1]];
+      cVals[2][3] = data[ind[0][1][2]];
+      cVals[3][0] = extrapolation(data[ind[0][2][0]], data[ind[0][2][1]], data[ind[0][2][2]]);
+      cVals[3][1] = data[ind[0][2][0]];
+      cVals[3][2] = data[ind[0][2][1]];
+      cVals[3][3] = data[ind[0][2][2]];
+      cVals[4][0] = extrapolation(data[ii_x_y_z], data[ind[1][1][1]], data[ind[1][2][2]]);
+      cVals[4][1] = extrapolation(data[ii_x_y_z], data[ind[1][1][0]], data[ind[1][2][0]]);
+      cVals[4][2] = extrapolation(data[ind[1][0][1]], data[ind[1][1][1]], data[ind[1][2][1]]);
+      cVals[4][3] = extrapolation(data[ind[1][0][2]], data[ind[1][1][2]], data[ind[1][2][2]]);
+      cVals[5][0] = extrapolation(data[ii_x_y_z], data[ind[1][0][1]], data[ind[1][0][2]]);
+      cVals[5][2] = data[ind[1][0][1]];
+      cVals[5][3] = data[ind[1][0][2]];
+      cVals[6][0] = extrapolation(data[ind[1][1][0]], data[ind[1][1][1]], data[ind[1][1][2]]);
+      cVals[6][1] = data[ind[1][1][0]];
+      cVals[6][2] = data[ind[1][1][1]];
+      cVals[6][3] = data[ind[1][1][2]];
+      cVals[7][0] = extrapolation(data[ind[1][2][0]], data[ind[1][2][1]], data[ind[1][2][2]]);
+      cVals[7][1] = data[ind[1][2][0]];
+      cVals[7][2] = data[ind[1][2][1]];
+      cVals[7][3] = data[ind[1][2][2]];
+      cVals[8][0] = extrapolation(data[ind[2][0][0]], data[ind[2][1][1]], data[ind[2][2][2]]);
+      cVals[8][1] = extrapolation(data[ind[2][0][0]], data[ind[2][1][0]], data[ind[2][2][0]]);
+      cVals[8][2] = extrapolation(data[ind[2][0][1]], data[ind[2][1][1]], data[ind[2][2][1]]);
+      cVals[8][3] = extrapolation(data[ind[2][0][2]], data[ind[2][1][2]], data[ind[2][2][2]]);
+      cVals[9][0] = extrapolation(data[ind[2][0][0]], data[ind[2][0][1]], data[ind[2][0][2]]);
+      cVals[9][1] = data[ind[2][0][0]];
+      cVals[9][2] = data[ind[2][0][1]];
+      cVals[9][3] = data[ind[2][0][2]];
+      cVals[10][0] = extrapolation(data[ind[2][1][0]], data[ind[2][1][1]], data[ind[2][1][2]]);
+      cVals[10][1] = data[ind[2][1][0]];
+      cVals[10][2] = data[ind[2][1][1]];
+      cVals[10][3] = data[ind[2][1][2]];
+      cVals[11][0] = extrapolation(data[ind[2][2][0]], data[ind[2][2][1]], data[ind[2][2][2]]);
+      cVals[11][1] = data[ind[2][2][0]];
+      cVals[11][2] = data[ind[2][2][1]];
+      cVals[11][3] = data[ind[2][2][2]];
+      cVals[12][0] = extrapolation(data[ind[3][0][0]], data[ind[3][1][1]], data[ind[3][2][2]]);
+      cVals[12][1] = extrapolation(data[ind[3][0][0]], data[ind[3][1][0]], data[ind[3][2][0]]);
+      cVals[12][2] = extrapolation(data[ind[3][0][1]], data[ind[3][1][1]], data[ind[3][2][1]]);
+      cVals[12][3] = extrapolation(data[ind[3][0][2]], data[ind[3][1][2]], data[ind[3][2][2]]);
+      cVals[13][0] = extrapolation(data[ind[3][0][0]], data[ind[3][0][1]], data[ind[3][0][2]]);
+      cVals[13][1] = data[ind[3][0][0]];
+      cVals[13][2] = data[ind[3][0][1]];
+      cVals[13][3] = data[ind[3][0][2]];
+      cVals[14][0] = extrapolation(data[ind[3][1][0]], data[ind[3][1][1]], data[ind[3][1][2]]);
+      cVals[14][1] = data[ind[3][1][0]];
+      cVals[14][2] = data[ind[3][1][1]];
+      cVals[14][3] = data[ind[3][1][2]];
+      cVals[15][0] = extrapolation(data[ind[3][2][0]], data[ind[3][2][1]], data[ind[3][2][2]]);
+      cVals[15][1] = data[ind[3][2][0]];
+      cVals[15][2] = data[ind[3][2][1]];
+      cVals[15][3] = data[ind[3][2][2]];
     } break;
 
     case GridPos::Edge1:
@@ -847,69 +861,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][2][0]]);
-      cVals[0][1] = extrapolation((*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][2][1]]);
-      cVals[0][2] = extrapolation((*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][2][0] + deltaZ[i0]]);
-      cVals[0][3] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][2][0]]);
-      cVals[1][0] = (*mGridData)[ind[0][0][0]];
-      cVals[1][1] = (*mGridData)[ind[0][0][1]];
-      cVals[1][2] = (*mGridData)[ind[0][0][2]];
-      cVals[1][3] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][0]]);
-      cVals[2][0] = (*mGridData)[ind[0][1][0]];
-      cVals[2][1] = (*mGridData)[ind[0][1][1]];
-      cVals[2][2] = (*mGridData)[ind[0][1][2]];
-      cVals[2][3] = extrapolation((*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][0]]);
-      cVals[3][0] = (*mGridData)[ind[0][2][0]];
-      cVals[3][1] = (*mGridData)[ind[0][2][1]];
-      cVals[3][2] = (*mGridData)[ind[0][2][2]];
-      cVals[3][3] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][2][0]]);
-      cVals[4][0] = extrapolation((*mGridData)[ind[1][0][0]], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][2][0]]);
-      cVals[4][1] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][2][1]]);
-      cVals[4][2] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][2][0] + deltaZ[i0]]);
-      cVals[4][3] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][2][0]]);
-      cVals[5][0] = (*mGridData)[ind[1][0][0]];
-      cVals[5][2] = (*mGridData)[ind[1][0][2]];
-      cVals[5][3] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][0]]);
-      cVals[6][0] = (*mGridData)[ind[1][1][0]];
-      cVals[6][1] = (*mGridData)[ind[1][1][1]];
-      cVals[6][2] = (*mGridData)[ind[1][1][2]];
-      cVals[6][3] = extrapolation((*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][1][0]]);
-      cVals[7][0] = (*mGridData)[ind[1][2][0]];
-      cVals[7][1] = (*mGridData)[ind[1][2][1]];
-      cVals[7][2] = (*mGridData)[ind[1][2][2]];
-      cVals[7][3] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][2][0]]);
-      cVals[8][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][2][0]]);
-      cVals[8][1] = extrapolation((*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][2][1]]);
-      cVals[8][2] = extrapolation((*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][2][0] + deltaZ[i0]]);
-      cVals[8][3] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][2][0]]);
-      cVals[9][0] = (*mGridData)[ind[2][0][0]];
-      cVals[9][1] = (*mGridData)[ind[2][0][1]];
-      cVals[9][2] = (*mGridData)[ind[2][0][2]];
-      cVals[9][3] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][0]]);
-      cVals[10][0] = (*mGridData)[ind[2][1][0]];
-      cVals[10][1] = (*mGridData)[ind[2][1][1]];
-      cVals[10][2] = (*mGridData)[ind[2][1][2]];
-      cVals[10][3] = extrapolation((*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][0]]);
-      cVals[11][0] = (*mGridData)[ind[2][2][0]];
-      cVals[11][1] = (*mGridData)[ind[2][2][1]];
-      cVals[11][2] = (*mGridData)[ind[2][2][2]];
-      cVals[11][3] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][2][0]]);
-      cVals[12][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][2][0]]);
-      cVals[12][1] = extrapolation((*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][2][1]]);
-      cVals[12][2] = extrapolation((*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][2][0] + deltaZ[i0]]);
-      cVals[12][3] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][2][0]]);
-      cVals[13][0] = (*mGridData)[ind[3][0][0]];
-      cVals[13][1] = (*mGridData)[ind[3][0][1]];
-      cVals[13][2] = (*mGridData)[ind[3][0][2]];
-      cVals[13][3] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][0]]);
-      cVals[14][0] = (*mGridData)[ind[3][1][0]];
-      cVals[14][1] = (*mGridData)[ind[3][1][1]];
-      cVals[14][2] = (*mGridData)[ind[3][1][2]];
-      cVals[14][3] = extrapolation((*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][0]]);
-      cVals[15][0] = (*mGridData)[ind[3][2][0]];
-      cVals[15][1] = (*mGridData)[ind[3][2][1]];
-      cVals[15][2] = (*mGridData)[ind[3][2][2]];
-      cVals[15][3] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][2][0]]);
+      cVals[0][0] = extrapolation(data[ind[0][0][0]], data[ind[0][1][0]], data[ind[0][2][0]]);
+      cVals[0][1] = extrapolation(data[ind[0][0][1]], data[ind[0][1][1]], data[ind[0][2][1]]);
+      cVals[0][2] = extrapolation(data[ind[0][0][1]], data[ind[0][1][0]], data[ind[0][2][0] + deltaZ[i0]]);
+      cVals[0][3] = extrapolation(data[ind[0][0][2]], data[ind[0][1][1]], data[ind[0][2][0]]);
+      cVals[1][0] = data[ind[0][0][0]];
+      cVals[1][1] = data[ind[0][0][1]];
+      cVals[1][2] = data[ind[0][0][2]];
+      cVals[1][3] = extrapolation(data[ind[0][0][2]], data[ind[0][0][1]], data[ind[0][0][0]]);
+      cVals[2][0] = data[ind[0][1][0]];
+      cVals[2][1] = data[ind[0][1][1]];
+      cVals[2][2] = data[ind[0][1][2]];
+      cVals[2][3] = extrapolation(data[ind[0][1][2]], data[ind[0][1][1]], data[ind[0][1][0]]);
+      cVals[3][0] = data[ind[0][2][0]];
+      cVals[3][1] = data[ind[0][2][1]];
+      cVals[3][2] = data[ind[0][2][2]];
+      cVals[3][3] = extrapolation(data[ind[0][2][2]], data[ind[0][2][1]], data[ind[0][2][0]]);
+      cVals[4][0] = extrapolation(data[ind[1][0][0]], data[ind[1][1][0]], data[ind[1][2][0]]);
+      cVals[4][1] = extrapolation(data[ii_x_y_z], data[ind[1][1][1]], data[ind[1][2][1]]);
+      cVals[4][2] = extrapolation(data[ii_x_y_z], data[ind[1][1][0]], data[ind[1][2][0] + deltaZ[i0]]);
+      cVals[4][3] = extrapolation(data[ind[1][0][2]], data[ind[1][1][1]], data[ind[1][2][0]]);
+      cVals[5][0] = data[ind[1][0][0]];
+      cVals[5][2] = data[ind[1][0][2]];
+      cVals[5][3] = extrapolation(data[ind[1][0][2]], data[ii_x_y_z], data[ind[1][0][0]]);
+      cVals[6][0] = data[ind[1][1][0]];
+      cVals[6][1] = data[ind[1][1][1]];
+      cVals[6][2] = data[ind[1][1][2]];
+      cVals[6][3] = extrapolation(data[ind[1][1][2]], data[ind[1][1][1]], data[ind[1][1][0]]);
+      cVals[7][0] = data[ind[1][2][0]];
+      cVals[7][1] = data[ind[1][2][1]];
+      cVals[7][2] = data[ind[1][2][2]];
+      cVals[7][3] = extrapolation(data[ind[1][2][2]], data[ind[1][2][1]], data[ind[1][2][0]]);
+      cVals[8][0] = extrapolation(data[ind[2][0][0]], data[ind[2][1][0]], data[ind[2][2][0]]);
+      cVals[8][1] = extrapolation(data[ind[2][0][1]], data[ind[2][1][1]], data[ind[2][2][1]]);
+      cVals[8][2] = extrapolation(data[ind[2][0][1]], data[ind[2][1][0]], data[ind[2][2][0] + deltaZ[i0]]);
+      cVals[8][3] = extrapolation(data[ind[2][0][2]], data[ind[2][1][1]], data[ind[2][2][0]]);
+      cVals[9][0] = data[ind[2][0][0]];
+      cVals[9][1] = data[ind[2][0][1]];
+      cVals[9][2] = data[ind[2][0][2]];
+      cVals[9][3] = extrapolation(data[ind[2][0][2]], data[ind[2][0][1]], data[ind[2][0][0]]);
+      cVals[10][0] = data[ind[2][1][0]];
+      cVals[10][1] = data[ind[2][1][1]];
+      cVals[10][2] = data[ind[2][1][2]];
+      cVals[10][3] = extrapolation(data[ind[2][1][2]], data[ind[2][1][1]], data[ind[2][1][0]]);
+      cVals[11][0] = data[ind[2][2][0]];
+      cVals[11][1] = data[ind[2][2][1]];
+      cVals[11][2] = data[ind[2][2][2]];
+      cVals[11][3] = extrapolation(data[ind[2][2][2]], data[ind[2][2][1]], data[ind[2][2][0]]);
+      cVals[12][0] = extrapolation(data[ind[3][0][0]], data[ind[3][1][0]], data[ind[3][2][0]]);
+      cVals[12][1] = extrapolation(data[ind[3][0][1]], data[ind[3][1][1]], data[ind[3][2][1]]);
+      cVals[12][2] = extrapolation(data[ind[3][0][1]], data[ind[3][1][0]], data[ind[3][2][0] + deltaZ[i0]]);
+      cVals[12][3] = extrapolation(data[ind[3][0][2]], data[ind[3][1][1]], data[ind[3][2][0]]);
+      cVals[13][0] = data[ind[3][0][0]];
+      cVals[13][1] = data[ind[3][0][1]];
+      cVals[13][2] = data[ind[3][0][2]];
+      cVals[13][3] = extrapolation(data[ind[3][0][2]], data[ind[3][0][1]], data[ind[3][0][0]]);
+      cVals[14][0] = data[ind[3][1][0]];
+      cVals[14][1] = data[ind[3][1][1]];
+      cVals[14][2] = data[ind[3][1][2]];
+      cVals[14][3] = extrapolation(data[ind[3][1][2]], data[ind[3][1][1]], data[ind[3][1][0]]);
+      cVals[15][0] = data[ind[3][2][0]];
+      cVals[15][1] = data[ind[3][2][1]];
+      cVals[15][2] = data[ind[3][2][2]];
+      cVals[15][3] = extrapolation(data[ind[3][2][2]], data[ind[3][2][1]], data[ind[3][2][0]]);
     } break;
 
     case GridPos::Edge2:
@@ -929,69 +943,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = extrapolation((*mGridData)[ind[0][0][0]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][2]]);
-      cVals[0][1] = (*mGridData)[ind[0][0][0]];
-      cVals[0][2] = (*mGridData)[ind[0][0][1]];
-      cVals[0][3] = (*mGridData)[ind[0][0][2]];
-      cVals[1][0] = extrapolation((*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][2]]);
-      cVals[1][1] = (*mGridData)[ind[0][1][0]];
-      cVals[1][2] = (*mGridData)[ind[0][1][1]];
-      cVals[1][3] = (*mGridData)[ind[0][1][2]];
-      cVals[2][0] = extrapolation((*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][2] + deltaR[i0]]);
-      cVals[2][1] = (*mGridData)[ind[0][2][0]];
-      cVals[2][2] = (*mGridData)[ind[0][2][1]];
-      cVals[2][3] = (*mGridData)[ind[0][2][2]];
-      cVals[3][0] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][0][2]]);
-      cVals[3][1] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][0][0]]);
-      cVals[3][2] = extrapolation((*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][0][1]]);
-      cVals[3][3] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][0][2]]);
-      cVals[4][0] = extrapolation((*mGridData)[ind[1][0][0]], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][2]]);
-      cVals[4][1] = (*mGridData)[ind[1][0][0]];
-      cVals[4][2] = (*mGridData)[ind[1][0][1]];
-      cVals[4][3] = (*mGridData)[ind[1][0][2]];
-      cVals[5][0] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][1][2]]);
-      cVals[5][2] = (*mGridData)[ind[1][1][1]];
-      cVals[5][3] = (*mGridData)[ind[1][1][2]];
-      cVals[6][0] = extrapolation((*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][2] + deltaR[i0]]);
-      cVals[6][1] = (*mGridData)[ind[1][2][0]];
-      cVals[6][2] = (*mGridData)[ind[1][2][1]];
-      cVals[6][3] = (*mGridData)[ind[1][2][2]];
-      cVals[7][0] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][0][2]]);
-      cVals[7][1] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][0]]);
-      cVals[7][2] = extrapolation((*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][0][1]]);
-      cVals[8][0] = extrapolation((*mGridData)[ind[2][0][0]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][2]]);
-      cVals[7][3] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][0][2]]);
-      cVals[8][1] = (*mGridData)[ind[2][0][0]];
-      cVals[8][2] = (*mGridData)[ind[2][0][1]];
-      cVals[8][3] = (*mGridData)[ind[2][0][2]];
-      cVals[9][0] = extrapolation((*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][2]]);
-      cVals[9][1] = (*mGridData)[ind[2][1][0]];
-      cVals[9][2] = (*mGridData)[ind[2][1][1]];
-      cVals[9][3] = (*mGridData)[ind[2][1][2]];
-      cVals[10][0] = extrapolation((*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][2] + deltaR[i0]]);
-      cVals[10][1] = (*mGridData)[ind[2][2][0]];
-      cVals[10][2] = (*mGridData)[ind[2][2][1]];
-      cVals[10][3] = (*mGridData)[ind[2][2][2]];
-      cVals[11][0] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][0][2]]);
-      cVals[11][1] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][0][0]]);
-      cVals[11][2] = extrapolation((*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][0][1]]);
-      cVals[11][3] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][0][2]]);
-      cVals[12][0] = extrapolation((*mGridData)[ind[3][0][0]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][2]]);
-      cVals[12][1] = (*mGridData)[ind[3][0][0]];
-      cVals[12][2] = (*mGridData)[ind[3][0][1]];
-      cVals[12][3] = (*mGridData)[ind[3][0][2]];
-      cVals[13][0] = extrapolation((*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][2]]);
-      cVals[13][1] = (*mGridData)[ind[3][1][0]];
-      cVals[13][2] = (*mGridData)[ind[3][1][1]];
-      cVals[13][3] = (*mGridData)[ind[3][1][2]];
-      cVals[14][0] = extrapolation((*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][2] + deltaR[i0]]);
-      cVals[14][1] = (*mGridData)[ind[3][2][0]];
-      cVals[14][2] = (*mGridData)[ind[3][2][1]];
-      cVals[14][3] = (*mGridData)[ind[3][2][2]];
-      cVals[15][0] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][0][2]]);
-      cVals[15][1] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][0][0]]);
-      cVals[15][2] = extrapolation((*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][0][1]]);
-      cVals[15][3] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][0][2]]);
+      cVals[0][0] = extrapolation(data[ind[0][0][0]], data[ind[0][0][1]], data[ind[0][0][2]]);
+      cVals[0][1] = data[ind[0][0][0]];
+      cVals[0][2] = data[ind[0][0][1]];
+      cVals[0][3] = data[ind[0][0][2]];
+      cVals[1][0] = extrapolation(data[ind[0][1][0]], data[ind[0][1][1]], data[ind[0][1][2]]);
+      cVals[1][1] = data[ind[0][1][0]];
+      cVals[1][2] = data[ind[0][1][1]];
+      cVals[1][3] = data[ind[0][1][2]];
+      cVals[2][0] = extrapolation(data[ind[0][1][0]], data[ind[0][0][1]], data[ind[0][0][2] + deltaR[i0]]);
+      cVals[2][1] = data[ind[0][2][0]];
+      cVals[2][2] = data[ind[0][2][1]];
+      cVals[2][3] = data[ind[0][2][2]];
+      cVals[3][0] = extrapolation(data[ind[0][2][0]], data[ind[0][1][1]], data[ind[0][0][2]]);
+      cVals[3][1] = extrapolation(data[ind[0][2][0]], data[ind[0][1][0]], data[ind[0][0][0]]);
+      cVals[3][2] = extrapolation(data[ind[0][2][1]], data[ind[0][1][1]], data[ind[0][0][1]]);
+      cVals[3][3] = extrapolation(data[ind[0][2][2]], data[ind[0][1][2]], data[ind[0][0][2]]);
+      cVals[4][0] = extrapolation(data[ind[1][0][0]], data[ind[1][0][1]], data[ind[1][0][2]]);
+      cVals[4][1] = data[ind[1][0][0]];
+      cVals[4][2] = data[ind[1][0][1]];
+      cVals[4][3] = data[ind[1][0][2]];
+      cVals[5][0] = extrapolation(data[ii_x_y_z], data[ind[1][1][1]], data[ind[1][1][2]]);
+      cVals[5][2] = data[ind[1][1][1]];
+      cVals[5][3] = data[ind[1][1][2]];
+      cVals[6][0] = extrapolation(data[ii_x_y_z], data[ind[1][0][1]], data[ind[1][0][2] + deltaR[i0]]);
+      cVals[6][1] = data[ind[1][2][0]];
+      cVals[6][2] = data[ind[1][2][1]];
+      cVals[6][3] = data[ind[1][2][2]];
+      cVals[7][0] = extrapolation(data[ind[1][2][0]], data[ind[1][1][1]], data[ind[1][0][2]]);
+      cVals[7][1] = extrapolation(data[ind[1][2][0]], data[ii_x_y_z], data[ind[1][0][0]]);
+      cVals[7][2] = extrapolation(data[ind[1][2][1]], data[ind[1][1][1]], data[ind[1][0][1]]);
+      cVals[8][0] = extrapolation(data[ind[2][0][0]], data[ind[2][0][1]], data[ind[2][0][2]]);
+      cVals[7][3] = extrapolation(data[ind[1][2][2]], data[ind[1][1][2]], data[ind[1][0][2]]);
+      cVals[8][1] = data[ind[2][0][0]];
+      cVals[8][2] = data[ind[2][0][1]];
+      cVals[8][3] = data[ind[2][0][2]];
+      cVals[9][0] = extrapolation(data[ind[2][1][0]], data[ind[2][1][1]], data[ind[2][1][2]]);
+      cVals[9][1] = data[ind[2][1][0]];
+      cVals[9][2] = data[ind[2][1][1]];
+      cVals[9][3] = data[ind[2][1][2]];
+      cVals[10][0] = extrapolation(data[ind[2][1][0]], data[ind[2][0][1]], data[ind[2][0][2] + deltaR[i0]]);
+      cVals[10][1] = data[ind[2][2][0]];
+      cVals[10][2] = data[ind[2][2][1]];
+      cVals[10][3] = data[ind[2][2][2]];
+      cVals[11][0] = extrapolation(data[ind[2][2][0]], data[ind[2][1][1]], data[ind[2][0][2]]);
+      cVals[11][1] = extrapolation(data[ind[2][2][0]], data[ind[2][1][0]], data[ind[2][0][0]]);
+      cVals[11][2] = extrapolation(data[ind[2][2][1]], data[ind[2][1][1]], data[ind[2][0][1]]);
+      cVals[11][3] = extrapolation(data[ind[2][2][2]], data[ind[2][1][2]], data[ind[2][0][2]]);
+      cVals[12][0] = extrapolation(data[ind[3][0][0]], data[ind[3][0][1]], data[ind[3][0][2]]);
+      cVals[12][1] = data[ind[3][0][0]];
+      cVals[12][2] = data[ind[3][0][1]];
+      cVals[12][3] = data[ind[3][0][2]];
+      cVals[13][0] = extrapolation(data[ind[3][1][0]], data[ind[3][1][1]], data[ind[3][1][2]]);
+      cVals[13][1] = data[ind[3][1][0]];
+      cVals[13][2] = data[ind[3][1][1]];
+      cVals[13][3] = data[ind[3][1][2]];
+      cVals[14][0] = extrapolation(data[ind[3][1][0]], data[ind[3][0][1]], data[ind[3][0][2] + deltaR[i0]]);
+      cVals[14][1] = data[ind[3][2][0]];
+      cVals[14][2] = data[ind[3][2][1]];
+      cVals[14][3] = data[ind[3][2][2]];
+      cVals[15][0] = extrapolation(data[ind[3][2][0]], data[ind[3][1][1]], data[ind[3][0][2]]);
+      cVals[15][1] = extrapolation(data[ind[3][2][0]], data[ind[3][1][0]], data[ind[3][0][0]]);
+      cVals[15][2] = extrapolation(data[ind[3][2][1]], data[ind[3][1][1]], data[ind[3][0][1]]);
+      cVals[15][3] = extrapolation(data[ind[3][2][2]], data[ind[3][1][2]], data[ind[3][0][2]]);
     } break;
 
     case GridPos::Edge3:
@@ -1011,69 +1025,69 @@ void TriCubicInterpolator<DataT>::setValues(const int iz, const int ir, const in
          {ind[3][0][0] - deltaR[i0], ind[3][1][0] - deltaZ[i0], ind[3][1][1] - deltaZ[i0]},
          {ind[3][1][0] - deltaR[i0], ind[3][2][0] - deltaZ[i0], ind[3][2][1] - deltaZ[i0]}}};
 
-      cVals[0][0] = (*mGridData)[ind[0][0][0]];
-      cVals[0][1] = (*mGridData)[ind[0][0][1]];
-      cVals[0][2] = (*mGridData)[ind[0][0][2]];
-      cVals[0][3] = extrapolation((*mGridData)[ind[0][0][2]], (*mGridData)[ind[0][0][1]], (*mGridData)[ind[0][0][0]]);
-      cVals[1][0] = (*mGridData)[ind[0][1][0]];
-      cVals[1][1] = (*mGridData)[ind[0][1][1]];
-      cVals[1][2] = (*mGridData)[ind[0][1][2]];
-      cVals[1][3] = extrapolation((*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][1][0]]);
-      cVals[2][0] = (*mGridData)[ind[0][2][0]];
-      cVals[2][1] = (*mGridData)[ind[0][2][1]];
-      cVals[2][2] = (*mGridData)[ind[0][2][2]];
-      cVals[2][3] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][2][0]]);
-      cVals[3][0] = extrapolation((*mGridData)[ind[0][2][0]], (*mGridData)[ind[0][1][0]], (*mGridData)[ind[0][0][0]]);
-      cVals[3][1] = extrapolation((*mGridData)[ind[0][2][1]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][0][1]]);
-      cVals[3][2] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][1][2]], (*mGridData)[ind[0][0][2]]);
-      cVals[3][3] = extrapolation((*mGridData)[ind[0][2][2]], (*mGridData)[ind[0][1][1]], (*mGridData)[ind[0][0][0]]);
-      cVals[4][0] = (*mGridData)[ind[1][0][0]];
-      cVals[4][1] = (*mGridData)[ind[1][0][1]];
-      cVals[4][2] = (*mGridData)[ind[1][0][2]];
-      cVals[4][3] = extrapolation((*mGridData)[ind[1][0][2]], (*mGridData)[ind[1][0][1]], (*mGridData)[ind[1][0][0]]);
-      cVals[5][0] = (*mGridData)[ind[1][1][0]];
-      cVals[5][2] = (*mGridData)[ind[1][1][2]];
-      cVals[5][3] = extrapolation((*mGridData)[ind[1][1][2]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][1][0]]);
-      cVals[6][0] = (*mGridData)[ind[1][2][0]];
-      cVals[6][1] = (*mGridData)[ind[1][2][1]];
-      cVals[6][2] = (*mGridData)[ind[1][2][2]];
-      cVals[6][3] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][2][1]], (*mGridData)[ind[1][2][0]]);
-      cVals[7][0] = extrapolation((*mGridData)[ind[1][2][0]], (*mGridData)[ind[1][1][0]], (*mGridData)[ind[1][0][0]]);
-      cVals[7][1] = extrapolation((*mGridData)[ind[1][2][1]], (*mGridData)[ii_x_y_z], (*mGridData)[ind[1][0][1]]);
-      cVals[7][2] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][1][2]], (*mGridData)[ind[1][0][2]]);
-      cVals[7][3] = extrapolation((*mGridData)[ind[1][2][2]], (*mGridData)[ind[1][1][1]], (*mGridData)[ind[1][0][0]]);
-      cVals[8][0] = (*mGridData)[ind[2][0][0]];
-      cVals[8][1] = (*mGridData)[ind[2][0][1]];
-      cVals[8][2] = (*mGridData)[ind[2][0][2]];
-      cVals[8][3] = extrapolation((*mGridData)[ind[2][0][2]], (*mGridData)[ind[2][0][1]], (*mGridData)[ind[2][0][0]]);
-      cVals[9][0] = (*mGridData)[ind[2][1][0]];
-      cVals[9][1] = (*mGridData)[ind[2][1][1]];
-      cVals[9][2] = (*mGridData)[ind[2][1][2]];
-      cVals[9][3] = extrapolation((*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][1][0]]);
-      cVals[10][0] = (*mGridData)[ind[2][2][0]];
-      cVals[10][1] = (*mGridData)[ind[2][2][1]];
-      cVals[10][2] = (*mGridData)[ind[2][2][2]];
-      cVals[10][3] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][2][0]]);
-      cVals[11][0] = extrapolation((*mGridData)[ind[2][2][0]], (*mGridData)[ind[2][1][0]], (*mGridData)[ind[2][0][0]]);
-      cVals[11][1] = extrapolation((*mGridData)[ind[2][2][1]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][0][1]]);
-      cVals[11][2] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][1][2]], (*mGridData)[ind[2][0][2]]);
-      cVals[11][3] = extrapolation((*mGridData)[ind[2][2][2]], (*mGridData)[ind[2][1][1]], (*mGridData)[ind[2][0][0]]);
-      cVals[12][0] = (*mGridData)[ind[3][0][0]];
-      cVals[12][1] = (*mGridData)[ind[3][0][1]];
-      cVals[12][2] = (*mGridData)[ind[3][0][2]];
-      cVals[12][3] = extrapolation((*mGridData)[ind[3][0][2]], (*mGridData)[ind[3][0][1]], (*mGridData)[ind[3][0][0]]);
-      cVals[13][0] = (*mGridData)[ind[3][1][0]];
-      cVals[13][1] = (*mGridData)[ind[3][1][1]];
-      cVals[13][2] = (*mGridData)[ind[3][1][2]];
-      cVals[13][3] = extrapolation((*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][1][0]]);
-      cVals[14][0] = (*mGridData)[ind[3][2][0]];
-      cVals[14][1] = (*mGridData)[ind[3][2][1]];
-      cVals[14][2] = (*mGridData)[ind[3][2][2]];
-      cVals[14][3] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][2][0]]);
-      cVals[15][0] = extrapolation((*mGridData)[ind[3][2][0]], (*mGridData)[ind[3][1][0]], (*mGridData)[ind[3][0][0]]);
-      cVals[15][1] = extrapolation((*mGridData)[ind[3][2][1]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][0][1]]);
-      cVals[15][2] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][1][2]], (*mGridData)[ind[3][0][2]]);
-      cVals[15][3] = extrapolation((*mGridData)[ind[3][2][2]], (*mGridData)[ind[3][1][1]], (*mGridData)[ind[3][0][0]]);
+      cVals[0][0] = data[ind[0][0][0]];
+      cVals[0][1] = data[ind[0][0][1]];
+      cVals[0][2] = data[ind[0][0][2]];
+      cVals[0][3] = extrapolation(data[ind[0][0][2]], data[ind[0][0][1]], data[ind[0][0][0]]);
+      cVals[1][0] = data[ind[0][1][0]];
+      cVals[1][1] = data[ind[0][1][1]];
+      cVals[1][2] = data[ind[0][1][2]];
+      cVals[1][3] = extrapolation(data[ind[0][1][2]], data[ind[0][1][1]], data[ind[0][1][0]]);
+      cVals[2][0] = data[ind[0][2][0]];
+      cVals[2][1] = data[ind[0][2][1]];
+      cVals[2][2] = data[ind[0][2][2]];
+      cVals[2][3] = extrapolation(data[ind[0][2][2]], data[ind[0][2][1]], data[ind[0][2][0]]);
+      cVals[3][0] = extrapolation(data[ind[0][2][0]], data[ind[0][1][0]], data[ind[0][0][0]]);
+      cVals[3][1] = extrapolation(data[ind[0][2][1]], data[ind[0][1][1]], data[ind[0][0][1]]);
+      cVals[3][2] = extrapolation(data[ind[0][2][2]], data[ind[0][1][2]], data[ind[0][0][2]]);
+      cVals[3][3] = extrapolation(data[ind[0][2][2]], data[ind[0][1][1]], data[ind[0][0][0]]);
+      cVals[4][0] = data[ind[1][0][0]];
+      cVals[4][1] = data[ind[1][0][1]];
+      cVals[4][2] = data[ind[1][0][2]];
+      cVals[4][3] = extrapolation(data[ind[1][0][2]], data[ind[1][0][1]], data[ind[1][0][0]]);
+      cVals[5][0] = data[ind[1][1][0]];
+      cVals[5][2] = data[ind[1][1][2]];
+      cVals[5][3] = extrapolation(data[ind[1][1][2]], data[ii_x_y_z], data[ind[1][1][0]]);
+      cVals[6][0] = data[ind[1][2][0]];
+      cVals[6][1] = data[ind[1][2][1]];
+      cVals[6][2] = data[ind[1][2][2]];
+      cVals[6][3] = extrapolation(data[ind[1][2][2]], data[ind[1][2][1]], data[ind[1][2][0]]);
+      cVals[7][0] = extrapolation(data[ind[1][2][0]], data[ind[1][1][0]], data[ind[1][0][0]]);
+      cVals[7][1] = extrapolation(data[ind[1][2][1]], data[ii_x_y_z], data[ind[1][0][1]]);
+      cVals[7][2] = extrapolation(data[ind[1][2][2]], data[ind[1][1][2]], data[ind[1][0][2]]);
+      cVals[7][3] = extrapolation(data[ind[1][2][2]], data[ind[1][1][1]], data[ind[1][0][0]]);
+      cVals[8][0] = data[ind[2][0][0]];
+      cVals[8][1] = data[ind[2][0][1]];
+      cVals[8][2] = data[ind[2][0][2]];
+      cVals[8][3] = extrapolation(data[ind[2][0][2]], data[ind[2][0][1]], data[ind[2][0][0]]);
+      cVals[9][0] = data[ind[2][1][0]];
+      cVals[9][1] = data[ind[2][1][1]];
+      cVals[9][2] = data[ind[2][1][2]];
+      cVals[9][3] = extrapolation(data[ind[2][1][2]], data[ind[2][1][1]], data[ind[2][1][0]]);
+      cVals[10][0] = data[ind[2][2][0]];
+      cVals[10][1] = data[ind[2][2][1]];
+      cVals[10][2] = data[ind[2][2][2]];
+      cVals[10][3] = extrapolation(data[ind[2][2][2]], data[ind[2][2][1]], data[ind[2][2][0]]);
+      cVals[11][0] = extrapolation(data[ind[2][2][0]], data[ind[2][1][0]], data[ind[2][0][0]]);
+      cVals[11][1] = extrapolation(data[ind[2][2][1]], data[ind[2][1][1]], data[ind[2][0][1]]);
+      cVals[11][2] = extrapolation(data[ind[2][2][2]], data[ind[2][1][2]], data[ind[2][0][2]]);
+      cVals[11][3] = extrapolation(data[ind[2][2][2]], data[ind[2][1][1]], data[ind[2][0][0]]);
+      cVals[12][0] = data[ind[3][0][0]];
+      cVals[12][1] = data[ind[3][0][1]];
+      cVals[12][2] = data[ind[3][0][2]];
+      cVals[12][3] = extrapolation(data[ind[3][0][2]], data[ind[3][0][1]], data[ind[3][0][0]]);
+      cVals[13][0] = data[ind[3][1][0]];
+      cVals[13][1] = data[ind[3][1][1]];
+      cVals[13][2] = data[ind[3][1][2]];
+      cVals[13][3] = extrapolation(data[ind[3][1][2]], data[ind[3][1][1]], data[ind[3][1][0]]);
+      cVals[14][0] = data[ind[3][2][0]];
+      cVals[14][1] = data[ind[3][2][1]];
+      cVals[14][2] = data[ind[3][2][2]];
+      cVals[14][3] = extrapolation(data[ind[3][2][2]], data[ind[3][2][1]], data[ind[3][2][0]]);
+      cVals[15][0] = extrapolation(data[ind[3][2][0]], data[ind[3][1][0]], data[ind[3][0][0]]);
+      cVals[15][1] = extrapolation(data[ind[3][2][1]], data[ind[3][1][1]], data[ind[3][0][1]]);
+      cVals[15][2] = extrapolation(data[ind[3][2][2]], data[ind[3][1][2]], data[ind[3][0][2]]);
+      cVals[15][3] = extrapolation(data[ind[3][2][2]], data[ind[3][1][1]], data[ind[3][0][0]]);
     } break;
   }
 }
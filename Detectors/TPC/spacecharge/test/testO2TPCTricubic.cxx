@@ -70,6 +70,13 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D_test)
   // create tricubic interpolator
   o2::tpc::TriCubicInterpolator<DataT> interpolator(data3D, grid3D);
 
+  // second container on the same grid to check the simultaneous interpolation of several containers
+  o2::tpc::DataContainer3D<DataT> data3DScaled(data3D);
+  data3DScaled *= -2;
+  o2::tpc::TriCubicInterpolator<DataT> interpolatorScaled(data3DScaled, grid3D);
+  const std::array<const o2::tpc::DataContainer3D<DataT>*, 2> dataMulti{&data3D, &data3DScaled};
+  std::array<DataT, 2> interpolatedMulti{};
+
   const float nFacLoop = 1.4;
   const int nrPointsLoop = NR * nFacLoop;
   const int nzPointsLoop = NZ * nFacLoop;
@@ -87,6 +94,10 @@ BOOST_AUTO_TEST_CASE(PoissonSolver3D_test)
         const DataT interpolatedSparse = interpolator(z, r, phi);
         const DataT trueValue = field.evalPotential(z, r, phi);
 
+        interpolator(z, r, phi, dataMulti, interpolatedMulti);
+        BOOST_CHECK_EQUAL(interpolatedMulti[0], interpolatedSparse);
+        BOOST_CHECK_EQUAL(interpolatedMulti[1], interpolatorScaled(z, r, phi));
+
         // use larger tolerances at the edges of the grid
         const int facTol = ((iR < nFacLoop) || (iZ < nFacLoop) || (iR >= nrPointsLoop - 1 - nFacLoop) || (iZ >= nzPointsLoop - 1 - nFacLoop)) ? 10 : 1;
         if (std::abs(trueValue) < 0.1) {
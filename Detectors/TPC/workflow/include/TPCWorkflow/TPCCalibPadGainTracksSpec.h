@@ -114,6 +114,7 @@ class TPCCalibPadGainTracksDevice : public o2::framework::Task
     }
 
     mMaxTracksPerTF = ic.options().get<int>("maxTracksPerTF");
+    mPadGainTracks.setNThreads(ic.options().get<int>("nthreads"));
 
     const std::string gainMapFile = ic.options().get<std::string>("gainMapFile");
     if (!gainMapFile.empty()) {
@@ -291,6 +292,7 @@ DataProcessorSpec getTPCCalibPadGainTracksSpec(const uint32_t publishAfterTFs, c
     {"do-not-propagateTrack", VariantType::Bool, false, {"Performing a refit for obtaining track parameters instead of propagating."}},
     {"useEveryNthTF", VariantType::Int, 10, {"Using only a fraction of the data: 1: Use every TF, 10: Use only every tenth TF."}},
     {"maxTracksPerTF", VariantType::Int, 10000, {"Maximum number of processed tracks per TF (-1 for processing all tracks)"}},
+    {"nthreads", VariantType::Int, 1, {"Number of threads used for the processing of the tracks"}},
   };
   o2::tpc::CorrectionMapsLoader::requestCCDBInputs(dataRequest->inputs, opts, sclOpts);
 
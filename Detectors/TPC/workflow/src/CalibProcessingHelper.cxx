@@ -264,6 +264,7 @@ void processGBT(o2::framework::RawParser<>& parser, std::unique_ptr<o2::tpc::raw
 
 void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<o2::tpc::rawreader::RawReaderCRU>& reader, uint32_t firstOrbit, uint32_t syncOffsetReference, uint32_t decoderType, int triggerBC)
 {
+  std::vector<Digit> digits; // reused for all pages
   for (auto it = parser.begin(), end = parser.end(); it != end; ++it) {
     auto rdhPtr = reinterpret_cast<const o2::header::RDHAny*>(it.raw());
     const auto rdhVersion = RDHUtils::getVersion(rdhPtr);
@@ -287,7 +288,7 @@ void processLinkZS(o2::framework::RawParser<>& parser, std::unique_ptr<o2::tpc::
     }
 
     if ((decoderType == 1) && (linkID == rdh_utils::ILBZSLinkID || linkID == rdh_utils::DLBZSLinkID) && (detField == raw_data_types::Type::ZS)) {
-      std::vector<Digit> digits;
+      digits.clear();
       static o2::gpu::GPUO2InterfaceUtils::GPUReconstructionZSDecoder gpuDecoder;
       gpuDecoder.DecodePage(digits, (const void*)it.raw(), firstOrbit, nullptr, static_cast<unsigned int>((triggerBC > 0) ? triggerBC : 0));
       for (const auto& digit : digits) {
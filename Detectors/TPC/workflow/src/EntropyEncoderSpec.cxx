@@ -68,6 +68,7 @@ void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
 {
   mCTFCoder.init<CTF>(ic);
   mCTFCoder.setCombineColumns(!ic.options().get<bool>("no-ctf-columns-combining"));
+  mCTFCoder.setContextCoding(ic.options().get<bool>("ctf-context-coding"));
 
   mFastTransform = std::move(TPCFastTransformHelperO2::instance()->create(0));
 
@@ -78,6 +79,7 @@ void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
   }
 
   mNThreads = ic.options().get<unsigned int>("nThreads-tpc-encoder");
+  mCTFCoder.setNThreads(mNThreads);
   mMaxZ = ic.options().get<float>("irframe-clusters-maxz");
   mMaxEta = ic.options().get<float>("irframe-clusters-maxeta");
 
@@ -187,7 +189,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
       const float tMin = o2::tpc::ClusterNative::unpackTime(tMinP), tMax = o2::tpc::ClusterNative::unpackTime(tMaxP);
       const auto chkVal = firstIR + (tMin * constants::LHCBCPERTIMEBIN);
       const auto chkExt = totalT > tMax - tMin ? ((totalT - (tMax - tMin)) * constants::LHCBCPERTIMEBIN + 1) : 0;
-      const bool reject = mCTFCoder.getIRFramesSelector().check(o2::dataformats::IRFrame(chkVal, chkVal + 1), chkExt, 0) < 0;
+      const bool reject = !mCTFCoder.getIRFramesSelector().isSelected(o2::dataformats::IRFrame(chkVal, chkVal + 1), chkExt, 0);
       if (reject) {
         for (unsigned int k = offset - clusters.nTrackClusters[i]; k < offset; k++) {
           rejectTrackHits[k] = true;
@@ -238,7 +240,7 @@ void EntropyEncoderSpec::run(ProcessingContext& pc)
         const unsigned int deltaBC = std::max<float>(0.f, totalT - mFastTransform->convDeltaZtoDeltaTimeInTimeFrameAbs(maxz)) * constants::LHCBCPERTIMEBIN;
         const auto chkVal = firstIR + (cl.getTime() * constants::LHCBCPERTIMEBIN) - deltaBC;
         const auto chkExt = totalT * constants::LHCBCPERTIMEBIN - deltaBC;
-        const bool reject = mCTFCoder.getIRFramesSelector().check(o2::dataformats::IRFrame(chkVal, chkVal + 1), chkExt, 0) < 0;
+        const bool reject = !mCTFCoder.getIRFramesSelector().isSelected(o2::dataformats::IRFrame(chkVal, chkVal + 1), chkExt, 0);
         if (reject) {
           rejectHits[k] = true;
           clustersFiltered.nSliceRowClusters[i * GPUCA_ROW_COUNT + j]--;
@@ -326,13 +328,16 @@ DataProcessorSpec getEntropyEncoderSpec(bool inputFromFile, bool selIR)
             {{"ctfrep"}, "TPC", "CTFENCREP", 0, Lifetime::Timeframe}},
     AlgorithmSpec{adaptFromTask<EntropyEncoderSpec>(inputFromFile, selIR, ggreq)},
     Options{{"ctf-dict", VariantType::String, "ccdb", {"CTF dictionary: empty or ccdb=CCDB, none=no external dictionary otherwise: local filename"}},
+            {"ctf-dict-update", VariantType::Int, 0, {"if > 0, check for an updated CTF dictionary (CCDB or local file) every N TFs"}},
+            {"ctf-dict-sampling", VariantType::Int, 0, {"if > 0, encode every N-th TF with per-TF dictionaries to feed the online dictionary creation"}},
             {"no-ctf-columns-combining", VariantType::Bool, false, {"Do not combine correlated columns in CTF"}},
+            {"ctf-context-coding", VariantType::Bool, false, {"Encode the pad and time residuals with symbol tables selected by the row increment, w/o external dictionary only"}},
             {"irframe-margin-bwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame lower boundary when selection is requested"}},
             {"irframe-margin-fwd", VariantType::UInt32, 0u, {"margin in BC to add to the IRFrame upper boundary when selection is requested"}},
             {"irframe-clusters-maxeta", VariantType::Float, 1.5f, {"Max eta for non-assigned clusters"}},
             {"irframe-clusters-maxz", VariantType::Float, 25.f, {"Max z for non assigned clusters (combined with maxeta)"}},
             {"mem-factor", VariantType::Float, 1.f, {"Memory allocation margin factor"}},
-            {"nThreads-tpc-encoder", VariantType::UInt32, 1u, {"number of threads to use for decoding"}},
+            {"nThreads-tpc-encoder", VariantType::UInt32, 1u, {"number of threads to use for the cluster selection and the entropy encoding"}},
             {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
 
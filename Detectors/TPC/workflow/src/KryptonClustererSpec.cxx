@@ -9,7 +9,10 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "Framework/Task.h"
 #include "Framework/InputRecordWalker.h"
@@ -34,15 +37,19 @@ namespace tpc
 class KrBoxClusterFinderDevice : public o2::framework::Task
 {
  public:
-  KrBoxClusterFinderDevice() : mClusterFinder{std::make_unique<KrBoxClusterFinder>()} {}
-
   void init(o2::framework::InitContext& ic) final
   {
-    mClusterFinder->init();
+    // one cluster finder per thread, the sectors of a TF are processed in parallel
+    const int nThreads = std::max(ic.options().get<int>("nthreads"), 1);
+    for (int i = 0; i < nThreads; ++i) {
+      auto& clusterFinder = mClusterFinders.emplace_back(std::make_unique<KrBoxClusterFinder>());
+      clusterFinder->init();
+    }
   }
 
   void run(o2::framework::ProcessingContext& pc) final
   {
+    std::vector<std::pair<int, gsl::span<const o2::tpc::Digit>>> sectorDigits;
     for (auto const& inputRef : InputRecordWalker(pc.inputs())) {
       auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputRef);
       if (sectorHeader == nullptr) {
@@ -51,15 +58,36 @@ class KrBoxClusterFinderDevice : public o2::framework::Task
       }
 
       const int sector = sectorHeader->sector();
-      auto inDigits = pc.inputs().get<gsl::span<o2::tpc::Digit>>(inputRef);
-
-      mClusterFinder->loopOverSector(inDigits, sector);
-
-      snapshotClusters(pc.outputs(), mClusterFinder->getClusters(), sector);
+      sectorDigits.emplace_back(sector, pc.inputs().get<gsl::span<o2::tpc::Digit>>(inputRef));
+    }
 
-      LOGP(info, "processed sector {} with {} digits and {} reconstructed clusters", sector, inDigits.size(), mClusterFinder->getClusters().size());
+    const int nThreads = mClusterFinders.size();
+    std::vector<std::vector<o2::tpc::KrCluster>> clusters(sectorDigits.size());
+    auto myThread = [&](int iThread) {
+      auto& clusterFinder = *mClusterFinders[iThread];
+      for (size_t i = iThread; i < sectorDigits.size(); i += nThreads) {
+        clusterFinder.loopOverSector(sectorDigits[i].second, sectorDigits[i].first);
+        clusters[i].swap(clusterFinder.getClusters());
+        clusterFinder.resetClusters();
+      }
+    };
+
+    if (nThreads == 1) {
+      myThread(0);
+    } else {
+      std::vector<std::thread> threads(nThreads);
+      for (int i = 0; i < nThreads; i++) {
+        threads[i] = std::thread(myThread, i);
+      }
+      for (auto& th : threads) {
+        th.join();
+      }
+    }
 
-      mClusterFinder->resetClusters();
+    for (size_t i = 0; i < sectorDigits.size(); ++i) {
+      const int sector = sectorDigits[i].first;
+      snapshotClusters(pc.outputs(), clusters[i], sector);
+      LOGP(info, "processed sector {} with {} digits and {} reconstructed clusters", sector, sectorDigits[i].second.size(), clusters[i].size());
     }
 
     ++mProcessedTFs;
@@ -67,7 +95,7 @@ class KrBoxClusterFinderDevice : public o2::framework::Task
   }
 
  private:
-  std::unique_ptr<KrBoxClusterFinder> mClusterFinder;
+  std::vector<std::unique_ptr<KrBoxClusterFinder>> mClusterFinders;
   uint32_t mProcessedTFs{0};
 
   //____________________________________________________________________________
@@ -95,7 +123,9 @@ o2::framework::DataProcessorSpec getKryptonClustererSpec()
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<device>()},
-    Options{} // end Options
+    Options{
+      {"nthreads", VariantType::Int, 1, {"Number of threads used to process the sectors in parallel"}},
+    } // end Options
   };          // end DataProcessorSpec
 }
 } // namespace tpc
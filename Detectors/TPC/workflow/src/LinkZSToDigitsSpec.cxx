@@ -28,6 +28,8 @@
 #include "TPCBase/Mapper.h"
 #include "TPCReconstruction/RawReaderCRU.h"
 #include "TPCWorkflow/LinkZSToDigitsSpec.h"
+#include <array>
+#include <bit>
 #include <vector>
 #include <string>
 #include "DetectorsRaw/RDHUtils.h"
@@ -216,14 +218,26 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
               const uint32_t numberOfWords = zsdata->cont.header.numWordsPayload;
               assert((channelBits.count() - 1) / 10 == numberOfWords - 1);
 
+              // unpack all ADC values of the time bin at once
+              std::array<float, zerosupp_link_based::ContainerZS::ChannelsPerWord * 8> adcValues;
+              for (uint32_t iword = 0; iword < std::min(numberOfWords, 8u); ++iword) {
+                zsdata->cont.data[iword].getADCValuesFloat(adcValues.data() + iword * zerosupp_link_based::ContainerZS::ChannelsPerWord);
+              }
+              const int timebin = (globalBCoffset + zsdata->cont.header.bunchCrossing) / 8; // To be calculated
+
+              // loop only over the channels with data
               std::size_t processedChannels = 0;
+              const uint64_t channelMasks[2] = {zsdata->cont.header.bitMaskLow, zsdata->cont.header.bitMaskHigh};
               for (std::size_t ichannel = 0; ichannel < channelBits.size(); ++ichannel) {
-                if (!channelBits[ichannel]) {
+                const auto mask = channelMasks[ichannel / 64] >> (ichannel % 64);
+                if (!mask) {
+                  ichannel = (ichannel / 64 + 1) * 64 - 1; // no more channels with data in this part of the mask
                   continue;
                 }
+                ichannel += std::countr_zero(mask);
 
                 // adc value
-                const auto adcValue = zsdata->getADCValueFloat(processedChannels);
+                const auto adcValue = adcValues[processedChannels];
 
                 // pad mapping
                 // TODO: verify the assumptions of the channel mapping!
@@ -267,7 +281,6 @@ o2::framework::DataProcessorSpec getLinkZSToDigitsSpec(int channel, const std::s
 
                 const auto padSecPos = mapper.padSecPos(cru, fecInPartition, sampaOnFEC, channelOnSAMPA);
                 const auto& padPos = padSecPos.getPadPos();
-                int timebin = (globalBCoffset + zsdata->cont.header.bunchCrossing) / 8; // To be calculated
 
                 // add digit
                 processAttributes->digitsAll[sector].emplace_back(cruID, adcValue, padPos.getRow(), padPos.getPad(), timebin);
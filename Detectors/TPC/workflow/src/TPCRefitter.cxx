@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include <vector>
+#include <algorithm>
 #include <TStopwatch.h>
 #include "DataFormatsGlobalTracking/RecoContainer.h"
 #include "DataFormatsGlobalTracking/RecoContainerCreateTracksVariadic.h"
@@ -32,6 +33,9 @@
 #include "TPCBase/ParameterElectronics.h"
 #include "CommonUtils/TreeStreamRedirector.h"
 #include "Steer/MCKinematicsReader.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 namespace o2::trackstudy
 {
@@ -66,6 +70,34 @@ class TPCRefitterSpec final : public Task
   bool getDCAs(const o2::track::TrackPar& track, float& dcar, float& dcaz);
 
  private:
+  /// positions of the clusters of a track
+  struct TrackClusters {
+    std::vector<short> sector, row;
+    std::vector<float> x, y, z, xI, yI, zI; // *I are the uncorrected cluster positions
+    void clear()
+    {
+      sector.clear();
+      row.clear();
+      x.clear();
+      y.clear();
+      z.clear();
+      xI.clear();
+      yI.clear();
+      zI.clear();
+    }
+  };
+
+  /// result of the refit of a TPC track
+  struct RefitResult {
+    o2::tpc::TrackTPC track{};                // original track propagated to the target X
+    o2::track::TrackParCov trackRef{};        // refitted track propagated to the target X
+    TrackClusters clusters{};                 // clusters of the original track, if requested
+    float chi2refit = 0.f;                    // chi2 of the refit
+    float dcar = 9999.f, dcaz = 9999.f;       // DCAs of the original track
+    float dcarRef = 9999.f, dcazRef = 9999.f; // DCAs of the refitted track
+    bool isOK = false;                        // refit and propagations succeeded
+  };
+
   void updateTimeDependentParams(ProcessingContext& pc);
   std::shared_ptr<DataRequest> mDataRequest;
   std::shared_ptr<o2::base::GRPGeomRequest> mGGCCDBRequest;
@@ -79,6 +111,7 @@ class TPCRefitterSpec final : public Task
   int mTFEnd = 999999999;
   int mTFCount = -1;
   int mDCAMinNCl = 80;
+  int mNThreads = 1;
   bool mUseR = false;
   bool mEnableDCA = false;
   bool mWriteTrackClusters = false;
@@ -109,6 +142,13 @@ void TPCRefitterSpec::init(InitContext& ic)
   mTFEnd = ic.options().get<int>("tf-end");
   mDCAMinPt = ic.options().get<float>("dcaMinPt");
   mDCAMinNCl = ic.options().get<float>("dcaMinNCl");
+  mNThreads = std::max(ic.options().get<int>("nthreads"), 1);
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOGP(warn, "OpenMP is not available, the tracks are refitted with 1 thread");
+    mNThreads = 1;
+  }
+#endif
   if (mXRef < 0.) {
     mXRef = 0.;
   }
@@ -196,9 +236,6 @@ void TPCRefitterSpec::process(o2::globaltracking::RecoContainer& recoData)
 
   float vdriftTB = mTPCVDriftHelper.getVDriftObject().getVDrift() * o2::tpc::ParameterElectronics::Instance().ZbinWidth; // VDrift expressed in cm/TimeBin
   float tpcTBBias = mTPCVDriftHelper.getVDriftObject().getTimeOffset() / (8 * o2::constants::lhc::LHCBunchSpacingMUS);
-  std::vector<short> clSector, clRow;
-  std::vector<float> clX, clY, clZ, clXI, clYI, clZI; // *I are the uncorrected cluster positions
-  float dcar, dcaz, dcarRef, dcazRef;
 
   auto dumpClusters = [this] {
     static int tf = 0;
@@ -229,183 +266,194 @@ void TPCRefitterSpec::process(o2::globaltracking::RecoContainer& recoData)
     dumpClusters();
   }
 
-  for (size_t itr = 0; itr < mTPCTracksArray.size(); itr++) {
-    auto tr = mTPCTracksArray[itr]; // create track copy
-    if (tr.hasBothSidesClusters()) {
-      continue;
+  //=========================================================================
+  // create refitted copy
+  auto trackRefit = [this](size_t itr, o2::track::TrackParCov& trc, float t, float& chi2refit) -> bool {
+    int retVal = mUseGPUModel ? this->mTPCRefitter->RefitTrackAsGPU(trc, this->mTPCTracksArray[itr].getClusterRef(), t, &chi2refit, false, true)
+                              : this->mTPCRefitter->RefitTrackAsTrackParCov(trc, this->mTPCTracksArray[itr].getClusterRef(), t, &chi2refit, false, true);
+    if (retVal < 0) {
+      LOGP(warn, "Refit failed ({}) with time={}: TPC track {} [{}]", retVal, t, itr, trc.asString());
+      return false;
     }
+    return true;
+  };
 
-    //=========================================================================
-    // create refitted copy
-    auto trackRefit = [itr, this](o2::track::TrackParCov& trc, float t, float chi2refit) -> bool {
-      int retVal = mUseGPUModel ? this->mTPCRefitter->RefitTrackAsGPU(trc, this->mTPCTracksArray[itr].getClusterRef(), t, &chi2refit, false, true)
-                                : this->mTPCRefitter->RefitTrackAsTrackParCov(trc, this->mTPCTracksArray[itr].getClusterRef(), t, &chi2refit, false, true);
-      if (retVal < 0) {
-        LOGP(warn, "Refit failed ({}) with time={}: track#{}[{}]", retVal, t, counter, trc.asString());
-        return false;
-      }
-      return true;
-    };
+  auto trackProp = [prop, this](size_t itr, float alpha, o2::track::TrackParCov& trc) -> bool {
+    if (!trc.rotate(alpha)) {
+      LOGP(warn, "Rotation to original track alpha {} failed, TPC track {} [{}]", alpha, itr, trc.asString());
+      return false;
+    }
+    float xtgt = this->mXRef;
+    if (mUseR && !trc.getXatLabR(this->mXRef, xtgt, prop->getNominalBz(), o2::track::DirInward)) {
+      xtgt = 0;
+      return false;
+    }
+    if (!prop->PropagateToXBxByBz(trc, xtgt)) {
+      LOGP(warn, "Propagation to X={} failed, TPC track {} [{}]", xtgt, itr, trc.asString());
+      return false;
+    }
+    return true;
+  };
 
-    auto trackProp = [&tr, itr, prop, this](o2::track::TrackParCov& trc) -> bool {
-      if (!trc.rotate(tr.getAlpha())) {
-        LOGP(warn, "Rotation to original track alpha {} failed, track#{}[{}]", tr.getAlpha(), counter, trc.asString());
-        return false;
-      }
-      float xtgt = this->mXRef;
-      if (mUseR && !trc.getXatLabR(this->mXRef, xtgt, prop->getNominalBz(), o2::track::DirInward)) {
-        xtgt = 0;
-        return false;
-      }
-      if (!prop->PropagateToXBxByBz(trc, xtgt)) {
-        LOGP(warn, "Propagation to X={} failed, track#{}[{}]", xtgt, counter, trc.asString());
-        return false;
-      }
-      return true;
-    };
-
-    auto prepClus = [this, &tr, &clSector, &clRow, &clX, &clY, &clZ, &clXI, &clYI, &clZI](float t) { // extract cluster info
-      clSector.clear();
-      clRow.clear();
-      clXI.clear();
-      clYI.clear();
-      clZI.clear();
-      clX.clear();
-      clY.clear();
-      clZ.clear();
-      int count = tr.getNClusters();
-      const auto* corrMap = this->mTPCCorrMapsLoader.getCorrMap();
-      const o2::tpc::ClusterNative* cl = nullptr;
-      for (int ic = count; ic--;) {
-        uint8_t sector, row;
-        cl = &tr.getCluster(this->mTPCTrackClusIdx, ic, *this->mTPCClusterIdxStruct, sector, row);
-        clSector.push_back(sector);
-        clRow.push_back(row);
-        float x, y, z;
-        // ideal transformation without distortions
-        corrMap->TransformIdeal(sector, row, cl->getPad(), cl->getTime(), x, y, z, t); // nominal time of the track
-        clXI.push_back(x);
-        clYI.push_back(y);
-        clZI.push_back(z);
-
-        // transformation without distortions
-        mTPCCorrMapsLoader.Transform(sector, row, cl->getPad(), cl->getTime(), x, y, z, t); // nominal time of the track
-        clX.push_back(x);
-        clY.push_back(y);
-        clZ.push_back(z);
-      }
-    };
+  auto prepClus = [this](const o2::tpc::TrackTPC& tr, float t, TrackClusters& cls) { // extract cluster info
+    cls.clear();
+    int count = tr.getNClusters();
+    const auto* corrMap = this->mTPCCorrMapsLoader.getCorrMap();
+    const o2::tpc::ClusterNative* cl = nullptr;
+    for (int ic = count; ic--;) {
+      uint8_t sector, row;
+      cl = &tr.getCluster(this->mTPCTrackClusIdx, ic, *this->mTPCClusterIdxStruct, sector, row);
+      cls.sector.push_back(sector);
+      cls.row.push_back(row);
+      float x, y, z;
+      // ideal transformation without distortions
+      corrMap->TransformIdeal(sector, row, cl->getPad(), cl->getTime(), x, y, z, t); // nominal time of the track
+      cls.xI.push_back(x);
+      cls.yI.push_back(y);
+      cls.zI.push_back(z);
+
+      // transformation without distortions
+      mTPCCorrMapsLoader.Transform(sector, row, cl->getPad(), cl->getTime(), x, y, z, t); // nominal time of the track
+      cls.x.push_back(x);
+      cls.y.push_back(y);
+      cls.z.push_back(z);
+    }
+  };
 
-    //=========================================================================
+  //=========================================================================
+  // refit the tracks in parallel, the refitter, the propagator and the transformation are used concurrently as in the matching
+  const int nTracks = mTPCTracksArray.size();
+  std::vector<RefitResult> results(nTracks);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int itr = 0; itr < nTracks; itr++) {
+    auto& res = results[itr];
+    res.track = mTPCTracksArray[itr]; // create track copy
+    auto& tr = res.track;
+    if (tr.hasBothSidesClusters()) {
+      continue;
+    }
 
-    auto trf = tr.getOuterParam(); // we refit inward original track
-    float chi2refit = 0;
-    if (!trackRefit(trf, tr.getTime0(), chi2refit) || !trackProp(trf)) {
+    res.trackRef = tr.getOuterParam(); // we refit inward original track
+    if (!trackRefit(itr, res.trackRef, tr.getTime0(), res.chi2refit) || !trackProp(itr, tr.getAlpha(), res.trackRef)) {
       continue;
     }
 
     // propagate original track
-    if (!trackProp(tr)) {
+    if (!trackProp(itr, tr.getAlpha(), tr)) {
       continue;
     }
 
     if (mWriteTrackClusters) {
-      prepClus(tr.getTime0()); // original clusters
+      prepClus(tr, tr.getTime0(), res.clusters); // original clusters
     }
 
     if (mEnableDCA) {
-      dcar = dcaz = dcarRef = dcazRef = 9999.f;
-      if ((trf.getPt() > mDCAMinPt) && (tr.getNClusters() > mDCAMinNCl)) {
-        getDCAs(trf, dcarRef, dcazRef);
-        getDCAs(tr, dcar, dcaz);
+      if ((res.trackRef.getPt() > mDCAMinPt) && (tr.getNClusters() > mDCAMinNCl)) {
+        getDCAs(res.trackRef, res.dcarRef, res.dcazRef);
+        getDCAs(tr, res.dcar, res.dcaz);
       }
     }
+    res.isOK = true;
+  }
+
+  //=========================================================================
+  // impose MC time in TPC timebin and refit inward after resetted covariance
+  TrackClusters clustersMC;
+  auto refitWithMCTime = [&](size_t itr, const o2::tpc::TrackTPC& tr) {
+    // extract MC truth
+    const o2::MCTrack* mcTrack = nullptr;
+    auto lbl = mTPCTrkLabels[itr];
+    if (!lbl.isValid() || !(mcTrack = mcReader.getTrack(lbl))) {
+      return;
+    }
+    long bc = intRecs[lbl.getEventID()].toLong(); // bunch crossing of the interaction
+    float bcTB = bc / 8. + tpcTBBias;             // the same in TPC timebins, accounting for the TPC time bias
+    // create MC truth track in O2 format
+    std::array<float, 3> xyz{(float)mcTrack->GetStartVertexCoordinatesX(), (float)mcTrack->GetStartVertexCoordinatesY(), (float)mcTrack->GetStartVertexCoordinatesZ()},
+      pxyz{(float)mcTrack->GetStartVertexMomentumX(), (float)mcTrack->GetStartVertexMomentumY(), (float)mcTrack->GetStartVertexMomentumZ()};
+    TParticlePDG* pPDG = TDatabasePDG::Instance()->GetParticle(mcTrack->GetPdgCode());
+    if (!pPDG) {
+      return;
+    }
+    o2::track::TrackPar mctrO2(xyz, pxyz, TMath::Nint(pPDG->Charge() / 3), false);
+    //
+    // propagate it to the alpha/X of the reconstructed track
+    if (!mctrO2.rotate(tr.getAlpha()) || !prop->PropagateToXBxByBz(mctrO2, tr.getX())) {
+      return;
+    }
+    // now create a properly refitted track with correct time and distortions correction
+    auto trfm = tr.getOuterParam(); // we refit inward
+    // impose MC time in TPC timebin and refit inward after resetted covariance
+    float chi2refit = 0;
+    if (!trackRefit(itr, trfm, bcTB, chi2refit) || !trfm.rotate(tr.getAlpha()) || !prop->PropagateToXBxByBz(trfm, tr.getX())) {
+      LOGP(warn, "Failed to propagate MC-time refitted track#{} [{}] to X/alpha of original track [{}]", counter, trfm.asString(), tr.asString());
+      return;
+    }
+    // estimate Z shift in case of no-distortions
+    float dz = (tr.getTime0() - bcTB) * vdriftTB;
+    if (tr.hasCSideClustersOnly()) {
+      dz = -dz;
+    }
+    //
+    prepClus(tr, bcTB, clustersMC); // clusters for MC time
+    (*mDBGOut) << "tpcMC"
+               << "counter=" << counter
+               << "movTrackRef=" << trfm
+               << "mcTrack=" << mctrO2
+               << "imposedTB=" << bcTB
+               << "chi2refit=" << chi2refit
+               << "dz=" << dz
+               << "clX=" << clustersMC.x
+               << "clY=" << clustersMC.y
+               << "clZ=" << clustersMC.z
+               << "\n";
+  };
+
+  //=========================================================================
+  // store the results in the order of the tracks
+  for (int itr = 0; itr < nTracks; itr++) {
+    const auto& res = results[itr];
+    if (!res.isOK) {
+      continue;
+    }
+    const auto& tr = res.track;
 
     counter++;
     // store results
     (*mDBGOut) << "tpcIni"
                << "counter=" << counter
                << "iniTrack=" << tr
-               << "iniTrackRef=" << trf
+               << "iniTrackRef=" << res.trackRef
                << "time=" << tr.getTime0()
-               << "chi2refit=" << chi2refit;
+               << "chi2refit=" << res.chi2refit;
 
     if (mWriteTrackClusters) {
       (*mDBGOut) << "tpcIni"
-                 << "clSector=" << clSector
-                 << "clRow=" << clRow
-                 << "clX=" << clX
-                 << "clY=" << clY
-                 << "clZ=" << clZ
-                 << "clXI=" << clXI  // ideal (uncorrected) cluster positions
-                 << "clYI=" << clYI  // ideal (uncorrected) cluster positions
-                 << "clZI=" << clZI; // ideal (uncorrected) cluster positions
+                 << "clSector=" << res.clusters.sector
+                 << "clRow=" << res.clusters.row
+                 << "clX=" << res.clusters.x
+                 << "clY=" << res.clusters.y
+                 << "clZ=" << res.clusters.z
+                 << "clXI=" << res.clusters.xI  // ideal (uncorrected) cluster positions
+                 << "clYI=" << res.clusters.yI  // ideal (uncorrected) cluster positions
+                 << "clZI=" << res.clusters.zI; // ideal (uncorrected) cluster positions
     }
 
     if (mEnableDCA) {
       (*mDBGOut) << "tpcIni"
-                 << "dcar=" << dcar
-                 << "dcaz=" << dcaz
-                 << "dcarRef=" << dcarRef
-                 << "dcazRef=" << dcazRef;
+                 << "dcar=" << res.dcar
+                 << "dcaz=" << res.dcaz
+                 << "dcarRef=" << res.dcarRef
+                 << "dcazRef=" << res.dcazRef;
     }
 
     (*mDBGOut) << "tpcIni"
                << "\n";
 
-    float dz = 0;
-
-    if (mUseMC) { // impose MC time in TPC timebin and refit inward after resetted covariance
-      // extract MC truth
-      const o2::MCTrack* mcTrack = nullptr;
-      auto lbl = mTPCTrkLabels[itr];
-      if (!lbl.isValid() || !(mcTrack = mcReader.getTrack(lbl))) {
-        break;
-      }
-      long bc = intRecs[lbl.getEventID()].toLong(); // bunch crossing of the interaction
-      float bcTB = bc / 8. + tpcTBBias;             // the same in TPC timebins, accounting for the TPC time bias
-      // create MC truth track in O2 format
-      std::array<float, 3> xyz{(float)mcTrack->GetStartVertexCoordinatesX(), (float)mcTrack->GetStartVertexCoordinatesY(), (float)mcTrack->GetStartVertexCoordinatesZ()},
-        pxyz{(float)mcTrack->GetStartVertexMomentumX(), (float)mcTrack->GetStartVertexMomentumY(), (float)mcTrack->GetStartVertexMomentumZ()};
-      TParticlePDG* pPDG = TDatabasePDG::Instance()->GetParticle(mcTrack->GetPdgCode());
-      if (!pPDG) {
-        break;
-      }
-      o2::track::TrackPar mctrO2(xyz, pxyz, TMath::Nint(pPDG->Charge() / 3), false);
-      //
-      // propagate it to the alpha/X of the reconstructed track
-      if (!mctrO2.rotate(tr.getAlpha()) || !prop->PropagateToXBxByBz(mctrO2, tr.getX())) {
-        break;
-      }
-      // now create a properly refitted track with correct time and distortions correction
-      {
-        auto trfm = tr.getOuterParam(); // we refit inward
-        // impose MC time in TPC timebin and refit inward after resetted covariance
-        float chi2refit = 0;
-        if (!trackRefit(trfm, bcTB, chi2refit) || !trfm.rotate(tr.getAlpha()) || !prop->PropagateToXBxByBz(trfm, tr.getX())) {
-          LOGP(warn, "Failed to propagate MC-time refitted track#{} [{}] to X/alpha of original track [{}]", counter, trfm.asString(), tr.asString());
-          break;
-        }
-        // estimate Z shift in case of no-distortions
-        dz = (tr.getTime0() - bcTB) * vdriftTB;
-        if (tr.hasCSideClustersOnly()) {
-          dz = -dz;
-        }
-        //
-        prepClus(bcTB); // clusters for MC time
-        (*mDBGOut) << "tpcMC"
-                   << "counter=" << counter
-                   << "movTrackRef=" << trfm
-                   << "mcTrack=" << mctrO2
-                   << "imposedTB=" << bcTB
-                   << "chi2refit=" << chi2refit
-                   << "dz=" << dz
-                   << "clX=" << clX
-                   << "clY=" << clY
-                   << "clZ=" << clZ
-                   << "\n";
-      }
-      break;
+    if (mUseMC) {
+      refitWithMCTime(itr, tr);
     }
   }
 }
@@ -459,6 +507,7 @@ DataProcessorSpec getTPCRefitterSpec(GTrackID::mask_t srcTracks, GTrackID::mask_
     {"enable-dcas", VariantType::Bool, false, {"Propagate to DCA and add it to the tree"}},
     {"dcaMinPt", VariantType::Float, 1.f, {"Min pT of tracks propagated to DCA"}},
     {"dcaMinNCl", VariantType::Int, 80, {"Min number of clusters for tracks propagated to DCA"}},
+    {"nthreads", VariantType::Int, 1, {"Number of threads used to refit the tracks"}},
   };
   auto dataRequest = std::make_shared<DataRequest>();
 
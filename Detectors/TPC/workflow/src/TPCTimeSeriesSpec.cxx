@@ -428,360 +428,374 @@ class TPCTimeSeries : public Task
       }
     }
 
-    // fill DCA values from buffer
-    for (const auto& vals : mBufferVals) {
-      for (int type = 0; type < vals.size(); ++type) {
-        const auto& val = vals[type];
-        const auto nPoints = val.side.size();
-        for (int i = 0; i < nPoints; ++i) {
-          const auto tglBin = val.tglBin[i];
-          const auto phiBin = val.phiBin[i];
-          const auto qPtBin = val.qPtBin[i];
-          const auto multBin = val.multBin[i];
-          const auto dcar = val.dcar[i];
-          const auto dcaz = val.dcaz[i];
-          const auto dcarW = val.dcarW[i];
-          const int binInt = nBins - 1;
-          const bool fillCombDCA = ((type == 1) && (val.dcarcomb[i] != -1) && (val.dcazcomb[i] != -1));
-          const bool fillDCAR = (type == 1) ? (dcar != -999) : true;
-          const std::array<int, 5> bins{tglBin, phiBin, qPtBin, multBin, binInt};
-          // fill bins
-          for (auto bin : bins) {
-            if (val.side[i] == Side::C) {
-              if (fillDCAR) {
-                mAvgCDCAr[bin][type].addValue(dcar, dcarW);
+    // fill DCA values from buffer, each thread fills only its own bins to keep the order of the filled values
+    runThreads([&](int iThread) {
+      for (const auto& vals : mBufferVals) {
+        for (int type = 0; type < vals.size(); ++type) {
+          const auto& val = vals[type];
+          const auto nPoints = val.side.size();
+          for (int i = 0; i < nPoints; ++i) {
+            const auto tglBin = val.tglBin[i];
+            const auto phiBin = val.phiBin[i];
+            const auto qPtBin = val.qPtBin[i];
+            const auto multBin = val.multBin[i];
+            const auto dcar = val.dcar[i];
+            const auto dcaz = val.dcaz[i];
+            const auto dcarW = val.dcarW[i];
+            const int binInt = nBins - 1;
+            const bool fillCombDCA = ((type == 1) && (val.dcarcomb[i] != -1) && (val.dcazcomb[i] != -1));
+            const bool fillDCAR = (type == 1) ? (dcar != -999) : true;
+            const std::array<int, 5> bins{tglBin, phiBin, qPtBin, multBin, binInt};
+            // fill bins
+            for (auto bin : bins) {
+              if ((bin % mNThreads) != iThread) {
+                continue;
               }
-              if (fillCombDCA) {
-                mAvgCDCAr[bin][2].addValue(val.dcarcomb[i], dcarW);
-                mAvgCDCAz[bin][2].addValue(val.dcazcomb[i], dcarW);
-              }
-              // fill only in case of valid value
-              if (dcaz != 0) {
-                mAvgCDCAz[bin][type].addValue(dcaz, dcarW);
-              }
-            } else {
-              if (fillDCAR) {
-                mAvgADCAr[bin][type].addValue(dcar, dcarW);
-              }
-              if (fillCombDCA) {
-                mAvgADCAr[bin][2].addValue(val.dcarcomb[i], dcarW);
-                mAvgADCAz[bin][2].addValue(val.dcazcomb[i], dcarW);
-              }
-              // fill only in case of valid value
-              if (dcaz != 0) {
-                mAvgADCAz[bin][type].addValue(dcaz, dcarW);
+              if (val.side[i] == Side::C) {
+                if (fillDCAR) {
+                  mAvgCDCAr[bin][type].addValue(dcar, dcarW);
+                }
+                if (fillCombDCA) {
+                  mAvgCDCAr[bin][2].addValue(val.dcarcomb[i], dcarW);
+                  mAvgCDCAz[bin][2].addValue(val.dcazcomb[i], dcarW);
+                }
+                // fill only in case of valid value
+                if (dcaz != 0) {
+                  mAvgCDCAz[bin][type].addValue(dcaz, dcarW);
+                }
+              } else {
+                if (fillDCAR) {
+                  mAvgADCAr[bin][type].addValue(dcar, dcarW);
+                }
+                if (fillCombDCA) {
+                  mAvgADCAr[bin][2].addValue(val.dcarcomb[i], dcarW);
+                  mAvgADCAz[bin][2].addValue(val.dcazcomb[i], dcarW);
+                }
+                // fill only in case of valid value
+                if (dcaz != 0) {
+                  mAvgADCAz[bin][type].addValue(dcaz, dcarW);
+                }
               }
             }
           }
         }
       }
-    }
+    });
 
     // calculate statistics and store values
-    // loop over TPC sides
-    for (int type = 0; type < 2; ++type) {
+    runThreads([&](int iThread) {
       // loop over phi and tgl bins
-      for (int slice = 0; slice < nBins; ++slice) {
-        auto& bufferDCA = (type == 0) ? mBufferDCA.mTSTPC : mBufferDCA.mTSITSTPC;
-
-        const auto dcaAr = mAvgADCAr[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
-        bufferDCA.mDCAr_A_Median[slice] = std::get<0>(dcaAr);
-        bufferDCA.mDCAr_A_WeightedMean[slice] = std::get<1>(dcaAr);
-        bufferDCA.mDCAr_A_RMS[slice] = std::get<2>(dcaAr);
-        bufferDCA.mDCAr_A_NTracks[slice] = std::get<3>(dcaAr);
-
-        const auto dcaAz = mAvgADCAz[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
-        bufferDCA.mDCAz_A_Median[slice] = std::get<0>(dcaAz);
-        bufferDCA.mDCAz_A_WeightedMean[slice] = std::get<1>(dcaAz);
-        bufferDCA.mDCAz_A_RMS[slice] = std::get<2>(dcaAz);
-        bufferDCA.mDCAz_A_NTracks[slice] = std::get<3>(dcaAz);
-
-        const auto dcaCr = mAvgCDCAr[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
-        bufferDCA.mDCAr_C_Median[slice] = std::get<0>(dcaCr);
-        bufferDCA.mDCAr_C_WeightedMean[slice] = std::get<1>(dcaCr);
-        bufferDCA.mDCAr_C_RMS[slice] = std::get<2>(dcaCr);
-        bufferDCA.mDCAr_C_NTracks[slice] = std::get<3>(dcaCr);
-
-        const auto dcaCz = mAvgCDCAz[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
-        bufferDCA.mDCAz_C_Median[slice] = std::get<0>(dcaCz);
-        bufferDCA.mDCAz_C_WeightedMean[slice] = std::get<1>(dcaCz);
-        bufferDCA.mDCAz_C_RMS[slice] = std::get<2>(dcaCz);
-        bufferDCA.mDCAz_C_NTracks[slice] = std::get<3>(dcaCz);
-        // store combined ITS-TPC DCAs
-        if (type == 1) {
-          const auto dcaArComb = mAvgADCAr[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
-          mBufferDCA.mDCAr_comb_A_Median[slice] = std::get<0>(dcaArComb);
-          mBufferDCA.mDCAr_comb_A_RMS[slice] = std::get<2>(dcaArComb);
-
-          const auto dcaAzCom = mAvgADCAz[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
-          mBufferDCA.mDCAz_comb_A_Median[slice] = std::get<0>(dcaAzCom);
-          mBufferDCA.mDCAz_comb_A_RMS[slice] = std::get<2>(dcaAzCom);
-
-          const auto dcaCrComb = mAvgCDCAr[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
-          mBufferDCA.mDCAr_comb_C_Median[slice] = std::get<0>(dcaCrComb);
-          mBufferDCA.mDCAr_comb_C_RMS[slice] = std::get<2>(dcaCrComb);
-
-          const auto dcaCzComb = mAvgCDCAz[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
-          mBufferDCA.mDCAz_comb_C_Median[slice] = std::get<0>(dcaCzComb);
-          mBufferDCA.mDCAz_comb_C_RMS[slice] = std::get<2>(dcaCzComb);
+      for (int slice = iThread; slice < nBins; slice += mNThreads) {
+        // loop over TPC and ITS-TPC tracks
+        for (int type = 0; type < 2; ++type) {
+          auto& bufferDCA = (type == 0) ? mBufferDCA.mTSTPC : mBufferDCA.mTSITSTPC;
+
+          const auto dcaAr = mAvgADCAr[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
+          bufferDCA.mDCAr_A_Median[slice] = std::get<0>(dcaAr);
+          bufferDCA.mDCAr_A_WeightedMean[slice] = std::get<1>(dcaAr);
+          bufferDCA.mDCAr_A_RMS[slice] = std::get<2>(dcaAr);
+          bufferDCA.mDCAr_A_NTracks[slice] = std::get<3>(dcaAr);
+
+          const auto dcaAz = mAvgADCAz[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
+          bufferDCA.mDCAz_A_Median[slice] = std::get<0>(dcaAz);
+          bufferDCA.mDCAz_A_WeightedMean[slice] = std::get<1>(dcaAz);
+          bufferDCA.mDCAz_A_RMS[slice] = std::get<2>(dcaAz);
+          bufferDCA.mDCAz_A_NTracks[slice] = std::get<3>(dcaAz);
+
+          const auto dcaCr = mAvgCDCAr[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
+          bufferDCA.mDCAr_C_Median[slice] = std::get<0>(dcaCr);
+          bufferDCA.mDCAr_C_WeightedMean[slice] = std::get<1>(dcaCr);
+          bufferDCA.mDCAr_C_RMS[slice] = std::get<2>(dcaCr);
+          bufferDCA.mDCAr_C_NTracks[slice] = std::get<3>(dcaCr);
+
+          const auto dcaCz = mAvgCDCAz[slice][type].filterPointsMedian(mCutDCA, mCutRMS);
+          bufferDCA.mDCAz_C_Median[slice] = std::get<0>(dcaCz);
+          bufferDCA.mDCAz_C_WeightedMean[slice] = std::get<1>(dcaCz);
+          bufferDCA.mDCAz_C_RMS[slice] = std::get<2>(dcaCz);
+          bufferDCA.mDCAz_C_NTracks[slice] = std::get<3>(dcaCz);
+          // store combined ITS-TPC DCAs
+          if (type == 1) {
+            const auto dcaArComb = mAvgADCAr[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
+            mBufferDCA.mDCAr_comb_A_Median[slice] = std::get<0>(dcaArComb);
+            mBufferDCA.mDCAr_comb_A_RMS[slice] = std::get<2>(dcaArComb);
+
+            const auto dcaAzCom = mAvgADCAz[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
+            mBufferDCA.mDCAz_comb_A_Median[slice] = std::get<0>(dcaAzCom);
+            mBufferDCA.mDCAz_comb_A_RMS[slice] = std::get<2>(dcaAzCom);
+
+            const auto dcaCrComb = mAvgCDCAr[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
+            mBufferDCA.mDCAr_comb_C_Median[slice] = std::get<0>(dcaCrComb);
+            mBufferDCA.mDCAr_comb_C_RMS[slice] = std::get<2>(dcaCrComb);
+
+            const auto dcaCzComb = mAvgCDCAz[slice][2].filterPointsMedian(mCutDCA, mCutRMS);
+            mBufferDCA.mDCAz_comb_C_Median[slice] = std::get<0>(dcaCzComb);
+            mBufferDCA.mDCAz_comb_C_RMS[slice] = std::get<2>(dcaCzComb);
+          }
         }
       }
-    }
+    });
 
     // calculate matching eff
-    for (const auto& vals : mBufferVals) {
-      const auto& val = vals.front();
-      const auto nPoints = val.side.size();
-      for (int i = 0; i < nPoints; ++i) {
-        const auto tglBin = val.tglBin[i];
-        const auto phiBin = val.phiBin[i];
-        const auto qPtBin = val.qPtBin[i];
-        const auto multBin = val.multBin[i];
-        const auto dcar = val.dcar[i];
-        const auto dcaz = val.dcaz[i];
-        const auto hasITS = val.hasITS[i];
-        const auto chi2Match = val.chi2Match[i];
-        const auto dedxRatioqMax = val.dedxRatioqMax[i];
-        const auto dedxRatioqTot = val.dedxRatioqTot[i];
-        const auto sqrtChi2TPC = val.sqrtChi2TPC[i];
-        const auto nClTPC = val.nClTPC[i];
-        const int binInt = nBins - 1;
-        const Side side = val.side[i];
-        const bool isCSide = (side == Side::C);
-        const auto& bufferDCARMSR = isCSide ? mBufferDCA.mTSTPC.mDCAr_C_RMS : mBufferDCA.mTSTPC.mDCAr_A_RMS;
-        const auto& bufferDCARMSZ = isCSide ? mBufferDCA.mTSTPC.mDCAz_C_RMS : mBufferDCA.mTSTPC.mDCAz_A_RMS;
-        const auto& bufferDCAMedR = isCSide ? mBufferDCA.mTSTPC.mDCAr_C_Median : mBufferDCA.mTSTPC.mDCAr_A_Median;
-        const auto& bufferDCAMedZ = isCSide ? mBufferDCA.mTSTPC.mDCAz_C_Median : mBufferDCA.mTSTPC.mDCAz_A_Median;
-        auto& mAvgEff = isCSide ? mAvgMeffC : mAvgMeffA;
-        auto& mAvgChi2Match = isCSide ? mAvgChi2MatchC : mAvgChi2MatchA;
-        auto& mAvgmMIPdEdxRatioqMax = isCSide ? mMIPdEdxRatioQMaxC : mMIPdEdxRatioQMaxA;
-        auto& mAvgmMIPdEdxRatioqTot = isCSide ? mMIPdEdxRatioQTotC : mMIPdEdxRatioQTotA;
-        auto& mAvgmTPCChi2 = isCSide ? mTPCChi2C : mTPCChi2A;
-        auto& mAvgmTPCNCl = isCSide ? mTPCNClC : mTPCNClA;
-        auto& mAvgmdEdxRatioQMax = isCSide ? mLogdEdxQMaxC : mLogdEdxQMaxA;
-        auto& mAvgmdEdxRatioQTot = isCSide ? mLogdEdxQTotC : mLogdEdxQTotA;
-        auto& mITSProperties = isCSide ? mITSPropertiesC : mITSPropertiesA;
-        auto& mSigmaYZ = isCSide ? mSigmaYZC : mSigmaYZA;
-        auto& mITSTPCDeltaP = isCSide ? mITSTPCDeltaPC : mITSTPCDeltaPA;
-
-        const std::array<int, 5> bins{tglBin, phiBin, qPtBin, multBin, binInt};
-        // fill bins
-        for (auto bin : bins) {
-          // make DCA cut - select only good tracks
-          if ((std::abs(dcar - bufferDCAMedR[bin]) < (bufferDCARMSR[bin] * mCutRMS)) && (std::abs(dcaz - bufferDCAMedZ[bin]) < (bufferDCARMSZ[bin] * mCutRMS))) {
-            const auto gID = val.gID[i];
-            mAvgEff[bin][0].addValue(hasITS);
-            // count tpc only tracks not matched
-            if (!hasITS) {
-              mAvgEff[bin][1].addValue(hasITS);
-              mAvgEff[bin][2].addValue(hasITS);
-            }
-            // count tracks from ITS standalone and afterburner
-            if (gID == o2::dataformats::GlobalTrackID::Source::ITS) {
-              mAvgEff[bin][1].addValue(hasITS);
-            } else if (gID == o2::dataformats::GlobalTrackID::Source::ITSAB) {
-              mAvgEff[bin][2].addValue(hasITS);
+    runThreads([&](int iThread) {
+      for (const auto& vals : mBufferVals) {
+        const auto& val = vals.front();
+        const auto nPoints = val.side.size();
+        for (int i = 0; i < nPoints; ++i) {
+          const auto tglBin = val.tglBin[i];
+          const auto phiBin = val.phiBin[i];
+          const auto qPtBin = val.qPtBin[i];
+          const auto multBin = val.multBin[i];
+          const auto dcar = val.dcar[i];
+          const auto dcaz = val.dcaz[i];
+          const auto hasITS = val.hasITS[i];
+          const auto chi2Match = val.chi2Match[i];
+          const auto dedxRatioqMax = val.dedxRatioqMax[i];
+          const auto dedxRatioqTot = val.dedxRatioqTot[i];
+          const auto sqrtChi2TPC = val.sqrtChi2TPC[i];
+          const auto nClTPC = val.nClTPC[i];
+          const int binInt = nBins - 1;
+          const Side side = val.side[i];
+          const bool isCSide = (side == Side::C);
+          const auto& bufferDCARMSR = isCSide ? mBufferDCA.mTSTPC.mDCAr_C_RMS : mBufferDCA.mTSTPC.mDCAr_A_RMS;
+          const auto& bufferDCARMSZ = isCSide ? mBufferDCA.mTSTPC.mDCAz_C_RMS : mBufferDCA.mTSTPC.mDCAz_A_RMS;
+          const auto& bufferDCAMedR = isCSide ? mBufferDCA.mTSTPC.mDCAr_C_Median : mBufferDCA.mTSTPC.mDCAr_A_Median;
+          const auto& bufferDCAMedZ = isCSide ? mBufferDCA.mTSTPC.mDCAz_C_Median : mBufferDCA.mTSTPC.mDCAz_A_Median;
+          auto& mAvgEff = isCSide ? mAvgMeffC : mAvgMeffA;
+          auto& mAvgChi2Match = isCSide ? mAvgChi2MatchC : mAvgChi2MatchA;
+          auto& mAvgmMIPdEdxRatioqMax = isCSide ? mMIPdEdxRatioQMaxC : mMIPdEdxRatioQMaxA;
+          auto& mAvgmMIPdEdxRatioqTot = isCSide ? mMIPdEdxRatioQTotC : mMIPdEdxRatioQTotA;
+          auto& mAvgmTPCChi2 = isCSide ? mTPCChi2C : mTPCChi2A;
+          auto& mAvgmTPCNCl = isCSide ? mTPCNClC : mTPCNClA;
+          auto& mAvgmdEdxRatioQMax = isCSide ? mLogdEdxQMaxC : mLogdEdxQMaxA;
+          auto& mAvgmdEdxRatioQTot = isCSide ? mLogdEdxQTotC : mLogdEdxQTotA;
+          auto& mITSProperties = isCSide ? mITSPropertiesC : mITSPropertiesA;
+          auto& mSigmaYZ = isCSide ? mSigmaYZC : mSigmaYZA;
+          auto& mITSTPCDeltaP = isCSide ? mITSTPCDeltaPC : mITSTPCDeltaPA;
+
+          const std::array<int, 5> bins{tglBin, phiBin, qPtBin, multBin, binInt};
+          // fill bins
+          for (auto bin : bins) {
+            if ((bin % mNThreads) != iThread) {
+              continue;
             }
-            if (chi2Match > 0) {
-              mAvgChi2Match[bin][0].addValue(chi2Match);
+            // make DCA cut - select only good tracks
+            if ((std::abs(dcar - bufferDCAMedR[bin]) < (bufferDCARMSR[bin] * mCutRMS)) && (std::abs(dcaz - bufferDCAMedZ[bin]) < (bufferDCARMSZ[bin] * mCutRMS))) {
+              const auto gID = val.gID[i];
+              mAvgEff[bin][0].addValue(hasITS);
+              // count tpc only tracks not matched
+              if (!hasITS) {
+                mAvgEff[bin][1].addValue(hasITS);
+                mAvgEff[bin][2].addValue(hasITS);
+              }
+              // count tracks from ITS standalone and afterburner
               if (gID == o2::dataformats::GlobalTrackID::Source::ITS) {
-                mAvgChi2Match[bin][1].addValue(chi2Match);
+                mAvgEff[bin][1].addValue(hasITS);
               } else if (gID == o2::dataformats::GlobalTrackID::Source::ITSAB) {
-                mAvgChi2Match[bin][2].addValue(chi2Match);
+                mAvgEff[bin][2].addValue(hasITS);
+              }
+              if (chi2Match > 0) {
+                mAvgChi2Match[bin][0].addValue(chi2Match);
+                if (gID == o2::dataformats::GlobalTrackID::Source::ITS) {
+                  mAvgChi2Match[bin][1].addValue(chi2Match);
+                } else if (gID == o2::dataformats::GlobalTrackID::Source::ITSAB) {
+                  mAvgChi2Match[bin][2].addValue(chi2Match);
+                }
               }
-            }
-            if (dedxRatioqMax > 0) {
-              mAvgmMIPdEdxRatioqMax[bin][0].addValue(dedxRatioqMax);
-            }
-            if (dedxRatioqTot > 0) {
-              mAvgmMIPdEdxRatioqTot[bin][0].addValue(dedxRatioqTot);
-            }
-            mAvgmTPCChi2[bin][0].addValue(sqrtChi2TPC);
-            mAvgmTPCNCl[bin][0].addValue(nClTPC);
-            if (hasITS) {
               if (dedxRatioqMax > 0) {
-                mAvgmMIPdEdxRatioqMax[bin][1].addValue(dedxRatioqMax);
+                mAvgmMIPdEdxRatioqMax[bin][0].addValue(dedxRatioqMax);
               }
               if (dedxRatioqTot > 0) {
-                mAvgmMIPdEdxRatioqTot[bin][1].addValue(dedxRatioqTot);
+                mAvgmMIPdEdxRatioqTot[bin][0].addValue(dedxRatioqTot);
+              }
+              mAvgmTPCChi2[bin][0].addValue(sqrtChi2TPC);
+              mAvgmTPCNCl[bin][0].addValue(nClTPC);
+              if (hasITS) {
+                if (dedxRatioqMax > 0) {
+                  mAvgmMIPdEdxRatioqMax[bin][1].addValue(dedxRatioqMax);
+                }
+                if (dedxRatioqTot > 0) {
+                  mAvgmMIPdEdxRatioqTot[bin][1].addValue(dedxRatioqTot);
+                }
+                mAvgmTPCChi2[bin][1].addValue(sqrtChi2TPC);
+                mAvgmTPCNCl[bin][1].addValue(nClTPC);
               }
-              mAvgmTPCChi2[bin][1].addValue(sqrtChi2TPC);
-              mAvgmTPCNCl[bin][1].addValue(nClTPC);
-            }
 
-            float dedxNormQMax = val.dedxValsqMax[i].dedxNorm;
-            if (dedxNormQMax > 0) {
-              mAvgmdEdxRatioQMax[bin][0].addValue(dedxNormQMax);
-            }
+              float dedxNormQMax = val.dedxValsqMax[i].dedxNorm;
+              if (dedxNormQMax > 0) {
+                mAvgmdEdxRatioQMax[bin][0].addValue(dedxNormQMax);
+              }
 
-            float dedxNormQTot = val.dedxValsqTot[i].dedxNorm;
-            if (dedxNormQTot > 0) {
-              mAvgmdEdxRatioQTot[bin][0].addValue(dedxNormQTot);
-            }
+              float dedxNormQTot = val.dedxValsqTot[i].dedxNorm;
+              if (dedxNormQTot > 0) {
+                mAvgmdEdxRatioQTot[bin][0].addValue(dedxNormQTot);
+              }
 
-            float dedxIROCQMax = val.dedxValsqMax[i].dedxIROC;
-            if (dedxIROCQMax > 0) {
-              mAvgmdEdxRatioQMax[bin][1].addValue(dedxIROCQMax);
-            }
+              float dedxIROCQMax = val.dedxValsqMax[i].dedxIROC;
+              if (dedxIROCQMax > 0) {
+                mAvgmdEdxRatioQMax[bin][1].addValue(dedxIROCQMax);
+              }
 
-            float dedxIROCQTot = val.dedxValsqTot[i].dedxIROC;
-            if (dedxIROCQTot > 0) {
-              mAvgmdEdxRatioQTot[bin][1].addValue(dedxIROCQTot);
-            }
+              float dedxIROCQTot = val.dedxValsqTot[i].dedxIROC;
+              if (dedxIROCQTot > 0) {
+                mAvgmdEdxRatioQTot[bin][1].addValue(dedxIROCQTot);
+              }
 
-            float dedxOROC1QMax = val.dedxValsqMax[i].dedxOROC1;
-            if (dedxOROC1QMax > 0) {
-              mAvgmdEdxRatioQMax[bin][2].addValue(dedxOROC1QMax);
-            }
+              float dedxOROC1QMax = val.dedxValsqMax[i].dedxOROC1;
+              if (dedxOROC1QMax > 0) {
+                mAvgmdEdxRatioQMax[bin][2].addValue(dedxOROC1QMax);
+              }
 
-            float dedxOROC1QTot = val.dedxValsqTot[i].dedxOROC1;
-            if (dedxOROC1QTot > 0) {
-              mAvgmdEdxRatioQTot[bin][2].addValue(dedxOROC1QTot);
-            }
+              float dedxOROC1QTot = val.dedxValsqTot[i].dedxOROC1;
+              if (dedxOROC1QTot > 0) {
+                mAvgmdEdxRatioQTot[bin][2].addValue(dedxOROC1QTot);
+              }
 
-            float dedxOROC2QMax = val.dedxValsqMax[i].dedxOROC2;
-            if (dedxOROC2QMax > 0) {
-              mAvgmdEdxRatioQMax[bin][3].addValue(dedxOROC2QMax);
-            }
+              float dedxOROC2QMax = val.dedxValsqMax[i].dedxOROC2;
+              if (dedxOROC2QMax > 0) {
+                mAvgmdEdxRatioQMax[bin][3].addValue(dedxOROC2QMax);
+              }
 
-            float dedxOROC2QTot = val.dedxValsqTot[i].dedxOROC2;
-            if (dedxOROC2QTot > 0) {
-              mAvgmdEdxRatioQTot[bin][3].addValue(dedxOROC2QTot);
-            }
+              float dedxOROC2QTot = val.dedxValsqTot[i].dedxOROC2;
+              if (dedxOROC2QTot > 0) {
+                mAvgmdEdxRatioQTot[bin][3].addValue(dedxOROC2QTot);
+              }
 
-            float dedxOROC3QMax = val.dedxValsqMax[i].dedxOROC3;
-            if (dedxOROC3QMax > 0) {
-              mAvgmdEdxRatioQMax[bin][4].addValue(dedxOROC3QMax);
-            }
+              float dedxOROC3QMax = val.dedxValsqMax[i].dedxOROC3;
+              if (dedxOROC3QMax > 0) {
+                mAvgmdEdxRatioQMax[bin][4].addValue(dedxOROC3QMax);
+              }
 
-            float dedxOROC3QTot = val.dedxValsqTot[i].dedxOROC3;
-            if (dedxOROC3QTot > 0) {
-              mAvgmdEdxRatioQTot[bin][4].addValue(dedxOROC3QTot);
-            }
+              float dedxOROC3QTot = val.dedxValsqTot[i].dedxOROC3;
+              if (dedxOROC3QTot > 0) {
+                mAvgmdEdxRatioQTot[bin][4].addValue(dedxOROC3QTot);
+              }
 
-            float nClITS = val.nClITS[i];
-            if (nClITS > 0) {
-              mITSProperties[bin][0].addValue(nClITS);
-            }
-            float chi2ITS = val.chi2ITS[i];
-            if (chi2ITS > 0) {
-              mITSProperties[bin][1].addValue(chi2ITS);
-            }
+              float nClITS = val.nClITS[i];
+              if (nClITS > 0) {
+                mITSProperties[bin][0].addValue(nClITS);
+              }
+              float chi2ITS = val.chi2ITS[i];
+              if (chi2ITS > 0) {
+                mITSProperties[bin][1].addValue(chi2ITS);
+              }
 
-            float sigmay2 = val.sigmaY2[i];
-            if (sigmay2 > 0) {
-              mSigmaYZ[bin][0].addValue(sigmay2);
-            }
-            float sigmaz2 = val.sigmaZ2[i];
-            if (sigmaz2 > 0) {
-              mSigmaYZ[bin][1].addValue(sigmaz2);
-            }
+              float sigmay2 = val.sigmaY2[i];
+              if (sigmay2 > 0) {
+                mSigmaYZ[bin][0].addValue(sigmay2);
+              }
+              float sigmaz2 = val.sigmaZ2[i];
+              if (sigmaz2 > 0) {
+                mSigmaYZ[bin][1].addValue(sigmaz2);
+              }
 
-            float deltaP2 = val.deltaP2[i];
-            if (deltaP2 != -999) {
-              mITSTPCDeltaP[bin][0].addValue(deltaP2);
-            }
+              float deltaP2 = val.deltaP2[i];
+              if (deltaP2 != -999) {
+                mITSTPCDeltaP[bin][0].addValue(deltaP2);
+              }
 
-            float deltaP3 = val.deltaP3[i];
-            if (deltaP3 != -999) {
-              mITSTPCDeltaP[bin][1].addValue(deltaP3);
-            }
+              float deltaP3 = val.deltaP3[i];
+              if (deltaP3 != -999) {
+                mITSTPCDeltaP[bin][1].addValue(deltaP3);
+              }
 
-            float deltaP4 = val.deltaP4[i];
-            if (deltaP4 != -999) {
-              mITSTPCDeltaP[bin][2].addValue(deltaP4);
+              float deltaP4 = val.deltaP4[i];
+              if (deltaP4 != -999) {
+                mITSTPCDeltaP[bin][2].addValue(deltaP4);
+              }
             }
           }
         }
       }
-    }
+    });
 
     // store matching eff
-    for (int slice = 0; slice < nBins; ++slice) {
-      for (int i = 0; i < mAvgMeffA[slice].size(); ++i) {
-        auto& itsBuf = (i == 0) ? mBufferDCA.mITSTPCAll : ((i == 1) ? mBufferDCA.mITSTPCStandalone : mBufferDCA.mITSTPCAfterburner);
-        itsBuf.mITSTPC_A_MatchEff[slice] = mAvgMeffA[slice][i].getMean();
-        itsBuf.mITSTPC_C_MatchEff[slice] = mAvgMeffC[slice][i].getMean();
-        itsBuf.mITSTPC_A_Chi2Match[slice] = mAvgChi2MatchA[slice][i].getMean();
-        itsBuf.mITSTPC_C_Chi2Match[slice] = mAvgChi2MatchC[slice][i].getMean();
-      }
+    runThreads([&](int iThread) {
+      for (int slice = iThread; slice < nBins; slice += mNThreads) {
+        for (int i = 0; i < mAvgMeffA[slice].size(); ++i) {
+          auto& itsBuf = (i == 0) ? mBufferDCA.mITSTPCAll : ((i == 1) ? mBufferDCA.mITSTPCStandalone : mBufferDCA.mITSTPCAfterburner);
+          itsBuf.mITSTPC_A_MatchEff[slice] = mAvgMeffA[slice][i].getMean();
+          itsBuf.mITSTPC_C_MatchEff[slice] = mAvgMeffC[slice][i].getMean();
+          itsBuf.mITSTPC_A_Chi2Match[slice] = mAvgChi2MatchA[slice][i].getMean();
+          itsBuf.mITSTPC_C_Chi2Match[slice] = mAvgChi2MatchC[slice][i].getMean();
+        }
 
-      // loop over TPC and ITS-TPC tracks
-      for (int i = 0; i < mMIPdEdxRatioQMaxC[slice].size(); ++i) {
-        auto& buff = (i == 0) ? mBufferDCA.mTSTPC : mBufferDCA.mTSITSTPC;
-        buff.mMIPdEdxRatioQMaxA[slice] = mMIPdEdxRatioQMaxA[slice][i].getMean();
-        buff.mMIPdEdxRatioQMaxC[slice] = mMIPdEdxRatioQMaxC[slice][i].getMean();
-        buff.mMIPdEdxRatioQTotA[slice] = mMIPdEdxRatioQTotA[slice][i].getMean();
-        buff.mMIPdEdxRatioQTotC[slice] = mMIPdEdxRatioQTotC[slice][i].getMean();
-        buff.mTPCChi2C[slice] = mTPCChi2C[slice][i].getMean();
-        buff.mTPCChi2A[slice] = mTPCChi2A[slice][i].getMean();
-        buff.mTPCNClC[slice] = mTPCNClC[slice][i].getMean();
-        buff.mTPCNClA[slice] = mTPCNClA[slice][i].getMean();
-      }
+        // loop over TPC and ITS-TPC tracks
+        for (int i = 0; i < mMIPdEdxRatioQMaxC[slice].size(); ++i) {
+          auto& buff = (i == 0) ? mBufferDCA.mTSTPC : mBufferDCA.mTSITSTPC;
+          buff.mMIPdEdxRatioQMaxA[slice] = mMIPdEdxRatioQMaxA[slice][i].getMean();
+          buff.mMIPdEdxRatioQMaxC[slice] = mMIPdEdxRatioQMaxC[slice][i].getMean();
+          buff.mMIPdEdxRatioQTotA[slice] = mMIPdEdxRatioQTotA[slice][i].getMean();
+          buff.mMIPdEdxRatioQTotC[slice] = mMIPdEdxRatioQTotC[slice][i].getMean();
+          buff.mTPCChi2C[slice] = mTPCChi2C[slice][i].getMean();
+          buff.mTPCChi2A[slice] = mTPCChi2A[slice][i].getMean();
+          buff.mTPCNClC[slice] = mTPCNClC[slice][i].getMean();
+          buff.mTPCNClA[slice] = mTPCNClA[slice][i].getMean();
+        }
 
-      // loop over qMax and qTot
-      for (int type = 0; type < 2; ++type) {
-        auto& logdEdxA = (type == 0) ? mLogdEdxQMaxA : mLogdEdxQTotA;
-        auto& buffer = (type == 0) ? mBufferDCA.mdEdxQMax : mBufferDCA.mdEdxQTot;
-        // fill A-side
-        buffer.mLogdEdx_A_Median[slice] = logdEdxA[slice][0].getMedian();
-        buffer.mLogdEdx_A_RMS[slice] = logdEdxA[slice][0].getStdDev();
-        buffer.mLogdEdx_A_IROC_Median[slice] = logdEdxA[slice][1].getMedian();
-        buffer.mLogdEdx_A_IROC_RMS[slice] = logdEdxA[slice][1].getStdDev();
-        buffer.mLogdEdx_A_OROC1_Median[slice] = logdEdxA[slice][2].getMedian();
-        buffer.mLogdEdx_A_OROC1_RMS[slice] = logdEdxA[slice][2].getStdDev();
-        buffer.mLogdEdx_A_OROC2_Median[slice] = logdEdxA[slice][3].getMedian();
-        buffer.mLogdEdx_A_OROC2_RMS[slice] = logdEdxA[slice][3].getStdDev();
-        buffer.mLogdEdx_A_OROC3_Median[slice] = logdEdxA[slice][4].getMedian();
-        buffer.mLogdEdx_A_OROC3_RMS[slice] = logdEdxA[slice][4].getStdDev();
-        // fill C-side
-        auto& logdEdxC = (type == 0) ? mLogdEdxQMaxC : mLogdEdxQTotC;
-        buffer.mLogdEdx_C_Median[slice] = logdEdxC[slice][0].getMedian();
-        buffer.mLogdEdx_C_RMS[slice] = logdEdxC[slice][0].getStdDev();
-        buffer.mLogdEdx_C_IROC_Median[slice] = logdEdxC[slice][1].getMedian();
-        buffer.mLogdEdx_C_IROC_RMS[slice] = logdEdxC[slice][1].getStdDev();
-        buffer.mLogdEdx_C_OROC1_Median[slice] = logdEdxC[slice][2].getMedian();
-        buffer.mLogdEdx_C_OROC1_RMS[slice] = logdEdxC[slice][2].getStdDev();
-        buffer.mLogdEdx_C_OROC2_Median[slice] = logdEdxC[slice][3].getMedian();
-        buffer.mLogdEdx_C_OROC2_RMS[slice] = logdEdxC[slice][3].getStdDev();
-        buffer.mLogdEdx_C_OROC3_Median[slice] = logdEdxC[slice][4].getMedian();
-        buffer.mLogdEdx_C_OROC3_RMS[slice] = logdEdxC[slice][4].getStdDev();
-      }
+        // loop over qMax and qTot
+        for (int type = 0; type < 2; ++type) {
+          auto& logdEdxA = (type == 0) ? mLogdEdxQMaxA : mLogdEdxQTotA;
+          auto& buffer = (type == 0) ? mBufferDCA.mdEdxQMax : mBufferDCA.mdEdxQTot;
+          // fill A-side
+          buffer.mLogdEdx_A_Median[slice] = logdEdxA[slice][0].getMedian();
+          buffer.mLogdEdx_A_RMS[slice] = logdEdxA[slice][0].getStdDev();
+          buffer.mLogdEdx_A_IROC_Median[slice] = logdEdxA[slice][1].getMedian();
+          buffer.mLogdEdx_A_IROC_RMS[slice] = logdEdxA[slice][1].getStdDev();
+          buffer.mLogdEdx_A_OROC1_Median[slice] = logdEdxA[slice][2].getMedian();
+          buffer.mLogdEdx_A_OROC1_RMS[slice] = logdEdxA[slice][2].getStdDev();
+          buffer.mLogdEdx_A_OROC2_Median[slice] = logdEdxA[slice][3].getMedian();
+          buffer.mLogdEdx_A_OROC2_RMS[slice] = logdEdxA[slice][3].getStdDev();
+          buffer.mLogdEdx_A_OROC3_Median[slice] = logdEdxA[slice][4].getMedian();
+          buffer.mLogdEdx_A_OROC3_RMS[slice] = logdEdxA[slice][4].getStdDev();
+          // fill C-side
+          auto& logdEdxC = (type == 0) ? mLogdEdxQMaxC : mLogdEdxQTotC;
+          buffer.mLogdEdx_C_Median[slice] = logdEdxC[slice][0].getMedian();
+          buffer.mLogdEdx_C_RMS[slice] = logdEdxC[slice][0].getStdDev();
+          buffer.mLogdEdx_C_IROC_Median[slice] = logdEdxC[slice][1].getMedian();
+          buffer.mLogdEdx_C_IROC_RMS[slice] = logdEdxC[slice][1].getStdDev();
+          buffer.mLogdEdx_C_OROC1_Median[slice] = logdEdxC[slice][2].getMedian();
+          buffer.mLogdEdx_C_OROC1_RMS[slice] = logdEdxC[slice][2].getStdDev();
+          buffer.mLogdEdx_C_OROC2_Median[slice] = logdEdxC[slice][3].getMedian();
+          buffer.mLogdEdx_C_OROC2_RMS[slice] = logdEdxC[slice][3].getStdDev();
+          buffer.mLogdEdx_C_OROC3_Median[slice] = logdEdxC[slice][4].getMedian();
+          buffer.mLogdEdx_C_OROC3_RMS[slice] = logdEdxC[slice][4].getStdDev();
+        }
 
-      // ITS properties
-      // A-side
-      mBufferDCA.mITS_A_NCl_Median[slice] = mITSPropertiesA[slice][0].getMedian();
-      mBufferDCA.mITS_A_NCl_RMS[slice] = mITSPropertiesA[slice][0].getStdDev();
-      mBufferDCA.mSqrtITSChi2_Ncl_A_Median[slice] = mITSPropertiesA[slice][1].getMedian();
-      mBufferDCA.mSqrtITSChi2_Ncl_A_RMS[slice] = mITSPropertiesA[slice][1].getStdDev();
-      // C-side
-      mBufferDCA.mITS_C_NCl_Median[slice] = mITSPropertiesC[slice][0].getMedian();
-      mBufferDCA.mITS_C_NCl_RMS[slice] = mITSPropertiesC[slice][0].getStdDev();
-      mBufferDCA.mSqrtITSChi2_Ncl_C_Median[slice] = mITSPropertiesC[slice][1].getMedian();
-      mBufferDCA.mSqrtITSChi2_Ncl_C_RMS[slice] = mITSPropertiesC[slice][1].getStdDev();
-
-      //...
-      mBufferDCA.mITSTPCDeltaP2_A_Median[slice] = mITSTPCDeltaPA[slice][0].getMedian();
-      mBufferDCA.mITSTPCDeltaP3_A_Median[slice] = mITSTPCDeltaPA[slice][1].getMedian();
-      mBufferDCA.mITSTPCDeltaP4_A_Median[slice] = mITSTPCDeltaPA[slice][2].getMedian();
-      mBufferDCA.mITSTPCDeltaP2_C_Median[slice] = mITSTPCDeltaPC[slice][0].getMedian();
-      mBufferDCA.mITSTPCDeltaP3_C_Median[slice] = mITSTPCDeltaPC[slice][1].getMedian();
-      mBufferDCA.mITSTPCDeltaP4_C_Median[slice] = mITSTPCDeltaPC[slice][2].getMedian();
-      mBufferDCA.mITSTPCDeltaP2_A_RMS[slice] = mITSTPCDeltaPA[slice][0].getStdDev();
-      mBufferDCA.mITSTPCDeltaP3_A_RMS[slice] = mITSTPCDeltaPA[slice][1].getStdDev();
-      mBufferDCA.mITSTPCDeltaP4_A_RMS[slice] = mITSTPCDeltaPA[slice][2].getStdDev();
-      mBufferDCA.mITSTPCDeltaP2_C_RMS[slice] = mITSTPCDeltaPC[slice][0].getStdDev();
-      mBufferDCA.mITSTPCDeltaP3_C_RMS[slice] = mITSTPCDeltaPC[slice][1].getStdDev();
-      mBufferDCA.mITSTPCDeltaP4_C_RMS[slice] = mITSTPCDeltaPC[slice][2].getStdDev();
-      mBufferDCA.mTPCSigmaY2A_Median[slice] = mSigmaYZA[slice][0].getMedian();
-      mBufferDCA.mTPCSigmaZ2A_Median[slice] = mSigmaYZA[slice][1].getMedian();
-      mBufferDCA.mTPCSigmaY2C_Median[slice] = mSigmaYZC[slice][0].getMedian();
-      mBufferDCA.mTPCSigmaZ2C_Median[slice] = mSigmaYZC[slice][1].getMedian();
-      mBufferDCA.mTPCSigmaY2A_RMS[slice] = mSigmaYZA[slice][0].getStdDev();
-      mBufferDCA.mTPCSigmaZ2A_RMS[slice] = mSigmaYZA[slice][1].getStdDev();
-      mBufferDCA.mTPCSigmaY2C_RMS[slice] = mSigmaYZC[slice][0].getStdDev();
-      mBufferDCA.mTPCSigmaZ2C_RMS[slice] = mSigmaYZC[slice][1].getStdDev();
-    }
+        // ITS properties
+        // A-side
+        mBufferDCA.mITS_A_NCl_Median[slice] = mITSPropertiesA[slice][0].getMedian();
+        mBufferDCA.mITS_A_NCl_RMS[slice] = mITSPropertiesA[slice][0].getStdDev();
+        mBufferDCA.mSqrtITSChi2_Ncl_A_Median[slice] = mITSPropertiesA[slice][1].getMedian();
+        mBufferDCA.mSqrtITSChi2_Ncl_A_RMS[slice] = mITSPropertiesA[slice][1].getStdDev();
+        // C-side
+        mBufferDCA.mITS_C_NCl_Median[slice] = mITSPropertiesC[slice][0].getMedian();
+        mBufferDCA.mITS_C_NCl_RMS[slice] = mITSPropertiesC[slice][0].getStdDev();
+        mBufferDCA.mSqrtITSChi2_Ncl_C_Median[slice] = mITSPropertiesC[slice][1].getMedian();
+        mBufferDCA.mSqrtITSChi2_Ncl_C_RMS[slice] = mITSPropertiesC[slice][1].getStdDev();
+
+        //...
+        mBufferDCA.mITSTPCDeltaP2_A_Median[slice] = mITSTPCDeltaPA[slice][0].getMedian();
+        mBufferDCA.mITSTPCDeltaP3_A_Median[slice] = mITSTPCDeltaPA[slice][1].getMedian();
+        mBufferDCA.mITSTPCDeltaP4_A_Median[slice] = mITSTPCDeltaPA[slice][2].getMedian();
+        mBufferDCA.mITSTPCDeltaP2_C_Median[slice] = mITSTPCDeltaPC[slice][0].getMedian();
+        mBufferDCA.mITSTPCDeltaP3_C_Median[slice] = mITSTPCDeltaPC[slice][1].getMedian();
+        mBufferDCA.mITSTPCDeltaP4_C_Median[slice] = mITSTPCDeltaPC[slice][2].getMedian();
+        mBufferDCA.mITSTPCDeltaP2_A_RMS[slice] = mITSTPCDeltaPA[slice][0].getStdDev();
+        mBufferDCA.mITSTPCDeltaP3_A_RMS[slice] = mITSTPCDeltaPA[slice][1].getStdDev();
+        mBufferDCA.mITSTPCDeltaP4_A_RMS[slice] = mITSTPCDeltaPA[slice][2].getStdDev();
+        mBufferDCA.mITSTPCDeltaP2_C_RMS[slice] = mITSTPCDeltaPC[slice][0].getStdDev();
+        mBufferDCA.mITSTPCDeltaP3_C_RMS[slice] = mITSTPCDeltaPC[slice][1].getStdDev();
+        mBufferDCA.mITSTPCDeltaP4_C_RMS[slice] = mITSTPCDeltaPC[slice][2].getStdDev();
+        mBufferDCA.mTPCSigmaY2A_Median[slice] = mSigmaYZA[slice][0].getMedian();
+        mBufferDCA.mTPCSigmaZ2A_Median[slice] = mSigmaYZA[slice][1].getMedian();
+        mBufferDCA.mTPCSigmaY2C_Median[slice] = mSigmaYZC[slice][0].getMedian();
+        mBufferDCA.mTPCSigmaZ2C_Median[slice] = mSigmaYZC[slice][1].getMedian();
+        mBufferDCA.mTPCSigmaY2A_RMS[slice] = mSigmaYZA[slice][0].getStdDev();
+        mBufferDCA.mTPCSigmaZ2A_RMS[slice] = mSigmaYZA[slice][1].getStdDev();
+        mBufferDCA.mTPCSigmaY2C_RMS[slice] = mSigmaYZC[slice][0].getStdDev();
+        mBufferDCA.mTPCSigmaZ2C_RMS[slice] = mSigmaYZC[slice][1].getStdDev();
+      }
+    });
 
     auto stop = timer::now();
     std::chrono::duration<float> time = stop - startTotal;
@@ -1043,6 +1057,23 @@ class TPCTimeSeries : public Task
   /// check if track passes coarse cuts
   bool acceptTrack(const TrackTPC& track) const { return std::abs(track.getTgl()) < mMaxTgl; }
 
+  /// run the given function with the thread index as argument on all threads
+  template <typename Func>
+  void runThreads(Func&& func) const
+  {
+    if (mNThreads <= 1) {
+      func(0);
+      return;
+    }
+    std::vector<std::thread> threads(mNThreads);
+    for (int i = 0; i < mNThreads; i++) {
+      threads[i] = std::thread(func, i);
+    }
+    for (auto& th : threads) {
+      th.join();
+    }
+  }
+
   bool checkTrack(const TrackTPC& track) const
   {
     const bool isGoodTrack = ((track.getNClusters() < mMinNCl) || (track.getP() < mMinMom)) ? false : true;
@@ -12,7 +12,11 @@
 #ifndef O2_TRD_TRACKLETTRANSFORMER_H
 #define O2_TRD_TRACKLETTRANSFORMER_H
 
+#include <array>
+#include <gsl/span>
+
 #include "TRDBase/Geometry.h"
+#include "DataFormatsTRD/Constants.h"
 #include "DataFormatsTRD/Tracklet64.h"
 #include "DataFormatsTRD/CalibratedTracklet.h"
 #include "DataFormatsTRD/CalVdriftExB.h"
@@ -30,7 +34,8 @@ class TrackletTransformer
 
   void init();
 
-  void setCalVdriftExB(const CalVdriftExB* cal) { mCalVdriftExB = cal; };
+  /// set the calibration object and rebuild the per-chamber transformation parameters
+  void setCalVdriftExB(const CalVdriftExB* cal);
   void setApplyXOR() { mApplyXOR = true; }
   void setApplyShift(bool f) { mApplyShift = f; }
   bool isShiftApplied() const { return mApplyShift; }
@@ -45,9 +50,25 @@ class TrackletTransformer
 
   CalibratedTracklet transformTracklet(Tracklet64 tracklet, bool trackingFrame = true) const;
 
+  /// transform a batch of tracklets, output[i] corresponds to tracklets[i]
+  /// the chamber parameters are looked up only once for consecutive tracklets of the same chamber
+  void transformTracklets(gsl::span<const Tracklet64> tracklets, gsl::span<CalibratedTracklet> output, bool trackingFrame = true) const;
+
   double getTimebin(int detector, double x) const;
 
  private:
+  /// chamber dependent parameters of the transformation
+  struct ChamberTransform {
+    const o2::math_utils::Transform3D* matrixT2L{nullptr}; ///< tracking to local frame matrix, null if the chamber is not in the geometry
+    double dyPerSlope{0.};                                  ///< raw deflection per unit of tracklet slope
+    double lorentzCorrection{0.};                           ///< deflection due to the Lorentz angle
+    std::array<float, constants::NROWC1> rowZ{};            ///< local z position of each pad row
+  };
+
+  ChamberTransform computeChamberTransform(int detector) const;
+  void updateChamberTransforms();
+  CalibratedTracklet transformTracklet(const Tracklet64& tracklet, const ChamberTransform& chamber, bool trackingFrame) const;
+
   Geometry* mGeo{nullptr};
   bool mApplyXOR{false};
   bool mApplyShift{true};
@@ -55,6 +76,9 @@ class TrackletTransformer
   float mXAnode;
 
   const CalVdriftExB* mCalVdriftExB{nullptr};
+
+  bool mChamberTransformsValid{false};                                    ///< per-chamber parameters are up to date with geometry and calibration
+  std::array<ChamberTransform, constants::MAXCHAMBER> mChamberTransforms; ///< per-chamber parameters
 };
 
 } // namespace trd
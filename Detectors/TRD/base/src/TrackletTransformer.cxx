@@ -25,6 +25,47 @@ void TrackletTransformer::init()
 
   // 3.35 cm
   mXAnode = mGeo->cdrHght() + mGeo->camHght() / 2;
+
+  if (mCalVdriftExB) {
+    updateChamberTransforms();
+  }
+}
+
+void TrackletTransformer::setCalVdriftExB(const CalVdriftExB* cal)
+{
+  mCalVdriftExB = cal;
+  mChamberTransformsValid = false;
+  if (mGeo && mCalVdriftExB) {
+    updateChamberTransforms();
+  }
+}
+
+TrackletTransformer::ChamberTransform TrackletTransformer::computeChamberTransform(int detector) const
+{
+  ChamberTransform chamber;
+  const auto padPlane = mGeo->getPadPlane(detector);
+  if (mGeo->chamberInGeometry(detector)) {
+    chamber.matrixT2L = &mGeo->getMatrixT2L(detector);
+  }
+
+  // same as calculateDy, with the slope factored out
+  float vDrift = mCalVdriftExB->getVdrift(detector);
+  float exb = mCalVdriftExB->getExB(detector);
+  chamber.dyPerSlope = ((mGeo->cdrHght() / vDrift) * 10.) * padPlane->getWidthIPad() * GRANULARITYTRKLSLOPE / ADDBITSHIFTSLOPE;
+  chamber.lorentzCorrection = TMath::Tan(exb) * mXAnode;
+
+  for (int padrow = 0; padrow < padPlane->getNrows() && padrow < NROWC1; ++padrow) {
+    chamber.rowZ[padrow] = calculateZ(padrow, padPlane);
+  }
+  return chamber;
+}
+
+void TrackletTransformer::updateChamberTransforms()
+{
+  for (int detector = 0; detector < MAXCHAMBER; ++detector) {
+    mChamberTransforms[detector] = computeChamberTransform(detector);
+  }
+  mChamberTransformsValid = true;
 }
 
 float TrackletTransformer::calculateZ(int padrow, const PadPlane* padPlane) const
@@ -78,9 +119,38 @@ std::array<float, 3> TrackletTransformer::transformL2T(int detector, std::array<
 CalibratedTracklet TrackletTransformer::transformTracklet(Tracklet64 tracklet, bool trackingFrame) const
 {
   auto detector = tracklet.getDetector();
-  auto hcid = tracklet.getHCID();
+  if (mChamberTransformsValid) {
+    return transformTracklet(tracklet, mChamberTransforms[detector], trackingFrame);
+  }
+  return transformTracklet(tracklet, computeChamberTransform(detector), trackingFrame);
+}
+
+void TrackletTransformer::transformTracklets(gsl::span<const Tracklet64> tracklets, gsl::span<CalibratedTracklet> output, bool trackingFrame) const
+{
+  // tracklets are ordered by half-chamber within a trigger, so the chamber parameters change rarely
+  int currentDetector = -1;
+  ChamberTransform chamber;
+  const ChamberTransform* currentChamber = nullptr;
+  for (size_t iTrklt = 0; iTrklt < tracklets.size(); ++iTrklt) {
+    const auto& tracklet = tracklets[iTrklt];
+    int detector = tracklet.getDetector();
+    if (detector != currentDetector) {
+      currentDetector = detector;
+      if (mChamberTransformsValid) {
+        currentChamber = &mChamberTransforms[detector];
+      } else {
+        chamber = computeChamberTransform(detector);
+        currentChamber = &chamber;
+      }
+    }
+    output[iTrklt] = transformTracklet(tracklet, *currentChamber, trackingFrame);
+  }
+}
+
+CalibratedTracklet TrackletTransformer::transformTracklet(const Tracklet64& tracklet, const ChamberTransform& chamber, bool trackingFrame) const
+{
+  auto detector = tracklet.getDetector();
   auto padrow = tracklet.getPadRow();
-  auto column = tracklet.getColumn();
   int position;
   int slope;
   if (mApplyXOR) {
@@ -98,24 +168,27 @@ CalibratedTracklet TrackletTransformer::transformTracklet(Tracklet64 tracklet, b
   }
 
   // calculate raw local chamber space point
-  const auto padPlane = mGeo->getPadPlane(detector);
-
   // 5mm below cathode plane to reduce error propogation from tracklet fit and driftV
   float x = mGeo->cdrHght() - 0.5;
   float y = tracklet.getUncalibratedY(mApplyShift);
-  float z = calculateZ(padrow, padPlane);
+  float z = (padrow < NROWC1) ? chamber.rowZ[padrow] : calculateZ(padrow, mGeo->getPadPlane(detector));
 
-  float dy = calculateDy(detector, slope, padPlane);
+  // NOTE: check what drift height is used in calibration code to ensure consistency
+  // NOTE: check sign convention of Lorentz angle
+  // NOTE: confirm the direction in which vDrift is measured/determined. Is it in x or in direction of drift?
+  float dy = slope * chamber.dyPerSlope - chamber.lorentzCorrection;
 
   float calibratedX = calibrateX(x);
 
   // NOTE: Correction to y position based on x calibration NOT YET implemented. Need t0.
   if (trackingFrame) {
-    std::array<float, 3> sectorSpacePoint = transformL2T(detector, std::array<double, 3>{calibratedX, y, z});
-    LOG(debug) << "x: " << sectorSpacePoint[0] << " | "
-               << "y: " << sectorSpacePoint[1] << " | "
-               << "z: " << sectorSpacePoint[2];
-    return CalibratedTracklet(sectorSpacePoint[0], sectorSpacePoint[1], sectorSpacePoint[2], dy);
+    const auto& transformationMatrix = chamber.matrixT2L ? *chamber.matrixT2L : mGeo->getMatrixT2L(detector);
+    ROOT::Math::Impl::Transform3D<double>::Point localPoint(calibratedX, y, z);
+    auto gobalPoint = transformationMatrix ^ localPoint;
+    LOG(debug) << "x: " << gobalPoint.x() << " | "
+               << "y: " << gobalPoint.y() << " | "
+               << "z: " << gobalPoint.z();
+    return CalibratedTracklet(gobalPoint.x(), gobalPoint.y(), gobalPoint.z(), dy);
   } else {
     return CalibratedTracklet(calibratedX, y, z, dy); // local frame
   }
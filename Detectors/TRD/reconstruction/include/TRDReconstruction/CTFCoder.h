@@ -95,7 +95,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const TriggerReco
     mTrkDataFilt.clear();
     mDigDataFilt.clear();
     for (const auto& trig : trigData) {
-      if (mIRFrameSelector.check(trig.getBCData()) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.getBCData())) {
         mTrgRecFilt.push_back(trig);
         auto trkIt = trkData.begin() + trig.getFirstTracklet();
         auto digIt = digData.begin() + trig.getFirstDigit();
@@ -100,6 +100,10 @@ class CruRawReader
   // reset the event storage and the counters
   void reset();
 
+  // move the event records, the counters and the half-chamber header report of another reader into this one
+  // and reset the other reader. Used to combine the outputs of readers which parsed different inputs of the same TF
+  void merge(CruRawReader& other);
+
   // the parsing starts here, payload from all available RDHs is copied into mHBFPayload and afterwards processHalfCRU() is called
   // returns the total number of bytes read, including RDH header
   int processHBFs();
@@ -24,6 +24,7 @@
 #include "DataFormatsTRD/Digit.h"
 #include "DataFormatsTRD/RawDataStats.h"
 #include <fstream>
+#include <vector>
 
 using namespace o2::framework;
 
@@ -43,9 +44,12 @@ class DataReaderTask : public Task
 
  private:
   void updateTimeDependentParams(framework::ProcessingContext& pc);
+  void configureReader(CruRawReader& reader, InitContext& ic);
   CruRawReader mReader; // this will do the parsing, of raw data passed directly through the flp(no compression)
                         // we pull the data from the vectors build message and pass on.
                         // they will internally produce a vector of digits and a vector tracklets and associated indexing.
+  std::vector<CruRawReader> mWorkerReaders{}; // additional readers parsing a share of the inputs in parallel, merged into mReader afterwards
+  int mNThreads{1};                           // number of threads used for the parsing
 
   bool mVerbose{false};          // verbos output general debuggign and info output.
   bool mDataVerbose{false};      // verbose output of data unpacking
@@ -64,6 +64,9 @@ class EventRecord
   void incTime(float duration) { mTimeTaken += duration; }
   void setIsCalibTrigger() { mIsCalibTrigger = true; }
 
+  // append the data, timing and counters of another record of the same trigger
+  void append(const EventRecord& other);
+
  private:
   BCData mBCData;                       /// orbit and Bunch crossing data of the physics trigger
   std::vector<Digit> mDigits{};         /// digit data, for this event
@@ -111,6 +114,10 @@ class EventRecordContainer
   void reset();
   void accumulateStats();
 
+  // move the event records and the link statistics of another container into this one.
+  // Records of the same trigger are combined, the other ones are added in their order in the other container
+  void merge(EventRecordContainer& other);
+
  private:
   int mCurrEventRecord = 0;
   std::vector<EventRecord> mEventRecords;
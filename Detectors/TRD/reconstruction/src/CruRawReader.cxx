@@ -775,6 +775,27 @@ int CruRawReader::parseDigitLinkData(int maxWords32, int hcid, int& wordsRejecte
           // either ZS is OFF, or the adcMask has iChannel flagged as active
           DigitMCMData data;
           int timebin = 0;
+          // fast path: if all the ADC words of the channel are inside the link and pass the checks,
+          // they are unpacked in one go. Otherwise they are read one by one to locate the problem
+          const int nWordsChannel = (mTimeBins + 2) / 3;
+          const uint32_t checkBits = (iChannel % 2) ? 0x2 : 0x3;
+          if (wordsRead + nWordsChannel <= maxWords32 && 3 * nWordsChannel <= TIMEBINS) {
+            const uint32_t* words = &mHBFPayload[mHBFoffset32 + wordsRead];
+            bool wordsOK = true;
+            for (int iWord = 0; iWord < nWordsChannel; ++iWord) {
+              wordsOK &= (words[iWord] != DIGITENDMARKER) & ((words[iWord] & 0x3) == checkBits);
+            }
+            if (wordsOK) {
+              for (int iWord = 0; iWord < nWordsChannel; ++iWord) {
+                adcValues[3 * iWord] = (words[iWord] >> 2) & 0x3ff;
+                adcValues[3 * iWord + 1] = (words[iWord] >> 12) & 0x3ff;
+                adcValues[3 * iWord + 2] = (words[iWord] >> 22) & 0x3ff;
+              }
+              timebin = 3 * nWordsChannel;
+              wordsRead += nWordsChannel;
+              currWord = mHBFPayload[mHBFoffset32 + wordsRead];
+            }
+          }
           while (timebin < mTimeBins) {
             if (currWord == DIGITENDMARKER) {
               incrementErrors(DigitEndMarkerWrongState, hcid, "Expected Digit ADC data, but found end marker instead");
@@ -1156,6 +1177,21 @@ void CruRawReader::reset()
   mWordsRejected = 0;
 }
 
+void CruRawReader::merge(CruRawReader& other)
+{
+  mEventRecords.merge(other.mEventRecords);
+  mTrackletsFound += other.mTrackletsFound;
+  mDigitsFound += other.mDigitsFound;
+  mDigitWordsRead += other.mDigitWordsRead;
+  mDigitWordsRejected += other.mDigitWordsRejected;
+  mTrackletWordsRead += other.mTrackletWordsRead;
+  mTrackletWordsRejected += other.mTrackletWordsRejected;
+  mWordsRejected += other.mWordsRejected;
+  mHalfChamberHeaderOK.insert(other.mHalfChamberHeaderOK.begin(), other.mHalfChamberHeaderOK.end());
+  mHalfChamberMismatches.insert(other.mHalfChamberMismatches.begin(), other.mHalfChamberMismatches.end());
+  other.reset();
+}
+
 void CruRawReader::checkNoWarn(bool silently)
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
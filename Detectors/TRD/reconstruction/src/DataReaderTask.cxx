@@ -26,19 +26,45 @@
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DataFormatsTRD/Constants.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2::trd
 {
 
 void DataReaderTask::init(InitContext& ic)
 {
-  mReader.setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+  configureReader(mReader, ic);
   int nTimeBins = ic.options().get<int>("number-of-TBs");
   if (nTimeBins >= 0) {
     LOGP(info, "Number of time bins set to {} externally", nTimeBins);
-    mReader.setNumberOfTimeBins(nTimeBins);
   }
-  mReader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
   mProcessEveryNthTF = ic.options().get<int>("every-nth-tf");
+#ifdef WITH_OPENMP
+  int askedThreads = ic.options().get<int>("nthreads");
+  int maxThreads = omp_get_max_threads();
+  mNThreads = (askedThreads < 0) ? maxThreads : std::max(1, std::min(maxThreads, askedThreads));
+  LOG(info) << "Raw data parsing running with " << mNThreads << " threads";
+#endif
+  mWorkerReaders.resize(mNThreads - 1);
+  for (auto& reader : mWorkerReaders) {
+    configureReader(reader, ic);
+  }
+}
+
+void DataReaderTask::configureReader(CruRawReader& reader, InitContext& ic)
+{
+  reader.setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+  int nTimeBins = ic.options().get<int>("number-of-TBs");
+  if (nTimeBins >= 0) {
+    reader.setNumberOfTimeBins(nTimeBins);
+  }
+  reader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
 }
 
 void DataReaderTask::endOfStream(o2::framework::EndOfStreamContext& ec)
@@ -57,6 +83,9 @@ void DataReaderTask::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
   } else if (matcher == ConcreteDataMatcher("TRD", "LinkToHcid", 0)) {
     LOG(info) << "Updated Link ID to HCID mapping";
     mReader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    for (auto& reader : mWorkerReaders) {
+      reader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    }
     return;
   }
 }
@@ -113,24 +142,42 @@ void DataReaderTask::run(ProcessingContext& pc)
   size_t datasizeInTF = 0;
   std::vector<InputSpec> sel{InputSpec{"filter", ConcreteDataTypeMatcher{"TRD", "RAWDATA"}}};
   uint64_t tfCount = 0;
+  std::vector<std::pair<const char*, size_t>> payloads{};
   for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
     // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
     tfCount = dh->tfCounter;
-    const char* payloadIn = ref.payload;
     auto payloadInSize = DataRefUtils::getPayloadSize(ref);
     if (mOptions[TRDVerboseBit]) {
       LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
            dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
     }
-    mReader.setDataBuffer(payloadIn);
-    mReader.setDataBufferSize(payloadInSize);
-    mReader.run();
+    payloads.emplace_back(ref.payload, payloadInSize);
     datasizeInTF += payloadInSize;
-    if (mOptions[TRDVerboseBit]) {
-      LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+  }
+
+  // the inputs are split in contiguous shares, one per reader. Since the readers are merged in the order of
+  // their shares, the output is identical to the one obtained by parsing all the inputs with a single reader
+  int nReaders = std::max(1, std::min(mNThreads, static_cast<int>(payloads.size())));
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nReaders)
+#endif
+  for (int iReader = 0; iReader < nReaders; ++iReader) {
+    auto& reader = (iReader == 0) ? mReader : mWorkerReaders[iReader - 1];
+    size_t first = payloads.size() * iReader / nReaders;
+    size_t last = payloads.size() * (iReader + 1) / nReaders;
+    for (size_t iPayload = first; iPayload < last; ++iPayload) {
+      reader.setDataBuffer(payloads[iPayload].first);
+      reader.setDataBufferSize(payloads[iPayload].second);
+      reader.run();
+      if (mOptions[TRDVerboseBit]) {
+        LOG(info) << "relevant vectors to read : " << reader.getTrackletsFound() << " tracklets and " << reader.getDigitsFound() << " compressed digits";
+      }
     }
   }
+  for (int iReader = 1; iReader < nReaders; ++iReader) {
+    mReader.merge(mWorkerReaders[iReader - 1]);
+  }
 
   mReader.buildDPLOutputs(pc);
   std::chrono::duration<double, std::milli> dataReadTime = std::chrono::high_resolution_clock::now() - dataReadStart;
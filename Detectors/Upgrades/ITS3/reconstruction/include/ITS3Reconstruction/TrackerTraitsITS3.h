@@ -0,0 +1,51 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TrackerTraitsITS3.h
+/// \brief CPU tracker traits with the tracklet finding specialised for the curved ITS3 layers
+
+#ifndef ALICEO2_ITS3_TRACKERTRAITSITS3_H_
+#define ALICEO2_ITS3_TRACKERTRAITSITS3_H_
+
+#include <array>
+
+#include "ITStracking/TrackerTraits.h"
+#include "ITS3Base/SpecsV2.h"
+
+namespace o2::its3
+{
+
+/// The curved layers are exact cylinders of known radius: for a pair of them the
+/// tracklet phi window is centred on the straight line from the vertex through the
+/// cluster and its half width is computed from the exact radii (bending, multiple
+/// scattering lever arm, resolution) instead of the generic layer-pair cut.
+/// Pairs involving the outer barrel staves keep the generic ITS window.
+template <int NLayers>
+class TrackerTraitsITS3 final : public its::TrackerTraits
+{
+  static_assert(NLayers > static_cast<int>(constants::nLayers), "the ITS3 layers are the innermost ones");
+
+ public:
+  static constexpr int NTrackletLayers{NLayers - 1};
+
+  void initialiseTimeFrame(const int iteration) final;
+  void computeLayerTracklets(const int iteration, int iROFslice, int iVertex) final;
+
+  static constexpr bool isCurvedPair(int iLayer) { return iLayer + 1 < static_cast<int>(constants::nLayers); }
+  float getCurvedPhiCut(int iLayer) const { return mCurvedPhiCuts[iLayer]; }
+
+ private:
+  std::array<float, NTrackletLayers> mCurvedPhiCuts{};
+};
+
+} // namespace o2::its3
+
+#endif
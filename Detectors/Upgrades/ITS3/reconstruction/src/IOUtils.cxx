@@ -68,6 +68,7 @@ int loadROFrameDataITS3(its::TimeFrame* tf,
 
   std::vector<uint8_t> clusterSizeVec;
   clusterSizeVec.reserve(clusters.size());
+  const auto& chipTransforms = geom->getChipTransforms();
 
   for (auto& rof : rofs) {
     for (int clusterId{rof.getFirstEntry()}; clusterId < rof.getFirstEntry() + rof.getNEntries(); ++clusterId) {
@@ -92,8 +93,16 @@ int loadROFrameDataITS3(its::TimeFrame* tf,
       }
       clusterSizeVec.push_back(std::clamp(clusterSize, 0u, 255u));
 
-      // Transformation to the local --> global
-      auto gloXYZ = geom->getMatrixL2G(sensorID) * locXYZ;
+      // Transformation to the local --> global, with the flattened chip matrices when available
+      const float lx{locXYZ.x()}, ly{locXYZ.y()}, lz{locXYZ.z()};
+      o2::math_utils::Point3D<float> gloXYZ;
+      if (chipTransforms.isInitialised()) {
+        float gx, gy, gz;
+        chipTransforms.localToGlobal(sensorID, 1, &lx, &ly, &lz, &gx, &gy, &gz);
+        gloXYZ.SetXYZ(gx, gy, gz);
+      } else {
+        gloXYZ = geom->getMatrixL2G(sensorID) * locXYZ;
+      }
 
       // for cylindrical layers we have a different alpha for each cluster, for regular silicon detectors instead a single alpha for the whole sensor
       float alpha = geom->getSensorRefAlpha(sensorID);
@@ -101,6 +110,10 @@ int loadROFrameDataITS3(its::TimeFrame* tf,
       if (isITS3) {
         // Inverse transformation to the local --> tracking
         trkXYZ = geom->getT2LMatrixITS3(sensorID, alpha) ^ locXYZ;
+      } else if (chipTransforms.hasTrackingFrame()) {
+        float tx, ty, tz;
+        chipTransforms.localToTracking(sensorID, 1, &lx, &ly, &lz, &tx, &ty, &tz);
+        trkXYZ.SetXYZ(tx, ty, tz);
       } else {
         // Inverse transformation to the local --> tracking
         trkXYZ = geom->getMatrixT2L(sensorID) ^ locXYZ;
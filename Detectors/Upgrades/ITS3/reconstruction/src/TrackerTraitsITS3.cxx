@@ -0,0 +1,240 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file TrackerTraitsITS3.cxx
+/// \brief Implementation of the ITS3 specialised tracker traits
+
+#include "ITS3Reconstruction/TrackerTraitsITS3.h"
+
+#include <algorithm>
+
+#include "CommonConstants/MathConstants.h"
+#include "GPUCommonMath.h"
+#include "ITStracking/ArenaAllocator.h"
+#include "ITStracking/IndexTableUtils.h"
+#include "ITStracking/MathUtils.h"
+#include "ITStracking/Tracklet.h"
+#include "Framework/Logger.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+float Sq(float q)
+{
+  return q * q;
+}
+
+int getThreadIndex()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/// phi at radius r1 of the straight line from the vertex (vx, vy) through the point (x0, y0)
+float projectPhi(float x0, float y0, float vx, float vy, float r1)
+{
+  const float dx{x0 - vx}, dy{y0 - vy};
+  const float norm{o2::gpu::CAMath::Sqrt(Sq(dx) + Sq(dy))};
+  if (norm < 1.e-6f) {
+    return o2::math_utils::getNormalizedPhi(o2::gpu::CAMath::ATan2(y0, x0));
+  }
+  const float ux{dx / norm}, uy{dy / norm};
+  const float proj{x0 * ux + y0 * uy};
+  const float t{-proj + o2::gpu::CAMath::Sqrt(o2::gpu::CAMath::Max(0.f, Sq(proj) - Sq(x0) - Sq(y0) + Sq(r1)))};
+  return o2::math_utils::getNormalizedPhi(o2::gpu::CAMath::ATan2(y0 + t * uy, x0 + t * ux));
+}
+} // namespace
+
+namespace o2::its3
+{
+using its::ArenaScope;
+using its::ArenaStlAllocator;
+using its::ArenaVector;
+using its::Cluster;
+using its::TimeFrame;
+using its::Tracklet;
+using its::Vertex;
+
+template <int NLayers>
+void TrackerTraitsITS3<NLayers>::initialiseTimeFrame(const int iteration)
+{
+  if (mTrkParams[iteration].NLayers != NLayers) {
+    LOGP(fatal, "TrackerTraitsITS3 compiled for {} layers, the tracking parameters have {}", NLayers, mTrkParams[iteration].NLayers);
+  }
+  TrackerTraits::initialiseTimeFrame(iteration);
+
+  const auto& trkParam = mTrkParams[iteration];
+  const float oneOverR{0.001f * 0.3f * std::abs(mBz) / trkParam.TrackletMinPt};
+  for (int iLayer{0}; iLayer < NTrackletLayers; ++iLayer) {
+    const float genericCut{mTimeFrame->getPhiCut(iLayer)};
+    if (!isCurvedPair(iLayer)) {
+      mCurvedPhiCuts[iLayer] = genericCut;
+      continue;
+    }
+    const float r0{constants::radii[iLayer]}, r1{constants::radii[iLayer + 1]};
+    // a track from the vertex crosses radius r at phi0 -+ asin(r / 2R)
+    const float bending{o2::gpu::CAMath::ASin(std::min(1.f, 0.5f * r1 * oneOverR)) - o2::gpu::CAMath::ASin(std::min(1.f, 0.5f * r0 * oneOverR))};
+    // a kink at r0 displaces the track at r1 by (r1 - r0) * theta
+    const float scattering{2.f * mTimeFrame->getMSangle(iLayer) * (r1 - r0) / r1};
+    const float sigmaPhi{o2::gpu::CAMath::Sqrt(Sq(mTimeFrame->getPositionResolution(iLayer) / r0) +
+                                               Sq(mTimeFrame->getPositionResolution(iLayer + 1) / r1) +
+                                               Sq(trkParam.PVres * (r1 - r0) / (r0 * r1)))};
+    mCurvedPhiCuts[iLayer] = std::min(bending + scattering + trkParam.NSigmaCut * sigmaPhi, genericCut);
+  }
+}
+
+template <int NLayers>
+void TrackerTraitsITS3<NLayers>::computeLayerTracklets(const int iteration, int iROFslice, int iVertex)
+{
+  TimeFrame* tf = mTimeFrame;
+  const auto& trkParam = mTrkParams[iteration];
+
+  for (int iLayer = 0; iLayer < NTrackletLayers; ++iLayer) {
+    tf->getTracklets()[iLayer].clear();
+    tf->getTrackletsLabel(iLayer).clear();
+    if (iLayer > 0) {
+      std::fill(tf->getTrackletsLookupTable()[iLayer - 1].begin(), tf->getTrackletsLookupTable()[iLayer - 1].end(), 0);
+    }
+  }
+
+  const Vertex diamondVert({trkParam.Diamond[0], trkParam.Diamond[1], trkParam.Diamond[2]}, {25.e-6f, 0.f, 0.f, 25.e-6f, 0.f, 36.f}, 1, 1.f);
+  gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
+  const int startROF{trkParam.nROFsPerIterations > 0 ? iROFslice * trkParam.nROFsPerIterations : 0};
+  const int endROF{trkParam.nROFsPerIterations > 0 ? (iROFslice + 1) * trkParam.nROFsPerIterations + trkParam.DeltaROF : tf->getNrof()};
+  const int nThreads{getNThreads()};
+  const int nTasks{std::max(0, endROF - startROF) * NTrackletLayers};
+  ArenaScope scratch{tf->getArena()};
+  ArenaStlAllocator<Tracklet> trackletAllocator{tf->getArena()};
+  ArenaVector<ArenaVector<Tracklet>> threadTracklets(nThreads * NTrackletLayers, ArenaVector<Tracklet>{trackletAllocator}, ArenaStlAllocator<ArenaVector<Tracklet>>{tf->getArena()});
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+  for (int iTask = 0; iTask < nTasks; ++iTask) {
+    const int rof0{startROF + iTask / NTrackletLayers};
+    const int iLayer{iTask % NTrackletLayers};
+    const bool curved{isCurvedPair(iLayer)};
+    auto& tracklets{threadTracklets[getThreadIndex() * NTrackletLayers + iLayer]};
+    gsl::span<const Vertex> primaryVertices = trkParam.UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
+    const int startVtx{iVertex >= 0 ? iVertex : 0};
+    const int endVtx{iVertex >= 0 ? std::min(iVertex + 1, static_cast<int>(primaryVertices.size())) : static_cast<int>(primaryVertices.size())};
+    const int minRof = std::max(startROF, rof0 - trkParam.DeltaROF);
+    const int maxRof = std::min(endROF - 1, rof0 + trkParam.DeltaROF);
+    gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
+    if (layer0.empty()) {
+      continue;
+    }
+    const float nextRadius{curved ? constants::radii[iLayer + 1] : trkParam.LayerRadii[iLayer + 1]};
+    const float meanDeltaR{nextRadius - (curved ? constants::radii[iLayer] : trkParam.LayerRadii[iLayer])};
+    const float phiCut{mCurvedPhiCuts[iLayer]};
+    const float minR{tf->getMinR(iLayer + 1)}, maxR{tf->getMaxR(iLayer + 1)};
+
+    const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+      const Cluster& currentCluster{layer0[iCluster]};
+      const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+
+      if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
+        continue;
+      }
+      const float inverseR0{1.f / currentCluster.radius};
+
+      for (int iV{startVtx}; iV < endVtx; ++iV) {
+        auto& primaryVertex{primaryVertices[iV]};
+        if (primaryVertex.isFlagSet(1) && iteration != 3) {
+          continue;
+        }
+        const float resolution = o2::gpu::CAMath::Sqrt(Sq(trkParam.PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
+
+        const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
+
+        const float zAtRmin{tanLambda * (minR - currentCluster.radius) + currentCluster.zCoordinate};
+        const float zAtRmax{tanLambda * (maxR - currentCluster.radius) + currentCluster.zCoordinate};
+
+        const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
+        const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
+
+        // on the cylinders the window follows the vertex-cluster direction, elsewhere it is centred on the cluster
+        const float phiCentre{curved ? projectPhi(currentCluster.xCoordinate, currentCluster.yCoordinate, primaryVertex.getX(), primaryVertex.getY(), nextRadius) : currentCluster.phi};
+        const int4 selectedBinsRect{getBinsRect(iLayer, phiCentre, phiCut, zAtRmin, zAtRmax, sigmaZ * trkParam.NSigmaCut)};
+        if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+          continue;
+        }
+
+        int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+
+        if (phiBinsNum < 0) {
+          phiBinsNum += trkParam.PhiBins;
+        }
+
+        for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
+          gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
+          if (layer1.empty()) {
+            continue;
+          }
+          const float* phi1{tf->getClustersPhiOnLayer(rof1, iLayer + 1).data()};
+          const float* z1{tf->getClustersZOnLayer(rof1, iLayer + 1).data()};
+          const float* r1{tf->getClustersROnLayer(rof1, iLayer + 1).data()};
+          const int* id1{tf->getClustersIdOnLayer(rof1, iLayer + 1).data()};
+          const auto& indexTable{tf->getIndexTable(rof1, iLayer + 1)};
+
+          for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
+            const int iPhiBin = (selectedBinsRect.y + iPhiCount) % trkParam.PhiBins;
+            const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+            const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+            const int firstRowClusterIndex = indexTable[firstBinIndex];
+            const int maxRowClusterIndex = std::min(indexTable[maxBinIndex], static_cast<int>(layer1.size()));
+
+            for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+              if (tf->isClusterUsed(iLayer + 1, id1[iNextCluster])) {
+                continue;
+              }
+
+              const float deltaPhi{gpu::GPUCommonMath::Abs(phiCentre - phi1[iNextCluster])};
+              const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (r1[iNextCluster] - currentCluster.radius) +
+                                                         currentCluster.zCoordinate - z1[iNextCluster])};
+
+              if (deltaZ / sigmaZ < trkParam.NSigmaCut &&
+                  (deltaPhi < phiCut || gpu::GPUCommonMath::Abs(deltaPhi - o2::constants::math::TwoPI) < phiCut)) {
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
+                }
+                const Cluster& nextCluster{layer1[iNextCluster]};
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                tracklets.emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  for (int iLayer = 0; iLayer < NTrackletLayers; ++iLayer) {
+    for (int iThread = 0; iThread < nThreads; ++iThread) {
+      const auto& tracklets{threadTracklets[iThread * NTrackletLayers + iLayer]};
+      tf->getTracklets()[iLayer].insert(tf->getTracklets()[iLayer].end(), tracklets.begin(), tracklets.end());
+    }
+  }
+  if (!tf->checkMemory(trkParam.MaxMemory)) {
+    return;
+  }
+  finaliseLayerTracklets(iteration);
+}
+
+template class TrackerTraitsITS3<constants::nTotLayers>;
+
+} // namespace o2::its3
@@ -58,6 +58,7 @@ class TrackerDPL : public framework::Task
   bool mCosmicsProcessing{false};
   o2::its3::TopologyDictionary* mDict{};
   std::unique_ptr<o2::gpu::GPUChainITS> mChainITS{};
+  std::unique_ptr<its::TrackerTraits> mTrackerTraits{}; ///< ITS3 specialised CPU traits, the GPU ones come from the chain
   std::unique_ptr<its::Tracker> mTracker{};
   std::unique_ptr<its::Vertexer> mVertexer{};
   TStopwatch mTimer{};
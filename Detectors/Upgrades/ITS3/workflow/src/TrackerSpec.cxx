@@ -29,6 +29,7 @@
 #include "CommonDataFormat/IRFrame.h"
 #include "DataFormatsTRD/TriggerRecord.h"
 #include "ITS3Reconstruction/IOUtils.h"
+#include "ITS3Reconstruction/TrackerTraitsITS3.h"
 #include "ITSReconstruction/FastMultEstConfig.h"
 #include "ITS3Base/SpecsV2.h"
 
@@ -60,7 +61,12 @@ void TrackerDPL::init(InitContext& /*ic*/)
 
   mChainITS.reset(mRecChain->AddChain<o2::gpu::GPUChainITS>());
   mVertexer = std::make_unique<Vertexer>(mChainITS->GetITSVertexerTraits());
-  mTracker = std::make_unique<Tracker>(mChainITS->GetITSTrackerTraits());
+  if (mRecChain->IsGPU()) {
+    mTracker = std::make_unique<Tracker>(mChainITS->GetITSTrackerTraits());
+  } else {
+    mTrackerTraits = std::make_unique<TrackerTraitsITS3<constants::nTotLayers>>();
+    mTracker = std::make_unique<Tracker>(mTrackerTraits.get());
+  }
   mRunVertexer = true;
   mCosmicsProcessing = false;
   std::vector<TrackingParameters> trackParams;
@@ -108,24 +108,34 @@ bool StrangenessTracker::loadData(const o2::globaltracking::RecoContainer& recoD
 
 void StrangenessTracker::prepareITStracks() // sort tracks by eta and phi and select only tracks with vertex matching
 {
-
+  // eta/phi bin of every selected track is computed once, then the tracks are counting-sorted by bin (keeping the input order within the bin),
+  // the overflow bin mPhiBins * mEtaBins going last
+  int nBins = mUtils.mPhiBins * mUtils.mEtaBins;
+  std::vector<int> trackBins, binFirst(nBins + 1, 0), selIndexes;
+  trackBins.reserve(mInputITStracks.size());
+  selIndexes.reserve(mInputITStracks.size());
   for (int iTrack{0}; iTrack < mInputITStracks.size(); iTrack++) {
     if (mStrParams->mVertexMatching && mITSvtxBrackets[iTrack].getMin() == -1) {
       continue;
     }
-    mSortedITStracks.push_back(mInputITStracks[iTrack]);
-    mSortedITSindexes.push_back(iTrack);
+    const auto& track = mInputITStracks[iTrack];
+    int bin = mUtils.getBinIndex(track.getEta(), track.getPhi());
+    binFirst[bin]++;
+    selIndexes.push_back(iTrack);
+    trackBins.push_back(bin);
   }
+  std::exclusive_scan(binFirst.begin(), binFirst.end(), binFirst.begin(), 0);
+  mTracksIdxTable.assign(binFirst.begin(), binFirst.end());
+  mTracksIdxTable[nBins] = selIndexes.size();
 
-  mTracksIdxTable.resize(mUtils.mPhiBins * mUtils.mEtaBins + 1);
-  std::sort(mSortedITStracks.begin(), mSortedITStracks.end(), [&](o2::its::TrackITS& a, o2::its::TrackITS& b) { return mUtils.getBinIndex(a.getEta(), a.getPhi()) < mUtils.getBinIndex(b.getEta(), b.getPhi()); });
-  std::sort(mSortedITSindexes.begin(), mSortedITSindexes.end(), [&](int i, int j) { return mUtils.getBinIndex(mInputITStracks[i].getEta(), mInputITStracks[i].getPhi()) < mUtils.getBinIndex(mInputITStracks[j].getEta(), mInputITStracks[j].getPhi()); });
-
-  for (auto& track : mSortedITStracks) {
-    mTracksIdxTable[mUtils.getBinIndex(track.getEta(), track.getPhi())]++;
+  mSortedITSindexes.resize(selIndexes.size());
+  for (int i{0}; i < (int)trackBins.size(); i++) {
+    mSortedITSindexes[binFirst[trackBins[i]]++] = selIndexes[i];
+  }
+  mSortedITStracks.reserve(mSortedITSindexes.size());
+  for (auto iTrack : mSortedITSindexes) {
+    mSortedITStracks.push_back(mInputITStracks[iTrack]);
   }
-  std::exclusive_scan(mTracksIdxTable.begin(), mTracksIdxTable.begin() + mUtils.mPhiBins * mUtils.mEtaBins, mTracksIdxTable.begin(), 0);
-  mTracksIdxTable[mUtils.mPhiBins * mUtils.mEtaBins] = mSortedITStracks.size();
 }
 
 void StrangenessTracker::processV0(int iv0, const V0& v0, const V0Index& v0Idx, int iThread)
@@ -245,7 +255,7 @@ void StrangenessTracker::processCascade(int iCasc, const Cascade& casc, const Ca
         strangeTrack.mDecayRef = iCasc;
         strangeTrack.mITSRef = mSortedITSindexes[iTrack];
         mStrangeTrackVec[iThread].push_back(strangeTrack);
-        mClusAttachments[iThread].push_back(mStructClus);
+        mClusAttachments[iThread].push_back(structClus);
         if (mMCTruthON) {
           auto lab = getStrangeTrackLabel(itsTrack, strangeTrack, structClus);
           mStrangeTrackLabels[iThread].push_back(lab);
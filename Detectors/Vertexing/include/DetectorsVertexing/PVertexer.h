@@ -134,6 +134,9 @@ class PVertexer
 
   void setPoolDumpDirectory(const std::string& d) { mPoolDumpDirectory = d; }
 
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   void printInpuTracksStatus(const VertexingInput& input) const;
 
  private:
@@ -148,6 +151,7 @@ class PVertexer
   FitStatus fitIteration(const VertexingInput& input, VertexSeed& vtxSeed);
   void finalizeVertex(const VertexingInput& input, const PVertex& vtx, std::vector<PVertex>& vertices, std::vector<V2TRef>& v2tRefs, std::vector<uint32_t>& trackIDs, SeedHistoTZ* histo = nullptr);
   void accountTrack(TrackVF& trc, VertexSeed& vtxSeed) const;
+  int accountTracks(TrackVFSoA& soa, VertexSeed& vtxSeed);
   bool solveVertex(VertexSeed& vtxSeed) const;
   FitStatus evalIterations(VertexSeed& vtxSeed, PVertex& vtx) const;
   TimeEst timeEstimate(const VertexingInput& input) const;
@@ -211,6 +215,7 @@ class PVertexer
   int mNKilledDebris = 0;
   int mNKilledQuality = 0;
   int mNKilledITSOnly = 0;
+  int mNThreads = 1;
   size_t mNTZClustersIni = 0;
   size_t mTotTrials = 0;
   size_t mMaxTrialPerCluster = 0;
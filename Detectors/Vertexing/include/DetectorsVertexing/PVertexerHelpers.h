@@ -16,6 +16,8 @@
 #ifndef O2_PVERTEXER_HELPERS_H
 #define O2_PVERTEXER_HELPERS_H
 
+#include <array>
+#include <vector>
 #include "gsl/span"
 #include "ReconstructionDataFormats/PrimaryVertex.h"
 #include "ReconstructionDataFormats/Track.h"
@@ -36,10 +38,13 @@ using V2TRef = o2::dataformats::VtxTrackRef;
 using GIndex = o2::dataformats::VtxTrackIndex;
 using GTrackID = o2::dataformats::GlobalTrackID;
 
+struct TrackVFSoA;
+
 struct VertexingInput {
   gsl::span<int> idRange;
   TimeEst timeEst{0, -1.}; // negative error means don't use time info
   float scaleSigma2 = 10;
+  TrackVFSoA* soa = nullptr; // if provided, SoA copy of the idRange tracks to use in the fit iterations
 };
 
 ///< weights and scaling params for current vertex
@@ -217,6 +222,106 @@ struct TrackVF {
   ClassDefNV(TrackVF, 1);
 };
 
+///< SoA copy of the TrackVF data of the vertexing input tracks, used for the vectorizable evaluation of the tracks
+///< contributions to the vertex fit. The contributions are evaluated exactly as in PVertexer::accountTrack, so that
+///< their summation in the tracks order reproduces the fit with TrackVF data
+struct TrackVFSoA {
+  enum Contrib { CXX,
+                 CXY,
+                 CXZ,
+                 CX0,
+                 CYY,
+                 CYZ,
+                 CY0,
+                 CZZ,
+                 CZ0,
+                 NContrib };
+  std::vector<float> x, y, z, sig2YI, sig2ZI, sigYZI, tgP, tgL, cosAlp, sinAlp, t, tErr, timeFromTB, use;
+  std::vector<float> accept, wgh, wghChi2, tAcc, tAccErr;   // per-track results of the last evaluation
+  std::array<std::vector<double>, NContrib> contrib;       // per-track contributions to the vertex fit linear equations
+  gsl::span<const int> ids;
+
+  int size() const { return ids.size(); }
+
+  void fill(const std::vector<TrackVF>& pool, gsl::span<const int> trackIDs)
+  {
+    ids = trackIDs;
+    int n = size();
+    for (auto* v : {&x, &y, &z, &sig2YI, &sig2ZI, &sigYZI, &tgP, &tgL, &cosAlp, &sinAlp, &t, &tErr, &timeFromTB, &use, &accept, &wgh, &wghChi2, &tAcc, &tAccErr}) {
+      v->resize(n);
+    }
+    for (auto& v : contrib) {
+      v.resize(n);
+    }
+    for (int i = 0; i < n; i++) {
+      const auto& trc = pool[ids[i]];
+      x[i] = trc.x;
+      y[i] = trc.y;
+      z[i] = trc.z;
+      sig2YI[i] = trc.sig2YI;
+      sig2ZI[i] = trc.sig2ZI;
+      sigYZI[i] = trc.sigYZI;
+      tgP[i] = trc.tgP;
+      tgL[i] = trc.tgL;
+      cosAlp[i] = trc.cosAlp;
+      sinAlp[i] = trc.sinAlp;
+      t[i] = trc.timeEst.getTimeStamp();
+      tErr[i] = trc.timeEst.getTimeStampError();
+      timeFromTB[i] = trc.gid.getSource() == GTrackID::ITS; // time error from the time bracket rather than gaussian error
+    }
+    updateUse(pool);
+  }
+
+  void updateUse(const std::vector<TrackVF>& pool)
+  {
+    for (int i = 0; i < size(); i++) {
+      use[i] = pool[ids[i]].canUse();
+    }
+  }
+
+  ///< evaluate Tukey weights and weighted contributions of all tracks wrt the vertex, branch-free to allow vectorization
+  void evaluate(const PVertex& vtx, bool useTime, float scaleSig2ITuk2I, float almost0)
+  {
+    constexpr float NDOF2I = 1. / 2, NDOF3I = 1. / 3;
+    const float vx = vtx.getX(), vy = vtx.getY(), vz = vtx.getZ(), vt = vtx.getTimeStamp().getTimeStamp();
+    const int n = size();
+    for (int i = 0; i < n; i++) {
+      float dx = vx * cosAlp[i] + vy * sinAlp[i] - x[i];
+      auto dy = y[i] + tgP[i] * dx - (-vx * sinAlp[i] + vy * cosAlp[i]);
+      auto dz = z[i] + tgL[i] * dx - vz;
+      float chi2T = (dy * dy * sig2YI[i] + dz * dz * sig2ZI[i]) + 2. * dy * dz * sigYZI[i];
+      float dt = t[i] - vt;
+      float chi2TT = chi2T + dt * dt / (tErr[i] * tErr[i]);
+      chi2T = useTime ? chi2TT * NDOF3I : chi2T * NDOF2I;
+      float wghT = (1.f - chi2T * scaleSig2ITuk2I);
+      accept[i] = !(wghT < almost0);
+      wghT *= wghT;
+      wgh[i] = wghT;
+      wghChi2[i] = wghT * chi2T;
+      float syyI(sig2YI[i] * wghT), szzI(sig2ZI[i] * wghT), syzI(sigYZI[i] * wghT);
+      double tmpSP = sinAlp[i] * tgP[i], tmpCP = cosAlp[i] * tgP[i],
+             tmpSC = sinAlp[i] + tmpCP, tmpCS = -cosAlp[i] + tmpSP,
+             tmpCL = cosAlp[i] * tgL[i], tmpSL = sinAlp[i] * tgL[i],
+             tmpYXP = y[i] - tgP[i] * x[i], tmpZXL = z[i] - tgL[i] * x[i],
+             tmpCLzz = tmpCL * szzI, tmpSLzz = tmpSL * szzI, tmpSCyz = tmpSC * syzI,
+             tmpCSyz = tmpCS * syzI, tmpCSyy = tmpCS * syyI, tmpSCyy = tmpSC * syyI,
+             tmpSLyz = tmpSL * syzI, tmpCLyz = tmpCL * syzI;
+      contrib[CXX][i] = tmpCL * (tmpCLzz + tmpSCyz + tmpSCyz) + tmpSC * tmpSCyy;
+      contrib[CXY][i] = tmpCL * (tmpSLzz + tmpCSyz) + tmpSL * tmpSCyz + tmpSC * tmpCSyy;
+      contrib[CXZ][i] = -sinAlp[i] * syzI - tmpCLzz - tmpCP * syzI;
+      contrib[CX0][i] = -(tmpCLyz + tmpSCyy) * tmpYXP - (tmpCLzz + tmpSCyz) * tmpZXL;
+      contrib[CYY][i] = tmpSL * (tmpSLzz + tmpCSyz + tmpCSyz) + tmpCS * tmpCSyy;
+      contrib[CYZ][i] = -(tmpCSyz + tmpSLzz);
+      contrib[CY0][i] = -tmpYXP * (tmpCSyy + tmpSLyz) - tmpZXL * (tmpCSyz + tmpSLzz);
+      contrib[CZZ][i] = szzI;
+      contrib[CZ0][i] = tmpZXL * szzI + tmpYXP * syzI;
+      float trErr2I = wghT / (tErr[i] * tErr[i]);
+      tAcc[i] = t[i] * trErr2I;
+      tAccErr[i] = trErr2I;
+    }
+  }
+};
+
 struct SeedHistoTZ : public o2::dataformats::FlatHisto2D_f {
   using o2::dataformats::FlatHisto2D<float>::FlatHisto2D;
 
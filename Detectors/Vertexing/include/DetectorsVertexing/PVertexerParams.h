@@ -58,6 +58,7 @@ struct PVertexerParams : public o2::conf::ConfigurableParamHelper<PVertexerParam
   bool useMeanVertexConstraint = true; ///< use MeanVertex as extra measured point
   float tukey = kDefTukey;             ///< Tukey parameter
   float iniScale2 = 5.;              ///< initial scale to assign
+  bool useSoAFitIteration = false;   ///< evaluate the tracks contributions to the fit in a vectorizable loop over SoA copy of time-Z cluster tracks (same results)
   float minScale2 = 1.;              ///< min scaling factor^2
   float acceptableScale2 = 4.;       ///< if below this factor, try to refit with minScale2
   float maxScale2 = 50;              ///< max slaling factor^2
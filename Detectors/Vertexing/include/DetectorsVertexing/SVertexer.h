@@ -108,6 +108,11 @@ class SVertexer
     }
   };
 
+  struct PairPreselInfo {
+    o2::track::TrackAuxPar aux{}; // circle parameters exactly as calculated by the DCAFitter
+    uint64_t phiMask = 0;         // azimuthal sectors where the track can produce a fitter seed
+  };
+
   SVertexer(bool enabCascades = true, bool enab3body = false) : mEnableCascades{enabCascades}, mEnable3BodyDecays{enab3body}
   {
   }
@@ -146,6 +151,7 @@ class SVertexer
   o2::strangeness_tracking::StrangenessTracker* getStrangenessTracker() { return mStrTracker; }
 
   std::array<size_t, 3> getNFitterCalls() const;
+  std::array<size_t, 4> getV0PreselCounters() const;
   void setSources(GIndex::mask_t src) { mSrc = src; }
 
  private:
@@ -156,6 +162,9 @@ class SVertexer
   int check3bodyDecays(const V0Index& v0Idx, const V0& v0, float rv0, std::array<float, 3> pV0, float p2V0, int avoidTrackID, int posneg, VBracket v0vlist, int ithread);
   void setupThreads();
   void buildT2V(const o2::globaltracking::RecoContainer& recoTracks);
+  void buildV0PairsPresel();
+  uint64_t getV0PreselPhiMask(const o2::track::TrackAuxPar& aux) const;
+  bool preselectV0Pair(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN) const;
   void updateTimeDependentParams();
   bool acceptTrack(const GIndex gid, const o2::track::TrackParCov& trc) const;
   bool processTPCTrack(const o2::tpc::TrackTPC& trTPC, GIndex gid, int vtxid);
@@ -185,6 +194,8 @@ class SVertexer
   std::vector<std::vector<Decay3BodyIndex>> m3bodyIdxTmp;
   std::array<std::vector<TrackCand>, 2> mTracksPool{}; // pools of positive and negative seeds sorted in min VtxID
   std::array<std::vector<int>, 2> mVtxFirstTrack{};    // 1st pos. and neg. track of the pools for each vertex
+  std::array<std::vector<PairPreselInfo>, 2> mPreselInfo{}; // V0 pairs pre-selection info of the pools tracks
+  std::vector<std::array<size_t, 4>> mV0PreselCounters;      // per thread: N pairs tested, rejected, rejected but fitted, rejected but giving V0
 
   o2::dataformats::VertexBase mMeanVertex{{0., 0., 0.}, {0.1 * 0.1, 0., 0.1 * 0.1, 0., 0., 6. * 6.}};
   const SVertexerParams* mSVParams = nullptr;
@@ -201,6 +212,7 @@ class SVertexer
   int mNV0s = 0, mNCascades = 0, mN3Bodies = 0, mNStrangeTracks = 0;
   float mBz = 0;
   float mMinR2ToMeanVertex = 0;
+  float mV0PreselMargin = 0; // max distance of the DCAFitter seed from the track circle, for the pre-selection
   float mMaxDCAXY2ToMeanVertex = 0;
   float mMaxDCAXY2ToMeanVertexV0Casc = 0;
   float mMaxDCAXY2ToMeanVertex3bodyV0 = 0;
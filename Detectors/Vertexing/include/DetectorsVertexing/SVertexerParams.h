@@ -43,6 +43,11 @@ struct SVertexerParams : public o2::conf::ConfigurableParamHelper<SVertexerParam
   float maxDXYIni = 4.;         ///< don't consider as a seed (circles intersection) if XY distance exceeds this
   float maxRIni = 150;          ///< don't consider as a seed (circles intersection) if its R exceeds this
   //
+  // V0 pairs pre-selection before the DCAFitter
+  int v0PairsPresel = 0;        ///< 0: fit all pairs with compatible vertices, 1: fit only pairs passing the pre-selection, 2: fit all pairs and validate the pre-selection
+  int v0PreselNPhiSectors = 64; ///< number of azimuthal sectors (max 64) of the pre-selection index
+  float v0PreselMinR = 0.;      ///< pre-selection ignores crossings below this R: 0 does not lose any fitted pair, >0 is faster but may lose low-R V0s
+  //
   // propagation options
   int matCorr = int(o2::base::Propagator::MatCorrType::USEMatCorrNONE); ///< material correction to use
   float minRFor3DField = 40;                                            ///< above this radius use 3D field
@@ -21,6 +21,9 @@
 #include <unordered_map>
 #include "CommonUtils/StringUtils.h"
 #include <TH2F.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::vertexing;
 using DetID = o2::detectors::DetID;
@@ -63,9 +66,28 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
   mTimeVertexing.Start();
-  int cntTZ = 0;
-  for (auto tc : mTimeZClusters) {
-    size_t nnold = verticesLoc.size();
+  // time-Z clusters have no tracks in common, they are processed independently, each with its own output which is then
+  // merged in the clusters order, so that the result does not depend on the number of threads
+  struct ClusterOutput {
+    std::vector<PVertex> vertices;
+    std::vector<uint32_t> trackIDs;
+    std::vector<V2TRef> v2tRefs;
+  };
+  int nTZClusters = mTimeZClusters.size();
+  std::vector<ClusterOutput> clOutput(nTZClusters);
+  std::vector<int> clOrder(nTZClusters); // largest clusters are scheduled first to balance the threads load
+  std::iota(clOrder.begin(), clOrder.end(), 0);
+  std::stable_sort(clOrder.begin(), clOrder.end(), [this](int i, int j) { return mTimeZClusters[i].trackIDs.size() > mTimeZClusters[j].trackIDs.size(); });
+  int nThreads = mNThreads;
+#ifdef _PV_DEBUG_TREE_
+  nThreads = 1; // debug output is not thread-safe
+#endif
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int ic = 0; ic < nTZClusters; ic++) {
+    auto& tc = mTimeZClusters[clOrder[ic]];
+    auto& out = clOutput[clOrder[ic]];
     VertexingInput inp;
     inp.idRange = gsl::span<int>(tc.trackIDs);
     inp.scaleSigma2 = mPVParams->iniScale2;
@@ -73,7 +95,19 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
 #ifdef _PV_DEBUG_TREE_
     doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    findVertices(inp, out.vertices, out.trackIDs, out.v2tRefs);
+  }
+  for (auto& out : clOutput) {
+    int vtxOffs = verticesLoc.size(), trOffs = trackIDs.size();
+    for (size_t iv = 0; iv < out.vertices.size(); iv++) {
+      verticesLoc.push_back(out.vertices[iv]);
+      const auto& ref = out.v2tRefs[iv];
+      v2tRefsLoc.emplace_back(ref.getFirstEntry() + trOffs, ref.getEntries());
+      for (int it = ref.getFirstEntry(); it < ref.getFirstEntry() + ref.getEntries(); it++) {
+        mTracksPool[out.trackIDs[it]].vtxID = vtxOffs + iv; // vertex ID in the cluster -> global vertex ID
+      }
+    }
+    trackIDs.insert(trackIDs.end(), out.trackIDs.begin(), out.trackIDs.end());
   }
   mTimeVertexing.Stop();
   // sort in time
@@ -178,6 +212,12 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
 
   int nfound = 0, ntr = 0;
   auto seedHistoTZ = buildHistoTZ(input); // histo for seeding peak finding
+  TrackVFSoA soa;
+  VertexingInput inp = input;
+  if (mPVParams->useSoAFitIteration) {
+    soa.fill(mTracksPool, input.idRange);
+    inp.soa = &soa;
+  }
 
 #ifdef _PV_DEBUG_TREE_
   static int dbsCount = -1;
@@ -204,8 +244,11 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
     PVertex vtx;
     mMeanVertex.setMeanXYVertexAtZ(vtx, zv);
     vtx.setTimeStamp({tv, 0.f});
-    if (findVertex(input, vtx)) {
-      finalizeVertex(input, vtx, vertices, v2tRefs, trackIDs, &seedHistoTZ);
+    if (findVertex(inp, vtx)) {
+      finalizeVertex(inp, vtx, vertices, v2tRefs, trackIDs, &seedHistoTZ);
+      if (inp.soa) {
+        soa.updateUse(mTracksPool);
+      }
       nfound++;
       nTrials = 0;
     } else {                                                                    // suppress failed seeding bin and its proximities
@@ -223,19 +266,29 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
     auto clTime = tCurr - tStart;
     if (clTime > mPVParams->maxTimeMSPerCluster) {
       LOGP(warn, "Time per TZ-cluster ({}ms) of {} tracks exceeded limit after {} trials, abandon", clTime, mult, nTrials);
-      if (!mPoolDumpProduced) {
-        dumpPool();
+#ifdef WITH_OPENMP
+#pragma omp critical(PVertexerPoolDump)
+#endif
+      {
+        if (!mPoolDumpProduced) {
+          dumpPool();
+        }
       }
       break;
     }
   }
-  mTotTrials += nTrials;
-  if (size_t(nTrials) > mMaxTrialPerCluster) {
-    mMaxTrialPerCluster = nTrials;
-  }
-  if (tCurr - tStart > mLongestClusterTimeMS) {
-    mLongestClusterTimeMS = tCurr - tStart;
-    mLongestClusterMult = mult;
+#ifdef WITH_OPENMP
+#pragma omp critical(PVertexerStat)
+#endif
+  {
+    mTotTrials += nTrials;
+    if (size_t(nTrials) > mMaxTrialPerCluster) {
+      mMaxTrialPerCluster = nTrials;
+    }
+    if (tCurr - tStart > mLongestClusterTimeMS) {
+      mLongestClusterTimeMS = tCurr - tStart;
+      mLongestClusterMult = mult;
+    }
   }
   return nfound;
 }
@@ -295,12 +348,16 @@ bool PVertexer::findVertex(const VertexingInput& input, PVertex& vtx)
 PVertexer::FitStatus PVertexer::fitIteration(const VertexingInput& input, VertexSeed& vtxSeed)
 {
   int nTested = 0;
-  for (int i : input.idRange) {
-    if (mTracksPool[i].canUse()) {
-      accountTrack(mTracksPool[i], vtxSeed);
-      //      printf("#%d z:%f t:%f te:%f w:%f wh:%f\n", nTested, mTracksPool[i].z, mTracksPool[i].timeEst.getTimeStamp(),
-      //             mTracksPool[i].timeEst.getTimeStampError(), mTracksPool[i].wgh, mTracksPool[i].wghHisto);
-      nTested++;
+  if (input.soa) {
+    nTested = accountTracks(*input.soa, vtxSeed);
+  } else {
+    for (int i : input.idRange) {
+      if (mTracksPool[i].canUse()) {
+        accountTrack(mTracksPool[i], vtxSeed);
+        //      printf("#%d z:%f t:%f te:%f w:%f wh:%f\n", nTested, mTracksPool[i].z, mTracksPool[i].timeEst.getTimeStamp(),
+        //             mTracksPool[i].timeEst.getTimeStampError(), mTracksPool[i].wgh, mTracksPool[i].wghHisto);
+        nTested++;
+      }
     }
   }
 
@@ -382,6 +439,52 @@ void PVertexer::accountTrack(TrackVF& trc, VertexSeed& vtxSeed) const
   vtxSeed.addContributor();
 }
 
+//___________________________________________________________________
+int PVertexer::accountTracks(TrackVFSoA& soa, VertexSeed& vtxSeed)
+{
+  // equivalent of accountTrack for all usable tracks of the SoA: the weights and contributions evaluated in the
+  // vectorizable loop are summed in the tracks order, giving the same result as the accountTrack loop. Returns N tracks tested
+  bool useTime = vtxSeed.getTimeStamp().getTimeStampError() >= 0.f;
+  soa.evaluate(vtxSeed, useTime && mPVParams->useTimeInChi2, vtxSeed.scaleSig2ITuk2I, kAlmost0F);
+  int nTested = 0;
+  for (int i = 0; i < soa.size(); i++) {
+    if (!soa.use[i]) {
+      continue;
+    }
+    nTested++;
+    auto& trc = mTracksPool[soa.ids[i]];
+    if (!soa.accept[i]) {
+      trc.wgh = 0.f;
+      continue;
+    }
+    trc.wgh = soa.wgh[i];
+    vtxSeed.wghSum += soa.wgh[i];
+    vtxSeed.wghChi2 += soa.wghChi2[i];
+    vtxSeed.cxx += soa.contrib[TrackVFSoA::CXX][i];
+    vtxSeed.cxy += soa.contrib[TrackVFSoA::CXY][i];
+    vtxSeed.cxz += soa.contrib[TrackVFSoA::CXZ][i];
+    vtxSeed.cx0 += soa.contrib[TrackVFSoA::CX0][i];
+    vtxSeed.cyy += soa.contrib[TrackVFSoA::CYY][i];
+    vtxSeed.cyz += soa.contrib[TrackVFSoA::CYZ][i];
+    vtxSeed.cy0 += soa.contrib[TrackVFSoA::CY0][i];
+    vtxSeed.czz += soa.contrib[TrackVFSoA::CZZ][i];
+    vtxSeed.cz0 += soa.contrib[TrackVFSoA::CZ0][i];
+    if (useTime) {
+      if (soa.timeFromTB[i]) {
+        vtxSeed.tMeanAccTB += soa.tAcc[i];
+        vtxSeed.tMeanAccErrTB += soa.tAccErr[i];
+        vtxSeed.nContributorsTB++;
+        vtxSeed.wghSumTB += soa.wgh[i];
+      } else {
+        vtxSeed.tMeanAcc += soa.tAcc[i];
+        vtxSeed.tMeanAccErr += soa.tAccErr[i];
+      }
+    }
+    vtxSeed.addContributor();
+  }
+  return nTested;
+}
+
 //___________________________________________________________________
 bool PVertexer::solveVertex(VertexSeed& vtxSeed) const
 {
@@ -855,6 +958,16 @@ void PVertexer::init()
 #endif
 }
 
+//___________________________________________________________________
+void PVertexer::setNThreads(int n)
+{
+#ifdef WITH_OPENMP
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
 //___________________________________________________________________
 void PVertexer::end()
 {
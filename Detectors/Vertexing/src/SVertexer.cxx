@@ -47,6 +47,10 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
   mPVertices = recoData.getPrimaryVertices();
   buildT2V(recoData); // build track->vertex refs from vertex->track (if other workflow will need this, consider producing a message in the VertexTrackMatcher)
   int ntrP = mTracksPool[POS].size(), ntrN = mTracksPool[NEG].size();
+  const int preselMode = mSVParams->v0PairsPresel;
+  if (preselMode) {
+    buildV0PairsPresel();
+  }
   if (mStrTracker) {
     mStrTracker->loadData(recoData);
     mStrTracker->prepareITStracks();
@@ -76,7 +80,32 @@ void SVertexer::process(const o2::globaltracking::RecoContainer& recoData, o2::f
 #else
       int iThread = 0;
 #endif
-      checkV0(seedP, seedN, itp, itn, iThread);
+      if (!preselMode) {
+        checkV0(seedP, seedN, itp, itn, iThread);
+        continue;
+      }
+      auto& counters = mV0PreselCounters[iThread];
+      counters[0]++;
+      if (preselectV0Pair(seedP, seedN, itp, itn)) {
+        checkV0(seedP, seedN, itp, itn, iThread);
+        continue;
+      }
+      counters[1]++;
+      if (preselMode == 2) { // validation: the rejected pair must produce neither fitter candidate nor V0
+        bool gotV0 = checkV0(seedP, seedN, itp, itn, iThread);
+        if (mFitterV0[iThread].getNCandidates()) {
+          counters[2]++;
+          LOG(debug) << "Pre-selection rejected fitted pair " << seedP.gid.asString() << " " << seedN.gid.asString() << (gotV0 ? " giving V0" : "");
+        }
+        counters[3] += gotV0;
+      }
+    }
+  }
+  if (preselMode) {
+    auto cnt = getV0PreselCounters();
+    LOGP(info, "V0 pairs pre-selection rejected {} of {} pairs", cnt[1], cnt[0]);
+    if (preselMode == 2) {
+      LOGP(info, "V0 pairs pre-selection validation: {} rejected pairs were fitted, {} gave V0", cnt[2], cnt[3]);
     }
   }
 
@@ -360,6 +389,10 @@ void SVertexer::setupThreads()
     fitter.setMaxSnp(mSVParams->maxSnp);
     fitter.setMinXSeed(mSVParams->minXSeed);
   }
+  // the DCAFitter seed is either at the circles crossing or between the circles (at most maxDXYIni apart) or between
+  // 2 merged crossings, add some tolerance for the precision
+  mV0PreselMargin = 0.5f * std::max(mSVParams->maxDXYIni, std::sqrt(mFitterV0[0].getMaxDistance2ToMerge())) + 0.1f;
+  mV0PreselCounters.resize(mNThreads);
   mFitterCasc.resize(mNThreads);
   fitCounter = 1000;
   for (auto& fitter : mFitterCasc) {
@@ -570,6 +603,111 @@ void SVertexer::buildT2V(const o2::globaltracking::RecoContainer& recoData) // a
   LOG(info) << "Collected " << mTracksPool[POS].size() << " positive and " << mTracksPool[NEG].size() << " negative seeds";
 }
 
+//__________________________________________________________________
+void SVertexer::buildV0PairsPresel()
+{
+  // cache the tracks circles and build the azimuthal sectors masks of the V0 pairs pre-selection
+  for (int pn = 0; pn < 2; pn++) {
+    const auto& tracksPool = mTracksPool[pn];
+    auto& preselInfo = mPreselInfo[pn];
+    preselInfo.resize(tracksPool.size());
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNThreads)
+#endif
+    for (int i = 0; i < (int)tracksPool.size(); i++) {
+      preselInfo[i].aux.set(tracksPool[i], mBz);
+      preselInfo[i].phiMask = getV0PreselPhiMask(preselInfo[i].aux);
+    }
+  }
+  for (auto& counters : mV0PreselCounters) {
+    counters = {};
+  }
+}
+
+//__________________________________________________________________
+uint64_t SVertexer::getV0PreselPhiMask(const o2::track::TrackAuxPar& aux) const
+{
+  // mask of the azimuthal sectors hit by the points within mV0PreselMargin from the track circle and with maxRIni > R > v0PreselMinR,
+  // i.e. where the DCAFitter seeds of this track not nested into the circle of its partner can be
+  const int nSect = std::clamp(mSVParams->v0PreselNPhiSectors, 1, 64);
+  const uint64_t maskAll = nSect == 64 ? ~uint64_t(0) : (uint64_t(1) << nSect) - 1;
+  if (aux.rC < o2::constants::math::Almost0) { // straight line, no pre-selection
+    return maskAll;
+  }
+  const float sectW = o2::constants::math::TwoPI / nSect, dC = std::sqrt(aux.xC * aux.xC + aux.yC * aux.yC);
+  const float step = mV0PreselMargin, margin = mV0PreselMargin + 0.5f * step + 1e-5f * (aux.rC + dC); // the sampled points are within step/2 from any circle point
+  const float rMax = mSVParams->maxRIni + margin + step, rMin = mSVParams->v0PreselMinR - margin;
+  // the circle points are {xC + rC*cos(phi), yC + rC*sin(phi)}, sample the arc at R < rMax, centered at the point closest to the origin
+  float cosHalfArc = dC > o2::constants::math::Almost0 ? (dC * dC + aux.rC * aux.rC - rMax * rMax) / (2.f * aux.rC * dC) : (aux.rC < rMax ? -1.f : 2.f);
+  if (cosHalfArc > 1.f) { // the circle does not reach rMax
+    return 0;
+  }
+  float halfArc = std::acos(std::max(cosHalfArc, -1.f)), phi0 = std::atan2(-aux.yC, -aux.xC) - halfArc;
+  int nSteps = 1 + int(2.f * halfArc * aux.rC / step);
+  float dPhi = 2.f * halfArc / nSteps;
+  uint64_t mask = 0;
+  for (int i = 0; i <= nSteps; i++) {
+    float sn, cs;
+    o2::math_utils::sincos(phi0 + i * dPhi, sn, cs);
+    float x = aux.xC + aux.rC * cs, y = aux.yC + aux.rC * sn, r = std::sqrt(x * x + y * y);
+    if (r < rMin || r > rMax) {
+      continue;
+    }
+    if (r <= margin) { // the seed near the origin may be in any sector
+      return maskAll;
+    }
+    float phi = std::atan2(y, x), dphiMargin = std::asin(margin / r);
+    int sect0 = std::floor((phi - dphiMargin) / sectW), sect1 = std::floor((phi + dphiMargin) / sectW);
+    if (sect1 - sect0 + 1 >= nSect) {
+      return maskAll;
+    }
+    for (int is = sect0; is <= sect1; is++) {
+      mask |= uint64_t(1) << ((is % nSect + nSect) % nSect);
+    }
+  }
+  return mask;
+}
+
+//__________________________________________________________________
+bool SVertexer::preselectV0Pair(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN) const
+{
+  // check if the pair may produce a DCAFitter candidate: the fitter seeds of the pair should be in the common azimuthal sectors
+  // of both tracks (unless one circle is nested into another) and at least one of them should pass the fitter R cut.
+  // The seeds are calculated exactly as in the DCAFitterN::process
+  if (mSVParams->mTPCTrackPhotonTune && (seedP.gid.getSource() == GIndex::TPC || seedN.gid.getSource() == GIndex::TPC)) {
+    return true; // the fitter uses special settings for such pairs
+  }
+  const auto &auxP = mPreselInfo[POS][iP].aux, &auxN = mPreselInfo[NEG][iN].aux;
+  if (!(mPreselInfo[POS][iP].phiMask & mPreselInfo[NEG][iN].phiMask)) {
+    float dx = auxP.xC - auxN.xC, dy = auxP.yC - auxN.yC, dr = auxP.rC - auxN.rC;
+    bool nested = std::sqrt(dx * dx + dy * dy) < std::abs(dr) + mV0PreselMargin; // the seed of nested circles is not bound to be close to them
+    if (!nested && auxP.rC > o2::constants::math::Almost0 && auxN.rC > o2::constants::math::Almost0) {
+      return false;
+    }
+  }
+  const auto& fitter = mFitterV0[0];
+  o2::track::CrossInfo crossings;
+  if (!crossings.set(auxP, seedP, auxN, seedN, mSVParams->maxDXYIni, false)) {
+    return false;
+  }
+  if (crossings.nDCA == 2) {
+    auto dst2 = (crossings.xDCA[0] - crossings.xDCA[1]) * (crossings.xDCA[0] - crossings.xDCA[1]) +
+                (crossings.yDCA[0] - crossings.yDCA[1]) * (crossings.yDCA[0] - crossings.yDCA[1]);
+    if (dst2 < fitter.getMaxDistance2ToMerge()) {
+      crossings.nDCA = 1;
+      crossings.xDCA[0] = 0.5 * (crossings.xDCA[0] + crossings.xDCA[1]);
+      crossings.yDCA[0] = 0.5 * (crossings.yDCA[0] + crossings.yDCA[1]);
+    }
+  }
+  const float maxR2 = mSVParams->maxRIni * mSVParams->maxRIni;
+  for (int ic = 0; ic < crossings.nDCA; ic++) {
+    if (crossings.xDCA[ic] * crossings.xDCA[ic] + crossings.yDCA[ic] * crossings.yDCA[ic] <= maxR2) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //__________________________________________________________________
 bool SVertexer::checkV0(const TrackCand& seedP, const TrackCand& seedN, int iP, int iN, int ithread)
 {
@@ -1365,3 +1503,15 @@ std::array<size_t, 3> SVertexer::getNFitterCalls() const
   }
   return calls;
 }
+
+//__________________________________________________________________
+std::array<size_t, 4> SVertexer::getV0PreselCounters() const
+{
+  std::array<size_t, 4> cnt{};
+  for (const auto& thrCnt : mV0PreselCounters) {
+    for (int i = 0; i < 4; i++) {
+      cnt[i] += thrCnt[i];
+    }
+  }
+  return cnt;
+}
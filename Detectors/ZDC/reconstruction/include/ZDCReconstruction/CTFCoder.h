@@ -72,7 +72,7 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const gsl::span<const BCData>& tr
     mChanDataFilt.clear();
     mPedDataFilt.clear();
     for (const auto& trig : trigData) {
-      if (mIRFrameSelector.check(trig.ir) >= 0) {
+      if (mIRFrameSelector.isSelected(trig.ir)) {
         mTrgDataFilt.push_back(trig);
         auto chanIt = chanData.begin() + trig.ref.getFirstEntry();
         auto& trigC = mTrgDataFilt.back();
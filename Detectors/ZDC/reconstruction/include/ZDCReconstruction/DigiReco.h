@@ -169,8 +169,11 @@ class DigiReco
   int correctTDCSignal(int itdc, int16_t TDCVal, float TDCAmp, float& fTDCVal, float& fTDCAmp, bool isbeg, bool isend); /// Correct TDC single signal
   int correctTDCBackground(int ibc, int itdc, std::deque<DigiRecoTDC>& tdc);                                            /// TDC amplitude and time corrections due to pile-up from previous bunches
 
-  O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i); /// Interpolation for current TDC
-  void setPoint(int itdc, int ibeg, int iend, int i);                /// Interpolation for current TDC
+  O2_ZDC_DIGIRECO_FLT getPoint(int itdc, int ibeg, int iend, int i);                                 /// Interpolation for current TDC
+  void getPoints(int isig, int ibeg, int iend, int ifirst, int ilast, O2_ZDC_DIGIRECO_FLT* points); /// Interpolation of consecutive points
+  O2_ZDC_DIGIRECO_FLT getSample(int isig, int ibeg, int ii) const;                                   /// Acquired sample with constant extrapolation
+  void setPoint(int itdc, int ibeg, int iend, int i);                                                /// Interpolation for current TDC
+  void setPoints(int isig, int ibeg, int iend);                                                      /// Interpolation of all points for current signal
 
   void assignTDC(int ibun, int ibeg, int iend, int itdc, int tdc, float amp); /// Set reconstructed TDC values
   void findSignals(int ibeg, int iend);                                       /// Find signals around main-main that satisfy condition on TDC
@@ -189,6 +192,8 @@ class DigiReco
   const RecoConfigZDC* mRecoConfigZDC = nullptr; /// CCDB configuration parameters
   int32_t mVerbosity = DbgMinimal;
   O2_ZDC_DIGIRECO_FLT mTS[NTS];                     /// Tapered sinc function
+  O2_ZDC_DIGIRECO_FLT mTSPhase[2 * TSL * TSN];      /// Tapered sinc function ordered by phase of interpolated point
+  O2_ZDC_DIGIRECO_FLT mTSSum[TSN];                  /// Normalization of tapered sinc function for each phase
   bool mTreeDbg = false;                            /// Write reconstructed data in debug output file
   std::unique_ptr<TFile> mDbg = nullptr;            /// Debug output file
   std::unique_ptr<TTree> mTDbg = nullptr;           /// Debug tree
@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <algorithm>
 #include <TMath.h>
 #include "Framework/Logger.h"
 #include "ZDCReconstruction/DigiReco.h"
@@ -480,6 +481,17 @@ void DigiReco::prepareInterpolation()
     mTS[n + tsi] = fs * fg;
     mTS[n - tsi] = mTS[n + tsi]; // Function is even
   }
+  // Weights of the 2*TSL acquired samples contributing to a point with a given phase
+  // (i.e. position between two acquired samples) stored contiguously for consecutive
+  // phases, so that points sharing the same acquired samples are computed together
+  for (int im = 0; im < TSN; im++) {
+    O2_ZDC_DIGIRECO_FLT sum = 0;
+    for (int k = 0, is = TSN - im; k < 2 * TSL; k++, is += TSN) {
+      mTSPhase[k * TSN + im] = im == 0 ? 0 : mTS[is];
+      sum += mTSPhase[k * TSN + im];
+    }
+    mTSSum[im] = sum;
+  }
   LOG(info) << "Interpolation numeric precision is " << sizeof(O2_ZDC_DIGIRECO_FLT);
   LOG(info) << "Interpolation alpha = " << mAlpha;
 }
@@ -1405,30 +1417,70 @@ O2_ZDC_DIGIRECO_FLT DigiReco::getPoint(int isig, int ibeg, int iend, int i)
       // Do the actual interpolation
       O2_ZDC_DIGIRECO_FLT y = 0;
       int ip = i / TSN;
-      O2_ZDC_DIGIRECO_FLT sum = 0;
-      for (int is = TSN - im, ii = ip - TSL + 1; is < NTS; is += TSN, ii++) {
-        // Default is first point in the array
-        O2_ZDC_DIGIRECO_FLT yy = mFirstSample;
-        if (ii > 0) {
-          if (ii < mNsam) {
-            int ip = ii % NTimeBinsPerBC;
-            int ib = ibeg + ii / NTimeBinsPerBC;
-            yy = mReco[ib].data[isig][ip];
-            // yy = mChData[mReco[ib].ref[isig]].data[ip];
-          } else {
-            // Last acquired point
-            yy = mLastSample;
-          }
-        }
-        sum += mTS[is];
-        y += yy * mTS[is];
+      for (int k = 0, ii = ip - TSL + 1; k < 2 * TSL; k++, ii++) {
+        y += getSample(isig, ibeg, ii) * mTSPhase[k * TSN + im];
       }
-      y = y / sum;
+      y = y / mTSSum[im];
       return y;
     }
   }
 }
 
+O2_ZDC_DIGIRECO_FLT DigiReco::getSample(int isig, int ibeg, int ii) const
+{
+  // Default is first point in the array
+  if (ii <= 0) {
+    return mFirstSample;
+  }
+  if (ii >= mNsam) {
+    // Last acquired point
+    return mLastSample;
+  }
+  int ip = ii % NTimeBinsPerBC;
+  int ib = ibeg + ii / NTimeBinsPerBC;
+  return mReco[ib].data[isig][ip];
+  // return mChData[mReco[ib].ref[isig]].data[ip];
+}
+
+void DigiReco::getPoints(int isig, int ibeg, int iend, int ifirst, int ilast, O2_ZDC_DIGIRECO_FLT* points)
+{
+  // Interpolation of the points from ifirst to ilast (excluded). The same result is
+  // obtained as calling getPoint for each of them, but the points between two
+  // consecutive acquired samples are interpolated together from the same samples
+  // in a loop that can be vectorized
+  int ilastint = std::min(ilast, mIlast);
+  int i = ifirst;
+  while (i < ilast) {
+    int im = (i - TSNH) % TSN;
+    if (i < TSNH || i >= ilastint || im == 0) {
+      // Constant extrapolation, acquired point or addressing error
+      points[i - ifirst] = getPoint(isig, ibeg, iend, i);
+      i++;
+      continue;
+    }
+    int ip = (i - TSNH) / TSN;
+    int np = std::min(TSN - im, ilastint - i);
+    O2_ZDC_DIGIRECO_FLT yy[2 * TSL];
+    for (int k = 0, ii = ip - TSL + 1; k < 2 * TSL; k++, ii++) {
+      yy[k] = getSample(isig, ibeg, ii);
+    }
+    O2_ZDC_DIGIRECO_FLT* y = points + (i - ifirst);
+    for (int j = 0; j < np; j++) {
+      y[j] = 0;
+    }
+    for (int k = 0; k < 2 * TSL; k++) {
+      const O2_ZDC_DIGIRECO_FLT* ts = &mTSPhase[k * TSN + im];
+      for (int j = 0; j < np; j++) {
+        y[j] += yy[k] * ts[j];
+      }
+    }
+    for (int j = 0; j < np; j++) {
+      y[j] = y[j] / mTSSum[im + j];
+    }
+    i += np;
+  }
+}
+
 void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
 {
   // This function needs to be used only if mFullInterpolation is true otherwise the
@@ -1459,6 +1511,21 @@ void DigiReco::setPoint(int isig, int ibeg, int iend, int i)
   }
 } // setPoint
 
+void DigiReco::setPoints(int isig, int ibeg, int iend)
+{
+  // Interpolation of all the points of signal isig, equivalent to calling setPoint for each of them
+  if (!mFullInterpolation) {
+    LOG(fatal) << __func__ << " call with mFullInterpolation = " << mFullInterpolation;
+    return;
+  }
+  O2_ZDC_DIGIRECO_FLT points[mNSB];
+  for (int ibun = ibeg; ibun <= iend; ibun++) {
+    int ifirst = (ibun - ibeg) * mNSB;
+    getPoints(isig, ibeg, iend, ifirst, ifirst + mNSB, points);
+    std::copy(points, points + mNSB, mReco[ibun].inter[isig].begin());
+  }
+} // setPoints
+
 int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
 {
   // Interpolation of signal isig, in consecutive bunches from ibeg to iend
@@ -1497,9 +1564,7 @@ int DigiReco::fullInterpolation(int isig, int ibeg, int iend)
   for (int ibun = ibeg; ibun <= iend; ibun++) {
     mReco[ibun].allocate(isig);
   }
-  for (int i = 0; i < mNtot; i++) {
-    setPoint(isig, ibeg, iend, i);
-  }
+  setPoints(isig, ibeg, iend);
   if (mInError) {
     return __LINE__;
   }
@@ -1554,9 +1619,7 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
     for (int ibun = ibeg; ibun <= iend; ibun++) {
       mReco[ibun].allocate(isig);
     }
-    for (int i = 0; i < mNtot; i++) {
-      setPoint(isig, ibeg, iend, i);
-    }
+    setPoints(isig, ibeg, iend);
   }
   if (mInError) {
     return __LINE__;
@@ -1693,9 +1756,11 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
           if (sbeg < 0) {
             sbeg = 0;
           }
+          // Perform interpolation for the searched points
+          O2_ZDC_DIGIRECO_FLT myvals[TSN];
+          getPoints(isig, ibeg, iend, sbeg, send, myvals);
           for (int spos = sbeg; spos < send; spos++) {
-            // Perform interpolation for the searched point
-            O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+            O2_ZDC_DIGIRECO_FLT myval = myvals[spos - sbeg];
             // Get local minimum of waveform
             if (myval < amp) {
               amp = myval;
@@ -1763,9 +1828,11 @@ int DigiReco::interpolate(int itdc, int ibeg, int iend)
         if (sbeg < 0) {
           sbeg = 0;
         }
+        // Perform interpolation for the searched points
+        O2_ZDC_DIGIRECO_FLT myvals[TSN];
+        getPoints(isig, ibeg, iend, sbeg, send, myvals);
         for (int spos = sbeg; spos < send; spos++) {
-          // Perform interpolation for the searched point
-          O2_ZDC_DIGIRECO_FLT myval = getPoint(isig, ibeg, iend, spos);
+          O2_ZDC_DIGIRECO_FLT myval = myvals[spos - sbeg];
           // Get local minimum of waveform
           if (myval < amp) {
             amp = myval;
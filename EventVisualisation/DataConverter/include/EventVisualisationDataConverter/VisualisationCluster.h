@@ -57,6 +57,9 @@ class VisualisationCluster
   float Z() const { return mCoordinates[2]; }
   float Time() const { return mTime; }
 
+  // Round the coordinates to the closest multiple of precision
+  void quantize(float precision);
+
  private:
   void setCoordinates(const float xyz[3]);
   float mCoordinates[3]; /// Vector of cluster's coordinates
@@ -70,6 +70,20 @@ class VisualisationEvent
   // Default constructor
   explicit VisualisationEvent(const VisualisationEventVO vo);
 
+  /// level of detail of the stored event
+  ///
+  /// Reduces the amount of data to write and to display for large (e.g. Pb-Pb) events
+  struct LevelOfDetail {
+    unsigned trackPointStep = 1; /// keep one track point every trackPointStep (first and last ones are always kept)
+    unsigned maxTrackPoints = 0; /// maximum number of points per track (0 means no limit)
+    unsigned clusterStep = 1;    /// keep one cluster every clusterStep, for the track and the global clusters
+    float precision = 0.f;       /// coordinates are rounded to a multiple of precision in cm (0 means no rounding)
+
+    bool isFull() const { return trackPointStep <= 1 && maxTrackPoints == 0 && clusterStep <= 1 && precision <= 0.f; }
+  };
+
+  void applyLevelOfDetail(const LevelOfDetail& lod);
+
   void appendAnotherEventCalo(const VisualisationEvent& another);
 
   VisualisationTrack* addTrack(VisualisationTrack::VisualisationTrackVO vo)
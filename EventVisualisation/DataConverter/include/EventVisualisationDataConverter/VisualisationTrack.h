@@ -96,6 +96,13 @@ class VisualisationTrack
   size_t getPointCount() const { return mPolyX.size(); }
   std::array<float, 3> getPoint(size_t i) const { return std::array<float, 3>{mPolyX[i], mPolyY[i], mPolyZ[i]}; }
 
+  // Keep one point every step, and at most maxPoints points if maxPoints > 0, always keeping the first and the last ones
+  void decimatePoints(unsigned step, unsigned maxPoints);
+  // Keep one cluster every step
+  void decimateClusters(unsigned step);
+  // Round the coordinates of the points and of the clusters to the closest multiple of precision
+  void quantize(float precision);
+
   VisualisationCluster& addCluster(const float pos[]);
   const VisualisationCluster& getCluster(int i) const { return mClusters[i]; };
   size_t getClusterCount() const { return mClusters.size(); } // Returns number of clusters
@@ -16,6 +16,7 @@
 
 #include "EventVisualisationDataConverter/VisualisationCluster.h"
 #include <iostream>
+#include <cmath>
 
 using namespace std;
 
@@ -38,5 +39,12 @@ void VisualisationCluster::setCoordinates(const float xyz[3])
   }
 }
 
+void VisualisationCluster::quantize(float precision)
+{
+  for (auto& coordinate : mCoordinates) {
+    coordinate = std::round(coordinate / precision) * precision;
+  }
+}
+
 } // namespace event_visualisation
 } // namespace o2
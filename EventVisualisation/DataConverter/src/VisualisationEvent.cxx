@@ -159,6 +159,32 @@ void VisualisationEvent::afterLoading()
   }
 }
 
+void VisualisationEvent::applyLevelOfDetail(const LevelOfDetail& lod)
+{
+  if (lod.isFull()) {
+    return;
+  }
+  for (auto& track : this->mTracks) {
+    track.decimatePoints(lod.trackPointStep, lod.maxTrackPoints);
+    track.decimateClusters(lod.clusterStep);
+    if (lod.precision > 0.f) {
+      track.quantize(lod.precision);
+    }
+  }
+  if (lod.clusterStep > 1) {
+    size_t nKept = 0;
+    for (size_t i = 0; i < this->mClusters.size(); i += lod.clusterStep) {
+      this->mClusters[nKept++] = this->mClusters[i];
+    }
+    this->mClusters.erase(this->mClusters.begin() + nKept, this->mClusters.end());
+  }
+  if (lod.precision > 0.f) {
+    for (auto& cluster : this->mClusters) {
+      cluster.quantize(lod.precision);
+    }
+  }
+}
+
 VisualisationEvent VisualisationEvent::limit(std::size_t maximum_number_of_items)
 {
   VisualisationEvent result = *this;
@@ -18,6 +18,8 @@
 
 #include "EventVisualisationDataConverter/VisualisationTrack.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace o2::event_visualisation
@@ -77,6 +79,60 @@ void VisualisationTrack::addPolyPoint(const float p[])
   mPolyZ.push_back(p[2]);
 }
 
+void VisualisationTrack::decimatePoints(unsigned step, unsigned maxPoints)
+{
+  const size_t nPoints = mPolyX.size();
+  if (maxPoints > 0 && nPoints > maxPoints) {
+    maxPoints = std::max(maxPoints, 2u);
+    step = std::max<size_t>(step, (nPoints - 2) / (maxPoints - 1) + 1); // ceil((nPoints - 1) / (maxPoints - 1))
+  }
+  if (step <= 1 || nPoints <= 2) {
+    return;
+  }
+  size_t nKept = 0;
+  auto keep = [this, &nKept](size_t i) {
+    mPolyX[nKept] = mPolyX[i];
+    mPolyY[nKept] = mPolyY[i];
+    mPolyZ[nKept] = mPolyZ[i];
+    nKept++;
+  };
+  for (size_t i = 0; i < nPoints; i += step) {
+    keep(i);
+  }
+  if ((nPoints - 1) % step != 0) {
+    if (maxPoints > 0 && nKept == maxPoints) {
+      nKept--; // the last point replaces the last kept one to respect the limit
+    }
+    keep(nPoints - 1);
+  }
+  mPolyX.resize(nKept);
+  mPolyY.resize(nKept);
+  mPolyZ.resize(nKept);
+}
+
+void VisualisationTrack::decimateClusters(unsigned step)
+{
+  if (step <= 1) {
+    return;
+  }
+  size_t nKept = 0;
+  for (size_t i = 0; i < mClusters.size(); i += step) {
+    mClusters[nKept++] = mClusters[i];
+  }
+  mClusters.erase(mClusters.begin() + nKept, mClusters.end());
+}
+
+void VisualisationTrack::quantize(float precision)
+{
+  auto round = [precision](float& coordinate) { coordinate = std::round(coordinate / precision) * precision; };
+  std::for_each(mPolyX.begin(), mPolyX.end(), round);
+  std::for_each(mPolyY.begin(), mPolyY.end(), round);
+  std::for_each(mPolyZ.begin(), mPolyZ.end(), round);
+  for (auto& cluster : mClusters) {
+    cluster.quantize(precision);
+  }
+}
+
 VisualisationCluster& VisualisationTrack::addCluster(const float pos[])
 {
   mClusters.emplace_back(pos, this->mTime, this->mBGID);
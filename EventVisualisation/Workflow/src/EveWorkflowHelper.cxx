@@ -38,6 +38,8 @@
 #include "EMCALCalib/CellRecalibrator.h"
 #include <TGeoBBox.h>
 #include <tuple>
+#include <filesystem>
+#include <system_error>
 #include <gsl/span>
 
 using namespace o2::event_visualisation;
@@ -466,7 +468,16 @@ void EveWorkflowHelper::save(const std::string& jsonPath, const std::string& ext
 {
   mEvent.setEveVersion(o2_eve_version);
   FileProducer producer(jsonPath, ext, numberOfFiles);
-  VisualisationEventSerializer::getInstance(ext)->toFile(mEvent, producer.newFileName());
+  // the event is written under a temporary name and renamed once complete, such that
+  // the displays watching the folder never read a partially written large event
+  const auto fileName = producer.newFileName();
+  const auto partialFileName = fileName + ".part";
+  VisualisationEventSerializer::getInstance(ext)->toFile(mEvent, partialFileName);
+  std::error_code error;
+  std::filesystem::rename(partialFileName, fileName, error);
+  if (error) {
+    LOGP(error, "cannot rename {} to {}: {}", partialFileName, fileName, error.message());
+  }
 }
 
 std::vector<PNT> EveWorkflowHelper::getTrackPoints(const o2::track::TrackPar& trc, float minR, float maxR, float maxStep, float minZ, float maxZ)
@@ -93,7 +93,11 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
     {"primary-vertex-min-x", VariantType::Float, -o2::constants::math::VeryBig, {"minimum x position for primary vertex"}},
     {"primary-vertex-max-x", VariantType::Float, o2::constants::math::VeryBig, {"maximum x position for primary vertex"}},
     {"primary-vertex-min-y", VariantType::Float, -o2::constants::math::VeryBig, {"minimum y position for primary vertex"}},
-    {"primary-vertex-max-y", VariantType::Float, o2::constants::math::VeryBig, {"maximum y position for primary vertex"}}};
+    {"primary-vertex-max-y", VariantType::Float, o2::constants::math::VeryBig, {"maximum y position for primary vertex"}},
+    {"lod-track-point-step", VariantType::Int, 1, {"store only one track point every n (the first and last points are always stored)"}},
+    {"lod-max-track-points", VariantType::Int, 0, {"maximum number of points stored per track (0 means no limit)"}},
+    {"lod-cluster-step", VariantType::Int, 1, {"store only one cluster every n, for the track and the standalone clusters"}},
+    {"lod-precision", VariantType::Float, 0.f, {"round the stored coordinates to a multiple of this precision in cm (0 means no rounding)"}}};
 
   o2::raw::HBFUtilsInitializer::addConfigOption(options);
   std::swap(workflowOptions, options);
@@ -220,6 +224,7 @@ void O2DPLDisplaySpec::run(ProcessingContext& pc)
         helper.mEvent.setRunType(this->mRunType);
         helper.mEvent.setPrimaryVertex(pv);
         helper.mEvent.setCreationTime(tinfo.creation);
+        helper.mEvent.applyLevelOfDetail(this->mLevelOfDetail);
         helper.save(this->mJsonPath, this->mExt, this->mNumberOfFiles);
         filesSaved++;
         currentTime = std::chrono::high_resolution_clock::now(); // time AFTER save
@@ -432,6 +437,12 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
   auto maxEMCALCellTime = cfgc.options().get<float>("emcal-max-celltime");
   auto minEMCALCellEnergy = cfgc.options().get<float>("emcal-min-cellenergy");
 
+  VisualisationEvent::LevelOfDetail levelOfDetail;
+  levelOfDetail.trackPointStep = std::max(cfgc.options().get<int>("lod-track-point-step"), 1);
+  levelOfDetail.maxTrackPoints = std::max(cfgc.options().get<int>("lod-max-track-points"), 0);
+  levelOfDetail.clusterStep = std::max(cfgc.options().get<int>("lod-cluster-step"), 1);
+  levelOfDetail.precision = std::max(cfgc.options().get<float>("lod-precision"), 0.f);
+
   if (numberOfTracks == -1) {
     tracksSorting = false; // do not sort if all tracks are allowed
   }
@@ -457,7 +468,7 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
     "o2-eve-export",
     dataRequest->inputs,
     {},
-    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, emcalCalibLoader, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, numberOfBytes, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY, maxEMCALCellTime, minEMCALCellEnergy)}});
+    AlgorithmSpec{adaptFromTask<O2DPLDisplaySpec>(disableWrite, useMC, srcTrk, srcCl, dataRequest, ggRequest, emcalCalibLoader, jsonFolder, ext, timeInterval, numberOfFiles, numberOfTracks, numberOfBytes, eveHostNameMatch, minITSTracks, minTracks, filterITSROF, filterTime, timeBracket, removeTPCEta, etaBracket, tracksSorting, onlyNthEvent, primaryVertexMode, maxPrimaryVertices, primaryVertexTriggers, primaryVertexMinZ, primaryVertexMaxZ, primaryVertexMinX, primaryVertexMaxX, primaryVertexMinY, primaryVertexMaxY, maxEMCALCellTime, minEMCALCellEnergy, levelOfDetail)}});
 
   // configure dpl timer to inject correct firstTForbit: start from the 1st orbit of TF containing 1st sampled orbit
   o2::raw::HBFUtilsInitializer hbfIni(cfgc, specs);
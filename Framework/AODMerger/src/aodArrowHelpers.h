@@ -0,0 +1,84 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// Helpers for the AODs stored as arrow files (see Framework/ArrowFileHelpers.h)
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/table.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+bool isIndexColumn(std::string const& name)
+{
+  return name.rfind("fIndex", 0) == 0 && (name.size() < 5 || name.compare(name.size() - 5, 5, "_size") != 0);
+}
+
+// Return a copy of the index column @a column, where each index is replaced
+// by f(index, row). Handles plain indices, index slices (fixed size lists)
+// and index arrays (lists), all of int32. Returns nullptr for any other type.
+std::shared_ptr<arrow::Array> transformIndices(std::shared_ptr<arrow::Array> const& column, std::function<int(int, int64_t)> const& f)
+{
+  std::shared_ptr<arrow::Int32Array> values;
+  std::function<std::pair<int64_t, int64_t>(int64_t)> range;
+  switch (column->type_id()) {
+    case arrow::Type::INT32:
+      values = std::static_pointer_cast<arrow::Int32Array>(column);
+      range = [](int64_t row) { return std::make_pair(row, row + 1); };
+      break;
+    case arrow::Type::FIXED_SIZE_LIST: {
+      auto list = std::static_pointer_cast<arrow::FixedSizeListArray>(column);
+      if (list->value_type()->id() != arrow::Type::INT32) {
+        return nullptr;
+      }
+      values = std::static_pointer_cast<arrow::Int32Array>(list->values());
+      range = [list](int64_t row) { return std::make_pair((int64_t)list->value_offset(row), (int64_t)list->value_offset(row) + list->value_length()); };
+    } break;
+    case arrow::Type::LIST: {
+      auto list = std::static_pointer_cast<arrow::ListArray>(column);
+      if (list->value_type()->id() != arrow::Type::INT32) {
+        return nullptr;
+      }
+      values = std::static_pointer_cast<arrow::Int32Array>(list->values());
+      range = [list](int64_t row) { return std::make_pair((int64_t)list->value_offset(row), (int64_t)list->value_offset(row + 1)); };
+    } break;
+    default:
+      return nullptr;
+  }
+
+  std::vector<int> transformed(values->raw_values(), values->raw_values() + values->length());
+  for (int64_t row = 0; row < column->length(); ++row) {
+    auto [begin, end] = range(row);
+    for (auto i = begin; i < end; ++i) {
+      transformed[i] = f(transformed[i], row);
+    }
+  }
+  arrow::Int32Builder builder;
+  std::shared_ptr<arrow::Array> newValues;
+  if (!builder.AppendValues(transformed).ok() || !builder.Finish(&newValues).ok()) {
+    return nullptr;
+  }
+
+  switch (column->type_id()) {
+    case arrow::Type::FIXED_SIZE_LIST: {
+      auto list = std::static_pointer_cast<arrow::FixedSizeListArray>(column);
+      return std::make_shared<arrow::FixedSizeListArray>(list->type(), list->length(), newValues, list->null_bitmap(), list->null_count(), list->offset());
+    }
+    case arrow::Type::LIST: {
+      auto list = std::static_pointer_cast<arrow::ListArray>(column);
+      return std::make_shared<arrow::ListArray>(list->type(), list->length(), list->value_offsets(), newValues, list->null_bitmap(), list->null_count(), list->offset());
+    }
+    default:
+      return newValues;
+  }
+}
@@ -13,6 +13,9 @@
 #include <list>
 #include <fstream>
 #include <getopt.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "TSystem.h"
 #include "TFile.h"
@@ -24,9 +27,338 @@
 #include <TGrid.h>
 #include <TMap.h>
 #include <TLeaf.h>
+#include <TROOT.h>
 
 #include "aodMerger.h"
+#include "aodArrowHelpers.h"
+#include "Framework/ArrowFileHelpers.h"
+#include <algorithm>
 #include <cinttypes>
+#include <filesystem>
+#include <vector>
+
+using o2::framework::ArrowFileHelpers;
+
+// Same as below, for AODs stored as directories of arrow files: dataframes
+// are concatenated until maxDirSize is reached, shifting the indices by
+// the number of rows which were already merged.
+int mergeArrow(std::vector<std::string> const& inputs, std::string const& outputName, long maxDirSize, bool skipNonExistingFiles, bool skipParentFilesList, int verbosity)
+{
+  int exitCode = 0;
+  std::map<std::string, std::vector<std::shared_ptr<arrow::Table>>> tables;
+  std::map<std::string, int64_t> rows;
+  std::map<std::string, uint64_t> sizes;
+  std::map<std::string, int> offsets;
+  std::map<std::string, int> unassignedIndexOffset;
+  ArrowFileHelpers::StringMap metaData;
+  ArrowFileHelpers::StringMap parentFiles;
+  std::string outputFolder;
+  long currentDirSize = 0;
+  int totalMergedDFs = 0;
+  int mergedDFs = 0;
+
+  std::filesystem::remove_all(outputName);
+
+  auto writeFolder = [&]() {
+    for (auto const& [treeName, parts] : tables) {
+      auto filename = ArrowFileHelpers::tablePath(outputName, outputFolder, treeName);
+      ArrowFileHelpers::writeTable(arrow::ConcatenateTables(parts).ValueOrDie(), filename);
+      sizes[treeName] += std::filesystem::file_size(filename);
+    }
+    tables.clear();
+    rows.clear();
+    offsets.clear();
+    outputFolder.clear();
+    mergedDFs = 0;
+  };
+
+  for (auto const& input : inputs) {
+    if (!ArrowFileHelpers::isArrowAOD(input)) {
+      printf("Error: Could not open input directory %s.\n", input.c_str());
+      if (skipNonExistingFiles) {
+        continue;
+      } else {
+        printf("Aborting merge!\n");
+        exitCode = 1;
+        break;
+      }
+    }
+    printf("Processing input directory: %s\n", input.c_str());
+
+    auto metaDataCurrentFile = ArrowFileHelpers::readMap(input + "/" + ArrowFileHelpers::metaDataName);
+    if (metaData.empty()) {
+      metaData = metaDataCurrentFile;
+    } else {
+      for (auto const& [key, value] : metaData) {
+        auto current = std::find_if(metaDataCurrentFile.begin(), metaDataCurrentFile.end(), [&key](auto const& kv) { return kv.first == key; });
+        if (current == metaDataCurrentFile.end()) {
+          printf("WARNING: Metadata differs between input files. Key %s is not present in current file\n", key.c_str());
+        } else if (current->second != value) {
+          printf("WARNING: Metadata differs between input files. Key %s : %s vs. %s\n", key.c_str(), value.c_str(), current->second.c_str());
+        }
+      }
+    }
+    if (!skipParentFilesList) {
+      auto parentFilesCurrentFile = ArrowFileHelpers::readMap(input + "/" + ArrowFileHelpers::parentFilesName);
+      parentFiles.insert(parentFiles.end(), parentFilesCurrentFile.begin(), parentFilesCurrentFile.end());
+    }
+
+    for (auto dfNumber : ArrowFileHelpers::listDataFrames(input)) {
+      auto dfName = "DF_" + std::to_string(dfNumber);
+      if (verbosity > 0) {
+        printf("  Processing folder %s\n", dfName.c_str());
+      }
+      ++mergedDFs;
+      ++totalMergedDFs;
+      if (outputFolder.empty()) {
+        outputFolder = dfName;
+        currentDirSize = 0;
+        if (verbosity > 0) {
+          printf("Writing to output folder %s\n", dfName.c_str());
+        }
+      }
+
+      std::vector<std::filesystem::path> files;
+      for (auto const& entry : std::filesystem::directory_iterator(input + "/" + dfName)) {
+        if (entry.path().extension() == ArrowFileHelpers::extension) {
+          files.push_back(entry.path());
+        }
+      }
+      std::sort(files.begin(), files.end());
+
+      std::list<std::string> foundTrees;
+      for (auto const& file : files) {
+        auto treeName = file.stem().string();
+        foundTrees.push_back(treeName);
+        if (tables.count(treeName) == 0 && mergedDFs > 1) {
+          printf("    *** FATAL ***: The tree %s was not in the previous dataframe(s)\n", treeName.c_str());
+          exitCode = 3;
+        }
+
+        auto table = ArrowFileHelpers::readTable(file.string());
+        if (verbosity > 1) {
+          printf("    Processing tree %s with %" PRId64 " entries\n", treeName.c_str(), table->num_rows());
+        }
+
+        // shift index columns by offset
+        int minIndexOffset = unassignedIndexOffset[treeName];
+        auto newMinIndexOffset = minIndexOffset;
+        auto columns = table->columns();
+        for (int ci = 0; ci < table->num_columns(); ++ci) {
+          auto const& name = table->field(ci)->name();
+          if (!isIndexColumn(name)) {
+            continue;
+          }
+          int offset = offsets[getTableName(name.c_str(), treeName.c_str())];
+          arrow::ArrayVector chunks;
+          for (auto const& chunk : columns[ci]->chunks()) {
+            auto shifted = transformIndices(chunk, [&](int index, int64_t) {
+              // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
+              if (index < 0) {
+                index += minIndexOffset;
+                newMinIndexOffset = std::min(newMinIndexOffset, index);
+                return index;
+              }
+              return index + offset;
+            });
+            chunks.push_back(shifted ? shifted : chunk);
+          }
+          columns[ci] = std::make_shared<arrow::ChunkedArray>(chunks, columns[ci]->type());
+        }
+        unassignedIndexOffset[treeName] = newMinIndexOffset;
+
+        tables[treeName].push_back(arrow::Table::Make(table->schema(), columns, table->num_rows()));
+        rows[treeName] += table->num_rows();
+        currentDirSize += std::filesystem::file_size(file);
+      }
+      if (exitCode > 0) {
+        break;
+      }
+
+      // check if all trees were present
+      if (mergedDFs > 1) {
+        for (auto const& tree : tables) {
+          bool found = (std::find(foundTrees.begin(), foundTrees.end(), tree.first) != foundTrees.end());
+          if (found == false) {
+            printf("  *** FATAL ***: The tree %s was not in the current dataframe\n", tree.first.c_str());
+            exitCode = 4;
+          }
+        }
+      }
+
+      // set to -1 to identify not found tables
+      for (auto& offset : offsets) {
+        offset.second = -1;
+      }
+
+      // update offsets
+      for (auto const& tree : rows) {
+        offsets[removeVersionSuffix(tree.first.c_str())] = tree.second;
+      }
+
+      // check for not found tables
+      for (auto& offset : offsets) {
+        if (offset.second < 0) {
+          if (maxDirSize > 0) {
+            // if maxDirSize is 0 then we do not merge DFs and this error is not an error actually (e.g. for not self-contained derived data)
+            printf("ERROR: Index on %s but no tree found\n", offset.first.c_str());
+          }
+          offset.second = 0;
+        }
+      }
+
+      if (maxDirSize == 0 || currentDirSize > maxDirSize) {
+        if (verbosity > 0) {
+          printf("Maximum size reached: %ld. Closing folder %s.\n", currentDirSize, outputFolder.c_str());
+        }
+        writeFolder();
+      }
+    }
+    if (exitCode > 0) {
+      break;
+    }
+  }
+
+  if (exitCode == 0) {
+    if (!tables.empty()) {
+      writeFolder();
+    }
+    if (!metaData.empty()) {
+      ArrowFileHelpers::writeMap(metaData, outputName + "/" + ArrowFileHelpers::metaDataName);
+    }
+    if (!parentFiles.empty()) {
+      ArrowFileHelpers::writeMap(parentFiles, outputName + "/" + ArrowFileHelpers::parentFilesName);
+    }
+  }
+
+  if (totalMergedDFs == 0) {
+    printf("ERROR: Did not merge a single DF. This does not seem right.\n");
+    exitCode = 2;
+  }
+
+  // in case of failure, remove the incomplete output
+  if (exitCode != 0) {
+    printf("Removing incomplete output %s.\n", outputName.c_str());
+    std::filesystem::remove_all(outputName);
+  } else {
+    printf("AOD merger finished. Size overview follows:\n");
+    uint64_t total = 0;
+    for (auto const& tree : sizes) {
+      total += tree.second;
+    }
+    if (total > 0) {
+      for (auto const& tree : sizes) {
+        printf("  Tree %20s | Size: %12" PRIu64 " (%2.0f%%)\n", tree.first.c_str(), tree.second, 100.0 * tree.second / total);
+      }
+    }
+  }
+  printf("\n");
+
+  return exitCode;
+}
+
+// Copies the remote input files to a local directory in a background thread, while the
+// previous ones are merged, so that the merging does not wait for the network. At most
+// maxBytes of copied files which were not merged yet are kept (at least one file).
+class InputPrefetcher
+{
+ public:
+  InputPrefetcher(std::vector<std::string> const& inputs, long maxBytes, int verbosity)
+    : mInputs(inputs), mLocal(inputs.size()), mDone(inputs.size(), false), mMaxBytes(maxBytes), mVerbosity(verbosity)
+  {
+    mDirectory = std::filesystem::temp_directory_path() / ("aod-merger-" + std::to_string(gSystem->GetPid()));
+    std::filesystem::create_directories(mDirectory);
+    mThread = std::thread([this]() { run(); });
+  }
+
+  ~InputPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    mThread.join();
+    std::filesystem::remove_all(mDirectory);
+  }
+
+  // the file to open for input i, waiting for its copy to be completed
+  std::string get(size_t i)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this, i]() { return mDone[i]; });
+    return mLocal[i];
+  }
+
+  // input i was merged, its local copy can be removed
+  void release(size_t i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mDone[i] || mLocal[i] == mInputs[i]) {
+        return;
+      }
+      std::error_code ec;
+      mStagedBytes -= std::filesystem::file_size(mLocal[i], ec);
+      std::filesystem::remove(mLocal[i], ec);
+      mLocal[i] = mInputs[i];
+    }
+    mCondition.notify_all();
+  }
+
+  static bool isRemote(std::string const& input)
+  {
+    return input.rfind("alien:", 0) == 0 || (input.find("://") != std::string::npos && input.rfind("file:", 0) != 0);
+  }
+
+ private:
+  void run()
+  {
+    for (size_t i = 0; i < mInputs.size(); ++i) {
+      std::string local = mInputs[i];
+      if (isRemote(mInputs[i])) {
+        {
+          std::unique_lock<std::mutex> lock(mMutex);
+          mCondition.wait(lock, [this]() { return mStop || mStagedBytes == 0 || mStagedBytes < mMaxBytes; });
+          if (mStop) {
+            return;
+          }
+        }
+        auto copy = (mDirectory / ("input_" + std::to_string(i) + ".root")).string();
+        if (TFile::Cp(mInputs[i].c_str(), copy.c_str(), kFALSE)) {
+          local = copy;
+        } else {
+          printf("WARNING: Could not prefetch %s, it will be read remotely.\n", mInputs[i].c_str());
+        }
+        if (mVerbosity > 1 && local == copy) {
+          printf("  Prefetched %s\n", mInputs[i].c_str());
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (local != mInputs[i]) {
+          std::error_code ec;
+          mStagedBytes += std::filesystem::file_size(local, ec);
+        }
+        mLocal[i] = local;
+        mDone[i] = true;
+      }
+      mCondition.notify_all();
+    }
+  }
+
+  std::vector<std::string> mInputs;
+  std::vector<std::string> mLocal;
+  std::vector<bool> mDone;
+  long mMaxBytes;
+  long mStagedBytes = 0;
+  int mVerbosity;
+  std::filesystem::path mDirectory;
+  bool mStop = false;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+};
 
 // AOD merger with correct index rewriting
 // No need to know the datamodel because the branch names follow a canonical standard (identified by fIndex)
@@ -37,6 +369,8 @@ int main(int argc, char* argv[])
   long maxDirSize = 100000000;
   bool skipNonExistingFiles = false;
   bool skipParentFilesList = false;
+  bool arrowFormat = false;
+  long prefetchSize = 0;
   int verbosity = 2;
   int exitCode = 0; // 0: success, >0: failure
 
@@ -49,6 +383,8 @@ int main(int argc, char* argv[])
     {"skip-parent-files-list", no_argument, nullptr, 4},
     {"verbosity", required_argument, nullptr, 5},
     {"help", no_argument, nullptr, 6},
+    {"arrow", no_argument, nullptr, 7},
+    {"prefetch-size", required_argument, nullptr, 8},
     {nullptr, 0, nullptr, 0}};
 
   while (true) {
@@ -67,6 +403,10 @@ int main(int argc, char* argv[])
       skipParentFilesList = true;
     } else if (c == 5) {
       verbosity = atoi(optarg);
+    } else if (c == 7) {
+      arrowFormat = true;
+    } else if (c == 8) {
+      prefetchSize = atol(optarg);
     } else if (c == 6) {
       printf("AO2D merging tool. Options: \n");
       printf("  --input <inputfile.txt>      Contains path to files to be merged. Default: %s\n", inputCollection.c_str());
@@ -75,6 +415,8 @@ int main(int argc, char* argv[])
       printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
       printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
       printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
+      printf("  --arrow                      Inputs and output are directories of arrow files instead of ROOT files.\n");
+      printf("  --prefetch-size <size in Bytes> Copy remote input files locally in the background, keeping at most this size of copies. Default: %ld (disabled).\n", prefetchSize);
       return -1;
     } else {
       return -2;
@@ -89,6 +431,19 @@ int main(int argc, char* argv[])
     printf("  WARNING: Skipping non-existing files.\n");
   }
 
+  std::vector<std::string> inputs;
+  {
+    std::ifstream in(inputCollection);
+    std::string line;
+    while (in >> line) {
+      inputs.push_back(line);
+    }
+  }
+
+  if (arrowFormat) {
+    return mergeArrow(inputs, outputFileName, maxDirSize, skipNonExistingFiles, skipParentFilesList, verbosity);
+  }
+
   std::map<std::string, TTree*> trees;
   std::map<std::string, uint64_t> sizeCompressed;
   std::map<std::string, uint64_t> sizeUncompressed;
@@ -99,32 +454,33 @@ int main(int argc, char* argv[])
   TDirectory* outputDir = nullptr;
   long currentDirSize = 0;
 
-  std::ifstream in;
-  in.open(inputCollection);
-  TString line;
-  bool connectedToAliEn = false;
   TMap* metaData = nullptr;
   TMap* parentFiles = nullptr;
   int totalMergedDFs = 0;
   int mergedDFs = 0;
-  while (in.good() && exitCode == 0) {
-    in >> line;
 
-    if (line.Length() == 0) {
-      continue;
-    }
+  // connect before the prefetching starts
+  if (std::any_of(inputs.begin(), inputs.end(), [](auto const& input) { return input.rfind("alien:", 0) == 0; })) {
+    printf("Connecting to AliEn...");
+    TGrid::Connect("alien:");
+  }
+  std::unique_ptr<InputPrefetcher> prefetcher;
+  if (prefetchSize > 0) {
+    ROOT::EnableThreadSafety();
+    prefetcher = std::make_unique<InputPrefetcher>(inputs, prefetchSize, verbosity);
+  }
 
-    if (line.BeginsWith("alien:") && !connectedToAliEn) {
-      printf("Connecting to AliEn...");
-      TGrid::Connect("alien:");
-      connectedToAliEn = true; // Only try once
-    }
+  for (size_t inputIndex = 0; inputIndex < inputs.size() && exitCode == 0; ++inputIndex) {
+    TString line = inputs[inputIndex].c_str();
 
     printf("Processing input file: %s\n", line.Data());
 
-    auto inputFile = TFile::Open(line);
+    auto inputFile = TFile::Open(prefetcher ? prefetcher->get(inputIndex).c_str() : line.Data());
     if (!inputFile) {
       printf("Error: Could not open input file %s.\n", line.Data());
+      if (prefetcher) {
+        prefetcher->release(inputIndex);
+      }
       if (skipNonExistingFiles) {
         continue;
       } else {
@@ -256,6 +612,7 @@ int main(int argc, char* argv[])
         auto outputTree = trees[treeName];
         // register index and connect VLA columns
         std::vector<std::pair<int*, int>> indexList;
+        std::vector<std::string> indexBranches;
         std::vector<char*> vlaPointers;
         std::vector<int*> indexPointers;
         TObjArray* branches = inputTree->GetListOfBranches();
@@ -286,6 +643,8 @@ int main(int argc, char* argv[])
               for (int i = 0; i < maximum; i++) {
                 indexList.push_back({reinterpret_cast<int*>(buffer + i * typeSize), offsets[getTableName(branchName, treeName)]});
               }
+              indexBranches.push_back(br->GetName());
+              indexBranches.push_back(((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount()->GetBranch()->GetName());
             }
           } else if (branchName.BeginsWith("fIndexSlice")) {
             int* buffer = new int[2];
@@ -297,6 +656,7 @@ int main(int argc, char* argv[])
 
             indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
             indexList.push_back({buffer + 1, offsets[getTableName(branchName, treeName)]});
+            indexBranches.push_back(br->GetName());
           } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
             int* buffer = new int;
             *buffer = 0;
@@ -306,10 +666,18 @@ int main(int argc, char* argv[])
             outputTree->SetBranchAddress(br->GetName(), buffer);
 
             indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
+            indexBranches.push_back(br->GetName());
           }
         }
 
         if (indexList.size() > 0) {
+          if (alreadyCopied) {
+            // the entries were copied by CloneTree, only the index columns have to be read to track the unassigned indices
+            inputTree->SetBranchStatus("*", 0);
+            for (auto const& name : indexBranches) {
+              inputTree->SetBranchStatus(name.c_str(), 1);
+            }
+          }
           auto entries = inputTree->GetEntries();
           int minIndexOffset = unassignedIndexOffset[treeName];
           auto newMinIndexOffset = minIndexOffset;
@@ -410,7 +778,11 @@ int main(int argc, char* argv[])
       }
     }
     inputFile->Close();
+    if (prefetcher) {
+      prefetcher->release(inputIndex);
+    }
   }
+  prefetcher.reset();
 
   if (parentFiles) {
     outputFile->cd();
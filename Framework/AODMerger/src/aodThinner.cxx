@@ -28,6 +28,281 @@
 #include "TLeaf.h"
 
 #include "aodMerger.h"
+#include "aodArrowHelpers.h"
+#include "Framework/ArrowFileHelpers.h"
+
+#include <arrow/compute/api_vector.h>
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <filesystem>
+#include <map>
+#include <regex>
+
+using o2::framework::ArrowFileHelpers;
+
+template <typename T>
+T const* columnValues(std::shared_ptr<arrow::Table> const& table, char const* name)
+{
+  auto column = table->GetColumnByName(name);
+  if (!column || column->num_chunks() == 0) {
+    return nullptr;
+  }
+  return std::static_pointer_cast<arrow::NumericArray<typename arrow::CTypeTraits<T>::ArrowType>>(column->chunk(0))->raw_values();
+}
+
+uint64_t directorySize(std::string const& directory)
+{
+  uint64_t size = 0;
+  for (auto const& entry : std::filesystem::recursive_directory_iterator(directory)) {
+    if (entry.is_regular_file()) {
+      size += entry.file_size();
+    }
+  }
+  return size;
+}
+
+// Same selections as below, for AODs stored as directories of arrow files
+int thinArrow(std::string const& inputName, std::string const& outputName, bool overwrite)
+{
+  int exitCode = 0;
+  if (!ArrowFileHelpers::isArrowAOD(inputName)) {
+    printf("Error: Could not open input directory %s.\n", inputName.c_str());
+    return 1;
+  }
+  if (std::filesystem::exists(outputName)) {
+    if (!overwrite) {
+      printf("Error: File %s exists or cannot be created!\n", outputName.c_str());
+      return 1;
+    }
+    std::filesystem::remove_all(outputName);
+  }
+  std::filesystem::create_directories(outputName);
+
+  TStopwatch clock;
+  clock.Start(kTRUE);
+
+  // Keep metaData and parentFiles
+  for (auto name : {ArrowFileHelpers::metaDataName, ArrowFileHelpers::parentFilesName}) {
+    auto from = inputName + "/" + name;
+    if (std::filesystem::exists(from)) {
+      std::filesystem::copy_file(from, outputName + "/" + name);
+    }
+  }
+
+  static const std::regex v0Re("O2v0_...");
+  for (auto dfNumber : ArrowFileHelpers::listDataFrames(inputName)) {
+    auto dfName = "DF_" + std::to_string(dfNumber);
+    printf("  Processing folder %s\n", dfName.c_str());
+
+    std::map<std::string, std::shared_ptr<arrow::Table>> tables;
+    for (auto const& entry : std::filesystem::directory_iterator(inputName + "/" + dfName)) {
+      if (entry.path().extension() == ArrowFileHelpers::extension) {
+        tables[entry.path().stem().string()] = ArrowFileHelpers::readTable(entry.path().string())->CombineChunks().ValueOrDie();
+      }
+    }
+
+    // Scan versions e.g. 001 or 002 ...
+    std::string v0Name{"O2v0_???"}, trkExtraName{"O2trackextra*"}, trackQAName{"O2trackqa*"};
+    bool hasTrackQA{false};
+    for (auto const& [name, table] : tables) {
+      if (std::regex_match(name, v0Re)) {
+        v0Name = name;
+      } else if (name.rfind("O2trackextra", 0) == 0) {
+        trkExtraName = name;
+      } else if (name.rfind("O2trackqa", 0) == 0) {
+        hasTrackQA = true;
+        trackQAName = name;
+      }
+    }
+
+    if (tables.count(trkExtraName) == 0) {
+      printf("%s table not found\n", trkExtraName.c_str());
+      exitCode = 6;
+      break;
+    }
+    if (tables.count("O2track_iu") == 0) {
+      printf("O2track_iu table not found\n");
+      exitCode = 7;
+      break;
+    }
+    if (tables.count(v0Name) == 0) {
+      printf("%s table not found\n", v0Name.c_str());
+      exitCode = 8;
+      break;
+    }
+    auto trackExtra = tables[trkExtraName];
+    auto nTracks = trackExtra->num_rows();
+
+    // We need to loop over the V0s once and flag the prong indices
+    std::vector<bool> keepV0s(nTracks, false);
+    auto v0s = tables[v0Name];
+    auto trackIdxPos = columnValues<int>(v0s, "fIndexTracks_Pos");
+    auto trackIdxNeg = columnValues<int>(v0s, "fIndexTracks_Neg");
+    for (int64_t i = 0; i < v0s->num_rows(); ++i) {
+      keepV0s[trackIdxPos[i]] = true;
+      keepV0s[trackIdxNeg[i]] = true;
+    }
+
+    // TrackQA
+    std::vector<bool> keepTrackQA;
+    if (hasTrackQA) {
+      keepTrackQA.assign(nTracks, false);
+      auto trackQA = tables[trackQAName];
+      auto trackIdx = columnValues<int>(trackQA, "fIndexTracks");
+      for (int64_t i = 0; i < trackQA->num_rows(); ++i) {
+        keepTrackQA[trackIdx[i]] = true;
+      }
+    }
+
+    // Test if track properties exist
+    auto schema = trackExtra->schema();
+    bool bTPClsFindable = schema->GetFieldIndex("fTPCNClsFindable") != -1;
+    bool bITSClusterMap = schema->GetFieldIndex("fITSClusterMap") != -1;
+    bool bITSClusterSizes = schema->GetFieldIndex("fITSClusterSizes") != -1;
+    bool bTRDPattern = schema->GetFieldIndex("fTRDPattern") != -1;
+    bool bTOFChi2 = schema->GetFieldIndex("fTOFChi2") != -1;
+
+    // Sanity-Check
+    // If any (%ITSClusterMap or %ITSClusterSizes) of these are not found, continuation is not possible, hence fataling
+    if (!bTPClsFindable || !bTRDPattern || !bTOFChi2 ||
+        (!bITSClusterMap && !bITSClusterSizes)) {
+      printf("    *** FATAL *** Branch detection failed in %s for trackextra.[(fITSClusterMap=%d,fITSClusterSizes=%d),fTPCNClsFindable=%d,fTRDPattern=%d,fTOFChi2=%d]\n", dfName.c_str(), bITSClusterMap, bITSClusterSizes, bTPClsFindable, bTRDPattern, bTOFChi2);
+      exitCode = 10;
+      break;
+    }
+    auto tpcNClsFindable = columnValues<uint8_t>(trackExtra, "fTPCNClsFindable");
+    auto ITSClusterMap = columnValues<uint8_t>(trackExtra, "fITSClusterMap");
+    auto ITSClusterSizes = columnValues<uint32_t>(trackExtra, "fITSClusterSizes");
+    auto TRDPattern = columnValues<uint8_t>(trackExtra, "fTRDPattern");
+    auto TOFChi2 = columnValues<float>(trackExtra, "fTOFChi2");
+    auto fIndexCollisions = columnValues<int>(tables["O2track_iu"], "fIndexCollisions");
+
+    // loop over all tracks
+    std::vector<int> acceptedTracks(nTracks, -1);
+    std::vector<bool> hasCollision(nTracks, false);
+    int counter = 0;
+    for (int64_t i = 0; i < nTracks; i++) {
+      // Flag collisions
+      hasCollision[i] = (fIndexCollisions[i] >= 0);
+
+      // Remove TPC only tracks, if they are not assoc. to a V0
+      if (tpcNClsFindable[i] > 0 && TRDPattern[i] == 0 && TOFChi2[i] < -1. &&
+          (!bITSClusterMap || ITSClusterMap[i] == 0) &&
+          (!bITSClusterSizes || ITSClusterSizes[i] == 0) &&
+          (!hasTrackQA || !keepTrackQA[i]) &&
+          !keepV0s[i]) {
+        counter++;
+      } else {
+        acceptedTracks[i] = i - counter;
+      }
+    }
+
+    for (auto const& [treeName, table] : tables) {
+      printf("    Processing tree %s with %" PRId64 " entries\n", treeName.c_str(), table->num_rows());
+
+      const bool processingTracked = treeName.rfind("O2tracked", 0) == 0;
+      const bool processingTrackQA = treeName.rfind("O2trackqa", 0) == 0;
+      const bool processingTracks = treeName.rfind("O2track", 0) == 0 && !processingTracked && !processingTrackQA; // matches any of the track tables and not tracked{v0s,cascase,3body} or trackqa;
+      const bool processingAmbiguousTracks = treeName.rfind("O2ambiguoustrack", 0) == 0;
+
+      auto entries = table->num_rows();
+      std::vector<bool> fillThisEntry(entries, true);
+      auto columns = table->columns();
+      if (processingTracks) {
+        // Special case for Tracks, TracksExtra, TracksCov
+        for (int64_t i = 0; i < entries; i++) {
+          fillThisEntry[i] = acceptedTracks[i] >= 0;
+        }
+      } else {
+        // Other table than Tracks* --> reassign indices to Tracks
+        for (int ci = 0; ci < table->num_columns(); ++ci) {
+          auto const& name = table->field(ci)->name();
+          // register index of track index ONLY
+          if (!isIndexColumn(name) || std::string(getTableName(name.c_str(), treeName.c_str())) != "O2track" || columns[ci]->num_chunks() == 0) {
+            continue;
+          }
+          if (columns[ci]->type()->id() == arrow::Type::LIST) {
+            printf("  *** FATAL ***: VLA detection is not supported\n");
+            exitCode = 9;
+            continue;
+          }
+          auto reassigned = transformIndices(columns[ci]->chunk(0), [&](int oldTrackIndex, int64_t row) {
+            // if negative, the index is unassigned.
+            if (oldTrackIndex >= 0) {
+              if (acceptedTracks[oldTrackIndex] < 0) {
+                fillThisEntry[row] = false;
+              } else {
+                return acceptedTracks[oldTrackIndex];
+              }
+            }
+            return oldTrackIndex;
+          });
+          if (reassigned) {
+            columns[ci] = std::make_shared<arrow::ChunkedArray>(reassigned);
+          }
+        }
+      }
+
+      // Keep only tracks which have no collision, see O2-3601
+      if (processingAmbiguousTracks) {
+        for (int64_t i = 0; i < entries; i++) {
+          if (hasCollision[i]) {
+            fillThisEntry[i] = false;
+          }
+        }
+      }
+
+      arrow::BooleanBuilder maskBuilder;
+      std::shared_ptr<arrow::Array> mask;
+      if (!maskBuilder.AppendValues(fillThisEntry).ok() || !maskBuilder.Finish(&mask).ok()) {
+        exitCode = 11;
+        break;
+      }
+      auto outputTable = arrow::compute::Filter(arrow::Table::Make(table->schema(), columns, entries), mask).ValueOrDie().table();
+
+      if (entries != outputTable->num_rows()) {
+        printf("      Reduced from %" PRId64 " to %" PRId64 " entries\n", entries, outputTable->num_rows());
+        // sanity check by hardcoding the trees for which we expect a reduction
+        const TString tableName{removeVersionSuffix(treeName.c_str())};
+        static const std::array<TString, 4> checkNames{"O2track", "O2trackextra", "O2trackcov", "O2ambiguoustrack"}; // O2track -> O2track_iu; O2trackcov -> O2trackcov_iu
+        if (std::none_of(checkNames.begin(), checkNames.end(), [&tableName](TString const& n) { return tableName.EqualTo(n); })) {
+          exitCode = 30;
+          printf("       -> Reduction is not expected for this tree!\n");
+          break;
+        }
+      }
+
+      ArrowFileHelpers::writeTable(outputTable, ArrowFileHelpers::tablePath(outputName, dfName, treeName));
+    }
+    if (exitCode > 0) {
+      break;
+    }
+  }
+
+  // in case of failure, remove the incomplete output
+  if (exitCode != 0) {
+    printf("Removing incomplete output %s.\n", outputName.c_str());
+    std::filesystem::remove_all(outputName);
+    return exitCode; // skip output below
+  }
+
+  clock.Stop();
+
+  // Report savings
+  auto sBefore = directorySize(inputName);
+  auto sAfter = directorySize(outputName);
+  if (sBefore <= 0 || sAfter <= 0) {
+    printf("Warning: Empty input or output file after thinning!\n");
+    exitCode = 9;
+  }
+  auto spaceSaving = (1 - ((double)sAfter) / ((double)sBefore)) * 100;
+  printf("Stats: After=%" PRIu64 " / Before=%" PRIu64 " Bytes ---> Saving %.1f%% diskspace!\n", sAfter, sBefore, spaceSaving);
+  printf("Timing: CPU=%.2f (s);   Real=%.2f (s)\n", clock.CpuTime(), clock.RealTime());
+  printf("End of AOD thinning.\n");
+
+  return exitCode;
+}
 
 // AOD reduction tool
 //   Designed for the 2022 pp data with specific selections:
@@ -42,14 +317,16 @@ int main(int argc, char* argv[])
   std::string outputFileName("AO2D_thinned.root");
   int exitCode = 0; // 0: success, !=0: failure
   bool bOverwrite = false;
+  bool bArrow = false;
 
   int option_index = 1;
 
-  const char* const short_opts = "i:o:KOh";
+  const char* const short_opts = "i:o:KOAh";
   static struct option long_options[] = {
     {"input", required_argument, nullptr, 'i'},
     {"output", required_argument, nullptr, 'o'},
     {"overwrite", no_argument, nullptr, 'O'},
+    {"arrow", no_argument, nullptr, 'A'},
     {"help", no_argument, nullptr, 'h'},
     {nullptr, 0, nullptr, 0}};
 
@@ -69,6 +346,9 @@ int main(int argc, char* argv[])
         bOverwrite = true;
         printf("Overwriting existing output file if existing\n");
         break;
+      case 'A':
+        bArrow = true;
+        break;
       case 'h':
       case '?':
       default:
@@ -78,6 +358,7 @@ int main(int argc, char* argv[])
         printf("\n");
         printf("  Optional Arguments:\n");
         printf("  --overwrite/-O                  Overwrite existing output file\n");
+        printf("  --arrow/-A                      Input and output are directories of arrow files instead of ROOT files\n");
         return -1;
     }
   }
@@ -86,6 +367,10 @@ int main(int argc, char* argv[])
   printf("  Input file: %s\n", inputFileName.c_str());
   printf("  Ouput file name: %s\n", outputFileName.c_str());
 
+  if (bArrow) {
+    return thinArrow(inputFileName, outputFileName, bOverwrite);
+  }
+
   TStopwatch clock;
   clock.Start(kTRUE);
 
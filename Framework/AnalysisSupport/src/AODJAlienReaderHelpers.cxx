@@ -41,6 +41,7 @@
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
 
+#include <filesystem>
 #include <thread>
 
 using namespace o2;
@@ -158,6 +159,9 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         LOGP(error, "Check the JSON document! Can not be properly parsed!");
       }
     }
+    if (options.isSet("aod-derived-cache-private")) {
+      didir->addCachedTables(options.get<std::string>("aod-derived-cache-private"), options.get<std::string>("aod-derived-cache-tables-private"));
+    }
 
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
@@ -267,8 +271,11 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             // Origin file name for derived output map
             auto o2 = Output(TFFileNameHeader);
             auto fileAndFolder = didir->getFileFolder(dh, fcnt, ntf);
-            std::string currentFilename(fileAndFolder.file->GetName());
-            if (strcmp(fileAndFolder.file->GetEndpointUrl()->GetProtocol(), "file") == 0 && fileAndFolder.file->GetEndpointUrl()->GetFile()[0] != '/') {
+            std::string currentFilename = didir->getCurrentFilename(dh);
+            if (!fileAndFolder.file) {
+              // A directory of arrow files, which is always local.
+              currentFilename = std::filesystem::absolute(currentFilename).string();
+            } else if (strcmp(fileAndFolder.file->GetEndpointUrl()->GetProtocol(), "file") == 0 && fileAndFolder.file->GetEndpointUrl()->GetFile()[0] != '/') {
               // This is not an absolute local path. Make it absolute.
               static std::string pwd = gSystem->pwd() + std::string("/");
               currentFilename = pwd + std::string(fileAndFolder.file->GetName());
@@ -283,6 +290,20 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       monitoring.send(Metric{(uint64_t)totalSizeUncompressed / 1000, "aod-bytes-read-uncompressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
       monitoring.send(Metric{(uint64_t)totalSizeCompressed / 1000, "aod-bytes-read-compressed"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
 
+      // throughput since the last report, at most once per second
+      static uint64_t lastRateTime = uv_hrtime();
+      static size_t lastRateSize = 0;
+      static uint64_t lastRateDF = 0;
+      auto rateTime = uv_hrtime();
+      if (rateTime - lastRateTime >= 1000000000) {
+        double elapsed = (double)(rateTime - lastRateTime) / 1.E9;
+        monitoring.send(Metric{(double)(totalSizeUncompressed - lastRateSize) / 1.E6 / elapsed, "aod-read-rate-mb-s"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        monitoring.send(Metric{(double)(totalDFSent - lastRateDF) / elapsed, "aod-df-rate-hz"}.addTag(Key::Subsystem, monitoring::tags::Value::DPL));
+        lastRateTime = rateTime;
+        lastRateSize = totalSizeUncompressed;
+        lastRateDF = totalDFSent;
+      }
+
       // save file number and time frame
       *fileCounter = (fcnt - device.inputTimesliceId) / device.maxInputTimeslices;
       *numTF = ntf;
@@ -295,7 +316,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       auto concrete = DataSpecUtils::asConcreteDataMatcher(firstRoute.matcher);
       auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
       auto fileAndFolder = didir->getFileFolder(dh, fcnt, ntf);
-      if (!fileAndFolder.file) {
+      if (fileAndFolder.folderName.empty()) {
         fcnt += 1;
         ntf = 0;
         if (didir->atEnd(fcnt)) {
@@ -15,6 +15,9 @@
 #include "Framework/Output.h"
 #include "Headers/DataHeader.h"
 #include "Framework/TableTreeHelpers.h"
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/ArrowTableSlicingCache.h"
+#include "Framework/DerivedTableCache.h"
 #include "Monitoring/Tags.h"
 #include "Monitoring/Metric.h"
 #include "Monitoring/Monitoring.h"
@@ -26,8 +29,12 @@
 #include "TGrid.h"
 #include "TObjString.h"
 #include "TMap.h"
+#include "TROOT.h"
+#include "TTree.h"
 
 #include <uv.h>
+#include <algorithm>
+#include <filesystem>
 
 #if __has_include(<TJAlienFile.h>)
 #include <TJAlienFile.h>
@@ -48,6 +55,28 @@ namespace o2::framework
 {
 using namespace rapidjson;
 
+namespace
+{
+bool readAheadEnabled()
+{
+  static bool enabled = getenv("DPL_AOD_READ_AHEAD") && atoi(getenv("DPL_AOD_READ_AHEAD"));
+  return enabled;
+}
+
+// Attach the slicing info of the sorted index columns to the tables which are read,
+// so that it is computed once here rather than by every task which groups by them.
+bool groupIndexEnabled()
+{
+  static bool enabled = getenv("DPL_AOD_GROUP_INDEX") && atoi(getenv("DPL_AOD_GROUP_INDEX"));
+  return enabled;
+}
+
+std::shared_ptr<arrow::Table> withGroupIndex(std::shared_ptr<arrow::Table> const& table)
+{
+  return groupIndexEnabled() ? ArrowTableSlicingCache::addGroupIndex(table) : table;
+}
+} // namespace
+
 FileNameHolder* makeFileNameHolder(std::string fileName)
 {
   auto fileNameHolder = new FileNameHolder();
@@ -117,20 +146,35 @@ bool DataInputDescriptor::setFile(int counter)
 
   // open file
   auto filename = mfilenames[counter]->fileName;
-  if (mcurrentFile) {
-    if (mcurrentFile->GetName() == filename) {
+  if (mcurrentFile || !mCurrentArrowAOD.empty()) {
+    if (getCurrentFilename() == filename) {
       return true;
     }
     closeInputFile();
   }
-  mcurrentFile = TFile::Open(filename.c_str());
-  if (!mcurrentFile) {
-    throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
-  }
-  mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
+  if (ArrowFileHelpers::isArrowAOD(filename)) {
+    // a directory of arrow files, which are mapped when read
+    mCurrentArrowAOD = filename;
+    mArrowBytesRead = 0;
+    mArrowTablesRead = 0;
+    auto parents = ArrowFileHelpers::readMap(filename + "/" + ArrowFileHelpers::parentFilesName);
+    if (!parents.empty()) {
+      mParentFileMap = new TMap();
+      mParentFileMap->SetOwnerKeyValue(true, true);
+      for (auto& [folder, parent] : parents) {
+        mParentFileMap->Add(new TObjString(folder.c_str()), new TObjString(parent.c_str()));
+      }
+    }
+  } else {
+    mcurrentFile = TFile::Open(filename.c_str());
+    if (!mcurrentFile) {
+      throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", filename));
+    }
+    mcurrentFile->SetReadaheadSize(50 * 1024 * 1024);
 
-  // get the parent file map if exists
-  mParentFileMap = (TMap*)mcurrentFile->Get("parentFiles"); // folder name (DF_XXX) --> parent file (absolute path)
+    // get the parent file map if exists
+    mParentFileMap = (TMap*)mcurrentFile->Get("parentFiles"); // folder name (DF_XXX) --> parent file (absolute path)
+  }
   if (mParentFileMap && !mParentFileReplacement.empty()) {
     auto pos = mParentFileReplacement.find(';');
     if (pos == std::string::npos) {
@@ -149,14 +193,18 @@ bool DataInputDescriptor::setFile(int counter)
 
   // get the directory names
   if (mfilenames[counter]->numberOfTimeFrames <= 0) {
-    std::regex TFRegex = std::regex("DF_[0-9]+");
-    TList* keyList = mcurrentFile->GetListOfKeys();
-
-    // extract TF numbers and sort accordingly
-    for (auto key : *keyList) {
-      if (std::regex_match(((TObjString*)key)->GetString().Data(), TFRegex)) {
-        auto folderNumber = std::stoul(std::string(((TObjString*)key)->GetString().Data()).substr(3));
-        mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(folderNumber);
+    if (!mCurrentArrowAOD.empty()) {
+      mfilenames[counter]->listOfTimeFrameNumbers = ArrowFileHelpers::listDataFrames(mCurrentArrowAOD);
+    } else {
+      std::regex TFRegex = std::regex("DF_[0-9]+");
+      TList* keyList = mcurrentFile->GetListOfKeys();
+
+      // extract TF numbers and sort accordingly
+      for (auto key : *keyList) {
+        if (std::regex_match(((TObjString*)key)->GetString().Data(), TFRegex)) {
+          auto folderNumber = std::stoul(std::string(((TObjString*)key)->GetString().Data()).substr(3));
+          mfilenames[counter]->listOfTimeFrameNumbers.emplace_back(folderNumber);
+        }
       }
     }
     if (mParentFileMap != nullptr) {
@@ -234,13 +282,13 @@ DataInputDescriptor* DataInputDescriptor::getParentFile(int counter, int numTF,
   auto parentFileName = (TObjString*)mParentFileMap->GetValue(folderName.c_str());
   if (!parentFileName) {
     // The current DF is not found in the parent map (this should not happen and is a fatal error)
-    throw std::runtime_error(fmt::format(R"(parent file map exists but does not contain the current DF "{}" in file "{}")", folderName.c_str(), mcurrentFile->GetName()));
+    throw std::runtime_error(fmt::format(R"(parent file map exists but does not contain the current DF "{}" in file "{}")", folderName.c_str(), getCurrentFilename()));
     return nullptr;
   }
 
   if (mParentFile) {
     // Is this still the corresponding to the correct file?
-    if (parentFileName->GetString().CompareTo(mParentFile->mcurrentFile->GetName()) == 0) {
+    if (parentFileName->GetString().CompareTo(mParentFile->getCurrentFilename().c_str()) == 0) {
       return mParentFile;
     } else {
       mParentFile->closeInputFile();
@@ -250,7 +298,7 @@ DataInputDescriptor* DataInputDescriptor::getParentFile(int counter, int numTF,
   }
 
   if (mLevel == mAllowedParentLevel) {
-    throw std::runtime_error(fmt::format(R"(while looking for tree "{}", the parent file was requested but we are already at level {} of maximal allowed level {} for DF "{}" in file "{}")", treename.c_str(), mLevel, mAllowedParentLevel, folderName.c_str(), mcurrentFile->GetName()));
+    throw std::runtime_error(fmt::format(R"(while looking for tree "{}", the parent file was requested but we are already at level {} of maximal allowed level {} for DF "{}" in file "{}")", treename.c_str(), mLevel, mAllowedParentLevel, folderName.c_str(), getCurrentFilename()));
   }
 
   LOGP(info, "Opening parent file {} for DF {}", parentFileName->GetString().Data(), folderName.c_str());
@@ -279,8 +327,12 @@ void DataInputDescriptor::printFileStatistics()
   if (wait_time < 0) {
     wait_time = 0;
   }
-  std::string monitoringInfo(fmt::format("lfn={},size={},total_df={},read_df={},read_bytes={},read_calls={},io_time={:.1f},wait_time={:.1f},level={}", mcurrentFile->GetName(),
-                                         mcurrentFile->GetSize(), getTimeFramesInFile(mCurrentFileID), getReadTimeFramesInFile(mCurrentFileID), mcurrentFile->GetBytesRead(), mcurrentFile->GetReadCalls(),
+  // for arrow files the mapped bytes and tables are reported
+  auto size = mcurrentFile ? mcurrentFile->GetSize() : (int64_t)mArrowBytesRead;
+  auto bytesRead = mcurrentFile ? mcurrentFile->GetBytesRead() : (int64_t)mArrowBytesRead;
+  auto readCalls = mcurrentFile ? mcurrentFile->GetReadCalls() : mArrowTablesRead;
+  std::string monitoringInfo(fmt::format("lfn={},size={},total_df={},read_df={},read_bytes={},read_calls={},io_time={:.1f},wait_time={:.1f},level={}", getCurrentFilename(),
+                                         size, getTimeFramesInFile(mCurrentFileID), getReadTimeFramesInFile(mCurrentFileID), bytesRead, readCalls,
                                          ((float)mIOTime / 1e9), ((float)wait_time / 1e9), mLevel));
 #if __has_include(<TJAlienFile.h>)
   auto alienFile = dynamic_cast<TJAlienFile*>(mcurrentFile);
@@ -292,9 +344,91 @@ void DataInputDescriptor::printFileStatistics()
   LOGP(info, "Read info: {}", monitoringInfo);
 }
 
+void DataInputDescriptor::waitReadAhead()
+{
+  if (!mReadAhead.result.valid()) {
+    return;
+  }
+  try {
+    mReadAhead.result.get();
+  } catch (std::exception const& e) {
+    LOGP(warn, "Reading ahead DF {} failed: {}", mReadAhead.numTF, e.what());
+  }
+}
+
+void DataInputDescriptor::startDataFrame(int counter, int numTF)
+{
+  if (counter == mLastCounter && numTF == mLastNumTF) {
+    return;
+  }
+  // What was requested for the previous dataframe is what we expect
+  // to be requested for the next one.
+  auto trees = std::move(mRequestedTrees);
+  mRequestedTrees.clear();
+  mPrefetched.clear();
+  mLastCounter = counter;
+  mLastNumTF = numTF;
+
+  if (mReadAhead.result.valid()) {
+    auto waitStart = uv_hrtime();
+    try {
+      auto prefetched = mReadAhead.result.get();
+      if (mReadAhead.counter == counter && mReadAhead.numTF == numTF) {
+        mPrefetched = std::move(prefetched);
+      }
+    } catch (std::exception const& e) {
+      LOGP(warn, "Reading ahead DF {} failed, reading it synchronously: {}", mReadAhead.numTF, e.what());
+    }
+    mIOTime += (uv_hrtime() - waitStart);
+  }
+
+  if (trees.empty() || !setFile(counter)) {
+    return;
+  }
+  auto* holder = mfilenames[counter];
+  if (numTF + 1 >= holder->numberOfTimeFrames) {
+    return;
+  }
+  // Reading from separate TFile instances in different threads is fine,
+  // as long as ROOT is told about it.
+  static bool threadSafety = (ROOT::EnableThreadSafety(), true);
+  (void)threadSafety;
+  mReadAhead.counter = counter;
+  mReadAhead.numTF = numTF + 1;
+  mReadAhead.result = std::async(std::launch::async, [&file = mReadAhead.file, fileName = holder->fileName, folderName = holder->listOfTimeFrameKeys[numTF + 1], trees = std::move(trees)]() {
+    if (!file || fileName != file->GetName()) {
+      file.reset(TFile::Open(fileName.c_str()));
+      if (!file) {
+        throw std::runtime_error(fmt::format("Couldn't open file \"{}\"!", fileName));
+      }
+      file->SetReadaheadSize(50 * 1024 * 1024);
+    }
+    std::vector<PrefetchedTree> result;
+    for (auto& treename : trees) {
+      std::unique_ptr<TTree> tree{(TTree*)file->Get((folderName + "/" + treename).c_str())};
+      // Trees which are not there, e.g. because they are in a parent
+      // file, will be read synchronously.
+      if (!tree) {
+        continue;
+      }
+      TreeToTable t2t;
+      t2t.setLabel(tree->GetName());
+      t2t.addAllColumns(tree.get());
+      t2t.fill(tree.get());
+      result.emplace_back(PrefetchedTree{treename, withGroupIndex(t2t.finalize()), (size_t)tree->GetZipBytes(), (size_t)tree->GetTotBytes()});
+    }
+    return result;
+  });
+}
+
 void DataInputDescriptor::closeInputFile()
 {
-  if (mcurrentFile) {
+  waitReadAhead();
+  mReadAhead.file.reset();
+  mPrefetched.clear();
+  mLastCounter = -1;
+  mLastNumTF = -1;
+  if (mcurrentFile || !mCurrentArrowAOD.empty()) {
     if (mParentFile) {
       mParentFile->closeInputFile();
       delete mParentFile;
@@ -305,10 +439,21 @@ void DataInputDescriptor::closeInputFile()
     mParentFileMap = nullptr;
 
     printFileStatistics();
-    mcurrentFile->Close();
-    delete mcurrentFile;
-    mcurrentFile = nullptr;
+    if (mcurrentFile) {
+      mcurrentFile->Close();
+      delete mcurrentFile;
+      mcurrentFile = nullptr;
+    }
+    mCurrentArrowAOD.clear();
+  }
+}
+
+std::string DataInputDescriptor::getCurrentFilename()
+{
+  if (mcurrentFile) {
+    return mcurrentFile->GetName();
   }
+  return mCurrentArrowAOD;
 }
 
 int DataInputDescriptor::fillInputfiles()
@@ -367,6 +512,31 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
 {
   auto ioStart = uv_hrtime();
 
+  if (!setFile(counter)) {
+    return false;
+  }
+  if (!mCurrentArrowAOD.empty()) {
+    return readArrowTable(outputs, dh, counter, numTF, treename, totalSizeCompressed, totalSizeUncompressed);
+  }
+
+  if (readAheadEnabled() && getColumnNames(dh).empty()) {
+    startDataFrame(counter, numTF);
+    mRequestedTrees.push_back(treename);
+    auto prefetched = std::find_if(mPrefetched.begin(), mPrefetched.end(), [&treename](PrefetchedTree const& p) { return p.treename == treename && p.table; });
+    if (prefetched != mPrefetched.end()) {
+      // Marks the dataframe as read.
+      auto fileAndFolder = getFileFolder(counter, numTF);
+      if (!fileAndFolder.file) {
+        return false;
+      }
+      outputs.adopt(Output(dh), std::move(prefetched->table));
+      totalSizeCompressed += prefetched->sizeCompressed;
+      totalSizeUncompressed += prefetched->sizeUncompressed;
+      mIOTime += (uv_hrtime() - ioStart);
+      return true;
+    }
+  }
+
   auto fileAndFolder = getFileFolder(counter, numTF);
   if (!fileAndFolder.file) {
     return false;
@@ -381,7 +551,7 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
     if (parentFile != nullptr) {
       int parentNumTF = parentFile->findDFNumber(0, fileAndFolder.folderName);
       if (parentNumTF == -1) {
-        throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->mcurrentFile->GetName()));
+        throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->getCurrentFilename()));
       }
       // first argument is 0 as the parent file object contains only 1 file
       return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
@@ -410,6 +580,9 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
     t2t->addAllColumns(tree, std::move(colnames));
   }
   t2t->fill(tree);
+  if (groupIndexEnabled()) {
+    t2t->addGroupIndex();
+  }
   delete tree;
 
   mIOTime += (uv_hrtime() - ioStart);
@@ -417,6 +590,45 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   return true;
 }
 
+bool DataInputDescriptor::readArrowTable(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+{
+  auto ioStart = uv_hrtime();
+
+  auto fileAndFolder = getFileFolder(counter, numTF);
+  if (fileAndFolder.folderName.empty()) {
+    return false;
+  }
+
+  auto filename = ArrowFileHelpers::tablePath(mCurrentArrowAOD, fileAndFolder.folderName, treename);
+  std::error_code ec;
+  auto size = std::filesystem::file_size(filename, ec);
+  if (ec) {
+    LOGP(debug, "Could not find table {}. Trying in parent file.", filename);
+    auto parentFile = getParentFile(counter, numTF, treename);
+    if (parentFile != nullptr) {
+      int parentNumTF = parentFile->findDFNumber(0, fileAndFolder.folderName);
+      if (parentNumTF == -1) {
+        throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->getCurrentFilename()));
+      }
+      // first argument is 0 as the parent file object contains only 1 file
+      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
+    }
+    throw std::runtime_error(fmt::format(R"(Couldn't get table "{}" from "{}".)", fileAndFolder.folderName + "/" + treename, mCurrentArrowAOD));
+  }
+
+  // the file is mapped, so only what is actually used will be read
+  auto table = withGroupIndex(ArrowFileHelpers::readTable(filename, getColumnNames(dh)));
+  outputs.adopt(Output(dh), table);
+  totalSizeCompressed += size;
+  totalSizeUncompressed += size;
+  mArrowBytesRead += size;
+  mArrowTablesRead++;
+
+  mIOTime += (uv_hrtime() - ioStart);
+
+  return true;
+}
+
 DataInputDirector::DataInputDirector()
 {
   createDefaultDataInputDescriptor();
@@ -481,6 +693,31 @@ void DataInputDirector::createDefaultDataInputDescriptor()
   mAlienSupport &= mdefaultDataInputDescriptor->isAlienSupportOn();
 }
 
+void DataInputDirector::addCachedTables(std::string const& cacheDir, std::string const& tables)
+{
+  // tables is a ','-separated list of hash:origin/description/subspec
+  static const std::regex delim(",");
+  std::sregex_token_iterator end;
+  for (std::sregex_token_iterator iter(tables.begin(), tables.end(), delim, -1); iter != end; ++iter) {
+    auto item = iter->str();
+    auto colon = item.find(':');
+    if (item.empty() || colon == std::string::npos) {
+      continue;
+    }
+    auto hash = item.substr(0, colon);
+    auto didesc = new DataInputDescriptor(false, 0, mMonitoring);
+    didesc->tablename = item.substr(colon + 1);
+    didesc->matcher = DataDescriptorQueryBuilder::buildNode(didesc->tablename);
+    didesc->cached = true;
+    // one cache entry for each of the default input files
+    for (int fi = 0; fi < mdefaultDataInputDescriptor->getNumberInputfiles(); ++fi) {
+      didesc->addFileNameHolder(makeFileNameHolder(DerivedTableCache::entryPath(cacheDir, hash, mdefaultDataInputDescriptor->getInputfileName(fi))));
+    }
+    // the cached tables take precedence over the other descriptors
+    mdataInputDescriptors.insert(mdataInputDescriptors.begin(), didesc);
+  }
+}
+
 bool DataInputDirector::readJson(std::string const& fnjson)
 {
   // open the file
@@ -716,18 +953,32 @@ FileAndFolder DataInputDirector::getFileFolder(header::DataHeader dh, int counte
 {
   auto didesc = getDataInputDescriptor(dh);
   // if NOT match then use defaultDataInputDescriptor
-  if (!didesc) {
+  // the cached tables follow the structure of the default input files
+  if (!didesc || didesc->cached) {
     didesc = mdefaultDataInputDescriptor;
   }
 
   return didesc->getFileFolder(counter, numTF);
 }
 
+std::string DataInputDirector::getCurrentFilename(header::DataHeader dh)
+{
+  auto didesc = getDataInputDescriptor(dh);
+  // if NOT match then use defaultDataInputDescriptor
+  // the cached tables follow the structure of the default input files
+  if (!didesc || didesc->cached) {
+    didesc = mdefaultDataInputDescriptor;
+  }
+
+  return didesc->getCurrentFilename();
+}
+
 int DataInputDirector::getTimeFramesInFile(header::DataHeader dh, int counter)
 {
   auto didesc = getDataInputDescriptor(dh);
   // if NOT match then use defaultDataInputDescriptor
-  if (!didesc) {
+  // the cached tables follow the structure of the default input files
+  if (!didesc || didesc->cached) {
     didesc = mdefaultDataInputDescriptor;
   }
 
@@ -738,7 +989,8 @@ uint64_t DataInputDirector::getTimeFrameNumber(header::DataHeader dh, int counte
 {
   auto didesc = getDataInputDescriptor(dh);
   // if NOT match then use defaultDataInputDescriptor
-  if (!didesc) {
+  // the cached tables follow the structure of the default input files
+  if (!didesc || didesc->cached) {
     didesc = mdefaultDataInputDescriptor;
   }
 
@@ -750,7 +1002,18 @@ bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh,
   std::string treename;
 
   auto didesc = getDataInputDescriptor(dh);
-  if (didesc) {
+  if (didesc && didesc->cached) {
+    // the cache has the same dataframes as the default input file,
+    // but not necessarily in the same order
+    treename = aod::datamodel::getTreeName(dh);
+    auto folderName = mdefaultDataInputDescriptor->getFileFolder(counter, numTF).folderName;
+    didesc->setFile(counter);
+    auto cachedNumTF = didesc->findDFNumber(counter, folderName);
+    if (cachedNumTF == -1) {
+      throw std::runtime_error(fmt::format(R"(DF {} not found in the derived table cache "{}")", folderName, didesc->getCurrentFilename()));
+    }
+    return didesc->readTree(outputs, dh, counter, cachedNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
+  } else if (didesc) {
     // if match then use filename and treename from DataInputDescriptor
     treename = didesc->treename;
   } else {
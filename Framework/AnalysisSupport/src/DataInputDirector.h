@@ -16,6 +16,8 @@
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataAllocator.h"
 
+#include <future>
+#include <memory>
 #include <regex>
 #include "rapidjson/fwd.h"
 
@@ -51,6 +53,9 @@ class DataInputDescriptor
   std::string tablename = "";
   std::string treename = "";
   std::unique_ptr<data_matcher::DataDescriptorMatcher> matcher;
+  /// The table is read from the derived table cache, whose entries
+  /// mirror the default input files.
+  bool cached = false;
 
   DataInputDescriptor() = default;
   DataInputDescriptor(bool alienSupport, int level, o2::monitoring::Monitoring* monitoring = nullptr, int allowedParentLevel = 0, std::string parentFileReplacement = "");
@@ -74,6 +79,7 @@ class DataInputDescriptor
   std::string getFilenamesRegexString();
   std::regex getFilenamesRegex();
   int getNumberInputfiles() { return mfilenames.size(); }
+  std::string getInputfileName(int counter) { return mfilenames[counter]->fileName; }
   int getNumberTimeFrames() { return mtotalNumberTimeFrames; }
   int findDFNumber(int file, std::string dfName);
 
@@ -87,6 +93,9 @@ class DataInputDescriptor
 
   void printFileStatistics();
   void closeInputFile();
+  /// The name of the file being read, either a ROOT file or a directory
+  /// of arrow files.
+  std::string getCurrentFilename();
   bool isAlienSupportOn() { return mAlienSupport; }
 
  private:
@@ -99,11 +108,49 @@ class DataInputDescriptor
   std::vector<FileNameHolder*> mfilenames;
   std::vector<FileNameHolder*>* mdefaultFilenamesPtr = nullptr;
   TFile* mcurrentFile = nullptr;
+  /// Set instead of mcurrentFile when the input is a directory of arrow
+  /// files, see ArrowFileHelpers.
+  std::string mCurrentArrowAOD;
+  uint64_t mArrowBytesRead = 0;
+  int mArrowTablesRead = 0;
+  bool readArrowTable(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
   int mCurrentFileID = -1;
   bool mAlienSupport = false;
 
   o2::monitoring::Monitoring* mMonitoring = nullptr;
 
+  /// A tree of the next dataframe which was read in the background.
+  struct PrefetchedTree {
+    std::string treename;
+    std::shared_ptr<arrow::Table> table;
+    size_t sizeCompressed = 0;
+    size_t sizeUncompressed = 0;
+  };
+  /// Read the trees of the next dataframe while the current one is being
+  /// processed, using a separate handle to the same file so that we do
+  /// not interfere with the reading happening on the main thread.
+  /// Enabled by DPL_AOD_READ_AHEAD=1.
+  struct ReadAhead {
+    int counter = -1;
+    int numTF = -1;
+    /// Only used by the background task, at most one at the time.
+    /// Declared before the result, so that it outlives any pending task.
+    std::unique_ptr<TFile> file;
+    std::future<std::vector<PrefetchedTree>> result;
+  };
+  ReadAhead mReadAhead;
+  /// The trees which were prefetched for the dataframe being read.
+  std::vector<PrefetchedTree> mPrefetched;
+  /// The trees which were requested for the dataframe being read, which
+  /// we use as a guess of what will be requested for the next one.
+  std::vector<std::string> mRequestedTrees;
+  int mLastCounter = -1;
+  int mLastNumTF = -1;
+  /// Account for a new dataframe being read and schedule the next one.
+  void startDataFrame(int counter, int numTF);
+  /// Wait for any pending read ahead.
+  void waitReadAhead();
+
   TMap* mParentFileMap = nullptr;
   DataInputDescriptor* mParentFile = nullptr;
   int mLevel = 0; // level of parent files
@@ -135,6 +182,9 @@ class DataInputDirector
   void setInputfilesFile(std::string iffn) { minputfilesFile = iffn; }
   void setFilenamesRegex(std::string dfn) { mFilenameRegex = dfn; }
   bool readJson(std::string const& fnjson);
+  /// Read the tables @a tables, a ','-separated list of hash:table, from the
+  /// derived table cache @a cacheDir, see DerivedTableCache.
+  void addCachedTables(std::string const& cacheDir, std::string const& tables);
   void closeInputFiles();
 
   // getters
@@ -144,6 +194,7 @@ class DataInputDirector
   bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
+  std::string getCurrentFilename(header::DataHeader dh);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
 
   uint64_t getTotalSizeCompressed();
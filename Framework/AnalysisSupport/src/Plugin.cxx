@@ -15,6 +15,7 @@
 #include "Framework/ConfigParamDiscovery.h"
 #include "Framework/Capability.h"
 #include "Framework/Signpost.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "AODJAlienReaderHelpers.h"
 #include <TFile.h>
 #include <TMap.h>
@@ -22,6 +23,7 @@
 #include <TObjString.h>
 #include <TString.h>
 #include <fmt/format.h>
+#include <filesystem>
 
 O2_DECLARE_DYNAMIC_LOG(analysis_support);
 
@@ -84,6 +86,36 @@ std::vector<std::string> getListOfTables(TFile* f)
   return r;
 }
 
+std::vector<ConfigParamSpec> discoverMetadataInArrowAOD(std::string const& directory)
+{
+  std::vector<ConfigParamSpec> results;
+  auto metaData = ArrowFileHelpers::readMap(directory + "/" + ArrowFileHelpers::metaDataName);
+  if (metaData.empty()) {
+    LOGP(info, "No metadata found in \"{}\"", directory);
+    results.push_back(ConfigParamSpec{"aod-metadata-disable", VariantType::String, "1", {"Metadata not found in AOD"}});
+    return results;
+  }
+  LOGP(info, "Metadata for \"{}\":", directory);
+  for (auto& [key, value] : metaData) {
+    LOGP(info, "- {}: {}", key, value);
+    results.push_back(ConfigParamSpec{"aod-metadata-" + key, VariantType::String, strdup(value.c_str()), {"Metadata in AOD"}});
+  }
+
+  std::vector<std::string> tables;
+  auto dataFrames = ArrowFileHelpers::listDataFrames(directory);
+  if (!dataFrames.empty()) {
+    for (auto const& entry : std::filesystem::directory_iterator(directory + "/DF_" + std::to_string(dataFrames.front()))) {
+      if (entry.path().extension() == ArrowFileHelpers::extension) {
+        tables.emplace_back(entry.path().stem().string());
+      }
+    }
+  }
+  if (tables.empty() == false) {
+    results.push_back(ConfigParamSpec{"aod-metadata-tables", VariantType::ArrayString, tables, {"Tables in first AOD"}});
+  }
+  return results;
+}
+
 struct DiscoverMetadataInAOD : o2::framework::ConfigDiscoveryPlugin {
   ConfigDiscovery* create() override
   {
@@ -110,6 +142,9 @@ struct DiscoverMetadataInAOD : o2::framework::ConfigDiscoveryPlugin {
           TGrid::Connect("alien://");
         }
         LOGP(info, "Loading metadata from file {} in PID {}", filename, getpid());
+        if (ArrowFileHelpers::isArrowAOD(filename)) {
+          return discoverMetadataInArrowAOD(filename);
+        }
         currentFile = TFile::Open(filename.c_str());
         if (!currentFile) {
           LOGP(fatal, "Couldn't open file \"{}\"!", filename);
@@ -24,6 +24,7 @@
 #include <TError.h>
 #include <TMemFile.h>
 #include <functional>
+#include <future>
 
 O2_DECLARE_DYNAMIC_LOG(ccdb);
 
@@ -40,6 +41,19 @@ struct CCDBFetcherHelper {
     size_t minSize = -1ULL;
     size_t maxSize = 0;
     int lastCheckedTF = 0;
+    // Metadata used for the last query, so that we can prefetch the next object
+    std::map<std::string, std::string> metadata;
+    // Timestamp for which a prefetch was last requested
+    size_t prefetchRequestedFor = 0;
+  };
+
+  /// An object fetched in the background for the next validity interval of a path.
+  struct Prefetched {
+    std::string path;
+    std::map<std::string, std::string> metadata;
+    int64_t timestamp = 0;
+    o2::pmr::vector<char> blob;
+    std::map<std::string, std::string> headers;
   };
 
   struct RemapMatcher {
@@ -61,22 +75,39 @@ struct CCDBFetcherHelper {
   int queryPeriodGlo = 1;
   int queryPeriodFactor = 1;
   int64_t timeToleranceMS = 5000;
+  // How long before the end of the validity of an object we start fetching
+  // the next one in the background. 0 disables prefetching.
+  int64_t prefetchMS = 0;
+  // Separate instances, only used by the prefetching task, so that the
+  // downloader of the processing path is never shared.
+  std::unordered_map<std::string, o2::ccdb::CcdbApi> prefetchApis;
+  // At most one batch of prefetches in flight
+  std::future<std::vector<Prefetched>> pendingPrefetch;
+  // Prefetched objects ready to be used, indexed by path
+  std::unordered_map<std::string, Prefetched> prefetched;
 
-  o2::ccdb::CcdbApi& getAPI(const std::string& path)
+  // @return the host serving a given path
+  std::string const& getHost(const std::string& path)
   {
+    static const std::string defaultHost = "";
     // find the first = sign in the string. If present drop everything after it
     // and between it and the previous /.
     auto pos = path.find('=');
     if (pos == std::string::npos) {
       auto entry = remappings.find(path);
-      return apis[entry == remappings.end() ? "" : entry->second];
+      return entry == remappings.end() ? defaultHost : entry->second;
     }
     auto pos2 = path.rfind('/', pos);
     if (pos2 == std::string::npos || pos2 == pos - 1 || pos2 == 0) {
       throw runtime_error_f("Malformed path %s", path.c_str());
     }
     auto entry = remappings.find(path.substr(0, pos2));
-    return apis[entry == remappings.end() ? "" : entry->second];
+    return entry == remappings.end() ? defaultHost : entry->second;
+  }
+
+  o2::ccdb::CcdbApi& getAPI(const std::string& path)
+  {
+    return apis[getHost(path)];
   }
 };
 
@@ -183,6 +214,96 @@ bool isOnlineRun(DataTakingContext const& dtc)
   return dtc.deploymentMode == DeploymentMode::OnlineAUX || dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS;
 }
 
+/// Move the results of the background prefetch, if completed, to the
+/// objects ready to be used.
+void collectPrefetched(std::shared_ptr<CCDBFetcherHelper> const& helper)
+{
+  auto& pending = helper->pendingPrefetch;
+  if (!pending.valid() || pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+  for (auto& result : pending.get()) {
+    if (result.headers.count("Error") != 0 || result.blob.empty()) {
+      LOGP(detail, "Prefetching {} for timestamp {} failed, will be fetched synchronously", result.path, result.timestamp);
+      continue;
+    }
+    helper->prefetched[result.path] = std::move(result);
+  }
+}
+
+/// Start fetching in the background the next object of all the paths whose
+/// validity ends within prefetchMS from @a timestamp.
+void schedulePrefetch(std::shared_ptr<CCDBFetcherHelper> const& helper, int64_t timestamp)
+{
+  if (helper->prefetchMS <= 0 || helper->pendingPrefetch.valid()) {
+    return;
+  }
+  std::vector<CCDBFetcherHelper::Prefetched> batch;
+  for (auto& [path, info] : helper->mapURL2UUID) {
+    if (info.cacheValidUntil == 0 || info.prefetchRequestedFor == info.cacheValidUntil) {
+      continue;
+    }
+    if ((int64_t)info.cacheValidUntil <= timestamp || (int64_t)info.cacheValidUntil > timestamp + helper->prefetchMS) {
+      continue;
+    }
+    if (helper->getAPI(path).isSnapshotMode() || helper->prefetched.count(path)) {
+      continue;
+    }
+    info.prefetchRequestedFor = info.cacheValidUntil;
+    batch.push_back(CCDBFetcherHelper::Prefetched{.path = path, .metadata = info.metadata, .timestamp = (int64_t)info.cacheValidUntil});
+  }
+  if (batch.empty()) {
+    return;
+  }
+  helper->pendingPrefetch = std::async(std::launch::async, [helper, batch = std::move(batch)]() mutable {
+    // Group by host, so that each of them can use the multi handle
+    // of its downloader to do the transfers in parallel.
+    std::unordered_map<std::string, std::vector<size_t>> byHost;
+    for (size_t i = 0; i < batch.size(); ++i) {
+      byHost[helper->getHost(batch[i].path)].push_back(i);
+    }
+    for (auto& [host, indices] : byHost) {
+      std::vector<o2::ccdb::CcdbApi::RequestContext> contexts;
+      contexts.reserve(indices.size());
+      for (auto i : indices) {
+        auto& context = contexts.emplace_back(batch[i].blob, batch[i].metadata, batch[i].headers);
+        context.path = batch[i].path;
+        context.timestamp = batch[i].timestamp;
+        context.createdNotAfter = helper->createdNotAfter;
+        context.createdNotBefore = helper->createdNotBefore;
+        context.considerSnapshot = true;
+      }
+      helper->prefetchApis[host].vectoredLoadFileToMemory(contexts);
+    }
+    return std::move(batch);
+  });
+}
+
+/// @return true if a prefetched object for @a path covering @a timestamp
+/// was found. In that case @a v and @a headers are filled with it.
+bool usePrefetched(std::shared_ptr<CCDBFetcherHelper> const& helper, std::string const& path, int64_t timestamp,
+                   o2::pmr::vector<char>& v, std::map<std::string, std::string>& headers)
+{
+  auto it = helper->prefetched.find(path);
+  if (it == helper->prefetched.end()) {
+    return false;
+  }
+  auto& entry = it->second;
+  auto validFrom = entry.headers.count("Valid-From") ? std::stoll(entry.headers["Valid-From"]) : entry.timestamp;
+  auto validUntil = entry.headers.count("Valid-Until") ? std::stoll(entry.headers["Valid-Until"]) : entry.timestamp + 1;
+  if (timestamp < validFrom) {
+    // Not yet its time.
+    return false;
+  }
+  if (timestamp < validUntil) {
+    v.resize(entry.blob.size());
+    memcpy(v.data(), entry.blob.data(), entry.blob.size());
+    headers = std::move(entry.headers);
+  }
+  helper->prefetched.erase(it);
+  return !v.empty();
+}
+
 auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
                        int64_t timestamp,
                        TimingInfo& timingInfo,
@@ -195,18 +316,35 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
   // callback.
   static bool isOnline = isOnlineRun(dtc);
 
+  // State of the query of a route, kept until all the objects of the timeslice are loaded
+  struct RouteQuery {
+    Output output;
+    o2::pmr::vector<char> v;
+    std::map<std::string, std::string> metadata;
+    std::map<std::string, std::string> headers;
+    std::string path = "";
+    std::string etag = "";
+    bool checkValidity = false;
+    bool load = false;
+  };
+  std::vector<RouteQuery> queries;
+  queries.reserve(helper->routes.size());
+
   auto sid = _o2_signpost_id_t{(int64_t)timingInfo.timeslice};
   O2_SIGNPOST_START(ccdb, sid, "populateCacheWith", "Starting to populate cache with CCDB objects");
+  collectPrefetched(helper);
   for (auto& route : helper->routes) {
     O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Fetching object for route %{public}s", DataSpecUtils::describe(route.matcher).data());
     objCnt++;
     auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
     Output output{concrete.origin, concrete.description, concrete.subSpec};
-    auto&& v = allocator.makeVector<char>(output);
-    std::map<std::string, std::string> metadata;
-    std::map<std::string, std::string> headers;
-    std::string path = "";
-    std::string etag = "";
+    auto&& buffer = allocator.makeVector<char>(output);
+    auto& query = queries.emplace_back(RouteQuery{.output = std::move(output), .v = std::move(buffer)});
+    auto& v = query.v;
+    auto& metadata = query.metadata;
+    auto& headers = query.headers;
+    auto& path = query.path;
+    auto& etag = query.etag;
     int chRate = helper->queryPeriodGlo;
     bool checkValidity = false;
     for (auto& meta : route.matcher.metadata) {
@@ -241,9 +379,50 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
     O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "checkValidity is %{public}s for tfID %d of %{public}s", checkValidity ? "true" : "false", timingInfo.tfCounter, path.data());
 
     const auto& api = helper->getAPI(path);
-    if (checkValidity && (!api.isSnapshotMode() || etag.empty())) { // in the snapshot mode the object needs to be fetched only once
-      LOGP(detail, "Loading {} for timestamp {}", path, timestamp);
-      api.loadFileToMemory(v, path, metadata, timestamp, &headers, etag, helper->createdNotAfter, helper->createdNotBefore);
+    query.checkValidity = checkValidity && (!api.isSnapshotMode() || etag.empty()); // in the snapshot mode the object needs to be fetched only once
+    if (query.checkValidity) {
+      helper->mapURL2UUID[path].metadata = metadata;
+      if (!etag.empty() && usePrefetched(helper, path, timestamp, v, headers) && headers["ETag"] != etag) {
+        O2_SIGNPOST_EVENT_EMIT(ccdb, sid, "populateCacheWith", "Using prefetched %{public}s for timestamp %" PRIi64, path.data(), timestamp);
+      } else {
+        v.clear();
+        headers.clear();
+        LOGP(detail, "Loading {} for timestamp {}", path, timestamp);
+        query.load = true;
+      }
+    }
+  }
+
+  // Load all the objects of the timeslice in one go, grouped by host so that
+  // the downloader of each of them performs the transfers in parallel.
+  std::unordered_map<std::string, std::vector<size_t>> byHost;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if (queries[i].load) {
+      byHost[helper->getHost(queries[i].path)].push_back(i);
+    }
+  }
+  for (auto& [host, indices] : byHost) {
+    std::vector<o2::ccdb::CcdbApi::RequestContext> contexts;
+    contexts.reserve(indices.size());
+    for (auto i : indices) {
+      auto& context = contexts.emplace_back(queries[i].v, queries[i].metadata, queries[i].headers);
+      context.path = queries[i].path;
+      context.timestamp = timestamp;
+      context.etag = queries[i].etag;
+      context.createdNotAfter = helper->createdNotAfter;
+      context.createdNotBefore = helper->createdNotBefore;
+      context.considerSnapshot = true;
+    }
+    helper->getAPI(queries[indices.front()].path).vectoredLoadFileToMemory(contexts);
+  }
+
+  for (auto& query : queries) {
+    auto& output = query.output;
+    auto& v = query.v;
+    auto& headers = query.headers;
+    auto& path = query.path;
+    auto& etag = query.etag;
+    if (query.checkValidity) {
       if ((headers.count("Error") != 0) || (etag.empty() && v.empty())) {
         LOGP(fatal, "Unable to find object {}/{}", path, timestamp);
         // FIXME: I should send a dummy message.
@@ -291,6 +470,7 @@ auto populateCacheWith(std::shared_ptr<CCDBFetcherHelper> const& helper,
     allocator.adoptFromCache(output, cacheId, header::gSerializationMethodCCDB);
     // the outputBuffer was not used, can we destroy it?
   }
+  schedulePrefetch(helper, timestamp);
   O2_SIGNPOST_END(ccdb, sid, "populateCacheWith", "Finished populating cache with CCDB objects");
 };
 
@@ -303,6 +483,7 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       auto checkRate = options.get<int>("condition-tf-per-query");
       auto checkMult = options.get<int>("condition-tf-per-query-multiplier");
       helper->timeToleranceMS = options.get<int64_t>("condition-time-tolerance");
+      helper->prefetchMS = options.get<int64_t>("condition-prefetch-ms");
       helper->queryPeriodGlo = checkRate > 0 ? checkRate : std::numeric_limits<int>::max();
       helper->queryPeriodFactor = checkMult > 0 ? checkMult : 1;
       LOGP(info, "CCDB Backend at: {}, validity check for every {} TF{}", defHost, helper->queryPeriodGlo, helper->queryPeriodFactor == 1 ? std::string{} : fmt::format(", (query for high-rate objects downscaled by {})", helper->queryPeriodFactor));
@@ -314,11 +495,17 @@ AlgorithmSpec CCDBHelpers::fetchFromCCDB()
       }
       helper->remappings = result.remappings;
       helper->apis[""].init(defHost); // default backend
+      if (helper->prefetchMS > 0) {
+        helper->prefetchApis[""].init(defHost);
+      }
       LOGP(info, "Initialised default CCDB host {}", defHost);
       //
       for (auto& entry : helper->remappings) { // init api instances for every host seen in the remapping
         if (helper->apis.find(entry.second) == helper->apis.end()) {
           helper->apis[entry.second].init(entry.second);
+          if (helper->prefetchMS > 0) {
+            helper->prefetchApis[entry.second].init(entry.second);
+          }
           LOGP(info, "Initialised custom CCDB host {}", entry.second);
         }
         LOGP(info, "{} is remapped to {}", entry.first, entry.second);
@@ -26,6 +26,7 @@
 #include <arrow/array.h>
 #include <arrow/util/config.h>
 #include <gandiva/selection_vector.h>
+#include <algorithm>
 #include <cassert>
 #include <fmt/format.h>
 #include <gsl/span>
@@ -1674,6 +1675,77 @@ class Table
     return size();
   }
 
+  /// Invoke @a f for each range of rows which is contiguous in memory for
+  /// all the persistent columns Cs..., passing a gsl::span over the values
+  /// of each of them. Ranges are visited in order, so the position of a
+  /// batch in the table is the sum of the sizes of the previous ones.
+  /// Since the loop inside @a f does not need to worry about arrow chunks,
+  /// the compiler is able to vectorise it.
+  /// Notice this always works on the whole underlying arrow table, i.e. any
+  /// selection of a Filtered table is ignored.
+  template <typename... Cs, typename F>
+  void forEachBatch(F&& f) const
+  {
+    static_assert(sizeof...(Cs) > 0, "At least one column must be requested");
+    static_assert(((is_persistent_v<Cs> && std::is_arithmetic_v<typename Cs::type> && !std::is_same_v<typename Cs::type, bool>) && ...),
+                  "forEachBatch only supports persistent columns of arithmetic types other than bool");
+    constexpr size_t N = sizeof...(Cs);
+    if (mTable->num_rows() == 0) {
+      return;
+    }
+    std::array<arrow::ChunkedArray const*, N> arrays{mColumnChunks[framework::has_type_at_v<Cs>(columns{})]...};
+    std::array<int, N> chunks{};
+    std::array<int64_t, N> positions{};
+    int64_t total = mTable->num_rows();
+    for (int64_t row = 0; row < total;) {
+      int64_t length = total - row;
+      for (size_t ci = 0; ci < N; ++ci) {
+        // Skip chunks we are done with, including empty ones.
+        while (positions[ci] == arrays[ci]->chunk(chunks[ci])->length()) {
+          chunks[ci]++;
+          positions[ci] = 0;
+        }
+        length = std::min(length, arrays[ci]->chunk(chunks[ci])->length() - positions[ci]);
+      }
+      [&]<size_t... Is>(std::index_sequence<Is...>) {
+        f(gsl::span<typename Cs::type const>{std::static_pointer_cast<arrow_array_for_t<typename Cs::type>>(arrays[Is]->chunk(chunks[Is]))->raw_values() + positions[Is],
+                                              static_cast<size_t>(length)}...);
+      }(std::make_index_sequence<N>{});
+      for (size_t ci = 0; ci < N; ++ci) {
+        positions[ci] += length;
+      }
+      row += length;
+    }
+  }
+
+  /// Evaluate the dynamic column DC for all the rows of the table and store
+  /// the results in @a out, which must hold at least size() elements.
+  /// The callback of DC is invoked in tight loops over the batches of its
+  /// bindings, rather than via the row iterator. Only dynamic columns whose
+  /// arguments are all bound to persistent columns are supported.
+  template <typename DC>
+  void evaluateDynamicColumn(gsl::span<typename DC::type> out) const
+  {
+    static_assert(is_dynamic_t<DC>(), "Requested column is not a dynamic column");
+    assert(out.size() >= static_cast<size_t>(mTable->num_rows()));
+    doEvaluateDynamicColumn<DC>(out, typename DC::bindings_t{});
+  }
+
+  template <typename DC, typename... Bs>
+  void doEvaluateDynamicColumn(gsl::span<typename DC::type> out, framework::pack<Bs...>) const
+  {
+    constexpr auto callback = DC::callback_holder_t::getLambda();
+    size_t offset = 0;
+    forEachBatch<Bs...>([&out, &offset, &callback](gsl::span<typename Bs::type const>... values) {
+      size_t length = std::min({values.size()...});
+      auto* result = out.data() + offset;
+      for (size_t i = 0; i < length; ++i) {
+        result[i] = callback(values[i]...);
+      }
+      offset += length;
+    });
+  }
+
   /// Bind the columns which refer to other tables
   /// to the associated tables.
   template <typename... TA>
@@ -1316,6 +1316,108 @@ auto selfPairCombinations(const BP& binningPolicy, int categoryNeighbours, const
   return CombinationsGenerator<CombinationsBlockStrictlyUpperSameIndexPolicy<BP, T1, T2, T2>>(CombinationsBlockStrictlyUpperSameIndexPolicy<BP, T1, T2, T2>(binningPolicy, categoryNeighbours, outsider, table, table));
 }
 
+/// Candidate pairs of one block (category) of self pair combinations, materialised in contiguous buffers.
+/// For each of the columns Cs, the values for the first and for the second element of all the pairs
+/// are gathered in plain arrays, so that a pre-filter can select pairs with simple loops over them,
+/// which the compiler is able to vectorise, before the full iterators are built.
+template <typename... Cs>
+struct CombinationsPairBlock {
+  template <typename C>
+  static constexpr size_t columnPosition = framework::has_type_at<C>(framework::pack<Cs...>{});
+
+  template <typename C>
+  gsl::span<typename C::type const> first() const
+  {
+    return std::get<columnPosition<C>>(firstValues);
+  }
+  template <typename C>
+  gsl::span<typename C::type const> second() const
+  {
+    return std::get<columnPosition<C>>(secondValues);
+  }
+  size_t size() const
+  {
+    return firstRows.size();
+  }
+  void clear()
+  {
+    firstRows.clear();
+    secondRows.clear();
+    selected.clear();
+    std::apply([](auto&... v) { (v.clear(), ...); }, firstValues);
+    std::apply([](auto&... v) { (v.clear(), ...); }, secondValues);
+  }
+
+  int bin = 0;
+  std::vector<uint64_t> firstRows;
+  std::vector<uint64_t> secondRows;
+  std::vector<uint8_t> selected; // set to 0 by the pre-filter for the pairs to be skipped
+  std::tuple<std::vector<typename Cs::type>...> firstValues;
+  std::tuple<std::vector<typename Cs::type>...> secondValues;
+};
+
+/// Same pairs as selfPairCombinations(binningPolicy, categoryNeighbours, outsider, table), produced one
+/// block at a time. For each block, preFilter(CombinationsPairBlock<Cs...>&) can zero the selected flag of
+/// the pairs to drop, using the values of the columns Cs, then process(c0, c1) is invoked for the others.
+template <typename... Cs, typename BP, typename T1, typename T2, typename PF, typename F>
+void selfPairCombinationsBatched(const BP& binningPolicy, int categoryNeighbours, const T1& outsider, const T2& table, PF&& preFilter, F&& process)
+{
+  if (table.size() == 0 || categoryNeighbours < 1) {
+    return;
+  }
+  auto groupedIndices = groupTable(table, binningPolicy, 2, outsider);
+
+  // the values of the pre-filter columns for all the rows, read only once
+  std::tuple<std::vector<typename Cs::type>...> columnValues;
+  std::apply([&table](auto&... v) { (v.reserve(table.size()), ...); }, columnValues);
+  for (auto& row : table) {
+    for_<sizeof...(Cs)>([&](auto i) {
+      using C = framework::pack_element_t<i.value, framework::pack<Cs...>>;
+      std::get<i.value>(columnValues).push_back(*(static_cast<C>(row).getIterator()));
+    });
+  }
+
+  CombinationsPairBlock<Cs...> block;
+  auto c0 = table.begin();
+  auto c1 = table.begin();
+  auto catBegin = groupedIndices.begin();
+  while (catBegin != groupedIndices.end()) {
+    auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
+    block.clear();
+    block.bin = catBegin->bin;
+    for (auto first = catBegin; first != catEnd; ++first) {
+      auto lastSecond = std::distance(first, catEnd) > categoryNeighbours ? first + categoryNeighbours + 1 : catEnd;
+      for (auto second = first + 1; second != lastSecond; ++second) {
+        block.firstRows.push_back(first->index);
+        block.secondRows.push_back(second->index);
+      }
+    }
+    block.selected.assign(block.size(), 1);
+    for_<sizeof...(Cs)>([&](auto i) {
+      auto const& values = std::get<i.value>(columnValues);
+      auto& firstValues = std::get<i.value>(block.firstValues);
+      auto& secondValues = std::get<i.value>(block.secondValues);
+      firstValues.resize(block.size());
+      secondValues.resize(block.size());
+      for (size_t p = 0; p < block.size(); ++p) {
+        firstValues[p] = values[block.firstRows[p]];
+        secondValues[p] = values[block.secondRows[p]];
+      }
+    });
+
+    preFilter(block);
+
+    for (size_t p = 0; p < block.size(); ++p) {
+      if (block.selected[p]) {
+        c0.setCursor(block.firstRows[p]);
+        c1.setCursor(block.secondRows[p]);
+        process(c0, c1);
+      }
+    }
+    catBegin = catEnd;
+  }
+}
+
 template <typename BP, typename T1, typename T2>
 auto selfTripleCombinations(const BP& binningPolicy, int categoryNeighbours, const T1& outsider)
 {
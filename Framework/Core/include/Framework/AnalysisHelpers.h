@@ -287,34 +287,75 @@ struct IndexBuilder {
   {
     auto pool = arrow::default_memory_pool();
     SelfIndexColumnBuilder self{C1::columnLabel(), pool};
-    std::unique_ptr<ChunkedArrayIterator> keyIndex = nullptr;
-    int64_t counter = 0;
+    int64_t nRows = tables[0]->num_rows();
+    // the keys of the rows of the first table are read once, for all the index columns
+    std::vector<int> keys;
     if constexpr (!std::is_same_v<T1, Key>) {
-      keyIndex = std::make_unique<ChunkedArrayIterator>(getIndexToKey<T1, Key>(tables[0].get()));
+      readIndexValues(getIndexToKey<T1, Key>(tables[0].get()), keys);
     }
+    auto keyAt = [&keys](int64_t row) -> int {
+      if constexpr (std::is_same_v<T1, Key>) {
+        return row;
+      } else {
+        return keys[row];
+      }
+    };
 
     std::array<std::shared_ptr<framework::SelfIndexColumnBuilder>, sizeof...(Cs)> columnBuilders{ColumnTrait<Cs>::template makeColumnBuilder<framework::pack_element_t<framework::has_type_at_v<Cs>(framework::pack<Cs...>{}), framework::pack<Ts...>>, Key>(
       tables[framework::has_type_at_v<Cs>(framework::pack<Cs...>{}) + 1].get(),
       pool)...};
-    std::array<bool, sizeof...(Cs)> finds;
 
-    for (counter = 0; counter < tables[0]->num_rows(); ++counter) {
-      auto idx = -1;
-      if constexpr (std::is_same_v<T1, Key>) {
-        idx = counter;
-      } else {
-        idx = keyIndex->valueAt(counter);
+    // The columns are independent: each one is built over all the rows by its own task,
+    // which run in parallel for large tables
+    std::vector<std::function<void()>> tasks;
+    if constexpr (std::is_same_v<Kind, Sparse>) {
+      (tasks.emplace_back([&builder = *std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})]), &keyAt, nRows]() {
+        for (int64_t row = 0; row < nRows; ++row) {
+          builder.template find<Cs>(keyAt(row));
+          builder.template fill<Cs>(keyAt(row));
+        }
+      }),
+       ...);
+      runColumnTasks(tasks, nRows);
+      for (int64_t row = 0; row < nRows; ++row) {
+        self.fill<C1>(row);
       }
-      finds = {std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})])->template find<Cs>(idx)...};
-      if constexpr (std::is_same_v<Kind, Sparse>) {
-        (std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})])->template fill<Cs>(idx), ...);
-        self.fill<C1>(counter);
-      } else if constexpr (std::is_same_v<Kind, Exclusive>) {
-        if (std::none_of(finds.begin(), finds.end(), [](bool const x) { return x == false; })) {
-          (std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})])->template fill<Cs>(idx), ...);
-          self.fill<C1>(counter);
+    } else if constexpr (std::is_same_v<Kind, Exclusive>) {
+      // a row is kept if all the columns find it
+      std::vector<char> found(nRows, 1);
+      std::array<std::vector<char>, sizeof...(Cs)> columnFound;
+      (tasks.emplace_back([&builder = *std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})]), &columnFound, &keyAt, nRows]() {
+        auto& colFound = columnFound[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})];
+        colFound.resize(nRows);
+        for (int64_t row = 0; row < nRows; ++row) {
+          colFound[row] = builder.template find<Cs>(keyAt(row));
+        }
+        builder.reset();
+      }),
+       ...);
+      runColumnTasks(tasks, nRows);
+      for (auto const& colFound : columnFound) {
+        for (int64_t row = 0; row < nRows; ++row) {
+          found[row] &= colFound[row];
         }
       }
+      for (int64_t row = 0; row < nRows; ++row) {
+        if (found[row]) {
+          self.fill<C1>(row);
+        }
+      }
+      // the lookups are repeated in the same order, such that each fill follows the lookup of its row
+      tasks.clear();
+      (tasks.emplace_back([&builder = *std::static_pointer_cast<typename Reduction<Key, Cs>::type>(columnBuilders[framework::has_type_at_v<Cs>(framework::pack<Cs...>{})]), &found, &keyAt, nRows]() {
+        for (int64_t row = 0; row < nRows; ++row) {
+          builder.template find<Cs>(keyAt(row));
+          if (found[row]) {
+            builder.template fill<Cs>(keyAt(row));
+          }
+        }
+      }),
+       ...);
+      runColumnTasks(tasks, nRows);
     }
 
     return makeArrowTable(label,
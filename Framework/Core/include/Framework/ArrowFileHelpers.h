@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_ARROWFILEHELPERS_H_
+#define O2_FRAMEWORK_ARROWFILEHELPERS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arrow
+{
+class Table;
+}
+
+namespace o2::framework
+{
+
+/// Helpers to store AOD tables as arrow IPC files rather than as TTrees.
+/// An AOD "file" is then a directory with the same layout as the ROOT one:
+///
+///   <directory>/DF_<n>/<treename>.arrow
+///   <directory>/parentFiles.arrow
+///   <directory>/metaData.arrow
+///
+/// Each table is a separate IPC file, so that it can be memory mapped and
+/// its columns used as they are, without any deserialisation.
+struct ArrowFileHelpers {
+  /// Extension of the files holding a table
+  static constexpr char const* extension = ".arrow";
+  /// Name of the table holding the folder name -> parent file map
+  static constexpr char const* parentFilesName = "parentFiles.arrow";
+  /// Name of the table holding the AOD metadata
+  static constexpr char const* metaDataName = "metaData.arrow";
+
+  using StringMap = std::vector<std::pair<std::string, std::string>>;
+
+  /// Whether @a path is an AOD stored as arrow files.
+  static bool isArrowAOD(std::string const& path);
+  /// The full path of table @a treename in dataframe @a folderName.
+  static std::string tablePath(std::string const& directory, std::string const& folderName, std::string const& treename);
+  /// The DF_<n> folders in @a directory, sorted by number.
+  static std::vector<uint64_t> listDataFrames(std::string const& directory);
+
+  /// Write @a table to @a filename, creating the parent directories
+  /// if needed.
+  static void writeTable(std::shared_ptr<arrow::Table> const& table, std::string const& filename);
+  /// Memory map @a filename and return the table, optionally restricted
+  /// to @a columns. The buffers of the returned table point to the
+  /// mapped file, which stays mapped as long as they are alive.
+  static std::shared_ptr<arrow::Table> readTable(std::string const& filename, std::vector<std::string> const& columns = {});
+
+  /// Write a string -> string map as a two columns ("key", "value") table.
+  static void writeMap(StringMap const& map, std::string const& filename);
+  /// Read a map written by writeMap. Returns an empty map if the file
+  /// does not exist.
+  static StringMap readMap(std::string const& filename);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_ARROWFILEHELPERS_H_
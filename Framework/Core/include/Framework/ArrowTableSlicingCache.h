@@ -79,6 +79,14 @@ struct ArrowTableSlicingCache {
   SliceInfoUnsortedPtr getCacheUnsortedForPos(int pos) const;
 
   static void validateOrder(StringPair const& bindingKey, std::shared_ptr<arrow::Table> const& input);
+
+  // precompute the slicing info for all the sorted index columns of a table and
+  // store it in the metadata of their fields, so that updateCacheEntry can use it
+  // directly in every consumer, rather than rescanning the column
+  static std::shared_ptr<arrow::Table> addGroupIndex(std::shared_ptr<arrow::Table> const& table);
+  static constexpr char const* groupValuesKey = "o2.group.values";
+  static constexpr char const* groupCountsKey = "o2.group.counts";
+  static constexpr char const* groupRowsKey = "o2.group.rows";
 };
 } // namespace o2::framework
 
@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_BACKGROUNDWRITER_H_
+#define O2_FRAMEWORK_BACKGROUNDWRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace o2::framework
+{
+
+/// Runs the write tasks of an output sink (e.g. compressing and writing
+/// ROOT trees) in order, in one background thread, such that the processing
+/// callback does not wait for them. As ROOT files must not be used from
+/// several threads at the same time, all the operations on the output files
+/// need to go through the writer once it is used.
+///
+/// At most depth tasks are pending: push() blocks when the queue is full,
+/// such that a slow disk throttles the sink and, through the DPL rate
+/// limiting, the upstream devices, instead of accumulating data in memory.
+class BackgroundWriter
+{
+ public:
+  using Task = std::function<void()>;
+
+  explicit BackgroundWriter(size_t depth);
+  BackgroundWriter(BackgroundWriter const&) = delete;
+  BackgroundWriter& operator=(BackgroundWriter const&) = delete;
+  /// Waits for the pending tasks, an exception they threw is lost
+  ~BackgroundWriter();
+
+  /// Queue a task, waiting while depth tasks are pending. An exception thrown
+  /// by a previous task is rethrown here.
+  void push(Task task);
+  /// Wait until all the queued tasks are done. An exception thrown by a task
+  /// is rethrown here.
+  void drain();
+
+  size_t getDepth() const { return mDepth; }
+
+ private:
+  void run();
+  void rethrowPendingError();
+
+  size_t mDepth;
+  std::deque<Task> mTasks;
+  bool mBusy = false; // a task is running
+  bool mStop = false;
+  std::exception_ptr mError;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::thread mThread;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_BACKGROUNDWRITER_H_
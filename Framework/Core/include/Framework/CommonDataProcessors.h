@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_COMMONDATAPROCESSORS_H_
 
 #include "Framework/DataProcessorSpec.h"
+#include "Framework/DerivedTableCache.h"
 #include "Framework/InputSpec.h"
 
 #include <vector>
@@ -58,6 +59,10 @@ struct CommonDataProcessors {
   static DataProcessorSpec getGlobalAODSink(std::shared_ptr<DataOutputDirector> dod,
                                             std::vector<InputSpec> const& outputInputs);
 
+  /// stores the tables of the @a entries in the derived table cache @a cacheDir
+  static DataProcessorSpec getDerivedTableCacheSink(std::string const& cacheDir,
+                                                    std::vector<DerivedTableCacheEntry> const& entries);
+
   /// @return a dummy DataProcessorSpec which requires all the passed @a InputSpec
   /// and simply discards them. @a rateLimitingChannelConfig is the configuration
   /// for the rate limiting channel, if any required.
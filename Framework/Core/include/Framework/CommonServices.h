@@ -76,6 +76,7 @@ struct CommonServices {
   static ServiceSpec dataProcessingStats();
   static ServiceSpec dataProcessingStates();
   static ServiceSpec objectCache();
+  static ServiceSpec objectPool();
   static ServiceSpec timingInfoSpec();
   static ServiceSpec ccdbSupportSpec();
   static ServiceSpec decongestionSpec();
@@ -83,6 +84,7 @@ struct CommonServices {
   static ServiceSpec guiMetricsSpec();
   static ServiceSpec dataAllocatorSpec();
   static ServiceSpec streamContextSpec();
+  static ServiceSpec streamSchedulerSpec();
 
   static std::vector<ServiceSpec> defaultServices(std::string extraPlugins = "", int numWorkers = 0);
   static std::vector<ServiceSpec> arrowServices();
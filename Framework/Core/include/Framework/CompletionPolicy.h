@@ -73,6 +73,7 @@ struct CompletionPolicy {
   using InputSetElement = DataRef;
   using CallbackFull = std::function<CompletionOp(InputSpan const&, std::vector<InputSpec> const&, ServiceRegistryRef&)>;
   using CallbackConfigureRelayer = std::function<void(DataRelayer&)>;
+  using RequiredInput = std::function<bool(InputSpec const&)>;
 
   /// Constructor
   CompletionPolicy()
@@ -91,6 +92,13 @@ struct CompletionPolicy {
   /// A callback which allows you to configure the behavior of the data relayer associated
   /// to the matching device.
   CallbackConfigureRelayer configureRelayer = nullptr;
+  /// Optional incremental hint. The inputs for which this returns true are
+  /// required for the policy to do anything but Wait. The DataRelayer keeps
+  /// count of the required inputs which did not arrive yet for each slot,
+  /// updating it whenever an input arrives, and only invokes callbackFull
+  /// once all of them are there, rather than walking the whole InputSpan
+  /// on every new message.
+  RequiredInput requiredInput = nullptr;
   /// Wether or not the policy requires queues to be balanced
   /// Set to false if the policy does not require that the upstream
   /// producers are more or less balanced. Most notably, this is
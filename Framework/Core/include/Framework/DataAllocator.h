@@ -407,6 +407,13 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload of an existing message, e.g. of an input, without copying the data if the message
+  /// belongs to the transport of the output channel. In this case the new message references the same
+  /// buffer, which for shared memory is only released after all references are gone. Otherwise the
+  /// payload is copied like in snapshot().
+  void forwardPayload(const Output& spec, fair::mq::Message& payload,
+                      o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
@@ -433,9 +440,8 @@ class DataAllocator
   o2::pmr::FairMQMemoryResource* getMemoryResource(const Output& spec)
   {
     auto& timingInfo = mRegistry.get<TimingInfo>();
-    auto& proxy = mRegistry.get<FairMQDeviceProxy>();
     RouteIndex routeIndex = matchDataHeader(spec, timingInfo.timeslice);
-    return *proxy.getOutputTransport(routeIndex);
+    return mRegistry.get<MessageContext>().memoryResource(routeIndex);
   }
 
   // make a stl (pmr) vector
@@ -304,6 +304,10 @@ class DataDescriptorMatcher
   Op getOp() const { return mOp; };
 
  private:
+  /// Evaluate the query on the already resolved headers of a message,
+  /// which are null when missing from the header stack.
+  bool match(header::DataHeader const* dh, DataProcessingHeader const* dph, VariableContext& context) const;
+
   Op mOp;
   Node mLeft;
   Node mRight;
@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DATADESCRIPTORMATCHERINDEX_H_
+#define O2_FRAMEWORK_DATADESCRIPTORMATCHERINDEX_H_
+
+#include "Framework/DataDescriptorMatcher.h"
+#include "Headers/DataHeader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace o2::framework::data_matcher
+{
+
+/// Lookup table of an ordered list of DataDescriptorMatcher on the
+/// origin, description and subspecification they require.
+///
+/// For a given header it provides the positions of the only matchers
+/// which can possibly match it, in the original order, so that trying
+/// them in sequence gives the same result as trying all the matchers.
+/// Matchers which do not require a constant origin and description
+/// (e.g. because they use a variable or an Or clause) are wildcards
+/// which are candidates for any header.
+class DataDescriptorMatcherIndex
+{
+ public:
+  DataDescriptorMatcherIndex() = default;
+
+  /// Build the index of the matchers found at the positions @a order,
+  /// the candidates are given as indices in @a order.
+  DataDescriptorMatcherIndex(std::vector<DataDescriptorMatcher> const& matchers, std::vector<size_t> const& order);
+
+  /// @return the ordered indices of the matchers which can match the
+  /// header @a dh. All of them are returned when there is no header.
+  std::vector<size_t> const& candidates(header::DataHeader const* dh) const;
+
+  /// @return the number of matchers which are candidates for any header.
+  [[nodiscard]] size_t getNumberOfWildcards() const { return mWildcards.size(); }
+
+ private:
+  /// Normalised origin, description and subspecification, as compared by the
+  /// value matchers, i.e. ignoring what follows the first null character.
+  struct Key {
+    char origin[header::DataOrigin::size] = {};
+    char description[header::DataDescription::size] = {};
+    header::DataHeader::SubSpecificationType subSpec = 0;
+
+    bool operator==(Key const& other) const;
+  };
+
+  struct KeyHash {
+    size_t operator()(Key const& key) const;
+  };
+
+  static Key makeKey(char const* origin, size_t originSize, char const* description, size_t descriptionSize, header::DataHeader::SubSpecificationType subSpec);
+
+  std::vector<size_t> mAll;                                         ///< all the positions
+  std::vector<size_t> mWildcards;                                   ///< positions of the matchers without constant origin and description
+  std::unordered_map<Key, std::vector<size_t>, KeyHash> mExact;     ///< candidates per origin, description and subspecification
+  std::unordered_map<Key, std::vector<size_t>, KeyHash> mNoSubSpec; ///< candidates per origin and description, for any subspecification
+};
+
+} // namespace o2::framework::data_matcher
+
+#endif // O2_FRAMEWORK_DATADESCRIPTORMATCHERINDEX_H_
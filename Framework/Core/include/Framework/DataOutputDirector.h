@@ -78,6 +78,13 @@ struct DataOutputDirector {
   void setNumberTimeFramesToMerge(int ntfmerge) { mnumberTimeFramesToMerge = ntfmerge > 0 ? ntfmerge : 1; }
   std::string getFileMode() { return mfileMode; }
   void setFileMode(std::string filemode) { mfileMode = filemode; }
+  // "root" (TTrees in a ROOT file) or "arrow" (a directory of arrow IPC files)
+  std::string getFileFormat() { return mfileFormat; }
+  void setFileFormat(std::string fileformat);
+  // number of time frames which can wait to be written by a background
+  // thread, 0 (default) writes in the processing callback
+  int getWriterQueueDepth() { return mwriterQueueDepth; }
+  void setWriterQueueDepth(int depth) { mwriterQueueDepth = depth > 0 ? depth : 0; }
 
   // get matching DataOutputDescriptors
   std::vector<DataOutputDescriptor*> getDataOutputDescriptors(header::DataHeader dh);
@@ -85,6 +92,9 @@ struct DataOutputDirector {
 
   // get the matching TFile
   FileAndFolder getFileFolder(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::string parentFileName);
+  // get the name of the arrow file to be used for the table of dodesc,
+  // when the file format is "arrow"
+  std::string getArrowFilename(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::string parentFileName);
 
   // check file sizes
   bool checkFileSizes();
@@ -107,11 +117,16 @@ struct DataOutputDirector {
   std::vector<std::string> mfilenameBases;
   std::vector<TFile*> mfilePtrs;
   std::vector<TMap*> mParentMaps;
+  std::vector<std::string> mArrowDirectories;
   bool mdebugmode = false;
   int mfileCounter = 1;
   float mmaxfilesize = -1.;
   int mnumberTimeFramesToMerge = 1;
   std::string mfileMode = "RECREATE";
+  std::string mfileFormat = "root";
+  int mwriterQueueDepth = 0;
+
+  std::string createResultDirectory();
 
   std::tuple<std::string, std::string, std::string, float, int> readJsonDocument(Document* doc);
   const std::tuple<std::string, std::string, std::string, float, int> memptyanswer = std::make_tuple(std::string(""), std::string(""), std::string(""), -1., -1);
@@ -64,7 +64,29 @@ enum struct ProcessingStatsId : short {
   RESOURCES_MISSING,
   RESOURCES_INSUFFICIENT,
   RESOURCES_SATISFACTORY,
+  SCHEDULER_QUEUE_DEPTH,
+  SCHEDULER_STEALS,
+  SCHEDULER_IDLE_TIME_MS,
+  RATE_LIMITER_WINDOW,
+  RATE_LIMITER_LATENCY_MS,
+  RATE_LIMITER_BASE_LATENCY_MS,
+  SLAB_ALLOCATIONS,
+  SLAB_REUSED,
+  SLAB_CACHED_BYTES,
+  RELAYER_COMPLETION_TIME_MS,
+  RELAYER_COMPLETION_TIME_P99_MS,
+  RELAYER_QUEUE_TIME_MS,
+  RELAYER_QUEUE_TIME_P99_MS,
+  MEMORY_ALLOCATIONS,
+  MEMORY_ALLOCATED_BYTES,
+  MEMORY_HELD_BYTES,
+  MEMORY_PEAK_HELD_BYTES,
+  MALLOC_IN_USE_BYTES,
+  NUMA_LOCAL_BYTES,
+  NUMA_REMOTE_BYTES,
   AVAILABLE_MANAGED_SHM_BASE = 512,
+  RELAYER_INPUT_WAIT_BASE = 1024,
+  MEMORY_HELD_BYTES_BASE = 2048,
 };
 
 /// Helper struct to hold statistics about the data processing happening.
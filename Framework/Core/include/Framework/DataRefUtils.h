@@ -167,6 +167,12 @@ struct DataRefUtils {
     } else if constexpr (is_specialization_v<T, CCDBSerialized> == true) {
       using wrapped = typename T::wrapped_type;
       using DataHeader = o2::header::DataHeader;
+      if constexpr (requires(const char* image, size_t size) { wrapped::template isFlatImage<wrapped>(image, size); }) {
+        // flat objects stored as raw image are relocated, without ROOT streaming
+        if (wrapped::template isFlatImage<wrapped>(ref.payload, getPayloadSize(ref))) {
+          return std::unique_ptr<wrapped>(wrapped::template readFromFlatImage<wrapped>(ref.payload, getPayloadSize(ref)));
+        }
+      }
       auto* ptr = DataRefUtils::decodeCCDB(ref, typeid(wrapped));
       if constexpr (std::is_base_of<o2::conf::ConfigurableParam, wrapped>::value) {
         auto& param = const_cast<typename std::remove_const<wrapped&>::type>(wrapped::Instance());
@@ -177,6 +183,37 @@ struct DataRefUtils {
       return std::move(result);
     }
   }
+
+  /// Extract a ROOT-serialised object into @a object, which is reused if it was
+  /// extracted from a previous message of the same class, avoiding the allocation
+  /// of all its members.
+  template <typename T>
+  static void readInto(DataRef const& ref, std::unique_ptr<T>& object)
+  {
+    static_assert(is_type_complete_v<struct RootSerializationSupport>, "Framework/RootSerializationSupport.h not included");
+    call_if_defined<struct RootSerializationSupport>([&](auto* p) {
+      using RSS = std::decay_t<decltype(*p)>;
+      using DataHeader = o2::header::DataHeader;
+      auto header = o2::header::get<const DataHeader*>(ref.header);
+      if (header->payloadSerializationMethod != o2::header::gSerializationMethodROOT) {
+        throw runtime_error("Attempt to extract a TMessage from non-ROOT serialised message");
+      }
+      // the streamers of collections add to the existing elements, which are
+      // owned, see below
+      if constexpr (has_root_setowner<T>::value) {
+        if (object) {
+          object->Clear();
+        }
+      }
+      typename RSS::FairInputTBuffer ftm(const_cast<char*>(ref.payload), getPayloadSize(ref));
+      RSS::TMessageSerializer::deserializeInto(ftm, object);
+      // see above, the objects created by the streamer must be owned by the collection
+      if constexpr (has_root_setowner<T>::value) {
+        object->SetOwner(true);
+      }
+    });
+  }
+
   // Decode a CCDB object using the CcdbApi.
   static void* decodeCCDB(DataRef const& ref, std::type_info const& info);
 
@@ -14,6 +14,7 @@
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/InputRoute.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataDescriptorMatcherIndex.h"
 #include "Framework/ForwardRoute.h"
 #include "Framework/CompletionPolicy.h"
 #include "Framework/MessageSet.h"
@@ -22,6 +23,7 @@
 #include "Framework/TimesliceSlot.h"
 #include "Framework/ServiceRegistryRef.h"
 
+#include <array>
 #include <cstddef>
 #include <mutex>
 #include <vector>
@@ -47,9 +49,15 @@ enum struct CacheEntryStatus : int {
 class DataRelayer
 {
  public:
-  /// DataRelayer is thread safe because we have a lock around
-  /// each method and there is no particular order in which
-  /// methods need to be called.
+  /// DataRelayer is thread safe. The TimesliceIndex bookkeeping (slot
+  /// assignment, dirty flags, variables) is protected by mMutex, which is
+  /// only held for the short time needed to find or update a slot, while
+  /// the cachelines of a given slot are protected by one of the
+  /// mSlotMutexes shards. This way relaying to and consuming from different
+  /// timeslices can proceed in parallel from different streams.
+  /// Locks are always acquired in the order mMutex -> slot shard, never
+  /// the other way around. The latency histograms are protected by a
+  /// separate mTimingMutex, which is always the last one to be taken.
   constexpr static ServiceKind service_kind = ServiceKind::Global;
   /// This represents what the DataRelayer did when
   /// inserting a set of messages in the cache.
@@ -75,6 +83,33 @@ class DataRelayer
     TimesliceSlot slot = {-1ULL};
   };
 
+  /// A coarse histogram of latencies, in milliseconds, with power of two
+  /// sized bins: bin 0 is [0, 1), bin 1 is [1, 2), bin 2 is [2, 4) and so on.
+  /// The last bin catches everything above.
+  struct LatencyHistogram {
+    static constexpr size_t NBINS = 16;
+    std::array<uint64_t, NBINS> bins = {};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    void fill(uint64_t ms);
+    /// @return the upper edge of the bin containing the @a q quantile,
+    /// clamped to the maximum seen value.
+    [[nodiscard]] uint64_t quantile(float q) const;
+    [[nodiscard]] uint64_t mean() const { return count ? sum / count : 0; }
+    void reset() { *this = LatencyHistogram{}; }
+  };
+
+  /// Timing information for the messages which ended up in a given slot.
+  /// All the times are in ns, as returned by uv_hrtime(), 0 means unset.
+  struct SlotTiming {
+    /// When the first input of the slot arrived.
+    uint64_t firstArrival = 0;
+    /// When the slot was found to be ready by the CompletionPolicy.
+    uint64_t ready = 0;
+  };
+
   struct RecordAction {
     TimesliceSlot slot;
     TimesliceId timeslice;
@@ -191,6 +226,16 @@ class DataRelayer
   [[nodiscard]] size_t getNumberOfTimeslices() const { return mTimesliceIndex.size(); }
   [[nodiscard]] size_t getNumberOfUniqueInputs() const { return mDistinctRoutesIndex.size(); }
 
+  /// Histogram of the time between the first input of a slot arriving
+  /// and the slot being ready to be processed.
+  [[nodiscard]] LatencyHistogram getCompletionHistogram();
+  /// Histogram of the time a ready slot waited before being consumed.
+  [[nodiscard]] LatencyHistogram getQueueHistogram();
+  /// Histogram of the time between the first input of a slot arriving
+  /// and the arrival of @a input. The input with the largest values is
+  /// the one on the critical path.
+  [[nodiscard]] LatencyHistogram getInputWaitHistogram(size_t input);
+
  private:
   ServiceRegistryRef mContext;
 
@@ -208,12 +253,56 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<InputSpec> mInputs;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// Candidate routes per origin, description and subspecification, to avoid trying all the matchers
+  data_matcher::DataDescriptorMatcherIndex mInputMatcherIndex;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
 
+  /// Whether the input at the given position is required by the
+  /// CompletionPolicy::requiredInput hint.
+  std::vector<char> mRequiredInputs;
+  /// How many required inputs there are in total.
+  int mNumRequiredInputs = 0;
+  /// For each slot, how many required inputs did not arrive yet.
+  /// Protected by the slot lock.
+  std::vector<int> mMissingRequiredInputs;
+  /// Account for the arrival of the first message for @a input in @a slot.
+  void markInputArrived(TimesliceSlot slot, size_t input);
+  /// Forget about all the timing information of @a slot.
+  void resetTiming(TimesliceSlot slot);
+  /// Account for @a slot being ready to be processed.
+  void markSlotReady(TimesliceSlot slot);
+  /// Account for @a slot being consumed.
+  void markSlotConsumed(TimesliceSlot slot);
+  /// Publish the latency histograms as metrics and reset them.
+  void publishLatencies();
+
+  /// When the first message for each cacheline arrived.
+  /// Protected by the slot lock.
+  std::vector<uint64_t> mArrivalTimes;
+  /// Per slot timing information. Protected by the slot lock.
+  std::vector<SlotTiming> mSlotTimings;
+  /// Histograms of the latencies since the last time they were published.
+  /// Protected by mTimingMutex, so that they can be filled while only holding
+  /// a slot lock.
+  LatencyHistogram mCompletionHistogram;
+  LatencyHistogram mQueueHistogram;
+  std::vector<LatencyHistogram> mInputWaitHistograms;
+  std::mutex mTimingMutex;
+
+  /// Number of shards used to protect the cachelines. Slots are mapped
+  /// to a shard by their index, so as long as the pipeline is shorter than
+  /// this each slot effectively has its own lock.
+  static constexpr size_t MAX_SLOT_SHARDS = 64;
+  /// @return the mutex protecting the cachelines of @a slot
+  std::mutex& slotMutex(TimesliceSlot slot) { return mSlotMutexes[slot.index % MAX_SLOT_SHARDS]; }
+  /// Lock all the shards, e.g. when resizing the cache.
+  std::vector<std::unique_lock<std::mutex>> lockAllSlots();
+
   O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
+  std::array<std::mutex, MAX_SLOT_SHARDS> mSlotMutexes;
 };
 
 } // namespace o2::framework
@@ -0,0 +1,63 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DERIVEDTABLECACHE_H_
+#define O2_FRAMEWORK_DERIVEDTABLECACHE_H_
+
+#include "Framework/OutputSpec.h"
+
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+struct DataProcessorSpec;
+
+/// The tables produced by a given task, stored under
+/// DerivedTableCache::entryPath(cacheDir, hash, inputFile).
+struct DerivedTableCacheEntry {
+  /// Hash of the configuration of the producing task
+  std::string hash;
+  std::vector<OutputSpec> outputs;
+};
+
+/// Helpers for the cache of derived tables enabled by --aod-derived-cache.
+/// The tables produced by a task which only depends on the input AOD are
+/// stored, for each input file, as arrow files (see ArrowFileHelpers):
+///
+///   <cacheDir>/<configuration hash>/<input file hash>/DF_<n>/<treename>.arrow
+///   <cacheDir>/<configuration hash>/<input file hash>/complete
+///
+/// so that a later run with the same configuration on the same files can
+/// read them instead of running the task again.
+struct DerivedTableCache {
+  /// Marker written once all the tables of an entry have been stored
+  static constexpr char const* completeName = "complete";
+
+  /// Hash of everything which determines the outputs of @a spec, given the
+  /// hashes of the cached tasks it consumes tables from (@a upstream): its
+  /// name, outputs, options, the ones of those given on the command line
+  /// (@a argc, @a argv) and the --configuration, if any.
+  static std::string configurationHash(DataProcessorSpec const& spec, int argc, char* const* argv, std::vector<std::string> const& upstream);
+  /// Local files are identified by their absolute path.
+  static std::string normalise(std::string const& inputFile);
+  /// The directory where the tables derived from @a inputFile are stored.
+  static std::string entryPath(std::string const& cacheDir, std::string const& hash, std::string const& inputFile);
+  /// The input files corresponding to the aod-file option @a aodFile,
+  /// i.e. either the file itself or the content of @list.txt.
+  static std::vector<std::string> inputFiles(std::string const& aodFile);
+  static bool isComplete(std::string const& entry);
+  static void markComplete(std::string const& entry);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DERIVEDTABLECACHE_H_
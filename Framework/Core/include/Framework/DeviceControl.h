@@ -50,6 +50,8 @@ struct DeviceControl {
   int tracingFlags = 0;
   /// What kind of log streams should be enabled
   int logStreams = 0;
+  /// What kind of log streams should be recorded in the trace buffers
+  int traceStreams = 0;
   /// An incremental number to identify the device state
   int requestedState = 0;
 };
@@ -84,6 +84,12 @@ struct DeviceInfo {
   size_t lastSignal;
   /// An incremental number for the state of the device
   int providedState = 0;
+  /// CPU time spent by the device in user and system mode, in seconds.
+  /// Only available once the device exited.
+  double userTime = 0;
+  double systemTime = 0;
+  /// Peak resident set size of the device, in kB. Only available once the device exited.
+  long maxResidentSetSize = 0;
 };
 
 } // namespace o2::framework
@@ -104,6 +104,10 @@ struct DeviceState {
   int tracingFlags = 0;
   /// Bitmask of log streams which are available
   int logStreams = 0;
+  /// Bitmask of LogStreams whose signposts are recorded in the trace buffers
+  int traceStreams = 0;
+  /// NUMA node on which the memory of the device is allocated, -1 if not bound
+  int numaNode = -1;
   /// Stack of the severity, so that we can display only
   /// the bits we are interested in.
   std::vector<int> severityStack;
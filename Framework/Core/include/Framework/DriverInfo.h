@@ -151,6 +151,8 @@ struct DriverInfo {
   unsigned short resourcesMonitoringInterval = 0;
   /// Metrics gathering dump to disk interval
   unsigned short resourcesMonitoringDumpInterval = 0;
+  /// File where to write the resources used by each device on exit, empty to disable.
+  std::string benchmarkReport = "";
   /// Port used by the websocket control. 0 means not initialised.
   unsigned short port = 0;
   /// The minimum level after which the device will exit with 1
@@ -455,6 +455,17 @@ std::shared_ptr<gandiva::Projector> createProjector(gandiva::SchemaPtr const& Sc
 std::shared_ptr<gandiva::Projector> createProjector(gandiva::SchemaPtr const& Schema,
                                                     Projector&& p,
                                                     gandiva::FieldPtr result);
+/// Statistics of the process wide cache of compiled gandiva filters and
+/// projectors, which the functions above use. The cache can be disabled
+/// by setting DPL_NO_EXPRESSION_CACHE=1.
+struct ExpressionCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t size = 0;
+};
+ExpressionCacheStats getExpressionCacheStats();
+/// Drop all the cached filters and projectors
+void clearExpressionCache();
 /// Function for attaching gandiva filters to to compatible task inputs
 void updateExpressionInfos(expressions::Filter const& filter, std::vector<ExpressionInfo>& eInfos);
 /// Function to create gandiva condition expression from generic gandiva expression tree
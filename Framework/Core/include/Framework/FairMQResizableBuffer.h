@@ -14,7 +14,10 @@
 
 #include <memory>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
 #include "arrow/io/interfaces.h"
 #include "arrow/status.h"
 #include "arrow/util/future.h"
@@ -86,7 +89,7 @@ class FairMQOutputStream : public OutputStream
 /// An arrow::ResizableBuffer implemented on top of a fair::mq::Message
 /// FIXME: this is an initial attempt to integrate arrow and FairMQ
 /// a proper solution probably involves writing a `arrow::MemoryPool`
-/// using a `fair::mq::UnmanagedRegion`. This will come at a later stage.
+/// using a `fair::mq::UnmanagedRegion`. See FairMQMemoryPool below.
 class FairMQResizableBuffer : public ::arrow::ResizableBuffer
 {
  public:
@@ -119,6 +122,46 @@ class FairMQResizableBuffer : public ::arrow::ResizableBuffer
   Creator mCreator;
 };
 
+/// An arrow::MemoryPool where every allocation is backed by a
+/// fair::mq::Message obtained via the provided Creator, e.g. from the
+/// transport of an output channel. Using it for a TableBuilder keeps the
+/// column buffers in shared memory rather than on the heap of the device,
+/// so that building a large table does not create a private memory spike
+/// on top of the message we eventually send.
+class FairMQMemoryPool : public ::arrow::MemoryPool
+{
+ public:
+  using Creator = FairMQResizableBuffer::Creator;
+
+  explicit FairMQMemoryPool(Creator);
+  ~FairMQMemoryPool() override;
+
+  using MemoryPool::Allocate;
+  using MemoryPool::Free;
+  using MemoryPool::Reallocate;
+
+  arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out) override;
+  arrow::Status Reallocate(int64_t oldSize, int64_t newSize, int64_t alignment, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size, int64_t alignment) override;
+
+  [[nodiscard]] int64_t bytes_allocated() const override;
+  [[nodiscard]] int64_t max_memory() const override;
+  [[nodiscard]] int64_t total_bytes_allocated() const override;
+  [[nodiscard]] int64_t num_allocations() const override;
+  [[nodiscard]] std::string backend_name() const override { return "fairmq"; }
+
+ private:
+  Creator mCreator;
+  /// The messages backing the allocations, indexed by the (aligned)
+  /// pointer we handed out.
+  std::unordered_map<uint8_t*, std::unique_ptr<fair::mq::Message>> mMessages;
+  int64_t mBytesAllocated = 0;
+  int64_t mMaxMemory = 0;
+  int64_t mTotalBytesAllocated = 0;
+  int64_t mNumAllocations = 0;
+  mutable std::mutex mMutex;
+};
+
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_FAIRMQRESIZABLEBUFFER_H_
@@ -92,6 +92,11 @@ class HistogramRegistry
   };
 
  public:
+  // position of a histogram in the registry, which can be used to fill it without looking up its name
+  struct HistHandle {
+    uint32_t idx{};
+  };
+
   HistogramRegistry(char const* const name = "histograms", std::vector<HistogramSpec> histSpecs = {}, OutputObjHandlingPolicy policy = OutputObjHandlingPolicy::AnalysisObject, bool sortHistos = false, bool createRegistryDir = false);
 
   // functions to add histograms to the registry
@@ -139,6 +144,31 @@ class HistogramRegistry
   template <typename... Cs, typename T>
   void fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter);
 
+  // get the handle of a histogram, which stays valid for the lifetime of the registry
+  HistHandle getHandle(const HistName& histName);
+
+  // fill hist with values, skipping the name lookup
+  template <typename... Ts>
+  void fill(HistHandle handle, Ts... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+
+  // create nShards private copies of all the histograms (which have to be added beforehand),
+  // so that nShards threads can fill the registry concurrently, each one using its own shard
+  void setNumberOfShards(uint32_t nShards);
+  uint32_t getNumberOfShards() const { return mShards.size(); }
+
+  // fill the copy of hist in shard with values, safe as long as a shard is used by one thread at a time
+  template <typename... Ts>
+  void fillShard(uint32_t shard, HistHandle handle, Ts... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+  template <typename... Ts>
+  void fillShard(uint32_t shard, const HistName& histName, Ts... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+
+  // add the content of all the shards to the histograms of the registry and reset the shards,
+  // called at the end of each dataframe and before the histograms are sent
+  void mergeShards();
+
   // get rough estimate for size of histogram stored in registry
   double getSize(const HistName& histName, double fillFraction = 1.);
 
@@ -194,6 +224,7 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+  std::vector<std::array<HistPtr, MAX_REGISTRY_SIZE>> mShards{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -425,6 +456,27 @@ void HistogramRegistry::fill(const HistName& histName, Ts... positionAndWeight)
   std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mRegistryValue[getHistIndex(histName)]);
 }
 
+template <typename... Ts>
+void HistogramRegistry::fill(HistHandle handle, Ts... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mRegistryValue[handle.idx]);
+}
+
+template <typename... Ts>
+void HistogramRegistry::fillShard(uint32_t shard, HistHandle handle, Ts... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mShards[shard][handle.idx]);
+}
+
+template <typename... Ts>
+void HistogramRegistry::fillShard(uint32_t shard, const HistName& histName, Ts... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  fillShard(shard, HistHandle{getHistIndex(histName)}, positionAndWeight...);
+}
+
 extern template void HistogramRegistry::fill(const HistName& histName, double);
 extern template void HistogramRegistry::fill(const HistName& histName, float);
 extern template void HistogramRegistry::fill(const HistName& histName, int);
@@ -16,9 +16,11 @@
 #include <arrow/chunked_array.h>
 #include <arrow/builder.h>
 #include <arrow/memory_pool.h>
+#include <functional>
 #include <string>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace o2::framework
 {
@@ -69,6 +71,9 @@ struct SelfIndexColumnBuilder {
     (void)static_cast<arrow::Int32Builder*>(mBuilder.get())->Append(idx);
   }
 
+  /// Restart the lookups from the beginning of the source
+  virtual void reset() {}
+
   std::string mColumnName;
   std::shared_ptr<arrow::DataType> mArrowType;
   std::unique_ptr<arrow::ArrayBuilder> mBuilder = nullptr;
@@ -117,6 +122,8 @@ class IndexColumnBuilder : public SelfIndexColumnBuilder, public ChunkedArrayIte
     }
   }
 
+  void reset() override;
+
  private:
   arrow::Status preSlice();
   arrow::Status preFind();
@@ -142,12 +149,18 @@ class IndexColumnBuilder : public SelfIndexColumnBuilder, public ChunkedArrayIte
 
   std::shared_ptr<arrow::NumericArray<arrow::Int32Type>> mValuesArrow = nullptr;
   std::shared_ptr<arrow::NumericArray<arrow::Int64Type>> mCounts = nullptr;
-  std::vector<int> mValues;
-  std::vector<std::vector<int>> mIndices;
+  std::vector<int64_t> mFirstRows;        // first row of each of the mValuesArrow slices
+  std::vector<std::vector<int>> mIndices; // rows of the source for each value, the value being the position
   int mFillOffset = 0;
   int mValuePos = 0;
 };
 
+/// Copy the values of an int32 column, chunk by chunk
+void readIndexValues(std::shared_ptr<arrow::ChunkedArray> const& source, std::vector<int>& values);
+
+/// Run the tasks (one per index column), concurrently if there are enough rows to be worth it
+void runColumnTasks(std::vector<std::function<void()>>& tasks, int64_t nRows);
+
 std::shared_ptr<arrow::Table> makeArrowTable(const char* label, std::vector<std::shared_ptr<arrow::ChunkedArray>>&& columns, std::vector<std::shared_ptr<arrow::Field>>&& fields);
 } // namespace o2::framework
 
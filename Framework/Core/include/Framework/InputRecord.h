@@ -20,6 +20,7 @@
 #include "Framework/RuntimeError.h"
 #include "Framework/Logger.h"
 #include "Framework/ObjectCache.h"
+#include "Framework/ObjectPool.h"
 #include "Framework/CallbackService.h"
 
 #include "Headers/DataHeader.h"
@@ -82,6 +83,15 @@ class CallbackService;
 ///    auto v4 = get<vector<TParticle>>("input4");
 /// </pre>
 ///
+/// \par Pooled ROOT objects
+/// ROOT-serialized objects retrieved by pointer are allocated and streamed anew for every
+/// timeslice. With @ref getPooled the object of the previous timeslice of the same input
+/// is reused and the payload streamed into it, e.g. for large histograms. The object stays
+/// owned by the framework and is overwritten by the next call for the same input.
+/// <pre>
+///    auto const* h = getPooled<TH2F>("input5");
+/// </pre>
+///
 /// \par Validity of inputs
 /// Not all input slots are always valid if a custom completion policy is chosen. Validity
 /// can be checked using method @ref isValid.
@@ -106,6 +116,15 @@ class InputRecord
     constexpr static size_t INVALID = -1LL;
   };
 
+  // Binding resolved once to its position in the record, e.g. at the first
+  // processing, so that accessing the input does not need to look up the
+  // binding by name. The position only depends on the input routes of the
+  // device, hence the handle stays valid for its whole lifetime.
+  struct Handle {
+    int pos = -1;
+    [[nodiscard]] bool isResolved() const { return pos >= 0; }
+  };
+
   InputRecord(std::vector<InputRoute> const& inputs,
               InputSpan& span,
               ServiceRegistryRef);
@@ -189,6 +208,10 @@ class InputRecord
 
   [[nodiscard]] int getPos(const std::string& name) const;
 
+  /// Resolve the @a binding to a handle, which is not resolved if there is no such input.
+  [[nodiscard]] Handle resolve(const char* binding) const { return Handle{getPos(binding)}; }
+  [[nodiscard]] Handle resolve(std::string const& binding) const { return resolve(binding.c_str()); }
+
   [[nodiscard]] DataRef getByPos(int pos, int part = 0) const;
 
   /// Get the ref of the first valid input. If requested, throw an error if none is found.
@@ -196,6 +219,10 @@ class InputRecord
 
   [[nodiscard]] size_t getNofParts(int pos) const;
 
+  /// The message holding the payload of the @a part of the input at @a pos, which can be
+  /// used to forward the payload without copying it. nullptr if the message is not available.
+  [[nodiscard]] fair::mq::Message* getPayloadMessage(int pos, int part = 0) const;
+
   // Given a binding by string, return the associated DataRef
   DataRef getDataRefByString(const char* bindingName, int part = 0) const
   {
@@ -206,9 +233,20 @@ class InputRecord
     }
     return this->getByPos(pos, part);
   }
+
+  // Given a resolved binding, return the associated DataRef
+  [[nodiscard]] DataRef getDataRefByHandle(Handle handle, int part = 0) const
+  {
+    if (!handle.isResolved()) {
+      auto msg = describeAvailableInputs();
+      throw runtime_error_f("InputRecord::get: unresolved input handle. %s", msg.c_str());
+    }
+    return this->getByPos(handle.pos, part);
+  }
   /// Get the object of specified type T for the binding R.
   /// If R is a string like object, we look up by name the InputSpec and
   /// return the data associated to the given label.
+  /// If R is a Handle, we use the position of the input it was resolved to.
   /// If R is a DataRef, we extract the result object from the Payload,
   /// following the information provided by the Header.
   /// The actual operation and cast depends on the target data type and the
@@ -229,6 +267,8 @@ class InputRecord
       ref = getDataRefByString(binding, part);
     } else if constexpr (std::is_same_v<decayed, std::string>) {
       ref = getDataRefByString(binding.c_str(), part);
+    } else if constexpr (std::is_same_v<decayed, Handle>) {
+      ref = getDataRefByHandle(binding, part);
     } else if constexpr (std::is_same_v<decayed, DataRef>) {
       ref = binding;
     } else {
@@ -454,6 +494,35 @@ class InputRecord
     }
   }
 
+  /// Get a ROOT-serialized object of the input @a binding, deserialized into the instance
+  /// returned for the same input in the previous timeslice, see class description.
+  /// The type needs to be streamable into a used instance, i.e. its streamer overwrites all
+  /// the members, as it is the case for histograms and containers.
+  /// @return non-owning unique_ptr to the pooled object
+  template <typename T>
+  auto getPooled(const char* binding, int part = 0) const
+  {
+    static_assert(has_root_dictionary<T>::value, "pooled objects need a ROOT dictionary");
+    auto ref = getDataRefByString(binding, part);
+    if (ref.header == nullptr) {
+      throw runtime_error_f("InputRecord::getPooled: input %s is not valid", binding);
+    }
+    auto& pool = mRegistry.get<ObjectPool>();
+    auto& entry = pool.objects[ObjectPool::Key{ref.spec, part, typeid(T)}];
+    std::unique_ptr<T> object(static_cast<T*>(entry.object));
+    entry.object = nullptr;
+    DataRefUtils::readInto(ref, object);
+    entry.object = object.release();
+    entry.destroy = [](void* ptr) { delete static_cast<T*>(ptr); };
+    return std::unique_ptr<T const, Deleter<T const>>(static_cast<T const*>(entry.object), Deleter<T const>(false));
+  }
+
+  template <typename T>
+  auto getPooled(std::string const& binding, int part = 0) const
+  {
+    return getPooled<T>(binding.c_str(), part);
+  }
+
   /// Helper method to be used to check if a given part of the InputRecord is present.
   [[nodiscard]] bool isValid(std::string const& s) const
   {
@@ -463,6 +532,8 @@ class InputRecord
   /// Helper method to be used to check if a given part of the InputRecord is present.
   bool isValid(char const* s) const;
   [[nodiscard]] bool isValid(int pos) const;
+  /// Helper method to be used to check if the input of a handle is present.
+  [[nodiscard]] bool isValid(Handle handle) const { return handle.isResolved() && isValid(handle.pos); }
 
   /// @return the total number of inputs in the InputRecord. Notice that these will include
   /// both valid and invalid inputs (i.e. inputs which have not arrived yet), depending
@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_INPUTSPAN_H_
 
 #include "Framework/DataRef.h"
+#include <fairmq/FwdDecls.h>
 #include <functional>
 
 extern template class std::function<o2::framework::DataRef(size_t)>;
@@ -82,6 +83,21 @@ class InputSpan
     return get(i).payload;
   }
 
+  /// @a getter is the mapping between an element of the span referred by
+  /// index and part index and the message holding its payload. It allows
+  /// to forward payloads without copying them.
+  void setPayloadMessageGetter(std::function<fair::mq::Message*(size_t, size_t)> getter)
+  {
+    mPayloadMessageGetter = std::move(getter);
+  }
+
+  /// The message holding the payload of the @a partidx part of the @a i-th
+  /// element, nullptr if the span does not provide the messages.
+  [[nodiscard]] fair::mq::Message* getPayloadMessage(size_t i, size_t partidx = 0) const
+  {
+    return mPayloadMessageGetter && i < mSize ? mPayloadMessageGetter(i, partidx) : nullptr;
+  }
+
   /// an iterator class working on position within the a parent class
   template <typename ParentT, typename T>
   class Iterator
@@ -236,6 +252,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<fair::mq::Message*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
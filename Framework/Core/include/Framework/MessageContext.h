@@ -261,7 +261,7 @@ class MessageContext
         // the transport factory
         mFactory{context->proxy().getOutputTransport(routeIndex)},
         // the memory resource takes ownership of the message
-        mResource{mFactory ? AlignedMemoryResource(mFactory->GetMemoryResource()) : AlignedMemoryResource(nullptr)},
+        mResource{mFactory ? AlignedMemoryResource(context->memoryResource(routeIndex)) : AlignedMemoryResource(nullptr)},
         // create the vector with apropriate underlying memory resource for the message
         mData{std::forward<Args>(args)..., pmr::polymorphic_allocator<value_type>(&mResource)}
     {
@@ -486,6 +486,18 @@ class MessageContext
   fair::mq::MessagePtr createMessage(RouteIndex routeIndex, int index, size_t size);
   fair::mq::MessagePtr createMessage(RouteIndex routeIndex, int index, void* data, size_t size, fair::mq::FreeFn* ffn, void* hint);
 
+  /// @return the memory resource to be used for containers sent via @a routeIndex.
+  /// This is a SlabMessageResource when DPL_SLAB_ALLOCATOR=1, the transport one otherwise.
+  /// With DPL_MEMORY_ACCOUNTING=1, it is wrapped in an AccountingMessageResource per output channel.
+  o2::pmr::FairMQMemoryResource* memoryResource(RouteIndex routeIndex);
+  /// @return the accumulated statistics of the slab resources of this context
+  [[nodiscard]] o2::pmr::SlabMessageResource::Stats slabStats() const;
+  /// @return the statistics of the accounting resources, per output channel index,
+  /// starting a new interval if @a reset is true
+  std::vector<std::pair<int, o2::pmr::AccountingMessageResource::Stats>> accountingStats(bool reset);
+  /// @return the @a n allocation sites with the most sampled bytes, over all the output channels
+  [[nodiscard]] std::vector<o2::pmr::AccountingMessageResource::Site> topAllocationSites(size_t n) const;
+
   /// return the headers of the 1st (from the end) matching message checking first in mMessages then in mScheduledMessages
   o2::header::DataHeader* findMessageHeader(const Output& spec);
   o2::header::Stack* findMessageHeaderStack(const Output& spec);
@@ -503,6 +515,10 @@ class MessageContext
   DispatchControl mDispatchControl;
   /// Cached messages, in case we want to reuse them.
   std::unordered_map<int64_t, std::unique_ptr<fair::mq::Message>> mMessageCache;
+  /// Slab resources, one per output transport.
+  std::unordered_map<fair::mq::TransportFactory*, std::unique_ptr<o2::pmr::SlabMessageResource>> mSlabResources;
+  /// Accounting resources, one per output channel index.
+  std::unordered_map<int, std::unique_ptr<o2::pmr::AccountingMessageResource>> mAccountingResources;
 };
 } // namespace o2::framework
 #endif // O2_FRAMEWORK_MESSAGECONTEXT_H_
@@ -0,0 +1,163 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef FRAMEWORK_MIXINGPOOL_H
+#define FRAMEWORK_MIXINGPOOL_H
+
+#include "Framework/ASoA.h"
+#include "Framework/BinningPolicy.h"
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Pool of past collisions for event mixing across dataframes.
+///
+/// The grouping helpers (Pair, SameKindPair, ...) only combine collisions of
+/// the same dataframe. A MixingPool, kept as a member of the analysis task,
+/// retains the selected columns Cs of the associated rows (e.g. tracks) of the
+/// last `depth` collisions of each bin of the binning policy BP, such that the
+/// collisions of a dataframe can also be mixed with those of the previous
+/// dataframes. The memory is bounded: the events of a bin are held in a ring
+/// buffer, where the oldest event is overwritten (reusing its storage), and
+/// optionally at most `maxRows` rows are kept per event.
+///
+/// Typical use, after the same-dataframe mixing of the process function:
+///
+///   for (auto& [c1, tracks1, c2, tracks2] : pair) { ... }
+///   pool.newDataframe();
+///   for (auto& collision : collisions) {
+///     auto tracksColl = tracks.sliceBy(perCollision, collision.globalIndex());
+///     pool.mix(collision, collisions, tracksColl, [](auto& track, auto const& pooled) { ... });
+///     pool.add(collision, collisions, tracksColl);
+///   }
+///
+/// Only events of previous dataframes are mixed, such that the pairs of the
+/// same dataframe are not counted twice.
+template <typename BP, typename... Cs>
+struct MixingPool {
+  using row_t = std::tuple<typename Cs::type...>;
+
+  struct PooledEvent {
+    uint64_t dataframe = 0;     // dataframe the collision was added in, see newDataframe()
+    int64_t collisionIndex = 0; // global index of the collision in its dataframe
+    std::vector<row_t> rows;    // selected columns of the associated rows
+  };
+
+  MixingPool(BP const& binning, int depth, int maxRows = -1) : mBinning{binning}, mDepth{depth > 0 ? depth : 1}, mMaxRows{maxRows}
+  {
+  }
+
+  /// To be called once per dataframe, before the collisions of this dataframe are added
+  void newDataframe()
+  {
+    mDataframe++;
+  }
+
+  /// Bin of the collision, -1 if it is not to be mixed
+  template <typename T>
+  int getBin(typename T::iterator const& collision, T const& collisions) const
+  {
+    auto rowIterator = collision;
+    return mBinning.getBin(mBinning.getBinningValues(rowIterator, collisions.asArrowTable().get()));
+  }
+
+  /// Adds the collision, with the selected columns of its associated rows, to the pool
+  template <typename T, typename A>
+  void add(typename T::iterator const& collision, T const& collisions, A const& associated)
+  {
+    int bin = getBin(collision, collisions);
+    if (bin < 0) {
+      return;
+    }
+    if (static_cast<size_t>(bin) >= mBins.size()) {
+      mBins.resize(bin + 1);
+    }
+    auto& ring = mBins[bin];
+    if (ring.events.size() < static_cast<size_t>(mDepth)) {
+      ring.events.emplace_back();
+      ring.next = ring.events.size() - 1;
+    }
+    auto& event = ring.events[ring.next];
+    ring.next = (ring.next + 1) % mDepth;
+
+    event.dataframe = mDataframe;
+    event.collisionIndex = collision.globalIndex();
+    event.rows.clear(); // keeps the capacity of the overwritten event
+    auto table = associated.asArrowTable().get();
+    for (auto& row : associated) {
+      if (mMaxRows >= 0 && event.rows.size() >= static_cast<size_t>(mMaxRows)) {
+        break;
+      }
+      event.rows.emplace_back(soa::row_helpers::getRowData<typename A::iterator, Cs...>(table, row));
+    }
+  }
+
+  /// Calls f(event) for the pooled events of previous dataframes in the given bin, from the oldest to the newest
+  template <typename F>
+  void forEachEvent(int bin, F&& f) const
+  {
+    if (bin < 0 || static_cast<size_t>(bin) >= mBins.size()) {
+      return;
+    }
+    auto const& ring = mBins[bin];
+    int nEvents = ring.events.size();
+    int first = nEvents < mDepth ? 0 : ring.next;
+    for (int i = 0; i < nEvents; i++) {
+      auto const& event = ring.events[(first + i) % nEvents];
+      if (event.dataframe != mDataframe) {
+        f(event);
+      }
+    }
+  }
+
+  /// Calls f(row, pooledRow) for each associated row of the collision and each pooled row of the
+  /// events of previous dataframes in the bin of the collision
+  template <typename T, typename A, typename F>
+  void mix(typename T::iterator const& collision, T const& collisions, A const& associated, F&& f) const
+  {
+    forEachEvent(getBin(collision, collisions), [&](PooledEvent const& event) {
+      for (auto& row : associated) {
+        for (auto const& pooledRow : event.rows) {
+          f(row, pooledRow);
+        }
+      }
+    });
+  }
+
+  /// Number of pooled events in the bin, including the ones of the current dataframe
+  int getNEvents(int bin) const
+  {
+    return bin >= 0 && static_cast<size_t>(bin) < mBins.size() ? mBins[bin].events.size() : 0;
+  }
+
+  void clear()
+  {
+    mBins.clear();
+  }
+
+ private:
+  struct Ring {
+    std::vector<PooledEvent> events;
+    int next = 0; // slot to overwrite once the ring is full
+  };
+
+  BP mBinning;
+  int mDepth;
+  int mMaxRows;
+  uint64_t mDataframe = 0;
+  std::vector<Ring> mBins;
+};
+
+} // namespace o2::framework
+#endif // FRAMEWORK_MIXINGPOOL_H
@@ -14,6 +14,7 @@
 
 #include "Headers/DataHeader.h"
 #include <fairmq/Parts.h>
+#include <fairmq/FwdDecls.h>
 #include "Framework/OutputSpec.h"
 
 namespace o2::framework
@@ -81,6 +82,17 @@ struct O2DataModelHelpers {
     return true;
   }
   static std::string describeMissingOutputs(std::vector<OutputSpec> const& specs, std::vector<bool> const& present);
+
+  /// Pack all the (header, payload) pairs of @a parts whose payload is
+  /// smaller than @a threshold bytes into a single DPL/COALESCED pair,
+  /// allocated via @a transport. Split payloads and non-data headers
+  /// (e.g. SourceInfoHeader, DomainInfoHeader) are left untouched.
+  /// @return the number of pairs which were packed.
+  static size_t coalesceSmallParts(fair::mq::Parts& parts, fair::mq::TransportFactory* transport, size_t threshold);
+  /// Undo what coalesceSmallParts did, so that the rest of the
+  /// framework only sees the original (header, payload) pairs.
+  /// @return the number of pairs which were unpacked.
+  static size_t expandCoalescedParts(fair::mq::Parts& parts, fair::mq::TransportFactory* transport);
 };
 } // namespace o2::framework
 
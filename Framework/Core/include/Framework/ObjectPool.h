@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_OBJECTPOOL_H_
+#define O2_FRAMEWORK_OBJECTPOOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+
+namespace o2::framework
+{
+
+struct InputSpec;
+
+/// A pool of objects deserialised from ROOT-serialised inputs, which are
+/// reused from one timeslice to the next instead of being allocated again,
+/// see InputRecord::getPooled. There is one object per input route, part
+/// and requested type.
+struct ObjectPool {
+  struct Key {
+    InputSpec const* route;
+    int part;
+    std::type_index type;
+    bool operator==(const Key& other) const
+    {
+      return route == other.route && part == other.part && type == other.type;
+    }
+
+    struct hash_fn {
+      std::size_t operator()(const Key& key) const
+      {
+        return std::hash<void const*>{}(key.route) ^ (std::hash<int>{}(key.part) << 1) ^ (key.type.hash_code() << 2);
+      }
+    };
+  };
+
+  /// A type erased object, deleted with destroy
+  struct Entry {
+    void* object = nullptr;
+    void (*destroy)(void*) = nullptr;
+  };
+
+  ObjectPool() = default;
+  ObjectPool(ObjectPool const&) = delete;
+  ObjectPool& operator=(ObjectPool const&) = delete;
+  ~ObjectPool()
+  {
+    for (auto& [key, entry] : objects) {
+      if (entry.object) {
+        entry.destroy(entry.object);
+      }
+    }
+  }
+
+  std::unordered_map<Key, Entry, Key::hash_fn> objects;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_OBJECTPOOL_H_
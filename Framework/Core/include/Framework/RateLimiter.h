@@ -20,12 +20,32 @@
 
 namespace o2::framework
 {
+/// Throttle the injection of timeframes so that at most maxInFlight
+/// of them are being processed at the same time and at least minSHM
+/// bytes of shared memory are free.
+///
+/// When DPL_ADAPTIVE_RATE_LIMITING=1 is set, maxInFlight is only an upper
+/// bound. The actual window is adjusted with an AIMD controller, using the
+/// processing latency reported via the metric-feedback channel: it grows by
+/// one timeframe per window while less than MIN_QUEUED_TIMEFRAMES timeframes are queued
+/// in excess of what the base latency would need and it is reduced when more
+/// than MAX_QUEUED_TIMEFRAMES are, or when the free shared memory drops below 2 * minSHM.
 class RateLimiter
 {
  public:
   int check(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
 
  private:
+  static constexpr float MIN_QUEUED_TIMEFRAMES = 1.f;
+  static constexpr float MAX_QUEUED_TIMEFRAMES = 3.f;
+
+  /// @return the free memory in the shared memory segment of the device
+  int64_t getFreeSHM(ProcessingContext& ctx);
+  /// Account for the newly consumed timeframes and update the latency estimate
+  void updateConsumed(int64_t consumed);
+  /// @return the number of timeframes which can be in flight in adaptive mode
+  int adaptWindow(int maxInFlight, int64_t freeSHM, size_t minSHM);
+
   int64_t mConsumedTimeframes = 0;
   int64_t mSentTimeframes = 0;
 
@@ -33,6 +53,14 @@ class RateLimiter
   std::chrono::time_point<std::chrono::system_clock> mLastTime, mFirstTime;
   int64_t mTimeCountingSince = 0;
   float mSmothDelay = 0.f;
+
+  // Adaptive mode state
+  std::vector<std::chrono::time_point<std::chrono::system_clock>> mSendTimes;
+  float mWindow = 0.f;
+  float mLatency = 0.f;
+  float mBaseLatency = 0.f;
+  int64_t mNewlyConsumed = 0;
+  int64_t mLastDecrease = 0;
 };
 } // namespace o2::framework
 
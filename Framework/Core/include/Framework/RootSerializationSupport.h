@@ -24,6 +24,7 @@ struct RootSerializationSupport {
   using FairInputTBuffer = o2::framework::FairInputTBuffer;
   using FairOutputBuffer = o2::framework::FairOutputTBuffer;
   using TObject = ::TObject;
+  using TMessageSerializer = o2::framework::TMessageSerializer;
 };
 
 };     // namespace o2::framework
@@ -64,6 +64,12 @@ class ServiceRegistryRef
   {
   }
 
+  /// @return the salt of this reference, e.g. to know which stream we are in
+  [[nodiscard]] ServiceRegistry::Salt salt() const
+  {
+    return mSalt;
+  }
+
   // Wether or not this is the main thread
   bool isMainThread()
   {
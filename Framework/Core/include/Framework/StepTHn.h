@@ -22,6 +22,8 @@
 
 #include "Framework/Logger.h"
 
+#include <vector>
+
 class TArray;
 class TArrayF;
 class TArrayD;
@@ -48,9 +50,18 @@ class StepTHn : public TNamed
   Int_t getNSteps() { return mNSteps; }
   Int_t getNVar() { return mNVars; }
 
+  // with block sparse storage, these arrays contain only the allocated blocks, use getBinContent() to access a bin
   TArray* getValues(Int_t step) { return mValues[step]; }
   TArray* getSumw2(Int_t step) { return mSumw2[step]; }
 
+  // Store the bins in blocks of blockSize bins, which are allocated only once one of their bins is filled,
+  // rather than in one dense array per step. Suited for containers with many bins of which few are filled:
+  // memory and merging time then scale with the number of filled blocks. Has to be called before filling.
+  void setBlockSize(Int_t blockSize);
+  Int_t getBlockSize() const { return mBlockSize; }
+  Long64_t getNAllocatedBins(Int_t step) const { return mValues[step] ? mValues[step]->GetSize() : 0; }
+  Double_t getBinContent(Int_t step, Long64_t globalBin) const;
+
   StepTHn(const StepTHn& c);
   StepTHn& operator=(const StepTHn& corr);
   void Copy(TObject& c) const override;
@@ -58,15 +69,21 @@ class StepTHn : public TNamed
   virtual Long64_t Merge(TCollection* list) = 0;
 
   TAxis* GetAxis(int i) { return mPrototype->GetAxis(i); }
+  virtual void Reset() = 0;
   void Sumw2(){}; // TODO: added for compatibiltiy with registry, but maybe it would be useful also in StepTHn as toggle for error weights
 
  protected:
   void init();
   virtual TArray* createArray(const TArray* src = nullptr) const = 0;
+  virtual TArray* createEmptyArray(Long64_t size) const = 0;
   void createTarget(Int_t step, Bool_t sparse);
   void deleteContainers();
 
   Long64_t getGlobalBinIndex(const Int_t* binIdx);
+  // position of globalBin in the containers of step, allocating its block if needed when using block sparse storage
+  Long64_t getStorageIndex(Int_t step, Long64_t globalBin);
+  // position of globalBin in the containers of step, -1 if its block is not allocated
+  Long64_t findStorageIndex(Int_t step, Long64_t globalBin) const;
 
   Long64_t mNBins;  // number of total bins
   Int_t mNVars;     // number of variables
@@ -83,7 +100,10 @@ class StepTHn : public TNamed
 
   THnSparse* mPrototype; // not filled used as prototype histogram for axis functionality etc.
 
-  ClassDef(StepTHn, 1) // THn like container
+  Int_t mBlockSize;                        // number of bins per block with block sparse storage, 0 for dense storage
+  std::vector<std::vector<Int_t>> mBlocks; // [mNSteps][number of blocks] position of each block in the containers, -1 if not allocated
+
+  ClassDef(StepTHn, 2) // THn like container
 };
 
 template <class TemplateArray>
@@ -96,6 +116,7 @@ class StepTHnT : public StepTHn
   ~StepTHnT() override = default;
 
   Long64_t Merge(TCollection* list) override;
+  void Reset() override;
 
  protected:
   TArray* createArray(const TArray* src = nullptr) const override
@@ -106,8 +127,13 @@ class StepTHnT : public StepTHn
       return new TemplateArray(*((TemplateArray*)src));
     }
   }
+  TArray* createEmptyArray(Long64_t size) const override
+  {
+    return new TemplateArray(size);
+  }
+  void mergeBlocks(const StepTHnT<TemplateArray>* entry, Int_t step);
 
-  ClassDef(StepTHnT, 1) // THn like container
+  ClassDef(StepTHnT, 2) // THn like container
 };
 
 typedef StepTHnT<TArrayF> StepTHnF;
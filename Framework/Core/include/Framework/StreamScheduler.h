@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_STREAMSCHEDULER_H_
+#define O2_FRAMEWORK_STREAMSCHEDULER_H_
+
+#include "Framework/DataRelayer.h"
+#include "Framework/ServiceHandle.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Work stealing scheduler for the actions which the DataRelayer reports
+/// as ready to be processed. Every stream has its own queue where it puts
+/// whatever it finds ready and which it serves oldest first. A stream whose
+/// queue is empty steals the most recent action from the most loaded of
+/// the other streams, so that a slow timeslice does not keep the rest of
+/// the work hostage while other streams are idle.
+///
+/// Notice that a stream only runs once the ComputingQuotaEvaluator gave it
+/// an offer, so stealing never bypasses the resource accounting.
+class StreamScheduler
+{
+ public:
+  constexpr static ServiceKind service_kind = ServiceKind::Global;
+
+  struct StreamStats {
+    /// Actions executed by this stream
+    uint64_t executed = 0;
+    /// Actions this stream took from somebody else's queue
+    uint64_t steals = 0;
+    /// Total time this stream spent with nothing to do, in nanoseconds
+    uint64_t idleTime = 0;
+  };
+
+  /// Make sure there is a queue for each of the @a nStreams streams.
+  /// Must not be called while streams are running.
+  void resize(size_t nStreams);
+  [[nodiscard]] size_t size() const { return mQueues.size(); }
+
+  /// Enqueue @a actions on the queue owned by @a stream.
+  /// Wait actions are dropped, since there is nothing to do for them.
+  void push(size_t stream, std::vector<DataRelayer::RecordAction> const& actions);
+  /// Retrieve the next action for @a stream. If its own queue is empty and
+  /// @a allowSteal is true, an action is taken from the other streams.
+  /// @return false if there was nothing to do.
+  bool pop(size_t stream, DataRelayer::RecordAction& action, bool allowSteal = true);
+
+  /// @return the total number of queued actions
+  [[nodiscard]] size_t queueDepth() const;
+  /// @return the number of actions queued by @a stream
+  [[nodiscard]] size_t queueDepth(size_t stream) const;
+
+  /// Mark @a stream as idle / busy at time @a now (in ns), in order to
+  /// account for the time it spends doing nothing.
+  void markIdle(size_t stream, uint64_t now);
+  void markBusy(size_t stream, uint64_t now);
+
+  [[nodiscard]] StreamStats stats(size_t stream) const;
+  /// @return the sum of the statistics over all the streams
+  [[nodiscard]] StreamStats totalStats() const;
+
+  /// Drop all the queued actions, e.g. when the relayer is cleared.
+  void clear();
+
+ private:
+  struct Queue {
+    mutable std::mutex mutex;
+    std::deque<DataRelayer::RecordAction> actions;
+    StreamStats stats;
+    uint64_t idleSince = 0;
+  };
+  std::vector<std::unique_ptr<Queue>> mQueues;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_STREAMSCHEDULER_H_
@@ -78,6 +78,12 @@ struct TMessageSerializer {
 
   template <typename T = TObject>
   static inline std::unique_ptr<T> deserialize(FairInputTBuffer& buffer);
+
+  /// Deserialize into @a object, an instance from a previous call. If it has the
+  /// serialized class, the buffer is streamed into it instead of a new allocation,
+  /// otherwise it is replaced by a new instance.
+  template <typename T>
+  static inline void deserializeInto(FairInputTBuffer& buffer, std::unique_ptr<T>& object);
 };
 
 inline void TMessageSerializer::serialize(FairOutputTBuffer& tm, const TObject* input)
@@ -122,6 +128,40 @@ inline std::unique_ptr<T> TMessageSerializer::deserialize(FairInputTBuffer& buff
   return std::unique_ptr<T>(reinterpret_cast<T*>(buffer.ReadObjectAny(serializedClass)));
 }
 
+template <typename T>
+inline void TMessageSerializer::deserializeInto(FairInputTBuffer& buffer, std::unique_ptr<T>& object)
+{
+  TClass* tgtClass = TClass::GetClass(typeid(T));
+  if (tgtClass == nullptr) {
+    throw runtime_error_f("class is not ROOT-serializable: %s", typeid(T).name());
+  }
+  buffer.SetBufferOffset(0);
+  buffer.InitMap();
+  UInt_t tag = 0;
+  TClass* serializedClass = buffer.ReadClass(nullptr, &tag);
+  if (serializedClass == nullptr || serializedClass == (TClass*)-1) {
+    throw runtime_error_f("can not read class info from buffer");
+  }
+  if (tgtClass != serializedClass && serializedClass->GetBaseClass(tgtClass) == nullptr) {
+    throw runtime_error_f("can not convert serialized class %s into target class %s",
+                          serializedClass->GetName(),
+                          tgtClass->GetName());
+  }
+  if (object && tgtClass->GetActualClass(object.get()) == serializedClass) {
+    // the streamer overwrites the members of the existing instance
+    auto offset = serializedClass == tgtClass ? 0 : serializedClass->GetBaseClassOffset(tgtClass);
+    serializedClass->Streamer(reinterpret_cast<char*>(object.get()) - offset, buffer);
+    buffer.CheckByteCount(0, tag, serializedClass);
+    return;
+  }
+  buffer.SetBufferOffset(0);
+  buffer.ResetMap();
+  object.reset(reinterpret_cast<T*>(buffer.ReadObjectAny(tgtClass)));
+  if (object == nullptr) {
+    throw runtime_error_f("Unable to extract class %s", serializedClass->GetName());
+  }
+}
+
 inline void TMessageSerializer::Serialize(fair::mq::Message& msg, const TObject* input)
 {
   FairOutputTBuffer output(msg);
@@ -734,6 +734,19 @@ class TableBuilder
     mDestructor(mHolders);
   }
 
+  /// @return the pool used to allocate the column buffers
+  [[nodiscard]] arrow::MemoryPool* memoryPool() const { return mMemoryPool; }
+  /// Change the pool used to allocate the column buffers. Only
+  /// allowed before any column is created, i.e. before persist()
+  /// or any of the cursor creation methods are invoked.
+  void setMemoryPool(arrow::MemoryPool* pool)
+  {
+    if (mHolders != nullptr) {
+      throw runtime_error("Cannot change the memory pool of a TableBuilder which is already being filled");
+    }
+    mMemoryPool = pool;
+  }
+
   /// Creates a lambda which is suitable to persist things
   /// in an arrow::Table
   template <typename... ARGS, size_t NCOLUMNS = countColumns<ARGS...>()>
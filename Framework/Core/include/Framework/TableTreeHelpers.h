@@ -129,6 +129,8 @@ class TreeToTable
   void addAllColumns(TTree* tree, std::vector<std::string>&& names = {});
   void fill(TTree*);
   std::shared_ptr<arrow::Table> finalize();
+  /// Attach the slicing info of the sorted index columns, see ArrowTableSlicingCache::addGroupIndex
+  void addGroupIndex();
 
  private:
   arrow::MemoryPool* mArrowMemoryPool;
@@ -137,6 +139,8 @@ class TreeToTable
   std::shared_ptr<arrow::Table> mTable;
 
   void addReader(TBranch* branch, std::string const& name, bool VLA);
+  /// Enable a TTreeCache on @a tree, sized for the branches being read.
+  void setupTreeCache(TTree* tree);
 };
 
 // -----------------------------------------------------------------------------
@@ -86,6 +86,10 @@ class TimesliceIndex
   [[nodiscard]] inline bool isValid(TimesliceSlot const& slot) const;
   [[nodiscard]] inline bool isDirty(TimesliceSlot const& slot) const;
   inline void markAsDirty(TimesliceSlot slot, bool value);
+  /// @return the highest dirty slot strictly below @a end, or an invalid
+  /// slot if there is none. Clean slots are skipped a word at a time, so
+  /// that walking all the dirty slots is cheap even for deep pipelines.
+  [[nodiscard]] inline TimesliceSlot findDirtyBefore(size_t end) const;
   inline void markAsInvalid(TimesliceSlot slot);
   /// Mark all the cachelines as invalid, e.g. due to an out of band event
   inline void rescan();
@@ -147,8 +151,9 @@ class TimesliceIndex
   std::vector<data_matcher::VariableContext> mPublishedVariables;
 
   /// This keeps track whether or not something was relayed
-  /// since last time we called getReadyToProcess()
-  std::vector<bool> mDirty;
+  /// since last time we called getReadyToProcess(). One bit per slot,
+  /// bits beyond the last slot are always kept to zero.
+  std::vector<uint64_t> mDirty;
 
   /// This is the oldest possible timeslice for any given channel
   /// The cardinality of this vector is the number of input channels
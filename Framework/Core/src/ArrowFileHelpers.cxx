@@ -0,0 +1,164 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/RuntimeError.h"
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+
+namespace fs = std::filesystem;
+
+namespace o2::framework
+{
+
+bool ArrowFileHelpers::isArrowAOD(std::string const& path)
+{
+  std::error_code ec;
+  return fs::is_directory(path, ec);
+}
+
+std::string ArrowFileHelpers::tablePath(std::string const& directory, std::string const& folderName, std::string const& treename)
+{
+  return directory + "/" + folderName + "/" + treename + extension;
+}
+
+std::vector<uint64_t> ArrowFileHelpers::listDataFrames(std::string const& directory)
+{
+  static std::regex const dfRegex("DF_[0-9]+");
+  std::vector<uint64_t> result;
+  for (auto const& entry : fs::directory_iterator(directory)) {
+    auto name = entry.path().filename().string();
+    if (entry.is_directory() && std::regex_match(name, dfRegex)) {
+      result.push_back(std::stoull(name.substr(3)));
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void ArrowFileHelpers::writeTable(std::shared_ptr<arrow::Table> const& table, std::string const& filename)
+{
+  auto parent = fs::path(filename).parent_path();
+  if (!parent.empty()) {
+    fs::create_directories(parent);
+  }
+  auto stream = arrow::io::FileOutputStream::Open(filename);
+  if (!stream.ok()) {
+    throw runtime_error_f("Unable to open %s: %s", filename.c_str(), stream.status().ToString().c_str());
+  }
+  auto writer = arrow::ipc::MakeFileWriter(*stream, table->schema());
+  if (!writer.ok()) {
+    throw runtime_error_f("Unable to create writer for %s: %s", filename.c_str(), writer.status().ToString().c_str());
+  }
+  arrow::Status status;
+  if (table->num_rows() != 0) {
+    status = (*writer)->WriteTable(*table);
+  } else {
+    // Always write one batch, so that readers get columns with one chunk.
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    for (auto const& field : table->schema()->fields()) {
+      columns.push_back(arrow::MakeEmptyArray(field->type()).ValueOrDie());
+    }
+    status = (*writer)->WriteRecordBatch(*arrow::RecordBatch::Make(table->schema(), 0, columns));
+  }
+  if (status.ok()) {
+    status = (*writer)->Close();
+  }
+  if (status.ok()) {
+    status = (*stream)->Close();
+  }
+  if (!status.ok()) {
+    throw runtime_error_f("Unable to write %s: %s", filename.c_str(), status.ToString().c_str());
+  }
+}
+
+std::shared_ptr<arrow::Table> ArrowFileHelpers::readTable(std::string const& filename, std::vector<std::string> const& columns)
+{
+  auto file = arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ);
+  if (!file.ok()) {
+    throw runtime_error_f("Unable to map %s: %s", filename.c_str(), file.status().ToString().c_str());
+  }
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+  if (!reader.ok()) {
+    throw runtime_error_f("Unable to read %s: %s", filename.c_str(), reader.status().ToString().c_str());
+  }
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int bi = 0; bi < (*reader)->num_record_batches(); ++bi) {
+    auto batch = (*reader)->ReadRecordBatch(bi);
+    if (!batch.ok()) {
+      throw runtime_error_f("Unable to read batch %d of %s: %s", bi, filename.c_str(), batch.status().ToString().c_str());
+    }
+    batches.push_back(*batch);
+  }
+  auto table = arrow::Table::FromRecordBatches((*reader)->schema(), batches);
+  if (!table.ok()) {
+    throw runtime_error_f("Unable to create table from %s: %s", filename.c_str(), table.status().ToString().c_str());
+  }
+  if (columns.empty()) {
+    return *table;
+  }
+  std::vector<int> indices;
+  for (auto const& column : columns) {
+    auto idx = (*table)->schema()->GetFieldIndex(column);
+    if (idx == -1) {
+      throw runtime_error_f("Column %s not found in %s", column.c_str(), filename.c_str());
+    }
+    indices.push_back(idx);
+  }
+  return (*table)->SelectColumns(indices).ValueOrDie();
+}
+
+void ArrowFileHelpers::writeMap(StringMap const& map, std::string const& filename)
+{
+  arrow::StringBuilder keys;
+  arrow::StringBuilder values;
+  for (auto const& [key, value] : map) {
+    if (!keys.Append(key).ok() || !values.Append(value).ok()) {
+      throw runtime_error_f("Unable to fill %s", filename.c_str());
+    }
+  }
+  std::shared_ptr<arrow::Array> keyArray;
+  std::shared_ptr<arrow::Array> valueArray;
+  if (!keys.Finish(&keyArray).ok() || !values.Finish(&valueArray).ok()) {
+    throw runtime_error_f("Unable to fill %s", filename.c_str());
+  }
+  auto schema = arrow::schema({arrow::field("key", arrow::utf8()), arrow::field("value", arrow::utf8())});
+  writeTable(arrow::Table::Make(schema, {keyArray, valueArray}), filename);
+}
+
+ArrowFileHelpers::StringMap ArrowFileHelpers::readMap(std::string const& filename)
+{
+  StringMap result;
+  std::error_code ec;
+  if (!fs::exists(filename, ec)) {
+    return result;
+  }
+  auto table = readTable(filename, {"key", "value"});
+  for (int ci = 0; ci < table->column(0)->num_chunks(); ++ci) {
+    auto keys = std::static_pointer_cast<arrow::StringArray>(table->column(0)->chunk(ci));
+    auto values = std::static_pointer_cast<arrow::StringArray>(table->column(1)->chunk(ci));
+    for (int64_t ri = 0; ri < keys->length(); ++ri) {
+      result.emplace_back(keys->GetString(ri), values->GetString(ri));
+    }
+  }
+  return result;
+}
+
+} // namespace o2::framework
@@ -12,12 +12,55 @@
 #include "Framework/ArrowTableSlicingCache.h"
 #include "Framework/RuntimeError.h"
 
+#include <arrow/buffer.h>
 #include <arrow/compute/api_aggregate.h>
 #include <arrow/compute/kernel.h>
 #include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
 
 namespace o2::framework
 {
+namespace
+{
+// Run length encoding of a sorted index column, which gives the same result as
+// value_counts. Returns false if the column is not sorted as validateOrder expects.
+bool makeGroups(std::shared_ptr<arrow::ChunkedArray> const& column, std::vector<int32_t>& groupValues, std::vector<int64_t>& groupCounts)
+{
+  int32_t lastPos = -1;
+  int32_t lastNeg = 0;
+  for (auto iChunk = 0; iChunk < column->num_chunks(); ++iChunk) {
+    auto chunk = static_cast<arrow::NumericArray<arrow::Int32Type>>(column->chunk(iChunk)->data());
+    for (auto iElement = 0; iElement < chunk.length(); ++iElement) {
+      auto v = chunk.Value(iElement);
+      if (!groupValues.empty() && groupValues.back() == v) {
+        ++groupCounts.back();
+        continue;
+      }
+      // a new group, which must not have been seen before
+      if (v >= 0) {
+        if (v <= lastPos) {
+          return false;
+        }
+        lastPos = v;
+      } else {
+        if (v >= lastNeg) {
+          return false;
+        }
+        lastNeg = v;
+      }
+      groupValues.push_back(v);
+      groupCounts.push_back(1);
+    }
+  }
+  return true;
+}
+
+template <typename T>
+std::string asBytes(std::vector<T> const& v)
+{
+  return {reinterpret_cast<char const*>(v.data()), v.size() * sizeof(T)};
+}
+} // namespace
 
 void updatePairList(std::vector<StringPair>& list, std::string const& binding, std::string const& key)
 {
@@ -107,6 +150,23 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<
     counts[pos].reset();
     return arrow::Status::OK();
   }
+  values[pos].reset();
+  counts[pos].reset();
+  // use the precomputed slicing info, if the producer provided it
+  auto field = table->schema()->GetFieldByName(bindingsKeys[pos].second);
+  if (field != nullptr && field->HasMetadata()) {
+    auto const& metadata = field->metadata();
+    auto rows = metadata->Get(groupRowsKey);
+    if (rows.ok() && std::stoll(*rows) == table->num_rows()) {
+      auto v = metadata->Get(groupValuesKey).ValueOrDie();
+      auto c = metadata->Get(groupCountsKey).ValueOrDie();
+      auto nv = v.size() / sizeof(int32_t);
+      auto nc = c.size() / sizeof(int64_t);
+      values[pos] = std::make_shared<arrow::NumericArray<arrow::Int32Type>>(nv, arrow::Buffer::FromString(std::move(v)));
+      counts[pos] = std::make_shared<arrow::NumericArray<arrow::Int64Type>>(nc, arrow::Buffer::FromString(std::move(c)));
+      return arrow::Status::OK();
+    }
+  }
   validateOrder(bindingsKeys[pos], table);
   arrow::Datum value_counts;
   auto options = arrow::compute::ScalarAggregateOptions::Defaults();
@@ -114,8 +174,6 @@ arrow::Status ArrowTableSlicingCache::updateCacheEntry(int pos, std::shared_ptr<
                         arrow::compute::CallFunction("value_counts", {table->GetColumnByName(bindingsKeys[pos].second)},
                                                      &options));
   auto pair = static_cast<arrow::StructArray>(value_counts.array());
-  values[pos].reset();
-  counts[pos].reset();
   values[pos] = std::make_shared<arrow::NumericArray<arrow::Int32Type>>(pair.field(0)->data());
   counts[pos] = std::make_shared<arrow::NumericArray<arrow::Int64Type>>(pair.field(1)->data());
   return arrow::Status::OK();
@@ -224,6 +282,40 @@ SliceInfoUnsortedPtr ArrowTableSlicingCache::getCacheUnsortedForPos(int pos) con
   };
 }
 
+std::shared_ptr<arrow::Table> ArrowTableSlicingCache::addGroupIndex(std::shared_ptr<arrow::Table> const& table)
+{
+  if (table->num_rows() == 0) {
+    return table;
+  }
+  auto fields = table->schema()->fields();
+  bool changed = false;
+  for (auto i = 0U; i < fields.size(); ++i) {
+    auto const& field = fields[i];
+    if (field->type()->id() != arrow::Type::INT32 || field->name().rfind("fIndex", 0) != 0) {
+      continue;
+    }
+    if (field->HasMetadata() && field->metadata()->Contains(groupRowsKey)) {
+      continue;
+    }
+    std::vector<int32_t> groupValues;
+    std::vector<int64_t> groupCounts;
+    // unsorted columns are left to updateCacheEntryUnsorted
+    if (!makeGroups(table->column(i), groupValues, groupCounts)) {
+      continue;
+    }
+    auto metadata = field->HasMetadata() ? field->metadata()->Copy() : std::make_shared<arrow::KeyValueMetadata>();
+    metadata->Append(groupValuesKey, asBytes(groupValues));
+    metadata->Append(groupCountsKey, asBytes(groupCounts));
+    metadata->Append(groupRowsKey, std::to_string(table->num_rows()));
+    fields[i] = field->WithMetadata(metadata);
+    changed = true;
+  }
+  if (!changed) {
+    return table;
+  }
+  return arrow::Table::Make(arrow::schema(fields, table->schema()->metadata()), table->columns(), table->num_rows());
+}
+
 void ArrowTableSlicingCache::validateOrder(StringPair const& bindingKey, const std::shared_ptr<arrow::Table>& input)
 {
   auto const& [target, key] = bindingKey;
@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/BackgroundWriter.h"
+
+namespace o2::framework
+{
+
+BackgroundWriter::BackgroundWriter(size_t depth)
+  : mDepth{depth > 0 ? depth : 1}
+{
+  mThread = std::thread(&BackgroundWriter::run, this);
+}
+
+BackgroundWriter::~BackgroundWriter()
+{
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this] { return mTasks.empty() && !mBusy; });
+    mStop = true;
+  }
+  mCondition.notify_all();
+  mThread.join();
+}
+
+void BackgroundWriter::push(Task task)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondition.wait(lock, [this] { return mTasks.size() + (mBusy ? 1 : 0) < mDepth || mError; });
+  rethrowPendingError();
+  mTasks.push_back(std::move(task));
+  mCondition.notify_all();
+}
+
+void BackgroundWriter::drain()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mCondition.wait(lock, [this] { return (mTasks.empty() && !mBusy) || mError; });
+  rethrowPendingError();
+}
+
+void BackgroundWriter::rethrowPendingError()
+{
+  if (mError) {
+    auto error = mError;
+    mError = nullptr;
+    mTasks.clear();
+    std::rethrow_exception(error);
+  }
+}
+
+void BackgroundWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mCondition.wait(lock, [this] { return !mTasks.empty() || mStop; });
+    if (mTasks.empty()) {
+      return;
+    }
+    auto task = std::move(mTasks.front());
+    mTasks.pop_front();
+    mBusy = true;
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    mBusy = false;
+    if (error && !mError) {
+      mError = error;
+    }
+    mCondition.notify_all();
+  }
+}
+
+} // namespace o2::framework
@@ -11,6 +11,7 @@
 #include "Framework/CommonDataProcessors.h"
 
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/BackgroundWriter.h"
 #include "Framework/CallbackService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
@@ -33,6 +34,10 @@
 #include "../../../Algorithm/include/Algorithm/HeaderStack.h"
 #include "Framework/OutputObjHeader.h"
 #include "Framework/TableTreeHelpers.h"
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/ArrowTableSlicingCache.h"
+#include "Framework/AnalysisDataModelHelpers.h"
+#include "Framework/DerivedTableCache.h"
 #include "Framework/StringHelpers.h"
 #include "Framework/ChannelSpec.h"
 #include "Framework/ChannelSpecHelpers.h"
@@ -51,9 +56,11 @@
 
 #include <fairmq/Device.h>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
 #include <thread>
 
@@ -310,8 +317,19 @@ DataProcessorSpec
       };
     }
 
+    // with a queue depth > 0 the tables are written by a background thread,
+    // which then owns all the operations on the output files
+    std::shared_ptr<BackgroundWriter> backgroundWriter;
+    if (dod->getWriterQueueDepth() > 0) {
+      LOGP(info, "AOD tables are written in the background, up to {} time frames are queued", dod->getWriterQueueDepth());
+      backgroundWriter = std::make_shared<BackgroundWriter>(dod->getWriterQueueDepth());
+    }
+
     // end of data functor is called at the end of the data stream
-    auto endofdatacb = [dod](EndOfStreamContext& context) {
+    auto endofdatacb = [dod, backgroundWriter](EndOfStreamContext& context) {
+      if (backgroundWriter) {
+        backgroundWriter->drain();
+      }
       dod->closeDataFiles();
       context.services().get<ControlService>().readyToQuit(QuitRequest::Me);
     };
@@ -326,8 +344,101 @@ DataProcessorSpec
     std::vector<TString> aodMetaDataKeys;
     std::vector<TString> aodMetaDataVals;
 
+    // a table of the current time frame to be written with the descriptors ds.
+    // When written in the background the message payload does not outlive the
+    // processing callback, hence the table is then read from a copy.
+    struct PendingTable {
+      std::string tableName;
+      std::vector<DataOutputDescriptor*> ds;
+      uint64_t tfNumber;
+      std::string aodInputFile;
+      std::shared_ptr<TableConsumer> consumer;
+      std::shared_ptr<std::vector<uint8_t>> payload;
+    };
+
+    // write the tables of one time frame, needs exclusive access to the output files
+    auto writeTables = [dod](std::vector<PendingTable> const& pending, std::vector<TString> const& aodMetaDataKeys, std::vector<TString> const& aodMetaDataVals) {
+      // close all output files if one has reached size limit
+      dod->checkFileSizes();
+
+      for (auto const& pt : pending) {
+        auto const& tableName = pt.tableName;
+        auto tfNumber = pt.tfNumber;
+        auto const& aodInputFile = pt.aodInputFile;
+        auto table = pt.consumer->asArrowTable();
+        if (!table->Validate().ok()) {
+          LOGP(warning, "The table \"{}\" is not valid and will not be saved!", tableName);
+          continue;
+        }
+        if (table->schema()->fields().empty()) {
+          LOGP(debug, "The table \"{}\" is empty but will be saved anyway!", tableName);
+        }
+
+        // loop over all DataOutputDescriptors
+        // a table can be saved in multiple ways
+        // e.g. different selections of columns to different files
+        for (auto d : pt.ds) {
+          if (dod->getFileFormat() == "arrow") {
+            auto filename = dod->getArrowFilename(d, tfNumber, aodInputFile);
+            auto metaDataFilename = std::filesystem::path(filename).parent_path().parent_path() / ArrowFileHelpers::metaDataName;
+            if (!aodMetaDataKeys.empty() && !aodMetaDataVals.empty() && !std::filesystem::exists(metaDataFilename)) {
+              ArrowFileHelpers::StringMap aodMetaDataMap;
+              for (uint32_t imd = 0; imd < aodMetaDataKeys.size(); imd++) {
+                aodMetaDataMap.emplace_back(aodMetaDataKeys[imd].Data(), aodMetaDataVals[imd].Data());
+              }
+              ArrowFileHelpers::writeMap(aodMetaDataMap, metaDataFilename.string());
+            }
+            auto toWrite = table;
+            if (!d->colnames.empty()) {
+              std::vector<int> indices;
+              for (auto& cn : d->colnames) {
+                auto idx = table->schema()->GetFieldIndex(cn);
+                if (idx != -1) {
+                  indices.push_back(idx);
+                }
+              }
+              toWrite = table->SelectColumns(indices).ValueOrDie();
+            }
+            // store the slicing info with the table, so that it is not recomputed by the readers
+            ArrowFileHelpers::writeTable(ArrowTableSlicingCache::addGroupIndex(toWrite), filename);
+            continue;
+          }
+          auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile);
+          auto treename = fileAndFolder.folderName + "/" + d->treename;
+          TableToTree ta2tr(table,
+                            fileAndFolder.file,
+                            treename.c_str());
+
+          // update metadata
+          if (fileAndFolder.file->FindObjectAny("metaData")) {
+            LOGF(debug, "Metadata: target file %s already has metadata, preserving it", fileAndFolder.file->GetName());
+          } else if (!aodMetaDataKeys.empty() && !aodMetaDataVals.empty()) {
+            TMap aodMetaDataMap;
+            for (uint32_t imd = 0; imd < aodMetaDataKeys.size(); imd++) {
+              aodMetaDataMap.Add(new TObjString(aodMetaDataKeys[imd]), new TObjString(aodMetaDataVals[imd]));
+            }
+            fileAndFolder.file->WriteObject(&aodMetaDataMap, "metaData", "Overwrite");
+          }
+
+          if (!d->colnames.empty()) {
+            for (auto& cn : d->colnames) {
+              auto idx = table->schema()->GetFieldIndex(cn);
+              auto col = table->column(idx);
+              auto field = table->schema()->field(idx);
+              if (idx != -1) {
+                ta2tr.addBranch(col, field);
+              }
+            }
+          } else {
+            ta2tr.addAllBranches();
+          }
+          ta2tr.process();
+        }
+      }
+    };
+
     // this functor is called once per time frame
-    return [dod, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals](ProcessingContext& pc) mutable -> void {
+    return [dod, backgroundWriter, writeTables, tfNumbers, tfFilenames, aodMetaDataKeys, aodMetaDataVals](ProcessingContext& pc) mutable -> void {
       LOGP(debug, "======== getGlobalAODSink::processing ==========");
       LOGP(debug, " processing data set with {} entries", pc.inputs().size());
 
@@ -355,10 +466,8 @@ DataProcessorSpec
         tfFilenames.insert(std::pair<uint64_t, std::string>(startTime, aodInputFile));
       }
 
-      // close all output files if one has reached size limit
-      dod->checkFileSizes();
-
       // loop over the DataRefs which are contained in pc.inputs()
+      std::vector<PendingTable> pending;
       for (const auto& ref : pc.inputs()) {
         if (!ref.spec) {
           LOGP(debug, "Invalid input will be skipped!");
@@ -407,51 +516,24 @@ DataProcessorSpec
           LOGP(error, "No header for message {}:{}", ref.spec->binding, DataSpecUtils::describe(*ref.spec));
           continue;
         }
-        auto s = pc.inputs().get<TableConsumer>(ref.spec->binding);
-        auto table = s->asArrowTable();
-        if (!table->Validate().ok()) {
-          LOGP(warning, "The table \"{}\" is not valid and will not be saved!", tableName);
-          continue;
-        }
-        if (table->schema()->fields().empty()) {
-          LOGP(debug, "The table \"{}\" is empty but will be saved anyway!", tableName);
+        PendingTable pt{tableName, ds, tfNumber, aodInputFile, nullptr, nullptr};
+        if (backgroundWriter) {
+          auto data = reinterpret_cast<uint8_t const*>(msg.payload);
+          pt.payload = std::make_shared<std::vector<uint8_t>>(data, data + DataRefUtils::getPayloadSize(msg));
+          pt.consumer = std::make_shared<TableConsumer>(pt.payload->data(), pt.payload->size());
+        } else {
+          pt.consumer = pc.inputs().get<TableConsumer>(ref.spec->binding);
         }
+        pending.emplace_back(std::move(pt));
+      }
 
-        // loop over all DataOutputDescriptors
-        // a table can be saved in multiple ways
-        // e.g. different selections of columns to different files
-        for (auto d : ds) {
-          auto fileAndFolder = dod->getFileFolder(d, tfNumber, aodInputFile);
-          auto treename = fileAndFolder.folderName + "/" + d->treename;
-          TableToTree ta2tr(table,
-                            fileAndFolder.file,
-                            treename.c_str());
-
-          // update metadata
-          if (fileAndFolder.file->FindObjectAny("metaData")) {
-            LOGF(debug, "Metadata: target file %s already has metadata, preserving it", fileAndFolder.file->GetName());
-          } else if (!aodMetaDataKeys.empty() && !aodMetaDataVals.empty()) {
-            TMap aodMetaDataMap;
-            for (uint32_t imd = 0; imd < aodMetaDataKeys.size(); imd++) {
-              aodMetaDataMap.Add(new TObjString(aodMetaDataKeys[imd]), new TObjString(aodMetaDataVals[imd]));
-            }
-            fileAndFolder.file->WriteObject(&aodMetaDataMap, "metaData", "Overwrite");
-          }
-
-          if (!d->colnames.empty()) {
-            for (auto& cn : d->colnames) {
-              auto idx = table->schema()->GetFieldIndex(cn);
-              auto col = table->column(idx);
-              auto field = table->schema()->field(idx);
-              if (idx != -1) {
-                ta2tr.addBranch(col, field);
-              }
-            }
-          } else {
-            ta2tr.addAllBranches();
-          }
-          ta2tr.process();
-        }
+      if (backgroundWriter) {
+        // blocks while the queue is full, which throttles the upstream devices
+        backgroundWriter->push([writeTables, pending = std::move(pending), aodMetaDataKeys, aodMetaDataVals]() {
+          writeTables(pending, aodMetaDataKeys, aodMetaDataVals);
+        });
+      } else {
+        writeTables(pending, aodMetaDataKeys, aodMetaDataVals);
       }
     };
   }; // end of writerFunction
@@ -468,6 +550,61 @@ DataProcessorSpec
   return spec;
 }
 
+DataProcessorSpec CommonDataProcessors::getDerivedTableCacheSink(std::string const& cacheDir, std::vector<DerivedTableCacheEntry> const& entries)
+{
+  // one binding per cached table, associated to the hash of its producer
+  std::vector<InputSpec> inputs;
+  std::vector<std::string> hashes;
+  for (auto const& entry : entries) {
+    for (auto const& output : entry.outputs) {
+      auto input = DataSpecUtils::matchingInput(output);
+      input.binding = fmt::format("cache_{}", hashes.size());
+      inputs.emplace_back(input);
+      hashes.emplace_back(entry.hash);
+    }
+  }
+  auto nTables = hashes.size();
+  inputs.emplace_back(InputSpec{"tfn", "TFN", "TFNumber"});
+  inputs.emplace_back(InputSpec{"tff", "TFF", "TFFilename"});
+
+  auto writerFunction = [cacheDir, hashes, nTables](InitContext& ic) -> std::function<void(ProcessingContext&)> {
+    // the entries which were written, marked complete at the end of the stream
+    auto written = std::make_shared<std::set<std::string>>();
+    auto endofdatacb = [written](EndOfStreamContext& context) {
+      for (auto const& entry : *written) {
+        DerivedTableCache::markComplete(entry);
+      }
+      LOGP(info, "Stored {} entries in the derived table cache", written->size());
+      context.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+    };
+    ic.services().get<CallbackService>().set<CallbackService::Id::EndOfStream>(endofdatacb);
+
+    return [cacheDir, hashes, nTables, written](ProcessingContext& pc) -> void {
+      auto tfNumber = pc.inputs().get<uint64_t>("tfn");
+      auto inputFile = pc.inputs().get<std::string>("tff");
+      auto folderName = fmt::format("DF_{}", tfNumber);
+      for (size_t ti = 0; ti < nTables; ++ti) {
+        auto binding = fmt::format("cache_{}", ti);
+        auto ref = pc.inputs().get(binding.c_str());
+        if (ref.header == nullptr) {
+          continue;
+        }
+        auto dh = DataRefUtils::getHeader<header::DataHeader*>(ref);
+        auto table = pc.inputs().get<TableConsumer>(binding.c_str())->asArrowTable();
+        auto entry = DerivedTableCache::entryPath(cacheDir, hashes[ti], inputFile);
+        ArrowFileHelpers::writeTable(ArrowTableSlicingCache::addGroupIndex(table), ArrowFileHelpers::tablePath(entry, folderName, o2::aod::datamodel::getTreeName(*dh)));
+        written->insert(entry);
+      }
+    };
+  };
+
+  return DataProcessorSpec{
+    .name = "internal-dpl-aod-derived-cache-writer",
+    .inputs = inputs,
+    .algorithm = AlgorithmSpec(writerFunction),
+  };
+}
+
 DataProcessorSpec
   CommonDataProcessors::getGlobalFileSink(std::vector<InputSpec> const& danglingOutputInputs,
                                           std::vector<InputSpec>& unmatched)
@@ -20,6 +20,8 @@
 #include "Framework/Tracing.h"
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceInfo.h"
+#include "Framework/DataProcessingStats.h"
+#include "Framework/Logger.h"
 
 #include "CommonMessageBackendsHelpers.h"
 
@@ -31,7 +33,12 @@
 
 #include <uv.h>
 #include <boost/program_options/variables_map.hpp>
+#include <chrono>
 #include <csignal>
+#include <execinfo.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
 // This is to allow C++20 aggregate initialisation
 #pragma GCC diagnostic push
@@ -43,6 +50,60 @@ namespace o2::framework
 class EndOfStreamContext;
 class ProcessingContext;
 
+namespace
+{
+constexpr size_t MAX_CHANNEL_MEMORY_METRICS = 256;
+
+/// Publish what the containers created by the last computation allocated. The interval of
+/// the accounting restarts after each computation, so the peak is the one of its callback.
+void publishMemoryAccounting(DataProcessingStats& stats, MessageContext& context)
+{
+  size_t allocations = 0;
+  size_t allocatedBytes = 0;
+  size_t heldBytes = 0;
+  size_t peakHeldBytes = 0;
+  for (auto& [channel, channelStats] : context.accountingStats(true)) {
+    allocations += channelStats.allocations;
+    allocatedBytes += channelStats.allocatedBytes;
+    heldBytes += channelStats.heldBytes;
+    // The channels do not peak at the same time, so this is an upper bound.
+    peakHeldBytes += channelStats.peakHeldBytes;
+    if (channel >= 0 && (size_t)channel < MAX_CHANNEL_MEMORY_METRICS) {
+      stats.updateStats({(unsigned short)((int)ProcessingStatsId::MEMORY_HELD_BYTES_BASE + channel), DataProcessingStats::Op::Set, (int64_t)channelStats.heldBytes});
+    }
+  }
+  stats.updateStats({(int)ProcessingStatsId::MEMORY_ALLOCATIONS, DataProcessingStats::Op::Set, (int64_t)allocations});
+  stats.updateStats({(int)ProcessingStatsId::MEMORY_ALLOCATED_BYTES, DataProcessingStats::Op::Set, (int64_t)allocatedBytes});
+  stats.updateStats({(int)ProcessingStatsId::MEMORY_HELD_BYTES, DataProcessingStats::Op::Set, (int64_t)heldBytes});
+  stats.updateStats({(int)ProcessingStatsId::MEMORY_PEAK_HELD_BYTES, DataProcessingStats::Op::Set, (int64_t)peakHeldBytes});
+
+  // Walking the malloc arenas and symbolising the allocation sites is
+  // too expensive to be done for every computation.
+  static auto lastHeapReport = std::chrono::steady_clock::now();
+  static auto lastSitesReport = std::chrono::steady_clock::now();
+  auto now = std::chrono::steady_clock::now();
+  if (now - lastHeapReport > std::chrono::seconds(1)) {
+    lastHeapReport = now;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    stats.updateStats({(int)ProcessingStatsId::MALLOC_IN_USE_BYTES, DataProcessingStats::Op::Set, (int64_t)mallinfo2().uordblks});
+#endif
+  }
+  if (now - lastSitesReport > std::chrono::seconds(60)) {
+    lastSitesReport = now;
+    auto sites = context.topAllocationSites(5);
+    for (size_t si = 0; si < sites.size(); ++si) {
+      auto& site = sites[si];
+      LOGP(info, "Top allocation site #{}: {} sampled allocations, {} bytes", si, site.allocations, site.bytes);
+      char** symbols = backtrace_symbols(site.frames.data(), site.nFrames);
+      for (int fi = 0; symbols && fi < site.nFrames; ++fi) {
+        LOGP(info, "    {}", symbols[fi]);
+      }
+      free(symbols);
+    }
+  }
+}
+} // namespace
+
 o2::framework::ServiceSpec CommonMessageBackends::fairMQDeviceProxy()
 {
   return ServiceSpec{
@@ -61,7 +122,27 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQDeviceProxy()
       /// some of the channels are added only later on to the party,
       /// (e.g. by ECS) and Init might not be late enough to
       /// account for them.
-      proxy->bind(outputs, inputs, forwards, *device); },
+      proxy->bind(outputs, inputs, forwards, *device);
+      static bool useAccounting = getenv("DPL_MEMORY_ACCOUNTING") && atoi(getenv("DPL_MEMORY_ACCOUNTING"));
+      if (!useAccounting) {
+        return;
+      }
+      // One metric per output channel with the memory held by its containers.
+      auto& stats = services.get<DataProcessingStats>();
+      for (size_t ci = 0; ci < std::min(proxy->getNumOutputChannels(), MAX_CHANNEL_MEMORY_METRICS); ++ci) {
+        int metricId = (int)ProcessingStatsId::MEMORY_HELD_BYTES_BASE + ci;
+        if (stats.metricSpecs[metricId].name.empty() == false) {
+          continue;
+        }
+        stats.registerMetric(DataProcessingStats::MetricSpec{
+          .name = fmt::format("memory-held-bytes/{}", proxy->getOutputChannelInfo(ChannelIndex{(int)ci}).name),
+          .metricId = metricId,
+          .kind = DataProcessingStats::Kind::UInt64,
+          .scope = DataProcessingStats::Scope::DPL,
+          .minPublishInterval = 1000,
+          .maxRefreshLatency = 10000,
+          .sendInitialValue = true});
+      } },
   };
 }
 
@@ -94,7 +175,21 @@ o2::framework::ServiceSpec CommonMessageBackends::fairMQBackendSpec()
     },
     .configure = CommonServices::noConfiguration(),
     .preProcessing = CommonMessageBackendsHelpers<MessageContext>::clearContext(),
-    .postProcessing = CommonMessageBackendsHelpers<MessageContext>::sendCallback(),
+    .postProcessing = [](ProcessingContext& ctx, void* service) {
+      auto* context = reinterpret_cast<MessageContext*>(service);
+      DataProcessor::doSend(ctx.services().get<DataSender>(), *context, ctx.services());
+      static bool useSlabs = getenv("DPL_SLAB_ALLOCATOR") && atoi(getenv("DPL_SLAB_ALLOCATOR"));
+      if (useSlabs) {
+        auto slabStats = context->slabStats();
+        auto& stats = ctx.services().get<DataProcessingStats>();
+        stats.updateStats({(int)ProcessingStatsId::SLAB_ALLOCATIONS, DataProcessingStats::Op::Set, (int64_t)slabStats.allocations});
+        stats.updateStats({(int)ProcessingStatsId::SLAB_REUSED, DataProcessingStats::Op::Set, (int64_t)slabStats.reused});
+        stats.updateStats({(int)ProcessingStatsId::SLAB_CACHED_BYTES, DataProcessingStats::Op::Set, (int64_t)slabStats.cachedBytes});
+      }
+      static bool useAccounting = getenv("DPL_MEMORY_ACCOUNTING") && atoi(getenv("DPL_MEMORY_ACCOUNTING"));
+      if (useAccounting) {
+        publishMemoryAccounting(ctx.services().get<DataProcessingStats>(), *context);
+      } },
     .preEOS = CommonMessageBackendsHelpers<MessageContext>::clearContextEOS(),
     .postEOS = CommonMessageBackendsHelpers<MessageContext>::sendCallbackEOS(),
     .kind = ServiceKind::Stream};
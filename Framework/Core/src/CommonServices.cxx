@@ -26,10 +26,12 @@
 #include "Framework/DataProcessingStats.h"
 #include "Framework/DataProcessingStates.h"
 #include "Framework/TimingHelpers.h"
+#include "Framework/ObjectPool.h"
 #include "Framework/CommonMessageBackends.h"
 #include "Framework/DanglingContext.h"
 #include "Framework/DataProcessingHelpers.h"
 #include "InputRouteHelpers.h"
+#include "NumaHelpers.h"
 #include "Framework/EndOfStreamContext.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -40,6 +42,7 @@
 #include "Framework/DeviceContext.h"
 #include "Framework/DataProcessingContext.h"
 #include "Framework/StreamContext.h"
+#include "Framework/StreamScheduler.h"
 #include "Framework/DeviceState.h"
 #include "Framework/DeviceConfig.h"
 #include "Framework/DefaultsHelpers.h"
@@ -66,8 +69,10 @@
 #include <fairmq/ProgOptions.h>
 #include <uv.h>
 
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 
 using o2::configuration::ConfigurationFactory;
 using o2::configuration::ConfigurationInterface;
@@ -426,6 +431,15 @@ o2::framework::ServiceSpec CommonServices::dataRelayer()
     .kind = ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::streamSchedulerSpec()
+{
+  return ServiceSpec{
+    .name = "stream-scheduler",
+    .init = simpleServiceInit<StreamScheduler, StreamScheduler>(),
+    .configure = noConfiguration(),
+    .kind = ServiceKind::Global};
+}
+
 o2::framework::ServiceSpec CommonServices::dataSender()
 {
   return ServiceSpec{
@@ -768,6 +782,20 @@ auto sendRelayerMetrics(ServiceRegistryRef registry, DataProcessingStats& stats)
 
   stats.updateStats({static_cast<short>(ProcessingStatsId::TOTAL_RATE_IN_MB_S), DataProcessingStats::Op::InstantaneousRate, totalBytesIn / 1000000});
   stats.updateStats({static_cast<short>(ProcessingStatsId::TOTAL_RATE_OUT_MB_S), DataProcessingStats::Op::InstantaneousRate, totalBytesOut / 1000000});
+
+  // Memory of a device bound to a NUMA node which ended up on the other ones,
+  // e.g. because the node was full or because it was allocated by another
+  // process. Walking the mappings is expensive, so only every 10 seconds.
+  auto& state = registry.get<DeviceState>();
+  static auto lastNumaReport = std::chrono::steady_clock::now();
+  auto now = std::chrono::steady_clock::now();
+  if (state.numaNode >= 0 && now - lastNumaReport > std::chrono::seconds(10)) {
+    lastNumaReport = now;
+    std::ifstream maps("/proc/self/numa_maps");
+    auto placement = NumaHelpers::parseNumaMaps(maps, state.numaNode);
+    stats.updateStats({static_cast<short>(ProcessingStatsId::NUMA_LOCAL_BYTES), DataProcessingStats::Op::Set, (int64_t)placement.localBytes});
+    stats.updateStats({static_cast<short>(ProcessingStatsId::NUMA_REMOTE_BYTES), DataProcessingStats::Op::Set, (int64_t)placement.remoteBytes});
+  }
 };
 
 auto flushStates(ServiceRegistryRef registry, DataProcessingStates& states) -> void
@@ -1060,6 +1088,149 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
                    .minPublishInterval = 1000,
                    .maxRefreshLatency = 1000,
                    .sendInitialValue = true},
+        MetricSpec{.name = "scheduler-queue-depth",
+                   .enabled = enableDebugMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::SCHEDULER_QUEUE_DEPTH),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 1000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "scheduler-steals",
+                   .enabled = enableDebugMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::SCHEDULER_STEALS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 1000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "scheduler-idle-time-ms",
+                   .enabled = enableDebugMetrics,
+                   .metricId = static_cast<short>(ProcessingStatsId::SCHEDULER_IDLE_TIME_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 1000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "rate-limiter-window",
+                   .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMITER_WINDOW),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "rate-limiter-latency-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMITER_LATENCY_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "rate-limiter-base-latency-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMITER_BASE_LATENCY_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "slab-allocations",
+                   .metricId = static_cast<short>(ProcessingStatsId::SLAB_ALLOCATIONS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "slab-reused",
+                   .metricId = static_cast<short>(ProcessingStatsId::SLAB_REUSED),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "slab-cached-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::SLAB_CACHED_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "relayer-completion-time-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RELAYER_COMPLETION_TIME_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "relayer-completion-time-p99-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RELAYER_COMPLETION_TIME_P99_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "relayer-queue-time-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RELAYER_QUEUE_TIME_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "relayer-queue-time-p99-ms",
+                   .metricId = static_cast<short>(ProcessingStatsId::RELAYER_QUEUE_TIME_P99_MS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "memory-allocations",
+                   .metricId = static_cast<short>(ProcessingStatsId::MEMORY_ALLOCATIONS),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "memory-allocated-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::MEMORY_ALLOCATED_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "memory-held-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::MEMORY_HELD_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "memory-peak-held-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::MEMORY_PEAK_HELD_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "malloc-in-use-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::MALLOC_IN_USE_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 1000,
+                   .maxRefreshLatency = 10000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "numa-local-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::NUMA_LOCAL_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 10000,
+                   .maxRefreshLatency = 60000,
+                   .sendInitialValue = true},
+        MetricSpec{.name = "numa-remote-bytes",
+                   .metricId = static_cast<short>(ProcessingStatsId::NUMA_REMOTE_BYTES),
+                   .kind = Kind::UInt64,
+                   .scope = Scope::DPL,
+                   .minPublishInterval = 10000,
+                   .maxRefreshLatency = 60000,
+                   .sendInitialValue = true},
         MetricSpec{.name = "resource-offer-expired",
                    .enabled = arrowAndResourceLimitingMetrics,
                    .metricId = static_cast<short>(ProcessingStatsId::RESOURCE_OFFER_EXPIRED),
@@ -1174,6 +1345,18 @@ o2::framework::ServiceSpec CommonServices::objectCache()
     .kind = ServiceKind::Serial};
 }
 
+o2::framework::ServiceSpec CommonServices::objectPool()
+{
+  return ServiceSpec{
+    .name = "object-pool",
+    .init = [](ServiceRegistryRef, DeviceState&, fair::mq::ProgOptions&) -> ServiceHandle {
+      return ServiceHandle{TypeIdHelpers::uniqueId<ObjectPool>(), new ObjectPool()};
+    },
+    .configure = noConfiguration(),
+    .exit = [](ServiceRegistryRef, void* service) { auto* pool = (ObjectPool*)service; delete pool; },
+    .kind = ServiceKind::Serial};
+}
+
 o2::framework::ServiceSpec CommonServices::dataProcessorContextSpec()
 {
   return ServiceSpec{
@@ -1235,9 +1418,11 @@ std::vector<ServiceSpec> CommonServices::defaultServices(std::string extraPlugin
     dataProcessingStats(),
     dataProcessingStates(),
     dataRelayer(),
+    streamSchedulerSpec(),
     CommonMessageBackends::fairMQDeviceProxy(),
     dataSender(),
     objectCache(),
+    objectPool(),
     ccdbSupportSpec()};
 
   if (!DefaultsHelpers::onlineDeploymentMode() && DefaultsHelpers::deploymentMode() != DeploymentMode::FST) {
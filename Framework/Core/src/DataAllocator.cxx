@@ -227,7 +227,17 @@ void DataAllocator::adopt(const Output& spec, LifetimeHolder<TableBuilder>& tb)
   };
   auto buffer = std::make_shared<FairMQResizableBuffer>(creator);
 
-  tb.callback = [buffer = buffer, transport = context.proxy().getOutputTransport(routeIndex)](TableBuilder& builder) -> void {
+  // Optionally build the columns directly in messages of the output
+  // transport (i.e. shared memory), so that the only big private allocation
+  // is gone. The pool is kept alive by the callback, which outlives the builder.
+  static bool builderInShm = getenv("DPL_TABLE_BUILDER_IN_SHM") && atoi(getenv("DPL_TABLE_BUILDER_IN_SHM"));
+  std::shared_ptr<FairMQMemoryPool> pool;
+  if (builderInShm && tb->memoryPool() == arrow::default_memory_pool()) {
+    pool = std::make_shared<FairMQMemoryPool>(creator);
+    tb->setMemoryPool(pool.get());
+  }
+
+  tb.callback = [buffer = buffer, pool = pool, transport = context.proxy().getOutputTransport(routeIndex)](TableBuilder& builder) -> void {
     auto table = builder.finalize();
     doWriteTable(buffer, table.get());
     // deletion happens in the caller
@@ -305,6 +315,27 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::forwardPayload(const Output& spec, fair::mq::Message& payload,
+                                   o2::header::SerializationMethod serializationMethod)
+{
+  auto& proxy = mRegistry.get<FairMQDeviceProxy>();
+  auto& timingInfo = mRegistry.get<TimingInfo>();
+
+  RouteIndex routeIndex = matchDataHeader(spec, timingInfo.timeslice);
+  auto* transport = proxy.getOutputTransport(routeIndex);
+  fair::mq::MessagePtr payloadMessage;
+  if (payload.GetTransport() == transport) {
+    // only the reference is copied, the buffer is shared with the original message
+    payloadMessage = transport->CreateMessage();
+    payloadMessage->Copy(payload);
+  } else {
+    payloadMessage = proxy.createOutputMessage(routeIndex, payload.GetSize());
+    memcpy(payloadMessage->GetData(), payload.GetData(), payload.GetSize());
+  }
+
+  addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
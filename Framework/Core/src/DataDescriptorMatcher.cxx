@@ -237,6 +237,13 @@ bool DataDescriptorMatcher::match(header::Stack const& stack, VariableContext& c
 // actual polymorphic matcher which is able to cast the pointer to the correct
 // kind of header.
 bool DataDescriptorMatcher::match(char const* d, VariableContext& context) const
+{
+  // The headers are looked up only once for the whole query, rather than
+  // once for each node which needs them.
+  return this->match(o2::header::get<header::DataHeader*>(d), o2::header::get<DataProcessingHeader*>(d), context);
+}
+
+bool DataDescriptorMatcher::match(header::DataHeader const* dh, DataProcessingHeader const* dph, VariableContext& context) const
 {
   bool leftValue = false, rightValue = false;
 
@@ -268,30 +275,25 @@ bool DataDescriptorMatcher::match(char const* d, VariableContext& context) const
   // }
   //  When we drop support for macOS 10.13
   if (auto pval0 = std::get_if<OriginValueMatcher>(&mLeft)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
     if (dh == nullptr) {
       throw runtime_error("Cannot find DataHeader");
     }
     leftValue = pval0->match(*dh, context);
   } else if (auto pval1 = std::get_if<DescriptionValueMatcher>(&mLeft)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
     if (dh == nullptr) {
       throw runtime_error("Cannot find DataHeader");
     }
     leftValue = pval1->match(*dh, context);
   } else if (auto pval2 = std::get_if<SubSpecificationTypeValueMatcher>(&mLeft)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
     if (dh == nullptr) {
       throw runtime_error("Cannot find DataHeader");
     }
     leftValue = pval2->match(*dh, context);
   } else if (auto pval3 = std::get_if<std::unique_ptr<DataDescriptorMatcher>>(&mLeft)) {
-    leftValue = (*pval3)->match(d, context);
+    leftValue = (*pval3)->match(dh, dph, context);
   } else if (auto pval4 = std::get_if<ConstantValueMatcher>(&mLeft)) {
     leftValue = pval4->match();
   } else if (auto pval5 = std::get_if<StartTimeValueMatcher>(&mLeft)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
-    auto dph = o2::header::get<DataProcessingHeader*>(d);
     if (dph == nullptr) {
       throw runtime_error("Cannot find DataProcessingHeader");
     }
@@ -314,21 +316,28 @@ bool DataDescriptorMatcher::match(char const* d, VariableContext& context) const
   }
 
   if (auto pval0 = std::get_if<OriginValueMatcher>(&mRight)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
+    if (dh == nullptr) {
+      throw runtime_error("Cannot find DataHeader");
+    }
     rightValue = pval0->match(*dh, context);
   } else if (auto pval1 = std::get_if<DescriptionValueMatcher>(&mRight)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
+    if (dh == nullptr) {
+      throw runtime_error("Cannot find DataHeader");
+    }
     rightValue = pval1->match(*dh, context);
   } else if (auto pval2 = std::get_if<SubSpecificationTypeValueMatcher>(&mRight)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
+    if (dh == nullptr) {
+      throw runtime_error("Cannot find DataHeader");
+    }
     rightValue = pval2->match(*dh, context);
   } else if (auto pval3 = std::get_if<std::unique_ptr<DataDescriptorMatcher>>(&mRight)) {
-    rightValue = (*pval3)->match(d, context);
+    rightValue = (*pval3)->match(dh, dph, context);
   } else if (auto pval4 = std::get_if<ConstantValueMatcher>(&mRight)) {
     rightValue = pval4->match();
   } else if (auto pval5 = std::get_if<StartTimeValueMatcher>(&mRight)) {
-    auto dh = o2::header::get<header::DataHeader*>(d);
-    auto dph = o2::header::get<DataProcessingHeader*>(d);
+    if (dph == nullptr) {
+      throw runtime_error("Cannot find DataProcessingHeader");
+    }
     rightValue = pval5->match(*dh, *dph, context);
   }
   // There are cases in which not having a rightValue might be legitimate,
@@ -0,0 +1,159 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DataDescriptorMatcherIndex.h"
+#include "Framework/VariantHelpers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace o2::framework::data_matcher
+{
+
+namespace
+{
+/// Constant values required by a matcher
+struct Constraints {
+  std::optional<std::string> origin;
+  std::optional<std::string> description;
+  std::optional<header::DataHeader::SubSpecificationType> subSpec;
+};
+
+void collectConstraints(DataDescriptorMatcher const& matcher, Constraints& constraints);
+
+/// Only the nodes which must be true for the matcher to be true
+/// can constrain it, i.e. the ones of the Just and And clauses.
+void collectConstraints(Node const& node, Constraints& constraints)
+{
+  std::visit(overloaded{
+               [&constraints](OriginValueMatcher const& origin) {
+                 origin.visit(overloaded{[&constraints](std::string const& s) { constraints.origin = s; },
+                                         [](ContextRef) {}});
+               },
+               [&constraints](DescriptionValueMatcher const& description) {
+                 description.visit(overloaded{[&constraints](std::string const& s) { constraints.description = s; },
+                                              [](ContextRef) {}});
+               },
+               [&constraints](SubSpecificationTypeValueMatcher const& subSpec) {
+                 subSpec.visit(overloaded{[&constraints](header::DataHeader::SubSpecificationType v) { constraints.subSpec = v; },
+                                          [](ContextRef) {}});
+               },
+               [&constraints](std::unique_ptr<DataDescriptorMatcher> const& matcher) {
+                 collectConstraints(*matcher, constraints);
+               },
+               [](auto const&) {}},
+             node);
+}
+
+void collectConstraints(DataDescriptorMatcher const& matcher, Constraints& constraints)
+{
+  switch (matcher.getOp()) {
+    case DataDescriptorMatcher::Op::Just:
+      collectConstraints(matcher.getLeft(), constraints);
+      break;
+    case DataDescriptorMatcher::Op::And:
+      collectConstraints(matcher.getLeft(), constraints);
+      collectConstraints(matcher.getRight(), constraints);
+      break;
+    default:
+      break;
+  }
+}
+
+/// Merge sorted lists of positions
+std::vector<size_t> merge(std::vector<size_t> const& a, std::vector<size_t> const& b)
+{
+  std::vector<size_t> result;
+  result.reserve(a.size() + b.size());
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+  return result;
+}
+} // namespace
+
+bool DataDescriptorMatcherIndex::Key::operator==(Key const& other) const
+{
+  return std::memcmp(this, &other, sizeof(Key)) == 0;
+}
+
+size_t DataDescriptorMatcherIndex::KeyHash::operator()(Key const& key) const
+{
+  return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<char const*>(&key), sizeof(Key)));
+}
+
+DataDescriptorMatcherIndex::Key DataDescriptorMatcherIndex::makeKey(char const* origin, size_t originSize,
+                                                                    char const* description, size_t descriptionSize,
+                                                                    header::DataHeader::SubSpecificationType subSpec)
+{
+  static_assert(sizeof(Key) == header::DataOrigin::size + header::DataDescription::size + sizeof(header::DataHeader::SubSpecificationType),
+                "the key must not have padding to be hashed as a sequence of bytes");
+  Key key;
+  std::memcpy(key.origin, origin, strnlen(origin, std::min(originSize, sizeof(key.origin))));
+  std::memcpy(key.description, description, strnlen(description, std::min(descriptionSize, sizeof(key.description))));
+  key.subSpec = subSpec;
+  return key;
+}
+
+DataDescriptorMatcherIndex::DataDescriptorMatcherIndex(std::vector<DataDescriptorMatcher> const& matchers, std::vector<size_t> const& order)
+{
+  std::unordered_map<Key, std::vector<size_t>, KeyHash> exact;
+  std::unordered_map<Key, std::vector<size_t>, KeyHash> noSubSpec;
+
+  for (size_t ri = 0; ri < order.size(); ++ri) {
+    mAll.push_back(ri);
+    Constraints constraints;
+    collectConstraints(matchers[order[ri]], constraints);
+    if (!constraints.origin || !constraints.description) {
+      mWildcards.push_back(ri);
+      continue;
+    }
+    auto key = makeKey(constraints.origin->c_str(), constraints.origin->size(),
+                       constraints.description->c_str(), constraints.description->size(),
+                       constraints.subSpec.value_or(0));
+    if (constraints.subSpec) {
+      exact[key].push_back(ri);
+    } else {
+      noSubSpec[key].push_back(ri);
+    }
+  }
+
+  // The candidates of a given key are the matchers requiring it, the ones
+  // with the same origin and description but any subspecification, and the wildcards.
+  for (auto& [key, positions] : noSubSpec) {
+    mNoSubSpec[key] = merge(positions, mWildcards);
+  }
+  for (auto& [key, positions] : exact) {
+    Key anySubSpec = key;
+    anySubSpec.subSpec = 0;
+    auto otherSubSpecs = noSubSpec.find(anySubSpec);
+    mExact[key] = merge(merge(positions, otherSubSpecs != noSubSpec.end() ? otherSubSpecs->second : std::vector<size_t>{}), mWildcards);
+  }
+}
+
+std::vector<size_t> const& DataDescriptorMatcherIndex::candidates(header::DataHeader const* dh) const
+{
+  if (dh == nullptr) {
+    return mAll;
+  }
+  auto key = makeKey(dh->dataOrigin.str, header::DataOrigin::size, dh->dataDescription.str, header::DataDescription::size, dh->subSpecification);
+  if (auto exact = mExact.find(key); exact != mExact.end()) {
+    return exact->second;
+  }
+  key.subSpec = 0;
+  if (auto noSubSpec = mNoSubSpec.find(key); noSubSpec != mNoSubSpec.end()) {
+    return noSubSpec->second;
+  }
+  return mWildcards;
+}
+
+} // namespace o2::framework::data_matcher
@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "Framework/DataOutputDirector.h"
+#include "Framework/ArrowFileHelpers.h"
 #include "Framework/DataSpecUtils.h"
 #include "Headers/DataHeaderHelpers.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
@@ -191,6 +192,7 @@ void DataOutputDirector::readString(std::string const& keepString)
     mfilePtrs.emplace_back(new TFile());
     mParentMaps.emplace_back(new TMap());
   }
+  mArrowDirectories.assign(mfilenameBases.size(), "");
 }
 
 // creates a keep string from a InputSpec
@@ -329,6 +331,16 @@ std::tuple<std::string, std::string, std::string, float, int> DataOutputDirector
     }
   }
 
+  itemName = "resfileformat";
+  if (dodirItem.HasMember(itemName)) {
+    if (dodirItem[itemName].IsString()) {
+      setFileFormat(dodirItem[itemName].GetString());
+    } else {
+      LOGP(error, "Check the JSON document! Item \"{}\" must be a string!", itemName);
+      return memptyanswer;
+    }
+  }
+
   itemName = "maxfilesize";
   if (dodirItem.HasMember(itemName)) {
     if (dodirItem[itemName].IsNumber()) {
@@ -467,22 +479,7 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
 
     // open new output file
     if (!mfilePtrs[ind]->IsOpen()) {
-      // output directory
-      auto resdirname = mresultDirectory;
-      // is the maximum-file-size check enabled?
-      if (mmaxfilesize > 0.) {
-        // subdirectory ./xxx
-        char chcnt[4];
-        std::snprintf(chcnt, sizeof(chcnt), "%03d", mfileCounter);
-        resdirname += "/" + std::string(chcnt);
-      }
-      auto resdir = fs::path{resdirname.c_str()};
-
-      if (!fs::is_directory(resdir)) {
-        if (!fs::create_directories(resdir)) {
-          LOGF(fatal, "Could not create output directory %s", resdirname.c_str());
-        }
-      }
+      auto resdirname = createResultDirectory();
 
       // complete file name
       auto fn = resdirname + "/" + mfilenameBases[ind] + ".root";
@@ -508,6 +505,49 @@ FileAndFolder DataOutputDirector::getFileFolder(DataOutputDescriptor* dodesc, ui
   return fileAndFolder;
 }
 
+std::string DataOutputDirector::getArrowFilename(DataOutputDescriptor* dodesc, uint64_t folderNumber, std::string parentFileName)
+{
+  auto it = std::find(mfilenameBases.begin(), mfilenameBases.end(), dodesc->getFilenameBase());
+  if (it == mfilenameBases.end()) {
+    return "";
+  }
+  int ind = std::distance(mfilenameBases.begin(), it);
+
+  // the directory plays the role of the ROOT file
+  if (mArrowDirectories[ind].empty()) {
+    mArrowDirectories[ind] = createResultDirectory() + "/" + mfilenameBases[ind];
+    mParentMaps[ind]->Clear();
+  }
+
+  auto folderName = "DF_" + std::to_string(folderNumber);
+  // TODO not clear why we get a " " in case we sent empty over DPL, put the limit to 1 for now
+  if (parentFileName.length() > 1 && !mParentMaps[ind]->GetValue(folderName.c_str())) {
+    mParentMaps[ind]->Add(new TObjString(folderName.c_str()), new TObjString(parentFileName.c_str()));
+  }
+
+  return ArrowFileHelpers::tablePath(mArrowDirectories[ind], folderName, dodesc->treename);
+}
+
+std::string DataOutputDirector::createResultDirectory()
+{
+  auto resdirname = mresultDirectory;
+  // is the maximum-file-size check enabled?
+  if (mmaxfilesize > 0.) {
+    // subdirectory ./xxx
+    char chcnt[4];
+    std::snprintf(chcnt, sizeof(chcnt), "%03d", mfileCounter);
+    resdirname += "/" + std::string(chcnt);
+  }
+  auto resdir = fs::path{resdirname.c_str()};
+
+  if (!fs::is_directory(resdir)) {
+    if (!fs::create_directories(resdir)) {
+      LOGF(fatal, "Could not create output directory %s", resdirname.c_str());
+    }
+  }
+  return resdirname;
+}
+
 bool DataOutputDirector::checkFileSizes()
 {
   // is the maximum-file-size check enabled?
@@ -528,12 +568,22 @@ bool DataOutputDirector::checkFileSizes()
       continue;
     }
     // size of fn
-    auto fn = resdirname + "/" + mfilenameBases[i] + ".root";
+    auto fn = resdirname + "/" + mfilenameBases[i] + (mfileFormat == "arrow" ? "" : ".root");
     auto resfile = fs::path{fn.c_str()};
     if (!fs::exists(resfile)) {
       continue;
     }
-    auto fsize = (float)fs::file_size(resfile) / 1.E6; // MBytes
+    uintmax_t size = 0;
+    if (fs::is_directory(resfile)) {
+      for (auto const& entry : fs::recursive_directory_iterator(resfile)) {
+        if (entry.is_regular_file()) {
+          size += entry.file_size();
+        }
+      }
+    } else {
+      size = fs::file_size(resfile);
+    }
+    auto fsize = (float)size / 1.E6; // MBytes
     LOGF(debug, "File %s: %f MBytes", fn.c_str(), fsize);
     if (fsize >= mmaxfilesize) {
       closeDataFiles();
@@ -548,6 +598,22 @@ bool DataOutputDirector::checkFileSizes()
 
 void DataOutputDirector::closeDataFiles()
 {
+  for (auto i = 0U; i < mArrowDirectories.size(); i++) {
+    if (mArrowDirectories[i].empty()) {
+      continue;
+    }
+    if (mParentMaps[i]->GetEntries() > 0) {
+      ArrowFileHelpers::StringMap parents;
+      auto it = mParentMaps[i]->MakeIterator();
+      while (auto key = it->Next()) {
+        parents.emplace_back(((TObjString*)key)->GetString().Data(), ((TObjString*)mParentMaps[i]->GetValue(key))->GetString().Data());
+      }
+      delete it;
+      ArrowFileHelpers::writeMap(parents, mArrowDirectories[i] + "/" + ArrowFileHelpers::parentFilesName);
+      mParentMaps[i]->Clear();
+    }
+    mArrowDirectories[i].clear();
+  }
   for (auto i = 0U; i < mfilePtrs.size(); i++) {
     auto filePtr = mfilePtrs[i];
     if (filePtr) {
@@ -566,6 +632,7 @@ void DataOutputDirector::printOut()
   LOGP(info, "  Output directory     : {}", mresultDirectory);
   LOGP(info, "  Default file name    : {}", mfilenameBase);
   LOGP(info, "  Maximum file size    : {} megabytes", mmaxfilesize);
+  LOGP(info, "  File format          : {}", mfileFormat);
   LOGP(info, "  Number of files      : {}", mfilenameBases.size());
 
   LOGP(info, "  DataOutputDescriptors: {}", mDataOutputDescriptors.size());
@@ -618,6 +685,15 @@ void DataOutputDirector::setFilenameBase(std::string dfn)
     mfilePtrs.emplace_back(new TFile());
     mParentMaps.emplace_back(new TMap());
   }
+  mArrowDirectories.assign(mfilenameBases.size(), "");
+}
+
+void DataOutputDirector::setFileFormat(std::string fileformat)
+{
+  if (fileformat != "root" && fileformat != "arrow") {
+    LOGP(fatal, "Unknown AOD file format \"{}\", must be root or arrow", fileformat);
+  }
+  mfileFormat = fileformat;
 }
 
 void DataOutputDirector::setMaximumFileSize(float maxfs)
@@ -31,6 +31,7 @@
 #include "Framework/TMessageSerializer.h"
 #include "Framework/InputRecord.h"
 #include "Framework/InputSpan.h"
+#include "Framework/O2DataModelHelpers.h"
 #if defined(__APPLE__) || defined(NDEBUG)
 #define O2_SIGNPOST_IMPLEMENTATION
 #endif
@@ -46,6 +47,7 @@
 #include "Framework/DeviceContext.h"
 #include "Framework/RawDeviceService.h"
 #include "Framework/StreamContext.h"
+#include "Framework/StreamScheduler.h"
 #include "Framework/DefaultsHelpers.h"
 
 #include "PropertyTreeHelpers.h"
@@ -519,6 +521,7 @@ void DataProcessingDevice::Init()
     ServiceRegistry::Salt streamSalt = ServiceRegistry::streamSalt(si + 1, ServiceRegistry::globalDeviceSalt().dataProcessorId);
     mServiceRegistry.lateBindStreamServices(state, *options, streamSalt);
   }
+  ServiceRegistryRef{mServiceRegistry}.get<StreamScheduler>().resize(mStreams.size());
   O2_SIGNPOST_END(device, cid, "Init", "Exiting Init callback.");
 }
 
@@ -1638,6 +1641,9 @@ void DataProcessingDevice::doPrepare(ServiceRegistryRef ref)
         if (parts.Size()) {
           O2_SIGNPOST_EVENT_EMIT(device, cid, "channels", "Received %zu parts from channel %{public}s (%d).", parts.Size(), channelSpec.name.c_str(), info.id.value);
         }
+        // Unpack what the "coalescing" sending policy might have packed, so
+        // that the relayer and the InputRecord see the original parts.
+        O2DataModelHelpers::expandCoalescedParts(parts, info.channel->Transport());
         for (auto&& part : parts) {
           info.parts.fParts.emplace_back(std::move(part));
         }
@@ -1774,6 +1780,7 @@ void DataProcessingDevice::ResetTask()
 {
   ServiceRegistryRef ref{mServiceRegistry};
   ref.get<DataRelayer>().clear();
+  ref.get<StreamScheduler>().clear();
   auto& deviceContext = ref.get<DeviceContext>();
   // If the signal handler is there, we should
   // hide the registry from it, so that we do not
@@ -2156,7 +2163,12 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].getNumberOfPairs();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    auto payloadMessageGetter = [&currentSetOfInputs](size_t i, size_t partindex) -> fair::mq::Message* {
+      return currentSetOfInputs[i].getNumberOfPairs() > partindex ? currentSetOfInputs[i].associatedPayload(partindex).get() : nullptr;
+    };
+    InputSpan span{getter, nofPartsGetter, currentSetOfInputs.size()};
+    span.setPayloadMessageGetter(payloadMessageGetter);
+    return span;
   };
 
   auto markInputsAsDone = [ref](TimesliceSlot slot) -> void {
@@ -2260,11 +2272,30 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     control.notifyStreamingState(state.streaming);
   };
 
+  // Whatever is ready goes in the queue of this stream. Streams which
+  // have nothing to do will steal from it.
+  auto& scheduler = ref.get<StreamScheduler>();
+  size_t streamIndex = std::max(0, ref.salt().streamId - 1);
+  assert(streamIndex < scheduler.size());
   ref.get<DataRelayer>().getReadyToProcess(completed);
-  if (completed.empty() == true) {
+  switch (ref.get<DeviceSpec const>().completionPolicy.order) {
+    case CompletionPolicy::CompletionOrder::Timeslice:
+      std::sort(completed.begin(), completed.end(), [](auto const& a, auto const& b) { return a.timeslice.value < b.timeslice.value; });
+      break;
+    case CompletionPolicy::CompletionOrder::Slot:
+      std::sort(completed.begin(), completed.end(), [](auto const& a, auto const& b) { return a.slot.index < b.slot.index; });
+      break;
+    case CompletionPolicy::CompletionOrder::Any:
+    default:
+      break;
+  }
+  scheduler.push(streamIndex, completed);
+  if (scheduler.queueDepth() == 0) {
     LOGP(debug, "No computations available for dispatching.");
+    scheduler.markIdle(streamIndex, uv_hrtime());
     return false;
   }
+  scheduler.markBusy(streamIndex, uv_hrtime());
 
   auto postUpdateStats = [ref](DataRelayer::RecordAction const& action, InputRecord const& record, uint64_t tStart, uint64_t tStartMilli) {
     auto& stats = ref.get<DataProcessingStats>();
@@ -2325,19 +2356,15 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
   using namespace o2::framework;
   stats.updateStats({(int)ProcessingStatsId::PENDING_INPUTS, DataProcessingStats::Op::Set, static_cast<int64_t>(relayer.getParallelTimeslices() - completed.size())});
   stats.updateStats({(int)ProcessingStatsId::INCOMPLETE_INPUTS, DataProcessingStats::Op::Set, completed.empty() ? 1 : 0});
-  switch (spec.completionPolicy.order) {
-    case CompletionPolicy::CompletionOrder::Timeslice:
-      std::sort(completed.begin(), completed.end(), [](auto const& a, auto const& b) { return a.timeslice.value < b.timeslice.value; });
-      break;
-    case CompletionPolicy::CompletionOrder::Slot:
-      std::sort(completed.begin(), completed.end(), [](auto const& a, auto const& b) { return a.slot.index < b.slot.index; });
-      break;
-    case CompletionPolicy::CompletionOrder::Any:
-    default:
-      break;
-  }
-
-  for (auto action : completed) {
+  stats.updateStats({(int)ProcessingStatsId::SCHEDULER_QUEUE_DEPTH, DataProcessingStats::Op::Set, static_cast<int64_t>(scheduler.queueDepth())});
+
+  // Stealing would break the ordering guarantees, so we only do it when
+  // the policy does not care about the order.
+  bool allowSteal = spec.completionPolicy.order == CompletionPolicy::CompletionOrder::Any;
+  // Everything is in the scheduler now, make sure we do not queue it twice.
+  completed.clear();
+  DataRelayer::RecordAction action;
+  while (scheduler.pop(streamIndex, action, allowSteal)) {
     O2_SIGNPOST_ID_GENERATE(aid, device);
     O2_SIGNPOST_START(device, aid, "device", "Processing action on slot %lu for action %{public}s", action.slot.index, fmt::format("{}", action.op).c_str());
     if (action.op == CompletionPolicy::CompletionOp::Wait) {
@@ -2516,6 +2543,9 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     O2_SIGNPOST_END(device, aid, "device", "Done processing action on slot %lu for action %{public}s", action.slot.index, fmt::format("{}", action.op).c_str());
   }
   O2_SIGNPOST_END(device, sid, "device", "Start processing ready actions");
+  auto schedulerStats = scheduler.totalStats();
+  stats.updateStats({(int)ProcessingStatsId::SCHEDULER_STEALS, DataProcessingStats::Op::Set, static_cast<int64_t>(schedulerStats.steals)});
+  stats.updateStats({(int)ProcessingStatsId::SCHEDULER_IDLE_TIME_MS, DataProcessingStats::Op::Set, static_cast<int64_t>(schedulerStats.idleTime / 1000000)});
 
   // We now broadcast the end of stream if it was requested
   if (state.streaming == StreamingState::EndOfStreaming) {
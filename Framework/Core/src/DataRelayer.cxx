@@ -46,6 +46,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <gsl/span>
+#include <uv.h>
 #include <numeric>
 #include <string>
 
@@ -60,6 +61,34 @@ namespace o2::framework
 {
 
 constexpr int INVALID_INPUT = -1;
+/// Maximum number of inputs for which we publish the time they waited
+/// for the rest of the slot.
+constexpr size_t MAX_INPUT_WAIT_METRICS = 1024;
+
+void DataRelayer::LatencyHistogram::fill(uint64_t ms)
+{
+  size_t bin = ms == 0 ? 0 : std::min<size_t>(64 - __builtin_clzll(ms), NBINS - 1);
+  bins[bin]++;
+  count++;
+  sum += ms;
+  max = std::max(max, ms);
+}
+
+uint64_t DataRelayer::LatencyHistogram::quantile(float q) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(q * count);
+  uint64_t seen = 0;
+  for (size_t bi = 0; bi < NBINS; ++bi) {
+    seen += bins[bi];
+    if (seen > target) {
+      return std::min(max, (uint64_t)1 << bi);
+    }
+  }
+  return max;
+}
 
 DataRelayer::DataRelayer(const CompletionPolicy& policy,
                          std::vector<InputRoute> const& routes,
@@ -70,6 +99,7 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     mCompletionPolicy{policy},
     mDistinctRoutesIndex{DataRelayerHelpers::createDistinctRouteIndex(routes)},
     mInputMatchers{DataRelayerHelpers::createInputMatchers(routes)},
+    mInputMatcherIndex{mInputMatchers, mDistinctRoutesIndex},
     mMaxLanes{InputRouteHelpers::maxLanes(routes)}
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
@@ -94,12 +124,152 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     queries += std::string_view(buffer, strlen(buffer));
     queries += ";";
   }
+  for (auto& input : mInputs) {
+    bool required = mCompletionPolicy.requiredInput && mCompletionPolicy.requiredInput(input);
+    mRequiredInputs.push_back(required);
+    mNumRequiredInputs += required ? 1 : 0;
+  }
+  std::fill(mMissingRequiredInputs.begin(), mMissingRequiredInputs.end(), mNumRequiredInputs);
+  mInputWaitHistograms.resize(mInputs.size());
+
+  // One metric per input with how long, on average, it arrived after the
+  // first input of the same slot.
+  auto& stats = services.get<DataProcessingStats>();
+  for (size_t ii = 0; ii < std::min(mInputs.size(), MAX_INPUT_WAIT_METRICS); ++ii) {
+    int metricId = (int)ProcessingStatsId::RELAYER_INPUT_WAIT_BASE + ii;
+    if (stats.metricSpecs[metricId].name.empty() == false) {
+      continue;
+    }
+    stats.registerMetric(DataProcessingStats::MetricSpec{
+      .name = fmt::format("relayer-input-wait-ms/{}", mInputs[ii].binding),
+      .metricId = metricId,
+      .kind = DataProcessingStats::Kind::UInt64,
+      .scope = DataProcessingStats::Scope::DPL,
+      .minPublishInterval = 1000,
+      .maxRefreshLatency = 10000,
+      .sendInitialValue = true});
+  }
+
   auto stateId = (short)ProcessingStateId::DATA_QUERIES;
   states.registerState({.name = "data_queries", .stateId = stateId, .sendInitialValue = true, .defaultEnabled = true});
   states.updateState(DataProcessingStates::CommandSpec{.id = stateId, .size = (int)queries.size(), .data = queries.data()});
   states.processCommandQueue();
 }
 
+std::vector<std::unique_lock<std::mutex>> DataRelayer::lockAllSlots()
+{
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(mSlotMutexes.size());
+  for (auto& m : mSlotMutexes) {
+    locks.emplace_back(m);
+  }
+  return locks;
+}
+
+void DataRelayer::markInputArrived(TimesliceSlot slot, size_t input)
+{
+  if (mRequiredInputs[input]) {
+    assert(mMissingRequiredInputs[slot.index] > 0);
+    mMissingRequiredInputs[slot.index]--;
+  }
+  auto now = uv_hrtime();
+  mArrivalTimes[slot.index * mDistinctRoutesIndex.size() + input] = now;
+  auto& timing = mSlotTimings[slot.index];
+  if (timing.firstArrival == 0) {
+    timing.firstArrival = now;
+  }
+}
+
+void DataRelayer::resetTiming(TimesliceSlot slot)
+{
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  std::fill_n(mArrivalTimes.begin() + slot.index * numInputTypes, numInputTypes, 0);
+  mSlotTimings[slot.index] = SlotTiming{};
+}
+
+void DataRelayer::markSlotReady(TimesliceSlot slot)
+{
+  auto& timing = mSlotTimings[slot.index];
+  // ConsumeExisting can make the same slot ready multiple times, we
+  // account only for the first one.
+  if (timing.ready != 0 || timing.firstArrival == 0) {
+    return;
+  }
+  timing.ready = uv_hrtime();
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  size_t lastInput = 0;
+  uint64_t lastArrival = 0;
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  mCompletionHistogram.fill((timing.ready - timing.firstArrival) / 1000000);
+  for (size_t ai = 0; ai < numInputTypes; ++ai) {
+    auto arrival = mArrivalTimes[slot.index * numInputTypes + ai];
+    if (arrival == 0) {
+      continue;
+    }
+    mInputWaitHistograms[ai].fill((arrival - timing.firstArrival) / 1000000);
+    if (arrival >= lastArrival) {
+      lastArrival = arrival;
+      lastInput = ai;
+    }
+  }
+  O2_SIGNPOST_ID_GENERATE(aid, data_relayer);
+  O2_SIGNPOST_EVENT_EMIT(data_relayer, aid, "slotReady", "Slot %zu ready after %" PRIu64 " us, last input was %{public}s after %" PRIu64 " us",
+                         slot.index, (timing.ready - timing.firstArrival) / 1000,
+                         numInputTypes ? mInputs[lastInput].binding.c_str() : "none", (lastArrival - timing.firstArrival) / 1000);
+}
+
+void DataRelayer::markSlotConsumed(TimesliceSlot slot)
+{
+  auto const& timing = mSlotTimings[slot.index];
+  if (timing.ready == 0) {
+    return;
+  }
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  mQueueHistogram.fill((uv_hrtime() - timing.ready) / 1000000);
+}
+
+DataRelayer::LatencyHistogram DataRelayer::getCompletionHistogram()
+{
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  return mCompletionHistogram;
+}
+
+DataRelayer::LatencyHistogram DataRelayer::getQueueHistogram()
+{
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  return mQueueHistogram;
+}
+
+DataRelayer::LatencyHistogram DataRelayer::getInputWaitHistogram(size_t input)
+{
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  return mInputWaitHistograms.at(input);
+}
+
+void DataRelayer::publishLatencies()
+{
+  auto& stats = mContext.get<DataProcessingStats>();
+  std::scoped_lock<std::mutex> timingLock(mTimingMutex);
+  if (mCompletionHistogram.count) {
+    stats.updateStats({(int)ProcessingStatsId::RELAYER_COMPLETION_TIME_MS, DataProcessingStats::Op::Set, (int64_t)mCompletionHistogram.mean()});
+    stats.updateStats({(int)ProcessingStatsId::RELAYER_COMPLETION_TIME_P99_MS, DataProcessingStats::Op::Set, (int64_t)mCompletionHistogram.quantile(0.99)});
+    mCompletionHistogram.reset();
+  }
+  if (mQueueHistogram.count) {
+    stats.updateStats({(int)ProcessingStatsId::RELAYER_QUEUE_TIME_MS, DataProcessingStats::Op::Set, (int64_t)mQueueHistogram.mean()});
+    stats.updateStats({(int)ProcessingStatsId::RELAYER_QUEUE_TIME_P99_MS, DataProcessingStats::Op::Set, (int64_t)mQueueHistogram.quantile(0.99)});
+    mQueueHistogram.reset();
+  }
+  for (size_t ii = 0; ii < std::min(mInputWaitHistograms.size(), MAX_INPUT_WAIT_METRICS); ++ii) {
+    auto& histogram = mInputWaitHistograms[ii];
+    if (histogram.count == 0) {
+      continue;
+    }
+    stats.updateStats({(unsigned short)((int)ProcessingStatsId::RELAYER_INPUT_WAIT_BASE + ii), DataProcessingStats::Op::Set, (int64_t)histogram.mean()});
+    histogram.reset();
+  }
+}
+
 TimesliceId DataRelayer::getTimesliceForSlot(TimesliceSlot slot)
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
@@ -157,6 +327,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       continue;
     }
     assert(mDistinctRoutesIndex.empty() == false);
+    std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
     auto& variables = mTimesliceIndex.getVariablesForSlot(slot);
     auto timestamp = VariableContextHelpers::getTimeslice(variables);
     // We iterate on all the hanlders checking if they need to be expired.
@@ -219,7 +390,11 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       assert(expirator.handler);
       PartRef newRef;
       expirator.handler(services, newRef, variables);
+      bool wasEmpty = part.size() == 0;
       part.reset(std::move(newRef));
+      if (wasEmpty) {
+        markInputArrived(slot, expirator.routeIndex.value);
+      }
       activity.expiredSlots++;
 
       mTimesliceIndex.markAsDirty(slot, true);
@@ -235,12 +410,15 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 /// This does the mapping between a route and a InputSpec. The
 /// reason why these might diffent is that when you have timepipelining
 /// you have one route per timeslice, even if the type is the same.
+/// Only the routes which can match the header according to the matcher
+/// index are tried, in the same order as the full list of routes.
 size_t matchToContext(void const* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      DataDescriptorMatcherIndex const& matcherIndex,
                       VariableContext& context)
 {
-  for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
+  for (auto ri : matcherIndex.candidates(o2::header::get<DataHeader*>(data))) {
     auto& matcher = matchers[index[ri]];
 
     if (matcher.match(reinterpret_cast<char const*>(data), context)) {
@@ -283,6 +461,7 @@ void sendVariableContextMetrics(VariableContext& context, TimesliceSlot slot, Da
 
 void DataRelayer::setOldestPossibleInput(TimesliceId proposed, ChannelIndex channel)
 {
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   auto newOldest = mTimesliceIndex.setOldestPossibleInput(proposed, channel);
   LOGP(debug, "DataRelayer::setOldestPossibleInput {} from channel {}", newOldest.timeslice.value, newOldest.channel.value);
   static bool dontDrop = getenv("DPL_DONT_DROP_OLD_TIMESLICE") && atoi(getenv("DPL_DONT_DROP_OLD_TIMESLICE"));
@@ -300,6 +479,7 @@ void DataRelayer::setOldestPossibleInput(TimesliceId proposed, ChannelIndex chan
       continue;
     }
     mPruneOps.push_back(PruneOp{si});
+    std::scoped_lock<std::mutex> slotLock(slotMutex({si}));
     bool didDrop = false;
     for (size_t mi = 0; mi < mInputs.size(); ++mi) {
       auto& input = mInputs[mi];
@@ -350,6 +530,7 @@ TimesliceIndex::OldestOutputInfo DataRelayer::getOldestPossibleOutput() const
 
 void DataRelayer::prunePending(OnDropCallback onDrop)
 {
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   for (auto& op : mPruneOps) {
     this->pruneCache(op.slot, onDrop);
   }
@@ -358,6 +539,8 @@ void DataRelayer::prunePending(OnDropCallback onDrop)
 
 void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
 {
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
   // We need to prune the cache from the old stuff, if any. Otherwise we
   // simply store the payload in the cache and we mark relevant bit in the
   // hence the first if.
@@ -400,6 +583,8 @@ void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
   };
 
   pruneCache(slot);
+  mMissingRequiredInputs[slot.index] = mNumRequiredInputs;
+  resetTiming(slot);
 }
 
 DataRelayer::RelayChoice
@@ -410,7 +595,10 @@ DataRelayer::RelayChoice
                      size_t nPayloads,
                      std::function<void(TimesliceSlot, std::vector<MessageSet>&, TimesliceIndex::OldestOutputInfo)> onDrop)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // The index lock is only held while we look up the slot. Once the slot
+  // is known we grab its own lock and release the index one, so that the
+  // messages are moved in the cache while other streams can proceed.
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
   DataProcessingHeader const* dph = o2::header::get<DataProcessingHeader*>(rawHeader);
   // IMPLEMENTATION DETAILS
   //
@@ -423,12 +611,13 @@ DataRelayer::RelayChoice
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &matcherIndex = mInputMatcherIndex,
                             &rawHeader,
                             &index = mTimesliceIndex](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(rawHeader, matchers, distinctRoutes, context);
+    auto input = matchToContext(rawHeader, matchers, distinctRoutes, matcherIndex, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -450,7 +639,8 @@ DataRelayer::RelayChoice
   };
 
   // Actually save the header / payload in the slot
-  auto saveInSlot = [&cachedStateMetrics = mCachedStateMetrics,
+  auto saveInSlot = [this,
+                     &cachedStateMetrics = mCachedStateMetrics,
                      &messages,
                      &nMessages,
                      &nPayloads,
@@ -465,6 +655,9 @@ DataRelayer::RelayChoice
     auto cacheIdx = numInputTypes * slot.index + input;
     MessageSet& target = cache[cacheIdx];
     cachedStateMetrics[cacheIdx] = CacheEntryStatus::PENDING;
+    if (target.size() == 0) {
+      markInputArrived(slot, input);
+    }
     // TODO: make sure that multiple parts can only be added within the same call of
     // DataRelayer::relay
     assert(nPayloads > 0);
@@ -551,9 +744,11 @@ DataRelayer::RelayChoice
       this->pruneCache(slot, onDrop);
       mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
     }
-    saveInSlot(timeslice, input, slot, info);
+    std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
     index.publishSlot(slot);
     index.markAsDirty(slot, true);
+    lock.unlock();
+    saveInSlot(timeslice, input, slot, info);
     stats.updateStats({static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), DataProcessingStats::Op::Add, (int)1});
     return RelayChoice{.type = RelayChoice::Type::WillRelay, .timeslice = timeslice};
   }
@@ -633,9 +828,13 @@ DataRelayer::RelayChoice
       // cache still holds the old data, so we prune it.
       this->pruneCache(slot, onDrop);
       mPruneOps.erase(std::remove_if(mPruneOps.begin(), mPruneOps.end(), [slot](const auto& x) { return x.slot == slot; }), mPruneOps.end());
-      saveInSlot(timeslice, input, slot, info);
-      index.publishSlot(slot);
-      index.markAsDirty(slot, true);
+      {
+        std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
+        index.publishSlot(slot);
+        index.markAsDirty(slot, true);
+        lock.unlock();
+        saveInSlot(timeslice, input, slot, info);
+      }
       return RelayChoice{.type = RelayChoice::Type::WillRelay};
   }
   O2_BUILTIN_UNREACHABLE();
@@ -696,19 +895,24 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
   int countProcess = 0;
   int countDiscard = 0;
   int countWait = 0;
-  int notDirty = 0;
-
-  for (int li = cacheLines - 1; li >= 0; --li) {
-    TimesliceSlot slot{(size_t)li};
-    // We only check the cachelines which have been updated by an incoming
-    // message.
-    if (mTimesliceIndex.isDirty(slot) == false) {
-      notDirty++;
-      continue;
-    }
+  int notDirty = cacheLines;
+
+  // We only check the cachelines which have been updated by an incoming
+  // message, walking the dirty bitmap from the most recent slot down.
+  for (auto slot = mTimesliceIndex.findDirtyBefore(cacheLines); TimesliceSlot::isValid(slot); slot = mTimesliceIndex.findDirtyBefore(slot.index)) {
+    size_t li = slot.index;
+    notDirty--;
     if (!mCompletionPolicy.callbackFull) {
       throw runtime_error_f("Completion police %s has no callback set", mCompletionPolicy.name.c_str());
     }
+    std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
+    // Some input the policy needs is still missing, so there is no point
+    // in looking at the partial record.
+    if (mMissingRequiredInputs[li] > 0) {
+      countWait++;
+      mTimesliceIndex.markAsDirty(slot, false);
+      continue;
+    }
     auto partial = getPartialRecord(li);
     // TODO: get the data ref from message model
     auto getter = [&partial](size_t idx, size_t part) {
@@ -733,6 +937,7 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     switch (action) {
       case CompletionPolicy::CompletionOp::Consume:
         countConsume++;
+        markSlotReady(slot);
         updateCompletionResults(slot, timeslice, action);
         mTimesliceIndex.markAsDirty(slot, false);
         break;
@@ -740,16 +945,19 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
         // This is just like Consume, but we also mark all slots as dirty
         countConsume++;
         action = CompletionPolicy::CompletionOp::Consume;
+        markSlotReady(slot);
         updateCompletionResults(slot, timeslice, action);
         mTimesliceIndex.rescan();
         break;
       case CompletionPolicy::CompletionOp::ConsumeExisting:
         countConsumeExisting++;
+        markSlotReady(slot);
         updateCompletionResults(slot, timeslice, action);
         mTimesliceIndex.markAsDirty(slot, false);
         break;
       case CompletionPolicy::CompletionOp::Process:
         countProcess++;
+        markSlotReady(slot);
         updateCompletionResults(slot, timeslice, action);
         mTimesliceIndex.markAsDirty(slot, false);
         break;
@@ -777,7 +985,8 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
 
 void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // Only the cachelines of the slot are touched, no need for the index lock.
+  std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
   const auto numInputTypes = mDistinctRoutesIndex.size();
 
   auto markInputDone = [&cachedStateMetrics = mCachedStateMetrics,
@@ -795,13 +1004,20 @@ void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStat
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // We invalidate the slot in the index while holding both locks, then
+  // release the index so that other timeslices can be relayed while we move
+  // the messages out. Whoever wants to reuse the slot needs to wait for
+  // the slot lock, hence for us to be done.
+  std::unique_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
+  mTimesliceIndex.markAsInvalid(slot);
+  lock.unlock();
+  markSlotConsumed(slot);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
   std::vector<MessageSet> messages(numInputTypes);
   auto& cache = mCache;
-  auto& index = mTimesliceIndex;
 
   // Nothing to see here, this is just to make the outer loop more understandable.
   auto jumpToCacheEntryAssociatedWith = [](TimesliceSlot) {
@@ -814,7 +1030,7 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
   // cache where to put them.
   auto moveHeaderPayloadToOutput = [&messages,
                                     &cachedStateMetrics = mCachedStateMetrics,
-                                    &cache, &index, &numInputTypes](TimesliceSlot s, size_t arg) {
+                                    &cache, &numInputTypes](TimesliceSlot s, size_t arg) {
     auto cacheId = s.index * numInputTypes + arg;
     cachedStateMetrics[cacheId] = CacheEntryStatus::RUNNING;
     // TODO: in the original implementation of the cache, there have been only two messages per entry,
@@ -822,19 +1038,18 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
     if (cache[cacheId].size() > 0) {
       messages[arg] = std::move(cache[cacheId]);
     }
-    index.markAsInvalid(s);
   };
 
   // An invalid set of arguments is a set of arguments associated to an invalid
   // timeslice, so I can simply do that. I keep the assertion there because in principle
   // we should have dispatched the timeslice already!
   // FIXME: what happens when we have enough timeslices to hit the invalid one?
-  auto invalidateCacheFor = [&numInputTypes, &index, &cache](TimesliceSlot s) {
+  auto invalidateCacheFor = [&numInputTypes, &cache, &missing = mMissingRequiredInputs, required = mNumRequiredInputs](TimesliceSlot s) {
     for (size_t ai = s.index * numInputTypes, ae = ai + numInputTypes; ai != ae; ++ai) {
       assert(std::accumulate(cache[ai].messages.begin(), cache[ai].messages.end(), true, [](bool result, auto const& element) { return result && element.get() == nullptr; }));
       cache[ai].clear();
     }
-    index.markAsInvalid(s);
+    missing[s.index] = required;
   };
 
   // Outer loop here.
@@ -843,19 +1058,21 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
     moveHeaderPayloadToOutput(slot, ai);
   }
   invalidateCacheFor(slot);
+  resetTiming(slot);
 
   return messages;
 }
 
 std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTimeslice(TimesliceSlot slot)
 {
-  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  // The slot stays valid in the index, so we only need the slot lock.
+  std::scoped_lock<std::mutex> slotLock(slotMutex(slot));
+  markSlotConsumed(slot);
 
   const auto numInputTypes = mDistinctRoutesIndex.size();
   // State of the computation
   std::vector<MessageSet> messages(numInputTypes);
   auto& cache = mCache;
-  auto& index = mTimesliceIndex;
 
   // Nothing to see here, this is just to make the outer loop more understandable.
   auto jumpToCacheEntryAssociatedWith = [](TimesliceSlot) {
@@ -868,7 +1085,7 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTime
   // cache where to put them.
   auto copyHeaderPayloadToOutput = [&messages,
                                     &cachedStateMetrics = mCachedStateMetrics,
-                                    &cache, &index, &numInputTypes](TimesliceSlot s, size_t arg) {
+                                    &cache, &numInputTypes](TimesliceSlot s, size_t arg) {
     auto cacheId = s.index * numInputTypes + arg;
     cachedStateMetrics[cacheId] = CacheEntryStatus::RUNNING;
     // TODO: in the original implementation of the cache, there have been only two messages per entry,
@@ -893,10 +1110,14 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeExistingInputsForTime
 void DataRelayer::clear()
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  auto slotLocks = lockAllSlots();
 
   for (auto& cache : mCache) {
     cache.clear();
   }
+  std::fill(mMissingRequiredInputs.begin(), mMissingRequiredInputs.end(), mNumRequiredInputs);
+  std::fill(mArrivalTimes.begin(), mArrivalTimes.end(), 0);
+  std::fill(mSlotTimings.begin(), mSlotTimings.end(), SlotTiming{});
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
@@ -929,11 +1150,16 @@ void DataRelayer::publishMetrics()
   // FIXME: many of the DataRelayer function rely on allocated cache, so its
   // maybe misleading to have the allocation in a function primarily for
   // metrics publishing, do better in setPipelineLength?
-  mCache.resize(numInputTypes * mTimesliceIndex.size());
+  {
+    auto slotLocks = lockAllSlots();
+    mCache.resize(numInputTypes * mTimesliceIndex.size());
+    mCachedStateMetrics.resize(mCache.size());
+    mMissingRequiredInputs.resize(mTimesliceIndex.size(), mNumRequiredInputs);
+    mArrivalTimes.resize(mCache.size(), 0);
+    mSlotTimings.resize(mTimesliceIndex.size());
+  }
   auto& states = mContext.get<DataProcessingStates>();
 
-  mCachedStateMetrics.resize(mCache.size());
-
   // There is maximum 16 variables available. We keep them row-wise so that
   // that we can take mod 16 of the index to understand which variable we
   // are talking about.
@@ -985,6 +1211,7 @@ uint64_t DataRelayer::getCreationTimeForSlot(TimesliceSlot slot)
 void DataRelayer::sendContextState()
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  publishLatencies();
   auto& states = mContext.get<DataProcessingStates>();
   for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
     auto slot = TimesliceSlot{ci};
@@ -997,6 +1224,7 @@ void DataRelayer::sendContextState()
   int written = snprintf(relayerSlotState, 1024, "%d ", (int)mTimesliceIndex.size());
   char* buffer = relayerSlotState + written;
   for (size_t ci = 0; ci < mTimesliceIndex.size(); ++ci) {
+    std::scoped_lock<std::mutex> slotLock(slotMutex({ci}));
     for (size_t si = 0; si < mDistinctRoutesIndex.size(); ++si) {
       int index = si * mTimesliceIndex.size() + ci;
       int value = static_cast<int>(mCachedStateMetrics[index]);
@@ -0,0 +1,137 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/DerivedTableCache.h"
+#include "Framework/DataProcessorSpec.h"
+#include "Framework/DataSpecUtils.h"
+#include "Framework/RuntimeError.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace o2::framework
+{
+
+namespace
+{
+// FNV-1a, so that the hashes do not depend on the standard library
+// and the cache can be shared between different builds.
+std::string hashString(std::string const& s)
+{
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (auto c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ull;
+  }
+  return fmt::format("{:016x}", h);
+}
+} // namespace
+
+std::string DerivedTableCache::configurationHash(DataProcessorSpec const& spec, int argc, char* const* argv, std::vector<std::string> const& upstream)
+{
+  std::ostringstream key;
+  key << spec.name << '\n';
+  for (auto const& output : spec.outputs) {
+    key << DataSpecUtils::describe(output) << '\n';
+  }
+  for (auto const& option : spec.options) {
+    key << option.name << '=' << option.defaultValue << '\n';
+  }
+
+  // The options of the task which were given on the command line,
+  // together with the configuration, if any.
+  auto isRelevant = [&spec](std::string const& name) {
+    return name == "configuration" || std::any_of(spec.options.begin(), spec.options.end(), [&name](auto const& option) { return option.name == name; });
+  };
+  for (int ai = 1; ai < argc; ++ai) {
+    std::string arg = argv[ai];
+    if (arg.rfind("--", 0) != 0) {
+      continue;
+    }
+    auto name = arg.substr(2, arg.find('=') - 2);
+    if (!isRelevant(name)) {
+      continue;
+    }
+    std::string value;
+    if (arg.find('=') != std::string::npos) {
+      value = arg.substr(arg.find('=') + 1);
+    } else if (ai + 1 < argc && std::strncmp(argv[ai + 1], "--", 2) != 0) {
+      value = argv[++ai];
+    }
+    key << name << ':' << value << '\n';
+    if (name == "configuration" && value.rfind("json://", 0) == 0) {
+      std::ifstream file(value.substr(7));
+      key << file.rdbuf() << '\n';
+    }
+  }
+
+  for (auto const& hash : upstream) {
+    key << hash << '\n';
+  }
+  return hashString(key.str());
+}
+
+std::string DerivedTableCache::normalise(std::string const& inputFile)
+{
+  if (inputFile.find("://") != std::string::npos) {
+    return inputFile;
+  }
+  return fs::absolute(inputFile).lexically_normal().string();
+}
+
+std::string DerivedTableCache::entryPath(std::string const& cacheDir, std::string const& hash, std::string const& inputFile)
+{
+  return cacheDir + "/" + hash + "/" + hashString(normalise(inputFile));
+}
+
+std::vector<std::string> DerivedTableCache::inputFiles(std::string const& aodFile)
+{
+  if (aodFile.empty() || aodFile[0] != '@') {
+    return {aodFile};
+  }
+  std::vector<std::string> result;
+  std::ifstream list(aodFile.substr(1));
+  if (!list.is_open()) {
+    throw runtime_error_f("Couldn't open file \"%s\"", aodFile.substr(1).c_str());
+  }
+  std::string fileName;
+  while (std::getline(list, fileName)) {
+    // same rules as the DataInputDescriptor
+    fileName.erase(std::remove_if(fileName.begin(), fileName.end(), ::isspace), fileName.end());
+    if (!fileName.empty()) {
+      result.push_back(fileName);
+    }
+  }
+  return result;
+}
+
+bool DerivedTableCache::isComplete(std::string const& entry)
+{
+  std::error_code ec;
+  return fs::exists(fs::path(entry) / completeName, ec);
+}
+
+void DerivedTableCache::markComplete(std::string const& entry)
+{
+  fs::create_directories(entry);
+  std::ofstream marker(fs::path(entry) / completeName);
+  if (!marker.is_open()) {
+    throw runtime_error_f("Unable to create %s/%s", entry.c_str(), completeName);
+  }
+}
+
+} // namespace o2::framework
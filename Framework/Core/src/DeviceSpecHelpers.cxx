@@ -1520,6 +1520,8 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("environment", bpo::value<std::string>());
         realOdesc.add_options()("stacktrace-on-signal", bpo::value<std::string>());
         realOdesc.add_options()("post-fork-command", bpo::value<std::string>());
+        realOdesc.add_options()("numa-node", bpo::value<std::string>());
+        realOdesc.add_options()("cpu-affinity", bpo::value<std::string>());
         realOdesc.add_options()("bad-alloc-max-attempts", bpo::value<std::string>());
         realOdesc.add_options()("bad-alloc-attempt-interval", bpo::value<std::string>());
         realOdesc.add_options()("io-threads", bpo::value<std::string>());
@@ -1723,6 +1725,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
      "dump stacktrace on specified signal(s) (any of `all`, `segv`, `bus`, `ill`, `abrt`, `fpe`, `sys`.)"                                                            //
      "Use `simple` to dump only the main thread in a reliable way")                                                                                                  //
     ("post-fork-command", bpo::value<std::string>(), "post fork command to execute (e.g. numactl {pid}")                                                             //
+    ("numa-node", bpo::value<std::string>(), "NUMA node of the CPUs and memory of the device (<node>, pci:<address> or gpu:<index>)")                                //
+    ("cpu-affinity", bpo::value<std::string>(), "CPUs on which the device runs (e.g. 0-15,32-47), all the ones of --numa-node by default")                           //
     ("session", bpo::value<std::string>(), "unique label for the shared memory session")                                                                             //
     ("network-interface", bpo::value<std::string>(), "network interface to which to bind tpc fmq ports without specified address")                                   //
     ("early-forward-policy", bpo::value<EarlyForwardPolicy>()->default_value(EarlyForwardPolicy::NEVER), "when to forward early the messages: never, noraw, always") //
@@ -15,7 +15,9 @@
 #include "arrow/table.h"
 #include "gandiva/tree_expr_builder.h"
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <stack>
 #include <unordered_map>
@@ -440,44 +442,135 @@ gandiva::ExpressionPtr makeExpression(gandiva::NodePtr node, gandiva::FieldPtr r
   return gandiva::TreeExprBuilder::MakeExpression(std::move(node), std::move(result));
 }
 
-std::shared_ptr<gandiva::Filter>
-  createFilter(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
+namespace
 {
-  std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 makeCondition(createExpressionTree(opSpecs, Schema)),
-                                 &filter);
-  if (!s.ok()) {
-    throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
+/// Process wide cache of the compiled gandiva filters and projectors, so
+/// that the code generation happens only once for the same expression
+/// tree applied to the same schema, regardless of which task requests it.
+/// The key is the textual representation of the schema followed by the
+/// one of the expressions, which is stable for equivalent trees.
+struct ExpressionCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Filter>> filters;
+  std::unordered_map<std::string, std::shared_ptr<gandiva::Projector>> projectors;
+  ExpressionCacheStats stats;
+};
+
+ExpressionCache& expressionCache()
+{
+  static ExpressionCache cache;
+  return cache;
+}
+
+bool expressionCacheEnabled()
+{
+  static bool disabled = getenv("DPL_NO_EXPRESSION_CACHE") && atoi(getenv("DPL_NO_EXPRESSION_CACHE"));
+  return !disabled;
+}
+
+std::string cacheKey(gandiva::SchemaPtr const& schema, gandiva::ConditionPtr const& condition)
+{
+  return schema->ToString() + "\n" + condition->ToString();
+}
+
+std::string cacheKey(gandiva::SchemaPtr const& schema, std::vector<gandiva::ExpressionPtr> const& expressions)
+{
+  std::string key = schema->ToString();
+  for (auto& expression : expressions) {
+    key += "\n";
+    key += expression->ToString();
   }
-  return filter;
+  return key;
 }
 
-std::shared_ptr<gandiva::Filter>
-  createFilter(gandiva::SchemaPtr const& Schema, gandiva::ConditionPtr condition)
+std::shared_ptr<gandiva::Filter> makeFilter(gandiva::SchemaPtr const& schema, gandiva::ConditionPtr condition)
 {
+  std::string key;
+  if (expressionCacheEnabled()) {
+    key = cacheKey(schema, condition);
+    auto& cache = expressionCache();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    if (auto it = cache.filters.find(key); it != cache.filters.end()) {
+      cache.stats.hits++;
+      return it->second;
+    }
+  }
   std::shared_ptr<gandiva::Filter> filter;
-  auto s = gandiva::Filter::Make(Schema,
-                                 std::move(condition),
-                                 &filter);
+  auto s = gandiva::Filter::Make(schema, std::move(condition), &filter);
   if (!s.ok()) {
     throw runtime_error_f("Failed to create filter: %s", s.ToString().c_str());
   }
+  if (expressionCacheEnabled()) {
+    auto& cache = expressionCache();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    cache.stats.misses++;
+    cache.filters.emplace(std::move(key), filter);
+    cache.stats.size = cache.filters.size() + cache.projectors.size();
+  }
   return filter;
 }
 
-std::shared_ptr<gandiva::Projector>
-  createProjector(gandiva::SchemaPtr const& Schema, Operations const& opSpecs, gandiva::FieldPtr result)
+std::shared_ptr<gandiva::Projector> makeProjector(gandiva::SchemaPtr const& schema, std::vector<gandiva::ExpressionPtr> const& expressions)
 {
+  std::string key;
+  if (expressionCacheEnabled()) {
+    key = cacheKey(schema, expressions);
+    auto& cache = expressionCache();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    if (auto it = cache.projectors.find(key); it != cache.projectors.end()) {
+      cache.stats.hits++;
+      return it->second;
+    }
+  }
   std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(Schema,
-                                    {makeExpression(createExpressionTree(opSpecs, Schema), std::move(result))},
-                                    &projector);
+  auto s = gandiva::Projector::Make(schema, expressions, &projector);
   if (!s.ok()) {
     throw runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
   }
+  if (expressionCacheEnabled()) {
+    auto& cache = expressionCache();
+    std::scoped_lock<std::mutex> lock(cache.mutex);
+    cache.stats.misses++;
+    cache.projectors.emplace(std::move(key), projector);
+    cache.stats.size = cache.filters.size() + cache.projectors.size();
+  }
   return projector;
 }
+} // namespace
+
+ExpressionCacheStats getExpressionCacheStats()
+{
+  auto& cache = expressionCache();
+  std::scoped_lock<std::mutex> lock(cache.mutex);
+  return cache.stats;
+}
+
+void clearExpressionCache()
+{
+  auto& cache = expressionCache();
+  std::scoped_lock<std::mutex> lock(cache.mutex);
+  cache.filters.clear();
+  cache.projectors.clear();
+  cache.stats = ExpressionCacheStats{};
+}
+
+std::shared_ptr<gandiva::Filter>
+  createFilter(gandiva::SchemaPtr const& Schema, Operations const& opSpecs)
+{
+  return makeFilter(Schema, makeCondition(createExpressionTree(opSpecs, Schema)));
+}
+
+std::shared_ptr<gandiva::Filter>
+  createFilter(gandiva::SchemaPtr const& Schema, gandiva::ConditionPtr condition)
+{
+  return makeFilter(Schema, std::move(condition));
+}
+
+std::shared_ptr<gandiva::Projector>
+  createProjector(gandiva::SchemaPtr const& Schema, Operations const& opSpecs, gandiva::FieldPtr result)
+{
+  return makeProjector(Schema, {makeExpression(createExpressionTree(opSpecs, Schema), std::move(result))});
+}
 
 std::shared_ptr<gandiva::Projector>
   createProjector(gandiva::SchemaPtr const& Schema, Projector&& p, gandiva::FieldPtr result)
@@ -500,15 +593,7 @@ std::shared_ptr<gandiva::Projector> createProjectorHelper(size_t nColumns, expre
         fields[ci]));
   }
 
-  std::shared_ptr<gandiva::Projector> projector;
-  auto s = gandiva::Projector::Make(
-    schema,
-    expressions,
-    &projector);
-  if (s.ok()) {
-    return projector;
-  }
-  throw o2::framework::runtime_error_f("Failed to create projector: %s", s.ToString().c_str());
+  return makeProjector(schema, expressions);
 }
 
 gandiva::Selection createSelection(std::shared_ptr<arrow::Table> const& table, std::shared_ptr<gandiva::Filter> const& gfilter)
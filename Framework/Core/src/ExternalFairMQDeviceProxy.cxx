@@ -206,14 +206,28 @@ InjectorFunction o2DataModelAdaptor(OutputSpec const& spec, uint64_t startTime,
 {
   return [spec](TimingInfo&, ServiceRegistryRef const& ref, fair::mq::Parts& parts, ChannelRetriever channelRetriever, size_t newTimesliceId, bool& stop) -> bool {
     auto* device = ref.get<RawDeviceService>().device();
+    if (parts.Size() < 2) {
+      return false;
+    }
+    // All the parts go to the same spec and time slice, so they share the route: the
+    // header stacks are built directly in messages of the channel transport and all
+    // the (header, payload) pairs are forwarded with a single send.
+    auto channelName = channelRetriever(spec, newTimesliceId);
+    if (channelName.empty()) {
+      LOG(warning) << "can not find matching channel for " << DataSpecUtils::describe(spec);
+      return false;
+    }
+    auto channelAlloc = o2::pmr::getTransportAllocator(device->GetChannel(channelName, 0).Transport());
+    DataProcessingHeader dph{newTimesliceId, 0};
+    fair::mq::Parts out;
+    out.fParts.reserve(parts.Size());
     for (int i = 0; i < parts.Size() / 2; ++i) {
       auto dh = o2::header::get<DataHeader*>(parts.At(i * 2)->GetData());
-
-      DataProcessingHeader dph{newTimesliceId, 0};
-      o2::header::Stack headerStack{*dh, dph};
-      sendOnChannel(*device, std::move(headerStack), std::move(parts.At(i * 2 + 1)), spec, channelRetriever);
+      out.AddPart(o2::pmr::getMessage(o2::header::Stack{channelAlloc, *dh, dph}));
+      out.AddPart(std::move(parts.At(i * 2 + 1)));
     }
-    return parts.Size() > 0;
+    sendOnChannel(*device, out, channelName, newTimesliceId);
+    return true;
   };
 }
 
@@ -420,6 +434,19 @@ void injectMissingData(fair::mq::Device& device, fair::mq::Parts& parts, std::ve
   }
 }
 
+namespace
+{
+// Hash of the data type of a block, to resolve the route of all the blocks with
+// the same origin, description and subspecification once per received message
+struct ConcreteDataMatcherHash {
+  size_t operator()(ConcreteDataMatcher const& matcher) const
+  {
+    uint64_t key = (uint64_t(matcher.origin.itg[0]) << 32 | matcher.subSpec) ^ (matcher.description.itg[0] * 0x9e3779b97f4a7c15ULL) ^ matcher.description.itg[1];
+    return std::hash<uint64_t>{}(key);
+  }
+};
+} // namespace
+
 InjectorFunction dplModelAdaptor(std::vector<OutputSpec> const& filterSpecs, DPLModelAdapterConfig config)
 {
   bool throwOnUnmatchedInputs = config.throwOnUnmatchedInputs;
@@ -459,6 +486,9 @@ InjectorFunction dplModelAdaptor(std::vector<OutputSpec> const& filterSpecs, DPL
   return [filterSpecs = std::move(filterSpecs), throwOnUnmatchedInputs, droppedDataSpecs = std::make_shared<DroppedDataSpecs>()](TimingInfo& timingInfo, ServiceRegistryRef const& services, fair::mq::Parts& parts, ChannelRetriever channelRetriever, size_t newTimesliceId, bool& stop) {
     // FIXME: this in not thread safe, but better than an alloc of a map per message...
     std::unordered_map<std::string, fair::mq::Parts> outputs;
+    // the output parts of each data type, nullptr if it is not forwarded. The time slice is
+    // the same for all the parts, so the route only depends on the data type
+    std::unordered_map<ConcreteDataMatcher, fair::mq::Parts*, ConcreteDataMatcherHash> routeCache;
     std::vector<std::string> unmatchedDescriptions;
     auto* device = services.get<RawDeviceService>().device();
 
@@ -510,20 +540,32 @@ InjectorFunction dplModelAdaptor(std::vector<OutputSpec> const& filterSpecs, DPL
       OutputSpec query{dh->dataOrigin, dh->dataDescription, dh->subSpecification};
       LOG(debug) << "processing " << DataSpecUtils::describe(OutputSpec{dh->dataOrigin, dh->dataDescription, dh->subSpecification}) << " time slice " << dph->startTime << " part " << dh->splitPayloadIndex << " of " << dh->splitPayloadParts;
       int finalBlockIndex = 0;
-      std::string channelName = "";
-
-      for (auto const& spec : filterSpecs) {
-        // filter on the specified OutputSpecs, the default value is a ConcreteDataTypeMatcher with origin and description 'any'
-        if (DataSpecUtils::match(spec, OutputSpec{{header::gDataOriginAny, header::gDataDescriptionAny}}) ||
-            DataSpecUtils::match(spec, query)) {
-          channelName = channelRetriever(query, dph->startTime);
-          // We do not complain about DPL/EOS/0, since it's normal not to forward it.
-          if (channelName.empty() && DataSpecUtils::describe(query) != "DPL/EOS/0") {
-            LOG(warning) << "can not find matching channel, not able to adopt " << DataSpecUtils::describe(query);
+      ConcreteDataMatcher dataType{dh->dataOrigin, dh->dataDescription, dh->subSpecification};
+      auto cachedRoute = routeCache.find(dataType);
+      if (cachedRoute == routeCache.end()) {
+        fair::mq::Parts* channelParts = nullptr;
+        for (auto const& spec : filterSpecs) {
+          // filter on the specified OutputSpecs, the default value is a ConcreteDataTypeMatcher with origin and description 'any'
+          if (DataSpecUtils::match(spec, OutputSpec{{header::gDataOriginAny, header::gDataDescriptionAny}}) ||
+              DataSpecUtils::match(spec, query)) {
+            auto channelName = channelRetriever(query, dph->startTime);
+            // We do not complain about DPL/EOS/0, since it's normal not to forward it.
+            if (channelName.empty() && DataSpecUtils::describe(query) != "DPL/EOS/0") {
+              LOG(warning) << "can not find matching channel, not able to adopt " << DataSpecUtils::describe(query);
+            }
+            if (!channelName.empty()) {
+              channelParts = &outputs[channelName];
+              if (channelParts->Size() == 0) {
+                // the received parts are an upper bound for what goes to this channel
+                channelParts->fParts.reserve(parts.Size());
+              }
+            }
+            break;
           }
-          break;
         }
+        cachedRoute = routeCache.emplace(dataType, channelParts).first;
       }
+      fair::mq::Parts* channelParts = cachedRoute->second;
       finalBlockIndex = getFinalIndex(*dh, msgidx);
       if (finalBlockIndex > parts.Size()) {
         // TODO error handling
@@ -531,7 +573,7 @@ InjectorFunction dplModelAdaptor(std::vector<OutputSpec> const& filterSpecs, DPL
         continue;
       }
 
-      if (!channelName.empty()) {
+      if (channelParts != nullptr) {
         // the checks for consistency of split payload parts are of informative nature
         // forwarding happens independently
         // if (dh->splitPayloadParts > 1 && dh->splitPayloadParts != std::numeric_limits<decltype(dh->splitPayloadParts)>::max()) {
@@ -545,9 +587,9 @@ InjectorFunction dplModelAdaptor(std::vector<OutputSpec> const& filterSpecs, DPL
         //               << ", matching " << channelName << ", expecting " << channelNameForSplitParts;
         //  }
         //}
-        LOGP(debug, "associating {} part(s) at index {} to channel {} ({})", finalBlockIndex - msgidx, msgidx, channelName, outputs[channelName].Size());
+        LOGP(debug, "associating {} part(s) at index {} to {} ({})", finalBlockIndex - msgidx, msgidx, DataSpecUtils::describe(query), channelParts->Size());
         for (; msgidx < finalBlockIndex; ++msgidx) {
-          outputs[channelName].AddPart(std::move(parts.At(msgidx)));
+          channelParts->AddPart(std::move(parts.At(msgidx)));
         }
         msgidx -= 2;
       } else {
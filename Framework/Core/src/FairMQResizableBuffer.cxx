@@ -13,7 +13,9 @@
 #include <fairmq/Message.h>
 #include <arrow/status.h>
 #include <arrow/util/config.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <utility>
 
 namespace arrow::io::internal
@@ -167,4 +169,98 @@ std::unique_ptr<fair::mq::Message> FairMQResizableBuffer::Finalise()
   return std::move(mMessage);
 }
 
+// Arrow uses the same trick for its own pools: zero sized allocations all
+// point to the same, properly aligned, area.
+alignas(kDefaultBufferAlignment) static uint8_t zeroSizeArea[1] = {0};
+
+FairMQMemoryPool::FairMQMemoryPool(Creator creator)
+  : mCreator{std::move(creator)}
+{
+}
+
+FairMQMemoryPool::~FairMQMemoryPool() = default;
+
+arrow::Status FairMQMemoryPool::Allocate(int64_t size, int64_t alignment, uint8_t** out)
+{
+  if (size < 0) {
+    return arrow::Status::Invalid("negative malloc size");
+  }
+  if (size == 0) {
+    *out = zeroSizeArea;
+    return arrow::Status::OK();
+  }
+  // We do not know what alignment the transport gives us, so we
+  // overallocate and align ourselves.
+  auto message = mCreator(size + alignment);
+  if (message.get() == nullptr || message->GetData() == nullptr) {
+    return arrow::Status::OutOfMemory("unable to allocate ", size, " bytes from the transport");
+  }
+  auto base = reinterpret_cast<uintptr_t>(message->GetData());
+  auto* aligned = reinterpret_cast<uint8_t*>((base + alignment - 1) & ~(uintptr_t)(alignment - 1));
+  std::scoped_lock lock(mMutex);
+  mMessages.emplace(aligned, std::move(message));
+  mBytesAllocated += size;
+  mMaxMemory = std::max(mMaxMemory, mBytesAllocated);
+  mTotalBytesAllocated += size;
+  mNumAllocations++;
+  *out = aligned;
+  return arrow::Status::OK();
+}
+
+arrow::Status FairMQMemoryPool::Reallocate(int64_t oldSize, int64_t newSize, int64_t alignment, uint8_t** ptr)
+{
+  uint8_t* newPtr = nullptr;
+  RETURN_NOT_OK(Allocate(newSize, alignment, &newPtr));
+  if (oldSize > 0 && newSize > 0) {
+    memcpy(newPtr, *ptr, std::min(oldSize, newSize));
+  }
+  Free(*ptr, oldSize, alignment);
+  *ptr = newPtr;
+  return arrow::Status::OK();
+}
+
+void FairMQMemoryPool::Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/)
+{
+  if (buffer == zeroSizeArea) {
+    return;
+  }
+  std::unique_ptr<fair::mq::Message> message;
+  {
+    std::scoped_lock lock(mMutex);
+    auto it = mMessages.find(buffer);
+    assert(it != mMessages.end());
+    if (it == mMessages.end()) {
+      return;
+    }
+    message = std::move(it->second);
+    mMessages.erase(it);
+    mBytesAllocated -= size;
+  }
+  // The message is released outside of the lock.
+}
+
+int64_t FairMQMemoryPool::bytes_allocated() const
+{
+  std::scoped_lock lock(mMutex);
+  return mBytesAllocated;
+}
+
+int64_t FairMQMemoryPool::max_memory() const
+{
+  std::scoped_lock lock(mMutex);
+  return mMaxMemory;
+}
+
+int64_t FairMQMemoryPool::total_bytes_allocated() const
+{
+  std::scoped_lock lock(mMutex);
+  return mTotalBytesAllocated;
+}
+
+int64_t FairMQMemoryPool::num_allocations() const
+{
+  std::scoped_lock lock(mMutex);
+  return mNumAllocations;
+}
+
 } // namespace o2::framework
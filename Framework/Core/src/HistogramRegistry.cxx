@@ -192,6 +192,52 @@ void HistogramRegistry::clean()
   for (auto& value : mRegistryValue) {
     std::visit([](auto&& hist) { hist.reset(); }, value);
   }
+  mShards.clear();
+}
+
+HistogramRegistry::HistHandle HistogramRegistry::getHandle(const HistName& histName)
+{
+  return HistHandle{getHistIndex(histName)};
+}
+
+void HistogramRegistry::setNumberOfShards(uint32_t nShards)
+{
+  mergeShards();
+  mShards.resize(nShards);
+  for (auto& shard : mShards) {
+    for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
+      auto makeEmptyCopy = [&](auto&& hist) {
+        using T = typename std::decay_t<decltype(hist)>::element_type;
+        if (hist) {
+          auto copy = std::shared_ptr<T>(static_cast<T*>(hist->Clone()));
+          copy->Reset();
+          shard[j] = copy;
+        }
+      };
+      std::visit(makeEmptyCopy, mRegistryValue[j]);
+    }
+  }
+}
+
+void HistogramRegistry::mergeShards()
+{
+  if (mShards.empty()) {
+    return;
+  }
+  TList shardHists;
+  for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
+    shardHists.Clear();
+    for (auto& shard : mShards) {
+      std::visit([&](auto&& hist) { if (hist) { shardHists.Add(hist.get()); } }, shard[j]);
+    }
+    if (shardHists.IsEmpty()) {
+      continue;
+    }
+    std::visit([&](auto&& hist) { hist->Merge(&shardHists); }, mRegistryValue[j]);
+    for (auto& shard : mShards) {
+      std::visit([](auto&& hist) { hist->Reset(); }, shard[j]);
+    }
+  }
 }
 
 // print some useful meta-info about the stored histograms
@@ -285,6 +331,7 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::getListOfHistograms()
 {
+  mergeShards();
   TList* list = new TList();
   list->SetName(mName.data());
 
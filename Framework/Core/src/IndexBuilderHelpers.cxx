@@ -16,6 +16,7 @@
 #include <arrow/status.h>
 #include <arrow/table.h>
 #include <arrow/util/key_value_metadata.h>
+#include <thread>
 
 namespace o2::framework
 {
@@ -84,6 +85,13 @@ arrow::Status IndexColumnBuilder::preSlice()
   auto pair = static_cast<arrow::StructArray>(value_counts.array());
   mValuesArrow = std::make_shared<arrow::NumericArray<arrow::Int32Type>>(pair.field(0)->data());
   mCounts = std::make_shared<arrow::NumericArray<arrow::Int64Type>>(pair.field(1)->data());
+  // the slices are contiguous, the first row of a slice is the sum of the counts before it
+  mFirstRows.resize(mCounts->length());
+  int64_t first = 0;
+  for (auto i = 0; i < mCounts->length(); ++i) {
+    mFirstRows[i] = first;
+    first += mCounts->Value(i);
+  }
   return arrow::Status::OK();
 }
 
@@ -95,16 +103,15 @@ arrow::Status IndexColumnBuilder::preFind()
   auto maxValue = std::dynamic_pointer_cast<arrow::Int32Scalar>(max.scalar())->value;
   mIndices.resize(maxValue + 1);
 
-  auto row = 0;
-  for (auto i = 0; i < mSource->length(); ++i) {
-    auto v = valueAt(i);
-    if (v >= 0) {
-      mValues.emplace_back(v);
-      mIndices[v].push_back(row);
+  // group the rows by value: the value is the position of its rows in mIndices,
+  // such that the lookups do not need to search
+  std::vector<int> values;
+  readIndexValues(mSource, values);
+  for (auto row = 0; row < (int)values.size(); ++row) {
+    if (values[row] >= 0) {
+      mIndices[values[row]].push_back(row);
     }
-    ++row;
   }
-  std::sort(mValues.begin(), mValues.end());
 
   return arrow::Status::OK();
 }
@@ -175,7 +182,13 @@ bool IndexColumnBuilder::findSlice(int idx)
 
 bool IndexColumnBuilder::findMulti(int idx)
 {
-  return (std::find(mValues.begin(), mValues.end(), idx) != mValues.end());
+  return idx >= 0 && idx < (int)mIndices.size() && !mIndices[idx].empty();
+}
+
+void IndexColumnBuilder::reset()
+{
+  mPosition = 0;
+  mValuePos = 0;
 }
 
 void IndexColumnBuilder::fillSingle(int idx)
@@ -192,10 +205,7 @@ void IndexColumnBuilder::fillSlice(int idx)
 {
   int data[2] = {-1, -1};
   if (mValuePos < mValuesArrow->length() && mValuesArrow->Value(mValuePos) == idx) {
-    for (auto i = 0; i < mValuePos; ++i) {
-      data[0] += mCounts->Value(i);
-    }
-    data[0] += 1;
+    data[0] = mFirstRows[mValuePos];
     data[1] = data[0] + mCounts->Value(mValuePos) - 1;
   }
   (void)static_cast<arrow::FixedSizeListBuilder*>(mListBuilder.get())->AppendValues(1);
@@ -205,7 +215,7 @@ void IndexColumnBuilder::fillSlice(int idx)
 void IndexColumnBuilder::fillMulti(int idx)
 {
   (void)static_cast<arrow::ListBuilder*>(mListBuilder.get())->Append();
-  if (std::find(mValues.begin(), mValues.end(), idx) != mValues.end()) {
+  if (findMulti(idx)) {
     (void)static_cast<arrow::Int32Builder*>(mValueBuilder)->AppendValues(mIndices[idx].data(), mIndices[idx].size());
   } else {
     (void)static_cast<arrow::Int32Builder*>(mValueBuilder)->AppendValues(nullptr, 0);
@@ -252,6 +262,37 @@ int ChunkedArrayIterator::valueAt(size_t pos)
   return *(mCurrent + pos);
 }
 
+void readIndexValues(std::shared_ptr<arrow::ChunkedArray> const& source, std::vector<int>& values)
+{
+  values.clear();
+  values.reserve(source->length());
+  for (auto const& chunk : source->chunks()) {
+    auto array = std::static_pointer_cast<arrow::Int32Array>(chunk);
+    values.insert(values.end(), array->raw_values(), array->raw_values() + array->length());
+  }
+}
+
+void runColumnTasks(std::vector<std::function<void()>>& tasks, int64_t nRows)
+{
+  // below this, starting the threads costs more than the columns
+  constexpr int64_t minRowsForThreads = 100000;
+  if (tasks.size() < 2 || nRows < minRowsForThreads) {
+    for (auto& task : tasks) {
+      task();
+    }
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(tasks.size() - 1);
+  for (size_t i = 1; i < tasks.size(); ++i) {
+    threads.emplace_back(tasks[i]);
+  }
+  tasks[0]();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 std::shared_ptr<arrow::Table> makeArrowTable(const char* label, std::vector<std::shared_ptr<arrow::ChunkedArray>>&& columns, std::vector<std::shared_ptr<arrow::Field>>&& fields)
 {
   auto schema = std::make_shared<arrow::Schema>(fields);
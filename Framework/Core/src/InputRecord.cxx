@@ -134,6 +134,15 @@ size_t InputRecord::getNofParts(int pos) const
   }
   return mSpan.getNofParts(pos);
 }
+
+fair::mq::Message* InputRecord::getPayloadMessage(int pos, int part) const
+{
+  if (pos < 0 || part < 0 || part >= (int)mSpan.getNofParts(pos)) {
+    return nullptr;
+  }
+  return mSpan.getPayloadMessage(pos, part);
+}
+
 size_t InputRecord::size() const
 {
   return mSpan.size();
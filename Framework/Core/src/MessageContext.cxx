@@ -13,6 +13,7 @@
 #include "Framework/MessageContext.h"
 #include "Framework/OutputRoute.h"
 #include <fairmq/Device.h>
+#include <algorithm>
 
 namespace o2::framework
 {
@@ -29,6 +30,74 @@ fair::mq::MessagePtr MessageContext::createMessage(RouteIndex routeIndex, int in
   return transport->CreateMessage(data, size, ffn, hint);
 }
 
+o2::pmr::FairMQMemoryResource* MessageContext::memoryResource(RouteIndex routeIndex)
+{
+  static bool useSlabs = getenv("DPL_SLAB_ALLOCATOR") && atoi(getenv("DPL_SLAB_ALLOCATOR"));
+  // How much memory each slab resource can keep around, in MB.
+  static size_t maxCachedBytes = (getenv("DPL_SLAB_CACHE_SIZE_MB") ? std::stoul(getenv("DPL_SLAB_CACHE_SIZE_MB")) : 64) * 1024 * 1024;
+  static bool useAccounting = getenv("DPL_MEMORY_ACCOUNTING") && atoi(getenv("DPL_MEMORY_ACCOUNTING"));
+  // One allocation out of this many is attributed to its call stack, 0 to disable.
+  static size_t samplingInterval = getenv("DPL_MEMORY_ACCOUNTING_SAMPLING") ? std::stoul(getenv("DPL_MEMORY_ACCOUNTING_SAMPLING")) : 0;
+  auto* transport = mProxy.getOutputTransport(routeIndex);
+  if (transport == nullptr) {
+    return nullptr;
+  }
+  o2::pmr::FairMQMemoryResource* resource = transport->GetMemoryResource();
+  if (useSlabs) {
+    auto& slab = mSlabResources[transport];
+    if (!slab) {
+      slab = std::make_unique<o2::pmr::SlabMessageResource>(transport, maxCachedBytes);
+    }
+    resource = slab.get();
+  }
+  if (!useAccounting) {
+    return resource;
+  }
+  // Accounting is done per output channel, on top of the resource of its transport.
+  auto& accounting = mAccountingResources[mProxy.getOutputChannelIndex(routeIndex).value];
+  if (!accounting) {
+    accounting = std::make_unique<o2::pmr::AccountingMessageResource>(resource, samplingInterval);
+  }
+  return accounting.get();
+}
+
+o2::pmr::SlabMessageResource::Stats MessageContext::slabStats() const
+{
+  o2::pmr::SlabMessageResource::Stats result;
+  for (auto& [_, slab] : mSlabResources) {
+    auto stats = slab->getStats();
+    result.allocations += stats.allocations;
+    result.reused += stats.reused;
+    result.allocatedBytes += stats.allocatedBytes;
+    result.cachedMessages += stats.cachedMessages;
+    result.cachedBytes += stats.cachedBytes;
+  }
+  return result;
+}
+
+std::vector<std::pair<int, o2::pmr::AccountingMessageResource::Stats>> MessageContext::accountingStats(bool reset)
+{
+  std::vector<std::pair<int, o2::pmr::AccountingMessageResource::Stats>> result;
+  for (auto& [channel, accounting] : mAccountingResources) {
+    result.emplace_back(channel, accounting->getStats(reset));
+  }
+  std::sort(result.begin(), result.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+  return result;
+}
+
+std::vector<o2::pmr::AccountingMessageResource::Site> MessageContext::topAllocationSites(size_t n) const
+{
+  std::vector<o2::pmr::AccountingMessageResource::Site> result;
+  for (auto& [_, accounting] : mAccountingResources) {
+    auto sites = accounting->getTopSites(n);
+    result.insert(result.end(), sites.begin(), sites.end());
+  }
+  auto last = result.begin() + std::min(n, result.size());
+  std::partial_sort(result.begin(), last, result.end(), [](auto const& a, auto const& b) { return a.bytes > b.bytes; });
+  result.erase(last, result.end());
+  return result;
+}
+
 o2::header::DataHeader* MessageContext::findMessageHeader(const Output& spec)
 {
   for (auto it = mMessages.rbegin(); it != mMessages.rend(); ++it) {
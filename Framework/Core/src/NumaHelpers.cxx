@@ -0,0 +1,167 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "NumaHelpers.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace o2::framework
+{
+namespace
+{
+std::string readFirstLine(std::string const& path)
+{
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+
+int numaNodeOfPCIDevice(std::string const& address, std::string const& sysfs)
+{
+  auto node = readFirstLine(sysfs + "/bus/pci/devices/" + address + "/numa_node");
+  if (node.empty()) {
+    return -1;
+  }
+  // The kernel reports -1 when the device is not attached to a node.
+  return std::max(-1, atoi(node.c_str()));
+}
+
+/// Addresses of the NVIDIA and AMD display controllers, ordered as
+/// the devices are when enumerated by PCI bus.
+std::vector<std::string> gpuAddresses(std::string const& sysfs)
+{
+  std::vector<std::string> result;
+  std::error_code ec;
+  for (auto const& entry : std::filesystem::directory_iterator(sysfs + "/bus/pci/devices", ec)) {
+    auto path = entry.path().string();
+    auto deviceClass = readFirstLine(path + "/class");
+    auto vendor = readFirstLine(path + "/vendor");
+    if (deviceClass.rfind("0x03", 0) == 0 && (vendor == "0x10de" || vendor == "0x1002")) {
+      result.push_back(entry.path().filename().string());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace
+
+std::vector<int> NumaHelpers::parseCPUList(std::string const& list)
+{
+  std::vector<int> cpus;
+  std::istringstream in{list};
+  std::string range;
+  while (std::getline(in, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = atoi(range.c_str());
+    int last = dash == std::string::npos ? first : atoi(range.c_str() + dash + 1);
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+int NumaHelpers::resolveNumaNode(std::string const& spec, std::string const& sysfs)
+{
+  if (spec.empty()) {
+    return -1;
+  }
+  if (spec.rfind("pci:", 0) == 0) {
+    return numaNodeOfPCIDevice(spec.substr(4), sysfs);
+  }
+  if (spec.rfind("gpu:", 0) == 0) {
+    auto gpus = gpuAddresses(sysfs);
+    size_t index = atoi(spec.c_str() + 4);
+    return index < gpus.size() ? numaNodeOfPCIDevice(gpus[index], sysfs) : -1;
+  }
+  return atoi(spec.c_str());
+}
+
+std::vector<int> NumaHelpers::cpusOfNumaNode(int node, std::string const& sysfs)
+{
+  if (node < 0) {
+    return {};
+  }
+  return parseCPUList(readFirstLine(sysfs + "/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+}
+
+bool NumaHelpers::bindToCPUs(std::vector<int> const& cpus)
+{
+#ifdef __linux__
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+bool NumaHelpers::preferNumaNode(int node)
+{
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+  // Same as MPOL_PREFERRED from <numaif.h>, which would require libnuma.
+  constexpr int preferred = 1;
+  if (node < 0 || node >= (int)(8 * sizeof(unsigned long))) {
+    return false;
+  }
+  unsigned long mask = 1UL << node;
+  return syscall(SYS_set_mempolicy, preferred, &mask, 8 * sizeof(mask)) == 0;
+#else
+  return false;
+#endif
+}
+
+NumaHelpers::Placement NumaHelpers::parseNumaMaps(std::istream& maps, int node)
+{
+  Placement placement;
+  std::string line;
+  std::vector<std::pair<int, size_t>> pages;
+  while (std::getline(maps, line)) {
+    std::istringstream in{line};
+    std::string field;
+    size_t pageSize = 4096;
+    pages.clear();
+    while (in >> field) {
+      if (field.size() > 1 && field[0] == 'N' && field.find('=') != std::string::npos) {
+        pages.emplace_back(atoi(field.c_str() + 1), strtoull(field.c_str() + field.find('=') + 1, nullptr, 10));
+      } else if (field.rfind("kernelpagesize_kB=", 0) == 0) {
+        pageSize = 1024 * strtoull(field.c_str() + 18, nullptr, 10);
+      }
+    }
+    for (auto& [pageNode, count] : pages) {
+      (pageNode == node ? placement.localBytes : placement.remoteBytes) += count * pageSize;
+    }
+  }
+  return placement;
+}
+
+} // namespace o2::framework
@@ -0,0 +1,61 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_NUMAHELPERS_H_
+#define O2_FRAMEWORK_NUMAHELPERS_H_
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+/// Placement of a device on the CPUs and the memory of a NUMA node.
+/// Only available on Linux, elsewhere the placement is a no-op.
+struct NumaHelpers {
+  /// Memory of the process which is on the node it is bound to and on the other ones.
+  struct Placement {
+    size_t localBytes = 0;
+    size_t remoteBytes = 0;
+  };
+
+  /// Parse a list of CPUs in the kernel format, e.g. 0-15,32-47
+  static std::vector<int> parseCPUList(std::string const& list);
+
+  /// Resolve the NUMA node requested for a device, which can be given as:
+  ///
+  /// <node>: the node itself
+  /// pci:<address>: the node of a PCI device, e.g. pci:0000:41:00.0
+  /// gpu:<index>: the node of the index-th GPU, in order of PCI address,
+  ///              which is the order of the devices of CUDA and HIP
+  ///              when enumerated by PCI bus.
+  ///
+  /// @return the node, or -1 if it is not known.
+  static int resolveNumaNode(std::string const& spec, std::string const& sysfs = "/sys");
+
+  /// @return the CPUs of the NUMA node @a node.
+  static std::vector<int> cpusOfNumaNode(int node, std::string const& sysfs = "/sys");
+
+  /// Restrict the current process to the CPUs @a cpus.
+  static bool bindToCPUs(std::vector<int> const& cpus);
+
+  /// Allocate the memory of the current process, including the shared memory segments
+  /// it creates and touches first, on the node @a node. When the node is full the
+  /// memory is taken from the other nodes.
+  static bool preferNumaNode(int node);
+
+  /// Sum the resident memory of a process per node, given its /proc/<pid>/numa_maps
+  static Placement parseNumaMaps(std::istream& maps, int node);
+};
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_NUMAHELPERS_H_
@@ -11,9 +11,67 @@
 
 #include "Framework/O2DataModelHelpers.h"
 #include "Framework/DataSpecUtils.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/SourceInfoHeader.h"
+#include "Framework/DomainInfoHeader.h"
+#include "Framework/Logger.h"
+#include "MemoryResources/MemoryResources.h"
+#include "Headers/Stack.h"
+#include <fairmq/TransportFactory.h>
+#include <cstring>
 
 namespace o2::framework
 {
+namespace
+{
+constexpr o2::header::DataOrigin gCoalescedOrigin{"DPL"};
+constexpr o2::header::DataDescription gCoalescedDescription{"COALESCED"};
+
+/// A coalesced payload starts with this index, followed by nParts
+/// CoalescedEntry and then by the header and the payload of each
+/// part, back to back.
+struct CoalescedIndex {
+  uint32_t nParts;
+  uint32_t reserved;
+};
+
+struct CoalescedEntry {
+  uint32_t headerSize;
+  uint32_t payloadSize;
+};
+
+bool isCoalesced(o2::header::DataHeader const* dh)
+{
+  return dh && dh->dataOrigin == gCoalescedOrigin && dh->dataDescription == gCoalescedDescription;
+}
+
+/// Number of messages used by the part starting at @a i
+size_t partSpan(fair::mq::Parts& parts, size_t i)
+{
+  auto* dh = o2::header::get<o2::header::DataHeader*>(parts.At(i)->GetData());
+  if (dh && dh->splitPayloadParts > 1 && dh->splitPayloadParts == dh->splitPayloadIndex) {
+    return 1 + dh->splitPayloadParts;
+  }
+  return 2;
+}
+
+bool isPackable(fair::mq::Parts& parts, size_t i, size_t threshold)
+{
+  if (i + 1 >= parts.Size() || parts.At(i + 1)->GetSize() >= threshold) {
+    return false;
+  }
+  auto* headerData = parts.At(i)->GetData();
+  auto* dh = o2::header::get<o2::header::DataHeader*>(headerData);
+  // Split payloads need to stay contiguous, so we do not touch them.
+  if (dh == nullptr || dh->splitPayloadParts > 1 || isCoalesced(dh)) {
+    return false;
+  }
+  return o2::header::get<DataProcessingHeader*>(headerData) != nullptr &&
+         o2::header::get<SourceInfoHeader*>(headerData) == nullptr &&
+         o2::header::get<DomainInfoHeader*>(headerData) == nullptr;
+}
+} // namespace
+
 void O2DataModelHelpers::updateMissingSporadic(fair::mq::Parts& parts, std::vector<OutputSpec> const& specs, std::vector<bool>& present)
 {
   // Mark as present anything which is not of Lifetime timeframe.
@@ -77,4 +135,126 @@ std::string O2DataModelHelpers::describeMissingOutputs(std::vector<OutputSpec> c
   }
   return error;
 }
+
+size_t O2DataModelHelpers::coalesceSmallParts(fair::mq::Parts& parts, fair::mq::TransportFactory* transport, size_t threshold)
+{
+  std::vector<size_t> packable;
+  size_t blobSize = sizeof(CoalescedIndex);
+  for (size_t i = 0; i < parts.Size(); i += partSpan(parts, i)) {
+    if (isPackable(parts, i, threshold)) {
+      packable.push_back(i);
+      blobSize += sizeof(CoalescedEntry) + parts.At(i)->GetSize() + parts.At(i + 1)->GetSize();
+    }
+  }
+  // Nothing to gain
+  if (packable.size() < 2) {
+    return 0;
+  }
+
+  auto blob = transport->CreateMessage(blobSize);
+  auto* data = reinterpret_cast<char*>(blob->GetData());
+  auto* index = reinterpret_cast<CoalescedIndex*>(data);
+  index->nParts = packable.size();
+  index->reserved = 0;
+  auto* entries = reinterpret_cast<CoalescedEntry*>(data + sizeof(CoalescedIndex));
+  char* cursor = reinterpret_cast<char*>(entries + packable.size());
+  for (size_t pi = 0; pi < packable.size(); ++pi) {
+    auto& header = parts.At(packable[pi]);
+    auto& payload = parts.At(packable[pi] + 1);
+    entries[pi] = CoalescedEntry{(uint32_t)header->GetSize(), (uint32_t)payload->GetSize()};
+    memcpy(cursor, header->GetData(), header->GetSize());
+    cursor += header->GetSize();
+    memcpy(cursor, payload->GetData(), payload->GetSize());
+    cursor += payload->GetSize();
+  }
+
+  o2::header::DataHeader dh;
+  dh.dataOrigin = gCoalescedOrigin;
+  dh.dataDescription = gCoalescedDescription;
+  dh.subSpecification = 0;
+  dh.payloadSize = blobSize;
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  // Keep the timing information of the first packed part, so that the
+  // block is accounted to the correct timeslice while in flight.
+  auto* dph = o2::header::get<DataProcessingHeader*>(parts.At(packable[0])->GetData());
+  auto channelAlloc = o2::pmr::getTransportAllocator(transport);
+
+  // The coalesced pair takes the place of the first packed one, everything
+  // else keeps its relative order.
+  fair::mq::Parts result;
+  size_t next = 0;
+  for (size_t i = 0; i < parts.Size(); ++i) {
+    if (next < packable.size() && i == packable[next]) {
+      if (next == 0) {
+        result.AddPart(o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh, *dph}));
+        result.AddPart(std::move(blob));
+      }
+      ++next;
+      ++i;
+      continue;
+    }
+    result.AddPart(std::move(parts.At(i)));
+  }
+  parts = std::move(result);
+  return packable.size();
+}
+
+size_t O2DataModelHelpers::expandCoalescedParts(fair::mq::Parts& parts, fair::mq::TransportFactory* transport)
+{
+  bool found = false;
+  for (size_t i = 0; i < parts.Size(); i += partSpan(parts, i)) {
+    if (isCoalesced(o2::header::get<o2::header::DataHeader*>(parts.At(i)->GetData()))) {
+      found = true;
+      break;
+    }
+  }
+  // Fast path, nothing to do.
+  if (found == false) {
+    return 0;
+  }
+
+  fair::mq::Parts result;
+  size_t expanded = 0;
+  for (size_t i = 0; i < parts.Size();) {
+    auto span = partSpan(parts, i);
+    auto* dh = o2::header::get<o2::header::DataHeader*>(parts.At(i)->GetData());
+    if (isCoalesced(dh) == false || i + 1 >= parts.Size()) {
+      for (size_t end = std::min(i + span, (size_t)parts.Size()); i < end; ++i) {
+        result.AddPart(std::move(parts.At(i)));
+      }
+      continue;
+    }
+    auto const* data = reinterpret_cast<char const*>(parts.At(i + 1)->GetData());
+    size_t size = parts.At(i + 1)->GetSize();
+    i += 2;
+    if (size < sizeof(CoalescedIndex)) {
+      LOGP(error, "Coalesced message too small ({} bytes). Dropping it.", size);
+      continue;
+    }
+    auto const* index = reinterpret_cast<CoalescedIndex const*>(data);
+    auto const* entries = reinterpret_cast<CoalescedEntry const*>(data + sizeof(CoalescedIndex));
+    size_t offset = sizeof(CoalescedIndex) + index->nParts * sizeof(CoalescedEntry);
+    size_t total = offset;
+    for (size_t ei = 0; offset <= size && ei < index->nParts; ++ei) {
+      total += entries[ei].headerSize + entries[ei].payloadSize;
+    }
+    if (offset > size || total > size) {
+      LOGP(error, "Coalesced message of {} bytes does not contain its {} parts. Dropping it.", size, index->nParts);
+      continue;
+    }
+    for (size_t ei = 0; ei < index->nParts; ++ei) {
+      auto header = transport->CreateMessage(entries[ei].headerSize);
+      memcpy(header->GetData(), data + offset, entries[ei].headerSize);
+      offset += entries[ei].headerSize;
+      auto payload = transport->CreateMessage(entries[ei].payloadSize);
+      memcpy(payload->GetData(), data + offset, entries[ei].payloadSize);
+      offset += entries[ei].payloadSize;
+      result.AddPart(std::move(header));
+      result.AddPart(std::move(payload));
+      ++expanded;
+    }
+  }
+  parts = std::move(result);
+  return expanded;
+}
 } // namespace o2::framework
@@ -16,23 +16,109 @@
 #include "Framework/DataTakingContext.h"
 #include "Framework/DeviceState.h"
 #include "Framework/DeviceContext.h"
+#include "Framework/DataProcessingStats.h"
 #include <fairmq/Device.h>
 #include <uv.h>
 #include <fairmq/shmem/Monitor.h>
 #include <fairmq/shmem/Common.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using namespace o2::framework;
 
+int64_t RateLimiter::getFreeSHM(ProcessingContext& ctx)
+{
+  auto device = ctx.services().get<RawDeviceService>().device();
+  auto& runningWorkflow = ctx.services().get<RunningWorkflowInfo const>();
+  long freeMemory = -1;
+  try {
+    freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
+  } catch (...) {
+  }
+  if (freeMemory == -1) {
+    try {
+      freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
+    } catch (...) {
+    }
+  }
+  if (freeMemory == -1) {
+    throw std::runtime_error("Could not obtain free SHM memory");
+  }
+  return freeMemory;
+}
+
+void RateLimiter::updateConsumed(int64_t consumed)
+{
+  if (!mSendTimes.empty() && consumed > mConsumedTimeframes && consumed <= mSentTimeframes) {
+    // Time it took for the last completed timeframe to go through the whole chain.
+    auto now = std::chrono::system_clock::now();
+    float latency = std::chrono::duration_cast<std::chrono::duration<float>>(now - mSendTimes[(consumed - 1) % mSendTimes.size()]).count();
+    mLatency = mLatency == 0.f ? latency : 0.9f * mLatency + 0.1f * latency;
+    // Let the base latency slowly drift up, so that we follow changes
+    // in the processing time per timeframe (e.g. pp vs PbPb).
+    mBaseLatency = mBaseLatency == 0.f ? latency : std::min(latency, mBaseLatency * 1.001f);
+    mNewlyConsumed += consumed - mConsumedTimeframes;
+  }
+  mConsumedTimeframes = consumed;
+}
+
+int RateLimiter::adaptWindow(int maxInFlight, int64_t freeSHM, size_t minSHM)
+{
+  if (mSendTimes.size() != (size_t)maxInFlight) {
+    mSendTimes.resize(maxInFlight);
+    // Start small and grow, so that we get a sensible base latency.
+    mWindow = std::min(2.f, (float)maxInFlight);
+  }
+  // Decrease at most once per window, to give time to the previous
+  // decision to have an effect.
+  bool canDecrease = mSentTimeframes - mLastDecrease >= (int64_t)mWindow;
+  if (minSHM && freeSHM >= 0 && freeSHM < 2 * (int64_t)minSHM) {
+    if (canDecrease) {
+      mWindow *= 0.5f;
+      mLastDecrease = mSentTimeframes;
+    }
+  } else if (mLatency > 0.f) {
+    // Number of timeframes waiting somewhere, rather than being processed.
+    float queued = mWindow * (1.f - mBaseLatency / mLatency);
+    if (queued > MAX_QUEUED_TIMEFRAMES) {
+      if (canDecrease) {
+        mWindow *= 0.75f;
+        mLastDecrease = mSentTimeframes;
+      }
+    } else if (queued < MIN_QUEUED_TIMEFRAMES) {
+      mWindow += mNewlyConsumed / mWindow;
+    }
+  }
+  mNewlyConsumed = 0;
+  mWindow = std::clamp(mWindow, 1.f, (float)maxInFlight);
+  return (int)mWindow;
+}
+
 int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
 {
   if (!maxInFlight && !minSHM) {
     return 0;
   }
+  static bool adaptive = getenv("DPL_ADAPTIVE_RATE_LIMITING") && atoi(getenv("DPL_ADAPTIVE_RATE_LIMITING"));
   auto device = ctx.services().get<RawDeviceService>().device();
   auto& deviceState = ctx.services().get<DeviceState>();
   if (maxInFlight && device->GetChannels().count("metric-feedback")) {
+    int window = maxInFlight;
+    int64_t freeSHM = -1;
+    if (adaptive) {
+      // Process the feedback we already have without blocking, so that
+      // the latency is tracked also when we are below the limit.
+      auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+      while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+        updateConsumed(*(int64_t*)msg->GetData());
+        msg = device->NewMessageFor("metric-feedback", 0, 0);
+      }
+      if (minSHM) {
+        freeSHM = getFreeSHM(ctx);
+      }
+      window = adaptWindow(maxInFlight, freeSHM, minSHM);
+    }
     auto& dtc = ctx.services().get<DataTakingContext>();
     const auto& device = ctx.services().get<RawDeviceService>().device();
     const auto& deviceContext = ctx.services().get<DeviceContext>();
@@ -42,12 +128,12 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
     int recvTimeout = 0;
     auto startTime = std::chrono::system_clock::now();
     static constexpr float MESSAGE_DELAY_TIME = 15.f;
-    while ((mSentTimeframes - mConsumedTimeframes) >= maxInFlight) {
+    while ((mSentTimeframes - mConsumedTimeframes) >= window) {
       if (recvTimeout != 0 && !waitMessage && (timeoutForMessage == false || std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::system_clock::now() - startTime).count() > MESSAGE_DELAY_TIME)) {
         if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
-          LOG(alarm) << "Maximum number of TF in flight reached (" << maxInFlight << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
+          LOG(alarm) << "Maximum number of TF in flight reached (" << window << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
         } else {
-          LOG(info) << "Maximum number of TF in flight reached (" << maxInFlight << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
+          LOG(info) << "Maximum number of TF in flight reached (" << window << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
         }
         waitMessage = true;
         timeoutForMessage = false;
@@ -66,13 +152,16 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         continue;
       }
       assert(msg->GetSize() == 8);
-      mConsumedTimeframes = *(int64_t*)msg->GetData();
+      updateConsumed(*(int64_t*)msg->GetData());
+      if (adaptive) {
+        window = adaptWindow(maxInFlight, freeSHM, minSHM);
+      }
     }
     if (waitMessage) {
       if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
-        LOG(important) << (mSentTimeframes - mConsumedTimeframes) << " / " << maxInFlight << " TF in flight, continuing to publish";
+        LOG(important) << (mSentTimeframes - mConsumedTimeframes) << " / " << window << " TF in flight, continuing to publish";
       } else {
-        LOG(info) << (mSentTimeframes - mConsumedTimeframes) << " / " << maxInFlight << " TF in flight, continuing to publish";
+        LOG(info) << (mSentTimeframes - mConsumedTimeframes) << " / " << window << " TF in flight, continuing to publish";
       }
     }
 
@@ -124,26 +213,18 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
       mLastTime = std::chrono::system_clock::now();
       mTfTimes[mSentTimeframes % maxInFlight] = curTime;
     }
+    if (adaptive) {
+      mSendTimes[mSentTimeframes % mSendTimes.size()] = std::chrono::system_clock::now();
+      auto& stats = ctx.services().get<DataProcessingStats>();
+      stats.updateStats({(int)ProcessingStatsId::RATE_LIMITER_WINDOW, DataProcessingStats::Op::Set, (int64_t)window});
+      stats.updateStats({(int)ProcessingStatsId::RATE_LIMITER_LATENCY_MS, DataProcessingStats::Op::Set, (int64_t)(mLatency * 1000.f)});
+      stats.updateStats({(int)ProcessingStatsId::RATE_LIMITER_BASE_LATENCY_MS, DataProcessingStats::Op::Set, (int64_t)(mBaseLatency * 1000.f)});
+    }
   }
   if (minSHM) {
     int waitMessage = 0;
-    auto& runningWorkflow = ctx.services().get<RunningWorkflowInfo const>();
     while (true) {
-      long freeMemory = -1;
-      try {
-        freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
-      } catch (...) {
-      }
-      if (freeMemory == -1) {
-        try {
-          freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
-        } catch (...) {
-        }
-      }
-      if (freeMemory == -1) {
-        throw std::runtime_error("Could not obtain free SHM memory");
-      }
-      uint64_t freeSHM = freeMemory;
+      uint64_t freeSHM = getFreeSHM(ctx);
       if (freeSHM > minSHM) {
         if (waitMessage) {
           LOG(important) << "Sufficient SHM memory free (" << freeSHM << " >= " << minSHM << "), continuing to publish";
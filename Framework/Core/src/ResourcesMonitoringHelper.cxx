@@ -11,6 +11,7 @@
 
 #include "ResourcesMonitoringHelper.h"
 #include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS
 #include <boost/property_tree/json_parser.hpp>
 #include <fstream>
@@ -172,3 +173,54 @@ bool ResourcesMonitoringHelper::dumpMetricsToJSON(const std::vector<DeviceMetric
 
   return true;
 }
+
+bool ResourcesMonitoringHelper::dumpBenchmarkReport(std::string const& filename,
+                                                    std::vector<DeviceMetricsInfo> const& metrics,
+                                                    std::vector<DeviceSpec> const& specs,
+                                                    std::vector<DeviceInfo> const& infos,
+                                                    uint64_t wallTimeMs) noexcept
+{
+  assert(metrics.size() == specs.size());
+  assert(infos.size() == specs.size());
+
+  // The counters only grow, so their maximum is their final value.
+  auto maxOf = [](DeviceMetricsInfo const& deviceMetrics, std::string const& name) -> double {
+    auto mi = DeviceMetricsHelper::metricIdxByName(name, deviceMetrics);
+    if (mi == deviceMetrics.metricLabels.size() || deviceMetrics.metrics[mi].filledMetrics == 0) {
+      return 0;
+    }
+    return deviceMetrics.max[mi];
+  };
+
+  boost::property_tree::ptree root;
+  root.put("wallTimeMs", wallTimeMs);
+  boost::property_tree::ptree devices;
+  for (size_t di = 0; di < specs.size(); ++di) {
+    auto const& deviceMetrics = metrics[di];
+    auto const& info = infos[di];
+    double processingTimeMs = maxOf(deviceMetrics, "total_wall_time_ms");
+    double timeframes = maxOf(deviceMetrics, "consumed-timeframes");
+
+    boost::property_tree::ptree device;
+    device.put("name", specs[di].name);
+    device.put("exitStatus", info.exitStatus);
+    device.put("cpuUserTimeS", info.userTime);
+    device.put("cpuSystemTimeS", info.systemTime);
+    device.put("maxResidentSetSizeKB", info.maxResidentSetSize);
+    device.put("processingTimeMs", processingTimeMs);
+    device.put("timeframes", timeframes);
+    device.put("processedBytes", maxOf(deviceMetrics, "total_processed_input_size_byte"));
+    device.put("timeframesPerSecond", processingTimeMs > 0 ? timeframes * 1000. / processingTimeMs : 0.);
+    device.put("peakHeldBytes", maxOf(deviceMetrics, "memory-peak-held-bytes"));
+    device.put("peakMallocInUseBytes", maxOf(deviceMetrics, "malloc-in-use-bytes"));
+    devices.add_child(specs[di].id, device);
+  }
+  root.add_child("devices", devices);
+
+  std::ofstream file(filename, std::ios::out);
+  if (!file.is_open()) {
+    return false;
+  }
+  boost::property_tree::json_parser::write_json(file, root);
+  return file.good();
+}
@@ -15,6 +15,7 @@
 #include "Framework/DeviceMetricsInfo.h"
 #include "Monitoring/ProcessMonitor.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/DeviceInfo.h"
 
 #include <vector>
 #include <type_traits>
@@ -30,6 +31,13 @@ struct ResourcesMonitoringHelper {
                                 DeviceMetricsInfo const& driverMetrics,
                                 std::vector<DeviceSpec> const& specs,
                                 std::vector<std::regex> const& metricsToDump) noexcept;
+  /// Dump to @a filename a summary of the resources used by each device of the run, meant
+  /// to be compared between software versions. @a wallTimeMs is the duration of the run.
+  static bool dumpBenchmarkReport(std::string const& filename,
+                                  std::vector<DeviceMetricsInfo> const& metrics,
+                                  std::vector<DeviceSpec> const& specs,
+                                  std::vector<DeviceInfo> const& infos,
+                                  uint64_t wallTimeMs) noexcept;
   static bool isResourcesMonitoringEnabled(unsigned short interval) noexcept { return interval > 0; }
 };
 
@@ -14,6 +14,7 @@
 #include "Framework/DataRefUtils.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Framework/DataRelayer.h"
+#include "Framework/O2DataModelHelpers.h"
 #include "Headers/DataHeaderHelpers.h"
 #include "Framework/Logger.h"
 #include "Headers/STFHeader.h"
@@ -90,6 +91,28 @@ std::vector<SendingPolicy> SendingPolicy::createDefaultPolicies()
               } else {
                 state.droppedMessages++;
               } }},
+          SendingPolicy{
+            .name = "coalescing",
+            .matcher = [](DataProcessorSpec const& source, DataProcessorSpec const& dest, ConfigContext const&) {
+              auto has_label = [](DataProcessorLabel const& label) {
+                return label.value == "coalesce-outputs";
+              };
+              return std::find_if(source.labels.begin(), source.labels.end(), has_label) != source.labels.end(); },
+            .send = [](fair::mq::Parts& parts, ChannelIndex channelIndex, ServiceRegistryRef registry) {
+              // Payloads smaller than this are packed in a single message.
+              static size_t threshold = getenv("DPL_COALESCE_THRESHOLD") ? std::stoul(getenv("DPL_COALESCE_THRESHOLD")) : 4096;
+              auto &proxy = registry.get<FairMQDeviceProxy>();
+              auto *channel = proxy.getOutputChannel(channelIndex);
+              O2DataModelHelpers::coalesceSmallParts(parts, channel->Transport(), threshold);
+              auto timeout = 1000;
+              auto res = channel->Send(parts, timeout);
+              if (res == (size_t)fair::mq::TransferCode::timeout) {
+                LOGP(warning, "Timed out sending after {}s. Downstream backpressure detected on {}.", timeout/1000, channel->GetName());
+                channel->Send(parts);
+                LOGP(info, "Downstream backpressure on {} recovered.", channel->GetName());
+              } else if (res == (size_t) fair::mq::TransferCode::error) {
+                LOGP(fatal, "Error while sending on channel {}", channel->GetName());
+              } }},
           SendingPolicy{
             .name = "default",
             .matcher = [](DataProcessorSpec const&, DataProcessorSpec const&, ConfigContext const&) { return true; },
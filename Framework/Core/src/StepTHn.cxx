@@ -15,6 +15,7 @@
 // this storage container is optimized for small memory usage
 //   under/over flow bins do not exist
 //   sumw2 structure is float only and only create when the weight != 1
+//   with setBlockSize(), the bins are stored in blocks allocated only when filled (block sparse storage)
 //
 // Templated version allows also the use of double as storage container
 
@@ -26,6 +27,8 @@
 #include "THn.h"
 #include "TMath.h"
 
+#include <algorithm>
+
 ClassImp(StepTHn);
 templateClassImp(StepTHnT);
 
@@ -39,7 +42,8 @@ StepTHn::StepTHn() : mNBins(0),
                      mNbinsCache(nullptr),
                      mLastVars(nullptr),
                      mLastBins(nullptr),
-                     mPrototype(nullptr)
+                     mPrototype(nullptr),
+                     mBlockSize(0)
 {
   // Default constructor (for streaming)
 }
@@ -55,7 +59,8 @@ StepTHn::StepTHn(const Char_t* name, const Char_t* title, const Int_t nSteps, co
                                                                                                    mNbinsCache(nullptr),
                                                                                                    mLastVars(nullptr),
                                                                                                    mLastBins(nullptr),
-                                                                                                   mPrototype(nullptr)
+                                                                                                   mPrototype(nullptr),
+                                                                                                   mBlockSize(0)
 {
   // Constructor
   //
@@ -130,7 +135,8 @@ StepTHn::StepTHn(const StepTHn& c) : mNBins(c.mNBins),
                                      mNbinsCache(nullptr),
                                      mLastVars(nullptr),
                                      mLastBins(nullptr),
-                                     mPrototype(nullptr)
+                                     mPrototype(nullptr),
+                                     mBlockSize(0)
 {
   //
   // StepTHn copy constructor
@@ -174,6 +180,10 @@ void StepTHn::deleteContainers()
       delete mTarget[i];
       mTarget[i] = nullptr;
     }
+
+    if (i < (Int_t)mBlocks.size()) {
+      mBlocks[i].clear();
+    }
   }
 }
 
@@ -219,6 +229,72 @@ void StepTHn::Copy(TObject& c) const
   if (mPrototype) {
     target.mPrototype = dynamic_cast<THnSparse*>(mPrototype->Clone());
   }
+
+  target.mBlockSize = mBlockSize;
+  target.mBlocks = mBlocks;
+}
+
+void StepTHn::setBlockSize(Int_t blockSize)
+{
+  // switches between dense (blockSize == 0) and block sparse storage
+
+  for (Int_t i = 0; i < mNSteps; i++) {
+    if (mValues[i]) {
+      LOGF(fatal, "StepTHn %s: the storage cannot be changed after filling.", GetName());
+    }
+  }
+  if (blockSize < 0) {
+    LOGF(fatal, "StepTHn %s: invalid block size %d.", GetName(), blockSize);
+  }
+  mBlockSize = blockSize;
+  mBlocks.clear();
+  if (mBlockSize > 0) {
+    mBlocks.resize(mNSteps);
+  }
+}
+
+Long64_t StepTHn::findStorageIndex(Int_t step, Long64_t globalBin) const
+{
+  if (mBlockSize == 0) {
+    return globalBin;
+  }
+  auto const& blocks = mBlocks[step];
+  Long64_t block = globalBin / mBlockSize;
+  if (block >= (Long64_t)blocks.size() || blocks[block] == -1) {
+    return -1;
+  }
+  return (Long64_t)blocks[block] * mBlockSize + globalBin % mBlockSize;
+}
+
+Long64_t StepTHn::getStorageIndex(Int_t step, Long64_t globalBin)
+{
+  if (mBlockSize == 0) {
+    return globalBin;
+  }
+  auto& blocks = mBlocks[step];
+  if (blocks.empty()) {
+    blocks.assign((mNBins + mBlockSize - 1) / mBlockSize, -1);
+  }
+  Long64_t block = globalBin / mBlockSize;
+  if (blocks[block] == -1) {
+    // append a new block to the containers
+    Long64_t size = mValues[step]->GetSize();
+    blocks[block] = size / mBlockSize;
+    mValues[step]->Set(size + mBlockSize);
+    if (mSumw2[step]) {
+      mSumw2[step]->Set(size + mBlockSize);
+    }
+  }
+  return (Long64_t)blocks[block] * mBlockSize + globalBin % mBlockSize;
+}
+
+Double_t StepTHn::getBinContent(Int_t step, Long64_t globalBin) const
+{
+  if (!mValues[step]) {
+    return 0;
+  }
+  auto index = findStorageIndex(step, globalBin);
+  return index == -1 ? 0 : mValues[step]->GetAt(index);
 }
 
 template <class TemplateArray>
@@ -247,6 +323,11 @@ Long64_t StepTHnT<TemplateArray>::Merge(TCollection* list)
     }
 
     for (Int_t i = 0; i < mNSteps; i++) {
+      if (mBlockSize != 0 || entry->mBlockSize != 0) {
+        mergeBlocks(entry, i);
+        continue;
+      }
+
       if (entry->mValues[i]) {
         if (!mValues[i]) {
           mValues[i] = createArray();
@@ -278,6 +359,85 @@ Long64_t StepTHnT<TemplateArray>::Merge(TCollection* list)
   return count + 1;
 }
 
+template <class TemplateArray>
+void StepTHnT<TemplateArray>::mergeBlocks(const StepTHnT<TemplateArray>* entry, Int_t step)
+{
+  // adds step of entry to this, when at least one of them uses block sparse storage
+  // the work scales with the number of filled blocks of entry, rather than with the number of bins
+
+  if (!entry->mValues[step]) {
+    return;
+  }
+  if (!mValues[step]) {
+    mValues[step] = mBlockSize ? createEmptyArray(0) : createArray();
+  }
+  if (entry->mSumw2[step] && !mSumw2[step]) {
+    mSumw2[step] = createEmptyArray(mValues[step]->GetSize());
+  }
+
+  // a dense container is handled as a single block
+  Long64_t sourceBlockSize = entry->mBlockSize ? entry->mBlockSize : mNBins;
+  std::vector<Int_t> denseBlocks{0};
+  auto const& sourceBlocks = entry->mBlockSize ? entry->mBlocks[step] : denseBlocks;
+
+  for (Long64_t block = 0; block < (Long64_t)sourceBlocks.size(); block++) {
+    if (sourceBlocks[block] == -1) {
+      continue;
+    }
+    Long64_t first = block * sourceBlockSize;
+    Long64_t last = std::min(first + sourceBlockSize, mNBins);
+    Long64_t sourceOffset = sourceBlocks[block] * sourceBlockSize - first;
+    auto sourceValues = dynamic_cast<TemplateArray*>(entry->mValues[step])->GetArray() + sourceOffset;
+    auto sourceSumw2 = entry->mSumw2[step] ? dynamic_cast<TemplateArray*>(entry->mSumw2[step])->GetArray() + sourceOffset : nullptr;
+
+    if (mBlockSize == entry->mBlockSize) {
+      // same layout: add the whole block at once
+      Long64_t targetOffset = getStorageIndex(step, first) - first;
+      auto targetValues = dynamic_cast<TemplateArray*>(mValues[step])->GetArray() + targetOffset;
+      for (Long64_t l = first; l < last; l++) {
+        targetValues[l] += sourceValues[l];
+      }
+      if (sourceSumw2) {
+        auto targetSumw2 = dynamic_cast<TemplateArray*>(mSumw2[step])->GetArray() + targetOffset;
+        for (Long64_t l = first; l < last; l++) {
+          targetSumw2[l] += sourceSumw2[l];
+        }
+      }
+      continue;
+    }
+
+    for (Long64_t l = first; l < last; l++) {
+      if (sourceValues[l] == 0 && (!sourceSumw2 || sourceSumw2[l] == 0)) {
+        continue;
+      }
+      auto index = getStorageIndex(step, l);
+      mValues[step]->SetAt(mValues[step]->GetAt(index) + sourceValues[l], index);
+      if (sourceSumw2) {
+        mSumw2[step]->SetAt(mSumw2[step]->GetAt(index) + sourceSumw2[l], index);
+      }
+    }
+  }
+}
+
+template <class TemplateArray>
+void StepTHnT<TemplateArray>::Reset()
+{
+  // zero the data containers, keeping them allocated
+
+  for (Int_t i = 0; i < mNSteps; i++) {
+    if (mValues[i]) {
+      dynamic_cast<TemplateArray*>(mValues[i])->Reset();
+    }
+    if (mSumw2[i]) {
+      dynamic_cast<TemplateArray*>(mSumw2[i])->Reset();
+    }
+    if (mTarget && mTarget[i]) {
+      delete mTarget[i];
+      mTarget[i] = nullptr;
+    }
+  }
+}
+
 Long64_t StepTHn::getGlobalBinIndex(const Int_t* binIdx)
 {
   // calculates global bin index
@@ -345,10 +505,11 @@ void StepTHn::createTarget(Int_t step, Bool_t sparse)
     //       Printf(" --> %lld", globalBin);
 
     // TODO probably slow
-    double value = source->GetAt(globalBin);
+    Long64_t index = findStorageIndex(step, globalBin);
+    double value = (index == -1) ? 0 : source->GetAt(index);
     if (value != 0) {
       target->SetBinContent(binIdx, value);
-      target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2->GetAt(globalBin)));
+      target->SetBinError(binIdx, TMath::Sqrt(sourceSumw2->GetAt(index)));
 
       count++;
     }
@@ -374,6 +535,12 @@ void StepTHn::createTarget(Int_t step, Bool_t sparse)
 
   delete mValues[step];
   mValues[step] = nullptr;
+  if (mBlockSize) {
+    // the block layout is shared with the sumw2 container
+    delete mSumw2[step];
+    mSumw2[step] = nullptr;
+    mBlocks[step].clear();
+  }
 }
 
 void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
@@ -434,22 +601,23 @@ void StepTHn::Fill(int iStep, int nParams, double positionAndWeight[])
   }
 
   if (!mValues[iStep]) {
-    mValues[iStep] = createArray();
+    mValues[iStep] = mBlockSize ? createEmptyArray(0) : createArray();
     LOGF(info, "Created values container for step %d", iStep);
   }
 
   if (weight != 1.) {
     // initialize with already filled entries (which have been filled with weight == 1), in this case mSumw2 := mValues
     if (!mSumw2[iStep]) {
-      mSumw2[iStep] = createArray();
+      mSumw2[iStep] = createEmptyArray(mValues[iStep]->GetSize());
       LOGF(info, "Created sumw2 container for step %d", iStep);
     }
   }
 
   // TODO probably slow; add StepTHnT::add ?
-  mValues[iStep]->SetAt(mValues[iStep]->GetAt(bin) + weight, bin);
+  Long64_t index = getStorageIndex(iStep, bin);
+  mValues[iStep]->SetAt(mValues[iStep]->GetAt(index) + weight, index);
   if (mSumw2[iStep]) {
-    mSumw2[iStep]->SetAt(mSumw2[iStep]->GetAt(bin) + weight, bin);
+    mSumw2[iStep]->SetAt(mSumw2[iStep]->GetAt(index) + weight, index);
   }
 }
 
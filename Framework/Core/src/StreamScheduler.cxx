@@ -0,0 +1,154 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/StreamScheduler.h"
+#include "Framework/Signpost.h"
+
+O2_DECLARE_DYNAMIC_LOG(stream_scheduler);
+
+namespace o2::framework
+{
+
+void StreamScheduler::resize(size_t nStreams)
+{
+  while (mQueues.size() < nStreams) {
+    mQueues.emplace_back(std::make_unique<Queue>());
+  }
+}
+
+void StreamScheduler::push(size_t stream, std::vector<DataRelayer::RecordAction> const& actions)
+{
+  assert(stream < mQueues.size());
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  for (auto& action : actions) {
+    if (action.op == CompletionPolicy::CompletionOp::Wait) {
+      continue;
+    }
+    queue.actions.push_back(action);
+  }
+}
+
+bool StreamScheduler::pop(size_t stream, DataRelayer::RecordAction& action, bool allowSteal)
+{
+  assert(stream < mQueues.size());
+  {
+    auto& queue = *mQueues[stream];
+    std::scoped_lock lock(queue.mutex);
+    if (!queue.actions.empty()) {
+      action = queue.actions.front();
+      queue.actions.pop_front();
+      queue.stats.executed++;
+      return true;
+    }
+  }
+  if (!allowSteal) {
+    return false;
+  }
+  // Our own queue is empty. Find the most loaded victim without holding
+  // more than one lock at the time, then try to take its most recent action.
+  // If someone else was faster we simply try again with the next best one.
+  while (true) {
+    size_t victim = -1;
+    size_t victimDepth = 0;
+    for (size_t qi = 0; qi < mQueues.size(); ++qi) {
+      if (qi == stream) {
+        continue;
+      }
+      auto depth = queueDepth(qi);
+      if (depth > victimDepth) {
+        victim = qi;
+        victimDepth = depth;
+      }
+    }
+    if (victimDepth == 0) {
+      return false;
+    }
+    auto& queue = *mQueues[victim];
+    std::scoped_lock lock(queue.mutex);
+    if (queue.actions.empty()) {
+      continue;
+    }
+    action = queue.actions.back();
+    queue.actions.pop_back();
+    O2_SIGNPOST_ID_GENERATE(sid, stream_scheduler);
+    O2_SIGNPOST_EVENT_EMIT(stream_scheduler, sid, "steal", "Stream %zu stole slot %zu from stream %zu", stream, action.slot.index, victim);
+    break;
+  }
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  queue.stats.executed++;
+  queue.stats.steals++;
+  return true;
+}
+
+size_t StreamScheduler::queueDepth() const
+{
+  size_t depth = 0;
+  for (size_t qi = 0; qi < mQueues.size(); ++qi) {
+    depth += queueDepth(qi);
+  }
+  return depth;
+}
+
+size_t StreamScheduler::queueDepth(size_t stream) const
+{
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  return queue.actions.size();
+}
+
+void StreamScheduler::markIdle(size_t stream, uint64_t now)
+{
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  if (queue.idleSince == 0) {
+    queue.idleSince = now;
+  }
+}
+
+void StreamScheduler::markBusy(size_t stream, uint64_t now)
+{
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  if (queue.idleSince != 0 && now > queue.idleSince) {
+    queue.stats.idleTime += now - queue.idleSince;
+  }
+  queue.idleSince = 0;
+}
+
+StreamScheduler::StreamStats StreamScheduler::stats(size_t stream) const
+{
+  auto& queue = *mQueues[stream];
+  std::scoped_lock lock(queue.mutex);
+  return queue.stats;
+}
+
+StreamScheduler::StreamStats StreamScheduler::totalStats() const
+{
+  StreamStats total;
+  for (size_t qi = 0; qi < mQueues.size(); ++qi) {
+    auto s = stats(qi);
+    total.executed += s.executed;
+    total.steals += s.steals;
+    total.idleTime += s.idleTime;
+  }
+  return total;
+}
+
+void StreamScheduler::clear()
+{
+  for (auto& queue : mQueues) {
+    std::scoped_lock lock(queue->mutex);
+    queue->actions.clear();
+  }
+}
+
+} // namespace o2::framework
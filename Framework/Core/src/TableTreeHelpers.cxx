@@ -11,11 +11,14 @@
 #include "Framework/TableTreeHelpers.h"
 #include "Framework/Logger.h"
 #include "Framework/Endian.h"
+#include "Framework/ArrowTableSlicingCache.h"
 
 #include "arrow/type_traits.h"
 #include <arrow/util/key_value_metadata.h>
 #include <TBufferFile.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <utility>
 namespace TableTreeHelpers
 {
@@ -533,14 +536,39 @@ void TreeToTable::addAllColumns(TTree* tree, std::vector<std::string>&& names)
   if (mBranchReaders.empty()) {
     throw runtime_error("No columns will be read");
   }
-  //tree->SetCacheSize(50000000);
-  // FIXME: see https://github.com/root-project/root/issues/8962 and enable
-  // again once fixed.
-  //tree->SetClusterPrefetch(true);
-  //for (auto& reader : mBranchReaders) {
-  //  tree->AddBranchToCache(reader->branch());
-  //}
-  //tree->StopCacheLearningPhase();
+  // FIXME: see https://github.com/root-project/root/issues/8962. The
+  // TTreeCache is only enabled on request until we are sure it is fixed
+  // in the ROOT versions we use.
+  static bool useTreeCache = getenv("DPL_AOD_TREE_CACHE") && atoi(getenv("DPL_AOD_TREE_CACHE"));
+  if (useTreeCache) {
+    setupTreeCache(tree);
+  }
+}
+
+void TreeToTable::setupTreeCache(TTree* tree)
+{
+  // The cache is sized so that the baskets of all the branches we read,
+  // including the size branches of VLAs, fit in it in one go.
+  constexpr Long64_t minCacheSize = 1 * 1024 * 1024;
+  constexpr Long64_t maxCacheSize = 512 * 1024 * 1024;
+  std::vector<TBranch*> branches;
+  Long64_t cacheSize = 0;
+  for (auto& reader : mBranchReaders) {
+    branches.push_back(reader->branch());
+    auto sizeBranch = tree->GetBranch((std::string{reader->branch()->GetName()} + TableTreeHelpers::sizeBranchSuffix).c_str());
+    if (sizeBranch) {
+      branches.push_back(sizeBranch);
+    }
+  }
+  for (auto* branch : branches) {
+    cacheSize += branch->GetZipBytes("*");
+  }
+  tree->SetCacheSize(std::clamp(cacheSize + cacheSize / 10, minCacheSize, maxCacheSize));
+  tree->SetClusterPrefetch(true);
+  for (auto* branch : branches) {
+    tree->AddBranchToCache(branch);
+  }
+  tree->StopCacheLearningPhase();
 }
 
 void TreeToTable::setLabel(const char* label)
@@ -552,7 +580,9 @@ void TreeToTable::fill(TTree*)
 {
   std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
   std::vector<std::shared_ptr<arrow::Field>> fields;
-  static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+  // Trees might be read concurrently from different threads, e.g. by the
+  // AOD reader read-ahead, hence we need one buffer per thread.
+  static thread_local TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
   for (auto& reader : mBranchReaders) {
     buffer.Reset();
     auto arrayAndField = reader->read(&buffer);
@@ -566,7 +596,7 @@ void TreeToTable::fill(TTree*)
 
 void TreeToTable::addReader(TBranch* branch, std::string const& name, bool VLA)
 {
-  static TClass* cls;
+  TClass* cls = nullptr;
   EDataType type;
   branch->GetExpectedType(cls, type);
   auto listSize = -1;
@@ -581,4 +611,9 @@ std::shared_ptr<arrow::Table> TreeToTable::finalize()
   return mTable;
 }
 
+void TreeToTable::addGroupIndex()
+{
+  mTable = ArrowTableSlicingCache::addGroupIndex(mTable);
+}
+
 } // namespace o2::framework
@@ -27,7 +27,11 @@ void TimesliceIndex::resize(size_t s)
 {
   mVariables.resize(s);
   mPublishedVariables.resize(s);
-  mDirty.resize(s, false);
+  mDirty.resize((s + 63) / 64, 0);
+  // Make sure that slots which are added later on start clean.
+  if (s % 64) {
+    mDirty.back() &= (1ULL << (s % 64)) - 1;
+  }
 }
 
 void TimesliceIndex::associate(TimesliceId timestamp, TimesliceSlot slot)
@@ -35,7 +39,7 @@ void TimesliceIndex::associate(TimesliceId timestamp, TimesliceSlot slot)
   assert(mVariables.size() > slot.index);
   mVariables[slot.index].put({0, static_cast<uint64_t>(timestamp.value)});
   mVariables[slot.index].commit();
-  mDirty[slot.index] = true;
+  markAsDirty(slot, true);
   O2_SIGNPOST_ID_GENERATE(tid, timeslice_index);
   O2_SIGNPOST_EVENT_EMIT(timeslice_index, tid, "associate", "Associating timestamp %zu to slot %zu", timestamp.value, slot.index);
 }
@@ -180,7 +184,7 @@ TimesliceIndex::OldestInputInfo TimesliceIndex::setOldestPossibleInput(Timeslice
 
 bool TimesliceIndex::validateSlot(TimesliceSlot slot, TimesliceId currentOldest)
 {
-  if (mDirty[slot.index] == true) {
+  if (isDirty(slot)) {
     return true;
   }
 
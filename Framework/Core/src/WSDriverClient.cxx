@@ -18,6 +18,7 @@
 #include "DPLWebSocket.h"
 #include "Framework/Signpost.h"
 #include <uv.h>
+#include <unistd.h>
 #include <string_view>
 #include <charconv>
 
@@ -203,6 +204,61 @@ void on_connect(uv_connect_t* connection, int status)
     }
   });
 
+  client->observe("/signpost-trace", [ref = context->ref](std::string_view cmd) {
+    auto& state = ref.get<DeviceState>();
+    static constexpr int prefixSize = std::string_view{"/signpost-trace "}.size();
+    if (prefixSize > cmd.size()) {
+      LOG(error) << "Malformed signpost-trace request";
+      return;
+    }
+    cmd.remove_prefix(prefixSize);
+    int traceStreams = 0;
+
+    auto error = std::from_chars(cmd.data(), cmd.data() + cmd.size(), traceStreams);
+    if (error.ec != std::errc()) {
+      LOG(error) << "Malformed signpost-trace mask";
+      return;
+    }
+    LOGP(info, "Tracestreams flags set to {}", traceStreams);
+    state.traceStreams = traceStreams;
+    if ((state.traceStreams & DeviceState::LogStreams::DEVICE_LOG) != 0) {
+      O2_LOG_TRACE_ENABLE(device);
+    } else {
+      O2_LOG_TRACE_DISABLE(device);
+    }
+    if ((state.traceStreams & DeviceState::LogStreams::COMPLETION_LOG) != 0) {
+      O2_LOG_TRACE_ENABLE(completion);
+    } else {
+      O2_LOG_TRACE_DISABLE(completion);
+    }
+    if ((state.traceStreams & DeviceState::LogStreams::MONITORING_SERVICE_LOG) != 0) {
+      O2_LOG_TRACE_ENABLE(monitoring_service);
+    } else {
+      O2_LOG_TRACE_DISABLE(monitoring_service);
+    }
+    if ((state.traceStreams & DeviceState::LogStreams::DATA_PROCESSOR_CONTEXT_LOG) != 0) {
+      O2_LOG_TRACE_ENABLE(data_processor_context);
+    } else {
+      O2_LOG_TRACE_DISABLE(data_processor_context);
+    }
+    if ((state.traceStreams & DeviceState::LogStreams::STREAM_CONTEXT_LOG) != 0) {
+      O2_LOG_TRACE_ENABLE(stream_context);
+    } else {
+      O2_LOG_TRACE_DISABLE(stream_context);
+    }
+  });
+
+  client->observe("/signpost-dump", [ref = context->ref](std::string_view) {
+    auto& spec = ref.get<DeviceSpec const>();
+    auto filename = fmt::format("dpl-trace-{}-{}.json", spec.id, getpid());
+    auto written = o2_trace_dump(filename.c_str());
+    if (written < 0) {
+      LOGP(error, "Unable to write the signposts trace to {}", filename);
+      return;
+    }
+    LOGP(info, "{} signposts written to {}. Open it with https://ui.perfetto.dev", written, filename);
+  });
+
   // Client will be filled in the line after. I can probably have a single
   // client per device.
   auto dplClient = std::make_unique<WSDPLClient>();
@@ -58,13 +58,16 @@ std::vector<ConfigParamSpec> WorkflowCustomizationHelpers::requiredWorkflowOptio
            // aod-file needs to be available as workflow option, because we
            // can configure the workflow based on the contents of the first file.
            {"aod-file", VariantType::String, "", {"Input AOD file"}},
+           {"aod-derived-cache", VariantType::String, "", {"Directory where the tables produced by tasks which only depend on the input AOD are cached"}},
            // options for AOD writer
            {"aod-writer-json", VariantType::String, "", {"Name of the json configuration file"}},
            {"aod-writer-resdir", VariantType::String, "", {"Name of the output directory"}},
            {"aod-writer-resfile", VariantType::String, "", {"Default name of the output file"}},
            {"aod-writer-maxfilesize", VariantType::Float, 0.0f, {"Maximum size of an output file in megabytes"}},
            {"aod-writer-resmode", VariantType::String, "RECREATE", {"Creation mode of the result files: NEW, CREATE, RECREATE, UPDATE"}},
+           {"aod-writer-resformat", VariantType::String, "", {"Format of the result files: root (TTrees, default) or arrow (memory mappable arrow IPC files)"}},
            {"aod-writer-ntfmerge", VariantType::Int, -1, {"Number of time frames to merge into one file"}},
+           {"aod-writer-queue-depth", VariantType::Int, 0, {"Number of time frames queued for writing in a background thread (0: write in the processing callback)"}},
            {"aod-writer-keep", VariantType::String, "", {"Comma separated list of ORIGIN/DESCRIPTION/SUBSPECIFICATION:treename:col1/col2/..:filename"}},
 
            {"fairmq-rate-logging", VariantType::Int, 0, {"Rate logging for FairMQ channels"}},
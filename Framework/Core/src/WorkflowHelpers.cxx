@@ -24,11 +24,17 @@
 #include "Framework/PluginManager.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/DefaultsHelpers.h"
+#include "Framework/VariantHelpers.h"
 
 #include "Headers/DataHeader.h"
 #include <algorithm>
+#include <functional>
 #include <list>
+#include <numeric>
+#include <optional>
 #include <set>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <climits>
@@ -206,6 +212,90 @@ void WorkflowHelpers::addMissingOutputsToBuilder(std::vector<InputSpec> const& r
   }
 }
 
+void WorkflowHelpers::useDerivedTableCache(WorkflowSpec& workflow, ConfigContext const& ctx, std::string const& cacheDir,
+                                           std::vector<DerivedTableCacheEntry>& cached,
+                                           std::vector<DerivedTableCacheEntry>& toStore)
+{
+  auto inputFiles = DerivedTableCache::inputFiles(ctx.options().get<std::string>("aod-file"));
+  std::string prefix = "internal-dpl-";
+
+  // A task can be cached if it only produces tables and only consumes
+  // tables from the input or from other tasks which can be cached. Its
+  // hash then includes theirs. An empty hash means it cannot be cached.
+  std::vector<std::optional<std::string>> hashes(workflow.size());
+  std::function<std::string const&(size_t)> hashOf = [&](size_t wi) -> std::string const& {
+    if (hashes[wi]) {
+      return *hashes[wi];
+    }
+    hashes[wi] = "";
+    auto const& processor = workflow[wi];
+    bool cacheable = processor.name.compare(0, prefix.size(), prefix) != 0 &&
+                     !processor.inputs.empty() && !processor.outputs.empty() &&
+                     std::all_of(processor.outputs.begin(), processor.outputs.end(), [](auto const& output) { return DataSpecUtils::partialMatch(output, AODOrigins); });
+    std::vector<std::string> upstream;
+    for (auto const& input : processor.inputs) {
+      if (!cacheable) {
+        break;
+      }
+      if (!DataSpecUtils::partialMatch(input, extendedAODOrigins) && !DataSpecUtils::partialMatch(input, header::DataOrigin{"IDX"})) {
+        cacheable = false;
+        break;
+      }
+      for (size_t pi = 0; pi < workflow.size(); ++pi) {
+        auto const& outputs = workflow[pi].outputs;
+        if (pi == wi || std::none_of(outputs.begin(), outputs.end(), [&input](auto const& output) { return DataSpecUtils::match(input, output); })) {
+          continue;
+        }
+        auto const& hash = hashOf(pi);
+        if (hash.empty()) {
+          cacheable = false;
+          break;
+        }
+        upstream.push_back(hash);
+      }
+    }
+    if (cacheable) {
+      hashes[wi] = DerivedTableCache::configurationHash(processor, ctx.argc(), ctx.argv(), upstream);
+    }
+    return *hashes[wi];
+  };
+
+  auto isConsumed = [&workflow](size_t wi, OutputSpec const& output) {
+    for (size_t ci = 0; ci < workflow.size(); ++ci) {
+      auto const& inputs = workflow[ci].inputs;
+      if (ci != wi && std::any_of(inputs.begin(), inputs.end(), [&output](auto const& input) { return DataSpecUtils::match(input, output); })) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<size_t> toRemove;
+  for (size_t wi = 0; wi < workflow.size(); ++wi) {
+    auto const& hash = hashOf(wi);
+    if (hash.empty()) {
+      continue;
+    }
+    auto const& processor = workflow[wi];
+    DerivedTableCacheEntry entry{hash, processor.outputs};
+    // Tables which are not consumed are there to be written out, so the
+    // task has to run in any case.
+    bool complete = std::all_of(inputFiles.begin(), inputFiles.end(), [&](auto const& file) { return DerivedTableCache::isComplete(DerivedTableCache::entryPath(cacheDir, hash, file)); });
+    bool consumed = std::all_of(processor.outputs.begin(), processor.outputs.end(), [&](auto const& output) { return isConsumed(wi, output); });
+    if (complete && consumed) {
+      LOGP(info, "Tables of {} are read from the derived table cache {}/{}", processor.name, cacheDir, hash);
+      cached.emplace_back(entry);
+      toRemove.push_back(wi);
+    } else {
+      LOGP(info, "Tables of {} will be stored in the derived table cache {}/{}", processor.name, cacheDir, hash);
+      toStore.emplace_back(entry);
+    }
+  }
+  for (auto wi = toRemove.rbegin(); wi != toRemove.rend(); ++wi) {
+    workflow.erase(workflow.begin() + *wi);
+  }
+}
+
 // get the default value for condition-backend
 std::string defaultConditionBackend()
 {
@@ -256,6 +346,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 {"condition-tf-per-query", VariantType::Int, defaultConditionQueryRate(), {"check condition validity per requested number of TFs, fetch only once if <=0"}},
                 {"condition-tf-per-query-multiplier", VariantType::Int, defaultConditionQueryRateMultiplier(), {"check conditions once per this amount of nominal checks"}},
                 {"condition-time-tolerance", VariantType::Int64, 5000ll, {"prefer creation time if its difference to orbit-derived time exceeds threshold (ms), impose if <0"}},
+                {"condition-prefetch-ms", VariantType::Int64, 0ll, {"fetch in background the next object this many ms before the end of validity of the current one, 0 disables"}},
                 {"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
                 {"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
                 {"start-value-enumeration", VariantType::Int64, 0ll, {"initial value for the enumeration"}},
@@ -304,6 +395,25 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 ConfigParamSpec{"step-value-enumeration", VariantType::Int64, 1ll, {"step between one value and the other"}}},
     .requiredServices = CommonServices::defaultServices("O2FrameworkAnalysisSupport:RunSummary")};
 
+  // Tasks whose tables are read from, or stored in, the derived table cache
+  std::vector<DerivedTableCacheEntry> cachedTables;
+  std::vector<DerivedTableCacheEntry> tablesToCache;
+  std::string derivedTableCache;
+  if (ctx.options().isSet("aod-derived-cache") && !ctx.options().get<std::string>("aod-file").empty()) {
+    derivedTableCache = ctx.options().get<std::string>("aod-derived-cache");
+  }
+  if (!derivedTableCache.empty()) {
+    useDerivedTableCache(workflow, ctx, derivedTableCache, cachedTables, tablesToCache);
+    std::string tables;
+    for (auto const& entry : cachedTables) {
+      for (auto const& output : entry.outputs) {
+        tables += (tables.empty() ? "" : ",") + entry.hash + ":" + DataSpecUtils::describe(output);
+      }
+    }
+    aodReader.options.emplace_back(ConfigParamSpec{"aod-derived-cache-private", VariantType::String, derivedTableCache, {"Derived table cache"}});
+    aodReader.options.emplace_back(ConfigParamSpec{"aod-derived-cache-tables-private", VariantType::String, tables, {"Tables read from the derived table cache, as hash:table"}});
+  }
+
   // AOD reader can be rate limited
   int rateLimitingIPCID = std::stoi(ctx.options().get<std::string>("timeframes-rate-limit-ipcid"));
   std::string rateLimitingChannelConfigInput;
@@ -689,6 +799,11 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
     isDangling[ii] = false;
   }
 
+  // the tables of the tasks which were not found in the cache
+  if (!tablesToCache.empty()) {
+    extraSpecs.push_back(CommonDataProcessors::getDerivedTableCacheSink(derivedTableCache, tablesToCache));
+  }
+
   workflow.insert(workflow.end(), extraSpecs.begin(), extraSpecs.end());
   extraSpecs.clear();
 
@@ -822,6 +937,19 @@ void WorkflowHelpers::adjustTopology(WorkflowSpec& workflow, ConfigContext const
   }
 }
 
+namespace
+{
+struct ConcreteDataMatcherHash {
+  size_t operator()(ConcreteDataMatcher const& matcher) const
+  {
+    size_t h = std::hash<std::string_view>{}(std::string_view(matcher.origin.str, matcher.origin.size));
+    h ^= std::hash<std::string_view>{}(std::string_view(matcher.description.str, matcher.description.size)) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<uint32_t>{}(matcher.subSpec) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+  }
+};
+} // namespace
+
 void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
                                      std::vector<DeviceConnectionEdge>& logicalEdges,
                                      std::vector<OutputSpec>& outputs,
@@ -876,12 +1004,48 @@ void WorkflowHelpers::constructGraph(const WorkflowSpec& workflow,
   // parallel pipeline and add an edge for each.
   enumerateAvailableOutputs();
 
+  // Index the outputs which have a concrete matcher, so that for concrete
+  // inputs we only need to check those with the same triplet (and the
+  // wildcard ones), rather than all the outputs of the workflow.
+  std::unordered_map<ConcreteDataMatcher, std::vector<size_t>, ConcreteDataMatcherHash> concreteOutputs;
+  std::vector<size_t> wildcardOutputs;
+  for (size_t i = 0; i < constOutputs.size(); i++) {
+    auto concrete = DataSpecUtils::asOptionalConcreteDataMatcher(constOutputs[i]);
+    if (concrete) {
+      concreteOutputs[*concrete].push_back(i);
+    } else {
+      wildcardOutputs.push_back(i);
+    }
+  }
+  auto concreteInput = [](InputSpec const& input) -> std::optional<ConcreteDataMatcher> {
+    return std::visit(overloaded{
+                        [](ConcreteDataMatcher const& concrete) { return std::optional<ConcreteDataMatcher>{concrete}; },
+                        [](data_matcher::DataDescriptorMatcher const& matcher) { return DataSpecUtils::optionalConcreteDataMatcherFrom(matcher); }},
+                      input.matcher);
+  };
+
   std::vector<bool> matches(constOutputs.size());
+  std::vector<size_t> candidates;
   for (size_t consumer = 0; consumer < workflow.size(); ++consumer) {
     for (size_t input = 0; input < workflow[consumer].inputs.size(); ++input) {
       forwards.clear();
-      for (size_t i = 0; i < constOutputs.size(); i++) {
-        matches[i] = DataSpecUtils::match(workflow[consumer].inputs[input], constOutputs[i]);
+      auto& inputSpec = workflow[consumer].inputs[input];
+      for (auto ci : candidates) {
+        matches[ci] = false;
+      }
+      candidates.clear();
+      if (auto concrete = concreteInput(inputSpec)) {
+        auto it = concreteOutputs.find(*concrete);
+        if (it != concreteOutputs.end()) {
+          candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+        candidates.insert(candidates.end(), wildcardOutputs.begin(), wildcardOutputs.end());
+      } else {
+        candidates.resize(constOutputs.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+      }
+      for (auto ci : candidates) {
+        matches[ci] = DataSpecUtils::match(inputSpec, constOutputs[ci]);
       }
 
       for (size_t i = 0; i < availableOutputsInfo.size(); i++) {
@@ -1092,6 +1256,12 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       filemode = fmo;
     }
   }
+  if (options.isSet("aod-writer-resformat")) {
+    auto format = options.get<std::string>("aod-writer-resformat");
+    if (!format.empty()) {
+      dod->setFileFormat(format);
+    }
+  }
   if (options.isSet("aod-writer-maxfilesize")) {
     mfs = options.get<float>("aod-writer-maxfilesize");
     if (mfs > 0) {
@@ -1104,6 +1274,9 @@ std::shared_ptr<DataOutputDirector> WorkflowHelpers::getDataOutputDirector(Confi
       ntfmerge = ntfm;
     }
   }
+  if (options.isSet("aod-writer-queue-depth")) {
+    dod->setWriterQueueDepth(options.get<int>("aod-writer-queue-depth"));
+  }
   // parse the keepString
   if (options.isSet("aod-writer-keep")) {
     auto keepString = options.get<std::string>("aod-writer-keep");
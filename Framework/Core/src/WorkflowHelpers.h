@@ -15,6 +15,7 @@
 #include "Framework/OutputSpec.h"
 #include "Framework/WorkflowSpec.h"
 #include "Framework/DataOutputDirector.h"
+#include "Framework/DerivedTableCache.h"
 
 #include <cstddef>
 #include <vector>
@@ -200,6 +201,14 @@ struct WorkflowHelpers {
                                          std::vector<InputSpec>& requestedDYNs,
                                          DataProcessorSpec& publisher);
 
+  /// Look up the tasks of @a workflow which only depend on the input AOD
+  /// in the derived table cache @a cacheDir. Those whose tables are cached
+  /// for all input files, and consumed by other tasks, are removed from
+  /// @a workflow and added to @a cached, the others to @a toStore.
+  static void useDerivedTableCache(WorkflowSpec& workflow, ConfigContext const& ctx, std::string const& cacheDir,
+                                   std::vector<DerivedTableCacheEntry>& cached,
+                                   std::vector<DerivedTableCacheEntry>& toStore);
+
   // Final adjustments to @a workflow after service devices have been injected.
   static void adjustTopology(WorkflowSpec& workflow, ConfigContext const& ctx);
 
@@ -70,6 +70,7 @@
 #include "ArrowSupport.h"
 
 #include "ComputingResourceHelpers.h"
+#include "NumaHelpers.h"
 #include "DataProcessingStatus.h"
 #include "DDSConfigHelpers.h"
 #include "O2ControlHelpers.h"
@@ -928,7 +929,8 @@ bool processSigChild(DeviceInfos& infos, DeviceSpecs& specs)
   bool hasError = false;
   while (true) {
     int status;
-    pid_t pid = waitpid((pid_t)(-1), &status, WNOHANG);
+    struct rusage usage;
+    pid_t pid = wait4((pid_t)(-1), &status, WNOHANG, &usage);
     if (pid > 0) {
       // Normal exit
       int es = WEXITSTATUS(status);
@@ -962,6 +964,9 @@ bool processSigChild(DeviceInfos& infos, DeviceSpecs& specs)
         if (info.pid == pid) {
           info.active = false;
           info.exitStatus = es;
+          info.userTime = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6;
+          info.systemTime = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+          info.maxResidentSetSize = usage.ru_maxrss;
         }
       }
       continue;
@@ -1017,6 +1022,25 @@ void doDefaultWorkflowTerminationHook()
   // LOG(info) << "Process " << getpid() << " is exiting.";
 }
 
+/// Bind the device to the CPUs and to the memory of its NUMA node, if any.
+void placeDevice(DeviceState& state, std::string const& numaNode, std::string const& cpuAffinity)
+{
+  state.numaNode = NumaHelpers::resolveNumaNode(numaNode);
+  if (!numaNode.empty() && state.numaNode < 0) {
+    LOGP(warning, "Unable to find the NUMA node {}, the memory of the device is not bound", numaNode);
+  }
+  if (state.numaNode >= 0 && !NumaHelpers::preferNumaNode(state.numaNode)) {
+    LOGP(warning, "Unable to allocate the memory of the device on NUMA node {}", state.numaNode);
+    state.numaNode = -1;
+  }
+  auto cpus = cpuAffinity.empty() ? NumaHelpers::cpusOfNumaNode(state.numaNode) : NumaHelpers::parseCPUList(cpuAffinity);
+  if (!cpus.empty() && !NumaHelpers::bindToCPUs(cpus)) {
+    LOGP(warning, "Unable to bind the device to the CPUs {}", cpuAffinity.empty() ? "of NUMA node " + std::to_string(state.numaNode) : cpuAffinity);
+  } else if (!cpus.empty()) {
+    LOGP(info, "Device bound to NUMA node {} and {} CPUs", state.numaNode, cpus.size());
+  }
+}
+
 int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
             RunningWorkflowInfo const& runningWorkflow,
             RunningDeviceRef ref,
@@ -1047,11 +1071,14 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
     boost::program_options::options_description optsDesc;
     ConfigParamsHelper::populateBoostProgramOptions(optsDesc, spec.options, gHiddenDeviceOptions);
     char const* defaultSignposts = getenv("DPL_SIGNPOSTS");
+    char const* defaultNumaNode = getenv("DPL_NUMA_NODE");
     optsDesc.add_options()("monitoring-backend", bpo::value<std::string>()->default_value("default"), "monitoring backend info")                                                           //
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets") //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("dpl-tracing-flags", bpo::value<std::string>()->default_value(""), "pipe `|` separate list of events to be traced")                                                                 //
       ("signposts", bpo::value<std::string>()->default_value(defaultSignposts ? defaultSignposts : ""), "comma separated list of signposts to enable")                                     //
+      ("numa-node", bpo::value<std::string>()->default_value(defaultNumaNode ? defaultNumaNode : ""), "NUMA node of the device (<node>, pci:<address> or gpu:<index>)")                    //
+      ("cpu-affinity", bpo::value<std::string>()->default_value(""), "CPUs on which the device runs, all the ones of --numa-node by default")                                              //
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
@@ -1087,6 +1114,9 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
     deviceState = std::make_unique<DeviceState>();
     deviceState->loop = loop;
     deviceState->tracingFlags = DeviceStateHelpers::parseTracingFlags(r.fConfig.GetPropertyAsString("dpl-tracing-flags"));
+    // The placement is done before the transport is created, so that the shared
+    // memory segment is allocated on the node of the device when it creates it.
+    placeDevice(*deviceState, r.fConfig.GetPropertyAsString("numa-node"), r.fConfig.GetPropertyAsString("cpu-affinity"));
     serviceRef.registerService(ServiceRegistryHelpers::handleForService<DeviceState>(deviceState.get()));
 
     quotaEvaluator = std::make_unique<ComputingQuotaEvaluator>(serviceRef);
@@ -2019,12 +2049,15 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           // the subworkflow invokations.
           const auto uniformOptions = {
             "--aod-file",
+            "--aod-derived-cache",
             "--aod-memory-rate-limit",
             "--aod-writer-json",
             "--aod-writer-ntfmerge",
+            "--aod-writer-queue-depth",
             "--aod-writer-resdir",
             "--aod-writer-resfile",
             "--aod-writer-resmode",
+            "--aod-writer-resformat",
             "--aod-writer-maxfilesize",
             "--aod-writer-keep",
             "--aod-parent-access-level",
@@ -2233,6 +2266,13 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           dumpMetricsCallback(&metricDumpTimer);
         }
         dumpRunSummary(serverContext, driverInfo, infos, runningWorkflow.devices);
+        if (driverInfo.benchmarkReport.empty() == false && infos.empty() == false) {
+          LOGP(info, "Dumping benchmark report to {}", driverInfo.benchmarkReport);
+          uint64_t wallTimeMs = (uv_hrtime() - driverInfo.startTime) / 1000000;
+          if (!ResourcesMonitoringHelper::dumpBenchmarkReport(driverInfo.benchmarkReport, metricsInfos, runningWorkflow.devices, infos, wallTimeMs)) {
+            LOGP(error, "Unable to write the benchmark report to {}", driverInfo.benchmarkReport);
+          }
+        }
         // This is a clean exit. Before we do so, if required,
         // we dump the configuration of all the devices so that
         // we can reuse it. Notice we do not dump anything if
@@ -2793,7 +2833,8 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                                           //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                                 //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")                          //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds");              //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")              //
+    ("benchmark-report", bpo::value<std::string>()->default_value(""), "write the resources used by each device to the provided JSON file on exit");               //
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
@@ -3142,6 +3183,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.resources = varmap["resources"].as<std::string>();
   driverInfo.resourcesMonitoringInterval = varmap["resources-monitoring"].as<unsigned short>();
   driverInfo.resourcesMonitoringDumpInterval = varmap["resources-monitoring-dump-interval"].as<unsigned short>();
+  driverInfo.benchmarkReport = varmap["benchmark-report"].as<std::string>();
 
   // FIXME: should use the whole dataProcessorInfos, actually...
   driverInfo.processorInfo = dataProcessorInfos;
@@ -260,6 +260,36 @@ static void BM_ASoASimpleForLoopWithOp(benchmark::State& state)
 
 BENCHMARK(BM_ASoASimpleForLoopWithOp)->Range(8, 8 << maxrange);
 
+static void BM_ASoABatchForLoopWithOp(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X, test::Y>;
+
+  for (auto _ : state) {
+    Test tests{table};
+    float sum = 0;
+    tests.forEachBatch<test::X, test::Y>([&sum](gsl::span<float const> xs, gsl::span<float const> ys) {
+      for (size_t i = 0; i < xs.size(); ++i) {
+        sum += xs[i] + ys[i];
+      }
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float) * 2);
+}
+
+BENCHMARK(BM_ASoABatchForLoopWithOp)->Range(8, 8 << maxrange);
+
 static void BM_ASoADynamicColumnPresent(benchmark::State& state)
 {
   // Seed with a real random value, if available
@@ -315,4 +345,33 @@ static void BM_ASoADynamicColumnCall(benchmark::State& state)
 }
 BENCHMARK(BM_ASoADynamicColumnCall)->Range(8, 8 << maxrange);
 
+static void BM_ASoADynamicColumnBatch(benchmark::State& state)
+{
+  // Seed with a real random value, if available
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  using Test = o2::soa::Table<test::X, test::Y, test::Sum<test::X, test::Y>>;
+
+  Test tests{table};
+  std::vector<float> sums(tests.size());
+  for (auto _ : state) {
+    tests.evaluateDynamicColumn<test::Sum<test::X, test::Y>>(sums);
+    float sum = 0;
+    for (auto s : sums) {
+      sum += s;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(float) * 2);
+}
+BENCHMARK(BM_ASoADynamicColumnBatch)->Range(8, 8 << maxrange);
+
 BENCHMARK_MAIN();
@@ -11,6 +11,9 @@
 #include <benchmark/benchmark.h>
 #include "Headers/DataHeader.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataDescriptorMatcherIndex.h"
+#include <string>
+#include <vector>
 
 using namespace o2::header;
 using namespace o2::framework::data_matcher;
@@ -179,4 +182,73 @@ static void BM_OneVariableMatchUnmatch(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_OneVariableMatchUnmatch);
 
+// A set of routes like the ones of a device with many inputs, the
+// header only matching the last one
+static std::vector<DataDescriptorMatcher> createRoutes(size_t nRoutes)
+{
+  std::vector<DataDescriptorMatcher> routes;
+  for (size_t i = 0; i < nRoutes; ++i) {
+    routes.emplace_back(
+      DataDescriptorMatcher::Op::And,
+      OriginValueMatcher{"AOD"},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        DescriptionValueMatcher{"TABLE" + std::to_string(i)},
+        std::make_unique<DataDescriptorMatcher>(
+          DataDescriptorMatcher::Op::And,
+          SubSpecificationTypeValueMatcher{0},
+          ConstantValueMatcher{true})));
+  }
+  return routes;
+}
+
+static void BM_RoutesLinearLookup(benchmark::State& state)
+{
+  auto routes = createRoutes(state.range(0));
+  DataHeader header;
+  header.dataOrigin = "AOD";
+  header.dataDescription.runtimeInit(("TABLE" + std::to_string(state.range(0) - 1)).c_str());
+  header.subSpecification = 0;
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    for (auto& route : routes) {
+      if (route.match(header, context)) {
+        break;
+      }
+      context.discard();
+    }
+    context.discard();
+  }
+}
+BENCHMARK(BM_RoutesLinearLookup)->Arg(4)->Arg(32)->Arg(256);
+
+static void BM_RoutesIndexLookup(benchmark::State& state)
+{
+  auto routes = createRoutes(state.range(0));
+  std::vector<size_t> order(routes.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  DataDescriptorMatcherIndex index{routes, order};
+  DataHeader header;
+  header.dataOrigin = "AOD";
+  header.dataDescription.runtimeInit(("TABLE" + std::to_string(state.range(0) - 1)).c_str());
+  header.subSpecification = 0;
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    for (auto ri : index.candidates(&header)) {
+      if (routes[order[ri]].match(header, context)) {
+        break;
+      }
+      context.discard();
+    }
+    context.discard();
+  }
+}
+BENCHMARK(BM_RoutesIndexLookup)->Arg(4)->Arg(32)->Arg(256);
+
 BENCHMARK_MAIN();
@@ -17,7 +17,9 @@
 #include "Framework/DataProcessingHeader.h"
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
+#include <atomic>
 #include <cstring>
+#include <thread>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -354,4 +356,70 @@ static void BM_RelayMultiplePayloads(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultiplePayloads)->Arg(10)->Arg(100)->Arg(1000);
 
+// Several streams relaying and consuming different timeslices at the same
+// time, as it happens with a multi-stream DataProcessingDevice. Each stream
+// relays a message for a new timeslice and then consumes whatever is ready,
+// so this measures how well the relayer scales with the number of streams.
+static void BM_RelayConcurrentStreams(benchmark::State& state)
+{
+  Monitoring metrics;
+  InputSpec spec{"clusters", "TPC", "CLUSTERS"};
+
+  std::vector<InputRoute> inputs = {
+    InputRoute{spec, 0, "Fake", 0}};
+
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAny();
+  ServiceRegistry registry;
+  DataRelayer relayer(policy, inputs, index, {registry});
+  const size_t nStreams = state.range(0);
+  relayer.setPipelineLength(2 * nStreams);
+
+  DataHeader dh;
+  dh.dataDescription = "CLUSTERS";
+  dh.dataOrigin = "TPC";
+  dh.subSpecification = 0;
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  constexpr size_t messagesPerStream = 1000;
+  std::atomic<size_t> timeslice = 0;
+
+  auto stream = [&]() {
+    DataRelayer::InputInfo fakeInfo{0, 2, DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+    std::vector<RecordAction> ready;
+    size_t relayed = 0;
+    while (relayed < messagesPerStream) {
+      Stack stack{dh, DataProcessingHeader{timeslice++, 1}};
+      std::vector<fair::mq::MessagePtr> inflightMessages;
+      inflightMessages.emplace_back(transport->CreateMessage(stack.size()));
+      inflightMessages.emplace_back(transport->CreateMessage(1000));
+      memcpy(inflightMessages[0]->GetData(), stack.data(), stack.size());
+      auto choice = relayer.relay(inflightMessages[0]->GetData(), inflightMessages.data(), fakeInfo, inflightMessages.size());
+      if (choice.type == DataRelayer::RelayChoice::Type::WillRelay) {
+        relayed++;
+      }
+      ready.clear();
+      relayer.getReadyToProcess(ready);
+      for (auto& action : ready) {
+        relayer.consumeAllInputsForTimeslice(action.slot);
+      }
+    }
+  };
+
+  for (auto _ : state) {
+    std::vector<std::thread> streams;
+    for (size_t si = 0; si < nStreams; ++si) {
+      streams.emplace_back(stream);
+    }
+    for (auto& t : streams) {
+      t.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * nStreams * messagesPerStream);
+}
+
+BENCHMARK(BM_RelayConcurrentStreams)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -52,6 +52,9 @@ void customize(std::vector<ConfigParamSpec>& workflowOptions)
   workflowOptions.push_back(
     ConfigParamSpec{
       "nChannels", VariantType::Int, 1, {"number of output channels of the producer"}});
+  workflowOptions.push_back(
+    ConfigParamSpec{
+      "nLinks", VariantType::Int, 0, {"number of subspecifications sent by the producer in each message, as for the readout links of an ITS or TPC FLP, 0: one per output channel"}});
   workflowOptions.push_back(
     ConfigParamSpec{
       "bypass-proxies", VariantType::String, "none", {"bypass proxies: none, all, output"}});
@@ -90,6 +93,7 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   using ProxyBypass = benchmark_config::ProxyBypass;
   auto bypassProxies = readConfig<ProxyBypass>(config, "bypass-proxies");
   int nChannels = config.options().get<int>("nChannels");
+  int nLinks = config.options().get<int>("nLinks");
   std::string defaultTransportConfig = config.options().get<std::string>("default-transport");
   if (defaultTransportConfig == "zeromq") {
     // nothing to do for the moment
@@ -208,6 +212,7 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
     size_t nRolls = 2;
     size_t msgSize = 1024 * 1024;
     size_t nChannels = 1;
+    size_t nLinks = 0;
     size_t splitPayloadSize = 1;
     size_t iteration = 0;
     std::string channelName;
@@ -256,6 +261,7 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   }
   attributes->bypassProxies = bypassProxies;
   attributes->nChannels = nChannels;
+  attributes->nLinks = nLinks;
   auto producerInitCallback = [pState, loggerInit, loggerCycle, loggerSummary, attributes](CallbackService& callbacks,
                                                                                            RawDeviceService& rds,
                                                                                            ConfigParamRegistry const& config) {
@@ -339,7 +345,8 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
       bool forcedTermination = false;
       try {
         if (attributes->mode == ProducerAttributes::Mode::Transport) {
-          for (unsigned int i = 0; i < attributes->nChannels; i++) {
+          size_t nSubSpecs = attributes->nLinks > 0 ? attributes->nLinks : attributes->nChannels;
+          for (unsigned int i = 0; i < nSubSpecs; i++) {
             createPairs(attributes->splitPayloadSize, DataHeader{"DATA", "TST", i});
           }
           // using utility from ExternalFairMQDeviceProxy
@@ -387,8 +394,13 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   };
 
   Outputs outputs;
-  for (unsigned int i = 0; i < nChannels; i++) {
-    outputs.emplace_back(OutputSpec{{"data"}, "TST", "DATA", i, Lifetime::Timeframe});
+  if (nLinks > 0) {
+    // the links are sent on the raw channel, any subspecification is accepted downstream
+    outputs.emplace_back(OutputSpec{{"data"}, ConcreteDataTypeMatcher{"TST", "DATA"}, Lifetime::Timeframe});
+  } else {
+    for (unsigned int i = 0; i < nChannels; i++) {
+      outputs.emplace_back(OutputSpec{{"data"}, "TST", "DATA", i, Lifetime::Timeframe});
+    }
   }
   workflow.emplace_back(DataProcessorSpec{"producer",
                                           {},
@@ -407,8 +419,12 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
   // the dpl sink proxy process
 
   Inputs sinkInputs;
-  for (unsigned int i = 0; i < nChannels; i++) {
-    sinkInputs.emplace_back(InputSpec{{"external"}, "TST", "DATA", i, Lifetime::Timeframe});
+  if (nLinks > 0) {
+    sinkInputs.emplace_back(InputSpec{"external", ConcreteDataTypeMatcher{"TST", "DATA"}, Lifetime::Timeframe});
+  } else {
+    for (unsigned int i = 0; i < nChannels; i++) {
+      sinkInputs.emplace_back(InputSpec{{"external"}, "TST", "DATA", i, Lifetime::Timeframe});
+    }
   }
   auto channelSelector = [](InputSpec const&, const std::unordered_map<std::string, std::vector<fair::mq::Channel>>&) -> std::string {
     return "downstream";
@@ -469,43 +485,49 @@ std::vector<DataProcessorSpec> defineDataProcessing(ConfigContext const& config)
     if (inputs.Size() < 2) {
       return false;
     }
-    int msgidx = 0;
-    auto dh = o2::header::get<o2::header::DataHeader*>(inputs.At(msgidx)->GetData());
-    if (!dh) {
-      LOG(error) << "data on input " << msgidx << " does not follow the O2 data model, DataHeader missing";
-      return false;
-    }
-    auto dph = o2::header::get<DataProcessingHeader*>(inputs.At(msgidx)->GetData());
-    if (!dph) {
-      LOG(error) << "data on input " << msgidx << " does not follow the O2 data model, DataProcessingHeader missing";
-      return false;
-    }
-    // Note: we want to run both the output and input proxy in the same workflow and thus we need
-    // different data identifiers and change the data origin in the forwarding
-    OutputSpec query{"PRX", dh->dataDescription, dh->subSpecification};
-    auto channelName = channelRetriever(query, dph->startTime);
-    bool isData = DataSpecUtils::match(OutputSpec{"TST", "DATA", 0}, dh->dataOrigin, dh->dataDescription, dh->subSpecification);
-    // for the configured data channel we require the channel name, the EOS message containing
-    // the forwarded SourceInfoHeader created by the output proxy will be skipped here since the
-    // input proxy handles this internally
-    ASSERT_ERROR(!isData || !channelName.empty());
-    LOG(debug) << "using channel '" << channelName << "' for " << DataSpecUtils::describe(OutputSpec{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
-    if (channelName.empty()) {
-      return false;
-    }
-    // make a copy of the header message, get the data header and change origin
-    auto outHeaderMessage = device->NewMessageFor(channelName, 0, inputs.At(msgidx)->GetSize());
-    memcpy(outHeaderMessage->GetData(), inputs.At(msgidx)->GetData(), inputs.At(msgidx)->GetSize());
-    // this we obviously need to fix in the get API, const'ness of the returned header pointer
-    // should depend on const'ness of the buffer
-    auto odh = const_cast<o2::header::DataHeader*>(o2::header::get<o2::header::DataHeader*>(outHeaderMessage->GetData()));
-    odh->dataOrigin = o2::header::DataOrigin("PRX");
+    // all the (header, payload) pairs, i.e. one per link, are forwarded in one message
     fair::mq::Parts output;
-    output.AddPart(std::move(outHeaderMessage));
-    output.AddPart(std::move(inputs.At(msgidx + 1)));
-    LOG(debug) << "sending " << DataSpecUtils::describe(OutputSpec{odh->dataOrigin, odh->dataDescription, odh->subSpecification});
+    std::string channelName;
+    for (int msgidx = 0; msgidx + 1 < inputs.Size(); msgidx += 2) {
+      auto dh = o2::header::get<o2::header::DataHeader*>(inputs.At(msgidx)->GetData());
+      if (!dh) {
+        LOG(error) << "data on input " << msgidx << " does not follow the O2 data model, DataHeader missing";
+        return false;
+      }
+      auto dph = o2::header::get<DataProcessingHeader*>(inputs.At(msgidx)->GetData());
+      if (!dph) {
+        LOG(error) << "data on input " << msgidx << " does not follow the O2 data model, DataProcessingHeader missing";
+        return false;
+      }
+      // Note: we want to run both the output and input proxy in the same workflow and thus we need
+      // different data identifiers and change the data origin in the forwarding
+      if (channelName.empty()) {
+        OutputSpec query{"PRX", dh->dataDescription, dh->subSpecification};
+        channelName = channelRetriever(query, dph->startTime);
+        bool isData = DataSpecUtils::match(OutputSpec{{"TST", "DATA"}}, dh->dataOrigin, dh->dataDescription, dh->subSpecification);
+        // for the configured data channel we require the channel name, the EOS message containing
+        // the forwarded SourceInfoHeader created by the output proxy will be skipped here since the
+        // input proxy handles this internally
+        ASSERT_ERROR(!isData || !channelName.empty());
+        LOG(debug) << "using channel '" << channelName << "' for " << DataSpecUtils::describe(OutputSpec{dh->dataOrigin, dh->dataDescription, dh->subSpecification});
+        if (channelName.empty()) {
+          return false;
+        }
+      }
+      // make a copy of the header message, get the data header and change origin
+      auto outHeaderMessage = device->NewMessageFor(channelName, 0, inputs.At(msgidx)->GetSize());
+      memcpy(outHeaderMessage->GetData(), inputs.At(msgidx)->GetData(), inputs.At(msgidx)->GetSize());
+      // this we obviously need to fix in the get API, const'ness of the returned header pointer
+      // should depend on const'ness of the buffer
+      auto odh = const_cast<o2::header::DataHeader*>(o2::header::get<o2::header::DataHeader*>(outHeaderMessage->GetData()));
+      odh->dataOrigin = o2::header::DataOrigin("PRX");
+      output.AddPart(std::move(outHeaderMessage));
+      output.AddPart(std::move(inputs.At(msgidx + 1)));
+    }
+    LOG(debug) << "sending " << output.Size() / 2 << " part(s)";
+    bool didSend = output.Size() > 0;
     o2::framework::sendOnChannel(*device, output, channelName, (size_t)-1);
-    return output.Size() > 0;
+    return didSend;
   };
 
   // we use the same spec to build the configuration string, ideally we would have some helpers
@@ -107,4 +107,50 @@ static void BM_CreateGraphReverseOverhead(benchmark::State& state)
 }
 
 BENCHMARK(BM_CreateGraphReverseOverhead)->Range(1, 1 << 10);
+
+// A synthetic reconstruction-like topology: state.range() devices, each
+// producing 32 outputs and consuming all the outputs of the previous one,
+// plus a wildcard subscription to the first device.
+static void BM_CreateGraphLargeTopology(benchmark::State& state)
+{
+  constexpr size_t outputsPerDevice = 32;
+  WorkflowSpec baseWorkflow;
+  for (size_t di = 0; di < state.range(); ++di) {
+    DataProcessorSpec spec{.name = "device-" + std::to_string(di)};
+    o2::header::DataDescription description;
+    description.runtimeInit(("D" + std::to_string(di)).c_str());
+    for (size_t oi = 0; oi < outputsPerDevice; ++oi) {
+      auto subSpec = static_cast<o2::header::DataHeader::SubSpecificationType>(oi);
+      spec.outputs.emplace_back(OutputSpec{{"out" + std::to_string(oi)}, "TST", description, subSpec});
+    }
+    if (di > 0) {
+      o2::header::DataDescription inputDescription;
+      inputDescription.runtimeInit(("D" + std::to_string(di - 1)).c_str());
+      for (size_t oi = 0; oi < outputsPerDevice; ++oi) {
+        auto subSpec = static_cast<o2::header::DataHeader::SubSpecificationType>(oi);
+        spec.inputs.emplace_back(InputSpec{"in" + std::to_string(oi), "TST", inputDescription, subSpec});
+      }
+      spec.inputs.emplace_back(InputSpec{"first", ConcreteDataTypeMatcher{"TST", "D0"}});
+    }
+    baseWorkflow.push_back(spec);
+  }
+
+  for (auto _ : state) {
+    WorkflowSpec workflow = baseWorkflow;
+    std::vector<DeviceConnectionEdge> logicalEdges;
+    std::vector<OutputSpec> outputs;
+    std::vector<LogicalForwardInfo> availableForwardsInfo;
+
+    if (WorkflowHelpers::verifyWorkflow(workflow) != WorkflowParsingState::Valid) {
+      throw std::runtime_error("invalid workflow");
+    };
+    auto context = makeEmptyConfigContext();
+    WorkflowHelpers::injectServiceDevices(workflow, *context);
+    WorkflowHelpers::constructGraph(workflow, logicalEdges,
+                                    outputs,
+                                    availableForwardsInfo);
+  }
+}
+
+BENCHMARK(BM_CreateGraphLargeTopology)->RangeMultiplier(2)->Range(8, 256)->Unit(benchmark::kMillisecond);
 BENCHMARK_MAIN();
@@ -1357,3 +1357,52 @@ TEST_CASE("TestCombinedGetter")
     ++count;
   }
 }
+
+TEST_CASE("TestForEachBatch")
+{
+  // Two chunks of 10 and 5 rows for X and Y...
+  TableBuilder b1;
+  auto w1 = b1.cursor<o2::aod::Points>();
+  for (auto i = 0; i < 10; ++i) {
+    w1(0, i, 2 * i);
+  }
+  TableBuilder b2;
+  auto w2 = b2.cursor<o2::aod::Points>();
+  for (auto i = 10; i < 15; ++i) {
+    w2(0, i, 2 * i);
+  }
+  // ... and a single chunk of 15 rows for the thickness.
+  TableBuilder b3;
+  auto w3 = b3.cursor<o2::aod::SegmentsExtras>();
+  for (auto i = 0; i < 15; ++i) {
+    w3(0, 3 * i);
+  }
+  auto points = ArrowHelpers::concatTables({b1.finalize(), b2.finalize()});
+  REQUIRE(points->column(0)->num_chunks() == 2);
+  using Test = Join<o2::aod::Points, o2::aod::SegmentsExtras>;
+  Test t{{points, b3.finalize()}};
+
+  std::vector<size_t> sizes;
+  int row = 0;
+  t.forEachBatch<o2::aod::test::X, o2::aod::test::Y, o2::aod::test::Thickness>([&](gsl::span<int const> xs, gsl::span<int const> ys, gsl::span<int const> ts) {
+    REQUIRE(xs.size() == ys.size());
+    REQUIRE(xs.size() == ts.size());
+    for (size_t i = 0; i < xs.size(); ++i, ++row) {
+      REQUIRE(xs[i] == row);
+      REQUIRE(ys[i] == 2 * row);
+      REQUIRE(ts[i] == 3 * row);
+    }
+    sizes.push_back(xs.size());
+  });
+  REQUIRE(row == 15);
+  REQUIRE(sizes == std::vector<size_t>{10, 5});
+
+  using TestSum = o2::soa::Table<o2::aod::test::X, o2::aod::test::Y, o2::aod::test::Sum<o2::aod::test::X, o2::aod::test::Y>>;
+  TestSum ts{points};
+  std::vector<int> sums(ts.size());
+  ts.evaluateDynamicColumn<o2::aod::test::Sum<o2::aod::test::X, o2::aod::test::Y>>(sums);
+  row = 0;
+  for (auto& p : ts) {
+    REQUIRE(sums[row++] == p.sum());
+  }
+}
@@ -1296,6 +1296,57 @@ TEST_CASE("CombinationsHelpers")
   REQUIRE(count == expectedStrictlyUpperTriples.size());
 }
 
+TEST_CASE("BatchedPairCombinations")
+{
+  TableBuilder builderB;
+  auto rowWriterB = builderB.persist<int32_t, int32_t, float>({"x", "y", "floatZ"});
+  rowWriterB(0, 0, 25, -6.0f);
+  rowWriterB(0, 1, 18, 0.0f);
+  rowWriterB(0, 2, 48, 8.0f);
+  rowWriterB(0, 3, 103, 2.0f);
+  rowWriterB(0, 4, 28, -6.0f);
+  rowWriterB(0, 5, 102, 2.0f);
+  rowWriterB(0, 6, 12, 0.0f);
+  rowWriterB(0, 7, 24, -7.0f);
+  rowWriterB(0, 8, 41, 8.0f);
+  rowWriterB(0, 9, 49, 8.0f);
+  auto tableB = builderB.finalize();
+
+  using TestB = o2::soa::Table<o2::soa::Index<>, test::X, test::Y, test::FloatZ>;
+  TestB testB{tableB};
+
+  std::vector<double> yBins{VARIABLE_WIDTH, 0, 5, 10, 20, 30, 40, 50, 101};
+  std::vector<double> zBins{VARIABLE_WIDTH, -7.0, -5.0, -3.0, -1.0, 1.0, 3.0, 5.0, 7.0};
+  ColumnBinningPolicy<test::Y, test::FloatZ> pairBinning{{yBins, zBins}, false};
+
+  // without pre-filtering, the pairs are the same as for selfPairCombinations
+  std::vector<std::tuple<int32_t, int32_t>> expectedPairs;
+  for (auto& [c0, c1] : selfPairCombinations(pairBinning, 2, -1, testB)) {
+    expectedPairs.emplace_back(c0.x(), c1.x());
+  }
+  std::vector<std::tuple<int32_t, int32_t>> pairs;
+  int blocks = 0;
+  selfPairCombinationsBatched<test::X>(
+    pairBinning, 2, -1, testB, [&blocks](auto&) { blocks++; }, [&pairs](auto& c0, auto& c1) { pairs.emplace_back(c0.x(), c1.x()); });
+  REQUIRE(pairs == expectedPairs);
+  REQUIRE(blocks == 4);
+
+  // pre-filter on the gathered column values
+  std::vector<std::tuple<int32_t, int32_t>> expectedFilteredPairs{
+    {0, 4}, {0, 7}, {4, 7}, {1, 6}, {2, 8}, {2, 9}};
+  pairs.clear();
+  auto preFilter = [](auto& block) {
+    auto x0 = block.template first<test::X>();
+    auto x1 = block.template second<test::X>();
+    for (size_t p = 0; p < block.size(); ++p) {
+      block.selected[p] = (x1[p] - x0[p]) > 2;
+    }
+  };
+  selfPairCombinationsBatched<test::X, test::FloatZ>(
+    pairBinning, 2, -1, testB, preFilter, [&pairs](auto& c0, auto& c1) { pairs.emplace_back(c0.x(), c1.x()); });
+  REQUIRE(pairs == expectedFilteredPairs);
+}
+
 TEST_CASE("ConstructorsWithoutTables")
 {
   using TestA = o2::soa::Table<o2::soa::Index<>, test::X, test::Y>;
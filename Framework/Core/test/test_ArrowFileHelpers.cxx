@@ -0,0 +1,67 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/ArrowFileHelpers.h"
+#include "Framework/TableBuilder.h"
+
+#include <arrow/table.h>
+#include <filesystem>
+
+using namespace o2::framework;
+
+TEST_CASE("TestArrowFileHelpers")
+{
+  std::string directory = "arrowfilehelpers";
+  std::filesystem::remove_all(directory);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int, float>({"fIndex", "fPt"});
+  for (int i = 0; i < 100; ++i) {
+    rowWriter(0, i, 0.5f * i);
+  }
+  auto table = builder.finalize();
+
+  auto filename = ArrowFileHelpers::tablePath(directory, "DF_10", "O2track");
+  REQUIRE(filename == "arrowfilehelpers/DF_10/O2track.arrow");
+  ArrowFileHelpers::writeTable(table, filename);
+  ArrowFileHelpers::writeTable(table, ArrowFileHelpers::tablePath(directory, "DF_2", "O2track"));
+  REQUIRE(ArrowFileHelpers::isArrowAOD(directory));
+  REQUIRE(ArrowFileHelpers::isArrowAOD(filename) == false);
+  REQUIRE(ArrowFileHelpers::listDataFrames(directory) == std::vector<uint64_t>{2, 10});
+
+  auto read = ArrowFileHelpers::readTable(filename);
+  REQUIRE(read->num_rows() == 100);
+  REQUIRE(read->num_columns() == 2);
+  REQUIRE(read->Equals(*table));
+
+  auto subset = ArrowFileHelpers::readTable(filename, {"fPt"});
+  REQUIRE(subset->num_columns() == 1);
+  REQUIRE(subset->schema()->field(0)->name() == "fPt");
+  REQUIRE_THROWS(ArrowFileHelpers::readTable(filename, {"fEta"}));
+
+  // Empty tables still have one chunk per column
+  TableBuilder emptyBuilder;
+  emptyBuilder.persist<int>({"fIndex"});
+  auto emptyFilename = ArrowFileHelpers::tablePath(directory, "DF_2", "O2empty");
+  ArrowFileHelpers::writeTable(emptyBuilder.finalize(), emptyFilename);
+  auto empty = ArrowFileHelpers::readTable(emptyFilename);
+  REQUIRE(empty->num_rows() == 0);
+  REQUIRE(empty->column(0)->num_chunks() == 1);
+
+  ArrowFileHelpers::StringMap parents{{"DF_2", "/some/parent.root"}, {"DF_10", "/other/parent"}};
+  auto mapFilename = directory + "/" + ArrowFileHelpers::parentFilesName;
+  ArrowFileHelpers::writeMap(parents, mapFilename);
+  REQUIRE(ArrowFileHelpers::readMap(mapFilename) == parents);
+  REQUIRE(ArrowFileHelpers::readMap(directory + "/missing.arrow").empty());
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/BackgroundWriter.h"
+#include <catch_amalgamated.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace o2::framework;
+
+TEST_CASE("TestBackgroundWriterOrder")
+{
+  std::vector<int> written;
+  {
+    BackgroundWriter writer(2);
+    for (int i = 0; i < 100; ++i) {
+      writer.push([&written, i]() { written.push_back(i); });
+    }
+    writer.drain();
+    REQUIRE(written.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE(written[i] == i);
+    }
+    writer.push([&written]() { written.push_back(100); });
+  }
+  // the destructor waits for the pending tasks
+  REQUIRE(written.size() == 101);
+}
+
+TEST_CASE("TestBackgroundWriterBackPressure")
+{
+  BackgroundWriter writer(1);
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  std::atomic<int> done{0};
+  for (int i = 0; i < 10; ++i) {
+    writer.push([&]() {
+      maxRunning = std::max(maxRunning.load(), ++running);
+      --running;
+      ++done;
+    });
+    // with depth 1, a push returns only once the previous task has finished
+    REQUIRE(done >= i);
+  }
+  writer.drain();
+  REQUIRE(done == 10);
+  REQUIRE(maxRunning == 1);
+}
+
+TEST_CASE("TestBackgroundWriterError")
+{
+  BackgroundWriter writer(4);
+  writer.push([]() { throw std::runtime_error("disk full"); });
+  REQUIRE_THROWS_AS(writer.drain(), std::runtime_error);
+  // the error is reported once, the writer can be used afterwards
+  int value = 0;
+  writer.push([&value]() { value = 1; });
+  writer.drain();
+  REQUIRE(value == 1);
+}
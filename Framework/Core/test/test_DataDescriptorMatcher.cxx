@@ -10,6 +10,7 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataDescriptorMatcherIndex.h"
 #include "Framework/DataDescriptorQueryBuilder.h"
 #include "Framework/InputSpec.h"
 #include "Framework/DataSpecUtils.h"
@@ -720,3 +721,52 @@ TEST_CASE("MatchSubspec")
 
   REQUIRE(matcher.match(header0, context) == false);
 }
+
+// The index must provide the candidates in the original order,
+// including the matchers which do not have a constant origin and description
+
+TEST_CASE("MatcherIndexCandidates")
+{
+  auto makeMatcher = [](std::string origin, std::string description, Node&& subSpec) {
+    return DataDescriptorMatcher{
+      DataDescriptorMatcher::Op::And,
+      OriginValueMatcher{origin},
+      std::make_unique<DataDescriptorMatcher>(
+        DataDescriptorMatcher::Op::And,
+        DescriptionValueMatcher{description},
+        std::make_unique<DataDescriptorMatcher>(
+          DataDescriptorMatcher::Op::And,
+          std::move(subSpec),
+          ConstantValueMatcher{true}))};
+  };
+
+  std::vector<DataDescriptorMatcher> matchers;
+  matchers.push_back(makeMatcher("TPC", "CLUSTERS", SubSpecificationTypeValueMatcher{1}));
+  matchers.push_back(makeMatcher("TPC", "CLUSTERS", SubSpecificationTypeValueMatcher{ContextRef{1}}));
+  matchers.push_back(DataDescriptorMatcher{DataDescriptorMatcher::Op::Or,
+                                           OriginValueMatcher{"ITS"},
+                                           DescriptionValueMatcher{"TRACKS"}});
+  matchers.push_back(makeMatcher("TPC", "CLUSTERS", SubSpecificationTypeValueMatcher{2}));
+  matchers.push_back(makeMatcher("ITS", "TRACKS", SubSpecificationTypeValueMatcher{0}));
+  std::vector<size_t> order{4, 0, 1, 2, 3};
+
+  DataDescriptorMatcherIndex index{matchers, order};
+  REQUIRE(index.getNumberOfWildcards() == 1);
+
+  DataHeader header;
+  header.dataOrigin = "TPC";
+  header.dataDescription = "CLUSTERS";
+  header.subSpecification = 1;
+  REQUIRE(index.candidates(&header) == std::vector<size_t>{1, 2, 3});
+  header.subSpecification = 2;
+  REQUIRE(index.candidates(&header) == std::vector<size_t>{2, 3, 4});
+  header.subSpecification = 3;
+  REQUIRE(index.candidates(&header) == std::vector<size_t>{2, 3});
+  header.dataOrigin = "ITS";
+  header.dataDescription = "TRACKS";
+  header.subSpecification = 0;
+  REQUIRE(index.candidates(&header) == std::vector<size_t>{0, 3});
+  header.dataOrigin = "TOF";
+  REQUIRE(index.candidates(&header) == std::vector<size_t>{3});
+  REQUIRE(index.candidates(nullptr) == std::vector<size_t>{0, 1, 2, 3, 4});
+}
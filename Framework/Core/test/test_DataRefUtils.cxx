@@ -12,6 +12,7 @@
 #include <TObject.h>
 #include <TObjString.h>
 #include <TObjArray.h>
+#include <TNamed.h>
 #include <TMessage.h>
 #include "Framework/RootSerializationSupport.h"
 #include "Framework/DataRefUtils.h"
@@ -67,6 +68,48 @@ TEST_CASE("TestRootSerialization")
   REQUIRE(std::string(o->GetName()) == "test");
 }
 
+// Deserialization into the instance extracted from a previous message
+TEST_CASE("TestRootDeserializationInto")
+{
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  auto makeRef = [&transport](fair::mq::MessagePtr& msg, o2::header::DataHeader& dh, TObject const* object) {
+    msg = transport->CreateMessage(4096);
+    FairOutputTBuffer tm(*msg);
+    tm << object;
+    dh.payloadSerializationMethod = o2::header::gSerializationMethodROOT;
+    dh.payloadSize = (size_t)msg->GetSize();
+    DataRef ref;
+    ref.payload = (char*)msg->GetData();
+    ref.header = reinterpret_cast<char const*>(&dh);
+    return ref;
+  };
+
+  fair::mq::MessagePtr msg1, msg2, msg3;
+  o2::header::DataHeader dh1, dh2, dh3;
+  TObjString s1("first");
+  TObjString s2("second");
+  TNamed n3("third", "title");
+  auto ref1 = makeRef(msg1, dh1, &s1);
+  auto ref2 = makeRef(msg2, dh2, &s2);
+  auto ref3 = makeRef(msg3, dh3, &n3);
+
+  std::unique_ptr<TObject> object;
+  DataRefUtils::readInto(ref1, object);
+  REQUIRE(object.get() != nullptr);
+  REQUIRE(std::string(object->GetName()) == "first");
+
+  // same class, the instance is reused
+  auto* previous = object.get();
+  DataRefUtils::readInto(ref2, object);
+  REQUIRE(object.get() == previous);
+  REQUIRE(std::string(object->GetName()) == "second");
+
+  // a different class replaces the instance
+  DataRefUtils::readInto(ref3, object);
+  REQUIRE(object->IsA() == TNamed::Class());
+  REQUIRE(std::string(object->GetTitle()) == "title");
+}
+
 // Simple test for ROOT container deserialization.
 TEST_CASE("TestRootContainerSerialization")
 {
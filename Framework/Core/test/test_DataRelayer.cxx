@@ -112,6 +112,11 @@ TEST_CASE("DataRelayer")
     // one MessageSet with one PartRef with header and payload
     REQUIRE(result.size() == 1);
     REQUIRE(result.at(0).size() == 1);
+    // The slot became ready and was consumed exactly once.
+    REQUIRE(relayer.getCompletionHistogram().count == 1);
+    REQUIRE(relayer.getQueueHistogram().count == 1);
+    REQUIRE(relayer.getInputWaitHistogram(0).count == 1);
+    REQUIRE(relayer.getInputWaitHistogram(0).max == 0);
   }
 
   //
@@ -805,3 +810,28 @@ TEST_CASE("DataRelayer")
     }
   }
 }
+
+TEST_CASE("LatencyHistogram")
+{
+  DataRelayer::LatencyHistogram histogram;
+  REQUIRE(histogram.quantile(0.5) == 0);
+  REQUIRE(histogram.mean() == 0);
+  histogram.fill(0);
+  histogram.fill(1);
+  histogram.fill(3);
+  histogram.fill(100);
+  REQUIRE(histogram.count == 4);
+  REQUIRE(histogram.bins[0] == 1);
+  REQUIRE(histogram.bins[1] == 1);
+  REQUIRE(histogram.bins[2] == 1);
+  REQUIRE(histogram.bins[7] == 1);
+  REQUIRE(histogram.mean() == 26);
+  REQUIRE(histogram.quantile(0.5) == 4);
+  REQUIRE(histogram.quantile(0.99) == 100);
+  // Everything above the last bin ends up there.
+  histogram.fill(1ULL << 40);
+  REQUIRE(histogram.bins[DataRelayer::LatencyHistogram::NBINS - 1] == 1);
+  histogram.reset();
+  REQUIRE(histogram.count == 0);
+  REQUIRE(histogram.max == 0);
+}
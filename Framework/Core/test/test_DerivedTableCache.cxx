@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/DerivedTableCache.h"
+#include "Framework/DataProcessorSpec.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace o2::framework;
+
+TEST_CASE("TestDerivedTableCache")
+{
+  DataProcessorSpec producer{
+    .name = "producer",
+    .inputs = {InputSpec{"tracks", "AOD", "TRACK"}},
+    .outputs = {OutputSpec{"AOD", "DERIVED"}},
+    .options = {ConfigParamSpec{"cut", VariantType::Float, 0.5f, {"a cut"}}}};
+
+  char arg0[] = "workflow";
+  char arg1[] = "--cut";
+  char arg2[] = "0.7";
+  char arg3[] = "--other";
+  char arg4[] = "1";
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4};
+
+  // options of other tasks do not change the hash, the ones of the producer do
+  auto hash = DerivedTableCache::configurationHash(producer, 1, argv, {});
+  REQUIRE(hash.size() == 16);
+  REQUIRE(DerivedTableCache::configurationHash(producer, 1, argv, {}) == hash);
+  char* otherArgv[] = {arg0, arg3, arg4};
+  REQUIRE(DerivedTableCache::configurationHash(producer, 3, otherArgv, {}) == hash);
+  REQUIRE(DerivedTableCache::configurationHash(producer, 5, argv, {}) != hash);
+  REQUIRE(DerivedTableCache::configurationHash(producer, 1, argv, {"upstream"}) != hash);
+  DataProcessorSpec modified{
+    .name = "producer",
+    .inputs = {InputSpec{"tracks", "AOD", "TRACK"}},
+    .outputs = {OutputSpec{"AOD", "DERIVED"}},
+    .options = {ConfigParamSpec{"cut", VariantType::Float, 0.6f, {"a cut"}}}};
+  REQUIRE(DerivedTableCache::configurationHash(modified, 1, argv, {}) != hash);
+
+  // relative and absolute paths of the same file share the entry
+  auto cwd = std::filesystem::current_path().string();
+  REQUIRE(DerivedTableCache::entryPath("cache", hash, "AO2D.root") == DerivedTableCache::entryPath("cache", hash, cwd + "/./AO2D.root"));
+  REQUIRE(DerivedTableCache::entryPath("cache", hash, "AO2D.root") != DerivedTableCache::entryPath("cache", hash, "AO2D_2.root"));
+  REQUIRE(DerivedTableCache::entryPath("cache", hash, "AO2D.root").rfind("cache/" + hash + "/", 0) == 0);
+
+  std::string directory = "derivedtablecache";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  {
+    std::ofstream list(directory + "/list.txt");
+    list << "AO2D_1.root\n\n AO2D_2.root \n";
+  }
+  REQUIRE(DerivedTableCache::inputFiles("AO2D.root") == std::vector<std::string>{"AO2D.root"});
+  REQUIRE(DerivedTableCache::inputFiles("@" + directory + "/list.txt") == std::vector<std::string>{"AO2D_1.root", "AO2D_2.root"});
+  REQUIRE_THROWS(DerivedTableCache::inputFiles("@" + directory + "/missing.txt"));
+
+  auto entry = DerivedTableCache::entryPath(directory, hash, "AO2D_1.root");
+  REQUIRE(DerivedTableCache::isComplete(entry) == false);
+  DerivedTableCache::markComplete(entry);
+  REQUIRE(DerivedTableCache::isComplete(entry));
+  REQUIRE(DerivedTableCache::isComplete(DerivedTableCache::entryPath(directory, hash, "AO2D_2.root")) == false);
+
+  std::filesystem::remove_all(directory);
+}
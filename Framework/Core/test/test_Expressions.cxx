@@ -283,3 +283,38 @@ TEST_CASE("TestConditionalExpressions")
   auto gandiva_filter2 = createFilter(schema2, gandiva_condition2);
   REQUIRE(gandiva_tree2->ToString() == "bool greater_than((float) fSigned1Pt, (const float) 0 raw(0)) && if (bool less_than(float absf((float) fEta), (const float) 1 raw(3f800000)) && if (bool less_than((float) fPt, (const float) 1 raw(3f800000))) { bool greater_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) } else { bool less_than((float) fPhi, (const float) 1.5708 raw(3fc90fdb)) }) { bool greater_than(float absf((float) fX), (const float) 1 raw(3f800000)) } else { bool greater_than(float absf((float) fY), (const float) 1 raw(3f800000)) }");
 }
+
+TEST_CASE("TestExpressionCache")
+{
+  clearExpressionCache();
+  auto schema = std::make_shared<arrow::Schema>(std::vector{o2::aod::track::Pt::asArrowField(), o2::aod::track::Eta::asArrowField()});
+  Filter f1 = o2::aod::track::pt > 1.0f && nabs(o2::aod::track::eta) < 0.8f;
+  Filter f2 = o2::aod::track::pt > 1.0f && nabs(o2::aod::track::eta) < 0.8f;
+  Filter f3 = o2::aod::track::pt > 2.0f && nabs(o2::aod::track::eta) < 0.8f;
+
+  // Equivalent trees on the same schema share the compiled filter...
+  auto filter1 = createFilter(schema, createOperations(f1));
+  auto filter2 = createFilter(schema, createOperations(f2));
+  REQUIRE(filter1 == filter2);
+  // ... while different literals or schemas do not.
+  auto filter3 = createFilter(schema, createOperations(f3));
+  REQUIRE(filter1 != filter3);
+  auto schema2 = std::make_shared<arrow::Schema>(std::vector{o2::aod::track::Eta::asArrowField(), o2::aod::track::Pt::asArrowField()});
+  auto filter4 = createFilter(schema2, createOperations(f1));
+  REQUIRE(filter1 != filter4);
+
+  auto stats = getExpressionCacheStats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 3);
+  REQUIRE(stats.size == 3);
+
+  Projector p1 = o2::aod::track::pt * 2.0f;
+  auto resfield = std::make_shared<arrow::Field>("result", arrow::float32());
+  auto projector1 = createProjector(schema, createOperations(p1), resfield);
+  auto projector2 = createProjector(schema, createOperations(p1), resfield);
+  REQUIRE(projector1 == projector2);
+  REQUIRE(getExpressionCacheStats().size == 4);
+
+  clearExpressionCache();
+  REQUIRE(getExpressionCacheStats().size == 0);
+}
@@ -113,3 +113,36 @@ TEST_CASE("TestContents")
   REQUIRE(buffer.size() == 40);
   REQUIRE(strncmp((const char*)buffer.data(), "foo", 3) == 0);
 }
+
+// Check that a TableBuilder can have its columns allocated from the transport
+TEST_CASE("TestMemoryPool")
+{
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  FairMQMemoryPool pool{[&transport](size_t size) -> std::unique_ptr<fair::mq::Message> {
+    return std::move(transport->CreateMessage(size));
+  }};
+
+  uint8_t* ptr = nullptr;
+  REQUIRE(pool.Allocate(100, 64, &ptr).ok());
+  REQUIRE(((uintptr_t)ptr % 64) == 0);
+  REQUIRE(pool.bytes_allocated() == 100);
+  memset(ptr, 'a', 100);
+  REQUIRE(pool.Reallocate(100, 1000, 64, &ptr).ok());
+  REQUIRE(ptr[99] == 'a');
+  REQUIRE(pool.bytes_allocated() == 1000);
+  pool.Free(ptr, 1000, 64);
+  REQUIRE(pool.bytes_allocated() == 0);
+  REQUIRE(pool.num_allocations() == 2);
+
+  {
+    TableBuilder builder{&pool};
+    auto rowWriter = builder.persist<int, float>({"x", "y"});
+    for (int i = 0; i < 1000; ++i) {
+      rowWriter(0, i, 2.f * i);
+    }
+    REQUIRE(pool.bytes_allocated() > 0);
+    auto table = builder.finalize();
+    REQUIRE(table->num_rows() == 1000);
+  }
+  REQUIRE(pool.bytes_allocated() == 0);
+}
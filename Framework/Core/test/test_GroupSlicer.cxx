@@ -327,6 +327,53 @@ TEST_CASE("GroupSlicerMismatchedUnassignedGroups")
   }
 }
 
+TEST_CASE("GroupSlicerPersistentGroupIndex")
+{
+  int skip = 0;
+  TableBuilder builderT;
+  auto trksWriter = builderT.cursor<aod::TrksX>();
+  for (auto i = 0; i < 20; ++i) {
+    if (i == 3 || i == 10) {
+      trksWriter(0, -1 - skip, 1.f);
+      ++skip;
+      continue;
+    }
+    for (auto j = 0.f; j < 5; j += 0.5f) {
+      trksWriter(0, i, 0.5f * j);
+    }
+  }
+  auto trkTable = builderT.finalize();
+  auto indexedTable = ArrowTableSlicingCache::addGroupIndex(trkTable);
+  auto key = "fIndex" + o2::framework::cutString(soa::getLabelFromType<aod::Events>());
+  REQUIRE(indexedTable->schema()->GetFieldByName(key)->HasMetadata());
+  REQUIRE(indexedTable->column(0)->Equals(trkTable->column(0)));
+
+  ArrowTableSlicingCache computed({{soa::getLabelFromType<aod::TrksX>(), key}});
+  ArrowTableSlicingCache persistent({{soa::getLabelFromType<aod::TrksX>(), key}});
+  REQUIRE(computed.updateCacheEntry(0, trkTable).ok());
+  REQUIRE(persistent.updateCacheEntry(0, indexedTable).ok());
+  auto c = computed.getCacheForPos(0);
+  auto p = persistent.getCacheForPos(0);
+  REQUIRE(std::vector<int>(c.values.begin(), c.values.end()) == std::vector<int>(p.values.begin(), p.values.end()));
+  REQUIRE(std::vector<int64_t>(c.counts.begin(), c.counts.end()) == std::vector<int64_t>(p.counts.begin(), p.counts.end()));
+  REQUIRE(p.getSliceFor(5) == c.getSliceFor(5));
+  REQUIRE(p.getSliceFor(3) == c.getSliceFor(3));
+
+  // a table with a different number of rows does not use the stale info
+  auto sliced = arrow::Table::Make(indexedTable->schema(), indexedTable->Slice(0, 20)->columns(), 20);
+  REQUIRE(persistent.updateCacheEntry(0, sliced).ok());
+  REQUIRE(persistent.getCacheForPos(0).values.size() == 1);
+
+  // unsorted columns are not indexed
+  TableBuilder builderU;
+  auto trksWriterU = builderU.cursor<aod::TrksXU>();
+  for (auto i = 0; i < 20; ++i) {
+    trksWriterU(0, (i * 7) % 20, 1.f);
+  }
+  auto unsortedTable = builderU.finalize();
+  REQUIRE(ArrowTableSlicingCache::addGroupIndex(unsortedTable) == unsortedTable);
+}
+
 TEST_CASE("GroupSlicerMismatchedFilteredGroups")
 {
   TableBuilder builderE;
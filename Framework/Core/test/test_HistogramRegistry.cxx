@@ -11,6 +11,7 @@
 
 #include "Framework/HistogramRegistry.h"
 #include <catch_amalgamated.hpp>
+#include <thread>
 
 using namespace o2;
 using namespace o2::framework;
@@ -125,3 +126,108 @@ TEST_CASE("HistogramRegistryStepTHn")
 
   registry.print();
 }
+
+TEST_CASE("HistogramRegistryShards")
+{
+  HistogramRegistry registry{"registry"};
+  registry.add("pt", "p_{T}", {HistType::kTH1F, {{100, 0.0, 10.0}}});
+  registry.add("ptEta", "p_{T} vs #eta", {HistType::kTHnD, {{100, 0.0, 10.0}, {10, -1.0, 1.0}}});
+  registry.add("steps", "steps", {kStepTHnF, {{100, 0.0, 10.0}}, 2});
+
+  auto pt = registry.getHandle(HIST("pt"));
+  registry.fill(pt, 1.5);
+  REQUIRE(registry.get<TH1>(HIST("pt"))->GetEntries() == 1);
+
+  constexpr uint32_t nShards = 4;
+  constexpr int nFills = 1000;
+  registry.setNumberOfShards(nShards);
+  REQUIRE(registry.getNumberOfShards() == nShards);
+
+  auto ptEta = registry.getHandle(HIST("ptEta"));
+  std::vector<std::thread> workers;
+  for (auto shard = 0u; shard < nShards; ++shard) {
+    workers.emplace_back([&registry, shard, pt, ptEta]() {
+      for (int i = 0; i < nFills; ++i) {
+        registry.fillShard(shard, pt, 0.01 * i);
+        registry.fillShard(shard, ptEta, 0.01 * i, 0.5);
+        registry.fillShard(shard, HIST("steps"), 1, 0.01 * i);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  // nothing is visible before merging
+  REQUIRE(registry.get<TH1>(HIST("pt"))->GetEntries() == 1);
+
+  registry.mergeShards();
+  REQUIRE(registry.get<TH1>(HIST("pt"))->GetEntries() == 1 + nShards * nFills);
+  REQUIRE(registry.get<THn>(HIST("ptEta"))->GetEntries() == nShards * nFills);
+  auto steps = registry.get<StepTHn>(HIST("steps"))->getValues(1);
+  double sum = 0;
+  for (int i = 0; i < steps->GetSize(); ++i) {
+    sum += steps->GetAt(i);
+  }
+  REQUIRE(sum == nShards * nFills);
+
+  // shards are reset after merging
+  registry.mergeShards();
+  REQUIRE(registry.get<TH1>(HIST("pt"))->GetEntries() == 1 + nShards * nFills);
+}
+
+TEST_CASE("StepTHnBlockStorage")
+{
+  int nBins[] = {100, 100, 100};
+  double xmin[] = {0., 0., 0.};
+  double xmax[] = {1., 1., 1.};
+  StepTHnF dense("dense", "dense", 2, 3, nBins, xmin, xmax);
+  StepTHnF sparse("sparse", "sparse", 2, 3, nBins, xmin, xmax);
+  StepTHnF other("other", "other", 2, 3, nBins, xmin, xmax);
+  sparse.setBlockSize(64);
+  other.setBlockSize(64);
+  REQUIRE(sparse.getBlockSize() == 64);
+
+  for (auto* hist : {&dense, &sparse}) {
+    hist->Fill(0, 0.005, 0.005, 0.005);
+    hist->Fill(0, 0.995, 0.995, 0.995, 2.);
+    hist->Fill(1, 0.505, 0.505, 0.505);
+  }
+  other.Fill(0, 0.005, 0.005, 0.005);
+  other.Fill(0, 0.505, 0.505, 0.505);
+
+  // only the filled blocks are allocated
+  REQUIRE(dense.getNAllocatedBins(0) == 1000000);
+  REQUIRE(sparse.getNAllocatedBins(0) == 2 * 64);
+  REQUIRE(sparse.getNAllocatedBins(1) == 64);
+  auto lastBin = 1000000 - 1;
+  REQUIRE(sparse.getBinContent(0, 0) == 1);
+  REQUIRE(sparse.getBinContent(0, lastBin) == 2);
+  REQUIRE(sparse.getBinContent(0, 1) == 0);
+  REQUIRE(sparse.getBinContent(0, 500000) == 0);
+
+  // merging sparse into sparse, dense into sparse and sparse into dense
+  TList list;
+  list.Add(&other);
+  sparse.Merge(&list);
+  dense.Merge(&list);
+  REQUIRE(sparse.getNAllocatedBins(0) == 3 * 64);
+  TList denseList;
+  denseList.Add(&dense);
+  other.Merge(&denseList);
+
+  auto midBin = 50 * 100 * 100 + 50 * 100 + 50;
+  for (auto* hist : {&dense, &sparse}) {
+    REQUIRE(hist->getBinContent(0, 0) == 2);
+    REQUIRE(hist->getBinContent(0, lastBin) == 2);
+    REQUIRE(hist->getBinContent(0, midBin) == 1);
+    REQUIRE(hist->getBinContent(1, midBin) == 1);
+  }
+  REQUIRE(other.getBinContent(0, 0) == 3);
+  REQUIRE(other.getBinContent(0, midBin) == 2);
+
+  // conversion to THn
+  int lastBinIdx[] = {100, 100, 100};
+  int midBinIdx[] = {51, 51, 51};
+  REQUIRE(sparse.getTHn(0)->GetBinContent(lastBinIdx) == 2);
+  REQUIRE(sparse.getTHn(0)->GetBinContent(midBinIdx) == 1);
+}
@@ -133,6 +133,19 @@ TEST_CASE("TestInputRecord")
   REQUIRE(record.get<int>("x") == 1);
   REQUIRE(record.get<int>("x") == 1);
 
+  // Or through a handle, resolved only once
+  auto handleX = record.resolve("x");
+  auto handleZ = record.resolve("z");
+  auto handleErr = record.resolve("err");
+  REQUIRE(handleX.isResolved() == true);
+  REQUIRE(handleErr.isResolved() == false);
+  REQUIRE(record.get<int>(handleX) == 1);
+  REQUIRE(record.get(handleX).payload == ref00.payload);
+  REQUIRE(record.isValid(handleX) == true);
+  REQUIRE(record.isValid(handleZ) == false);
+  REQUIRE(record.isValid(handleErr) == false);
+  REQUIRE_THROWS_AS(record.get(handleErr), RuntimeErrorRef);
+
   // test the iterator
   int position = 0;
   for (auto input = record.begin(), end = record.end(); input != end; input++, position++) {
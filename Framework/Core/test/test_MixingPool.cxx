@@ -0,0 +1,123 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/MixingPool.h"
+#include "Framework/TableBuilder.h"
+#include <catch_amalgamated.hpp>
+
+using namespace o2::framework;
+using namespace o2::soa;
+
+namespace test
+{
+DECLARE_SOA_COLUMN_FULL(Z, z, float, "z");
+DECLARE_SOA_COLUMN_FULL(X, x, int32_t, "x");
+DECLARE_SOA_COLUMN_FULL(Y, y, int32_t, "y");
+DECLARE_SOA_DYNAMIC_COLUMN(Sum, sum, [](int32_t x, int32_t y) { return x + y; });
+} // namespace test
+
+using TestCollisions = o2::soa::Table<o2::soa::Index<>, test::Z>;
+using TestTracks = o2::soa::Table<o2::soa::Index<>, test::X, test::Y, test::Sum<test::X, test::Y>>;
+
+namespace
+{
+TestCollisions makeCollisions(std::vector<float> const& zs)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float>({"z"});
+  for (auto z : zs) {
+    rowWriter(0, z);
+  }
+  return TestCollisions{builder.finalize()};
+}
+
+TestTracks makeTracks(int32_t first, int n)
+{
+  TableBuilder builder;
+  auto rowWriter = builder.persist<int32_t, int32_t>({"x", "y"});
+  for (int i = 0; i < n; i++) {
+    rowWriter(0, first + i, 100);
+  }
+  return TestTracks{builder.finalize()};
+}
+} // namespace
+
+TEST_CASE("MixingPoolAcrossDataframes")
+{
+  std::vector<double> zBins{VARIABLE_WIDTH, -10.0, 0.0, 10.0};
+  ColumnBinningPolicy<test::Z> binning{{zBins}, true};
+  MixingPool<ColumnBinningPolicy<test::Z>, test::X, test::Sum<test::X, test::Y>> pool{binning, 2};
+
+  // first dataframe: collisions in bins 0, 1, 0 and out of range
+  auto collisions1 = makeCollisions({-5.f, 5.f, -3.f, 20.f});
+  pool.newDataframe();
+  int nCalls = 0;
+  int index = 0;
+  for (auto& collision : collisions1) {
+    auto tracks = makeTracks(10 * index++, 3);
+    pool.mix(collision, collisions1, tracks, [&](auto&, auto const&) { nCalls++; });
+    pool.add(collision, collisions1, tracks);
+  }
+  REQUIRE(nCalls == 0); // events of the same dataframe are not mixed
+  REQUIRE(pool.getNEvents(0) == 2);
+  REQUIRE(pool.getNEvents(1) == 1);
+  REQUIRE(pool.getNEvents(-1) == 0);
+
+  // second dataframe: one collision in bin 0, mixed with the two events of the first dataframe
+  auto collisions2 = makeCollisions({-1.f});
+  pool.newDataframe();
+  auto tracks2 = makeTracks(100, 2);
+  std::vector<std::pair<int32_t, int32_t>> pairs;
+  pool.mix(collisions2.begin(), collisions2, tracks2, [&](auto& track, auto const& pooled) {
+    REQUIRE(std::get<1>(pooled) == std::get<0>(pooled) + 100);
+    pairs.emplace_back(track.x(), std::get<0>(pooled));
+  });
+  REQUIRE(pairs.size() == 2 * 2 * 3);
+  REQUIRE(pairs[0] == std::pair<int32_t, int32_t>{100, 0});
+  REQUIRE(pairs[3] == std::pair<int32_t, int32_t>{101, 0});
+  REQUIRE(pairs[6] == std::pair<int32_t, int32_t>{100, 20});
+
+  std::vector<int64_t> pooledCollisions;
+  pool.forEachEvent(0, [&](auto const& event) { pooledCollisions.push_back(event.collisionIndex); });
+  REQUIRE(pooledCollisions == std::vector<int64_t>{0, 2});
+
+  // the ring of the bin is full, the oldest event is replaced
+  pool.add(collisions2.begin(), collisions2, tracks2);
+  REQUIRE(pool.getNEvents(0) == 2);
+  pooledCollisions.clear();
+  pool.forEachEvent(0, [&](auto const& event) { pooledCollisions.push_back(event.collisionIndex); });
+  REQUIRE(pooledCollisions == std::vector<int64_t>{2}); // the new one belongs to the current dataframe
+
+  pool.newDataframe();
+  std::vector<size_t> nRows;
+  pool.forEachEvent(0, [&](auto const& event) { nRows.push_back(event.rows.size()); });
+  REQUIRE(nRows == std::vector<size_t>{3, 2});
+}
+
+TEST_CASE("MixingPoolMaxRows")
+{
+  std::vector<double> zBins{VARIABLE_WIDTH, -10.0, 10.0};
+  ColumnBinningPolicy<test::Z> binning{{zBins}, true};
+  MixingPool<ColumnBinningPolicy<test::Z>, test::X> pool{binning, 5, 2};
+
+  auto collisions = makeCollisions({0.f});
+  auto tracks = makeTracks(0, 4);
+  pool.newDataframe();
+  pool.add(collisions.begin(), collisions, tracks);
+  pool.newDataframe();
+  std::vector<int32_t> xs;
+  pool.forEachEvent(0, [&](auto const& event) {
+    for (auto const& row : event.rows) {
+      xs.push_back(std::get<0>(row));
+    }
+  });
+  REQUIRE(xs == std::vector<int32_t>{0, 1});
+}
@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+
+#include "../src/NumaHelpers.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+TEST_CASE("TestCPUListParsing")
+{
+  REQUIRE(NumaHelpers::parseCPUList("").empty());
+  REQUIRE(NumaHelpers::parseCPUList("3") == std::vector<int>{3});
+  REQUIRE(NumaHelpers::parseCPUList("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+}
+
+TEST_CASE("TestNumaMapsParsing")
+{
+  std::istringstream maps{
+    "7f0000000000 default file=/usr/lib64/libc.so.6 mapped=3 mapmax=2 N0=3 N1=2 kernelpagesize_kB=4\n"
+    "7f1000000000 prefer:1 anon=2 dirty=2 N1=2 kernelpagesize_kB=2048\n"
+    "7f2000000000 default\n"};
+  auto placement = NumaHelpers::parseNumaMaps(maps, 1);
+  REQUIRE(placement.localBytes == 2 * 4096 + 2 * 2048 * 1024);
+  REQUIRE(placement.remoteBytes == 3 * 4096);
+}
+
+TEST_CASE("TestNumaNodeResolution")
+{
+  auto sysfs = std::filesystem::temp_directory_path() / "test_NumaHelpers";
+  std::filesystem::remove_all(sysfs);
+  auto addDevice = [&sysfs](std::string const& address, char const* deviceClass, char const* vendor, char const* node) {
+    auto path = sysfs / "bus/pci/devices" / address;
+    std::filesystem::create_directories(path);
+    std::ofstream(path / "class") << deviceClass << "\n";
+    std::ofstream(path / "vendor") << vendor << "\n";
+    std::ofstream(path / "numa_node") << node << "\n";
+  };
+  addDevice("0000:c1:00.0", "0x038000", "0x1002", "1");
+  addDevice("0000:41:00.0", "0x038000", "0x1002", "0");
+  addDevice("0000:03:00.0", "0x030000", "0x1a03", "0");
+  addDevice("0000:05:00.0", "0x020000", "0x15b3", "-1");
+  std::filesystem::create_directories(sysfs / "devices/system/node/node1");
+  std::ofstream(sysfs / "devices/system/node/node1/cpulist") << "32-33,96\n";
+
+  REQUIRE(NumaHelpers::resolveNumaNode("", sysfs) == -1);
+  REQUIRE(NumaHelpers::resolveNumaNode("1", sysfs) == 1);
+  REQUIRE(NumaHelpers::resolveNumaNode("pci:0000:c1:00.0", sysfs) == 1);
+  REQUIRE(NumaHelpers::resolveNumaNode("pci:0000:05:00.0", sysfs) == -1);
+  REQUIRE(NumaHelpers::resolveNumaNode("pci:0000:ff:00.0", sysfs) == -1);
+  // The BMC display controller is not a GPU
+  REQUIRE(NumaHelpers::resolveNumaNode("gpu:0", sysfs) == 0);
+  REQUIRE(NumaHelpers::resolveNumaNode("gpu:1", sysfs) == 1);
+  REQUIRE(NumaHelpers::resolveNumaNode("gpu:2", sysfs) == -1);
+  REQUIRE(NumaHelpers::cpusOfNumaNode(1, sysfs) == std::vector<int>{32, 33, 96});
+  REQUIRE(NumaHelpers::cpusOfNumaNode(-1, sysfs).empty());
+  std::filesystem::remove_all(sysfs);
+}
@@ -194,3 +194,66 @@ TEST_CASE("TestTimeframeSporadic")
   O2DataModelHelpers::updateMissingSporadic(inputs, outputs, present);
   REQUIRE(O2DataModelHelpers::validateOutputs(present) == true);
 }
+
+TEST_CASE("TestCoalescing")
+{
+  o2::header::DataHeader dh1;
+  dh1.dataDescription = "DIGITS";
+  dh1.dataOrigin = "FT0";
+  dh1.subSpecification = 0;
+  dh1.payloadSize = 10;
+
+  o2::header::DataHeader dh2;
+  dh2.dataDescription = "CLUSTERS";
+  dh2.dataOrigin = "ITS";
+  dh2.subSpecification = 0;
+  dh2.payloadSize = 100000;
+
+  o2::header::DataHeader dh3;
+  dh3.dataDescription = "TRIGGERS";
+  dh3.dataOrigin = "CTP";
+  dh3.subSpecification = 1;
+  dh3.payloadSize = 20;
+
+  DataProcessingHeader dph{10, 1};
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+  fair::mq::Parts parts{
+    o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh1, dph}),
+    transport->CreateMessage(10),
+    o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh2, dph}),
+    transport->CreateMessage(100000),
+    o2::pmr::getMessage(o2::header::Stack{channelAlloc, dh3, dph}),
+    transport->CreateMessage(20),
+  };
+  memset(parts.At(1)->GetData(), 'a', 10);
+  memset(parts.At(5)->GetData(), 'c', 20);
+
+  REQUIRE(O2DataModelHelpers::coalesceSmallParts(parts, transport.get(), 4096) == 2);
+  REQUIRE(parts.Size() == 4);
+  auto* coalesced = o2::header::get<o2::header::DataHeader*>(parts.At(0)->GetData());
+  REQUIRE(coalesced->dataOrigin == o2::header::DataOrigin("DPL"));
+  REQUIRE(coalesced->dataDescription == o2::header::DataDescription("COALESCED"));
+  REQUIRE(o2::header::get<DataProcessingHeader*>(parts.At(0)->GetData())->startTime == 10);
+  REQUIRE(o2::header::get<o2::header::DataHeader*>(parts.At(2)->GetData())->dataOrigin == o2::header::DataOrigin("ITS"));
+
+  // Nothing left to pack.
+  REQUIRE(O2DataModelHelpers::coalesceSmallParts(parts, transport.get(), 4096) == 0);
+
+  REQUIRE(O2DataModelHelpers::expandCoalescedParts(parts, transport.get()) == 2);
+  REQUIRE(parts.Size() == 6);
+  auto* edh1 = o2::header::get<o2::header::DataHeader*>(parts.At(0)->GetData());
+  REQUIRE(edh1->dataOrigin == o2::header::DataOrigin("FT0"));
+  REQUIRE(parts.At(1)->GetSize() == 10);
+  REQUIRE(((char*)parts.At(1)->GetData())[9] == 'a');
+  auto* edh3 = o2::header::get<o2::header::DataHeader*>(parts.At(2)->GetData());
+  REQUIRE(edh3->dataOrigin == o2::header::DataOrigin("CTP"));
+  REQUIRE(edh3->subSpecification == 1);
+  REQUIRE(parts.At(3)->GetSize() == 20);
+  REQUIRE(((char*)parts.At(3)->GetData())[0] == 'c');
+  REQUIRE(o2::header::get<o2::header::DataHeader*>(parts.At(4)->GetData())->dataOrigin == o2::header::DataOrigin("ITS"));
+  REQUIRE(parts.At(5)->GetSize() == 100000);
+
+  // Expanding again is a no-op.
+  REQUIRE(O2DataModelHelpers::expandCoalescedParts(parts, transport.get()) == 0);
+}
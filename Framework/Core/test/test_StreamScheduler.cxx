@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/StreamScheduler.h"
+
+using namespace o2::framework;
+using RecordAction = DataRelayer::RecordAction;
+
+TEST_CASE("TestOwnQueueFirst")
+{
+  StreamScheduler scheduler;
+  scheduler.resize(2);
+  REQUIRE(scheduler.size() == 2);
+  std::vector<RecordAction> actions{
+    RecordAction{TimesliceSlot{0}, TimesliceId{10}, CompletionPolicy::CompletionOp::Consume},
+    RecordAction{TimesliceSlot{1}, TimesliceId{11}, CompletionPolicy::CompletionOp::Wait},
+    RecordAction{TimesliceSlot{2}, TimesliceId{12}, CompletionPolicy::CompletionOp::Process}};
+  scheduler.push(0, actions);
+  // Wait actions are never queued.
+  REQUIRE(scheduler.queueDepth() == 2);
+  REQUIRE(scheduler.queueDepth(0) == 2);
+  REQUIRE(scheduler.queueDepth(1) == 0);
+
+  RecordAction action;
+  REQUIRE(scheduler.pop(0, action));
+  REQUIRE(action.slot.index == 0);
+  REQUIRE(scheduler.pop(0, action));
+  REQUIRE(action.slot.index == 2);
+  REQUIRE(scheduler.pop(0, action) == false);
+  REQUIRE(scheduler.stats(0).executed == 2);
+  REQUIRE(scheduler.stats(0).steals == 0);
+}
+
+TEST_CASE("TestStealing")
+{
+  StreamScheduler scheduler;
+  scheduler.resize(3);
+  std::vector<RecordAction> actions{
+    RecordAction{TimesliceSlot{0}, TimesliceId{10}, CompletionPolicy::CompletionOp::Consume},
+    RecordAction{TimesliceSlot{1}, TimesliceId{11}, CompletionPolicy::CompletionOp::Consume}};
+  scheduler.push(1, actions);
+  scheduler.push(2, {RecordAction{TimesliceSlot{2}, TimesliceId{12}, CompletionPolicy::CompletionOp::Consume}});
+
+  RecordAction action;
+  // Stealing not allowed, nothing to do for stream 0.
+  REQUIRE(scheduler.pop(0, action, false) == false);
+  // The most loaded stream is the victim and we take its most recent action.
+  REQUIRE(scheduler.pop(0, action));
+  REQUIRE(action.slot.index == 1);
+  REQUIRE(scheduler.stats(0).steals == 1);
+  REQUIRE(scheduler.queueDepth() == 2);
+  scheduler.clear();
+  REQUIRE(scheduler.queueDepth() == 0);
+  REQUIRE(scheduler.pop(0, action) == false);
+}
+
+TEST_CASE("TestIdleTime")
+{
+  StreamScheduler scheduler;
+  scheduler.resize(1);
+  scheduler.markIdle(0, 1000);
+  // Only the first idle mark counts.
+  scheduler.markIdle(0, 2000);
+  scheduler.markBusy(0, 5000);
+  scheduler.markBusy(0, 6000);
+  REQUIRE(scheduler.stats(0).idleTime == 4000);
+  REQUIRE(scheduler.totalStats().idleTime == 4000);
+}
@@ -160,3 +160,34 @@ TEST_CASE("TestOldestPossibleTimeslice")
   index.updateOldestPossibleOutput(false);
   REQUIRE(index.getOldestPossibleOutput().timeslice.value == 10);
 }
+
+TEST_CASE("TestDirtyBitmap")
+{
+  using namespace o2::framework;
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+  index.resize(130);
+  REQUIRE(TimesliceSlot::isValid(index.findDirtyBefore(130)) == false);
+  index.markAsDirty({3}, true);
+  index.markAsDirty({64}, true);
+  index.markAsDirty({129}, true);
+  REQUIRE(index.findDirtyBefore(130).index == 129);
+  REQUIRE(index.findDirtyBefore(129).index == 64);
+  REQUIRE(index.findDirtyBefore(64).index == 3);
+  REQUIRE(TimesliceSlot::isValid(index.findDirtyBefore(3)) == false);
+  index.markAsDirty({64}, false);
+  REQUIRE(index.findDirtyBefore(129).index == 3);
+  index.rescan();
+  REQUIRE(index.isDirty({0}));
+  REQUIRE(index.findDirtyBefore(130).index == 129);
+  // Growing the index must not make the new slots dirty.
+  for (size_t i = 0; i < 130; ++i) {
+    index.markAsDirty({i}, false);
+  }
+  index.rescan();
+  index.resize(100);
+  index.resize(200);
+  REQUIRE(index.isDirty({99}));
+  REQUIRE(index.isDirty({100}) == false);
+  REQUIRE(index.findDirtyBefore(200).index == 99);
+}
@@ -148,6 +148,7 @@ o2_log_handle_t* o2_walk_logs(bool (*callback)(char const* name, void* log, void
 #include <atomic>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cinttypes>
 #include <cstddef>
 
@@ -197,6 +198,40 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // Whether the signposts of the log are recorded in the trace buffers.
+  // 0 means they are not recorded.
+  int tracing = 0;
+
+  // The name of the log, used as category of the recorded events.
+  char const* name = nullptr;
+};
+
+// A signpost recorded in a trace buffer. We only keep what can be
+// stored without formatting, so that recording is cheap enough
+// for the hot paths. The name must therefore be a string literal.
+struct _o2_trace_event_t {
+  // Nanoseconds of the steady clock.
+  uint64_t timestamp = 0;
+  int64_t id = 0;
+  char const* name = nullptr;
+  _o2_log_t* log = nullptr;
+  // 'b' for the start of an interval, 'e' for its end, 'n' for an event.
+  char phase = 0;
+};
+
+// A ring buffer of the last N signposts recorded by a given thread.
+// There is only one writer, the thread itself, so recording
+// does not need any lock. The buffers are never deallocated,
+// so that the trace of the threads which are gone can still be written out.
+struct _o2_trace_buffer_t {
+  static constexpr size_t N = 1 << 16;
+  // Number of events ever recorded in this buffer.
+  std::atomic<uint64_t> head = 0;
+  // Sequential number of the thread, used as tid in the trace.
+  uint32_t thread = 0;
+  _o2_trace_buffer_t* next = nullptr;
+  _o2_trace_event_t events[N];
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -206,6 +241,32 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_log_set_tracing(_o2_log_t* log, int tracing);
+_o2_trace_buffer_t* _o2_trace_buffer_create();
+// Write the content of all the trace buffers in the Chrome trace event format,
+// which can be opened with Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+// Returns the number of events written, or -1 in case the file could not be created.
+int64_t o2_trace_dump(char const* filename);
+
+inline _o2_trace_buffer_t* _o2_trace_get_buffer()
+{
+  thread_local _o2_trace_buffer_t* buffer = nullptr;
+  if (O2_BUILTIN_UNLIKELY(buffer == nullptr)) {
+    buffer = _o2_trace_buffer_create();
+  }
+  return buffer;
+}
+
+// Record a signpost in the buffer of the current thread. Do not use this directly,
+// the signposts of a log are recorded by the O2_SIGNPOST_* macros once O2_LOG_TRACE_ENABLE is called.
+inline void _o2_trace_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char phase)
+{
+  auto* buffer = _o2_trace_get_buffer();
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  buffer->events[head & (_o2_trace_buffer_t::N - 1)] = {(uint64_t)timestamp, id.value, name, log, phase};
+  buffer->head.store(head + 1, std::memory_order_release);
+}
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -235,6 +296,7 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #include <cstdio>
 #include <cstring>
 #include <execinfo.h>
+#include <unistd.h>
 #include "Framework/RuntimeError.h"
 #include "Framework/BacktraceHelpers.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
@@ -334,6 +396,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   }
 #endif
   newHandle->name = strdup(name);
+  log->name = newHandle->name;
   newHandle->next = o2_get_logs_tail().load();
   // Until I manage to replace the log I have in next, keep trying.
   // Notice this does not protect against two threads trying to insert
@@ -458,6 +521,83 @@ void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void _o2_log_set_tracing(_o2_log_t* log, int tracing)
+{
+  log->tracing = tracing;
+}
+
+// The first trace buffer of the list, like for the logs we make it atomic
+// so that threads can add their own buffer concurrently.
+static std::atomic<_o2_trace_buffer_t*>& _o2_get_trace_buffers()
+{
+  static std::atomic<_o2_trace_buffer_t*> buffers = nullptr;
+  return buffers;
+}
+
+_o2_trace_buffer_t* _o2_trace_buffer_create()
+{
+  static std::atomic<uint32_t> threads = 0;
+  auto* buffer = new _o2_trace_buffer_t();
+  buffer->thread = threads++;
+  buffer->next = _o2_get_trace_buffers().load();
+  while (!_o2_get_trace_buffers().compare_exchange_weak(buffer->next, buffer,
+                                                       std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+  }
+  return buffer;
+}
+
+// Names and categories are string literals, but we still need to escape them for JSON.
+static void _o2_trace_write_string(FILE* out, char const* s)
+{
+  fputc('"', out);
+  for (; s && *s; ++s) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', out);
+      fputc(*s, out);
+    } else if ((unsigned char)*s < 0x20) {
+      fprintf(out, "\\u%04x", (unsigned char)*s);
+    } else {
+      fputc(*s, out);
+    }
+  }
+  fputc('"', out);
+}
+
+int64_t o2_trace_dump(char const* filename)
+{
+  FILE* out = fopen(filename, "w");
+  if (out == nullptr) {
+    return -1;
+  }
+  int pid = getpid();
+  int64_t written = 0;
+  fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (auto* buffer = _o2_get_trace_buffers().load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > _o2_trace_buffer_t::N ? head - _o2_trace_buffer_t::N : 0;
+    for (uint64_t i = first; i < head; ++i) {
+      _o2_trace_event_t event = buffer->events[i & (_o2_trace_buffer_t::N - 1)];
+      // The thread might still be recording, in which case the oldest events
+      // can be overwritten while we copy them. Skip those.
+      if (i + _o2_trace_buffer_t::N <= buffer->head.load(std::memory_order_acquire)) {
+        continue;
+      }
+      fprintf(out, "%s\n{\"name\":", written ? "," : "");
+      _o2_trace_write_string(out, event.name);
+      fprintf(out, ",\"cat\":");
+      _o2_trace_write_string(out, event.log ? event.log->name : nullptr);
+      // Intervals are async events, since they can start and end on different threads.
+      fprintf(out, ",\"ph\":\"%c\",\"id\":\"0x%" PRIx64 "\",\"ts\":%" PRIu64 ".%03" PRIu64 ",\"pid\":%d,\"tid\":%u}",
+              event.phase, (uint64_t)event.id, event.timestamp / 1000, event.timestamp % 1000, pid, buffer->thread);
+      ++written;
+    }
+  }
+  fprintf(out, "\n]}\n");
+  fclose(out);
+  return written;
+}
 // A C function which can be used to enable the signposts
 extern "C" {
 void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
@@ -477,6 +617,10 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // When we enable the log, we set the stacktrace to the default value.
 #define O2_LOG_ENABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, private_o2_log_##log->defaultStacktrace)
 #define O2_LOG_DISABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, 0)
+// Record the signposts of the log in the per thread trace buffers, regardless of them being printed.
+// Use o2_trace_dump to write the buffers out.
+#define O2_LOG_TRACE_ENABLE(log) _o2_log_set_tracing(private_o2_log_##log, 1)
+#define O2_LOG_TRACE_DISABLE(log) _o2_log_set_tracing(private_o2_log_##log, 0)
 // For the moment we simply use LOG DEBUG. We should have proper activities so that we can
 // turn on and off the printing.
 #define O2_LOG_DEBUG(log, ...) __extension__({                        \
@@ -498,6 +642,9 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                          \
+    _o2_trace_record(private_o2_log_##log, id, name, 'n');                                                         \
+  }                                                                                                                 \
 })
 
 // Similar to the above, however it will print a normal info message if the signpost is not enabled.
@@ -509,6 +656,9 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   } else {                                                                                                          \
     O2_LOG_MACRO_RAW(info, remove_engineering_type(format).data(), ##__VA_ARGS__);                                  \
   }                                                                                                                 \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                          \
+    _o2_trace_record(private_o2_log_##log, id, name, 'n');                                                         \
+  }                                                                                                                 \
 })
 
 // Similar to the above, however it will always print a normal error message regardless of the signpost being enabled or not.
@@ -519,6 +669,9 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
   O2_LOG_MACRO_RAW(error, remove_engineering_type(format).data(), ##__VA_ARGS__);                                   \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                          \
+    _o2_trace_record(private_o2_log_##log, id, name, 'n');                                                         \
+  }                                                                                                                 \
 })
 
 // Similar to the above, however it will also print a normal warning message regardless of the signpost being enabled or not.
@@ -529,26 +682,39 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
     _o2_signpost_event_emit(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
   }                                                                                                                 \
   O2_LOG_MACRO_RAW(warn, remove_engineering_type(format).data(), ##__VA_ARGS__);                                    \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                          \
+    _o2_trace_record(private_o2_log_##log, id, name, 'n');                                                         \
+  }                                                                                                                 \
 })
 
-#define O2_SIGNPOST_START(log, id, name, format, ...)                                                                   \
+#define O2_SIGNPOST_START(log, id, name, format, ...) __extension__({                                                  \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                              \
     O2_SIGNPOST_START_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                   \
     _o2_signpost_interval_begin(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
-#define O2_SIGNPOST_END(log, id, name, format, ...)                                                                   \
+  }                                                                                                                     \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                             \
+    _o2_trace_record(private_o2_log_##log, id, name, 'b');                                                              \
+  }                                                                                                                     \
+})
+#define O2_SIGNPOST_END(log, id, name, format, ...) __extension__({                                                  \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                            \
     O2_SIGNPOST_END_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                 \
     _o2_signpost_interval_end(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
+  }                                                                                                                   \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->tracing)) {                                                           \
+    _o2_trace_record(private_o2_log_##log, id, name, 'e');                                                            \
+  }                                                                                                                   \
+})
 #else // This is the release implementation, it does nothing.
 #define O2_DECLARE_DYNAMIC_LOG(x)
 #define O2_DECLARE_DYNAMIC_STACKTRACE_LOG(x)
 #define O2_DECLARE_LOG(x, category)
 #define O2_LOG_ENABLE(log)
 #define O2_LOG_DISABLE(log)
+#define O2_LOG_TRACE_ENABLE(log)
+#define O2_LOG_TRACE_DISABLE(log)
 #define O2_LOG_DEBUG(log, ...)
 #define O2_SIGNPOST_ID_FROM_POINTER(name, log, pointer)
 #define O2_SIGNPOST_ID_GENERATE(name, log)
@@ -44,6 +44,14 @@ int main(int argc, char** argv)
   O2_SIGNPOST_START(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will not see, because they are off by default");
   O2_SIGNPOST_END(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will not see, because they are off by default");
   O2_LOG_ENABLE(test_SignpostDynamic);
+
+  // Record the signposts in the trace buffers and write them out.
+  O2_LOG_TRACE_ENABLE(test_SignpostDynamic);
+  O2_SIGNPOST_START(test_SignpostDynamic, id, "Traced interval", "This is recorded in the trace");
+  O2_SIGNPOST_EVENT_EMIT(test_SignpostDynamic, id, "Traced event", "This is recorded in the trace");
+  O2_SIGNPOST_END(test_SignpostDynamic, id, "Traced interval", "This is recorded in the trace");
+  O2_LOG_TRACE_DISABLE(test_SignpostDynamic);
+  std::cout << "Signposts written to the trace: " << o2_trace_dump("test_Signpost_trace.json") << std::endl;
 #ifdef __APPLE__
   // On Apple there is no way to turn on signposts in the logger, so we do not display this message
   O2_SIGNPOST_START(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
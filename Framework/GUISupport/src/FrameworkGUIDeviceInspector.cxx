@@ -406,6 +406,23 @@ void displayDeviceInspector(DeviceSpec const& spec,
     }
   }
 
+  bool tracesChanged = false;
+  if (ImGui::CollapsingHeader("Signposts tracing", ImGuiTreeNodeFlags_DefaultOpen)) {
+    tracesChanged |= ImGui::CheckboxFlags("Device##trace", &control.traceStreams, DeviceState::LogStreams::DEVICE_LOG);
+    tracesChanged |= ImGui::CheckboxFlags("Completion##trace", &control.traceStreams, DeviceState::LogStreams::COMPLETION_LOG);
+    tracesChanged |= ImGui::CheckboxFlags("Monitoring##trace", &control.traceStreams, DeviceState::LogStreams::MONITORING_SERVICE_LOG);
+    tracesChanged |= ImGui::CheckboxFlags("DataProcessorContext##trace", &control.traceStreams, DeviceState::LogStreams::DATA_PROCESSOR_CONTEXT_LOG);
+    tracesChanged |= ImGui::CheckboxFlags("StreamContext##trace", &control.traceStreams, DeviceState::LogStreams::STREAM_CONTEXT_LOG);
+    if (tracesChanged && control.controller) {
+      std::string cmd = fmt::format("/signpost-trace {}", control.traceStreams);
+      control.controller->write(cmd.c_str(), cmd.size());
+    }
+    if (ImGui::Button("Dump trace") && control.controller) {
+      std::string cmd = "/signpost-dump";
+      control.controller->write(cmd.c_str(), cmd.size());
+    }
+  }
+
   bool flagsChanged = false;
   if (ImGui::CollapsingHeader("Event loop tracing", ImGuiTreeNodeFlags_DefaultOpen)) {
     flagsChanged |= ImGui::CheckboxFlags("METRICS_MUST_FLUSH", &control.tracingFlags, DeviceState::LoopReason::METRICS_MUST_FLUSH);
@@ -68,6 +68,13 @@ namespace framework
 ///     --nevents
 ///     --autosave
 ///     --terminate
+///     --async-flush
+///     --async-basket-size
+///
+/// \par
+/// With a positive --async-flush n, the baskets are compressed and written to disk every
+/// n events by a background thread while the next inputs are received, the baskets are
+/// then --async-basket-size MB large such that they are not written while filling.
 ///
 /// \par
 /// In addition to that, a custom option can be added for every branch to configure the
@@ -381,6 +388,11 @@ class MakeRootTreeWriterSpec
                      << "data in the output file as the number of processed input sets is counted";
       }
       processAttributes->nEventsAutoSave = ic.options().get<int>("autosave");
+      auto asyncFlush = ic.options().get<int>("async-flush");
+      if (asyncFlush > 0) {
+        auto basketSize = ic.options().get<int>("async-basket-size");
+        processAttributes->writer->setBackgroundWriter(std::make_shared<BackgroundWriter>(1), asyncFlush, basketSize * 1024 * 1024);
+      }
       try {
         processAttributes->terminationPolicy = TerminationPolicyMap.at(ic.options().get<std::string>("terminate"));
       } catch (std::out_of_range&) {
@@ -492,6 +504,8 @@ class MakeRootTreeWriterSpec
       {"nevents", VariantType::Int, mDefaultNofEvents, {"Number of events to execute"}},
       {"autosave", VariantType::Int, mDefaultAutoSave, {"Autosave after number of events"}},
       {"terminate", VariantType::String, mDefaultTerminationPolicy.c_str(), {"Terminate the 'process' or 'workflow'"}},
+      {"async-flush", VariantType::Int, 0, {"Write the baskets in a background thread after number of events (0: write while filling)"}},
+      {"async-basket-size", VariantType::Int, 64, {"Basket size in MB when writing in the background"}},
     };
     for (size_t branchIndex = 0; branchIndex < mBranchNameOptions.size(); branchIndex++) {
       // adding option definitions for those ones defined in the branch definition
@@ -25,6 +25,7 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 namespace o2::header
 {
 struct DataHeader;
@@ -92,6 +93,13 @@ struct RawParserHelper {
   static void warnDeadBeef(const o2::header::DataHeader* dh);
 };
 
+/// reference on a raw page in the buffer as filled by the page index builder
+struct PageRef {
+  size_t offset = 0;        // position of the RDH in the buffer
+  uint32_t headerSize = 0;  // size of the RDH
+  uint32_t payloadSize = 0; // size of the payload following the RDH
+};
+
 /// @class ConcreteRawParser
 /// Raw parser implementation for a particular version of RAWDataHeader.
 /// Parses a contiguous sequence of raw pages in a raw buffer.
@@ -216,24 +224,23 @@ class ConcreteRawParser
   template <typename Processor>
   void parse(Processor&& processor)
   {
-    if (!reset()) {
-      return;
-    }
-    if constexpr (BOUNDS_CHECKS) {
-      if (RawParserHelper::sErrorMode && !checkPageInBuffer()) {
-        if (RawParserHelper::sErrorMode >= 2) {
-          throw std::runtime_error("Corrupt RDH - RDH parsing ran out of raw data buffer");
-        }
-        if (RawParserHelper::checkPrintError(mNErrors)) {
-          LOG(error) << "RAWPARSER: Corrupt RDH - RDH parsing ran out of raw data buffer (" << RawParserHelper::sErrors << " total RawParser errors)";
-        }
-      }
-    }
     // auto deleter = [](buffer_type*) {};
-    do {
+    forEachPage([this, &processor]() {
       processor(data(), size());
       // processor(std::unique_ptr<buffer_type, decltype(deleter)>(data(), deleter), size());
-    } while (next());
+    });
+  }
+
+  /// Build the index of all pages of the buffer in a single pass, the pages are appended to the vector.
+  /// The index allows to process the pages independently, e.g. in parallel, w/o navigating through the RDHs.
+  /// @return number of pages added
+  size_t buildPageIndex(std::vector<PageRef>& pages)
+  {
+    size_t nPages = pages.size();
+    forEachPage([this, &pages]() {
+      pages.push_back({size_t(mPosition - mRawBuffer), uint32_t(offset()), uint32_t(size())});
+    });
+    return pages.size() - nPages;
   }
 
   /// Move to next page start
@@ -343,6 +350,28 @@ class ConcreteRawParser
   }
 
  private:
+  /// call the operation for every page of the buffer, the current position is at the page
+  template <typename Operation>
+  void forEachPage(Operation&& operation)
+  {
+    if (!reset()) {
+      return;
+    }
+    if constexpr (BOUNDS_CHECKS) {
+      if (RawParserHelper::sErrorMode && !checkPageInBuffer()) {
+        if (RawParserHelper::sErrorMode >= 2) {
+          throw std::runtime_error("Corrupt RDH - RDH parsing ran out of raw data buffer");
+        }
+        if (RawParserHelper::checkPrintError(mNErrors)) {
+          LOG(error) << "RAWPARSER: Corrupt RDH - RDH parsing ran out of raw data buffer (" << RawParserHelper::sErrors << " total RawParser errors)";
+        }
+      }
+    }
+    do {
+      operation();
+    } while (next());
+  }
+
   buffer_type const* mRawBuffer;
   buffer_type const* mPosition = nullptr;
   size_t mSize;
@@ -458,6 +487,14 @@ U const* get_if(T& instances)
 ///       auto dataptr = it.data();
 ///     }
 ///
+///     // option 3: page index, e.g. for processing the pages in parallel
+///     RawParser parser(buffer, size);
+///     std::vector<raw_parser::PageRef> pages;
+///     parser.buildPageIndex(pages);
+///     for (const auto& page : pages) {
+///       auto dataptr = buffer + page.offset + page.headerSize;
+///     }
+///
 /// TODO:
 /// - iterators are not independent at the moment and this can cause conflicts, this must be
 ///   improved
@@ -497,6 +534,23 @@ class RawParser
     return std::visit([](auto& parser) { return parser.reset(); }, mParser);
   }
 
+  /// Call the processor with the concrete parser for the RDH version found at the beginning of the buffer.
+  /// The version is resolved once per buffer and the processor can navigate the pages via the interface of
+  /// ConcreteRawParser (reset(), next(), header(), data(), size()) with the header type known at compile time,
+  /// avoiding the dispatch on every access of the iterator. Processor has signature
+  ///     auto(auto& concreteParser)
+  template <typename Processor>
+  decltype(auto) visit(Processor&& processor)
+  {
+    return std::visit(std::forward<Processor>(processor), mParser);
+  }
+
+  /// Build the index of all pages of the buffer in a single pass, see ConcreteRawParser::buildPageIndex
+  size_t buildPageIndex(std::vector<raw_parser::PageRef>& pages)
+  {
+    return std::visit([&pages](auto& parser) { return parser.buildPageIndex(pages); }, mParser);
+  }
+
   /// @struct RawDataHeaderInfo the smallest common part of all RAWDataHeader versions
   /// This struct is used as iterator value type and is a common header which can be returned
   /// for all versions of RAWDataHeader
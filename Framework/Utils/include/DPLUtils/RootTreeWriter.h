@@ -20,6 +20,7 @@
 #include "Framework/InputRecord.h"
 #include "Framework/DataRef.h"
 #include "Framework/Logger.h"
+#include "Framework/BackgroundWriter.h"
 #include <TFile.h>
 #include <TTree.h>
 #include <TBranch.h>
@@ -313,6 +314,29 @@ class RootTreeWriter
     mTree = std::make_unique<TTree>(treename, treetitle != nullptr ? treetitle : treename);
     mTree->SetDirectory(mFile.get());
     mTreeStructure->setup(mBranchSpecs, mTree.get());
+    if (mBackgroundWriter) {
+      setupBackgroundWriting();
+    }
+  }
+
+  /// Compress and write the baskets in a background thread.
+  /// @param writer         the thread writing the baskets
+  /// @param flushInterval  number of entries after which the baskets are written
+  /// @param basketSize     size of the branch baskets in bytes
+  ///
+  /// The tree is not flushed automatically anymore, and the baskets are made large
+  /// enough to hold flushInterval entries, such that nothing is written while filling.
+  /// Every flushInterval entries the filled baskets are handed to the writer, and the
+  /// next entry waits until they are written. A slow disk therefore throttles the
+  /// device, and through the DPL rate limiting its producers.
+  void setBackgroundWriter(std::shared_ptr<BackgroundWriter> writer, int flushInterval, int basketSize)
+  {
+    mBackgroundWriter = std::move(writer);
+    mFlushInterval = flushInterval > 0 ? flushInterval : 1;
+    mBasketSize = basketSize;
+    if (mTree) {
+      setupBackgroundWriting();
+    }
   }
 
   /// Set the branch name for a branch definition from the constructor argument list
@@ -345,9 +369,17 @@ class RootTreeWriter
     if (!mTree || !mFile || mFile->IsZombie()) {
       throw std::runtime_error("Writer is invalid state, probably closed previously");
     }
+    if (mBackgroundWriter) {
+      // the baskets must not be filled while they are written
+      mBackgroundWriter->drain();
+    }
     // execute tree structure handlers and fill the individual branches
     mTreeStructure->exec(std::forward<ContextType>(context), mBranchSpecs);
     // Note: number of entries will be set when closing the writer
+    if (mBackgroundWriter && ++mEntriesSinceFlush >= mFlushInterval) {
+      mEntriesSinceFlush = 0;
+      mBackgroundWriter->push([tree = mTree.get()]() { tree->FlushBaskets(); });
+    }
   }
 
   /// write the tree and close the file
@@ -359,6 +391,9 @@ class RootTreeWriter
       if (!mFile) {
         return;
       }
+      if (mBackgroundWriter) {
+        mBackgroundWriter->drain();
+      }
       if (mCustomClose) {
         mCustomClose(mFile.get(), mTree.get());
       } else {
@@ -381,6 +416,9 @@ class RootTreeWriter
     if (mIsClosed || !mFile) {
       return;
     }
+    if (mBackgroundWriter) {
+      mBackgroundWriter->drain();
+    }
     mTree->SetEntries();
     LOG(info) << "Autosaving " << mTree->GetName() << " at entry " << mTree->GetEntries();
     mTree->AutoSave("overwrite");
@@ -440,6 +478,14 @@ class RootTreeWriter
 
   using InputContext = InputRecord;
 
+  void setupBackgroundWriting()
+  {
+    mTree->SetAutoFlush(0);
+    if (mBasketSize > 0) {
+      mTree->SetBasketSize("*", mBasketSize);
+    }
+  }
+
   /// polymorphic interface for the mixin stack of branch type descriptions
   /// it implements the entry point for processing through exec method
   class TreeStructureInterface
@@ -905,6 +951,14 @@ class RootTreeWriter
   bool mIsClosed = false;
   /// custom close handler, optional
   CustomClose mCustomClose;
+  /// thread writing the baskets, optional
+  std::shared_ptr<BackgroundWriter> mBackgroundWriter;
+  /// number of entries after which the baskets are written in the background
+  int mFlushInterval = 1;
+  /// size of the branch baskets when writing in the background, 0 keeps the default
+  int mBasketSize = 0;
+  /// number of entries filled since the last flush
+  int mEntriesSinceFlush = 0;
 };
 
 } // namespace framework
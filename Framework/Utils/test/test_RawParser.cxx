@@ -82,4 +82,35 @@ TEMPLATE_TEST_CASE("test_RawParser", "[RDH][template]", V5, V6, V7)
   }
 }
 
+TEMPLATE_TEST_CASE("test_RawParserPageIndex", "[RDH][template]", V5, V6, V7)
+{
+  constexpr size_t NofPages = 5;
+  std::array<unsigned char, NofPages * PageSize> buffer;
+  fillPages<TestType>(buffer);
+
+  RawParser parser(buffer.data(), buffer.size());
+  std::vector<raw_parser::PageRef> pages;
+  REQUIRE(parser.buildPageIndex(pages) == NofPages);
+  REQUIRE(pages.size() == NofPages);
+  for (size_t pageNo = 0; pageNo < NofPages; pageNo++) {
+    REQUIRE(pages[pageNo].offset == pageNo * PageSize);
+    REQUIRE(pages[pageNo].headerSize == sizeof(TestType));
+    REQUIRE(pages[pageNo].payloadSize == PageSize - sizeof(TestType));
+    REQUIRE(*reinterpret_cast<size_t const*>(buffer.data() + pages[pageNo].offset + pages[pageNo].headerSize) == pageNo);
+  }
+
+  // the concrete parser of the RDH version is resolved once
+  size_t count = 0;
+  parser.visit([&count](auto& concreteParser) {
+    using header_type = typename std::decay_t<decltype(concreteParser)>::header_type;
+    REQUIRE(std::is_same_v<header_type, TestType>);
+    concreteParser.reset();
+    do {
+      REQUIRE(concreteParser.header().pageCnt == count);
+      count++;
+    } while (concreteParser.next());
+  });
+  REQUIRE(count == NofPages);
+}
+
 } // namespace o2::framework
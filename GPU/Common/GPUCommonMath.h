@@ -75,7 +75,10 @@ class GPUCommonMath
   GPUd() static CONSTEXPR float Pi() { return 3.1415927f; }
   GPUd() static float Round(float x);
   GPUd() static float Floor(float x);
-  GPUd() static unsigned int Float2UIntReint(const float& x);
+  GPUhd() static unsigned int Float2UIntReint(const float& x);
+  GPUhd() static float UInt2FloatReint(unsigned int x);
+  GPUhd() static unsigned short Float2BFloat16Rn(float x);
+  GPUhd() static float BFloat162Float(unsigned short x);
   GPUd() static unsigned int Float2UIntRn(float x);
   GPUd() static int Float2IntRn(float x);
   GPUd() static float Modf(float x, float y);
@@ -209,7 +212,7 @@ GPUdi() float2 GPUCommonMath::MakeFloat2(float x, float y)
 
 GPUdi() float GPUCommonMath::Modf(float x, float y) { return CHOICE(fmodf(x, y), fmodf(x, y), fmod(x, y)); }
 
-GPUdi() unsigned int GPUCommonMath::Float2UIntReint(const float& x)
+GPUhdi() unsigned int GPUCommonMath::Float2UIntReint(const float& x)
 {
 #if defined(GPUCA_GPUCODE_DEVICE) && (defined(__CUDACC__) || defined(__HIPCC__))
   return __float_as_uint(x);
@@ -220,6 +223,26 @@ GPUdi() unsigned int GPUCommonMath::Float2UIntReint(const float& x)
 #endif
 }
 
+GPUhdi() float GPUCommonMath::UInt2FloatReint(unsigned int x)
+{
+#if defined(GPUCA_GPUCODE_DEVICE) && (defined(__CUDACC__) || defined(__HIPCC__))
+  return __uint_as_float(x);
+#elif defined(GPUCA_GPUCODE_DEVICE) && (defined(__OPENCL__) || defined(__OPENCLCPP__))
+  return as_float(x);
+#else
+  return reinterpret_cast<const float&>(x);
+#endif
+}
+
+// bfloat16: upper 16 bits of the float, rounded to nearest even, i.e. full float range but 8 bits of mantissa
+GPUhdi() unsigned short GPUCommonMath::Float2BFloat16Rn(float x)
+{
+  unsigned int bits = Float2UIntReint(x);
+  return (unsigned short)((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+GPUhdi() float GPUCommonMath::BFloat162Float(unsigned short x) { return UInt2FloatReint((unsigned int)x << 16); }
+
 GPUdi() unsigned int GPUCommonMath::Float2UIntRn(float x) { return (unsigned int)(int)(x + 0.5f); }
 GPUdi() float GPUCommonMath::Floor(float x) { return CHOICE(floorf(x), floorf(x), floor(x)); }
 
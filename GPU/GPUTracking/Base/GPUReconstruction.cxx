@@ -22,6 +22,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <array>
+#include <fstream>
+#include <sstream>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -318,6 +320,9 @@ int GPUReconstruction::InitPhaseBeforeDevice()
     mProcessingSettings.rtc.optConstexpr = false;
   }
 
+  if (mProcessingSettings.memoryScalerFile != "" && mMemoryScalers->readCalibratedFactors(mProcessingSettings.memoryScalerFile.c_str())) {
+    return 1;
+  }
   mMemoryScalers->factor = mProcessingSettings.memoryScalingFactor;
   mMemoryScalers->conservative = mProcessingSettings.conservativeMemoryEstimate;
   mMemoryScalers->returnMaxVal = mProcessingSettings.forceMaxMemScalers != 0;
@@ -364,6 +369,11 @@ int GPUReconstruction::InitPhaseBeforeDevice()
     return 1;
   }
 
+  if (mProcessingSettings.kernelProfiling && mProcessingSettings.doublePipeline) {
+    GPUError("Kernel profiling is not supported in double pipeline mode");
+    return 1;
+  }
+
   if (mMaster == nullptr && mProcessingSettings.doublePipeline) {
     mPipelineContext.reset(new GPUReconstructionPipelineContext);
   }
@@ -393,6 +403,9 @@ int GPUReconstruction::InitPhaseBeforeDevice()
   if (mProcessingSettings.forceHostMemoryPoolSize) {
     mHostMemorySize = mProcessingSettings.forceHostMemoryPoolSize;
   }
+  if (IsGPU() && mDeviceBackendSettings.externalHostMemoryPool) {
+    mHostMemorySize = mDeviceBackendSettings.externalHostMemoryPoolSize;
+  }
 
   for (unsigned int i = 0; i < mProcessors.size(); i++) {
     (mProcessors[i].proc->*(mProcessors[i].RegisterMemoryAllocation))();
@@ -528,6 +541,15 @@ size_t GPUReconstruction::AllocateRegisteredPermanentMemory()
       total += AllocateRegisteredMemory(i);
     }
   }
+  if (IsGPU() && mMaster == nullptr && mProcessingSettings.unmanagedMemoryReserve && mProcessingSettings.memoryAllocationStrategy != GPUMemoryResource::ALLOCATION_INDIVIDUAL) {
+    GPUProcessor::computePointerWithAlignment(mDeviceMemoryPool, mUnmanagedMemoryReserveBase, mProcessingSettings.unmanagedMemoryReserve);
+    if (mDeviceMemoryPool > mDeviceMemoryPoolEnd) {
+      GPUError("Insufficient device memory to reserve %lu bytes for unmanaged allocations", (unsigned long)mProcessingSettings.unmanagedMemoryReserve);
+      throw std::bad_alloc();
+    }
+    mUnmanagedMemoryReservePool = mUnmanagedMemoryReserveBase;
+    mUnmanagedMemoryReserveSize = mProcessingSettings.unmanagedMemoryReserve;
+  }
   mHostMemoryPermanent = mHostMemoryPool;
   mDeviceMemoryPermanent = mDeviceMemoryPool;
   if (mProcessingSettings.debugLevel >= 5) {
@@ -694,6 +716,19 @@ void* GPUReconstruction::AllocateUnmanagedMemory(size_t size, int type)
   if (mProcessingSettings.memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_INDIVIDUAL) {
     mUnmanagedChunks.emplace_back(new char[size + GPUCA_BUFFER_ALIGNMENT]);
     return GPUProcessor::alignPointer<GPUCA_BUFFER_ALIGNMENT>(mUnmanagedChunks.back().get());
+  } else if (type == GPUMemoryResource::MEMORY_GPU && (mMaster ? mMaster : this)->mUnmanagedMemoryReserveSize) {
+    GPUReconstruction& master = mMaster ? *mMaster : *this;
+    std::lock_guard<std::mutex> lock(master.mUnmanagedMemoryMutex);
+    char* retVal;
+    GPUProcessor::computePointerWithAlignment(master.mUnmanagedMemoryReservePool, retVal, size);
+    if ((char*)master.mUnmanagedMemoryReservePool > (char*)master.mUnmanagedMemoryReserveBase + master.mUnmanagedMemoryReserveSize) {
+      GPUError("Insufficient reserved unmanaged memory: missing %lu bytes", (size_t)((char*)master.mUnmanagedMemoryReservePool - ((char*)master.mUnmanagedMemoryReserveBase + master.mUnmanagedMemoryReserveSize)));
+      throw std::bad_alloc();
+    }
+    if (mProcessingSettings.allocDebugLevel >= 2) {
+      std::cout << "Allocated (unmanaged reserved gpu): " << size << " - available: " << ((char*)master.mUnmanagedMemoryReserveBase + master.mUnmanagedMemoryReserveSize - (char*)master.mUnmanagedMemoryReservePool) << "\n";
+    }
+    return retVal;
   } else {
     void*& pool = type == GPUMemoryResource::MEMORY_GPU ? mDeviceMemoryPool : mHostMemoryPool;
     void*& poolend = type == GPUMemoryResource::MEMORY_GPU ? mDeviceMemoryPoolEnd : mHostMemoryPoolEnd;
@@ -888,6 +923,10 @@ void GPUReconstruction::ClearAllocatedMemory(bool clearOutputs)
   mHostMemoryPool = GPUProcessor::alignPointer<GPUCA_MEMALIGN>(mHostMemoryPermanent);
   mDeviceMemoryPool = GPUProcessor::alignPointer<GPUCA_MEMALIGN>(mDeviceMemoryPermanent);
   mUnmanagedChunks.clear();
+  if (mUnmanagedMemoryReserveSize) {
+    std::lock_guard<std::mutex> lock(mUnmanagedMemoryMutex);
+    mUnmanagedMemoryReservePool = mUnmanagedMemoryReserveBase;
+  }
   mVolatileMemoryStart = nullptr;
   mNonPersistentMemoryStack.clear();
   mNonPersistentIndividualAllocations.clear();
@@ -1136,6 +1175,81 @@ int GPUReconstruction::ReadSettings(const char* dir)
   return 0;
 }
 
+int GPUReconstruction::ReadKernelParameters(const char* filename)
+{
+  // Format: one kernel per line: <architecture> <kernel name> <threads per block> <blocks per multiprocessor>, # starts a comment
+  std::ifstream in(filename);
+  if (!in) {
+    GPUError("Cannot open kernel parameter file %s", filename);
+    return 1;
+  }
+  std::string line;
+  unsigned int nLine = 0;
+  while (std::getline(in, line)) {
+    nLine++;
+    line = line.substr(0, line.find('#'));
+    std::istringstream str(line);
+    std::string arch, kernel;
+    kernelParameters p;
+    if (!(str >> arch)) {
+      continue;
+    }
+    if (!(str >> kernel >> p.nThreads >> p.minBlocks)) {
+      GPUError("Invalid entry in line %u of kernel parameter file %s", nLine, filename);
+      return 1;
+    }
+    if (arch == mDeviceArchitecture) {
+      mKernelParameters[kernel] = p;
+    }
+  }
+  if (mProcessingSettings.debugLevel >= 0) {
+    GPUInfo("Read launch parameters for %d kernels for architecture %s from %s", (int)mKernelParameters.size(), mDeviceArchitecture.c_str(), filename);
+  }
+  return 0;
+}
+
+int GPUReconstruction::WriteKernelParameters(const char* filename, const std::unordered_map<std::string, kernelParameters>& params) const
+{
+  std::vector<std::string> otherArchitectures; // Keep entries of other architectures, replace the ones of the current device
+  {
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream str(line.substr(0, line.find('#')));
+      std::string arch;
+      if (str >> arch && arch != mDeviceArchitecture) {
+        otherArchitectures.emplace_back(line);
+      }
+    }
+  }
+  std::ofstream out(filename);
+  if (!out) {
+    GPUError("Cannot write kernel parameter file %s", filename);
+    return 1;
+  }
+  out << "# <architecture> <kernel> <threads per block> <blocks per multiprocessor>, 0 = compiled default\n";
+  for (const auto& line : otherArchitectures) {
+    out << line << "\n";
+  }
+  std::map<std::string, kernelParameters> sorted(params.begin(), params.end());
+  for (const auto& p : sorted) {
+    out << mDeviceArchitecture << " " << p.first << " " << p.second.nThreads << " " << p.second.minBlocks << "\n";
+  }
+  return out.good() ? 0 : 1;
+}
+
+bool GPUReconstruction::KernelHasFixedThreadCount(const std::string& kernel)
+{
+  // These kernels use their compile-time thread count in device code, e.g. for shared memory arrays, block-wide scans, or the work distribution
+  static const char* fixed[] = {"GPUTPCCF", "GPUTPCNeighboursFinder", "GPUTPCTrackletConstructor", "GPUTPCTrackletSelector", "GPUTPCGMMergerResolve", "GPUTPCCompressionKernels_step1unattached", "GPUTPCCompressionGatherKernels"};
+  for (const char* f : fixed) {
+    if (kernel.rfind(f, 0) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void GPUReconstruction::SetSettings(float solenoidBzNominalGPU, const GPURecoStepConfiguration* workflow)
 {
 #ifdef GPUCA_O2_LIB
@@ -20,6 +20,7 @@
 #include <cstring>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <iosfwd>
 #include <vector>
 #include <unordered_map>
@@ -58,6 +59,19 @@ namespace gpu_reconstruction_kernels
 struct deviceEvent;
 }
 
+struct GPUKernelProfile { // Filled per TF by the kernel profiler (processing option kernelProfiling)
+  struct kernel {
+    std::string name;
+    unsigned int count = 0; // Number of launches
+    double time = 0.;       // Summed execution time in s
+    double occupancy = 0.;  // Time-weighted mean fraction of the device threads covered by the launch grids
+  };
+  std::vector<kernel> kernels;
+  size_t bytesToGPU = 0;
+  size_t bytesToHost = 0;
+  unsigned int nDropped = 0; // Launches not timed since kernelProfilingMaxLaunches was exceeded
+};
+
 class GPUReconstruction
 {
   friend class GPUChain;
@@ -140,6 +154,18 @@ class GPUReconstruction
   void DumpSettings(const char* dir = "");
   int ReadSettings(const char* dir = "");
 
+  // Runtime overrides of the kernel launch parameters, per kernel name
+  struct kernelParameters {
+    unsigned int nThreads = 0;  // Threads per block, 0 = compiled default, cannot exceed the compiled launch bounds
+    unsigned int minBlocks = 0; // Blocks per multiprocessor, 0 = compiled default
+  };
+  int ReadKernelParameters(const char* filename);
+  int WriteKernelParameters(const char* filename, const std::unordered_map<std::string, kernelParameters>& params) const;
+  void SetKernelParameters(const std::unordered_map<std::string, kernelParameters>& params) { mKernelParameters = params; }
+  const std::unordered_map<std::string, kernelParameters>& GetKernelParameters() const { return mKernelParameters; }
+  const std::string& GetDeviceArchitecture() const { return mDeviceArchitecture; }
+  static bool KernelHasFixedThreadCount(const std::string& kernel);
+
   void PrepareEvent();
   virtual int RunChains() = 0;
   unsigned int getNEventsProcessed() { return mNEventsProcessed; }
@@ -232,6 +258,8 @@ class GPUReconstruction
   virtual void PrintKernelOccupancies() {}
   double GetStatKernelTime() { return mStatKernelTime; }
   double GetStatWallTime() { return mStatWallTime; }
+  const std::unordered_map<std::string, double>& GetStatKernelTimes() { return mStatKernelTimes; } // us per event, only filled with debugLevel >= 1
+  const GPUKernelProfile& GetKernelProfile() const { return mKernelProfile; }                      // Last TF, only filled with kernelProfiling
 
  protected:
   void AllocateRegisteredMemoryInternal(GPUMemoryResource* res, GPUOutputControl* control, GPUReconstruction* recPool);
@@ -310,6 +338,9 @@ class GPUReconstruction
   InOutTypeField mRecoStepsOutputs = 0;
 
   std::string mDeviceName = "CPU";
+  std::string mDeviceArchitecture = "CPU"; // Key for the kernel launch parameters, e.g. sm_80 or gfx90a
+
+  std::unordered_map<std::string, kernelParameters> mKernelParameters; // Launch parameters overriding the compiled defaults
 
   // Ptrs to host and device memory;
   void* mHostMemoryBase = nullptr;          // Ptr to begin of large host memory buffer
@@ -326,6 +357,10 @@ class GPUReconstruction
   void* mDeviceMemoryPoolBlocked = nullptr; //
   size_t mDeviceMemorySize = 0;             //
   void* mVolatileMemoryStart = nullptr;     // Ptr to beginning of temporary volatile memory allocation, nullptr if uninitialized
+  void* mUnmanagedMemoryReserveBase = nullptr; // Ptr to device memory reserved for unmanaged allocations, which are then independent from the memory stack
+  void* mUnmanagedMemoryReservePool = nullptr; // Ptr to next free location in the reserved unmanaged memory
+  size_t mUnmanagedMemoryReserveSize = 0;      // Size of the reserved unmanaged memory
+  std::mutex mUnmanagedMemoryMutex;            // Serializes unmanaged allocations from concurrent chains (e.g. ITS tracking running alongside TPC)
   size_t mDeviceMemoryUsedMax = 0;          //
 
   std::unordered_set<const void*> mRegisteredMemoryPtrs; // List of pointers registered for GPU
@@ -339,6 +374,8 @@ class GPUReconstruction
   unsigned int mNEventsProcessed = 0;
   double mStatKernelTime = 0.;
   double mStatWallTime = 0.;
+  std::unordered_map<std::string, double> mStatKernelTimes;
+  GPUKernelProfile mKernelProfile;
   std::shared_ptr<GPUROOTDumpCore> mROOTDump;
   std::vector<std::array<unsigned int, 4>>* mOutputErrorCodes = nullptr;
 
@@ -58,6 +58,9 @@ GPUReconstruction* GPUReconstruction::GPUReconstruction_Create_CPU(const GPUSett
 GPUReconstructionCPU::~GPUReconstructionCPU()
 {
   Exit(); // Needs to be identical to GPU backend bahavior in order to avoid calling abstract methods later in the destructor
+  if (mKernelProfileTraceFile) {
+    fclose(mKernelProfileTraceFile);
+  }
 }
 
 template <class T, int I, typename... Args>
@@ -73,8 +76,17 @@ inline int GPUReconstructionCPUBackend::runKernelBackendInternal(const krnlSetup
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
   for (unsigned int k = 0; k < num; k++) {
+    if (mNestedLoopOmpTasks) {
+      // The idle threads of the enclosing parallel region pick up the blocks, the calling thread only executes blocks of its own kernel while waiting
+      GPUCA_OPENMP(taskloop grainsize(1))
+      for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+        typename T::GPUSharedMemory smem;
+        T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      }
+      continue;
+    }
     int ompThreads = 0;
-    if (mProcessingSettings.ompKernels == 2) {
+    if (mProcessingSettings.ompKernels >= 2) {
       ompThreads = mProcessingSettings.ompThreads / mNestedLoopOmpFactor;
       if ((unsigned int)getOMPThreadNum() < mProcessingSettings.ompThreads % mNestedLoopOmpFactor) {
         ompThreads++;
@@ -193,6 +205,7 @@ int GPUReconstructionCPU::InitDevice()
   }
   mThreadId = GetThread();
   mProcShadow.mProcessorsProc = processors();
+  kernelProfileInit();
   return 0;
 }
 
@@ -229,12 +242,18 @@ int GPUReconstructionCPU::RunChains()
     if (mSlaves.size() || mMaster) {
       WriteConstantParams(); // Reinitialize
     }
+    if (mProcessingSettings.kernelProfiling) {
+      kernelProfileBeginTF();
+    }
     for (unsigned int i = 0; i < mChains.size(); i++) {
       int retVal = mChains[i]->RunChain();
       if (retVal) {
         return retVal;
       }
     }
+    if (mProcessingSettings.kernelProfiling) {
+      kernelProfileCollect();
+    }
   }
   timerTotal.Stop();
 
@@ -259,6 +278,7 @@ int GPUReconstructionCPU::RunChains()
       char type = mTimers[i]->type;
       if (type == 0) {
         kernelTotal += time;
+        mStatKernelTimes[mTimers[i]->name] = time * 1000000 / mStatNEvents;
         int stepNum = getRecoStepNum(mTimers[i]->step);
         kernelStepTimes[stepNum] += time;
       }
@@ -368,6 +388,121 @@ GPUReconstructionCPU::timerMeta* GPUReconstructionCPU::getTimerById(unsigned int
   return retVal;
 }
 
+void GPUReconstructionCPU::applyKernelParameters(const char* kernel, krnlProperties& prop) const
+{
+  auto it = mKernelParameters.find(kernel);
+  if (it == mKernelParameters.end()) {
+    return;
+  }
+  if (it->second.nThreads && !KernelHasFixedThreadCount(it->first)) {
+    prop.nThreads = std::min(prop.nThreads, it->second.nThreads); // Must not exceed the launch bounds of the compiled kernel
+  }
+  if (it->second.minBlocks) {
+    prop.minBlocks = it->second.minBlocks;
+  }
+}
+
+void GPUReconstructionCPU::kernelProfileInit()
+{
+  if (!mProcessingSettings.kernelProfiling) {
+    return;
+  }
+  mKernelProfileRecords.resize(mProcessingSettings.kernelProfilingMaxLaunches);
+  mKernelProfileTimer.ResetStart();
+  if (mProcessingSettings.kernelProfilingTraceFile != "" && mKernelProfileTraceFile == nullptr) {
+    mKernelProfileTraceFile = fopen(mProcessingSettings.kernelProfilingTraceFile.c_str(), "a");
+    if (mKernelProfileTraceFile == nullptr) {
+      GPUError("Cannot open kernel profiling trace file %s", mProcessingSettings.kernelProfilingTraceFile.c_str());
+    } else if (fseek(mKernelProfileTraceFile, 0, SEEK_END) == 0 && ftell(mKernelProfileTraceFile) == 0) {
+      fprintf(mKernelProfileTraceFile, "[\n"); // The closing bracket is optional in the Chrome trace array format, so that we can append during processing
+    }
+  }
+  kernelProfileBeginTF();
+}
+
+void GPUReconstructionCPU::kernelProfileBeginTF()
+{
+  mKernelProfile.bytesToGPU = mKernelProfile.bytesToHost = 0;
+  if (mKernelProfileNRecords == 0) { // Otherwise keep the reference of the kernels launched since the last collection
+    mKernelProfileTFStart = mKernelProfileTimer.GetCurrentElapsedTime();
+    if (mKernelProfileEvents) {
+      RecordMarker(mKernelProfileEvents[0], 0);
+    }
+  }
+}
+
+unsigned int GPUReconstructionCPU::kernelProfileStart(const char* name, int stream, unsigned int nThreads)
+{
+  const unsigned int id = mKernelProfileNRecords.fetch_add(1);
+  if (id >= mKernelProfileRecords.size()) {
+    return (unsigned int)-1;
+  }
+  kernelProfileRecord& r = mKernelProfileRecords[id];
+  r.name = name;
+  r.stream = mKernelProfileEvents ? stream : -1;
+  r.nThreads = nThreads;
+  if (r.stream >= 0) {
+    RecordMarker(mKernelProfileEvents[1 + 2 * id], stream);
+  } else {
+    r.start = mKernelProfileTimer.GetCurrentElapsedTime();
+  }
+  return id;
+}
+
+void GPUReconstructionCPU::kernelProfileStop(unsigned int id)
+{
+  kernelProfileRecord& r = mKernelProfileRecords[id];
+  if (r.stream >= 0) {
+    RecordMarker(mKernelProfileEvents[2 + 2 * id], r.stream);
+  } else {
+    r.end = mKernelProfileTimer.GetCurrentElapsedTime();
+  }
+}
+
+void GPUReconstructionCPU::kernelProfileCollect()
+{
+  const unsigned int nLaunches = mKernelProfileNRecords.load();
+  const unsigned int n = std::min<unsigned int>(nLaunches, mKernelProfileRecords.size());
+  mKernelProfile.kernels.clear();
+  mKernelProfile.nDropped = nLaunches - n;
+  if (mKernelProfileEvents) {
+    SynchronizeGPU(); // The events of the last kernels must have completed, usually the chain is synchronized already
+  }
+  std::unordered_map<const char*, unsigned int> kernelIndex;
+  for (unsigned int i = 0; i < n; i++) {
+    kernelProfileRecord& r = mKernelProfileRecords[i];
+    if (r.stream >= 0) {
+      r.start = mKernelProfileTFStart + GetEventElapsedTime(mKernelProfileEvents[0], mKernelProfileEvents[1 + 2 * i]);
+      r.end = mKernelProfileTFStart + GetEventElapsedTime(mKernelProfileEvents[0], mKernelProfileEvents[2 + 2 * i]);
+    }
+    auto it = kernelIndex.emplace(r.name, mKernelProfile.kernels.size());
+    if (it.second) {
+      mKernelProfile.kernels.emplace_back();
+      mKernelProfile.kernels.back().name = r.name;
+    }
+    GPUKernelProfile::kernel& k = mKernelProfile.kernels[it.first->second];
+    const double time = r.end - r.start;
+    k.count++;
+    k.time += time;
+    k.occupancy += time * std::min(1., (double)r.nThreads / std::max(1, mMaxThreads));
+    if (mKernelProfileTraceFile) {
+      fprintf(mKernelProfileTraceFile, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"TF\":%u,\"threads\":%u}},\n", r.name, r.stream >= 0 ? "GPU" : "CPU", r.start * 1e6, time * 1e6, mMaster ? 1 : 0, r.stream, mNEventsProcessed, r.nThreads);
+    }
+  }
+  for (unsigned int i = 0; i < mKernelProfile.kernels.size(); i++) {
+    if (mKernelProfile.kernels[i].time > 0.) {
+      mKernelProfile.kernels[i].occupancy /= mKernelProfile.kernels[i].time;
+    }
+  }
+  if (mKernelProfileTraceFile) {
+    fflush(mKernelProfileTraceFile);
+  }
+  mKernelProfileNRecords = 0;
+  if (mKernelProfile.nDropped && mProcessingSettings.debugLevel >= 0) {
+    GPUWarning("Kernel profiler did not time %u of %u kernel launches, increase kernelProfilingMaxLaunches", mKernelProfile.nDropped, nLaunches);
+  }
+}
+
 unsigned int GPUReconstructionCPU::getNextTimerId()
 {
   static std::atomic<unsigned int> id{0};
@@ -377,7 +512,7 @@ unsigned int GPUReconstructionCPU::getNextTimerId()
 unsigned int GPUReconstructionCPU::SetAndGetNestedLoopOmpFactor(bool condition, unsigned int max)
 {
   if (condition && mProcessingSettings.ompKernels != 1) {
-    mNestedLoopOmpFactor = mProcessingSettings.ompKernels == 2 ? std::min<unsigned int>(max, mProcessingSettings.ompThreads) : mProcessingSettings.ompThreads;
+    mNestedLoopOmpFactor = mProcessingSettings.ompKernels >= 2 ? std::min<unsigned int>(max, mProcessingSettings.ompThreads) : mProcessingSettings.ompThreads;
   } else {
     mNestedLoopOmpFactor = 1;
   }
@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include "utils/timer.h"
 #include <vector>
+#include <atomic>
 
 #include "GPUGeneralKernels.h"
 #include "GPUReconstructionKernelIncludes.h"
@@ -45,6 +46,7 @@ class GPUReconstructionCPUBackend : public GPUReconstruction
   template <class T, int I>
   gpu_reconstruction_kernels::krnlProperties getKernelPropertiesBackend();
   unsigned int mNestedLoopOmpFactor = 1;
+  bool mNestedLoopOmpTasks = false; // Kernels are called from OMP tasks, their blocks are spawned as tasks as well
   static int getOMPThreadNum();
   static int getOMPMaxThreads();
 };
@@ -64,7 +66,11 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   template <class S, int I = 0>
   const gpu_reconstruction_kernels::krnlProperties getKernelProperties()
   {
-    return getKernelPropertiesImpl(gpu_reconstruction_kernels::classArgument<S, I>());
+    auto prop = getKernelPropertiesImpl(gpu_reconstruction_kernels::classArgument<S, I>());
+    if (mKernelParameters.size()) {
+      applyKernelParameters(GetKernelName<S, I>(), prop);
+    }
+    return prop;
   }
 
   template <class T, int I>
@@ -82,6 +88,7 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   HighResTimer& getGeneralStepTimer(GeneralStep step) { return mTimersGeneralSteps[getGeneralStepNum(step)]; }
 
   void SetNestedLoopOmpFactor(unsigned int f) { mNestedLoopOmpFactor = f; }
+  void SetNestedLoopOmpTasks(bool v) { mNestedLoopOmpTasks = v; }
   unsigned int SetAndGetNestedLoopOmpFactor(bool condition, unsigned int max);
 
   void UpdateParamOccupancyMap(const unsigned int* mapHost, const unsigned int* mapGPU, unsigned int occupancyTotal, int stream = -1);
@@ -115,8 +122,11 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
   virtual void StreamWaitForEvents(int stream, deviceEvent* evList, int nEvents = 1) {}
   virtual bool IsEventDone(deviceEvent* evList, int nEvents = 1) { return true; }
   virtual void RecordMarker(deviceEvent ev, int stream) {}
+  virtual bool RunKernelGraph(int graph, int stream, unsigned long long key) { return false; } // Returns true if a recorded graph was replayed, otherwise the kernels must be launched and may be recorded
+  virtual void FinishKernelGraph(int graph, int stream) {}
   virtual void SynchronizeGPU() {}
   virtual void ReleaseEvent(deviceEvent ev) {}
+  virtual double GetEventElapsedTime(deviceEvent start, deviceEvent end) { return 0.; } // In s, both events must have completed
   virtual int StartHelperThreads() { return 0; }
   virtual int StopHelperThreads() { return 0; }
   virtual void RunHelperThreads(int (GPUReconstructionHelpers::helperDelegateBase::*function)(int, int, GPUReconstructionHelpers::helperParam*), GPUReconstructionHelpers::helperDelegateBase* functionCls, int count) {}
@@ -183,8 +193,28 @@ class GPUReconstructionCPU : public GPUReconstructionKernels<GPUReconstructionCP
 
   std::vector<std::vector<deviceEvent>> mEvents;
 
+  struct kernelProfileRecord {
+    const char* name;
+    int stream;            // -1 for kernels executed on the CPU
+    unsigned int nThreads; // Blocks * threads of the launch
+    double start;          // Host time in s for kernels on the CPU, otherwise obtained from the events at collection
+    double end;
+  };
+  std::vector<kernelProfileRecord> mKernelProfileRecords;
+  std::atomic<unsigned int> mKernelProfileNRecords{0};
+  deviceEvent* mKernelProfileEvents = nullptr; // Reference event of the TF, followed by a start / end pair per record
+  HighResTimer mKernelProfileTimer;
+  double mKernelProfileTFStart = 0.;
+  FILE* mKernelProfileTraceFile = nullptr;
+  unsigned int kernelProfileStart(const char* name, int stream, unsigned int nThreads);
+  void kernelProfileStop(unsigned int id);
+  void kernelProfileInit();
+  void kernelProfileBeginTF();
+  void kernelProfileCollect();
+
  private:
   size_t TransferMemoryResourcesHelper(GPUProcessor* proc, int stream, bool all, bool toGPU);
+  void applyKernelParameters(const char* kernel, gpu_reconstruction_kernels::krnlProperties& prop) const;
   unsigned int getNextTimerId();
   timerMeta* getTimerById(unsigned int id);
   timerMeta* insertTimer(unsigned int id, std::string&& name, int J, int num, int type, RecoStep step);
@@ -232,8 +262,12 @@ inline int GPUReconstructionCPU::runKernel(krnlSetup&& setup, Args&&... args)
       t->Start();
     }
   }
+  unsigned int profileId = mProcessingSettings.kernelProfiling ? kernelProfileStart(GetKernelName<S, I>(), !IsGPU() || cpuFallback ? -1 : (int)stream, nBlocks * nThreads) : (unsigned int)-1;
   double deviceTimerTime = 0.;
   int retVal = runKernelImplWrapper(gpu_reconstruction_kernels::classArgument<S, I>(), cpuFallback, deviceTimerTime, std::forward<krnlSetup&&>(setup), std::forward<Args>(args)...);
+  if (profileId != (unsigned int)-1) {
+    kernelProfileStop(profileId);
+  }
   if (GPUDebug(GetKernelName<S, I>(), stream)) {
     throw std::runtime_error("kernel failure");
   }
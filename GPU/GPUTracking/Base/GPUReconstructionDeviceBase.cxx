@@ -249,6 +249,10 @@ int GPUReconstructionDeviceBase::InitDevice()
   if (mProcessingSettings.deviceTimers) {
     AddGPUEvents(mDebugEvents);
   }
+  if (mProcessingSettings.kernelProfiling) {
+    mEvents.emplace_back(std::vector<deviceEvent>(1 + 2 * mProcessingSettings.kernelProfilingMaxLaunches));
+    mKernelProfileEvents = mEvents.back().data();
+  }
 
   int retVal = InitDevice_Runtime();
   if (retVal) {
@@ -259,6 +263,7 @@ int GPUReconstructionDeviceBase::InitDevice()
   if (mProcessingSettings.globalInitMutex) {
     ReleaseGlobalLock(semLock);
   }
+  kernelProfileInit();
 
   mDeviceMemoryPermanent = mDeviceMemoryBase;
   mHostMemoryPermanent = mHostMemoryBase;
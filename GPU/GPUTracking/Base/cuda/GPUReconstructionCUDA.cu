@@ -273,11 +273,20 @@ int GPUReconstructionCUDA::InitDevice_Runtime()
 #endif
     mDeviceName = deviceProp.name;
     mDeviceName += " (CUDA GPU)";
+#ifndef __HIPCC__ // CUDA
+    mDeviceArchitecture = "sm_" + std::to_string(deviceProp.major * 10 + deviceProp.minor);
+#else // HIP
+    mDeviceArchitecture = deviceProp.gcnArchName;
+    mDeviceArchitecture = mDeviceArchitecture.substr(0, mDeviceArchitecture.find(':'));
+#endif
 
     if (deviceProp.major < 3) {
       GPUError("Unsupported CUDA Device");
       return (1);
     }
+    if (mProcessingSettings.kernelParameterFile != "" && ReadKernelParameters(mProcessingSettings.kernelParameterFile.c_str())) {
+      return (1);
+    }
 
 #ifdef GPUCA_USE_TEXTURES
     if (GPUCA_SLICE_DATA_MEMORY * NSLICES > (size_t)deviceProp.maxTexture1DLinear) {
@@ -336,7 +345,14 @@ int GPUReconstructionCUDA::InitDevice_Runtime()
       GPUFailedMsgI(cudaDeviceReset());
       return (1);
     }
-    if (GPUFailedMsgI(cudaMallocHost(&mHostMemoryBase, mHostMemorySize))) {
+    if (mDeviceBackendSettings.externalHostMemoryPool) {
+      mHostMemoryBase = mDeviceBackendSettings.externalHostMemoryPool;
+      if (registerMemoryForGPU_internal(mHostMemoryBase, mHostMemorySize)) {
+        GPUError("Error registering external host memory pool (%lld bytes at %p)", (long long int)mHostMemorySize, mHostMemoryBase);
+        GPUFailedMsgI(cudaDeviceReset());
+        return (1);
+      }
+    } else if (GPUFailedMsgI(cudaMallocHost(&mHostMemoryBase, mHostMemorySize))) {
       GPUError("Error allocating Page Locked Host Memory (trying %lld bytes)", (long long int)mHostMemorySize);
       GPUFailedMsgI(cudaDeviceReset());
       return (1);
@@ -407,6 +423,8 @@ int GPUReconstructionCUDA::InitDevice_Runtime()
     mWarpSize = master->mWarpSize;
     mMaxThreads = master->mMaxThreads;
     mDeviceName = master->mDeviceName;
+    mDeviceArchitecture = master->mDeviceArchitecture;
+    mKernelParameters = master->mKernelParameters;
     mDeviceConstantMem = master->mDeviceConstantMem;
     mDeviceConstantMemList.resize(master->mDeviceConstantMemList.size());
     std::copy(master->mDeviceConstantMemList.begin(), master->mDeviceConstantMemList.end(), mDeviceConstantMemList.begin());
@@ -462,6 +480,13 @@ int GPUReconstructionCUDA::ExitDevice_Runtime()
   SynchronizeGPU();
   unregisterRemainingRegisteredMemory();
 
+  for (unsigned int i = 0; i < mInternals->kernelGraphs.size(); i++) {
+    if (mInternals->kernelGraphs[i].exec) {
+      GPUFailedMsgI(cudaGraphExecDestroy(mInternals->kernelGraphs[i].exec));
+    }
+  }
+  mInternals->kernelGraphs.clear();
+
   for (unsigned int i = 0; i < mEvents.size(); i++) {
     cudaEvent_t* events = (cudaEvent_t*)mEvents[i].data();
     for (unsigned int j = 0; j < mEvents[i].size(); j++) {
@@ -479,7 +504,11 @@ int GPUReconstructionCUDA::ExitDevice_Runtime()
       GPUFailedMsgI(cudaStreamDestroy(mInternals->Streams[i]));
     }
 
-    GPUFailedMsgI(cudaFreeHost(mHostMemoryBase));
+    if (mDeviceBackendSettings.externalHostMemoryPool) {
+      GPUFailedMsgI(cudaHostUnregister(mHostMemoryBase));
+    } else {
+      GPUFailedMsgI(cudaFreeHost(mHostMemoryBase));
+    }
     for (unsigned int i = 0; i < mInternals->kernelModules.size(); i++) {
       GPUFailedMsg(cuModuleUnload(*mInternals->kernelModules[i]));
     }
@@ -552,6 +581,52 @@ size_t GPUReconstructionCUDA::WriteToConstantMemory(size_t offset, const void* s
 void GPUReconstructionCUDA::ReleaseEvent(deviceEvent ev) {}
 void GPUReconstructionCUDA::RecordMarker(deviceEvent ev, int stream) { GPUFailedMsg(cudaEventRecord(ev.get<cudaEvent_t>(), mInternals->Streams[stream])); }
 
+double GPUReconstructionCUDA::GetEventElapsedTime(deviceEvent start, deviceEvent end)
+{
+  float v;
+  GPUFailedMsg(cudaEventElapsedTime(&v, start.get<cudaEvent_t>(), end.get<cudaEvent_t>()));
+  return v * 1.e-3;
+}
+
+bool GPUReconstructionCUDA::RunKernelGraph(int graph, int stream, unsigned long long key)
+{
+  // Debug modes and the kernel profiler synchronize or time individual kernels, which is not possible inside a graph
+  if (!mProcessingSettings.kernelGraphs || mProcessingSettings.debugLevel > 0 || mProcessingSettings.checkKernelFailures || mProcessingSettings.keepAllMemory || mProcessingSettings.kernelProfiling) {
+    return false;
+  }
+  if (mInternals->kernelGraphs.size() <= (unsigned int)graph) {
+    mInternals->kernelGraphs.resize(graph + 1);
+  }
+  auto& g = mInternals->kernelGraphs[graph];
+  if (g.exec && g.key == key) {
+    GPUFailedMsg(cudaGraphLaunch(g.exec, mInternals->Streams[stream]));
+    return true;
+  }
+  // First call or the launch parameters (e.g. buffer addresses after a size change) differ: record the sequence again
+  if (g.exec) {
+    GPUFailedMsg(cudaGraphExecDestroy(g.exec));
+    g.exec = nullptr;
+  }
+  GPUFailedMsg(cudaStreamBeginCapture(mInternals->Streams[stream], cudaStreamCaptureModeThreadLocal));
+  g.key = key;
+  g.capturing = true;
+  return false;
+}
+
+void GPUReconstructionCUDA::FinishKernelGraph(int graph, int stream)
+{
+  if (mInternals->kernelGraphs.size() <= (unsigned int)graph || !mInternals->kernelGraphs[graph].capturing) {
+    return;
+  }
+  auto& g = mInternals->kernelGraphs[graph];
+  g.capturing = false;
+  cudaGraph_t cudaGraph;
+  GPUFailedMsg(cudaStreamEndCapture(mInternals->Streams[stream], &cudaGraph));
+  GPUFailedMsg(cudaGraphInstantiateWithFlags(&g.exec, cudaGraph, 0));
+  GPUFailedMsg(cudaGraphDestroy(cudaGraph));
+  GPUFailedMsg(cudaGraphLaunch(g.exec, mInternals->Streams[stream]));
+}
+
 std::unique_ptr<GPUReconstruction::GPUThreadContext> GPUReconstructionCUDA::GetThreadContext()
 {
   GPUFailedMsg(cudaSetDevice(mDeviceId));
@@ -611,7 +686,8 @@ int GPUReconstructionCUDA::GPUDebug(const char* state, int stream, bool force)
 
 int GPUReconstructionCUDA::registerMemoryForGPU_internal(const void* ptr, size_t size)
 {
-  return GPUFailedMsgI(cudaHostRegister((void*)ptr, size, cudaHostRegisterDefault));
+  // With several devices in one process, the registration must be valid for all of them
+  return GPUFailedMsgI(cudaHostRegister((void*)ptr, size, mProcessingSettings.nDevices > 1 ? cudaHostRegisterPortable : cudaHostRegisterDefault));
 }
 
 int GPUReconstructionCUDA::unregisterMemoryForGPU_internal(const void* ptr)
@@ -86,6 +86,9 @@ class GPUReconstructionCUDA : public GPUReconstructionKernels<GPUReconstructionC
   size_t GPUMemCpy(void* dst, const void* src, size_t size, int stream, int toGPU, deviceEvent* ev = nullptr, deviceEvent* evList = nullptr, int nEvents = 1) override;
   void ReleaseEvent(deviceEvent ev) override;
   void RecordMarker(deviceEvent ev, int stream) override;
+  double GetEventElapsedTime(deviceEvent start, deviceEvent end) override;
+  bool RunKernelGraph(int graph, int stream, unsigned long long key) override;
+  void FinishKernelGraph(int graph, int stream) override;
 
   void GetITSTraits(std::unique_ptr<o2::its::TrackerTraits>* trackerTraits, std::unique_ptr<o2::its::VertexerTraits>* vertexerTraits, std::unique_ptr<o2::its::TimeFrame>* timeFrame) override;
 
@@ -100,6 +103,7 @@ class GPUReconstructionCUDA : public GPUReconstructionKernels<GPUReconstructionC
 
  private:
   int genRTC(std::string& filename, unsigned int& nCompile);
+  void applyRTCKernelParameters(std::string& kernel);
   void genAndLoadRTC();
   void loadKernelModules(bool perKernel, bool perSingleMulti = true);
   const char *mRtcSrcExtension = ".src", *mRtcBinExtension = ".o";
@@ -26,6 +26,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <filesystem>
+#include <algorithm>
 
 using namespace GPUCA_NAMESPACE::gpu;
 
@@ -35,6 +36,35 @@ QGET_LD_BINARY_SYMBOLS(GPUReconstructionCUDArtc_src);
 QGET_LD_BINARY_SYMBOLS(GPUReconstructionCUDArtc_command);
 #endif
 
+void GPUReconstructionCUDA::applyRTCKernelParameters(std::string& kernel)
+{
+  // Replace the launch bounds of the kernel definition by the runtime kernel parameters, consistent with GPUReconstructionCPU::applyKernelParameters
+  size_t namePos = kernel.find("krnl_");
+  size_t boundsPos = kernel.find("launch_bounds");
+  if (namePos == std::string::npos || boundsPos == std::string::npos || boundsPos > namePos) {
+    return;
+  }
+  size_t nameEnd = kernel.find('(', namePos);
+  std::string name = kernel.substr(namePos + 5, nameEnd - namePos - 5);
+  if (name.size() > 6 && name.compare(name.size() - 6, 6, "_multi") == 0) {
+    name.resize(name.size() - 6);
+  }
+  auto it = mKernelParameters.find(name);
+  size_t boundsBegin = kernel.find('(', boundsPos);
+  size_t boundsEnd = kernel.find(')', boundsBegin);
+  unsigned int nThreads = 0, minBlocks = 1;
+  if (it == mKernelParameters.end() || boundsEnd == std::string::npos || sscanf(kernel.substr(boundsBegin + 1, boundsEnd - boundsBegin - 1).c_str(), "%u , %u", &nThreads, &minBlocks) < 1) {
+    return;
+  }
+  if (it->second.nThreads && !KernelHasFixedThreadCount(name)) {
+    nThreads = std::min(nThreads, it->second.nThreads);
+  }
+  if (it->second.minBlocks) {
+    minBlocks = it->second.minBlocks;
+  }
+  kernel.replace(boundsBegin + 1, boundsEnd - boundsBegin - 1, std::to_string(nThreads) + ", " + std::to_string(minBlocks));
+}
+
 int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
 {
 #ifndef GPUCA_ALIROOT_LIB
@@ -48,18 +78,35 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
 
   std::vector<std::string> kernels;
   getRTCKernelCalls(kernels);
+  if (mKernelParameters.size()) {
+    for (unsigned int i = 0; i < kernels.size(); i++) {
+      applyRTCKernelParameters(kernels[i]);
+    }
+  }
   std::string kernelsall;
   for (unsigned int i = 0; i < kernels.size(); i++) {
     kernelsall += kernels[i] + "\n";
   }
 
+  std::string baseCommand = getenv("O2_GPU_RTC_OVERRIDE_CMD") ? std::string(getenv("O2_GPU_RTC_OVERRIDE_CMD")) : std::string(_binary_GPUReconstructionCUDArtc_command_start, _binary_GPUReconstructionCUDArtc_command_len);
+
 #ifdef GPUCA_HAVE_O2HEADERS
   char shasource[21], shaparam[21], shacmd[21], shakernels[21];
+  std::string cacheFile;
   if (mProcessingSettings.rtc.cacheOutput) {
     o2::framework::internal::SHA1(shasource, _binary_GPUReconstructionCUDArtc_src_start, _binary_GPUReconstructionCUDArtc_src_len);
     o2::framework::internal::SHA1(shaparam, rtcparam.c_str(), rtcparam.size());
-    o2::framework::internal::SHA1(shacmd, _binary_GPUReconstructionCUDArtc_command_start, _binary_GPUReconstructionCUDArtc_command_len);
+    o2::framework::internal::SHA1(shacmd, baseCommand.c_str(), baseCommand.size());
     o2::framework::internal::SHA1(shakernels, kernelsall.c_str(), kernelsall.size());
+    // One cache file per configuration, so that processes with different parameters do not evict each other's entries
+    std::string shaall = std::string(shasource, 20) + std::string(shaparam, 20) + std::string(shacmd, 20) + std::string(shakernels, 20) + std::string((const char*)&mProcessingSettings.rtc, sizeof(mProcessingSettings.rtc));
+    char shakey[21];
+    o2::framework::internal::SHA1(shakey, shaall.c_str(), shaall.size());
+    char shakeyhex[41];
+    for (int i = 0; i < 20; i++) {
+      snprintf(shakeyhex + 2 * i, 3, "%02x", (unsigned char)shakey[i]);
+    }
+    cacheFile = mProcessingSettings.RTCcacheFolder + "/rtc.cuda." + shakeyhex + ".cache";
   }
 #endif
 
@@ -85,34 +132,51 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
       }
     }
 
-    FILE* fp = fopen((mProcessingSettings.RTCcacheFolder + "/rtc.cuda.cache").c_str(), "rb");
+    std::string cacheFileRead = cacheFile;
+    if (mProcessingSettings.rtc.ignoreCacheValid) { // Use the most recent cache file, whatever configuration it was created for
+      std::filesystem::file_time_type newest;
+      bool found = false;
+      for (const auto& entry : std::filesystem::directory_iterator(mProcessingSettings.RTCcacheFolder)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("rtc.cuda.", 0) == 0 && name.size() > 6 && name.compare(name.size() - 6, 6, ".cache") == 0 && (!found || entry.last_write_time() > newest)) {
+          cacheFileRead = entry.path().string();
+          newest = entry.last_write_time();
+          found = true;
+        }
+      }
+    }
+    FILE* fp = fopen(cacheFileRead.c_str(), "rb");
     char sharead[20];
     if (fp) {
       size_t len;
       while (true) {
         if (fread(sharead, 1, 20, fp) != 20) {
-          throw std::runtime_error("Cache file corrupt");
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
         }
         if (!mProcessingSettings.rtc.ignoreCacheValid && memcmp(sharead, shasource, 20)) {
           GPUInfo("Cache file content outdated (source)");
           break;
         }
         if (fread(sharead, 1, 20, fp) != 20) {
-          throw std::runtime_error("Cache file corrupt");
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
         }
         if (!mProcessingSettings.rtc.ignoreCacheValid && memcmp(sharead, shaparam, 20)) {
           GPUInfo("Cache file content outdated (param)");
           break;
         }
         if (fread(sharead, 1, 20, fp) != 20) {
-          throw std::runtime_error("Cache file corrupt");
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
         }
         if (!mProcessingSettings.rtc.ignoreCacheValid && memcmp(sharead, shacmd, 20)) {
           GPUInfo("Cache file content outdated (commandline)");
           break;
         }
         if (fread(sharead, 1, 20, fp) != 20) {
-          throw std::runtime_error("Cache file corrupt");
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
         }
         if (!mProcessingSettings.rtc.ignoreCacheValid && memcmp(sharead, shakernels, 20)) {
           GPUInfo("Cache file content outdated (kernel definitions)");
@@ -121,20 +185,24 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
         GPUSettingsProcessingRTC cachedSettings;
         static_assert(std::is_trivially_copyable_v<GPUSettingsProcessingRTC> == true, "GPUSettingsProcessingRTC must be POD");
         if (fread(&cachedSettings, sizeof(cachedSettings), 1, fp) != 1) {
-          throw std::runtime_error("Cache file corrupt");
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
         }
         if (!mProcessingSettings.rtc.ignoreCacheValid && memcmp(&cachedSettings, &mProcessingSettings.rtc, sizeof(cachedSettings))) {
           GPUInfo("Cache file content outdated (rtc parameters)");
           break;
         }
         std::vector<char> buffer;
+        bool cacheCorrupt = false;
         for (unsigned int i = 0; i < nCompile; i++) {
           if (fread(&len, sizeof(len), 1, fp) != 1) {
-            throw std::runtime_error("Cache file corrupt");
+            cacheCorrupt = true;
+            break;
           }
           buffer.resize(len);
           if (fread(buffer.data(), 1, len, fp) != len) {
-            throw std::runtime_error("Cache file corrupt");
+            cacheCorrupt = true;
+            break;
           }
           FILE* fp2 = fopen((filename + "_" + std::to_string(i) + mRtcBinExtension).c_str(), "w+b");
           if (fp2 == nullptr) {
@@ -145,6 +213,10 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
           }
           fclose(fp2);
         }
+        if (cacheCorrupt) {
+          GPUWarning("RTC cache file corrupt, recompiling");
+          break;
+        }
         GPUInfo("Using RTC cache file");
         cacheLoaded = true;
         break;
@@ -159,7 +231,6 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
     }
     HighResTimer rtcTimer;
     rtcTimer.ResetStart();
-    std::string baseCommand = getenv("O2_GPU_RTC_OVERRIDE_CMD") ? std::string(getenv("O2_GPU_RTC_OVERRIDE_CMD")) : std::string(_binary_GPUReconstructionCUDArtc_command_start, _binary_GPUReconstructionCUDArtc_command_len);
 #ifdef WITH_OPENMP
 #pragma omp parallel for schedule(dynamic, 1)
 #endif
@@ -204,7 +275,9 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
     }
 #ifdef GPUCA_HAVE_O2HEADERS
     if (mProcessingSettings.rtc.cacheOutput) {
-      FILE* fp = fopen((mProcessingSettings.RTCcacheFolder + "/rtc.cuda.cache").c_str(), "w+b");
+      // Write to a temporary file and rename it, so that concurrent readers and crashes never leave a partial cache file behind
+      std::string cacheFileTmp = cacheFile + ".tmp." + std::to_string(getpid());
+      FILE* fp = fopen(cacheFileTmp.c_str(), "w+b");
       if (fp == nullptr) {
         throw std::runtime_error("Cannot open cache file for writing");
       }
@@ -239,6 +312,7 @@ int GPUReconstructionCUDA::genRTC(std::string& filename, unsigned int& nCompile)
         }
       }
       fclose(fp);
+      std::filesystem::rename(cacheFileTmp, cacheFile);
     }
 #endif
   }
@@ -36,6 +36,13 @@ struct GPUReconstructionCUDAInternals {
   std::vector<std::string> kernelNames;                     // names of kernels
   cudaStream_t Streams[GPUCA_MAX_STREAMS];                  // Pointer to array of CUDA Streams
 
+  struct kernelGraph {
+    cudaGraphExec_t exec = nullptr; // Instantiated graph of the recorded kernel sequence
+    unsigned long long key = 0;     // Launch parameters the graph was recorded with
+    bool capturing = false;
+  };
+  std::vector<kernelGraph> kernelGraphs;
+
   static void getArgPtrs(const void** pArgs) {}
   template <typename T, typename... Args>
   static void getArgPtrs(const void** pArgs, const T& arg, const Args&... args)
@@ -14,6 +14,11 @@
 
 #include "GPUMemorySizeScalers.h"
 #include "GPULogging.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
 
 using namespace GPUCA_NAMESPACE::gpu;
 
@@ -36,3 +41,92 @@ void GPUMemorySizeScalers::rescaleMaxMem(size_t newAvailableMemory)
   tpcMaxMergedTrackHits = (double)tmp.tpcMaxMergedTrackHits * scaleFactor;
   availableMemory = newAvailableMemory;
 }
+
+double& GPUMemorySizeScalers::getCalibratedFactor(calibratedFactor f)
+{
+  switch (f) {
+    case kTPCPeaksPerDigit:
+      return tpcPeaksPerDigit;
+    case kTPCClustersPerPeak:
+      return tpcClustersPerPeak;
+    case kTPCStartHitsPerHit:
+      return tpcStartHitsPerHit;
+    case kTPCTrackletsPerStartHit:
+      return tpcTrackletsPerStartHit;
+    case kTPCTrackletHitsPerHit:
+      return tpcTrackletHitsPerHit;
+    case kTPCSectorTracksPerHit:
+      return tpcSectorTracksPerHit;
+    case kTPCSectorTrackHitsPerHit:
+      return tpcSectorTrackHitsPerHit;
+    case kTPCSectorTrackHitsPerHitWithRejection:
+      return tpcSectorTrackHitsPerHitWithRejection;
+    case kTPCMergedTrackPerSliceTrack:
+      return tpcMergedTrackPerSliceTrack;
+    case kTPCMergedTrackHitPerSliceHit:
+      return tpcMergedTrackHitPerSliceHit;
+    default:
+      throw std::runtime_error("Invalid memory scaling factor");
+  }
+}
+
+const char* GPUMemorySizeScalers::getCalibratedFactorName(calibratedFactor f)
+{
+  static constexpr const char* names[N_CALIBRATED_FACTORS] = {"tpcPeaksPerDigit", "tpcClustersPerPeak", "tpcStartHitsPerHit", "tpcTrackletsPerStartHit", "tpcTrackletHitsPerHit", "tpcSectorTracksPerHit", "tpcSectorTrackHitsPerHit", "tpcSectorTrackHitsPerHitWithRejection", "tpcMergedTrackPerSliceTrack", "tpcMergedTrackHitPerSliceHit"};
+  return names[f];
+}
+
+void GPUMemorySizeScalers::addCalibrationSample(calibratedFactor f, size_t input, size_t used)
+{
+  if (input < 1000) { // Small inputs are covered by the offsets, and would dominate the ratio
+    return;
+  }
+  calibrationMaxRatio[f] = std::max(calibrationMaxRatio[f], (double)used / input);
+  calibrationCount[f]++;
+}
+
+int GPUMemorySizeScalers::readCalibratedFactors(const char* filename)
+{
+  // Format: one factor per line: <name> <value>, # starts a comment
+  std::ifstream in(filename);
+  if (!in) {
+    GPUError("Cannot open memory scaling factor file %s", filename);
+    return 1;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream str(line.substr(0, line.find('#')));
+    std::string name;
+    double value;
+    if (!(str >> name)) {
+      continue;
+    }
+    int i = 0;
+    while (i < N_CALIBRATED_FACTORS && name != getCalibratedFactorName((calibratedFactor)i)) {
+      i++;
+    }
+    if (i == N_CALIBRATED_FACTORS || !(str >> value) || value <= 0.) {
+      GPUError("Invalid memory scaling factor entry '%s' in %s", line.c_str(), filename);
+      return 1;
+    }
+    getCalibratedFactor((calibratedFactor)i) = value;
+  }
+  return 0;
+}
+
+int GPUMemorySizeScalers::writeCalibratedFactors(const char* filename, double margin) const
+{
+  std::ofstream out(filename);
+  if (!out) {
+    GPUError("Cannot write memory scaling factor file %s", filename);
+    return 1;
+  }
+  out << "# Memory scaling factors: maximum observed ratio times " << margin << ", <name> <value> # <default> <samples>\n";
+  GPUMemorySizeScalers defaults;
+  for (int i = 0; i < N_CALIBRATED_FACTORS; i++) {
+    if (calibrationCount[i]) {
+      out << getCalibratedFactorName((calibratedFactor)i) << " " << calibrationMaxRatio[i] * margin << " # " << defaults.getCalibratedFactor((calibratedFactor)i) << " " << calibrationCount[i] << "\n";
+    }
+  }
+  return out.good() ? 0 : 1;
+}
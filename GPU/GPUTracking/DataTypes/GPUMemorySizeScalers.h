@@ -65,7 +65,27 @@ struct GPUMemorySizeScalers {
   size_t availableMemory = 20500000000;
   bool returnMaxVal = false;
 
+  // Calibration of the scaling factors from the buffer usage observed in processed time frames
+  enum calibratedFactor { kTPCPeaksPerDigit,
+                          kTPCClustersPerPeak,
+                          kTPCStartHitsPerHit,
+                          kTPCTrackletsPerStartHit,
+                          kTPCTrackletHitsPerHit,
+                          kTPCSectorTracksPerHit,
+                          kTPCSectorTrackHitsPerHit,
+                          kTPCSectorTrackHitsPerHitWithRejection,
+                          kTPCMergedTrackPerSliceTrack,
+                          kTPCMergedTrackHitPerSliceHit,
+                          N_CALIBRATED_FACTORS };
+  double calibrationMaxRatio[N_CALIBRATED_FACTORS] = {}; // Maximum observed ratio of used buffer entries to the input, per factor
+  unsigned int calibrationCount[N_CALIBRATED_FACTORS] = {};
+
   void rescaleMaxMem(size_t newAvailableMemory);
+  double& getCalibratedFactor(calibratedFactor f);
+  static const char* getCalibratedFactorName(calibratedFactor f);
+  void addCalibrationSample(calibratedFactor f, size_t input, size_t used);
+  int readCalibratedFactors(const char* filename);
+  int writeCalibratedFactors(const char* filename, double margin) const;
   inline size_t getValue(size_t maxVal, size_t val)
   {
     return returnMaxVal ? maxVal : (std::min<size_t>(maxVal, offset + val) * factor * temporaryFactor);
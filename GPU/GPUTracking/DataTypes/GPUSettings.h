@@ -79,6 +79,8 @@ struct GPUSettingsDeviceBackend {
   unsigned int deviceType = GPUDataTypes::DeviceType::CPU; // Device type, shall use GPUDataTypes::DEVICE_TYPE constants, e.g. CPU / CUDA
   char forceDeviceType = true;                             // Fail if device initialization fails, otherwise falls back to CPU
   GPUReconstruction* master = nullptr;                     // GPUReconstruction master object
+  void* externalHostMemoryPool = nullptr;                  // Host memory provided by the caller, e.g. from a shm region, to be registered and used as page locked host memory pool instead of allocating one
+  size_t externalHostMemoryPoolSize = 0;                   // Size of the external host memory pool
 };
 #endif
 
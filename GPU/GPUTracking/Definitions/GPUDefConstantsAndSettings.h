@@ -47,6 +47,7 @@
 #define GPUCA_TPC_COMP_CHUNK_SIZE 1024                // Chunk size of sorted unattached TPC cluster in compression
 
 #define TPC_MAX_TIME_BIN_TRIGGERED 600
+#define GPUCA_TPC_TIMEBINS_PER_HBF (3564.f / 8.f)     // TPC time bins per heart beat frame, LHC bunches per orbit / bunches per time bin
 
 #if defined(GPUCA_NSLICES) || defined(GPUCA_ROW_COUNT)
   #error GPUCA_NSLICES or GPUCA_ROW_COUNT already defined, do not include GPUTPCGeometry.h before!
@@ -106,6 +106,8 @@ AddOptionRTC(maxConsecTimeBinAboveThreshold, unsigned short, 200, "", 0, "Except
 AddOptionRTC(noisyPadSaturationThreshold, unsigned short, 700, "", 0, "Threshold where a timebin is considered saturated, disabling the noisy pad check for that pad")
 AddOptionRTC(occupancyMapTimeBins, unsigned short, 16, "", 0, "Number of timebins per histogram bin of occupancy map (0 = disable occupancy map)")
 AddOptionRTC(occupancyMapTimeBinsAverage, unsigned short, 0, "", 0, "Number of timebins +/- to use for the averaging")
+AddOptionRTC(occupancyAdaptiveReference, float, 0.f, "", 0, "Occupancy (clusters per HBF) at which the nominal search windows and rejection thresholds apply, they are scaled with the ratio to the occupancy of the TF or of the time bin (0 = disable)")
+AddOptionRTC(occupancyAdaptiveMaxScale, float, 2.f, "", 0, "Maximum factor by which the occupancy adaptive search windows and rejection thresholds are tightened or loosened")
 AddOptionRTC(trackFitCovLimit, unsigned short, 1000, "", 0, "Abort fit when y/z cov exceed the limit")
 AddOptionRTC(addErrorsCECrossing, unsigned char, 0, "", 0, "Add additional custom track errors when crossing CE, 0 = no custom errors but att 0.5 to sigma_z^2, 1 = only to cov diagonal, 2 = preserve correlations")
 AddOptionRTC(trackMergerMinPartHits, unsigned char, 10, "", 0, "Minimum hits of track part during track merging")
@@ -216,6 +218,7 @@ EndConfig()
 BeginSubConfig(GPUSettingsProcessing, proc, configStandalone, "PROC", 0, "Processing settings", proc)
 AddOption(platformNum, int, -1, "", 0, "Platform to use, in case the backend provides multiple platforms (-1 = auto-select)")
 AddOption(deviceNum, int, -1, "gpuDevice", 0, "Set GPU device to use (-1: automatic, -2: for round-robin usage in timeslice-pipeline)")
+AddOption(nDevices, int, 1, "gpuDevices", 0, "Number of GPU devices driven by one instance, starting at deviceNum, time frames are distributed between them round-robin")
 AddOption(gpuDeviceOnly, bool, false, "", 0, "Use only GPU as device (i.e. no CPU for OpenCL)")
 AddOption(globalInitMutex, bool, false, "", 0, "Use global mutex to synchronize initialization of multiple GPU instances")
 AddOption(stuckProtection, int, 0, "", 0, "Timeout in us, When AMD GPU is stuck, just continue processing and skip tracking, do not crash or stall the chain")
@@ -230,24 +233,34 @@ AddOption(showOutputStat, bool, false, "", 0, "Print some track output statistic
 AddOption(runCompressionStatistics, bool, false, "compressionStat", 0, "Run statistics and verification for cluster compression")
 AddOption(resetTimers, char, 1, "", 0, "Reset timers every event")
 AddOption(deviceTimers, bool, true, "", 0, "Use device timers instead of host-based time measurement")
+AddOption(kernelProfiling, bool, false, "", 0, "Time all kernels per TF with device events, without synchronizing after each kernel")
+AddOption(kernelProfilingMaxLaunches, unsigned int, 16384, "", 0, "Maximum number of kernel launches timed per TF by the kernel profiler")
+AddOption(kernelProfilingTraceFile, std::string, "", "", 0, "Append the kernel profiler timeline of each TF to this file in Chrome trace format")
+AddOption(kernelGraphs, bool, false, "", 0, "Record kernel sequences without host synchronization as CUDA / HIP graphs, and replay them while their launch parameters do not change")
 AddOption(keepAllMemory, bool, false, "", 0, "Allocate all memory on both device and host, and do not reuse")
 AddOption(keepDisplayMemory, bool, false, "", 0, "Like keepAllMemory, but only for memory required for event display")
 AddOption(disableMemoryReuse, bool, false, "", 0, "Disable memory reusage (for debugging only)")
 AddOption(memoryAllocationStrategy, char, 0, "", 0, "Memory Allocation Stragegy (0 = auto, 1 = individual allocations, 2 = single global allocation)")
 AddOption(forceMemoryPoolSize, unsigned long, 1, "memSize", 0, "Force size of allocated GPU / page locked host memory", min(0ul))
 AddOption(forceHostMemoryPoolSize, unsigned long, 0, "hostMemSize", 0, "Force size of allocated host page locked host memory (overriding memSize)", min(0ul))
+AddOption(unmanagedMemoryReserve, unsigned long, 0, "", 0, "Reserve this amount of GPU memory for unmanaged allocations (ITS tracking), served independently of the TPC memory stack so that both can run concurrently", min(0ul))
 AddOption(memoryScalingFactor, float, 1.f, "", 0, "Factor to apply to all memory scalers")
 AddOption(conservativeMemoryEstimate, bool, false, "", 0, "Use some more conservative defaults for larger buffers during TPC processing")
 AddOption(tpcInputWithClusterRejection, unsigned char, 0, "", 0, "Indicate whether the TPC input is CTF data with cluster rejection, to tune buffer estimations")
 AddOption(forceMaxMemScalers, unsigned long, 0, "", 0, "Force using the maximum values for all buffers, Set a value n > 1 to rescale all maximums to a memory size of n")
+AddOption(memoryScalerFile, std::string, "", "", 0, "Read the memory scaling factors (buffer entries per input) from this file, e.g. as written by memoryScalerCalibrationFile")
+AddOption(memoryScalerCalibrationFile, std::string, "", "", 0, "Record the buffer usage of all processed time frames, and write the fitted memory scaling factors to this file at finalization")
+AddOption(memoryScalerCalibrationMargin, float, 1.1f, "", 0, "Safety margin applied to the maximum observed buffer usage ratio during the calibration")
 AddOption(registerStandaloneInputMemory, bool, false, "registerInputMemory", 0, "Automatically register input memory buffers for the GPU")
 AddOption(ompThreads, int, -1, "omp", 't', "Number of OMP threads to run (-1: all)", min(-1), message("Using %s OMP threads"))
-AddOption(ompKernels, unsigned char, 2, "", 0, "Parallelize with OMP inside kernels instead of over slices, 2 for nested parallelization over TPC sectors and inside kernels")
+AddOption(ompKernels, unsigned char, 2, "", 0, "Parallelize with OMP inside kernels instead of over slices, 2 for nested parallelization over TPC sectors and inside kernels, 3 for the same with the TPC sector tracking and the blocks of its kernels running as OMP tasks shared by all threads")
 AddOption(ompAutoNThreads, bool, true, "", 0, "Auto-adjust number of OMP threads, decreasing the number for small input data")
 AddOption(nDeviceHelperThreads, int, 1, "", 0, "Number of CPU helper threads for CPU processing")
 AddOption(nStreams, char, 8, "", 0, "Number of GPU streams / command queues")
 AddOption(nTPCClustererLanes, char, -1, "", 0, "Number of TPC clusterers that can run in parallel (-1 = autoset)")
 AddOption(overrideClusterizerFragmentLen, int, -1, "", 0, "Force the cluster max fragment len to a certain value (-1 = autodetect)")
+AddOption(tpcClusterizerStreaming, bool, false, "", 0, "Double-buffer the TPC ZS pages on the GPU, so that the transfer of the next fragment overlaps with the decoding of the current one")
+AddOption(tpcClusterizerStreamingPages, int, 0, "", 0, "Target number of TPC ZS pages per sector and fragment in streaming mode, shortening the fragments for high occupancy (0 = always use the maximum fragment length)")
 AddOption(trackletSelectorSlices, char, -1, "", 0, "Number of slices to processes in parallel at max")
 AddOption(trackletConstructorInPipeline, char, -1, "", 0, "Run tracklet constructor in the pipeline")
 AddOption(trackletSelectorInPipeline, char, -1, "", 0, "Run tracklet selector in the pipeline")
@@ -268,6 +281,7 @@ AddOption(outputSharedClusterMap, bool, false, "", 0, "Ship optional shared clus
 AddOption(disableTPCNoisyPadFilter, bool, false, "", 0, "Disables all TPC noisy pad filters (Not the normal noise filter!)")
 AddOption(createO2Output, char, 2, "", 0, "Create Track output in O2 format (2 = skip non-O2 output in GPU track format (reverts to =1 if QA is requested))")
 AddOption(clearO2OutputFromGPU, bool, false, "", 0, "Free the GPU memory used for O2 output after copying to host, prevents further O2 processing on the GPU")
+AddOption(o2OutputCacheClusterSelection, bool, false, "", 0, "Store the per-cluster selection of the O2 output prepare kernel and reuse it in the output kernel instead of re-reading the cluster attachment")
 AddOption(ignoreNonFatalGPUErrors, bool, false, "", 0, "Continue running after having received non fatal GPU errors, e.g. abort due to overflow")
 AddOption(tpcIncreasedMinClustersPerRow, unsigned int, 0, "", 0, "Impose a minimum buffer size for the clustersPerRow during TPC clusterization")
 AddOption(noGPUMemoryRegistration, bool, false, "", 0, "Do not register input / output memory for GPU dma transfer")
@@ -282,6 +296,7 @@ AddOption(tpcDownscaledEdx, unsigned char, 0, "", 0, "If != 0, downscale dEdx pr
 AddOption(tpcMaxAttachedClustersPerSectorRow, unsigned int, 51000, "", 0, "Maximum number of TPC attached clusters which can be decoded per SectorRow")
 AddOption(tpcUseOldCPUDecoding, bool, false, "", 0, "Enable old CPU-based TPC decoding")
 AddOption(RTCcacheFolder, std::string, "./rtccache/", "", 0, "Folder in which the cache file is stored")
+AddOption(kernelParameterFile, std::string, "", "", 0, "File with kernel launch parameters per device architecture (e.g. from the standalone autotuning), overriding the compiled defaults, also applied to the launch bounds of RTC code")
 AddVariable(eventDisplay, GPUCA_NAMESPACE::gpu::GPUDisplayFrontendInterface*, nullptr)
 AddSubConfig(GPUSettingsProcessingRTC, rtc)
 AddSubConfig(GPUSettingsProcessingParam, param)
@@ -490,6 +505,7 @@ AddOption(testSync, bool, false, "sync", 0, "Test settings for synchronous phase
 AddOption(timeFrameTime, bool, false, "tfTime", 0, "Print some debug information about time frame processing time")
 AddOption(controlProfiler, bool, false, "", 0, "Issues GPU profiler stop and start commands to profile only the relevant processing part")
 AddOption(preloadEvents, bool, false, "", 0, "Preload events into host memory before start processing")
+AddOption(batchTF, int, 0, "", 0, "Process n consecutive TFs (native cluster dumps of continuous data) as one batch, placed one after another in time", min(0))
 AddOption(recoSteps, int, -1, "", 0, "Bitmask for RecoSteps")
 AddOption(recoStepsGPU, int, -1, "", 0, "Bitmask for RecoSteps")
 AddOption(runMerger, int, 1, "", 0, "Run track merging / refit", min(0), max(1))
@@ -498,6 +514,8 @@ AddOption(rundEdx, int, -1, "", 0, "Enable dEdx processing")
 AddOption(runCompression, int, 1, "", 0, "Enable TPC Compression")
 AddOption(runTransformation, int, 1, "", 0, "Enable TPC Transformation")
 AddOption(runRefit, bool, false, "", 0, "Enable final track refit")
+AddOption(autoTuneKernels, bool, false, "", 0, "Sweep kernel launch parameters, running all events once per candidate set, and write the fastest set per kernel to autoTuneOutput")
+AddOption(autoTuneOutput, std::string, "kernelParameters.txt", "", 0, "Kernel parameter file to which the autotuning result is written, entries of other architectures are kept")
 AddHelp("help", 'h')
 AddHelpAll("helpall", 'H')
 AddSubConfig(GPUSettingsRec, rec)
@@ -538,11 +556,17 @@ AddOption(gainCalibDisableCCDB, bool, false, "", 0, "Disabling loading the TPC p
 AddOption(thresholdCalibFile, std::string, "", "", 0, "File name of TPC zero supression threshold map")
 AddOption(allocateOutputOnTheFly, bool, true, "", 0, "Allocate shm output buffers on the fly, instead of using preallocated buffer with upper bound size")
 AddOption(outputBufferSize, unsigned long, 200000000ul, "", 0, "Size of the output buffers to be allocated")
+AddOption(runITSConcurrently, bool, false, "", 0, "Run the ITS reconstruction in a separate thread concurrently to the TPC reconstruction of the same TF (requires allocateOutputOnTheFly = false, and unmanagedMemoryReserve for GPU ITS tracking)")
 AddOption(mutexMemReg, bool, false, "", 0, "Global mutex to serialize GPU memory registration")
 AddOption(printSettings, int, 0, "", 0, "Print all settings", def(1))
 AddOption(gpuDisplayfilterMacro, std::string, "", "", 0, "File name of ROOT macro for GPU display filter")
 AddOption(benchmarkMemoryRegistration, bool, false, "", 0, "Time-benchmark for memory registration")
 AddOption(registerSelectedSegmentIds, int, -1, "", 0, "Register only a specific managed shm segment id (-1 = all)")
+AddOption(hostMemoryRegionId, int, -1, "", 0, "Take the page locked host memory pool of the GPU (of size hostMemSize) from the unmanaged shm region with this id, e.g. created and locked once per node by the shm manager (-1 = disabled)")
+AddOption(hostMemoryRegionOffset, unsigned long, 0ul, "", 0, "Offset of the host memory pool in the shm region, the pipeline id times the pool size is added to place the processes of the node one after the other")
+AddOption(hostMemoryRegionHugePagePath, std::string, "", "", 0, "Back the host memory shm region by huge pages, creating it as a file in this hugetlbfs mount (e.g. /dev/hugepages), empty = normal shm")
+AddOption(hostMemoryRegionPrefault, bool, false, "", 0, "Pre-fault the host memory pool of this process at init (and zero the shm region if this process creates it), to avoid page faults during the first TFs")
+AddOption(memoryMetrics, bool, false, "", 0, "Send the page faults and, where the perf events are accessible, the data TLB misses of the process per TF as metrics")
 AddOption(disableCalibUpdates, bool, false, "", 0, "Disable all calibration updates")
 AddOption(partialOutputForNonFatalErrors, bool, false, "", 0, "In case of a non-fatal error that is ignored (ignoreNonFatalGPUErrors=true), forward the partial output that was created instead of shipping an empty TF")
 AddOption(checkFirstTfOrbit, bool, false, "", 0, "Check consistency of firstTfOrbit")
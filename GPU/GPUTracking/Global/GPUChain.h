@@ -103,6 +103,8 @@ class GPUChain
   }
   inline bool IsEventDone(deviceEvent* evList, int nEvents = 1) { return mRec->IsEventDone(evList, nEvents); }
   inline void RecordMarker(deviceEvent ev, int stream) { mRec->RecordMarker(ev, stream); }
+  inline bool RunKernelGraph(int graph, int stream, unsigned long long key) { return mRec->RunKernelGraph(graph, stream, key); }
+  inline void FinishKernelGraph(int graph, int stream) { mRec->FinishKernelGraph(graph, stream); }
   virtual inline std::unique_ptr<GPUReconstruction::GPUThreadContext> GetThreadContext() { return mRec->GetThreadContext(); }
   inline void SynchronizeGPU() { mRec->SynchronizeGPU(); }
   inline void ReleaseEvent(deviceEvent ev, bool doGPU = true)
@@ -268,6 +270,9 @@ inline void GPUChain::timeCpy(RecoStep step, int toGPU, S T::*func, Args... args
     }
   }
   size_t n = (mRec->*func)(args...);
+  if (mRec->mProcessingSettings.kernelProfiling && toGPU >= 0) {
+    (toGPU ? mRec->mKernelProfile.bytesToGPU : mRec->mKernelProfile.bytesToHost) += n;
+  }
   if (timer) {
     SynchronizeGPU();
     timer->Stop();
@@ -507,6 +507,12 @@ int GPUChainTracking::Finalize()
   if (mCompressionStatistics) {
     mCompressionStatistics->Finish();
   }
+  if (GetProcessingSettings().memoryScalerCalibrationFile != "") {
+    if (mRec->MemoryScalers()->writeCalibratedFactors(GetProcessingSettings().memoryScalerCalibrationFile.c_str(), GetProcessingSettings().memoryScalerCalibrationMargin)) {
+      return 1;
+    }
+    GPUInfo("Wrote calibrated memory scaling factors to %s", GetProcessingSettings().memoryScalerCalibrationFile.c_str());
+  }
   return 0;
 }
 
@@ -568,6 +574,7 @@ void GPUChainTracking::ClearIOPointers()
   std::memset((void*)&mIOPtrs, 0, sizeof(mIOPtrs));
   mIOMem.~InOutMemory();
   new (&mIOMem) InOutMemory;
+  mTFBatchSize = mTFBatchTimeBins = 0;
 }
 
 void GPUChainTracking::AllocateIOMemory()
@@ -834,6 +841,9 @@ int GPUChainTracking::RunChainFinalize()
   PrintDebugOutput();
 
   //PrintMemoryRelations();
+  if (GetProcessingSettings().memoryScalerCalibrationFile != "") {
+    RecordMemoryUsage();
+  }
 
   if (GetProcessingSettings().eventDisplay) {
     if (!mDisplayRunning) {
@@ -147,6 +147,9 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   void ConvertRun2RawToNative();
   void ConvertZSEncoder(int version);
   void ConvertZSFilter(bool zs12bit);
+  int MergeTFBatch(const GPUTrackingInOutPointers* tfs, unsigned int nTFs, unsigned int tfTimeBins); // Process several small TFs in one run, placed one after another in time
+  unsigned int GetTFBatchSize() const { return mTFBatchSize; }
+  unsigned int GetTFBatchIndex(float time) const; // TF of the batch to which an output at the given time bin belongs
 
   // Getters for external usage of tracker classes
   GPUTRDTrackerGPU* GetTRDTrackerGPU() { return &processors()->trdTrackerGPU; }
@@ -238,6 +241,7 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   int PrepareProfile();
   int DoProfile();
   void PrintMemoryRelations();
+  void RecordMemoryUsage();
   void PrintMemoryStatistics() override;
   void PrepareDebugOutput();
   void PrintDebugOutput();
@@ -286,6 +290,10 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
   unsigned int mMaxTPCHits = 0;
   unsigned int mMaxTRDTracklets = 0;
 
+  // TF batching
+  unsigned int mTFBatchSize = 0;     // Number of TFs merged by MergeTFBatch, 0 if no batch
+  unsigned int mTFBatchTimeBins = 0; // Time bins reserved for every TF of the batch
+
   // Debug
   std::unique_ptr<std::ofstream> mDebugFile;
 
@@ -310,6 +318,8 @@ class GPUChainTracking : public GPUChain, GPUReconstructionHelpers::helperDelega
 #endif
   void RunTPCTrackingMerger_MergeBorderTracks(char withinSlice, char mergeMode, GPUReconstruction::krnlDeviceType deviceType);
   void RunTPCTrackingMerger_Resolve(char useOrigTrackParam, char mergeAll, GPUReconstruction::krnlDeviceType deviceType);
+  void RunTPCTrackingMerger_Merge(unsigned int numBlocks, GPUReconstruction::krnlDeviceType deviceType);
+  static constexpr int kernelGraphTPCMerger = 0; // Ids of kernel sequences recorded as graphs
 
   std::atomic_flag mLockAtomicOutputBuffer = ATOMIC_FLAG_INIT;
   std::mutex mMutexUpdateCalib;
@@ -429,11 +429,20 @@ std::pair<unsigned int, unsigned int> GPUChainTracking::RunTPCClusterizer_transf
   if (doGPU) {
     GPUTPCClusterFinder& clusterer = processors()->tpcClusterer[iSlice];
     GPUTPCClusterFinder& clustererShadow = doGPU ? processorsShadow()->tpcClusterer[iSlice] : clusterer;
+    unsigned int zsBuffer = 0;
+    if (GetProcessingSettings().tpcClusterizerStreaming) { // Alternate between the two halves of the ZS buffers of the lane, the other half may still be in use by the decoding
+      const unsigned int zsLane = iSlice % GetProcessingSettings().nTPCClustererLanes;
+      zsBuffer = mCFContext->zsBuffer[iSlice] = mCFContext->zsBufferNext[zsLane];
+      mCFContext->zsBufferNext[zsLane] ^= 1;
+    }
+    GPUTrackingInOutZS::GPUTrackingInOutZSSlice& zsMeta = mInputsHost->mPzsMeta[zsBuffer].slice[iSlice];
+    const unsigned int zsPtrOffset = (zsBuffer * NSLICES + iSlice) * GPUTrackingInOutZS::NENDPOINTS;
+    unsigned char* const zsPages = clustererShadow.mPzs + zsBuffer * clusterer.mNMaxPages * TPCZSHDR::TPC_ZS_PAGE_SIZE;
     unsigned int nPagesSector = 0;
     for (unsigned int j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
       unsigned int nPages = 0;
-      mInputsHost->mPzsMeta->slice[iSlice].zsPtr[j] = &mInputsShadow->mPzsPtrs[iSlice * GPUTrackingInOutZS::NENDPOINTS + j];
-      mInputsHost->mPzsPtrs[iSlice * GPUTrackingInOutZS::NENDPOINTS + j] = clustererShadow.mPzs + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE;
+      zsMeta.zsPtr[j] = &mInputsShadow->mPzsPtrs[zsPtrOffset + j];
+      mInputsHost->mPzsPtrs[zsPtrOffset + j] = zsPages + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE;
       for (unsigned int k = clusterer.mMinMaxCN[j].zsPtrFirst; k < clusterer.mMinMaxCN[j].zsPtrLast; k++) {
         const unsigned int min = (k == clusterer.mMinMaxCN[j].zsPtrFirst) ? clusterer.mMinMaxCN[j].zsPageFirst : 0;
         const unsigned int max = (k + 1 == clusterer.mMinMaxCN[j].zsPtrLast) ? clusterer.mMinMaxCN[j].zsPageLast : mIOPtrs.tpcZS->slice[iSlice].nZSPtr[j][k];
@@ -441,16 +450,21 @@ std::pair<unsigned int, unsigned int> GPUChainTracking::RunTPCClusterizer_transf
           char* src = (char*)mIOPtrs.tpcZS->slice[iSlice].zsPtr[j][k] + min * TPCZSHDR::TPC_ZS_PAGE_SIZE;
           char* ptrLast = (char*)mIOPtrs.tpcZS->slice[iSlice].zsPtr[j][k] + (max - 1) * TPCZSHDR::TPC_ZS_PAGE_SIZE;
           size_t size = (ptrLast - src) + o2::raw::RDHUtils::getMemorySize(*(const o2::header::RAWDataHeader*)ptrLast);
-          GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzs + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE, src, size, lane, true);
+          GPUMemCpy(RecoStep::TPCClusterFinding, zsPages + (nPagesSector + nPages) * TPCZSHDR::TPC_ZS_PAGE_SIZE, src, size, lane, true);
         }
         nPages += max - min;
       }
-      mInputsHost->mPzsMeta->slice[iSlice].nZSPtr[j] = &mInputsShadow->mPzsSizes[iSlice * GPUTrackingInOutZS::NENDPOINTS + j];
-      mInputsHost->mPzsSizes[iSlice * GPUTrackingInOutZS::NENDPOINTS + j] = nPages;
-      mInputsHost->mPzsMeta->slice[iSlice].count[j] = 1;
+      zsMeta.nZSPtr[j] = &mInputsShadow->mPzsSizes[zsPtrOffset + j];
+      mInputsHost->mPzsSizes[zsPtrOffset + j] = nPages;
+      zsMeta.count[j] = 1;
       nPagesSector += nPages;
     }
-    GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzsOffsets, clusterer.mPzsOffsets, clusterer.mNMaxPages * sizeof(*clusterer.mPzsOffsets), lane, true);
+    GPUMemCpy(RecoStep::TPCClusterFinding, clustererShadow.mPzsOffsets + zsBuffer * clusterer.mNMaxPages, clusterer.mPzsOffsets, clusterer.mNMaxPages * sizeof(*clusterer.mPzsOffsets), lane, true);
+    if (GetProcessingSettings().tpcClusterizerStreaming) { // Transfer only the ZS pointers of this sector, the ones of the other sectors may be in use
+      GPUMemCpy(RecoStep::TPCClusterFinding, &mInputsShadow->mPzsMeta[zsBuffer].slice[iSlice], &zsMeta, sizeof(zsMeta), lane, true);
+      GPUMemCpy(RecoStep::TPCClusterFinding, mInputsShadow->mPzsPtrs + zsPtrOffset, mInputsHost->mPzsPtrs + zsPtrOffset, GPUTrackingInOutZS::NENDPOINTS * sizeof(*mInputsHost->mPzsPtrs), lane, true);
+      GPUMemCpy(RecoStep::TPCClusterFinding, mInputsShadow->mPzsSizes + zsPtrOffset, mInputsHost->mPzsSizes + zsPtrOffset, GPUTrackingInOutZS::NENDPOINTS * sizeof(*mInputsHost->mPzsSizes), lane, true);
+    }
   }
   return retVal;
 }
@@ -471,7 +485,27 @@ int GPUChainTracking::RunTPCClusterizer_prepare(bool restorePointers)
   if (mCFContext == nullptr) {
     mCFContext.reset(new GPUTPCCFChainContext);
   }
-  const short maxFragmentLen = GetProcessingSettings().overrideClusterizerFragmentLen;
+  short maxFragmentLen = GetProcessingSettings().overrideClusterizerFragmentLen;
+  if (mIOPtrs.tpcZS && (GetRecoStepsGPU() & RecoStep::TPCClusterFinding) && GetProcessingSettings().tpcClusterizerStreaming && GetProcessingSettings().tpcClusterizerStreamingPages > 0) {
+    // Shorten the fragments for high occupancy, such that the pages of a sector per fragment stay around the target, for better overlap of transfer and processing
+    size_t nPages = 0;
+    for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+      for (unsigned int j = 0; j < GPUTrackingInOutZS::NENDPOINTS; j++) {
+        for (unsigned int k = 0; k < mIOPtrs.tpcZS->slice[iSlice].count[j]; k++) {
+          nPages += mIOPtrs.tpcZS->slice[iSlice].nZSPtr[j][k];
+        }
+      }
+    }
+    const int nTimeBins = param().par.continuousTracking ? param().par.continuousMaxTimeBin : TPC_MAX_TIME_BIN_TRIGGERED;
+    const float pagesPerTimeBin = (float)nPages / NSLICES / std::max(1, nTimeBins);
+    if (pagesPerTimeBin > 0.f) {
+      const int minFragmentLen = std::min<int>(TPC_MAX_FRAGMENT_LEN_HOST, maxFragmentLen);
+      maxFragmentLen = std::max<int>(minFragmentLen, std::min<float>(GetProcessingSettings().tpcClusterizerStreamingPages / pagesPerTimeBin, maxFragmentLen));
+    }
+    if (GetProcessingSettings().debugLevel >= 2) {
+      GPUInfo("TPC clusterizer streaming: %lld ZS pages, using fragment length %d", (long long int)nPages, (int)maxFragmentLen);
+    }
+  }
   const unsigned int maxAllowedTimebin = param().par.continuousTracking ? std::max<int>(param().par.continuousMaxTimeBin, maxFragmentLen) : TPC_MAX_TIME_BIN_TRIGGERED;
   mCFContext->tpcMaxTimeBin = maxAllowedTimebin;
   const CfFragment fragmentMax{(tpccf::TPCTime)mCFContext->tpcMaxTimeBin + 1, maxFragmentLen};
@@ -648,6 +682,20 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
   char transferRunning[NSLICES] = {0};
   unsigned int outputQueueStart = mOutputQueue.size();
 
+  // In streaming mode the ZS pages are double-buffered, and the next fragment is transferred while the current one is decoded
+  const bool streamingZS = doGPU && mIOPtrs.tpcZS && GetProcessingSettings().tpcClusterizerStreaming;
+  auto transferNextZS = [this](unsigned int iSlice, const CfFragment& fragment, int lane) {
+    CfFragment f = fragment.next();
+    int nextSlice = iSlice;
+    if (f.isEnd()) {
+      nextSlice += GetProcessingSettings().nTPCClustererLanes;
+      f = mCFContext->fragmentFirst;
+    }
+    if (nextSlice < NSLICES && mIOPtrs.tpcZS && mCFContext->nPagesSector[nextSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
+      mCFContext->nextPos[nextSlice] = RunTPCClusterizer_transferZS(nextSlice, f, GetProcessingSettings().nTPCClustererLanes + lane);
+    }
+  };
+
   auto notifyForeignChainFinished = [this]() {
     if (mPipelineNotifyCtx) {
       SynchronizeStream(OutputStream()); // Must finish before updating ioPtrs in (global) constant memory
@@ -698,6 +746,7 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
           if (mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1) {
             clusterer.mPmemory->counters.nPositions = mCFContext->nextPos[iSlice].first;
             clusterer.mPmemory->counters.nPagesSubslice = mCFContext->nextPos[iSlice].second;
+            clusterer.mPmemory->zsBuffer = mCFContext->zsBuffer[iSlice];
           } else {
             clusterer.mPmemory->counters.nPositions = clusterer.mPmemory->counters.nPagesSubslice = 0;
           }
@@ -715,11 +764,16 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
 
         if (doGPU) {
           if (mIOPtrs.tpcZS && mCFContext->nPagesSector[iSlice] && mCFContext->zsVersion != -1) {
-            TransferMemoryResourceLinkToGPU(RecoStep::TPCClusterFinding, mInputsHost->mResourceZS, lane);
+            if (!streamingZS) {
+              TransferMemoryResourceLinkToGPU(RecoStep::TPCClusterFinding, mInputsHost->mResourceZS, lane);
+            }
             SynchronizeStream(GetProcessingSettings().nTPCClustererLanes + lane);
           }
           SynchronizeStream(mRec->NStreams() - 1); // Wait for copying to constant memory
         }
+        if (streamingZS) {
+          transferNextZS(iSlice, fragment, lane);
+        }
 
         if (mIOPtrs.tpcZS && (mCFContext->abandonTimeframe || !mCFContext->nPagesSector[iSlice] || mCFContext->zsVersion == -1)) {
           clusterer.mPmemory->counters.nPositions = 0;
@@ -780,16 +834,8 @@ int GPUChainTracking::RunTPCClusterizer(bool synchronizeOutput)
         if (doGPU) {
           SynchronizeStream(lane);
         }
-        if (mIOPtrs.tpcZS) {
-          CfFragment f = fragment.next();
-          int nextSlice = iSlice;
-          if (f.isEnd()) {
-            nextSlice += GetProcessingSettings().nTPCClustererLanes;
-            f = mCFContext->fragmentFirst;
-          }
-          if (nextSlice < NSLICES && mIOPtrs.tpcZS && mCFContext->nPagesSector[nextSlice] && mCFContext->zsVersion != -1 && !mCFContext->abandonTimeframe) {
-            mCFContext->nextPos[nextSlice] = RunTPCClusterizer_transferZS(nextSlice, f, GetProcessingSettings().nTPCClustererLanes + lane);
-          }
+        if (mIOPtrs.tpcZS && !streamingZS) {
+          transferNextZS(iSlice, fragment, lane);
         }
         GPUTPCClusterFinder& clusterer = processors()->tpcClusterer[iSlice];
         GPUTPCClusterFinder& clustererShadow = doGPU ? processorsShadow()->tpcClusterer[iSlice] : clusterer;
@@ -237,6 +237,10 @@ int GPUChainTracking::RunTPCDecompression()
     mRec->PushNonPersistentMemory(qStr2Tag("TPCDCMPR"));
     RecoStep myStep = RecoStep::TPCDecompression;
     bool doGPU = GetRecoStepsGPU() & RecoStep::TPCDecompression;
+    // When decompressing on the GPU, the tracking reads the native clusters from the GPU buffer, they are copied back only if needed on the host
+    bool buildNativeHost = !doGPU || (GetRecoStepsOutputs() & GPUDataTypes::InOutType::TPCClusters) || GetProcessingSettings().deterministicGPUReconstruction || GetProcessingSettings().debugLevel >= 4 ||
+                           GetProcessingSettings().runQA || GetProcessingSettings().eventDisplay || GetProcessingSettings().outputSanityCheck || GetProcessingSettings().runCompressionStatistics ||
+                           (GetRecoSteps() & ~GetRecoStepsGPU()).isSetAny(RecoStep::TPCConversion, RecoStep::TPCSliceTracking, RecoStep::TPCMerging, RecoStep::TPCCompression, RecoStep::TPCdEdx, RecoStep::Refit);
     GPUTPCDecompression& Decompressor = processors()->tpcDecompressor;
     GPUTPCDecompression& DecompressorShadow = doGPU ? processorsShadow()->tpcDecompressor : Decompressor;
     const auto& threadContext = GetThreadContext();
@@ -320,10 +324,12 @@ int GPUChainTracking::RunTPCDecompression()
     GPUMemCpy(myStep, inputGPUShadow.sigmaTimeU, cmprClsHost.sigmaTimeU, cmprClsHost.nUnattachedClusters * sizeof(cmprClsHost.sigmaTimeU[0]), unattachedStream, toGPU);
 
     mInputsHost->mNClusterNative = mInputsShadow->mNClusterNative = cmprClsHost.nAttachedClusters + cmprClsHost.nUnattachedClusters;
-    AllocateRegisteredMemory(mInputsHost->mResourceClusterNativeOutput, mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::clustersNative)]);
+    if (buildNativeHost) {
+      AllocateRegisteredMemory(mInputsHost->mResourceClusterNativeOutput, mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::clustersNative)]);
+    }
     AllocateRegisteredMemory(mInputsHost->mResourceClusterNativeBuffer);
     DecompressorShadow.mNativeClustersBuffer = mInputsShadow->mPclusterNativeBuffer;
-    Decompressor.mNativeClustersBuffer = mInputsHost->mPclusterNativeOutput;
+    Decompressor.mNativeClustersBuffer = buildNativeHost ? mInputsHost->mPclusterNativeOutput : nullptr;
     WriteToConstantMemory(myStep, (char*)&processors()->tpcDecompressor - (char*)processors(), &DecompressorShadow, sizeof(DecompressorShadow), inputStream);
     TransferMemoryResourceLinkToHost(RecoStep::TPCDecompression, Decompressor.mResourceTmpIndexes, inputStream, nullptr, mEvents->stream, nStreams);
     SynchronizeStream(inputStream);
@@ -352,15 +358,19 @@ int GPUChainTracking::RunTPCDecompression()
       TransferMemoryResourceLinkToGPU(RecoStep::TPCDecompression, mInputsHost->mResourceClusterNativeAccess, inputStream, &mEvents->single);
     }
     mIOPtrs.clustersNative = mClusterNativeAccess.get();
-    mClusterNativeAccess->clustersLinear = mInputsHost->mPclusterNativeOutput;
-    mClusterNativeAccess->setOffsetPtrs();
+    if (buildNativeHost) {
+      mClusterNativeAccess->clustersLinear = mInputsHost->mPclusterNativeOutput;
+      mClusterNativeAccess->setOffsetPtrs();
+    }
 
     unsigned int batchSize = doGPU ? 6 : NSLICES;
     for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice = iSlice + batchSize) {
       int iStream = (iSlice / batchSize) % mRec->NStreams();
       runKernel<GPUTPCDecompressionKernels, GPUTPCDecompressionKernels::step1unattached>({GetGridAuto(iStream), krnlRunRangeNone, {nullptr, &mEvents->single}}, iSlice, batchSize);
-      unsigned int copySize = std::accumulate(mClusterNativeAccess->nClustersSector + iSlice, mClusterNativeAccess->nClustersSector + iSlice + batchSize, 0u);
-      GPUMemCpy(RecoStep::TPCDecompression, mInputsHost->mPclusterNativeOutput + mClusterNativeAccess->clusterOffset[iSlice][0], DecompressorShadow.mNativeClustersBuffer + mClusterNativeAccess->clusterOffset[iSlice][0], sizeof(Decompressor.mNativeClustersBuffer[0]) * copySize, iStream, false);
+      if (buildNativeHost) {
+        unsigned int copySize = std::accumulate(mClusterNativeAccess->nClustersSector + iSlice, mClusterNativeAccess->nClustersSector + iSlice + batchSize, 0u);
+        GPUMemCpy(RecoStep::TPCDecompression, mInputsHost->mPclusterNativeOutput + mClusterNativeAccess->clusterOffset[iSlice][0], DecompressorShadow.mNativeClustersBuffer + mClusterNativeAccess->clusterOffset[iSlice][0], sizeof(Decompressor.mNativeClustersBuffer[0]) * copySize, iStream, false);
+      }
     }
     SynchronizeGPU();
 
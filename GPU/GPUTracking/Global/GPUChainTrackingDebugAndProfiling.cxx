@@ -180,6 +180,34 @@ void GPUChainTracking::PrintMemoryRelations()
   GPUInfo("MEMREL TrackHitss NCl %d NTrkH %d", processors()->tpcMerger.NMaxClusters(), processors()->tpcMerger.NOutputTrackClusters());
 }
 
+void GPUChainTracking::RecordMemoryUsage()
+{
+  GPUMemorySizeScalers* s = mRec->MemoryScalers();
+  unsigned int nSectorTracks = 0;
+  for (int i = 0; i < NSLICES; i++) {
+#ifdef GPUCA_TPC_GEOMETRY_O2
+    if (GetRecoSteps() & RecoStep::TPCClusterFinding) {
+      const auto& counters = processors()->tpcClusterer[i].mPmemory->counters;
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCPeaksPerDigit, counters.nDigitsInFragment, counters.nPeaks);
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCClustersPerPeak, counters.nPeaks, counters.nClusters);
+    }
+#endif
+    if (GetRecoSteps() & RecoStep::TPCSliceTracking) {
+      const GPUTPCTracker& trk = processors()->tpcTrackers[i];
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCStartHitsPerHit, trk.NHitsTotal(), *trk.NStartHits());
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCTrackletsPerStartHit, *trk.NStartHits(), *trk.NTracklets());
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCTrackletHitsPerHit, trk.NHitsTotal(), *trk.NRowHits());
+      s->addCalibrationSample(GPUMemorySizeScalers::kTPCSectorTracksPerHit, trk.NHitsTotal(), *trk.NTracks());
+      s->addCalibrationSample(GetProcessingSettings().tpcInputWithClusterRejection ? GPUMemorySizeScalers::kTPCSectorTrackHitsPerHitWithRejection : GPUMemorySizeScalers::kTPCSectorTrackHitsPerHit, trk.NHitsTotal(), *trk.NTrackHits());
+      nSectorTracks += *trk.NTracks();
+    }
+  }
+  if (GetRecoSteps() & RecoStep::TPCMerging) {
+    s->addCalibrationSample(GPUMemorySizeScalers::kTPCMergedTrackPerSliceTrack, nSectorTracks, processors()->tpcMerger.NOutputTracks());
+    s->addCalibrationSample(GPUMemorySizeScalers::kTPCMergedTrackHitPerSliceHit, processors()->tpcMerger.NMaxClusters(), processors()->tpcMerger.NOutputTrackClusters());
+  }
+}
+
 void GPUChainTracking::PrepareDebugOutput()
 {
 #ifdef GPUCA_KERNEL_DEBUGGER_OUTPUT
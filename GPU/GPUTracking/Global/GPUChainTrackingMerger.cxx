@@ -85,37 +85,11 @@ void GPUChainTracking::RunTPCTrackingMerger_Resolve(char useOrigTrackParam, char
   runKernel<GPUTPCGMMergerResolve, 4>(GetGridAuto(0, deviceType), useOrigTrackParam, mergeAll);
 }
 
-int GPUChainTracking::RunTPCTrackingMerger(bool synchronizeOutput)
+void GPUChainTracking::RunTPCTrackingMerger_Merge(unsigned int numBlocks, GPUReconstruction::krnlDeviceType deviceType)
 {
-  mRec->PushNonPersistentMemory(qStr2Tag("TPCMERGE"));
-  bool doGPU = GetRecoStepsGPU() & RecoStep::TPCMerging;
-  bool doGPUall = doGPU && GetProcessingSettings().fullMergerOnGPU;
-  GPUReconstruction::krnlDeviceType deviceType = doGPUall ? GPUReconstruction::krnlDeviceType::Auto : GPUReconstruction::krnlDeviceType::CPU;
-  unsigned int numBlocks = (!mRec->IsGPU() || doGPUall) ? BlockCount() : 1;
+  bool doGPUall = GetRecoStepsGPU() & RecoStep::TPCMerging && GetProcessingSettings().fullMergerOnGPU;
   GPUTPCGMMerger& Merger = processors()->tpcMerger;
-  GPUTPCGMMerger& MergerShadow = doGPU ? processorsShadow()->tpcMerger : Merger;
   GPUTPCGMMerger& MergerShadowAll = doGPUall ? processorsShadow()->tpcMerger : Merger;
-  const int outputStream = OutputStream();
-  if (GetProcessingSettings().debugLevel >= 2) {
-    GPUInfo("Running TPC Merger");
-  }
-  const auto& threadContext = GetThreadContext();
-
-  SynchronizeGPU(); // Need to know the full number of slice tracks
-  SetupGPUProcessor(&Merger, true);
-  AllocateRegisteredMemory(Merger.MemoryResOutput(), mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::tpcTracks)]);
-  AllocateRegisteredMemory(Merger.MemoryResOutputState(), mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::sharedClusterMap)]);
-
-  if (Merger.CheckSlices()) {
-    return 1;
-  }
-
-  memset(Merger.Memory(), 0, sizeof(*Merger.Memory()));
-  WriteToConstantMemory(RecoStep::TPCMerging, (char*)&processors()->tpcMerger - (char*)processors(), &MergerShadow, sizeof(MergerShadow), 0);
-  if (doGPUall) {
-    TransferMemoryResourcesToGPU(RecoStep::TPCMerging, &Merger, 0);
-  }
-
   if (GetProcessingSettings().deterministicGPUReconstruction) {
     runKernel<GPUTPCGlobalDebugSortKernels, GPUTPCGlobalDebugSortKernels::clearIds>(GetGridAuto(0, deviceType), 1);
   }
@@ -177,6 +151,48 @@ int GPUChainTracking::RunTPCTrackingMerger(bool synchronizeOutput)
     runKernel<GPUTPCGMMergerMergeCE>(GetGridAuto(0, deviceType));
     DoDebugAndDump(RecoStep::TPCMerging, 2048, doGPUall, Merger, &GPUTPCGMMerger::DumpMergeCE, *mDebugFile);
   }
+}
+
+int GPUChainTracking::RunTPCTrackingMerger(bool synchronizeOutput)
+{
+  mRec->PushNonPersistentMemory(qStr2Tag("TPCMERGE"));
+  bool doGPU = GetRecoStepsGPU() & RecoStep::TPCMerging;
+  bool doGPUall = doGPU && GetProcessingSettings().fullMergerOnGPU;
+  GPUReconstruction::krnlDeviceType deviceType = doGPUall ? GPUReconstruction::krnlDeviceType::Auto : GPUReconstruction::krnlDeviceType::CPU;
+  unsigned int numBlocks = (!mRec->IsGPU() || doGPUall) ? BlockCount() : 1;
+  GPUTPCGMMerger& Merger = processors()->tpcMerger;
+  GPUTPCGMMerger& MergerShadow = doGPU ? processorsShadow()->tpcMerger : Merger;
+  GPUTPCGMMerger& MergerShadowAll = doGPUall ? processorsShadow()->tpcMerger : Merger;
+  const int outputStream = OutputStream();
+  if (GetProcessingSettings().debugLevel >= 2) {
+    GPUInfo("Running TPC Merger");
+  }
+  const auto& threadContext = GetThreadContext();
+
+  SynchronizeGPU(); // Need to know the full number of slice tracks
+  SetupGPUProcessor(&Merger, true);
+  AllocateRegisteredMemory(Merger.MemoryResOutput(), mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::tpcTracks)]);
+  AllocateRegisteredMemory(Merger.MemoryResOutputState(), mSubOutputControls[GPUTrackingOutputs::getIndex(&GPUTrackingOutputs::sharedClusterMap)]);
+
+  if (Merger.CheckSlices()) {
+    return 1;
+  }
+
+  memset(Merger.Memory(), 0, sizeof(*Merger.Memory()));
+  WriteToConstantMemory(RecoStep::TPCMerging, (char*)&processors()->tpcMerger - (char*)processors(), &MergerShadow, sizeof(MergerShadow), 0);
+  if (doGPUall) {
+    TransferMemoryResourcesToGPU(RecoStep::TPCMerging, &Merger, 0);
+  }
+
+  // The unpacking and merging kernels run on stream 0 without host synchronization, and apart from the temporary counters only depend on the configuration
+  const unsigned long long kernelGraphKey = (unsigned long long)(size_t)MergerShadowAll.TmpCounter() ^ ((unsigned long long)param().rec.tpc.mergeCE << 1) ^ (unsigned long long)(bool)GetProcessingSettings().deterministicGPUReconstruction;
+  const bool kernelGraph = doGPUall && !GetProcessingSettings().alternateBorderSort;
+  if (!kernelGraph || !RunKernelGraph(kernelGraphTPCMerger, 0, kernelGraphKey)) {
+    RunTPCTrackingMerger_Merge(numBlocks, deviceType);
+  }
+  if (kernelGraph) {
+    FinishKernelGraph(kernelGraphTPCMerger, 0);
+  }
   int waitForTransfer = 0;
   if (doGPUall) {
     TransferMemoryResourceLinkToHost(RecoStep::TPCMerging, Merger.MemoryResMemory(), 0, &mEvents->single);
@@ -171,8 +171,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
   int streamMap[NSLICES];
 
   bool error = false;
-  GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
-  for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+  auto processSlice = [&](unsigned int iSlice) {
     GPUTPCTracker& trk = processors()->tpcTrackers[iSlice];
     GPUTPCTracker& trkShadow = doGPU ? processorsShadow()->tpcTrackers[iSlice] : trk;
     int useStream = (iSlice % mRec->NStreams());
@@ -188,7 +187,7 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       if (ReadEvent(iSlice, 0)) {
         GPUError("Error reading event");
         error = 1;
-        continue;
+        return;
       }
     } else {
       if (GetProcessingSettings().debugLevel >= 3) {
@@ -198,14 +197,14 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
       if (HelperError(iSlice % (GetProcessingSettings().nDeviceHelperThreads + 1) - 1)) {
         error = 1;
-        continue;
+        return;
       }
     }
     if (GetProcessingSettings().deterministicGPUReconstruction) {
       runKernel<GPUTPCSectorDebugSortKernels, GPUTPCSectorDebugSortKernels::hitData>({GetGridBlk(GPUCA_ROW_COUNT, useStream), {iSlice}});
     }
     if (!doGPU && trk.CheckEmptySlice() && GetProcessingSettings().debugLevel == 0) {
-      continue;
+      return;
     }
 
     if (GetProcessingSettings().debugLevel >= 6) {
@@ -288,6 +287,23 @@ int GPUChainTracking::RunTPCTrackingSlices_internal()
       }
       DoDebugAndDump(RecoStep::TPCSliceTracking, 512, trk, &GPUTPCTracker::DumpTrackHits, *mDebugFile);
     }
+  };
+  if (!doGPU && GetProcessingSettings().ompKernels == 3) {
+    // One task per sector, the blocks of its kernels are tasks as well, such that the threads which finished their sector help with the others
+    mRec->SetAndGetNestedLoopOmpFactor(true, NSLICES);
+    mRec->SetNestedLoopOmpTasks(true);
+    GPUCA_OPENMP(parallel num_threads(GetProcessingSettings().ompThreads))
+    GPUCA_OPENMP(single)
+    GPUCA_OPENMP(taskloop grainsize(1))
+    for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+      processSlice(iSlice);
+    }
+    mRec->SetNestedLoopOmpTasks(false);
+  } else {
+    GPUCA_OPENMP(parallel for if(!doGPU && GetProcessingSettings().ompKernels != 1) num_threads(mRec->SetAndGetNestedLoopOmpFactor(!doGPU, NSLICES)))
+    for (unsigned int iSlice = 0; iSlice < NSLICES; iSlice++) {
+      processSlice(iSlice);
+    }
   }
   mRec->SetNestedLoopOmpFactor(1);
   if (error) {
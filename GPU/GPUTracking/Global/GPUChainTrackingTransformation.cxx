@@ -43,7 +43,10 @@ int GPUChainTracking::ConvertNativeToClusterData()
 
   bool transferClusters = false;
   if (doGPU) {
-    if (!(mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding)) {
+    // The clusterizer and the decompression leave the native clusters in the GPU buffer, no need to transfer them again
+    bool clustersOnGPU = (mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding) ||
+                         (mIOPtrs.tpcCompressedClusters && (GetRecoSteps() & RecoStep::TPCDecompression) && (GetProcessingSettings().tpcUseOldCPUDecoding ? mRec->IsGPU() : (bool)(GetRecoStepsGPU() & RecoStep::TPCDecompression)));
+    if (!clustersOnGPU) {
       mInputsHost->mNClusterNative = mInputsShadow->mNClusterNative = mIOPtrs.clustersNative->nClustersTotal;
       AllocateRegisteredMemory(mInputsHost->mResourceClusterNativeBuffer);
       processorsShadow()->ioPtrs.clustersNative = mInputsShadow->mPclusterNativeAccess;
@@ -151,6 +154,83 @@ void GPUChainTracking::ConvertZSFilter(bool zs12bit)
   GPUReconstructionConvert::RunZSFilter(mIOMem.tpcDigits, mIOPtrs.tpcPackedDigits->tpcDigits, mIOMem.digitMap->nTPCDigits, mIOPtrs.tpcPackedDigits->nTPCDigits, param(), zs12bit, param().rec.tpc.zsThreshold);
 }
 
+int GPUChainTracking::MergeTFBatch(const GPUTrackingInOutPointers* tfs, unsigned int nTFs, unsigned int tfTimeBins)
+{
+#ifdef GPUCA_HAVE_O2HEADERS
+  // The TF i of the batch is shifted by i * tfTimeBins, the range of the packed cluster time limits the batch size
+  if (nTFs == 0 || tfTimeBins == 0 || (unsigned long)nTFs * tfTimeBins > (1u << 24) / ClusterNative::scaleTimePacked) {
+    GPUError("Cannot batch %u TFs of %u time bins", nTFs, tfTimeBins);
+    return 1;
+  }
+  unsigned int nTotal = 0;
+  for (unsigned int k = 0; k < nTFs; k++) {
+    if (tfs[k].clustersNative == nullptr) {
+      GPUError("TF %u of the batch has no native clusters, batching supports only native cluster input", k);
+      return 1;
+    }
+    nTotal += tfs[k].clustersNative->nClustersTotal;
+  }
+  GPUSettingsTF settingsTF;
+  const bool hasSettingsTF = tfs[0].settingsTF != nullptr;
+  if (hasSettingsTF) {
+    settingsTF = *tfs[0].settingsTF;
+  }
+
+  ClearIOPointers();
+  mIOMem.clusterNativeAccess.reset(new ClusterNativeAccess);
+  std::memset(mIOMem.clusterNativeAccess.get(), 0, sizeof(ClusterNativeAccess));
+  mIOMem.clustersNative.reset(new ClusterNative[nTotal]);
+  nTotal = 0;
+  for (unsigned int i = 0; i < NSLICES; i++) {
+    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
+      const unsigned int rowStart = nTotal;
+      for (unsigned int k = 0; k < nTFs; k++) {
+        const unsigned int timeShift = k * tfTimeBins * ClusterNative::scaleTimePacked;
+        for (unsigned int l = 0; l < tfs[k].clustersNative->nClusters[i][j]; l++) {
+          ClusterNative c = tfs[k].clustersNative->clusters[i][j][l];
+          c.setTimePacked(c.getTimePacked() + timeShift);
+          mIOMem.clustersNative[nTotal++] = c;
+        }
+      }
+      mIOMem.clusterNativeAccess->nClusters[i][j] = nTotal - rowStart;
+    }
+  }
+  mIOMem.clusterNativeAccess->clustersLinear = mIOMem.clustersNative.get();
+  mIOMem.clusterNativeAccess->setOffsetPtrs();
+  mIOPtrs.clustersNative = mIOMem.clusterNativeAccess.get();
+  if (hasSettingsTF) {
+    if (settingsTF.hasNHBFPerTF) {
+      settingsTF.nHBFPerTF *= nTFs;
+    }
+    mIOMem.settingsTF.reset(new GPUSettingsTF[1]);
+    mIOMem.settingsTF[0] = settingsTF;
+    mIOPtrs.settingsTF = mIOMem.settingsTF.get();
+  }
+  if (GetProcessingSettings().registerStandaloneInputMemory) {
+    if (mRec->registerMemoryForGPU(mIOMem.clustersNative.get(), nTotal * sizeof(*mIOMem.clusterNativeAccess->clustersLinear))) {
+      throw std::runtime_error("Error registering memory for GPU");
+    }
+  }
+  mTFBatchSize = nTFs;
+  mTFBatchTimeBins = tfTimeBins;
+  if (GetProcessingSettings().debugLevel >= 2) {
+    GPUInfo("Batched %u TFs of %u time bins, %u TPC clusters", nTFs, tfTimeBins, nTotal);
+  }
+  return 0;
+#else
+  return 1;
+#endif
+}
+
+unsigned int GPUChainTracking::GetTFBatchIndex(float time) const
+{
+  if (mTFBatchSize <= 1 || time < 0.f) {
+    return 0;
+  }
+  const unsigned int iTF = time / mTFBatchTimeBins;
+  return iTF < mTFBatchSize ? iTF : (mTFBatchSize - 1);
+}
+
 int GPUChainTracking::ForwardTPCDigits()
 {
 #ifdef GPUCA_HAVE_O2HEADERS
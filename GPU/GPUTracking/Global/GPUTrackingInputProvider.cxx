@@ -26,9 +26,10 @@ void GPUTrackingInputProvider::InitializeProcessor() {}
 void* GPUTrackingInputProvider::SetPointersInputZS(void* mem)
 {
   if (mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding) {
-    computePointerWithAlignment(mem, mPzsMeta);
-    computePointerWithAlignment(mem, mPzsSizes, GPUTrackingInOutZS::NSLICES * GPUTrackingInOutZS::NENDPOINTS);
-    computePointerWithAlignment(mem, mPzsPtrs, GPUTrackingInOutZS::NSLICES * GPUTrackingInOutZS::NENDPOINTS);
+    const unsigned int nBuffers = 1 + mRec->GetProcessingSettings().tpcClusterizerStreaming; // Double-buffered in streaming mode, see GPUChainTracking::RunTPCClusterizer_transferZS
+    computePointerWithAlignment(mem, mPzsMeta, nBuffers);
+    computePointerWithAlignment(mem, mPzsSizes, nBuffers * GPUTrackingInOutZS::NSLICES * GPUTrackingInOutZS::NENDPOINTS);
+    computePointerWithAlignment(mem, mPzsPtrs, nBuffers * GPUTrackingInOutZS::NSLICES * GPUTrackingInOutZS::NENDPOINTS);
   }
   return mem;
 }
@@ -23,6 +23,7 @@
 #include "GPUParam.inc"
 #include "GPUQA.h"
 #include "GPUOutputControl.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <thread>
@@ -56,7 +57,10 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     return (1);
   }
   mConfig.reset(new GPUO2InterfaceConfiguration(config));
-  mNContexts = mConfig->configProcessing.doublePipeline ? 2 : 1;
+  // With several devices, each context is an independent instance on its own device, sharing the host copies of the calibration objects.
+  // The double pipeline then distributes the time frames between them, instead of overlapping two time frames on one device.
+  mMultiDevice = mConfig->configProcessing.nDevices > 1;
+  mNContexts = mMultiDevice ? mConfig->configProcessing.nDevices : (mConfig->configProcessing.doublePipeline ? 2 : 1);
   mCtx.reset(new GPUO2Interface_processingContext[mNContexts]);
   if (mConfig->configWorkflow.inputs.isSet(GPUDataTypes::InOutType::TPCRaw)) {
     mConfig->configGRP.needsClusterer = 1;
@@ -65,7 +69,7 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     mConfig->configGRP.doCompClusterDecode = 1;
   }
   for (unsigned int i = 0; i < mNContexts; i++) {
-    if (i) {
+    if (i && !mMultiDevice) {
       mConfig->configDeviceBackend.master = mCtx[0].mRec.get();
     }
     mCtx[i].mRec.reset(GPUReconstruction::CreateInstance(mConfig->configDeviceBackend));
@@ -84,7 +88,14 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     }
     mCtx[i].mChain->mConfigDisplay = &mConfig->configDisplay;
     mCtx[i].mChain->mConfigQA = &mConfig->configQA;
-    mCtx[i].mRec->SetSettings(&mConfig->configGRP, &mConfig->configReconstruction, &mConfig->configProcessing, &mConfig->configWorkflow);
+    if (mMultiDevice) {
+      GPUSettingsProcessing proc = mConfig->configProcessing;
+      proc.deviceNum = std::max(proc.deviceNum, 0) + i;
+      proc.doublePipeline = false;
+      mCtx[i].mRec->SetSettings(&mConfig->configGRP, &mConfig->configReconstruction, &proc, &mConfig->configWorkflow);
+    } else {
+      mCtx[i].mRec->SetSettings(&mConfig->configGRP, &mConfig->configReconstruction, &mConfig->configProcessing, &mConfig->configWorkflow);
+    }
     mCtx[i].mChain->SetCalibObjects(mConfig->configCalib);
 
     if (i == 0 && mConfig->configWorkflow.steps.isSet(GPUDataTypes::RecoStep::ITSTracking)) {
@@ -102,7 +113,7 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
     }
   }
   for (unsigned int i = 0; i < mNContexts; i++) {
-    if (i == 0 && mCtx[i].mRec->Init()) {
+    if ((i == 0 || mMultiDevice) && mCtx[i].mRec->Init()) {
       mNContexts = 0;
       mCtx.reset(nullptr);
       return (1);
@@ -111,7 +122,7 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
       mCtx[i].mRec->MemoryScalers()->factor *= 2;
     }
   }
-  if (mConfig->configProcessing.doublePipeline) {
+  if (mConfig->configProcessing.doublePipeline && !mMultiDevice) {
     mInternals->pipelineThread.reset(new std::thread([this]() { mCtx[0].mRec->RunPipelineWorker(); }));
   }
   return (0);
@@ -120,14 +131,16 @@ int GPUO2Interface::Initialize(const GPUO2InterfaceConfiguration& config)
 void GPUO2Interface::Deinitialize()
 {
   if (mNContexts) {
-    if (mConfig->configProcessing.doublePipeline) {
+    if (mConfig->configProcessing.doublePipeline && !mMultiDevice) {
       mCtx[0].mRec->TerminatePipelineWorker();
       mInternals->pipelineThread->join();
     }
     for (unsigned int i = 0; i < mNContexts; i++) {
       mCtx[i].mRec->Finalize();
     }
-    mCtx[0].mRec->Exit();
+    for (unsigned int i = 0; i < (mMultiDevice ? mNContexts : 1); i++) {
+      mCtx[i].mRec->Exit();
+    }
     for (int i = mNContexts - 1; i >= 0; i--) {
       mCtx[i].mRec.reset();
     }
@@ -226,6 +239,7 @@ void GPUO2Interface::Clear(bool clearOutputs, unsigned int iThread) { mCtx[iThre
 
 int GPUO2Interface::registerMemoryForGPU(const void* ptr, size_t size)
 {
+  // With several devices, the memory is registered as portable, i.e. for all of them
   return mCtx[0].mRec->registerMemoryForGPU(ptr, size);
 }
 
@@ -249,6 +263,8 @@ void GPUO2Interface::setErrorCodeOutput(std::vector<std::array<unsigned int, 4>>
   }
 }
 
+const GPUKernelProfile& GPUO2Interface::getKernelProfile(unsigned int iThread) const { return mCtx[iThread].mRec->GetKernelProfile(); }
+
 void GPUO2Interface::GetITSTraits(o2::its::TrackerTraits*& trackerTraits, o2::its::VertexerTraits*& vertexerTraits, o2::its::TimeFrame*& timeFrame)
 {
   trackerTraits = mChainITS->GetITSTrackerTraits();
@@ -62,6 +62,7 @@ struct GPUInterfaceInputUpdate;
 struct GPUTrackingOutputs;
 struct GPUConstantMem;
 struct GPUNewCalibValues;
+struct GPUKernelProfile;
 
 struct GPUO2Interface_processingContext;
 struct GPUO2Interface_Internals;
@@ -90,14 +91,19 @@ class GPUO2Interface
   int registerMemoryForGPU(const void* ptr, size_t size);
   int unregisterMemoryForGPU(const void* ptr);
   void setErrorCodeOutput(std::vector<std::array<unsigned int, 4>>* v);
+  // Kernel timings of the last TF processed by the context, only filled with the kernelProfiling option
+  const GPUKernelProfile& getKernelProfile(unsigned int iThread = 0) const;
 
   const GPUO2InterfaceConfiguration& getConfig() const { return *mConfig; }
+  // Number of processing contexts, which can run time frames concurrently
+  unsigned int getNContexts() const { return mNContexts; }
 
  private:
   GPUO2Interface(const GPUO2Interface&);
   GPUO2Interface& operator=(const GPUO2Interface&);
 
   bool mContinuous = false;
+  bool mMultiDevice = false;
 
   unsigned int mNContexts = 0;
   std::unique_ptr<GPUO2Interface_processingContext[]> mCtx;
@@ -91,7 +91,7 @@ struct MergeLooperParam {
 #include "GPUMemorySizeScalers.h"
 
 GPUTPCGMMerger::GPUTPCGMMerger()
-  : mTrackLinks(nullptr), mNTotalSliceTracks(0), mNMaxTracks(0), mNMaxSingleSliceTracks(0), mNMaxOutputTrackClusters(0), mNMaxClusters(0), mMemoryResMemory(-1), mNClusters(0), mOutputTracks(nullptr), mSliceTrackInfos(nullptr), mSliceTrackInfoIndex(nullptr), mClusters(nullptr), mClustersXYZ(nullptr), mGlobalClusterIDs(nullptr), mClusterAttachment(nullptr), mOutputTracksTPCO2(nullptr), mOutputClusRefsTPCO2(nullptr), mOutputTracksTPCO2MC(nullptr), mTrackOrderAttach(nullptr), mTrackOrderProcess(nullptr), mBorderMemory(nullptr), mBorderRangeMemory(nullptr), mMemory(nullptr), mRetryRefitIds(nullptr), mLoopData(nullptr)
+  : mTrackLinks(nullptr), mNTotalSliceTracks(0), mNMaxTracks(0), mNMaxSingleSliceTracks(0), mNMaxOutputTrackClusters(0), mNMaxClusters(0), mMemoryResMemory(-1), mNClusters(0), mOutputTracks(nullptr), mSliceTrackInfos(nullptr), mSliceTrackInfoIndex(nullptr), mClusters(nullptr), mClustersXYZ(nullptr), mGlobalClusterIDs(nullptr), mClusterAttachment(nullptr), mOutputTracksTPCO2(nullptr), mOutputClusRefsTPCO2(nullptr), mOutputTracksTPCO2MC(nullptr), mTrackOrderAttach(nullptr), mTrackOrderProcess(nullptr), mClusAcceptO2(nullptr), mTmpSortMemory(nullptr), mBorderMemory(nullptr), mBorderRangeMemory(nullptr), mMemory(nullptr), mRetryRefitIds(nullptr), mLoopData(nullptr)
 {
   //* constructor
 
@@ -371,6 +371,11 @@ void* GPUTPCGMMerger::SetPointersOutputO2Scratch(void* mem)
 {
   computePointerWithAlignment(mem, mTrackSortO2, mNMaxTracks);
   computePointerWithAlignment(mem, mClusRefTmp, mNMaxTracks);
+  if (mRec->GetProcessingSettings().o2OutputCacheClusterSelection) {
+    computePointerWithAlignment(mem, mClusAcceptO2, mNMaxOutputTrackClusters);
+  } else {
+    mClusAcceptO2 = nullptr;
+  }
   return mem;
 }
 
@@ -1831,6 +1836,9 @@ GPUd() void GPUTPCGMMerger::CollectMergedTracks(int nBlocks, int nThreads, int i
       CAMath::AtomicExch(&mMemory->nOutputTracks, mNMaxTracks);
       continue;
     }
+    if (mTmpSortMemory) { // Deterministic mode, the merged tracks are ordered by their first slice track
+      mTmpSortMemory[mNMaxTracks + iOutputTrack] = itr;
+    }
 
     GPUTPCGMMergedTrack& mergedTrack = mOutputTracks[iOutputTrack];
 
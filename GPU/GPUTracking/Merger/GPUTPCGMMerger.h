@@ -132,6 +132,7 @@ class GPUTPCGMMerger : public GPUProcessor
   GPUhdi() memory* Memory() const { return mMemory; }
   GPUhdi() GPUAtomic(unsigned int) * TmpCounter() { return mMemory->tmpCounter; }
   GPUhdi() uint2* ClusRefTmp() { return mClusRefTmp; }
+  GPUhdi() unsigned char* ClusAcceptO2() { return mClusAcceptO2; }
   GPUhdi() unsigned int* TrackSort() { return mTrackSort; }
   GPUhdi() tmpSort* TrackSortO2() { return mTrackSortO2; }
   GPUhdi() MergeLooperParam* LooperCandidates() { return mLooperCandidates; }
@@ -284,6 +285,7 @@ class GPUTPCGMMerger : public GPUProcessor
   unsigned int* mTrackOrderProcess;
   unsigned char* mClusterStateExt;
   uint2* mClusRefTmp;
+  unsigned char* mClusAcceptO2; // Per-cluster selection of the O2 output prepare step, reused by the output step (only with o2OutputCacheClusterSelection)
   int* mTrackIDs;
   int* mTmpSortMemory;
   unsigned int* mTrackSort;
@@ -33,6 +33,18 @@ using namespace o2::tpc::constants;
 
 GPUdi() static constexpr unsigned char getFlagsReject() { return GPUTPCGMMergedTrackHit::flagReject | GPUTPCGMMergedTrackHit::flagNotFit; }
 GPUdi() static unsigned int getFlagsRequired(const GPUSettingsRec& rec) { return rec.tpc.dropSecondaryLegsInOutput ? gputpcgmmergertypes::attachGoodLeg : gputpcgmmergertypes::attachZero; }
+GPUdi() static bool acceptCluster(const GPUTPCGMMerger& GPUrestrict() merger, const GPUTPCGMMergedTrack& GPUrestrict() track, const GPUTPCGMMergedTrackHit* GPUrestrict() trackClusters, unsigned int j, unsigned int flagsRequired)
+{
+  constexpr unsigned char flagsReject = getFlagsReject();
+  const GPUTPCGMMergedTrackHit& cl = trackClusters[track.FirstClusterRef() + j];
+  if ((cl.state & flagsReject) || (merger.ClusterAttachment()[cl.num] & flagsRequired) != flagsRequired) {
+    return false;
+  }
+  if (merger.Param().rec.tpc.dropSecondaryLegsInOutput && cl.leg != trackClusters[track.FirstClusterRef() + track.NClusters() - 1].leg) {
+    return false;
+  }
+  return true;
+}
 
 template <>
 GPUdii() void GPUTPCGMO2Output::Thread<GPUTPCGMO2Output::prepare>(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() merger)
@@ -42,25 +54,23 @@ GPUdii() void GPUTPCGMO2Output::Thread<GPUTPCGMO2Output::prepare>(int nBlocks, i
   const GPUTPCGMMergedTrackHit* trackClusters = merger.Clusters();
   const GPUdEdxInfo* tracksdEdx = merger.OutputTracksdEdx();
 
-  constexpr unsigned char flagsReject = getFlagsReject();
   const unsigned int flagsRequired = getFlagsRequired(merger.Param().rec);
   bool cutOnTrackdEdx = merger.Param().par.dodEdx && merger.Param().rec.tpc.minTrackdEdxMax2Tot > 0.f;
 
   GPUTPCGMMerger::tmpSort* GPUrestrict() trackSort = merger.TrackSortO2();
   uint2* GPUrestrict() tmpData = merger.ClusRefTmp();
+  unsigned char* GPUrestrict() clusAccept = merger.ClusAcceptO2();
   for (unsigned int i = get_global_id(0); i < nTracks; i += get_global_size(0)) {
     if (!tracks[i].OK()) {
       continue;
     }
     unsigned int nCl = 0;
     for (unsigned int j = 0; j < tracks[i].NClusters(); j++) {
-      if ((trackClusters[tracks[i].FirstClusterRef() + j].state & flagsReject) || (merger.ClusterAttachment()[trackClusters[tracks[i].FirstClusterRef() + j].num] & flagsRequired) != flagsRequired) {
-        continue;
-      }
-      if (merger.Param().rec.tpc.dropSecondaryLegsInOutput && trackClusters[tracks[i].FirstClusterRef() + j].leg != trackClusters[tracks[i].FirstClusterRef() + tracks[i].NClusters() - 1].leg) {
-        continue;
+      const bool accept = acceptCluster(merger, tracks[i], trackClusters, j, flagsRequired);
+      if (clusAccept) {
+        clusAccept[tracks[i].FirstClusterRef() + j] = accept;
       }
-      nCl++;
+      nCl += accept;
     }
     if (nCl == 0) {
       continue;
@@ -118,8 +128,8 @@ GPUdii() void GPUTPCGMO2Output::Thread<GPUTPCGMO2Output::output>(int nBlocks, in
   GPUdEdxInfo* tracksdEdx = merger.OutputTracksdEdx();
   const int nTracks = merger.NOutputTracksTPCO2();
   const GPUTPCGMMergedTrackHit* trackClusters = merger.Clusters();
-  constexpr unsigned char flagsReject = getFlagsReject();
   const unsigned int flagsRequired = getFlagsRequired(merger.Param().rec);
+  const unsigned char* GPUrestrict() clusAccept = merger.ClusAcceptO2();
   TrackTPC* outputTracks = merger.OutputTracksTPCO2();
   unsigned int* clusRefs = merger.OutputClusRefsTPCO2();
 
@@ -186,10 +196,7 @@ GPUdii() void GPUTPCGMO2Output::Thread<GPUTPCGMO2Output::output>(int nBlocks, in
     int sector1 = 0, sector2 = 0;
     const o2::tpc::ClusterNativeAccess* GPUrestrict() clusters = merger.GetConstantMem()->ioPtrs.clustersNative;
     for (unsigned int j = 0; j < tracks[i].NClusters(); j++) {
-      if ((trackClusters[tracks[i].FirstClusterRef() + j].state & flagsReject) || (merger.ClusterAttachment()[trackClusters[tracks[i].FirstClusterRef() + j].num] & flagsRequired) != flagsRequired) {
-        continue;
-      }
-      if (merger.Param().rec.tpc.dropSecondaryLegsInOutput && trackClusters[tracks[i].FirstClusterRef() + j].leg != trackClusters[tracks[i].FirstClusterRef() + tracks[i].NClusters() - 1].leg) {
+      if (clusAccept ? !clusAccept[tracks[i].FirstClusterRef() + j] : !acceptCluster(merger, tracks[i], trackClusters, j, flagsRequired)) {
         continue;
       }
       int clusterIdGlobal = trackClusters[tracks[i].FirstClusterRef() + j].num;
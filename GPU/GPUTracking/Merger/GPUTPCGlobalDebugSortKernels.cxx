@@ -17,9 +17,6 @@
 #include "GPUCommonMath.h"
 #include "GPUCommonAlgorithm.h"
 #include "GPUTPCGlobalDebugSortKernels.h"
-#ifndef GPUCA_GPUCODE_DEVICE
-#include <stdexcept>
-#endif
 
 using namespace GPUCA_NAMESPACE::gpu;
 
@@ -31,6 +28,20 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
   }
 }
 
+// The slice tracks and the merged tracks are ordered by a stable integer key assigned at their creation:
+// the position of the sector track in the sector tracker output, resp. the index of the first slice track
+// of the merged track. Ranges which are already ordered, e.g. when unpacked by a single thread, are not sorted.
+template <class T, class S>
+GPUdi() static bool isOrdered(const T* begin, const T* end, const S& comp)
+{
+  for (const T* it = begin + 1; it < end; it++) {
+    if (comp(*it, *(it - 1))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <>
 GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels::sectorTracks>(int nBlocks, int nThreads, int iBlock, int iThread, GPUsharedref() GPUSharedMemory& smem, processorType& GPUrestrict() merger, char parameter)
 {
@@ -46,48 +57,35 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
     if (n < 2) {
       continue;
     }
+    GPUTPCGMSliceTrack* GPUrestrict() tracks = merger.SliceTrackInfos() + offset;
+    if (isOrdered(tracks, tracks + n, [](const GPUTPCGMSliceTrack& a, const GPUTPCGMSliceTrack& b) { return a.OrigTrack() < b.OrigTrack(); })) {
+      continue;
+    }
     for (int j = 0; j < n; j++) {
       tmp[j] = j;
     }
-    GPUCommonAlgorithm::sort(tmp, tmp + n, [&merger, offset](const int& aa, const int& bb) {
-      const auto& a = merger.SliceTrackInfos()[offset + aa];
-      const auto& b = merger.SliceTrackInfos()[offset + bb];
-      return (a.X() != b.X()) ? (a.X() < b.X()) : (a.Y() != b.Y()) ? (a.Y() < b.Y())
-                                                                   : (a.Z() < b.Z());
+    GPUCommonAlgorithm::sort(tmp, tmp + n, [tracks](const int& aa, const int& bb) {
+      return tracks[aa].OrigTrack() < tracks[bb].OrigTrack();
     });
     for (int j = 0; j < n; j++) {
       if (tmp[j] >= 0 && tmp[j] != j) {
-        auto getTrackIDIndex = [&merger](const int iSlice, const int iTrack) {
-          const int kEnd = merger.NMaxSingleSliceTracks();
-          for (int k = 0; k < kEnd; k++) {
-            if (merger.TrackIDs()[iSlice * merger.NMaxSingleSliceTracks() + k] == iTrack) {
-              return k;
-            }
-          }
-#ifndef GPUCA_GPUCODE_DEVICE
-          throw std::runtime_error("Internal error, track id missing");
-#endif
-          return -1;
-        };
         int firstIdx = j;
-        auto firstItem = merger.SliceTrackInfos()[offset + firstIdx];
-        int firstTrackIDIndex = parameter ? 0 : getTrackIDIndex(i, offset + firstIdx);
+        auto firstItem = tracks[firstIdx];
         int currIdx = firstIdx;
         int sourceIdx = tmp[currIdx];
         do {
           tmp[currIdx] = -1;
-          merger.SliceTrackInfos()[offset + currIdx] = merger.SliceTrackInfos()[offset + sourceIdx];
-          if (!parameter) {
-            merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + getTrackIDIndex(i, offset + sourceIdx)] = offset + currIdx;
-          }
+          tracks[currIdx] = tracks[sourceIdx];
           currIdx = sourceIdx;
           sourceIdx = tmp[currIdx];
         } while (sourceIdx != firstIdx);
         tmp[currIdx] = -1;
-        merger.SliceTrackInfos()[offset + currIdx] = firstItem;
-        if (!parameter) {
-          merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + firstTrackIDIndex] = offset + currIdx;
-        }
+        tracks[currIdx] = firstItem;
+      }
+    }
+    if (!parameter) { // The ids of the local tracks are indexed by the local track id of their sector track
+      for (int j = 0; j < n; j++) {
+        merger.TrackIDs()[i * merger.NMaxSingleSliceTracks() + tracks[j].OrigTrack()->LocalTrackId()] = offset + j;
       }
     }
   }
@@ -100,14 +98,16 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
     return;
   }
   int* GPUrestrict() tmp = merger.TmpSortMemory();
+  const int* GPUrestrict() keys = merger.TmpSortMemory() + merger.NMaxTracks(); // Filled by CollectMergedTracks
   const int n = merger.NOutputTracks();
   for (int j = 0; j < n; j++) {
     tmp[j] = j;
   }
-  GPUCommonAlgorithm::sortDeviceDynamic(tmp, tmp + n, [&merger](const int& aa, const int& bb) {
-    const GPUTPCGMMergedTrack& a = merger.OutputTracks()[aa];
-    const GPUTPCGMMergedTrack& b = merger.OutputTracks()[bb];
-    return (a.GetAlpha() != b.GetAlpha()) ? (a.GetAlpha() < b.GetAlpha()) : (a.GetParam().GetX() != b.GetParam().GetX()) ? (a.GetParam().GetX() < b.GetParam().GetX()) : (a.GetParam().GetY() != b.GetParam().GetY()) ? (a.GetParam().GetY() < b.GetParam().GetY()) : (a.GetParam().GetZ() < b.GetParam().GetZ());
+  if (isOrdered(keys, keys + n, [](const int& a, const int& b) { return a < b; })) {
+    return;
+  }
+  GPUCommonAlgorithm::sortDeviceDynamic(tmp, tmp + n, [keys](const int& aa, const int& bb) {
+    return keys[aa] < keys[bb];
   });
 }
 
@@ -158,7 +158,11 @@ GPUdii() void GPUTPCGlobalDebugSortKernels::Thread<GPUTPCGlobalDebugSortKernels:
   }
   auto* borderTracks = merger.BorderTracks(iBlock);
   const unsigned int n = merger.TmpCounter()[iBlock];
-  GPUCommonAlgorithm::sortDeviceDynamic(borderTracks, borderTracks + n, [](const GPUTPCGMBorderTrack& a, const GPUTPCGMBorderTrack& b) {
+  auto comp = [](const GPUTPCGMBorderTrack& a, const GPUTPCGMBorderTrack& b) {
     return (a.TrackID() < b.TrackID());
-  });
+  };
+  if (n < 2 || isOrdered(borderTracks, borderTracks + n, comp)) {
+    return;
+  }
+  GPUCommonAlgorithm::sortDeviceDynamic(borderTracks, borderTracks + n, comp);
 }
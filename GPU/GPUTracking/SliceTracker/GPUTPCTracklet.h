@@ -17,6 +17,7 @@
 
 #include "GPUTPCBaseTrackParam.h"
 #include "GPUTPCDef.h"
+#include "GPUCommonMath.h"
 
 namespace GPUCA_NAMESPACE
 {
@@ -27,12 +28,16 @@ namespace gpu
  *
  * The class describes the reconstructed TPC track candidate.
  * The class is dedicated for internal use by the GPUTPCTracker algorithm.
+ * With GPUCA_TPC_REDUCED_PRECISION_TRACKLETS, the covariance matrix is stored as bfloat16,
+ * which reduces the tracklet from 104 to 76 bytes, the track parameters are kept in full precision.
  */
 MEM_CLASS_PRE()
 class GPUTPCTracklet
 {
  public:
-#if !defined(GPUCA_GPUCODE)
+#if !defined(GPUCA_GPUCODE) && defined(GPUCA_TPC_REDUCED_PRECISION_TRACKLETS)
+  GPUTPCTracklet() : mFirstRow(0), mLastRow(0), mX(0), mZOffset(0), mP(), mC(), mHitWeight(0), mFirstHit(0){};
+#elif !defined(GPUCA_GPUCODE)
   GPUTPCTracklet() : mFirstRow(0), mLastRow(0), mParam(), mHitWeight(0), mFirstHit(0){};
 #endif //! GPUCA_GPUCODE
 
@@ -40,20 +45,58 @@ class GPUTPCTracklet
   GPUhd() int LastRow() const { return mLastRow; }
   GPUhd() int HitWeight() const { return mHitWeight; }
   GPUhd() unsigned int FirstHit() const { return mFirstHit; }
+#ifdef GPUCA_TPC_REDUCED_PRECISION_TRACKLETS
+  GPUhd() MEM_LG(GPUTPCBaseTrackParam) Param() const
+  {
+    MEM_LG(GPUTPCBaseTrackParam)
+    v;
+    v.mX = mX;
+    v.mZOffset = mZOffset;
+    for (int i = 0; i < 5; i++) {
+      v.mP[i] = mP[i];
+    }
+    for (int i = 0; i < 15; i++) {
+      v.mC[i] = CAMath::BFloat162Float(mC[i]);
+    }
+    return v;
+  }
+#else
   GPUhd() MakeType(const MEM_LG(GPUTPCBaseTrackParam) &) Param() const { return mParam; }
+#endif
 
   GPUhd() void SetFirstRow(int v) { mFirstRow = v; }
   GPUhd() void SetLastRow(int v) { mLastRow = v; }
   GPUhd() void SetFirstHit(unsigned int v) { mFirstHit = v; }
   MEM_CLASS_PRE2()
+#ifdef GPUCA_TPC_REDUCED_PRECISION_TRACKLETS
+  GPUhd() void SetParam(const MEM_LG2(GPUTPCBaseTrackParam) & v)
+  {
+    mX = v.mX;
+    mZOffset = v.mZOffset;
+    for (int i = 0; i < 5; i++) {
+      mP[i] = v.mP[i];
+    }
+    for (int i = 0; i < 15; i++) {
+      mC[i] = CAMath::Float2BFloat16Rn(v.mC[i]);
+    }
+  }
+#else
   GPUhd() void SetParam(const MEM_LG2(GPUTPCBaseTrackParam) & v) { mParam = reinterpret_cast<const MEM_LG(GPUTPCBaseTrackParam)&>(v); }
+#endif
   GPUhd() void SetHitWeight(const int w) { mHitWeight = w; }
 
  private:
   int mFirstRow; // first TPC row // TODO: We can use smaller data format here!
   int mLastRow;  // last TPC row
+#ifdef GPUCA_TPC_REDUCED_PRECISION_TRACKLETS
+  float mX;               // x position
+  float mZOffset;         // z offset
+  float mP[5];            // track parameters: Y, Z, SinPhi, DzDs, q/Pt
+  unsigned short mC[15];  // covariance matrix as bfloat16
+#else
   MEM_LG(GPUTPCBaseTrackParam)
   mParam;                 // tracklet parameters
+#endif
   int mHitWeight;         // Hit Weight of Tracklet
   unsigned int mFirstHit; // first hit in row hit array
 };
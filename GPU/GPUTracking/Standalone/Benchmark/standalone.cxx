@@ -32,6 +32,7 @@
 #include <thread>
 #include <future>
 #include <atomic>
+#include <unordered_map>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -58,6 +59,7 @@
 #include "GPUO2DataTypes.h"
 #ifdef GPUCA_HAVE_O2HEADERS
 #include "GPUChainITS.h"
+#include "DataFormatsTPC/TrackTPC.h"
 #endif
 
 using namespace GPUCA_NAMESPACE::gpu;
@@ -82,6 +84,7 @@ std::unique_ptr<char, void (*)(char*)> outputmemory(nullptr, unique_ptr_aligned_
 std::unique_ptr<GPUDisplayFrontendInterface> eventDisplay;
 std::unique_ptr<GPUReconstructionTimeframe> tf;
 int nEventsInDirectory = 0;
+unsigned int batchTFTimeBins = 0;
 std::atomic<unsigned int> nIteration, nIterationEnd;
 
 std::vector<GPUTrackingInOutPointers> ioPtrEvents;
@@ -191,10 +194,23 @@ int ReadConfiguration(int argc, char** argv)
     printf("Double pipeline mode needs at least 3 runs per event and external output. To cycle though multiple events, use --preloadEvents and --runs n for n iterations round-robin\n");
     return 1;
   }
+  if (configStandalone.autoTuneKernels) {
+    if (configStandalone.proc.doublePipeline || configStandalone.testSyncAsync || configStandalone.proc.kernelParameterFile != "") {
+      printf("Kernel autotuning cannot run with double pipeline, asynchronous processing, or preloaded kernel parameters\n");
+      return 1;
+    }
+    if (configStandalone.proc.debugLevel < 1) {
+      configStandalone.proc.debugLevel = 1; // Needed for per-kernel timers
+    }
+  }
   if (configStandalone.TF.bunchSim && configStandalone.TF.nMerge) {
     printf("Cannot run --MERGE and --SIMBUNCHES togeterh\n");
     return 1;
   }
+  if (configStandalone.batchTF > 1 && (configStandalone.TF.bunchSim || configStandalone.TF.nMerge || !configStandalone.runTransformation || configStandalone.proc.runQA)) {
+    printf("Cannot batch TFs with timeframe simulation, without transformation, or with QA\n");
+    return 1;
+  }
   if (configStandalone.TF.bunchSim > 1) {
     configStandalone.TF.timeFrameLen = 1.e9 * configStandalone.TF.bunchSim / configStandalone.TF.interactionRate;
   }
@@ -326,6 +342,14 @@ int SetupReconstruction()
   if (configStandalone.cont && grp.continuousMaxTimeBin == 0) {
     grp.continuousMaxTimeBin = -1;
   }
+  if (configStandalone.batchTF > 1) {
+    if (grp.continuousMaxTimeBin == 0) {
+      printf("ERROR: batching of TFs needs continuous data\n");
+      return 1;
+    }
+    batchTFTimeBins = (grp.continuousMaxTimeBin == -1 ? GPUSettings::TPC_MAX_TF_TIME_BIN : grp.continuousMaxTimeBin) + 1;
+    grp.continuousMaxTimeBin = configStandalone.batchTF * batchTFTimeBins - 1;
+  }
   if (rec->GetDeviceType() == GPUReconstruction::DeviceType::CPU) {
     printf("Standalone Test Framework for CA Tracker - Using CPU\n");
   } else {
@@ -540,6 +564,20 @@ int LoadEvent(int iEvent, int x)
     if (tf->LoadMergedEvents(iEvent)) {
       return 1;
     }
+  } else if (configStandalone.batchTF > 1) {
+    std::vector<GPUTrackingInOutPointers> batchPtrs(configStandalone.batchTF);
+    std::vector<GPUChainTracking::InOutMemory> batchMem(configStandalone.batchTF);
+    for (int i = 0; i < configStandalone.batchTF; i++) {
+      if (ReadEvent(iEvent * configStandalone.batchTF + i)) {
+        return 1;
+      }
+      batchPtrs[i] = chainTracking->mIOPtrs;
+      batchMem[i] = std::move(chainTracking->mIOMem);
+      chainTracking->mIOMem = decltype(chainTracking->mIOMem)();
+    }
+    if (chainTracking->MergeTFBatch(batchPtrs.data(), configStandalone.batchTF, batchTFTimeBins)) {
+      return 1;
+    }
   } else {
     if (ReadEvent(iEvent)) {
       return 1;
@@ -605,6 +643,28 @@ void OutputStat(GPUChainTracking* t, long long int* nTracksTotal = nullptr, long
   if (nTracksTotal && nClustersTotal) {
     *nTracksTotal += nTracks;
     *nClustersTotal += t->mIOPtrs.nMergedTrackHits;
+    if (t->GetTFBatchSize() > 1) {
+      std::vector<unsigned int> nTracksTF(t->GetTFBatchSize());
+#ifdef GPUCA_HAVE_O2HEADERS
+      if (t->GetProcessingSettings().createO2Output) {
+        for (unsigned int k = 0; k < t->mIOPtrs.nOutputTracksTPCO2; k++) {
+          nTracksTF[t->GetTFBatchIndex(t->mIOPtrs.outputTracksTPCO2[k].getTime0())]++;
+        }
+      } else
+#endif
+      {
+        for (unsigned int k = 0; k < t->mIOPtrs.nMergedTracks; k++) {
+          if (t->mIOPtrs.mergedTracks[k].OK()) {
+            nTracksTF[t->GetTFBatchIndex(t->mIOPtrs.mergedTracks[k].GetParam().GetTZOffset())]++;
+          }
+        }
+      }
+      printf("Tracks per TF of the batch:");
+      for (unsigned int k = 0; k < nTracksTF.size(); k++) {
+        printf(" %u", nTracksTF[k]);
+      }
+      printf("\n");
+    }
   }
 }
 
@@ -814,6 +874,9 @@ int main(int argc, char** argv)
     if (configStandalone.TF.nMerge > 1) {
       nEvents /= configStandalone.TF.nMerge;
     }
+    if (configStandalone.batchTF > 1) {
+      nEvents /= configStandalone.batchTF;
+    }
   }
 
   ioPtrEvents.resize(configStandalone.preloadEvents ? (nEvents - configStandalone.StartEvent) : 1);
@@ -833,11 +896,36 @@ int main(int argc, char** argv)
     printf("\n");
   }
 
+  // Candidate launch parameters (threads per block, blocks per multiprocessor) for the autotuning, the first one is the compiled default
+  static constexpr unsigned int autoTuneThreads[] = {0, 64, 128, 256, 512, 1024};
+  static constexpr unsigned int autoTuneBlocks[] = {0, 1, 2, 4, 8};
+  std::vector<GPUReconstruction::kernelParameters> autoTuneCandidates;
+  std::vector<std::unordered_map<std::string, double>> autoTuneTimes; // Summed kernel times over all events, per candidate
+  if (configStandalone.autoTuneKernels) {
+    for (unsigned int t : autoTuneThreads) {
+      for (unsigned int b : autoTuneBlocks) {
+        autoTuneCandidates.emplace_back(GPUReconstruction::kernelParameters{t, b});
+      }
+    }
+    configStandalone.runs2 = autoTuneCandidates.size();
+  }
+
   for (int iRunOuter = 0; iRunOuter < configStandalone.runs2; iRunOuter++) {
     if (configStandalone.QA.inputHistogramsOnly) {
       chainTracking->ForceInitQA();
       break;
     }
+    if (configStandalone.autoTuneKernels) {
+      std::unordered_map<std::string, GPUReconstruction::kernelParameters> params;
+      if (iRunOuter) {
+        for (const auto& k : autoTuneTimes[0]) {
+          params[k.first] = autoTuneCandidates[iRunOuter];
+        }
+      }
+      rec->SetKernelParameters(params);
+      autoTuneTimes.emplace_back();
+      printf("Autotuning candidate %d / %d: %u threads, %u blocks per multiprocessor (0 = default)\n", iRunOuter + 1, (int)autoTuneCandidates.size(), autoTuneCandidates[iRunOuter].nThreads, autoTuneCandidates[iRunOuter].minBlocks);
+    }
     if (configStandalone.runs2 > 1) {
       printf("RUN2: %d\n", iRunOuter);
     }
@@ -909,6 +997,11 @@ int main(int argc, char** argv)
         if (RunBenchmark(rec, chainTracking, configStandalone.runs, iEvent, &nTracksTotal, &nClustersTotal)) {
           goto breakrun;
         }
+        if (configStandalone.autoTuneKernels) {
+          for (const auto& k : rec->GetStatKernelTimes()) {
+            autoTuneTimes.back()[k.first] += k.second;
+          }
+        }
       }
       nEventsProcessed++;
 
@@ -937,6 +1030,28 @@ int main(int argc, char** argv)
     }
   }
 
+  if (configStandalone.autoTuneKernels && autoTuneTimes.size()) {
+    std::unordered_map<std::string, GPUReconstruction::kernelParameters> best;
+    for (const auto& k : autoTuneTimes[0]) {
+      unsigned int iBest = 0;
+      for (unsigned int i = 1; i < autoTuneTimes.size(); i++) {
+        auto it = autoTuneTimes[i].find(k.first);
+        if (it != autoTuneTimes[i].end() && it->second < autoTuneTimes[iBest][k.first]) {
+          iBest = i;
+        }
+      }
+      if (iBest) {
+        best[k.first] = autoTuneCandidates[iBest];
+      }
+      printf("Autotuning: %50s: %'10d us -> %'10d us (%u threads, %u blocks)\n", k.first.c_str(), (int)k.second, (int)autoTuneTimes[iBest][k.first], autoTuneCandidates[iBest].nThreads, autoTuneCandidates[iBest].minBlocks);
+    }
+    if (rec->WriteKernelParameters(configStandalone.autoTuneOutput.c_str(), best)) {
+      printf("Error writing kernel parameters\n");
+    } else {
+      printf("Wrote parameters of %d kernels for architecture %s to %s\n", (int)best.size(), rec->GetDeviceArchitecture().c_str(), configStandalone.autoTuneOutput.c_str());
+    }
+  }
+
 breakrun:
   if (rec->GetProcessingSettings().memoryAllocationStrategy == GPUMemoryResource::ALLOCATION_GLOBAL) {
     rec->PrintMemoryMax();
@@ -30,6 +30,7 @@ set(CONFIG_GL3W 0)
 set(CONFIG_O2 1)
 set(BUILD_DEBUG 0)
 set(GPUCA_NO_FAST_MATH 0)
+set(GPUCA_TPC_REDUCED_PRECISION_TRACKLETS 0)
 #set(GPUCA_CUDA_GCCBIN c++-8.3.0)
 #set(GPUCA_OPENCL_CLANGBIN clang-15)
 #set(HIP_AMDGPUTARGET "gfx906;gfx908;gfx90a")
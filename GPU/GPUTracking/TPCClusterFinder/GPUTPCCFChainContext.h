@@ -52,6 +52,8 @@ struct GPUTPCCFChainContext {
   unsigned int nFragments;
   CfFragment fragmentFirst;
   std::pair<unsigned int, unsigned int> nextPos[GPUCA_NSLICES];
+  unsigned char zsBuffer[GPUCA_NSLICES];     // Half of the ZS buffers holding the next fragment of the sector, in streaming mode
+  unsigned char zsBufferNext[GPUCA_NSLICES]; // Half of the ZS buffers to fill next, per clusterizer lane
   PtrSave ptrSave[GPUCA_NSLICES];
   const o2::tpc::ClusterNativeAccess* ptrClusterNativeSave;
 
@@ -62,6 +64,7 @@ struct GPUTPCCFChainContext {
     for (unsigned int i = 0; i < GPUCA_NSLICES; i++) {
       nPagesSector[i] = 0;
       nDigitsEndpointMax[i] = 0;
+      zsBuffer[i] = zsBufferNext[i] = 0;
     }
 
     if (tpcZS) {
@@ -44,17 +44,17 @@ GPUdii() void GPUTPCCFDecodeZS::decode(GPUTPCClusterFinder& clusterer, GPUShared
 {
   const unsigned int slice = clusterer.mISlice;
 #ifdef GPUCA_GPUCODE
-  const unsigned int endpoint = clusterer.mPzsOffsets[iBlock].endpoint;
+  const unsigned int endpoint = clusterer.GetZSOffsets()[iBlock].endpoint;
 #else
   const unsigned int endpoint = iBlock;
 #endif
-  const GPUTrackingInOutZS::GPUTrackingInOutZSSlice& zs = clusterer.GetConstantMem()->ioPtrs.tpcZS->slice[slice];
+  const GPUTrackingInOutZS::GPUTrackingInOutZSSlice& zs = clusterer.GetConstantMem()->ioPtrs.tpcZS[clusterer.mPmemory->zsBuffer].slice[slice];
   if (zs.count[endpoint] == 0) {
     return;
   }
   ChargePos* positions = clusterer.mPpositions;
   Array2D<PackedCharge> chargeMap(reinterpret_cast<PackedCharge*>(clusterer.mPchargeMap));
-  const size_t nDigits = clusterer.mPzsOffsets[iBlock].offset;
+  const size_t nDigits = clusterer.GetZSOffsets()[iBlock].offset;
   if (iThread == 0) {
     const int region = endpoint / 2;
     s.nRowsRegion = clusterer.Param().tpcGeometry.GetRegionRows(region);
@@ -68,7 +68,7 @@ GPUdii() void GPUTPCCFDecodeZS::decode(GPUTPCClusterFinder& clusterer, GPUShared
   const unsigned int mySequence = iThread % s.nThreadsPerRow;
 #ifdef GPUCA_GPUCODE
   const unsigned int i = 0;
-  const unsigned int j = clusterer.mPzsOffsets[iBlock].num;
+  const unsigned int j = clusterer.GetZSOffsets()[iBlock].num;
   {
     {
 #else
@@ -466,21 +466,21 @@ GPUd() void GPUTPCCFDecodeZSLinkBase::Decode(int nBlocks, int nThreads, int iBlo
   const unsigned int slice = clusterer.mISlice;
 
 #ifdef GPUCA_GPUCODE
-  const unsigned int endpoint = clusterer.mPzsOffsets[iBlock].endpoint;
+  const unsigned int endpoint = clusterer.GetZSOffsets()[iBlock].endpoint;
 #else // CPU
   const unsigned int endpoint = iBlock;
 #endif
 
-  const GPUTrackingInOutZS::GPUTrackingInOutZSSlice& zs = clusterer.GetConstantMem()->ioPtrs.tpcZS->slice[slice];
+  const GPUTrackingInOutZS::GPUTrackingInOutZSSlice& zs = clusterer.GetConstantMem()->ioPtrs.tpcZS[clusterer.mPmemory->zsBuffer].slice[slice];
   if (zs.count[endpoint] == 0) {
     return;
   }
 
-  uint32_t pageDigitOffset = clusterer.mPzsOffsets[iBlock].offset;
+  uint32_t pageDigitOffset = clusterer.GetZSOffsets()[iBlock].offset;
 
 #ifdef GPUCA_GPUCODE
   const unsigned int i = 0;
-  const unsigned int j = clusterer.mPzsOffsets[iBlock].num;
+  const unsigned int j = clusterer.GetZSOffsets()[iBlock].num;
   {
     {
 #else // CPU
@@ -512,7 +512,7 @@ GPUd() void GPUTPCCFDecodeZSLinkBase::Decode(int nBlocks, int nThreads, int iBlo
 
 #ifdef GPUCA_CHECK_TPCZS_CORRUPTION
   if (iThread == 0 && iBlock < nBlocks - 1) {
-    uint32_t maxOffset = clusterer.mPzsOffsets[iBlock + 1].offset;
+    uint32_t maxOffset = clusterer.GetZSOffsets()[iBlock + 1].offset;
     if (pageDigitOffset != maxOffset) {
       clusterer.raiseError(GPUErrors::ERROR_TPCZS_INVALID_OFFSET, clusterer.mISlice * 1000 + endpoint, pageDigitOffset, maxOffset);
     }
@@ -53,7 +53,7 @@ void* GPUTPCClusterFinder::SetPointersInput(void* mem)
 
 void* GPUTPCClusterFinder::SetPointersZSOffset(void* mem)
 {
-  const int n = (mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding) ? mNMaxPages : GPUTrackingInOutZS::NENDPOINTS;
+  const int n = (mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding) ? mNMaxPages * (1 + mRec->GetProcessingSettings().tpcClusterizerStreaming) : GPUTrackingInOutZS::NENDPOINTS;
   if (n) {
     computePointerWithAlignment(mem, mPzsOffsets, n);
   }
@@ -63,7 +63,7 @@ void* GPUTPCClusterFinder::SetPointersZSOffset(void* mem)
 void* GPUTPCClusterFinder::SetPointersZS(void* mem)
 {
   if (mNMaxPages && (mRec->GetRecoStepsGPU() & GPUDataTypes::RecoStep::TPCClusterFinding)) {
-    computePointerWithAlignment(mem, mPzs, mNMaxPages * TPCZSHDR::TPC_ZS_PAGE_SIZE);
+    computePointerWithAlignment(mem, mPzs, mNMaxPages * (1 + mRec->GetProcessingSettings().tpcClusterizerStreaming) * TPCZSHDR::TPC_ZS_PAGE_SIZE);
   }
   return mem;
 }
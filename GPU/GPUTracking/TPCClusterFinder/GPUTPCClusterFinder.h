@@ -64,6 +64,7 @@ class GPUTPCClusterFinder : public GPUProcessor
       unsigned int nPagesSubslice = 0;
     } counters;
     CfFragment fragment;
+    unsigned int zsBuffer = 0; // Which half of the double-buffered ZS data holds the current fragment
   };
 
   struct ZSOffset {
@@ -117,6 +118,7 @@ class GPUTPCClusterFinder : public GPUProcessor
   Memory* mPmemory = nullptr;
 
   GPUdi() int* GetScanBuffer(int iBuf) const { return mPbuf + iBuf * mBufSize; }
+  GPUdi() const ZSOffset* GetZSOffsets() const { return mPzsOffsets + mPmemory->zsBuffer * mNMaxPages; }
 
   o2::dataformats::ConstMCTruthContainerView<o2::MCCompLabel> const* mPinputLabels = nullptr;
   unsigned int* mPlabelsInRow = nullptr;
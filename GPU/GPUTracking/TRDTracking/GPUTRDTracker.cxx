@@ -36,6 +36,7 @@ class GPUTPCGMPolynomialField;
 #ifdef WITH_OPENMP
 #include <omp.h>
 #endif // WITH_OPENMP
+#include <algorithm>
 #include <chrono>
 #include <vector>
 #ifdef GPUCA_ALIROOT_LIB
@@ -87,6 +88,7 @@ void* GPUTRDTracker_t<TRDTRK, PROP>::SetPointersTracklets(void* base)
     computePointerWithAlignment(base, mSpacePoints, mNMaxSpacePoints);
   }
   computePointerWithAlignment(base, mTrackletIndexArray, (kNChambers + 1) * mNMaxCollisions);
+  computePointerWithAlignment(base, mTrackletIndexSortedY, mNMaxSpacePoints);
   return base;
 }
 
@@ -102,7 +104,7 @@ void* GPUTRDTracker_t<TRDTRK, PROP>::SetPointersTracks(void* base)
 }
 
 template <class TRDTRK, class PROP>
-GPUTRDTracker_t<TRDTRK, PROP>::GPUTRDTracker_t() : mR(nullptr), mIsInitialized(false), mGenerateSpacePoints(false), mProcessPerTimeFrame(false), mNAngleHistogramBins(25), mAngleHistogramRange(50), mMemoryPermanent(-1), mMemoryTracklets(-1), mMemoryTracks(-1), mNMaxCollisions(0), mNMaxTracks(0), mNMaxSpacePoints(0), mTracks(nullptr), mTrackAttribs(nullptr), mNCandidates(1), mNTracks(0), mNEvents(0), mMaxThreads(100), mTrackletIndexArray(nullptr), mHypothesis(nullptr), mCandidates(nullptr), mSpacePoints(nullptr), mGeo(nullptr), mRPhiA2(0), mRPhiB(0), mRPhiC2(0), mDyA2(0), mDyB(0), mDyC2(0), mAngleToDyA(0), mAngleToDyB(0), mAngleToDyC(0), mDebugOutput(false), mMaxEta(0.84f), mRoadZ(18.f), mZCorrCoefNRC(1.4f), mTPCVdrift(2.58f), mTPCTDriftOffset(0.f), mDebug(new GPUTRDTrackerDebug<TRDTRK>())
+GPUTRDTracker_t<TRDTRK, PROP>::GPUTRDTracker_t() : mR(nullptr), mIsInitialized(false), mGenerateSpacePoints(false), mProcessPerTimeFrame(false), mNAngleHistogramBins(25), mAngleHistogramRange(50), mMemoryPermanent(-1), mMemoryTracklets(-1), mMemoryTracks(-1), mNMaxCollisions(0), mNMaxTracks(0), mNMaxSpacePoints(0), mTracks(nullptr), mTrackAttribs(nullptr), mNCandidates(1), mNTracks(0), mNEvents(0), mMaxThreads(100), mTrackletIndexArray(nullptr), mTrackletIndexSortedY(nullptr), mHypothesis(nullptr), mCandidates(nullptr), mSpacePoints(nullptr), mGeo(nullptr), mRPhiA2(0), mRPhiB(0), mRPhiC2(0), mDyA2(0), mDyB(0), mDyC2(0), mAngleToDyA(0), mAngleToDyB(0), mAngleToDyC(0), mDebugOutput(false), mMaxEta(0.84f), mRoadZ(18.f), mZCorrCoefNRC(1.4f), mTPCVdrift(2.58f), mTPCTDriftOffset(0.f), mDebug(new GPUTRDTrackerDebug<TRDTRK>())
 {
   //--------------------------------------------------------------------
   // Default constructor
@@ -239,12 +241,23 @@ void GPUTRDTracker_t<TRDTRK, PROP>::PrepareTracking(GPUChainTracking* chainTrack
     for (int iDet = currDet; iDet <= kNChambers; ++iDet) {
       trkltIndexArray[iDet] = trkltCounter;
     }
+    int* trkltIndexSortedY = &mTrackletIndexSortedY[idxOffset];
+    for (int iTrklt = 0; iTrklt < nTrklts; ++iTrklt) {
+      trkltIndexSortedY[iTrklt] = idxOffset + iTrklt;
+    }
     if (mGenerateSpacePoints) {
       if (!CalculateSpacePoints(iColl)) {
         GPUError("Space points for at least one chamber could not be calculated (for interaction %i)", iColl);
         break;
       }
     }
+    // order the tracklets of each chamber by the y coordinate of their space point, for the search of the tracklets in the road of the tracks
+    const GPUTRDSpacePoint* spacePoints = mGenerateSpacePoints ? mSpacePoints : GetConstantMem()->ioPtrs.trdSpacePoints;
+    for (int iDet = 0; iDet < kNChambers; ++iDet) {
+      std::sort(trkltIndexSortedY + trkltIndexArray[iDet], trkltIndexSortedY + trkltIndexArray[iDet + 1], [spacePoints](int a, int b) {
+        return spacePoints[a].getY() < spacePoints[b].getY();
+      });
+    }
   }
   if (mGenerateSpacePoints) {
     chainTracking->mIOPtrs.trdSpacePoints = mSpacePoints;
@@ -653,9 +666,24 @@ GPUd() bool GPUTRDTracker_t<TRDTRK, PROP>::FollowProlongation(PROP* prop, TRDTRK
             GPUWarning("Track parameter for track %i, x=%f at chamber %i x=%f in layer %i cannot be retrieved", iTrk, trkWork->getX(), currDet, mR[currDet], iLayer);
           }
         }
+        // the tracklets of the chamber are ordered in y, only the ones within the road in y are visited, starting from the first one found by binary search
+        int iSortedFirst = glbTrkltIdxOffset + mTrackletIndexArray[trkltIdxOffset + currDet];
+        const int iSortedEnd = glbTrkltIdxOffset + mTrackletIndexArray[trkltIdxOffset + currDet + 1];
+        for (int iSortedLast = iSortedEnd; iSortedFirst < iSortedLast;) {
+          const int iSortedMid = (iSortedFirst + iSortedLast) / 2;
+          if (trkWork->getY() - spacePoints[mTrackletIndexSortedY[iSortedMid]].getY() > roadY) {
+            iSortedFirst = iSortedMid + 1;
+          } else {
+            iSortedLast = iSortedMid;
+          }
+        }
         // first propagate track to x of tracklet
-        for (int trkltIdx = glbTrkltIdxOffset + mTrackletIndexArray[trkltIdxOffset + currDet]; trkltIdx < glbTrkltIdxOffset + mTrackletIndexArray[trkltIdxOffset + currDet + 1]; ++trkltIdx) {
-          if (CAMath::Abs(trkWork->getY() - spacePoints[trkltIdx].getY()) > roadY || CAMath::Abs(trkWork->getZ() + zShiftTrk - spacePoints[trkltIdx].getZ()) > roadZ) {
+        for (int iSorted = iSortedFirst; iSorted < iSortedEnd; ++iSorted) {
+          const int trkltIdx = mTrackletIndexSortedY[iSorted];
+          if (spacePoints[trkltIdx].getY() - trkWork->getY() > roadY) {
+            break; // all the following tracklets are outside of the road
+          }
+          if (CAMath::Abs(trkWork->getZ() + zShiftTrk - spacePoints[trkltIdx].getZ()) > roadZ) {
             // skip tracklets which are too far away
             // although the radii of space points and tracks may differ by ~ few mm the roads are large enough to allow no efficiency loss by this cut
             continue;
@@ -180,6 +180,8 @@ class GPUTRDTracker_t : public GPUProcessor
   // the array has (kNChambers + 1) * numberOfCollisions entries
   // note, that for collision iColl one has to add an offset corresponding to the index of the first tracklet of iColl to the index stored in mTrackletIndexArray
   int* mTrackletIndexArray;
+  // global indices of the tracklets ordered by the y coordinate of their space point within each chamber, with the same chamber ranges as mTrackletIndexArray
+  int* mTrackletIndexSortedY;
   Hypothesis* mHypothesis;                 // array with multiple track hypothesis
   TRDTRK* mCandidates;                     // array of tracks for multiple hypothesis tracking
   GPUTRDSpacePoint* mSpacePoints;          // array with tracklet coordinates in global tracking frame
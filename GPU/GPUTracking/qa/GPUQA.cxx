@@ -101,7 +101,7 @@ using namespace GPUCA_NAMESPACE::gpu;
   int id = attach & gputpcgmmergertypes::attachTrackMask;                                        \
   if (!unattached) {                                                                             \
     qpt = fabsf(mTracking->mIOPtrs.mergedTracks[id].GetParam().GetQPt());                        \
-    lowPt = qpt * mTracking->GetParam().qptB5Scaler > mTracking->GetParam().rec.tpc.rejectQPtB5; \
+    lowPt = qpt * mTracking->GetParam().qptB5Scaler > mTracking->GetParam().GetRejectQPtB5(mTracking->mIOPtrs.mergedTracks[id].GetParam().GetTZOffset()); \
     mev200 = qpt > 5;                                                                            \
     mergedLooper = mTracking->mIOPtrs.mergedTracks[id].MergedLooper();                           \
   }                                                                                              \
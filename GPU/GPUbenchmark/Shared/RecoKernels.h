@@ -0,0 +1,66 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RecoKernels.h
+/// \brief Microbenchmarks with the memory access patterns of the reconstruction
+
+#ifndef GPU_BENCHMARK_RECOKERNELS_H
+#define GPU_BENCHMARK_RECOKERNELS_H
+
+#include "Utils.h"
+#include <string>
+#include <vector>
+
+namespace o2
+{
+namespace benchmark
+{
+
+struct recoResult {
+  RecoTest test;
+  std::string config; // Parameters of the measurement, e.g. the number of bins of the atomics test
+  float milliseconds; // Average time per launch
+  float throughput;
+  std::string unit;
+};
+
+class RecoBenchmark final
+{
+ public:
+  RecoBenchmark() = delete; // need for a configuration
+  RecoBenchmark(benchmarkOpts& opts) : mOptions{opts}
+  {
+  }
+  ~RecoBenchmark() = default;
+
+  void run(); // Execute all the requested reco tests, and write the JSON report if requested
+
+ private:
+  void runChargeMap(bool scatter); // Digits scattered to / clusterizer 3x3 neighbourhoods gathered from a pad x time charge map
+  void runSortScan(bool sort);     // Radix sort of merger-like (key, index) pairs, exclusive scan of per-bin counts
+  void runAtomics();               // Occupancy-map-like histogramming, for an increasing contention
+  void runTransfer();              // Pinned host <-> device copies, one direction at a time and both concurrently
+
+  template <typename F>
+  float measure(F&& launch); // Average time (ms) of the launches, called with the stream to use, after a warm up
+  void report(RecoTest test, const std::string& config, float milliseconds, float throughput, const char* unit);
+  void writeJSON() const;
+
+  benchmarkOpts mOptions;
+  std::string mDeviceName;
+  int mBlocks{0};  // Grid of the kernels, from the multiprocessor count unless given with --blocks
+  int mThreads{0}; // Block size of the kernels, 256 unless given with --threads
+  std::vector<recoResult> mResults;
+};
+
+} // namespace benchmark
+} // namespace o2
+#endif
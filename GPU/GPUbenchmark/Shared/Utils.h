@@ -86,6 +86,41 @@ inline std::ostream& operator<<(std::ostream& os, Test test)
   return os;
 }
 
+// Microbenchmarks with the access patterns of the reconstruction
+enum class RecoTest {
+  ChargeMapScatter,
+  ChargeMapGather,
+  SortKeys,
+  ScanCounts,
+  AtomicsContention,
+  PinnedTransfer
+};
+
+inline std::ostream& operator<<(std::ostream& os, RecoTest test)
+{
+  switch (test) {
+    case RecoTest::ChargeMapScatter:
+      os << "charge map scatter";
+      break;
+    case RecoTest::ChargeMapGather:
+      os << "charge map gather";
+      break;
+    case RecoTest::SortKeys:
+      os << "sort keys";
+      break;
+    case RecoTest::ScanCounts:
+      os << "scan counts";
+      break;
+    case RecoTest::AtomicsContention:
+      os << "atomics contention";
+      break;
+    case RecoTest::PinnedTransfer:
+      os << "pinned transfer";
+      break;
+  }
+  return os;
+}
+
 enum class Mode {
   Sequential,
   Concurrent,
@@ -230,6 +265,10 @@ struct benchmarkOpts {
   int prime = 0;
   std::string outFileName = "benchmark_result";
   bool dumpChunks = false;
+  std::vector<RecoTest> recoTests;
+  size_t recoElements = 1 << 24; // Number of digits, keys or atomic operations of the reco tests
+  float recoTransferGB = 1.f;    // Size of the pinned host buffers of the transfer test (GB)
+  bool json = false;             // Write the results of the reco tests to <outFileName>_reco.json
 };
 
 template <class chunk_t>
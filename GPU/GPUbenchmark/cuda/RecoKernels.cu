@@ -0,0 +1,371 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+///
+/// \file RecoKernels.{cu, hip.cxx}
+/// \brief Microbenchmarks with the memory access patterns of the reconstruction
+
+#include "../Shared/RecoKernels.h"
+#include <cub/cub.cuh>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#define GPUCHECK(error)                                                                        \
+  if (error != cudaSuccess) {                                                                  \
+    printf("%serror: '%s'(%d) at %s:%d%s\n", KRED, cudaGetErrorString(error), error, __FILE__, \
+           __LINE__, KNRM);                                                                    \
+    failed("API returned error code.");                                                        \
+  }
+
+namespace o2
+{
+namespace benchmark
+{
+
+namespace gpu
+{
+// Charge map with the size of a TPC sector: pads of all the rows x time bins
+constexpr unsigned int NPads = 15488;
+constexpr unsigned int NTimeBins = 1024;
+
+__host__ __device__ inline unsigned int hashIndex(unsigned int i)
+{
+  i = (i ^ 61) ^ (i >> 16);
+  i *= 9;
+  i ^= i >> 4;
+  i *= 0x27d4eb2d;
+  i ^= i >> 15;
+  return i;
+}
+
+////////////
+// Kernels
+
+// Digits in time order, at random pads, as they come out of the TPC decoding
+__global__ void fill_digits_k(
+  unsigned int* positions,
+  unsigned int* charges,
+  size_t nDigits)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nDigits; i += blockDim.x * gridDim.x) {
+    unsigned int h = hashIndex(i);
+    unsigned int time = (i * NTimeBins / nDigits + (h & 3)) % NTimeBins;
+    positions[i] = time * NPads + (h >> 2) % NPads;
+    charges[i] = 1 + (h >> 24);
+  }
+}
+
+// Random keys with their index, as the tracks sorted by the merger
+__global__ void fill_keys_k(
+  unsigned int* keys,
+  unsigned int* values,
+  size_t n)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    keys[i] = hashIndex(i);
+    values[i] = i;
+  }
+}
+
+// Scatter of the digits to the charge map
+__global__ void charge_map_scatter_k(
+  unsigned int* chargeMap,
+  const unsigned int* positions,
+  const unsigned int* charges,
+  size_t nDigits)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nDigits; i += blockDim.x * gridDim.x) {
+    atomicAdd(&chargeMap[positions[i]], charges[i]);
+  }
+}
+
+// Gather of the 3x3 neighbourhood of the digits in the charge map, as by the peak finder
+__global__ void charge_map_gather_k(
+  const unsigned int* chargeMap,
+  const unsigned int* positions,
+  unsigned char* isPeak,
+  size_t nDigits)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < nDigits; i += blockDim.x * gridDim.x) {
+    int pad = positions[i] % NPads;
+    int time = positions[i] / NPads;
+    unsigned int q = chargeMap[positions[i]];
+    bool peak = true;
+    for (int dt = -1; dt <= 1; dt++) {
+      for (int dp = -1; dp <= 1; dp++) {
+        int t = min(max(time + dt, 0), (int)NTimeBins - 1);
+        int p = min(max(pad + dp, 0), (int)NPads - 1);
+        peak &= chargeMap[t * NPads + p] <= q;
+      }
+    }
+    isPeak[i] = peak;
+  }
+}
+
+// Histogramming to nBins bins, as the occupancy maps
+__global__ void atomics_k(
+  unsigned int* bins,
+  size_t n,
+  unsigned int nBins)
+{
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    atomicAdd(&bins[hashIndex(i) % nBins], 1u);
+  }
+}
+} // namespace gpu
+
+template <typename F>
+float RecoBenchmark::measure(F&& launch)
+{
+  // Best of the nTests runs, to be less sensitive to the other activity of the node when comparing the devices
+  float best{-1.f};
+  cudaStream_t stream;
+  cudaEvent_t start, stop;
+  GPUCHECK(cudaStreamCreate(&stream));
+  GPUCHECK(cudaEventCreate(&start));
+  GPUCHECK(cudaEventCreate(&stop));
+
+  // Warm up
+  launch(stream);
+  GPUCHECK(cudaGetLastError());
+  for (auto measurement{0}; measurement < mOptions.nTests; ++measurement) {
+    float milliseconds{0.f};
+    GPUCHECK(cudaEventRecord(start, stream));
+    for (auto iLaunch{0}; iLaunch < mOptions.kernelLaunches; ++iLaunch) {
+      launch(stream);
+    }
+    GPUCHECK(cudaGetLastError());
+    GPUCHECK(cudaEventRecord(stop, stream));
+    GPUCHECK(cudaEventSynchronize(stop));
+    GPUCHECK(cudaEventElapsedTime(&milliseconds, start, stop));
+    milliseconds /= mOptions.kernelLaunches;
+    best = (best < 0.f) ? milliseconds : std::min(best, milliseconds);
+  }
+  GPUCHECK(cudaEventDestroy(start));
+  GPUCHECK(cudaEventDestroy(stop));
+  GPUCHECK(cudaStreamDestroy(stream));
+  return best;
+}
+
+void RecoBenchmark::report(RecoTest test, const std::string& config, float milliseconds, float throughput, const char* unit)
+{
+  mResults.push_back({test, config, milliseconds, throughput, unit});
+  if (!mOptions.raw) {
+    std::cout << "   ├ " << test << " (" << config << "): \e[1m" << throughput << " " << unit << " \e[0m(" << milliseconds << " ms)" << std::endl;
+  } else {
+    std::cout << test << "\t" << config << "\t" << throughput << "\t" << milliseconds << std::endl;
+  }
+}
+
+void RecoBenchmark::runChargeMap(bool scatter)
+{
+  const size_t nDigits = mOptions.recoElements;
+  const size_t mapSize = (size_t)gpu::NPads * gpu::NTimeBins;
+  unsigned int *chargeMap, *positions, *charges;
+  unsigned char* isPeak;
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&chargeMap), mapSize * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&positions), nDigits * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&charges), nDigits * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&isPeak), nDigits * sizeof(unsigned char)));
+  GPUCHECK(cudaMemset(chargeMap, 0, mapSize * sizeof(unsigned int)));
+  gpu::fill_digits_k<<<mBlocks, mThreads>>>(positions, charges, nDigits);
+  GPUCHECK(cudaGetLastError());
+  GPUCHECK(cudaDeviceSynchronize());
+
+  float milliseconds;
+  if (scatter) {
+    milliseconds = measure([&](cudaStream_t stream) {
+      gpu::charge_map_scatter_k<<<mBlocks, mThreads, 0, stream>>>(chargeMap, positions, charges, nDigits);
+    });
+  } else {
+    gpu::charge_map_scatter_k<<<mBlocks, mThreads>>>(chargeMap, positions, charges, nDigits);
+    milliseconds = measure([&](cudaStream_t stream) {
+      gpu::charge_map_gather_k<<<mBlocks, mThreads, 0, stream>>>(chargeMap, positions, isPeak, nDigits);
+    });
+  }
+  report(scatter ? RecoTest::ChargeMapScatter : RecoTest::ChargeMapGather, std::to_string(nDigits) + " digits", milliseconds, 1e-6 * nDigits / milliseconds, "Gdigits/s");
+
+  GPUCHECK(cudaFree(chargeMap));
+  GPUCHECK(cudaFree(positions));
+  GPUCHECK(cudaFree(charges));
+  GPUCHECK(cudaFree(isPeak));
+}
+
+void RecoBenchmark::runSortScan(bool sort)
+{
+  // The input buffers are not modified, so that all the launches process the same unsorted data
+  const size_t n = mOptions.recoElements;
+  unsigned int *keysIn, *keysOut, *valuesIn, *valuesOut;
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&keysIn), n * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&keysOut), n * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&valuesIn), n * sizeof(unsigned int)));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&valuesOut), n * sizeof(unsigned int)));
+  gpu::fill_keys_k<<<mBlocks, mThreads>>>(keysIn, valuesIn, n);
+  GPUCHECK(cudaGetLastError());
+
+  void* tmp{nullptr};
+  size_t tmpSize{0};
+  if (sort) {
+    GPUCHECK(cub::DeviceRadixSort::SortPairs(tmp, tmpSize, keysIn, keysOut, valuesIn, valuesOut, n));
+  } else {
+    GPUCHECK(cub::DeviceScan::ExclusiveSum(tmp, tmpSize, valuesIn, valuesOut, n));
+  }
+  GPUCHECK(cudaMalloc(&tmp, tmpSize));
+  GPUCHECK(cudaDeviceSynchronize());
+
+  float milliseconds;
+  if (sort) {
+    milliseconds = measure([&](cudaStream_t stream) {
+      GPUCHECK(cub::DeviceRadixSort::SortPairs(tmp, tmpSize, keysIn, keysOut, valuesIn, valuesOut, n, 0, sizeof(unsigned int) * 8, stream));
+    });
+  } else {
+    milliseconds = measure([&](cudaStream_t stream) {
+      GPUCHECK(cub::DeviceScan::ExclusiveSum(tmp, tmpSize, valuesIn, valuesOut, n, stream));
+    });
+  }
+  report(sort ? RecoTest::SortKeys : RecoTest::ScanCounts, std::to_string(n) + " elements", milliseconds, 1e-6 * n / milliseconds, sort ? "Gkeys/s" : "Gelements/s");
+
+  GPUCHECK(cudaFree(tmp));
+  GPUCHECK(cudaFree(keysIn));
+  GPUCHECK(cudaFree(keysOut));
+  GPUCHECK(cudaFree(valuesIn));
+  GPUCHECK(cudaFree(valuesOut));
+}
+
+void RecoBenchmark::runAtomics()
+{
+  const size_t n = mOptions.recoElements;
+  const unsigned int maxBins = std::max<size_t>(1, std::min<size_t>(n, 1 << 20));
+  unsigned int* bins;
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&bins), maxBins * sizeof(unsigned int)));
+  GPUCHECK(cudaMemset(bins, 0, maxBins * sizeof(unsigned int)));
+  // From all the threads on the same bin, to mostly one thread per bin
+  for (unsigned int nBins = 1; nBins <= maxBins; nBins *= 32) {
+    float milliseconds = measure([&](cudaStream_t stream) {
+      gpu::atomics_k<<<mBlocks, mThreads, 0, stream>>>(bins, n, nBins);
+    });
+    report(RecoTest::AtomicsContention, std::to_string(nBins) + " bins", milliseconds, 1e-6 * n / milliseconds, "Gops/s");
+  }
+  GPUCHECK(cudaFree(bins));
+}
+
+void RecoBenchmark::runTransfer()
+{
+  const size_t size = static_cast<size_t>(GB * mOptions.recoTransferGB) & 0xFFFFFFFFFFFFF000;
+  char *hostIn, *hostOut, *deviceIn, *deviceOut;
+  GPUCHECK(cudaMallocHost(reinterpret_cast<void**>(&hostIn), size));
+  GPUCHECK(cudaMallocHost(reinterpret_cast<void**>(&hostOut), size));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&deviceIn), size));
+  GPUCHECK(cudaMalloc(reinterpret_cast<void**>(&deviceOut), size));
+  memset(hostIn, 1, size);
+
+  cudaStream_t d2hStream;
+  cudaEvent_t fork, join;
+  GPUCHECK(cudaStreamCreate(&d2hStream));
+  GPUCHECK(cudaEventCreateWithFlags(&fork, cudaEventDisableTiming));
+  GPUCHECK(cudaEventCreateWithFlags(&join, cudaEventDisableTiming));
+
+  std::ostringstream configStream;
+  configStream << mOptions.recoTransferGB << " GB";
+  const std::string config = configStream.str();
+  const float sizeGB = (float)size / (float)GB;
+  float milliseconds = measure([&](cudaStream_t stream) {
+    GPUCHECK(cudaMemcpyAsync(deviceIn, hostIn, size, cudaMemcpyHostToDevice, stream));
+  });
+  report(RecoTest::PinnedTransfer, "H2D " + config, milliseconds, 1e3 * sizeGB / milliseconds, "GB/s");
+  milliseconds = measure([&](cudaStream_t stream) {
+    GPUCHECK(cudaMemcpyAsync(hostOut, deviceOut, size, cudaMemcpyDeviceToHost, stream));
+  });
+  report(RecoTest::PinnedTransfer, "D2H " + config, milliseconds, 1e3 * sizeGB / milliseconds, "GB/s");
+  // The D2H copy runs on a second stream, between a fork and a join with the measured one
+  milliseconds = measure([&](cudaStream_t stream) {
+    GPUCHECK(cudaEventRecord(fork, stream));
+    GPUCHECK(cudaStreamWaitEvent(d2hStream, fork, 0));
+    GPUCHECK(cudaMemcpyAsync(deviceIn, hostIn, size, cudaMemcpyHostToDevice, stream));
+    GPUCHECK(cudaMemcpyAsync(hostOut, deviceOut, size, cudaMemcpyDeviceToHost, d2hStream));
+    GPUCHECK(cudaEventRecord(join, d2hStream));
+    GPUCHECK(cudaStreamWaitEvent(stream, join, 0));
+  });
+  report(RecoTest::PinnedTransfer, "H2D+D2H " + config, milliseconds, 2e3 * sizeGB / milliseconds, "GB/s");
+
+  GPUCHECK(cudaEventDestroy(fork));
+  GPUCHECK(cudaEventDestroy(join));
+  GPUCHECK(cudaStreamDestroy(d2hStream));
+  GPUCHECK(cudaFreeHost(hostIn));
+  GPUCHECK(cudaFreeHost(hostOut));
+  GPUCHECK(cudaFree(deviceIn));
+  GPUCHECK(cudaFree(deviceOut));
+}
+
+void RecoBenchmark::writeJSON() const
+{
+  std::string fileName = mOptions.outFileName + "_reco.json";
+  std::ofstream out(fileName);
+  out << "{\n"
+      << "  \"device\": \"" << mDeviceName << "\",\n"
+      << "  \"launches\": " << mOptions.kernelLaunches << ",\n"
+      << "  \"runs\": " << mOptions.nTests << ",\n"
+      << "  \"blocks\": " << mBlocks << ",\n"
+      << "  \"threads\": " << mThreads << ",\n"
+      << "  \"results\": [";
+  for (size_t i{0}; i < mResults.size(); ++i) {
+    const auto& result = mResults[i];
+    std::ostringstream test;
+    test << result.test;
+    out << (i ? "," : "") << "\n    {\"test\": \"" << test.str() << "\", \"config\": \"" << result.config << "\", \"ms\": " << result.milliseconds
+        << ", \"throughput\": " << result.throughput << ", \"unit\": \"" << result.unit << "\"}";
+  }
+  out << "\n  ]\n}\n";
+  if (!mOptions.raw) {
+    std::cout << "   ├ Results written to " << fileName << std::endl;
+  }
+}
+
+void RecoBenchmark::run()
+{
+  cudaDeviceProp props;
+  GPUCHECK(cudaSetDevice(mOptions.deviceId));
+  GPUCHECK(cudaGetDeviceProperties(&props, mOptions.deviceId));
+  mDeviceName = props.name;
+  mBlocks = (mOptions.numBlocks > 0) ? mOptions.numBlocks : props.multiProcessorCount * 4;
+  mThreads = (mOptions.numThreads > 0) ? mOptions.numThreads : 256;
+
+  if (!mOptions.raw) {
+    std::cout << " ◈ Reco benchmarks on: \033[1;31m" << props.name << "\e[0m with \e[1m" << mBlocks << "\e[0m blocks of \e[1m" << mThreads << "\e[0m threads" << std::endl;
+  }
+  for (auto& test : mOptions.recoTests) {
+    switch (test) {
+      case RecoTest::ChargeMapScatter:
+      case RecoTest::ChargeMapGather:
+        runChargeMap(test == RecoTest::ChargeMapScatter);
+        break;
+      case RecoTest::SortKeys:
+      case RecoTest::ScanCounts:
+        runSortScan(test == RecoTest::SortKeys);
+        break;
+      case RecoTest::AtomicsContention:
+        runAtomics();
+        break;
+      case RecoTest::PinnedTransfer:
+        runTransfer();
+        break;
+    }
+  }
+  if (mOptions.json) {
+    writeJSON();
+  }
+  if (!mOptions.raw) {
+    std::cout << "   └\033[1;32m done\033[0m" << std::endl;
+  }
+}
+
+} // namespace benchmark
+} // namespace o2
@@ -14,7 +14,8 @@
 #include <unistd.h>
 
 #include "../Shared/Kernels.h"
-#define VERSION "version 0.3"
+#include "../Shared/RecoKernels.h"
+#define VERSION "version 0.4"
 
 bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
 {
@@ -31,6 +32,7 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     "blocks,g", bpo::value<int>()->default_value(-1), "Number of blocks, manual mode. (g=-1: gridDim.x).")(
     "help,h", "Print help message.")(
     "inspect,i", "Inspect and dump chunk addresses.")(
+    "json", "Write the results of the reco tests to <outfile>_reco.json.")(
     "threads,j", bpo::value<int>()->default_value(-1), "Number of threads per block, manual mode. (j=-1: blockDim.x).")(
     "kind,k", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"char", "int", "ulong", "int4"}, "char int ulong int4"), "Test data type to be used.")(
     "launches,l", bpo::value<int>()->default_value(10), "Number of iterations in reading kernels.")(
@@ -39,6 +41,9 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     "outfile,o", bpo::value<std::string>()->default_value("benchmark_result"), "Output file name to store results.")(
     "prime,p", bpo::value<int>()->default_value(0), "Prime number to be used for the test.")(
     "raw,r", "Display raw output.")(
+    "reco", bpo::value<std::vector<std::string>>()->multitoken(), "Reco tests to be performed instead of the memory ones: scatter gather sort scan atomics transfer, or all.")(
+    "recoElements", bpo::value<size_t>()->default_value(1 << 24), "Number of digits, keys or atomic operations of the reco tests.")(
+    "recoTransferSize", bpo::value<float>()->default_value(1.f), "Size of the pinned host buffers of the reco transfer test (GB).")(
     "streams,s", bpo::value<int>()->default_value(8), "Size of the pool of streams available for concurrent tests.")(
     "test,t", bpo::value<std::vector<std::string>>()->multitoken()->default_value(std::vector<std::string>{"read", "write", "copy", "rread", "rwrite", "rcopy"}, "read write copy rread rwrite rcopy"), "Tests to be performed.")(
     "version,v", "Print version.")(
@@ -70,6 +75,10 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
       conf.raw = true;
     }
 
+    if (vm.count("json")) {
+      conf.json = true;
+    }
+
     bpo::notify(vm);
   } catch (const bpo::error& e) {
     std::cerr << e.what() << "\n\n";
@@ -168,6 +177,36 @@ bool parseArgs(o2::benchmark::benchmarkOpts& conf, int argc, const char* argv[])
     }
   }
 
+  conf.recoTests.clear();
+  if (vm.count("reco")) {
+    for (auto& test : vm["reco"].as<std::vector<std::string>>()) {
+      if (test == "scatter" || test == "all") {
+        conf.recoTests.push_back(RecoTest::ChargeMapScatter);
+      }
+      if (test == "gather" || test == "all") {
+        conf.recoTests.push_back(RecoTest::ChargeMapGather);
+      }
+      if (test == "sort" || test == "all") {
+        conf.recoTests.push_back(RecoTest::SortKeys);
+      }
+      if (test == "scan" || test == "all") {
+        conf.recoTests.push_back(RecoTest::ScanCounts);
+      }
+      if (test == "atomics" || test == "all") {
+        conf.recoTests.push_back(RecoTest::AtomicsContention);
+      }
+      if (test == "transfer" || test == "all") {
+        conf.recoTests.push_back(RecoTest::PinnedTransfer);
+      }
+      if (test != "scatter" && test != "gather" && test != "sort" && test != "scan" && test != "atomics" && test != "transfer" && test != "all") {
+        std::cerr << "Unkonwn reco test: " << test << std::endl;
+        exit(1);
+      }
+    }
+  }
+  conf.recoElements = vm["recoElements"].as<size_t>();
+  conf.recoTransferGB = vm["recoTransferSize"].as<float>();
+
   conf.dtypes = vm["kind"].as<std::vector<std::string>>();
   conf.outFileName = vm["outfile"].as<std::string>();
 
@@ -183,6 +222,12 @@ int main(int argc, const char* argv[])
     return -1;
   }
 
+  if (!opts.recoTests.empty()) {
+    o2::benchmark::RecoBenchmark bm_reco{opts};
+    bm_reco.run();
+    return 0;
+  }
+
   for (auto& dtype : opts.dtypes) {
     if (dtype == "char") {
       o2::benchmark::GPUbenchmark<char> bm_char{opts};
@@ -42,6 +42,11 @@ class CorrectionMapsHelper
     mCorrMap->Transform(slice, row, pad, time, x, y, z, vertexTime, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
   }
 
+  GPUd() void TransformRow(int slice, int row, int n, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime = 0) const
+  {
+    mCorrMap->TransformRow(slice, row, n, pad, time, x, y, z, vertexTime, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
+  }
+
   GPUd() void TransformXYZ(int slice, int row, float& x, float& y, float& z) const
   {
     mCorrMap->TransformXYZ(slice, row, x, y, z, mCorrMapRef, mCorrMapMShape, mLumiScale, 1, mLumiScaleMode);
@@ -161,6 +161,9 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   ///
   GPUd() int getCorrection(int slice, int row, float u, float v, float& dx, float& du, float& dv) const;
 
+  /// Corrections for n points of the same TPC row, identical to getCorrection() for each point. The row-dependent quantities are taken only once.
+  GPUd() void getCorrections(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const;
+
   /// inverse correction: Corrected U and V -> coorrected X
   GPUd() void getCorrectionInvCorrectedX(int slice, int row, float corrU, float corrV, float& corrX) const;
 
@@ -420,6 +423,32 @@ GPUdi() int TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, floa
   return 0;
 }
 
+GPUdi() void TPCFastSpaceChargeCorrection::getCorrections(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const
+{
+  const SplineType& spline = getSpline(slice, row);
+  const float* splineData = getSplineData(slice, row);
+  const SliceRowInfo& info = getSliceRowInfo(slice, row);
+  // same as convUVtoGrid(), with the start of the V-grid taken once
+  float su0 = 0.f, sv0 = 0.f;
+  mGeo.convUVtoScaledUV(slice, row, 0.f, info.gridV0, su0, sv0);
+  const float gridUmax = spline.getGridX1().getUmax();
+  const float gridVmax = spline.getGridX2().getUmax();
+  for (int i = 0; i < n; i++) {
+    float ui = u[i], vi = v[i];
+    schrinkUV(slice, row, ui, vi);
+    float gridU = 0.f, gridV = 0.f;
+    mGeo.convUVtoScaledUV(slice, row, ui, vi, gridU, gridV);
+    gridV = (gridV - sv0) / (1.f - sv0);
+    gridU *= gridUmax;
+    gridV *= gridVmax;
+    float dxuv[3];
+    spline.interpolateU(splineData, gridU, gridV, dxuv);
+    dx[i] = dxuv[0];
+    du[i] = dxuv[1];
+    dv[i] = dxuv[2];
+  }
+}
+
 GPUdi() int TPCFastSpaceChargeCorrection::getCorrectionOld(int slice, int row, float u, float v, float& dx, float& du, float& dv) const
 {
   const SplineType& spline = getSpline(slice, row);
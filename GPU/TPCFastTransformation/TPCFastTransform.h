@@ -185,6 +185,10 @@ class TPCFastTransform : public FlatObject
   GPUd() void Transform(int slice, int row, float pad, float time, float& x, float& y, float& z, float vertexTime = 0, const TPCFastTransform* ref = nullptr, const TPCFastTransform* ref2 = nullptr, float scale = 0.f, float scale2 = 0.f, int scaleMode = 0) const;
   GPUd() void TransformXYZ(int slice, int row, float& x, float& y, float& z, const TPCFastTransform* ref = nullptr, const TPCFastTransform* ref2 = nullptr, float scale = 0.f, float scale2 = 0.f, int scaleMode = 0) const;
 
+  /// Transforms n clusters of the same TPC row, the result is identical to Transform() called for each cluster.
+  /// The spline corrections are evaluated for blocks of clusters with the row-dependent quantities taken only once.
+  GPUd() void TransformRow(int slice, int row, int n, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime = 0, const TPCFastTransform* ref = nullptr, const TPCFastTransform* ref2 = nullptr, float scale = 0.f, float scale2 = 0.f, int scaleMode = 0) const;
+
   /// Transformation in the time frame
   GPUd() void TransformInTimeFrame(int slice, int row, float pad, float time, float& x, float& y, float& z, float maxTimeBin) const;
   GPUd() void TransformInTimeFrame(int slice, float time, float& z, float maxTimeBin) const;
@@ -619,6 +623,69 @@ GPUdi() void TPCFastTransform::Transform(int slice, int row, float pad, float ti
   z += dzTOF;
 }
 
+GPUdi() void TPCFastTransform::TransformRow(int slice, int row, int n, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime, const TPCFastTransform* ref, const TPCFastTransform* ref2, float scale, float scale2, int scaleMode) const
+{
+  bool perCluster = !mApplyCorrection || !((scale >= 0.f) || (scaleMode == 1) || (scaleMode == 2));
+#ifndef GPUCA_GPUCODE
+  perCluster |= (mCorrectionSlow != nullptr);
+#endif
+  GPUCA_DEBUG_STREAMER_CHECK(perCluster |= o2::utils::DebugStreamer::checkStream(o2::utils::StreamFlags::streamFastTransform););
+  if (perCluster) {
+    for (int i = 0; i < n; i++) {
+      Transform(slice, row, pad[i], time[i], x[i], y[i], z[i], vertexTime, ref, ref2, scale, scale2, scaleMode);
+    }
+    return;
+  }
+
+  const TPCFastTransformGeo::RowInfo& rowInfo = getGeometry().getRowInfo(row);
+  constexpr int BlockSize = 32;
+  float u[BlockSize], v[BlockSize], dx[BlockSize], du[BlockSize], dv[BlockSize], dxRef[BlockSize], duRef[BlockSize], dvRef[BlockSize];
+  for (int iFirst = 0; iFirst < n; iFirst += BlockSize) {
+    const int nBlock = GPUCommonMath::Min(BlockSize, n - iFirst);
+    for (int i = 0; i < nBlock; i++) {
+      convPadTimeToUV(slice, row, pad[iFirst + i], time[iFirst + i], u[i], v[i], vertexTime);
+    }
+    // same combination of the corrections as in TransformInternal()
+    mCorrection.getCorrections(slice, row, nBlock, u, v, dx, du, dv);
+    if (ref) {
+      if ((scale > 0.f) && (scaleMode == 0)) { // scaling was requested
+        ref->mCorrection.getCorrections(slice, row, nBlock, u, v, dxRef, duRef, dvRef);
+        for (int i = 0; i < nBlock; i++) {
+          dx[i] = (dx[i] - dxRef[i]) * scale + dxRef[i];
+          du[i] = (du[i] - duRef[i]) * scale + duRef[i];
+          dv[i] = (dv[i] - dvRef[i]) * scale + dvRef[i];
+        }
+      } else if ((scale != 0.f) && ((scaleMode == 1) || (scaleMode == 2))) {
+        ref->mCorrection.getCorrections(slice, row, nBlock, u, v, dxRef, duRef, dvRef);
+        for (int i = 0; i < nBlock; i++) {
+          dx[i] = dxRef[i] * scale + dx[i];
+          du[i] = duRef[i] * scale + du[i];
+          dv[i] = dvRef[i] * scale + dv[i];
+        }
+      }
+    }
+    if (ref2 && (scale2 != 0)) {
+      ref2->mCorrection.getCorrections(slice, row, nBlock, u, v, dxRef, duRef, dvRef);
+      for (int i = 0; i < nBlock; i++) {
+        dx[i] = dxRef[i] * scale2 + dx[i];
+        du[i] = duRef[i] * scale2 + du[i];
+        dv[i] = dvRef[i] * scale2 + dv[i];
+      }
+    }
+    for (int i = 0; i < nBlock; i++) {
+      float& xi = x[iFirst + i];
+      float& yi = y[iFirst + i];
+      float& zi = z[iFirst + i];
+      xi = rowInfo.x;
+      xi += dx[i];
+      getGeometry().convUVtoLocal(slice, u[i] + du[i], v[i] + dv[i], yi, zi);
+      float dzTOF = 0;
+      getTOFcorrection(slice, row, xi, yi, zi, dzTOF);
+      zi += dzTOF;
+    }
+  }
+}
+
 GPUdi() void TPCFastTransform::TransformInTimeFrame(int slice, float time, float& z, float maxTimeBin) const
 {
   float v = 0;
@@ -0,0 +1,153 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file testTPCFastTransformRow.cxx
+/// \brief Test and benchmark of the transformation of the clusters of a full TPC row
+
+#define BOOST_TEST_MODULE Test TPC Fast Transformation of TPC rows
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+#include "TPCFastTransform.h"
+
+namespace o2::gpu
+{
+
+// TPC-like geometry and a random smooth correction with 8x20 knots
+std::unique_ptr<TPCFastTransform> createTransform(std::mt19937& gen)
+{
+  TPCFastTransformGeo geo;
+  const int nRows = 152;
+  geo.startConstruction(nRows);
+  geo.setTPCzLength(250.f, 250.f);
+  geo.setTPCalignmentZ(0.f);
+  for (int row = 0; row < nRows; row++) {
+    const bool inner = row < 63;
+    const float x = inner ? 85.2f + 0.75f * row : 106.f + 1.1f * (row - 63);
+    const int nPads = 66 + row * 50 / nRows * 2;
+    geo.setTPCrow(row, x, nPads, inner ? 0.416f : 0.6f);
+  }
+  geo.finishConstruction();
+
+  TPCFastSpaceChargeCorrection correction;
+  correction.startConstruction(geo, 1);
+  TPCFastSpaceChargeCorrection::SplineType spline;
+  spline.recreate(8, 20);
+  correction.setSplineScenario(0, spline);
+  for (int row = 0; row < nRows; row++) {
+    correction.setRowScenarioID(row, 0);
+  }
+  correction.finishConstruction();
+
+  auto transform = std::make_unique<TPCFastTransform>();
+  transform->startConstruction(correction);
+  transform->setApplyCorrectionOn();
+  transform->setCalibration(0, 0.f, 0.516f, 0.f, 0.f, 0.f, 0.f);
+  transform->finishConstruction();
+
+  std::uniform_real_distribution<float> uni(-1.f, 1.f);
+  auto& corr = transform->getCorrection();
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < nRows; row++) {
+      float* data = corr.getSplineData(slice, row);
+      for (int i = 0; i < corr.getSpline(slice, row).getNumberOfParameters(); i++) {
+        data[i] = uni(gen);
+      }
+    }
+  }
+  return transform;
+}
+
+BOOST_AUTO_TEST_CASE(TPCFastTransform_TransformRow)
+{
+  std::mt19937 gen(42);
+  auto transform = createTransform(gen);
+  auto ref = createTransform(gen);
+  const auto& geo = transform->getGeometry();
+
+  const int nClustersPerRow = 200;
+  std::vector<float> pad(nClustersPerRow), time(nClustersPerRow), x(nClustersPerRow), y(nClustersPerRow), z(nClustersPerRow), xs(nClustersPerRow), ys(nClustersPerRow), zs(nClustersPerRow);
+  std::uniform_real_distribution<float> uni(0.f, 1.f);
+
+  struct Mode {
+    const TPCFastTransform* ref;
+    float scale;
+    int scaleMode;
+  };
+  for (const auto& mode : {Mode{nullptr, 0.f, 0}, Mode{ref.get(), 0.7f, 0}, Mode{ref.get(), 0.3f, 1}}) {
+    int nDiff = 0;
+    double timeScalar = 0., timeRow = 0.;
+    for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+      for (int row = 0; row < geo.getNumberOfRows(); row++) {
+        const int maxPad = geo.getRowInfo(row).maxPad;
+        for (int i = 0; i < nClustersPerRow; i++) {
+          pad[i] = uni(gen) * maxPad;
+          time[i] = uni(gen) * 480.f;
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        transform->TransformRow(slice, row, nClustersPerRow, pad.data(), time.data(), x.data(), y.data(), z.data(), 0.f, mode.ref, nullptr, mode.scale, 0.f, mode.scaleMode);
+        auto stop = std::chrono::high_resolution_clock::now();
+        timeRow += std::chrono::duration<double>(stop - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < nClustersPerRow; i++) {
+          transform->Transform(slice, row, pad[i], time[i], xs[i], ys[i], zs[i], 0.f, mode.ref, nullptr, mode.scale, 0.f, mode.scaleMode);
+        }
+        stop = std::chrono::high_resolution_clock::now();
+        timeScalar += std::chrono::duration<double>(stop - start).count();
+
+        for (int i = 0; i < nClustersPerRow; i++) {
+          nDiff += (xs[i] != x[i]) || (ys[i] != y[i]) || (zs[i] != z[i]);
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(nDiff, 0);
+    BOOST_TEST_MESSAGE("scale mode " << mode.scaleMode << " with" << (mode.ref ? "" : "out") << " reference: Transform() " << timeScalar << " s, TransformRow() " << timeRow << " s");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TPCFastTransform_FlatImage)
+{
+  std::mt19937 gen(42);
+  auto transform = createTransform(gen);
+  const auto& geo = transform->getGeometry();
+
+  std::vector<char> image(FlatObject::getFlatImageSize(*transform));
+  FlatObject::writeToFlatImage(*transform, image.data());
+  BOOST_CHECK(FlatObject::isFlatImage<TPCFastTransform>(image.data(), image.size()));
+  BOOST_CHECK(!FlatObject::isFlatImage<TPCFastTransform>(image.data(), image.size() - 1));
+  std::unique_ptr<TPCFastTransform> copy(FlatObject::readFromFlatImage<TPCFastTransform>(image.data(), image.size()));
+  BOOST_REQUIRE(copy);
+  BOOST_CHECK(copy->isBufferInternal());
+  auto* mapped = FlatObject::mapFlatImage<TPCFastTransform>(image.data(), image.size());
+  BOOST_REQUIRE(mapped);
+
+  std::uniform_real_distribution<float> uni(0.f, 1.f);
+  int nDiff = 0;
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < geo.getNumberOfRows(); row += 10) {
+      const float pad = uni(gen) * geo.getRowInfo(row).maxPad, time = uni(gen) * 480.f;
+      float x, y, z, xc, yc, zc, xm, ym, zm;
+      transform->Transform(slice, row, pad, time, x, y, z);
+      copy->Transform(slice, row, pad, time, xc, yc, zc);
+      mapped->Transform(slice, row, pad, time, xm, ym, zm);
+      nDiff += (x != xc) || (y != yc) || (z != zc) || (x != xm) || (y != ym) || (z != zm);
+    }
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+}
+
+} // namespace o2::gpu
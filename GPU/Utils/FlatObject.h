@@ -296,6 +296,39 @@ class FlatObject
 
 #if !defined(GPUCA_GPUCODE) // code invisible on GPU
 
+  /// Header of a flat image: the class part and the flat buffer of a child class object in one contiguous block.
+  /// The image can be stored as a binary blob (e.g. in the CCDB) and used without ROOT streaming,
+  /// but only by the same build, therefore the size of the class is stored for a consistency check.
+  struct FlatImageHeader {
+    unsigned long long magic = 0;        ///< identifier of the flat images
+    unsigned long long classSize = 0;    ///< size of the class part
+    unsigned long long classOffset = 0;  ///< offset of the class part in the image
+    unsigned long long bufferOffset = 0; ///< offset of the flat buffer in the image
+    unsigned long long bufferSize = 0;   ///< size of the flat buffer
+  };
+  static constexpr unsigned long long FlatImageMagic = 0x31474d4954414c46ULL; ///< "FLATIMG1"
+
+  /// size of the flat image of a child class object
+  template <class T>
+  static size_t getFlatImageSize(const T& obj);
+
+  /// write the flat image of a child class object to the image buffer of getFlatImageSize() bytes
+  template <class T>
+  static void writeToFlatImage(const T& obj, char* image);
+
+  /// check if the memory holds a flat image of the child class T
+  template <class T>
+  static bool isFlatImage(const char* image, size_t size);
+
+  /// create a child class object from the flat image, the flat buffer is copied to the internal container
+  template <class T>
+  static T* readFromFlatImage(const char* image, size_t size);
+
+  /// use the child class object of the flat image in place, no copy is done.
+  /// The image is modified by the relocation and must outlive the returned object, which must not be deleted.
+  template <class T>
+  static T* mapFlatImage(char* image, size_t size);
+
   /// Test the flat object functionality for a child class T
   template <class T>
   static std::string stressTest(T& obj);
@@ -473,6 +506,83 @@ inline void FlatObject::printC() const
 
 #endif // GPUCA_GPUCODE
 
+#if !defined(GPUCA_GPUCODE) // code invisible on GPU
+
+template <class T>
+inline size_t FlatObject::getFlatImageSize(const T& obj)
+{
+  size_t classOffset = alignSize(sizeof(FlatImageHeader), getClassAlignmentBytes());
+  return alignSize(classOffset + sizeof(T), getBufferAlignmentBytes()) + obj.getFlatBufferSize();
+}
+
+template <class T>
+inline void FlatObject::writeToFlatImage(const T& obj, char* image)
+{
+  assert(obj.isConstructed());
+  FlatImageHeader header;
+  header.magic = FlatImageMagic;
+  header.classSize = sizeof(T);
+  header.classOffset = alignSize(sizeof(FlatImageHeader), getClassAlignmentBytes());
+  header.bufferOffset = alignSize(header.classOffset + sizeof(T), getBufferAlignmentBytes());
+  header.bufferSize = obj.getFlatBufferSize();
+  std::memcpy(image, &header, sizeof(FlatImageHeader));
+  // clone with the flat buffer in the image, the pointers get relocated when the image is used
+  T tmp;
+  tmp.cloneFromObject(obj, image + header.bufferOffset);
+  std::memcpy(image + header.classOffset, (const void*)&tmp, sizeof(T));
+}
+
+template <class T>
+inline bool FlatObject::isFlatImage(const char* image, size_t size)
+{
+  if (!image || size < sizeof(FlatImageHeader)) {
+    return false;
+  }
+  FlatImageHeader header;
+  std::memcpy(&header, image, sizeof(FlatImageHeader));
+  return header.magic == FlatImageMagic && header.classSize == sizeof(T) && header.classOffset + header.classSize <= header.bufferOffset && header.bufferOffset + header.bufferSize <= size;
+}
+
+template <class T>
+inline T* FlatObject::readFromFlatImage(const char* image, size_t size)
+{
+  if (!isFlatImage<T>(image, size)) {
+    LOG(error) << "Memory does not contain a flat image of the requested class";
+    return nullptr;
+  }
+  FlatImageHeader header;
+  std::memcpy(&header, image, sizeof(FlatImageHeader));
+  T* obj = new T;
+  // bit-wise port of the object and its buffer, followed by the relocation of the pointers
+  char* buffer = new char[header.bufferSize];
+  std::memcpy(buffer, image + header.bufferOffset, header.bufferSize);
+  std::memcpy((void*)obj, image + header.classOffset, sizeof(T));
+  obj->mFlatBufferContainer = nullptr;
+  obj->setActualBufferAddress(buffer);
+  obj->adoptInternalBuffer(buffer);
+  return obj;
+}
+
+template <class T>
+inline T* FlatObject::mapFlatImage(char* image, size_t size)
+{
+  if (!isFlatImage<T>(image, size)) {
+    LOG(error) << "Memory does not contain a flat image of the requested class";
+    return nullptr;
+  }
+  FlatImageHeader header;
+  std::memcpy(&header, image, sizeof(FlatImageHeader));
+  if (reinterpret_cast<size_t>(image + header.classOffset) % getClassAlignmentBytes()) {
+    LOG(error) << "Flat image is not aligned to " << getClassAlignmentBytes() << " bytes";
+    return nullptr;
+  }
+  T* obj = reinterpret_cast<T*>(image + header.classOffset);
+  obj->setActualBufferAddress(image + header.bufferOffset);
+  return obj;
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) // code invisible on GPU
 template <class T, class TFile>
 inline int FlatObject::writeToFile(T& obj, TFile& outf, const char* name)
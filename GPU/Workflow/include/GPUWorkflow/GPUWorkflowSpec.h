@@ -34,6 +34,7 @@ class TStopwatch;
 namespace fair::mq
 {
 struct RegionInfo;
+class UnmanagedRegion;
 enum class State : int;
 } // namespace fair::mq
 namespace o2
@@ -176,6 +177,9 @@ class GPURecoWorkflowSpec : public o2::framework::Task
 
   int runMain(o2::framework::ProcessingContext* pc, GPUTrackingInOutPointers* ptrs, GPUInterfaceOutputs* outputRegions, int threadIndex = 0, GPUInterfaceInputUpdate* inputUpdateCallback = nullptr);
   int runITSTracking(o2::framework::ProcessingContext& pc);
+  void sendKernelProfile(o2::framework::ProcessingContext& pc, int threadIndex);
+  void initMemoryMetrics();
+  void sendMemoryMetrics(o2::framework::ProcessingContext& pc);
 
   int handlePipeline(o2::framework::ProcessingContext& pc, GPUTrackingInOutPointers& ptrs, gpurecoworkflow_internals::GPURecoWorkflowSpec_TPCZSBuffers& tpcZSmeta, o2::gpu::GPUTrackingInOutZS& tpcZS, std::unique_ptr<gpurecoworkflow_internals::GPURecoWorkflow_QueueObject>& context);
   void RunReceiveThread();
@@ -190,6 +194,11 @@ class GPURecoWorkflowSpec : public o2::framework::Task
 
   CompletionPolicyData* mPolicyData;
   std::function<bool(o2::framework::DataProcessingHeader::StartTime)> mPolicyOrder;
+  std::unique_ptr<fair::mq::UnmanagedRegion> mHostMemoryRegion; // shm region providing the page locked host memory pool of the GPU, must outlive mGPUReco
+  int mTLBMissesFd = -1;                                         // perf event counting the data TLB misses of the process, -1 if not available
+  long mLastMinorFaults = 0;
+  long mLastMajorFaults = 0;
+  unsigned long mLastTLBMisses = 0;
   std::unique_ptr<GPUO2Interface> mGPUReco;
   std::unique_ptr<GPUDisplayFrontendInterface> mDisplayFrontend;
 
@@ -20,6 +20,7 @@
 #include <thread>
 #include <condition_variable>
 #include <queue>
+#include <deque>
 #include <array>
 #include <fairmq/States.h>
 
@@ -78,7 +79,7 @@ struct GPURecoWorkflowSpec_PipelineInternals {
     std::mutex inputQueueMutex;
     std::condition_variable inputQueueNotify;
   };
-  std::array<pipelineWorkerStruct, 2> workers;
+  std::deque<pipelineWorkerStruct> workers; // One per processing context of the GPUO2Interface
 
   std::queue<std::unique_ptr<GPURecoWorkflow_QueueObject>> pipelineQueue;
   std::mutex queueMutex;
@@ -73,6 +73,9 @@ void GPURecoWorkflowSpec::initPipeline(o2::framework::InitContext& ic)
       return false;
     };
     mPipeline->receiveThread = std::thread([this]() { RunReceiveThread(); });
+    while (mPipeline->workers.size() < mGPUReco->getNContexts()) {
+      mPipeline->workers.emplace_back();
+    }
     for (unsigned int i = 0; i < mPipeline->workers.size(); i++) {
       mPipeline->workers[i].thread = std::thread([this, i]() { RunWorkerThread(i); });
     }
@@ -134,7 +137,7 @@ void GPURecoWorkflowSpec::enqueuePipelinedJob(GPUTrackingInOutPointers* ptrs, GP
     mPipeline->mayInjectCondition.notify_one();
   };
 
-  mNextThreadIndex = (mNextThreadIndex + 1) % 2;
+  mNextThreadIndex = (mNextThreadIndex + 1) % mPipeline->workers.size();
 
   {
     std::lock_guard lk(mPipeline->workers[mNextThreadIndex].inputQueueMutex);
@@ -28,6 +28,7 @@
 #include "Framework/CallbackService.h"
 #include "Framework/CCDBParamSpec.h"
 #include "Framework/RawDeviceService.h"
+#include "Framework/Monitoring.h"
 #include "DataFormatsTPC/TPCSectorHeader.h"
 #include "DataFormatsTPC/ClusterNative.h"
 #include "DataFormatsTPC/CompressedClusters.h"
@@ -53,6 +54,7 @@
 #include "GPUO2InterfaceQA.h"
 #include "GPUO2Interface.h"
 #include "GPUO2InterfaceUtils.h"
+#include "GPUReconstruction.h"
 #include "CalibdEdxContainer.h"
 #include "GPUNewCalibValues.h"
 #include "TPCPadGainCalib.h"
@@ -80,6 +82,10 @@
 #include "GPUWorkflowInternal.h"
 // #include "Framework/ThreadPool.h"
 
+#include <fairmq/Device.h>
+#include <fairmq/TransportFactory.h>
+#include <fairmq/UnmanagedRegion.h>
+
 #include <TStopwatch.h>
 #include <TObjArray.h>
 #include <TH1F.h>
@@ -96,7 +102,14 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 #include <chrono>
+#include <future>
 #include <unordered_set>
 
 using namespace o2::framework;
@@ -126,7 +139,12 @@ GPURecoWorkflowSpec::GPURecoWorkflowSpec(GPURecoWorkflowSpec::CompletionPolicyDa
   }
 }
 
-GPURecoWorkflowSpec::~GPURecoWorkflowSpec() = default;
+GPURecoWorkflowSpec::~GPURecoWorkflowSpec()
+{
+  if (mTLBMissesFd != -1) {
+    close(mTLBMissesFd);
+  }
+}
 
 void GPURecoWorkflowSpec::init(InitContext& ic)
 {
@@ -161,7 +179,7 @@ void GPURecoWorkflowSpec::init(InitContext& ic)
   if (mConfig->configProcessing.deviceNum == -2) {
     int myId = ic.services().get<const o2::framework::DeviceSpec>().inputTimesliceId;
     int idMax = ic.services().get<const o2::framework::DeviceSpec>().maxInputTimeslices;
-    mConfig->configProcessing.deviceNum = myId;
+    mConfig->configProcessing.deviceNum = myId * std::max(mConfig->configProcessing.nDevices, 1);
     LOG(info) << "GPU device number selected from pipeline id: " << myId << " / " << idMax;
   }
   if (mConfig->configProcessing.debugLevel >= 3 && mVerbosity == 0) {
@@ -242,6 +260,14 @@ void GPURecoWorkflowSpec::init(InitContext& ic)
   if (config.configProcessing.doublePipeline && (mSpecConfig.readTRDtracklets || mSpecConfig.runITSTracking || !(mSpecConfig.zsOnTheFly || mSpecConfig.zsDecoder))) {
     LOG(fatal) << "GPU two-threaded pipeline works only with TPC-only processing, and with ZS input";
   }
+  if (mSpecConfig.runITSTracking && mConfParam->runITSConcurrently) {
+    if (mConfParam->allocateOutputOnTheFly) {
+      LOG(fatal) << "Concurrent ITS reconstruction requires preallocated TPC output buffers (allocateOutputOnTheFly = false)";
+    }
+    if (config.configDeviceBackend.deviceType != GPUDataTypes::DeviceType::CPU && config.configProcessing.unmanagedMemoryReserve == 0) {
+      LOG(fatal) << "Concurrent ITS reconstruction on the GPU requires a reserved unmanaged memory budget (unmanagedMemoryReserve)";
+    }
+  }
 
   if (mSpecConfig.enableDoublePipeline != 2) {
     mGPUReco = std::make_unique<GPUO2Interface>();
@@ -278,6 +304,35 @@ void GPURecoWorkflowSpec::init(InitContext& ic)
       mConfig->PrintParam();
     }
 
+    if (mConfParam->hostMemoryRegionId != -1) {
+      // The region is created and locked once per node, each process of the node takes its host memory pool from a different part of it
+      size_t poolSize = mConfig->configProcessing.forceHostMemoryPoolSize;
+      if (config.configDeviceBackend.deviceType == GPUDataTypes::DeviceType::CPU || poolSize == 0) {
+        LOG(fatal) << "Taking the host memory pool from a shm region requires a GPU backend and the host memory pool size (hostMemSize)";
+      }
+      size_t offset = mConfParam->hostMemoryRegionOffset + ic.services().get<const o2::framework::DeviceSpec>().inputTimesliceId * poolSize;
+      fair::mq::RegionConfig cfg;
+      cfg.id = mConfParam->hostMemoryRegionId;
+      cfg.size = offset + poolSize;
+      cfg.path = mConfParam->hostMemoryRegionHugePagePath;
+      cfg.zero = mConfParam->hostMemoryRegionPrefault;
+      mHostMemoryRegion = ic.services().get<RawDeviceService>().device()->Transport()->CreateUnmanagedRegion(offset + poolSize, [](const std::vector<fair::mq::RegionBlock>&) {}, cfg);
+      if (!mHostMemoryRegion || mHostMemoryRegion->GetSize() < offset + poolSize) {
+        LOG(fatal) << "Could not get " << offset + poolSize << " bytes of shm region " << mConfParam->hostMemoryRegionId << " for the GPU host memory pool";
+      }
+      if (mConfParam->hostMemoryRegionPrefault) {
+        // The region may have been created by another process, so only read: this maps all pages of our pool without touching the data of others
+        const volatile char* pool = (const char*)mHostMemoryRegion->GetData() + offset;
+        for (size_t i = 0; i < poolSize; i += 4096) {
+          (void)pool[i];
+        }
+        LOG(info) << "Pre-faulted " << poolSize << " bytes of the GPU host memory pool" << (mConfParam->hostMemoryRegionHugePagePath.empty() ? "" : " (huge pages)");
+      }
+      config.configDeviceBackend.externalHostMemoryPool = (char*)mHostMemoryRegion->GetData() + offset;
+      config.configDeviceBackend.externalHostMemoryPoolSize = poolSize;
+      LOG(info) << "Using " << poolSize << " bytes at offset " << offset << " of shm region " << mConfParam->hostMemoryRegionId << " as GPU host memory pool";
+    }
+
     // Configuration is prepared, initialize the tracker.
     if (mGPUReco->Initialize(config) != 0) {
       throw std::invalid_argument("GPU Reconstruction initialization failed");
@@ -293,6 +348,10 @@ void GPURecoWorkflowSpec::init(InitContext& ic)
     if (mSpecConfig.runITSTracking) {
       initFunctionITS(ic);
     }
+
+    if (mConfParam->memoryMetrics) {
+      initMemoryMetrics();
+    }
   }
 
   if (mSpecConfig.enableDoublePipeline) {
@@ -316,6 +375,9 @@ void GPURecoWorkflowSpec::init(InitContext& ic)
     if (mConfParam->registerSelectedSegmentIds != -1 && info.managed && info.id != (unsigned int)mConfParam->registerSelectedSegmentIds) {
       return;
     }
+    if (mConfParam->hostMemoryRegionId != -1 && !info.managed && info.id == (unsigned int)mConfParam->hostMemoryRegionId) {
+      return; // The part used as host memory pool is already registered by the GPU backend
+    }
     int fd = 0;
     if (mConfParam->mutexMemReg) {
       mode_t mask = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
@@ -498,9 +560,18 @@ int GPURecoWorkflowSpec::runMain(o2::framework::ProcessingContext* pc, GPUTracki
 {
   int retVal = 0;
   if (mConfParam->dump < 2) {
+    std::future<int> retValITS;
+    if (mSpecConfig.runITSTracking && mConfParam->runITSConcurrently) { // ITS runs on its own streams and reserved memory, and creates its outputs while TPC only fills preallocated buffers
+      retValITS = std::async(std::launch::async, [this, pc]() { return runITSTracking(*pc); });
+    }
     retVal = mGPUReco->RunTracking(ptrs, outputRegions, threadIndex, inputUpdateCallback);
 
-    if (retVal == 0 && mSpecConfig.runITSTracking) {
+    if (retValITS.valid()) {
+      int tmp = retValITS.get();
+      if (retVal == 0) {
+        retVal = tmp;
+      }
+    } else if (retVal == 0 && mSpecConfig.runITSTracking) {
       retVal = runITSTracking(*pc);
     }
   }
@@ -511,6 +582,68 @@ int GPURecoWorkflowSpec::runMain(o2::framework::ProcessingContext* pc, GPUTracki
   return retVal;
 }
 
+void GPURecoWorkflowSpec::sendKernelProfile(ProcessingContext& pc, int threadIndex)
+{
+  const GPUKernelProfile& profile = mGPUReco->getKernelProfile(threadIndex);
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  auto send = [&monitoring](auto value, const std::string& name) {
+    monitoring.send(o2::monitoring::Metric{value, name}.addTag(o2::monitoring::tags::Key::Subsystem, o2::monitoring::tags::Value::DPL));
+  };
+  double totalTime = 0.;
+  for (const auto& k : profile.kernels) {
+    send(k.time * 1e6, "gpu_kernel_time_us_" + k.name);
+    send((uint64_t)k.count, "gpu_kernel_count_" + k.name);
+    send(k.occupancy, "gpu_kernel_occupancy_" + k.name);
+    totalTime += k.time;
+  }
+  send(totalTime * 1e6, "gpu_kernel_time_us");
+  send((uint64_t)profile.bytesToGPU, "gpu_bytes_to_gpu");
+  send((uint64_t)profile.bytesToHost, "gpu_bytes_to_host");
+  if (profile.nDropped) {
+    send((uint64_t)profile.nDropped, "gpu_kernel_profile_dropped");
+  }
+}
+
+void GPURecoWorkflowSpec::initMemoryMetrics()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  mLastMinorFaults = usage.ru_minflt;
+  mLastMajorFaults = usage.ru_majflt;
+#ifdef __linux__
+  perf_event_attr attr{};
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.inherit = 1; // count the threads started later as well
+  mTLBMissesFd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  if (mTLBMissesFd == -1) {
+    LOG(info) << "Data TLB misses not available (no hardware perf events or insufficient perf_event_paranoid level), sending only page faults";
+  }
+}
+
+void GPURecoWorkflowSpec::sendMemoryMetrics(ProcessingContext& pc)
+{
+  auto& monitoring = pc.services().get<o2::monitoring::Monitoring>();
+  auto send = [&monitoring](auto value, const std::string& name) {
+    monitoring.send(o2::monitoring::Metric{value, name}.addTag(o2::monitoring::tags::Key::Subsystem, o2::monitoring::tags::Value::DPL));
+  };
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  send((uint64_t)(usage.ru_minflt - mLastMinorFaults), "gpu_page_faults_minor");
+  send((uint64_t)(usage.ru_majflt - mLastMajorFaults), "gpu_page_faults_major");
+  mLastMinorFaults = usage.ru_minflt;
+  mLastMajorFaults = usage.ru_majflt;
+  unsigned long tlbMisses = 0;
+  if (mTLBMissesFd != -1 && read(mTLBMissesFd, &tlbMisses, sizeof(tlbMisses)) == sizeof(tlbMisses)) {
+    send((uint64_t)(tlbMisses - mLastTLBMisses), "gpu_dtlb_misses");
+    mLastTLBMisses = tlbMisses;
+  }
+}
+
 void GPURecoWorkflowSpec::cleanOldCalibsTPCPtrs(calibObjectStruct& oldCalibObjects)
 {
   if (mOldCalibObjects.size() > 0) {
@@ -793,11 +926,17 @@ void GPURecoWorkflowSpec::run(ProcessingContext& pc)
   } else {
     // unsigned int threadIndex = pc.services().get<ThreadPool>().threadIndex;
     unsigned int threadIndex = mNextThreadIndex;
-    if (mConfig->configProcessing.doublePipeline) {
-      mNextThreadIndex = (mNextThreadIndex + 1) % 2;
+    if (mGPUReco->getNContexts() > 1) {
+      mNextThreadIndex = (mNextThreadIndex + 1) % mGPUReco->getNContexts();
     }
 
     retVal = runMain(&pc, &ptrs, &outputRegions, threadIndex);
+    if (mConfig->configProcessing.kernelProfiling) {
+      sendKernelProfile(pc, threadIndex);
+    }
+  }
+  if (mConfParam->memoryMetrics) {
+    sendMemoryMetrics(pc);
   }
   if (retVal != 0) {
     debugTFDump = true;
@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_EVENTGEN_EVENTPREFETCHER_H_
+#define ALICEO2_EVENTGEN_EVENTPREFETCHER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace o2
+{
+namespace eventgen
+{
+
+/// Reads events ahead of their use, in a background thread, into a bounded queue.
+/// Used by the generators reading pre-generated events, such that the parsing of
+/// the input overlaps with the transport of the previous events.
+/// The input is read in order by a single thread, the reader function is only
+/// called from that thread.
+template <typename T>
+class EventPrefetcher
+{
+ public:
+  /// reader fills the event and returns false at the end of the input
+  using Reader = std::function<bool(T&)>;
+
+  /// starts reading, keeping up to depth events in the queue
+  EventPrefetcher(Reader reader, size_t depth) : mReader(std::move(reader)), mDepth(depth > 0 ? depth : 1)
+  {
+    mThread = std::thread(&EventPrefetcher::run, this);
+  }
+  EventPrefetcher(const EventPrefetcher&) = delete;
+  EventPrefetcher& operator=(const EventPrefetcher&) = delete;
+  ~EventPrefetcher() { stop(); }
+
+  /// takes the next event, waiting for it if needed. Returns false at the end of the input,
+  /// an exception thrown by the reader is rethrown here
+  bool pop(T& event)
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this] { return !mQueue.empty() || mDone; });
+    if (mQueue.empty()) {
+      if (mError) {
+        std::rethrow_exception(mError);
+      }
+      return false;
+    }
+    event = std::move(mQueue.front());
+    mQueue.pop_front();
+    mCondition.notify_all();
+    return true;
+  }
+
+  /// stops reading ahead. Note that a reader blocked on its input (e.g. a FIFO) is waited for
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+ private:
+  void run()
+  {
+    while (true) {
+      T event{};
+      bool read = false;
+      std::exception_ptr error;
+      try {
+        read = mReader(event);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::unique_lock<std::mutex> lock(mMutex);
+      if (!read) {
+        mError = error;
+        mDone = true;
+        mCondition.notify_all();
+        return;
+      }
+      mCondition.wait(lock, [this] { return mQueue.size() < mDepth || mStop; });
+      if (mStop) {
+        return;
+      }
+      mQueue.push_back(std::move(event));
+      mCondition.notify_all();
+    }
+  }
+
+  Reader mReader;
+  size_t mDepth;
+  std::deque<T> mQueue;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::exception_ptr mError; // exception thrown by the reader, if any
+  bool mDone = false;        // reader reached the end of the input
+  bool mStop = false;
+  std::thread mThread;
+};
+
+} // namespace eventgen
+} // namespace o2
+
+#endif // ALICEO2_EVENTGEN_EVENTPREFETCHER_H_
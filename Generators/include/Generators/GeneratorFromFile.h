@@ -16,6 +16,7 @@
 
 #include "FairGenerator.h"
 #include "Generators/Generator.h"
+#include "Generators/EventPrefetcher.h"
 
 class TBranch;
 class TFile;
@@ -65,8 +66,9 @@ class GeneratorFromFile : public FairGenerator
 class GeneratorFromO2Kine : public o2::eventgen::Generator
 {
  public:
-  GeneratorFromO2Kine() = default;
+  GeneratorFromO2Kine();
   GeneratorFromO2Kine(const char* name);
+  ~GeneratorFromO2Kine() override;
 
   bool Init() override;
 
@@ -86,6 +88,10 @@ class GeneratorFromO2Kine : public o2::eventgen::Generator
   /** methods that can be overridden **/
   void updateHeader(o2::dataformats::MCEventHeader* eventHeader) override;
 
+  struct PrefetchedEvent; // event read from the file, before it is put on the stack
+  // read the entry of the file, called from the prefetching thread if GeneratorFromO2Kine.prefetch is set
+  void readEvent(int entry, PrefetchedEvent& event) const;
+
   TFile* mEventFile = nullptr;     //! the file containing the persistent events
   TBranch* mEventBranch = nullptr; //! the branch containing the persistent events
   TBranch* mMCHeaderBranch = nullptr; //! branch containing MC event headers
@@ -96,6 +102,8 @@ class GeneratorFromO2Kine : public o2::eventgen::Generator
   bool mRoundRobin = false;      //! whether we want to take events from file in a round robin fashion
 
   std::unique_ptr<o2::dataformats::MCEventHeader> mOrigMCEventHeader; //! the MC event header of the original file
+  unsigned int mPrefetch = 0;                                         //! number of events read ahead, 0 to read in importParticles
+  std::unique_ptr<EventPrefetcher<PrefetchedEvent>> mPrefetcher;      //! reads the events ahead, if mPrefetch is set
 
   ClassDefOverride(GeneratorFromO2Kine, 2);
 };
@@ -33,6 +33,7 @@ struct GeneratorFromO2KineParam : public o2::conf::ConfigurableParamHelper<Gener
   bool continueMode = false;
   bool roundRobin = false;   // read events with period boundary conditions
   std::string fileName = ""; // filename to read from - takes precedence over SimConfig if given
+  unsigned int prefetch = 0; // number of events read ahead in a background thread (0 = off)
   O2ParamDef(GeneratorFromO2KineParam, "GeneratorFromO2Kine");
 };
 
@@ -17,6 +17,8 @@
 #include "Generators/Generator.h"
 #include "Generators/GeneratorFileOrCmd.h"
 #include "Generators/GeneratorHepMCParam.h"
+#include "Generators/EventPrefetcher.h"
+#include <memory>
 
 #ifdef GENERATORS_WITH_HEPMC3_DEPRECATED
 namespace HepMC
@@ -101,6 +103,11 @@ class GeneratorHepMC : public Generator, public GeneratorFileOrCmd
   void updateHeader(o2::dataformats::MCEventHeader* eventHeader) override;
   /** Make our reader */
   bool makeReader();
+  /** Read the next event from the input into the passed event.
+   * Returns false at the end of the input, and flags a failure if
+   * the reading failed repeatedly.  Called from the prefetching
+   * thread if HepMC.prefetch is set. */
+  bool readEvent(HepMC3::GenEvent& event);
 
   /** Type of function to select particles to keep when pruning
    * events */
@@ -118,6 +125,12 @@ class GeneratorHepMC : public Generator, public GeneratorFileOrCmd
   HepMC3::GenEvent* mEvent = nullptr;
   /** Option whether to prune event */
   bool mPrune; //!
+  /** Number of events read ahead in a background thread, 0 to read in generateEvent */
+  unsigned int mPrefetch = 0; //!
+  /** Reads the events ahead, if mPrefetch is set */
+  std::unique_ptr<EventPrefetcher<std::unique_ptr<HepMC3::GenEvent>>> mPrefetcher; //!
+  /** Set if the reading of an event failed repeatedly */
+  bool mReadFailed = false; //!
 
   ClassDefOverride(GeneratorHepMC, 1);
 
@@ -51,6 +51,10 @@ struct GeneratorHepMCParam : public o2::conf::ConfigurableParamHelper<GeneratorH
    * event generator producing the event.  Use with caution, as it may
    * corrupt the event record. */
   bool prune = false;
+  /** Number of events to read ahead of their use, in a background
+   *  thread, such that the parsing of the input overlaps with the
+   *  transport.  0 disables the read ahead. */
+  unsigned int prefetch = 0;
   O2ParamDef(GeneratorHepMCParam, "HepMC");
 };
 
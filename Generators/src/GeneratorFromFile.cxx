@@ -20,7 +20,10 @@
 #include <TFile.h>
 #include <TMCProcess.h>
 #include <TParticle.h>
+#include <TROOT.h>
 #include <TTree.h>
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace o2
@@ -167,6 +170,20 @@ Bool_t GeneratorFromFile::ReadEvent(FairPrimaryGenerator* primGen)
 
 // based on O2 kinematics
 
+struct GeneratorFromO2Kine::PrefetchedEvent {
+  int entry = -1;                                          // entry of the event in the file
+  std::vector<TParticle> particles;                        // particles to put on the stack
+  std::unique_ptr<o2::dataformats::MCEventHeader> header; // original header, if any
+};
+
+GeneratorFromO2Kine::GeneratorFromO2Kine() = default;
+
+GeneratorFromO2Kine::~GeneratorFromO2Kine()
+{
+  // stop reading ahead before the file goes away
+  mPrefetcher.reset();
+}
+
 GeneratorFromO2Kine::GeneratorFromO2Kine(const char* name)
 {
   // this generator should leave all dimensions the same as in the incoming kinematics file
@@ -210,6 +227,7 @@ bool GeneratorFromO2Kine::Init()
   mSkipNonTrackable = param.skipNonTrackable;
   mContinueMode = param.continueMode;
   mRoundRobin = param.roundRobin;
+  mPrefetch = param.prefetch;
 
   return true;
 }
@@ -223,78 +241,111 @@ void GeneratorFromO2Kine::SetStartEvent(int start)
   }
 }
 
-bool GeneratorFromO2Kine::importParticles()
+void GeneratorFromO2Kine::readEvent(int entry, PrefetchedEvent& event) const
 {
-  // NOTE: This should be usable with kinematics files without secondaries
-  // It might need some adjustment to make it work with secondaries or to continue
-  // from a kinematics snapshot
-
-  if (mEventCounter < mEventsAvailable) {
-    int particlecounter = 0;
+  event.entry = entry;
+  event.particles.clear();
+
+  std::vector<o2::MCTrack>* tracks = nullptr;
+  mEventBranch->SetAddress(&tracks);
+  mEventBranch->GetEntry(entry);
+
+  if (mMCHeaderBranch) {
+    o2::dataformats::MCEventHeader* mcheader = nullptr;
+    mMCHeaderBranch->SetAddress(&mcheader);
+    mMCHeaderBranch->GetEntry(entry);
+    event.header.reset(mcheader);
+  }
 
-    std::vector<o2::MCTrack>* tracks = nullptr;
-    mEventBranch->SetAddress(&tracks);
-    mEventBranch->GetEntry(mEventCounter);
+  event.particles.reserve(tracks->size());
+  for (auto& t : *tracks) {
 
-    if (mMCHeaderBranch) {
-      o2::dataformats::MCEventHeader* mcheader = nullptr;
-      mMCHeaderBranch->SetAddress(&mcheader);
-      mMCHeaderBranch->GetEntry(mEventCounter);
-      mOrigMCEventHeader.reset(mcheader);
+    // in case we do not want to continue, take only primaries
+    if (!mContinueMode && !t.isPrimary()) {
+      continue;
     }
 
-    for (auto& t : *tracks) {
+    auto pdg = t.GetPdgCode();
+    auto px = t.Px();
+    auto py = t.Py();
+    auto pz = t.Pz();
+    auto vx = t.Vx();
+    auto vy = t.Vy();
+    auto vz = t.Vz();
+    auto m1 = t.getMotherTrackId();
+    auto m2 = t.getSecondMotherTrackId();
+    auto d1 = t.getFirstDaughterTrackId();
+    auto d2 = t.getLastDaughterTrackId();
+    auto e = t.GetEnergy();
+    auto vt = t.T() * 1e-9; // MCTrack stores in ns ... generators and engines use seconds
+    auto weight = t.getWeight();
+    auto wanttracking = t.getToBeDone();
+
+    if (mContinueMode) { // in case we want to continue, do only inhibited tracks
+      wanttracking &= t.getInhibited();
+    }
 
-      // in case we do not want to continue, take only primaries
-      if (!mContinueMode && !t.isPrimary()) {
-        continue;
-      }
+    LOG(debug) << "Putting primary " << pdg;
 
-      auto pdg = t.GetPdgCode();
-      auto px = t.Px();
-      auto py = t.Py();
-      auto pz = t.Pz();
-      auto vx = t.Vx();
-      auto vy = t.Vy();
-      auto vz = t.Vz();
-      auto m1 = t.getMotherTrackId();
-      auto m2 = t.getSecondMotherTrackId();
-      auto d1 = t.getFirstDaughterTrackId();
-      auto d2 = t.getLastDaughterTrackId();
-      auto e = t.GetEnergy();
-      auto vt = t.T() * 1e-9; // MCTrack stores in ns ... generators and engines use seconds
-      auto weight = t.getWeight();
-      auto wanttracking = t.getToBeDone();
-
-      if (mContinueMode) { // in case we want to continue, do only inhibited tracks
-        wanttracking &= t.getInhibited();
-      }
+    event.particles.push_back(TParticle(pdg, t.getStatusCode().fullEncoding, m1, m2, d1, d2, px, py, pz, e, vx, vy, vz, vt));
+    event.particles.back().SetUniqueID((unsigned int)t.getProcess()); // we should propagate the process ID
+    event.particles.back().SetBit(ParticleStatus::kToBeDone, wanttracking);
+    event.particles.back().SetWeight(weight);
+  }
 
-      LOG(debug) << "Putting primary " << pdg;
+  if (tracks) {
+    delete tracks;
+  }
+}
 
-      mParticles.push_back(TParticle(pdg, t.getStatusCode().fullEncoding, m1, m2, d1, d2, px, py, pz, e, vx, vy, vz, vt));
-      mParticles.back().SetUniqueID((unsigned int)t.getProcess()); // we should propagate the process ID
-      mParticles.back().SetBit(ParticleStatus::kToBeDone, wanttracking);
-      mParticles.back().SetWeight(weight);
+bool GeneratorFromO2Kine::importParticles()
+{
+  // NOTE: This should be usable with kinematics files without secondaries
+  // It might need some adjustment to make it work with secondaries or to continue
+  // from a kinematics snapshot
 
-      particlecounter++;
+  PrefetchedEvent event;
+  if (mPrefetch > 0) {
+    if (!mPrefetcher) {
+      // the entries are read from the prefetching thread, which owns the branches from now on
+      ROOT::EnableThreadSafety();
+      LOG(info) << "Reading up to " << mPrefetch << " events ahead";
+      mPrefetcher = std::make_unique<EventPrefetcher<PrefetchedEvent>>(
+        [this, next = mEventCounter](PrefetchedEvent& ev) mutable {
+          if (next >= mEventsAvailable) {
+            return false;
+          }
+          readEvent(next++, ev);
+          if (mRoundRobin) {
+            next = next % mEventsAvailable;
+          }
+          return true;
+        },
+        mPrefetch);
     }
-    mEventCounter++;
-    if (mRoundRobin) {
-      LOG(info) << "Resetting event counter to 0; Reusing events from file";
-      mEventCounter = mEventCounter % mEventsAvailable;
-    }
-
-    if (tracks) {
-      delete tracks;
+    if (!mPrefetcher->pop(event)) {
+      LOG(error) << "GeneratorFromO2Kine: Ran out of events\n";
+      return false;
     }
-
-    LOG(info) << "Event generator put " << particlecounter << " on stack";
-    return true;
+  } else if (mEventCounter < mEventsAvailable) {
+    readEvent(mEventCounter, event);
   } else {
     LOG(error) << "GeneratorFromO2Kine: Ran out of events\n";
+    return false;
   }
-  return false;
+
+  mOrigMCEventHeader = std::move(event.header);
+  auto particlecounter = event.particles.size();
+  std::move(event.particles.begin(), event.particles.end(), std::back_inserter(mParticles));
+
+  mEventCounter = event.entry + 1;
+  if (mRoundRobin) {
+    LOG(info) << "Resetting event counter to 0; Reusing events from file";
+    mEventCounter = mEventCounter % mEventsAvailable;
+  }
+
+  LOG(info) << "Event generator put " << particlecounter << " on stack";
+  return true;
 }
 
 void GeneratorFromO2Kine::updateHeader(o2::dataformats::MCEventHeader* eventHeader)
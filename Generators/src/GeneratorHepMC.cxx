@@ -23,6 +23,7 @@
 #include "HepMC3/FourVector.h"
 #include "HepMC3/Version.h"
 #include "TParticle.h"
+#include "TROOT.h"
 
 #include <fairlogger/Logger.h>
 #include "FairPrimaryGenerator.h"
@@ -59,6 +60,8 @@ GeneratorHepMC::~GeneratorHepMC()
 {
   /** default destructor **/
   LOG(info) << "Destructing GeneratorHepMC";
+  // stop reading ahead before closing the reader used by the prefetcher
+  mPrefetcher.reset();
   if (mReader) {
     mReader->close();
   }
@@ -85,6 +88,7 @@ void GeneratorHepMC::setup(const GeneratorFileOrCmdParam& param0,
 
   mVersion = param.version;
   mPrune = param.prune;
+  mPrefetch = param.prefetch;
   setEventsToSkip(param.eventsToSkip);
 
   // we are skipping ahead in the HepMC stream now
@@ -104,6 +108,38 @@ Bool_t GeneratorHepMC::generateEvent()
 {
   LOG(debug) << "Generating an event";
   /** generate event **/
+  bool ret = false;
+  if (mPrefetch > 0) {
+    if (not mPrefetcher) {
+      // the readers of ROOT files use ROOT I/O from the prefetching thread
+      ROOT::EnableThreadSafety();
+      LOG(info) << "Reading up to " << mPrefetch << " HepMC events ahead";
+      mPrefetcher = std::make_unique<EventPrefetcher<std::unique_ptr<HepMC3::GenEvent>>>(
+        [this](std::unique_ptr<HepMC3::GenEvent>& event) {
+          event = std::make_unique<HepMC3::GenEvent>();
+          return readEvent(*event);
+        },
+        mPrefetch);
+    }
+    std::unique_ptr<HepMC3::GenEvent> event;
+    ret = mPrefetcher->pop(event);
+    if (ret) {
+      delete mEvent;
+      mEvent = event.release();
+      mInterface = reinterpret_cast<void*>(mEvent);
+    }
+  } else {
+    ret = readEvent(*mEvent);
+  }
+  if (not ret and mReadFailed) {
+    LOG(fatal) << "HepMC event gen failed (Does the file/stream have enough events)?";
+  }
+  return ret;
+}
+
+/*****************************************************************/
+bool GeneratorHepMC::readEvent(HepMC3::GenEvent& event)
+{
   int tries = 0;
   constexpr int max_tries = 3;
   do {
@@ -113,12 +149,12 @@ Bool_t GeneratorHepMC::generateEvent()
     }
 
     /** clear and read event **/
-    mEvent->clear();
-    mReader->read_event(*mEvent);
+    event.clear();
+    mReader->read_event(event);
     if (not mReader->failed()) {
       /** set units to desired output **/
-      mEvent->set_units(HepMC3::Units::GEV, HepMC3::Units::MM);
-      LOG(debug) << "Read one event " << mEvent->event_number();
+      event.set_units(HepMC3::Units::GEV, HepMC3::Units::MM);
+      LOG(debug) << "Read one event " << event.event_number();
       return true;
     } else {
       LOG(error) << "Event reading from HepMC failed ...";
@@ -126,9 +162,8 @@ Bool_t GeneratorHepMC::generateEvent()
     tries++;
   } while (tries < max_tries);
 
-  LOG(fatal) << "HepMC event gen failed (Does the file/stream have enough events)?";
-
   /** failure **/
+  mReadFailed = true;
   return false;
 }
 
@@ -18,6 +18,7 @@
 #include "Framework/Task.h"
 #include "Framework/CCDBParamSpec.h"
 #include "Steer/HitProcessingManager.h" // for DigitizationContext
+#include "Steer/HitReadAhead.h"
 #include "DataFormatsITSMFT/Digit.h"
 #include "DataFormatsITSMFT/NoiseMap.h"
 #include "DataFormatsITSMFT/TimeDeadMap.h"
@@ -29,6 +30,9 @@
 #include "DataFormatsParameters/GRPObject.h"
 #include "DataFormatsITSMFT/ROFRecord.h"
 #include "ITSMFTSimulation/Digitizer.h"
+#include "ITSMFTSimulation/ClusterFastSimulation.h"
+#include "DataFormatsITSMFT/CompCluster.h"
+#include "DataFormatsITSMFT/TopologyDictionary.h"
 #include "ITSMFTSimulation/DPLDigitizerParam.h"
 #include "ITSMFTBase/DPLAlpideParam.h"
 #include "ITSBase/GeometryTGeo.h"
@@ -53,6 +57,10 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   void initDigitizerTask(framework::InitContext& ic) override
   {
     mDisableQED = ic.options().get<bool>("disable-qed");
+    mHitCacheSize = std::max(0, ic.options().get<int>("hit-cache-size"));
+    if (mFastClusters) {
+      mTopologySeed = ic.options().get<int>("topology-seed");
+    }
   }
 
   void run(framework::ProcessingContext& pc)
@@ -75,6 +83,10 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     if (timesview.size() == 0) {
       return;
     }
+    if (mFastClusters) {
+      runFastSimulation(pc, *context, withQED);
+      return;
+    }
     TStopwatch timer;
     timer.Start();
     LOG(info) << " CALLING ITS DIGITIZATION ";
@@ -128,6 +140,8 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     }; // and accumulate lambda
 
     auto& eventParts = context->getEventParts(withQED);
+    // the hits are read ahead in the order of the collisions, events contributing to several collisions are read once
+    o2::steer::HitReadAhead<o2::itsmft::Hit> hitReader(*context, mSimChains, {o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0]}, mHitCacheSize, mHitCacheSize > 0, withQED);
     int bcShift = mDigitizer.getParams().getROFrameBiasInBC();
     // loop over all composite collisions given from context (aka loop over all the interaction records)
     for (int collID = 0; collID < timesview.size(); ++collID) {
@@ -144,13 +158,13 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
       for (auto& part : eventParts[collID]) {
 
         // get the hits for this event and this source
-        mHits.clear();
-        context->retrieveHits(mSimChains, o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0].c_str(), part.sourceID, part.entryID, &mHits);
+        auto hits = hitReader.get(part.sourceID, part.entryID);
+        auto const& eventHits = (*hits)[0];
 
-        if (mHits.size() > 0) {
+        if (eventHits.size() > 0) {
           LOG(debug) << "For collision " << collID << " eventID " << part.entryID
-                     << " found " << mHits.size() << " hits ";
-          mDigitizer.process(&mHits, part.entryID, part.sourceID); // call actual digitization procedure
+                     << " found " << eventHits.size() << " hits ";
+          mDigitizer.process(&eventHits, part.entryID, part.sourceID); // call actual digitization procedure
         }
       }
       mMC2ROFRecordsAccum.emplace_back(collID, -1, mDigitizer.getEventROFrameMin(), mDigitizer.getEventROFrameMax());
@@ -174,7 +188,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     pc.outputs().snapshot(Output{mOrigin, "ROMode", 0}, mROMode);
 
     timer.Stop();
-    LOG(info) << "Digitization took " << timer.CpuTime() << "s";
+    LOG(info) << "Digitization took " << timer.CpuTime() << "s, read " << hitReader.getNReads() << " events with " << hitReader.getNCacheHits() << " cache hits";
 
     // we should be only called once; tell DPL that this process is ready to exit
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
@@ -182,8 +196,85 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     mFinished = true;
   }
 
+  // produce clusters with sampled topologies directly from the hits, instead of digits
+  void runFastSimulation(framework::ProcessingContext& pc, o2::steer::DigitizationContext const& context, bool withQED)
+  {
+    TStopwatch timer;
+    timer.Start();
+    LOG(info) << " CALLING " << mID.getName() << " FAST CLUSTER SIMULATION ";
+
+    mFastSim.setClusters(&mClusters);
+    mFastSim.setPatterns(&mPatterns);
+    mFastSim.setROFRecords(&mROFRecordsAccum);
+    mFastSim.setMCLabels(mWithMCTruth ? &mLabelsAccum : nullptr);
+
+    auto fixMC2ROF = [this]() {
+      // register the ROFRecords entry of the first ROF of every MC event
+      for (; mFixROF < mROFRecordsAccum.size(); mFixROF++) {
+        const auto& rof = mROFRecordsAccum[mFixROF];
+        for (int m2rid = mFixMC2ROF; m2rid < mMC2ROFRecordsAccum.size(); m2rid++) {
+          auto& mc2rof = mMC2ROFRecordsAccum[m2rid];
+          if (rof.getROFrame() == mc2rof.minROF) {
+            mFixMC2ROF++;
+            mc2rof.rofRecordID = mFixROF;
+          }
+        }
+      }
+    };
+
+    auto& timesview = context.getEventRecords(withQED);
+    auto& eventParts = context.getEventParts(withQED);
+    o2::steer::HitReadAhead<o2::itsmft::Hit> hitReader(context, mSimChains, {o2::detectors::SimTraits::DETECTORBRANCHNAMES[mID][0]}, mHitCacheSize, mHitCacheSize > 0, withQED);
+    int bcShift = mFastSim.getParams().getROFrameBiasInBC();
+    for (int collID = 0; collID < timesview.size(); ++collID) {
+      auto irt = timesview[collID];
+      if (irt.toLong() < bcShift) { // due to the ROF misalignment the collision would go to negative ROF ID, discard
+        continue;
+      }
+      irt -= bcShift; // account for the ROF start shift
+
+      mFastSim.setEventTime(irt);
+      mFastSim.resetEventROFrames(); // to estimate min/max ROF for this collID
+      for (auto& part : eventParts[collID]) {
+        auto hits = hitReader.get(part.sourceID, part.entryID);
+        auto const& eventHits = (*hits)[0];
+        if (eventHits.size() > 0) {
+          mFastSim.process(&eventHits, part.entryID, part.sourceID);
+        }
+      }
+      mMC2ROFRecordsAccum.emplace_back(collID, -1, mFastSim.getEventROFrameMin(), mFastSim.getEventROFrameMax());
+      fixMC2ROF();
+    }
+    mFastSim.fillOutputContainer();
+    fixMC2ROF();
+
+    // same outputs as the clusterer
+    pc.outputs().snapshot(Output{mOrigin, "COMPCLUSTERS", 0}, mClusters);
+    pc.outputs().snapshot(Output{mOrigin, "PATTERNS", 0}, mPatterns);
+    pc.outputs().snapshot(Output{mOrigin, "CLUSTERSROF", 0}, mROFRecordsAccum);
+    if (mWithMCTruth) {
+      pc.outputs().snapshot(Output{mOrigin, "CLUSTERSMCTR", 0}, mLabelsAccum);
+      pc.outputs().snapshot(Output{mOrigin, "CLUSTERSMC2ROF", 0}, mMC2ROFRecordsAccum);
+      mLabelsAccum.clear_andfreememory();
+    }
+    LOG(info) << mID.getName() << ": Sending ROMode= " << mROMode << " to GRPUpdater";
+    pc.outputs().snapshot(Output{mOrigin, "ROMode", 0}, mROMode);
+
+    timer.Stop();
+    LOG(info) << "Fast simulation of " << mClusters.size() << " clusters (" << mFastSim.getNSampledGroups() << " with rare topologies) took "
+              << timer.CpuTime() << "s, read " << hitReader.getNReads() << " events with " << hitReader.getNCacheHits() << " cache hits";
+
+    pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
+    mFinished = true;
+  }
+
   void finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
   {
+    if (matcher == ConcreteDataMatcher(mOrigin, "CLUSDICT", 0)) {
+      LOG(info) << mID.getName() << " cluster dictionary updated";
+      mFastSim.setDictionary(*(const o2::itsmft::TopologyDictionary*)obj, mTopologySeed);
+      return;
+    }
     if (matcher == ConcreteDataMatcher(mOrigin, "NOISEMAP", 0)) {
       LOG(info) << mID.getName() << " noise map updated";
       mDigitizer.setNoiseMap((const o2::itsmft::NoiseMap*)obj);
@@ -225,7 +316,7 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   }
 
  protected:
-  ITSMFTDPLDigitizerTask(bool mctruth = true) : BaseDPLDigitizer(InitServices::FIELD | InitServices::GEOM), mWithMCTruth(mctruth) {}
+  ITSMFTDPLDigitizerTask(bool mctruth = true, bool fastClusters = false) : BaseDPLDigitizer(InitServices::FIELD | InitServices::GEOM), mWithMCTruth(mctruth), mFastClusters(fastClusters) {}
 
   template <int DETID>
   void updateTimeDependentParams(ProcessingContext& pc)
@@ -236,6 +327,9 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
     // TODO: the code should run even if this object does not exist. Or: create default object
     pc.inputs().get<o2::itsmft::TimeDeadMap*>(detstr + "_time_dead");
     pc.inputs().get<o2::itsmft::DPLAlpideParam<DETID>*>(detstr + "_alppar");
+    if (mFastClusters) {
+      pc.inputs().get<o2::itsmft::TopologyDictionary*>(detstr + "_cldict");
+    }
 
     auto& dopt = o2::itsmft::DPLDigitizerParam<DETID>::Instance();
     auto& aopt = o2::itsmft::DPLAlpideParam<DETID>::Instance();
@@ -276,13 +370,21 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
       geom = o2::mft::GeometryTGeo::Instance();
     }
     geom->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::L2G)); // make sure L2G matrices are loaded
+    if (mFastClusters) {
+      mFastSim.getParams() = digipar;
+      mFastSim.setGeometry(geom);
+      mFastSim.init();
+      return;
+    }
     mDigitizer.setGeometry(geom);
     mDigitizer.init();
   }
 
   bool mWithMCTruth = true;
+  bool mFastClusters = false; // clusters with sampled topologies are produced instead of digits
   bool mFinished = false;
   bool mDisableQED = false;
+  int mHitCacheSize = 0; // number of events in the hit cache, the hits are read ahead by a thread if > 0
   unsigned long mFirstOrbitTF = 0x0;
   o2::detectors::DetID mID;
   o2::header::DataOrigin mOrigin = o2::header::gDataOriginInvalid;
@@ -290,14 +392,19 @@ class ITSMFTDPLDigitizerTask : BaseDPLDigitizer
   std::vector<o2::itsmft::Digit> mDigits;
   std::vector<o2::itsmft::ROFRecord> mROFRecords;
   std::vector<o2::itsmft::ROFRecord> mROFRecordsAccum;
-  std::vector<o2::itsmft::Hit> mHits;
-  std::vector<o2::itsmft::Hit>* mHitsP = &mHits;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
   o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabelsAccum;
   std::vector<o2::itsmft::MC2ROFRecord> mMC2ROFRecordsAccum;
   std::vector<TChain*> mSimChains;
   o2::itsmft::NoiseMap* mDeadMap = nullptr;
 
+  // fast simulation of clusters
+  o2::itsmft::ClusterFastSimulation mFastSim;
+  std::vector<o2::itsmft::CompClusterExt> mClusters;
+  std::vector<unsigned char> mPatterns;
+  int mTopologySeed = 0;
+  size_t mFixROF = 0; // 1st entry in mROFRecordsAccum not yet checked for MC2ROF records
+
   int mFixMC2ROF = 0;                                                             // 1st entry in mc2rofRecordsAccum to be fixed for ROFRecordID
   bool mTimeDeadMapUpdated = false;
   o2::parameters::GRPObject::ROMode mROMode = o2::parameters::GRPObject::PRESENT; // readout mode
@@ -310,7 +417,7 @@ class ITSDPLDigitizerTask : public ITSMFTDPLDigitizerTask
   // FIXME: origin should be extractable from the DetID, the problem is 3d party header dependencies
   static constexpr o2::detectors::DetID::ID DETID = o2::detectors::DetID::ITS;
   static constexpr o2::header::DataOrigin DETOR = o2::header::gDataOriginITS;
-  ITSDPLDigitizerTask(bool mctruth = true) : ITSMFTDPLDigitizerTask(mctruth)
+  ITSDPLDigitizerTask(bool mctruth = true, bool fastClusters = false) : ITSMFTDPLDigitizerTask(mctruth, fastClusters)
   {
     mID = DETID;
     mOrigin = DETOR;
@@ -327,7 +434,7 @@ class MFTDPLDigitizerTask : public ITSMFTDPLDigitizerTask
   // FIXME: origina should be extractable from the DetID, the problem is 3d party header dependencies
   static constexpr o2::detectors::DetID::ID DETID = o2::detectors::DetID::MFT;
   static constexpr o2::header::DataOrigin DETOR = o2::header::gDataOriginMFT;
-  MFTDPLDigitizerTask(bool mctruth) : ITSMFTDPLDigitizerTask(mctruth)
+  MFTDPLDigitizerTask(bool mctruth, bool fastClusters = false) : ITSMFTDPLDigitizerTask(mctruth, fastClusters)
   {
     mID = DETID;
     mOrigin = DETOR;
@@ -337,9 +444,20 @@ class MFTDPLDigitizerTask : public ITSMFTDPLDigitizerTask
 constexpr o2::detectors::DetID::ID MFTDPLDigitizerTask::DETID;
 constexpr o2::header::DataOrigin MFTDPLDigitizerTask::DETOR;
 
-std::vector<OutputSpec> makeOutChannels(o2::header::DataOrigin detOrig, bool mctruth)
+std::vector<OutputSpec> makeOutChannels(o2::header::DataOrigin detOrig, bool mctruth, bool fastClusters)
 {
   std::vector<OutputSpec> outputs;
+  if (fastClusters) {
+    outputs.emplace_back(detOrig, "COMPCLUSTERS", 0, Lifetime::Timeframe);
+    outputs.emplace_back(detOrig, "PATTERNS", 0, Lifetime::Timeframe);
+    outputs.emplace_back(detOrig, "CLUSTERSROF", 0, Lifetime::Timeframe);
+    if (mctruth) {
+      outputs.emplace_back(detOrig, "CLUSTERSMCTR", 0, Lifetime::Timeframe);
+      outputs.emplace_back(detOrig, "CLUSTERSMC2ROF", 0, Lifetime::Timeframe);
+    }
+    outputs.emplace_back(detOrig, "ROMode", 0, Lifetime::Timeframe);
+    return outputs;
+  }
   outputs.emplace_back(detOrig, "DIGITS", 0, Lifetime::Timeframe);
   outputs.emplace_back(detOrig, "DIGITSROF", 0, Lifetime::Timeframe);
   if (mctruth) {
@@ -350,7 +468,7 @@ std::vector<OutputSpec> makeOutChannels(o2::header::DataOrigin detOrig, bool mct
   return outputs;
 }
 
-DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth)
+DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth, bool fastClusters)
 {
   std::string detStr = o2::detectors::DetID::getName(ITSDPLDigitizerTask::DETID);
   auto detOrig = ITSDPLDigitizerTask::DETOR;
@@ -365,15 +483,21 @@ DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth)
   inputs.emplace_back("ITS_dead", "ITS", "DEADMAP", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/DeadMap"));
   inputs.emplace_back("ITS_time_dead", "ITS", "TimeDeadMap", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/TimeDeadMap"));
   inputs.emplace_back("ITS_alppar", "ITS", "ALPIDEPARAM", 0, Lifetime::Condition, ccdbParamSpec("ITS/Config/AlpideParam"));
+  Options options{
+    {"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}},
+    {"hit-cache-size", o2::framework::VariantType::Int, 16, {"Number of events kept in the hit cache, hits are read ahead by a thread if > 0"}}};
+  if (fastClusters) {
+    inputs.emplace_back("ITS_cldict", "ITS", "CLUSDICT", 0, Lifetime::Condition, ccdbParamSpec("ITS/Calib/ClusterDictionary"));
+    options.push_back({"topology-seed", o2::framework::VariantType::Int, 0, {"Seed for the sampling of the cluster topologies"}});
+  }
 
-  return DataProcessorSpec{(detStr + "Digitizer").c_str(),
-                           inputs, makeOutChannels(detOrig, mctruth),
-                           AlgorithmSpec{adaptFromTask<ITSDPLDigitizerTask>(mctruth)},
-                           Options{
-                             {"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}}}};
+  return DataProcessorSpec{(detStr + (fastClusters ? "FastClusterizer" : "Digitizer")).c_str(),
+                           inputs, makeOutChannels(detOrig, mctruth, fastClusters),
+                           AlgorithmSpec{adaptFromTask<ITSDPLDigitizerTask>(mctruth, fastClusters)},
+                           options};
 }
 
-DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth)
+DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth, bool fastClusters)
 {
   std::string detStr = o2::detectors::DetID::getName(MFTDPLDigitizerTask::DETID);
   auto detOrig = MFTDPLDigitizerTask::DETOR;
@@ -388,10 +512,16 @@ DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth)
             << o2::itsmft::DPLDigitizerParam<ITSDPLDigitizerTask::DETID>::Instance()
             << " or " << o2::itsmft::DPLAlpideParam<ITSDPLDigitizerTask::DETID>::getParamName().data() << ".<param>=value;... with"
             << o2::itsmft::DPLAlpideParam<ITSDPLDigitizerTask::DETID>::Instance();
-  return DataProcessorSpec{(detStr + "Digitizer").c_str(),
-                           inputs, makeOutChannels(detOrig, mctruth),
-                           AlgorithmSpec{adaptFromTask<MFTDPLDigitizerTask>(mctruth)},
-                           Options{{"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}}}};
+  Options options{{"disable-qed", o2::framework::VariantType::Bool, false, {"disable QED handling"}},
+                  {"hit-cache-size", o2::framework::VariantType::Int, 16, {"Number of events kept in the hit cache, hits are read ahead by a thread if > 0"}}};
+  if (fastClusters) {
+    inputs.emplace_back("MFT_cldict", "MFT", "CLUSDICT", 0, Lifetime::Condition, ccdbParamSpec("MFT/Calib/ClusterDictionary"));
+    options.push_back({"topology-seed", o2::framework::VariantType::Int, 0, {"Seed for the sampling of the cluster topologies"}});
+  }
+  return DataProcessorSpec{(detStr + (fastClusters ? "FastClusterizer" : "Digitizer")).c_str(),
+                           inputs, makeOutChannels(detOrig, mctruth, fastClusters),
+                           AlgorithmSpec{adaptFromTask<MFTDPLDigitizerTask>(mctruth, fastClusters)},
+                           options};
 }
 
 } // end namespace itsmft
@@ -19,8 +19,10 @@ namespace o2
 namespace itsmft
 {
 
-o2::framework::DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth = true);
-o2::framework::DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth = true);
+/// if fastClusters is true, compact clusters with topologies sampled from the cluster dictionary
+/// are produced directly from the hits instead of digits
+o2::framework::DataProcessorSpec getITSDigitizerSpec(int channel, bool mctruth = true, bool fastClusters = false);
+o2::framework::DataProcessorSpec getMFTDigitizerSpec(int channel, bool mctruth = true, bool fastClusters = false);
 
 } // end namespace itsmft
 } // end namespace o2
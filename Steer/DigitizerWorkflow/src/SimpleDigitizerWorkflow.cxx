@@ -39,6 +39,8 @@
 // for ITSMFT
 #include "ITSMFTDigitizerSpec.h"
 #include "ITSMFTWorkflow/DigitWriterSpec.h"
+#include "ITSWorkflow/ClusterWriterSpec.h"
+#include "MFTWorkflow/ClusterWriterSpec.h"
 
 #ifdef ENABLE_UPGRADES
 // for ITS3
@@ -214,6 +216,9 @@ void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
 
   workflowOptions.push_back(ConfigParamSpec{"combine-devices", VariantType::Bool, false, {"combined multiple DPL worker/writer devices"}});
 
+  // produce ITS/MFT clusters with sampled topologies instead of digits
+  workflowOptions.push_back(ConfigParamSpec{"itsmft-fast-clusters", VariantType::Bool, false, {"produce ITS/MFT clusters directly from the hits with topologies sampled from the cluster dictionary"}});
+
   // to enable distribution of triggers
   workflowOptions.push_back(ConfigParamSpec{"with-trigger", VariantType::Bool, false, {"enable distribution of CTP trigger digits"}});
 }
@@ -610,6 +615,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
     }
   }
 
+  const bool itsmftFastClusters = configcontext.options().get<bool>("itsmft-fast-clusters");
+
   // first 36 channels are reserved for the TPC
   const int firstOtherChannel = 36;
   int fanoutsize = firstOtherChannel;
@@ -618,9 +625,13 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   if (isEnabled(o2::detectors::DetID::ITS)) {
     detList.emplace_back(o2::detectors::DetID::ITS);
     // connect the ITS digitization
-    digitizerSpecs.emplace_back(o2::itsmft::getITSDigitizerSpec(fanoutsize++, mctruth));
-    // connect ITS digit writer
-    writerSpecs.emplace_back(o2::itsmft::getITSDigitWriterSpec(mctruth));
+    digitizerSpecs.emplace_back(o2::itsmft::getITSDigitizerSpec(fanoutsize++, mctruth, itsmftFastClusters));
+    // connect ITS digit or cluster writer
+    if (itsmftFastClusters) {
+      writerSpecs.emplace_back(o2::its::getClusterWriterSpec(mctruth));
+    } else {
+      writerSpecs.emplace_back(o2::itsmft::getITSDigitWriterSpec(mctruth));
+    }
   }
 
 #ifdef ENABLE_UPGRADES
@@ -638,9 +649,13 @@ WorkflowSpec defineDataProcessing(ConfigContext const& configcontext)
   if (isEnabled(o2::detectors::DetID::MFT)) {
     detList.emplace_back(o2::detectors::DetID::MFT);
     // connect the MFT digitization
-    digitizerSpecs.emplace_back(o2::itsmft::getMFTDigitizerSpec(fanoutsize++, mctruth));
-    // connect MFT digit writer
-    writerSpecs.emplace_back(o2::itsmft::getMFTDigitWriterSpec(mctruth));
+    digitizerSpecs.emplace_back(o2::itsmft::getMFTDigitizerSpec(fanoutsize++, mctruth, itsmftFastClusters));
+    // connect MFT digit or cluster writer
+    if (itsmftFastClusters) {
+      writerSpecs.emplace_back(o2::mft::getClusterWriterSpec(mctruth));
+    } else {
+      writerSpecs.emplace_back(o2::itsmft::getMFTDigitWriterSpec(mctruth));
+    }
   }
 
   // the TOF part
@@ -26,6 +26,7 @@
 #include "Headers/DataHeader.h"
 #include "TStopwatch.h"
 #include "Steer/HitProcessingManager.h" // for DigitizationContext
+#include "Steer/HitReadAhead.h"
 #include "TChain.h"
 #include <SimulationDataFormat/MCCompLabel.h>
 #include <SimulationDataFormat/ConstMCTruthContainer.h>
@@ -36,6 +37,9 @@
 #include "TPCBase/CDBInterface.h"
 #include "DataFormatsTPC/Digit.h"
 #include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
+#include "TPCSimulation/SAMPAProcessing.h"
 #include "TPCSimulation/Detector.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
 #include "DetectorsBase/BaseDPLDigitizer.h"
@@ -44,6 +48,9 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "SimConfig/DigiParams.h"
 #include <filesystem>
+#include <atomic>
+#include <thread>
+#include "TROOT.h"
 #include "Framework/CCDBParamSpec.h"
 
 using namespace o2::framework;
@@ -108,6 +115,23 @@ using namespace o2::base;
 class TPCDPLDigitizerTask : public BaseDPLDigitizer
 {
  public:
+  /// input, output buffers and workspace of the digitization of one sector
+  struct SectorJob {
+    std::shared_ptr<const o2::steer::DigitizationContext> context;
+    int sector = 0;
+    uint64_t activeSectors = 0;
+    SubSpecificationType subSpecification = 0;
+    std::vector<o2::tpc::Digit>* digitsAccum = nullptr;            // DPL owned accumulator for digits
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labelAccum; // timeframe accumulator for labels
+    std::vector<CommonMode> commonModeAccum;
+    std::vector<DigiGroupRef> eventAccum;
+    std::vector<o2::tpc::Digit> digits; // digits of the current flush
+    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+    std::vector<o2::tpc::CommonMode> commonMode;
+    size_t digitCounter = 0;
+    size_t flushCounter = 0;
+  };
+
   TPCDPLDigitizerTask(bool internalwriter, int distortionType) : mInternalWriter(internalwriter), BaseDPLDigitizer(InitServices::FIELD | InitServices::GEOM), mDistortionType(distortionType)
   {
   }
@@ -123,6 +147,16 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     mRecalcDistortions = !(ic.options().get<bool>("do-not-recalculate-distortions"));
     const int nthreadsDist = ic.options().get<int>("n-threads-distortions");
     SC::setNThreads(nthreadsDist);
+    mNThreads = std::max(1, ic.options().get<int>("n-threads-sectors"));
+    mHitCacheSize = std::max(0, ic.options().get<int>("hit-cache-size"));
+    if (mNThreads > 1) {
+      if (mInternalWriter) {
+        LOG(warning) << "TPC: Parallel digitization of sectors is not supported with the internal writer, using 1 thread";
+        mNThreads = 1;
+      } else {
+        ROOT::EnableThreadSafety();
+      }
+    }
     mUseCalibrationsFromCCDB = ic.options().get<bool>("TPCuseCCDB");
     mMeanLumiDistortions = ic.options().get<float>("meanLumiDistortions");
     mMeanLumiDistortionsDerivative = ic.options().get<float>("meanLumiDistortionsDerivative");
@@ -153,36 +187,36 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     }
   }
 
-  void writeToROOTFile()
+  void writeToROOTFile(SectorJob& job)
   {
     if (!mInternalROOTFlushFile) {
       std::stringstream tmp;
       tmp << "tpc_driftime_digits_lane" << mLaneId << ".root";
       mInternalROOTFlushFile = new TFile(tmp.str().c_str(), "UPDATE");
       std::stringstream trname;
-      trname << mSector;
+      trname << job.sector;
       mInternalROOTFlushTTree = new TTree(trname.str().c_str(), "o2sim");
     }
     {
       std::stringstream brname;
-      brname << "TPCDigit_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mDigits);
+      brname << "TPCDigit_" << job.sector;
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &job.digits);
       br->Fill();
       br->ResetAddress();
     }
     if (mWithMCTruth) {
       // labels
       std::stringstream brname;
-      brname << "TPCDigitMCTruth_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mLabels);
+      brname << "TPCDigitMCTruth_" << job.sector;
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &job.labels);
       br->Fill();
       br->ResetAddress();
     }
     {
       // common
       std::stringstream brname;
-      brname << "TPCCommonMode_" << mSector;
-      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &mCommonMode);
+      brname << "TPCCommonMode_" << job.sector;
+      auto br = o2::base::getOrMakeBranch(*mInternalROOTFlushTTree, brname.str().c_str(), &job.commonMode);
       br->Fill();
       br->ResetAddress();
     }
@@ -248,37 +282,51 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       cdb.setGainMapFromFile("GainMap.root");
     }
 
+    std::vector<std::unique_ptr<SectorJob>> jobs;
     for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
       for (auto const& inputref : it) {
         if (inputref.spec->lifetime == o2::framework::Lifetime::Condition) { // process does not need conditions
           continue;
         }
-        process(pc, inputref);
+        auto job = prepareSector(pc, inputref);
+        if (!job) {
+          continue;
+        }
+        if (mNThreads > 1 && !mInternalWriter) {
+          // the sectors are digitized in parallel after all inputs are collected
+          jobs.emplace_back(std::move(job));
+          continue;
+        }
+        digitizeSector(mDigitizer, mSimChains, *job);
+        sendSector(pc, *job);
         if (mInternalWriter) {
-          mInternalROOTFlushTTree->SetEntries(mFlushCounter);
+          mInternalROOTFlushTTree->SetEntries(job->flushCounter);
           mInternalROOTFlushFile->Write("", TObject::kOverwrite);
           mInternalROOTFlushFile->Close();
           // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
           delete mInternalROOTFlushFile;
           mInternalROOTFlushFile = nullptr;
         }
-        // TODO: make generic reset method?
-        mFlushCounter = 0;
-        mDigitCounter = 0;
+      }
+    }
+
+    if (jobs.size()) {
+      digitizeSectorsParallel(jobs);
+      for (auto& job : jobs) {
+        sendSector(pc, *job);
       }
     }
   }
 
-  // process one sector
-  void process(framework::ProcessingContext& pc, framework::DataRef const& inputref)
+  // prepare the digitization of one sector, the output buffers are created here as the DPL allocator is not thread safe
+  std::unique_ptr<SectorJob> prepareSector(framework::ProcessingContext& pc, framework::DataRef const& inputref)
   {
     // read collision context from input
-    auto context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
-    context->initSimChains(o2::detectors::DetID::TPC, mSimChains);
+    std::shared_ptr<const o2::steer::DigitizationContext> context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
     auto& irecords = context->getEventRecords();
     LOG(info) << "TPC: Processing " << irecords.size() << " collisions";
     if (irecords.size() == 0) {
-      return;
+      return nullptr;
     }
     auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
 
@@ -296,64 +344,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
     if (sectorHeader == nullptr) {
       LOG(error) << "TPC: Sector header missing, skipping processing";
-      return;
+      return nullptr;
     }
     auto sector = sectorHeader->sector();
-    mSector = sector;
     mListOfSectors.push_back(sector);
     LOG(info) << "TPC: Processing sector " << sector;
-    // the active sectors need to be propagated
-    uint64_t activeSectors = 0;
-    activeSectors = sectorHeader->activeSectors;
-
-    // lambda that creates a DPL owned buffer to accumulate the digits (in shared memory)
-    auto makeDigitBuffer = [this, sector, &pc, activeSectors, &dh]() {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (mInternalWriter) {
-        using ContainerType = std::decay_t<decltype(pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"", "", 0}))>*;
-        return ContainerType(nullptr);
-      } else {
-        // default case
-        return &pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"TPC", "DIGITS", static_cast<SubSpecificationType>(dh->subSpecification), header});
-      }
-    };
-    // lambda that snapshots the common mode vector to be sent out; prepares and attaches header with sector information
-    auto snapshotCommonMode = [this, sector, &pc, activeSectors, &dh](std::vector<o2::tpc::CommonMode> const& commonMode) {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (!mInternalWriter) {
-        // note that snapshoting only works with non-const references (to be fixed?)
-        pc.outputs().snapshot(Output{"TPC", "COMMONMODE", static_cast<SubSpecificationType>(dh->subSpecification), header},
-                              const_cast<std::vector<o2::tpc::CommonMode>&>(commonMode));
-      }
-    };
-    // lambda that snapshots labels to be sent out; prepares and attaches header with sector information
-    auto snapshotLabels = [this, &sector, &pc, activeSectors, &dh](o2::dataformats::MCTruthContainer<o2::MCCompLabel> const& labels) {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (mWithMCTruth) {
-        if (!mInternalWriter) {
-          auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", static_cast<SubSpecificationType>(dh->subSpecification), header});
-          labels.flatten_to(sharedlabels);
-        }
-      }
-    };
-    // lambda that snapshots digits grouping (triggers) to be sent out; prepares and attaches header with sector information
-    auto snapshotEvents = [this, sector, &pc, activeSectors, &dh](const std::vector<DigiGroupRef>& events) {
-      o2::tpc::TPCSectorHeader header{sector};
-      header.activeSectors = activeSectors;
-      if (!mInternalWriter) {
-        LOG(info) << "TPC: Send TRIGGERS for sector " << sector << " channel " << dh->subSpecification << " | size " << events.size();
-        pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", static_cast<SubSpecificationType>(dh->subSpecification), header},
-                              const_cast<std::vector<DigiGroupRef>&>(events));
-      }
-    };
-
-    auto digitsAccum = makeDigitBuffer();                          // accumulator for digits
-    o2::dataformats::MCTruthContainer<o2::MCCompLabel> labelAccum; // timeframe accumulator for labels
-    std::vector<CommonMode> commonModeAccum;
-    std::vector<DigiGroupRef> eventAccum;
 
     // this should not happen any more, legacy condition when the sector variable was used
     // to transport control information
@@ -368,54 +363,81 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       throw std::runtime_error("Digitizer can only work on single sectors");
     }
 
-    mDigitizer.setSector(sector);
-    mDigitizer.init();
+    auto job = std::make_unique<SectorJob>();
+    job->context = context;
+    job->sector = sector;
+    // the active sectors need to be propagated
+    job->activeSectors = sectorHeader->activeSectors;
+    job->subSpecification = static_cast<SubSpecificationType>(dh->subSpecification);
 
-    auto& eventParts = context->getEventParts();
+    // DPL owned buffer to accumulate the digits (in shared memory)
+    if (!mInternalWriter) {
+      o2::tpc::TPCSectorHeader header{sector};
+      header.activeSectors = job->activeSectors;
+      job->digitsAccum = &pc.outputs().make<std::vector<o2::tpc::Digit>>(Output{"TPC", "DIGITS", job->subSpecification, header});
+    }
+    return job;
+  }
 
-    auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush = false) {
-      mFlushCounter++;
+  // digitize one sector, only the given digitizer and simulation chains are modified
+  void digitizeSector(o2::tpc::Digitizer& digitizer, std::vector<TChain*>& simChains, SectorJob& job)
+  {
+    auto const& context = *job.context;
+    auto& irecords = context.getEventRecords();
+    auto& eventParts = context.getEventParts();
+    const int sector = job.sector;
+    const bool isContinuous = digitizer.isContinuousReadout();
+    context.initSimChains(o2::detectors::DetID::TPC, simChains);
+
+    digitizer.setSector(sector);
+    digitizer.init();
+
+    auto flushDigitsAndLabels = [this, &digitizer, &job](bool finalFlush = false) {
+      job.flushCounter++;
       // flush previous buffer
-      mDigits.clear();
-      mLabels.clear();
-      mCommonMode.clear();
-      mDigitizer.flush(mDigits, mLabels, mCommonMode, finalFlush);
-      LOG(info) << "TPC: Flushed " << mDigits.size() << " digits, " << mLabels.getNElements() << " labels and " << mCommonMode.size() << " common mode entries";
+      job.digits.clear();
+      job.labels.clear();
+      job.commonMode.clear();
+      digitizer.flush(job.digits, job.labels, job.commonMode, finalFlush);
+      LOG(info) << "TPC: Flushed " << job.digits.size() << " digits, " << job.labels.getNElements() << " labels and " << job.commonMode.size() << " common mode entries";
 
       if (mInternalWriter) {
         // the natural place to write out this independent datachunk immediately ...
-        writeToROOTFile();
+        writeToROOTFile(job);
       } else {
         // ... or to accumulate and later forward to next DPL proc
-        std::copy(mDigits.begin(), mDigits.end(), std::back_inserter(*digitsAccum));
+        std::copy(job.digits.begin(), job.digits.end(), std::back_inserter(*job.digitsAccum));
         if (mWithMCTruth) {
-          labelAccum.mergeAtBack(mLabels);
+          job.labelAccum.mergeAtBack(job.labels);
         }
-        std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
+        std::copy(job.commonMode.begin(), job.commonMode.end(), std::back_inserter(job.commonModeAccum));
       }
-      mDigitCounter += mDigits.size();
+      job.digitCounter += job.digits.size();
     };
 
     if (isContinuous) {
       auto& hbfu = o2::raw::HBFUtils::Instance();
       double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
-      mDigitizer.setOutputDigitTimeOffset(time);
-      mDigitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+      digitizer.setOutputDigitTimeOffset(time);
+      digitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
     }
 
     TStopwatch timer;
     timer.Start();
 
+    // the hits are read ahead in the order of the collisions, events contributing to several collisions are read once
+    o2::steer::HitReadAhead<o2::tpc::HitGroup> hitReader(context, simChains, {getBranchNameLeft(sector), getBranchNameRight(sector)}, mHitCacheSize, mHitCacheSize > 0);
+
     // loop over all composite collisions given from context
     // (aka loop over all the interaction records)
     for (int collID = 0; collID < irecords.size(); ++collID) {
       const double eventTime = irecords[collID].getTimeNS() / 1000.f;
       LOG(info) << "TPC: Event time " << eventTime << " us";
-      mDigitizer.setEventTime(eventTime);
+      digitizer.setEventTime(eventTime);
       if (!isContinuous) {
-        mDigitizer.setStartTime(eventTime);
+        digitizer.setStartTime(eventTime);
       }
-      size_t startSize = mDigitCounter; // digitsAccum->size();
+      size_t startSize = job.digitCounter; // digitsAccum->size();
 
       // for each collision, loop over the constituents event and source IDs
       // (background signal merging is basically taking place here)
@@ -424,19 +446,18 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         const int sourceID = part.sourceID;
 
         // get the hits for this event and this source
-        std::vector<o2::tpc::HitGroup> hitsLeft;
-        std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        auto hits = hitReader.get(part.sourceID, part.entryID);
+        auto const& hitsLeft = (*hits)[0];
+        auto const& hitsRight = (*hits)[1];
         LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
 
-        mDigitizer.process(hitsLeft, eventID, sourceID);
-        mDigitizer.process(hitsRight, eventID, sourceID);
+        digitizer.process(hitsLeft, eventID, sourceID);
+        digitizer.process(hitsRight, eventID, sourceID);
 
         flushDigitsAndLabels();
 
         if (!isContinuous) {
-          eventAccum.emplace_back(startSize, mDigits.size());
+          job.eventAccum.emplace_back(startSize, job.digits.size());
         }
       }
     }
@@ -445,35 +466,95 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     if (isContinuous) {
       LOG(info) << "TPC: Final flush";
       flushDigitsAndLabels(true);
-      eventAccum.emplace_back(0, mDigitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
+      job.eventAccum.emplace_back(0, job.digitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
     }
 
-    if (!mInternalWriter) {
-      // send out to next stage
-      snapshotEvents(eventAccum);
-      // snapshotDigits(digitsAccum); --> done automatically
-      snapshotCommonMode(commonModeAccum);
-      snapshotLabels(labelAccum);
+    timer.Stop();
+    LOG(info) << "TPC: Digitization of sector " << sector << " took " << timer.CpuTime() << "s, read " << hitReader.getNReads() << " events with " << hitReader.getNCacheHits() << " cache hits";
+  }
+
+  // digitize the sectors in a pool of threads, each thread uses its own digitizer, hit chains and copies of the
+  // singletons with random rings, the calibration and distortion objects are shared between the threads
+  void digitizeSectorsParallel(std::vector<std::unique_ptr<SectorJob>>& jobs)
+  {
+    const int nThreads = std::min(mNThreads, int(jobs.size()));
+    while (int(mWorkers.size()) < nThreads) {
+      const int workerID = mWorkers.size();
+      auto& worker = mWorkers.emplace_back();
+      worker.digitizer = std::make_unique<o2::tpc::Digitizer>();
+      worker.electronTransport = ElectronTransport::createCopy(workerID);
+      worker.gemAmplification = GEMAmplification::createCopy(workerID);
+      worker.sampaProcessing = SAMPAProcessing::createCopy(workerID);
+    }
+    for (int i = 0; i < nThreads; ++i) {
+      mWorkers[i].digitizer->copySettings(mDigitizer);
+      // the chains are set up sequentially, afterwards each thread reads from its own files
+      jobs.front()->context->initSimChains(o2::detectors::DetID::TPC, mWorkers[i].simChains);
     }
 
+    TStopwatch timer;
+    timer.Start();
+    std::atomic<size_t> nextJob{0};
+    auto work = [this, &jobs, &nextJob](Worker& worker) {
+      ElectronTransport::setThreadInstance(worker.electronTransport.get());
+      GEMAmplification::setThreadInstance(worker.gemAmplification.get());
+      SAMPAProcessing::setThreadInstance(worker.sampaProcessing.get());
+      for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+        digitizeSector(*worker.digitizer, worker.simChains, *jobs[i]);
+      }
+      ElectronTransport::setThreadInstance(nullptr);
+      GEMAmplification::setThreadInstance(nullptr);
+      SAMPAProcessing::setThreadInstance(nullptr);
+    };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nThreads; ++i) {
+      threads.emplace_back(work, std::ref(mWorkers[i]));
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
     timer.Stop();
-    LOG(info) << "TPC: Digitization took " << timer.CpuTime() << "s";
+    LOG(info) << "TPC: Digitization of " << jobs.size() << " sectors in " << nThreads << " threads took " << timer.RealTime() << "s";
+  }
+
+  // send the outputs of one sector to the next stage
+  void sendSector(framework::ProcessingContext& pc, SectorJob& job)
+  {
+    if (mInternalWriter) {
+      return;
+    }
+    o2::tpc::TPCSectorHeader header{job.sector};
+    header.activeSectors = job.activeSectors;
+    // digits are sent automatically
+    LOG(info) << "TPC: Send TRIGGERS for sector " << job.sector << " channel " << job.subSpecification << " | size " << job.eventAccum.size();
+    pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", job.subSpecification, header}, job.eventAccum);
+    pc.outputs().snapshot(Output{"TPC", "COMMONMODE", job.subSpecification, header}, job.commonModeAccum);
+    if (mWithMCTruth) {
+      auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", job.subSpecification, header});
+      job.labelAccum.flatten_to(sharedlabels);
+    }
   }
 
  private:
+  /// digitizer, hit chains and copies of the singletons of one thread of the parallel digitization
+  struct Worker {
+    std::unique_ptr<o2::tpc::Digitizer> digitizer;
+    std::vector<TChain*> simChains;
+    std::unique_ptr<ElectronTransport> electronTransport;
+    std::unique_ptr<GEMAmplification> gemAmplification;
+    std::unique_ptr<SAMPAProcessing> sampaProcessing;
+  };
+
   o2::tpc::Digitizer mDigitizer;
   o2::tpc::VDriftHelper mTPCVDriftHelper{};
   std::vector<TChain*> mSimChains;
-  std::vector<o2::tpc::Digit> mDigits;
-  o2::dataformats::MCTruthContainer<o2::MCCompLabel> mLabels;
-  std::vector<o2::tpc::CommonMode> mCommonMode;
+  std::vector<Worker> mWorkers; // workers of the parallel digitization
   std::vector<int> mListOfSectors; //  a list of sectors treated by this task
   TFile* mInternalROOTFlushFile = nullptr;
   TTree* mInternalROOTFlushTTree = nullptr;
-  size_t mDigitCounter = 0;
-  size_t mFlushCounter = 0;
   int mLaneId = 0; // the id of the current process within the parallel pipeline
-  int mSector = 0;
+  int mNThreads = 1; // number of threads digitizing the sectors of this lane in parallel
+  int mHitCacheSize = 0; // number of events in the hit cache, the hits are read ahead by a thread if > 0
   bool mWriteGRP = false;
   bool mWithMCTruth = true;
   bool mInternalWriter = false;
@@ -522,6 +603,8 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
       {"meanLumiDistortionsDerivative", VariantType::Float, -1.f, {"override lumi of derivative distortion object if >=0"}},
       {"do-not-recalculate-distortions", VariantType::Bool, false, {"Do not recalculate the distortions"}},
       {"n-threads-distortions", VariantType::Int, 4, {"Number of threads used for the calculation of the distortions"}},
+      {"n-threads-sectors", VariantType::Int, 1, {"Number of threads used to digitize the sectors of this lane in parallel"}},
+      {"hit-cache-size", VariantType::Int, 8, {"Number of events kept in the hit cache, hits are read ahead by a thread if > 0"}},
     }};
 }
 
@@ -0,0 +1,216 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file HitReadAhead.h
+/// \brief Cached reading of the hits of the events of a DigitizationContext with a read-ahead thread
+
+#ifndef O2_STEER_HITREADAHEAD_H
+#define O2_STEER_HITREADAHEAD_H
+
+#include "SimulationDataFormat/DigitizationContext.h"
+#include <TChain.h>
+#include <TROOT.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+/// Reader of the hits of the events contributing to the collisions of a DigitizationContext.
+/// The decoded hits are kept in a LRU cache of events keyed by (sourceID, entryID), such that an event contributing to
+/// several collisions (e.g. a background event used for the embedding of several signals) is read only once.
+/// Optionally a thread reads the events ahead in the order of the collisions of the context, while the caller is
+/// digitizing the previous ones. The events are expected to be requested in the order of the collisions as well.
+template <typename T>
+class HitReadAhead
+{
+ public:
+  using HitVector = std::vector<T>;
+  using EventHits = std::vector<HitVector>; ///< hits of one event, one vector per branch
+
+  /// \param context context with the collisions to be digitized
+  /// \param chains chains set up by DigitizationContext::initSimChains, only used by the reader during its lifetime
+  /// \param branchNames names of the hit branches read for each event
+  /// \param cacheSize maximal number of events kept in the cache, at most half of them are read ahead
+  /// \param readAhead if true, the events are read by a separate thread
+  /// \param withQED if true, the collisions including the QED events are read
+  HitReadAhead(DigitizationContext const& context, std::vector<TChain*> const& chains, std::vector<std::string> branchNames,
+               size_t cacheSize = 64, bool readAhead = true, bool withQED = false)
+    : mContext(context), mChains(chains), mBranchNames(std::move(branchNames)), mCacheSize(std::max(size_t(2), cacheSize))
+  {
+    for (auto const& parts : mContext.getEventParts(withQED)) {
+      for (auto const& part : parts) {
+        mOrder.push_back(part);
+      }
+    }
+    if (readAhead && mOrder.size() > 1) {
+      // the chains open their files in the reader thread
+      ROOT::EnableThreadSafety();
+      mReader = std::thread([this]() { readAheadLoop(); });
+    }
+  }
+
+  ~HitReadAhead()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mCacheMutex);
+      mStop = true;
+    }
+    mCondition.notify_all();
+    if (mReader.joinable()) {
+      mReader.join();
+    }
+  }
+
+  HitReadAhead(HitReadAhead const&) = delete;
+  HitReadAhead& operator=(HitReadAhead const&) = delete;
+
+  /// \return hits of the given event, one vector per branch in the order of the branch names
+  std::shared_ptr<const EventHits> get(int sourceID, int entryID)
+  {
+    const auto key = makeKey(sourceID, entryID);
+    {
+      std::lock_guard<std::mutex> lock(mCacheMutex);
+      ++mNRequested;
+      mCondition.notify_all();
+      if (auto hits = lookup(key)) {
+        ++mNHits;
+        return hits;
+      }
+    }
+    // the event might be read in this moment by the reader thread: wait for the read and look again
+    std::lock_guard<std::mutex> readLock(mReadMutex);
+    {
+      std::lock_guard<std::mutex> lock(mCacheMutex);
+      if (auto hits = lookup(key)) {
+        ++mNHits;
+        return hits;
+      }
+    }
+    auto hits = read(sourceID, entryID);
+    std::lock_guard<std::mutex> lock(mCacheMutex);
+    insert(key, hits);
+    return hits;
+  }
+
+  /// \return number of requests which were served from the cache
+  size_t getNCacheHits() const { return mNHits; }
+
+  /// \return number of events read from the chains
+  size_t getNReads() const { return mNReads; }
+
+ private:
+  using Key = uint64_t;
+  using LRUList = std::list<std::pair<Key, std::shared_ptr<const EventHits>>>;
+
+  static Key makeKey(int sourceID, int entryID) { return (Key(uint32_t(sourceID)) << 32) | uint32_t(entryID); }
+
+  /// read the hits of one event from the chains, to be called with the read mutex locked
+  std::shared_ptr<const EventHits> read(int sourceID, int entryID)
+  {
+    auto hits = std::make_shared<EventHits>(mBranchNames.size());
+    for (size_t i = 0; i < mBranchNames.size(); ++i) {
+      mContext.retrieveHits(mChains, mBranchNames[i].c_str(), sourceID, entryID, &(*hits)[i]);
+    }
+    ++mNReads;
+    return hits;
+  }
+
+  /// \return event from the cache and mark it as most recently used, nullptr if not cached. Needs the cache mutex
+  std::shared_ptr<const EventHits> lookup(Key key)
+  {
+    auto it = mIndex.find(key);
+    if (it == mIndex.end()) {
+      return nullptr;
+    }
+    mLRU.splice(mLRU.begin(), mLRU, it->second);
+    return it->second->second;
+  }
+
+  /// add event to the cache as most recently used and drop the least recently used ones. Needs the cache mutex
+  void insert(Key key, std::shared_ptr<const EventHits> hits)
+  {
+    if (mIndex.count(key)) {
+      return;
+    }
+    mLRU.emplace_front(key, std::move(hits));
+    mIndex[key] = mLRU.begin();
+    while (mLRU.size() > mCacheSize) {
+      mIndex.erase(mLRU.back().first);
+      mLRU.pop_back();
+    }
+  }
+
+  void readAheadLoop()
+  {
+    const size_t maxAhead = mCacheSize / 2;
+    for (size_t next = 0; next < mOrder.size(); ++next) {
+      const auto part = mOrder[next];
+      const auto key = makeKey(part.sourceID, part.entryID);
+      {
+        std::unique_lock<std::mutex> lock(mCacheMutex);
+        mCondition.wait(lock, [this, next, maxAhead]() { return mStop || next < mNRequested + maxAhead; });
+        if (mStop) {
+          return;
+        }
+        if (next < mNRequested || mIndex.count(key)) {
+          continue; // already requested by the caller or still cached
+        }
+      }
+      std::lock_guard<std::mutex> readLock(mReadMutex);
+      {
+        // the caller might have read the event while waiting for the chains
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        if (mIndex.count(key)) {
+          continue;
+        }
+      }
+      auto hits = read(part.sourceID, part.entryID);
+      std::lock_guard<std::mutex> lock(mCacheMutex);
+      insert(key, std::move(hits));
+    }
+  }
+
+  DigitizationContext const& mContext;
+  std::vector<TChain*> const& mChains;
+  std::vector<std::string> mBranchNames;
+  std::vector<EventPart> mOrder; ///< events in the order of the collisions
+  size_t mCacheSize = 0;
+
+  LRUList mLRU;                                               ///< cached events, most recently used first
+  std::unordered_map<Key, typename LRUList::iterator> mIndex; ///< position of the cached events in the LRU list
+  size_t mNRequested = 0;                                     ///< number of events requested by the caller
+  std::atomic<size_t> mNHits{0};                              ///< number of requests served from the cache
+  std::atomic<size_t> mNReads{0};                             ///< number of events read from the chains
+  bool mStop = false;                                         ///< request to stop the reader thread
+
+  std::mutex mCacheMutex; ///< protects the cache and the counters
+  std::mutex mReadMutex;  ///< serializes the access to the chains
+  std::condition_variable mCondition;
+  std::thread mReader;
+};
+
+} // namespace steer
+} // namespace o2
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test HitReadAhead class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "Steer/HitReadAhead.h"
+#include <TFile.h>
+#include <TTree.h>
+#include <TChain.h>
+#include <set>
+#include <vector>
+
+namespace o2
+{
+namespace steer
+{
+
+BOOST_AUTO_TEST_CASE(HitReadAheadTest)
+{
+  // mockup hits file, the hits of each event contain the event number
+  const int nEvents = 20;
+  {
+    TFile file("o2sim_HitReadAhead.root", "RECREATE");
+    TTree tree("o2sim", "");
+    std::vector<float> hits;
+    auto hitsP = &hits;
+    tree.Branch("Hits", &hitsP);
+    for (int i = 0; i < nEvents; ++i) {
+      hits.assign(i + 1, float(i));
+      tree.Fill();
+    }
+    tree.Write();
+    file.Close();
+  }
+  std::vector<TChain*> chains{new TChain("o2sim")};
+  chains[0]->AddFile("o2sim_HitReadAhead.root");
+
+  // the background event 0 is embedded in every collision
+  DigitizationContext context;
+  auto& parts = context.getEventParts();
+  std::set<int> events;
+  for (int i = 1; i < nEvents; ++i) {
+    parts.push_back({EventPart(0, 0), EventPart(0, i)});
+    events.insert(i);
+  }
+  events.insert(0);
+
+  for (bool readAhead : {false, true}) {
+    HitReadAhead<float> reader(context, chains, {"Hits"}, 4, readAhead);
+    int nErrors = 0;
+    for (auto const& collision : parts) {
+      for (auto const& part : collision) {
+        auto hits = reader.get(part.sourceID, part.entryID);
+        auto const& eventHits = (*hits)[0];
+        nErrors += (eventHits.size() != size_t(part.entryID + 1)) || (eventHits.size() && eventHits[0] != part.entryID);
+      }
+    }
+    BOOST_CHECK_EQUAL(nErrors, 0);
+    BOOST_CHECK_EQUAL(reader.getNReads(), events.size());
+    if (!readAhead) {
+      BOOST_CHECK_EQUAL(reader.getNCacheHits(), 2 * parts.size() - events.size());
+    }
+  }
+}
+
+} // namespace steer
+} // namespace o2
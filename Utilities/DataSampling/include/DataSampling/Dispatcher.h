@@ -17,13 +17,17 @@
 #ifndef ALICEO2_DISPATCHER_H
 #define ALICEO2_DISPATCHER_H
 
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <memory>
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/DeviceSpec.h"
 #include "Framework/Task.h"
+#include "Framework/ConcreteDataMatcher.h"
+#include "Headers/DataHeader.h"
 
 #include <fairmq/FwdDecls.h>
 #include "DataSampling/DataSamplingHeader.h"
@@ -67,13 +71,24 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, fair::mq::Message* inputPayload, const framework::Output& output) const;
+
+  /// a policy which requires the data of an input together with the output data type of the policy
+  struct SamplingRoute {
+    DataSamplingPolicy* policy;
+    framework::ConcreteDataTypeMatcher output;
+  };
+  using RouteKey = std::tuple<header::DataOrigin, header::DataDescription, header::DataHeader::SubSpecificationType>;
+  /// \brief Returns the policies which require the data of the input, the matching is done once per input.
+  const std::vector<SamplingRoute>& getSamplingRoutes(const framework::ConcreteDataMatcher& input);
 
   std::string mName;
   DataSamplingHeader::DeviceIDType mDeviceID = "invalid";
   std::string mReconfigurationSource;
   // policies should be shared between all pipeline threads
   std::vector<std::shared_ptr<DataSamplingPolicy>> mPolicies;
+  // policies matching each of the inputs seen so far
+  std::map<RouteKey, std::vector<SamplingRoute>> mSamplingRoutes;
 };
 
 } // namespace o2::utilities
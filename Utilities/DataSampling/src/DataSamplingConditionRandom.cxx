@@ -20,6 +20,9 @@
 #include "Framework/DataProcessingHeader.h"
 
 #include "PCG/pcg_random.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
 #include <random>
 
 #include <boost/property_tree/ptree.hpp>
@@ -32,6 +35,55 @@ namespace o2::utilities
 // todo: consider using run number as a seed
 using namespace o2::header;
 
+/// \brief The pseudo-random numbers of one seed, drawn once per TimesliceID.
+///
+/// The sequence is shared between all random conditions with the same seed and TimesliceID, so that many policies
+/// sampling the same data with different fractions draw one number per timeslice and only compare it against their
+/// thresholds. As a consequence, the timeslices sampled with a fraction are a subset of those sampled with a larger one.
+class RandomSequence
+{
+ public:
+  explicit RandomSequence(uint64_t seed) : mGenerator(seed) {}
+
+  /// \brief Returns the number drawn for the TimesliceID.
+  uint32_t get(uint64_t tid)
+  {
+    int64_t diff = tid - mCurrentTimesliceID;
+    if (diff == -1) {
+      return mLastValue;
+    } else if (diff < -1) {
+      mGenerator.backstep(static_cast<uint64_t>(-diff));
+    } else if (diff > 0) {
+      mGenerator.advance(static_cast<uint64_t>(diff));
+    }
+
+    mLastValue = mGenerator();
+    mCurrentTimesliceID = tid + 1;
+    return mLastValue;
+  }
+
+  /// \brief Returns the sequence shared by all conditions with the seed and the TimesliceID type.
+  static std::shared_ptr<RandomSequence> getShared(uint64_t seed, const std::string& timesliceID)
+  {
+    static std::mutex mutex;
+    static std::map<std::pair<uint64_t, std::string>, std::weak_ptr<RandomSequence>> sequences;
+
+    std::lock_guard lock(mutex);
+    auto& entry = sequences[{seed, timesliceID}];
+    auto sequence = entry.lock();
+    if (!sequence) {
+      sequence = std::make_shared<RandomSequence>(seed);
+      entry = sequence;
+    }
+    return sequence;
+  }
+
+ private:
+  pcg32_fast mGenerator;
+  uint64_t mCurrentTimesliceID = 0;
+  uint32_t mLastValue = std::numeric_limits<uint32_t>::max();
+};
+
 /// \brief A DataSamplingCondition which makes decisions randomly, but with determinism.
 class DataSamplingConditionRandom : public DataSamplingCondition
 {
@@ -39,10 +91,7 @@ class DataSamplingConditionRandom : public DataSamplingCondition
  public:
   /// \brief Constructor.
   DataSamplingConditionRandom() : DataSamplingCondition(),
-                                  mThreshold(0),
-                                  mGenerator(0),
-                                  mCurrentTimesliceID(0),
-                                  mLastDecision(false){};
+                                  mThreshold(0){};
   /// \brief Default destructor
   ~DataSamplingConditionRandom() override = default;
 
@@ -51,13 +100,12 @@ class DataSamplingConditionRandom : public DataSamplingCondition
   {
     mThreshold = static_cast<uint32_t>(config.get<double>("fraction") * std::numeric_limits<uint32_t>::max());
 
-    auto seed = config.get<uint64_t>("seed");
-    mGenerator.seed((seed == 0) ? std::random_device()() : seed);
+    auto timeslideID = config.get_optional<std::string>("timesliceId").value_or("startTime");
 
-    mCurrentTimesliceID = 0;
-    mLastDecision = false;
+    // a random seed is not shared with other conditions
+    auto seed = config.get<uint64_t>("seed");
+    mSequence = (seed == 0) ? std::make_shared<RandomSequence>(std::random_device()()) : RandomSequence::getShared(seed, timeslideID);
 
-    auto timeslideID = config.get_optional<std::string>("timesliceId").value_or("startTime");
     if (timeslideID == "startTime") {
       mGetTimesliceID = [](const o2::framework::DataRef& dataRef) {
         const auto* dph = get<DataProcessingHeader*>(dataRef.header);
@@ -84,27 +132,12 @@ class DataSamplingConditionRandom : public DataSamplingCondition
   /// The reason behind using TimesliceID is to ensure, that data of the same events is sampled even on different FLPs.
   bool decide(const o2::framework::DataRef& dataRef) override
   {
-    auto tid = mGetTimesliceID(dataRef);
-
-    int64_t diff = tid - mCurrentTimesliceID;
-    if (diff == -1) {
-      return mLastDecision;
-    } else if (diff < -1) {
-      mGenerator.backstep(static_cast<uint64_t>(-diff));
-    } else if (diff > 0) {
-      mGenerator.advance(static_cast<uint64_t>(diff));
-    }
-
-    mLastDecision = mGenerator() < mThreshold;
-    mCurrentTimesliceID = tid + 1;
-    return mLastDecision;
+    return mSequence->get(mGetTimesliceID(dataRef)) < mThreshold;
   }
 
  private:
   uint32_t mThreshold;
-  pcg32_fast mGenerator;
-  bool mLastDecision;
-  uint64_t mCurrentTimesliceID;
+  std::shared_ptr<RandomSequence> mSequence;
   std::function<uint64_t(const o2::framework::DataRef&)> mGetTimesliceID;
 };
 
@@ -73,6 +73,8 @@ void Dispatcher::init(InitContext& ctx)
     }
   }
 
+  mSamplingRoutes.clear();
+
   auto& spec = ctx.services().get<const DeviceSpec>();
   mDeviceID.runtimeInit(spec.id.substr(0, DataSamplingHeader::deviceIDTypeSize).c_str());
 }
@@ -83,6 +85,14 @@ void Dispatcher::run(ProcessingContext& ctx)
   //  it is not trivial though, we would have to share state with the customize() method,
   //  which is not possible atm.
 
+  // The decisions of all policies are taken for the whole timeslice before sending anything,
+  // so that the policies matching an input and their conditions are evaluated once per input.
+  struct Sample {
+    size_t position;
+    ConcreteDataTypeMatcher output;
+    DataSamplingHeader dsheader;
+  };
+  std::vector<Sample> samples;
   for (auto inputIt = ctx.inputs().begin(); inputIt != ctx.inputs().end(); inputIt++) {
 
     const DataRef& firstPart = inputIt.getByPos(0);
@@ -92,32 +102,36 @@ void Dispatcher::run(ProcessingContext& ctx)
     const auto* firstInputHeader = DataRefUtils::getHeader<header::DataHeader*>(firstPart);
     ConcreteDataMatcher inputMatcher{firstInputHeader->dataOrigin, firstInputHeader->dataDescription, firstInputHeader->subSpecification};
 
-    for (auto& policy : mPolicies) {
-      // fixme: in principle matching could be broken by having query "TST/RAWDATA/0" and having parts with just
-      //  the first subspec == 0, but others could be different. However, we trust that DPL does necessary checks
-      //  during workflow validation and when passing messages (e.g. query "TST/RAWDATA/0" should not match
-      //  a "TST/RAWDATA/*" output.
-      if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
-        auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
-        auto dsheader = prepareDataSamplingHeader(*policy);
-        for (const auto& part : inputIt) {
-          if (part.header != nullptr) {
-            // We copy every header which is not DataHeader or DataProcessingHeader,
-            // so that custom data-dependent headers are passed forward,
-            // and we add a DataSamplingHeader.
-            header::Stack headerStack{
-              std::move(extractAdditionalHeaders(part.header)),
-              dsheader};
-            const auto* partInputHeader = DataRefUtils::getHeader<header::DataHeader*>(part);
-
-            Output output{
-              routeAsConcreteDataType.origin,
-              routeAsConcreteDataType.description,
-              partInputHeader->subSpecification,
-              std::move(headerStack)};
-            send(ctx.outputs(), part, output);
-          }
-        }
+    // fixme: in principle matching could be broken by having query "TST/RAWDATA/0" and having parts with just
+    //  the first subspec == 0, but others could be different. However, we trust that DPL does necessary checks
+    //  during workflow validation and when passing messages (e.g. query "TST/RAWDATA/0" should not match
+    //  a "TST/RAWDATA/*" output.
+    for (const auto& route : getSamplingRoutes(inputMatcher)) {
+      if (route.policy->decide(firstPart)) {
+        samples.push_back({inputIt.position(), route.output, prepareDataSamplingHeader(*route.policy)});
+      }
+    }
+  }
+
+  for (const auto& sample : samples) {
+    const auto nParts = ctx.inputs().getNofParts(sample.position);
+    for (size_t partIndex = 0; partIndex < nParts; partIndex++) {
+      const DataRef part = ctx.inputs().getByPos(sample.position, partIndex);
+      if (part.header != nullptr) {
+        // We copy every header which is not DataHeader or DataProcessingHeader,
+        // so that custom data-dependent headers are passed forward,
+        // and we add a DataSamplingHeader.
+        header::Stack headerStack{
+          std::move(extractAdditionalHeaders(part.header)),
+          sample.dsheader};
+        const auto* partInputHeader = DataRefUtils::getHeader<header::DataHeader*>(part);
+
+        Output output{
+          sample.output.origin,
+          sample.output.description,
+          partInputHeader->subSpecification,
+          std::move(headerStack)};
+        send(ctx.outputs(), part, ctx.inputs().getPayloadMessage(sample.position, partIndex), output);
       }
     }
   }
@@ -170,15 +184,34 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+const std::vector<Dispatcher::SamplingRoute>& Dispatcher::getSamplingRoutes(const ConcreteDataMatcher& input)
+{
+  auto [it, inserted] = mSamplingRoutes.try_emplace(RouteKey{input.origin, input.description, input.subSpec});
+  if (inserted) {
+    for (auto& policy : mPolicies) {
+      if (auto route = policy->match(input); route != nullptr) {
+        it->second.push_back({policy.get(), DataSpecUtils::asConcreteDataTypeMatcher(*route)});
+      }
+    }
+  }
+  return it->second;
+}
+
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, fair::mq::Message* inputPayload, const Output& output) const
 {
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
-  dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  if (inputPayload != nullptr) {
+    // the sampled message references the payload of the input, the data is not copied if the transports allow it
+    dataAllocator.forwardPayload(output, *inputPayload, inputHeader->payloadSerializationMethod);
+  } else {
+    dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  }
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)
 {
   mPolicies.emplace_back(std::move(policy));
+  mSamplingRoutes.clear();
 }
 
 const std::string& Dispatcher::getName()
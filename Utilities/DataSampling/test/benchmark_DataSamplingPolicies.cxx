@@ -0,0 +1,86 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_DataSamplingPolicies.cxx
+/// \brief Benchmark of the decisions of a Dispatcher handling many Data Sampling Policies with random conditions
+
+#include <benchmark/benchmark.h>
+#include <boost/property_tree/ptree.hpp>
+
+#include "DataSampling/DataSamplingConditionFactory.h"
+#include "DataSampling/DataSamplingPolicy.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Framework/DataRef.h"
+#include "Headers/DataHeader.h"
+#include "Headers/Stack.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+using namespace o2::utilities;
+using namespace o2::header;
+
+static std::vector<std::unique_ptr<DataSamplingPolicy>> createPolicies(size_t nPolicies, bool sameSeed)
+{
+  std::vector<std::unique_ptr<DataSamplingPolicy>> policies;
+  for (size_t i = 0; i < nPolicies; i++) {
+    auto policy = std::make_unique<DataSamplingPolicy>("benchmark" + std::to_string(i));
+    auto condition = DataSamplingConditionFactory::create("random");
+    boost::property_tree::ptree config;
+    config.put("fraction", std::to_string(static_cast<double>(i + 1) / nPolicies));
+    config.put("seed", std::to_string(sameSeed ? 22222 : 22222 + i));
+    condition->configure(config);
+    policy->registerCondition(std::move(condition));
+    policies.push_back(std::move(policy));
+  }
+  return policies;
+}
+
+// Each timeslice consists of several messages, which are evaluated by all policies, as in Dispatcher::run()
+static void decideForAllPolicies(benchmark::State& state, bool sameSeed)
+{
+  const size_t nPolicies = state.range(0);
+  const size_t nMessagesPerTimeslice = 16;
+  auto policies = createPolicies(nPolicies, sameSeed);
+
+  DataProcessingHeader::StartTime timeslice = 0;
+  size_t accepted = 0;
+  for (auto _ : state) {
+    DataHeader dh{"RAWDATA", "TST", 0};
+    DataProcessingHeader dph{timeslice++, 0};
+    Stack headerStack{dh, dph};
+    DataRef ref{nullptr, reinterpret_cast<const char*>(headerStack.data()), nullptr};
+    for (size_t m = 0; m < nMessagesPerTimeslice; m++) {
+      for (auto& policy : policies) {
+        accepted += policy->decide(ref);
+      }
+    }
+  }
+  benchmark::DoNotOptimize(accepted);
+  state.SetItemsProcessed(state.iterations() * nMessagesPerTimeslice * nPolicies);
+}
+
+static void BM_ManyPoliciesSameSeed(benchmark::State& state)
+{
+  decideForAllPolicies(state, true);
+}
+
+static void BM_ManyPoliciesDifferentSeeds(benchmark::State& state)
+{
+  decideForAllPolicies(state, false);
+}
+
+BENCHMARK(BM_ManyPoliciesSameSeed)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_ManyPoliciesDifferentSeeds)->RangeMultiplier(4)->Range(1, 256);
+
+BENCHMARK_MAIN();
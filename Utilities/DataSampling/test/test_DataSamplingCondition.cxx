@@ -73,6 +73,36 @@ BOOST_AUTO_TEST_CASE(DataSamplingConditionRandom)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DataSamplingConditionRandomShared)
+{
+  // conditions with the same seed draw the same numbers, independently of the order of evaluation
+  std::vector<std::unique_ptr<DataSamplingCondition>> conditions;
+  for (const auto* fraction : {"0.2", "0.5", "0.8"}) {
+    conditions.push_back(DataSamplingConditionFactory::create("random"));
+    boost::property_tree::ptree config;
+    config.put("fraction", fraction);
+    config.put("seed", "943753948");
+    conditions.back()->configure(config);
+  }
+
+  std::vector<bool> correctDecision{
+    true, false, true, false, true, false, false, true, false, false, true, true, false, false, true, false, false,
+    true, false, false, true, true, true, false, false, false, true, false, true, true, true, false, false, true,
+    false, false, false, false, false, false, true, false, false, true, false, false, true, false, false};
+  for (DataProcessingHeader::StartTime id = 1; id < 50; id++) {
+    DataProcessingHeader dph{id, 0};
+    o2::header::Stack headerStack{dph};
+    DataRef dr{nullptr, reinterpret_cast<const char*>(headerStack.data()), nullptr};
+    bool decision02 = conditions[0]->decide(dr);
+    bool decision08 = conditions[2]->decide(dr);
+    bool decision05 = conditions[1]->decide(dr);
+    BOOST_CHECK_EQUAL(correctDecision[id - 1], decision05);
+    // the timeslices sampled with a smaller fraction are a subset of those sampled with a larger one
+    BOOST_CHECK(!decision02 || decision05);
+    BOOST_CHECK(!decision05 || decision08);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(DataSamplingConditionPayloadSize)
 {
   auto conditionPayloadSize = DataSamplingConditionFactory::create("payloadSize");
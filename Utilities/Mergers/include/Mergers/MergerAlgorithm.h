@@ -25,13 +25,16 @@ namespace o2::mergers::algorithm
 {
 
 /// \brief A function which merges TObjects
-void merge(TObject* const target, TObject* const other);
+///
+/// If the objects are TCollections, their members are merged on up to nThreads threads. Members which are missing
+/// in the target are cloned beforehand in the calling thread, since cloning registers objects in global ROOT lists.
+void merge(TObject* const target, TObject* const other, size_t nThreads = 1);
 /// \brief A function which merges two vectors of TObjects
 ///
 /// Iterates through others vector and searches for the object with the same name in targets vector.
 /// If such item exists it is merged into the target object. If not than the item is pushed to the end
-/// of targets vector.
-void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others);
+/// of targets vector. The pairs of objects with the same name are merged on up to nThreads threads.
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, size_t nThreads = 1);
 
 void deleteTCollections(TObject* obj);
 
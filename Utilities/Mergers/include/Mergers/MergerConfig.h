@@ -58,7 +58,8 @@ enum class PublicationDecision {
 enum class TopologySize {
   NumberOfLayers,  // User specifies the number of layers in topology.
   ReductionFactor, // User specifies how many sources should be handled by one merger (by maximum).
-  MergersPerLayer  // User specifies how many Mergers should be spawned in each layer.
+  MergersPerLayer, // User specifies how many Mergers should be spawned in each layer.
+  Auto             // User specifies the expected size of an input object in bytes, the reduction factor is chosen to respect the data volume per Merger.
 };
 
 enum class ParallelismType {
@@ -97,6 +98,7 @@ struct MergerConfig {
   std::string detectorName = "TST";
   ConfigEntry<ParallelismType> parallelismType = {ParallelismType::SplitInputs};
   std::vector<o2::framework::DataProcessorLabel> labels;
+  size_t mergingThreads = 1; // Number of threads used to merge independent objects of a collection or a vector.
 };
 
 } // namespace o2::mergers
@@ -63,6 +63,11 @@ class MergerInfrastructureBuilder
   std::string validateConfig();
   std::vector<size_t> computeNumberOfMergersPerLayer(const size_t inputs) const;
 
+  /// data volume which one Merger is expected to handle in one cycle with TopologySize::Auto
+  static constexpr size_t AutoBytesPerMerger = 256 * 1024 * 1024;
+  /// the largest number of inputs of one Merger with TopologySize::Auto, even for small objects
+  static constexpr size_t AutoMaxReductionFactor = 64;
+
  private:
   std::string mInfrastructureName;
   framework::Inputs mInputs;
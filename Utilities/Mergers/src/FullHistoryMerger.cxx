@@ -160,7 +160,7 @@ void FullHistoryMerger::mergeCache()
     for (auto& [name, entry] : mCache) {
       (void)name;
       auto other = std::get<TObjectPtr>(entry);
-      algorithm::merge(target.get(), other.get());
+      algorithm::merge(target.get(), other.get(), mConfig.mergingThreads);
       mObjectsMerged++;
     }
 
@@ -177,7 +177,7 @@ void FullHistoryMerger::mergeCache()
     auto target = std::get<VectorOfTObjectPtrs>(mMergedObject);
     for (auto& [_, entry] : mCache) {
       auto other = std::get<VectorOfTObjectPtrs>(entry);
-      algorithm::merge(target, other);
+      algorithm::merge(target, other, mConfig.mergingThreads);
       mObjectsMerged += target.size();
     }
   }
@@ -110,7 +110,7 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
     // We expect that if the first object was TObject, then all should.
     auto targetAsTObject = std::get<TObjectPtr>(target);
     auto otherAsTObject = std::get<TObjectPtr>(other);
-    algorithm::merge(targetAsTObject.get(), otherAsTObject.get());
+    algorithm::merge(targetAsTObject.get(), otherAsTObject.get(), mConfig.mergingThreads);
   } else if (std::holds_alternative<MergeInterfacePtr>(target)) {
     // We expect that if the first object inherited MergeInterface, then all should.
     auto otherAsMergeInterface = std::get<MergeInterfacePtr>(other);
@@ -119,7 +119,7 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
     // We expect that if the first object was Vector of TObjects, then all should.
     auto targetAsVector = std::get<VectorOfTObjectPtrs>(target);
     const auto otherAsVector = std::get<VectorOfTObjectPtrs>(other);
-    algorithm::merge(targetAsVector, otherAsVector);
+    algorithm::merge(targetAsVector, otherAsVector, mConfig.mergingThreads);
   } else {
     LOG(error) << "The target variant has an unrecognized value";
   }
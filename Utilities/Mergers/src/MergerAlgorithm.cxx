@@ -29,6 +29,14 @@
 #include <THnSparse.h>
 #include <TObjArray.h>
 #include <TTree.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 namespace o2::mergers::algorithm
 {
@@ -43,7 +51,134 @@ size_t estimateTreeSize(TTree* tree)
   return totalSize;
 }
 
-void merge(TObject* const target, TObject* const other)
+bool sameBinning(const TAxis* target, const TAxis* other)
+{
+  if (target->GetNbins() != other->GetNbins() || target->GetXmin() != other->GetXmin() || target->GetXmax() != other->GetXmax()) {
+    return false;
+  }
+  // labels may reorder the bins and axis ranges change the statistics, such histograms are left to TH1::Merge()
+  if (target->GetLabels() || other->GetLabels() || target->TestBit(TAxis::kAxisRange) || other->TestBit(TAxis::kAxisRange)) {
+    return false;
+  }
+  const auto* targetBins = target->GetXbins();
+  const auto* otherBins = other->GetXbins();
+  return targetBins->GetSize() == otherBins->GetSize() && std::equal(targetBins->GetArray(), targetBins->GetArray() + targetBins->GetSize(), otherBins->GetArray());
+}
+
+template <typename T, typename U>
+void addArrays(T* target, const U* other, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    target[i] += other[i];
+  }
+}
+
+/// Adds the bin contents and the errors of histograms of the same type and binning, TArrayT is the storage of the type
+template <typename TArrayT>
+void addBins(TH1* target, TH1* other)
+{
+  const size_t nCells = target->GetNcells();
+  const auto* otherContents = dynamic_cast<TArrayT*>(other)->GetArray();
+  if (target->GetSumw2N() > 0) {
+    if (other->GetSumw2N() > 0) {
+      addArrays(target->GetSumw2()->GetArray(), other->GetSumw2()->GetArray(), nCells);
+    } else {
+      // the errors of an unweighted histogram are given by its bin contents
+      addArrays(target->GetSumw2()->GetArray(), otherContents, nCells);
+    }
+  }
+  addArrays(dynamic_cast<TArrayT*>(target)->GetArray(), otherContents, nCells);
+}
+
+/// Adds the bin contents, the errors and the statistics of histograms of the same type and binning directly,
+/// which avoids the generic machinery of TH1::Merge(). Returns false if the histograms are not eligible.
+bool mergeSameBinning(TH1* target, TH1* other)
+{
+  const auto* cl = target->IsA();
+  if (cl != other->IsA() || target->GetBuffer() || other->GetBuffer()) {
+    return false;
+  }
+  const bool isFloat = cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class();
+  const bool isDouble = cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class();
+  if (!isFloat && !isDouble) {
+    return false;
+  }
+  if (!sameBinning(target->GetXaxis(), other->GetXaxis()) || !sameBinning(target->GetYaxis(), other->GetYaxis()) || !sameBinning(target->GetZaxis(), other->GetZaxis())) {
+    return false;
+  }
+
+  double targetStats[TH1::kNstat] = {0};
+  double otherStats[TH1::kNstat] = {0};
+  target->GetStats(targetStats);
+  other->GetStats(otherStats);
+  for (int i = 0; i < TH1::kNstat; i++) {
+    targetStats[i] += otherStats[i];
+  }
+  const double entries = target->GetEntries() + other->GetEntries();
+
+  if (other->GetSumw2N() > 0 && target->GetSumw2N() == 0) {
+    target->Sumw2();
+  }
+  if (isFloat) {
+    addBins<TArrayF>(target, other);
+  } else {
+    addBins<TArrayD>(target, other);
+  }
+
+  target->PutStats(targetStats);
+  target->SetEntries(entries);
+  return true;
+}
+
+/// Merges the pairs of independent objects on up to nThreads threads. The first exception is rethrown.
+void mergePairs(const std::vector<std::pair<TObject*, TObject*>>& pairs, size_t nThreads)
+{
+  nThreads = std::min(nThreads, pairs.size());
+  // the same target may appear more than once if the other objects have duplicate names, such pairs cannot run concurrently
+  std::unordered_set<TObject*> targets;
+  for (const auto& pair : pairs) {
+    if (nThreads > 1 && !targets.insert(pair.first).second) {
+      nThreads = 1;
+    }
+  }
+  if (nThreads <= 1) {
+    for (const auto& [target, other] : pairs) {
+      merge(target, other);
+    }
+    return;
+  }
+
+  ROOT::EnableThreadSafety();
+  std::atomic<size_t> next{0};
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto worker = [&]() {
+    for (size_t i = next++; i < pairs.size(); i = next++) {
+      try {
+        merge(pairs[i].first, pairs[i].second);
+      } catch (...) {
+        std::lock_guard lock(exceptionMutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1);
+  for (size_t t = 1; t < nThreads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void merge(TObject* const target, TObject* const other, size_t nThreads)
 {
   if (target == nullptr) {
     throw std::runtime_error("Merging target is nullptr");
@@ -70,18 +205,20 @@ void merge(TObject* const target, TObject* const other)
                                "' is a TCollection, while the other object '" + other->GetName() + "' is not.");
     }
 
+    std::vector<std::pair<TObject*, TObject*>> pairs;
     auto otherIterator = otherCollection->MakeIterator();
     while (auto otherObject = otherIterator->Next()) {
       TObject* targetObject = targetCollection->FindObject(otherObject->GetName());
       if (targetObject) {
         // That might be another collection or a concrete object to be merged, we walk on the collection recursively.
-        merge(targetObject, otherObject);
+        pairs.emplace_back(targetObject, otherObject);
       } else {
         // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
         targetCollection->Add(otherObject->Clone());
       }
     }
     delete otherIterator;
+    mergePairs(pairs, nThreads);
   } else {
     Long64_t errorCode = 0;
     TObjArray otherCollection;
@@ -97,7 +234,7 @@ void merge(TObject* const target, TObject* const other)
         if (auto otherTH1 = dynamic_cast<TH1*>(otherCollection.First())) {
           errorCode = targetTH1->Add(otherTH1);
         }
-      } else {
+      } else if (auto otherTH1 = dynamic_cast<TH1*>(other); otherTH1 == nullptr || !mergeSameBinning(targetTH1, otherTH1)) {
         // Add() does not support histograms with labels, thus we resort to Merge() by default
         errorCode = targetTH1->Merge(&otherCollection);
       }
@@ -129,18 +266,20 @@ void merge(TObject* const target, TObject* const other)
   }
 }
 
-void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others)
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, size_t nThreads)
 {
+  std::vector<std::pair<TObject*, TObject*>> pairs;
   for (const auto& other : others) {
     if (const auto targetSameName = std::find_if(targets.begin(), targets.end(), [&other](const auto& target) {
           return std::string_view{other->GetName()} == std::string_view{target->GetName()};
         });
         targetSameName != targets.end()) {
-      merge(targetSameName->get(), other.get());
+      pairs.emplace_back(targetSameName->get(), other.get());
     } else {
       targets.push_back(std::shared_ptr<TObject>(other->Clone(), deleteTCollections));
     }
   }
+  mergePairs(pairs, nThreads);
 }
 
 void deleteRecursive(TCollection* Coll)
@@ -20,6 +20,8 @@
 
 #include "Framework/DataSpecUtils.h"
 
+#include <algorithm>
+
 using namespace o2::framework;
 
 namespace o2::mergers
@@ -70,8 +72,8 @@ std::string MergerInfrastructureBuilder::validateConfig()
     error += preamble + "invalid output\n";
   }
 
-  if ((mConfig.topologySize.value == TopologySize::NumberOfLayers || mConfig.topologySize.value == TopologySize::ReductionFactor) && !std::holds_alternative<int>(mConfig.topologySize.param)) {
-    error += preamble + "TopologySize::NumberOfLayers and TopologySize::ReductionFactor require a single int as parameter\n";
+  if ((mConfig.topologySize.value == TopologySize::NumberOfLayers || mConfig.topologySize.value == TopologySize::ReductionFactor || mConfig.topologySize.value == TopologySize::Auto) && !std::holds_alternative<int>(mConfig.topologySize.param)) {
+    error += preamble + "TopologySize::NumberOfLayers, TopologySize::ReductionFactor and TopologySize::Auto require a single int as parameter\n";
   } else {
     if (mConfig.topologySize.value == TopologySize::NumberOfLayers && std::get<int>(mConfig.topologySize.param) < 1) {
       error += preamble + "number of layers less than 1 (" + std::to_string(std::get<int>(mConfig.topologySize.param)) + ")\n";
@@ -79,6 +81,9 @@ std::string MergerInfrastructureBuilder::validateConfig()
     if (mConfig.topologySize.value == TopologySize::ReductionFactor && std::get<int>(mConfig.topologySize.param) < 2) {
       error += preamble + "reduction factor smaller than 2 (" + std::to_string(std::get<int>(mConfig.topologySize.param)) + ")\n";
     }
+    if (mConfig.topologySize.value == TopologySize::Auto && std::get<int>(mConfig.topologySize.param) < 1) {
+      error += preamble + "expected object size smaller than 1 byte (" + std::to_string(std::get<int>(mConfig.topologySize.param)) + ")\n";
+    }
   }
   if (mConfig.topologySize.value == TopologySize::MergersPerLayer) {
     if (!std::holds_alternative<std::vector<size_t>>(mConfig.topologySize.param)) {
@@ -200,7 +205,7 @@ std::vector<size_t> MergerInfrastructureBuilder::computeNumberOfMergersPerLayer(
       mergersPerLayer.push_back(static_cast<size_t>(ceil(pow(inputs, (L - i) / static_cast<double>(L)))));
     }
 
-  } else if (mConfig.topologySize.value == TopologySize::ReductionFactor) {
+  } else if (mConfig.topologySize.value == TopologySize::ReductionFactor || mConfig.topologySize.value == TopologySize::Auto) {
     //              _        _
     //             |  |V|     |  where:
     //  |V|  ---   |  | |i-1  |  R   - reduction factor
@@ -208,7 +213,10 @@ std::vector<size_t> MergerInfrastructureBuilder::computeNumberOfMergersPerLayer(
     //             |    R     |  M_i - number of mergers in i layer
     //
 
-    double R = std::get<int>(mConfig.topologySize.param);
+    // with TopologySize::Auto, R is the number of objects of the expected size which fit in the data volume of one Merger
+    double R = mConfig.topologySize.value == TopologySize::ReductionFactor
+                 ? std::get<int>(mConfig.topologySize.param)
+                 : std::clamp<size_t>(AutoBytesPerMerger / std::get<int>(mConfig.topologySize.param), 2, AutoMaxReductionFactor);
     size_t Mi, prevMi = inputs;
     do {
       Mi = static_cast<size_t>(ceil(prevMi / R));
@@ -305,6 +305,63 @@ BOOST_AUTO_TEST_CASE(MergerCollection)
   delete target;
 }
 
+BOOST_AUTO_TEST_CASE(MergerCollectionParallel)
+{
+  const size_t nHistos = 20;
+  TObjArray* target = new TObjArray();
+  target->SetOwner(true);
+  TObjArray* other = new TObjArray();
+  other->SetOwner(true);
+  for (size_t i = 0; i < nHistos; i++) {
+    auto name = "histo " + std::to_string(i);
+    auto targetTH1I = new TH1I(name.c_str(), name.c_str(), bins, min, max);
+    targetTH1I->Fill(5);
+    target->Add(targetTH1I);
+    auto otherTH1I = new TH1I(name.c_str(), name.c_str(), bins, min, max);
+    otherTH1I->Fill(static_cast<double>(i % bins));
+    other->Add(otherTH1I);
+  }
+  other->Add(new CustomMergeableTObject("custom", 1));
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, other, 4));
+  delete other;
+
+  BOOST_REQUIRE_EQUAL(target->GetEntries(), nHistos + 1);
+  for (size_t i = 0; i < nHistos; i++) {
+    auto resultTH1I = dynamic_cast<TH1I*>(target->At(i));
+    BOOST_REQUIRE(resultTH1I != nullptr);
+    BOOST_CHECK_EQUAL(resultTH1I->GetEntries(), 2);
+    BOOST_CHECK_EQUAL(resultTH1I->GetBinContent(resultTH1I->FindBin(i % bins)), i % bins == 5 ? 2 : 1);
+  }
+  BOOST_CHECK(target->FindObject("custom") != nullptr);
+
+  delete target;
+}
+
+BOOST_AUTO_TEST_CASE(MergerSameBinning, *boost::unit_test::tolerance(1e-9))
+{
+  TH2D target("histo 2d", "histo 2d", bins, min, max, bins, min, max);
+  TH2D other("histo 2d", "histo 2d", bins, min, max, bins, min, max);
+  for (size_t i = 0; i < 100; i++) {
+    target.Fill(i % bins, (i * 3) % bins);
+    other.Fill((i * 7) % bins, i % bins, 0.5);
+  }
+  std::unique_ptr<TH2D> reference(dynamic_cast<TH2D*>(target.Clone("reference")));
+  TObjArray otherCollection;
+  otherCollection.Add(&other);
+  reference->Merge(&otherCollection);
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(&target, &other));
+
+  BOOST_CHECK_EQUAL(target.GetEntries(), reference->GetEntries());
+  BOOST_TEST(target.GetMean(1) == reference->GetMean(1));
+  BOOST_TEST(target.GetStdDev(2) == reference->GetStdDev(2));
+  for (int bin = 0; bin < target.GetNcells(); bin++) {
+    BOOST_TEST(target.GetBinContent(bin) == reference->GetBinContent(bin));
+    BOOST_TEST(target.GetBinError(bin) == reference->GetBinError(bin));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Deleting)
 {
   TObjArray* main = new TObjArray();
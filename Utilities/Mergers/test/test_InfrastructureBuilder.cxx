@@ -200,6 +200,49 @@ BOOST_AUTO_TEST_CASE(InfrastructureBuilderReductionFactor)
   }
 }
 
+BOOST_AUTO_TEST_CASE(InfrastructureBuilderAuto)
+{
+  MergerInfrastructureBuilder builder;
+  builder.setInfrastructureName("name");
+  builder.setInputSpecs({{"one", "TST", "test", 1},
+                         {"two", "TST", "test", 2},
+                         {"thr", "TST", "test", 3},
+                         {"fou", "TST", "test", 4},
+                         {"fiv", "TST", "test", 5},
+                         {"six", "TST", "test", 6},
+                         {"sev", "TST", "test", 7}});
+  builder.setOutputSpec({{"main"}, "TST", "test", 0});
+  MergerConfig config;
+
+  {
+    config.topologySize = {TopologySize::Auto, 0};
+    builder.setConfig(config);
+    BOOST_CHECK_THROW(builder.generateInfrastructure(), std::runtime_error);
+  }
+
+  {
+    // small objects, one Merger handles all inputs
+    config.topologySize = {TopologySize::Auto, 1000};
+    builder.setConfig(config);
+    auto mergersTopology = builder.generateInfrastructure();
+
+    BOOST_REQUIRE_EQUAL(mergersTopology.size(), 1);
+    BOOST_CHECK_EQUAL(mergersTopology[0].inputs.size(), 8); // 7 inputs + 1 timer
+  }
+
+  {
+    // large objects, the reduction factor becomes 2
+    config.topologySize = {TopologySize::Auto, 200 * 1024 * 1024};
+    builder.setConfig(config);
+    auto mergersTopology = builder.generateInfrastructure();
+
+    BOOST_REQUIRE_EQUAL(mergersTopology.size(), 7); // 4 + 2 + 1
+    BOOST_CHECK_EQUAL(mergersTopology[0].inputs.size(), 3);
+    BOOST_CHECK_EQUAL(mergersTopology[3].inputs.size(), 2);
+    BOOST_CHECK_EQUAL(mergersTopology[6].inputs.size(), 3);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(InfrastructureBuilderMergersPerLayer)
 {
   MergerInfrastructureBuilder builder;
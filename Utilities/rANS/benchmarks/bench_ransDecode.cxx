@@ -101,8 +101,9 @@ inline const SourceMessageProxyUniform<uint8_t> sourceMessageUniform8{MessageSiz
 inline const SourceMessageProxyUniform<uint16_t> sourceMessageUniform16{MessageSize};
 inline const SourceMessageProxyUniform<uint32_t> sourceMessageUniform32{MessageSize};
 
-template <class... Args>
-void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
+// scalar_V forces the scalar round robin decoder by hiding the encoded buffer behind a non-pointer iterator
+template <CoderTag coderTag_V, bool scalar_V, class... Args>
+void ransDecodeBenchmarkImpl(benchmark::State& st, Args&&... args)
 {
 
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -119,7 +120,7 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   Metrics<source_type> metrics{histogram};
   const auto renormedHistogram = renorm(histogram, metrics, RenormingPolicy::Auto, 10);
 
-  auto encoder = makeDenseEncoder<>::fromRenormed(renormedHistogram);
+  auto encoder = makeDenseEncoder<coderTag_V>::fromRenormed(renormedHistogram);
   encodeBuffer.encodeBufferEnd = encoder.process(inputData.data(), inputData.data() + inputData.size(), encodeBuffer.buffer.data());
 
   auto decoder = makeDecoder<>::fromRenormed(renormedHistogram);
@@ -127,7 +128,12 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   __itt_resume();
 #endif
   for (auto _ : st) {
-    decoder.process(encodeBuffer.encodeBufferEnd, decodeBuffer.buffer.data(), inputData.size(), encoder.getNStreams());
+    if constexpr (scalar_V) {
+      gsl::span<const uint32_t> encoded{encodeBuffer.buffer.data(), encodeBuffer.encodeBufferEnd};
+      decoder.process(encoded.end(), decodeBuffer.buffer.data(), inputData.size(), encoder.getNStreams());
+    } else {
+      decoder.process(encodeBuffer.encodeBufferEnd, decodeBuffer.buffer.data(), inputData.size(), encoder.getNStreams());
+    }
   }
 #ifdef ENABLE_VTUNE_PROFILER
   __itt_pause();
@@ -152,6 +158,26 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   st.counters["CompressionWRTEntropy"] = st.counters["CompressedSize"] / st.counters["LowerBound"];
 };
 
+template <class... Args>
+void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
+{
+  ransDecodeBenchmarkImpl<defaults::DefaultTag, false>(st, std::forward<Args>(args)...);
+};
+
+template <class... Args>
+void ransDecodeScalarBenchmark(benchmark::State& st, Args&&... args)
+{
+  ransDecodeBenchmarkImpl<defaults::DefaultTag, true>(st, std::forward<Args>(args)...);
+};
+
+#ifdef RANS_AVX512
+template <class... Args>
+void ransDecodeAVX512Benchmark(benchmark::State& st, Args&&... args)
+{
+  ransDecodeBenchmarkImpl<CoderTag::AVX512, false>(st, std::forward<Args>(args)...);
+};
+#endif /* RANS_AVX512 */
+
 // BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_binomial_8, sourceMessageBinomial8);
 // BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_binomial_16, sourceMessageBinomial16);
 // BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_binomial_32, sourceMessageBinomial32);
@@ -160,4 +186,14 @@ BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_8, sourceMessageUniform8);
 BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_16, sourceMessageUniform16);
 BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_32, sourceMessageUniform32);
 
+BENCHMARK_CAPTURE(ransDecodeScalarBenchmark, decodeScalar_uniform_8, sourceMessageUniform8);
+BENCHMARK_CAPTURE(ransDecodeScalarBenchmark, decodeScalar_uniform_16, sourceMessageUniform16);
+BENCHMARK_CAPTURE(ransDecodeScalarBenchmark, decodeScalar_uniform_32, sourceMessageUniform32);
+
+#ifdef RANS_AVX512
+BENCHMARK_CAPTURE(ransDecodeAVX512Benchmark, decodeAVX512_uniform_8, sourceMessageUniform8);
+BENCHMARK_CAPTURE(ransDecodeAVX512Benchmark, decodeAVX512_uniform_16, sourceMessageUniform16);
+BENCHMARK_CAPTURE(ransDecodeAVX512Benchmark, decodeAVX512_uniform_32, sourceMessageUniform32);
+#endif /* RANS_AVX512 */
+
 BENCHMARK_MAIN();
\ No newline at end of file
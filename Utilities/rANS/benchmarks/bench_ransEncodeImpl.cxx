@@ -187,6 +187,20 @@ struct SIMDFixture : public benchmark::Fixture {
           &symbolTable[sourceMessage[i + 3]],
         });
       }
+#ifdef RANS_AVX512
+      if constexpr (width_V == simd::SIMDWidth::AVX512) {
+        mSymbols.push_back({
+          &symbolTable[sourceMessage[i]],
+          &symbolTable[sourceMessage[i + 1]],
+          &symbolTable[sourceMessage[i + 2]],
+          &symbolTable[sourceMessage[i + 3]],
+          &symbolTable[sourceMessage[i + 4]],
+          &symbolTable[sourceMessage[i + 5]],
+          &symbolTable[sourceMessage[i + 6]],
+          &symbolTable[sourceMessage[i + 7]],
+        });
+      }
+#endif /* RANS_AVX512 */
     }
   }
 
@@ -223,8 +237,9 @@ ransState_t simpleEncode(ransState_t state, size_t symbolTablePrecision, const S
 template <simd::SIMDWidth width_V>
 inline auto SIMDEncode(simd::simdI_t<width_V> states, simd::simdD_t<width_V> nSamples, gsl::span<const Symbol*, simd::getElementCount<ransState_t>(width_V)> symbols)
 {
-  simd::simdIsse_t frequencies;
-  simd::simdIsse_t cumulativeFrequencies;
+  using frequencies_type = std::remove_reference_t<decltype(std::declval<simd::unrolledSymbols_t<width_V>>().frequencies[0])>;
+  frequencies_type frequencies;
+  frequencies_type cumulativeFrequencies;
   simd::aosToSoa(symbols, &frequencies, &cumulativeFrequencies);
   return simd::ransEncode(states, simd::int32ToDouble<width_V>(frequencies), simd::int32ToDouble<width_V>(cumulativeFrequencies), nSamples);
 };
@@ -355,6 +370,26 @@ BENCHMARK_TEMPLATE_DEFINE_F(SIMDFixture, encodeAVX_32, uint32_t, simd::SIMDWidth
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+BENCHMARK_TEMPLATE_DEFINE_F(SIMDFixture, encodeAVX512_8, uint8_t, simd::SIMDWidth::AVX512)
+(benchmark::State& st)
+{
+  ransSIMDEncodeBenchmark(st, *this);
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(SIMDFixture, encodeAVX512_16, uint16_t, simd::SIMDWidth::AVX512)
+(benchmark::State& st)
+{
+  ransSIMDEncodeBenchmark(st, *this);
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(SIMDFixture, encodeAVX512_32, uint32_t, simd::SIMDWidth::AVX512)
+(benchmark::State& st)
+{
+  ransSIMDEncodeBenchmark(st, *this);
+};
+#endif /* RANS_AVX512 */
+
 BENCHMARK_REGISTER_F(SimpleFixture, simpleEncode_8);
 BENCHMARK_REGISTER_F(SimpleFixture, simpleEncode_16);
 BENCHMARK_REGISTER_F(SimpleFixture, simpleEncode_32);
@@ -375,6 +410,12 @@ BENCHMARK_REGISTER_F(SIMDFixture, encodeSSE_32);
 BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX_8);
 BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX_16);
 BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX_32);
-#endif /* RANS_SSE */
+#endif /* RANS_AVX2 */
+
+#ifdef RANS_AVX512
+BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX512_8);
+BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX512_16);
+BENCHMARK_REGISTER_F(SIMDFixture, encodeAVX512_32);
+#endif /* RANS_AVX512 */
 
 BENCHMARK_MAIN();
@@ -53,6 +53,10 @@ using coder_types = boost::mp11::mp_list<std::integral_constant<CoderTag, CoderT
                                          ,
                                          std::integral_constant<CoderTag, CoderTag::AVX2>
 #endif /* RANS_AVX2 */
+#ifdef RANS_AVX512
+                                         ,
+                                         std::integral_constant<CoderTag, CoderTag::AVX512>
+#endif /* RANS_AVX512 */
                                          >;
 
 // using coder_types = boost::mp11::mp_list<std::integral_constant<CoderTag, CoderTag::SingleStream>>;
@@ -72,6 +76,9 @@ std::string toString(CoderTag tag)
     case CoderTag::AVX2:
       return {"AVX2"};
       break;
+    case CoderTag::AVX512:
+      return {"AVX512"};
+      break;
     default:
       throw Exception("Invalid");
       break;
@@ -23,5 +23,6 @@
 #include "rANS/internal/containers/DenseSymbolTable.h"
 #include "rANS/internal/containers/Symbol.h"
 #include "rANS/internal/encode/Encoder.h"
+#include "rANS/internal/encode/StreamingEncoder.h"
 
 #endif /* RANS_ENCODE_H_ */
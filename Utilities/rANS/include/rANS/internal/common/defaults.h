@@ -29,7 +29,8 @@ namespace o2::rans
 enum class CoderTag : uint8_t { Compat,
                                 SingleStream,
                                 SSE,
-                                AVX2 };
+                                AVX2,
+                                AVX512 };
 
 using count_t = uint32_t;
 
@@ -24,6 +24,12 @@
 #ifdef RANS_SSE
 #error RANS_SSE cannot be directly set
 #endif
+#ifdef RANS_AVX512
+#error RANS_AVX512 cannot be directly set
+#endif
+#ifdef RANS_AVX512_DISPATCH
+#error RANS_AVX512_DISPATCH cannot be directly set
+#endif
 #ifdef RANS_SINGLE_STREAM
 #error RANS_AVX cannot be directly set
 #endif
@@ -54,6 +60,13 @@
 #if defined(__AVX2__)
 #define RANS_AVX2
 #endif // AVX2
+#if defined(__AVX2__) && defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512VL__) && defined(__AVX512BW__)
+#define RANS_AVX512
+#endif // AVX512
+#if defined(__GNUC__)
+// kernels compiled with function level target attributes, selected at runtime on CPUs supporting them
+#define RANS_AVX512_DISPATCH
+#endif // GNUC
 #endif // x86
 
 #if (defined(RANS_SSE) && !defined(RANS_AVX2))
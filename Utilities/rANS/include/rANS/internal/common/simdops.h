@@ -101,6 +101,43 @@ inline __m256d load(gsl::span<const double_t, getElementCount<double_t>(SIMDWidt
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline __m512i load(const AlignedArray<T, SIMDWidth::AVX512>& v) noexcept
+{
+  return _mm512_load_si512(reinterpret_cast<const __m512i*>(v.data()));
+};
+
+inline __m512d load(const pd_t<SIMDWidth::AVX512>& v) noexcept
+{
+  return _mm512_load_pd(v.data());
+};
+
+template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline __m512i load(gsl::span<const T, getElementCount<T>(SIMDWidth::AVX512)> v) noexcept
+{
+  return _mm512_load_si512(reinterpret_cast<const __m512i*>(v.data()));
+};
+
+template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline __m512i load(gsl::span<T, getElementCount<T>(SIMDWidth::AVX512)> v) noexcept
+{
+  return _mm512_load_si512(reinterpret_cast<const __m512i*>(v.data()));
+};
+
+inline __m512d load(gsl::span<double_t, getElementCount<double_t>(SIMDWidth::AVX512)> v) noexcept
+{
+  return _mm512_load_pd(v.data());
+};
+
+inline __m512d load(gsl::span<const double_t, getElementCount<double_t>(SIMDWidth::AVX512)> v) noexcept
+{
+  return _mm512_load_pd(v.data());
+};
+
+#endif /* RANS_AVX512 */
+
 template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
 inline AlignedArray<T, SIMDWidth::SSE> store(__m128i inVec) noexcept
 {
@@ -157,13 +194,47 @@ inline void store(__m256d inVec, gsl::span<double_t, getElementCount<double>(SIM
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline AlignedArray<T, SIMDWidth::AVX512> store(__m512i inVec) noexcept
+{
+  AlignedArray<T, SIMDWidth::AVX512> out;
+  _mm512_store_si512(reinterpret_cast<__m512i*>(out.data()), inVec);
+  return out;
+};
+
+inline AlignedArray<double_t, SIMDWidth::AVX512> store(__m512d inVec) noexcept
+{
+  AlignedArray<double_t, SIMDWidth::AVX512> out;
+  _mm512_store_pd(out.data(), inVec);
+  return out;
+};
+
+template <typename T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+inline void store(__m512i inVec, gsl::span<T, getElementCount<T>(SIMDWidth::AVX512)> v) noexcept
+{
+  _mm512_store_si512(reinterpret_cast<__m512i*>(v.data()), inVec);
+};
+
+inline void store(__m512d inVec, gsl::span<double_t, getElementCount<double>(SIMDWidth::AVX512)> v) noexcept
+{
+  _mm512_store_pd(v.data(), inVec);
+};
+
+#endif /* RANS_AVX512 */
+
 template <SIMDWidth width_V>
 inline auto setAll(uint64_t value) noexcept
 {
   if constexpr (width_V == SIMDWidth::SSE) {
     return _mm_set1_epi64x(value);
-  } else {
+  } else if constexpr (width_V == SIMDWidth::AVX) {
     return _mm256_set1_epi64x(value);
+  } else {
+#ifdef RANS_AVX512
+    return _mm512_set1_epi64(value);
+#endif /* RANS_AVX512 */
   }
 };
 
@@ -172,8 +243,12 @@ inline auto setAll(uint32_t value) noexcept
 {
   if constexpr (width_V == SIMDWidth::SSE) {
     return _mm_set1_epi32(value);
-  } else {
+  } else if constexpr (width_V == SIMDWidth::AVX) {
     return _mm256_set1_epi32(value);
+  } else {
+#ifdef RANS_AVX512
+    return _mm512_set1_epi32(value);
+#endif /* RANS_AVX512 */
   }
 };
 
@@ -182,8 +257,12 @@ inline auto setAll(uint16_t value) noexcept
 {
   if constexpr (width_V == SIMDWidth::SSE) {
     return _mm_set1_epi16(value);
-  } else {
+  } else if constexpr (width_V == SIMDWidth::AVX) {
     return _mm256_set1_epi16(value);
+  } else {
+#ifdef RANS_AVX512
+    return _mm512_set1_epi16(value);
+#endif /* RANS_AVX512 */
   }
 };
 
@@ -192,8 +271,12 @@ inline auto setAll(uint8_t value) noexcept
 {
   if constexpr (width_V == SIMDWidth::SSE) {
     return _mm_set1_epi8(value);
-  } else {
+  } else if constexpr (width_V == SIMDWidth::AVX) {
     return _mm256_set1_epi8(value);
+  } else {
+#ifdef RANS_AVX512
+    return _mm512_set1_epi8(value);
+#endif /* RANS_AVX512 */
   }
 };
 
@@ -202,8 +285,12 @@ inline auto setAll(double_t value) noexcept
 {
   if constexpr (width_V == SIMDWidth::SSE) {
     return _mm_set1_pd(value);
-  } else {
+  } else if constexpr (width_V == SIMDWidth::AVX) {
     return _mm256_set1_pd(value);
+  } else {
+#ifdef RANS_AVX512
+    return _mm512_set1_pd(value);
+#endif /* RANS_AVX512 */
   }
 };
 
@@ -222,6 +309,15 @@ inline auto int32ToDouble(__m128i in) noexcept
   }
 };
 
+#ifdef RANS_AVX512
+template <SIMDWidth width_V>
+inline auto int32ToDouble(__m256i in) noexcept
+{
+  static_assert(width_V == SIMDWidth::AVX512);
+  return _mm512_cvtepi32_pd(in);
+};
+#endif /* RANS_AVX512 */
+
 //
 // uint64 -> double
 // Only works for inputs in the range: [0, 2^52)
@@ -296,6 +392,34 @@ inline __m256i doubleToUint64(__m256d in) noexcept
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+//
+// uint64 <-> double
+// AVX512DQ provides exact conversions, the range is limited to [0, 2^52) for consistency with SSE and AVX2
+//
+inline __m512d uint64ToDouble(__m512i in) noexcept
+{
+#if !defined(NDEBUG)
+  auto vec = store<uint64_t>(in);
+  for (auto i : gsl::make_span(vec)) {
+    assert(i < utils::pow2(52));
+  }
+#endif
+  return _mm512_cvtepu64_pd(in);
+};
+
+inline __m512i doubleToUint64(__m512d in) noexcept
+{
+#if !defined(NDEBUG)
+  auto vec = store(in);
+  for (auto i : gsl::make_span(vec)) {
+    assert(i < utils::pow2(52));
+  }
+#endif
+  return _mm512_cvtpd_epu64(in);
+}
+#endif /* RANS_AVX512 */
+
 template <SIMDWidth>
 struct DivMod;
 
@@ -336,6 +460,23 @@ inline DivMod<SIMDWidth::AVX> divMod(__m256d numerator, __m256d denominator) noe
 }
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+template <>
+struct DivMod<SIMDWidth::AVX512> {
+  __m512d div;
+  __m512d mod;
+};
+
+// calculate both floor(a/b) and a%b
+inline DivMod<SIMDWidth::AVX512> divMod(__m512d numerator, __m512d denominator) noexcept
+{
+  __m512d div = _mm512_roundscale_pd(_mm512_div_pd(numerator, denominator), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+  __m512d mod = _mm512_fnmadd_pd(div, denominator, numerator);
+  return {div, mod};
+}
+#endif /* RANS_AVX512 */
+
 inline __m128i cmpgeq_epi64(__m128i a, __m128i b) noexcept
 {
   __m128i cmpGreater = _mm_cmpgt_epi64(a, b);
@@ -30,7 +30,8 @@ namespace o2::rans::internal::simd
 {
 
 enum class SIMDWidth : uint32_t { SSE = 128u,
-                                  AVX = 256u };
+                                  AVX = 256u,
+                                  AVX512 = 512u };
 
 [[nodiscard]] inline constexpr size_t getLaneWidthBits(SIMDWidth width) noexcept { return static_cast<size_t>(width); };
 
@@ -86,6 +87,13 @@ struct SimdInt<SIMDWidth::AVX> {
 };
 #endif
 
+#ifdef RANS_AVX512
+template <>
+struct SimdInt<SIMDWidth::AVX512> {
+  using value_type = __m512i;
+};
+#endif
+
 template <SIMDWidth width_V>
 using simdI_t = typename SimdInt<width_V>::value_type;
 
@@ -93,6 +101,9 @@ using simdIsse_t = simdI_t<SIMDWidth::SSE>;
 #ifdef RANS_AVX2
 using simdIavx_t = simdI_t<SIMDWidth::AVX>;
 #endif
+#ifdef RANS_AVX512
+using simdIavx512_t = simdI_t<SIMDWidth::AVX512>;
+#endif
 
 template <SIMDWidth>
 struct SimdDouble;
@@ -109,6 +120,13 @@ struct SimdDouble<SIMDWidth::AVX> {
 };
 #endif
 
+#ifdef RANS_AVX512
+template <>
+struct SimdDouble<SIMDWidth::AVX512> {
+  using value_type = __m512d;
+};
+#endif
+
 template <SIMDWidth width_V>
 using simdD_t = typename SimdDouble<width_V>::value_type;
 
@@ -116,6 +134,9 @@ using simdDsse_t = simdD_t<SIMDWidth::SSE>;
 #ifdef RANS_AVX2
 using simdDavx_t = simdD_t<SIMDWidth::AVX>;
 #endif
+#ifdef RANS_AVX512
+using simdDavx512_t = simdD_t<SIMDWidth::AVX512>;
+#endif
 } // namespace o2::rans::internal::simd
 
 #endif /* RANS_SIMD */
@@ -59,6 +59,12 @@ struct getCoderTag<AVXEncoderImpl<lowerBound_V>> : public std::integral_constant
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <size_t lowerBound_V>
+struct getCoderTag<AVX512EncoderImpl<lowerBound_V>> : public std::integral_constant<CoderTag, CoderTag::AVX512> {
+};
+#endif /* RANS_AVX512 */
+
 template <class encoderImpl_T, class symbolTable_T, size_t nStreams_V>
 struct getCoderTag<Encoder<encoderImpl_T, symbolTable_T, nStreams_V>> : public getCoderTag<encoderImpl_T> {
 };
@@ -101,6 +107,12 @@ struct getStreamingLowerBound<AVXEncoderImpl<lowerBound_V>> : public std::integr
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <size_t lowerBound_V>
+struct getStreamingLowerBound<AVX512EncoderImpl<lowerBound_V>> : public std::integral_constant<size_t, lowerBound_V> {
+};
+#endif /* RANS_AVX512 */
+
 template <size_t lowerBound_V>
 struct getStreamingLowerBound<DecoderImpl<lowerBound_V>> : public std::integral_constant<size_t, lowerBound_V> {
 };
@@ -16,12 +16,15 @@
 #ifndef RANS_INTERNAL_DECODE_DECODER_CONCEPT_H_
 #define RANS_INTERNAL_DECODE_DECODER_CONCEPT_H_
 
+#include <algorithm>
 #include <fairlogger/Logger.h>
 #include <gsl/span>
 #include <stdexcept>
+#include <vector>
 
 #include "rANS/internal/common/utils.h"
 #include "rANS/internal/containers/RenormedHistogram.h"
+#include "rANS/internal/decode/simdDecoderKernel.h"
 
 namespace o2::rans
 {
@@ -94,9 +97,25 @@ class DecoderConcept
         inputIter = decoder.init(inputIter);
       }
 
-      const size_t nLoops = messageLength / nStreams;
+      size_t nLoops = messageLength / nStreams;
       const size_t nLoopRemainder = messageLength % nStreams;
 
+#ifdef RANS_AVX512_DISPATCH
+      // interleaved vectorized decoding if the CPU supports it, the result is identical to the scalar loop below
+      if constexpr (std::is_pointer_v<stream_IT>) {
+        if (nLoops > 0 && internal::simd::isAVX512Decodable(nStreams)) {
+          std::vector<typename coder_type::state_type> states(nStreams);
+          std::transform(decoders.begin(), decoders.end(), states.begin(), [](const auto& decoder) { return decoder.getState(); });
+          inputIter = internal::simd::decodeAVX512(states.data(), nStreams, nLoops, this->mSymbolTable.getPrecision(), coder_type::getStreamingLowerBound(),
+                                                   inputIter, outputIter, lookupSymbol);
+          for (size_t i = 0; i < nStreams; ++i) {
+            decoders[i].setState(states[i]);
+          }
+          nLoops = 0;
+        }
+      }
+#endif /* RANS_AVX512_DISPATCH */
+
       for (size_t i = 0; i < nLoops; ++i) {
 #if defined(RANS_OPENMP)
 #pragma omp unroll partial(2)
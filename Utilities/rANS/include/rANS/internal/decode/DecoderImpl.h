@@ -51,6 +51,12 @@ class DecoderImpl
 
   [[nodiscard]] inline static constexpr size_type getNstreams() noexcept { return N_STREAMS; };
 
+  [[nodiscard]] inline static constexpr state_type getStreamingLowerBound() noexcept { return LOWER_BOUND; };
+
+  // access to the state for vectorized decoding of multiple interleaved decoders
+  [[nodiscard]] inline state_type getState() const noexcept { return mState; };
+  inline void setState(state_type state) noexcept { mState = state; };
+
  private:
   state_type mState{};
   size_type mSymbolTablePrecission{};
@@ -0,0 +1,154 @@
+// Copyright 2019-2023 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   simdDecoderKernel.h
+/// @brief  Decoding of 8 interleaved rANS streams per AVX512 vector, selected at runtime.
+
+#ifndef RANS_INTERNAL_DECODE_SIMDDECODERKERNEL_H_
+#define RANS_INTERNAL_DECODE_SIMDDECODERKERNEL_H_
+
+#include "rANS/internal/common/defines.h"
+
+#ifdef RANS_AVX512_DISPATCH
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "rANS/internal/common/exceptions.h"
+#include "rANS/internal/common/utils.h"
+
+// compiled for AVX512 independently of the target architecture of the translation unit
+#define RANS_AVX512_TARGET __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw")))
+
+namespace o2::rans::internal::simd
+{
+
+inline constexpr size_t AVX512DecoderLanes = 8;
+
+[[nodiscard]] inline bool hasAVX512Decoder() noexcept
+{
+  static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                                __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw");
+  return supported;
+};
+
+// reverses the 8 bits of a lane mask
+[[nodiscard]] inline constexpr uint32_t reverse8(uint32_t mask) noexcept
+{
+  mask = ((mask >> 1) & 0x55u) | ((mask & 0x55u) << 1);
+  mask = ((mask >> 2) & 0x33u) | ((mask & 0x33u) << 2);
+  mask = ((mask >> 4) & 0x0Fu) | ((mask & 0x0Fu) << 4);
+  return mask;
+};
+
+template <size_t nVectors_V, typename stream_IT, typename source_IT, typename lookup_F>
+RANS_AVX512_TARGET stream_IT decodeAVX512Impl(uint64_t* __restrict__ states, size_t nLoops, size_t symbolTablePrecision, uint64_t lowerBound,
+                                              stream_IT inputIter, source_IT& outputIter, lookup_F&& lookup)
+{
+  const __m512i maskVec = _mm512_set1_epi64(utils::pow2(symbolTablePrecision) - 1);
+  const __m128i precisionVec = _mm_cvtsi64_si128(symbolTablePrecision);
+  const __m512i lowerBoundVec = _mm512_set1_epi64(lowerBound);
+  const __m256i reverseVec = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  __m512i stateVec[nVectors_V];
+  for (size_t v = 0; v < nVectors_V; ++v) {
+    stateVec[v] = _mm512_loadu_si512(states + v * AVX512DecoderLanes);
+  }
+
+  alignas(32) uint32_t cumulativeFrequencies[AVX512DecoderLanes];
+  uint64_t symbols[AVX512DecoderLanes];
+
+  // local copy, writes through a byte sized output type could otherwise alias the iterator
+  source_IT outputPos = outputIter;
+
+  for (size_t i = 0; i < nLoops; ++i) {
+#pragma GCC unroll 8
+    for (size_t v = 0; v < nVectors_V; ++v) {
+      __m512i cumulVec = _mm512_and_si512(stateVec[v], maskVec);
+      _mm256_store_si256(reinterpret_cast<__m256i*>(cumulativeFrequencies), _mm512_cvtepi64_epi32(cumulVec));
+
+#pragma GCC unroll 8
+      for (size_t lane = 0; lane < AVX512DecoderLanes; ++lane) {
+        const auto symbol = lookup(cumulativeFrequencies[lane]);
+        *outputPos++ = symbol.first;
+        symbols[lane] = static_cast<uint64_t>(symbol.second.getFrequency()) | (static_cast<uint64_t>(symbol.second.getCumulative()) << 32);
+      }
+      const __m512i symbolVec = _mm512_set_epi64(symbols[7], symbols[6], symbols[5], symbols[4], symbols[3], symbols[2], symbols[1], symbols[0]);
+
+      // s, x = D(x)
+      // frequency * (x >> precision) as two 32x32 bit multiplications, which are considerably faster than vpmullq
+      const __m512i quotientVec = _mm512_srl_epi64(stateVec[v], precisionVec);
+      __m512i newStateVec = _mm512_mul_epu32(symbolVec, quotientVec);
+      newStateVec = _mm512_add_epi64(newStateVec, _mm512_slli_epi64(_mm512_mul_epu32(symbolVec, _mm512_srli_epi64(quotientVec, 32)), 32));
+      newStateVec = _mm512_add_epi64(newStateVec, cumulVec);
+      newStateVec = _mm512_sub_epi64(newStateVec, _mm512_srli_epi64(symbolVec, 32));
+
+      // renormalize: the i-th renorming lane reads the word at inputIter - i. Only the nWords words ending at inputIter
+      // are loaded, the masked out lanes are not accessed.
+      const __mmask8 renormMask = _mm512_cmplt_epu64_mask(newStateVec, lowerBoundVec);
+      const uint32_t nWords = _mm_popcnt_u32(renormMask);
+      const __mmask8 loadMask = static_cast<__mmask8>(0xFF00u >> nWords);
+      __m256i words = _mm256_maskz_loadu_epi32(loadMask, inputIter - (AVX512DecoderLanes - 1));
+      words = _mm256_maskz_expand_epi32(renormMask, _mm256_permutexvar_epi32(reverseVec, words));
+      stateVec[v] = _mm512_mask_or_epi64(newStateVec, renormMask, _mm512_slli_epi64(newStateVec, 32), _mm512_cvtepu32_epi64(words));
+      inputIter -= nWords;
+    }
+  }
+
+  for (size_t v = 0; v < nVectors_V; ++v) {
+    _mm512_storeu_si512(states + v * AVX512DecoderLanes, stateVec[v]);
+  }
+  outputIter = outputPos;
+  return inputIter;
+};
+
+/// Decodes nLoops rounds of all nStreams interleaved streams, exactly reproducing the scalar round robin of DecoderConcept.
+/// The states of 8 consecutive streams are kept in one vector: symbols are looked up per lane and in stream order
+/// to keep the order of incompressible literals, while the state update and the renorming are vectorized.
+/// Renorming words are read backwards in stream order by a masked load, reversed and expanded into the renorming lanes.
+///
+/// @param states      states of the nStreams decoders, nStreams must be 32 or 64
+/// @param inputIter   position of the next word to be read from the encoded stream
+/// @param lookup      callable returning the (source symbol, Symbol) pair for a cumulative frequency
+/// @return            position of the next word to be read after decoding
+template <typename stream_IT, typename source_IT, typename lookup_F>
+stream_IT decodeAVX512(uint64_t* states, size_t nStreams, size_t nLoops, size_t symbolTablePrecision, uint64_t lowerBound,
+                       stream_IT inputIter, source_IT& outputIter, lookup_F&& lookup)
+{
+  static_assert(std::is_pointer_v<stream_IT>);
+  static_assert(sizeof(std::remove_pointer_t<stream_IT>) == sizeof(uint32_t));
+
+  switch (nStreams / AVX512DecoderLanes) {
+    case 4:
+      return decodeAVX512Impl<4>(states, nLoops, symbolTablePrecision, lowerBound, inputIter, outputIter, lookup);
+    case 8:
+      return decodeAVX512Impl<8>(states, nLoops, symbolTablePrecision, lowerBound, inputIter, outputIter, lookup);
+    default:
+      throw DecodingError(fmt::format("Vectorized decoding of {} streams is not supported", nStreams));
+  }
+};
+
+/// Vectorized decoding is used for 32 or 64 streams, as produced by the AVX512 encoder. With fewer vectors in flight
+/// the latency of the chain lookup -> state update -> renorming of a vector is not hidden and the scalar decoder is faster.
+[[nodiscard]] inline bool isAVX512Decodable(size_t nStreams) noexcept
+{
+  return (nStreams == 32 || nStreams == 64) && hasAVX512Decoder();
+};
+
+} // namespace o2::rans::internal::simd
+
+#endif /* RANS_AVX512_DISPATCH */
+
+#endif /* RANS_INTERNAL_DECODE_SIMDDECODERKERNEL_H_ */
@@ -350,6 +350,75 @@ class EncoderSymbolMapper<symbolTable_T,
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <size_t streamingLowerBound_V, typename symbolTable_T, typename incompressible_IT>
+class EncoderSymbolMapper<symbolTable_T,
+                          AVX512EncoderImpl<streamingLowerBound_V>,
+                          incompressible_IT> : public EncoderSymbolMapperInterface<symbolTable_T,
+                                                                                   AVX512EncoderImpl<streamingLowerBound_V>,
+                                                                                   incompressible_IT,
+                                                                                   EncoderSymbolMapper<symbolTable_T, incompressible_IT>>
+{
+  using base_type = EncoderSymbolMapperInterface<symbolTable_T, AVX512EncoderImpl<streamingLowerBound_V>, incompressible_IT, EncoderSymbolMapper<symbolTable_T, incompressible_IT>>;
+
+ public:
+  using symbolTable_type = typename base_type::symbolTable_type;
+  using coder_type = typename base_type::coder_type;
+  using size_type = typename base_type::size_type;
+  using difference_type = typename base_type::difference_type;
+  using source_type = typename base_type::source_type;
+  using symbol_type = typename base_type::symbol_type;
+  using coderSymbol_type = typename base_type::coderSymbol_type;
+  using incompressible_iterator = typename base_type::incompressible_iterator;
+
+  static_assert(coder_type::getNstreams() == 16);
+
+  EncoderSymbolMapper() = default;
+
+  EncoderSymbolMapper(const symbolTable_type& symbolTable, incompressible_IT incompressibleIter = nullptr) : base_type{symbolTable, incompressibleIter} {};
+
+  template <typename source_IT>
+  [[nodiscard]] inline source_IT unpackSymbols(source_IT sourceIter, coderSymbol_type& unpacked)
+  {
+    using namespace simd;
+    std::array<const Symbol*, 16> ret;
+    for (size_t i = 0; i < ret.size(); ++i) {
+      ret[ret.size() - 1 - i] = &this->lookupSymbol(sourceIter - i);
+    }
+
+    aosToSoa(gsl::make_span(ret).template subspan<0, 8>(), &unpacked.frequencies[0], &unpacked.cumulativeFrequencies[0]);
+    aosToSoa(gsl::make_span(ret).template subspan<8, 8>(), &unpacked.frequencies[1], &unpacked.cumulativeFrequencies[1]);
+
+    return utils::advanceIter(sourceIter, -coder_type::getNstreams());
+  };
+
+  template <typename source_IT>
+  [[nodiscard]] inline source_IT unpackSymbols(source_IT sourceIter, coderSymbol_type& unpacked, size_type nActiveStreams)
+  {
+    using namespace internal::simd;
+
+    difference_type currentStream = nActiveStreams;
+
+    epi32_t<SIMDWidth::AVX, 2> frequencies;
+    epi32_t<SIMDWidth::AVX, 2> cumulativeFrequencies;
+
+    while (currentStream-- > 0) {
+      const auto& symbol = this->lookupSymbol(sourceIter--);
+      frequencies(currentStream) = symbol.getFrequency();
+      cumulativeFrequencies(currentStream) = symbol.getCumulative();
+    }
+
+    unpacked.frequencies[0] = load(frequencies[0]);
+    unpacked.frequencies[1] = load(frequencies[1]);
+
+    unpacked.cumulativeFrequencies[0] = load(cumulativeFrequencies[0]);
+    unpacked.cumulativeFrequencies[1] = load(cumulativeFrequencies[1]);
+
+    return sourceIter;
+  };
+};
+#endif /* RANS_AVX512 */
+
 } // namespace o2::rans::internal
 
 #endif /* RANS_INTERNAL_ENCODE_ENCODERSYMBOLMAPPER_H_ */
\ No newline at end of file
@@ -11,7 +11,7 @@
 
 /// @file   SIMDEncoderImpl.h
 /// @author Michael Lettrich
-/// @brief  rANS encoding operations that encode multiple symbols simultaniously using SIMD. Unified implementation for SSE4.1 and AVX2.
+/// @brief  rANS encoding operations that encode multiple symbols simultaniously using SIMD. Unified implementation for SSE4.1, AVX2 and AVX512.
 
 #ifndef RANS_INTERNAL_ENCODE_SIMDENCODERIMPL_H_
 #define RANS_INTERNAL_ENCODE_SIMDENCODERIMPL_H_
@@ -33,10 +33,10 @@ namespace o2::rans::internal
 {
 
 template <size_t streamingLowerBound_V, simd::SIMDWidth simdWidth_V>
-class SIMDEncoderImpl : public EncoderImpl<simd::UnrolledSymbols,
+class SIMDEncoderImpl : public EncoderImpl<simd::unrolledSymbols_t<simdWidth_V>,
                                            SIMDEncoderImpl<streamingLowerBound_V, simdWidth_V>>
 {
-  using base_type = EncoderImpl<simd::UnrolledSymbols, SIMDEncoderImpl<streamingLowerBound_V, simdWidth_V>>;
+  using base_type = EncoderImpl<simd::unrolledSymbols_t<simdWidth_V>, SIMDEncoderImpl<streamingLowerBound_V, simdWidth_V>>;
 
  public:
   using stream_type = typename base_type::stream_type;
@@ -64,6 +64,12 @@ class SIMDEncoderImpl : public EncoderImpl<simd::UnrolledSymbols,
 
   [[nodiscard]] inline static constexpr state_type getStreamingLowerBound() noexcept { return static_cast<state_type>(utils::pow2(streamingLowerBound_V)); };
 
+  // width of the vectors holding frequencies and cumulative frequencies of the unrolled symbols
+  [[nodiscard]] inline static constexpr simd::SIMDWidth getSymbolWidth() noexcept
+  {
+    return simdWidth_V == simd::SIMDWidth::SSE ? simd::SIMDWidth::SSE : static_cast<simd::SIMDWidth>(static_cast<uint32_t>(simdWidth_V) / 2);
+  };
+
  private:
   size_t mSymbolTablePrecision{};
   simd::simdI_t<simdWidth_V> mStates[2]{};
@@ -152,8 +158,8 @@ Stream_IT SIMDEncoderImpl<streamingLowerBound_V, simdWidth_V>::putSymbols(Stream
   store(mStates[0], states[0]);
   store(mStates[1], states[1]);
 
-  epi32_t<SIMDWidth::SSE, 2> frequencies;
-  epi32_t<SIMDWidth::SSE, 2> cumulativeFrequencies;
+  epi32_t<getSymbolWidth(), 2> frequencies;
+  epi32_t<getSymbolWidth(), 2> cumulativeFrequencies;
 
   store<uint32_t>(symbols.frequencies[0], frequencies[0]);
   store<uint32_t>(symbols.frequencies[1], frequencies[1]);
@@ -215,6 +221,10 @@ template <size_t streamingLowerBound_V>
 using SSEEncoderImpl = SIMDEncoderImpl<streamingLowerBound_V, simd::SIMDWidth::SSE>;
 template <size_t streamingLowerBound_V>
 using AVXEncoderImpl = SIMDEncoderImpl<streamingLowerBound_V, simd::SIMDWidth::AVX>;
+#ifdef RANS_AVX512
+template <size_t streamingLowerBound_V>
+using AVX512EncoderImpl = SIMDEncoderImpl<streamingLowerBound_V, simd::SIMDWidth::AVX512>;
+#endif /* RANS_AVX512 */
 
 } // namespace o2::rans::internal
 
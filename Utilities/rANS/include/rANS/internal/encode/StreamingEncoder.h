@@ -0,0 +1,131 @@
+// Copyright 2019-2023 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   StreamingEncoder.h
+/// @brief  Encoding of a source of arbitrary length in independent chunks with a bounded working set.
+
+#ifndef RANS_INTERNAL_ENCODE_STREAMINGENCODER_H_
+#define RANS_INTERNAL_ENCODE_STREAMINGENCODER_H_
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "rANS/internal/common/exceptions.h"
+#include "rANS/internal/common/utils.h"
+
+namespace o2::rans
+{
+
+/// Wraps an Encoder to encode a source in chunks of a fixed number of symbols.
+///
+/// rANS works like a stack, the symbols are encoded backwards so that the decoder can work forwards. Encoding a source
+/// as a single message therefore needs the complete source and an output buffer for all of it. Here the source is read
+/// forwards in a single pass, only the current chunk is buffered, encoded backwards and its final states are flushed,
+/// making every chunk an independent rANS message. The encoded chunk is handed to a sink, which can store it anywhere,
+/// in a growing buffer or a file. The working set is bounded by the chunk size, whatever the length of the source.
+///
+/// The decoder processes the chunks in forward order, each with the plain Decoder over the nSymbols and nStreamWords
+/// reported for the chunk. Incompressible symbols of each chunk are appended to the literals in chunk order: the
+/// literals of chunk i end after the literals of chunks 0..i, which is where the decoder of chunk i has to start.
+template <class encoder_T>
+class StreamingEncoder
+{
+ public:
+  using encoder_type = encoder_T;
+  using source_type = typename encoder_type::source_type;
+  using stream_type = typename encoder_type::stream_type;
+  using size_type = std::size_t;
+
+  static constexpr size_type DefaultChunkSize = utils::pow2(20);
+
+  /// description of an encoded chunk as passed to the sink
+  struct ChunkInfo {
+    size_type nSymbols{};     // number of encoded source symbols
+    size_type nStreamWords{}; // number of words of the encoded chunk
+    size_type nLiterals{};    // number of incompressible symbols of the chunk
+  };
+
+  StreamingEncoder(const encoder_type& encoder, size_type chunkSize = DefaultChunkSize) : mEncoder{&encoder}, mChunkSize{chunkSize}
+  {
+    if (mChunkSize < encoder_type::getNStreams()) {
+      throw EncodingError(fmt::format("chunk size {} is smaller than the number of streams {} of the encoder", mChunkSize, encoder_type::getNStreams()));
+    }
+  };
+
+  [[nodiscard]] inline size_type getChunkSize() const noexcept { return mChunkSize; };
+
+  [[nodiscard]] inline const encoder_type& getEncoder() const noexcept { return *mEncoder; };
+
+  /// upper bound of the encoded size of nSymbols: the renorming streams out at most one word per
+  /// symbol, and the final state of each stream takes 2 words.
+  [[nodiscard]] inline static constexpr size_type getMaxStreamSize(size_type nSymbols) noexcept
+  {
+    return nSymbols + 2 * encoder_type::getNStreams();
+  };
+
+  /// Encode the source range chunk by chunk, the source is iterated once in forward direction.
+  /// The sink is called for every chunk with signature
+  ///     void(const ChunkInfo& info, const stream_type* streamBegin, const stream_type* streamEnd)
+  /// @return end of the written literals if a literals iterator was provided
+  template <typename source_IT, typename sink_F, typename literals_IT = std::nullptr_t>
+  literals_IT process(source_IT srcBegin, source_IT srcEnd, sink_F&& sink, literals_IT literalsBegin = nullptr);
+
+ private:
+  const encoder_type* mEncoder{};
+  size_type mChunkSize{};
+  std::vector<source_type> mChunkBuffer{};
+  std::vector<stream_type> mStreamBuffer{};
+  std::vector<source_type> mLiteralsBuffer{};
+};
+
+template <class encoder_T>
+template <typename source_IT, typename sink_F, typename literals_IT>
+literals_IT StreamingEncoder<encoder_T>::process(source_IT srcBegin, source_IT srcEnd, sink_F&& sink, literals_IT literalsBegin)
+{
+  static_assert(std::is_convertible_v<typename std::iterator_traits<source_IT>::value_type, source_type>);
+
+  mChunkBuffer.reserve(mChunkSize);
+  mStreamBuffer.resize(getMaxStreamSize(mChunkSize));
+  literals_IT literalsIter = literalsBegin;
+
+  while (srcBegin != srcEnd) {
+    mChunkBuffer.clear();
+    for (; srcBegin != srcEnd && mChunkBuffer.size() < mChunkSize; ++srcBegin) {
+      mChunkBuffer.push_back(*srcBegin);
+    }
+
+    ChunkInfo info{mChunkBuffer.size(), 0, 0};
+    const source_type* chunkBegin = mChunkBuffer.data();
+    const source_type* chunkEnd = chunkBegin + mChunkBuffer.size();
+    stream_type* streamEnd{};
+    if constexpr (std::is_null_pointer_v<literals_IT>) {
+      streamEnd = mEncoder->process(chunkBegin, chunkEnd, mStreamBuffer.data());
+    } else {
+      mLiteralsBuffer.clear();
+      auto [encodedEnd, literalsEnd] = mEncoder->process(chunkBegin, chunkEnd, mStreamBuffer.data(), std::back_inserter(mLiteralsBuffer));
+      streamEnd = encodedEnd;
+      info.nLiterals = mLiteralsBuffer.size();
+      literalsIter = std::copy(mLiteralsBuffer.begin(), mLiteralsBuffer.end(), literalsIter);
+    }
+    utils::checkBounds(streamEnd, mStreamBuffer.data() + mStreamBuffer.size());
+    info.nStreamWords = std::distance(mStreamBuffer.data(), streamEnd);
+    sink(info, static_cast<const stream_type*>(mStreamBuffer.data()), static_cast<const stream_type*>(streamEnd));
+  }
+  return literalsIter;
+};
+
+} // namespace o2::rans
+
+#endif /* RANS_INTERNAL_ENCODE_STREAMINGENCODER_H_ */
@@ -11,7 +11,7 @@
 
 /// @file   Encoder.h
 /// @author Michael Lettrich
-/// @brief  Kernels performing SIMD rANS encoding using SSE 4.1 and AVX2.
+/// @brief  Kernels performing SIMD rANS encoding using SSE 4.1, AVX2 and AVX512.
 
 #ifndef RANS_INTERNAL_ENCODE_SIMDKERNEL_H_
 #define RANS_INTERNAL_ENCODE_SIMDKERNEL_H_
@@ -80,6 +80,29 @@ inline __m256i ransEncode(__m256i state, __m256d frequency, __m256d cumulative,
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+
+//
+// rans Encode
+//
+inline __m512i ransEncode(__m512i state, __m512d frequency, __m512d cumulative, __m512d normalization) noexcept
+{
+#if !defined(NDEBUG)
+  auto vec = store<uint64_t>(state);
+  for (auto i : gsl::make_span(vec)) {
+    assert(i < utils::pow2(52));
+  }
+#endif
+
+  auto [div, mod] = divMod(uint64ToDouble(state), frequency);
+  auto newState = _mm512_fmadd_pd(normalization, div, cumulative);
+  newState = _mm512_add_pd(newState, mod);
+
+  return doubleToUint64(newState);
+};
+
+#endif /* RANS_AVX512 */
+
 inline void aosToSoa(gsl::span<const Symbol*, 2> in, __m128i* __restrict__ frequency, __m128i* __restrict__ cumulatedFrequency) noexcept
 {
   __m128i in0Reg = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in[0]->data()));
@@ -119,6 +142,28 @@ inline auto computeMaxState(__m128i frequencyVec, uint8_t symbolTablePrecisionBi
   }
 };
 
+#ifdef RANS_AVX512
+inline void aosToSoa(gsl::span<const Symbol*, 8> in, __m256i* __restrict__ frequency, __m256i* __restrict__ cumulatedFrequency) noexcept
+{
+  __m128i frequencies[2];
+  __m128i cumulatedFrequencies[2];
+  aosToSoa(in.template subspan<0, 4>(), &frequencies[0], &cumulatedFrequencies[0]);
+  aosToSoa(in.template subspan<4, 4>(), &frequencies[1], &cumulatedFrequencies[1]);
+  *frequency = _mm256_set_m128i(frequencies[1], frequencies[0]);
+  *cumulatedFrequency = _mm256_set_m128i(cumulatedFrequencies[1], cumulatedFrequencies[0]);
+};
+
+template <SIMDWidth width_V, uint64_t lowerBound_V, uint8_t streamBits_V>
+inline __m512i computeMaxState(__m256i frequencyVec, uint8_t symbolTablePrecisionBits) noexcept
+{
+  static_assert(width_V == SIMDWidth::AVX512);
+  const uint64_t xmax = (lowerBound_V >> symbolTablePrecisionBits) << streamBits_V;
+  const uint8_t shift = log2UIntNZ(xmax);
+  __m512i frequencyVecEpi64 = _mm512_cvtepu32_epi64(frequencyVec);
+  return _mm512_slli_epi64(frequencyVecEpi64, shift);
+};
+#endif /* RANS_AVX512 */
+
 template <uint8_t streamBits_V>
 inline __m128i computeNewState(__m128i stateVec, __m128i cmpVec) noexcept
 {
@@ -470,6 +515,37 @@ inline StreamOutResult<SIMDWidth::AVX> streamOut(const __m256i* __restrict__ sta
 
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+// reverses the lowest 16 bits, i.e. maps the lane mask of a vector onto the mask of the vector with reversed lanes
+inline constexpr uint32_t reverse16(uint32_t mask) noexcept
+{
+  mask = ((mask >> 1) & 0x5555u) | ((mask & 0x5555u) << 1);
+  mask = ((mask >> 2) & 0x3333u) | ((mask & 0x3333u) << 2);
+  mask = ((mask >> 4) & 0x0F0Fu) | ((mask & 0x0F0Fu) << 4);
+  mask = ((mask >> 8) & 0x00FFu) | ((mask & 0x00FFu) << 8);
+  return mask;
+};
+
+template <>
+struct StreamOutResult<SIMDWidth::AVX512> {
+  uint32_t nElemens;
+  __mmask16 streamOutMask;
+  __m512i streamOutVec;
+};
+
+// AVX512 has no need for a permutation LUT: the lower 32 bits of all 16 states are packed into one vector
+// in reversed stream order and the streamed out words are compressed by the renorming mask when stored.
+inline StreamOutResult<SIMDWidth::AVX512> streamOut(const __m512i* __restrict__ stateVec, const __mmask8* __restrict__ cmpMask) noexcept
+{
+  __m512i statesFused = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtepi64_epi32(stateVec[0])), _mm512_cvtepi64_epi32(stateVec[1]), 1);
+  const __m512i reverse = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  __m512i streamOutVec = _mm512_permutexvar_epi32(reverse, statesFused);
+  const uint32_t id = reverse16(static_cast<uint32_t>(cmpMask[0]) | (static_cast<uint32_t>(cmpMask[1]) << 8));
+
+  return {static_cast<uint32_t>(_mm_popcnt_u32(id)), static_cast<__mmask16>(id), streamOutVec};
+};
+#endif /* RANS_AVX512 */
+
 template <SIMDWidth, typename output_IT>
 struct RenormResult;
 
@@ -487,6 +563,14 @@ struct RenormResult<SIMDWidth::AVX, output_IT> {
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <typename output_IT>
+struct RenormResult<SIMDWidth::AVX512, output_IT> {
+  output_IT outputIter;
+  __m512i newState;
+};
+#endif /* RANS_AVX512 */
+
 template <typename output_IT, uint64_t lowerBound_V, uint8_t streamBits_V>
 inline output_IT ransRenorm(const __m128i* __restrict__ state, const __m128i* __restrict__ frequency, uint8_t symbolTablePrecisionBits, output_IT outputIter, __m128i* __restrict__ newState) noexcept
 {
@@ -551,11 +635,68 @@ inline output_IT ransRenorm(const __m256i* state, const __m128i* __restrict__ fr
 };
 #endif /* RANS_AVX2 */
 
+#ifdef RANS_AVX512
+template <typename output_IT, uint64_t lowerBound_V, uint8_t streamBits_V>
+inline output_IT ransRenorm(const __m512i* state, const __m256i* __restrict__ frequency, uint8_t symbolTablePrecisionBits, output_IT outputIter, __m512i* __restrict__ newState) noexcept
+{
+  __m512i maxState[2];
+  __mmask8 cmp[2];
+
+  // calculate maximum state
+  maxState[0] = computeMaxState<SIMDWidth::AVX512, lowerBound_V, streamBits_V>(frequency[0], symbolTablePrecisionBits);
+  maxState[1] = computeMaxState<SIMDWidth::AVX512, lowerBound_V, streamBits_V>(frequency[1], symbolTablePrecisionBits);
+  // cmp = (state >= maxState)
+  cmp[0] = _mm512_cmpge_epu64_mask(state[0], maxState[0]);
+  cmp[1] = _mm512_cmpge_epu64_mask(state[1], maxState[1]);
+  // newState = (state >= maxState) ? state >> streamBits_V : state
+  newState[0] = _mm512_mask_srli_epi64(state[0], cmp[0], state[0], streamBits_V);
+  newState[1] = _mm512_mask_srli_epi64(state[1], cmp[1], state[1], streamBits_V);
+
+  auto [nStreamOutWords, streamOutMask, streamOutResult] = streamOut(state, cmp);
+  // compress in registers followed by a masked store, compressing stores to memory are slow
+  const __m512i compressed = _mm512_maskz_compress_epi32(streamOutMask, streamOutResult);
+  if constexpr (std::is_pointer_v<output_IT>) {
+    _mm512_mask_storeu_epi32(outputIter, static_cast<__mmask16>((1u << nStreamOutWords) - 1), compressed);
+    outputIter += nStreamOutWords;
+  } else {
+    auto result = store<uint32_t>(compressed);
+    for (size_t i = 0; i < nStreamOutWords; ++i) {
+      *outputIter = result(i);
+      ++outputIter;
+    }
+  }
+
+  return outputIter;
+};
+#endif /* RANS_AVX512 */
+
 struct UnrolledSymbols {
   __m128i frequencies[2];
   __m128i cumulativeFrequencies[2];
 };
 
+#ifdef RANS_AVX512
+struct UnrolledSymbolsAVX512 {
+  __m256i frequencies[2];
+  __m256i cumulativeFrequencies[2];
+};
+#endif /* RANS_AVX512 */
+
+template <SIMDWidth width_V>
+struct UnrolledSymbolsTraits {
+  using type = UnrolledSymbols;
+};
+
+#ifdef RANS_AVX512
+template <>
+struct UnrolledSymbolsTraits<SIMDWidth::AVX512> {
+  using type = UnrolledSymbolsAVX512;
+};
+#endif /* RANS_AVX512 */
+
+template <SIMDWidth width_V>
+using unrolledSymbols_t = typename UnrolledSymbolsTraits<width_V>::type;
+
 } // namespace o2::rans::internal::simd
 
 #endif /* RANS_SIMD */
@@ -81,14 +81,18 @@ using coder_types = boost::mp11::mp_list<std::integral_constant<CoderTag, CoderT
                                          ,
                                          std::integral_constant<CoderTag, CoderTag::SingleStream>
 #endif /* RANS_SINGLE_STREAM */
-#ifdef RANS_SEE
+#ifdef RANS_SSE
                                          ,
                                          std::integral_constant<CoderTag, CoderTag::SSE>
-#endif /*RANS_SSE */
+#endif /* RANS_SSE */
 #ifdef RANS_AVX2
                                          ,
                                          std::integral_constant<CoderTag, CoderTag::AVX2>
 #endif /* RANS_AVX2 */
+#ifdef RANS_AVX512
+                                         ,
+                                         std::integral_constant<CoderTag, CoderTag::AVX512>
+#endif /* RANS_AVX512 */
                                          >;
 
 using testCase_types = boost::mp11::mp_product<boost::mp11::mp_list, coder_types, testInput_types>;
@@ -142,6 +146,61 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, test_types, testCase_types)
   decoder.process(encodeBufferEnd, decodeBuffer.begin(), encodeString.size(), encoder.getNStreams(), literalBufferEnd);
 
   BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), encodeString.begin(), encodeString.end());
+
+  // decoding from raw pointers can take the vectorized path
+  std::vector<source_type> decodeBuffer2(encodeString.size());
+  const stream_type* encodeBufferPtrEnd = encodeBuffer.data() + std::distance(encodeBuffer.begin(), encodeBufferEnd);
+  decoder.process(encodeBufferPtrEnd, decodeBuffer2.data(), encodeString.size(), encoder.getNStreams(), literalBufferEnd);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer2.begin(), decodeBuffer2.end(), encodeString.begin(), encodeString.end());
+};
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_streamingEncodeDecode, coder_type, coder_types)
+{
+  using stream_type = uint32_t;
+  using source_type = int16_t;
+
+  constexpr CoderTag coderTag = coder_type::value;
+  const std::vector<source_type> source{str.begin(), str.end()};
+  // the dictionary is built from the first line only, the symbols missing in it are coded as literals
+  const size_t dictSize = str.find('\n');
+
+  auto renormed = renorm(makeDenseHistogram::fromSamples(source.begin(), source.begin() + dictSize), RansRenormingPrecision, RenormingPolicy::ForceIncompressible);
+  auto encoder = makeDenseEncoder<coderTag>::fromRenormed(renormed);
+  auto decoder = makeDecoder<>::fromRenormed(renormed);
+  using encoder_type = decltype(encoder);
+
+  // chunks which are not a multiple of the number of streams, the last chunk is partial
+  StreamingEncoder<encoder_type> streamingEncoder{encoder, 3 * encoder.getNStreams() + 1};
+  const size_t chunkSize = streamingEncoder.getChunkSize();
+
+  std::vector<stream_type> encodeBuffer;
+  std::vector<size_t> chunkWords;
+  std::vector<size_t> chunkLiterals;
+  std::vector<source_type> literals(source.size());
+  auto literalsEnd = streamingEncoder.process(source.begin(), source.end(), [&](const auto& info, const stream_type* begin, const stream_type* end) {
+    BOOST_CHECK_EQUAL(info.nStreamWords, std::distance(begin, end));
+    BOOST_CHECK(info.nSymbols == chunkSize || chunkWords.size() == source.size() / chunkSize);
+    encodeBuffer.insert(encodeBuffer.end(), begin, end);
+    chunkWords.push_back(info.nStreamWords);
+    chunkLiterals.push_back(info.nLiterals);
+  },
+                                              literals.begin());
+
+  BOOST_CHECK_EQUAL(chunkWords.size(), (source.size() + chunkSize - 1) / chunkSize);
+  BOOST_CHECK(literalsEnd != literals.begin());
+
+  std::vector<source_type> decodeBuffer(source.size());
+  const stream_type* chunkBegin = encodeBuffer.data();
+  auto chunkLiteralsEnd = literals.begin();
+  for (size_t i = 0; i < chunkWords.size(); ++i) {
+    const size_t nSymbols = std::min(chunkSize, source.size() - i * chunkSize);
+    chunkBegin += chunkWords[i];
+    chunkLiteralsEnd += chunkLiterals[i];
+    decoder.process(chunkBegin, decodeBuffer.data() + i * chunkSize, nSymbols, encoder.getNStreams(), chunkLiteralsEnd);
+  }
+  BOOST_CHECK(chunkLiteralsEnd == literalsEnd);
+  BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), source.begin(), source.end());
 };
 
 #ifndef RANS_SINGLE_STREAM
@@ -161,4 +220,10 @@ BOOST_AUTO_TEST_CASE(test_NoAVX2)
 {
   BOOST_TEST_WARN("Tests were not Compiled for a AVX2 capable CPU, cannot run all tests");
 }
-#endif /* RANS_AVX2 */
\ No newline at end of file
+#endif /* RANS_AVX2 */
+#ifndef RANS_AVX512
+BOOST_AUTO_TEST_CASE(test_NoAVX512)
+{
+  BOOST_TEST_WARN("Tests were not Compiled for a AVX512 capable CPU, cannot run all tests");
+}
+#endif /* RANS_AVX512 */
@@ -40,12 +40,18 @@ using pd_types = boost::mpl::list<pd_t<SIMDWidth::SSE>
 #ifdef RANS_AVX2
                                       , pd_t<SIMDWidth::AVX>
 #endif /* RANS_AVX2 */
+#ifdef RANS_AVX512
+                                      , pd_t<SIMDWidth::AVX512>
+#endif /* RANS_AVX512 */
                                       >;
 
 using epi64_types = boost::mpl::list<epi64_t<SIMDWidth::SSE>
 #ifdef RANS_AVX2
                                           , epi64_t<SIMDWidth::AVX>
 #endif /* RANS_AVX2 */
+#ifdef RANS_AVX512
+                                          , epi64_t<SIMDWidth::AVX512>
+#endif /* RANS_AVX512 */
                                           >;
 
 using epi32_types = boost::mpl::list<epi32_t<SIMDWidth::SSE>
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+#
+# Benchmark of reconstruction workflows on a fixed set of recorded timeframes.
+#
+# "run" replays the timeframes with o2-raw-tf-reader-workflow through the given
+# workflows, as a single DPL topology, and writes the report produced by the
+# driver (--benchmark-report): CPU time, peak RSS, processing time, throughput
+# and memory held by the DPL containers, per device. The report is annotated
+# with the label of the software version, and the inputs, so that two reports
+# can be compared with "compare", which fails in case of regressions.
+#
+# Examples:
+#   o2-benchmark-reco run --input-data tfs.txt --max-tf 20 --label nightly-20240101 \
+#     --workflow "o2-its-reco-workflow --trackerCA --disable-mc --clusters-from-upstream" \
+#     --workflow "o2-its-cluster-writer-workflow --disable-mc" --output its.json
+#   o2-benchmark-reco compare reference.json its.json --tolerance 0.05
+#
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+# Quantities of the report which are compared, and whether a larger value is better.
+COMPARED = {
+    'cpuTimeS': False,
+    'maxResidentSetSizeKB': False,
+    'processingTimeMs': False,
+    'timeframesPerSecond': True,
+    'peakHeldBytes': False,
+}
+
+
+def load_report(path):
+    # The driver writes the values as strings, via boost::property_tree.
+    with open(path) as f:
+        report = json.load(f)
+    report['wallTimeMs'] = float(report['wallTimeMs'])
+    for device in report['devices'].values():
+        for key, value in device.items():
+            if key != 'name':
+                device[key] = float(value)
+        device['cpuTimeS'] = device['cpuUserTimeS'] + device['cpuSystemTimeS']
+    return report
+
+
+def run(args):
+    reader = 'o2-raw-tf-reader-workflow --input-data {} --max-tf {} --loop {} --delay 0 --onlyDet {}'.format(
+        shlex.quote(os.path.abspath(args.input_data)), args.max_tf, args.loops, args.only_det)
+    output = os.path.abspath(args.output)
+    chain = [reader] + args.workflow
+    # The options common to all the workflows, the benchmark report is written by the driver.
+    command = ' | '.join('{} {}'.format(w, args.dpl_args) for w in chain)
+    command += ' --run -b --benchmark-report {}'.format(shlex.quote(output))
+    workdir = args.workdir or tempfile.mkdtemp(prefix='o2-benchmark-reco-')
+    print('Running in {}: {}'.format(workdir, command))
+    status = subprocess.call(command, shell=True, cwd=workdir)
+    if status != 0:
+        print('The workflow failed with exit code {}'.format(status), file=sys.stderr)
+        return status
+    report = load_report(output)
+    report['label'] = args.label
+    report['command'] = command
+    report['inputData'] = args.input_data
+    report['maxTF'] = args.max_tf
+    report['loops'] = args.loops
+    with open(output, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print_report(report)
+    return 0
+
+
+def print_report(report):
+    print('{:<40} {:>10} {:>12} {:>14} {:>10}'.format('device', 'cpu (s)', 'max rss (MB)', 'processing (s)', 'TF/s'))
+    for name, device in sorted(report['devices'].items()):
+        print('{:<40} {:>10.2f} {:>12.1f} {:>14.2f} {:>10.2f}'.format(
+            name, device['cpuTimeS'], device['maxResidentSetSizeKB'] / 1024., device['processingTimeMs'] / 1000., device['timeframesPerSecond']))
+
+
+def compare(args):
+    reference = load_report(args.reference)
+    report = load_report(args.report)
+    print('Comparing {} to {}'.format(report.get('label', args.report), reference.get('label', args.reference)))
+    regressions = 0
+    for name, device in sorted(report['devices'].items()):
+        if name not in reference['devices']:
+            print('{}: not in the reference'.format(name))
+            continue
+        for quantity, largerIsBetter in COMPARED.items():
+            old = reference['devices'][name].get(quantity, 0)
+            new = device.get(quantity, 0)
+            if old <= 0:
+                continue
+            change = (new - old) / old
+            worse = change < -args.tolerance if largerIsBetter else change > args.tolerance
+            regressions += worse
+            if worse or args.verbose:
+                print('{}{}: {} {:.6g} -> {:.6g} ({:+.1%})'.format('REGRESSION ' if worse else '', name, quantity, old, new, change))
+    for name in sorted(set(reference['devices']) - set(report['devices'])):
+        print('{}: missing from the report'.format(name))
+    print('{} regressions beyond {:.0%}'.format(regressions, args.tolerance))
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Benchmark of reconstruction workflows on recorded timeframes')
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    runParser = commands.add_parser('run', help='replay the timeframes through the workflows and write a report')
+    runParser.add_argument('--input-data', required=True, help='timeframe file, or list of files, as accepted by o2-raw-tf-reader-workflow')
+    runParser.add_argument('--workflow', action='append', required=True, help='workflow to run on the timeframes, can be repeated')
+    runParser.add_argument('--max-tf', type=int, default=-1, help='number of timeframes to replay')
+    runParser.add_argument('--loops', type=int, default=0, help='number of times the timeframes are replayed again')
+    runParser.add_argument('--only-det', default='all', help='detectors to read from the timeframes')
+    runParser.add_argument('--dpl-args', default='--shm-segment-size 16000000000', help='options given to all the workflows')
+    runParser.add_argument('--label', default='', help='label of the software version, stored in the report')
+    runParser.add_argument('--workdir', default='', help='directory where to run, a temporary one by default')
+    runParser.add_argument('--output', default='benchmark-reco.json', help='report file')
+
+    compareParser = commands.add_parser('compare', help='compare a report to a reference one')
+    compareParser.add_argument('reference')
+    compareParser.add_argument('report')
+    compareParser.add_argument('--tolerance', type=float, default=0.1, help='relative change considered as a regression')
+    compareParser.add_argument('--verbose', action='store_true', help='print all the changes, not only the regressions')
+
+    args = parser.parse_args()
+    return run(args) if args.command == 'run' else compare(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
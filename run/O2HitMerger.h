@@ -41,6 +41,7 @@
 
 #include "O2HitMerger.h"
 #include "O2SimDevice.h"
+#include <SimConfig/SimParams.h>
 #include <TPCSimulation/Detector.h>
 #include <ITSSimulation/Detector.h>
 #include <MFTSimulation/Detector.h>
@@ -64,6 +65,7 @@
 #include <list>
 #include <csignal>
 #include <mutex>
+#include <thread>
 #include <filesystem>
 #include <functional>
 
@@ -139,6 +141,18 @@ class O2HitMerger : public fair::mq::Device
       outfilename = o2::base::NameConf::getMCKinematicsFileName(o2::conf::SimConfig::Instance().getOutPrefix().c_str());
       mNExpectedEvents = o2::conf::SimConfig::Instance().getNEvents();
     }
+    {
+      // update the parameters from an INI/JSON file and from the command line, as done by the workers
+      auto& confref = o2::conf::SimConfig::Instance();
+      o2::conf::ConfigurableParam::updateFromFile(confref.getConfigFile());
+      o2::conf::ConfigurableParam::updateFromString(confref.getKeyValueString());
+    }
+    auto& ioParams = o2::conf::SimIOParams::Instance();
+    if (ioParams.mergerIOThreads > 0 && !ROOT::IsImplicitMTEnabled()) {
+      // has to be done before the trees are created; the baskets are then compressed in parallel when flushed
+      ROOT::EnableImplicitMT(ioParams.mergerIOThreads);
+      LOG(info) << "Enabled ROOT implicit MT with " << ioParams.mergerIOThreads << " threads for the output";
+    }
     mAsService = o2::conf::SimConfig::Instance().asService();
     mForwardKine = o2::conf::SimConfig::Instance().forwardKine();
     mWriteToDisc = o2::conf::SimConfig::Instance().writeToDisc();
@@ -152,6 +166,16 @@ class O2HitMerger : public fair::mq::Device
       mMCHeaderOnlyOutFile = new TFile(o2::base::NameConf::getMCHeadersFileName(o2::conf::SimConfig::Instance().getOutPrefix().c_str()).c_str(), "RECREATE");
       mMCHeaderTree = new TTree("o2sim", "o2sim");
       mMCHeaderTree->SetDirectory(mMCHeaderOnlyOutFile);
+
+      if (ioParams.kineCompression >= 0) {
+        mOutFile->SetCompressionSettings(ioParams.kineCompression);
+        mMCHeaderOnlyOutFile->SetCompressionSettings(ioParams.kineCompression);
+      }
+      if (ioParams.kineAutoFlush != 0) {
+        mOutTree->SetAutoFlush(ioParams.kineAutoFlush);
+        mMCHeaderTree->SetAutoFlush(ioParams.kineAutoFlush);
+      }
+      mKineBasketSizeSet = false;
     }
     // detectors init only once
     if (mDetectorInstances.size() == 0) {
@@ -765,6 +789,24 @@ class O2HitMerger : public fair::mq::Device
         eventheader->putInfo("prims_total", prims);
       };
 
+      // c) do the merge procedure for all hits ... delegate this to detector specific functions
+      // since they know about types; number of branches; etc.
+      // this will also fix the trackIDs inside the hits
+      // Every detector has its own hit buffers, tree and output file: the detectors are merged in parallel,
+      // one thread per detector, while this thread takes care of the kinematics
+      std::vector<std::thread> detectorMergers;
+      for (int id = 0; id < mDetectorInstances.size(); ++id) {
+        auto& det = mDetectorInstances[id];
+        auto hittree = det ? mDetectorToTTreeMap[id] : nullptr;
+        if (hittree) {
+          detectorMergers.emplace_back([&det, hittree, flusheventID, &trackoffsets, &nprimaries, &subevOrdered]() {
+            det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
+            hittree->SetEntries(hittree->GetEntries() + 1);
+            LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+          });
+        }
+      }
+
       reorderAndMergeMCTracks(flusheventID, mOutTree, nprimaries, subevOrdered, mcheaderhook, eventheader);
 
       if (mOutTree) {
@@ -787,19 +829,21 @@ class O2HitMerger : public fair::mq::Device
         }
       }
 
-      // c) do the merge procedure for all hits ... delegate this to detector specific functions
-      // since they know about types; number of branches; etc.
-      // this will also fix the trackIDs inside the hits
-      for (int id = 0; id < mDetectorInstances.size(); ++id) {
-        auto& det = mDetectorInstances[id];
-        if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
-          if (hittree) {
-            det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
-            hittree->SetEntries(hittree->GetEntries() + 1);
-            LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
+      for (auto& merger : detectorMergers) {
+        merger.join();
+      }
+
+      // the branches are created with the first event, only then the basket size can be changed
+      if (!mKineBasketSizeSet) {
+        const auto basketSize = o2::conf::SimIOParams::Instance().kineBasketSize;
+        if (basketSize > 0) {
+          for (auto tree : {mOutTree, mMCHeaderTree}) {
+            if (tree) {
+              tree->SetBasketSize("*", basketSize);
+            }
           }
         }
+        mKineBasketSizeSet = true;
       }
 
       // increase the entry count in the tree
@@ -820,16 +864,21 @@ class O2HitMerger : public fair::mq::Device
     } // end while
     if (mWriteToDisc && mOutFile) {
       LOG(info) << "Writing TTrees";
-      mOutFile->Write("", TObject::kOverwrite);
+      // the detector files are independent, write them in parallel as well
+      std::vector<std::thread> detectorWriters;
       for (int id = 0; id < mDetectorInstances.size(); ++id) {
-        auto& det = mDetectorInstances[id];
-        if (det && mDetectorOutFiles[id]) {
-          mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+        auto outfile = mDetectorInstances[id] ? mDetectorOutFiles[id] : nullptr;
+        if (outfile) {
+          detectorWriters.emplace_back([outfile]() { outfile->Write("", TObject::kOverwrite); });
         }
       }
+      mOutFile->Write("", TObject::kOverwrite);
       if (mMCHeaderOnlyOutFile) {
         mMCHeaderOnlyOutFile->Write("", TObject::kOverwrite);
       }
+      for (auto& writer : detectorWriters) {
+        writer.join();
+      }
     }
     return true;
   }
@@ -842,6 +891,7 @@ class O2HitMerger : public fair::mq::Device
   TTree* mOutTree;             //! tree (kinematics) associated to mOutFile
   TFile* mMCHeaderOnlyOutFile; //! outfile for header only information
   TTree* mMCHeaderTree;        //! tree to hold MCHeader branch in mMCHeaderOnlyOutFile;
+  bool mKineBasketSizeSet = false; //! if the basket size of the kinematics branches was adjusted
 
   template <class K, class V>
   using Hashtable = tbb::concurrent_unordered_map<K, V>;
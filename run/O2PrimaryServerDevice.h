@@ -28,6 +28,8 @@
 #include <Generators/GeneratorFromFile.h>
 #include <Generators/PrimaryGenerator.h>
 #include <SimConfig/SimConfig.h>
+#include <SimConfig/InteractionDiamondParam.h>
+#include <DataFormatsCalibration/MeanVertexObject.h>
 #include <CommonUtils/ConfigurableParam.h>
 #include <CommonUtils/RngHelper.h>
 #include <DetectorsBase/SimFieldUtils.h>
@@ -40,6 +42,11 @@
 #include <fstream>
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "PrimaryServerState.h"
 #include "SimPublishChannelHelper.h"
 #include <chrono>
@@ -67,6 +74,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
   ~O2PrimaryServerDevice() final
   {
     try {
+      stopGeneratorPool();
       if (mGeneratorThread.joinable()) {
         mGeneratorThread.join();
       }
@@ -111,28 +119,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     }
 
     if (mPrimGen == nullptr) {
-      mPrimGen = new o2::eventgen::PrimaryGenerator;
-      o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, mPrimGen);
-
-      // setup vertexing
-      auto vtxMode = conf.getVertexMode();
-      using o2::conf::VertexMode;
-      if (vtxMode == VertexMode::kNoVertex || vtxMode == VertexMode::kDiamondParam) {
-        mPrimGen->setVertexMode(vtxMode);
-      } else if (vtxMode == VertexMode::kCCDB) {
-        // we need to fetch the CCDB object
-        mPrimGen->setVertexMode(vtxMode, ccdbmgr.getForTimeStamp<o2::dataformats::MeanVertexObject>("GLO/Calib/MeanVertex", conf.getTimestamp()));
-      } else {
-        LOG(fatal) << "Unsupported vertex mode";
-      }
-
-      auto embedinto_filename = conf.getEmbedIntoFileName();
-      if (!embedinto_filename.empty()) {
-        mPrimGen->embedInto(embedinto_filename);
-      }
-
-      mPrimGen->Init();
-
+      mPrimGen = createPrimaryGenerator();
       mPrimGeneratorCache[conf.getGenerator()] = mPrimGen;
     }
     mPrimGen->SetEvent(&mEventHeader);
@@ -156,10 +143,182 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       }
     }
 
+    if (mNGenThreads > 1) {
+      initGeneratorPool();
+    }
+
     LOG(info) << "Generator initialization took " << timer.CpuTime() << "s";
     if (mMaxEvents > 0) {
-      generateEvent(); // generate a first event
+      if (mNGenThreads > 1) {
+        startGeneratorPool();
+      } else {
+        generateEvent(); // generate a first event
+      }
+    }
+  }
+
+  // creates and initializes a primary generator according to the current configuration
+  o2::eventgen::PrimaryGenerator* createPrimaryGenerator()
+  {
+    const auto& conf = mSimConfig;
+    auto primGen = new o2::eventgen::PrimaryGenerator;
+    o2::eventgen::GeneratorFactory::setPrimaryGenerator(conf, primGen);
+
+    // setup vertexing
+    auto vtxMode = conf.getVertexMode();
+    using o2::conf::VertexMode;
+    if (vtxMode == VertexMode::kNoVertex || vtxMode == VertexMode::kDiamondParam) {
+      primGen->setVertexMode(vtxMode);
+    } else if (vtxMode == VertexMode::kCCDB) {
+      // we need to fetch the CCDB object
+      primGen->setVertexMode(vtxMode, getMeanVertexFromCCDB());
+    } else {
+      LOG(fatal) << "Unsupported vertex mode";
     }
+
+    auto embedinto_filename = conf.getEmbedIntoFileName();
+    if (!embedinto_filename.empty()) {
+      primGen->embedInto(embedinto_filename);
+    }
+
+    primGen->Init();
+    return primGen;
+  }
+
+  o2::dataformats::MeanVertexObject const* getMeanVertexFromCCDB()
+  {
+    auto& ccdbmgr = o2::ccdb::BasicCCDBManager::instance();
+    return ccdbmgr.getForTimeStamp<o2::dataformats::MeanVertexObject>("GLO/Calib/MeanVertex", mSimConfig.getTimestamp());
+  }
+
+  // sets up the generator instances of the event pool; the first one is the current generator,
+  // the others are kept in a cache like the current generator
+  void initGeneratorPool()
+  {
+    const auto& conf = mSimConfig;
+    auto& cached = mPoolGeneratorCache[conf.getGenerator()];
+    mPoolGenerators.assign(1, mPrimGen);
+    for (int id = 1; id < mNGenThreads; ++id) {
+      if (id > (int)cached.size()) {
+        // the generators derive their own seeds (e.g. the Pythia8 seed) from gRandom when initialized
+        o2::utils::RngHelper::setGRandomSeed(o2::utils::RngHelper::decorrelatedSeed(mInitialSeed, id));
+        cached.push_back(createPrimaryGenerator());
+      }
+      mPoolGenerators.push_back(cached[id - 1]);
+    }
+    while ((int)mPoolStacks.size() < mNGenThreads) {
+      mPoolStacks.emplace_back(new o2::data::Stack());
+      mPoolStacks.back()->setExternalMode(true);
+      mPoolHeaders.emplace_back(new o2::dataformats::MCEventHeader());
+    }
+    for (int id = 0; id < mNGenThreads; ++id) {
+      mPoolGenerators[id]->SetEvent(mPoolHeaders[id].get());
+    }
+
+    // the vertices are sampled by the pool in the order of the events, such that they do not
+    // depend on the generator instance producing the event
+    using o2::conf::VertexMode;
+    auto vtxMode = conf.getVertexMode();
+    if (vtxMode == VertexMode::kCCDB) {
+      mPoolMeanVertex = std::make_unique<o2::dataformats::MeanVertexObject>(*getMeanVertexFromCCDB());
+    } else if (vtxMode == VertexMode::kDiamondParam) {
+      auto const& param = o2::eventgen::InteractionDiamondParam::Instance();
+      mPoolMeanVertex = std::make_unique<o2::dataformats::MeanVertexObject>(param.position[0], param.position[1], param.position[2], param.width[0], param.width[1], param.width[2], param.slopeX, param.slopeY);
+    } else {
+      mPoolMeanVertex = std::make_unique<o2::dataformats::MeanVertexObject>(0, 0, 0, 0, 0, 0, 0, 0);
+    }
+    LOG(info) << "Generating events with " << mNGenThreads << " generator instances in parallel";
+  }
+
+  // launches the threads filling the event pool
+  void startGeneratorPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mPoolMutex);
+      mPool.clear();
+      mPoolStop = false;
+      mPoolNextEvent = 0;
+      mPoolClaimedEvents = 0;
+    }
+    for (int id = 0; id < mNGenThreads; ++id) {
+      mPoolThreads.emplace_back(&O2PrimaryServerDevice::fillGeneratorPool, this, id);
+    }
+    stateTransition(O2PrimaryServerState::ReadyToServe, "GENPOOL");
+  }
+
+  // stops the threads filling the event pool and discards the events not served
+  void stopGeneratorPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mPoolMutex);
+      mPoolStop = true;
+    }
+    mPoolCondition.notify_all();
+    for (auto& t : mPoolThreads) {
+      if (t.joinable()) {
+        t.join();
+      }
+    }
+    mPoolThreads.clear();
+    std::lock_guard<std::mutex> lock(mPoolMutex);
+    mPool.clear();
+  }
+
+  // generates events with the generator instance of the given thread and adds them to the pool;
+  // the events are claimed in increasing order and at most 2 per instance are generated ahead of the serving
+  void fillGeneratorPool(int threadID)
+  {
+    auto primGen = mPoolGenerators[threadID];
+    auto stack = mPoolStacks[threadID].get();
+    const int maxAhead = 2 * mNGenThreads;
+    while (true) {
+      int event = 0;
+      math_utils::Point3D<float> vertex;
+      {
+        std::unique_lock<std::mutex> lock(mPoolMutex);
+        mPoolCondition.wait(lock, [this, maxAhead]() { return mPoolStop || mPoolClaimedEvents >= mMaxEvents || mPoolClaimedEvents < mPoolNextEvent + maxAhead; });
+        if (mPoolStop || mPoolClaimedEvents >= mMaxEvents) {
+          return;
+        }
+        event = mPoolClaimedEvents++;
+        if (auto contextVertex = getContextVertex(event)) {
+          vertex = *contextVertex;
+        } else {
+          // gRandom is not thread safe, the vertex is sampled while holding the lock
+          vertex = mPoolMeanVertex->sample();
+        }
+      }
+      TStopwatch timer;
+      timer.Start();
+      generateEventWith(primGen, stack, event, &vertex);
+      timer.Stop();
+      LOG(info) << "Generator instance " << threadID << " generated event " << event << " in " << timer.RealTime() << "s"
+                << " with " << stack->getPrimaries().size() << " primaries";
+      PooledEvent pooled{stack->getPrimaries(), *mPoolHeaders[threadID]};
+      {
+        std::lock_guard<std::mutex> lock(mPoolMutex);
+        mPool.emplace(event, std::move(pooled));
+      }
+      mPoolCondition.notify_all();
+    }
+  }
+
+  // takes the next event from the pool, waiting for it to be generated if needed
+  void takeEventFromPool()
+  {
+    std::unique_lock<std::mutex> lock(mPoolMutex);
+    const int event = mPoolNextEvent;
+    if (mPool.find(event) == mPool.end()) {
+      LOG(info) << "Waiting for event " << event << " to be generated";
+      mPoolCondition.wait(lock, [this, event]() { return mPool.find(event) != mPool.end(); });
+    }
+    auto iter = mPool.find(event);
+    mPoolEvent = std::move(iter->second);
+    mPool.erase(iter);
+    mPoolNextEvent++;
+    lock.unlock();
+    mPoolCondition.notify_all();
+    mEventHeader = mPoolEvent.header;
   }
 
   // function generating one event
@@ -172,24 +331,46 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     }
     TStopwatch timer;
     timer.Start();
+    generateEventWith(mPrimGen, mStack, mEventCounter, getContextVertex(mEventCounter));
+    timer.Stop();
+    LOG(info) << "Event generation took " << timer.CpuTime() << "s"
+              << " and produced " << mStack->getPrimaries().size() << " primaries ";
+    if (changeState) {
+      stateTransition(O2PrimaryServerState::ReadyToServe, "GENEVENT");
+    }
+  }
+
+  // returns the vertex of the event from the collision context, nullptr if there is none
+  math_utils::Point3D<float> const* getContextVertex(int eventID) const
+  {
+    // see if we the vertex comes from the collision context
+    if (mCollissionContext) {
+      const auto& vertices = mCollissionContext->getInteractionVertices();
+      if (vertices.size() > 0) {
+        auto collisionindex = mEventID_to_CollID.at(eventID);
+        auto& vertex = vertices.at(collisionindex);
+        LOG(info) << "Setting vertex " << vertex << " for event " << eventID << " for prefix " << mSimConfig.getOutPrefix();
+        return &vertex;
+      }
+    }
+    return nullptr;
+  }
+
+  // generates one non-empty event (if possible) with the given generator into the given stack,
+  // using the given vertex unless it is nullptr
+  void generateEventWith(o2::eventgen::PrimaryGenerator* primGen, o2::data::Stack* stack, int eventID, math_utils::Point3D<float> const* vertex)
+  {
     try {
       bool valid = false;
       int retry_counter = 0;
       const int MAX_RETRY = 100;
       do {
-        mStack->Reset();
-        // see if we the vertex comes from the collision context
-        if (mCollissionContext) {
-          const auto& vertices = mCollissionContext->getInteractionVertices();
-          if (vertices.size() > 0) {
-            auto collisionindex = mEventID_to_CollID.at(mEventCounter);
-            auto& vertex = vertices.at(collisionindex);
-            LOG(info) << "Setting vertex " << vertex << " for event " << mEventCounter << " for prefix " << mSimConfig.getOutPrefix();
-            mPrimGen->setExternalVertexForNextEvent(vertex.X(), vertex.Y(), vertex.Z());
-          }
+        stack->Reset();
+        if (vertex) {
+          primGen->setExternalVertexForNextEvent(vertex->X(), vertex->Y(), vertex->Z());
         }
-        mPrimGen->GenerateEvent(mStack);
-        if (mStack->getPrimaries().size() > 0) {
+        primGen->GenerateEvent(stack);
+        if (stack->getPrimaries().size() > 0) {
           valid = true;
         } else {
           retry_counter++;
@@ -201,13 +382,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
         }
       } while (!valid);
     } catch (std::exception const& e) {
-      LOG(error) << " Exception occurred during event gen " << e.what();
-    }
-    timer.Stop();
-    LOG(info) << "Event generation took " << timer.CpuTime() << "s"
-              << " and produced " << mStack->getPrimaries().size() << " primaries ";
-    if (changeState) {
-      stateTransition(O2PrimaryServerState::ReadyToServe, "GENEVENT");
+      LOG(error) << " Exception occurred during event gen " << e.what() << " for event " << eventID;
     }
   }
 
@@ -295,6 +470,13 @@ class O2PrimaryServerDevice final : public fair::mq::Device
 
     mMaxEvents = conf.getNEvents();
 
+    mNGenThreads = conf.getNGeneratorThreads();
+    if (mNGenThreads > 1 && (conf.getGenerator().compare(0, 6, "extkin") == 0 || !conf.getEmbedIntoFileName().empty())) {
+      // instances reading the same input would each start from its beginning
+      LOG(warn) << "Parallel event generation not supported when reading events or embedding, using 1 generator instance";
+      mNGenThreads = 1;
+    }
+
     // need to make ROOT thread-safe since we use ROOT services in all places
     ROOT::EnableThreadSafety();
 
@@ -378,6 +560,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     mSimConfig.getConfigData().mTrigger = reconfig.trigger;
     mSimConfig.getConfigData().mExtKinFileName = reconfig.extKinfileName;
 
+    stopGeneratorPool();
     mEventCounter = 0;
     mPartCounter = 0;
     mNeedNewEvent = true;
@@ -497,7 +680,12 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     LOG(debug) << "Received request for work " << mEventCounter << " " << mMaxEvents << " " << mNeedNewEvent << " available " << workavailable;
     if (workavailable) {
 
-      if (mNeedNewEvent) {
+      if (mNeedNewEvent && mNGenThreads > 1) {
+        takeEventFromPool();
+        mNeedNewEvent = false;
+        mPartCounter = 0;
+        mEventCounter++;
+      } else if (mNeedNewEvent) {
         // we need a newly generated event now
         if (mGeneratorThread.joinable()) {
           try {
@@ -516,7 +704,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
         mEventCounter++;
       }
 
-      auto& prims = mStack->getPrimaries();
+      auto& prims = mNGenThreads > 1 ? mPoolEvent.primaries : mStack->getPrimaries();
       auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
       // number of parts should be at least 1 (even if empty)
       numberofparts = std::max(1, numberofparts);
@@ -564,8 +752,8 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       mPartCounter++;
       if (mPartCounter == numberofparts) {
         mNeedNewEvent = true;
-        // start generation of a new event
-        if (mEventCounter < mMaxEvents) {
+        // start generation of a new event (the pool generates ahead on its own)
+        if (mEventCounter < mMaxEvents && mNGenThreads == 1) {
           mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
         }
       }
@@ -687,6 +875,26 @@ class O2PrimaryServerDevice final : public fair::mq::Device
   std::unordered_map<int, int> mEventID_to_CollID;              //!
 
   TRandom3 mSeedGenerator; //! specific random generator for seed generation for work chunks
+
+  // pool of events generated ahead by several generator instances in parallel threads (if mNGenThreads > 1)
+  struct PooledEvent {
+    std::vector<TParticle> primaries;
+    o2::dataformats::MCEventHeader header;
+  };
+  int mNGenThreads = 1;                                                                    // number of generator instances running in parallel
+  std::vector<o2::eventgen::PrimaryGenerator*> mPoolGenerators;                            //! generators of the pool threads, the first one is mPrimGen
+  std::map<std::string, std::vector<o2::eventgen::PrimaryGenerator*>> mPoolGeneratorCache; //! additional generator instances by generator name
+  std::vector<std::unique_ptr<o2::data::Stack>> mPoolStacks;                               //! stack of each pool thread
+  std::vector<std::unique_ptr<o2::dataformats::MCEventHeader>> mPoolHeaders;               //! event header of each pool thread
+  std::unique_ptr<o2::dataformats::MeanVertexObject> mPoolMeanVertex;                      //! vertex distribution sampled for the pooled events
+  std::vector<std::thread> mPoolThreads;                                                   //! threads filling the pool
+  std::map<int, PooledEvent> mPool;                                                        //! generated events not yet served by event index
+  PooledEvent mPoolEvent;                                                                  //! event currently served
+  int mPoolNextEvent = 0;                                                                  //! index of the next event to be served
+  int mPoolClaimedEvents = 0;                                                              //! number of events claimed by the pool threads
+  bool mPoolStop = false;                                                                  //! request to stop the pool threads
+  std::mutex mPoolMutex;                                                                   //! protects the pool and its counters
+  std::condition_variable mPoolCondition;                                                  //!
 };
 
 } // namespace devices